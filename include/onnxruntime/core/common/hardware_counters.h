@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace onnxruntime {
+namespace profiling {
+
+// Counts of the user space hardware events of a thread, see ReadThreadHardwareCounters().
+struct HardwareCounterValues {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llc_misses = 0;  // last level cache misses
+
+  HardwareCounterValues& operator+=(const HardwareCounterValues& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    llc_misses += other.llc_misses;
+    return *this;
+  }
+
+  HardwareCounterValues operator-(const HardwareCounterValues& other) const {
+    HardwareCounterValues diff;
+    diff.cycles = cycles - other.cycles;
+    diff.instructions = instructions - other.instructions;
+    diff.llc_misses = llc_misses - other.llc_misses;
+    return diff;
+  }
+};
+
+// Reads the counts of the calling thread since its counters were opened, which is done by the first call on the
+// thread. Only the difference between two reads on the same thread is meaningful.
+// Uses perf_event_open on Linux. Returns false on other platforms, and when the counters can't be opened, e.g.
+// because perf events are restricted by kernel.perf_event_paranoid. An event the CPU doesn't support reads as 0.
+bool ReadThreadHardwareCounters(HardwareCounterValues& values);
+
+}  // namespace profiling
+}  // namespace onnxruntime
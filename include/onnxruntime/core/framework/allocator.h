@@ -21,7 +21,9 @@ struct OrtArenaCfg {
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
                   initial_growth_chunk_size_bytes(-1),
-                  max_power_of_two_extend_bytes(-1) {}
+                  max_power_of_two_extend_bytes(-1),
+                  max_thread_cache_bytes(-1),
+                  huge_pages(-1) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
               int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
               int64_t max_power_of_two_extend_bytes)
@@ -30,7 +32,9 @@ struct OrtArenaCfg {
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
         initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
-        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes) {}
+        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes),
+        max_thread_cache_bytes(-1),
+        huge_pages(-1) {}
 
   size_t max_mem;                         // use 0 to allow ORT to choose the default
   int arena_extend_strategy;              // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
@@ -38,15 +42,28 @@ struct OrtArenaCfg {
   int max_dead_bytes_per_chunk;           // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;    // use -1 to allow ORT to choose the default
   int64_t max_power_of_two_extend_bytes;  // use -1 to allow ORT to choose the default
+  int64_t max_thread_cache_bytes;         // use -1 to allow ORT to choose the default (0 = thread cache disabled)
+  int huge_pages;                         // use -1 to allow ORT to choose the default (0 = regular pages), see HugePages
 
   bool IsValid() {
     return arena_extend_strategy >= -1 && arena_extend_strategy <= 1 &&
            initial_chunk_size_bytes >= -1 &&
            max_dead_bytes_per_chunk >= -1 &&
            initial_growth_chunk_size_bytes >= -1 &&
-           max_power_of_two_extend_bytes >= -1;
+           max_power_of_two_extend_bytes >= -1 &&
+           max_thread_cache_bytes >= -1 &&
+           huge_pages >= -1 && huge_pages <= HugePages::k1GB;
   }
 
+  // values of huge_pages for CPU arenas. the explicit sizes fall back to transparent huge pages, and all of them to
+  // regular pages, when the OS has none left.
+  struct HugePages {
+    static constexpr int kNone = 0;
+    static constexpr int kTransparent = 1;
+    static constexpr int k2MB = 2;
+    static constexpr int k1GB = 3;
+  };
+
   // config key names that we parse in FromKeyValuePairs
   struct ConfigKeyNames {
     static constexpr const char* ArenaExtendStrategy = "arena.extend_strategy";
@@ -55,6 +72,8 @@ struct OrtArenaCfg {
     static constexpr const char* InitialGrowthChunkSizeBytes = "arena.initial_growth_chunk_size_bytes";
     static constexpr const char* MaxPowerOfTwoExtendBytes = "arena.max_power_of_two_extend_bytes";
     static constexpr const char* MaxMem = "arena.max_mem";
+    static constexpr const char* MaxThreadCacheBytes = "arena.max_thread_cache_bytes";
+    static constexpr const char* HugePages = "arena.huge_pages";
   };
 
   static onnxruntime::common::Status FromKeyValuePairs(const OrtKeyValuePairs& kvps, OrtArenaCfg& cfg);
@@ -121,6 +140,20 @@ class IAllocator {
 
   const OrtMemoryInfo& Info() const { return memory_info_; };
 
+  // IsStreamAware(), AllocOnStream() and ReleaseStreamBuffers() let a device allocator order its allocations with
+  // the work enqueued on a Stream, e.g. on top of a stream-ordered memory pool of the device API. Arena-based
+  // allocators get the same behavior from StreamAwareArena instead.
+  // By default, the allocator is not stream aware and AllocOnStream() just calls Alloc().
+  virtual bool IsStreamAware() const { return false; }
+
+  // Allocate memory usable by the work enqueued on stream after this call. The memory is freed in stream order, so
+  // Free() may be called as soon as the last work using it is enqueued on stream.
+  virtual void* AllocOnStream(size_t size, Stream* /*stream*/) { return Alloc(size); }
+
+  // Called when stream is about to be released. Memory allocated on it that is still in use must no longer be
+  // freed in its order.
+  virtual void ReleaseStreamBuffers(Stream* /*stream*/) {}
+
   // Each implementation of IAllocator can override and provide their own implementation
   virtual void GetStats(AllocatorStats* stats) {
     *stats = {};
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <mutex>
 #include <string_view>
+#include <unordered_map>
 
 #include "core/framework/op_kernel.h"
 
@@ -126,8 +128,25 @@ class KernelRegistry {
   static std::string GetMapKey(const KernelDef& kernel_def) {
     return GetMapKey(kernel_def.OpName(), kernel_def.Domain(), kernel_def.Provider());
   }
+
+  // Key of a lookup of the kernel of a node in lookup_cache_: the map key, the since version of the node, the number
+  // of actual args of each formal input and the interned type of each input and output.
+  static std::string GetLookupCacheKey(const Node& node, std::string_view provider);
+
   // Kernel create function map from op name to kernel creation info.
   // key is opname+domain_name+provider_name
   KernelCreateMap kernel_creator_fn_map_;
+
+  // Result of a lookup with a kernel_type_str_resolver: the matching kernel, or nullptr and the errors of the kernel
+  // defs that were rejected, which don't depend on the node beyond its lookup cache key.
+  struct LookupResult {
+    const KernelCreateInfo* kernel_create_info;
+    std::string verify_kernel_def_errors;
+  };
+
+  // Registries are usually shared by all the sessions using an EP, e.g. the CPU registry is a static, so the matching
+  // done for the nodes of one session is reused by every session created after it. Cleared by Register.
+  mutable std::mutex lookup_cache_mutex_;
+  mutable std::unordered_map<std::string, LookupResult> lookup_cache_;
 };
 }  // namespace onnxruntime
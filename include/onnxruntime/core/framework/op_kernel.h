@@ -130,6 +130,13 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to return true if UseSharedPrePackedBuffers() restores everything PrePack() sets up for
+  // input_idx, and the pre-packed weights depend only on the tensor, the node attributes and the session options.
+  // The session may then skip PrePack() and provide pre-packed weights persisted by an earlier session.
+  virtual bool CanUseSharedPrePackedBuffersWithoutPrePack(int /*input_idx*/) const {
+    return false;
+  }
+
   const OrtDevice GetDevice(OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
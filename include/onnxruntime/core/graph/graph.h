@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <filesystem>
 #include <functional>
 #include <limits>
@@ -171,7 +172,10 @@ class Node {
   @remarks Used during layout transformation for setting since version for layout transformed nodes with
   domain kMSNHWC.
   */
-  void SetSinceVersion(int since_version) noexcept { since_version_ = since_version; }
+  void SetSinceVersion(int since_version) noexcept {
+    since_version_ = since_version;
+    type_inference_needed_ = true;
+  }
 
 #if !defined(ORT_MINIMAL_BUILD)
   /** Gets the Node's OpSchema.
@@ -250,6 +254,7 @@ class Node {
 
   /** Gets a modifiable collection of the Node's implicit input definitions. */
   std::vector<NodeArg*>& MutableImplicitInputDefs() noexcept {
+    type_inference_needed_ = true;
     return definitions_.implicit_input_defs;
   }
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -258,15 +263,20 @@ class Node {
   /** Gets a modifiable count of arguments for each of the Node's explicit inputs.
   @todo This should be removed in favor of a method that updates the input args and the count.
         Currently these operations are separate which is not a good setup. */
-  std::vector<int>& MutableInputArgsCount() { return definitions_.input_arg_count; }
+  std::vector<int>& MutableInputArgsCount() {
+    type_inference_needed_ = true;
+    return definitions_.input_arg_count;
+  }
 
   /** Gets a modifiable collection of the Node's input definitions. */
   std::vector<NodeArg*>& MutableInputDefs() noexcept {
+    type_inference_needed_ = true;
     return definitions_.input_defs;
   }
 
   /** Gets a modifiable collection of the Node's output definitions. */
   std::vector<NodeArg*>& MutableOutputDefs() noexcept {
+    type_inference_needed_ = true;
     return definitions_.output_defs;
   }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -397,7 +407,10 @@ class Node {
   bool ClearAttribute(const std::string& attr_name);
 
   /** Gets the Node's mutable attributes. */
-  NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
+  NodeAttributes& GetMutableAttributes() noexcept {
+    type_inference_needed_ = true;
+    return attributes_;
+  }
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -612,6 +625,9 @@ class Node {
   const Definitions& GetDefinitions() const noexcept { return definitions_; }
   const Relationships& GetRelationships() const noexcept { return relationships_; }
 
+  bool TypeInferenceNeeded() const noexcept { return type_inference_needed_; }
+  void SetTypeInferenceNeeded(bool needed) noexcept { type_inference_needed_ = needed; }
+
   // Node index. Default to impossible value rather than 0.
   NodeIndex index_ = std::numeric_limits<NodeIndex>::max();
 
@@ -686,6 +702,10 @@ class Node {
 
   // Can be saved? The node cannot be saved anymore if removable attributes have been cleared.
   bool can_be_saved_;
+
+  // Whether the next Graph::Resolve must run type and shape inference on this Node. Set by the methods that may
+  // modify its definitions, attributes or op, and cleared once inference has run on it.
+  bool type_inference_needed_ = true;
 };
 
 /**
@@ -732,6 +752,12 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   */
   common::Status ReplaceInitializedTensor(const ONNX_NAMESPACE::TensorProto& new_initializer, const OrtValue& ort_value);
 
+  /** Moves the raw_data of the initializers larger than utils::kSmallTensorExternalDataThreshold, in this Graph and
+  its subgraphs, into OrtValues that own it, so that session state uses the loaded bytes rather than a copy of them.
+  The TensorProtos are updated to refer to the OrtValue data in memory.
+  */
+  common::Status MoveInitializerDataToOrtValues();
+
 #if !defined(DISABLE_EXTERNAL_INITIALIZERS)
   /** This function takes externally provided data for initializers with external data
    *    and replaces graph initializers with its content.
@@ -1340,12 +1366,16 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
 
   // Without removing the existing consumers, add a consumer to the give node arg name.
   void AddConsumerNode(const std::string& node_arg_name, Node* consumer) {
-    node_arg_to_consumer_nodes_[node_arg_name].insert(consumer->Index());
+    auto& consumers = node_arg_to_consumer_nodes_[node_arg_name];
+    if (std::find(consumers.begin(), consumers.end(), consumer->Index()) == consumers.end()) {
+      consumers.push_back(consumer->Index());
+    }
   }
 
   // Remove a consumer from the set
   void RemoveConsumerNode(const std::string& node_arg_name, Node* consumer) {
-    node_arg_to_consumer_nodes_[node_arg_name].erase(consumer->Index());
+    auto& consumers = node_arg_to_consumer_nodes_[node_arg_name];
+    consumers.erase(std::remove(consumers.begin(), consumers.end(), consumer->Index()), consumers.end());
   }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -1363,7 +1393,9 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
 
     nodes_for_arg.reserve(nodes.size());
     for (Node* node : nodes) {
-      nodes_for_arg.insert(node->Index());
+      if (std::find(nodes_for_arg.begin(), nodes_for_arg.end(), node->Index()) == nodes_for_arg.end()) {
+        nodes_for_arg.push_back(node->Index());
+      }
     }
   }
 
@@ -1701,6 +1733,14 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+  // Marks the NodeArg with the given name, if any, so type inference revisits its producer and consumers in the next
+  // Resolve, e.g. when the initializer it refers to changes.
+  void MarkNodeArgChanged(const std::string& node_arg_name) {
+    if (NodeArg* node_arg = GetNodeArg(node_arg_name); node_arg != nullptr) {
+      node_arg->changed_since_resolve_ = true;
+    }
+  }
+
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
   // Recursively find all subgraphs including nested subgraphs
@@ -1875,8 +1915,9 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   // node arg to its producer node
   std::unordered_map<std::string, NodeIndex> node_arg_to_producer_node_;
 
-  // node arg to its consumer nodes
-  std::unordered_map<std::string, std::unordered_set<NodeIndex>> node_arg_to_consumer_nodes_;
+  // node arg to its consumer nodes, each once, in the order they were added. A flat list rather than a hash set as
+  // most values have a handful of consumers.
+  std::unordered_map<std::string, InlinedVector<NodeIndex>> node_arg_to_consumer_nodes_;
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
   std::unordered_map<std::string, int> domain_to_version_;
@@ -130,5 +130,9 @@ class NodeArg {
 
   // Flag indicates whether <*this> node arg exists or not.
   bool exists_;
+
+  // Whether the type or shape changed since the last Graph::Resolve, so the nodes using <*this> node arg need type
+  // inference again.
+  bool changed_since_resolve_ = true;
 };
 }  // namespace onnxruntime
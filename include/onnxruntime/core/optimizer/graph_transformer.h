@@ -12,6 +12,10 @@
 
 namespace onnxruntime {
 
+namespace concurrency {
+class ThreadPool;
+}
+
 /**
 @class GraphTransformer
 
@@ -41,11 +45,28 @@ class GraphTransformer {
   */
   Status Apply(Graph& graph, bool& modified, const logging::Logger& logger) const;
 
+  /** Same as Apply, but if CanTransformSubgraphsInParallel() the subgraphs of the nodes of the Graph are transformed
+  in parallel on subgraph_thread_pool first, and then the Graph itself.
+  The result doesn't depend on the scheduling, but as the subgraphs are transformed before the Graph instead of
+  along with their nodes, it may differ from the result of Apply.
+  */
+  Status Apply(Graph& graph, bool& modified, const logging::Logger& logger,
+               concurrency::ThreadPool* subgraph_thread_pool) const;
+
   virtual bool ShouldOnlyApplyOnce() const { return false; }
 
+  /** Override to return true if ApplyImpl calls Recurse for every node, only reads the outer scope of a subgraph,
+  and can run concurrently on different subgraphs. */
+  virtual bool CanTransformSubgraphsInParallel() const { return false; }
+
  protected:
   /** Helper method to call ApplyImpl on any subgraphs in the Node. */
   Status Recurse(Node& node, bool& modified, int graph_level, const logging::Logger& logger) const {
+    if (graph_level == 0 && subgraphs_transformed_) {
+      // Apply transformed the subgraphs of the main graph in parallel already
+      return Status::OK();
+    }
+
     int subgraph_level = ++graph_level;
     for (auto& entry : node.GetAttributeNameToMutableSubgraphMap()) {
       auto& subgraph = *entry.second;
@@ -69,6 +90,9 @@ class GraphTransformer {
 
   const std::string name_;
   const InlinedHashSet<std::string_view> compatible_provider_types_;
+
+  // set while ApplyImpl runs on a main graph whose subgraphs were transformed in parallel
+  mutable bool subgraphs_transformed_ = false;
 };
 
 /**
@@ -39,7 +39,10 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <vector>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
 #if defined(__GNUC__)
@@ -48,6 +51,7 @@
 #pragma warning(pop)
 #endif
 #include "core/common/denormal.h"
+#include "core/common/hardware_counters.h"
 #include "core/common/inlined_containers_fwd.h"
 #include "core/common/spin_pause.h"
 #include "core/platform/ort_spin_lock.h"
@@ -221,7 +225,7 @@ class ThreadPoolProfiler {
   ThreadPoolProfiler(int, const CHAR_TYPE*) {}
   ~ThreadPoolProfiler() = default;
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolProfiler);
-  void Start() {}
+  void Start(bool) {}
   std::string Stop() { return "not available for minimal build"; }
   void LogStart() {}
   void LogEnd(ThreadPoolEvent) {}
@@ -229,7 +233,10 @@ class ThreadPoolProfiler {
   void LogStartAndCoreAndBlock(std::ptrdiff_t) {}
   void LogCoreAndBlock(std::ptrdiff_t) {}
   void LogThreadId(int) {}
+  void LogThreadDomain(int, int) {}
+  void LogRunStart(int) {}
   void LogRun(int) {}
+  void LogSteal(int, bool) {}
   std::string DumpChildThreadStat() { return {}; }
 };
 #else
@@ -247,7 +254,7 @@ class ThreadPoolProfiler {
   ~ThreadPoolProfiler();
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolProfiler);
   using Clock = std::chrono::high_resolution_clock;
-  void Start();                  // called by executor to start profiling
+  void Start(bool collect_hardware_counters);  // called by executor to start profiling
   std::string Stop();            // called by executor to stop profiling and return collected numbers
   void LogStart();               // called in main thread to record the starting time point
   void LogEnd(ThreadPoolEvent);  // called in main thread to calculate and save the time elapsed from last start point
@@ -255,8 +262,12 @@ class ThreadPoolProfiler {
   void LogStartAndCoreAndBlock(std::ptrdiff_t block_size);
   void LogCoreAndBlock(std::ptrdiff_t block_size);  // called in main thread to log core and block size for task breakdown
   void LogThreadId(int thread_idx);                 // called in child thread to log its id
+  void LogThreadDomain(int thread_idx, int dom);    // called on pool creation to log the steal domain of a child
+  void LogRunStart(int thread_idx);                 // called in child thread before it runs a task
   void LogRun(int thread_idx);                      // called in child thread to log num of run
+  void LogSteal(int thread_idx, bool is_remote);    // called in child thread to log a successful steal
   std::string DumpChildThreadStat();                // return all child statistics collected so far
+  std::string DumpStealDomainStat();                // return steal statistics aggregated by steal domain
 
  private:
   static const char* GetEventName(ThreadPoolEvent);
@@ -265,6 +276,8 @@ class ThreadPoolProfiler {
     int32_t core_ = -1;
     std::vector<std::ptrdiff_t> blocks_;  // block size determined by cost model
     std::vector<onnxruntime::TimePoint> points_;
+    onnxruntime::profiling::HardwareCounterValues hw_counters_at_start_;  // when profiling was started
+    bool hw_counters_at_start_valid_ = false;
     void LogCore();
     void LogBlockSize(std::ptrdiff_t block_size);
     void LogStart();
@@ -273,6 +286,7 @@ class ThreadPoolProfiler {
     std::string Reset();
   };
   bool enabled_ = false;
+  bool collect_hardware_counters_ = false;
   MainThreadStat& GetMainThreadStat();  // return thread local stat
   int num_threads_;
 #ifdef _MSC_VER
@@ -283,8 +297,15 @@ class ThreadPoolProfiler {
   struct ORT_ALIGN_TO_AVOID_FALSE_SHARING ChildThreadStat {
     std::thread::id thread_id_;
     uint64_t num_run_ = 0;
+    uint64_t num_local_steal_ = 0;   // tasks stolen from a thread in the same steal domain
+    uint64_t num_remote_steal_ = 0;  // tasks stolen from a thread in another steal domain
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
-    int32_t core_ = -1;  // core that the child thread is running on
+    int32_t core_ = -1;    // core that the child thread is running on
+    int32_t domain_ = -1;  // steal domain of the child thread, -1 if steal domains are not used
+    // hardware counters of the tasks run since profiling was started, and at the start of the running task
+    onnxruntime::profiling::HardwareCounterValues hw_counters_;
+    onnxruntime::profiling::HardwareCounterValues hw_counters_at_run_start_;
+    bool hw_counters_at_run_start_valid_ = false;
   };
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -336,7 +357,7 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
   // two loops execute in series in a parallel section. ]
   virtual void RunInParallel(std::function<void(unsigned idx)> fn,
                              unsigned n, std::ptrdiff_t block_size) = 0;
-  virtual void StartProfiling() = 0;
+  virtual void StartProfiling(bool collect_hardware_counters) = 0;
   virtual std::string StopProfiling() = 0;
 };
 
@@ -358,6 +379,10 @@ class ThreadPoolParallelSection {
   // and in the dispatcher.
   unsigned current_dop{0};
 
+  // Whether the tasks of the section go to the high priority queues,
+  // taken from the main thread when the section starts.
+  bool high_priority{false};
+
   // State shared between the main thread and worker threads
   // -------------------------------------------------------
 
@@ -721,8 +746,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   }
 
  public:
-  void StartProfiling() override {
-    profiler_.Start();
+  void StartProfiling(bool collect_hardware_counters) override {
+    profiler_.Start(collect_hardware_counters);
   }
 
   std::string StopProfiling() override {
@@ -772,6 +797,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        adaptive_spinning_(allow_spinning && thread_options.adaptive_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
@@ -789,6 +815,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       ComputeCoprimes(i, &all_coprimes_.back());
     }
 
+    InitializeStealDomains(thread_options);
+
     // Eigen::MaxSizeVector has neither essential exception safety features
     // such as swap, nor it is movable. So we have to join threads right here
     // on exception
@@ -819,7 +847,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     PerThread* pt = GetPerThread();
     int q_idx = Rand(&pt->rand) % num_threads_;
     WorkerData& td = worker_data_[q_idx];
-    Queue& q = td.queue;
+    Queue& q = GetQueue(td, pt->high_priority);
     fn = q.PushBack(std::move(fn));
     if (!fn) {
       // The queue accepted the work; ensure that the thread will pick it up
@@ -857,6 +885,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     ps.work_done = false;
     ps.tasks_revoked = 0;
     ps.current_dop = 1;
+    ps.high_priority = pt.high_priority;
     ps.active = true;
   }
 
@@ -884,7 +913,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     // not the dispatch task itself has started -- if it has not started
     // then it cannot have pushed tasks.
     if (ps.dispatch_q_idx != -1) {
-      Queue& q = worker_data_[ps.dispatch_q_idx].queue;
+      Queue& q = GetQueue(worker_data_[ps.dispatch_q_idx], ps.high_priority);
       if (q.RevokeWithTag(pt.tag, ps.dispatch_w_idx)) {
         if (!ps.dispatch_started.load(std::memory_order_acquire)) {
           // We successfully revoked a task, and saw the dispatch task
@@ -920,7 +949,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     unsigned tasks_started = static_cast<unsigned>(ps.tasks.size());
     while (!ps.tasks.empty()) {
       const auto& item = ps.tasks.back();
-      Queue& q = worker_data_[item.first].queue;
+      Queue& q = GetQueue(worker_data_[item.first], ps.high_priority);
       if (q.RevokeWithTag(pt.tag, item.second)) {
         ps.tasks_revoked++;
       }
@@ -1095,7 +1124,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       unsigned q_idx = preferred_workers[par_idx] % num_threads_;
       assert(q_idx < num_threads_);
       WorkerData& td = worker_data_[q_idx];
-      Queue& q = td.queue;
+      Queue& q = GetQueue(td, ps.high_priority);
       unsigned w_idx;
 
       // Attempt to enqueue the task
@@ -1208,7 +1237,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         profiler_.LogStart();
         ps.dispatch_q_idx = preferred_workers[current_dop] % num_threads_;
         WorkerData& dispatch_td = worker_data_[ps.dispatch_q_idx];
-        Queue& dispatch_que = dispatch_td.queue;
+        Queue& dispatch_que = GetQueue(dispatch_td, ps.high_priority);
 
         // assign dispatch task to selected dispatcher
         auto push_status = dispatch_que.PushBackWithTag(dispatch_task, pt.tag, ps.dispatch_w_idx);
@@ -1331,6 +1360,16 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     spin_loop_status_ = SpinLoopStatus::kIdle;
   }
 
+  // Set whether the work scheduled by the calling thread, and the tasks of
+  // the parallel sections it starts, go to the high priority queues of the
+  // pools.  Returns the previous setting.
+  static bool SetHighPriority(bool high_priority) {
+    PerThread* pt = GetPerThread();
+    const bool prev = pt->high_priority;
+    pt->high_priority = high_priority;
+    return prev;
+  }
+
  private:
   void ComputeCoprimes(int N, Eigen::MaxSizeVector<unsigned>* coprimes) {
     for (int i = 1; i <= N; i++) {
@@ -1375,6 +1414,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     int thread_id{-1};                // Worker thread index in pool.
     Tag tag{};                        // Work item tag used to identify this thread.
     bool leading_par_section{false};  // Leading a parallel section (used only for asserts)
+    bool high_priority{false};        // Work scheduled by this thread goes to the high priority queues
 
     // When this thread is entering a parallel section, it will
     // initially push work to this set of workers.  The aim is to
@@ -1389,11 +1429,17 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 #endif  // _MSC_VER
 
   struct WorkerData {
-    constexpr WorkerData() : thread(), queue() {
+    constexpr WorkerData() : thread(), queue(), high_priority_queue() {
     }
     std::unique_ptr<Thread> thread;
     Queue queue;
 
+    // Work scheduled by threads with PerThread::high_priority set.  The
+    // worker, and the threads stealing from it, take work from this queue
+    // before the other one, so high priority work overtakes the queued
+    // normal priority work at the next task boundary.
+    Queue high_priority_queue;
+
     // Each thread has a status, available read-only without locking, and protected
     // by the mutex field below for updates.  The status is used for three
     // purposes:
@@ -1495,12 +1541,18 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  const bool adaptive_spinning_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
 
+  // Steal domain index of each worker thread, and the worker threads in each steal domain.
+  // Both are empty if steal domains are not used.  See InitializeStealDomains.
+  std::vector<unsigned> worker_domain_;
+  std::vector<std::vector<unsigned>> domain_workers_;
+
   // SpinLoopStatus indicates whether the main worker spinning (inner) loop should exit immediately when there is
   // no work available (kIdle) or whether it should follow the configured spin-then-block policy (kBusy).
   // This lets the ORT session layer hint to the thread pool that it should stop spinning in between
@@ -1524,11 +1576,44 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     }
   }
 
+  // Spin budget of a worker thread with ThreadOptions::adaptive_spinning.  The worker keeps a moving
+  // average of how long it waited for work, and spins for about twice that.  When work arrives in
+  // quick succession, e.g. the parallel sections of the kernels of a run, the worker is still
+  // spinning when it does, so it doesn't pay the wake-up latency of blocking.  When the waits are
+  // longer than kMaxSpinNs, e.g. in between requests, the worker spins only kMinSpinNs before
+  // blocking, instead of burning a core for the full fixed spin count.
+  class AdaptiveSpin {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    // Number of iterations of the spin loop between two reads of the clock.
+    static constexpr int kClockCheckInterval = 16;
+
+    std::chrono::nanoseconds SpinDuration() const {
+      const double spin_ns = average_wait_ns_ <= kMaxSpinNs ? 2 * average_wait_ns_ : kMinSpinNs;
+      return std::chrono::nanoseconds(static_cast<int64_t>(std::clamp(spin_ns, kMinSpinNs, kMaxSpinNs)));
+    }
+
+    void RecordWait(Clock::duration wait) {
+      // Clamp the long waits so that the average recovers quickly once the work arrives frequently again.
+      const auto wait_ns = std::min(
+          static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count()), 2 * kMaxSpinNs);
+      average_wait_ns_ += kAverageWeight * (wait_ns - average_wait_ns_);
+    }
+
+   private:
+    // Bounds of the spin duration, the upper one is a few times the wake-up latency of a blocked thread.
+    static constexpr double kMinSpinNs = 2e3;
+    static constexpr double kMaxSpinNs = 5e5;
+    static constexpr double kAverageWeight = 0.125;
+
+    double average_wait_ns_ = 0;
+  };
+
   // Main worker thread loop.
   void WorkerLoop(int thread_id) {
     PerThread* pt = GetPerThread();
     WorkerData& td = worker_data_[thread_id];
-    Queue& q = td.queue;
     bool should_exit = false;
     pt->pool = this;
     pt->thread_id = thread_id;
@@ -1539,24 +1624,39 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     const int spin_count = allow_spinning_ ? (1ull << log2_spin) : 0;
     const int steal_count = spin_count / 100;
 
+    AdaptiveSpin adaptive_spin;
+
     SetDenormalAsZero(set_denormal_as_zero_);
     profiler_.LogThreadId(thread_id);
 
     while (!should_exit) {
-      Task t = q.PopFront();
+      // Whether t was taken from a high priority queue
+      bool high_priority = false;
+      Task t = PopFront(td, high_priority);
       if (!t) {
+        AdaptiveSpin::Clock::time_point wait_start;
+        std::chrono::nanoseconds spin_duration{0};
+        if (adaptive_spinning_) {
+          wait_start = AdaptiveSpin::Clock::now();
+          spin_duration = adaptive_spin.SpinDuration();
+        }
+
         // Spin waiting for work.
         for (int i = 0; i < spin_count && !done_; i++) {
           if (((i + 1) % steal_count == 0)) {
-            t = Steal(StealAttemptKind::TRY_ONE);
+            t = Steal(StealAttemptKind::TRY_ONE, high_priority);
           } else {
-            t = q.PopFront();
+            t = PopFront(td, high_priority);
           }
           if (t) break;
 
           if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
             break;
           }
+          if (adaptive_spinning_ && (i + 1) % AdaptiveSpin::kClockCheckInterval == 0 &&
+              AdaptiveSpin::Clock::now() - wait_start >= spin_duration) {
+            break;
+          }
           onnxruntime::concurrency::SpinPause();
         }
 
@@ -1581,7 +1681,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
                     //
                     // If #A if after #2 then #B will see #1, and we abandon blocking
                     assert(!t);
-                    t = q.PopFront();
+                    t = PopFront(td, high_priority);
                     if (t) {
                       should_block = false;
                     }
@@ -1625,14 +1725,22 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           // Thread just unblocked.  Unless we picked up work while
           // blocking, or are exiting, then either work was pushed to
           // us, or it was pushed to an overloaded queue
-          if (!t) t = q.PopFront();
-          if (!t) t = Steal(StealAttemptKind::TRY_ALL);
+          if (!t) t = PopFront(td, high_priority);
+          if (!t) t = Steal(StealAttemptKind::TRY_ALL, high_priority);
+        }
+
+        if (adaptive_spinning_ && t) {
+          adaptive_spin.RecordWait(AdaptiveSpin::Clock::now() - wait_start);
         }
       }
 
       if (t) {
         td.SetActive();
+        // Work scheduled by a high priority task is high priority too
+        pt->high_priority = high_priority;
+        profiler_.LogRunStart(thread_id);
         t();
+        pt->high_priority = false;
         profiler_.LogRun(thread_id);
         td.SetSpinning();
       }
@@ -1651,9 +1759,38 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // is that the thread is busy with other work, and we will avoid
   // "snatching" work from a thread which is just about to notice the
   // work itself.
+  //
+  // If the pool has steal domains, a thread first tries the threads in
+  // its own domain (e.g. sharing its L3 cache), and only then walks
+  // over all threads.
 
-  Task Steal(StealAttemptKind steal_kind) {
+  Task Steal(StealAttemptKind steal_kind, bool& high_priority) {
     PerThread* pt = GetPerThread();
+    const bool use_domains = !domain_workers_.empty() && pt->pool == this;
+    const unsigned thief_domain = use_domains ? worker_domain_[pt->thread_id] : 0;
+
+    if (use_domains) {
+      const auto& local_workers = domain_workers_[thief_domain];
+      unsigned size = static_cast<unsigned>(local_workers.size());
+      unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
+      unsigned r = Rand(&pt->rand);
+      unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
+      unsigned victim = r % size;
+
+      for (unsigned i = 0; i < num_attempts; i++) {
+        assert(victim < size);
+        Task t = TryStealFrom(local_workers[victim], high_priority);
+        if (t) {
+          profiler_.LogSteal(pt->thread_id, false);
+          return t;
+        }
+        victim += inc;
+        if (victim >= size) {
+          victim -= size;
+        }
+      }
+    }
+
     unsigned size = num_threads_;
     unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
     unsigned r = Rand(&pt->rand);
@@ -1662,11 +1799,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
     for (unsigned i = 0; i < num_attempts; i++) {
       assert(victim < size);
-      if (worker_data_[victim].GetStatus() == WorkerData::ThreadStatus::Active) {
-        Task t = worker_data_[victim].queue.PopBack();
-        if (t) {
-          return t;
-        }
+      Task t = TryStealFrom(victim, high_priority);
+      if (t) {
+        profiler_.LogSteal(pt->thread_id, use_domains && worker_domain_[victim] != thief_domain);
+        return t;
       }
       victim += inc;
       if (victim >= size) {
@@ -1677,6 +1813,76 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return Task();
   }
 
+  Task TryStealFrom(unsigned victim, bool& high_priority) {
+    WorkerData& td = worker_data_[victim];
+    if (td.GetStatus() == WorkerData::ThreadStatus::Active) {
+      Task t = td.high_priority_queue.PopBack();
+      high_priority = static_cast<bool>(t);
+      if (!t) {
+        t = td.queue.PopBack();
+      }
+      return t;
+    }
+    return Task();
+  }
+
+  // Take the next task of a worker, from its high priority queue first.
+  Task PopFront(WorkerData& td, bool& high_priority) {
+    Task t = td.high_priority_queue.PopFront();
+    high_priority = static_cast<bool>(t);
+    if (!t) {
+      t = td.queue.PopFront();
+    }
+    return t;
+  }
+
+  static Queue& GetQueue(WorkerData& td, bool high_priority) {
+    return high_priority ? td.high_priority_queue : td.queue;
+  }
+
+  // Group the worker threads into steal domains based on the logical processors they are affinitized to.  Steal
+  // domains are only used if every worker thread has an affinity, the environment knows the domain of each of them,
+  // and there is more than one domain.
+  void InitializeStealDomains(const ThreadOptions& thread_options) {
+    if (thread_options.affinities.size() < num_threads_) {
+      return;
+    }
+
+    std::vector<int> domain_ids;  // environment domain id for each domain index
+    std::vector<unsigned> worker_domain(num_threads_);
+    std::vector<std::vector<unsigned>> domain_workers;
+    for (unsigned i = 0; i < num_threads_; ++i) {
+      const auto& affinity = thread_options.affinities[i];
+      if (affinity.empty()) {
+        return;
+      }
+
+      const int domain_id = env_.GetLogicalProcessorDomainId(affinity.front());
+      if (domain_id < 0) {
+        return;
+      }
+
+      auto it = std::find(domain_ids.begin(), domain_ids.end(), domain_id);
+      const auto domain = static_cast<unsigned>(it - domain_ids.begin());
+      if (it == domain_ids.end()) {
+        domain_ids.push_back(domain_id);
+        domain_workers.emplace_back();
+      }
+      worker_domain[i] = domain;
+      domain_workers[domain].push_back(i);
+    }
+
+    if (domain_workers.size() <= 1) {
+      return;
+    }
+
+    worker_domain_ = std::move(worker_domain);
+    domain_workers_ = std::move(domain_workers);
+    for (unsigned i = 0; i < num_threads_; ++i) {
+      profiler_.LogThreadDomain(static_cast<int>(i), static_cast<int>(worker_domain_[i]));
+    }
+  }
+
   int NonEmptyQueueIndex() {
     PerThread* pt = GetPerThread();
     const unsigned size = static_cast<unsigned>(worker_data_.size());
@@ -1684,7 +1890,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
     unsigned victim = r % size;
     for (unsigned i = 0; i < size; i++) {
-      if (!worker_data_[victim].queue.Empty()) {
+      if (!worker_data_[victim].queue.Empty() || !worker_data_[victim].high_priority_queue.Empty()) {
         return victim;
       }
       victim += inc;
@@ -20,6 +20,8 @@ limitations under the License.
 #include <vector>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include "core/common/common.h"
 #include "core/platform/env.h"
 
@@ -213,6 +215,57 @@ class ThreadPool {
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelSection);
   };
 
+  // Adaptive inline thresholds
+  //
+  // The cost model of TryParallelFor dispatches loops whose work only
+  // takes a few microseconds, where handing off the work to the pool
+  // (RunInParallel, waking up or spinning threads) takes longer than
+  // the work itself.  If the pool is created with
+  // ThreadOptions::adaptive_inline_threshold, the loops run inside a
+  // LoopOwnerScope measure their time, and each owner (a kernel)
+  // learns the total cost below which its loops run in the calling
+  // thread.  The learned threshold of the current owner is reported
+  // with the thread scheduling stats of StopProfiling().
+  //
+  // Scopes may be nested; the innermost scope owns the loops.
+
+  // The statistics of the loops of an owner, defined in threadpool.cc.
+  struct LoopStats;
+
+  class LoopOwnerScope {
+   public:
+    // owner identifies the loops across runs, e.g. the kernel running them.
+    LoopOwnerScope(ThreadPool* tp, const void* owner);
+    ~LoopOwnerScope();
+
+   private:
+    LoopStats* prev_stats_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(LoopOwnerScope);
+  };
+
+  // Priority lanes
+  //
+  // Each worker of the pools has a second, high priority queue.  The
+  // work scheduled by a thread inside a PriorityScope with high_priority
+  // set, including the tasks of its parallel loops, goes to those queues.
+  // The workers take the work of the high priority queues first, so the
+  // latency-critical work overtakes the queued normal priority work at
+  // the next task boundary, while the normal priority work runs on the
+  // workers left idle.  Running tasks are not preempted.
+  //
+  // The scope applies to all the pools the calling thread schedules work
+  // on, e.g. the intra-op and inter-op pools of a session run.  Scopes may
+  // be nested; the innermost scope sets the priority.
+  class PriorityScope {
+   public:
+    explicit PriorityScope(bool high_priority);
+    ~PriorityScope();
+
+   private:
+    bool prev_high_priority_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PriorityScope);
+  };
+
   // The below API allows to disable spinning
   // This is used to support real-time scenarios where
   // spinning between relatively infrequent requests
@@ -363,7 +416,9 @@ class ThreadPool {
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(ThreadPool);
 
   // StartProfiling and StopProfiling are not to be consumed as public-facing API
-  static void StartProfiling(concurrency::ThreadPool* tp);
+  // With collect_hardware_counters, the stats of each pool thread include the hardware counters of the tasks it ran,
+  // see ReadThreadHardwareCounters().
+  static void StartProfiling(concurrency::ThreadPool* tp, bool collect_hardware_counters = false);
   static std::string StopProfiling(concurrency::ThreadPool* tp);
 
  private:
@@ -411,7 +466,7 @@ class ThreadPool {
 
   void Schedule(std::function<void()> fn);
 
-  void StartProfiling();
+  void StartProfiling(bool collect_hardware_counters);
 
   std::string StopProfiling();
 
@@ -428,6 +483,12 @@ class ThreadPool {
 
   // Force the thread pool to run in hybrid mode on a normal cpu.
   bool force_hybrid_ = false;
+
+  // The loop statistics of each LoopOwnerScope owner, if thread_options_.adaptive_inline_threshold is set.
+  // Looked up once per scope rather than per loop.
+  LoopStats* GetLoopStats(const void* owner);
+  std::mutex loop_stats_mutex_;
+  std::unordered_map<const void*, std::unique_ptr<LoopStats>> loop_stats_;
 };
 
 }  // namespace concurrency
@@ -40,4 +40,7 @@ struct OrtCUDAProviderOptionsV2 {
   int use_tf32 = 1;                                                                                            // use TF32
   int fuse_conv_bias = 0;                                                                                      // Enable CUDNN Frontend kernel fusing, results in JIT compiles
   int sdpa_kernel = 0;                                                                                         // Scaled Dot Product Attention kernel option
+  int use_cuda_mempool = 0;                                                                                    // allocate from a stream-ordered CUDA memory pool instead of the BFC Arena
+  size_t cuda_mempool_release_threshold = std::numeric_limits<size_t>::max();                                  // bytes of freed memory the CUDA memory pool keeps cached
+  size_t external_data_load_chunk_size = 0;                                                                    // load external initializers to the device through pinned chunks of this size, 0 to disable
 };
@@ -92,4 +92,7 @@ struct OrtTensorRTProviderOptionsV2 {
   const char* trt_engine_cache_prefix{nullptr};  // specify engine cache prefix
   int trt_engine_hw_compatible{0};               // Enable hardware compatibility. Default 0 = false, nonzero = true
   const char* trt_op_types_to_exclude{};         // Exclude specific ops from running on TRT.
+  int trt_engine_async_build{0};                 // Build engines for input shapes outside the engine profile in the
+                                                 // background and run the subgraph with CUDA EP until they are ready.
+                                                 // Default 0 = false, nonzero = true
 };
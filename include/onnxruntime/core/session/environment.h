@@ -6,8 +6,10 @@
 #include <atomic>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 #include "core/common/common.h"
 #include "core/common/basic_types.h"
@@ -15,6 +17,7 @@
 #include "core/common/status.h"
 #include "core/framework/allocator.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/platform/device_discovery.h"
 #include "core/platform/threadpool.h"
 
@@ -86,6 +89,47 @@ class Environment {
     return create_global_thread_pools_;
   }
 
+  /**
+   * A named pair of intra and inter op thread pools owned by the environment.
+   * Sessions that do not use per session threads bind to a partition with the
+   * kOrtSessionOptionsConfigThreadPoolPartition config entry instead of using the global thread pools.
+   */
+  struct ThreadPoolPartition {
+    std::basic_string<ORTCHAR_T> intra_op_thread_pool_name;
+    std::basic_string<ORTCHAR_T> inter_op_thread_pool_name;
+    std::unique_ptr<onnxruntime::concurrency::ThreadPool> intra_op_thread_pool;
+    std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool;
+  };
+
+  /**
+   * Create a named thread pool partition, typically with thread affinities restricted to the logical processors of
+   * a single NUMA node so that one model replica per node can run in the same process.
+   * Partitions live for the lifetime of the environment.
+   * Return an error if a partition with the same name is already registered.
+   * @param name name the sessions use to bind to the partition.
+   * @param tp_options set of parameters controlling the intra and inter op thread pools of the partition.
+   */
+  Status RegisterThreadPoolPartition(const std::string& name, const OrtThreadingOptions& tp_options);
+
+  /**
+   * Returns the thread pool partition registered with the given name, or nullptr if there is none.
+   */
+  const ThreadPoolPartition* GetThreadPoolPartition(const std::string& name) const;
+
+  /**
+   * Returns the thread pool that initializes the sessions created with OrtApi::CreateSessionAsync.
+   * The pool is created on first use and its threads don't spin, as they are idle most of the time.
+   */
+  onnxruntime::concurrency::ThreadPool* GetSessionInitThreadPool() const;
+
+  /**
+   * Returns the store of the initializers shared by content between the sessions that set
+   * kOrtSessionOptionsShareInitializersByContent.
+   */
+  SharedInitializerStore& GetSharedInitializerStore() const {
+    return shared_initializer_store_;
+  }
+
   /**
    * Registers an allocator for sharing between multiple sessions.
    * Return an error if an allocator with the same OrtMemoryInfo is already registered.
@@ -166,6 +210,17 @@ class Environment {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
   bool create_global_thread_pools_{false};
 
+  // named thread pool partitions. see RegisterThreadPoolPartition.
+  std::unordered_map<std::string, std::unique_ptr<ThreadPoolPartition>> thread_pool_partitions_;
+  mutable std::mutex thread_pool_partitions_mutex_;
+
+  // see GetSessionInitThreadPool.
+  mutable std::unique_ptr<onnxruntime::concurrency::ThreadPool> session_init_thread_pool_;
+  mutable std::once_flag session_init_thread_pool_once_;
+
+  // see GetSharedInitializerStore. it is internally synchronized.
+  mutable SharedInitializerStore shared_initializer_store_;
+
   std::mutex mutex_;
 
   // shared allocators from various sources.
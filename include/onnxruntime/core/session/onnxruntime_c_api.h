@@ -321,6 +321,7 @@ ORT_RUNTIME_CLASS(ModelCompilationOptions);
 ORT_RUNTIME_CLASS(HardwareDevice);
 ORT_RUNTIME_CLASS(EpDevice);
 ORT_RUNTIME_CLASS(KeyValuePairs);
+ORT_RUNTIME_CLASS(PreparedRun);
 
 #ifdef _MSC_VER
 typedef _Return_type_success_(return == 0) OrtStatus* OrtStatusPtr;
@@ -367,6 +368,9 @@ typedef struct OrtAllocator {
    * - NumArenaExtensions: Number of arena extensions (Relevant only for arena based allocators)
    * - NumArenaShrinkages: Number of arena shrinkages (Relevant only for arena based allocators)
    * - MaxAllocSize: The max single allocation seen.
+   * - NumThreadCacheHits: Number of allocations served from the arena thread cache (Relevant only for arena based
+   *   allocators with max_thread_cache_bytes set)
+   * - ThreadCacheBytes: Number of bytes currently held in the arena thread cache. These bytes are included in InUse.
    *
    * NOTE: If the allocator does not implement this function, the OrtKeyValuePairs instance will be empty.
    */
@@ -853,6 +857,51 @@ typedef OrtStatus*(ORT_API_CALL* RegisterCustomOpsFn)(OrtSessionOptions* options
  */
 typedef void (*RunAsyncCallbackFn)(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status);
 
+/** \brief Callback function for CreateSessionAsync
+ *
+ * \param[in] user_data User specific data that passed back to the callback
+ * \param[out] session On succeed, the initialized session, which must be freed with OrtApi::ReleaseSession.
+ *             On error, the value will be nullptr
+ * \param[out] status On error, status will provide details, and must be freed with OrtApi::ReleaseStatus
+ */
+typedef void (*CreateSessionAsyncCallbackFn)(void* user_data, OrtSession* session, OrtStatusPtr status);
+
+/** \brief Progress callback function for CreateSessionAsync
+ *
+ * Called from the initialization thread as each phase of the session initialization completes.
+ *
+ * \param[in] user_data User specific data that passed back to the callback
+ * \param[in] phase Null terminated name of the completed phase:
+ *   "model_loaded" once the model is loaded,
+ *   "graph_partitioned" once the graph is optimized and partitioned between the execution providers,
+ *   "session_state_finalized" once the kernels are created and the initializers are loaded and pre-packed.
+ */
+typedef void (*CreateSessionAsyncProgressFn)(void* user_data, const char* phase);
+
+/** \brief Callback function receiving the tracing spans of the runs of a session
+ *
+ * Called as each span ends, on the thread that ran it. Concurrent runs and the inter-op threads of a run emit spans at
+ * the same time, so the callback must be thread safe. It should return quickly, as it delays the run.
+ *
+ * \param[in] user_data User specific data passed to OrtApi::SessionOptionsSetTracingCallback
+ * \param[in] name Null terminated name of the span:
+ *   "Run" for a run of the session,
+ *   "ExecuteGraph" for the execution of the graph of a run, or of the subgraph of a control flow node,
+ *   "NodeGroup" for a sequence of nodes of one device run back to back by the execution of a graph,
+ *   "RunAsync" for a run through OrtApi::RunAsync, whose "RunAsyncQueue" child is the time it waited for a thread.
+ * \param[in] detail Null terminated details of the span: the graph name for "ExecuteGraph", the device and stream for
+ *   "NodeGroup", and empty otherwise.
+ * \param[in] run_tag Null terminated run tag of the run, see OrtApi::RunOptionsSetRunTag. It can carry the id of the
+ *   request trace the run belongs to.
+ * \param[in] span_id Identifier of the span, unique within the process. Never 0.
+ * \param[in] parent_span_id Identifier of the span enclosing the span, 0 for a "Run" or "RunAsync" span.
+ * \param[in] start_time_ns Start time of the span, in nanoseconds since the Unix epoch.
+ * \param[in] end_time_ns End time of the span, in nanoseconds since the Unix epoch.
+ */
+typedef void (*OrtTracingSpanFn)(void* user_data, const char* name, const char* detail, const char* run_tag,
+                                 uint64_t span_id, uint64_t parent_span_id, int64_t start_time_ns,
+                                 int64_t end_time_ns);
+
 /** \brief The C API
  *
  * All C API functions are defined inside this structure as pointers to functions.
@@ -2938,6 +2987,14 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "max_thread_cache_bytes": Maximum bytes of small freed chunks each thread cache shard may hold so that
+   *  small Alloc/Free pairs can be served without taking the arena lock. Use 0 (or -1 for the default) to
+   *  disable the cache.
+   * "huge_pages": Page size of the memory regions of a CPU arena: 0 = regular pages, 1 = transparent huge pages,
+   *  2 = 2 MB huge pages, 3 = 1 GB huge pages. Regions smaller than a huge page, or that the OS has no huge pages
+   *  left for, use transparent huge pages or regular pages instead. Explicit huge pages must be reserved by the
+   *  administrator, e.g. in /proc/sys/vm/nr_hugepages on Linux; on Windows only 2 MB pages are supported and they
+   *  need the "Lock pages in memory" privilege. Use -1 for the default of regular pages.
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -6086,6 +6143,246 @@ struct OrtApi {
    * \since Version 1.23.
    */
   ORT_API2_STATUS(GetSessionOptionsConfigEntries, _In_ const OrtSessionOptions* options, _Outptr_ OrtKeyValuePairs** out);
+
+  /** \brief Register a named thread pool partition with the OrtEnv.
+   *
+   * A partition is a pair of intra and inter op thread pools owned by the env, in addition to the global thread
+   * pools. Sessions bind to it by disabling per session threads (OrtApi::DisablePerSessionThreads) and setting the
+   * "session.thread_pool_partition" session config entry to the partition name.
+   * Restricting the thread affinities of each partition to the logical processors of one NUMA node
+   * (see OrtApi::SetGlobalIntraOpThreadAffinity) allows running one model replica per node in the same process.
+   *
+   * \param[in] env The OrtEnv instance to register the partition with.
+   * \param[in] partition_name Name of the partition. Must be unique within the env.
+   * \param[in] tp_options Options for the partition's thread pools.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(RegisterThreadPoolPartition, _In_ OrtEnv* env, _In_ const char* partition_name,
+                  _In_ const OrtThreadingOptions* tp_options);
+
+  /** \brief Get the latency statistics of each node of the session.
+   *
+   * The statistics are only collected when the "session.profiling_node_stats" session config entry is "1".
+   * They cover all the runs since the session was created and can be queried while other threads run the session.
+   *
+   * The result is a JSON array with one object per node, ordered by decreasing total time:
+   * `[{"name" : "node", "count" : 10, "total_us" : 52.1, "mean_us" : 5.21, "min_us" : 4.9, "max_us" : 7.3,
+   * "p50_us" : 5.1, "p99_us" : 7.2}, ...]`
+   * The percentiles are interpolated within power of 2 histogram buckets.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string.
+   * \param[out] out Null terminated JSON string. Must be freed with `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(SessionGetProfilingNodeStats, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the memory high-water mark of each node of the session.
+   *
+   * The stats are only collected when the "session.collect_node_memory_stats" session config entry is "1".
+   * For each node they describe its latest execution, measured in the allocator of the node's device, so calling this
+   * after OrtApi::Run returns the stats of that run when the session isn't run concurrently.
+   *
+   * The result is a JSON array with one object per node, ordered by decreasing peak bytes in use:
+   * `[{"name" : "node", "peak_bytes_in_use" : 4096, "bytes_in_use_delta" : 1024, "dynamic_output_bytes" : 1024,
+   * "peak_temp_bytes" : 512, "total_temp_bytes" : 768, "max_peak_bytes_in_use" : 4096}, ...]`
+   * where max_peak_bytes_in_use is the largest peak_bytes_in_use of the node over all the runs of the session.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string.
+   * \param[out] out Null terminated JSON string. Must be freed with `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(SessionGetNodeMemoryStats, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get the current value of a state tensor of the session.
+   *
+   * The state tensors are set with the "session.stateful_tensors" session config entry. Each run feeds the graph
+   * output of a state to its graph input in the next run, keeping the value on the device that consumes it.
+   *
+   * The returned OrtValue shares the buffer of the state, on that device. The next run replaces the state with a new
+   * value rather than writing to this buffer.
+   *
+   * \param[in] session
+   * \param[in] name Name of the graph input or of the graph output of the state.
+   * \param[out] out The state, which must be freed with OrtApi::ReleaseValue, or nullptr if the state has no value
+   *   yet: before the first run, or after OrtApi::SessionResetStatefulTensors.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(SessionGetStatefulTensor, _In_ const OrtSession* session, _In_ const char* name,
+                  _Outptr_result_maybenull_ OrtValue** out);
+
+  /** \brief Drop the values of all the state tensors of the session, to start a new stream.
+   *
+   * The next run must feed the initial value of every state input.
+   *
+   * \param[in] session
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(SessionResetStatefulTensors, _Inout_ OrtSession* session);
+
+  /** \brief Create an OrtSession from a model file without blocking the caller.
+   *
+   * Returns once the initialization is scheduled. The model is loaded and the session initialized, as with
+   * OrtApi::CreateSession, on a thread owned by the environment, which then invokes `callback` with the session or
+   * the error. Several sessions may be initialized at the same time.
+   *
+   * `options` are copied, so they may be released once this returns. `env` must outlive the initialization.
+   *
+   * \param[in] env
+   * \param[in] model_path
+   * \param[in] options
+   * \param[in] progress_callback Optional callback invoked as each phase of the initialization completes.
+   * \param[in] callback Callback invoked once the session is initialized or the initialization failed.
+   * \param[in] user_data User data passed back to `progress_callback` and `callback`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(CreateSessionAsync, _In_ const OrtEnv* env, _In_ const ORTCHAR_T* model_path,
+                  _In_ const OrtSessionOptions* options, _In_opt_ CreateSessionAsyncProgressFn progress_callback,
+                  _In_ CreateSessionAsyncCallbackFn callback, _In_opt_ void* user_data);
+
+  /** \brief Warm up a session with runs of zero-filled inputs.
+   *
+   * The first runs of a session are slower than the next ones, as they extend the arenas, touch the pages of their
+   * buffers, spin up the threads and fill the caches of the kernels and execution providers. Each warm-up run feeds
+   * zero-filled CPU tensors to all the graph inputs and discards the outputs. The arenas keep the memory they were
+   * extended with for the real runs. The state tensors of the session are reset afterwards.
+   *
+   * The "session.warm_up_runs" session config entry runs the warm-up at the end of the session initialization.
+   *
+   * \param[in] session
+   * \param[in] dim_params Array of null terminated names of symbolic dimensions of the graph inputs.
+   * \param[in] dim_values Array of the values of the symbolic dimensions. The dimensions that are not listed are 1.
+   * \param[in] num_dims Number of elements in the dim_params and dim_values arrays.
+   * \param[in] num_runs Number of warm-up runs.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(SessionWarmUp, _Inout_ OrtSession* session, _In_reads_(num_dims) const char* const* dim_params,
+                  _In_reads_(num_dims) const int64_t* dim_values, size_t num_dims, size_t num_runs);
+
+  /** \brief Create an OrtLoraAdapter that stacks the parameters of several adapters.
+   *
+   * Each parameter of the new adapter stacks the parameter with the same name of the adapters along a new first
+   * dimension, in the order of the adapters. It is meant for models serving a batch in which each entry uses its own
+   * adapter, e.g. with the com.microsoft.BatchedLoraMatMul operator selecting the adapter of each entry by index.
+   * The stacked adapter stays active between runs, so switching the adapters of the batch entries only changes the
+   * index input and doesn't copy any weights.
+   *
+   * The adapters must have the same parameters, with the same types and shapes. They can be released once the
+   * stacked adapter is created.
+   *
+   * \param[in] adapters Array of the OrtLoraAdapter instances to stack.
+   * \param[in] num_adapters Number of elements in the adapters array.
+   * \param[in] allocator optional pointer to a device allocator. If specified, the stacked parameters are copied
+   *            to the device once. If nullptr, the stacked parameters stay on CPU.
+   * \param[out] out A pointer to a newly created OrtLoraAdapter instance. Must be released with
+   *                  OrtApi::ReleaseLoraAdapter.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(CreateLoraAdapterStack, _In_reads_(num_adapters) const OrtLoraAdapter* const* adapters,
+                  size_t num_adapters, _In_opt_ OrtAllocator* allocator, _Outptr_ OrtLoraAdapter** out);
+
+  /** \brief Resolve the inputs and outputs of repeated runs with the same input and output names.
+   *
+   * OrtApi::Run looks up the input and output names and validates the input values on each call. A run with an
+   * OrtPreparedRun, see OrtApi::RunPrepared, uses the names resolved when it was created, and only validates an input
+   * again if its type or shape differs from the input the OrtPreparedRun was created with. This reduces the overhead
+   * of each run for small models run at a high rate.
+   *
+   * The OrtPreparedRun is updated by each run, so it must not be used by concurrent runs. Create one per thread to
+   * run the session concurrently.
+   *
+   * \param[in] session
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] inputs Array of representative input values, which are validated. A later run with inputs of the same
+   *            types and shapes doesn't validate them again.
+   * \param[in] input_len Number of elements in the input_names and inputs arrays
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names array
+   * \param[out] out A pointer to a newly created OrtPreparedRun instance. Must be released with
+   *                 OrtApi::ReleasePreparedRun before the session is released.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(CreatePreparedRun, _In_ const OrtSession* session,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Outptr_ OrtPreparedRun** out);
+
+  /** \brief Run the model with the inputs and outputs of an OrtPreparedRun
+   *
+   * Same as OrtApi::Run with the input and output names of the OrtPreparedRun.
+   *
+   * LoRA adapters activated in the run options are not applied, as they add inputs to the run.
+   *
+   * \param[in] session The session the OrtPreparedRun was created for
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+   * \param[in] prepared_run
+   * \param[in] inputs Array of input values in the order of the input names of the OrtPreparedRun
+   * \param[in] input_len Number of elements in the inputs array
+   * \param[in,out] outputs Array of output values in the order of the output names of the OrtPreparedRun.
+   *                Entries can be nullptr, in which case they are filled with values allocated by ORT.
+   * \param[in] output_len Number of elements in the outputs array
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(RunPrepared, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _Inout_ OrtPreparedRun* prepared_run, _In_reads_(input_len) const OrtValue* const* inputs,
+                  size_t input_len, _Inout_updates_all_(output_len) OrtValue** outputs, size_t output_len);
+
+  /** \brief Release an OrtPreparedRun instance.
+   *
+   * \since Version 1.23.
+   */
+  ORT_CLASS_RELEASE(PreparedRun);
+
+  /** \brief Set a callback receiving the tracing spans of the runs of the sessions created with the options.
+   *
+   * The spans link the latency of the runs to the traces of the requests served by an application, through the run
+   * tag of the runs. Each run emits a "Run" span, with an "ExecuteGraph" child whose children are "NodeGroup" spans,
+   * see ::OrtTracingSpanFn. Without a callback, the spans cost a thread local read per graph execution.
+   *
+   * \param[in] options
+   * \param[in] tracing_callback Callback receiving the spans. nullptr disables tracing.
+   * \param[in] user_data User data passed back to `tracing_callback`. Must outlive the sessions.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(SessionOptionsSetTracingCallback, _Inout_ OrtSessionOptions* options,
+                  _In_opt_ OrtTracingSpanFn tracing_callback, _In_opt_ void* user_data);
 };
 
 /*
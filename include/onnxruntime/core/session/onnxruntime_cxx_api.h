@@ -574,6 +574,7 @@ ORT_DEFINE_RELEASE(Node);
 ORT_DEFINE_RELEASE(Graph);
 ORT_DEFINE_RELEASE(Model);
 ORT_DEFINE_RELEASE(KeyValuePairs)
+ORT_DEFINE_RELEASE(PreparedRun);
 ORT_DEFINE_RELEASE_FROM_API_STRUCT(ModelCompilationOptions, GetCompileApi);
 ORT_DEFINE_RELEASE_FROM_API_STRUCT(EpDevice, GetEpApi);
 
@@ -880,6 +881,8 @@ struct Env : detail::Base<OrtEnv> {
   Env& RegisterExecutionProviderLibrary(const char* registration_name, const std::basic_string<ORTCHAR_T>& path);  ///< Wraps OrtApi::RegisterExecutionProviderLibrary
   Env& UnregisterExecutionProviderLibrary(const char* registration_name);                                          ///< Wraps OrtApi::UnregisterExecutionProviderLibrary
 
+  Env& RegisterThreadPoolPartition(const char* partition_name, const OrtThreadingOptions* tp_options);  ///< Wraps OrtApi::RegisterThreadPoolPartition
+
   std::vector<ConstEpDevice> GetEpDevices() const;
 };
 
@@ -923,6 +926,15 @@ struct LoraAdapter : detail::Base<OrtLoraAdapter> {
   ///        be copied to device if required by the model at inference time.
   static LoraAdapter CreateLoraAdapterFromArray(const void* bytes, size_t num_bytes,
                                                 OrtAllocator* allocator);
+
+  /// \brief Wraps OrtApi::CreateLoraAdapterStack
+  ///
+  /// The function stacks the parameters of the adapters along a new first dimension, for batches in which
+  /// each entry uses its own adapter.
+  /// \param adapters The adapters to stack, in the order of their index
+  /// \param allocator optional pointer to a device allocator. If nullptr, the stacked data stays on CPU.
+  static LoraAdapter CreateLoraAdapterStack(const std::vector<const OrtLoraAdapter*>& adapters,
+                                            OrtAllocator* allocator);
 };
 
 /** \brief RunOptions
@@ -1064,6 +1076,8 @@ struct SessionOptionsImpl : ConstSessionOptionsImpl<T> {
 
   SessionOptionsImpl& SetLogId(const char* logid);     ///< Wraps OrtApi::SetSessionLogId
   SessionOptionsImpl& SetLogSeverityLevel(int level);  ///< Wraps OrtApi::SetSessionLogSeverityLevel
+  SessionOptionsImpl& SetTracingCallback(OrtTracingSpanFn tracing_callback,
+                                         void* user_data = nullptr);  ///< Wraps OrtApi::SessionOptionsSetTracingCallback
 
   SessionOptionsImpl& Add(OrtCustomOpDomain* custom_op_domain);  ///< Wraps OrtApi::AddCustomOpDomain
 
@@ -1244,6 +1258,7 @@ struct ModelMetadata : detail::Base<OrtModelMetadata> {
 };
 
 struct IoBinding;
+struct PreparedRun;
 
 namespace detail {
 
@@ -1290,6 +1305,24 @@ struct ConstSessionImpl : Base<T> {
   AllocatedStringPtr GetOverridableInitializerNameAllocated(size_t index, OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerName
 
   uint64_t GetProfilingStartTimeNs() const;  ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
+  /** \brief Returns the per node latency statistics as a JSON string, see OrtApi::SessionGetProfilingNodeStats
+   *
+   * \param allocator to allocate memory for the returned string
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   */
+  AllocatedStringPtr GetProfilingNodeStatsAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetProfilingNodeStats
+  /** \brief Returns the per node memory high-water marks as a JSON string, see OrtApi::SessionGetNodeMemoryStats
+   *
+   * \param allocator to allocate memory for the returned string
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   */
+  AllocatedStringPtr GetNodeMemoryStatsAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetNodeMemoryStats
+  /** \brief Returns the current value of a state tensor, see OrtApi::SessionGetStatefulTensor
+   *
+   * \param name of the graph input or graph output of the state
+   * \return the state, or an empty Value if the state has no value yet.
+   */
+  Value GetStatefulTensor(const char* name) const;
   ModelMetadata GetModelMetadata() const;    ///< Wraps OrtApi::SessionGetModelMetadata
 
   TypeInfo GetInputTypeInfo(size_t index) const;                   ///< Wraps OrtApi::SessionGetInputTypeInfo
@@ -1336,6 +1369,19 @@ struct SessionImpl : ConstSessionImpl<T> {
 
   void Run(const RunOptions& run_options, const IoBinding&);  ///< Wraps OrtApi::RunWithBinding
 
+  /** \brief Run the model with the input and output names of a PreparedRun, see OrtApi::RunPrepared
+   *
+   * \param[in] run_options
+   * \param[in] prepared_run
+   * \param[in] input_values Array of Value objects in the order of the input names of the prepared run
+   * \param[in] input_count Number of elements in the input_values array
+   * \param[out] output_values Array of Value objects in the order of the output names of the prepared run. Entries
+   *             holding nullptr are filled with values allocated by onnxruntime.
+   * \param[in] output_count Number of elements in the output_values array
+   */
+  void Run(const RunOptions& run_options, PreparedRun& prepared_run, const Value* input_values, size_t input_count,
+           Value* output_values, size_t output_count);
+
   /** \brief Run the model asynchronously in a thread owned by intra op thread pool
    *
    * Wraps OrtApi::RunAsync
@@ -1379,6 +1425,17 @@ struct SessionImpl : ConstSessionImpl<T> {
    */
   void SetEpDynamicOptions(const char* const* keys, const char* const* values, size_t kv_len);
 
+  void ResetStatefulTensors();  ///< Wraps OrtApi::SessionResetStatefulTensors
+
+  /** \brief Warm up the session with runs of zero-filled inputs, see OrtApi::SessionWarmUp
+   *
+   * \param dim_params names of the symbolic dimensions of the graph inputs
+   * \param dim_values values of the symbolic dimensions. The others are 1.
+   * \param num_dims number of elements in dim_params and dim_values
+   * \param num_runs number of warm-up runs
+   */
+  void WarmUp(const char* const* dim_params, const int64_t* dim_values, size_t num_dims, size_t num_runs);
+
   void FinalizeModelEditorSession(const Model& model, const SessionOptions& options,
                                   OrtPrepackedWeightsContainer* prepacked_weights_container = nullptr);
 };
@@ -1425,6 +1482,19 @@ struct Session : detail::SessionImpl<OrtSession> {
   UnownedSession GetUnowned() const { return UnownedSession{this->p_}; }
 };
 
+/** \brief Wrapper around ::OrtPreparedRun
+ *
+ * Holds the input and output names of repeated runs resolved once, see OrtApi::CreatePreparedRun.
+ * Must not be used by concurrent runs.
+ */
+struct PreparedRun : detail::Base<OrtPreparedRun> {
+  explicit PreparedRun(std::nullptr_t) {}  ///< Create an empty object, must be assigned a valid one to be used
+
+  /// Wraps OrtApi::CreatePreparedRun
+  PreparedRun(const Session& session, const char* const* input_names, const Value* input_values, size_t input_count,
+              const char* const* output_names, size_t output_count);
+};
+
 namespace detail {
 template <typename T>
 struct MemoryInfoImpl : Base<T> {
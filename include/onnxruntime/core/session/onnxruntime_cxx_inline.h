@@ -442,6 +442,13 @@ inline IoBinding::IoBinding(Session& session) {
   ThrowOnError(GetApi().CreateIoBinding(session, &this->p_));
 }
 
+inline PreparedRun::PreparedRun(const Session& session, const char* const* input_names, const Value* input_values,
+                                size_t input_count, const char* const* output_names, size_t output_count) {
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  ThrowOnError(GetApi().CreatePreparedRun(session, input_names, ort_input_values, input_count, output_names,
+                                          output_count, &this->p_));
+}
+
 inline ArenaCfg::ArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes, int max_dead_bytes_per_chunk) {
   ThrowOnError(GetApi().CreateArenaCfg(max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk, &p_));
 }
@@ -687,6 +694,11 @@ inline Env& Env::UnregisterExecutionProviderLibrary(const char* registration_nam
   return *this;
 }
 
+inline Env& Env::RegisterThreadPoolPartition(const char* partition_name, const OrtThreadingOptions* tp_options) {
+  ThrowOnError(GetApi().RegisterThreadPoolPartition(p_, partition_name, tp_options));
+  return *this;
+}
+
 inline std::vector<ConstEpDevice> Env::GetEpDevices() const {
   size_t num_devices = 0;
   const OrtEpDevice* const* device_ptrs = nullptr;
@@ -725,6 +737,13 @@ inline LoraAdapter LoraAdapter::CreateLoraAdapterFromArray(const void* bytes, si
   return LoraAdapter{p};
 }
 
+inline LoraAdapter LoraAdapter::CreateLoraAdapterStack(const std::vector<const OrtLoraAdapter*>& adapters,
+                                                       OrtAllocator* allocator) {
+  OrtLoraAdapter* p;
+  ThrowOnError(GetApi().CreateLoraAdapterStack(adapters.data(), adapters.size(), allocator, &p));
+  return LoraAdapter{p};
+}
+
 inline RunOptions::RunOptions() {
   ThrowOnError(GetApi().CreateRunOptions(&p_));
 }
@@ -985,6 +1004,13 @@ inline SessionOptionsImpl<T>& SessionOptionsImpl<T>::SetLogSeverityLevel(int lev
   return *this;
 }
 
+template <typename T>
+inline SessionOptionsImpl<T>& SessionOptionsImpl<T>::SetTracingCallback(OrtTracingSpanFn tracing_callback,
+                                                                        void* user_data) {
+  ThrowOnError(GetApi().SessionOptionsSetTracingCallback(this->p_, tracing_callback, user_data));
+  return *this;
+}
+
 template <typename T>
 inline SessionOptionsImpl<T>& SessionOptionsImpl<T>::Add(OrtCustomOpDomain* custom_op_domain) {
   ThrowOnError(GetApi().AddCustomOpDomain(this->p_, custom_op_domain));
@@ -1363,6 +1389,27 @@ inline uint64_t ConstSessionImpl<T>::GetProfilingStartTimeNs() const {
   return out;
 }
 
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetProfilingNodeStatsAllocated(OrtAllocator* allocator) const {
+  char* out;
+  ThrowOnError(GetApi().SessionGetProfilingNodeStats(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetNodeMemoryStatsAllocated(OrtAllocator* allocator) const {
+  char* out;
+  ThrowOnError(GetApi().SessionGetNodeMemoryStats(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
+template <typename T>
+inline Value ConstSessionImpl<T>::GetStatefulTensor(const char* name) const {
+  OrtValue* out;
+  ThrowOnError(GetApi().SessionGetStatefulTensor(this->p_, name, &out));
+  return Value{out};
+}
+
 template <typename T>
 inline ModelMetadata ConstSessionImpl<T>::GetModelMetadata() const {
   OrtModelMetadata* out;
@@ -1455,6 +1502,15 @@ inline void SessionImpl<T>::Run(const RunOptions& run_options, const IoBinding&
   ThrowOnError(GetApi().RunWithBinding(this->p_, run_options, io_binding));
 }
 
+template <typename T>
+inline void SessionImpl<T>::Run(const RunOptions& run_options, PreparedRun& prepared_run, const Value* input_values,
+                                size_t input_count, Value* output_values, size_t output_count) {
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunPrepared(this->p_, run_options, prepared_run, ort_input_values, input_count,
+                                    ort_output_values, output_count));
+}
+
 template <typename T>
 inline void SessionImpl<T>::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
                                      const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback, void* user_data) {
@@ -1477,7 +1533,18 @@ inline void SessionImpl<T>::SetEpDynamicOptions(const char* const* keys, const c
   ThrowOnError(GetApi().SetEpDynamicOptions(this->p_, keys, values, kv_len));
 }
 
+template <typename T>
+inline void SessionImpl<T>::WarmUp(const char* const* dim_params, const int64_t* dim_values, size_t num_dims,
+                                   size_t num_runs) {
+  ThrowOnError(GetApi().SessionWarmUp(this->p_, dim_params, dim_values, num_dims, num_runs));
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
+template <typename T>
+inline void SessionImpl<T>::ResetStatefulTensors() {
+  ThrowOnError(GetApi().SessionResetStatefulTensors(this->p_));
+}
+
 template <typename T>
 inline void SessionImpl<T>::FinalizeModelEditorSession(const Model& model, const SessionOptions& options,
                                                        OrtPrepackedWeightsContainer* prepacked_weights_container) {
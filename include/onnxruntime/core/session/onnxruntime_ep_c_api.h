@@ -13,8 +13,8 @@ ORT_RUNTIME_CLASS(EpGraphSupportInfo);
 ORT_RUNTIME_CLASS(MemoryDevice);  // opaque class to wrap onnxruntime::OrtDevice
 ORT_RUNTIME_CLASS(NodeComputeContext);
 
-// Opaque class to create an onnxruntime::Stream. Will be filled out in separate PR.
-// Adding here for OrtDataTransferImpl as the stream type is required by the IDataTransfer API.
+// Opaque class that wraps an onnxruntime::Stream.
+// A stream aware execution provider creates the streams with OrtEpFactory::CreateSyncStreamForDevice.
 ORT_RUNTIME_CLASS(SyncStream);
 
 // struct that an EP implements for IDataTransfer to copy between devices it uses and CPU
@@ -67,6 +67,116 @@ typedef struct OrtDataTransferImpl {
                   _In_ size_t num_tensors);
 } OrtDataTransferImpl;
 
+struct OrtSyncNotificationImpl;
+typedef struct OrtSyncNotificationImpl OrtSyncNotificationImpl;
+
+struct OrtSyncStreamImpl;
+typedef struct OrtSyncStreamImpl OrtSyncStreamImpl;
+
+// struct that an EP implements for a notification on one of its streams. ORT uses notifications to synchronize
+// streams, e.g. a stream waits for the copy of a tensor on another stream to complete before using the tensor.
+struct OrtSyncNotificationImpl {
+  uint32_t ort_version_supported;  ///< Must be initialized to ORT_API_VERSION
+
+  /** \brief Release the OrtSyncNotificationImpl instance.
+   *
+   * \param[in] this_ptr Pointer to the OrtSyncNotificationImpl instance.
+   *
+   * \since Version 1.23.
+   */
+  ORT_API_T(void, Release, _In_ OrtSyncNotificationImpl* this_ptr);
+
+  /** \brief Activate the notification, e.g. record an event on the stream that created the notification.
+   *
+   * \param[in] this_ptr Pointer to the OrtSyncNotificationImpl instance.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(Activate, _In_ OrtSyncNotificationImpl* this_ptr);
+
+  /** \brief Make a stream of the same device wait for the notification without blocking the host.
+   *
+   * \param[in] this_ptr Pointer to the OrtSyncNotificationImpl instance.
+   * \param[in] consumer_stream The stream that must wait for the notification.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(WaitOnDevice, _In_ OrtSyncNotificationImpl* this_ptr, _In_ OrtSyncStream* consumer_stream);
+
+  /** \brief Block the host until the notification is complete.
+   *
+   * \param[in] this_ptr Pointer to the OrtSyncNotificationImpl instance.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(WaitOnHost, _In_ OrtSyncNotificationImpl* this_ptr);
+};
+
+// struct that a stream aware EP implements for a stream of one of its devices, e.g. a queue of an accelerator.
+// ORT runs the nodes of the EP and the copies to and from its device on these streams, so that copies can overlap
+// with compute.
+struct OrtSyncStreamImpl {
+  uint32_t ort_version_supported;  ///< Must be initialized to ORT_API_VERSION
+
+  /** \brief Release the OrtSyncStreamImpl instance.
+   *
+   * \param[in] this_ptr Pointer to the OrtSyncStreamImpl instance.
+   *
+   * \since Version 1.23.
+   */
+  ORT_API_T(void, Release, _In_ OrtSyncStreamImpl* this_ptr);
+
+  /** \brief Get the native handle of the stream, e.g. a cudaStream_t.
+   *
+   * The EP can get the handle back from an OrtSyncStream with OrtEpApi::SyncStream_GetHandle.
+   *
+   * \param[in] this_ptr Pointer to the OrtSyncStreamImpl instance.
+   * \return The native handle of the stream.
+   *
+   * \since Version 1.23.
+   */
+  ORT_API_T(void*, GetHandle, _In_ OrtSyncStreamImpl* this_ptr);
+
+  /** \brief Create a notification for the stream.
+   *
+   * \param[in] this_ptr Pointer to the OrtSyncStreamImpl instance.
+   * \param[out] notification The created OrtSyncNotificationImpl. ORT calls OrtSyncNotificationImpl::Release when
+   *                          it is no longer needed.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(CreateNotification, _In_ OrtSyncStreamImpl* this_ptr,
+                  _Outptr_ OrtSyncNotificationImpl** notification);
+
+  /** \brief Block the host until all the work queued on the stream is complete.
+   *
+   * \param[in] this_ptr Pointer to the OrtSyncStreamImpl instance.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(Flush, _In_ OrtSyncStreamImpl* this_ptr);
+
+  /** \brief Called at the end of each session run that used the stream, e.g. to release per-run resources.
+   *
+   * \param[in] this_ptr Pointer to the OrtSyncStreamImpl instance.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(OnSessionRunEnd, _In_ OrtSyncStreamImpl* this_ptr);
+};
+
 struct OrtNodeFusionOptions;
 typedef struct OrtNodeFusionOptions OrtNodeFusionOptions;
 
@@ -318,6 +428,15 @@ struct OrtEpApi {
    * \since Version 1.23.
    */
   ORT_API_T(uint32_t, MemoryDevice_GetDeviceId, _In_ const OrtMemoryDevice* memory_device);
+
+  /** \brief Get the native handle of an OrtSyncStream.
+   *
+   * \param[in] stream The OrtSyncStream instance, e.g. a stream passed to OrtDataTransferImpl::CopyTensors.
+   * \return The handle returned by OrtSyncStreamImpl::GetHandle for a stream created by the EP.
+   *
+   * \since Version 1.23.
+   */
+  ORT_API_T(void*, SyncStream_GetHandle, _In_ OrtSyncStream* stream);
 };
 
 /**
@@ -716,6 +835,38 @@ struct OrtEpFactory {
    * \since Version 1.23.
    */
   ORT_API2_STATUS(CreateDataTransfer, _In_ OrtEpFactory* this_ptr, _Outptr_ OrtDataTransferImpl** data_transfer);
+
+  /** \brief Check if the execution providers created by the factory use streams.
+   *
+   * If true, ORT creates streams for the device of the execution provider with CreateSyncStreamForDevice, runs the
+   * execution provider's nodes on them and passes them to OrtDataTransferImpl::CopyTensors so copies can be
+   * asynchronous. Optional. nullptr means the execution provider is not stream aware.
+   *
+   * \param[in] this_ptr The OrtEpFactory instance.
+   * \return True if the execution provider is stream aware.
+   *
+   * \since Version 1.23.
+   */
+  ORT_API_T(bool, IsStreamAware, _In_ const OrtEpFactory* this_ptr);
+
+  /** \brief Create a stream for a device of the execution provider.
+   *
+   * Required if IsStreamAware returns true.
+   *
+   * \param[in] this_ptr The OrtEpFactory instance.
+   * \param[in] memory_device The device to create the stream for.
+   * \param[in] stream_options Optional key-value pairs for stream options, can be nullptr.
+   * \param[out] stream The created OrtSyncStreamImpl. ORT calls OrtSyncStreamImpl::Release when it is no longer
+   *                    needed.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23.
+   */
+  ORT_API2_STATUS(CreateSyncStreamForDevice, _In_ OrtEpFactory* this_ptr,
+                  _In_ const OrtMemoryDevice* memory_device,
+                  _In_opt_ const OrtKeyValuePairs* stream_options,
+                  _Outptr_ OrtSyncStreamImpl** stream);
 };
 
 #ifdef __cplusplus
@@ -52,3 +52,16 @@ static const char* const kOrtRunOptionsConfigQnnLoraConfig = "qnn.lora_config";
 // If the value is set to -1, cuda graph capture/replay is disabled in that run.
 // User are not expected to set the value to 0 as it is reserved for internal use.
 static const char* const kOrtRunOptionsConfigCudaGraphAnnotation = "gpu_graph_id";
+
+// Set to '1' to schedule the work of the run on the high priority queues of the intra-op and inter-op thread pools.
+// The pool threads take the work of those queues before the other work at their next task boundary, so the run isn't
+// delayed by the normal priority runs sharing the pools, e.g. those of the sessions of a global thread pool.
+// Set to '0' for a normal priority run. Defaults to the "session.high_priority" option of the session.
+static const char* const kOrtRunOptionsConfigHighPriority = "run.high_priority";
+
+// Timeout of the run in milliseconds, a non-negative integer. Once it has passed, the run stops at the next kernel,
+// including the kernels of the subgraphs of Loop, Scan and the beam search steps, and fails with an error status, as
+// when the terminate flag of the run options is set. The memory of the run is released when it fails, and is returned
+// to the OS by the arenas listed in "memory.enable_memory_arena_shrinkage".
+// "0", the default, means no timeout.
+static const char* const kOrtRunOptionsConfigTimeoutMs = "run.timeout_ms";
@@ -24,6 +24,28 @@ static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.di
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
 
+// Comma separated list of strictly increasing dimension bucket boundaries used to key the memory pattern cache,
+// e.g. "128,256,512". Only relevant if memory patterns are enabled.
+// Every input dimension is rounded up to the smallest boundary it fits in (dimensions larger than the last boundary
+// are used as is), so a memory pattern generated for one input shape is reused for all shapes in the same bucket
+// instead of planning again for every distinct shape.
+// If unset or empty (default), memory patterns are cached by the exact input shapes.
+static const char* const kOrtSessionOptionsMemoryPatternShapeBuckets = "session.memory_pattern_shape_buckets";
+
+// Maximum number of memory patterns cached per session. The least recently used pattern is evicted once the limit
+// is exceeded. Only relevant if memory patterns are enabled.
+// "0": no limit. [DEFAULT]
+static const char* const kOrtSessionOptionsMemoryPatternCacheMaxEntries = "session.memory_pattern_cache_max_entries";
+
+// Reserves the peak size of a new memory pattern as one region of the arena of its location. Every run using the
+// pattern allocates a buffer of that size, which the region then holds without the arena extending by the steps of
+// its extend strategy, e.g. to the next power of two, and fragmenting. A region is only reserved when the peak is
+// larger than the ones reserved before for the location. Only relevant if memory patterns are enabled.
+// Option values:
+// - "0": the arena extends as needed. [DEFAULT]
+// - "1": the peak of a new memory pattern is reserved.
+static const char* const kOrtSessionOptionsReserveMemoryPatternPeak = "session.reserve_memory_pattern_peak";
+
 // Set to 'ORT' (case sensitive) to load an ORT format model.
 // If unset, model type will default to ONNX unless inferred from filename ('.ort' == ORT format) or bytes to be ORT
 static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load_model_format";
@@ -32,6 +54,12 @@ static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load
 // If unset, format will default to ONNX unless optimized_model_filepath ends in '.ort'.
 static const char* const kOrtSessionOptionsConfigSaveModelFormat = "session.save_model_format";
 
+// If a value is "1", the allocation plan of the main graph is saved when saving an ORT format model. A session loading
+// the model uses the saved plan instead of computing the buffer reuse, if the plan matches the graph and execution
+// providers of that session. The plan is only saved if the main graph is planned as a single logic stream.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigSaveAllocationPlan = "session.save_allocation_plan_in_ort_format";
+
 // If a value is "1", flush-to-zero and denormal-as-zero are applied. The default is "0".
 // When multiple sessions are created, a main thread doesn't override changes from succeeding session options,
 // but threads in session thread pools follow option changes.
@@ -100,6 +128,13 @@ static const char* const kOrtSessionOptionsMemoryOptimizerApplyConfig = "optimiz
 // Specifies the config for detecting subgraphs for memory footprint reduction.
 // The value should be a string contains int separated using commas. The default value is "0:0".
 static const char* const kOrtSessionOptionsMemoryOptimizerProbeConfig = "optimization.enable_memory_probe_recompute_config";
+
+// Specifies a memory budget for the activations stashed for the backward pass, used to pick the recompute subgraphs
+// when kOrtSessionOptionsMemoryOptimizerApplyConfig is not set. The subgraphs saving the most memory per recomputed
+// element are recomputed until the stashed activations fit in the budget.
+// The value is "BudgetInMiB", or "BudgetInMiB:dim_param=value,..." giving the values of the symbolic dimensions used
+// to size the activations, e.g. "4096:batch=8,sequence=512". Symbolic dimensions without a value count as 1.
+static const char* const kOrtSessionOptionsMemoryOptimizerBudget = "optimization.memory_optimizer_budget";
 #endif
 
 // This setting if set should contain a comma separated list of optimizers names that should be disabled.
@@ -142,10 +177,57 @@ static const char* const kOrtSessionOptionsDisableSpecifiedOptimizers = "optimiz
 // Default value is set to "1".
 static const char* const kOrtSessionOptionsGraphOptimizationsLoopLevel = "session.graph_optimizations_loop_level";
 
+// Transform the control flow subgraphs of the main graph (e.g. the bodies of Loop and If nodes) in parallel on the
+// inter-op thread pool, or on the intra-op thread pool if the session has none.
+// Only graph transformers that support it do so, and a subgraph and its nested subgraphs are transformed by a single
+// thread. The result doesn't depend on the scheduling, but the subgraphs are transformed before the nodes of the main
+// graph rather than along with them, so it may differ from the result with this option disabled.
+// "0": disabled. Default.
+// "1": enabled.
+static const char* const kOrtSessionOptionsGraphOptimizationsParallelSubgraphs =
+    "session.graph_optimizations_parallel_subgraphs";
+
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
 
+// Enable or disable moving the raw data of the initializers of an ONNX model into the OrtValues used by the session
+// instead of copying it, which lowers the peak memory usage when loading models with large inline initializers.
+// The data of the initializers is then owned by the session rather than by the ModelProto.
+// "0": disable. Default.
+// "1": enable.
+static const char* const kOrtSessionOptionsMoveInitializerDataToOrtValues =
+    "session.move_initializer_data_to_ort_values";
+
+// Maximum number of initializers deserialized, and of nodes whose constant initializers are pre-packed, at the same
+// time on the intra-op thread pool during session initialization. Each of them holds both its source and its result
+// in memory until it is done, so a lower value bounds the peak memory usage of session creation.
+// "0": Default. Up to the degree of parallelism of the intra-op thread pool.
+// "1": One at a time.
+// "n": Up to n at a time.
+static const char* const kOrtSessionOptionsInitializerLoadMaxConcurrency = "session.initializer_load_max_concurrency";
+
+// Number of warm-up runs at the end of session initialization, see OrtApi::SessionWarmUp.
+// The first runs of a session are slower than the next ones, as they extend the arenas, touch the pages of their
+// buffers, spin up the threads and fill the caches of the kernels and execution providers. The warm-up runs feed
+// zero-filled inputs of representative shapes and discard the outputs, keeping the extended arenas for the real runs.
+// A failed warm-up is logged as a warning and doesn't fail the initialization.
+// "0": Default. No warm-up.
+// "n": n warm-up runs.
+static const char* const kOrtSessionOptionsWarmUpRuns = "session.warm_up_runs";
+
+// Values of the symbolic dimensions of the graph inputs used by the warm-up runs, as a ';' separated list of
+// "<dim_param>:<value>" pairs, e.g. "batch:8;sequence:128". Symbolic dimensions that are not listed are 1.
+static const char* const kOrtSessionOptionsWarmUpDims = "session.warm_up_dims";
+
+// Share the constant CPU initializers of the session with the other sessions of the environment that set this option
+// and load an initializer with the same data type, shape and bytes, e.g. the same model loaded by several sessions.
+// A shared initializer is loaded once and freed with the last session using it. Initializers with external data,
+// string initializers and the ones added with AddInitializer are not shared.
+// "0": Default. Each session holds its own copy of its initializers.
+// "1": Share the initializers by content.
+static const char* const kOrtSessionOptionsShareInitializersByContent = "session.share_initializers_by_content";
+
 // Configure whether to allow the inter_op/intra_op threads spinning a number of times before blocking
 // "0": thread will block if found no job to run
 // "1": default, thread will spin a number of times before blocking
@@ -170,6 +252,17 @@ static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "ses
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
     "session.use_ort_model_bytes_for_initializers";
 
+/// <summary>
+/// Key for memory-mapping an ORT format model file loaded from a path instead of reading it into a buffer.
+/// The initializers use the mapped bytes directly, on the CPU and on the execution providers that consume the
+/// default CPU memory, so the pages of the weights are only read when used and are shared between the processes
+/// loading the same file. The mapping is kept until the InferenceSession is destroyed, and the file must not be
+/// modified meanwhile. If the file can't be mapped it is read into a buffer.
+/// "0": Default. The file is read into a buffer that is freed once the session is initialized.
+/// "1": Map the file.
+/// </summary>
+static const char* const kOrtSessionOptionsConfigMapORTModelFile = "session.map_ort_model_file";
+
 // This should only be specified when exporting an ORT format model for use on a different platform.
 // If the ORT format model will be used on ARM platforms set to "1". For other platforms set to "0"
 // Available since version 1.11.
@@ -229,7 +322,10 @@ static const char* const kOrtSessionOptionsConfigStrictShapeTypeInference = "ses
 // is used for development purpose.
 static const char* const kOrtSessionOptionsConfigStrictAllowReleasedOpsetsOnly = "session.allow_released_opsets_only";
 
-// The file saves configuration for partitioning node among logic streams
+// The file saves configuration for partitioning node among logic streams.
+// Its "type" selects the partitioner: "DeviceBasedPartitioner" (the default) puts the nodes of each device in one
+// stream, "CriticalPathPartitioner" spreads the CPU nodes over "num_streams" streams, optionally guided by the node
+// times of a profile in "profile_file", so independent branches run concurrently in ORT_PARALLEL execution mode.
 static const char* const kNodePartitionConfigFile = "session.node_partition_config_file";
 
 // This Option allows setting affinities for intra op threads.
@@ -249,6 +345,77 @@ static const char* const kNodePartitionConfigFile = "session.node_partition_conf
 //    Hence 64-65 is an invalid configuration, because a windows thread cannot be attached to processors across group boundary.
 static const char* const kOrtSessionOptionsConfigIntraOpThreadAffinities = "session.intra_op_thread_affinities";
 
+// Name of the env thread pool partition the session should use instead of the global thread pools.
+// The partition must have been registered with OrtApi::RegisterThreadPoolPartition on the env used to create the
+// session, and the session must be configured to not use per session threads (OrtApi::DisablePerSessionThreads).
+// This allows running one model replica per NUMA node in a single process, with each partition's threads
+// restricted to the logical processors of its node.
+static const char* const kOrtSessionOptionsConfigThreadPoolPartition = "session.thread_pool_partition";
+
+// Enable batching of concurrent RunAsync calls. Requests with the same inputs, outputs and RunOptions whose CPU input
+// tensors only differ in the batch dimension are concatenated along it, run once, and the outputs are split back to
+// each callback. The value is the maximum sum of the batch dimension sizes in a batch.
+// "0": default, RunAsync requests are run separately.
+// Requests that can't be batched (e.g. with preallocated outputs) are run separately. If the model doesn't accept
+// the combined batch, or its outputs don't have the combined size in the batch dimension, the requests are re-run
+// separately, so only enable this for models that are batchable along the batch dimension.
+static const char* const kOrtSessionOptionsConfigRunAsyncMaxBatchSize = "session.run_async_max_batch_size";
+
+// Maximum time in microseconds the oldest queued RunAsync request waits for more requests before its batch is run.
+// Only applies if kOrtSessionOptionsConfigRunAsyncMaxBatchSize is set. Default is "1000".
+static const char* const kOrtSessionOptionsConfigRunAsyncMaxQueueDelayMicros = "session.run_async_max_queue_delay_us";
+
+// Dimension of the inputs and outputs that RunAsync requests are batched along.
+// Only applies if kOrtSessionOptionsConfigRunAsyncMaxBatchSize is set. Default is "0".
+static const char* const kOrtSessionOptionsConfigRunAsyncBatchDim = "session.run_async_batch_dim";
+
+// Capture a CUDA/HIP graph per shape bucket when graph capture is enabled in the EP, e.g. enable_cuda_graph.
+// The value is "<dim_param>:<size>,<size>,..." with ascending sizes, e.g. "sequence_length:32,64,128,256".
+// The inputs that have the symbolic dimension dim_param are padded with zeros along it to the smallest bucket size
+// that fits and copied into buffers owned by the bucket. The first runs of each bucket capture its graph and later
+// runs replay it, so the application doesn't set kOrtRunOptionsConfigCudaGraphAnnotation. The outputs that have the
+// dimension are sliced back to the size of the inputs.
+// Only use this for models whose outputs for the valid positions don't depend on the padding, e.g. when the padding
+// is masked. Runs whose inputs don't fit in a bucket, or that set kOrtRunOptionsConfigCudaGraphAnnotation, are not
+// bucketed.
+static const char* const kOrtSessionOptionsConfigGraphCaptureShapeBuckets = "session.graph_capture_shape_buckets";
+
+// State tensors kept by the session between runs, for streaming models like an RNN hidden state or a KV cache.
+// The value is a ';' separated list of "<graph output>:<graph input>" pairs, e.g. "h_out:h_in;c_out:c_in".
+// Each run feeds the input with the output of the previous run, and fetches the output on the device that consumes
+// the input, so neither is copied to or from the application. The application only feeds a state input to set its
+// initial value: before the first run, after OrtApi::SessionResetStatefulTensors, or to override the state.
+// A state output is only returned to the application when it is requested.
+// The current state is read with OrtApi::SessionGetStatefulTensor. Runs of the session are serialized.
+static const char* const kOrtSessionOptionsStatefulTensors = "session.stateful_tensors";
+
+// Reuse the outputs that an IOBinding binds to a device (OrtApi::BindOutputToDevice) across runs.
+// After a run the output values are kept by the binding and handed back on later runs that produce the same output
+// with the same shape, instead of allocating a new output every run.
+// The values returned by OrtApi::GetBoundOutputValues are overwritten by later runs using the same binding, so they
+// must be consumed before the next run.
+// "0": default, outputs bound to a device are allocated by the run unless a value is still bound from a previous run.
+// "1": reuse outputs bound to a device.
+static const char* const kOrtSessionOptionsConfigIOBindingReuseOutputs = "session.io_binding_reuse_outputs";
+
+// Stage the inputs that an IOBinding binds from CPU memory for a device (e.g. CUDA) through pinned memory.
+// OrtApi::BindInput copies the input into one of two pinned buffers kept by the binding for that input and issues an
+// asynchronous copy to one of two device buffers on a dedicated copy stream, instead of a synchronous copy from
+// pageable memory. The copy overlaps with the work of the previous run still running on the device, and the next run
+// waits for it. The device buffers are reused every other bind of an input.
+// "0": default, inputs bound from CPU memory are copied to the device synchronously.
+// "1": stage inputs bound from CPU memory.
+static const char* const kOrtSessionOptionsConfigIOBindingStageInputs = "session.io_binding_stage_inputs";
+
+// Shard the weights of the MLP and Attention blocks of a model for tensor parallel execution on the CUDA EP.
+// Each rank of the tensor parallel group runs the unsharded model in its own session (one per GPU), with its rank
+// and the group size, which must match the rank and size of the NCCL communicator used by the collective ops
+// (com.microsoft AllReduce). The weights of the blocks are split by column and row across the ranks, and an AllReduce
+// sums the partial results after each block, so the application does not shard the model itself.
+// Requires a build with NCCL. The world size defaults to "1", which disables sharding.
+static const char* const kOrtSessionOptionsConfigTensorParallelRank = "session.tensor_parallel_rank";
+static const char* const kOrtSessionOptionsConfigTensorParallelWorldSize = "session.tensor_parallel_world_size";
+
 // This option will dump out the model to assist debugging any issues with layout transformation,
 // and is primarily intended for developer usage. It is only relevant if an execution provider that requests
 // NHWC layout is enabled such as NNAPI, XNNPACK or QNN.
@@ -302,6 +469,33 @@ static const char* const kOrtSessionOptionsModelExternalInitializersFileFolderPa
 static const char* const kOrtSessionOptionsSavePrePackedConstantInitializers =
     "session.save_external_prepacked_constant_initializers";
 
+// Directory of a persistent cache of pre-packed constant initializers used by CPU kernels.
+// On a miss the output of PrePack() is written to the directory. Later sessions, including ones in other processes,
+// memory map the cached entry instead of pre-packing the weight again.
+// Entries are keyed by a hash of the node, its constant inputs, the session config, the CPU features and the
+// onnxruntime version, so a single directory can be shared by different models and machines.
+//
+// - "": Default. The cache is disabled.
+// - "path to a directory": The directory is created if it doesn't exist.
+// Sample usage: sess_options.add_session_config_entry(kOrtSessionOptionsPrepackedWeightsCacheDir, "/tmp/ort_prepack")
+static const char* const kOrtSessionOptionsPrepackedWeightsCacheDir = "session.prepacked_weights_cache_dir";
+
+// Directory of a persistent cache of optimized models.
+// When a session loads an ONNX model from a file and has no cache entry for it, the model is saved in ORT format to
+// the directory after the graph optimizations. Later sessions for the same model and configuration load the cached
+// ORT format model and skip the graph optimizations.
+// Entries are keyed by a hash of the model file, the size and modification time of its external data files, the
+// execution providers, the graph optimization level, the disabled optimizers, the free dimension overrides, the
+// session config, the CPU features and the onnxruntime version, so an entry is not used once any of them changes.
+// The cache is only used for sessions whose only execution provider is the CPU one, without custom graph
+// transformers or external initializers provided through the session options. Stale entries are not removed.
+//
+// - "": Default. The cache is disabled.
+// - "path to a directory": A relative path is relative to the directory of the model. The directory is created if it
+//   doesn't exist.
+// Sample usage: sess_options.add_session_config_entry(kOrtSessionOptionsOptimizedModelCacheDir, "ort_cache")
+static const char* const kOrtSessionOptionsOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
 // Use this config when you want to collect memory stats for each node in the graph.
 // The file format is a CSV file with the following columns:
 // The file will be created if it does not exist, and will be overwritten if it does.
@@ -320,6 +514,17 @@ static const char* const kOrtSessionOptionsSavePrePackedConstantInitializers =
 // - "full path to file": there is not a default for this option. If the file can not be opened for writing, an error will be returned.
 static const char* const kOrtSessionOptionsCollectNodeMemoryStatsToFile = "session.collect_node_memory_stats_to_file";
 
+// Records at run time the memory high-water mark of each node in the allocator of its device: the bytes in use when
+// the node returned plus the peak of its temporary allocations, the change of the bytes in use across the node,
+// its dynamically allocated outputs and its temporary allocations. The stats of the latest execution of each node,
+// and the largest high-water mark over all runs, are returned by OrtApi::SessionGetNodeMemoryStats.
+// Unlike kOrtSessionOptionsCollectNodeMemoryStatsToFile, nothing is written to disk and concurrent runs are supported.
+// The bytes in use are only known for allocators that keep stats, like the arena.
+// Option values:
+// - "0": node memory stats are not collected. [DEFAULT]
+// - "1": node memory stats are collected.
+static const char* const kOrtSessionOptionsCollectNodeMemoryStats = "session.collect_node_memory_stats";
+
 /// This is a composite CSV setting formatted as "memory limit in kb,file name for collected stats"
 /// "limit > 0": enables Capacity Aware Partitioning for Cuda EP. `limit` is optional and when absent
 /// the provider may attempt to figure out the memory available automatically.
@@ -366,12 +571,68 @@ static const char* const kOrtSessionOptionStopShareEpContexts = "ep.stop_share_e
 static const char* const kOrtSessionOptionsEpContextModelExternalInitializersFileName =
     "ep.context_model_external_initializers_file_name";
 
+// Used only for context model generation.
+// Generate the EP context model after the Level 2 and higher graph optimizations rather than right after partitioning,
+// so the nodes left to the CPU EP are saved fully optimized. Loading the model with the graph optimizations disabled
+// then does no graph optimization. Set kOrtSessionOptionsPrepackedWeightsCacheDir as well so that the pre-packed CPU
+// weights are not computed again either.
+// The optimized nodes may be specific to the CPU the model was generated on, e.g. with ORT_ENABLE_ALL.
+// "0": The EP context model is generated right after partitioning. (default)
+// "1": The EP context model is generated after the graph optimizations.
+static const char* const kOrtSessionOptionEpContextOptimizeCpuNodes = "ep.context_optimize_cpu_nodes";
+
 // Gemm fastmath mode provides fp32 gemm acceleration with bfloat16 based matmul.
 // Option values:
 // - "0": Gemm FastMath mode is not enabled. [DEFAULT]
 // - "1": Gemm FastMath mode is enabled.
 static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas.enable_gemm_fastmath_arm64_bfloat16";
 
+// Gemm fastmath mode on any CPU with bfloat16 GEMM support: ARM64 with the BF16 extension, or x86-64 with AVX512-BF16.
+// Same values as kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16, either key enables the mode.
+static const char* const kOrtSessionOptionsMlasGemmFastMathBfloat16 = "mlas.enable_gemm_fastmath_bfloat16";
+
+// Relative error the Gemm fastmath mode may introduce in a MatMul output. The inputs are rounded to bfloat16, whose
+// relative rounding error is 2^-8, and the products are summed in fp32, so the error estimate of a dot product of
+// length K is 2^-8 * sqrt(K). A MatMul whose estimate exceeds the tolerance keeps running in fp32.
+// Option values: a positive float, e.g. "0.05". [DEFAULT: no limit]
+static const char* const kOrtSessionOptionsMlasGemmFastMathBfloat16Tolerance = "mlas.gemm_fastmath_bfloat16_tolerance";
+
+// Largest fraction of non-zero elements of a constant fp32 MatMul weight for which the CPU MatMul also keeps the
+// weight compressed by column, and may run it through the sparse GEMM of MLAS, whose work is proportional to the
+// non-zero elements. With TunableOp enabled on the CPU EP, the sparse GEMM is only used for the shapes where it is
+// measured to be faster than the dense one, otherwise it's always used for such weights.
+// Option values: a float in (0, 1], e.g. "0.3". Default is "0", which disables the sparse GEMM.
+static const char* const kOrtSessionOptionsMlasSparseGemmMaxDensity = "mlas.sparse_gemm_max_density";
+
+// TunableOp for the CPU EP. Kernels with tunable variants (currently the float MatMul, whose variants partition the
+// GEMMs over the threads differently) time the variants on the first run of a shape and use the fastest one after.
+// The results are returned by GetTuningResults in the same TuningResults format as the CUDA and ROCm EPs use, and
+// results embedded in the model metadata are loaded when the session is initialized, which also enables TunableOp.
+// "session.cpu_tunable_op_enable": "1" to use the tuning results, "0" to use the default variants. [DEFAULT "0"]
+// "session.cpu_tunable_op_tuning_enable": "1" to tune the shapes without results, "0" otherwise. [DEFAULT "0"]
+// "session.cpu_tunable_op_max_tuning_duration_ms": the time to spend on tuning each variant, 0 for no limit.
+static const char* const kOrtSessionOptionsCpuTunableOpEnable = "session.cpu_tunable_op_enable";
+static const char* const kOrtSessionOptionsCpuTunableOpTuningEnable = "session.cpu_tunable_op_tuning_enable";
+static const char* const kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs =
+    "session.cpu_tunable_op_max_tuning_duration_ms";
+
+// Rewrite the float MatMul nodes with a constant 2-D weight that are assigned to the CPU EP into com.microsoft
+// DynamicQuantizeMatMul. The weight is quantized per column to 8 bits when the session is created and the activation
+// is quantized at runtime, so no offline quantization step is needed.
+// The value is the accuracy tolerance: the largest relative error of the quantized weight, the norm of
+// (W - dequantized W) divided by the norm of W, for which a MatMul is rewritten, e.g. "0.01".
+// Default is "0", which disables the rewrite.
+static const char* const kOrtSessionOptionsDynamicQuantizeMatMulTolerance =
+    "session.dynamic_quantize_matmul_tolerance";
+
+// Rewrite the float GRU nodes with constant W and R that are assigned to the CPU EP into com.microsoft
+// DynamicQuantizeGRU, quantizing W and R per gate column when the session is created.
+// The value is the accuracy tolerance, the largest relative error of the quantized W and R for which a GRU is
+// rewritten, with the same meaning as "session.dynamic_quantize_matmul_tolerance".
+// Default is "0", which disables the rewrite.
+static const char* const kOrtSessionOptionsDynamicQuantizeGRUTolerance =
+    "session.dynamic_quantize_gru_tolerance";
+
 // When converting DQ + MatMul -> MatMulNBits, the accuracy level of the MatMulNBits is controlled by this option.
 // Refer to MatMulNBits op schema for more details.
 // If not provided, default is 4.
@@ -399,3 +660,173 @@ static const char* const kOrtEpDynamicOptionsWorkloadType = "ep.dynamic.workload
 // - "0": EP compile is not disabled. [DEFAULT]
 // - "1": EP compile is disabled.
 static const char* const kOrtSessionOptionsDisableModelCompile = "session.disable_model_compile";
+
+// Times both ways of parallelizing the tree ensemble operators (over trees and over rows) on the first run with
+// several rows and keeps the faster one for the following runs of the node. The choice is logged at INFO level.
+// Otherwise the choice comes from a cost model of the trees and the size of the thread pool.
+// Option values:
+// - "0": the cost model chooses the parallelization. [DEFAULT]
+// - "1": the parallelization is tuned on the first run.
+static const char* const kOrtSessionOptionsTreeEnsembleAutotuneParallelization =
+    "session.tree_ensemble_autotune_parallelization";
+
+// When profiling is enabled, only record the events of every Nth graph execution instead of all of them, to reduce
+// the overhead of profiling a session that serves requests. The executions of the subgraphs of control flow nodes
+// are sampled independently of their parent graph. The session level events, like "model_run", are always recorded.
+// Option values:
+// - "1": the events of every execution are recorded. [DEFAULT]
+// - a positive integer N: the events of one out of N executions are recorded.
+static const char* const kOrtSessionOptionsProfilingSampleInterval = "session.profiling_sample_interval";
+
+// Collects the count, mean, min, max, p50 and p99 of the latency of each node in per thread buffers, for every run and
+// independently of whether profiling is enabled. The statistics can be queried at any time, while the session is
+// running, with OrtApi::SessionGetProfilingNodeStats.
+// Option values:
+// - "0": node statistics are not collected. [DEFAULT]
+// - "1": node statistics are collected.
+static const char* const kOrtSessionOptionsProfilingNodeStats = "session.profiling_node_stats";
+
+// When profiling is enabled, adds the user space hardware counters of the threads to the "thread_scheduling_stats"
+// of the node events: CPU cycles, retired instructions and last level cache misses. They are reported for the thread
+// running the node, and for each intra-op thread pool thread from the tasks it ran for the node. The instructions per
+// cycle and the misses tell a compute bound kernel from a memory bound one. The counters are read with
+// perf_event_open, so they are only available on Linux, and when kernel.perf_event_paranoid allows it. An event the
+// CPU doesn't support, e.g. in a VM, reads as 0.
+// Option values:
+// - "0": hardware counters are not recorded. [DEFAULT]
+// - "1": hardware counters are recorded.
+static const char* const kOrtSessionOptionsProfilingHardwareCounters = "session.profiling_hardware_counters";
+
+// Keeps a copy of the large pre-packed weights of the CPU MatMul and Gemm kernels on each NUMA node of the host, and
+// has the kernels read the copy on the node of the calling thread. This avoids reading the weights at remote memory
+// bandwidth on multi-socket hosts, and is meant for sessions whose thread pools are pinned to the processors of one
+// node, e.g. through thread pool partitions. Weights shared between sessions are replicated by each session.
+// Only supported on Linux and Windows, and ignored on single node hosts.
+// Option values:
+// - "0": the weights are only kept where they were pre-packed. [DEFAULT]
+// - "1": the pre-packed weights are replicated on each NUMA node.
+static const char* const kOrtSessionOptionsNumaReplicatePrepackedWeights = "session.numa_replicate_prepacked_weights";
+
+// Hoists the loop invariant nodes of Loop bodies into the graph of the Loop, and replaces a Loop whose trip count is a
+// constant of at most the given value, and whose body can't exit early, by one copy of its body per iteration.
+// The copies are then optimized together by the transformers that follow, e.g. ConstantFolding and CSE.
+// Hoisted nodes run once per run of the graph, also when the Loop would run zero iterations.
+// Option values:
+// - "0": Loop nodes are not rewritten. [DEFAULT]
+// - a positive integer N: loop invariant nodes are hoisted, and Loops of at most N iterations are unrolled.
+static const char* const kOrtSessionOptionsLoopUnrollMaxTripCount = "session.loop_unroll_max_trip_count";
+
+// A graph whose execution plan is a single sequence of CPU kernels, without synchronization between streams, is run
+// by a loop over its kernels instead of the generic execution steps. Per node instrumentation is skipped, so this
+// loop is only used on the runs that aren't profiled. The loop is meant for small models of short kernels whose
+// run time is dominated by the per node overhead of the executor.
+// Option values:
+// - "0": eligible graphs are run by the loop over their kernels. [DEFAULT]
+// - "1": graphs are always run by the execution steps.
+static const char* const kOrtSessionOptionsDisableLeanExecution = "session.disable_lean_execution";
+
+// Has the intra-op thread pool learn, for each kernel, the total cost of the TryParallelFor loops below which they run
+// in the calling thread, because handing them off to the pool threads takes longer than the work. The time of the
+// loops is measured and compared with the time of the loops of the kernel run the other way. The learned thresholds
+// are reported in the "thread_scheduling_stats" of the kernel events of a profile.
+// Ignored with an external or a global thread pool.
+// Option values:
+// - "0": loops are run as decided by the cost model of TryParallelFor. [DEFAULT]
+// - "1": the kernels learn the cost below which their loops run in the calling thread.
+static const char* const kOrtSessionOptionsConfigAdaptiveInlineThreshold = "session.intra_op.adaptive_inline_threshold";
+
+// Has the spinning intra-op threads tune how long they spin before blocking from how long they recently waited for
+// work, instead of spinning a fixed number of times. The threads keep spinning in between the parallel sections of
+// a run, so they don't pay the wake-up latency of a blocked thread, and block shortly once the work stops arriving,
+// e.g. in between requests, so that idle cores don't burn power. On the CPUs supporting it the spinning threads wait
+// with TPAUSE. Ignored if "session.intra_op.allow_spinning" is "0", and with an external or a global thread pool.
+// Option values:
+// - "0": the threads spin a fixed number of times before blocking. [DEFAULT]
+// - "1": the spin duration of the threads is tuned from their recent waits for work.
+static const char* const kOrtSessionOptionsConfigAdaptiveIntraOpSpinning = "session.intra_op.adaptive_spinning";
+
+// Default priority of the runs of the session in the intra-op and inter-op thread pools, which "run.high_priority"
+// of the run options overrides. The pool threads take the work of the high priority runs before the other work at
+// their next task boundary, e.g. for a latency-critical model sharing a global thread pool with batch models.
+// Option values:
+// - "0": the runs are normal priority. [DEFAULT]
+// - "1": the runs are high priority.
+static const char* const kOrtSessionOptionsConfigHighPriority = "session.high_priority";
+
+// Minimum number of connected nodes an execution provider other than the CPU EP keeps out of the single nodes it can
+// run with its kernels. Smaller groups, e.g. a lone node between CPU nodes, are left to the next execution provider,
+// usually the CPU EP, as the copies of their inputs and outputs between the devices often take longer than the nodes.
+// Compiling execution providers, which claim fused groups of nodes, and those preferring the NHWC layout are not
+// affected. The groups kept and the ones left are logged at INFO level.
+// Option values:
+// - "0": all the nodes an execution provider can run are assigned to it. [DEFAULT]
+// - a positive integer N: groups of fewer than N connected nodes are left to the next execution provider.
+static const char* const kOrtSessionOptionsMinEpNodeGroupSize = "session.min_ep_node_group_size";
+
+// Trims the arenas of the session from a background thread at this interval, in milliseconds, instead of shrinking
+// them at the end of a run on the request thread like the "memory.enable_memory_arena_shrinkage" run option. A trim
+// frees the arena regions in which no chunk has been in use for "session.arena_trim_max_idle_ms", then the idle
+// regions above the "session.arena_trim_max_retained_bytes" budget of each arena, the ones idle the longest first.
+// Option values:
+// - "0": the arenas are not trimmed. [DEFAULT]
+// - a positive integer: the interval between two trims in milliseconds.
+static const char* const kOrtSessionOptionsArenaTrimIntervalMs = "session.arena_trim_interval_ms";
+
+// The time, in milliseconds, a region must have been idle before the arena trimmer frees it. It is rounded up to a
+// multiple of the trim interval. Defaults to "10000".
+static const char* const kOrtSessionOptionsArenaTrimMaxIdleMs = "session.arena_trim_max_idle_ms";
+
+// The number of bytes each arena keeps at most when the arena trimmer runs, as long as they are not in use.
+// Defaults to no limit, in which case only the regions idle for "session.arena_trim_max_idle_ms" are freed.
+static const char* const kOrtSessionOptionsArenaTrimMaxRetainedBytes = "session.arena_trim_max_retained_bytes";
+
+// Runs the compute heavy float nodes (MatMul, Gemm, Conv, ConvTranspose, FusedMatMul, Attention, MultiHeadAttention)
+// in a lower precision where the execution provider they are assigned to has kernels for it. The CPU provider only
+// registers its float16 kernels on CPUs with a fast path for them. The numerically sensitive ops (Softmax,
+// normalizations, reductions) stay in float. Cast nodes are inserted at the ends of the chains of converted nodes and
+// constant weights are converted once.
+// Option values:
+// - "": nodes keep the precision of the model. [DEFAULT]
+// - "fp16": converts to float16.
+// - "bf16": converts to bfloat16.
+static const char* const kOrtSessionOptionsAutocastType = "session.autocast_type";
+
+// Comma separated op types converted by "session.autocast_type" instead of the default ones, e.g. "MatMul,Gemm".
+// The numerically sensitive ops are never converted.
+static const char* const kOrtSessionOptionsAutocastAllowOps = "session.autocast_allow_ops";
+
+// Comma separated op types or node names never converted by "session.autocast_type", e.g. "Conv,/head/MatMul".
+static const char* const kOrtSessionOptionsAutocastDenyList = "session.autocast_deny_list";
+
+// Runs the float Conv, FusedConv, MaxPool, AveragePool and GlobalAveragePool nodes assigned to the CPU execution
+// provider with channels last (NHWC) kernels at optimization level 3, like the fp16 and quantized ones. The transpose
+// optimizer then pushes the layout Transposes through the element wise ops and the 4-D linear Resize nodes, so a
+// convolutional model only transposes at its inputs and outputs. The NCHWc layout transformer is not used then.
+// Option values:
+// - "0": float convolutions run in NCHW or NCHWc. [DEFAULT]
+// - "1": float convolutions run in NHWC.
+static const char* const kOrtSessionOptionsEnableFp32NhwcLayout = "session.enable_fp32_nhwc_layout";
+
+// The size in bytes above which constant folding leaves a node to be computed at run time when folding it would add
+// constants larger than its constant inputs, e.g. an Expand or Tile of a small tensor to a large shape. The folded
+// constants are reused by later sessions for the same model with "session.optimized_model_cache_dir".
+// Option values:
+// - "0": the size of the folded constants is not limited. [DEFAULT]
+// - a positive integer: the budget in bytes for the outputs of each folded node.
+static const char* const kOrtSessionOptionsConstantFoldingMaxOutputBytes =
+    "optimization.constant_folding_max_output_bytes";
+
+// Number of timed calibration runs with which the OrtExecutionProviderDevicePolicy_MAX_PERFORMANCE policy picks the
+// execution provider device. Each candidate device, with the ORT CPU EP as fallback, gets a temporary session of the
+// model that runs once to warm up and then the given number of times with the zero-filled inputs of the warm-up runs
+// (see "session.warm_up_dims"). The device with the lowest median run time is selected. Candidates that fail to
+// create or run the model are skipped.
+// Option values:
+// - "0": MAX_PERFORMANCE prefers a GPU like OrtExecutionProviderDevicePolicy_PREFER_GPU. [DEFAULT]
+// - a positive integer: the number of timed runs for each candidate device.
+static const char* const kOrtSessionOptionsEpSelectionCalibrationRuns = "session.ep_selection_calibration_runs";
+
+// Path of a file keeping the calibration run times of "session.ep_selection_calibration_runs" between sessions,
+// keyed by the model and the device. The candidates with a cached time are not run again, so only the first session
+// of a model on a machine pays for the calibration. The file is created if it does not exist.
+static const char* const kOrtSessionOptionsEpSelectionCacheFile = "session.ep_selection_cache_file";
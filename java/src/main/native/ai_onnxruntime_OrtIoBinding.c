@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2025, Oracle and/or its affiliates. All rights reserved.
+ * Licensed under the MIT License.
+ */
+#include <jni.h>
+#include "onnxruntime/core/session/onnxruntime_c_api.h"
+#include "OrtJniUtil.h"
+#include "ai_onnxruntime_OrtIoBinding.h"
+
+/*
+ * Binds the inputs and outputs of a session to OrtValues ahead of the runs. Values created over direct ByteBuffers
+ * (OnnxTensor.createTensor with a direct buffer) are read and written by ORT in place, so a binding reused across
+ * runs doesn't copy the tensors between the JVM and native memory, nor create new Java objects per run.
+ */
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    createIoBinding
+ * Signature: (JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_ai_onnxruntime_OrtIoBinding_createIoBinding
+    (JNIEnv* jniEnv, jclass jclazz, jlong apiHandle, jlong sessionHandle) {
+  (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtSession* session = (OrtSession*) sessionHandle;
+  OrtIoBinding* binding = NULL;
+  checkOrtStatus(jniEnv, api, api->CreateIoBinding(session, &binding));
+  return (jlong) binding;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    bindInput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_bindInput
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong handle, jstring name, jlong valueHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtIoBinding* binding = (OrtIoBinding*) handle;
+  const OrtValue* value = (const OrtValue*) valueHandle;
+  const char* cName = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  checkOrtStatus(jniEnv, api, api->BindInput(binding, cName, value));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, cName);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    bindOutput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_bindOutput
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong handle, jstring name, jlong valueHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtIoBinding* binding = (OrtIoBinding*) handle;
+  const OrtValue* value = (const OrtValue*) valueHandle;
+  const char* cName = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  checkOrtStatus(jniEnv, api, api->BindOutput(binding, cName, value));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, cName);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    bindOutputToAllocator
+ * Signature: (JJLjava/lang/String;J)V
+ * Binds an output whose shape is not known ahead of the run, it is allocated by ORT with the allocator.
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_bindOutputToAllocator
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong handle, jstring name, jlong allocatorHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtIoBinding* binding = (OrtIoBinding*) handle;
+  OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+  const OrtMemoryInfo* allocatorInfo;
+  OrtErrorCode code = checkOrtStatus(jniEnv, api, api->AllocatorGetInfo(allocator, &allocatorInfo));
+  if (code != ORT_OK) {
+    return;
+  }
+  const char* cName = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  checkOrtStatus(jniEnv, api, api->BindOutputToDevice(binding, cName, allocatorInfo));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, cName);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    clearBoundInputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_clearBoundInputs
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong handle) {
+  (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ClearBoundInputs((OrtIoBinding*) handle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    clearBoundOutputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_clearBoundOutputs
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong handle) {
+  (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ClearBoundOutputs((OrtIoBinding*) handle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    synchronizeInputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_synchronizeInputs
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong handle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  checkOrtStatus(jniEnv, api, api->SynchronizeBoundInputs((OrtIoBinding*) handle));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    synchronizeOutputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_synchronizeOutputs
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong handle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  checkOrtStatus(jniEnv, api, api->SynchronizeBoundOutputs((OrtIoBinding*) handle));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    run
+ * Signature: (JJJJ)V
+ * The outputs bound to values are written in place, so nothing is returned.
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_run
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong handle, jlong runOptionsHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtSession* session = (OrtSession*) sessionHandle;
+  const OrtIoBinding* binding = (const OrtIoBinding*) handle;
+  const OrtRunOptions* runOptions = (const OrtRunOptions*) runOptionsHandle;
+  checkOrtStatus(jniEnv, api, api->RunWithBinding(session, runOptions, binding));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    getOutputValues
+ * Signature: (JJJ)[Lai/onnxruntime/OnnxValue;
+ * Returns the outputs of the last run in the order they were bound, as new Java objects owning new references
+ * to the bound values.
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtIoBinding_getOutputValues
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong handle, jlong allocatorHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  const OrtIoBinding* binding = (const OrtIoBinding*) handle;
+  OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+
+  OrtValue** outputValues = NULL;
+  size_t numOutputs = 0;
+  OrtErrorCode code = checkOrtStatus(jniEnv, api, api->GetBoundOutputValues(binding, allocator, &outputValues, &numOutputs));
+  if (code != ORT_OK) {
+    return NULL;
+  }
+
+  char* onnxValueClassName = "ai/onnxruntime/OnnxValue";
+  jclass onnxValueClazz = (*jniEnv)->FindClass(jniEnv, onnxValueClassName);
+  jobjectArray outputArray = (*jniEnv)->NewObjectArray(jniEnv, safecast_size_t_to_jsize(numOutputs), onnxValueClazz, NULL);
+
+  size_t i = 0;
+  for (; i < numOutputs; i++) {
+    jobject onnxValue = convertOrtValueToONNXValue(jniEnv, api, allocator, outputValues[i]);
+    if (onnxValue == NULL) {
+      // exception thrown, the values not converted yet are released below
+      outputArray = NULL;
+      break;
+    }
+    (*jniEnv)->SetObjectArrayElement(jniEnv, outputArray, (jsize) i, onnxValue);
+  }
+  for (; i < numOutputs; i++) {
+    api->ReleaseValue(outputValues[i]);
+  }
+
+  code = checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, outputValues));
+  if (code != ORT_OK) {
+    return NULL;
+  }
+  return outputArray;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    close
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_close
+    (JNIEnv* jniEnv, jobject jobj, jlong apiHandle, jlong handle) {
+  (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ReleaseIoBinding((OrtIoBinding*) handle);
+}
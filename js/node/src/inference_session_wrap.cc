@@ -9,6 +9,8 @@
 #include "run_options_helper.h"
 #include "session_options_helper.h"
 #include "tensor_helper.h"
+#include <memory>
+#include <stdexcept>
 #include <string>
 
 Napi::Object InferenceSessionWrap::Init(Napi::Env env, Napi::Object exports) {
@@ -26,6 +28,7 @@ Napi::Object InferenceSessionWrap::Init(Napi::Env env, Napi::Object exports) {
       env, "InferenceSession",
       {InstanceMethod("loadModel", &InferenceSessionWrap::LoadModel),
        InstanceMethod("run", &InferenceSessionWrap::Run),
+       InstanceMethod("runAsync", &InferenceSessionWrap::RunAsync),
        InstanceMethod("dispose", &InferenceSessionWrap::Dispose),
        InstanceMethod("endProfiling", &InferenceSessionWrap::EndProfiling),
        InstanceAccessor("inputMetadata", &InferenceSessionWrap::GetMetadata, nullptr, napi_default, reinterpret_cast<void*>(true)),
@@ -57,7 +60,7 @@ Napi::Value InferenceSessionWrap::InitOrtOnce(const Napi::CallbackInfo& info) {
 }
 
 InferenceSessionWrap::InferenceSessionWrap(const Napi::CallbackInfo& info)
-    : Napi::ObjectWrap<InferenceSessionWrap>(info), initialized_(false), disposed_(false), session_(nullptr) {}
+    : Napi::ObjectWrap<InferenceSessionWrap>(info), initialized_(false), disposed_(false), pendingRuns_(0), session_(nullptr) {}
 
 Napi::Value InferenceSessionWrap::LoadModel(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
@@ -161,7 +164,7 @@ Napi::Value InferenceSessionWrap::GetMetadata(const Napi::CallbackInfo& info) {
   return scope.Escape(array);
 }
 
-Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo& info) {
+void InferenceSessionWrap::PrepareRun(const Napi::CallbackInfo& info, RunContext& context) {
   Napi::Env env = info.Env();
   ORT_NAPI_THROW_ERROR_IF(!this->initialized_, env, "Session is not initialized.");
   ORT_NAPI_THROW_ERROR_IF(this->disposed_, env, "Session already disposed.");
@@ -170,98 +173,183 @@ Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo& info) {
                               "Expect inputs(feed) and outputs(fetch) to be objects.");
   ORT_NAPI_THROW_TYPEERROR_IF(info.Length() > 2 && (!info[2].IsObject() || info[2].IsNull()), env,
                               "'runOptions' must be an object.");
-
-  Napi::EscapableHandleScope scope(env);
+  ORT_NAPI_THROW_ERROR_IF(preferredOutputLocations_.size() != 0 &&
+                              preferredOutputLocations_.size() != outputNames_.size(),
+                          env, "Preferred output locations must have the same size as output names.");
 
   auto feed = info[0].As<Napi::Object>();
   auto fetch = info[1].As<Napi::Object>();
 
-  std::vector<const char*> inputNames_cstr;
-  std::vector<Ort::Value> inputValues;
-  std::vector<const char*> outputNames_cstr;
-  std::vector<Ort::Value> outputValues;
-  std::vector<bool> reuseOutput;
-  size_t inputIndex = 0;
-  size_t outputIndex = 0;
-  Ort::MemoryInfo cpuMemoryInfo = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
-  Ort::MemoryInfo gpuBufferMemoryInfo{"WebGPU_Buffer", OrtDeviceAllocator, 0, OrtMemTypeDefault};
+  for (auto& name : inputNames_) {
+    if (feed.Has(name)) {
+      context.inputNames.push_back(name.c_str());
+      auto value = feed.Get(name);
+      context.inputValues.push_back(
+          NapiValueToOrtValue(env, value, context.cpuMemoryInfo, context.gpuBufferMemoryInfo));
+    }
+  }
+  for (auto& name : outputNames_) {
+    if (fetch.Has(name)) {
+      context.outputNames.push_back(name.c_str());
+      auto value = fetch.Get(name);
+      context.reuseOutput.push_back(!value.IsNull());
+      context.outputValues.emplace_back(
+          value.IsNull() ? Ort::Value{nullptr}
+                         : NapiValueToOrtValue(env, value, context.cpuMemoryInfo, context.gpuBufferMemoryInfo));
+    }
+  }
+
+  if (info.Length() > 2) {
+    context.runOptions = Ort::RunOptions{};
+    ParseRunOptions(info[2].As<Napi::Object>(), context.runOptions);
+  }
+}
 
-  try {
-    for (auto& name : inputNames_) {
-      if (feed.Has(name)) {
-        inputIndex++;
-        inputNames_cstr.push_back(name.c_str());
-        auto value = feed.Get(name);
-        inputValues.push_back(NapiValueToOrtValue(env, value, cpuMemoryInfo, gpuBufferMemoryInfo));
-      }
+void InferenceSessionWrap::ExecuteRun(RunContext& context, Ort::IoBinding* ioBinding) {
+  const size_t inputCount = context.inputNames.size();
+  const size_t outputCount = context.outputNames.size();
+  Ort::RunOptions& runOptions =
+      context.runOptions == nullptr ? *OrtInstanceData::OrtDefaultRunOptions() : context.runOptions;
+
+  if (preferredOutputLocations_.size() == 0) {
+    session_->Run(runOptions,
+                  inputCount == 0 ? nullptr : &context.inputNames[0],
+                  inputCount == 0 ? nullptr : &context.inputValues[0], inputCount,
+                  outputCount == 0 ? nullptr : &context.outputNames[0],
+                  outputCount == 0 ? nullptr : &context.outputValues[0], outputCount);
+  } else {
+    // IO binding
+    ioBinding->ClearBoundInputs();
+    ioBinding->ClearBoundOutputs();
+    for (size_t i = 0; i < inputCount; i++) {
+      ioBinding->BindInput(context.inputNames[i], context.inputValues[i]);
     }
-    for (auto& name : outputNames_) {
-      if (fetch.Has(name)) {
-        outputIndex++;
-        outputNames_cstr.push_back(name.c_str());
-        auto value = fetch.Get(name);
-        reuseOutput.push_back(!value.IsNull());
-        outputValues.emplace_back(value.IsNull() ? Ort::Value{nullptr} : NapiValueToOrtValue(env, value, cpuMemoryInfo, gpuBufferMemoryInfo));
+    for (size_t i = 0; i < outputCount; i++) {
+      // TODO: support preallocated output tensor (outputValues[i])
+
+      if (preferredOutputLocations_[i] == DATA_LOCATION_GPU_BUFFER) {
+        ioBinding->BindOutput(context.outputNames[i], context.gpuBufferMemoryInfo);
+      } else {
+        ioBinding->BindOutput(context.outputNames[i], context.cpuMemoryInfo);
       }
     }
 
-    Ort::RunOptions runOptions{nullptr};
-    if (info.Length() > 2) {
-      runOptions = Ort::RunOptions{};
-      ParseRunOptions(info[2].As<Napi::Object>(), runOptions);
+    session_->Run(runOptions, *ioBinding);
+
+    auto outputs = ioBinding->GetOutputValues();
+    if (outputs.size() != outputCount) {
+      throw std::runtime_error("Output count mismatch.");
     }
-    if (preferredOutputLocations_.size() == 0) {
-      session_->Run(runOptions == nullptr ? *OrtInstanceData::OrtDefaultRunOptions() : runOptions,
-                    inputIndex == 0 ? nullptr : &inputNames_cstr[0], inputIndex == 0 ? nullptr : &inputValues[0],
-                    inputIndex, outputIndex == 0 ? nullptr : &outputNames_cstr[0],
-                    outputIndex == 0 ? nullptr : &outputValues[0], outputIndex);
+    context.reuseOutput.assign(outputCount, false);
+    context.outputValues = std::move(outputs);
+  }
+}
 
-      Napi::Object result = Napi::Object::New(env);
+Napi::Object InferenceSessionWrap::CreateRunResult(Napi::Env env, RunContext& context) {
+  Napi::Object result = Napi::Object::New(env);
+  for (size_t i = 0; i < context.outputNames.size(); i++) {
+    // the outputs allocated by ORT are handed over to Javascript without a copy
+    result.Set(outputNames_[i], OrtValueToNapiValue(env, std::move(context.outputValues[i]), !context.reuseOutput[i]));
+  }
+  return result;
+}
 
-      for (size_t i = 0; i < outputIndex; i++) {
-        result.Set(outputNames_[i], OrtValueToNapiValue(env, std::move(outputValues[i])));
-      }
-      return scope.Escape(result);
-    } else {
-      // IO binding
-      ORT_NAPI_THROW_ERROR_IF(preferredOutputLocations_.size() != outputNames_.size(), env,
-                              "Preferred output locations must have the same size as output names.");
+Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::EscapableHandleScope scope(env);
 
-      for (size_t i = 0; i < inputIndex; i++) {
-        ioBinding_->BindInput(inputNames_cstr[i], inputValues[i]);
-      }
-      for (size_t i = 0; i < outputIndex; i++) {
-        // TODO: support preallocated output tensor (outputValues[i])
-
-        if (preferredOutputLocations_[i] == DATA_LOCATION_GPU_BUFFER) {
-          ioBinding_->BindOutput(outputNames_cstr[i], gpuBufferMemoryInfo);
-        } else {
-          ioBinding_->BindOutput(outputNames_cstr[i], cpuMemoryInfo);
-        }
-      }
+  try {
+    RunContext context;
+    PrepareRun(info, context);
+    ExecuteRun(context, ioBinding_.get());
+    return scope.Escape(CreateRunResult(env, context));
+  } catch (Napi::Error const& e) {
+    throw e;
+  } catch (std::exception const& e) {
+    ORT_NAPI_THROW_ERROR(env, e.what());
+  }
+}
+
+// runs a session on a thread of the libuv thread pool and settles a promise with the result on the main thread.
+class InferenceSessionWrap::RunWorker : public Napi::AsyncWorker {
+ public:
+  RunWorker(const Napi::CallbackInfo& info, InferenceSessionWrap* session)
+      : Napi::AsyncWorker(info.Env(), "onnxruntime.run"),
+        session_(session),
+        deferred_(Napi::Promise::Deferred::New(info.Env())) {
+    session_->PrepareRun(info, context_);
+    if (session_->preferredOutputLocations_.size() != 0) {
+      // the binding of the session is only used by the synchronous run, concurrent runs each need their own
+      ioBinding_ = std::make_unique<Ort::IoBinding>(*session_->session_);
+    }
 
-      session_->Run(runOptions == nullptr ? *OrtInstanceData::OrtDefaultRunOptions() : runOptions, *ioBinding_);
+    // keep the session and the buffers of the feeds and fetches alive until the run completes
+    sessionRef_ = Napi::Persistent(info.This().As<Napi::Object>());
+    feedRef_ = Napi::Persistent(info[0].As<Napi::Object>());
+    fetchRef_ = Napi::Persistent(info[1].As<Napi::Object>());
+  }
 
-      auto outputs = ioBinding_->GetOutputValues();
-      ORT_NAPI_THROW_ERROR_IF(outputs.size() != outputIndex, env, "Output count mismatch.");
+  Napi::Promise Promise() const { return deferred_.Promise(); }
 
-      Napi::Object result = Napi::Object::New(env);
-      for (size_t i = 0; i < outputIndex; i++) {
-        result.Set(outputNames_[i], OrtValueToNapiValue(env, std::move(outputs[i])));
-      }
-      return scope.Escape(result);
+ protected:
+  void Execute() override {
+    try {
+      session_->ExecuteRun(context_, ioBinding_.get());
+    } catch (std::exception const& e) {
+      SetError(e.what());
     }
+  }
+
+  void OnOK() override {
+    Napi::Env env = Env();
+    Napi::HandleScope scope(env);
+    session_->pendingRuns_--;
+    try {
+      deferred_.Resolve(session_->CreateRunResult(env, context_));
+    } catch (Napi::Error const& e) {
+      deferred_.Reject(e.Value());
+    }
+  }
+
+  void OnError(Napi::Error const& e) override {
+    Napi::HandleScope scope(Env());
+    session_->pendingRuns_--;
+    deferred_.Reject(e.Value());
+  }
+
+ private:
+  InferenceSessionWrap* session_;
+  Napi::Promise::Deferred deferred_;
+  RunContext context_;
+  std::unique_ptr<Ort::IoBinding> ioBinding_;
+  Napi::ObjectReference sessionRef_;
+  Napi::ObjectReference feedRef_;
+  Napi::ObjectReference fetchRef_;
+};
+
+Napi::Value InferenceSessionWrap::RunAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  RunWorker* worker = nullptr;
+  try {
+    worker = new RunWorker(info, this);
   } catch (Napi::Error const& e) {
     throw e;
   } catch (std::exception const& e) {
     ORT_NAPI_THROW_ERROR(env, e.what());
   }
+
+  // the worker deletes itself once the promise is settled
+  pendingRuns_++;
+  worker->Queue();
+  return worker->Promise();
 }
 
 Napi::Value InferenceSessionWrap::Dispose(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   ORT_NAPI_THROW_ERROR_IF(!this->initialized_, env, "Session is not initialized.");
   ORT_NAPI_THROW_ERROR_IF(this->disposed_, env, "Session already disposed.");
+  ORT_NAPI_THROW_ERROR_IF(this->pendingRuns_ > 0, env, "Session has runs in progress. Await them before disposing.");
 
   this->ioBinding_.reset(nullptr);
   this->session_.reset(nullptr);
@@ -60,6 +60,16 @@ class InferenceSessionWrap : public Napi::ObjectWrap<InferenceSessionWrap> {
    */
   Napi::Value Run(const Napi::CallbackInfo& info);
 
+  /**
+   * [async] run the model on a thread of the libuv thread pool, so the event loop is not blocked.
+   * The input data is read in place, so the input tensors must not be modified until the promise is settled.
+   * @param arg0 input object: all keys must present, value is object
+   * @param arg1 output object: at least one key must present, value can be null.
+   * @returns a promise of an object that every output specified will present and value must be object
+   * @throw error if the arguments are invalid, the promise is rejected if status code != 0
+   */
+  Napi::Value RunAsync(const Napi::CallbackInfo& info);
+
   /**
    * [sync] dispose the session.
    * @param nothing
@@ -76,11 +86,37 @@ class InferenceSessionWrap : public Napi::ObjectWrap<InferenceSessionWrap> {
    */
   Napi::Value EndProfiling(const Napi::CallbackInfo& info);
 
+  // the feeds and fetches of a run, converted from the Javascript objects.
+  struct RunContext {
+    Ort::MemoryInfo cpuMemoryInfo{Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault)};
+    Ort::MemoryInfo gpuBufferMemoryInfo{"WebGPU_Buffer", OrtDeviceAllocator, 0, OrtMemTypeDefault};
+    std::vector<const char*> inputNames;
+    std::vector<Ort::Value> inputValues;
+    std::vector<const char*> outputNames;
+    std::vector<Ort::Value> outputValues;
+    // true for the outputs written to a tensor given in the fetches
+    std::vector<bool> reuseOutput;
+    Ort::RunOptions runOptions{nullptr};
+  };
+
+  // validate the arguments of run() and convert the feeds and fetches. Must be called on the main thread.
+  void PrepareRun(const Napi::CallbackInfo& info, RunContext& context);
+
+  // run the session. It doesn't touch any Javascript object, so it may be called from a worker thread.
+  void ExecuteRun(RunContext& context, Ort::IoBinding* ioBinding);
+
+  // convert the outputs of a run to an object of Javascript tensors. Must be called on the main thread.
+  Napi::Object CreateRunResult(Napi::Env env, RunContext& context);
+
+  class RunWorker;
+
   // private members
 
   // session objects
   bool initialized_;
   bool disposed_;
+  // number of runAsync() not settled yet, the session can't be disposed until they are
+  int pendingRuns_;
   std::unique_ptr<Ort::Session> session_;
 
   // input/output metadata
@@ -221,7 +221,7 @@ Ort::Value NapiValueToOrtValue(Napi::Env env, Napi::Value value, OrtMemoryInfo*
   }
 }
 
-Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value&& value) {
+Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value&& value, bool shareData) {
   Napi::EscapableHandleScope scope(env);
 
   auto typeInfo = value.GetTypeInfo();
@@ -307,10 +307,30 @@ Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value&& value) {
 
       return scope.Escape(tensorFromGpuBuffer.Call({Napi::External<OrtValue>::New(env, underlyingOrtValue), options}));
     } else {
-      // TODO: optimize memory
-      auto arrayBuffer = Napi::ArrayBuffer::New(env, size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
-      if (size > 0) {
-        memcpy(arrayBuffer.Data(), value.GetTensorRawData(), size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
+      const size_t byteLength = size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType];
+      napi_value arrayBuffer = nullptr;
+      if (shareData && size > 0) {
+        OrtValue* underlyingOrtValue = value;
+        napi_status status = napi_create_external_arraybuffer(
+            env, const_cast<void*>(value.GetTensorRawData()), byteLength,
+            [](napi_env /*env*/, void* /*data*/, void* hint) {
+              Ort::GetApi().ReleaseValue(reinterpret_cast<OrtValue*>(hint));
+            },
+            underlyingOrtValue, &arrayBuffer);
+        if (status == napi_ok) {
+          // the OrtValue is now owned by the ArrayBuffer
+          value.release();
+        } else {
+          // external buffers are not allowed by some runtimes, e.g. Electron, fall back to a copy.
+          arrayBuffer = nullptr;
+        }
+      }
+      if (arrayBuffer == nullptr) {
+        auto copy = Napi::ArrayBuffer::New(env, byteLength);
+        if (size > 0) {
+          memcpy(copy.Data(), value.GetTensorRawData(), byteLength);
+        }
+        arrayBuffer = copy;
       }
       napi_value typedArrayData;
       napi_status status =
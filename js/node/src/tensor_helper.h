@@ -11,8 +11,11 @@
 // convert a Javascript OnnxValue object to an OrtValue object
 Ort::Value NapiValueToOrtValue(Napi::Env env, Napi::Value value, OrtMemoryInfo* cpu_memory_info, OrtMemoryInfo* webgpu_memory_info);
 
-// convert an OrtValue object to a Javascript OnnxValue object
-Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value&& value);
+// convert an OrtValue object to a Javascript OnnxValue object.
+// if shareData is true, the data of a CPU tensor is not copied: the tensor is backed by an external ArrayBuffer over
+// the OrtValue's buffer, which releases the OrtValue when it is collected. It must only be set for values that own
+// their buffer.
+Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value&& value, bool shareData = false);
 
 enum DataLocation {
   DATA_LOCATION_NONE = 0,
@@ -11,6 +11,8 @@
 #include "core/common/span_utils.h"
 #include "core/platform/threadpool.h"
 
+#include <vector>
+
 using onnxruntime::narrow;
 using onnxruntime::concurrency::ThreadPool;
 namespace onnxruntime {
@@ -253,11 +255,13 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
     const auto* weights_data = weights ? weights->Data<T>() : nullptr;
     const auto* bias_data = bias->Data<T>();
 
-    // We use Q/K head size to estimate the cost, this is not accurate when Q/K and V head sizes are different.
-    const double cost = static_cast<double>(sequence_length) *
-                        static_cast<double>(parameters.head_size) * static_cast<double>(input_hidden_size);
+    // One projection per batch, head and Q, K or V. The bias is broadcast to the outputs first, and then the
+    // projections run as a single grouped GEMM, so the work is split by each head size and the thread pool is
+    // dispatched once.
+    std::vector<MLAS_SGEMM_GROUPED_PARAMS> gemms(loop_len);
+    const double broadcast_cost = static_cast<double>(sequence_length) * static_cast<double>(parameters.head_size);
 
-    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    ThreadPool::TryParallelFor(tp, loop_len, broadcast_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
       for (std::ptrdiff_t i = begin; i != end; ++i) {
         const int batch_index = static_cast<int>((i / 3) / num_heads_);
         const int head_index = static_cast<int>((i / 3) % num_heads_);
@@ -278,8 +282,7 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
 
         int qkv_offset = (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
 
-        // TODO!! memcpy here makes it not worthwhile to use Gemm batch. Possible to post process?
-        // broadcast NH -> (B.N.S.H) for each of Q, K, V
+        // broadcast NH -> (B.N.S.H) for each of Q, K, V, which the GEMM accumulates into
         const T* broadcast_data_src = bias_data + bias_offset;
         T* broadcast_data_dest = QKV[qkv_index] + qkv_offset;
 
@@ -293,44 +296,28 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
         // B: weights        (D_ixNxH_t)        D_i x (N.)H_t         D_i x H_t
         // C: QKV[qkv_index] (BxNxSxH_t)        (B.N.)S x H_t         S x H_t
         // Here H_t = H + H + H_v is size of one head of Q, K and V
+        MLAS_SGEMM_GROUPED_PARAMS& gemm = gemms[i];
+        gemm.M = sequence_length;    // M = S
+        gemm.N = head_size;          // N = H
+        gemm.K = input_hidden_size;  // K = D
+        gemm.Data.A = input_data + input_offset;
+        gemm.Data.lda = input_hidden_size;
+        gemm.Data.C = qkv_dest + qkv_offset;
+        gemm.Data.ldc = head_size;
+        gemm.Data.beta = 1.0f;
+
         if (is_prepack_) {
-          uint8_t* packed_weight;
-          packed_weight = static_cast<uint8_t*>(packed_weights_[qkv_index].get()) +
-                          packed_weights_size_[qkv_index] * (weights_offset / head_size);
-
-          MlasGemm(
-              CblasNoTrans,               // TransA = no
-              sequence_length,            // M      = S
-              head_size,                  // N      = H
-              input_hidden_size,          // K      = D
-              1.0f,                       // alpha
-              input_data + input_offset,  // A
-              input_hidden_size,          // lda    = D
-              packed_weight,              // B
-              1.0f,                       // beta
-              qkv_dest + qkv_offset,      // C
-              head_size,                  // ldc
-              nullptr);                   // use single-thread
+          gemm.Data.B = reinterpret_cast<const float*>(static_cast<uint8_t*>(packed_weights_[qkv_index].get()) +
+                                                       packed_weights_size_[qkv_index] * (weights_offset / head_size));
+          gemm.Data.BIsPacked = true;
         } else {
-          math::GemmEx<float, ThreadPool>(
-              CblasNoTrans,                   // TransA = no
-              CblasNoTrans,                   // TransB = no
-              sequence_length,                // M      = S
-              head_size,                      // N      = H
-              input_hidden_size,              // K      = D
-              1.0f,                           // alpha
-              input_data + input_offset,      // A
-              input_hidden_size,              // lda    = D
-              weights_data + weights_offset,  // B
-              qkv_hidden_size,                // ldb    = D + D + D_v
-              1.0f,                           // beta
-              qkv_dest + qkv_offset,          // C
-              head_size,                      // ldc
-              nullptr                         // use single-thread
-          );
+          gemm.Data.B = weights_data + weights_offset;
+          gemm.Data.ldb = qkv_hidden_size;  // D + D + D_v
         }
       }
     });
+
+    MlasGemmGrouped(gemms.data(), gemms.size(), tp);
   }
 
   // Compute the attention score and apply the score to V
@@ -63,6 +63,13 @@ constexpr const char* kDisableSparseAttentionV1 = "ORT_DISABLE_SPARSE_ATTENTION_
 
 namespace attention {
 
+// Quantization of a KV cache, as in the k_quant_type and v_quant_type attributes of GroupQueryAttention.
+enum class KVQuantizationType {
+  NONE,         // the cache has the type of the query
+  PER_TENSOR,   // int8 cache with a single scale
+  PER_CHANNEL,  // int8 cache with a scale for each channel of each head, with shape (kv_num_heads, 1, head_size)
+};
+
 enum class AttentionBackend : int {
   FLASH_ATTENTION = 1,
   EFFICIENT_ATTENTION = 2,
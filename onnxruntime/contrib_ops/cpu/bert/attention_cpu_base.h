@@ -8,15 +8,25 @@
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/env.h"
+#include "core/platform/env_var_utils.h"
+#include "core/platform/threadpool.h"
 #include "contrib_ops/cpu/utils/dump_tensor.h"
 
+#include <algorithm>
+#include <type_traits>
+
 namespace onnxruntime {
 namespace contrib {
 
 class AttentionCPUBase : public AttentionBase {
  protected:
   AttentionCPUBase(const OpKernelInfo& info, bool require_same_hidden_size)
-      : AttentionBase(info, require_same_hidden_size) {}
+      : AttentionBase(info, require_same_hidden_size) {
+    l2_cache_size_ = Env::Default().GetL2CacheSize();
+    disable_flash_ = ParseEnvironmentVariableWithDefault<bool>(attention::kDisableFlashAttention, false);
+  }
 
   template <typename T>
   Status ApplyAttention(const T* Q,                // Q data with shape BxNxSxH
@@ -54,6 +64,39 @@ class AttentionCPUBase : public AttentionBase {
       }
     }
 
+    // Without a mask, bias, past state or Q*K output the probabilities are never needed as a whole, so the tiled
+    // kernel computes the output without materializing the BxNxSxT buffer.
+    if constexpr (std::is_same_v<T, float>) {
+      const int flash_qk_head_size = qk_head_size == 0 ? v_head_size : qk_head_size;
+      if (!disable_flash_ && l2_cache_size_ > 0 &&
+          mask_index == nullptr && attn_bias == nullptr && output_qk == nullptr &&
+          past == nullptr && past_key == nullptr && past_value == nullptr &&
+          past_sequence_length == 0 && !past_present_share_buffer &&
+          (present == nullptr || flash_qk_head_size == v_head_size)) {
+        ApplyFlashAttention(Q, K, V, output->MutableData<float>(), is_unidirectional_ && sequence_length > 1,
+                            batch_size, sequence_length, kv_sequence_length, flash_qk_head_size, v_head_size,
+                            allocator, tp);
+
+        // Without past state the present state is only the new K and V.
+        const size_t k_bytes = SafeInt<size_t>(batch_size) * num_heads_ * kv_sequence_length * flash_qk_head_size *
+                               sizeof(T);
+        const size_t v_bytes = SafeInt<size_t>(batch_size) * num_heads_ * kv_sequence_length * v_head_size *
+                               sizeof(T);
+        if (present != nullptr) {
+          T* present_data = present->MutableData<T>();
+          memcpy(present_data, K, k_bytes);
+          memcpy(present_data + k_bytes / sizeof(T), V, v_bytes);
+        }
+        if (present_key != nullptr) {
+          memcpy(present_key->MutableData<T>(), K, k_bytes);
+        }
+        if (present_value != nullptr) {
+          memcpy(present_value->MutableData<T>(), V, v_bytes);
+        }
+        return Status::OK();
+      }
+    }
+
     // Total sequence length including that of past state: T = P + L
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
 
@@ -184,7 +227,71 @@ class AttentionCPUBase : public AttentionBase {
     return Status::OK();
   }
 
+  int l2_cache_size_;   // size of the L2 cache used to choose the block sizes of flash attention
+  bool disable_flash_;  // whether flash attention is disabled through ORT_DISABLE_FLASH_ATTENTION
+
  private:
+  // Computes output(B, S, N, H_v) = Softmax(scale x Q x K') x V with the online-softmax tiled kernel of MLAS.
+  void ApplyFlashAttention(const float* Q,  // Q data with shape BxNxSxH
+                           const float* K,  // K data with shape BxNxLxH
+                           const float* V,  // V data with shape BxNxLxH_v
+                           float* output,   // output with shape BxSxNxH_v
+                           bool causal,     // whether query row i only attends to key rows 0..i
+                           int batch_size, int sequence_length, int kv_sequence_length,
+                           int qk_head_size, int v_head_size,
+                           const AllocatorPtr& allocator, concurrency::ThreadPool* tp) const {
+    MlasFlashAttentionThreadedArgs args;
+    args.batch_size = batch_size;
+    args.num_heads = num_heads_;
+    args.q_sequence_length = sequence_length;
+    args.kv_sequence_length = kv_sequence_length;
+    args.qk_head_size = qk_head_size;
+    args.v_head_size = v_head_size;
+    args.scale = (scale_ == 0.0f) ? 1.0f / sqrt(static_cast<float>(qk_head_size)) : scale_;
+    args.causal = causal;
+    /*
+      q_block_size, kv_block_size correspond to Br, Bc in the FlashAttention paper.
+      Let M = l2_cache_size / sizeof(float)
+      In the FlashAttention kernel, there are 5 big matrices that we need to keep in L2 cache:
+        slice of Q -- [Br, qk_head_size]
+        slice of K -- [Bc, qk_head_size]
+        slice of V -- [Bc, v_head_size]
+        result of QK -- [Br, Bc]
+        temporary output (same shape as QKV) -- [Br, v_head_size]
+      The total size of these matrices is (Br + Bc) * (qk_head_size + v_head_size) + Br * Bc
+      By taking Bc = M / (4 * (qk_head_size + v_head_size)), and Br = min(Bc, qk_head_size + v_head_size), we have
+        (Br + Bc) * (qk_head_size + v_head_size) + Br * Bc
+        <= 2 * Bc * (qk_head_size + v_head_size) + Br * Bc
+        <= 2 * Bc * (qk_head_size + v_head_size) + M/4
+        <= 2 * M/4 + M/4 = M * (3/4)
+
+      We leave 1/4 of the L2 cache for
+        1. storing small tensors l and m
+        2. instruction (code)
+    */
+    args.kv_block_size = l2_cache_size_ / (static_cast<int>(sizeof(float)) * 4 * (qk_head_size + v_head_size));
+    args.kv_block_size = std::max(args.kv_block_size, 1);  // avoid kv_block_size = 0
+    args.q_block_size = std::min(args.kv_block_size, qk_head_size + v_head_size);
+    args.kv_block_size = std::min(args.kv_block_size, kv_sequence_length);  // No point to have kv_block_size > kv_sequence_length
+    args.q_block_size = std::min(args.q_block_size, sequence_length);       // No point to have q_block_size > q_sequence_length
+
+    args.thread_count = concurrency::ThreadPool::DegreeOfParallelism(tp);
+    args.buffer_size_per_thread = (static_cast<size_t>(args.q_block_size) * 2 +
+                                   static_cast<size_t>(args.q_block_size) * static_cast<size_t>(args.kv_block_size) +
+                                   static_cast<size_t>(args.q_block_size) * static_cast<size_t>(args.v_head_size)) *
+                                  sizeof(float);
+    size_t buffer_bytes = args.buffer_size_per_thread * args.thread_count;
+    IAllocatorUniquePtr<void> buffer = IAllocator::MakeUniquePtr<void>(allocator, buffer_bytes);
+
+    args.buffer = reinterpret_cast<float*>(buffer.get());
+    args.query = Q;
+    args.key = K;
+    args.value = V;
+    args.output = output;
+
+    MlasFlashAttention(&args, tp);
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T) +
   //                                1 x mask_data(B, N, S, T)
@@ -222,6 +329,10 @@ class AttentionCPUBase : public AttentionBase {
     DUMP_CPU_TENSOR("K", K, batch_size, num_heads_, total_sequence_length, head_size);
     DUMP_CPU_TENSOR("Attn_Bias", attn_bias_data, attn_bias_dims);
 
+    // Unless the scaled Q*K' is an output, the mask, the attention bias and the softmax are applied to the
+    // probabilities of each head in a single pass, right after they are computed.
+    const bool fuse_softmax = output_qk == nullptr;
+
     {
       const int loop_len = batch_size * num_heads_;
       const float alpha = scale;
@@ -252,6 +363,11 @@ class AttentionCPUBase : public AttentionBase {
         unit_cost.bytes_stored += probs_matrix_bytes;
       }
 
+      if (fuse_softmax) {
+        // Maximum, exponential and normalization of each probability.
+        unit_cost.compute_cycles += static_cast<double>(SafeInt<ptrdiff_t>(3) * probs_matrix_size);
+      }
+
       ThreadPool::TryParallelFor(tp, loop_len, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
         for (std::ptrdiff_t i = begin; i != end; ++i) {
           const int batch_index = static_cast<int>(i) / num_heads_;
@@ -262,26 +378,26 @@ class AttentionCPUBase : public AttentionBase {
 
           T* output = attention_probs + output_offset;
 
+          // Attention bias has shape (B or 1, N or 1, S, T)
+          // Here we handle the broadcast of batch_size and num_heads dimensions.
+          ptrdiff_t attn_bias_offset = 0;
           if (attn_bias_data != nullptr) {
-            // Attention bias has shape (B or 1, N or 1, S, T)
-            // Here we handle the broadcast of batch_size and num_heads dimensions.
-            ptrdiff_t attn_bias_offset = 0;
             if (attn_bias_dims[0] != 1) {
               attn_bias_offset += SafeInt<ptrdiff_t>(batch_index) * attn_bias_dims[1] * probs_matrix_size;
             }
             if (attn_bias_dims[1] != 1) {
               attn_bias_offset += head_index * probs_matrix_size;
             }
+          }
 
+          // When the softmax is fused, it adds the mask and the attention bias itself.
+          if (!fuse_softmax && attn_bias_data != nullptr) {
             memcpy(output, attn_bias_data + attn_bias_offset, probs_matrix_bytes);
 
             if (mask_data != nullptr) {
-              // This can be optimized with vectorized add using MlasAddFloat32x4.
-              for (ptrdiff_t j = 0; j < probs_matrix_size; j++) {
-                output[j] += mask_data[mask_offset + j];
-              }
+              ApplyAttentionBias(output, mask_data + mask_offset, static_cast<int>(probs_matrix_size));
             }
-          } else if (mask_data != nullptr) {
+          } else if (!fuse_softmax && mask_data != nullptr) {
             // Broadcast mask data: (Bx)SxT -> (BxNx)SxT
             memcpy(output, mask_data + mask_offset, probs_matrix_bytes);
           }
@@ -306,22 +422,29 @@ class AttentionCPUBase : public AttentionBase {
           // C: attention_probs  (B x N x) S x T          (B x N x) S x T        S x T
           math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_sequence_length, head_size, alpha,
                                     Q + q_input_chunk_length * i, k,
-                                    (mask_data != nullptr || attn_bias_data != nullptr) ? 1.0f : 0.0f,
+                                    (!fuse_softmax && (mask_data != nullptr || attn_bias_data != nullptr)) ? 1.0f : 0.0f,
                                     output, nullptr);
+
+          if (fuse_softmax) {
+            // attention_probs(S, T) = Softmax(attention_probs + attention_bias + mask)
+            MLAS_SOFTMAX_MASK_PARAMS mask_params;
+            mask_params.Bias = attn_bias_data != nullptr ? attn_bias_data + attn_bias_offset : nullptr;
+            mask_params.Mask = mask_data != nullptr ? mask_data + mask_offset : nullptr;
+            MlasComputeSoftmax(output, output, sequence_length, total_sequence_length, false, false, &mask_params,
+                               nullptr);
+          }
         }
       });
     }
 
-    if (output_qk != nullptr) {
+    if (!fuse_softmax) {
       // Output the scaled Q*K^T if needed.
       memcpy(output_qk, attention_probs,
              SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T));
-    }
 
-    DUMP_CPU_TENSOR("QK (scaled)", attention_probs, batch_size, num_heads_, sequence_length, total_sequence_length);
+      DUMP_CPU_TENSOR("QK (scaled)", attention_probs, batch_size, num_heads_, sequence_length, total_sequence_length);
 
-    // attention_probs(B, N, S, T) = Softmax(attention_probs)
-    {
+      // attention_probs(B, N, S, T) = Softmax(attention_probs)
       const int N = batch_size * num_heads_ * sequence_length;
       const int D = total_sequence_length;
       ComputeAttentionSoftmaxInplace(attention_probs, N, D, tp);
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+
 #include "contrib_ops/cpu/bert/attention_base.h"
 #include "contrib_ops/cpu/bert/attention_common.h"
 #include "contrib_ops/cpu/bert/attention_helper.h"
@@ -35,6 +39,19 @@ class GQAAttentionBase {
     use_smooth_softmax_ = info.GetAttrOrDefault<int64_t>("smooth_softmax", 0) == 1;
 
     local_window_size_ = has_local ? static_cast<int>(info.GetAttrOrDefault<int64_t>("local_window_size", -1)) : -1;
+
+    k_quant_type_ = ParseKVQuantizationType(info.GetAttrOrDefault<std::string>("k_quant_type", "NONE"));
+    v_quant_type_ = ParseKVQuantizationType(info.GetAttrOrDefault<std::string>("v_quant_type", "NONE"));
+  }
+
+  static KVQuantizationType ParseKVQuantizationType(const std::string& quant_type) {
+    if (quant_type == "PER_TENSOR") {
+      return KVQuantizationType::PER_TENSOR;
+    } else if (quant_type == "PER_CHANNEL") {
+      return KVQuantizationType::PER_CHANNEL;
+    }
+    ORT_ENFORCE(quant_type == "NONE", "Unsupported KV cache quantization type: ", quant_type);
+    return KVQuantizationType::NONE;
   }
 
   int num_heads_;     // number of attention heads of Q
@@ -47,6 +64,9 @@ class GQAAttentionBase {
 
   bool use_smooth_softmax_;
 
+  KVQuantizationType k_quant_type_;  // quantization of the key cache
+  KVQuantizationType v_quant_type_;  // quantization of the value cache
+
   template <typename T>
   Status ApplyAttention(const T* Q,                                 // Q data with shape BxNxSxH
                         const T* K,                                 // K data with shape BxN_kvxSxH
@@ -127,6 +147,372 @@ class GQAAttentionBase {
     return Status::OK();
   }
 
+  // Attention over a paged KV cache. key_cache and value_cache are pools of blocks with shape
+  // (num_blocks, block_size, kv_num_heads, head_size) shared by all sequences, and token p of sequence b is in slot
+  // p % block_size of block block_table[b][p / block_size]. Q, K and V are rows of packed tokens, where sequence b
+  // has the tokens [cumulative_seqlens[b], cumulative_seqlens[b + 1]) that follow its past_seqlens[b] cached tokens.
+  // The new K and V tokens are written to the cache before attending to it.
+  template <typename T>
+  Status ApplyPagedAttention(const T* Q, size_t q_row_stride,             // Q rows of the packed tokens
+                             const T* K, size_t k_row_stride,             // K rows of the packed tokens
+                             const T* V, size_t v_row_stride,             // V rows of the packed tokens
+                             T* key_cache,                                // block-based key cache
+                             T* value_cache,                              // block-based value cache
+                             const int32_t* cumulative_seqlens,           // token offsets of the sequences
+                             const int32_t* past_seqlens,                 // cached token counts of the sequences
+                             const int32_t* block_table,                  // blocks of each sequence
+                             T* output,                                   // output with shape token_count x hidden_size
+                             const PagedAttentionParameters& parameters,  // attention parameters
+                             AllocatorPtr allocator,                      // allocator for temporary buffers
+                             OpKernelContext* context) const {
+    const size_t head_size = static_cast<size_t>(parameters.head_size);
+    const size_t kv_hidden_size = static_cast<size_t>(parameters.kv_hidden_size);
+    const size_t block_size = static_cast<size_t>(parameters.block_size);
+    const size_t max_num_blocks_per_seq = static_cast<size_t>(parameters.max_num_blocks_per_seq);
+
+    // the cache slot of token p of sequence b
+    auto cache_offset = [&](size_t b, size_t p) {
+      const size_t block = static_cast<size_t>(block_table[b * max_num_blocks_per_seq + p / block_size]);
+      return (block * block_size + p % block_size) * kv_hidden_size;
+    };
+
+    return ApplyPackedTokenAttention(Q, q_row_stride, K, k_row_stride, V, v_row_stride, key_cache, value_cache,
+                                     cache_offset, head_size, cumulative_seqlens, past_seqlens, parameters.batch_size,
+                                     head_size, output, allocator, context);
+  }
+
+  // Attention of rows of packed tokens to a KV cache, where sequence b has the tokens
+  // [cumulative_seqlens[b], cumulative_seqlens[b + 1]) that follow its past_seqlens[b] cached tokens, so prompts and
+  // token generation steps can be mixed in one batch. Token p of sequence b is at cache_offset(b, p) in the caches
+  // for the first KV head, and the KV heads are cache_head_stride elements apart. The new K and V tokens are written
+  // to the cache before attending to it.
+  template <typename T, typename CacheOffset>
+  Status ApplyPackedTokenAttention(const T* Q, size_t q_row_stride,    // Q rows of the packed tokens
+                                   const T* K, size_t k_row_stride,    // K rows of the packed tokens
+                                   const T* V, size_t v_row_stride,    // V rows of the packed tokens
+                                   T* key_cache,                       // key cache
+                                   T* value_cache,                     // value cache
+                                   const CacheOffset& cache_offset,    // offset of a cached token of a sequence
+                                   size_t cache_head_stride,           // distance of the KV heads in the caches
+                                   const int32_t* cumulative_seqlens,  // token offsets of the sequences
+                                   const int32_t* past_seqlens,        // cached token counts of the sequences
+                                   int batch_size,                     // number of sequences
+                                   size_t head_size,                   // head size of Q, K and V
+                                   T* output,                          // output with shape token_count x hidden_size
+                                   AllocatorPtr allocator,             // allocator for temporary buffers
+                                   OpKernelContext* context) const {
+    const size_t hidden_size = num_heads_ * head_size;
+
+    for (int b = 0; b < batch_size; ++b) {
+      const size_t past_seqlen = static_cast<size_t>(past_seqlens[b]);
+      for (int t = cumulative_seqlens[b]; t < cumulative_seqlens[b + 1]; ++t) {
+        const size_t offset = cache_offset(b, past_seqlen + static_cast<size_t>(t - cumulative_seqlens[b]));
+        for (int h = 0; h < kv_num_heads_; ++h) {
+          memcpy(key_cache + offset + h * cache_head_stride, K + t * k_row_stride + h * head_size,
+                 head_size * sizeof(T));
+          memcpy(value_cache + offset + h * cache_head_stride, V + t * v_row_stride + h * head_size,
+                 head_size * sizeof(T));
+        }
+      }
+    }
+
+    const size_t kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+
+    auto to_float = [](const T* src, float* dst, size_t count) {
+      if constexpr (std::is_same<T, float>::value) {
+        memcpy(dst, src, count * sizeof(float));
+      } else {
+        MlasConvertHalfToFloatBuffer(src, dst, count);
+      }
+    };
+
+    // Each task gathers the cached K and V of one KV head of a sequence and attends to them with the query heads
+    // sharing that KV head.
+    ThreadPool::TrySimpleParallelFor(
+        context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(batch_size) * kv_num_heads_,
+        [&](std::ptrdiff_t i) {
+          const size_t batch_index = i / kv_num_heads_;
+          const size_t kv_head_index = i % kv_num_heads_;
+          const size_t q_start = static_cast<size_t>(cumulative_seqlens[batch_index]);
+          const size_t sequence_length = static_cast<size_t>(cumulative_seqlens[batch_index + 1]) - q_start;
+          const size_t past_seqlen = static_cast<size_t>(past_seqlens[batch_index]);
+          const size_t total_seqlen = past_seqlen + sequence_length;
+          if (sequence_length == 0) {
+            return;
+          }
+
+          // K and V (T x H), Q and output (S x H) and the attention probs (S x T)
+          const size_t bytes = SafeInt<size_t>(sizeof(float)) *
+                               (2 * total_seqlen * head_size + 2 * sequence_length * head_size +
+                                sequence_length * total_seqlen);
+          auto buffer = allocator->Alloc(bytes);
+          BufferUniquePtr scratch_buffer(buffer, BufferDeleter(allocator));
+          float* k = static_cast<float*>(buffer);
+          float* v = k + total_seqlen * head_size;
+          float* q = v + total_seqlen * head_size;
+          float* out = q + sequence_length * head_size;
+          float* probs = out + sequence_length * head_size;
+
+          for (size_t p = 0; p < total_seqlen; ++p) {
+            const size_t offset = cache_offset(batch_index, p) + kv_head_index * cache_head_stride;
+            to_float(key_cache + offset, k + p * head_size, head_size);
+            to_float(value_cache + offset, v + p * head_size, head_size);
+          }
+
+          for (size_t group_index = 0; group_index < kv_num_heads_factor; ++group_index) {
+            const size_t head_index = kv_head_index * kv_num_heads_factor + group_index;
+            for (size_t s = 0; s < sequence_length; ++s) {
+              to_float(Q + (q_start + s) * q_row_stride + head_index * head_size, q + s * head_size, head_size);
+            }
+
+            math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_seqlen, head_size, alpha,
+                                            q, static_cast<int>(head_size), k, static_cast<int>(head_size),
+                                            0.0f /*beta*/, probs, static_cast<int>(total_seqlen), nullptr);
+
+            for (size_t s = 0; s < sequence_length; ++s) {
+              float* row = probs + s * total_seqlen;
+              const size_t seq_causal_length = past_seqlen + s + 1;
+
+              // local_window_size does not include the current query token, while window_size includes it.
+              const bool should_apply_local_window = local_window_size_ >= 0 &&
+                                                     seq_causal_length > static_cast<size_t>(local_window_size_) + 1;
+              const size_t start_offset = should_apply_local_window ? seq_causal_length - local_window_size_ - 1 : 0;
+              const size_t window_size = seq_causal_length - start_offset;
+
+              // Softcap, softmax and causal mask of the window in a single pass.
+              MLAS_SOFTMAX_MASK_PARAMS mask_params;
+              mask_params.Softcap = softcap_;
+              mask_params.Causal = true;
+              mask_params.CausalOffset = window_size - 1;
+              MlasComputeSoftmax(row + start_offset, row + start_offset, 1, total_seqlen - start_offset, false,
+                                 use_smooth_softmax_, &mask_params, nullptr);
+
+              std::fill(row, row + start_offset, 0.f);
+            }
+
+            math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, total_seqlen, 1.f,
+                                            probs, static_cast<int>(total_seqlen), v, static_cast<int>(head_size),
+                                            0.0f /*beta*/, out, static_cast<int>(head_size), nullptr);
+
+            for (size_t s = 0; s < sequence_length; ++s) {
+              T* dst = output + (q_start + s) * hidden_size + head_index * head_size;
+              if constexpr (std::is_same<T, float>::value) {
+                memcpy(dst, out + s * head_size, head_size * sizeof(float));
+              } else {
+                MlasConvertFloatToHalfBuffer(out + s * head_size, dst, head_size);
+              }
+            }
+          }
+        });
+
+    return Status::OK();
+  }
+
+  // Attention over an int8 KV cache with the scales k_scale and v_scale, which have one element when the cache is
+  // quantized per tensor or head_size elements for each KV head when it is quantized per channel. The new K and V
+  // tokens are quantized into the cache, and the cached tokens are dequantized on the fly: the key scales are folded
+  // into the query before the dot products with the int8 keys, and the value scales are applied once to the sum of
+  // the int8 values weighted by the attention probs, so the cache is read once at a quarter of the bytes of float.
+  template <typename T>
+  Status ApplyQuantizedKVCacheAttention(const T* Q,                                 // Q data with shape BxNxSxH
+                                        const T* K,                                 // K data with shape BxN_kvxSxH
+                                        const T* V,                                 // V data with shape BxN_kvxSxH
+                                        const Tensor* attention_bias,               // Attention bias to add to QxK'
+                                        const Tensor* past_key,                     // int8 past K input tensor
+                                        const Tensor* past_value,                   // int8 past V input tensor
+                                        Tensor* output,                             // output tensor
+                                        Tensor* present_key,                        // int8 present K output tensor
+                                        Tensor* present_value,                      // int8 present V output tensor
+                                        const Tensor* k_scale,                      // scale of the K cache
+                                        const Tensor* v_scale,                      // scale of the V cache
+                                        const Tensor* seqlens_k,                    // past sequence lengths tensor
+                                        GroupQueryAttentionParameters& parameters,  // attention parameters
+                                        AllocatorPtr allocator,                     // allocator for temporary buffers
+                                        OpKernelContext* context) const {
+    const bool is_prompt = parameters.is_first_prompt;
+    const size_t batch_size = static_cast<size_t>(parameters.batch_size);
+    const size_t sequence_length = static_cast<size_t>(parameters.sequence_length);
+    const size_t head_size = static_cast<size_t>(parameters.head_size);
+    const size_t kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const int32_t* seqlens_k_data = seqlens_k->Data<int32_t>();
+
+    const size_t past_buffer_sequence_length =
+        past_key != nullptr ? static_cast<size_t>(past_key->Shape().GetDims()[2]) : 0;
+    const size_t present_buffer_sequence_length = static_cast<size_t>(present_key->Shape().GetDims()[2]);
+    const int8_t* past_key_data = past_key != nullptr ? past_key->Data<int8_t>() : nullptr;
+    const int8_t* past_value_data = past_value != nullptr ? past_value->Data<int8_t>() : nullptr;
+    int8_t* present_key_data = present_key->MutableData<int8_t>();
+    int8_t* present_value_data = present_value->MutableData<int8_t>();
+    const bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
+
+    const float* k_scale_data = k_scale->Data<float>();
+    const float* v_scale_data = v_scale->Data<float>();
+    const bool k_per_channel = k_quant_type_ == KVQuantizationType::PER_CHANNEL;
+    const bool v_per_channel = v_quant_type_ == KVQuantizationType::PER_CHANNEL;
+
+    const T* attention_bias_data = attention_bias != nullptr ? attention_bias->Data<T>() : nullptr;
+    auto attention_bias_shape = attention_bias != nullptr ? attention_bias->Shape().GetDims() : gsl::span<const int64_t>{};
+
+    const bool packed_qkv = parameters.is_packed_qkv;
+    const size_t packed_batch_stride = packed_qkv ? (num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size : 0;
+    const size_t q_head_stride = sequence_length * head_size;
+    const T* k_input = packed_qkv ? Q + num_heads_ * q_head_stride : K;
+    const T* v_input = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * q_head_stride : V;
+    auto new_kv_chunk = [&](const T* input, size_t batch_index, size_t kv_head_index) {
+      return packed_qkv ? input + packed_batch_stride * batch_index + q_head_stride * kv_head_index
+                        : input + q_head_stride * (batch_index * kv_num_heads_ + kv_head_index);
+    };
+
+    auto to_float = [](T value) {
+      if constexpr (std::is_same<T, float>::value) {
+        return value;
+      } else {
+        return value.ToFloat();
+      }
+    };
+
+    auto quantize = [&](const T* src, const float* scale, bool per_channel, int8_t* dst) {
+      for (size_t i = 0; i < head_size; ++i) {
+        const float q = std::nearbyint(to_float(src[i]) / scale[per_channel ? i : 0]);
+        dst[i] = static_cast<int8_t>(std::clamp(q, -128.0f, 127.0f));
+      }
+    };
+
+    auto* tp = context->GetOperatorThreadPool();
+    const size_t present_chunk_length = present_buffer_sequence_length * head_size;
+
+    // Append the new tokens, quantized, to the cache of each KV head.
+    ThreadPool::TrySimpleParallelFor(
+        tp, static_cast<std::ptrdiff_t>(batch_size * kv_num_heads_), [&](std::ptrdiff_t i) {
+          const size_t batch_index = i / kv_num_heads_;
+          const size_t kv_head_index = i % kv_num_heads_;
+          const size_t total_seqlen = static_cast<size_t>(seqlens_k_data[batch_index]) + 1;
+          const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;
+
+          int8_t* present_k = present_key_data + i * present_chunk_length;
+          int8_t* present_v = present_value_data + i * present_chunk_length;
+          if (!past_present_share_buffer) {
+            memset(present_k, 0, present_chunk_length);
+            memset(present_v, 0, present_chunk_length);
+            if (past_seqlen > 0) {
+              memcpy(present_k, past_key_data + i * past_buffer_sequence_length * head_size, past_seqlen * head_size);
+              memcpy(present_v, past_value_data + i * past_buffer_sequence_length * head_size, past_seqlen * head_size);
+            }
+          }
+
+          const float* k_head_scale = k_scale_data + (k_per_channel ? kv_head_index * head_size : 0);
+          const float* v_head_scale = v_scale_data + (v_per_channel ? kv_head_index * head_size : 0);
+          const T* k = new_kv_chunk(k_input, batch_index, kv_head_index);
+          const T* v = new_kv_chunk(v_input, batch_index, kv_head_index);
+          for (size_t s = 0; s < sequence_length; ++s) {
+            quantize(k + s * head_size, k_head_scale, k_per_channel, present_k + (past_seqlen + s) * head_size);
+            quantize(v + s * head_size, v_head_scale, v_per_channel, present_v + (past_seqlen + s) * head_size);
+          }
+        });
+
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    T* output_data = output->MutableData<T>();
+
+    // Each task attends with one query head to the cache of its KV head.
+    ThreadPool::TrySimpleParallelFor(
+        tp, static_cast<std::ptrdiff_t>(batch_size * num_heads_), [&](std::ptrdiff_t i) {
+          const size_t batch_index = i / num_heads_;
+          const size_t head_index = i % num_heads_;
+          const size_t kv_head_index = head_index / kv_num_heads_factor;
+          const size_t total_seqlen = static_cast<size_t>(seqlens_k_data[batch_index]) + 1;
+          const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;
+
+          const int8_t* k_cache = present_key_data + (batch_index * kv_num_heads_ + kv_head_index) * present_chunk_length;
+          const int8_t* v_cache =
+              present_value_data + (batch_index * kv_num_heads_ + kv_head_index) * present_chunk_length;
+          const float* k_head_scale = k_scale_data + (k_per_channel ? kv_head_index * head_size : 0);
+          const float* v_head_scale = v_scale_data + (v_per_channel ? kv_head_index * head_size : 0);
+
+          const T* q = packed_qkv ? Q + packed_batch_stride * batch_index + q_head_stride * head_index
+                                  : Q + q_head_stride * i;
+
+          // Attention bias is of shape (B or 1, N or 1, S, T)
+          const T* attention_bias_thread = nullptr;
+          size_t attention_total_seqlen = 0;
+          if (attention_bias_data != nullptr) {
+            attention_total_seqlen = static_cast<size_t>(attention_bias_shape[3]);
+            size_t attention_bias_offset = 0;
+            if (attention_bias_shape[0] != 1) {
+              attention_bias_offset += batch_index * attention_bias_shape[1] * sequence_length * attention_total_seqlen;
+            }
+            if (attention_bias_shape[1] != 1) {
+              attention_bias_offset += head_index * sequence_length * attention_total_seqlen;
+            }
+            attention_bias_thread = attention_bias_data + attention_bias_offset;
+          }
+
+          // the scaled query, the scores of a row and the weighted sum of the values
+          const size_t max_causal_length = past_seqlen + sequence_length;
+          const size_t bytes = SafeInt<size_t>(sizeof(float)) * (2 * head_size + max_causal_length);
+          auto buffer = allocator->Alloc(bytes);
+          BufferUniquePtr scratch_buffer(buffer, BufferDeleter(allocator));
+          float* q_scaled = static_cast<float*>(buffer);
+          float* out = q_scaled + head_size;
+          float* scores = out + head_size;
+
+          for (size_t s = 0; s < sequence_length; ++s) {
+            const size_t seq_causal_length = past_seqlen + s + 1;
+
+            // local_window_size does not include the current query token, while window_size includes it.
+            const bool should_apply_local_window = local_window_size_ >= 0 &&
+                                                   seq_causal_length > static_cast<size_t>(local_window_size_) + 1;
+            const size_t start_offset = should_apply_local_window ? seq_causal_length - local_window_size_ - 1 : 0;
+            const size_t window_size = seq_causal_length - start_offset;
+
+            for (size_t h = 0; h < head_size; ++h) {
+              q_scaled[h] = to_float(q[s * head_size + h]) * alpha * k_head_scale[k_per_channel ? h : 0];
+            }
+
+            for (size_t p = start_offset; p < seq_causal_length; ++p) {
+              const int8_t* k_row = k_cache + p * head_size;
+              float score = 0.0f;
+              for (size_t h = 0; h < head_size; ++h) {
+                score += q_scaled[h] * static_cast<float>(k_row[h]);
+              }
+              scores[p - start_offset] = score;
+            }
+
+            if (softcap_ > 0.f) {
+              ComputeAttentionSoftcapInplace(scores, static_cast<int>(window_size), softcap_);
+            }
+            if (attention_bias_thread != nullptr) {
+              const T* bias_row = attention_bias_thread + s * attention_total_seqlen + start_offset;
+              for (size_t p = 0; p < window_size; ++p) {
+                scores[p] += to_float(bias_row[p]);
+              }
+            }
+            if (use_smooth_softmax_) {
+              ComputeSmoothSoftmaxInplace(scores, 1, static_cast<int>(window_size), nullptr);
+            } else {
+              ComputeAttentionSoftmaxInplace(scores, 1, static_cast<int>(window_size), nullptr);
+            }
+
+            std::fill_n(out, head_size, 0.0f);
+            for (size_t p = start_offset; p < seq_causal_length; ++p) {
+              const int8_t* v_row = v_cache + p * head_size;
+              const float prob = scores[p - start_offset];
+              for (size_t h = 0; h < head_size; ++h) {
+                out[h] += prob * static_cast<float>(v_row[h]);
+              }
+            }
+
+            // the output is BxSxNxH
+            T* dst = output_data + ((batch_index * sequence_length + s) * num_heads_ + head_index) * head_size;
+            for (size_t h = 0; h < head_size; ++h) {
+              dst[h] = static_cast<T>(out[h] * v_head_scale[v_per_channel ? h : 0]);
+            }
+          }
+        });
+
+    return Status::OK();
+  }
+
  private:
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
@@ -288,40 +674,51 @@ class GQAAttentionBase {
             }
           }
 
-          if (softcap_ > 0.f) {
-            ComputeAttentionSoftcapInplace(output_softmax + start_offset, static_cast<int>(window_size),
-                                           static_cast<U>(softcap_));
-          }
+          if constexpr (std::is_same_v<U, float> && std::is_same_v<T, float>) {
+            // Softcap, attention bias, softmax and causal mask of the window in a single pass.
+            MLAS_SOFTMAX_MASK_PARAMS mask_params;
+            mask_params.Bias = attention_bias_thread != nullptr ? attention_bias_thread + start_offset : nullptr;
+            mask_params.Softcap = softcap_;
+            mask_params.Causal = true;
+            mask_params.CausalOffset = window_size - 1;
+            MlasComputeSoftmax(output_softmax + start_offset, output_softmax + start_offset, 1,
+                               total_seqlen - start_offset, false, use_smooth_softmax_, &mask_params, nullptr);
+          } else {
+            if (softcap_ > 0.f) {
+              ComputeAttentionSoftcapInplace(output_softmax + start_offset, static_cast<int>(window_size),
+                                             static_cast<U>(softcap_));
+            }
 
-          // Add attention bias to QxK' if provided
-          // TODO (#23982): Implement bias addition during softmax computation in GQA CPU operator
-          if (attention_bias_thread != nullptr) {
-            if constexpr (std::is_same_v<U, T>) {
-              ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread + start_offset,
-                                 static_cast<int>(window_size));
-            } else {
-              static_assert(std::is_same_v<U, float> && std::is_same_v<T, MLFloat16>);
-              size_t bytes = window_size * sizeof(float);
-              auto attention_bias_thread_fp32 = static_cast<float*>(allocator->Alloc(bytes));
-              BufferUniquePtr scratch_buffer(attention_bias_thread_fp32, BufferDeleter(allocator));
+            // Add attention bias to QxK' if provided
+            // TODO (#23982): Implement bias addition during softmax computation in GQA CPU operator
+            if (attention_bias_thread != nullptr) {
+              if constexpr (std::is_same_v<U, T>) {
+                ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread + start_offset,
+                                   static_cast<int>(window_size));
+              } else {
+                static_assert(std::is_same_v<U, float> && std::is_same_v<T, MLFloat16>);
+                size_t bytes = window_size * sizeof(float);
+                auto attention_bias_thread_fp32 = static_cast<float*>(allocator->Alloc(bytes));
+                BufferUniquePtr scratch_buffer(attention_bias_thread_fp32, BufferDeleter(allocator));
 
-              MlasConvertHalfToFloatBuffer(attention_bias_thread + start_offset, attention_bias_thread_fp32, window_size);
-              ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread_fp32, static_cast<int>(window_size));
+                MlasConvertHalfToFloatBuffer(attention_bias_thread + start_offset, attention_bias_thread_fp32, window_size);
+                ApplyAttentionBias(output_softmax + start_offset, attention_bias_thread_fp32, static_cast<int>(window_size));
+              }
             }
-          }
-
-          if (use_smooth_softmax_) {
-            ComputeSmoothSoftmaxInplace(output_softmax + start_offset, 1, static_cast<int>(window_size), nullptr);
-          } else {
-            ComputeAttentionSoftmaxInplace(output_softmax + start_offset, 1, static_cast<int>(window_size), nullptr);
-          }
 
-          // set causal [seq_causal_length, total_seqlen) to 0.f
-          for (size_t total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
-            if constexpr (std::is_same<U, float>::value) {
-              output_softmax[total_seq_id] = 0.f;
+            if (use_smooth_softmax_) {
+              ComputeSmoothSoftmaxInplace(output_softmax + start_offset, 1, static_cast<int>(window_size), nullptr);
             } else {
-              output_softmax[total_seq_id] = MLFloat16::FromBits(static_cast<uint16_t>(0));
+              ComputeAttentionSoftmaxInplace(output_softmax + start_offset, 1, static_cast<int>(window_size), nullptr);
+            }
+
+            // set causal [seq_causal_length, total_seqlen) to 0.f
+            for (size_t total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
+              if constexpr (std::is_same<U, float>::value) {
+                output_softmax[total_seq_id] = 0.f;
+              } else {
+                output_softmax[total_seq_id] = MLFloat16::FromBits(static_cast<uint16_t>(0));
+              }
             }
           }
 
@@ -14,6 +14,7 @@
 #include "core/platform/threadpool.h"
 
 #include <unsupported/Eigen/SpecialFunctions>
+#include <algorithm>
 #include <vector>
 
 using onnxruntime::concurrency::ThreadPool;
@@ -22,16 +23,19 @@ namespace onnxruntime {
 namespace contrib {
 
 // These ops are internal-only, so register outside of onnx
-#define REGISTER_KERNEL_TYPED(T)                                        \
-  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
-      GroupQueryAttention,                                              \
-      kMSDomain,                                                        \
-      1,                                                                \
-      T,                                                                \
-      kCpuExecutionProvider,                                            \
-      KernelDefBuilder()                                                \
-          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())        \
-          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()), \
+#define REGISTER_KERNEL_TYPED(T)                                              \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                              \
+      GroupQueryAttention,                                                    \
+      kMSDomain,                                                              \
+      1,                                                                      \
+      T,                                                                      \
+      kCpuExecutionProvider,                                                  \
+      KernelDefBuilder()                                                      \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())              \
+          .TypeConstraint("T_CACHE", {DataTypeImpl::GetTensorType<T>(),       \
+                                      DataTypeImpl::GetTensorType<int8_t>()}) \
+          .TypeConstraint("T_KV_SCALE", DataTypeImpl::GetTensorType<float>()) \
+          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()),       \
       GroupQueryAttention<T>);
 
 REGISTER_KERNEL_TYPED(float)
@@ -41,6 +45,42 @@ template <typename T>
 GroupQueryAttention<T>::GroupQueryAttention(const OpKernelInfo& info)
     : OpKernel(info), GQAAttentionBase(info, true) {}
 
+template <typename T>
+Status GroupQueryAttention<T>::CheckQuantizedKVCache(const Tensor* past_key, const Tensor* past_value,
+                                                     const Tensor* k_scale, const Tensor* v_scale,
+                                                     const GroupQueryAttentionParameters& parameters) const {
+  if (k_quant_type_ == KVQuantizationType::NONE || v_quant_type_ == KVQuantizationType::NONE) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "k_quant_type and v_quant_type must both be NONE or both be quantized on CPU");
+  }
+
+  if (past_key != nullptr && (!past_key->IsDataType<int8_t>() || !past_value->IsDataType<int8_t>())) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "past_key and past_value must be int8 tensors when the KV cache is quantized");
+  }
+
+  const auto check_scale = [&](const Tensor* scale, KVQuantizationType quant_type, const char* name) -> Status {
+    if (scale == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, name, " is required when the KV cache is quantized");
+    }
+    const int64_t expected_size = quant_type == KVQuantizationType::PER_CHANNEL
+                                      ? static_cast<int64_t>(parameters.kv_num_heads) * parameters.head_size
+                                      : 1;
+    if (scale->Shape().Size() != expected_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, name, " is expected to have ", expected_size,
+                             " elements, got ", scale->Shape().Size());
+    }
+    const auto scale_data = scale->DataAsSpan<float>();
+    if (std::any_of(scale_data.begin(), scale_data.end(), [](float value) { return !(value > 0.0f); })) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, name, " must be positive");
+    }
+    return Status::OK();
+  };
+
+  ORT_RETURN_IF_ERROR(check_scale(k_scale, k_quant_type_, "k_scale"));
+  return check_scale(v_scale, v_quant_type_, "v_scale");
+}
+
 template <typename T>
 Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   const Tensor* query = context->Input<Tensor>(0);
@@ -55,6 +95,12 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   const Tensor* position_ids = context->Input<Tensor>(9);
   const Tensor* attention_bias = context->Input<Tensor>(10);
   const Tensor* head_sink = context->Input<Tensor>(11);
+  const Tensor* k_scale = context->Input<Tensor>(12);
+  const Tensor* v_scale = context->Input<Tensor>(13);
+
+  if (context->Input<Tensor>(14) != nullptr) {
+    return ComputePackedBatch(context);
+  }
 
   GroupQueryAttentionParameters parameters = {};
   ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckInputs(query,
@@ -77,6 +123,12 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
                                                                                head_sink,
                                                                                parameters));
 
+  const bool quantized_kv_cache = k_quant_type_ != KVQuantizationType::NONE ||
+                                  v_quant_type_ != KVQuantizationType::NONE;
+  if (quantized_kv_cache) {
+    ORT_RETURN_IF_ERROR(CheckQuantizedKVCache(past_key, past_value, k_scale, v_scale, parameters));
+  }
+
   const int batch_size = parameters.batch_size;
   const int sequence_length = parameters.sequence_length;
   const int present_kv_seqlen = parameters.seqlen_present_kv_cache;
@@ -102,14 +154,19 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   OrtValue Q;
   OrtValue K;
   OrtValue V;
+  // with rotary, Q and K are rotated from BSNH into BNSH in one pass, so only V is transposed here
   if (packed_qkv) {
-    ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
-        allocator, batch_size, num_heads_ + 2 * kv_num_heads_, sequence_length, head_size, query, Q));
+    if (!do_rotary_) {
+      ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
+          allocator, batch_size, num_heads_ + 2 * kv_num_heads_, sequence_length, head_size, query, Q));
+    }
   } else {
-    ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
-        allocator, batch_size, num_heads_, sequence_length, head_size, query, Q));
-    ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
-        allocator, batch_size, kv_num_heads_, sequence_length, head_size, key, K));
+    if (!do_rotary_) {
+      ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
+          allocator, batch_size, num_heads_, sequence_length, head_size, query, Q));
+      ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
+          allocator, batch_size, kv_num_heads_, sequence_length, head_size, key, K));
+    }
     ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
         allocator, batch_size, kv_num_heads_, sequence_length, head_size, value, V));
   }
@@ -117,10 +174,13 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   OrtValue RotaryQKV;
   OrtValue RotaryQ;
   OrtValue RotaryK;
-  T* q_rotary = Q.GetMutable<Tensor>()->MutableData<T>();
-  T* k_rotary = packed_qkv ? nullptr : K.GetMutable<Tensor>()->MutableData<T>();
-  if (do_rotary_) {
-    // Initialize rotary parameters
+  T* q_rotary = nullptr;
+  T* k_rotary = nullptr;
+  if (!do_rotary_) {
+    q_rotary = Q.GetMutable<Tensor>()->MutableData<T>();
+    k_rotary = packed_qkv ? nullptr : K.GetMutable<Tensor>()->MutableData<T>();
+  } else {
+    // Initialize rotary parameters, the output is BNSH
     rotary_embedding_helper::RotaryParameters rotary_params = {};
     rotary_params.batch_size = batch_size;
     rotary_params.sequence_length = sequence_length;
@@ -159,25 +219,30 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
       }
     }
 
-    // Initialize separate buffers for rotary embeddings
-    const T* q_input;
+    // Initialize separate buffers for rotary embeddings. The inputs are read in BSNH.
+    const T* q_input = query->Data<T>();
     const T* k_input;
+    int q_input_seq_stride;
+    int k_input_seq_stride;
     if (packed_qkv) {
       Tensor::InitOrtValue(element_type, TensorShape({batch_size, num_heads_ + 2 * kv_num_heads_, sequence_length, head_size}), allocator, RotaryQKV);
-      q_input = Q.Get<Tensor>().Data<T>();
-      k_input = q_input + num_heads_ * sequence_length * head_size;
+      k_input = q_input + num_heads_ * head_size;
+      q_input_seq_stride = (num_heads_ + 2 * kv_num_heads_) * head_size;
+      k_input_seq_stride = q_input_seq_stride;
       q_rotary = RotaryQKV.GetMutable<Tensor>()->MutableData<T>();
       k_rotary = q_rotary + num_heads_ * sequence_length * head_size;
     } else {
       Tensor::InitOrtValue(element_type, TensorShape({batch_size, num_heads_, sequence_length, head_size}), allocator, RotaryQ);
       Tensor::InitOrtValue(element_type, TensorShape({batch_size, kv_num_heads_, sequence_length, head_size}), allocator, RotaryK);
-      q_input = Q.Get<Tensor>().Data<T>();
-      k_input = K.Get<Tensor>().Data<T>();
+      k_input = key->Data<T>();
+      q_input_seq_stride = q_hidden_size;
+      k_input_seq_stride = parameters.kv_hidden_size;
       q_rotary = RotaryQ.GetMutable<Tensor>()->MutableData<T>();
       k_rotary = RotaryK.GetMutable<Tensor>()->MutableData<T>();
     }
     // Run rotary embedding for Q and K
     ORT_RETURN_IF_ERROR(RunRotaryEmbedding<T>(tp, rotary_params, q_input,
+                                              sequence_length * q_input_seq_stride, q_input_seq_stride, head_size,
                                               pos_ids_data, cos_cache->Data<T>(),
                                               sin_cache->Data<T>(), q_rotary, rotary_interleaved_));
 
@@ -187,29 +252,210 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
       rotary_params.batch_stride = kv_num_heads_ * rotary_params.head_stride;
     }
     ORT_RETURN_IF_ERROR(RunRotaryEmbedding<T>(tp, rotary_params, k_input,
+                                              sequence_length * k_input_seq_stride, k_input_seq_stride, head_size,
                                               pos_ids_data, cos_cache->Data<T>(),
                                               sin_cache->Data<T>(), k_rotary, rotary_interleaved_));
-    // Pack V into rotary QKV buffer
+    // Transpose V into rotary QKV buffer
     if (packed_qkv) {
-      const T* v_input = k_input + kv_num_heads_ * sequence_length * head_size;
+      const T* v_input = k_input + kv_num_heads_ * head_size;
       T* v_rotary = k_rotary + kv_num_heads_ * sequence_length * head_size;
-      ORT_RETURN_IF_ERROR(rotary_helper::PackVIntoRotaryQKV<T>(tp,
-                                                               parameters.batch_size,
-                                                               parameters.sequence_length,
-                                                               parameters.num_heads,
-                                                               parameters.kv_num_heads,
-                                                               parameters.head_size,
-                                                               v_input,
-                                                               v_rotary));
+      ORT_RETURN_IF_ERROR(rotary_helper::TransposeVIntoRotaryQKV<T>(tp,
+                                                                    parameters.batch_size,
+                                                                    parameters.sequence_length,
+                                                                    parameters.num_heads,
+                                                                    parameters.kv_num_heads,
+                                                                    parameters.head_size,
+                                                                    v_input,
+                                                                    v_rotary));
     }
   }
 
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
+  if (quantized_kv_cache) {
+    return ApplyQuantizedKVCacheAttention(q_rotary, packed_qkv ? nullptr : k_rotary,
+                                          packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(), attention_bias,
+                                          past_key, past_value, output, present_k, present_v, k_scale, v_scale,
+                                          seqlens_k, parameters, allocator, context);
+  }
+
   // Compute the attention score and apply the score to V
   return ApplyAttention(q_rotary, packed_qkv ? nullptr : k_rotary, packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(),
                         attention_bias, past_key, past_value, output, present_k, present_v,
                         seqlens_k, parameters, allocator, context);
 }
+
+template <typename T>
+Status GroupQueryAttention<T>::ComputePackedBatch(OpKernelContext* context) const {
+  const Tensor* query = context->Input<Tensor>(0);
+  const Tensor* key = context->Input<Tensor>(1);
+  const Tensor* value = context->Input<Tensor>(2);
+  const Tensor* past_key = context->Input<Tensor>(3);
+  const Tensor* past_value = context->Input<Tensor>(4);
+  const Tensor* seqlens_k = context->Input<Tensor>(5);
+  const Tensor* total_seqlen_tensor = context->Input<Tensor>(6);
+  const Tensor* cos_cache = context->Input<Tensor>(7);
+  const Tensor* sin_cache = context->Input<Tensor>(8);
+  const Tensor* position_ids = context->Input<Tensor>(9);
+  const Tensor* cumulative_seqlens = context->Input<Tensor>(14);
+
+  if (context->Input<Tensor>(10) != nullptr || context->Input<Tensor>(11) != nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "attention_bias and head_sink are not supported with cumulative_sequence_length");
+  }
+  if (k_quant_type_ != KVQuantizationType::NONE || v_quant_type_ != KVQuantizationType::NONE) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "A quantized KV cache is not supported with cumulative_sequence_length");
+  }
+
+  GroupQueryAttentionParameters parameters = {};
+  ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckPackedBatchInputs(query,
+                                                                           key,
+                                                                           value,
+                                                                           past_key,
+                                                                           past_value,
+                                                                           cos_cache,
+                                                                           sin_cache,
+                                                                           &parameters,
+                                                                           num_heads_,
+                                                                           kv_num_heads_,
+                                                                           seqlens_k,
+                                                                           total_seqlen_tensor,
+                                                                           cumulative_seqlens,
+                                                                           scale_,
+                                                                           softcap_));
+
+  const int batch_size = parameters.batch_size;
+  const int token_count = parameters.sequence_length;
+  const int head_size = parameters.head_size;
+  const int hidden_size = parameters.hidden_size;
+  const int kv_hidden_size = parameters.kv_hidden_size;
+  const size_t present_kv_seqlen = static_cast<size_t>(parameters.seqlen_present_kv_cache);
+  const size_t past_kv_seqlen = static_cast<size_t>(parameters.seqlen_past_kv_cache);
+  const bool packed_qkv = parameters.is_packed_qkv;
+
+  Tensor* output = context->Output(0, {1, static_cast<int64_t>(token_count), static_cast<int64_t>(hidden_size)});
+  const TensorShape present_shape({batch_size, kv_num_heads_, static_cast<int64_t>(present_kv_seqlen), head_size});
+  Tensor* present_k = context->Output(1, present_shape);
+  Tensor* present_v = context->Output(2, present_shape);
+  if (present_k == nullptr || present_v == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "present_key and present_value are required with cumulative_sequence_length");
+  }
+
+  const int32_t* cumulative_seqlens_data = cumulative_seqlens->Data<int32_t>();
+  const int32_t* seqlens_k_data = seqlens_k->Data<int32_t>();
+  std::vector<int32_t> past_seqlens(batch_size);
+  for (int b = 0; b < batch_size; ++b) {
+    past_seqlens[b] = seqlens_k_data[b] + 1 - (cumulative_seqlens_data[b + 1] - cumulative_seqlens_data[b]);
+  }
+
+  // the new tokens are written to the present caches, which are copied from the past caches unless they share
+  // their buffers
+  T* present_k_data = present_k->MutableData<T>();
+  T* present_v_data = present_v->MutableData<T>();
+  if (past_key != nullptr && past_key->Data<T>() != present_k_data) {
+    const T* past_k_data = past_key->Data<T>();
+    const T* past_v_data = past_value->Data<T>();
+    const size_t past_chunk_length = past_kv_seqlen * head_size;
+    const size_t present_chunk_length = present_kv_seqlen * head_size;
+    for (size_t i = 0; i < static_cast<size_t>(batch_size) * kv_num_heads_; ++i) {
+      memcpy(present_k_data + i * present_chunk_length, past_k_data + i * past_chunk_length,
+             past_chunk_length * sizeof(T));
+      memcpy(present_v_data + i * present_chunk_length, past_v_data + i * past_chunk_length,
+             past_chunk_length * sizeof(T));
+    }
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  const T* q = query->Data<T>();
+  const T* k = packed_qkv ? q + hidden_size : key->Data<T>();
+  const T* v = packed_qkv ? k + kv_hidden_size : value->Data<T>();
+  const size_t q_row_stride = packed_qkv ? hidden_size + 2 * kv_hidden_size : hidden_size;
+  const size_t kv_row_stride = packed_qkv ? q_row_stride : kv_hidden_size;
+
+  OrtValue rotary_q;
+  OrtValue rotary_k;
+  if (do_rotary_) {
+    if (cos_cache == nullptr || sin_cache == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "cos_cache and sin_cache must be passed to GroupQueryAttention when do_rotary = 1");
+    }
+
+    std::vector<int64_t> default_pos_ids;
+    const int64_t* pos_ids_data = nullptr;
+    if (position_ids != nullptr) {
+      if (position_ids->Shape().Size() != token_count) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "position_ids must have one element for each packed token, got ",
+                               position_ids->Shape());
+      }
+      pos_ids_data = position_ids->Data<int64_t>();
+    } else {
+      default_pos_ids.resize(token_count);
+      for (int b = 0; b < batch_size; ++b) {
+        for (int t = cumulative_seqlens_data[b]; t < cumulative_seqlens_data[b + 1]; ++t) {
+          default_pos_ids[t] = static_cast<int64_t>(past_seqlens[b]) + t - cumulative_seqlens_data[b];
+        }
+      }
+      pos_ids_data = default_pos_ids.data();
+    }
+    for (int t = 0; t < token_count; ++t) {
+      if (pos_ids_data[t] < 0 || pos_ids_data[t] >= cos_cache->Shape()[0]) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Position ", pos_ids_data[t], " of packed token ", t,
+                               " is out of the range of cos_cache and sin_cache");
+      }
+    }
+
+    // each row is rotated in place in a copy with the same layout, so V isn't copied
+    auto element_type = DataTypeImpl::GetType<T>();
+    Tensor::InitOrtValue(element_type, TensorShape({token_count, static_cast<int64_t>(q_row_stride)}), allocator,
+                         rotary_q);
+    T* q_rotary = rotary_q.GetMutable<Tensor>()->MutableData<T>();
+    T* k_rotary = q_rotary + hidden_size;
+    if (!packed_qkv) {
+      Tensor::InitOrtValue(element_type, TensorShape({token_count, kv_hidden_size}), allocator, rotary_k);
+      k_rotary = rotary_k.GetMutable<Tensor>()->MutableData<T>();
+    }
+
+    // the packed tokens are a batch of a single sequence with explicit positions
+    rotary_embedding_helper::RotaryParameters rotary_params = {};
+    rotary_params.batch_size = 1;
+    rotary_params.sequence_length = token_count;
+    rotary_params.hidden_size = hidden_size;
+    rotary_params.head_size = head_size;
+    rotary_params.rotary_embedding_dim = parameters.rotary_dim;
+    rotary_params.num_heads = num_heads_;
+    rotary_params.max_sequence_length = token_count;  // unused
+    rotary_params.seq_stride = static_cast<int>(q_row_stride);
+    rotary_params.head_stride = head_size;
+    rotary_params.batch_stride = 0;
+    rotary_params.position_ids_format = 1;
+    rotary_params.transposed = false;
+    auto* tp = context->GetOperatorThreadPool();
+    ORT_RETURN_IF_ERROR(RunRotaryEmbedding<T>(tp, rotary_params, q, pos_ids_data, cos_cache->Data<T>(),
+                                              sin_cache->Data<T>(), q_rotary, rotary_interleaved_));
+
+    rotary_params.hidden_size = kv_hidden_size;
+    rotary_params.num_heads = kv_num_heads_;
+    rotary_params.seq_stride = static_cast<int>(kv_row_stride);
+    ORT_RETURN_IF_ERROR(RunRotaryEmbedding<T>(tp, rotary_params, k, pos_ids_data, cos_cache->Data<T>(),
+                                              sin_cache->Data<T>(), k_rotary, rotary_interleaved_));
+    q = q_rotary;
+    k = k_rotary;
+  }
+
+  // token p of sequence b is row p of the BNSH caches of the sequence
+  const size_t cache_head_stride = present_kv_seqlen * head_size;
+  auto cache_offset = [&](size_t b, size_t p) {
+    return b * kv_num_heads_ * cache_head_stride + p * head_size;
+  };
+  return ApplyPackedTokenAttention(q, q_row_stride, k, kv_row_stride, v, kv_row_stride, present_k_data,
+                                   present_v_data, cache_offset, cache_head_stride, cumulative_seqlens_data,
+                                   past_seqlens.data(), batch_size, static_cast<size_t>(head_size),
+                                   output->MutableData<T>(), allocator, context);
+}
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -15,6 +15,14 @@ class GroupQueryAttention final : public OpKernel, public GQAAttentionBase {
  public:
   GroupQueryAttention(const OpKernelInfo& info);
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  Status CheckQuantizedKVCache(const Tensor* past_key, const Tensor* past_value, const Tensor* k_scale,
+                               const Tensor* v_scale, const GroupQueryAttentionParameters& parameters) const;
+
+  // Attention of a batch of packed tokens given with cumulative_sequence_length, where each sequence may be a
+  // prompt or a token generation step.
+  Status ComputePackedBatch(OpKernelContext* context) const;
 };
 
 }  // namespace contrib
@@ -337,6 +337,94 @@ Status CheckInputs(const T* query,
   return CheckInputs(query, key, value, past_key, past_value, cos_cache, sin_cache, parameters, num_heads, kv_num_heads, seqlens_k, total_seqlen, scale, softcap);
 }
 
+// Checks the inputs of a batch of packed tokens. query, key and value have shape (1, token_count, hidden_size) and
+// sequence b has the rows [cumulative_seqlens[b], cumulative_seqlens[b + 1]), which follow its
+// seqlens_k[b] + 1 - sequence_length cached tokens. Each sequence may then be a prompt or a token generation step.
+template <typename T = Tensor>
+Status CheckPackedBatchInputs(const T* query,
+                              const T* key,
+                              const T* value,
+                              const T* past_key,
+                              const T* past_value,
+                              const T* cos_cache,
+                              const T* sin_cache,
+                              GroupQueryAttentionParameters* parameters,
+                              int num_heads,
+                              int kv_num_heads,
+                              const T* seqlens_k,
+                              const T* total_seqlen,
+                              const T* cumulative_seqlens,
+                              float scale,
+                              float softcap) {
+  const auto& cumulative_seqlens_dims = cumulative_seqlens->Shape().GetDims();
+  if (cumulative_seqlens_dims.size() != 1 || cumulative_seqlens_dims[0] < 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "cumulative_sequence_length must be shape (batch_size + 1) with batch_size > 0, got ",
+                           cumulative_seqlens->Shape());
+  }
+  const int batch_size = static_cast<int>(cumulative_seqlens_dims[0] - 1);
+
+  // the packed tokens are checked as one sequence, and the past as the caches of batch_size sequences
+  ORT_RETURN_IF_ERROR(CheckInputs<T>(query, key, value, nullptr, nullptr, cos_cache, sin_cache, parameters,
+                                     num_heads, kv_num_heads, seqlens_k, total_seqlen, scale, softcap));
+  if (parameters->batch_size != 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'query' dimension 0 must be 1 when cumulative_sequence_length is given, got ",
+                           parameters->batch_size);
+  }
+
+  const auto& seqlens_k_dims = seqlens_k->Shape().GetDims();
+  if (seqlens_k_dims.size() != 1 || seqlens_k_dims[0] != batch_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "seqlens_k must be shape (batch_size) = (", batch_size,
+                           "), got ", seqlens_k->Shape());
+  }
+
+  int past_sequence_length = 0;
+  if (past_key != nullptr && past_value != nullptr) {
+    ORT_RETURN_IF_ERROR(CheckPast(past_key, past_value, batch_size, kv_num_heads, parameters->head_size,
+                                  past_sequence_length));
+  } else if (past_key != nullptr || past_value != nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' and 'past_value' shall be both present or both absent.");
+  }
+  const int token_count = parameters->sequence_length;
+  const int present_sequence_length = std::max(parameters->total_sequence_length, past_sequence_length);
+
+  const int32_t* cumulative_seqlens_data = cumulative_seqlens->template Data<int32_t>();
+  const int32_t* seqlens_k_data = seqlens_k->template Data<int32_t>();
+  if (cumulative_seqlens_data[0] != 0 || cumulative_seqlens_data[batch_size] != token_count) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "cumulative_sequence_length must start with 0 and end with the token count ", token_count);
+  }
+  for (int b = 0; b < batch_size; ++b) {
+    const int32_t sequence_length = cumulative_seqlens_data[b + 1] - cumulative_seqlens_data[b];
+    const int64_t total_length = static_cast<int64_t>(seqlens_k_data[b]) + 1;
+    if (sequence_length < 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "cumulative_sequence_length must be non-decreasing. Got a negative length for sequence ",
+                             b);
+    }
+    if (total_length < sequence_length || total_length > present_sequence_length) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Sequence ", b, " with ", sequence_length,
+                             " new tokens has a total length of ", total_length,
+                             ", which must be at least the new tokens and at most ", present_sequence_length);
+    }
+    if (total_length - sequence_length > past_sequence_length) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Sequence ", b, " has ", total_length - sequence_length,
+                             " past tokens, which don't fit in past_key and past_value of length ",
+                             past_sequence_length);
+    }
+  }
+
+  parameters->batch_size = batch_size;
+  parameters->sequence_length = token_count;  // number of packed tokens
+  parameters->seqlen_past_kv_cache = past_sequence_length;
+  parameters->seqlen_present_kv_cache = present_sequence_length;
+  parameters->is_subsequent_prompt = false;
+  parameters->is_first_prompt = false;
+  return Status::OK();
+}
+
 template <typename T = Tensor>
 Status CheckCustomAttentionInputs(const T* position_ids,
                                   const T* attention_bias,
@@ -0,0 +1,171 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/bert/packed_multihead_attention.h"
+#include "contrib_ops/cpu/bert/attention_helper.h"
+#include "contrib_ops/cpu/bert/packed_multihead_attention_helper.h"
+#include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math.h"
+
+#include <cmath>
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    PackedMultiHeadAttention,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()),
+    PackedMultiHeadAttention<float>);
+
+template <typename T>
+PackedMultiHeadAttention<T>::PackedMultiHeadAttention(const OpKernelInfo& info) : OpKernel(info) {
+  int64_t num_heads = 0;
+  ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
+  num_heads_ = static_cast<int>(num_heads);
+  scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
+}
+
+template <typename T>
+Status PackedMultiHeadAttention<T>::Compute(OpKernelContext* context) const {
+  const Tensor* query = context->Input<Tensor>(0);
+  const Tensor* key = context->Input<Tensor>(1);
+  const Tensor* value = context->Input<Tensor>(2);
+  const Tensor* bias = context->Input<Tensor>(3);
+  const Tensor* token_offset = context->Input<Tensor>(4);
+  const Tensor* cumulative_sequence_length = context->Input<Tensor>(5);
+  const Tensor* attention_bias = context->Input<Tensor>(6);
+
+  PackedAttentionParameters parameters = {};
+  ORT_RETURN_IF_ERROR(packed_multihead_attention_helper::CheckInputs(query->Shape(),
+                                                                     key,
+                                                                     value,
+                                                                     bias,
+                                                                     token_offset->Shape(),
+                                                                     cumulative_sequence_length->Shape(),
+                                                                     attention_bias,
+                                                                     num_heads_,
+                                                                     scale_,
+                                                                     parameters));
+
+  const int32_t* cumulative_seqlens = cumulative_sequence_length->Data<int32_t>();
+  ORT_RETURN_IF_ERROR(packed_multihead_attention_helper::CheckCumulativeSequenceLength(cumulative_seqlens,
+                                                                                       parameters));
+
+  TensorShapeVector output_shape{parameters.token_count, parameters.v_hidden_size};
+  Tensor* output = context->Output(0, output_shape);
+  if (parameters.token_count == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  const size_t num_heads = static_cast<size_t>(parameters.num_heads);
+  const size_t head_size = static_cast<size_t>(parameters.head_size);
+  const size_t v_head_size = static_cast<size_t>(parameters.v_head_size);
+  const size_t hidden_size = static_cast<size_t>(parameters.hidden_size);
+  const size_t v_hidden_size = static_cast<size_t>(parameters.v_hidden_size);
+  const size_t max_seqlen = static_cast<size_t>(parameters.sequence_length);
+  const float alpha = parameters.scale == 0.0f ? 1.0f / std::sqrt(static_cast<float>(head_size)) : parameters.scale;
+
+  // Rows of Q, K and V are token-major. With packed QKV a row holds (num_heads, 3, head_size), otherwise the
+  // three inputs hold (num_heads, head_size) each.
+  const bool is_packed_qkv = key == nullptr;
+  const T* q_data = query->Data<T>();
+  const T* k_data = is_packed_qkv ? q_data + head_size : key->Data<T>();
+  const T* v_data = is_packed_qkv ? q_data + 2 * head_size : value->Data<T>();
+  const size_t q_row_stride = is_packed_qkv ? 3 * hidden_size : hidden_size;
+  const size_t k_row_stride = q_row_stride;
+  const size_t v_row_stride = is_packed_qkv ? 3 * hidden_size : v_hidden_size;
+  const size_t qk_head_stride = is_packed_qkv ? 3 * head_size : head_size;
+  const size_t v_head_stride = is_packed_qkv ? 3 * head_size : v_head_size;
+  const T* bias_data = bias != nullptr ? bias->Data<T>() : nullptr;
+  const T* attention_bias_data = attention_bias != nullptr ? attention_bias->Data<T>() : nullptr;
+  T* output_data = output->MutableData<T>();
+
+  // Each task attends one head of one sequence, reading its rows straight from the packed tokens between
+  // cumulative_sequence_length[b] and cumulative_sequence_length[b + 1], so no padding is restored.
+  // token_offset is only needed by the padded kernels of the other execution providers.
+  ThreadPool::TrySimpleParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(parameters.batch_size) * parameters.num_heads,
+      [&](std::ptrdiff_t i) {
+        const size_t batch_index = i / num_heads;
+        const size_t head_index = i % num_heads;
+        const size_t token_start = static_cast<size_t>(cumulative_seqlens[batch_index]);
+        const size_t sequence_length = static_cast<size_t>(cumulative_seqlens[batch_index + 1]) - token_start;
+        if (sequence_length == 0) {
+          return;
+        }
+
+        // Q and K (S x H), V and output (S x H_v) and the attention probs (S x S)
+        const size_t bytes = SafeInt<size_t>(sizeof(float)) *
+                             (2 * sequence_length * head_size + 2 * sequence_length * v_head_size +
+                              sequence_length * sequence_length);
+        auto buffer = allocator->Alloc(bytes);
+        BufferUniquePtr scratch_buffer(buffer, BufferDeleter(allocator));
+        float* q = static_cast<float*>(buffer);
+        float* k = q + sequence_length * head_size;
+        float* v = k + sequence_length * head_size;
+        float* out = v + sequence_length * v_head_size;
+        float* probs = out + sequence_length * v_head_size;
+
+        const T* q_bias = bias_data != nullptr ? bias_data + head_index * head_size : nullptr;
+        const T* k_bias = bias_data != nullptr ? bias_data + hidden_size + head_index * head_size : nullptr;
+        const T* v_bias = bias_data != nullptr ? bias_data + 2 * hidden_size + head_index * v_head_size : nullptr;
+        for (size_t s = 0; s < sequence_length; ++s) {
+          const size_t t = token_start + s;
+          const T* q_row = q_data + t * q_row_stride + head_index * qk_head_stride;
+          const T* k_row = k_data + t * k_row_stride + head_index * qk_head_stride;
+          const T* v_row = v_data + t * v_row_stride + head_index * v_head_stride;
+          for (size_t h = 0; h < head_size; ++h) {
+            q[s * head_size + h] = q_row[h] + (q_bias != nullptr ? q_bias[h] : 0.0f);
+            k[s * head_size + h] = k_row[h] + (k_bias != nullptr ? k_bias[h] : 0.0f);
+          }
+          for (size_t h = 0; h < v_head_size; ++h) {
+            v[s * v_head_size + h] = v_row[h] + (v_bias != nullptr ? v_bias[h] : 0.0f);
+          }
+        }
+
+        math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, sequence_length, head_size, alpha,
+                                        q, static_cast<int>(head_size), k, static_cast<int>(head_size),
+                                        0.0f /*beta*/, probs, static_cast<int>(sequence_length), nullptr);
+
+        if (attention_bias_data != nullptr) {
+          const size_t bias_batch = parameters.broadcast_attn_bias_dim_0 ? 0 : batch_index;
+          const size_t bias_head = parameters.broadcast_attn_bias_dim_1 ? 0 : head_index;
+          const size_t bias_heads = parameters.broadcast_attn_bias_dim_1 ? 1 : num_heads;
+          const T* bias_matrix = attention_bias_data + (bias_batch * bias_heads + bias_head) * max_seqlen * max_seqlen;
+          for (size_t s = 0; s < sequence_length; ++s) {
+            for (size_t j = 0; j < sequence_length; ++j) {
+              probs[s * sequence_length + j] += bias_matrix[s * max_seqlen + j];
+            }
+          }
+        }
+
+        ComputeAttentionSoftmaxInplace(probs, static_cast<int>(sequence_length), static_cast<int>(sequence_length),
+                                       nullptr);
+
+        math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, v_head_size, sequence_length, 1.f,
+                                        probs, static_cast<int>(sequence_length), v, static_cast<int>(v_head_size),
+                                        0.0f /*beta*/, out, static_cast<int>(v_head_size), nullptr);
+
+        for (size_t s = 0; s < sequence_length; ++s) {
+          memcpy(output_data + (token_start + s) * v_hidden_size + head_index * v_head_size, out + s * v_head_size,
+                 v_head_size * sizeof(float));
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
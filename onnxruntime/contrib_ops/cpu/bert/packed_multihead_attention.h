@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class PackedMultiHeadAttention final : public OpKernel {
+ public:
+  explicit PackedMultiHeadAttention(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int num_heads_;  // number of attention heads
+  float scale_;    // the scale for softmax, 1/sqrt(head_size) when 0
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
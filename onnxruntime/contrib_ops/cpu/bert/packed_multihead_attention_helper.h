@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/providers/common.h"
+#include "contrib_ops/cpu/bert/attention_common.h"
+#include "contrib_ops/cpu/bert/attention_parameters.h"
+#include "contrib_ops/cpu/bert/multihead_attention_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace packed_multihead_attention_helper {
+
+template <typename T = Tensor>
+Status CheckInputs(const TensorShape& query_shape,
+                   const T* key,
+                   const T* value,
+                   const T* bias,
+                   const TensorShape& token_offset_shape,
+                   const TensorShape& cu_seq_len_shape,
+                   const T* attention_bias,
+                   int num_heads,
+                   float scale,
+                   PackedAttentionParameters& parameters) {
+  // Shapes of inputs and output:
+  // When Q, K and V are not packed:
+  //   Input 'query':                      (token_count, hidden_size)
+  //   Input 'key':                        (token_count, hidden_size)
+  //   Input 'value':                      (token_count, v_hidden_size)
+  // When Q, K and V are packed:
+  //   Input 'query':                      (token_count, num_heads, 3, head_size)
+  //   Input 'key':                        None
+  //   Input 'value':                      None
+  // Input 'token_offset':                 (batch_size, sequence_length)
+  // Input 'cumulative_sequence_length':   (batch_size + 1)
+  // Input 'attention_bias':               (batch_size or 1, num_heads or 1, sequence_length, sequence_length) or None
+  // Output 'output':                      (token_count, v_hidden_size)
+
+  const auto& query_dims = query_shape.GetDims();
+  if (query_dims.size() != 2 && query_dims.size() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'query' is expected to have 2 or 4 dimensions in packing mode, got ",
+                           query_dims.size());
+  }
+  int64_t token_count = query_dims[0];
+  int64_t hidden_size = (query_dims.size() == 2) ? query_dims[1] : (query_dims[1] * query_dims[3]);
+
+  const auto& token_offset_dims = token_offset_shape.GetDims();
+  if (token_offset_dims.size() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'token_offset' is expected to have 2 dimensions in packing mode, got ",
+                           token_offset_dims.size());
+  }
+
+  int64_t batch_size = token_offset_dims[0];
+  int64_t sequence_length = token_offset_dims[1];
+
+  int64_t v_hidden_size = hidden_size;
+  if (query_dims.size() == 4) {
+    if (key != nullptr || value != nullptr) {
+      return ORT_MAKE_STATUS(
+          ONNXRUNTIME, INVALID_ARGUMENT,
+          "Input 'key' and 'value' is expected to be empty when 'query' has 4 dimensions in packing mode");
+    }
+  } else {  // query_dims.size() == 2
+    if (key == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'key' is expected when 'query' has 2 dimensions in packing mode");
+    }
+
+    const auto& key_dims = key->Shape().GetDims();
+    if (key_dims.size() != 2) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'key' is expected to have 2 dimension, got ",
+                             key_dims.size());
+    }
+    if (key_dims != query_dims) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'query' and 'key' is expected to have same shape");
+    }
+
+    if (value == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'value' is expected when 'query' has 2 dimensions in packing mode");
+    }
+    const auto& value_dims = value->Shape().GetDims();
+    if (value_dims.size() != 2) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'value' is expected to have 2 dimensions, got ",
+                             value_dims.size());
+    }
+    if (value_dims[0] != token_count) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 2 dimension 0 should have same length as dimension 0 of input 0");
+    }
+    v_hidden_size = value_dims[1];
+  }
+
+  if (bias != nullptr) {
+    const auto& bias_dims = bias->Shape().GetDims();
+    if (bias_dims.size() != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'bias' is expected to have 1 dimension, got ",
+                             bias_dims.size());
+    }
+
+    if (bias_dims[0] != hidden_size + hidden_size + v_hidden_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'bias' size is expected to be ",
+                             hidden_size + hidden_size + v_hidden_size, ", got ", bias_dims[0]);
+    }
+  }
+
+  const auto& cu_seq_len_dims = cu_seq_len_shape.GetDims();
+  if (cu_seq_len_dims.size() != 1 || cu_seq_len_dims[0] != batch_size + 1) {
+    return ORT_MAKE_STATUS(
+        ONNXRUNTIME, INVALID_ARGUMENT,
+        "Input 'cumulative_sequence_length' should have 1 dimension with size equal to batch_size + 1");
+  }
+
+  gsl::span<const int64_t> attention_bias_dims;
+  if (attention_bias != nullptr) {
+    attention_bias_dims = attention_bias->Shape().GetDims();
+    ORT_RETURN_IF_ERROR(multihead_attention_helper::CheckAttentionBias(
+        attention_bias_dims, batch_size, num_heads, sequence_length, sequence_length));
+  }
+  parameters.broadcast_attn_bias_dim_0 = attention_bias_dims.size() > 0 && attention_bias_dims[0] == 1;
+  parameters.broadcast_attn_bias_dim_1 = attention_bias_dims.size() > 1 && attention_bias_dims[1] == 1;
+
+  parameters.batch_size = static_cast<int>(batch_size);
+  parameters.sequence_length = static_cast<int>(sequence_length);
+  parameters.input_hidden_size = -1;  // not applicable
+  parameters.hidden_size = static_cast<int>(hidden_size);
+  parameters.v_hidden_size = static_cast<int>(v_hidden_size);
+  parameters.head_size = static_cast<int>(hidden_size) / num_heads;
+  parameters.v_head_size = static_cast<int>(v_hidden_size) / num_heads;
+  parameters.num_heads = num_heads;
+  parameters.scale = scale;
+  parameters.token_count = static_cast<int32_t>(token_count);
+
+  return Status::OK();
+}
+
+inline Status CheckCumulativeSequenceLength(const int32_t* cumulative_sequence_length,
+                                           const PackedAttentionParameters& parameters) {
+  if (cumulative_sequence_length[0] != 0 ||
+      cumulative_sequence_length[parameters.batch_size] != parameters.token_count) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "cumulative_sequence_length must start with 0 and end with the token count ",
+                           parameters.token_count);
+  }
+
+  for (int b = 0; b < parameters.batch_size; ++b) {
+    const int32_t sequence_length = cumulative_sequence_length[b + 1] - cumulative_sequence_length[b];
+    if (sequence_length < 0 || sequence_length > parameters.sequence_length) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Sequence ", b, " has ", sequence_length,
+                             " tokens in cumulative_sequence_length, expected between 0 and ",
+                             parameters.sequence_length);
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace packed_multihead_attention_helper
+}  // namespace contrib
+}  // namespace onnxruntime
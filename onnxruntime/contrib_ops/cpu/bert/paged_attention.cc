@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/bert/paged_attention.h"
+#include "contrib_ops/cpu/bert/paged_attention_helper.h"
+#include "contrib_ops/cpu/bert/rotary_embedding.h"
+#include "contrib_ops/cpu/bert/rotary_embedding_helper.h"
+
+#include <vector>
+
+namespace onnxruntime {
+namespace contrib {
+
+// These ops are internal-only, so register outside of onnx
+#define REGISTER_KERNEL_TYPED(T)                                        \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
+      PagedAttention,                                                   \
+      kMSDomain,                                                        \
+      1,                                                                \
+      T,                                                                \
+      kCpuExecutionProvider,                                            \
+      KernelDefBuilder()                                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())        \
+          .TypeConstraint("S", DataTypeImpl::GetTensorType<int32_t>()), \
+      PagedAttention<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+PagedAttention<T>::PagedAttention(const OpKernelInfo& info)
+    : OpKernel(info), GQAAttentionBase(info, true) {}
+
+template <typename T>
+Status PagedAttention<T>::Compute(OpKernelContext* context) const {
+  const Tensor* query = context->Input<Tensor>(0);
+  const Tensor* key = context->Input<Tensor>(1);
+  const Tensor* value = context->Input<Tensor>(2);
+  const Tensor* key_cache = context->Input<Tensor>(3);
+  const Tensor* value_cache = context->Input<Tensor>(4);
+  const Tensor* cumulative_seqlens_q = context->Input<Tensor>(5);
+  const Tensor* past_seqlens = context->Input<Tensor>(6);
+  const Tensor* block_table = context->Input<Tensor>(7);
+  const Tensor* cos_cache = context->Input<Tensor>(8);
+  const Tensor* sin_cache = context->Input<Tensor>(9);
+
+  PagedAttentionParameters parameters = {};
+  ORT_RETURN_IF_ERROR(paged_attention_helper::CheckInputs(query,
+                                                          key,
+                                                          value,
+                                                          key_cache,
+                                                          value_cache,
+                                                          cumulative_seqlens_q,
+                                                          past_seqlens,
+                                                          block_table,
+                                                          cos_cache,
+                                                          sin_cache,
+                                                          &parameters,
+                                                          num_heads_,
+                                                          kv_num_heads_,
+                                                          scale_,
+                                                          softcap_,
+                                                          /*max_threads_per_block*/ 0,
+                                                          /*block_size_multiple*/ 1));
+  parameters.local_window_size = local_window_size_;
+  parameters.do_rotary = do_rotary_;
+  parameters.rotary_interleaved = rotary_interleaved_;
+
+  const int32_t* cumulative_seqlens_data = cumulative_seqlens_q->Data<int32_t>();
+  const int32_t* past_seqlens_data = past_seqlens->Data<int32_t>();
+  const int32_t* block_table_data = block_table->Data<int32_t>();
+  ORT_RETURN_IF_ERROR(paged_attention_helper::CheckSequences(cumulative_seqlens_data, past_seqlens_data,
+                                                             block_table_data, parameters));
+
+  if (do_rotary_ && (cos_cache == nullptr || sin_cache == nullptr)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "cos_cache and sin_cache must be passed to PagedAttention when do_rotary = 1");
+  }
+
+  const int token_count = parameters.token_count;
+  const int hidden_size = parameters.hidden_size;
+  const int kv_hidden_size = parameters.kv_hidden_size;
+  Tensor* output = context->Output(0, {static_cast<int64_t>(token_count), static_cast<int64_t>(hidden_size)});
+  Tensor* key_cache_out = context->Output(1, key_cache->Shape());
+  Tensor* value_cache_out = context->Output(2, value_cache->Shape());
+
+  // the cache is updated in place, so the outputs can only be the inputs
+  if (key_cache_out != nullptr && key_cache->Data<T>() != key_cache_out->MutableData<T>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "key_cache and key_cache_out must be the same buffer");
+  } else if (value_cache_out != nullptr && value_cache->Data<T>() != value_cache_out->MutableData<T>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "value_cache and value_cache_out must be the same buffer");
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  const bool packed_qkv = parameters.is_packed_qkv;
+  const T* q = query->Data<T>();
+  const T* k = packed_qkv ? q + hidden_size : key->Data<T>();
+  const T* v = packed_qkv ? k + kv_hidden_size : value->Data<T>();
+  const size_t q_row_stride = packed_qkv ? hidden_size + 2 * kv_hidden_size : hidden_size;
+  const size_t kv_row_stride = packed_qkv ? q_row_stride : kv_hidden_size;
+
+  OrtValue rotary_q;
+  OrtValue rotary_k;
+  if (do_rotary_) {
+    std::vector<int64_t> position_ids(token_count);
+    for (int b = 0; b < parameters.batch_size; ++b) {
+      for (int t = cumulative_seqlens_data[b]; t < cumulative_seqlens_data[b + 1]; ++t) {
+        position_ids[t] = static_cast<int64_t>(past_seqlens_data[b]) + t - cumulative_seqlens_data[b];
+        if (position_ids[t] >= cos_cache->Shape()[0]) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Position ", position_ids[t], " of sequence ", b,
+                                 " is out of the range of cos_cache and sin_cache");
+        }
+      }
+    }
+
+    // each row is rotated in place in a copy with the same layout, so V isn't copied
+    auto element_type = DataTypeImpl::GetType<T>();
+    Tensor::InitOrtValue(element_type, TensorShape({token_count, static_cast<int64_t>(q_row_stride)}), allocator,
+                         rotary_q);
+    T* q_rotary = rotary_q.GetMutable<Tensor>()->MutableData<T>();
+    T* k_rotary = q_rotary + hidden_size;
+    if (!packed_qkv) {
+      Tensor::InitOrtValue(element_type, TensorShape({token_count, kv_hidden_size}), allocator, rotary_k);
+      k_rotary = rotary_k.GetMutable<Tensor>()->MutableData<T>();
+    }
+
+    // the packed tokens are a batch of a single sequence with explicit positions
+    rotary_embedding_helper::RotaryParameters rotary_params = {};
+    rotary_params.batch_size = 1;
+    rotary_params.sequence_length = token_count;
+    rotary_params.hidden_size = hidden_size;
+    rotary_params.head_size = parameters.head_size;
+    rotary_params.rotary_embedding_dim = parameters.rotary_dim;
+    rotary_params.num_heads = num_heads_;
+    rotary_params.max_sequence_length = token_count;  // unused
+    rotary_params.seq_stride = static_cast<int>(q_row_stride);
+    rotary_params.head_stride = parameters.head_size;
+    rotary_params.batch_stride = 0;
+    rotary_params.position_ids_format = 1;
+    rotary_params.transposed = false;
+    auto* tp = context->GetOperatorThreadPool();
+    ORT_RETURN_IF_ERROR(RunRotaryEmbedding<T>(tp, rotary_params, q, position_ids.data(), cos_cache->Data<T>(),
+                                              sin_cache->Data<T>(), q_rotary, rotary_interleaved_));
+
+    rotary_params.hidden_size = kv_hidden_size;
+    rotary_params.num_heads = kv_num_heads_;
+    rotary_params.seq_stride = static_cast<int>(kv_row_stride);
+    ORT_RETURN_IF_ERROR(RunRotaryEmbedding<T>(tp, rotary_params, k, position_ids.data(), cos_cache->Data<T>(),
+                                              sin_cache->Data<T>(), k_rotary, rotary_interleaved_));
+    q = q_rotary;
+    k = k_rotary;
+  }
+
+  return ApplyPagedAttention(q, q_row_stride, k, kv_row_stride, v, kv_row_stride,
+                             const_cast<T*>(key_cache->Data<T>()), const_cast<T*>(value_cache->Data<T>()),
+                             cumulative_seqlens_data, past_seqlens_data, block_table_data,
+                             output->MutableData<T>(), parameters, allocator, context);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -90,7 +90,7 @@ Status Check_QKV(const T* packed_qkv, const T* value, const int num_heads, const
 
 template <typename T = Tensor>
 Status CheckKVCache(const T* key_cache, const T* value_cache, const int kv_num_heads, const int head_size,
-                    int& num_blocks, int& block_size) {
+                    const int block_size_multiple, int& num_blocks, int& block_size) {
   const auto& key_cache_dims = key_cache->Shape().GetDims();
   const auto& value_cache_dims = value_cache->Shape().GetDims();
   if (key_cache_dims.size() != 4) {
@@ -107,10 +107,10 @@ Status CheckKVCache(const T* key_cache, const T* value_cache, const int kv_num_h
   num_blocks = static_cast<int>(key_cache_dims[0]);
   block_size = static_cast<int>(key_cache_dims[1]);
   // TODO(aciddelgado): block size multiple of 8
-  if (block_size % 256 != 0) {
+  if (block_size <= 0 || block_size % block_size_multiple != 0) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                           "block_size must be a multiple of 256. Got block_size % 256 == ",
-                           block_size % 256);
+                           "block_size must be a positive multiple of ", block_size_multiple, ". Got block_size == ",
+                           block_size);
   }
   if (value_cache_dims[0] != num_blocks) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
@@ -166,7 +166,7 @@ Status CheckSequenceLengthTensors(const T* cumulative_sequence_length, const T*
   batch_size = static_cast<int>(cumulative_seqlen_dim[0]) - 1;
 
   const auto& seqlens_dim = seqlens->Shape().GetDims();
-  if (seqlens_dim.size() != 1 && seqlens_dim[0] != batch_size) {
+  if (seqlens_dim.size() != 1 || seqlens_dim[0] != batch_size) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                            "seqlens must be shape (batch_size).");
   }
@@ -204,7 +204,8 @@ Status CheckInputs(const T* query,
                    int kv_num_heads,
                    float scale,
                    float softcap,
-                   int max_threads_per_block) {
+                   int max_threads_per_block,
+                   int block_size_multiple) {
   if (max_threads_per_block > 0 && num_heads > max_threads_per_block) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "num_heads should be no larger than ", max_threads_per_block);
   }
@@ -231,7 +232,8 @@ Status CheckInputs(const T* query,
   // Check KV-Cache
   int num_blocks = 0;
   int block_size = 0;
-  ORT_RETURN_IF_ERROR(CheckKVCache(key_cache, value_cache, kv_num_heads, head_size, num_blocks, block_size));
+  ORT_RETURN_IF_ERROR(CheckKVCache(key_cache, value_cache, kv_num_heads, head_size, block_size_multiple,
+                                   num_blocks, block_size));
 
   // Check sequence length tensors
   int batch_size = 0;
@@ -273,6 +275,46 @@ Status CheckInputs(const T* query,
   return Status::OK();
 }
 
+// Checks the sequence lengths and block table against the inputs. The tensors must be in CPU memory.
+inline Status CheckSequences(const int32_t* cumulative_sequence_length, const int32_t* past_seqlens,
+                             const int32_t* block_table, const PagedAttentionParameters& parameters) {
+  if (cumulative_sequence_length[0] != 0 ||
+      cumulative_sequence_length[parameters.batch_size] != parameters.token_count) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "cumulative_sequence_length must start with 0 and end with the token count ",
+                           parameters.token_count);
+  }
+
+  const int64_t max_seqlen = static_cast<int64_t>(parameters.max_num_blocks_per_seq) * parameters.block_size;
+  for (int b = 0; b < parameters.batch_size; ++b) {
+    const int32_t sequence_length = cumulative_sequence_length[b + 1] - cumulative_sequence_length[b];
+    if (sequence_length < 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "cumulative_sequence_length must be non-decreasing. Got a negative length for sequence ",
+                             b);
+    }
+
+    const int64_t total_seqlen = static_cast<int64_t>(past_seqlens[b]) + sequence_length;
+    if (past_seqlens[b] < 0 || total_seqlen > max_seqlen) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Sequence ", b, " with ", past_seqlens[b],
+                             " past tokens and ", sequence_length, " new tokens doesn't fit in ",
+                             parameters.max_num_blocks_per_seq, " blocks of ", parameters.block_size, " tokens");
+    }
+
+    const int64_t used_blocks = (total_seqlen + parameters.block_size - 1) / parameters.block_size;
+    for (int64_t i = 0; i < used_blocks; ++i) {
+      const int32_t block = block_table[b * parameters.max_num_blocks_per_seq + i];
+      if (block < 0 || block >= parameters.num_blocks) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "block_table entry ", i, " of sequence ", b,
+                               " is ", block, ", which is not a block of the KV cache with ", parameters.num_blocks,
+                               " blocks");
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
 }  // namespace paged_attention_helper
 }  // namespace contrib
 }  // namespace onnxruntime
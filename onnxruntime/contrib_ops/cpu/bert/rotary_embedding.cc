@@ -45,6 +45,7 @@ RotaryEmbedding<T>::RotaryEmbedding(const OpKernelInfo& info) : OpKernel(info) {
 // TODO: rotary embedding in place
 template <typename T>
 Status RunRotaryEmbedding(concurrency::ThreadPool* tp, RotaryParameters parameters, const T* input,
+                          int input_batch_stride, int input_seq_stride, int input_head_stride,
                           const int64_t* position_ids, const T* cos_cache, const T* sin_cache, T* output,
                           bool interleaved) {
   const int batch_size = parameters.batch_size;
@@ -72,8 +73,9 @@ Status RunRotaryEmbedding(concurrency::ThreadPool* tp, RotaryParameters paramete
       // Identify the index of batch, sequence, and head (specific range) in the input/output tensor
       // for read/write
       const int block_offset = b * batch_stride + s * seq_stride + n * head_stride;
+      const int input_block_offset = b * input_batch_stride + s * input_seq_stride + n * input_head_stride;
 
-      const T* input_data = input + block_offset;
+      const T* input_data = input + input_block_offset;
       T* output_data = output + block_offset;
 
       // Cache is (M, H/2) or (M, rotary_embedding_dim/2)
@@ -97,6 +99,14 @@ Status RunRotaryEmbedding(concurrency::ThreadPool* tp, RotaryParameters paramete
   return Status::OK();
 }
 
+template <typename T>
+Status RunRotaryEmbedding(concurrency::ThreadPool* tp, RotaryParameters parameters, const T* input,
+                          const int64_t* position_ids, const T* cos_cache, const T* sin_cache, T* output,
+                          bool interleaved) {
+  return RunRotaryEmbedding<T>(tp, parameters, input, parameters.batch_stride, parameters.seq_stride,
+                               parameters.head_stride, position_ids, cos_cache, sin_cache, output, interleaved);
+}
+
 template Status RunRotaryEmbedding<float>(concurrency::ThreadPool* tp, RotaryParameters parameters, const float* input,
                                           const int64_t* position_ids, const float* cos_cache, const float* sin_cache, float* output,
                                           bool interleaved);
@@ -105,6 +115,17 @@ template Status RunRotaryEmbedding<MLFloat16>(concurrency::ThreadPool* tp, Rotar
                                               const int64_t* position_ids, const MLFloat16* cos_cache, const MLFloat16* sin_cache,
                                               MLFloat16* output, bool interleaved);
 
+template Status RunRotaryEmbedding<float>(concurrency::ThreadPool* tp, RotaryParameters parameters, const float* input,
+                                          int input_batch_stride, int input_seq_stride, int input_head_stride,
+                                          const int64_t* position_ids, const float* cos_cache, const float* sin_cache,
+                                          float* output, bool interleaved);
+
+template Status RunRotaryEmbedding<MLFloat16>(concurrency::ThreadPool* tp, RotaryParameters parameters,
+                                              const MLFloat16* input,
+                                              int input_batch_stride, int input_seq_stride, int input_head_stride,
+                                              const int64_t* position_ids, const MLFloat16* cos_cache,
+                                              const MLFloat16* sin_cache, MLFloat16* output, bool interleaved);
+
 template <typename T>
 Status RotaryEmbedding<T>::Compute(OpKernelContext* context) const {
   const Tensor* input = context->Input<Tensor>(0);
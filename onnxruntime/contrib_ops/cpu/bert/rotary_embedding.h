@@ -14,6 +14,14 @@ Status RunRotaryEmbedding(onnxruntime::concurrency::ThreadPool* tp, rotary_embed
                           const int64_t* position_ids, const T* cos_cache, const T* sin_cache, T* output,
                           bool interleaved);
 
+// Same as above, but the input is read with its own strides while the output is written with the strides of
+// `parameters`, e.g. to rotate BSNH Q or K into BNSH without a separate transpose.
+template <typename T>
+Status RunRotaryEmbedding(onnxruntime::concurrency::ThreadPool* tp, rotary_embedding_helper::RotaryParameters parameters, const T* input,
+                          int input_batch_stride, int input_seq_stride, int input_head_stride,
+                          const int64_t* position_ids, const T* cos_cache, const T* sin_cache, T* output,
+                          bool interleaved);
+
 template <typename T>
 class RotaryEmbedding final : public OpKernel {
  public:
@@ -41,6 +41,37 @@ Status PackVIntoRotaryQKV(concurrency::ThreadPool* tp,
   return Status::OK();
 }
 
+// Copies V of a packed QKV input in BSNH into its place in the BNSH rotary QKV buffer.
+// `input` and `output` point to the first V head of the first token in each.
+template <typename T>
+Status TransposeVIntoRotaryQKV(concurrency::ThreadPool* tp,
+                               int batch_size,
+                               int sequence_length,
+                               int num_heads,
+                               int kv_num_heads,
+                               int head_size,
+                               const T* input,
+                               T* output) {
+  const int input_seq_stride = (num_heads + 2 * kv_num_heads) * head_size;
+  const int input_batch_stride = sequence_length * input_seq_stride;
+  const int head_stride = sequence_length * head_size;
+  const int batch_stride = (num_heads + 2 * kv_num_heads) * head_stride;
+
+  const int loop_len = batch_size * sequence_length * kv_num_heads;
+  const double cost = static_cast<double>(head_size);
+  ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t ptr = begin; ptr != end; ++ptr) {
+      const int b = static_cast<int>((ptr / kv_num_heads) / sequence_length);
+      const int s = static_cast<int>((ptr / kv_num_heads) % sequence_length);
+      const int n = static_cast<int>(ptr % kv_num_heads);
+      const T* input_data = input + b * input_batch_stride + s * input_seq_stride + n * head_size;
+      T* output_data = output + b * batch_stride + n * head_stride + s * head_size;
+      memcpy(output_data, input_data, head_size * sizeof(T));
+    }
+  });
+  return Status::OK();
+}
+
 }  // namespace rotary_helper
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -19,7 +19,8 @@ DEFINE_KERNEL(float);
 DEFINE_KERNEL(double);
 
 template <typename T>
-static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, concurrency::ThreadPool* threadpool) {
+static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, bool take_sqrt,
+                                 concurrency::ThreadPool* threadpool) {
   // input shapes have already been validated
   const auto& shape_a = a.Shape().GetDims();  // {m, k}
   const auto& shape_b = b.Shape().GetDims();  // {n, k}
@@ -34,60 +35,74 @@ static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, co
   const auto* b_data = b.Data<T>();
   auto* c_data = c.MutableData<T>();
 
-  // ReduceSumSquare for A
-  std::vector<T> a_ss;
-  a_ss.resize(narrow<size_t>(m));
-  const auto* cur_a = a_data;
-  for (int64_t i = 0; i < m; ++i) {
-    a_ss[narrow<size_t>(i)] = ConstEigenVectorMap<T>(cur_a, narrow<size_t>(k)).squaredNorm();
-    cur_a += k;
-  }
+  // ReduceSumSquare for A and B
+  const auto sum_squares = [k, threadpool](const T* data, int64_t rows, std::vector<T>& ss) {
+    ss.resize(narrow<size_t>(rows));
+    concurrency::ThreadPool::TryParallelFor(
+        threadpool, narrow<std::ptrdiff_t>(rows),
+        TensorOpCost{static_cast<double>(k * sizeof(T)), static_cast<double>(sizeof(T)), static_cast<double>(k * 2)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            ss[narrow<size_t>(i)] = ConstEigenVectorMap<T>(data + i * k, narrow<size_t>(k)).squaredNorm();
+          }
+        });
+  };
 
-  // ReduceSumSquare for B
+  std::vector<T> a_ss;
+  sum_squares(a_data, m, a_ss);
   std::vector<T> b_ss;
-  b_ss.resize(narrow<size_t>(n));
-  const auto* cur_b = b_data;
-  for (int64_t i = 0; i < n; ++i) {
-    b_ss[narrow<size_t>(i)] = ConstEigenVectorMap<T>(cur_b, narrow<size_t>(k)).squaredNorm();
-    cur_b += k;
-  }
+  sum_squares(b_data, n, b_ss);
 
   // NOTE: We want to avoid subtracting two numbers that are very close to each other as that can lead to
   // 'catastrophic cancellation'. (sum_k(Xik**2) + sum_k(Yjk**2)) would be close to 2*sum_k(Xik*Yjk) if the values
   // in Xij and Yjk are very similar, so subtracting can be problematic.
   // Due to that we calculate -2*sum_k(Xik*Yjk) using GEMM, add sum_k(Xik**2) next, and add sum_k(Yjk**2) last.
 
-// use MLAS on 64-bit (no 32-bit dgemm)
+  // use MLAS for float, and for double on x64 (no dgemm elsewhere)
 #if defined(_M_AMD64) || defined(__x86_64__)
-  // Use GEMM of A and B^T with -2 as alpha to calculate -2*sum_k(Xik*Yjk)
-  math::Gemm<T>(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                m, n, k,
-                static_cast<T>(-2.), a_data, b_data, static_cast<T>(0.),
-                c_data,
-                threadpool);
+  constexpr bool use_mlas = true;
 #else
-  // the performance of this isn't great as the eigen matmul is single threaded by default
-  // if you're on x86 and care about performance try MKL first. if there's a good enough argument for optimizing this
-  // we can look into it in the future.
-  ORT_UNUSED_PARAMETER(threadpool);
-
-  // https://eigen.tuxfamily.org/dox/TopicWritingEfficientProductExpression.html
-  auto out_map = EigenMatrixMapRowMajor<T>(c_data, SafeInt<size_t>(m), SafeInt<size_t>(n));
-  out_map.noalias() = static_cast<T>(-2.) *
-                      (ConstEigenMatrixMapRowMajor<T>(a_data, SafeInt<size_t>(m), SafeInt<size_t>(k)) *
-                       ConstEigenMatrixMapRowMajor<T>(b_data, SafeInt<size_t>(n), SafeInt<size_t>(k)).transpose());
+  constexpr bool use_mlas = std::is_same_v<T, float>;
 #endif
 
-  // add a_ss and b_ss, with broadcast
-  // output shape is {m, n}
-  auto* cur_out = c_data;
-  for (int64_t i = 0; i < m; ++i) {
-    T a_val = a_ss[narrow<size_t>(i)];
-    for (int64_t j = 0; j < n; ++j) {
-      *cur_out = (*cur_out + a_val) + b_ss[narrow<size_t>(j)];
-      ++cur_out;
-    }
+  if constexpr (use_mlas) {
+    // Use GEMM of A and B^T with -2 as alpha to calculate -2*sum_k(Xik*Yjk)
+    math::Gemm<T>(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                  m, n, k,
+                  static_cast<T>(-2.), a_data, b_data, static_cast<T>(0.),
+                  c_data,
+                  threadpool);
+  } else {
+    // the performance of this isn't great as the eigen matmul is single threaded by default
+    // if you're on x86 and care about performance try MKL first. if there's a good enough argument for optimizing this
+    // we can look into it in the future.
+
+    // https://eigen.tuxfamily.org/dox/TopicWritingEfficientProductExpression.html
+    auto out_map = EigenMatrixMapRowMajor<T>(c_data, SafeInt<size_t>(m), SafeInt<size_t>(n));
+    out_map.noalias() = static_cast<T>(-2.) *
+                        (ConstEigenMatrixMapRowMajor<T>(a_data, SafeInt<size_t>(m), SafeInt<size_t>(k)) *
+                         ConstEigenMatrixMapRowMajor<T>(b_data, SafeInt<size_t>(n), SafeInt<size_t>(k)).transpose());
   }
+
+  // add a_ss and b_ss, with broadcast, then take abs() and sqrt() in the same pass over each output row.
+  // output shape is {m, n}
+  // because we use GEMM there's a slight chance a number extremely close to zero could be negative, so we need to
+  // run abs() to avoid NaN's in the results.
+  const auto b_ss_map = ConstEigenVectorArrayMap<T>(b_ss.data(), narrow<size_t>(n));
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, narrow<std::ptrdiff_t>(m),
+      TensorOpCost{static_cast<double>(n * sizeof(T) * 2), static_cast<double>(n * sizeof(T)),
+                   static_cast<double>(n * (take_sqrt ? 8 : 3))},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          auto row = EigenVectorArrayMap<T>(c_data + i * n, narrow<size_t>(n));
+          if (take_sqrt) {
+            row = ((row + a_ss[narrow<size_t>(i)]) + b_ss_map).abs().sqrt();
+          } else {
+            row = ((row + a_ss[narrow<size_t>(i)]) + b_ss_map).abs();
+          }
+        }
+      });
 }
 
 template <typename T>
@@ -112,18 +127,8 @@ common::Status CDist<T>::Compute(OpKernelContext* context) const {
 
   TensorShape output_shape = {shape_a[0], shape_b[0]};
   Tensor* C = context->Output(0, output_shape);
-  T* output = C->MutableData<T>();
 
-  CalculateSqeuclidean<T>(*A, *B, *C, tp);
-  auto map_out = EigenVectorArrayMap<T>(output, narrow<size_t>(output_shape.Size()));
-
-  // because we use GEMM in CalculateSqeuclidean there's a slight chance a number extremely close to zero
-  // could be negative, so we need to run abs() to avoid NaN's in the results.
-  if (mode_ == Mode::EUCLIDEAN) {
-    map_out = map_out.abs().sqrt();  // do both abs and sqrt in one call so Eigen has a chance to combine
-  } else if (mode_ == Mode::SQEUCLIDEAN) {
-    map_out = map_out.abs();
-  }
+  CalculateSqeuclidean<T>(*A, *B, *C, mode_ == Mode::EUCLIDEAN, tp);
 
   return Status::OK();
 }
@@ -0,0 +1,255 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/embedding_bag.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/gather_rows.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// an int8 table is dequantized into a float output, a float table produces an output of its own type.
+template <typename T>
+using EmbeddingBagOutputType = std::conditional_t<std::is_same_v<T, int8_t>, float, T>;
+
+}  // namespace
+
+#define REGISTER_KERNEL_TYPED(T)                                                                      \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                      \
+      EmbeddingBag,                                                                                   \
+      kMSDomain,                                                                                      \
+      1,                                                                                              \
+      T,                                                                                              \
+      kCpuExecutionProvider,                                                                          \
+      KernelDefBuilder()                                                                              \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>())                                     \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<EmbeddingBagOutputType<T>>())              \
+          .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(),                            \
+                                   DataTypeImpl::GetTensorType<int64_t>()}),                          \
+      EmbeddingBag<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+REGISTER_KERNEL_TYPED(int8_t)
+
+template <typename T>
+EmbeddingBag<T>::EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+  const std::string mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+  ORT_ENFORCE(mode == "sum" || mode == "mean", "EmbeddingBag mode must be \"sum\" or \"mean\", got ", mode);
+  is_mean_ = mode == "mean";
+}
+
+template <typename T>
+Status EmbeddingBag<T>::Compute(OpKernelContext* context) const {
+  const Tensor* indices = context->Input<Tensor>(1);
+  if (indices->IsDataType<int32_t>()) {
+    return ComputeImpl<int32_t>(context);
+  }
+  return ComputeImpl<int64_t>(context);
+}
+
+template <typename T>
+template <typename Tind>
+Status EmbeddingBag<T>::ComputeImpl(OpKernelContext* context) const {
+  using TOut = EmbeddingBagOutputType<T>;
+
+  const Tensor* table = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const Tensor* offsets = context->Input<Tensor>(2);
+  const Tensor* lengths = context->Input<Tensor>(3);
+  const Tensor* per_sample_weights = context->Input<Tensor>(4);
+  const Tensor* table_scale = context->Input<Tensor>(5);
+
+  const auto& table_shape = table->Shape();
+  const auto& indices_shape = indices->Shape();
+  ORT_RETURN_IF_NOT(table_shape.NumDimensions() == 2, "table must be 2-D, got ", table_shape);
+  const int64_t num_embeddings = table_shape[0];
+  const size_t embedding_dim = narrow<size_t>(table_shape[1]);
+  const int64_t num_indices = indices_shape.Size();
+  const Tind* indices_data = indices->Data<Tind>();
+
+  // bag b holds the rows indices_data[bag_starts[b]:bag_starts[b + 1]].
+  std::vector<int64_t> bag_starts;
+  if (indices_shape.NumDimensions() == 2) {
+    ORT_RETURN_IF(offsets != nullptr || lengths != nullptr, "offsets and lengths are only allowed with 1-D indices");
+    const int64_t num_bags = indices_shape[0];
+    const int64_t bag_size = indices_shape[1];
+    bag_starts.resize(narrow<size_t>(num_bags + 1));
+    for (int64_t b = 0; b <= num_bags; ++b) {
+      bag_starts[narrow<size_t>(b)] = b * bag_size;
+    }
+  } else {
+    ORT_RETURN_IF_NOT(indices_shape.NumDimensions() == 1, "indices must be 1-D or 2-D, got ", indices_shape);
+    ORT_RETURN_IF_NOT((offsets != nullptr) != (lengths != nullptr),
+                      "exactly one of offsets and lengths is required with 1-D indices");
+    const Tensor* bounds = offsets != nullptr ? offsets : lengths;
+    ORT_RETURN_IF_NOT(bounds->Shape().NumDimensions() == 1, "offsets and lengths must be 1-D, got ", bounds->Shape());
+    const auto bounds_data = bounds->DataAsSpan<Tind>();
+    bag_starts.resize(bounds_data.size() + 1);
+    bag_starts.back() = num_indices;
+    int64_t start = 0;
+    for (size_t b = 0; b < bounds_data.size(); ++b) {
+      if (offsets != nullptr) {
+        const int64_t offset = static_cast<int64_t>(bounds_data[b]);
+        ORT_RETURN_IF(offset < start || offset > num_indices, "offsets must be non decreasing and within [0, ",
+                      num_indices, "], got ", offset, " for bag ", b);
+        start = offset;
+        bag_starts[b] = start;
+      } else {
+        const int64_t length = static_cast<int64_t>(bounds_data[b]);
+        ORT_RETURN_IF(length < 0 || length > num_indices - start, "lengths must be non negative and sum up to ",
+                      num_indices, ", got ", length, " for bag ", b);
+        bag_starts[b] = start;
+        start += length;
+      }
+    }
+    ORT_RETURN_IF(lengths != nullptr && start != num_indices, "lengths must sum up to ", num_indices, ", got ", start);
+  }
+  const int64_t num_bags = static_cast<int64_t>(bag_starts.size()) - 1;
+
+  const float* weights_data = nullptr;
+  if (per_sample_weights != nullptr) {
+    ORT_RETURN_IF(is_mean_, "per_sample_weights is only allowed in the \"sum\" mode");
+    ORT_RETURN_IF_NOT(per_sample_weights->Shape() == indices_shape, "per_sample_weights must have the shape of ",
+                      "indices ", indices_shape, ", got ", per_sample_weights->Shape());
+  }
+
+  [[maybe_unused]] const float* scale_data = nullptr;
+  [[maybe_unused]] bool per_row_scale = false;
+  if constexpr (std::is_same_v<T, int8_t>) {
+    ORT_RETURN_IF(table_scale == nullptr, "table_scale is required with an int8 table");
+    const int64_t scale_size = table_scale->Shape().Size();
+    ORT_RETURN_IF_NOT(table_scale->Shape().NumDimensions() <= 1 && (scale_size == 1 || scale_size == num_embeddings),
+                      "table_scale must be a scalar or of shape [", num_embeddings, "], got ", table_scale->Shape());
+    scale_data = table_scale->Data<float>();
+    per_row_scale = scale_size != 1;
+  } else {
+    ORT_RETURN_IF(table_scale != nullptr, "table_scale is only allowed with an int8 table");
+  }
+
+  for (int64_t i = 0; i < num_indices; ++i) {
+    const int64_t idx = static_cast<int64_t>(indices_data[i]);
+    if (idx < -num_embeddings || idx >= num_embeddings) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "indices element out of data bounds, idx=", idx,
+                             " must be within the inclusive range [", -num_embeddings, ",", num_embeddings - 1, "]");
+    }
+  }
+
+  Tensor* output = context->Output(0, {num_bags, static_cast<int64_t>(embedding_dim)});
+  if (num_bags == 0 || embedding_dim == 0) {
+    return Status::OK();
+  }
+
+  const T* table_data = table->Data<T>();
+  TOut* output_data = output->MutableData<TOut>();
+  std::vector<float> converted_weights;
+  if (per_sample_weights != nullptr) {
+    if constexpr (std::is_same_v<T, MLFloat16>) {
+      // the half weights are converted once rather than once per row of the embedding.
+      converted_weights.resize(narrow<size_t>(num_indices));
+      MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(per_sample_weights->Data<MLFloat16>()),
+                                   converted_weights.data(), converted_weights.size());
+      weights_data = converted_weights.data();
+    } else {
+      weights_data = per_sample_weights->Data<float>();
+    }
+  }
+  const size_t row_bytes = embedding_dim * sizeof(T);
+
+  auto row_index = [&](int64_t i) {
+    const int64_t idx = static_cast<int64_t>(indices_data[i]);
+    return idx < 0 ? idx + num_embeddings : idx;
+  };
+  auto table_row = [&](int64_t idx) { return table_data + idx * static_cast<int64_t>(embedding_dim); };
+
+  // a bag loads its rows and stores one output row.
+  const double rows_per_bag = static_cast<double>(num_indices) / static_cast<double>(num_bags);
+  const TensorOpCost cost{rows_per_bag * static_cast<double>(row_bytes),
+                          static_cast<double>(embedding_dim * sizeof(TOut)),
+                          rows_per_bag * static_cast<double>(embedding_dim)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), num_bags, cost, [&](ptrdiff_t first, ptrdiff_t last) {
+        // the half rows are converted into row_buffer and the bags are accumulated in float in bag_buffer.
+        std::vector<float> row_buffer;
+        std::vector<float> bag_buffer;
+        if constexpr (std::is_same_v<T, MLFloat16>) {
+          row_buffer.resize(embedding_dim);
+          bag_buffer.resize(embedding_dim);
+        }
+
+        // the lookups of the task are consecutive in indices, so the row kGatherPrefetchDistance lookups ahead is
+        // prefetched across the bags.
+        const int64_t end = bag_starts[narrow<size_t>(last)];
+        int64_t ahead = std::min<int64_t>(bag_starts[narrow<size_t>(first)] + kGatherPrefetchDistance, end);
+        for (int64_t i = bag_starts[narrow<size_t>(first)]; i < ahead; ++i) {
+          PrefetchRowForRead(table_row(row_index(i)), row_bytes);
+        }
+
+        for (ptrdiff_t b = first; b < last; ++b) {
+          float* acc = nullptr;
+          if constexpr (std::is_same_v<TOut, float>) {
+            acc = output_data + b * static_cast<ptrdiff_t>(embedding_dim);
+          } else {
+            acc = bag_buffer.data();
+          }
+          std::fill_n(acc, embedding_dim, 0.f);
+
+          const int64_t bag_begin = bag_starts[narrow<size_t>(b)];
+          const int64_t bag_end = bag_starts[narrow<size_t>(b) + 1];
+          for (int64_t i = bag_begin; i < bag_end; ++i) {
+            if (ahead < end) {
+              PrefetchRowForRead(table_row(row_index(ahead)), row_bytes);
+              ++ahead;
+            }
+
+            const int64_t idx = row_index(i);
+            const T* row = table_row(idx);
+            float weight = weights_data != nullptr ? weights_data[i] : 1.f;
+            if constexpr (std::is_same_v<T, float>) {
+              for (size_t j = 0; j < embedding_dim; ++j) {
+                acc[j] += weight * row[j];
+              }
+            } else if constexpr (std::is_same_v<T, MLFloat16>) {
+              MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(row), row_buffer.data(),
+                                           embedding_dim);
+              for (size_t j = 0; j < embedding_dim; ++j) {
+                acc[j] += weight * row_buffer[j];
+              }
+            } else {
+              weight *= scale_data[per_row_scale ? idx : 0];
+              for (size_t j = 0; j < embedding_dim; ++j) {
+                acc[j] += weight * static_cast<float>(row[j]);
+              }
+            }
+          }
+
+          if (is_mean_ && bag_end - bag_begin > 1) {
+            const float inv_count = 1.f / static_cast<float>(bag_end - bag_begin);
+            for (size_t j = 0; j < embedding_dim; ++j) {
+              acc[j] *= inv_count;
+            }
+          }
+
+          if constexpr (std::is_same_v<TOut, MLFloat16>) {
+            auto* output_row = reinterpret_cast<MLAS_FP16*>(output_data) + b * static_cast<ptrdiff_t>(embedding_dim);
+            MlasConvertFloatToHalfBuffer(acc, output_row, embedding_dim);
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
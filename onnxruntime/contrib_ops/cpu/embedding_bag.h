@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+/// <summary>
+/// Sums or averages bags of rows of an embedding table, like a Gather followed by a ReduceSum or ReduceMean over the
+/// gathered rows (see EmbeddingBagFusion), without writing the gathered rows out. Each task accumulates whole bags in
+/// their output row while the rows of the next lookups are prefetched.
+/// T is the type of the table: float, MLFloat16, or int8_t dequantized with a scale into a float output.
+/// </summary>
+template <typename T>
+class EmbeddingBag final : public OpKernel {
+ public:
+  explicit EmbeddingBag(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename Tind>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  bool is_mean_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
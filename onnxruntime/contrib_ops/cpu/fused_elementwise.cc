@@ -0,0 +1,248 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+
+using OpType = FusedElementwise::OpType;
+
+// the other operand of a binary operator, broadcast against X.
+struct Operand {
+  enum class Kind {
+    Scalar,
+    Full,
+    // 1-D with the size of the last dimension of X
+    Row,
+  };
+
+  const float* data;
+  Kind kind;
+  int64_t row_size;
+};
+
+template <typename Op>
+void ApplyBinary(const float* in, const Operand& operand, bool operand_first, int64_t start, int64_t count,
+                 float* out, Op op) {
+  switch (operand.kind) {
+    case Operand::Kind::Scalar: {
+      const float b = operand.data[0];
+      if (operand_first) {
+        for (int64_t i = 0; i < count; ++i) out[i] = op(b, in[i]);
+      } else {
+        for (int64_t i = 0; i < count; ++i) out[i] = op(in[i], b);
+      }
+      break;
+    }
+    case Operand::Kind::Full: {
+      const float* b = operand.data + start;
+      if (operand_first) {
+        for (int64_t i = 0; i < count; ++i) out[i] = op(b[i], in[i]);
+      } else {
+        for (int64_t i = 0; i < count; ++i) out[i] = op(in[i], b[i]);
+      }
+      break;
+    }
+    case Operand::Kind::Row: {
+      int64_t j = start % operand.row_size;
+      for (int64_t i = 0; i < count; ++i) {
+        const float b = operand.data[j];
+        out[i] = operand_first ? op(b, in[i]) : op(in[i], b);
+        if (++j == operand.row_size) {
+          j = 0;
+        }
+      }
+      break;
+    }
+  }
+}
+
+template <typename Op>
+void ApplyUnary(const float* in, int64_t count, float* out, Op op) {
+  for (int64_t i = 0; i < count; ++i) out[i] = op(in[i]);
+}
+
+void ApplyStep(OpType type, const float* in, const Operand* operand, bool operand_first, int64_t start,
+               int64_t count, float* out) {
+  const size_t n = narrow<size_t>(count);
+  switch (type) {
+    case OpType::Add:
+      if (operand->kind == Operand::Kind::Full) {
+        MlasEltwiseAdd<float>(in, operand->data + start, out, n);
+      } else {
+        ApplyBinary(in, *operand, operand_first, start, count, out, [](float a, float b) { return a + b; });
+      }
+      break;
+    case OpType::Sub:
+      ApplyBinary(in, *operand, operand_first, start, count, out, [](float a, float b) { return a - b; });
+      break;
+    case OpType::Mul:
+      ApplyBinary(in, *operand, operand_first, start, count, out, [](float a, float b) { return a * b; });
+      break;
+    case OpType::Div:
+      ApplyBinary(in, *operand, operand_first, start, count, out, [](float a, float b) { return a / b; });
+      break;
+    case OpType::Relu:
+      ApplyUnary(in, count, out, [](float a) { return std::max(a, 0.f); });
+      break;
+    case OpType::Sigmoid:
+      MlasComputeLogistic(in, out, n);
+      break;
+    case OpType::Tanh:
+      MlasComputeTanh<float>(in, out, n);
+      break;
+    case OpType::Exp:
+      MlasComputeExp<float>(in, out, n);
+      break;
+    case OpType::Erf:
+      MlasComputeErf(in, out, n);
+      break;
+    case OpType::Log:
+      ApplyUnary(in, count, out, [](float a) { return std::log(a); });
+      break;
+    case OpType::Neg:
+      ApplyUnary(in, count, out, [](float a) { return -a; });
+      break;
+    case OpType::Abs:
+      ApplyUnary(in, count, out, [](float a) { return std::abs(a); });
+      break;
+    case OpType::Sqrt:
+      ApplyUnary(in, count, out, [](float a) { return std::sqrt(a); });
+      break;
+    case OpType::Reciprocal:
+      ApplyUnary(in, count, out, [](float a) { return 1.f / a; });
+      break;
+  }
+}
+
+}  // namespace
+
+bool FusedElementwise::TryParseOpType(const std::string& op_type, OpType& type) {
+  static const InlinedHashMap<std::string, OpType> op_types{
+      {"Add", OpType::Add},
+      {"Sub", OpType::Sub},
+      {"Mul", OpType::Mul},
+      {"Div", OpType::Div},
+      {"Relu", OpType::Relu},
+      {"Sigmoid", OpType::Sigmoid},
+      {"Tanh", OpType::Tanh},
+      {"Exp", OpType::Exp},
+      {"Log", OpType::Log},
+      {"Neg", OpType::Neg},
+      {"Abs", OpType::Abs},
+      {"Sqrt", OpType::Sqrt},
+      {"Reciprocal", OpType::Reciprocal},
+      {"Erf", OpType::Erf},
+  };
+
+  auto it = op_types.find(op_type);
+  if (it == op_types.end()) {
+    return false;
+  }
+
+  type = it->second;
+  return true;
+}
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  const auto ops = info.GetAttrsOrDefault<std::string>("ops");
+  const auto operand_indices = info.GetAttrsOrDefault<int64_t>("operand_indices");
+  const auto operand_first = info.GetAttrsOrDefault<int64_t>("operand_first");
+  ORT_ENFORCE(!ops.empty(), "FusedElementwise requires at least one operator.");
+  ORT_ENFORCE(operand_indices.size() == ops.size() && operand_first.size() == ops.size(),
+              "The operand_indices and operand_first attributes must have one entry per operator.");
+
+  const int64_t num_inputs = static_cast<int64_t>(info.GetInputCount());
+  steps_.reserve(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    Step step{};
+    ORT_ENFORCE(TryParseOpType(ops[i], step.type), "Unsupported operator in FusedElementwise: ", ops[i]);
+    if (IsBinary(step.type)) {
+      ORT_ENFORCE(operand_indices[i] >= 0 && operand_indices[i] < num_inputs,
+                  "Invalid operand index for ", ops[i], ": ", operand_indices[i]);
+      step.operand_index = narrow<int>(operand_indices[i]);
+      step.operand_first = operand_first[i] != 0;
+    } else {
+      step.operand_index = -1;
+      step.operand_first = false;
+    }
+    steps_.push_back(step);
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const TensorShape& shape = input->Shape();
+  const int64_t elem_count = shape.Size();
+  const int64_t row_size = shape.NumDimensions() > 0 ? shape[shape.NumDimensions() - 1] : 1;
+
+  InlinedVector<Operand> operands;
+  operands.reserve(steps_.size());
+  for (const auto& step : steps_) {
+    if (step.operand_index < 0) {
+      operands.push_back(Operand{nullptr, Operand::Kind::Scalar, 0});
+      continue;
+    }
+
+    const Tensor* operand = context->Input<Tensor>(step.operand_index);
+    const TensorShape& operand_shape = operand->Shape();
+    if (operand_shape.Size() == 1 && operand_shape.NumDimensions() <= shape.NumDimensions()) {
+      operands.push_back(Operand{operand->Data<float>(), Operand::Kind::Scalar, 0});
+    } else if (operand_shape == shape) {
+      operands.push_back(Operand{operand->Data<float>(), Operand::Kind::Full, 0});
+    } else if (operand_shape.NumDimensions() == 1 && operand_shape[0] == row_size && row_size > 0) {
+      operands.push_back(Operand{operand->Data<float>(), Operand::Kind::Row, row_size});
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise operand ", step.operand_index,
+                             " with shape ", operand_shape, " can't be broadcast to the input shape ", shape);
+    }
+  }
+
+  Tensor* output = context->Output(0, shape);
+  const float* input_data = input->Data<float>();
+  float* output_data = output->MutableData<float>();
+
+  // each task walks its range in tiles that stay in L1 while the whole chain is applied to them.
+  constexpr int64_t length_per_task = 4096;
+  constexpr int64_t tile_size = 512;
+  const int64_t task_count = (elem_count + length_per_task - 1) / length_per_task;
+  concurrency::ThreadPool::TryBatchParallelFor(
+      context->GetOperatorThreadPool(), narrow<int32_t>(task_count),
+      [&](ptrdiff_t task_idx) {
+        const int64_t task_start = task_idx * length_per_task;
+        const int64_t task_end = std::min(task_start + length_per_task, elem_count);
+        for (int64_t start = task_start; start < task_end; start += tile_size) {
+          const int64_t count = std::min(tile_size, task_end - start);
+          const float* in = input_data + start;
+          float* out = output_data + start;
+          for (size_t i = 0; i < steps_.size(); ++i) {
+            ApplyStep(steps_[i].type, in, &operands[i], steps_[i].operand_first, start, count, out);
+            in = out;
+          }
+        }
+      },
+      0);
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
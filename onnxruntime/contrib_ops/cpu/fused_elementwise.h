@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+/// <summary>
+/// Applies a chain of elementwise operators produced by ElementwiseChainFusion in a single pass over the data.
+/// The tensor is processed in tiles small enough to stay in L1 cache, and every operator of the chain is applied to
+/// a tile before moving on to the next one, so each element is read from and written to memory once.
+/// </summary>
+class FusedElementwise final : public OpKernel {
+ public:
+  enum class OpType {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Relu,
+    Sigmoid,
+    Tanh,
+    Exp,
+    Log,
+    Neg,
+    Abs,
+    Sqrt,
+    Reciprocal,
+    Erf,
+  };
+
+  // Returns true and sets type if op_type is an operator supported by FusedElementwise.
+  static bool TryParseOpType(const std::string& op_type, OpType& type);
+  static bool IsBinary(OpType type) { return type <= OpType::Div; }
+
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  struct Step {
+    OpType type;
+    // index of the other operand in the inputs for binary operators, -1 for unary ones.
+    int operand_index;
+    bool operand_first;
+  };
+
+  InlinedVector<Step> steps_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/math/batched_lora_matmul_helper.h"
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class BatchedLoraMatMul final : public OpKernel {
+ public:
+  explicit BatchedLoraMatMul(const OpKernelInfo& info) : OpKernel(info) {
+    scale_ = info.GetAttrOrDefault<float>("scale", 1.0f);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float scale_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    BatchedLoraMatMul,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    BatchedLoraMatMul);
+
+Status BatchedLoraMatMul::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* A = context->Input<Tensor>(1);
+  const Tensor* B = context->Input<Tensor>(2);
+  const Tensor* adapter_index = context->Input<Tensor>(3);
+
+  batched_lora_matmul_helper::Parameters parameters;
+  ORT_RETURN_IF_ERROR(batched_lora_matmul_helper::CheckInputs(X->Shape(), A->Shape(), B->Shape(),
+                                                              adapter_index->Shape(), parameters));
+
+  TensorShapeVector y_dims = X->Shape().AsShapeVector();
+  y_dims.back() = parameters.n;
+  Tensor* Y = context->Output(0, y_dims);
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  InlinedVector<batched_lora_matmul_helper::Segment> segments;
+  ORT_RETURN_IF_ERROR(batched_lora_matmul_helper::GetSegments(adapter_index->DataAsSpan<int32_t>(),
+                                                              parameters.num_adapters, segments));
+
+  const size_t rows_per_batch = narrow<size_t>(parameters.rows_per_batch);
+  const size_t k = narrow<size_t>(parameters.k);
+  const size_t rank = narrow<size_t>(parameters.rank);
+  const size_t n = narrow<size_t>(parameters.n);
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  auto shrunk = IAllocator::MakeUniquePtr<float>(allocator,
+                                                 SafeInt<size_t>(parameters.batch_size) * rows_per_batch * rank);
+
+  const float* x_data = X->Data<float>();
+  const float* a_data = A->Data<float>();
+  const float* b_data = B->Data<float>();
+  float* y_data = Y->MutableData<float>();
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  // each segment is a shrink GEMM with A followed by an expand GEMM with B, on all the rows of its batch entries
+  for (const auto& segment : segments) {
+    const size_t first_row = narrow<size_t>(segment.begin) * rows_per_batch;
+    const size_t m = narrow<size_t>(segment.end - segment.begin) * rows_per_batch;
+    float* y = y_data + first_row * n;
+    if (segment.adapter < 0 || rank == 0) {
+      std::fill_n(y, m * n, 0.0f);
+      continue;
+    }
+
+    const size_t adapter = static_cast<size_t>(segment.adapter);
+    MlasGemm(CblasNoTrans, CblasNoTrans, m, rank, k, 1.0f, x_data + first_row * k, k, a_data + adapter * k * rank,
+             rank, 0.0f, shrunk.get(), rank, thread_pool);
+    MlasGemm(CblasNoTrans, CblasNoTrans, m, n, rank, scale_, shrunk.get(), rank, b_data + adapter * rank * n, n,
+             0.0f, y, n, thread_pool);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace batched_lora_matmul_helper {
+
+struct Parameters {
+  int64_t batch_size;      // number of entries of adapter_index
+  int64_t rows_per_batch;  // rows of X per batch entry, e.g. the sequence length
+  int64_t k;               // columns of X
+  int64_t rank;            // rank of the adapters
+  int64_t n;               // columns of Y
+  int64_t num_adapters;
+};
+
+// A run of consecutive batch entries using the same adapter, multiplied by a single pair of GEMMs.
+struct Segment {
+  int64_t begin;    // first batch entry
+  int64_t end;      // one past the last batch entry
+  int32_t adapter;  // negative for no adapter
+};
+
+inline Status CheckInputs(const TensorShape& x_shape, const TensorShape& a_shape, const TensorShape& b_shape,
+                          const TensorShape& adapter_index_shape, Parameters& parameters) {
+  if (x_shape.NumDimensions() < 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "X is expected to have at least 2 dimensions, got ",
+                           x_shape.NumDimensions());
+  }
+  if (a_shape.NumDimensions() != 3 || b_shape.NumDimensions() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "A and B are expected to have 3 dimensions, got ", a_shape, " and ", b_shape);
+  }
+  if (adapter_index_shape.NumDimensions() != 1 || adapter_index_shape[0] != x_shape[0]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "adapter_index is expected to have the shape [", x_shape[0], "], got ",
+                           adapter_index_shape);
+  }
+
+  parameters.batch_size = x_shape[0];
+  parameters.k = x_shape[x_shape.NumDimensions() - 1];
+  parameters.rows_per_batch = x_shape.Slice(1, x_shape.NumDimensions() - 1).Size();
+  parameters.num_adapters = a_shape[0];
+  parameters.rank = a_shape[2];
+  parameters.n = b_shape[2];
+
+  if (a_shape[1] != parameters.k) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "The second dimension of A is expected to be the last dimension of X, ", parameters.k,
+                           ", got ", a_shape[1]);
+  }
+  if (b_shape[0] != parameters.num_adapters || b_shape[1] != parameters.rank) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "B is expected to have the shape [", parameters.num_adapters, ", ", parameters.rank,
+                           ", N], got ", b_shape);
+  }
+
+  return Status::OK();
+}
+
+// Splits the batch in runs of entries using the same adapter, so rows sharing an adapter are multiplied together.
+inline Status GetSegments(gsl::span<const int32_t> adapter_index, int64_t num_adapters,
+                          InlinedVector<Segment>& segments) {
+  segments.clear();
+  for (int64_t i = 0; i < static_cast<int64_t>(adapter_index.size()); ++i) {
+    const int32_t adapter = adapter_index[i] < 0 ? -1 : adapter_index[i];
+    if (adapter >= num_adapters) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "adapter_index ", adapter, " at ", i,
+                             " is out of range, there are ", num_adapters, " adapters");
+    }
+    if (!segments.empty() && segments.back().adapter == adapter) {
+      segments.back().end = i + 1;
+    } else {
+      segments.push_back({i, i + 1, adapter});
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace batched_lora_matmul_helper
+}  // namespace contrib
+}  // namespace onnxruntime
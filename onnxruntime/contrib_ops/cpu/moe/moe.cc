@@ -0,0 +1,365 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/moe/moe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    MoE,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    MoE<float>);
+
+namespace {
+
+// Appends the multiplications of the rows routed to each expert by the weights of the expert. As for the CUDA
+// kernel, the weights of an expert are a column major (k, n) matrix, so they are multiplied transposed.
+void AppendExpertGemms(std::vector<MLAS_SGEMM_GROUPED_PARAMS>& gemms, const std::vector<size_t>& expert_offsets,
+                       const float* a, const float* weights, float* c, size_t n, size_t k) {
+  for (size_t e = 0; e + 1 < expert_offsets.size(); ++e) {
+    const size_t rows = expert_offsets[e + 1] - expert_offsets[e];
+    if (rows == 0) {
+      continue;
+    }
+    MLAS_SGEMM_GROUPED_PARAMS gemm;
+    gemm.TransB = CblasTrans;
+    gemm.M = rows;
+    gemm.N = n;
+    gemm.K = k;
+    gemm.Data.A = a + expert_offsets[e] * k;
+    gemm.Data.lda = k;
+    gemm.Data.B = weights + e * n * k;
+    gemm.Data.ldb = k;
+    gemm.Data.C = c + expert_offsets[e] * n;
+    gemm.Data.ldc = n;
+    gemms.push_back(gemm);
+  }
+}
+
+void ApplyActivation(MoEActivationType activation_type, float* data, float* buffer, size_t count) {
+  switch (activation_type) {
+    case MoEActivationType::Relu:
+      for (size_t i = 0; i < count; ++i) {
+        data[i] = std::max(data[i], 0.0f);
+      }
+      break;
+    case MoEActivationType::Gelu: {
+      // the tanh approximation, as for the CUDA kernel
+      constexpr float kAlpha = 0.7978845608028654f;  // sqrt(2 / pi)
+      for (size_t i = 0; i < count; ++i) {
+        buffer[i] = kAlpha * (data[i] + 0.044715f * data[i] * data[i] * data[i]);
+      }
+      MlasComputeTanh(buffer, buffer, count);
+      for (size_t i = 0; i < count; ++i) {
+        data[i] = 0.5f * data[i] * (1.0f + buffer[i]);
+      }
+      break;
+    }
+    case MoEActivationType::Silu:
+      MlasComputeLogistic(data, buffer, count);
+      for (size_t i = 0; i < count; ++i) {
+        data[i] *= buffer[i];
+      }
+      break;
+    case MoEActivationType::Identity:
+      break;
+  }
+}
+
+}  // namespace
+
+template <typename T>
+MoE<T>::MoE(const OpKernelInfo& info) : OpKernel(info) {
+  ORT_ENFORCE(info.GetAttr<int64_t>("k", &k_).IsOK());
+  ORT_ENFORCE(k_ > 0, "k must be positive, got ", k_);
+
+  const std::string activation_type = info.GetAttrOrDefault<std::string>("activation_type", "relu");
+  if (activation_type == "relu") {
+    activation_type_ = MoEActivationType::Relu;
+  } else if (activation_type == "gelu") {
+    activation_type_ = MoEActivationType::Gelu;
+  } else if (activation_type == "silu") {
+    activation_type_ = MoEActivationType::Silu;
+  } else if (activation_type == "identity") {
+    activation_type_ = MoEActivationType::Identity;
+  } else {
+    ORT_THROW("Unsupported MoE activation type: ", activation_type);
+  }
+
+  normalize_routing_weights_ = info.GetAttrOrDefault<int64_t>("normalize_routing_weights", 0) == 1;
+  ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("use_sparse_mixer", 0) == 0,
+              "The sparse mixer is not supported by the CPU MoE kernel");
+}
+
+template <typename T>
+Status MoE<T>::CheckInputs(MoEParameters& parameters, const Tensor* input, const Tensor* router_probs,
+                           const Tensor* fc1_experts_weights, const Tensor* fc1_experts_bias,
+                           const Tensor* fc2_experts_weights, const Tensor* fc2_experts_bias,
+                           const Tensor* fc3_experts_weights, const Tensor* fc3_experts_bias) const {
+  const auto& input_dims = input->Shape().GetDims();
+  const auto& router_probs_dims = router_probs->Shape().GetDims();
+  const auto& fc1_experts_weights_dims = fc1_experts_weights->Shape().GetDims();
+  const auto& fc2_experts_weights_dims = fc2_experts_weights->Shape().GetDims();
+
+  if (input_dims.size() != 2 && input_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "input must be 2D or 3D, got ", input_dims.size());
+  }
+  if (router_probs_dims.size() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "router_probs must be 2D, got ", router_probs_dims.size());
+  }
+  if (fc1_experts_weights_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc1_experts_weights must be 3D, got ",
+                           fc1_experts_weights_dims.size());
+  }
+  if (fc2_experts_weights_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc2_experts_weights must be 3D, got ",
+                           fc2_experts_weights_dims.size());
+  }
+
+  const int64_t num_rows = input->Shape().SizeToDimension(input_dims.size() - 1);
+  const int64_t hidden_size = input_dims.back();
+  const int64_t num_experts = router_probs_dims[1];
+  const int64_t inter_size = fc2_experts_weights_dims[1];
+
+  if (router_probs_dims[0] != num_rows) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "router_probs_dims[0] must be equal to num_rows, got ",
+                           router_probs_dims[0], " and ", num_rows);
+  }
+  if (k_ > num_experts) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "k must not be greater than num_experts, got ", k_,
+                           " and ", num_experts);
+  }
+  const TensorShape fc1_shape({num_experts, hidden_size, inter_size});
+  if (fc1_experts_weights->Shape() != fc1_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc1_experts_weights must have shape ", fc1_shape,
+                           ", got ", fc1_experts_weights->Shape());
+  }
+  const TensorShape fc2_shape({num_experts, inter_size, hidden_size});
+  if (fc2_experts_weights->Shape() != fc2_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc2_experts_weights must have shape ", fc2_shape,
+                           ", got ", fc2_experts_weights->Shape());
+  }
+  if (fc3_experts_weights != nullptr && fc3_experts_weights->Shape() != fc1_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc3_experts_weights must have shape ", fc1_shape,
+                           ", got ", fc3_experts_weights->Shape());
+  }
+  if (fc3_experts_bias != nullptr && fc3_experts_weights == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc3_experts_bias requires fc3_experts_weights");
+  }
+
+  const TensorShape fc1_bias_shape({num_experts, inter_size});
+  if (fc1_experts_bias != nullptr && fc1_experts_bias->Shape() != fc1_bias_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc1_experts_bias must have shape ", fc1_bias_shape,
+                           ", got ", fc1_experts_bias->Shape());
+  }
+  if (fc3_experts_bias != nullptr && fc3_experts_bias->Shape() != fc1_bias_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc3_experts_bias must have shape ", fc1_bias_shape,
+                           ", got ", fc3_experts_bias->Shape());
+  }
+  const TensorShape fc2_bias_shape({num_experts, hidden_size});
+  if (fc2_experts_bias != nullptr && fc2_experts_bias->Shape() != fc2_bias_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc2_experts_bias must have shape ", fc2_bias_shape,
+                           ", got ", fc2_experts_bias->Shape());
+  }
+
+  parameters.num_rows = num_rows;
+  parameters.num_experts = num_experts;
+  parameters.hidden_size = hidden_size;
+  parameters.inter_size = inter_size;
+  return Status::OK();
+}
+
+template <typename T>
+Status MoE<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* router_probs = context->Input<Tensor>(1);
+  const Tensor* fc1_experts_weights = context->Input<Tensor>(2);
+  const Tensor* fc1_experts_bias = context->Input<Tensor>(3);
+  const Tensor* fc2_experts_weights = context->Input<Tensor>(4);
+  const Tensor* fc2_experts_bias = context->Input<Tensor>(5);
+  const Tensor* fc3_experts_weights = context->Input<Tensor>(6);
+  const Tensor* fc3_experts_bias = context->Input<Tensor>(7);
+
+  MoEParameters parameters = {};
+  ORT_RETURN_IF_ERROR(CheckInputs(parameters, input, router_probs, fc1_experts_weights, fc1_experts_bias,
+                                  fc2_experts_weights, fc2_experts_bias, fc3_experts_weights, fc3_experts_bias));
+
+  Tensor* output = context->Output(0, input->Shape());
+  if (parameters.num_rows == 0) {
+    return Status::OK();
+  }
+
+  const size_t num_rows = static_cast<size_t>(parameters.num_rows);
+  const size_t num_experts = static_cast<size_t>(parameters.num_experts);
+  const size_t hidden_size = static_cast<size_t>(parameters.hidden_size);
+  const size_t inter_size = static_cast<size_t>(parameters.inter_size);
+  const size_t k = static_cast<size_t>(k_);
+  const size_t expanded_rows = SafeInt<size_t>(num_rows) * k;
+  auto* tp = context->GetOperatorThreadPool();
+
+  // route each row to the k experts with the highest probabilities, the lower index first on a tie
+  const float* router_data = router_probs->Data<float>();
+  std::vector<int32_t> expanded_experts(expanded_rows);
+  std::vector<float> expanded_scales(expanded_rows);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_rows, static_cast<double>(num_experts * 8),
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> probs(num_experts);
+        std::vector<int32_t> order(num_experts);
+        for (std::ptrdiff_t row = begin; row != end; ++row) {
+          const float* logits = router_data + row * num_experts;
+          const float max_logit = *std::max_element(logits, logits + num_experts);
+          float sum = 0.0f;
+          for (size_t e = 0; e < num_experts; ++e) {
+            probs[e] = std::exp(logits[e] - max_logit);
+            sum += probs[e];
+          }
+
+          std::iota(order.begin(), order.end(), 0);
+          std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](int32_t a, int32_t b) {
+            return probs[a] > probs[b] || (probs[a] == probs[b] && a < b);
+          });
+
+          float scale_sum = sum;
+          if (normalize_routing_weights_) {
+            scale_sum = 0.0f;
+            for (size_t i = 0; i < k; ++i) {
+              scale_sum += probs[order[i]];
+            }
+          }
+          for (size_t i = 0; i < k; ++i) {
+            expanded_experts[row * k + i] = order[i];
+            expanded_scales[row * k + i] = probs[order[i]] / scale_sum;
+          }
+        }
+      });
+
+  // group the expanded rows by expert, so that each expert multiplies one contiguous block of rows
+  std::vector<size_t> expert_offsets(num_experts + 1, 0);
+  for (int32_t expert : expanded_experts) {
+    ++expert_offsets[expert + 1];
+  }
+  std::partial_sum(expert_offsets.begin(), expert_offsets.end(), expert_offsets.begin());
+
+  std::vector<size_t> permuted_rows(expanded_rows);   // position of each expanded row in the grouped rows
+  std::vector<size_t> source_rows(expanded_rows);     // input row of each grouped row
+  std::vector<int32_t> grouped_experts(expanded_rows);
+  {
+    std::vector<size_t> next_rows(expert_offsets.begin(), expert_offsets.end() - 1);
+    for (size_t i = 0; i < expanded_rows; ++i) {
+      const size_t position = next_rows[expanded_experts[i]]++;
+      permuted_rows[i] = position;
+      source_rows[position] = i / k;
+      grouped_experts[position] = expanded_experts[i];
+    }
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  // the grouped input rows are also the buffer of the fc2 output, which has the same shape
+  auto grouped_buffer = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * hidden_size);
+  auto fc1_buffer = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * inter_size);
+  IAllocatorUniquePtr<float> fc3_buffer;
+  if (fc3_experts_weights != nullptr) {
+    fc3_buffer = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * inter_size);
+  }
+  float* grouped_data = grouped_buffer.get();
+  float* fc1_data = fc1_buffer.get();
+  float* fc3_data = fc3_buffer.get();
+
+  const float* input_data = input->Data<float>();
+  concurrency::ThreadPool::TryParallelFor(
+      tp, expanded_rows, TensorOpCost{static_cast<double>(hidden_size * sizeof(float)),
+                                      static_cast<double>(hidden_size * sizeof(float)), 0.0},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t position = begin; position != end; ++position) {
+          std::memcpy(grouped_data + position * hidden_size, input_data + source_rows[position] * hidden_size,
+                      hidden_size * sizeof(float));
+        }
+      });
+
+  // the experts of fc1 and fc3 run as one grouped gemm, so the threads are spread over all of the experts
+  std::vector<MLAS_SGEMM_GROUPED_PARAMS> gemms;
+  gemms.reserve(2 * num_experts);
+  AppendExpertGemms(gemms, expert_offsets, grouped_data, fc1_experts_weights->Data<float>(), fc1_data, inter_size,
+                    hidden_size);
+  if (fc3_experts_weights != nullptr) {
+    AppendExpertGemms(gemms, expert_offsets, grouped_data, fc3_experts_weights->Data<float>(), fc3_data, inter_size,
+                      hidden_size);
+  }
+  MlasGemmGrouped(gemms.data(), gemms.size(), tp);
+
+  const float* fc1_bias_data = fc1_experts_bias != nullptr ? fc1_experts_bias->Data<float>() : nullptr;
+  const float* fc3_bias_data = fc3_experts_bias != nullptr ? fc3_experts_bias->Data<float>() : nullptr;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, expanded_rows, static_cast<double>(inter_size * 16),
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> buffer(inter_size);
+        for (std::ptrdiff_t position = begin; position != end; ++position) {
+          const size_t expert = static_cast<size_t>(grouped_experts[position]);
+          float* fc1_row = fc1_data + position * inter_size;
+          if (fc1_bias_data != nullptr) {
+            const float* bias = fc1_bias_data + expert * inter_size;
+            for (size_t i = 0; i < inter_size; ++i) {
+              fc1_row[i] += bias[i];
+            }
+          }
+          ApplyActivation(activation_type_, fc1_row, buffer.data(), inter_size);
+          if (fc3_data != nullptr) {
+            const float* fc3_row = fc3_data + position * inter_size;
+            const float* bias = fc3_bias_data != nullptr ? fc3_bias_data + expert * inter_size : nullptr;
+            for (size_t i = 0; i < inter_size; ++i) {
+              fc1_row[i] *= bias != nullptr ? fc3_row[i] + bias[i] : fc3_row[i];
+            }
+          }
+        }
+      });
+
+  gemms.clear();
+  AppendExpertGemms(gemms, expert_offsets, fc1_data, fc2_experts_weights->Data<float>(), grouped_data, hidden_size,
+                    inter_size);
+  MlasGemmGrouped(gemms.data(), gemms.size(), tp);
+
+  // scatter the expert outputs back to the rows, weighted by the routing scales
+  const float* fc2_bias_data = fc2_experts_bias != nullptr ? fc2_experts_bias->Data<float>() : nullptr;
+  float* output_data = output->MutableData<float>();
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_rows, static_cast<double>(k * hidden_size * 2),
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t row = begin; row != end; ++row) {
+          float* out = output_data + row * hidden_size;
+          std::fill_n(out, hidden_size, 0.0f);
+          for (size_t i = 0; i < k; ++i) {
+            const size_t expanded_row = row * k + i;
+            const float scale = expanded_scales[expanded_row];
+            const float* expert_row = grouped_data + permuted_rows[expanded_row] * hidden_size;
+            const float* bias =
+                fc2_bias_data != nullptr ? fc2_bias_data + expanded_experts[expanded_row] * hidden_size : nullptr;
+            for (size_t c = 0; c < hidden_size; ++c) {
+              out[c] += scale * (bias != nullptr ? expert_row[c] + bias[c] : expert_row[c]);
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
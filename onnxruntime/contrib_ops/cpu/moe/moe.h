@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+enum class MoEActivationType {
+  Relu,
+  Gelu,
+  Silu,
+  Identity,
+};
+
+struct MoEParameters {
+  int64_t num_rows;
+  int64_t num_experts;
+  int64_t hidden_size;
+  int64_t inter_size;
+};
+
+template <typename T>
+class MoE final : public OpKernel {
+ public:
+  explicit MoE(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  Status CheckInputs(MoEParameters& parameters, const Tensor* input, const Tensor* router_probs,
+                     const Tensor* fc1_experts_weights, const Tensor* fc1_experts_bias,
+                     const Tensor* fc2_experts_weights, const Tensor* fc2_experts_bias,
+                     const Tensor* fc3_experts_weights, const Tensor* fc3_experts_bias) const;
+
+  int64_t k_;
+  MoEActivationType activation_type_;
+  bool normalize_routing_weights_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
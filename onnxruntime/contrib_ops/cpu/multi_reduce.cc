@@ -0,0 +1,364 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/multi_reduce.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+#include "core/providers/cpu/reduction/reduction_ops.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    MultiReduce,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    MultiReduce);
+
+namespace {
+
+using ReduceType = MultiReduce::ReduceType;
+
+// independent partial results per lane let the contiguous loop vectorize without reassociating the sums.
+constexpr int64_t kStatsLanes = 8;
+// number of kept columns a task accumulates at once when the reduced axis is not the innermost one.
+constexpr int64_t kColumnBlockSize = 256;
+// minimum number of elements per task when all the axes are reduced into a single output.
+constexpr int64_t kMinElementsPerChunk = 16384;
+
+// running statistics of a reduced set, enough to produce every supported reduction.
+struct ReduceStats {
+  float sum = 0.f;
+  float sum_square = 0.f;
+  float abs_sum = 0.f;
+  float max = -std::numeric_limits<float>::infinity();
+  float min = std::numeric_limits<float>::infinity();
+
+  void Update(float v) {
+    sum += v;
+    sum_square += v * v;
+    abs_sum += std::abs(v);
+    max = v > max ? v : max;
+    min = v < min ? v : min;
+  }
+
+  void Merge(const ReduceStats& other) {
+    sum += other.sum;
+    sum_square += other.sum_square;
+    abs_sum += other.abs_sum;
+    max = other.max > max ? other.max : max;
+    min = other.min < min ? other.min : min;
+  }
+};
+
+void AccumulateContiguous(const float* data, int64_t size, ReduceStats& stats) {
+  float sum[kStatsLanes] = {};
+  float sum_square[kStatsLanes] = {};
+  float abs_sum[kStatsLanes] = {};
+  float max[kStatsLanes];
+  float min[kStatsLanes];
+  std::fill_n(max, kStatsLanes, stats.max);
+  std::fill_n(min, kStatsLanes, stats.min);
+
+  int64_t i = 0;
+  for (; i + kStatsLanes <= size; i += kStatsLanes) {
+    for (int64_t j = 0; j < kStatsLanes; ++j) {
+      const float v = data[i + j];
+      sum[j] += v;
+      sum_square[j] += v * v;
+      abs_sum[j] += std::abs(v);
+      max[j] = v > max[j] ? v : max[j];
+      min[j] = v < min[j] ? v : min[j];
+    }
+  }
+
+  for (int64_t j = 0; j < kStatsLanes; ++j) {
+    stats.Merge(ReduceStats{sum[j], sum_square[j], abs_sum[j], max[j], min[j]});
+  }
+  for (; i < size; ++i) {
+    stats.Update(data[i]);
+  }
+}
+
+float GetReducedValue(ReduceType type, const ReduceStats& stats, int64_t count) {
+  switch (type) {
+    case ReduceType::Sum:
+      return stats.sum;
+    case ReduceType::Mean:
+      // the mean of an empty set is 0, as for ReduceMean.
+      return count == 0 ? 0.f : stats.sum / static_cast<float>(count);
+    case ReduceType::SumSquare:
+      return stats.sum_square;
+    case ReduceType::L1:
+      return stats.abs_sum;
+    case ReduceType::L2:
+      return std::sqrt(stats.sum_square);
+    case ReduceType::Max:
+      return stats.max;
+    case ReduceType::Min:
+      return stats.min;
+  }
+  return 0.f;
+}
+
+struct OutputWriter {
+  gsl::span<const ReduceType> types;
+  InlinedVector<float*> outputs;
+  // number of reduced elements per output value.
+  int64_t count;
+
+  void Write(int64_t index, const ReduceStats& stats) const {
+    for (size_t i = 0; i < types.size(); ++i) {
+      outputs[i][index] = GetReducedValue(types[i], stats, count);
+    }
+  }
+};
+
+// fast_shape is [N], a single output.
+void ReduceAll(const float* data, int64_t size, const OutputWriter& writer, concurrency::ThreadPool* tp) {
+  const int64_t num_chunks = std::max<int64_t>(
+      1, std::min<int64_t>(concurrency::ThreadPool::DegreeOfParallelism(tp), size / kMinElementsPerChunk));
+  std::vector<ReduceStats> partial(narrow<size_t>(num_chunks));
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, narrow<std::ptrdiff_t>(num_chunks), [&](std::ptrdiff_t chunk) {
+    const int64_t start = size * chunk / num_chunks;
+    const int64_t end = size * (chunk + 1) / num_chunks;
+    AccumulateContiguous(data + start, end - start, partial[chunk]);
+  });
+
+  for (int64_t i = 1; i < num_chunks; ++i) {
+    partial[0].Merge(partial[narrow<size_t>(i)]);
+  }
+  writer.Write(0, partial[0]);
+}
+
+// fast_shape is [K, R], each output reduces a contiguous row.
+void ReduceRows(const float* data, int64_t rows, int64_t row_size, const OutputWriter& writer,
+                concurrency::ThreadPool* tp) {
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(rows), ParallelReduceFastCost(1, row_size, sizeof(float), 6),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          ReduceStats stats;
+          AccumulateContiguous(data + row * row_size, row_size, stats);
+          writer.Write(row, stats);
+        }
+      });
+}
+
+// fast_shape is [D, R, K] (D = 1 for RK), each output reduces a column of one of the D [R, K] matrices.
+// Blocks of columns are accumulated row by row so the input is read sequentially.
+void ReduceColumns(const float* data, int64_t outer, int64_t reduced, int64_t columns, const OutputWriter& writer,
+                   concurrency::ThreadPool* tp) {
+  const int64_t blocks_per_matrix = (columns + kColumnBlockSize - 1) / kColumnBlockSize;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(outer * blocks_per_matrix),
+      ParallelReduceFastCost(std::min(columns, kColumnBlockSize), reduced, sizeof(float), 6),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        float sum[kColumnBlockSize];
+        float sum_square[kColumnBlockSize];
+        float abs_sum[kColumnBlockSize];
+        float max[kColumnBlockSize];
+        float min[kColumnBlockSize];
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const int64_t d = block / blocks_per_matrix;
+          const int64_t column_start = (block % blocks_per_matrix) * kColumnBlockSize;
+          const int64_t block_size = std::min(kColumnBlockSize, columns - column_start);
+          std::fill_n(sum, block_size, 0.f);
+          std::fill_n(sum_square, block_size, 0.f);
+          std::fill_n(abs_sum, block_size, 0.f);
+          std::fill_n(max, block_size, -std::numeric_limits<float>::infinity());
+          std::fill_n(min, block_size, std::numeric_limits<float>::infinity());
+
+          const float* p = data + d * reduced * columns + column_start;
+          for (int64_t r = 0; r < reduced; ++r, p += columns) {
+            for (int64_t c = 0; c < block_size; ++c) {
+              const float v = p[c];
+              sum[c] += v;
+              sum_square[c] += v * v;
+              abs_sum[c] += std::abs(v);
+              max[c] = v > max[c] ? v : max[c];
+              min[c] = v < min[c] ? v : min[c];
+            }
+          }
+
+          for (int64_t c = 0; c < block_size; ++c) {
+            writer.Write(d * columns + column_start + c, ReduceStats{sum[c], sum_square[c], abs_sum[c], max[c], min[c]});
+          }
+        }
+      });
+}
+
+// Any other layout, with the indices computed by NoTransposePrepareForReduce as in NoTransposeReduce1Loop.
+void ReduceProjected(const float* data, const TensorShape& fast_shape, gsl::span<const int64_t> fast_axes,
+                     int64_t output_size, const OutputWriter& writer, concurrency::ThreadPool* tp) {
+  ResultsNoTransposePrepareForReduce results;
+  NoTransposePrepareForReduce(fast_shape, fast_axes, results);
+  results.ValidateNotEmpty();
+
+  const int64_t loop_size = results.last_loop_red_size * results.last_loop_red_inc;
+  auto fn = [&](std::ptrdiff_t first, std::ptrdiff_t end) {
+    int64_t main_index = first / results.last_loop_size;
+    int64_t loop = first % results.last_loop_size;
+    int64_t origin = results.unprojected_index[narrow<size_t>(main_index)] + loop * results.last_loop_inc;
+    for (int64_t index = first; index < end; ++index) {
+      ReduceStats stats;
+      for (int64_t projected : results.projected_index) {
+        const float* p = data + origin + projected;
+        if (results.last_loop_red_inc == 1) {
+          AccumulateContiguous(p, results.last_loop_red_size, stats);
+        } else {
+          for (int64_t red = 0; red < loop_size; red += results.last_loop_red_inc) {
+            stats.Update(p[red]);
+          }
+        }
+      }
+      writer.Write(index, stats);
+
+      ++loop;
+      if (loop >= results.last_loop_size) {
+        loop = 0;
+        ++main_index;
+        if (main_index < static_cast<int64_t>(results.unprojected_index.size())) {
+          origin = results.unprojected_index[narrow<size_t>(main_index)];
+        }
+      } else {
+        origin += results.last_loop_inc;
+      }
+    }
+  };
+
+  auto cost = ParallelReduceFastCost(1, writer.count, sizeof(float), 6);
+  concurrency::ThreadPool::TryParallelFor(tp, narrow<std::ptrdiff_t>(output_size), cost, fn);
+}
+
+}  // namespace
+
+bool MultiReduce::TryParseReduceType(const std::string& op_type, ReduceType& type) {
+  static const InlinedHashMap<std::string, ReduceType> reduce_types{
+      {"ReduceSum", ReduceType::Sum},
+      {"ReduceMean", ReduceType::Mean},
+      {"ReduceSumSquare", ReduceType::SumSquare},
+      {"ReduceL1", ReduceType::L1},
+      {"ReduceL2", ReduceType::L2},
+      {"ReduceMax", ReduceType::Max},
+      {"ReduceMin", ReduceType::Min},
+  };
+
+  auto it = reduce_types.find(op_type);
+  if (it == reduce_types.end()) {
+    return false;
+  }
+
+  type = it->second;
+  return true;
+}
+
+MultiReduce::MultiReduce(const OpKernelInfo& info) : OpKernel(info) {
+  const auto reduce_ops = info.GetAttrsOrDefault<std::string>("reduce_ops");
+  ORT_ENFORCE(!reduce_ops.empty(), "MultiReduce requires at least one reduction.");
+  ORT_ENFORCE(reduce_ops.size() == info.GetOutputCount(),
+              "MultiReduce requires one output per reduction, got ", info.GetOutputCount(), " outputs for ",
+              reduce_ops.size(), " reductions.");
+
+  reduce_types_.reserve(reduce_ops.size());
+  for (const auto& reduce_op : reduce_ops) {
+    ReduceType type;
+    ORT_ENFORCE(TryParseReduceType(reduce_op, type), "Unsupported reduction in MultiReduce: ", reduce_op);
+    reduce_types_.push_back(type);
+  }
+
+  const auto axes = info.GetAttrsOrDefault<int64_t>("axes");
+  axes_.assign(axes.begin(), axes.end());
+  keepdims_ = info.GetAttrOrDefault<int64_t>("keepdims", 1) != 0;
+}
+
+Status MultiReduce::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const TensorShape& input_shape = input->Shape();
+  const auto input_dims = input_shape.GetDims();
+  const int64_t rank = narrow<int64_t>(input_dims.size());
+  for (int64_t axis : axes_) {
+    ORT_RETURN_IF_NOT(rank == 0 || (axis >= -rank && axis < rank),
+                      "MultiReduce axis ", axis, " is out of range for an input of rank ", rank);
+  }
+
+  TensorShapeVector fast_shape;
+  TensorShapeVector output_shape;
+  TensorShapeVector fast_axes;
+  const FastReduceKind fast_kind = OptimizeShapeForFastReduce(input_dims, axes_, fast_shape, output_shape, fast_axes,
+                                                              keepdims_);
+
+  if (input_shape.Size() == 0) {
+    // OptimizeShapeForFastReduce gives a size of 0 to the kept empty dimensions, the reductions keep them as 1.
+    output_shape.clear();
+    for (int64_t i = 0; i < rank; ++i) {
+      const bool reduced = axes_.empty() ||
+                           std::any_of(axes_.begin(), axes_.end(),
+                                       [&](int64_t axis) { return HandleNegativeAxis(axis, rank) == i; });
+      if (!reduced) {
+        output_shape.push_back(input_dims[narrow<size_t>(i)]);
+      } else if (keepdims_) {
+        output_shape.push_back(1);
+      }
+    }
+  }
+
+  OutputWriter writer{reduce_types_, {}, 0};
+  writer.outputs.reserve(reduce_types_.size());
+  for (size_t i = 0; i < reduce_types_.size(); ++i) {
+    writer.outputs.push_back(context->Output(narrow<int>(i), output_shape)->MutableData<float>());
+  }
+
+  const int64_t output_size = TensorShape(output_shape).Size();
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  writer.count = input_shape.Size() / output_size;
+  const float* data = input->Data<float>();
+  if (input_shape.Size() == 0) {
+    for (int64_t i = 0; i < output_size; ++i) {
+      writer.Write(i, ReduceStats{});
+    }
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  switch (fast_kind) {
+    case FastReduceKind::kEmpty: {
+      // a scalar input.
+      ReduceStats stats;
+      stats.Update(*data);
+      writer.Write(0, stats);
+      break;
+    }
+    case FastReduceKind::kR:
+      ReduceAll(data, fast_shape[0], writer, tp);
+      break;
+    case FastReduceKind::kKR:
+      ReduceRows(data, fast_shape[0], fast_shape[1], writer, tp);
+      break;
+    case FastReduceKind::kRK:
+      ReduceColumns(data, 1, fast_shape[0], fast_shape[1], writer, tp);
+      break;
+    case FastReduceKind::kKRK:
+      ReduceColumns(data, fast_shape[0], fast_shape[1], fast_shape[2], writer, tp);
+      break;
+    default:
+      ReduceProjected(data, TensorShape(fast_shape), fast_axes, output_size, writer, tp);
+      break;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+/// <summary>
+/// Computes the reductions of sibling Reduce* nodes fused by MultiReduceFusion in a single pass over the data.
+/// The shape is simplified and the reduced indices are computed once, then the running sum, sum of squares, sum of
+/// absolute values, maximum and minimum of each reduced set are updated together and every output is derived from
+/// them.
+/// </summary>
+class MultiReduce final : public OpKernel {
+ public:
+  enum class ReduceType {
+    Sum,
+    Mean,
+    SumSquare,
+    L1,
+    L2,
+    Max,
+    Min,
+  };
+
+  // Returns true and sets type if op_type is a reduction supported by MultiReduce.
+  static bool TryParseReduceType(const std::string& op_type, ReduceType& type);
+
+  explicit MultiReduce(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  InlinedVector<ReduceType> reduce_types_;
+  TensorShapeVector axes_;
+  bool keepdims_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
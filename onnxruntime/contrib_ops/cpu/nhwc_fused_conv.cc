@@ -0,0 +1,300 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <numeric>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/util/math.h"
+#include "core/util/math_cpuonly.h"
+#include "contrib_ops/cpu/fused_activation.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+/**
+ * @brief Float Conv with optional activation and add fused in, on channels last (NHWC) input and output.
+ *
+ * The NhwcTransformer converts the float Conv and FusedConv nodes to this operator when the
+ * "session.enable_fp32_nhwc_layout" option is set, so a model whose convolutions, pools and element wise ops all run
+ * channels last only has a Transpose at its inputs and outputs.
+ *
+ * Each output pixel is a row of M output channels. A convolution is an im2col of the input followed by one gemm per
+ * group, all dispatched as a single MlasGemmBatch, and a depthwise convolution accumulates the kernel taps of each
+ * pixel through an indirection buffer instead.
+ */
+class NhwcFusedConvFloat final : public OpKernel {
+ public:
+  explicit NhwcFusedConvFloat(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  /**
+   * @brief Reorders the filter from (M x C/group x kernel_size) to (kernel_size x C/group) x M, the B matrix of the
+   *        gemms: the filters of group g are the M/group columns starting at g * M/group. For a depthwise
+   *        convolution this is kernel_size x C, the filter value of each channel being contiguous for each tap.
+   */
+  static void ReorderFilter(const float* input,
+                            float* output,
+                            size_t output_channels,
+                            size_t input_channels,
+                            size_t kernel_size) {
+    for (size_t k = 0; k < kernel_size; k++) {
+      for (size_t ic = 0; ic < input_channels; ic++) {
+        for (size_t oc = 0; oc < output_channels; oc++) {
+          *output++ = input[(oc * input_channels + ic) * kernel_size + k];
+        }
+      }
+    }
+  }
+
+  MLAS_ACTIVATION activation_;
+  ConvAttributes conv_attrs_;
+  BufferUniquePtr reordered_W_buffer_;
+};
+
+Status NhwcFusedConvFloat::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                   /*out*/ bool& is_packed,
+                                   /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+  // W is kept as the shape checks of Compute use it
+  is_packed = false;
+
+  const auto& shape = tensor.Shape().GetDims();
+  if (input_idx != 1 || shape.size() <= 2) {
+    return Status::OK();
+  }
+
+  const size_t output_channels = narrow<size_t>(shape[0]);
+  const size_t group_input_channels = narrow<size_t>(shape[1]);
+  const size_t kernel_size = narrow<size_t>(
+      std::accumulate(shape.begin() + 2, shape.end(), int64_t{1}, std::multiplies<int64_t>()));
+
+  auto* reordered_W = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * output_channels * group_input_channels *
+                                   kernel_size);
+  reordered_W_buffer_ = BufferUniquePtr(reordered_W, BufferDeleter(std::move(alloc)));
+  ReorderFilter(tensor.Data<float>(), static_cast<float*>(reordered_W), output_channels, group_input_channels,
+                kernel_size);
+  return Status::OK();
+}
+
+Status NhwcFusedConvFloat::Compute(OpKernelContext* context) const {
+  const size_t num_inputs = OpKernel::Node().InputDefs().size();
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
+  const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W->Shape(), true, false));
+
+  const auto& input_dims = X->Shape().GetDims();
+  const size_t rank = input_dims.size();
+  ORT_RETURN_IF_NOT(rank >= 3, "Input dimension cannot be less than 3.");
+  const int64_t N = input_dims[0];
+  const int64_t C = input_dims[rank - 1];
+  const int64_t M = W->Shape()[0];
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  const size_t spatial_dims = kernel_shape.size();
+
+  ConvAttributes::ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(spatial_dims * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(spatial_dims, 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(spatial_dims, 1);
+  }
+
+  TensorShapeVector Y_dims({N});
+  const TensorShape input_shape = X->Shape().Slice(1, rank - 1);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads,
+                                                          Y_dims));
+  Y_dims.push_back(M);
+  Tensor* Y = context->Output(0, Y_dims);
+  const TensorShape output_shape = Y->Shape().Slice(1, rank - 1);
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const int64_t group_count = conv_attrs_.group;
+  const int64_t group_input_channels = C / group_count;
+  const int64_t group_output_channels = M / group_count;
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+  const int64_t kernel_dim = group_input_channels * kernel_size;
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // W is reordered on every run when it isn't a constant initializer.
+  const float* reordered_W = static_cast<const float*>(reordered_W_buffer_.get());
+  IAllocatorUniquePtr<float> reordered_W_per_run;
+  if (reordered_W == nullptr) {
+    reordered_W_per_run = IAllocator::MakeUniquePtr<float>(alloc, narrow<size_t>(W->Shape().Size()));
+    ReorderFilter(W->Data<float>(), reordered_W_per_run.get(), narrow<size_t>(M),
+                  narrow<size_t>(group_input_channels), narrow<size_t>(kernel_size));
+    reordered_W = reordered_W_per_run.get();
+  }
+
+  const float* Xdata = X->Data<float>();
+  const float* Bdata = B != nullptr ? B->Data<float>() : nullptr;
+  float* Ydata = Y->MutableData<float>();
+
+  // Check for the optional Conv/Sum fusion.
+  float Beta = 0.0f;
+  if (Sum != nullptr) {
+    ORT_RETURN_IF_NOT(Y->Shape() == Sum->Shape(), "output and sum shape must match");
+    // If the output was not allocated inplace with the sum tensor, then copy here.
+    const float* sum_data = Sum->Data<float>();
+    if (Ydata != sum_data) {
+      std::copy_n(sum_data, narrow<size_t>(Y->Shape().Size()), Ydata);
+    }
+    Beta = 1.0f;
+  }
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+  const bool is_depthwise_conv = (group_input_channels == 1 && group_output_channels == 1);
+  const bool is_pointwise_conv =
+      group_count == 1 &&
+      std::all_of(kernel_shape.begin(), kernel_shape.end(), [](int64_t v) { return v == 1; }) &&
+      std::all_of(strides.begin(), strides.end(), [](int64_t v) { return v == 1; }) &&
+      std::all_of(pads.begin(), pads.end(), [](int64_t v) { return v == 0; });
+
+  IAllocatorUniquePtr<float> col_buffer;
+  IAllocatorUniquePtr<const float*> indirection_buffer;
+  std::vector<float> padding_data;
+  if (is_depthwise_conv) {
+    indirection_buffer = IAllocator::MakeUniquePtr<const float*>(
+        alloc, SafeInt<size_t>(kernel_size) * output_image_size);
+    padding_data.resize(narrow<size_t>(C), 0.0f);
+  } else if (!is_pointwise_conv) {
+    col_buffer = IAllocator::MakeUniquePtr<float>(
+        alloc, SafeInt<size_t>(group_count) * output_image_size * kernel_dim);
+  }
+
+  std::vector<MLAS_SGEMM_DATA_PARAMS> gemm_params(narrow<size_t>(group_count));
+
+  for (int64_t image_id = 0; image_id < N; ++image_id) {
+    if (is_depthwise_conv) {
+      math::Im2col<float, StorageOrder::NHWC>()(
+          Xdata,
+          C,
+          input_shape.GetDims().data(),
+          output_shape.GetDims().data(),
+          kernel_shape.data(),
+          strides.data(),
+          dilations.data(),
+          pads.data(),
+          static_cast<ptrdiff_t>(spatial_dims),
+          0,
+          output_image_size,
+          indirection_buffer.get(),
+          padding_data.data());
+
+      // accumulate the kernel taps of blocks of output pixels, each tap being a contiguous row of C values
+      constexpr int64_t output_stride = 16;
+      const int64_t task_count = (output_image_size + output_stride - 1) / output_stride;
+      auto worker = [&](ptrdiff_t batch) {
+        const int64_t output_start = static_cast<int64_t>(batch) * output_stride;
+        const int64_t output_end = std::min(output_start + output_stride, output_image_size);
+        for (int64_t p = output_start; p < output_end; ++p) {
+          float* y = Ydata + p * C;
+          if (Beta == 0.0f) {
+            std::fill_n(y, narrow<size_t>(C), 0.0f);
+          }
+          const float* const* taps = indirection_buffer.get() + p * kernel_size;
+          for (int64_t k = 0; k < kernel_size; ++k) {
+            const float* x = taps[k];
+            const float* w = reordered_W + k * C;
+            for (int64_t c = 0; c < C; ++c) {
+              y[c] += x[c] * w[c];
+            }
+          }
+        }
+      };
+      concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, narrow<ptrdiff_t>(task_count), worker);
+    } else {
+      const float* col_data = Xdata;
+      if (!is_pointwise_conv) {
+        for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+          math::Im2col<float, StorageOrder::NHWC>()(
+              Xdata + group_id * group_input_channels,
+              group_input_channels,
+              C,
+              input_shape.GetDims().data(),
+              output_shape.GetDims().data(),
+              kernel_shape.data(),
+              strides.data(),
+              dilations.data(),
+              pads.data(),
+              static_cast<ptrdiff_t>(spatial_dims),
+              col_buffer.get() + group_id * output_image_size * kernel_dim);
+        }
+        col_data = col_buffer.get();
+      }
+
+      for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+        MLAS_SGEMM_DATA_PARAMS& params = gemm_params[narrow<size_t>(group_id)];
+        params.A = col_data + group_id * output_image_size * kernel_dim;
+        params.lda = narrow<size_t>(kernel_dim);
+        params.B = reordered_W + group_id * group_output_channels;
+        params.ldb = narrow<size_t>(M);
+        params.C = Ydata + group_id * group_output_channels;
+        params.ldc = narrow<size_t>(M);
+        params.alpha = 1.0f;
+        params.beta = Beta;
+      }
+      MlasGemmBatch(CblasNoTrans, CblasNoTrans,
+                    narrow<size_t>(output_image_size),
+                    narrow<size_t>(group_output_channels),
+                    narrow<size_t>(kernel_dim),
+                    gemm_params.data(),
+                    gemm_params.size(),
+                    thread_pool);
+    }
+
+    // the bias is per column here, so it is added before the activation instead of by MlasActivation
+    if (Bdata != nullptr) {
+      auto Ymatrix = EigenMatrixMap<float>(Ydata, M, output_image_size);
+      Ymatrix.colwise() += ConstEigenVectorMap<float>(Bdata, M);
+    }
+    MlasActivation(&activation_, Ydata, nullptr, narrow<size_t>(output_image_size), narrow<size_t>(M),
+                   narrow<size_t>(M));
+
+    Xdata += input_image_size * C;
+    Ydata += output_image_size * M;
+  }
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    NhwcFusedConv,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NhwcFusedConvFloat);
+
+}  // namespace contrib
+}  // namespace onnxruntime
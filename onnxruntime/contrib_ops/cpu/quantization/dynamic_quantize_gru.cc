@@ -0,0 +1,358 @@
+#include "core/common/narrow.h"
+#include "core/providers/cpu/rnn/deep_cpu_gru.h"
+#include "core/providers/cpu/rnn/gru_base.h"
+#include "core/providers/cpu/rnn/rnn_helpers.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+using namespace rnn::detail;
+
+class DynamicQuantizeGRU : public OpKernel, public GRUBase {
+ public:
+  DynamicQuantizeGRU(const OpKernelInfo& info) : OpKernel(info), GRUBase(info) {}
+
+  Status PrePack(const Tensor& tensor, int input_idx,
+                 AllocatorPtr alloc, /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+  ~DynamicQuantizeGRU() override = default;
+
+ private:
+  bool TryPackInputWeights(const Tensor& weights, AllocatorPtr& alloc);
+
+  bool TryPackRecurrentWeights(const Tensor& weights, AllocatorPtr& alloc);
+
+  // input weights of all the directions, packed in the same buffer
+  PackedWeights packed_W_;
+  // recurrent_weights_ZR_ fwd, followed by bwd
+  PackedWeights packed_R_ZR_;
+  // recurrent_weights_H_ fwd, followed by bwd
+  PackedWeights packed_R_H_;
+  bool is_W_signed_;
+  bool is_R_signed_;
+};
+
+bool DynamicQuantizeGRU::TryPackInputWeights(const Tensor& weights, AllocatorPtr& alloc) {
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3) {
+    return false;
+  }
+
+  // weights: [num_directions, input_size, 3*hidden_size]
+  const size_t K = static_cast<size_t>(shape[1]);
+  const size_t N = static_cast<size_t>(shape[2]);
+
+  if ((shape[0] != num_directions_) || (N != static_cast<size_t>(hidden_size_) * 3)) {
+    return false;
+  }
+
+  is_W_signed_ = weights.IsDataType<int8_t>();
+  const size_t packed_weights_size = MlasGemmPackBSize(N, K, false /*AIsSigned*/, is_W_signed_);
+  if (packed_weights_size == 0) {
+    return false;
+  }
+
+  const size_t buffer_size = SafeInt<size_t>(packed_weights_size) * num_directions_;
+  packed_W_.buffer_ = IAllocator::MakeUniquePtr<void>(alloc, buffer_size, true);
+
+  auto* packed_weights_data = packed_W_.buffer_.get();
+
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we don not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_weights_data, 0, buffer_size);
+
+  packed_W_.buffer_size_ = buffer_size;
+  packed_W_.weights_size_ = packed_weights_size;
+  packed_W_.shape_ = shape;
+
+  const auto* weights_data = static_cast<const uint8_t*>(weights.DataRaw());
+  for (int i = 0; i < num_directions_; i++) {
+    MlasGemmPackB(N, K, weights_data, N, false /*AIsSigned*/, is_W_signed_, packed_weights_data);
+    packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
+    weights_data += N * K;
+  }
+
+  return true;
+}
+
+bool DynamicQuantizeGRU::TryPackRecurrentWeights(const Tensor& weights, AllocatorPtr& alloc) {
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3) {
+    return false;
+  }
+
+  // recurrence weights: [num_directions, hidden_size, 3*hidden_size]
+  const size_t K = static_cast<size_t>(shape[1]);
+  const size_t N = static_cast<size_t>(shape[2]);
+
+  if ((shape[0] != num_directions_) || K != static_cast<size_t>(hidden_size_) || (N != K * 3)) {
+    return false;
+  }
+
+  is_R_signed_ = weights.IsDataType<int8_t>();
+
+  // We are making two packed buffers, one for the ZR columns and another for the H columns,
+  // both read straight from the [hidden_size, 3*hidden_size] weights with ldb = 3*hidden_size.
+  const size_t hidden_size_x2 = 2 * K;
+  const size_t ZR_packed_size = MlasGemmPackBSize(hidden_size_x2, K, false /*AIsSigned*/, is_R_signed_);
+  const size_t H_packed_size = MlasGemmPackBSize(K, K, false /*AIsSigned*/, is_R_signed_);
+  if (ZR_packed_size == 0 || H_packed_size == 0) {
+    return false;
+  }
+
+  const size_t buffer_size_ZR = SafeInt<size_t>(ZR_packed_size) * num_directions_;
+  const size_t buffer_size_H = SafeInt<size_t>(H_packed_size) * num_directions_;
+
+  packed_R_ZR_.buffer_ = IAllocator::MakeUniquePtr<void>(alloc, buffer_size_ZR, true);
+  auto* buffer_ZR = packed_R_ZR_.buffer_.get();
+  memset(buffer_ZR, 0, buffer_size_ZR);
+
+  packed_R_ZR_.buffer_size_ = buffer_size_ZR;
+  packed_R_ZR_.weights_size_ = ZR_packed_size;
+  packed_R_ZR_.shape_ = shape;  // original shape, not used in prepacked calculations, but useful for validation
+
+  packed_R_H_.buffer_ = IAllocator::MakeUniquePtr<void>(alloc, buffer_size_H, true);
+  auto* buffer_H = packed_R_H_.buffer_.get();
+  memset(buffer_H, 0, buffer_size_H);
+
+  packed_R_H_.buffer_size_ = buffer_size_H;
+  packed_R_H_.weights_size_ = H_packed_size;
+  packed_R_H_.shape_ = shape;
+
+  const auto* weights_data = static_cast<const uint8_t*>(weights.DataRaw());
+  for (int i = 0; i < num_directions_; i++) {
+    MlasGemmPackB(hidden_size_x2, K, weights_data, N, false /*AIsSigned*/, is_R_signed_, buffer_ZR);
+    MlasGemmPackB(K, K, weights_data + hidden_size_x2, N, false /*AIsSigned*/, is_R_signed_, buffer_H);
+    buffer_ZR = static_cast<uint8_t*>(buffer_ZR) + ZR_packed_size;
+    buffer_H = static_cast<uint8_t*>(buffer_H) + H_packed_size;
+    weights_data += N * K;
+  }
+
+  return true;
+}
+
+Status DynamicQuantizeGRU::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                   /*out*/ bool& is_packed,
+                                   /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  const bool share_prepacked_weights = (prepacked_weights != nullptr);
+
+  if (input_idx == 1) {
+    is_packed = TryPackInputWeights(tensor, alloc);
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_W_.buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_W_.buffer_size_);
+    }
+  } else if (input_idx == 2) {
+    is_packed = TryPackRecurrentWeights(tensor, alloc);
+    if (is_packed && share_prepacked_weights) {
+      prepacked_weights->buffers_.push_back(std::move(packed_R_ZR_.buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_R_ZR_.buffer_size_);
+      prepacked_weights->buffers_.push_back(std::move(packed_R_H_.buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_R_H_.buffer_size_);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DynamicQuantizeGRU::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                     int input_idx,
+                                                     /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    packed_W_.buffer_ = std::move(prepacked_buffers[0]);
+    used_shared_buffers = true;
+  } else if (input_idx == 2) {
+    packed_R_ZR_.buffer_ = std::move(prepacked_buffers[0]);
+    packed_R_H_.buffer_ = std::move(prepacked_buffers[1]);
+    used_shared_buffers = true;
+  }
+
+  return Status::OK();
+}
+
+#define WeightCheck(weight_shape, weight_name)                                                                                              \
+  if ((weight_shape.NumDimensions() != 1 && weight_shape.NumDimensions() != 2) ||                                                           \
+      (weight_shape.NumDimensions() == 2 && weight_shape[1] != static_cast<int64_t>(hidden_size_) * 3) ||                                   \
+      weight_shape[0] != num_directions_) {                                                                                                 \
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,                                                                                   \
+                           "Input ", #weight_name, " must have shape {", num_directions_, "} for per-tensor/layer quantization or shape {", \
+                           num_directions_, ", 3*", hidden_size_, "} for per-channel quantization. Actual:", weight_shape);                 \
+  }
+
+#define ZeroPointCheck(w_zp, zp_shape, is_W_signed, weight_name)                                                                          \
+  if (zp_shape.NumDimensions() == 2) {                                                                                                    \
+    const int64_t zp_size = zp_shape.Size();                                                                                              \
+    const uint8_t* w_zp_data = static_cast<const uint8_t*>(w_zp->DataRaw());                                                              \
+    if (is_W_signed) {                                                                                                                    \
+      for (int64_t i = 0; i < zp_size; i++) {                                                                                             \
+        if (w_zp_data[i] != 0) {                                                                                                          \
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "DynamicQuantizeGRU : ", #weight_name, "Weight zero point must be zero"); \
+        }                                                                                                                                 \
+      }                                                                                                                                   \
+    } else {                                                                                                                              \
+      const uint8_t W_zero_point_value = w_zp_data[0];                                                                                    \
+      for (int64_t i = 1; i < zp_size; i++) {                                                                                             \
+        if (w_zp_data[i] != W_zero_point_value) {                                                                                         \
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "DynamicQuantizeGRU : ", #weight_name, "Weight point must be constant");  \
+        }                                                                                                                                 \
+      }                                                                                                                                   \
+    }                                                                                                                                     \
+  }
+
+Status DynamicQuantizeGRU::Compute(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
+  // weights. [num_directions, input_size, 3*hidden_size]
+  const Tensor* W = packed_W_.buffer_ ? nullptr : context->Input<Tensor>(1);
+  // recurrence weights. [num_directions, hidden_size, 3*hidden_size]
+  const Tensor* R = packed_R_ZR_.buffer_ ? nullptr : context->Input<Tensor>(2);
+
+  // optional
+  const Tensor* B = context->Input<Tensor>(3);              // bias. [num_directions, 6*hidden_size]
+  const Tensor* sequence_lens = context->Input<Tensor>(4);  // [batch_size]
+  const Tensor* initial_h = context->Input<Tensor>(5);      // initial hidden. [num_directions, batch_size, hidden_size]
+
+  const auto& W_shape = (W != nullptr) ? W->Shape() : packed_W_.shape_;
+  const auto& R_shape = (R != nullptr) ? R->Shape() : packed_R_ZR_.shape_;
+
+  if (W_shape.NumDimensions() != 3 || R_shape.NumDimensions() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input W and R must have 3 dimensions. Actual:",
+                           W_shape, " and ", R_shape);
+  }
+
+  // The quantized weights are stored as [num_directions, K, N], the validation expects the layout of GRU.
+  ORT_RETURN_IF_ERROR(ValidateCommonRnnInputs(X, TensorShape{W_shape[0], W_shape[2], W_shape[1]},
+                                              TensorShape{R_shape[0], R_shape[2], R_shape[1]},
+                                              B, 3, sequence_lens, initial_h, num_directions_, hidden_size_));
+
+  const Tensor* w_scale = context->Input<Tensor>(6);
+  const Tensor* w_zp = context->Input<Tensor>(7);
+  const Tensor* r_scale = context->Input<Tensor>(8);
+  const Tensor* r_zp = context->Input<Tensor>(9);
+
+  const TensorShape& W_zp_shape = w_zp->Shape();
+  const TensorShape& R_zp_shape = r_zp->Shape();
+  const TensorShape& W_scale_shape = w_scale->Shape();
+  const TensorShape& R_scale_shape = r_scale->Shape();
+
+  WeightCheck(W_zp_shape, W_zero_point);
+  WeightCheck(R_zp_shape, R_zero_point);
+  WeightCheck(W_scale_shape, W_scale);
+  WeightCheck(R_scale_shape, R_scale);
+
+  const bool is_W_signed = (W != nullptr) ? W->IsDataType<int8_t>() : is_W_signed_;
+  const bool is_R_signed = (R != nullptr) ? R->IsDataType<int8_t>() : is_R_signed_;
+
+  ZeroPointCheck(w_zp, W_zp_shape, is_W_signed, Input);
+  ZeroPointCheck(r_zp, R_zp_shape, is_R_signed, Recurrent);
+
+  const bool is_W_per_channel = W_scale_shape.NumDimensions() == 2;
+  const bool is_R_per_channel = R_scale_shape.NumDimensions() == 2;
+  const size_t W_scale_size = is_W_per_channel ? narrow<size_t>(W_scale_shape[1]) : 1;
+  const size_t R_scale_size = is_R_per_channel ? narrow<size_t>(R_scale_shape[1]) : 1;
+
+  // The ZR and H parts of R are separate GEMMs, so each takes its own slice of the per-channel parameters.
+  const size_t hidden_size = static_cast<size_t>(hidden_size_);
+  const size_t R_H_scale_offset = is_R_per_channel ? 2 * hidden_size : 0;
+
+  QuantizationParameter quant_para_W_1(w_scale->Data<float>(),
+                                       static_cast<const uint8_t*>(w_zp->DataRaw()),
+                                       is_W_signed,
+                                       W_scale_size);
+  QuantizationParameter quant_para_R_ZR_1(r_scale->Data<float>(),
+                                          static_cast<const uint8_t*>(r_zp->DataRaw()),
+                                          is_R_signed,
+                                          is_R_per_channel ? 2 * hidden_size : 1);
+  QuantizationParameter quant_para_R_H_1(r_scale->Data<float>() + R_H_scale_offset,
+                                         static_cast<const uint8_t*>(r_zp->DataRaw()) + R_H_scale_offset,
+                                         is_R_signed,
+                                         is_R_per_channel ? hidden_size : 1);
+
+  const uint8_t* W_data = W != nullptr ? static_cast<const uint8_t*>(W->DataRaw()) : nullptr;
+
+  // spans for first direction
+  const size_t W_size_per_direction = SafeInt<size_t>(W_shape[1]) * W_shape[2];
+  const size_t R_ZR_size_per_direction = 2 * hidden_size * hidden_size;
+  const size_t R_H_size_per_direction = hidden_size * hidden_size;
+
+  // The quantized GEMM reads unpacked weights with ldb == N, so R that could not be prepacked is split
+  // into contiguous [hidden_size, 2*hidden_size] ZR and [hidden_size, hidden_size] H weights.
+  IAllocatorUniquePtr<uint8_t> R_ZR_buffer;
+  IAllocatorUniquePtr<uint8_t> R_H_buffer;
+  const uint8_t* R_ZR_data = nullptr;
+  const uint8_t* R_H_data = nullptr;
+  if (R != nullptr) {
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+    R_ZR_buffer = IAllocator::MakeUniquePtr<uint8_t>(alloc, R_ZR_size_per_direction * num_directions_);
+    R_H_buffer = IAllocator::MakeUniquePtr<uint8_t>(alloc, R_H_size_per_direction * num_directions_);
+
+    const auto* R_src = static_cast<const uint8_t*>(R->DataRaw());
+    uint8_t* R_ZR_dst = R_ZR_buffer.get();
+    uint8_t* R_H_dst = R_H_buffer.get();
+    for (size_t row = 0; row < hidden_size * num_directions_; row++) {
+      std::copy_n(R_src, 2 * hidden_size, R_ZR_dst);
+      std::copy_n(R_src + 2 * hidden_size, hidden_size, R_H_dst);
+      R_src += 3 * hidden_size;
+      R_ZR_dst += 2 * hidden_size;
+      R_H_dst += hidden_size;
+    }
+
+    R_ZR_data = R_ZR_buffer.get();
+    R_H_data = R_H_buffer.get();
+  }
+
+  GemmWeights<uint8_t> W_1(0, W_data, W_size_per_direction, packed_W_, &quant_para_W_1);
+  GemmWeights<uint8_t> R_ZR_1(0, R_ZR_data, R_ZR_size_per_direction, packed_R_ZR_, &quant_para_R_ZR_1);
+  GemmWeights<uint8_t> R_H_1(0, R_H_data, R_H_size_per_direction, packed_R_H_, &quant_para_R_H_1);
+
+  GemmWeights<uint8_t> W_2;
+  GemmWeights<uint8_t> R_ZR_2;
+  GemmWeights<uint8_t> R_H_2;
+
+  QuantizationParameter quant_para_W_2(quant_para_W_1);
+  QuantizationParameter quant_para_R_ZR_2(quant_para_R_ZR_1);
+  QuantizationParameter quant_para_R_H_2(quant_para_R_H_1);
+
+  if (direction_ == Direction::kBidirectional) {
+    quant_para_W_2.scale += W_scale_size;
+    quant_para_R_ZR_2.scale += R_scale_size;
+    quant_para_R_H_2.scale += R_scale_size;
+
+    quant_para_W_2.zero_point += W_scale_size;     // zero_point and scale have same size
+    quant_para_R_ZR_2.zero_point += R_scale_size;  // zero_point and scale have same size
+    quant_para_R_H_2.zero_point += R_scale_size;   // zero_point and scale have same size
+
+    W_2.Init(1, W_data, W_size_per_direction, packed_W_, &quant_para_W_2);
+    R_ZR_2.Init(1, R_ZR_data, R_ZR_size_per_direction, packed_R_ZR_, &quant_para_R_ZR_2);
+    R_H_2.Init(1, R_H_data, R_H_size_per_direction, packed_R_H_, &quant_para_R_H_2);
+  }
+
+  return GRUBase::ComputeImpl<float, uint8_t>(*context, W_1, W_2, R_ZR_1, R_ZR_2, R_H_1, R_H_2);
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    DynamicQuantizeGRU,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int32_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()}),
+    DynamicQuantizeGRU);
+
+}  // namespace contrib
+}  // namespace onnxruntime
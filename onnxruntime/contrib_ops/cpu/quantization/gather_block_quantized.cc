@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 
@@ -10,6 +11,7 @@
 #include "core/framework/float16.h"
 #include "core/framework/int4.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 
@@ -29,6 +31,41 @@ int32_t GetDataElement<uint8_t>(const uint8_t* data_ptr, int64_t data_idx) {
   auto data_val = static_cast<int32_t>((data_idx & 1) ? ((data_val_u8 >> 4) & 0x0F) : (data_val_u8 & 0x0F));
   return data_val;
 }
+
+// 4-bit element stored in the low (index 0) or high (index 1) nibble of a byte
+template <typename T1>
+int32_t UnpackNibble(uint8_t packed, int index) {
+  const int32_t val = index ? (packed >> 4) : (packed & 0x0F);
+  if constexpr (std::is_same_v<T1, Int4x2>) {
+    return (val ^ 8) - 8;  // sign extend
+  } else {
+    return val;
+  }
+}
+
+// Dequantizes `count` consecutive 4-bit elements from `data_idx` that share one scale and zero point.
+// The packed pairs are unpacked a byte at a time in a loop the compiler vectorizes.
+template <typename T1>
+void DequantizeBlock(const T1* data_ptr, int64_t data_idx, int64_t count, float scale, int32_t zp, float* output) {
+  const auto* packed = reinterpret_cast<const uint8_t*>(data_ptr);
+  int64_t i = 0;
+  if (data_idx & 1) {
+    output[i++] = static_cast<float>(UnpackNibble<T1>(packed[data_idx >> 1], 1) - zp) * scale;
+  }
+
+  const uint8_t* pairs = packed + ((data_idx + i) >> 1);
+  const int64_t num_pairs = (count - i) / 2;
+  float* pair_output = output + i;
+  for (int64_t j = 0; j < num_pairs; ++j) {
+    pair_output[2 * j] = static_cast<float>(UnpackNibble<T1>(pairs[j], 0) - zp) * scale;
+    pair_output[2 * j + 1] = static_cast<float>(UnpackNibble<T1>(pairs[j], 1) - zp) * scale;
+  }
+
+  i += num_pairs * 2;
+  if (i < count) {
+    output[i] = static_cast<float>(UnpackNibble<T1>(pairs[num_pairs], 0) - zp) * scale;
+  }
+}
 }  // namespace
 
 template <typename T1, typename Tind>
@@ -163,7 +200,18 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
   auto quantize_full_block = quantize_axis_dim * quantize_N;
   auto scale_full_block = (quantize_axis_dim + block_size_ - 1) / block_size_ * quantize_N;
 
-  auto lambda = [&](int64_t gather_MN_idx, std::unordered_map<int64_t, int64_t>& cache) {
+  auto get_zero_point = [&](int64_t scale_idx) -> int32_t {
+    if constexpr (std::is_same_v<T1, uint8_t>) {
+      // The default zero point for uint8 weights as stored by MatMulNBits op is 8.
+      return 8;
+    } else {
+      return static_cast<int32_t>(zero_points_ptr
+                                      ? zero_points_ptr[scale_idx >> 1].GetElem(narrow<size_t>(scale_idx & 1))
+                                      : 0);
+    }
+  };
+
+  auto lambda = [&](int64_t gather_MN_idx, std::unordered_map<int64_t, int64_t>& cache, std::vector<float>& row) {
     int64_t gather_M_idx = gather_MN_idx / gather_N;
     int64_t gather_N_idx = gather_MN_idx % gather_N;
 
@@ -182,7 +230,36 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
       return;
     }
 
-    // TODO(fajin): use SIMD
+    if (quantize_N == 1) {
+      // the quantize axis is the last axis, so the block is made of runs of consecutive elements sharing a scale.
+      // float16 output is dequantized to float in `row` and converted once.
+      float* row_output = nullptr;
+      if constexpr (std::is_same_v<T2, float>) {
+        row_output = output_ptr + output_idx_base;
+      } else {
+        row.resize(narrow<size_t>(gather_block));
+        row_output = row.data();
+      }
+
+      for (int64_t i = 0; i < gather_block;) {
+        const int64_t data_idx = data_idx_base + i;
+        const int64_t x = data_idx / quantize_axis_dim;
+        const int64_t y = data_idx % quantize_axis_dim;
+        const int64_t scale_idx = x * scale_full_block + y / block_size_;
+        const int64_t count = std::min({block_size_ - y % block_size_, quantize_axis_dim - y, gather_block - i});
+        DequantizeBlock(data_ptr, data_idx, count, static_cast<float>(scales_ptr[scale_idx]), get_zero_point(scale_idx),
+                        row_output + i);
+        i += count;
+      }
+
+      if constexpr (!std::is_same_v<T2, float>) {
+        MlasConvertFloatToHalfBuffer(row_output, output_ptr + output_idx_base, narrow<size_t>(gather_block));
+      }
+
+      cache[data_idx_base] = output_idx_base;
+      return;
+    }
+
     int64_t output_idx = output_idx_base;
     int64_t data_idx = data_idx_base;
     for (int64_t i = 0; i < gather_block; ++i, ++output_idx, ++data_idx) {
@@ -193,15 +270,7 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
       int64_t z = data_idx % quantize_N;
       int64_t scale_idx = x * scale_full_block + y / block_size_ * quantize_N + z;
       auto scale_val = static_cast<float>(scales_ptr[scale_idx]);
-      int32_t zp_val;
-      if constexpr (std::is_same_v<T1, uint8_t>) {
-        // The default zero point for uint8 weights as stored by MatMulNBits op is 8.
-        zp_val = 8;
-      } else {
-        zp_val = static_cast<int32_t>(zero_points_ptr
-                                          ? zero_points_ptr[scale_idx >> 1].GetElem(narrow<size_t>(scale_idx & 1))
-                                          : 0);
-      }
+      int32_t zp_val = get_zero_point(scale_idx);
 
       output_ptr[output_idx] = static_cast<T2>(static_cast<float>(data_val - zp_val) * scale_val);
     }
@@ -217,11 +286,12 @@ Status GatherBlockQuantized<T1, Tind>::CopyDataAndDequantize(const T1* data_ptr,
         // cache dequantized gather_block. Key is data_idx_base. Value is the output_idx_base.
         // cache is per thread to avoid contention.
         std::unordered_map<int64_t, int64_t> cache;
+        std::vector<float> row;
 
         for (auto index = static_cast<int64_t>(first), end = static_cast<int64_t>(last);
              index < end;
              ++index) {
-          lambda(index, cache);
+          lambda(index, cache, row);
         }
       });
 
@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/quantization/qlinear_layer_norm.h"
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// Dequantizes the N elements of Scale or B, quantized per tensor or per element.
+template <typename Q>
+Status DequantizeWeight(const Tensor& weight, const Tensor& weight_scale, const Tensor* weight_zero_point,
+                        size_t N, const char* name, std::vector<float>& output) {
+  ORT_RETURN_IF_NOT(static_cast<size_t>(weight.Shape().Size()) == N,
+                    name, " must have as many elements as the normalized dimensions of X");
+  const size_t scale_size = static_cast<size_t>(weight_scale.Shape().Size());
+  ORT_RETURN_IF_NOT(scale_size == 1 || scale_size == N,
+                    name, "'s scale must be a scalar or have one element per element of ", name);
+  ORT_RETURN_IF_NOT(weight_zero_point == nullptr ||
+                        static_cast<size_t>(weight_zero_point->Shape().Size()) == scale_size,
+                    name, "'s zero point must have the shape of its scale");
+
+  const Q* data = weight.Data<Q>();
+  const float* scales = weight_scale.Data<float>();
+  const Q* zero_points = weight_zero_point != nullptr ? weight_zero_point->Data<Q>() : nullptr;
+
+  output.resize(N);
+  for (size_t i = 0; i < N; i++) {
+    const size_t q = scale_size == 1 ? 0 : i;
+    const int64_t zero_point = zero_points != nullptr ? static_cast<int64_t>(zero_points[q]) : 0;
+    output[i] = static_cast<float>(static_cast<int64_t>(data[i]) - zero_point) * scales[q];
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+QLinearLayerNormalization::QLinearLayerNormalization(const OpKernelInfo& info) : OpKernel(info) {
+  axis_ = info.GetAttrOrDefault<int64_t>("axis", -1);
+  epsilon_ = info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+}
+
+template <typename T>
+Status QLinearLayerNormalization::ComputeImpl(OpKernelContext* context, const Tensor& X,
+                                              gsl::span<const float> scale, gsl::span<const float> bias) const {
+  const Tensor* tensor_x_scale = context->Input<Tensor>(1);
+  const Tensor* tensor_x_zero_point = context->Input<Tensor>(2);
+  const Tensor* tensor_y_scale = context->Input<Tensor>(6);
+  const Tensor* tensor_y_zero_point = context->Input<Tensor>(7);
+
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(tensor_x_scale), "Input X_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(tensor_x_zero_point == nullptr || IsScalarOr1ElementVector(tensor_x_zero_point),
+                    "Input X_zero_point must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(tensor_y_scale), "Input Y_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(tensor_y_zero_point == nullptr || IsScalarOr1ElementVector(tensor_y_zero_point),
+                    "Input Y_zero_point must be a scalar or 1D tensor of size 1");
+
+  const float x_scale = *tensor_x_scale->Data<float>();
+  const T x_zero_point = tensor_x_zero_point != nullptr ? *tensor_x_zero_point->Data<T>() : T{};
+  const float y_scale = *tensor_y_scale->Data<float>();
+  const T y_zero_point = tensor_y_zero_point != nullptr ? *tensor_y_zero_point->Data<T>() : T{};
+
+  // The 8 bit inputs are dequantized with a lookup table.
+  std::array<float, 256> lookup_table;
+  for (int32_t i = 0; i < 256; i++) {
+    const T value = static_cast<T>(std::is_signed_v<T> ? i - 128 : i);
+    lookup_table[static_cast<uint8_t>(value)] =
+        static_cast<float>(static_cast<int32_t>(value) - static_cast<int32_t>(x_zero_point)) * x_scale;
+  }
+
+  const TensorShape& x_shape = X.Shape();
+  const size_t axis = onnxruntime::narrow<size_t>(HandleNegativeAxis(axis_, x_shape.NumDimensions()));
+  const size_t M = onnxruntime::narrow<size_t>(x_shape.SizeToDimension(axis));
+  const size_t N = onnxruntime::narrow<size_t>(x_shape.SizeFromDimension(axis));
+
+  Tensor* Y = context->Output(0, x_shape);
+  if (M == 0 || N == 0) {
+    return Status::OK();
+  }
+
+  const T* x_data = X.Data<T>();
+  T* y_data = Y->MutableData<T>();
+  const float* bias_data = bias.empty() ? nullptr : bias.data();
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(M),
+      TensorOpCost{static_cast<double>(N), static_cast<double>(N), 8.0 * N},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> row(N);
+        for (std::ptrdiff_t m = first; m < last; m++) {
+          const T* x_row = x_data + static_cast<size_t>(m) * N;
+          for (size_t i = 0; i < N; i++) {
+            row[i] = lookup_table[static_cast<uint8_t>(x_row[i])];
+          }
+
+          MlasLayerNormOneRow<float>(row.data(), nullptr, nullptr, scale.data(), bias_data, N, epsilon_, false,
+                                     row.data(), nullptr, nullptr, nullptr);
+
+          MlasQuantizeLinear(row.data(), y_data + static_cast<size_t>(m) * N, N, y_scale, y_zero_point);
+        }
+      });
+
+  return Status::OK();
+}
+
+Status QLinearLayerNormalization::Compute(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);
+  const Tensor& scale = *context->Input<Tensor>(3);
+  const Tensor& scale_scale = *context->Input<Tensor>(4);
+  const Tensor* scale_zero_point = context->Input<Tensor>(5);
+  const Tensor* B = context->Input<Tensor>(8);
+  const Tensor* B_scale = context->Input<Tensor>(9);
+
+  const TensorShape& x_shape = X.Shape();
+  const int64_t axis = HandleNegativeAxis(axis_, x_shape.NumDimensions());
+  const size_t N = onnxruntime::narrow<size_t>(x_shape.SizeFromDimension(onnxruntime::narrow<size_t>(axis)));
+
+  // Scale and B are small, they are dequantized to fp32 once per run.
+  std::vector<float> scale_fp32;
+  if (scale.IsDataType<int8_t>()) {
+    ORT_RETURN_IF_ERROR(DequantizeWeight<int8_t>(scale, scale_scale, scale_zero_point, N, "Scale", scale_fp32));
+  } else {
+    ORT_RETURN_IF_ERROR(DequantizeWeight<uint8_t>(scale, scale_scale, scale_zero_point, N, "Scale", scale_fp32));
+  }
+
+  std::vector<float> bias_fp32;
+  if (B != nullptr) {
+    ORT_RETURN_IF_NOT(B_scale != nullptr, "B_scale is required when B is specified");
+    ORT_RETURN_IF_ERROR(DequantizeWeight<int32_t>(*B, *B_scale, nullptr, N, "B", bias_fp32));
+  }
+
+  if (X.IsDataType<int8_t>()) {
+    return ComputeImpl<int8_t>(context, X, scale_fp32, bias_fp32);
+  }
+  return ComputeImpl<uint8_t>(context, X, scale_fp32, bias_fp32);
+}
+
+ONNX_CPU_OPERATOR_MS_KERNEL(
+    QLinearLayerNormalization,
+    1,
+    KernelDefBuilder()
+        .TypeConstraint("T", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()}),
+    QLinearLayerNormalization)
+
+}  // namespace contrib
+}  // namespace onnxruntime
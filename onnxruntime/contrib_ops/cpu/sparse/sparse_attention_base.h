@@ -225,28 +225,70 @@ class SparseAttentionBase {
         DUMP_CPU_TENSOR("Q", q, sequence_length, head_size);
         DUMP_CPU_TENSOR("K", k, total_seq_len, head_size);
 
-        if constexpr (std::is_same<T, float>::value) {
-          math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_seq_len, head_size, alpha, q,
-                                      head_size, k, head_size, 0.0f /*bata*/, output, total_seq_len,
-                                      nullptr);
-        } else if constexpr (std::is_same<U, MLFloat16>::value) {
-          MlasGemm(CblasNoTrans, CblasTrans, sequence_length, total_seq_len, head_size,
-                   q, head_size, k, head_size, output, total_seq_len,
-                   MLFloat16(alpha).val, static_cast<uint16_t>(0) /*beta*/, nullptr);
-        } else {
+        // The fp16 inputs are converted to fp32 when the probabilities are computed in fp32.
+        BufferUniquePtr q_k_fp32_buffer;
+        float* q_fp32 = nullptr;
+        float* k_fp32 = nullptr;
+        if constexpr (!std::is_same<T, float>::value && !std::is_same<U, MLFloat16>::value) {
           size_t bytes = static_cast<size_t>(head_size) * (sequence_length + total_seq_len) * sizeof(float);
-          auto q_k_fp32 = allocator->Alloc(bytes);
-          BufferUniquePtr scratch_buffer(q_k_fp32, BufferDeleter(allocator));
+          void* q_k_fp32 = allocator->Alloc(bytes);
+          q_k_fp32_buffer = BufferUniquePtr(q_k_fp32, BufferDeleter(allocator));
 
-          float* q_fp32 = static_cast<float*>(q_k_fp32);
+          q_fp32 = static_cast<float*>(q_k_fp32);
           MlasConvertHalfToFloatBuffer(q, q_fp32, static_cast<size_t>(head_size) * sequence_length);
 
-          float* k_fp32 = q_fp32 + head_size * sequence_length;
+          k_fp32 = q_fp32 + head_size * sequence_length;
           MlasConvertHalfToFloatBuffer(k, k_fp32, static_cast<size_t>(head_size) * total_seq_len);
+        }
+
+        // Compute rows [row, row + rows) and columns [col, col + cols) of the S x T output of Q*K'.
+        auto compute_qk = [&](int row, int rows, int col, int cols) {
+          U* c = output + SafeInt<ptrdiff_t>(row) * total_seq_len + col;
+          const size_t q_offset = static_cast<size_t>(row) * head_size;
+          const size_t k_offset = static_cast<size_t>(col) * head_size;
+          if constexpr (std::is_same<T, float>::value) {
+            math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasTrans, rows, cols, head_size, alpha, q + q_offset,
+                                        head_size, k + k_offset, head_size, 0.0f /*bata*/, c, total_seq_len,
+                                        nullptr);
+          } else if constexpr (std::is_same<U, MLFloat16>::value) {
+            MlasGemm(CblasNoTrans, CblasTrans, rows, cols, head_size,
+                     q + q_offset, head_size, k + k_offset, head_size, c, total_seq_len,
+                     MLFloat16(alpha).val, static_cast<uint16_t>(0) /*beta*/, nullptr);
+          } else {
+            math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, rows, cols, head_size,
+                                            alpha, q_fp32 + q_offset, head_size, k_fp32 + k_offset, head_size,
+                                            0.0f /*bata*/, c, total_seq_len, nullptr);
+          }
+        };
 
-          math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_seq_len, head_size,
-                                          alpha, q_fp32, head_size, k_fp32, head_size, 0.0f /*bata*/,
-                                          output, total_seq_len, nullptr);
+        int layout_id = head_index % parameters.num_sparse_layout;
+        bool is_sparse_layout = layout_has_sparse[layout_id];
+        const int32_t* layout_row_indices = block_row_indices + layout_id * parameters.stride_row_indices;
+        const int32_t* layout_col_indices = block_col_indices + layout_id * parameters.stride_col_indices;
+
+        if (!is_sparse_layout) {
+          compute_qk(0, sequence_length, 0, total_seq_len);
+        } else {
+          // Only compute the nonzero blocks of the layout, one GEMM per block for the query rows in the same block row.
+          // The other causal positions are masked before softmax below.
+          const int sparse_block_size = parameters.sparse_block_size;
+          int q_id = 0;
+          while (q_id < sequence_length) {
+            int q_abs_position = past_seq_len + q_id;
+            int row_in_sparse_layout = q_abs_position / sparse_block_size;
+            int rows = std::min((row_in_sparse_layout + 1) * sparse_block_size - q_abs_position,
+                                sequence_length - q_id);
+            int causal_length = q_abs_position + rows;
+            for (int j = layout_row_indices[row_in_sparse_layout]; j < layout_row_indices[row_in_sparse_layout + 1];
+                 j++) {
+              int col = layout_col_indices[j] * sparse_block_size;
+              int cols = std::min(sparse_block_size, causal_length - col);
+              if (cols > 0) {
+                compute_qk(q_id, rows, col, cols);
+              }
+            }
+            q_id += rows;
+          }
         }
 
         DUMP_CPU_TENSOR("QK", output, sequence_length, total_seq_len);
@@ -254,9 +296,6 @@ class SparseAttentionBase {
         // Compute Softmax for causal and output result in place.
         U* output_softmax = output;
 
-        int layout_id = head_index % parameters.num_sparse_layout;
-        bool is_sparse_layout = layout_has_sparse[layout_id];
-
         DUMP_CPU_STRING("layout_id=", layout_id, ",is_sparse_layout=", is_sparse_layout);
 
         if (!is_sparse_layout) {  // dense
@@ -277,8 +316,6 @@ class SparseAttentionBase {
           bool has_sparse = false;
           std::vector<int32_t> mask(parameters.max_sequence_length);
 
-          const int32_t* layout_row_indices = block_row_indices + layout_id * parameters.stride_row_indices;
-          const int32_t* layout_col_indices = block_col_indices + layout_id * parameters.stride_col_indices;
           do {
             int q_abs_position = past_seq_len + q_id;
             int causal_length = q_abs_position + 1;
@@ -64,6 +64,7 @@ struct BeamSearchScorer : IBeamScorer {
   void OutputScores(gsl::span<const float>& final_scores, Tensor* output_scores) override;
 
   bool IsDone() const override { return not_done_count_ == 0; }
+  bool IsBatchDone(size_t batch) const override { return beam_hyps_[batch].done_; }
 
   gsl::span<float> GetNextScores() override { return next_beam_scores_; }
   gsl::span<int32_t> GetNextTokens() override { return next_beam_tokens_; }
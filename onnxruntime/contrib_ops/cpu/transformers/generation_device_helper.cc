@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include "core/providers/cpu/math/top_k.h"
 #include "core/providers/cpu/math/softmax_shared.h"
@@ -337,14 +338,42 @@ Status ProcessLogits(const OrtValue& logits,                                 //
 
   // Get scores for candidates of next token: next_token_scores = log_softmax(next_token_logits, dim=-1)
   gsl::span<T>& next_token_scores = beam_state->next_token_scores;
-  ORT_RETURN_IF_ERROR(
-      SoftmaxCPU<T>(
-          batch_beam_size,  // rows
-          vocab_size,       // elements per row
-          (input_length == 1 && logits_batch_size == batch_beam_size) ? logits_data : next_token_logits.data(),
-          next_token_scores.data(),
-          true,
-          thread_pool));
+  const T* softmax_input = (input_length == 1 && logits_batch_size == batch_beam_size) ? logits_data
+                                                                                      : next_token_logits.data();
+
+  // The scorer pads the batch entries that are done without reading their scores, so the softmax of their rows is
+  // skipped unless the scores are output. The rows of the other entries are processed in contiguous runs.
+  if (!output_scores) {
+    for (int batch = 0; batch < batch_size;) {
+      if (beam_scorer->IsBatchDone(static_cast<size_t>(batch))) {
+        ++batch;
+        continue;
+      }
+      int end = batch + 1;
+      while (end < batch_size && !beam_scorer->IsBatchDone(static_cast<size_t>(end))) {
+        ++end;
+      }
+      const size_t offset = SafeInt<size_t>(batch) * num_beams * vocab_size;
+      ORT_RETURN_IF_ERROR(
+          SoftmaxCPU<T>(
+              (end - batch) * num_beams,  // rows
+              vocab_size,                 // elements per row
+              softmax_input + offset,
+              next_token_scores.data() + offset,
+              true,
+              thread_pool));
+      batch = end;
+    }
+  } else {
+    ORT_RETURN_IF_ERROR(
+        SoftmaxCPU<T>(
+            batch_beam_size,  // rows
+            vocab_size,       // elements per row
+            softmax_input,
+            next_token_scores.data(),
+            true,
+            thread_pool));
+  }
 
 #ifdef DEBUG_GENERATION
   dumper->Print("next_token_scores after softmax", next_token_scores.data(), batch_size, num_beams, vocab_size);
@@ -555,7 +584,55 @@ Status DeviceCopy(gsl::span<T> target, gsl::span<const T> source, Stream* /*stre
   return Status::OK();
 }
 
+// Reorders beams in place so that beam j holds what beam beam_indices[j] held. Only beams that change are copied,
+// and a beam that is overwritten is saved first if another beam picks it.
+template <typename T>
+void PickBeamsInPlace(gsl::span<T> beams, size_t beam_size, gsl::span<const int32_t> beam_indices,
+                      AllocatorPtr allocator) {
+  const size_t num_beams = beam_indices.size();
+  InlinedVector<bool> picked_by_other(num_beams, false);
+  for (size_t j = 0; j < num_beams; j++) {
+    if (static_cast<size_t>(beam_indices[j]) != j) {
+      picked_by_other[beam_indices[j]] = true;
+    }
+  }
+
+  constexpr size_t not_saved = std::numeric_limits<size_t>::max();
+  InlinedVector<size_t> saved_index(num_beams, not_saved);
+  size_t num_saved = 0;
+  for (size_t j = 0; j < num_beams; j++) {
+    if (picked_by_other[j] && static_cast<size_t>(beam_indices[j]) != j) {
+      saved_index[j] = num_saved++;
+    }
+  }
+
+  IAllocatorUniquePtr<T> saved;
+  if (num_saved > 0) {
+    saved = IAllocator::MakeUniquePtr<T>(allocator, SafeInt<size_t>(num_saved) * beam_size);
+  }
+  gsl::span<T> saved_span = gsl::make_span<T>(saved.get(), saved ? num_saved * beam_size : 0);
+  for (size_t j = 0; j < num_beams; j++) {
+    if (saved_index[j] != not_saved) {
+      gsl::copy(beams.subspan(j * beam_size, beam_size), saved_span.subspan(saved_index[j] * beam_size, beam_size));
+    }
+  }
+
+  for (size_t j = 0; j < num_beams; j++) {
+    const size_t beam_index = static_cast<size_t>(beam_indices[j]);
+    if (beam_index == j) {
+      continue;
+    }
+
+    gsl::span<const T> source = saved_index[beam_index] != not_saved
+                                    ? saved_span.subspan(saved_index[beam_index] * beam_size, beam_size)
+                                    : beams.subspan(beam_index * beam_size, beam_size);
+    gsl::copy(source, beams.subspan(j * beam_size, beam_size));
+  }
+}
+
 // Copy present state to past state for GPT model
+// The present state is not used after this, so the beams are reordered in its buffer instead of copying all of them
+// to a new tensor. Beams that keep their parent, including all of them when no beam is reordered, are not copied.
 template <typename T>
 void PickGptPastState(const std::vector<OrtValue>& last_outputs,
                       std::vector<OrtValue>& next_inputs,
@@ -565,32 +642,18 @@ void PickGptPastState(const std::vector<OrtValue>& last_outputs,
                       AllocatorPtr allocator) {
   int num_present_tensors = static_cast<int>(last_outputs.size()) - gpt_subgraph_first_present_output_idx;
   for (ptrdiff_t i = 0; i < num_present_tensors; ++i) {
-    const OrtValue& present = last_outputs[gpt_subgraph_first_present_output_idx + i];
+    // shares the buffer of the present state
+    OrtValue past = last_outputs[gpt_subgraph_first_present_output_idx + i];
 
     // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
-    const TensorShape& past_shape = present.Get<Tensor>().Shape();
-    auto block_size_per_beam = past_shape[2] * past_shape[3] * past_shape[4];
-    auto past_key_size = past_shape[1] * past_shape[2] * past_shape[3] * past_shape[4];
-
-    // Create a tensor with same shape.
-    // TODO(tianleiwu): allocate one buffer for all layers
-    OrtValue past;
-    auto past_type = DataTypeImpl::GetType<T>();
-    Tensor::InitOrtValue(past_type, past_shape, allocator, past);
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    for (size_t j = 0; j < beam_indices.size(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_key = present_span.subspan(beam_index * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<const T> present_value = present_span.subspan(past_key_size + beam_index * SafeInt<size_t>(block_size_per_beam),
-                                                              onnxruntime::narrow<size_t>(block_size_per_beam));
-
-      gsl::span<T> past_key = past_span.subspan(j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<T> past_value = past_span.subspan(past_key_size + j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::copy(present_key, past_key);
-      gsl::copy(present_value, past_value);
-    }
+    const TensorShape& past_shape = past.Get<Tensor>().Shape();
+    const size_t block_size_per_beam = onnxruntime::narrow<size_t>(past_shape[2] * past_shape[3] * past_shape[4]);
+    const size_t past_key_size = onnxruntime::narrow<size_t>(past_shape[1]) * block_size_per_beam;
+
+    gsl::span<T> past_span = past.GetMutable<Tensor>()->MutableDataAsSpan<T>();
+    PickBeamsInPlace<T>(past_span.subspan(0, past_key_size), block_size_per_beam, beam_indices, allocator);
+    PickBeamsInPlace<T>(past_span.subspan(past_key_size, past_key_size), block_size_per_beam, beam_indices,
+                        allocator);
 
     next_inputs[gpt_subgraph_first_past_input_idx + i] = past;
   }
@@ -127,6 +127,7 @@ struct IBeamScorer {
 
   virtual bool IsDone() const = 0;                    // GPU version will return false here, as it asynchronously queues up the event
   virtual bool IsDoneLater() const { return false; }  // GPU version waits for the asynchous result to complete here
+  virtual bool IsBatchDone(size_t /*batch*/) const { return false; }  // Only the CPU version tracks it on the host
 
   virtual gsl::span<float> GetNextScores() = 0;
   virtual gsl::span<int32_t> GetNextTokens() = 0;
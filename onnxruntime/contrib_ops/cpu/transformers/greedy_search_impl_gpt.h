@@ -21,6 +21,34 @@ std::pair<Status, std::unique_ptr<GptSubgraph>> CreateGptSubgraphAndUpdateParame
     const std::string& attribute_name,
     const SessionState& subgraph_session_state,
     /*out*/ BeamSearchParameters& parameters);
+
+// Keep the first past_sequence_length entries of the past state of each layer,
+// which has shape (2, batch_size, num_heads, past_sequence_length, head_size).
+template <typename T>
+Status TruncatePastState(std::vector<OrtValue>& past, int past_sequence_length, AllocatorPtr allocator) {
+  for (OrtValue& value : past) {
+    const Tensor& tensor = value.Get<Tensor>();
+    const auto dims = tensor.Shape().GetDims();
+    ORT_RETURN_IF_NOT(dims.size() == 5 && dims[3] >= past_sequence_length,
+                      "Past state shall have 5 dimensions and at least ", past_sequence_length, " entries");
+    if (dims[3] == past_sequence_length) {
+      continue;
+    }
+
+    OrtValue truncated;
+    Tensor::InitOrtValue(tensor.DataType(), TensorShape({dims[0], dims[1], dims[2], past_sequence_length, dims[4]}),
+                         allocator, truncated);
+    const T* source = tensor.Data<T>();
+    T* target = truncated.GetMutable<Tensor>()->MutableData<T>();
+    const size_t source_stride = SafeInt<size_t>(dims[3]) * dims[4];
+    const size_t target_stride = SafeInt<size_t>(past_sequence_length) * dims[4];
+    for (int64_t i = 0; i < dims[0] * dims[1] * dims[2]; ++i) {
+      std::copy_n(source + i * source_stride, target_stride, target + i * target_stride);
+    }
+    value = std::move(truncated);
+  }
+  return Status::OK();
+}
 }  // namespace gpt_details
 
 // Greedy search implementation for GPT-2 model.
@@ -79,6 +107,28 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
   }
 #endif
 
+  // Enable speculative decoding: each step the draft decoder proposes up to num_speculative_tokens tokens, and the
+  // decoder verifies them with a single run.
+  Status InitializeSpeculative(const SessionState* draft_decoder_session_state,
+                               GptSubgraph* draft_gpt_subgraph,
+                               const FeedsFetchesManager* draft_feeds_fetches_manager) {
+    ORT_RETURN_IF(this->IsCuda(), "Speculative decoding with a draft decoder is only supported on CPU");
+    ORT_RETURN_IF((std::is_same<ParametersT, SamplingParameters>::value),
+                  "Speculative decoding with a draft decoder does not support sampling");
+    ORT_RETURN_IF_NOT(this->parameters_->batch_size == 1,
+                      "Speculative decoding with a draft decoder supports batch_size 1 only, got ",
+                      this->parameters_->batch_size);
+    ORT_RETURN_IF(gpt_subgraph_.past_present_share_buffer_ || draft_gpt_subgraph->past_present_share_buffer_,
+                  "Speculative decoding does not support past_present_share_buffer in the decoder subgraphs");
+    ORT_RETURN_IF_NOT(draft_gpt_subgraph->vocab_size == gpt_subgraph_.vocab_size &&
+                          draft_gpt_subgraph->IsOutputFloat16() == gpt_subgraph_.IsOutputFloat16(),
+                      "draft_decoder shall have the same vocabulary size and logits type as decoder");
+    draft_decoder_session_state_ = draft_decoder_session_state;
+    draft_gpt_subgraph_ = draft_gpt_subgraph;
+    draft_feeds_fetches_manager_ = draft_feeds_fetches_manager;
+    return Status::OK();
+  }
+
   // Execute beam search in iterations util stopping criteria is reached.
   // In each iteration, GPT subgraph is called, and next token for each sequence is generated.
   Status Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
@@ -101,10 +151,29 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
       gsl::span<const int32_t> next_tokens,
       int past_sequence_length);
 
+  // Greedy search where the tokens proposed by the draft decoder are verified by the decoder.
+  Status ExecuteSpeculative(const FeedsFetchesManager* init_run_feeds_fetches_manager,
+                            const FeedsFetchesManager& feeds_fetches_manager);
+
+  // Run a GPT subgraph of batch size 1 on the given inputs.
+  // past holds the past state of each layer, or is empty for the first run, and is replaced by the present state.
+  Status RunSpeculativeSubgraph(const SessionState& session_state,
+                                const FeedsFetchesManager& feeds_fetches_manager,
+                                const GptSubgraph& subgraph,
+                                const OrtValue& input_ids,
+                                const OrtValue& position_ids,
+                                const OrtValue& attention_mask,
+                                std::vector<OrtValue>& past,
+                                OrtValue& logits);
+
   const SessionState* init_run_decoder_session_state_ = nullptr;
   GptSubgraph* init_run_gpt_subgraph_ = nullptr;
   GptSubgraph& gpt_subgraph_;
 
+  const SessionState* draft_decoder_session_state_ = nullptr;
+  GptSubgraph* draft_gpt_subgraph_ = nullptr;
+  const FeedsFetchesManager* draft_feeds_fetches_manager_ = nullptr;
+
   // Device specific functions
   GenerationDeviceHelper::CreateGptInputsFunc create_inputs_func_;
   GenerationDeviceHelper::AddToFeedsFunc add_to_feeds_func_;
@@ -190,6 +259,10 @@ Status GreedySearchGpt<T, ParametersT>::UpdateFeeds(
 template <typename T, typename ParametersT>
 Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
                                                 const FeedsFetchesManager& feeds_fetches_manager) {
+  if (draft_gpt_subgraph_ != nullptr) {
+    return ExecuteSpeculative(init_run_feeds_fetches_manager, feeds_fetches_manager);
+  }
+
   auto status = Status::OK();
   const ParametersT* parameters = this->parameters_;
 
@@ -410,6 +483,232 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
   return status;
 }
 
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::RunSpeculativeSubgraph(const SessionState& session_state,
+                                                               const FeedsFetchesManager& feeds_fetches_manager,
+                                                               const GptSubgraph& subgraph,
+                                                               const OrtValue& input_ids,
+                                                               const OrtValue& position_ids,
+                                                               const OrtValue& attention_mask,
+                                                               std::vector<OrtValue>& past,
+                                                               OrtValue& logits) {
+  if (past.empty()) {
+    TensorShape past_shape{2, 1, subgraph.num_heads, 0, subgraph.head_size};
+    OrtValue empty_past;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), past_shape, this->temp_space_allocator_, empty_past);
+    past.assign(static_cast<size_t>(subgraph.num_layers), empty_past);
+  }
+
+  std::vector<OrtValue> feeds;
+  feeds.reserve(static_cast<size_t>(subgraph.num_subgraph_inputs) + static_cast<size_t>(subgraph.num_implicit_inputs));
+  feeds.push_back(input_ids);
+  feeds.push_back(position_ids);
+  feeds.push_back(attention_mask);
+  feeds.insert(feeds.end(), past.begin(), past.end());
+  for (size_t i = 0; i < this->implicit_inputs_.size(); ++i) {
+    if (subgraph.used_implicit_inputs[i]) {
+      feeds.push_back(*this->implicit_inputs_[i]);
+    }
+  }
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(utils::ExecuteSubgraph(session_state,
+                                             feeds_fetches_manager,
+                                             feeds,
+                                             fetches,
+                                             {},
+                                             ExecutionMode::ORT_SEQUENTIAL,
+                                             this->context_.GetTerminateFlag(),
+                                             this->context_.Logger(),
+                                             this->ort_stream_));
+
+  logits = fetches[0];
+  past.assign(fetches.begin() + subgraph.GetFirstPresentOutputIndex(), fetches.end());
+  return Status::OK();
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::ExecuteSpeculative(const FeedsFetchesManager* init_run_feeds_fetches_manager,
+                                                           const FeedsFetchesManager& feeds_fetches_manager) {
+  const ParametersT* parameters = this->parameters_;
+  const int sequence_length = parameters->sequence_length;
+  const int max_length = parameters->max_length;
+  const int vocab_size = parameters->vocab_size;
+
+  int64_t sequences_dims[] = {parameters->batch_size, max_length};
+  TensorShape sequences_shape(&sequences_dims[0], sizeof(sequences_dims) / sizeof(sequences_dims[0]));
+  Tensor* output_sequences = this->context_.Output(0, sequences_shape);
+
+  GreedySearchState<T> greedy_state;
+  greedy_state.Init(this->cpu_allocator_,
+                    this->temp_space_allocator_,
+                    static_cast<int>(parameters->BatchBeamSize()),
+                    static_cast<int>(parameters->vocab_size),
+                    static_cast<int>(parameters->sequence_length),
+                    static_cast<int>(parameters->max_length),
+                    static_cast<int>(parameters->num_heads),
+                    static_cast<int>(parameters->head_size),
+                    gpt_subgraph_.has_decoder_masked_attention_,
+                    this->IsCuda(),
+                    this->ort_stream_);
+  SamplingState<T> sampling_state;
+
+  std::vector<OrtValue> feeds;
+  IAllocatorUniquePtr<char> buffer;
+  OrtValue expanded_input_ids_in_cpu;
+  ORT_RETURN_IF_ERROR(CreateInitialFeeds(greedy_state.sequence_lengths, expanded_input_ids_in_cpu, feeds, buffer));
+
+  init_greedy_state_func_(&greedy_state,
+                          greedy_state.sequence_lengths,
+                          this->ort_stream_);
+
+  greedy_state.SetSequence(expanded_input_ids_in_cpu.Get<Tensor>().DataAsSpan<int32_t>(),
+                           static_cast<size_t>(parameters->BatchBeamSize()),
+                           max_length,
+                           sequence_length);
+
+  // Generated tokens continue the positions of the prompt, and are never masked.
+  const int32_t first_position = feeds[1].Get<Tensor>().Data<int32_t>()[sequence_length - 1] + 1;
+  std::vector<int32_t> attention_mask(max_length, 1);
+  std::copy_n(feeds[2].Get<Tensor>().Data<int32_t>(), sequence_length, attention_mask.begin());
+
+  // Create the inputs to run tokens that start at the given index of the sequence.
+  auto create_inputs = [&](gsl::span<const int32_t> tokens, int start,
+                           OrtValue& input_ids, OrtValue& position_ids, OrtValue& mask) {
+    const int64_t count = static_cast<int64_t>(tokens.size());
+    auto int32_type = DataTypeImpl::GetType<int32_t>();
+    Tensor::InitOrtValue(int32_type, TensorShape({1, count}), this->cpu_allocator_, input_ids);
+    Tensor::InitOrtValue(int32_type, TensorShape({1, count}), this->cpu_allocator_, position_ids);
+    Tensor::InitOrtValue(int32_type, TensorShape({1, start + count}), this->cpu_allocator_, mask);
+    int32_t* ids = input_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+    int32_t* positions = position_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+    for (int64_t i = 0; i < count; ++i) {
+      ids[i] = tokens[i];
+      positions[i] = static_cast<int32_t>(first_position + start + i - sequence_length);
+    }
+    std::copy_n(attention_mask.begin(), start + count, mask.GetMutable<Tensor>()->MutableData<int32_t>());
+  };
+
+  // The decoder (or init_decoder) runs the prompt as usual.
+  std::vector<OrtValue> fetches;
+  const bool use_init_decoder = init_run_decoder_session_state_ != nullptr;
+  ORT_RETURN_IF_ERROR(utils::ExecuteSubgraph(use_init_decoder ? *init_run_decoder_session_state_
+                                                              : this->decoder_session_state_,
+                                             use_init_decoder ? *init_run_feeds_fetches_manager
+                                                              : feeds_fetches_manager,
+                                             feeds,
+                                             fetches,
+                                             {},
+                                             ExecutionMode::ORT_SEQUENTIAL,
+                                             this->context_.GetTerminateFlag(),
+                                             this->context_.Logger(),
+                                             this->ort_stream_));
+
+  int iteration_counter = 0;
+  gsl::span<int32_t> next_tokens;
+  ORT_RETURN_IF_ERROR(this->GenerateNextToken(fetches[0], next_tokens, greedy_state, sampling_state,
+                                              ++iteration_counter, parameters->eos_token_id));
+  std::vector<OrtValue> past(fetches.begin() + gpt_subgraph_.GetFirstPresentOutputIndex(), fetches.end());
+  fetches.clear();
+
+  bool finished = greedy_state.eos_meet[0];
+  int current_length = finished ? sequence_length : sequence_length + 1;
+
+  // The draft decoder keeps its own past state, which covers the first draft_past_length tokens of the sequence.
+  std::vector<OrtValue> draft_past;
+  OrtValue draft_logits;
+  int draft_past_length = 0;
+  if (!finished && current_length < max_length) {
+    ORT_RETURN_IF_ERROR(RunSpeculativeSubgraph(*draft_decoder_session_state_, *draft_feeds_fetches_manager_,
+                                               *draft_gpt_subgraph_, feeds[0], feeds[1], feeds[2],
+                                               draft_past, draft_logits));
+    draft_past_length = sequence_length;
+  }
+
+  std::vector<int32_t> tokens;
+  std::vector<int32_t> drafts;
+  while (!finished && current_length < max_length) {
+    gsl::span<const int32_t> sequence = greedy_state.sequences.GetSequence(0);
+    const int32_t last_token = sequence[current_length - 1];
+
+    // Propose tokens with the draft decoder, leaving room for the token the decoder generates after them.
+    const int max_drafts = std::min(parameters->num_speculative_tokens, max_length - current_length - 1);
+    tokens.assign(sequence.begin() + draft_past_length, sequence.begin() + current_length);
+    drafts.clear();
+    while (static_cast<int>(drafts.size()) < max_drafts) {
+      OrtValue input_ids;
+      OrtValue position_ids;
+      OrtValue mask;
+      create_inputs(tokens, draft_past_length, input_ids, position_ids, mask);
+      ORT_RETURN_IF_ERROR(RunSpeculativeSubgraph(*draft_decoder_session_state_, *draft_feeds_fetches_manager_,
+                                                 *draft_gpt_subgraph_, input_ids, position_ids, mask,
+                                                 draft_past, draft_logits));
+      draft_past_length += static_cast<int>(tokens.size());
+
+      const T* last_logits = draft_logits.Get<Tensor>().Data<T>() + (tokens.size() - 1) * vocab_size;
+      const T* max_logit = std::max_element(last_logits, last_logits + vocab_size,
+                                            [](const T& a, const T& b) {
+                                              return static_cast<float>(a) < static_cast<float>(b);
+                                            });
+      drafts.push_back(static_cast<int32_t>(max_logit - last_logits));
+      if (drafts.back() == parameters->eos_token_id) {
+        break;
+      }
+      tokens.assign(1, drafts.back());
+    }
+
+    // Run the last token and the drafts with the decoder in one run.
+    const int past_length = current_length - 1;
+    tokens.assign(1, last_token);
+    tokens.insert(tokens.end(), drafts.begin(), drafts.end());
+    OrtValue input_ids;
+    OrtValue position_ids;
+    OrtValue mask;
+    OrtValue logits;
+    create_inputs(tokens, past_length, input_ids, position_ids, mask);
+    ORT_RETURN_IF_ERROR(RunSpeculativeSubgraph(this->decoder_session_state_, feeds_fetches_manager, gpt_subgraph_,
+                                               input_ids, position_ids, mask, past, logits));
+
+    // Generate tokens from the logits of each position as if they were generated one at a time,
+    // and stop at the first one that differs from the draft.
+    const Tensor& logits_tensor = logits.Get<Tensor>();
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      OrtValue position_logits;
+      Tensor::InitOrtValue(logits_tensor.DataType(), TensorShape({1, 1, vocab_size}),
+                           const_cast<T*>(logits_tensor.Data<T>() + i * vocab_size),
+                           logits_tensor.Location(), position_logits);
+      ORT_RETURN_IF_ERROR(this->GenerateNextToken(position_logits, next_tokens, greedy_state, sampling_state,
+                                                  ++iteration_counter, parameters->eos_token_id));
+      if (greedy_state.eos_meet[0]) {
+        finished = true;
+        break;
+      }
+
+      ++current_length;
+      if (i == drafts.size() || next_tokens[0] != drafts[i]) {
+        break;
+      }
+    }
+
+    if (!finished) {
+      // Drop the past state of the rejected drafts. The last generated token is run in the next iteration.
+      ORT_RETURN_IF_ERROR(gpt_details::TruncatePastState<T>(past, current_length - 1, this->temp_space_allocator_));
+      if (draft_past_length > current_length - 1) {
+        draft_past_length = current_length - 1;
+        ORT_RETURN_IF_ERROR(gpt_details::TruncatePastState<T>(draft_past, draft_past_length,
+                                                              this->temp_space_allocator_));
+      }
+    }
+  }
+
+  // Copy the sequences to output
+  gsl::span<int32_t> output = output_sequences->MutableDataAsSpan<int32_t>();
+  gsl::span<const int32_t> sequence_source = greedy_state.sequences.GetSequence(0);
+  gsl::copy(sequence_source, output.subspan(0, max_length));
+
+  return Status::OK();
+}
+
 }  // namespace transformers
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -37,24 +37,30 @@ RepetitionPenaltyLogitsProcessor<T>::RepetitionPenaltyLogitsProcessor(float pena
 template <typename T>
 void RepetitionPenaltyLogitsProcessor<T>::Process(const ISequences* sequences,
                                                   NextTokenScores<T>& next_token_scores) {
+  is_penalized_.resize(static_cast<size_t>(next_token_scores.vocab_size));
+
   const int batch_beam_size = next_token_scores.batch_beam_size;
   for (int i = 0; i < batch_beam_size; i++) {
     gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
     gsl::span<const int32_t> sequence = sequences->GetSequence(i);
 
-    // Find unique word IDs in sequence.
-    std::unordered_set<int32_t> unique_word_ids;
-    for (const auto& word_id : sequence) {
-      unique_word_ids.insert(word_id);
-    }
+    // Penalize each unique word ID in sequence once.
+    for (const int32_t word_id : sequence) {
+      if (is_penalized_[word_id]) {
+        continue;
+      }
 
-    for (const int32_t word_id : unique_word_ids) {
+      is_penalized_[word_id] = 1;
       T score = beam_token_scores[word_id];
 
       // If score < 0, then repetition penalty > 1.0 has to multiplied to reduce the previous token probability,
       // This assumes that scores are either positive (like ctrl) or negative (like GPT-2), but not a mixture.
       beam_token_scores[word_id] = (score < 0 ? score * penalty_ : score / penalty_);
     }
+
+    for (const int32_t word_id : sequence) {
+      is_penalized_[word_id] = 0;
+    }
   }
 }
 
@@ -79,19 +85,17 @@ void NoRepeatNGramLogitsProcessor<T>::Process(const ISequences* sequences,
     gsl::span<const int32_t> prefix = sequence.subspan(sequence.size() - prefix_length);
     ORT_ENFORCE(prefix.size() == narrow<size_t>(prefix_length));
 
-    std::unordered_set<int32_t> blocked_word_ids;
+    // Blocking a word twice is harmless, so the scores are written as the N-grams are matched.
+    // The last word of the prefix is compared first, as it rejects most positions.
+    // The complexity is O(batch_beam_size * sequence_length) unless the sequence repeats itself.
+    const int32_t prefix_last = ngram_size_ == 1 ? 0 : prefix[prefix_length - 1];
     for (int j = 0; j <= static_cast<int>(sequence.size()) - ngram_size_; j++) {
-      // Here we use naive algorithm for matching. The complexity is O(batch_beam_size * ngram_size * sequence_length)
-      // TODO(tianleiwu): build N-Gram index (hash table with prefix of length NGram - 1 as key,
-      //                  and list of last word of NGram as value) for fast matching.
-      if (ngram_size_ == 1 || SpanEq(prefix, sequence.subspan(j, prefix_length))) {
-        blocked_word_ids.insert(sequence[static_cast<gsl::index>(j) + prefix_length]);
+      if (ngram_size_ == 1 ||
+          (sequence[static_cast<gsl::index>(j) + prefix_length - 1] == prefix_last &&
+           SpanEq(prefix, sequence.subspan(j, prefix_length)))) {
+        beam_token_scores[sequence[static_cast<gsl::index>(j) + prefix_length]] = std::numeric_limits<T>::lowest();
       }
     }
-
-    for (const int32_t word_id : blocked_word_ids) {
-      beam_token_scores[word_id] = std::numeric_limits<T>::lowest();
-    }
   }
 }
 
@@ -188,6 +192,59 @@ void PresencePenaltyLogitsProcessor<T>::Process(const ISequences*,
   }
 }
 
+template <typename T>
+ElementwiseLogitsProcessor<T>::ElementwiseLogitsProcessor(const gsl::span<const int32_t>& vocab_mask,
+                                                          int min_length,
+                                                          int eos_token_id,
+                                                          float temperature,
+                                                          const gsl::span<const int32_t>& presence_mask,
+                                                          float presence_penalty)
+    : vocab_mask_(vocab_mask),
+      min_length_(min_length),
+      eos_token_id_(eos_token_id),
+      temperature_(temperature),
+      presence_mask_(presence_mask),
+      presence_penalty_(presence_penalty) {
+}
+
+template <typename T>
+void ElementwiseLogitsProcessor<T>::Process(const ISequences* sequences,
+                                            NextTokenScores<T>& next_token_scores) {
+  const bool mask = !vocab_mask_.empty();
+  const bool scale = temperature_ != 1.0f;
+  const bool penalize = !presence_mask_.empty();
+  const bool block_eos = sequences->GetSequenceLength() < min_length_;
+  const int vocab_size = next_token_scores.vocab_size;
+
+  for (int i = 0; i < next_token_scores.batch_beam_size; i++) {
+    gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
+    T* p = beam_token_scores.data();
+
+    // the vocabulary mask would only lower the eos score to the same value, so it is set first
+    if (block_eos) {
+      p[eos_token_id_] = std::numeric_limits<T>::lowest();
+    }
+
+    // presence_mask shape (batch_size, vocab_size), which is the shape of the scores as there is a single beam.
+    // The loop invariant conditions are hoisted out of the loop by the compiler, which vectorizes each variant.
+    const int32_t* vocab_mask = vocab_mask_.data();
+    const int32_t* presence = penalize ? presence_mask_.data() + static_cast<size_t>(i) * vocab_size : nullptr;
+    for (int j = 0; j < vocab_size; j++) {
+      T score = p[j];
+      if (mask && vocab_mask[j] == 0) {
+        score = std::numeric_limits<T>::lowest();
+      }
+      if (scale) {
+        score /= temperature_;
+      }
+      if (penalize) {
+        score -= presence[j] * presence_penalty_;
+      }
+      p[j] = score;
+    }
+  }
+}
+
 void LogitsProcessorList::Init(const BeamSearchParameters& parameters) {
   LogitsProcessorInitImpl<BeamSearchParameters>(parameters);
 }
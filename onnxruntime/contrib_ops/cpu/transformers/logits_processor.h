@@ -11,6 +11,7 @@
 #include "contrib_ops/cpu/transformers/sampling_parameters.h"
 #include "contrib_ops/cpu/transformers/generation_shared.h"
 #include <iostream>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
@@ -76,6 +77,7 @@ class RepetitionPenaltyLogitsProcessor : public ILogitsProcessor<T> {
 
  private:
   float penalty_;
+  std::vector<uint8_t> is_penalized_;  // per vocabulary entry, reset after each sequence
 };
 
 template <typename T>
@@ -156,6 +158,30 @@ class PresencePenaltyLogitsProcessor : public ILogitsProcessor<T> {
   float presence_penalty_;
 };
 
+// Applies the vocabulary mask, the minimum length, the temperature and the presence penalty in a single pass over
+// the scores. Each score goes through them in this order, as it did with the separate processors above.
+template <typename T>
+class ElementwiseLogitsProcessor : public ILogitsProcessor<T> {
+ public:
+  ElementwiseLogitsProcessor(const gsl::span<const int32_t>& vocab_mask,
+                             int min_length,
+                             int eos_token_id,
+                             float temperature,
+                             const gsl::span<const int32_t>& presence_mask,
+                             float presence_penalty);
+
+  void Process(const ISequences* sequences,
+               NextTokenScores<T>& next_token_scores) override;
+
+ private:
+  gsl::span<const int32_t> vocab_mask_;     // empty if not masked
+  int min_length_;                          // 0 if no minimum length
+  int eos_token_id_;
+  float temperature_;                       // 1 if not scaled
+  gsl::span<const int32_t> presence_mask_;  // empty if no presence penalty
+  float presence_penalty_;
+};
+
 template <typename T>
 class TimestampLogitsProcessor : public ILogitsProcessor<T> {
  public:
@@ -318,11 +344,7 @@ class LogitsProcessorList : public ILogitsProcessorList {
       processor_list_.push_back(no_repeat_ngram_processor_.get());
     }
 
-    if (!parameters.vocab_mask.empty()) {
-      vocab_mask_processor_ = std::make_unique<VocabMaskLogitsProcessor<float>>(parameters.vocab_mask);
-      processor_list_.push_back(vocab_mask_processor_.get());
-    }
-
+    // the prefix vocabulary mask is applied before the vocabulary mask, they both only lower scores to the minimum
     if (!parameters.prefix_vocab_mask.empty()) {
       prefix_vocab_mask_processor_ = std::make_unique<
           PrefixVocabMaskLogitsProcessor<float>>(parameters.prefix_vocab_mask,
@@ -330,22 +352,18 @@ class LogitsProcessorList : public ILogitsProcessorList {
       processor_list_.push_back(prefix_vocab_mask_processor_.get());
     }
 
-    if (parameters.min_length > 0) {
-      min_length_processor_ = std::make_unique<MinLengthLogitsProcessor<float>>(parameters.min_length,
-                                                                                parameters.eos_token_id);
-      processor_list_.push_back(min_length_processor_.get());
-    }
-
-    if (parameters.temperature > 0) {
-      temperature_processor_ = std::make_unique<TemperatureLogitsProcessor<float>>(parameters.temperature);
-      processor_list_.push_back(temperature_processor_.get());
-    }
-
-    if (!parameters.presence_mask.empty()) {
-      presence_penalty_processor_ = std::make_unique<
-          PresencePenaltyLogitsProcessor<float>>(parameters.presence_mask,
-                                                 parameters.presence_penalty);
-      processor_list_.push_back(presence_penalty_processor_.get());
+    const float temperature = parameters.temperature > 0 ? parameters.temperature : 1.0f;
+    const float presence_penalty = parameters.presence_mask.empty() ? 0.0f : parameters.presence_penalty;
+    if (!parameters.vocab_mask.empty() || parameters.min_length > 0 || temperature != 1.0f ||
+        presence_penalty != 0.0f) {
+      elementwise_processor_ = std::make_unique<ElementwiseLogitsProcessor<float>>(
+          parameters.vocab_mask,
+          parameters.min_length,
+          parameters.eos_token_id,
+          temperature,
+          presence_penalty != 0.0f ? parameters.presence_mask : gsl::span<const int32_t>{},
+          presence_penalty);
+      processor_list_.push_back(elementwise_processor_.get());
     }
 
     // Add timestamp processor for whisper model
@@ -373,11 +391,8 @@ class LogitsProcessorList : public ILogitsProcessorList {
 
   std::unique_ptr<RepetitionPenaltyLogitsProcessor<float>> repetition_penalty_processor_;
   std::unique_ptr<NoRepeatNGramLogitsProcessor<float>> no_repeat_ngram_processor_;
-  std::unique_ptr<VocabMaskLogitsProcessor<float>> vocab_mask_processor_;
   std::unique_ptr<PrefixVocabMaskLogitsProcessor<float>> prefix_vocab_mask_processor_;
-  std::unique_ptr<MinLengthLogitsProcessor<float>> min_length_processor_;
-  std::unique_ptr<TemperatureLogitsProcessor<float>> temperature_processor_;
-  std::unique_ptr<PresencePenaltyLogitsProcessor<float>> presence_penalty_processor_;
+  std::unique_ptr<ElementwiseLogitsProcessor<float>> elementwise_processor_;
   std::unique_ptr<TimestampLogitsProcessor<float>> timestamp_processor_;
 };
 
@@ -2,56 +2,68 @@
 // Licensed under the MIT License.
 #pragma once
 
+#include <algorithm>
+#include <numeric>
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
 namespace onnxruntime {
 namespace contrib {
 namespace SamplingCpuHelper {
 
-template <typename T>
-void filter_scores(std::vector<size_t>& sorted_indice,
-                   gsl::span<T>& next_token_score,
-                   const transformers::IGenerationParameters* parameters,
-                   size_t chunk_offset,
-                   size_t offset) {
-  size_t real_index = sorted_indice[chunk_offset + offset];
-  next_token_score[chunk_offset + real_index] = (T)parameters->filter_value;
-}
+// Sorting the candidates happens in rounds that at least double the number of sorted candidates, starting with this
+// many, so that only the head of the vocabulary is sorted when top_p keeps a few tokens.
+constexpr size_t kTopPInitialCandidates = 256;
 
+// Sets the scores of one batch entry to filter_value, except for the highest scored tokens that top_p keeps.
+// The candidates are ordered by a partial selection (nth_element) of one round at a time instead of sorting the
+// whole vocabulary, and probs is the softmax of the scores, used to accumulate the probability mass.
 template <typename T>
-void cumulate_and_filter_custom(gsl::span<T>& next_token_scores,
-                                gsl::span<T>& cumulative_probs,
-                                const transformers::IGenerationParameters* parameters,
-                                std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] > parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 1);
+void FilterTopP(gsl::span<T> next_token_scores,
+                gsl::span<const T> probs,
+                gsl::span<int32_t> indices,
+                const transformers::IGenerationParameters* parameters) {
+  const size_t vocab_size = next_token_scores.size();
+  std::iota(indices.begin(), indices.end(), 0);
+  auto greater = [&next_token_scores](int32_t i1, int32_t i2) {
+    return next_token_scores[i1] > next_token_scores[i2] ||
+           (next_token_scores[i1] == next_token_scores[i2] && i1 < i2);
+  };
+
+  // A token is filtered when the tokens above it hold enough probability mass: at least top_p (after the first
+  // min_tokens_to_keep tokens) by default, or more than top_p (after the first token) with custom sampling.
+  const float top_p = parameters->top_p;
+  const size_t min_tokens_to_keep =
+      parameters->custom_sampling ? 1 : static_cast<size_t>(std::max(parameters->min_tokens_to_keep, 0));
+  auto is_filtered = [&](size_t rank, float mass_above) {
+    if (rank < min_tokens_to_keep) {
+      return false;
     }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - 1; j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] > parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j + 1);
-      }
+    return parameters->custom_sampling ? mass_above > top_p : mass_above >= top_p;
+  };
+
+  size_t kept = 0;
+  float mass_above = 0.0f;
+  bool found = false;
+  while (!found && kept < vocab_size) {
+    const size_t candidates = std::min(vocab_size, std::max(2 * kept, kTopPInitialCandidates));
+    if (candidates < vocab_size) {
+      std::nth_element(indices.begin() + kept, indices.begin() + candidates, indices.end(), greater);
     }
-  }
-}
+    std::sort(indices.begin() + kept, indices.begin() + candidates, greater);
 
-template <typename T>
-void cumulate_and_filter(gsl::span<T>& next_token_scores,
-                         gsl::span<T>& cumulative_probs,
-                         const transformers::IGenerationParameters* parameters,
-                         std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] <= 1 - parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 0);
-    }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - static_cast<size_t>(parameters->min_tokens_to_keep); j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] <= 1 - parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j);
+    for (; kept < candidates; ++kept) {
+      if (is_filtered(kept, mass_above)) {
+        found = true;
+        break;
       }
+      mass_above += static_cast<float>(probs[indices[kept]]);
     }
   }
+
+  for (size_t i = kept; i < vocab_size; ++i) {
+    next_token_scores[indices[i]] = (T)parameters->filter_value;
+  }
 }
 
 template <typename T>
@@ -64,55 +76,23 @@ Status Sample(AllocatorPtr& allocator,
               const IConsoleDumper* dumper) {
   ORT_UNUSED_PARAMETER(dumper);
 
-  gsl::span<T>& sorted_scores = sampling_state->sorted_scores;
-  memcpy(sorted_scores.data(), next_token_scores.data(), next_token_scores.size_bytes());
-  std::vector<size_t> sorted_indices(static_cast<size_t>(parameters->batch_size) * static_cast<size_t>(parameters->vocab_size));
-
-  std::function<bool(T, T)> predicator;
-  if (parameters->custom_sampling) {
-    predicator = std::greater<T>();
-  } else {
-    predicator = std::less<T>();
-  }
-
-  // TODO: This could be optimized with allocated buffer and handwritten sort algorithm
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    auto indices_begin = sorted_indices.begin() + i * parameters->vocab_size;
-    auto indices_end = sorted_indices.begin() + (i + 1) * parameters->vocab_size;
-    gsl::span<T> next_token_score = next_token_scores.subspan(i * parameters->vocab_size, parameters->vocab_size);
-    std::iota(indices_begin, indices_end, 0);
-    std::sort(indices_begin, indices_end,
-              [&next_token_score, &predicator](size_t i1, size_t i2) {
-                return predicator(next_token_score[i1], next_token_score[i2]);
-              });
-
-    std::sort(sorted_scores.begin() + i * parameters->vocab_size,
-              sorted_scores.begin() + (i + 1) * parameters->vocab_size,
-              predicator);
-  }
-
-#ifdef DEBUG_GENERATION
-  dumper->Print("sorted_scores", sorted_scores.data(), parameters->batch_size, parameters->vocab_size);
-  dumper->Print("sorted_indices", sorted_indices.data(), parameters->batch_size, parameters->vocab_size);
-#endif
-
-  gsl::span<T>& cumulative_probs = sampling_state->cumulative_probs;
-
-  ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(parameters->batch_size,
-                                    parameters->vocab_size,
-                                    sorted_scores.data(),
-                                    cumulative_probs.data(),
-                                    false,
-                                    thread_pool));
-
-  if (parameters->custom_sampling) {
-    cumulate_and_filter_custom(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  } else {
-    cumulate_and_filter(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  }
+  const size_t batch_size = static_cast<size_t>(parameters->batch_size);
+  const size_t vocab_size = static_cast<size_t>(parameters->vocab_size);
+  gsl::span<T>& probs = sampling_state->cumulative_probs;
+  std::vector<int32_t> indices(batch_size * vocab_size);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(batch_size),
+      [&](std::ptrdiff_t i) {
+        const size_t offset = static_cast<size_t>(i) * vocab_size;
+        gsl::span<T> next_token_score = next_token_scores.subspan(offset, vocab_size);
+        gsl::span<T> prob = probs.subspan(offset, vocab_size);
+        MlasComputeSoftmax(next_token_score.data(), prob.data(), 1, vocab_size, false, false, nullptr);
+        FilterTopP<T>(next_token_score, prob, gsl::make_span(indices).subspan(offset, vocab_size), parameters);
+      });
 
 #ifdef DEBUG_GENERATION
-  dumper->Print("cumulative_probs after filtering", cumulative_probs.data(), parameters->batch_size, parameters->vocab_size);
+  dumper->Print("probs", probs.data(), parameters->batch_size, parameters->vocab_size);
   dumper->Print("next_token_scores after filtering", next_token_scores.data(), parameters->batch_size, parameters->vocab_size);
 #endif
 
@@ -231,6 +231,14 @@ Status WhisperDecoderSubgraph::CreateInitialFeeds(
     } else {
       // past key/value for cross attention does not need to be initialized with max_seq_len since they are static.
       bool use_max_seq_len = (j - first_past_input_index_) <= 2 * static_cast<size_t>(num_layers);
+      int max_seq_len = use_max_seq_len ? past_present_share_buffer_max_seq_len : 0;
+
+      // The decoder only reads the past states that are not padded to max_seq_len, and the feeds keep them for all
+      // the decoding steps. So with a single beam the encoder output is fed as is instead of copied.
+      if (num_beam == 1 && max_seq_len == 0) {
+        decoder_feeds.push_back(encoder_fetches[j]);
+        continue;
+      }
 
       OrtValue expanded_cache;
       if (is_output_float16_) {
@@ -240,7 +248,7 @@ Status WhisperDecoderSubgraph::CreateInitialFeeds(
                                                        allocator,
                                                        expanded_cache,
                                                        false,
-                                                       use_max_seq_len ? past_present_share_buffer_max_seq_len : 0));
+                                                       max_seq_len));
       } else {
         ORT_RETURN_IF_ERROR(expand_buffer_float_func(stream,
                                                      encoder_fetches[j],
@@ -248,7 +256,7 @@ Status WhisperDecoderSubgraph::CreateInitialFeeds(
                                                      allocator,
                                                      expanded_cache,
                                                      false,
-                                                     use_max_seq_len ? past_present_share_buffer_max_seq_len : 0));
+                                                     max_seq_len));
       }
       decoder_feeds.push_back(expanded_cache);
     }
@@ -17,17 +17,6 @@ class PackedMultiHeadAttention final : public TrtFusedAttention<T> {
   Status ComputeInternal(OpKernelContext* context) const override;
 
  private:
-  Status CheckInputs(const TensorShape& query_shape,
-                     const Tensor* key,
-                     const Tensor* value,
-                     const Tensor* bias,
-                     const TensorShape& token_offset_shape,
-                     const TensorShape& cu_seq_len_shape,
-                     const Tensor* attention_bias,
-                     PackedAttentionParameters& parameters) const;
-  int GetNumHeads() const { return num_heads_; }
-  float GetScale() const { return scale_; }
-
   int num_heads_;  // number of attention heads
   float scale_;    // the scale for softmax in memory efficient attention or unfused attention.
 
@@ -7,7 +7,7 @@
 #include "contrib_ops/cuda/utils/dump_cuda_tensor.h"
 #include "contrib_ops/cuda/bert/paged_attention_impl.h"
 #include "contrib_ops/cuda/bert/paged_attention.h"
-#include "contrib_ops/cuda/bert/paged_attention_helper.h"
+#include "contrib_ops/cpu/bert/paged_attention_helper.h"
 #include "contrib_ops/cuda/bert/flash_attention/flash_api.h"
 
 using namespace onnxruntime::cuda;
@@ -86,7 +86,8 @@ Status PagedAttention<T>::ComputeInternal(OpKernelContext* context) const {
                                                           kv_num_heads_,
                                                           scale_,
                                                           softcap_,
-                                                          device_prop.maxThreadsPerBlock));
+                                                          device_prop.maxThreadsPerBlock,
+                                                          /*block_size_multiple*/ 256));
   parameters.local_window_size = local_window_size_;
   parameters.do_rotary = do_rotary_;
   parameters.rotary_interleaved = rotary_interleaved_;
@@ -49,6 +49,8 @@ class CUDA_MS_OP_TYPED_CLASS_NAME(1, MLFloat16, TransposeMatMul);  // backward c
 class CUDA_MS_OP_TYPED_CLASS_NAME(1, float, FusedMatMul);
 class CUDA_MS_OP_TYPED_CLASS_NAME(1, double, FusedMatMul);
 class CUDA_MS_OP_TYPED_CLASS_NAME(1, MLFloat16, FusedMatMul);
+class CUDA_MS_OP_TYPED_CLASS_NAME(1, float, BatchedLoraMatMul);
+class CUDA_MS_OP_TYPED_CLASS_NAME(1, MLFloat16, BatchedLoraMatMul);
 class CUDA_MS_OP_TYPED_CLASS_NAME(1, float, RelativePositionBias);
 class CUDA_MS_OP_TYPED_CLASS_NAME(1, MLFloat16, RelativePositionBias);
 class CUDA_MS_OP_TYPED_CLASS_NAME(1, float, GatedRelativePositionBias);
@@ -268,6 +270,8 @@ Status RegisterCudaContribKernels(KernelRegistry& kernel_registry) {
       BuildKernelCreateInfo<CUDA_MS_OP_TYPED_CLASS_NAME(1, float, FusedMatMul)>,
       BuildKernelCreateInfo<CUDA_MS_OP_TYPED_CLASS_NAME(1, double, FusedMatMul)>,
       BuildKernelCreateInfo<CUDA_MS_OP_TYPED_CLASS_NAME(1, MLFloat16, FusedMatMul)>,
+      BuildKernelCreateInfo<CUDA_MS_OP_TYPED_CLASS_NAME(1, float, BatchedLoraMatMul)>,
+      BuildKernelCreateInfo<CUDA_MS_OP_TYPED_CLASS_NAME(1, MLFloat16, BatchedLoraMatMul)>,
       BuildKernelCreateInfo<CUDA_MS_OP_TYPED_CLASS_NAME(1, float, RelativePositionBias)>,
       BuildKernelCreateInfo<CUDA_MS_OP_TYPED_CLASS_NAME(1, MLFloat16, RelativePositionBias)>,
       BuildKernelCreateInfo<CUDA_MS_OP_TYPED_CLASS_NAME(1, float, GatedRelativePositionBias)>,
@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/safeint.h"
+#include "core/providers/cuda/cuda_kernel.h"
+#include "core/providers/cuda/shared_inc/fpgeneric.h"
+#include "contrib_ops/cpu/math/batched_lora_matmul_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+using namespace onnxruntime::cuda;
+
+template <typename T>
+class BatchedLoraMatMul final : public CudaKernel {
+ public:
+  BatchedLoraMatMul(const OpKernelInfo& info) : CudaKernel(info) {
+    scale_ = info.GetAttrOrDefault<float>("scale", 1.0f);
+  }
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  float scale_;
+};
+
+template <typename T>
+Status BatchedLoraMatMul<T>::ComputeInternal(OpKernelContext* ctx) const {
+  const Tensor* X = ctx->Input<Tensor>(0);
+  const Tensor* A = ctx->Input<Tensor>(1);
+  const Tensor* B = ctx->Input<Tensor>(2);
+  const Tensor* adapter_index = ctx->Input<Tensor>(3);
+
+  batched_lora_matmul_helper::Parameters parameters;
+  ORT_RETURN_IF_ERROR(batched_lora_matmul_helper::CheckInputs(X->Shape(), A->Shape(), B->Shape(),
+                                                              adapter_index->Shape(), parameters));
+
+  TensorShapeVector y_dims = X->Shape().AsShapeVector();
+  y_dims.back() = parameters.n;
+  Tensor* Y = ctx->Output(0, y_dims);
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  // adapter_index is on CPU, so the batch is split in segments without a device synchronization
+  InlinedVector<batched_lora_matmul_helper::Segment> segments;
+  ORT_RETURN_IF_ERROR(batched_lora_matmul_helper::GetSegments(adapter_index->DataAsSpan<int32_t>(),
+                                                              parameters.num_adapters, segments));
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  cudaStream_t stream = Stream(ctx);
+  const int k = SafeInt<int>(parameters.k);
+  const int rank = SafeInt<int>(parameters.rank);
+  const int n = SafeInt<int>(parameters.n);
+
+  IAllocatorUniquePtr<T> shrunk = GetScratchBuffer<T>(
+      SafeInt<size_t>(parameters.batch_size) * parameters.rows_per_batch * parameters.rank, ctx->GetComputeStream());
+
+  const CudaT* x_data = reinterpret_cast<const CudaT*>(X->Data<T>());
+  const CudaT* a_data = reinterpret_cast<const CudaT*>(A->Data<T>());
+  const CudaT* b_data = reinterpret_cast<const CudaT*>(B->Data<T>());
+  CudaT* y_data = reinterpret_cast<CudaT*>(Y->MutableData<T>());
+  CudaT* shrunk_data = reinterpret_cast<CudaT*>(shrunk.get());
+
+  const CudaT one = ToCudaType<T>::FromFloat(1.f);
+  const CudaT zero = ToCudaType<T>::FromFloat(0.f);
+  const CudaT scale = ToCudaType<T>::FromFloat(scale_);
+
+  // each segment is a shrink GEMM with A followed by an expand GEMM with B, on all the rows of its batch entries.
+  // cublas is column major, so the row major products are computed as their transposes.
+  for (const auto& segment : segments) {
+    const int64_t first_row = segment.begin * parameters.rows_per_batch;
+    const int m = SafeInt<int>((segment.end - segment.begin) * parameters.rows_per_batch);
+    CudaT* y = y_data + first_row * n;
+    if (segment.adapter < 0 || rank == 0) {
+      CUDA_RETURN_IF_ERROR(cudaMemsetAsync(y, 0, SafeInt<size_t>(m) * n * sizeof(CudaT), stream));
+      continue;
+    }
+
+    const int64_t adapter = segment.adapter;
+    CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+        GetCublasHandle(ctx), CUBLAS_OP_N, CUBLAS_OP_N, rank, m, k, &one,
+        a_data + adapter * k * rank, rank, x_data + first_row * k, k, &zero,
+        shrunk_data, rank, GetDeviceProp(), UseTF32()));
+    CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+        GetCublasHandle(ctx), CUBLAS_OP_N, CUBLAS_OP_N, n, m, rank, &scale,
+        b_data + adapter * rank * n, n, shrunk_data, rank, &zero,
+        y, n, GetDeviceProp(), UseTF32()));
+  }
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    BatchedLoraMatMul,
+    kMSDomain,
+    1,
+    float,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .InputMemoryType(OrtMemTypeCPUInput, 3)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    BatchedLoraMatMul<float>);
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    BatchedLoraMatMul,
+    kMSDomain,
+    1,
+    MLFloat16,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .InputMemoryType(OrtMemTypeCPUInput, 3)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    BatchedLoraMatMul<MLFloat16>);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/hardware_counters.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace onnxruntime {
+namespace profiling {
+
+#if defined(__linux__)
+namespace {
+
+// The counters of a thread, opened as one group so that they are read together and scheduled on the PMU together.
+class ThreadCounters {
+ public:
+  ThreadCounters() {
+    // the leader of the group. Without it, none of the counters are read.
+    leader_fd_ = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (leader_fd_ < 0) {
+      return;
+    }
+    slots_[num_counters_++] = &HardwareCounterValues::cycles;
+
+    // events that can't be opened, e.g. in a VM without a virtual PMU, are left out of the group
+    if (int fd = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, leader_fd_); fd >= 0) {
+      member_fds_[num_members_++] = fd;
+      slots_[num_counters_++] = &HardwareCounterValues::instructions;
+    }
+    if (int fd = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, leader_fd_); fd >= 0) {
+      member_fds_[num_members_++] = fd;
+      slots_[num_counters_++] = &HardwareCounterValues::llc_misses;
+    }
+  }
+
+  ~ThreadCounters() {
+    for (int i = 0; i < num_members_; ++i) {
+      close(member_fds_[i]);
+    }
+    if (leader_fd_ >= 0) {
+      close(leader_fd_);
+    }
+  }
+
+  bool Read(HardwareCounterValues& values) const {
+    if (leader_fd_ < 0) {
+      return false;
+    }
+
+    // layout of a read of a group with PERF_FORMAT_GROUP: the number of counters followed by their values
+    uint64_t buffer[1 + kMaxCounters];
+    const ssize_t bytes_read = read(leader_fd_, buffer, sizeof(buffer));
+    if (bytes_read < static_cast<ssize_t>(sizeof(uint64_t)) || buffer[0] != static_cast<uint64_t>(num_counters_)) {
+      return false;
+    }
+
+    values = {};
+    for (int i = 0; i < num_counters_; ++i) {
+      values.*slots_[i] = buffer[1 + i];
+    }
+    return true;
+  }
+
+ private:
+  static int Open(uint32_t type, uint64_t config, int group_fd) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // counts the calling thread on any CPU
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC));
+  }
+
+  static constexpr int kMaxCounters = 3;
+
+  int leader_fd_ = -1;
+  int member_fds_[kMaxCounters - 1] = {};
+  int num_members_ = 0;
+  uint64_t HardwareCounterValues::* slots_[kMaxCounters] = {};
+  int num_counters_ = 0;
+};
+
+}  // namespace
+
+bool ReadThreadHardwareCounters(HardwareCounterValues& values) {
+  static thread_local ThreadCounters counters;
+  return counters.Read(values);
+}
+#else
+bool ReadThreadHardwareCounters(HardwareCounterValues& /*values*/) {
+  return false;
+}
+#endif
+
+}  // namespace profiling
+}  // namespace onnxruntime
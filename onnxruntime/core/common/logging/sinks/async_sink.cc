@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/logging/sinks/async_sink.h"
+
+#include <chrono>
+#include <utility>
+
+namespace onnxruntime {
+namespace logging {
+
+AsyncSink::AsyncSink(std::unique_ptr<ISink> sink, size_t buffer_size)
+    : sink_{std::move(sink)} {
+  size_t capacity = 2;
+  while (capacity < buffer_size) {
+    capacity *= 2;
+  }
+
+  cells_ = std::make_unique<Cell[]>(capacity);
+  mask_ = capacity - 1;
+  for (size_t i = 0; i < capacity; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  thread_ = std::thread(&AsyncSink::Run, this);
+}
+
+AsyncSink::~AsyncSink() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_.store(true, std::memory_order_release);
+  }
+  cv_.notify_one();
+  thread_.join();
+}
+
+void AsyncSink::SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
+  if (message.Severity() == Severity::kFATAL) {
+    sink_->Send(timestamp, logger_id, message);
+    return;
+  }
+
+  const CodeLocation& location = message.Location();
+  Entry entry{timestamp, logger_id, message.Severity(), message.Category() != nullptr ? message.Category() : "",
+              message.DataType(), location.file_and_path, location.line_num, location.function, message.Message()};
+
+  if (!TryPush(std::move(entry))) {
+    num_dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  // the background thread may be sleeping. it also wakes up periodically in case this notification is missed.
+  cv_.notify_one();
+}
+
+// bounded multi-producer queue from http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+bool AsyncSink::TryPush(Entry&& entry) {
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell& cell = cells_[pos & mask_];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+    if (diff == 0) {
+      // the cell is free. claim it unless another producer did first.
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        cell.entry = std::move(entry);
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // the cell still holds the entry from the previous lap, so the buffer is full
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool AsyncSink::TryPop(Entry& entry) {
+  Cell& cell = cells_[dequeue_pos_ & mask_];
+  const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+  if (sequence != dequeue_pos_ + 1) {
+    return false;
+  }
+
+  entry = std::move(cell.entry);
+  cell.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+  ++dequeue_pos_;
+  return true;
+}
+
+void AsyncSink::Run() {
+  Entry entry;
+  for (;;) {
+    while (TryPop(entry)) {
+      SendEntry(entry);
+    }
+
+    if (const uint64_t num_dropped = num_dropped_.exchange(0, std::memory_order_relaxed); num_dropped > 0) {
+      Entry dropped;
+      dropped.timestamp = std::chrono::system_clock::now();
+      dropped.severity = Severity::kWARNING;
+      dropped.category = Category::onnxruntime;
+      dropped.file_and_path = __FILE__;
+      dropped.line_num = __LINE__;
+      dropped.function = __FUNCTION__;
+      dropped.message = "Dropped " + std::to_string(num_dropped) + " log messages as the log buffer was full.";
+      SendEntry(dropped);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stop_.load(std::memory_order_acquire)) {
+      lock.unlock();
+      // send what was queued before the sink was destroyed
+      while (TryPop(entry)) {
+        SendEntry(entry);
+      }
+      return;
+    }
+
+    cv_.wait_for(lock, std::chrono::milliseconds(10));
+  }
+}
+
+void AsyncSink::SendEntry(const Entry& entry) {
+  const CodeLocation location{entry.file_and_path.c_str(), entry.line_num, entry.function.c_str()};
+  const Capture message{entry.severity, entry.category.c_str(), entry.data_type, location, entry.message};
+  sink_->Send(entry.timestamp, entry.logger_id, message);
+}
+
+}  // namespace logging
+}  // namespace onnxruntime
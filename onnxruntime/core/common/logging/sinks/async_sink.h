@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "core/common/logging/capture.h"
+#include "core/common/logging/isink.h"
+
+namespace onnxruntime {
+namespace logging {
+/// <summary>
+/// ISink that sends the messages to another sink from a background thread, so that the threads logging a message
+/// don't format it or wait for the I/O of the sink.
+/// The messages are queued in a fixed size lock-free buffer. A message is dropped if the buffer is full, and the
+/// number of dropped messages is logged once the background thread catches up. FATAL messages are sent to the
+/// sink directly so they are not lost if the process terminates.
+/// </summary>
+/// <seealso cref="ISink" />
+class AsyncSink : public ISink {
+ public:
+  /// <summary>
+  /// Initializes a new instance of the <see cref="AsyncSink"/> class.
+  /// </summary>
+  /// <param name="sink">The sink to send the messages to.</param>
+  /// <param name="buffer_size">The maximum number of queued messages. Rounded up to a power of 2.</param>
+  AsyncSink(std::unique_ptr<ISink> sink, size_t buffer_size);
+
+  /// <summary>
+  /// Sends the queued messages and stops the background thread.
+  /// </summary>
+  ~AsyncSink() override;
+
+  void SendProfileEvent(profiling::EventRecord& event_record) const override {
+    sink_->SendProfileEvent(event_record);
+  }
+
+ private:
+  struct Entry {
+    Timestamp timestamp;
+    std::string logger_id;
+    Severity severity{Severity::kVERBOSE};
+    std::string category;
+    DataType data_type{DataType::SYSTEM};
+    // CodeLocation isn't assignable so its parts are stored
+    std::string file_and_path;
+    int line_num{0};
+    std::string function;
+    std::string message;
+  };
+
+  // slot of the buffer. sequence tells producers and the consumer whether the slot is free or holds an entry.
+  struct Cell {
+    std::atomic<size_t> sequence;
+    Entry entry;
+  };
+
+  void SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) override;
+
+  // called by any thread. returns false if the buffer is full.
+  bool TryPush(Entry&& entry);
+  // called by the background thread only. returns false if the buffer is empty.
+  bool TryPop(Entry& entry);
+
+  void Run();
+  void SendEntry(const Entry& entry);
+
+  std::unique_ptr<ISink> sink_;
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_;
+  std::atomic<size_t> enqueue_pos_{0};
+  size_t dequeue_pos_{0};
+
+  std::atomic<uint64_t> num_dropped_{0};
+
+  // only used to let the background thread sleep while the buffer is empty. producers don't take the mutex.
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::atomic<bool> stop_{false};
+
+  std::thread thread_;
+};
+}  // namespace logging
+}  // namespace onnxruntime
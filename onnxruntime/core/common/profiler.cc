@@ -3,11 +3,14 @@
 
 #include "profiler.h"
 
+#include <cmath>
+
 namespace onnxruntime {
 namespace profiling {
 using namespace std::chrono;
 
 std::atomic<size_t> Profiler::global_max_num_events_{1000 * 1000};
+std::atomic<uint64_t> Profiler::next_id_{0};
 
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
 Profiler* Profiler::instance_ = nullptr;
@@ -157,5 +160,92 @@ std::string Profiler::EndProfiling() {
   return profile_stream_file_;
 }
 
+Profiler::NodeStatsBuffer& Profiler::GetThreadNodeStatsBuffer() {
+  // the buffer of the last profiler used by this thread, so the map is only searched when sessions alternate
+  thread_local uint64_t cached_id = 0;
+  thread_local NodeStatsBuffer* cached_buffer = nullptr;
+  if (cached_id != id_) {
+    std::lock_guard<std::mutex> lock(node_stats_mutex_);
+    auto& buffer = node_stats_buffers_[std::this_thread::get_id()];
+    if (!buffer) {
+      buffer = std::make_unique<NodeStatsBuffer>();
+    }
+    cached_buffer = buffer.get();
+    cached_id = id_;
+  }
+  return *cached_buffer;
+}
+
+void Profiler::NodeStatsAccumulator::Merge(const NodeStatsAccumulator& other) {
+  count += other.count;
+  total_ns += other.total_ns;
+  min_ns = std::min(min_ns, other.min_ns);
+  max_ns = std::max(max_ns, other.max_ns);
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    buckets[i] += other.buckets[i];
+  }
+}
+
+namespace {
+
+// Interpolates the duration at the given fraction of the executions within the histogram bucket that holds it.
+double Percentile(const std::array<uint64_t, 65>& buckets, uint64_t count, uint64_t min_ns, uint64_t max_ns,
+                  double fraction) {
+  const double rank = fraction * static_cast<double>(count);
+  uint64_t below = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    if (buckets[i] == 0 || static_cast<double>(below + buckets[i]) < rank) {
+      below += buckets[i];
+      continue;
+    }
+    const double low = i == 0 ? 0.0 : std::ldexp(1.0, static_cast<int>(i) - 1);
+    const double high = std::ldexp(1.0, static_cast<int>(i));
+    const double value = low + (high - low) * (rank - static_cast<double>(below)) / static_cast<double>(buckets[i]);
+    return std::min(std::max(value, static_cast<double>(min_ns)), static_cast<double>(max_ns));
+  }
+  return static_cast<double>(max_ns);
+}
+
+}  // namespace
+
+std::vector<NodeStats> Profiler::GetNodeStats() const {
+  std::unordered_map<const void*, NodeStatsAccumulator> merged;
+  {
+    std::lock_guard<std::mutex> lock(node_stats_mutex_);
+    for (const auto& thread_buffer : node_stats_buffers_) {
+      std::lock_guard<std::mutex> buffer_lock(thread_buffer.second->mutex);
+      for (const auto& node : thread_buffer.second->nodes) {
+        auto it = merged.find(node.first);
+        if (it == merged.end()) {
+          merged.emplace(node.first, node.second);
+        } else {
+          it->second.Merge(node.second);
+        }
+      }
+    }
+  }
+
+  std::vector<NodeStats> result;
+  result.reserve(merged.size());
+  for (const auto& node : merged) {
+    const auto& acc = node.second;
+    NodeStats stats;
+    stats.name = acc.name;
+    stats.count = acc.count;
+    stats.total_us = static_cast<double>(acc.total_ns) / 1000.0;
+    stats.mean_us = stats.total_us / static_cast<double>(acc.count);
+    stats.min_us = static_cast<double>(acc.min_ns) / 1000.0;
+    stats.max_us = static_cast<double>(acc.max_ns) / 1000.0;
+    stats.p50_us = Percentile(acc.buckets, acc.count, acc.min_ns, acc.max_ns, 0.5) / 1000.0;
+    stats.p99_us = Percentile(acc.buckets, acc.count, acc.min_ns, acc.max_ns, 0.99) / 1000.0;
+    result.push_back(std::move(stats));
+  }
+
+  std::sort(result.begin(), result.end(), [](const NodeStats& a, const NodeStats& b) {
+    return a.total_us != b.total_us ? a.total_us > b.total_us : a.name < b.name;
+  });
+  return result;
+}
+
 }  // namespace profiling
 }  // namespace onnxruntime
@@ -3,11 +3,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <fstream>
 #include <initializer_list>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <thread>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include "core/common/profiler_common.h"
 #include "core/common/logging/logging.h"
@@ -21,6 +28,21 @@ namespace profiling {
 // note that static profiler instance only works with single session
 // #define ENABLE_STATIC_PROFILER_INSTANCE
 
+/**
+ * Latency statistics of a node over all of its recorded executions, in microseconds.
+ * The percentiles are interpolated from a histogram with power of 2 buckets.
+ */
+struct NodeStats {
+  std::string name;
+  uint64_t count{};
+  double total_us{};
+  double mean_us{};
+  double min_us{};
+  double max_us{};
+  double p50_us{};
+  double p99_us{};
+};
+
 /**
  * Main class for profiling. It continues to accumulate events and produce
  * a corresponding "complete event (X)" in "chrome tracing" format.
@@ -110,6 +132,72 @@ class Profiler {
     global_max_num_events_.store(new_max_num_events);
   }
 
+  /*
+  Only record the events of every Nth graph execution instead of all of them.
+  The executions of the subgraphs of control flow nodes are sampled independently of their parent graph.
+  */
+  void SetSampleInterval(size_t sample_interval) {
+    sample_interval_ = sample_interval == 0 ? 1 : sample_interval;
+  }
+
+  /*
+  Whether the events of the graph execution that is starting are recorded. Thread safe.
+  */
+  bool ShouldProfileExecution() {
+    if (!enabled_) {
+      return false;
+    }
+    return sample_interval_ == 1 || execution_count_.fetch_add(1, std::memory_order_relaxed) % sample_interval_ == 0;
+  }
+
+  /*
+  Enable the per node latency statistics. They are collected for every execution, independently of whether
+  events are recorded, and cost one clock read and an uncontended per thread lock per node.
+  */
+  void EnableNodeStats() {
+    node_stats_enabled_ = true;
+  }
+
+  bool IsNodeStatsEnabled() const {
+    return node_stats_enabled_;
+  }
+
+  /*
+  Add the hardware counters of the thread running a node and of each intra-op thread pool thread to the
+  "thread_scheduling_stats" of the node events. Only has an effect on Linux, see ReadThreadHardwareCounters().
+  */
+  void EnableHardwareCounters() {
+    hardware_counters_enabled_ = true;
+  }
+
+  bool IsHardwareCountersEnabled() const {
+    return hardware_counters_enabled_;
+  }
+
+  /*
+  Add the time since start_time to the statistics of the node identified by node_key.
+  get_name is only called the first time the node is seen by the calling thread.
+  */
+  template <typename GetName>
+  void RecordNodeStats(const void* node_key, const TimePoint& start_time, GetName&& get_name) {
+    const auto duration = std::chrono::high_resolution_clock::now() - start_time;
+    const auto duration_ns = static_cast<uint64_t>(
+        std::max<long long>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    NodeStatsBuffer& buffer = GetThreadNodeStatsBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    auto it = buffer.nodes.find(node_key);
+    if (it == buffer.nodes.end()) {
+      it = buffer.nodes.emplace(node_key, NodeStatsAccumulator{get_name()}).first;
+    }
+    it->second.Add(duration_ns);
+  }
+
+  /*
+  Return the statistics of the nodes merged over all threads, by decreasing total time.
+  Can be called while the session is running.
+  */
+  std::vector<NodeStats> GetNodeStats() const;
+
   void AddEpProfilers(std::unique_ptr<EpProfiler> ep_profiler) {
     if (ep_profiler) {
       ep_profilers_.push_back(std::move(ep_profiler));
@@ -156,6 +244,51 @@ class Profiler {
 #endif
 
   std::vector<std::unique_ptr<EpProfiler>> ep_profilers_;
+
+  size_t sample_interval_{1};
+  std::atomic<uint64_t> execution_count_{0};
+
+  struct NodeStatsAccumulator {
+    explicit NodeStatsAccumulator(std::string node_name) : name(std::move(node_name)) {}
+
+    void Add(uint64_t duration_ns) {
+      ++count;
+      total_ns += duration_ns;
+      min_ns = std::min(min_ns, duration_ns);
+      max_ns = std::max(max_ns, duration_ns);
+      // bucket i > 0 holds the durations in [2^(i-1), 2^i) ns
+      size_t bucket = 0;
+      while (bucket < 64 && (duration_ns >> bucket) != 0) {
+        ++bucket;
+      }
+      ++buckets[bucket];
+    }
+
+    void Merge(const NodeStatsAccumulator& other);
+
+    std::string name;
+    uint64_t count{0};
+    uint64_t total_ns{0};
+    uint64_t min_ns{std::numeric_limits<uint64_t>::max()};
+    uint64_t max_ns{0};
+    std::array<uint64_t, 65> buckets{};
+  };
+
+  // Each thread records into its own buffer, so the lock is only contended by GetNodeStats().
+  struct NodeStatsBuffer {
+    std::mutex mutex;
+    std::unordered_map<const void*, NodeStatsAccumulator> nodes;
+  };
+
+  NodeStatsBuffer& GetThreadNodeStatsBuffer();
+
+  static std::atomic<uint64_t> next_id_;
+  // identifies the profiler in the per thread buffer cache, ids are never reused
+  const uint64_t id_{next_id_.fetch_add(1) + 1};
+  bool node_stats_enabled_{false};
+  bool hardware_counters_enabled_{false};
+  mutable std::mutex node_stats_mutex_;
+  std::unordered_map<std::thread::id, std::unique_ptr<NodeStatsBuffer>> node_stats_buffers_;
 };
 
 }  // namespace profiling
@@ -13,8 +13,12 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <atomic>
+#include <chrono>
+#include <map>
 #include <memory>
 #include <optional>
+#include <sstream>
 
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
@@ -64,7 +68,23 @@ ThreadPoolProfiler::~ThreadPoolProfiler() {
   enabled_ = false;
 }
 
-void ThreadPoolProfiler::Start() {
+namespace {
+void WriteHardwareCounters(std::ostream& os, const profiling::HardwareCounterValues& hw_counters) {
+  os << "\"hw_cycles\": " << hw_counters.cycles << ", "
+     << "\"hw_instructions\": " << hw_counters.instructions << ", "
+     << "\"hw_llc_misses\": " << hw_counters.llc_misses;
+}
+}  // namespace
+
+void ThreadPoolProfiler::Start(bool collect_hardware_counters) {
+  if (collect_hardware_counters) {
+    MainThreadStat& stat = GetMainThreadStat();
+    stat.hw_counters_at_start_valid_ = profiling::ReadThreadHardwareCounters(stat.hw_counters_at_start_);
+    for (auto& child_thread_stat : child_thread_stats_) {
+      child_thread_stat.hw_counters_ = {};
+    }
+  }
+  collect_hardware_counters_ = collect_hardware_counters;
   enabled_ = true;
 }
 
@@ -78,13 +98,27 @@ ThreadPoolProfiler::MainThreadStat& ThreadPoolProfiler::GetMainThreadStat() {
 
 std::string ThreadPoolProfiler::Stop() {
   ORT_ENFORCE(enabled_, "Profiler not started yet");
+  MainThreadStat& main_thread_stat = GetMainThreadStat();
   std::ostringstream ss;
   ss << "{\"main_thread\": {"
      << "\"thread_pool_name\": \""
      << thread_pool_name_ << "\", "
-     << GetMainThreadStat().Reset()
-     << "}, \"sub_threads\": {"
+     << main_thread_stat.Reset();
+  if (collect_hardware_counters_) {
+    profiling::HardwareCounterValues hw_counters;
+    if (main_thread_stat.hw_counters_at_start_valid_ && profiling::ReadThreadHardwareCounters(hw_counters)) {
+      hw_counters = hw_counters - main_thread_stat.hw_counters_at_start_;
+    } else {
+      hw_counters = {};
+    }
+    main_thread_stat.hw_counters_at_start_valid_ = false;
+    ss << ", ";
+    WriteHardwareCounters(ss, hw_counters);
+  }
+  ss << "}, \"sub_threads\": {"
      << DumpChildThreadStat()
+     << "}, \"steal_domains\": {"
+     << DumpStealDomainStat()
      << "}}";
   return ss.str();
 }
@@ -203,9 +237,36 @@ void ThreadPoolProfiler::LogThreadId(int thread_idx) {
   child_thread_stats_[thread_idx].thread_id_ = std::this_thread::get_id();
 }
 
+void ThreadPoolProfiler::LogThreadDomain(int thread_idx, int domain) {
+  child_thread_stats_[thread_idx].domain_ = domain;
+}
+
+void ThreadPoolProfiler::LogSteal(int thread_idx, bool is_remote) {
+  if (enabled_) {
+    if (is_remote) {
+      child_thread_stats_[thread_idx].num_remote_steal_++;
+    } else {
+      child_thread_stats_[thread_idx].num_local_steal_++;
+    }
+  }
+}
+
+void ThreadPoolProfiler::LogRunStart(int thread_idx) {
+  if (enabled_ && collect_hardware_counters_) {
+    auto& stat = child_thread_stats_[thread_idx];
+    stat.hw_counters_at_run_start_valid_ = profiling::ReadThreadHardwareCounters(stat.hw_counters_at_run_start_);
+  }
+}
+
 void ThreadPoolProfiler::LogRun(int thread_idx) {
   if (enabled_) {
-    child_thread_stats_[thread_idx].num_run_++;
+    auto& stat = child_thread_stats_[thread_idx];
+    profiling::HardwareCounterValues hw_counters;
+    if (stat.hw_counters_at_run_start_valid_ && profiling::ReadThreadHardwareCounters(hw_counters)) {
+      stat.hw_counters_ += hw_counters - stat.hw_counters_at_run_start_;
+    }
+    stat.hw_counters_at_run_start_valid_ = false;
+    stat.num_run_++;
     auto now = Clock::now();
     if (child_thread_stats_[thread_idx].core_ < 0 ||
         TimeDiffMicroSeconds(child_thread_stats_[thread_idx].last_logged_point_, now) > 10000) {
@@ -236,11 +297,42 @@ std::string ThreadPoolProfiler::DumpChildThreadStat() {
   for (int i = 0; i < num_threads_; ++i) {
     ss << "\"" << child_thread_stats_[i].thread_id_ << "\": {"
        << "\"num_run\": " << child_thread_stats_[i].num_run_ << ", "
-       << "\"core\": " << child_thread_stats_[i].core_ << "}"
+       << "\"core\": " << child_thread_stats_[i].core_ << ", "
+       << "\"domain\": " << child_thread_stats_[i].domain_;
+    if (collect_hardware_counters_) {
+      ss << ", ";
+      WriteHardwareCounters(ss, child_thread_stats_[i].hw_counters_);
+    }
+    ss << "}"
        << (i == num_threads_ - 1 ? "" : ",");
   }
   return ss.str();
 }
+
+std::string ThreadPoolProfiler::DumpStealDomainStat() {
+  struct DomainStat {
+    int num_threads = 0;
+    uint64_t num_local_steal = 0;
+    uint64_t num_remote_steal = 0;
+  };
+  std::map<int32_t, DomainStat> domain_stats;
+  for (const auto& child_thread_stat : child_thread_stats_) {
+    auto& domain_stat = domain_stats[child_thread_stat.domain_];
+    domain_stat.num_threads++;
+    domain_stat.num_local_steal += child_thread_stat.num_local_steal_;
+    domain_stat.num_remote_steal += child_thread_stat.num_remote_steal_;
+  }
+
+  std::stringstream ss;
+  for (auto it = domain_stats.begin(); it != domain_stats.end(); ++it) {
+    ss << (it == domain_stats.begin() ? "" : ",")
+       << "\"" << it->first << "\": {"
+       << "\"num_threads\": " << it->second.num_threads << ", "
+       << "\"num_local_steal\": " << it->second.num_local_steal << ", "
+       << "\"num_remote_steal\": " << it->second.num_remote_steal << "}";
+  }
+  return ss.str();
+}
 #endif
 
 // A sharded loop counter distributes loop iterations between a set of worker threads.  The iteration space of
@@ -370,6 +462,21 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
 #pragma warning(pop) /* Padding added in LoopCounterShard, LoopCounter */
 #endif
 
+// The statistics of the parallel loops of a LoopOwnerScope owner.  Its loops whose total cost (in the
+// units of the Eigen cost model) is at most inline_threshold run in the calling thread.  The times per
+// cost unit are moving averages of the loops run in the calling thread and dispatched to the pool, 0
+// until measured.  Concurrent runs of an owner may lose updates, which only slows down the learning.
+struct ThreadPool::LoopStats {
+  explicit LoopStats(const ThreadPool* pool) : tp(pool) {}
+
+  const ThreadPool* tp;
+  std::atomic<double> inline_threshold{0};
+  std::atomic<double> inline_ns_per_cost{0};
+  std::atomic<double> parallel_ns_per_cost{0};
+  std::atomic<uint64_t> num_parallel_loops{0};
+  std::atomic<uint64_t> num_learned_inline_loops{0};
+};
+
 ThreadPool::ThreadPool(Env* env,
                        const ThreadOptions& thread_options,
                        const NAME_CHAR_TYPE* name,
@@ -480,22 +587,76 @@ void ThreadPool::Schedule(std::function<void()> fn) {
   }
 }
 
-void ThreadPool::StartProfiling() {
+void ThreadPool::StartProfiling(bool collect_hardware_counters) {
   if (underlying_threadpool_) {
-    underlying_threadpool_->StartProfiling();
+    underlying_threadpool_->StartProfiling(collect_hardware_counters);
   }
 }
 
+namespace {
+thread_local std::optional<ThreadPoolParallelSection> current_parallel_section;
+thread_local ThreadPool::LoopStats* current_loop_stats = nullptr;
+
+// Weight of a new measurement in the moving averages of the loop times.
+constexpr double kLoopTimeAverageWeight = 0.125;
+
+// While the inline time of an owner is unknown, one of every kInlineProbeInterval dispatched loops
+// whose total cost is below kMaxInlineProbeCost runs in the calling thread to measure it.
+constexpr uint64_t kInlineProbeInterval = 16;
+constexpr double kMaxInlineProbeCost = 1e6;
+
+void UpdateLoopTimeAverage(std::atomic<double>& average, double value) {
+  const double prev = average.load(std::memory_order_relaxed);
+  average.store(prev == 0 ? value : prev + kLoopTimeAverageWeight * (value - prev), std::memory_order_relaxed);
+}
+}  // namespace
+
 std::string ThreadPool::StopProfiling() {
   if (underlying_threadpool_) {
-    return underlying_threadpool_->StopProfiling();
+    std::string stats = underlying_threadpool_->StopProfiling();
+    LoopStats* loop_stats = current_loop_stats;
+    if (loop_stats != nullptr && loop_stats->tp == this && !stats.empty() && stats.back() == '}') {
+      std::ostringstream ss;
+      ss << ", \"inline_threshold\": {"
+         << "\"cost\": " << loop_stats->inline_threshold.load(std::memory_order_relaxed) << ", "
+         << "\"inline_ns_per_cost\": " << loop_stats->inline_ns_per_cost.load(std::memory_order_relaxed) << ", "
+         << "\"parallel_ns_per_cost\": " << loop_stats->parallel_ns_per_cost.load(std::memory_order_relaxed) << ", "
+         << "\"num_parallel_loops\": " << loop_stats->num_parallel_loops.load(std::memory_order_relaxed) << ", "
+         << "\"num_learned_inline_loops\": "
+         << loop_stats->num_learned_inline_loops.load(std::memory_order_relaxed) << "}}";
+      stats.pop_back();
+      stats += ss.str();
+    }
+    return stats;
   } else {
     return {};
   }
 }
 
-namespace {
-thread_local std::optional<ThreadPoolParallelSection> current_parallel_section;
+ThreadPool::LoopStats* ThreadPool::GetLoopStats(const void* owner) {
+  std::lock_guard<std::mutex> lock(loop_stats_mutex_);
+  auto& stats = loop_stats_[owner];
+  if (!stats) {
+    stats = std::make_unique<LoopStats>(this);
+  }
+  return stats.get();
+}
+
+ThreadPool::LoopOwnerScope::LoopOwnerScope(ThreadPool* tp, const void* owner) : prev_stats_(current_loop_stats) {
+  current_loop_stats = (tp != nullptr && tp->thread_options_.adaptive_inline_threshold) ? tp->GetLoopStats(owner)
+                                                                                         : nullptr;
+}
+
+ThreadPool::LoopOwnerScope::~LoopOwnerScope() {
+  current_loop_stats = prev_stats_;
+}
+
+ThreadPool::PriorityScope::PriorityScope(bool high_priority)
+    : prev_high_priority_(ThreadPoolTempl<Env>::SetHighPriority(high_priority)) {
+}
+
+ThreadPool::PriorityScope::~PriorityScope() {
+  ThreadPoolTempl<Env>::SetHighPriority(prev_high_priority_);
 }
 
 ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
@@ -623,8 +784,53 @@ void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
     return;
   }
 
-  ptrdiff_t block = CalculateParallelForBlock(n, cost, nullptr, d_of_p);
-  ParallelForFixedBlockSizeScheduling(n, block, f);
+  LoopStats* stats = current_loop_stats;
+  if (stats == nullptr || stats->tp != this) {
+    ptrdiff_t block = CalculateParallelForBlock(n, cost, nullptr, d_of_p);
+    ParallelForFixedBlockSizeScheduling(n, block, f);
+    return;
+  }
+
+  // Run the loop in the calling thread if the owner learned that dispatching loops of this cost takes
+  // longer, and compare the measured time with the time per cost unit of the other way of running it.
+  const double total_cost = CostModel::totalCost(static_cast<double>(n), cost);
+  const bool probe = stats->inline_ns_per_cost.load(std::memory_order_relaxed) == 0 &&
+                     total_cost < kMaxInlineProbeCost &&
+                     stats->num_parallel_loops.load(std::memory_order_relaxed) % kInlineProbeInterval ==
+                         kInlineProbeInterval - 1;
+  const bool run_inline = probe || total_cost <= stats->inline_threshold.load(std::memory_order_relaxed);
+
+  const auto start = std::chrono::steady_clock::now();
+  if (run_inline) {
+    f(0, n);
+  } else {
+    ptrdiff_t block = CalculateParallelForBlock(n, cost, nullptr, d_of_p);
+    ParallelForFixedBlockSizeScheduling(n, block, f);
+  }
+  const double ns_per_cost =
+      std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / total_cost;
+
+  if (run_inline) {
+    UpdateLoopTimeAverage(stats->inline_ns_per_cost, ns_per_cost);
+    if (probe) {
+      stats->num_parallel_loops.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      stats->num_learned_inline_loops.fetch_add(1, std::memory_order_relaxed);
+      // dispatching was faster for loops of this cost, lower the threshold below it
+      const double parallel_ns_per_cost = stats->parallel_ns_per_cost.load(std::memory_order_relaxed);
+      if (parallel_ns_per_cost != 0 && ns_per_cost > parallel_ns_per_cost) {
+        stats->inline_threshold.store(total_cost / 2, std::memory_order_relaxed);
+      }
+    }
+  } else {
+    UpdateLoopTimeAverage(stats->parallel_ns_per_cost, ns_per_cost);
+    stats->num_parallel_loops.fetch_add(1, std::memory_order_relaxed);
+    // running in the calling thread would have been faster, raise the threshold to this cost
+    const double inline_ns_per_cost = stats->inline_ns_per_cost.load(std::memory_order_relaxed);
+    if (inline_ns_per_cost != 0 && inline_ns_per_cost < ns_per_cost) {
+      stats->inline_threshold.store(total_cost, std::memory_order_relaxed);
+    }
+  }
 }
 
 void ThreadPool::ParallelFor(std::ptrdiff_t total, double cost_per_unit,
@@ -650,9 +856,9 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   }
 }
 
-void ThreadPool::StartProfiling(concurrency::ThreadPool* tp) {
+void ThreadPool::StartProfiling(concurrency::ThreadPool* tp, bool collect_hardware_counters) {
   if (tp) {
-    tp->StartProfiling();
+    tp->StartProfiling(collect_hardware_counters);
   }
 }
 
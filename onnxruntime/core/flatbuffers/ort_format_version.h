@@ -20,13 +20,15 @@ namespace onnxruntime {
 // Version 4 - update kernel def hashing to not depend on ordering of type constraint types (NOT BACKWARDS COMPATIBLE)
 // Version 5 - deprecate kernel def hashes and add KernelTypeStrResolver info to replace them (NOT BACKWARDS COMPATIBLE)
 // Version 6 - add float 8 types
-constexpr const int kOrtModelVersion = 6;
+// Version 7 - add optional saved allocation plan to InferenceSession
+constexpr const int kOrtModelVersion = 7;
 
 // Check if the given ort model version is supported in this build
 inline bool IsOrtModelVersionSupported(const int ort_model_version) {
   // The ort model versions we will support in this build
   // This may contain more versions than the kOrtModelVersion, based on the compatibilities
   constexpr std::array kSupportedOrtModelVersions{
+      kOrtModelVersion - 2,
       kOrtModelVersion - 1,
       kOrtModelVersion,
   };
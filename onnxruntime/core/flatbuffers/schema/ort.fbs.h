@@ -105,6 +105,12 @@ struct OpIdKernelTypeStrArgsEntryBuilder;
 struct KernelTypeStrResolver;
 struct KernelTypeStrResolverBuilder;
 
+struct AllocationPlanEntry;
+struct AllocationPlanEntryBuilder;
+
+struct AllocationPlan;
+struct AllocationPlanBuilder;
+
 struct InferenceSession;
 struct InferenceSessionBuilder;
 
@@ -2971,12 +2977,157 @@ inline ::flatbuffers::Offset<KernelTypeStrResolver> CreateKernelTypeStrResolverD
       op_kernel_type_str_args__);
 }
 
+struct AllocationPlanEntry FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef AllocationPlanEntryBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_VALUE_NAME = 4,
+    VT_ALLOC_KIND = 6,
+    VT_REUSED_BUFFER = 8
+  };
+  const ::flatbuffers::String *value_name() const {
+    return GetPointer<const ::flatbuffers::String *>(VT_VALUE_NAME);
+  }
+  int8_t alloc_kind() const {
+    return GetField<int8_t>(VT_ALLOC_KIND, 0);
+  }
+  const ::flatbuffers::String *reused_buffer() const {
+    return GetPointer<const ::flatbuffers::String *>(VT_REUSED_BUFFER);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffsetRequired(verifier, VT_VALUE_NAME) &&
+           verifier.VerifyString(value_name()) &&
+           VerifyField<int8_t>(verifier, VT_ALLOC_KIND, 1) &&
+           VerifyOffset(verifier, VT_REUSED_BUFFER) &&
+           verifier.VerifyString(reused_buffer()) &&
+           verifier.EndTable();
+  }
+};
+
+struct AllocationPlanEntryBuilder {
+  typedef AllocationPlanEntry Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_value_name(::flatbuffers::Offset<::flatbuffers::String> value_name) {
+    fbb_.AddOffset(AllocationPlanEntry::VT_VALUE_NAME, value_name);
+  }
+  void add_alloc_kind(int8_t alloc_kind) {
+    fbb_.AddElement<int8_t>(AllocationPlanEntry::VT_ALLOC_KIND, alloc_kind, 0);
+  }
+  void add_reused_buffer(::flatbuffers::Offset<::flatbuffers::String> reused_buffer) {
+    fbb_.AddOffset(AllocationPlanEntry::VT_REUSED_BUFFER, reused_buffer);
+  }
+  explicit AllocationPlanEntryBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<AllocationPlanEntry> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<AllocationPlanEntry>(end);
+    fbb_.Required(o, AllocationPlanEntry::VT_VALUE_NAME);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<AllocationPlanEntry> CreateAllocationPlanEntry(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    ::flatbuffers::Offset<::flatbuffers::String> value_name = 0,
+    int8_t alloc_kind = 0,
+    ::flatbuffers::Offset<::flatbuffers::String> reused_buffer = 0) {
+  AllocationPlanEntryBuilder builder_(_fbb);
+  builder_.add_reused_buffer(reused_buffer);
+  builder_.add_value_name(value_name);
+  builder_.add_alloc_kind(alloc_kind);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<AllocationPlanEntry> CreateAllocationPlanEntryDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    const char *value_name = nullptr,
+    int8_t alloc_kind = 0,
+    const char *reused_buffer = nullptr) {
+  auto value_name__ = value_name ? _fbb.CreateString(value_name) : 0;
+  auto reused_buffer__ = reused_buffer ? _fbb.CreateString(reused_buffer) : 0;
+  return onnxruntime::fbs::CreateAllocationPlanEntry(
+      _fbb,
+      value_name__,
+      alloc_kind,
+      reused_buffer__);
+}
+
+struct AllocationPlan FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef AllocationPlanBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_VALUES = 4,
+    VT_EXECUTION_ORDER = 6
+  };
+  const ::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::AllocationPlanEntry>> *values() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::AllocationPlanEntry>> *>(VT_VALUES);
+  }
+  const ::flatbuffers::Vector<uint32_t> *execution_order() const {
+    return GetPointer<const ::flatbuffers::Vector<uint32_t> *>(VT_EXECUTION_ORDER);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_VALUES) &&
+           verifier.VerifyVector(values()) &&
+           verifier.VerifyVectorOfTables(values()) &&
+           VerifyOffset(verifier, VT_EXECUTION_ORDER) &&
+           verifier.VerifyVector(execution_order()) &&
+           verifier.EndTable();
+  }
+};
+
+struct AllocationPlanBuilder {
+  typedef AllocationPlan Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_values(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::AllocationPlanEntry>>> values) {
+    fbb_.AddOffset(AllocationPlan::VT_VALUES, values);
+  }
+  void add_execution_order(::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> execution_order) {
+    fbb_.AddOffset(AllocationPlan::VT_EXECUTION_ORDER, execution_order);
+  }
+  explicit AllocationPlanBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<AllocationPlan> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<AllocationPlan>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<AllocationPlan> CreateAllocationPlan(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::AllocationPlanEntry>>> values = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> execution_order = 0) {
+  AllocationPlanBuilder builder_(_fbb);
+  builder_.add_execution_order(execution_order);
+  builder_.add_values(values);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<AllocationPlan> CreateAllocationPlanDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<::flatbuffers::Offset<onnxruntime::fbs::AllocationPlanEntry>> *values = nullptr,
+    const std::vector<uint32_t> *execution_order = nullptr) {
+  auto values__ = values ? _fbb.CreateVector<::flatbuffers::Offset<onnxruntime::fbs::AllocationPlanEntry>>(*values) : 0;
+  auto execution_order__ = execution_order ? _fbb.CreateVector<uint32_t>(*execution_order) : 0;
+  return onnxruntime::fbs::CreateAllocationPlan(
+      _fbb,
+      values__,
+      execution_order__);
+}
+
 struct InferenceSession FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef InferenceSessionBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_ORT_VERSION = 4,
     VT_MODEL = 6,
-    VT_KERNEL_TYPE_STR_RESOLVER = 10
+    VT_KERNEL_TYPE_STR_RESOLVER = 10,
+    VT_ALLOCATION_PLAN = 12
   };
   const ::flatbuffers::String *ort_version() const {
     return GetPointer<const ::flatbuffers::String *>(VT_ORT_VERSION);
@@ -2987,6 +3138,9 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   const onnxruntime::fbs::KernelTypeStrResolver *kernel_type_str_resolver() const {
     return GetPointer<const onnxruntime::fbs::KernelTypeStrResolver *>(VT_KERNEL_TYPE_STR_RESOLVER);
   }
+  const onnxruntime::fbs::AllocationPlan *allocation_plan() const {
+    return GetPointer<const onnxruntime::fbs::AllocationPlan *>(VT_ALLOCATION_PLAN);
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_ORT_VERSION) &&
@@ -2995,6 +3149,8 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
            verifier.VerifyTable(model()) &&
            VerifyOffset(verifier, VT_KERNEL_TYPE_STR_RESOLVER) &&
            verifier.VerifyTable(kernel_type_str_resolver()) &&
+           VerifyOffset(verifier, VT_ALLOCATION_PLAN) &&
+           verifier.VerifyTable(allocation_plan()) &&
            verifier.EndTable();
   }
 };
@@ -3012,6 +3168,9 @@ struct InferenceSessionBuilder {
   void add_kernel_type_str_resolver(::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver) {
     fbb_.AddOffset(InferenceSession::VT_KERNEL_TYPE_STR_RESOLVER, kernel_type_str_resolver);
   }
+  void add_allocation_plan(::flatbuffers::Offset<onnxruntime::fbs::AllocationPlan> allocation_plan) {
+    fbb_.AddOffset(InferenceSession::VT_ALLOCATION_PLAN, allocation_plan);
+  }
   explicit InferenceSessionBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -3027,8 +3186,10 @@ inline ::flatbuffers::Offset<InferenceSession> CreateInferenceSession(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     ::flatbuffers::Offset<::flatbuffers::String> ort_version = 0,
     ::flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    ::flatbuffers::Offset<onnxruntime::fbs::AllocationPlan> allocation_plan = 0) {
   InferenceSessionBuilder builder_(_fbb);
+  builder_.add_allocation_plan(allocation_plan);
   builder_.add_kernel_type_str_resolver(kernel_type_str_resolver);
   builder_.add_model(model);
   builder_.add_ort_version(ort_version);
@@ -3039,13 +3200,15 @@ inline ::flatbuffers::Offset<InferenceSession> CreateInferenceSessionDirect(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     const char *ort_version = nullptr,
     ::flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    ::flatbuffers::Offset<onnxruntime::fbs::AllocationPlan> allocation_plan = 0) {
   auto ort_version__ = ort_version ? _fbb.CreateString(ort_version) : 0;
   return onnxruntime::fbs::CreateInferenceSession(
       _fbb,
       ort_version__,
       model,
-      kernel_type_str_resolver);
+      kernel_type_str_resolver,
+      allocation_plan);
 }
 
 inline bool VerifyTypeInfoValue(::flatbuffers::Verifier &verifier, const void *obj, TypeInfoValue type) {
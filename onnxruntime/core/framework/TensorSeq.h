@@ -6,12 +6,20 @@
 #include "core/framework/data_types.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/tensor.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <utility>
 
 namespace onnxruntime {
 // Put this in a separate file to avoid circular dependency between tensor.h and data_types.h
 // Data type to represent a sequence of tensors of the same type
+//
+// Copies of a sequence share the storage of its elements, so copying one is O(1). A copy made to append an element,
+// e.g. by SequenceInsert, appends in place when no other sequence sharing the storage has appended to it yet, which
+// keeps building a sequence of N tensors in a Loop O(N) rather than O(N^2). Any other change to a sequence whose
+// storage is shared copies the elements first.
 class TensorSeq {
  public:
   TensorSeq() = default;
@@ -19,13 +27,28 @@ class TensorSeq {
     SetType(elem_type);
   }
 
+  TensorSeq(const TensorSeq&) = default;
+  TensorSeq& operator=(const TensorSeq&) = default;
+
+  TensorSeq(TensorSeq&& other) noexcept
+      : elem_type_(other.elem_type_), storage_(std::move(other.storage_)), size_(std::exchange(other.size_, 0)) {}
+
+  TensorSeq& operator=(TensorSeq&& other) noexcept {
+    if (this != &other) {
+      elem_type_ = other.elem_type_;
+      storage_ = std::move(other.storage_);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
   using const_iterator = std::vector<OrtValue>::const_iterator;
   using iterator = std::vector<OrtValue>::iterator;
 
   // Sets the element type after construction.
   // Expects sequence to be empty at the time.
   void SetType(MLDataType elem_type) {
-    assert(tensors_.empty());
+    assert(size_ == 0);
     elem_type_ = elem_type->AsPrimitiveDataType();
     ORT_ENFORCE(elem_type_ != nullptr, "Tensor sequence must contain only primitive types");
   }
@@ -34,8 +57,9 @@ class TensorSeq {
     // The caller of this method ensures that :
     // (1) `elem_type` is set before invoking this method
     // (2) All tensors contain elements of the same primitive data type
-    assert(tensors_.empty());
-    tensors_ = std::move(tensors);
+    assert(size_ == 0);
+    size_ = tensors.size();
+    storage_ = std::make_shared<Storage>(std::move(tensors));
   }
 
   MLDataType DataType() const noexcept { return elem_type_; }
@@ -48,23 +72,25 @@ class TensorSeq {
     return elem_type_ == o.DataType()->AsPrimitiveDataType();
   }
 
-  size_t Size() const noexcept { return tensors_.size(); }
+  size_t Size() const noexcept { return size_; }
 
   // Suitable for for range loop
   const_iterator begin() const noexcept {
-    return tensors_.cbegin();
+    return storage_ ? storage_->values.cbegin() : const_iterator{};
   }
 
   const_iterator end() const noexcept {
-    return tensors_.cend();
+    return storage_ ? storage_->values.cbegin() + size_ : const_iterator{};
   }
 
-  iterator begin() noexcept {
-    return tensors_.begin();
+  iterator begin() {
+    MakeStorageUnique();
+    return storage_ ? storage_->values.begin() : iterator{};
   }
 
-  iterator end() noexcept {
-    return tensors_.end();
+  iterator end() {
+    MakeStorageUnique();
+    return storage_ ? storage_->values.begin() + size_ : iterator{};
   }
 
   // Get onnxruntime::Tensor by index
@@ -74,20 +100,20 @@ class TensorSeq {
 
   // Get OrtValue by index
   const OrtValue& GetAt(size_t i) const {
-    ORT_ENFORCE(i < tensors_.size());
-    return tensors_[i];
+    ORT_ENFORCE(i < size_);
+    return storage_->values[i];
   }
 
   void Add(const OrtValue& tensor) {
     ORT_ENFORCE(IsSameDataType(tensor.Get<Tensor>()),
                 "TensorSeq: tensor to be added has a different data type.");
-    tensors_.push_back(tensor);
+    Append(OrtValue(tensor));
   }
 
   void Add(OrtValue&& tensor) {
     ORT_ENFORCE(IsSameDataType(tensor.Get<Tensor>()),
                 "TensorSeq: tensor to be added has a different data type.");
-    tensors_.push_back(std::move(tensor));
+    Append(std::move(tensor));
   }
 
   void Add(Tensor&& tensor) {
@@ -113,10 +139,59 @@ class TensorSeq {
   }
 
   void Reserve(size_t capacity) {
-    tensors_.reserve(capacity);
+    if (!storage_ || storage_->values.size() < capacity) {
+      Reallocate(capacity);
+    }
   }
 
  private:
+  // The elements of the sequences sharing the storage. values is never resized once the storage is shared, the slots
+  // past the elements of every sequence are empty. claimed is the number of slots in use by the longest of the
+  // sequences, a sequence of size_ elements may only append to the storage by claiming slot size_.
+  struct Storage {
+    explicit Storage(size_t capacity) : values(capacity) {}
+    explicit Storage(std::vector<OrtValue>&& elements) : values(std::move(elements)), claimed(values.size()) {}
+
+    std::vector<OrtValue> values;
+    std::atomic<size_t> claimed{0};
+  };
+
+  void Append(OrtValue&& value) {
+    if (storage_ && storage_.use_count() == 1) {
+      // drop the slots claimed by sequences that shared the storage and no longer exist
+      storage_->claimed.store(size_, std::memory_order_relaxed);
+    }
+
+    size_t expected = size_;
+    if (!storage_ || size_ == storage_->values.size() ||
+        !storage_->claimed.compare_exchange_strong(expected, size_ + 1, std::memory_order_acq_rel)) {
+      Reallocate(std::max<size_t>(size_ * 2, 4));
+      storage_->claimed.store(size_ + 1, std::memory_order_relaxed);
+    }
+
+    storage_->values[size_++] = std::move(value);
+  }
+
+  // Copies the elements to a storage of the given capacity, or moves them if the storage isn't shared.
+  void Reallocate(size_t capacity) {
+    auto storage = std::make_shared<Storage>(std::max(capacity, size_));
+    if (storage_) {
+      const bool is_unique = storage_.use_count() == 1;
+      for (size_t i = 0; i < size_; ++i) {
+        storage->values[i] = is_unique ? std::move(storage_->values[i]) : storage_->values[i];
+      }
+    }
+    storage->claimed.store(size_, std::memory_order_relaxed);
+    storage_ = std::move(storage);
+  }
+
+  // Copy on write: the elements are changed in place only if no other sequence shares them.
+  void MakeStorageUnique() {
+    if (storage_ && storage_.use_count() != 1) {
+      Reallocate(size_);
+    }
+  }
+
   // A sequence must be associated with only one data type and all tensors in the seq must be of that type
   // One other alternative of storing the data type of a seq is to templatize the TensorSeq class.
   // The current design follows the Tensor methodology.
@@ -124,7 +199,8 @@ class TensorSeq {
   // and the SequenceInsert op expects validation of tensors to be added to the seq against this type.
   const PrimitiveDataTypeBase* elem_type_{};
 
-  std::vector<OrtValue> tensors_;
+  std::shared_ptr<Storage> storage_;
+  size_t size_{0};
 };
 
 }  // namespace onnxruntime
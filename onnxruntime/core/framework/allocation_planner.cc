@@ -7,8 +7,10 @@
 #include <deque>
 #include <sstream>
 #include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <iterator>
+#include <limits>
 #include "core/common/exceptions.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
@@ -19,6 +21,7 @@
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/mldata_type_utils.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/saved_allocation_plan.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
@@ -99,6 +102,9 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
       if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.alloc_kind == AllocKind::kReuse && elt_plan.is_slice_of_reused_buffer) {
+        out << " at offset " << elt_plan.reused_buffer_offset;
+      }
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
     } else {
@@ -231,6 +237,12 @@ class PlannerImpl {
   // they became free (more recently freed earlier in the list).
   std::list<FreeBufferInfo> freelist_;
 
+  // concat_input_slices_ : the Concat inputs that their producers write straight into the Concat output, mapped to the
+  // Concat output and the byte offset of the input in it. See ComputeConcatInputSlices.
+  InlinedHashMap<OrtValueIndex, std::pair<OrtValueIndex, size_t>> concat_input_slices_;
+  // concat_outputs_with_slices_ : the Concat outputs in concat_input_slices_.
+  InlinedHashSet<OrtValueIndex> concat_outputs_with_slices_;
+
   OrtValueIndex Index(const OrtValueName& name) {
     OrtValueIndex result;
     auto status = ort_value_name_idx_map_.GetIdx(name, result);
@@ -430,10 +442,16 @@ class PlannerImpl {
     for (auto& pair : may_strided_outputs_map) {
       if (pair.second == output_arg_num && pair.first >= 0 && static_cast<size_t>(pair.first) < input_args.size() &&
           input_args[pair.first]->Exists()) {
-        bool can_strided = true;
-        for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+        // Tensors of sub-byte element types can't be strided.
+        const auto* output_tensor_type = utils::GetMLDataType(*p_output_arg)->AsTensorType();
+        bool can_strided = output_tensor_type != nullptr &&
+                           !output_tensor_type->GetElementType()->AsPrimitiveDataType()->HasSubElems();
+        for (auto it = node.OutputNodesBegin(); can_strided && it != node.OutputNodesEnd(); ++it) {
           const KernelCreateInfo& output_node_ci = GetKernelCreateInfo(kernel_create_info_map_, it->Index());
-          if (!output_node_ci.kernel_def) {
+          // A subgraph consuming the output as an implicit input doesn't know it is strided.
+          if (!output_node_ci.kernel_def ||
+              std::find(it->ImplicitInputDefs().begin(), it->ImplicitInputDefs().end(), p_output_arg) !=
+                  it->ImplicitInputDefs().end()) {
             can_strided = false;
             break;
           }
@@ -496,6 +514,44 @@ class PlannerImpl {
     return true;
   }
 
+  // The number of elements of a shape as a monomial of its symbolic dimensions: the product of the known dimensions
+  // times the product of the dim_params in symbols. Returns false if a dimension is unknown.
+  static bool GetSymbolicNumElements(const TensorShapeProto& shape, int64_t& constant,
+                                     InlinedVector<std::string_view>& symbols) {
+    constant = 1;
+    symbols.clear();
+    for (const auto& dim : shape.dim()) {
+      if (utils::HasDimValue(dim)) {
+        const int64_t value = dim.dim_value();
+        if (value < 0 || (value != 0 && constant > std::numeric_limits<int64_t>::max() / value)) {
+          return false;
+        }
+        constant *= value;
+      } else if (utils::HasDimParam(dim) && !dim.dim_param().empty()) {
+        symbols.push_back(dim.dim_param());
+      } else {
+        return false;
+      }
+    }
+    std::sort(symbols.begin(), symbols.end());
+    return true;
+  }
+
+  // Whether the shapes have the same number of elements for every value of their symbolic dimensions, e.g.
+  // [batch, seq, 4, 192] and [batch, seq, 768], or [M, N] and [N, M].
+  static bool SameNumElements(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
+    int64_t constant1, constant2;
+    InlinedVector<std::string_view> symbols1, symbols2;
+    if (!GetSymbolicNumElements(shape1, constant1, symbols1) || !GetSymbolicNumElements(shape2, constant2, symbols2)) {
+      return false;
+    }
+    // with a 0 dimension the tensors are empty whatever the symbols are
+    if (constant1 == 0 || constant2 == 0) {
+      return constant1 == constant2;
+    }
+    return constant1 == constant2 && symbols1 == symbols2;
+  }
+
   /*! \brief Given a tensor-type, return the size of an element of the tensor.
    */
   static size_t GetElementSize(const DataType& tensor_type) {
@@ -521,20 +577,10 @@ class PlannerImpl {
     // If either of the tensors is a string, don't treat them the same. Moreover, reusing a string tensor for a string
     // tensor without releasing the previous memory can cause memory leaks; hence we don't allow reuse across string
     // tensors as well.
-    return !(is_type1_string || is_type2_string) && (type1_size == type2_size) && SameShape(shape1, shape2);
-
-    /* TODO: we can improve this if the concrete shapes are known for both as below.
-       Unclear whether this is worthwhile though.
-    if (KnownSize(p_shape1) && KnownSize(p_shape2)) {
-      // Comparison of statically-known size
-      auto size1 = NumElements(p_shape1) * EltSize(ptype1);
-      auto size2 = NumElements(p_shape2) * EltSize(ptype2);
-      return size1 == size2;
-    } else {
-      // Comparison of statically-unknown size buffers
-      return SameElementSize(ptype1, ptype2) && SameShape(shape1, shape2);
-    }
-    */
+    // The shapes may differ as long as the number of elements is the same for every binding of the symbolic
+    // dimensions, which is what the execution frame checks when it places a tensor in the reused buffer.
+    return !(is_type1_string || is_type2_string) && (type1_size == type2_size) &&
+           (SameShape(shape1, shape2) || SameNumElements(shape1, shape2));
   }
 
   static bool OutputHasConsumerNode(const Node& node, int output_idx) {
@@ -1497,8 +1543,115 @@ class PlannerImpl {
   }
 #endif
 
+  // Returns false if the shape of arg is not fully known when planning.
+  bool GetStaticShape(const onnxruntime::NodeArg& arg, TensorShapeVector& dims) const {
+    const auto* shape = context_->GetShape(arg);
+    if (shape == nullptr) return false;
+    dims.clear();
+    for (const auto& dim : shape->dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() < 0) return false;
+      dims.push_back(dim.dim_value());
+    }
+    return true;
+  }
+
+  // Finds the inputs of CPU Concat nodes that can be allocated as slices of the Concat output, so their producers
+  // write straight into it and Concat doesn't copy them. That requires:
+  //  - static shapes, and all the dims before the concat axis being 1 so that each input is contiguous in the output.
+  //  - inputs that are produced by a node of this graph and used by nothing but the Concat.
+  //  - a Concat output that is not a graph output, so the output buffer is owned by the plan.
+  // The Concat output is then allocated when the first of its inputs is produced.
+  void ComputeConcatInputSlices() {
+    concat_input_slices_.clear();
+    concat_outputs_with_slices_.clear();
+    if (context_->IsParallelExecutionEnabled() || !context_->GetEnableMemoryReuse() || !IsSingleStream()) {
+      return;
+    }
+
+    const auto& graph_outputs = graph_viewer_.GetOutputs();
+    auto is_graph_output = [&graph_outputs](const NodeArg* arg) {
+      return std::find(graph_outputs.begin(), graph_outputs.end(), arg) != graph_outputs.end();
+    };
+
+    TensorShapeVector dims;
+    TensorShapeVector input_dims;
+    InlinedVector<std::pair<OrtValueIndex, size_t>> slices;
+    for (const auto& node : graph_viewer_.Nodes()) {
+      if (node.OpType() != "Concat" || node.Domain() != kOnnxDomain ||
+          node.GetExecutionProviderType() != kCpuExecutionProvider || node.OutputDefs().size() != 1) {
+        continue;
+      }
+
+      const NodeArg* output = node.OutputDefs()[0];
+      if (!output->Exists() || is_graph_output(output) || !GetStaticShape(*output, dims) ||
+          !utils::GetMLDataType(*output)->IsTensorType()) {
+        continue;
+      }
+
+      const auto* element_type = static_cast<const TensorTypeBase*>(utils::GetMLDataType(*output))->GetElementType();
+      if (element_type == DataTypeImpl::GetType<std::string>() || element_type->AsPrimitiveDataType() == nullptr ||
+          element_type->AsPrimitiveDataType()->HasSubElems()) {
+        continue;
+      }
+
+      const auto& attributes = node.GetAttributes();
+      const auto axis_attr = attributes.find("axis");
+      if (axis_attr == attributes.end() || dims.empty()) {
+        continue;
+      }
+
+      const int64_t rank = static_cast<int64_t>(dims.size());
+      int64_t axis = axis_attr->second.i();
+      if (axis < -rank || axis >= rank) {
+        continue;
+      }
+      axis = axis < 0 ? axis + rank : axis;
+      if (std::any_of(dims.begin(), dims.begin() + axis, [](int64_t dim) { return dim != 1; })) {
+        continue;
+      }
+
+      const OrtValueIndex output_index = Index(output->Name());
+      const auto& output_location = AllocPlan(output_index).location;
+      const size_t output_size = SafeInt<size_t>(TensorShape(dims).Size()) * element_type->Size();
+
+      slices.clear();
+      size_t offset = 0;
+      bool can_slice = true;
+      const auto& inputs = node.InputDefs();
+      for (const NodeArg* input : inputs) {
+        const Node* producer = input->Exists() ? graph_viewer_.GetProducerNode(input->Name()) : nullptr;
+        // the producer of a nested Concat would need the offsets of both.
+        can_slice = producer != nullptr && producer->OpType() != "Concat" && !producer->ContainsSubgraph() &&
+                    !HasExternalOutputs(*producer) && !is_graph_output(input) &&
+                    std::count(inputs.begin(), inputs.end(), input) == 1 &&
+                    graph_viewer_.GetConsumerNodes(input->Name()).size() == 1 &&
+                    AllocPlan(input->Name()).location == output_location && GetStaticShape(*input, input_dims);
+        if (!can_slice) {
+          break;
+        }
+
+        const OrtValueIndex input_index = Index(input->Name());
+        slices.emplace_back(input_index, offset);
+        offset += SafeInt<size_t>(TensorShape(input_dims).Size()) * element_type->Size();
+      }
+
+      if (!can_slice || offset != output_size) {
+        continue;
+      }
+
+      for (const auto& slice : slices) {
+        concat_input_slices_[slice.first] = {output_index, slice.second};
+      }
+      concat_outputs_with_slices_.insert(output_index);
+    }
+  }
+
   Status ComputeReusePlan() {
     gsl::not_null<const ISequentialPlannerContext*> backup_context = context_;
+#ifndef ENABLE_TRAINING
+    // training plans order the allocations by program counter, which slices allocated early would break.
+    ComputeConcatInputSlices();
+#endif
     SequentialPlannerContext no_mem_reuse_context(ExecutionMode::ORT_PARALLEL, ExecutionOrder::DEFAULT, false);
     if (!IsSingleStream()) {
       // use parallel execution context to generate a baseline first (no memory sharing)
@@ -1540,6 +1693,196 @@ class PlannerImpl {
     return Status::OK();
   }
 
+#if !defined(ORT_MEMORY_PROFILE) && !defined(ENABLE_TRAINING_CORE) && !defined(ENABLE_STRIDED_TENSORS)
+  // Use the allocation plan saved in an ORT format model for the node outputs instead of running ComputeReusePlan.
+  // The saved plan is only trusted for the graph and execution order it was created for. The checks here cover what
+  // can differ between the converting and the loading session (execution providers, kernels, value locations).
+  // Returns false without modifying the allocation plan if the saved plan can't be used.
+  bool ApplySavedAllocationPlan() {
+    const SavedAllocationPlan* saved_plan = context_->GetSavedAllocationPlan();
+    if (saved_plan == nullptr || parent_node_ != nullptr || num_logic_streams_ != 1 ||
+        context_->IsParallelExecutionEnabled() || !context_->GetEnableMemoryReuse()) {
+      return false;
+    }
+
+    auto reject = [&](const std::string& reason) {
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+      LOGS(logger_, INFO) << "Not using the allocation plan saved in the model. " << reason;
+#else
+      ORT_UNUSED_PARAMETER(reason);
+#endif
+      return false;
+    };
+
+    const auto& execution_order = stream_nodes_[0];
+    if (!std::equal(execution_order.begin(), execution_order.end(),
+                    saved_plan->execution_order.begin(), saved_plan->execution_order.end())) {
+      return reject("The node execution order differs.");
+    }
+
+    struct OutputPlan {
+      OrtValueIndex index;
+      AllocKind alloc_kind;
+      OrtValueIndex reused_buffer;
+      MLDataType value_type;
+    };
+
+    InlinedVector<OutputPlan> output_plans;
+    InlinedHashMap<OrtValueIndex, size_t> output_plan_idx;  // OrtValueIndex -> index in output_plans
+    output_plans.reserve(saved_plan->values.size());
+    output_plan_idx.reserve(saved_plan->values.size());
+
+    // the original buffer of a value, or -1 if it is a node output that hasn't been planned yet
+    auto original_buffer = [&](OrtValueIndex idx) -> OrtValueIndex {
+      auto it = output_plan_idx.find(idx);
+      if (it != output_plan_idx.end()) {
+        return output_plans[it->second].reused_buffer;
+      }
+      return AllocPlan(idx).alloc_kind == AllocKind::kNotSet ? -1 : idx;
+    };
+
+    const auto& graph_outputs = graph_viewer_.GetOutputs();
+    for (const auto node_index : execution_order) {
+      const auto* pnode = graph_viewer_.GetNode(node_index);
+      const bool has_external_outputs = HasExternalOutputs(*pnode);
+      const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, node_index);
+      const auto& input_defs = pnode->InputDefs();
+      const auto& output_defs = pnode->OutputDefs();
+
+      for (int output_idx = 0, end = static_cast<int>(output_defs.size()); output_idx < end; ++output_idx) {
+        const auto* node_output = output_defs[output_idx];
+        if (!node_output->Exists()) continue;
+
+        const auto& name = node_output->Name();
+        auto saved_it = saved_plan->values.find(name);
+        if (saved_it == saved_plan->values.end()) {
+          return reject("No entry for " + name);
+        }
+
+        const auto& saved = saved_it->second;
+        const auto current = Index(name);
+        const bool is_graph_output =
+            std::find(graph_outputs.begin(), graph_outputs.end(), node_output) != graph_outputs.end();
+
+        AllocKind expected_kind = AllocKind::kNotSet;
+        if (has_external_outputs) {
+          expected_kind = AllocKind::kAllocatedExternally;
+        } else if (is_graph_output) {
+          expected_kind = AllocKind::kAllocateOutput;
+        }
+
+        if (expected_kind != AllocKind::kNotSet && saved.alloc_kind != expected_kind) {
+          return reject("Unexpected allocation kind for " + name);
+        }
+
+        OrtValueIndex reused = current;
+        if (expected_kind == AllocKind::kNotSet) {
+          if (saved.alloc_kind == AllocKind::kReuse) {
+            if (!ort_value_name_idx_map_.GetIdx(saved.reused_buffer, reused).IsOK() || reused == current ||
+                original_buffer(reused) != reused) {
+              return reject("Invalid reused buffer for " + name);
+            }
+
+            if (!(AllocPlan(reused).location == AllocPlan(current).location)) {
+              return reject("The location of " + name + " differs from the location of its reused buffer.");
+            }
+          } else if (saved.alloc_kind != AllocKind::kAllocate) {
+            return reject("Unexpected allocation kind for " + name);
+          }
+
+          // reusing the buffer of an input must be permitted by the kernel, and an alias required by the kernel
+          // must be honored.
+          bool is_inplace = false;
+          bool may_inplace = false;
+          bool must_alias = false;
+          auto check_input = [&](int input_idx, bool is_alias) {
+            if (input_idx < 0 || static_cast<size_t>(input_idx) >= input_defs.size() ||
+                !input_defs[input_idx]->Exists()) {
+              return;
+            }
+
+            const bool uses_input_buffer = saved.alloc_kind == AllocKind::kReuse &&
+                                           original_buffer(Index(input_defs[input_idx]->Name())) == reused;
+            may_inplace = may_inplace || uses_input_buffer;
+            must_alias = must_alias || (is_alias && !uses_input_buffer);
+          };
+
+          if (ci.kernel_def != nullptr) {
+            for (const auto& pair : GetAliasMap(*pnode, ci)) {
+              if (pair.second == output_idx) check_input(pair.first, true);
+            }
+
+            const auto& variadic_alias_offsets = ci.kernel_def->VariadicAlias();
+            if (variadic_alias_offsets.has_value()) {
+              check_input(output_idx - variadic_alias_offsets->second + variadic_alias_offsets->first, true);
+            }
+
+            for (const auto& pair : ci.kernel_def->MayInplace()) {
+              if (pair.second == output_idx) check_input(pair.first, false);
+            }
+          }
+
+          if (saved.alloc_kind == AllocKind::kReuse) {
+            for (const auto* input_def : input_defs) {
+              if (input_def->Exists() && original_buffer(Index(input_def->Name())) == reused) {
+                is_inplace = true;
+                break;
+              }
+            }
+          }
+
+          if (must_alias || (is_inplace && !may_inplace)) {
+            return reject("The kernel for node " + pnode->Name() + " does not match the saved buffer reuse.");
+          }
+
+          if (saved.alloc_kind == AllocKind::kReuse && !is_inplace) {
+            // reuse of a freed buffer. see the conditions in ComputeSingleStreamReusePlan.
+            const auto* reused_def = graph_viewer_.GetNodeArg(saved.reused_buffer);
+            if (IsNonTensor(*node_output) || !OutputHasConsumerNode(*pnode, output_idx) ||
+                reused_def == nullptr || !SameSize(*reused_def, *node_output)) {
+              return reject("Invalid reuse of " + saved.reused_buffer + " for " + name);
+            }
+          }
+        }
+
+        output_plan_idx[current] = output_plans.size();
+        output_plans.push_back({current, saved.alloc_kind, reused, utils::GetMLDataType(*node_output)});
+      }
+    }
+
+    // every other saved entry is for a graph input or weight, which must match ComputePlanForInputsAndWeights.
+    size_t num_other_values = 0;
+    for (size_t i = 0; i < plan_.allocation_plan.size(); ++i) {
+      const auto& per_value_plan = plan_.allocation_plan[i];
+      if (per_value_plan.alloc_kind == AllocKind::kNotSet) continue;
+
+      ++num_other_values;
+      std::string name;
+      if (!ort_value_name_idx_map_.GetName(static_cast<int>(i), name).IsOK()) {
+        return reject("Unknown value index.");
+      }
+
+      auto saved_it = saved_plan->values.find(name);
+      if (saved_it == saved_plan->values.end() || saved_it->second.alloc_kind != per_value_plan.alloc_kind) {
+        return reject("The allocation kind of " + name + " differs.");
+      }
+    }
+
+    if (output_plans.size() + num_other_values != saved_plan->values.size()) {
+      return reject("The number of values differs.");
+    }
+
+    for (const auto& output_plan : output_plans) {
+      auto& per_value_plan = AllocPlan(output_plan.index);
+      per_value_plan.alloc_kind = output_plan.alloc_kind;
+      per_value_plan.reused_buffer = output_plan.reused_buffer;
+      per_value_plan.value_type = output_plan.value_type;
+    }
+
+    return true;
+  }
+#endif
+
   // Should only be used after ProcessDef()
   Status ComputeSingleStreamReusePlan(size_t stream_index) {
     auto& execution_plan = stream_nodes_[stream_index];
@@ -1606,6 +1949,14 @@ class PlannerImpl {
               }
             }
           }
+        } else if (auto slice = concat_input_slices_.find(current); slice != concat_input_slices_.end()) {
+          // written by its producer straight into the Concat output, see ComputeConcatInputSlices
+          Reuse(slice->second.first, current, AllocKind::kReuse);
+          AllocPlan(current).is_slice_of_reused_buffer = true;
+          AllocPlan(current).reused_buffer_offset = slice->second.second;
+        } else if (concat_outputs_with_slices_.count(current) != 0) {
+          // already in use by the slices, so it must not reuse another buffer
+          AllocPlan(current).alloc_kind = AllocKind::kAllocate;
         } else if (!context_->IsParallelExecutionEnabled() &&
                    FindReusableInput(graph_viewer_, *pnode, static_cast<int>(output_arg_def_index),
                                      &reused, &is_strided_tensor)) {
@@ -2397,7 +2748,13 @@ Status PlannerImpl::CreatePlan(
 #endif
 
   // determine sharing/reuse among ml-values
+#if !defined(ORT_MEMORY_PROFILE) && !defined(ENABLE_TRAINING_CORE) && !defined(ENABLE_STRIDED_TENSORS)
+  if (!ApplySavedAllocationPlan()) {
+    ORT_RETURN_IF_ERROR(ComputeReusePlan());
+  }
+#else
   ORT_RETURN_IF_ERROR(ComputeReusePlan());
+#endif
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Adjust the allocate and lifetime intervals for all ml-values, based on their allocation kind.
@@ -2633,6 +2990,233 @@ void DeviceBasedPartitioner::SaveConfig() const {
   }
 }
 
+/*
+CriticalPathPartitioner reads its config in json format:
+------------------------------------------------------
+{
+"type":"CriticalPathPartitioner",
+"num_streams":4,
+"profile_file":"./profile.json"
+}
+------------------------------------------------------
+"num_streams" is the number of logic streams the CPU nodes are spread over, so independent branches of the graph
+(e.g. the heads of a multi-head model or the members of an ensemble) run concurrently in ORT_PARALLEL mode;
+"profile_file" is optional, it is a profile written by a session with profiling enabled. The average kernel time of
+a node in it is its cost, and nodes that aren't in it cost the median. Without a profile every node costs the same.
+Nodes on other devices get one stream per device type, as they do with DeviceBasedPartitioner.
+
+The nodes are list scheduled: of the nodes whose inputs are all scheduled, the one with the longest path of costs to
+the end of the graph (its bottom level) goes first, on the stream where it can start the earliest. Waiting for a node
+on another stream costs a little more than waiting for one on the same stream, so a chain stays on one stream.
+*/
+class CriticalPathPartitioner : public IGraphPartitioner {
+ public:
+  CriticalPathPartitioner(const logging::Logger& logger,
+                          const PathString& config_file) : IGraphPartitioner(logger, config_file) {
+    Initialize();
+  }
+
+  Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                        const ExecutionProviders& execution_providers,
+                        std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                        ExecutionOrder execution_order) override;
+
+  const char* Type() const override { return "CriticalPathPartitioner"; }
+  size_t Streams() const override { return num_streams_; }
+
+ private:
+  void Initialize();
+  void LoadProfile(const std::string& profile_file);
+
+  size_t num_streams_ = 1;
+  // average kernel time in microseconds by node name
+  InlinedHashMap<std::string, double> node_costs_;
+};
+
+Status CriticalPathPartitioner::PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                                               const ExecutionProviders& execution_providers,
+                                               std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                                               ExecutionOrder execution_order) {
+  const auto& p_graph_nodes = graph_viewer.GetNodesInTopologicalOrder(execution_order);
+  const size_t max_node_index = graph_viewer.MaxNodeIndex();
+
+  // position in the topological order, or -1 for a node that isn't in the graph viewer
+  std::vector<int> topo_position(max_node_index, -1);
+  for (size_t i = 0; i < p_graph_nodes.size(); ++i) {
+    topo_position[p_graph_nodes[i]] = static_cast<int>(i);
+  }
+
+  std::vector<double> profiled_costs;
+  for (auto node_index : p_graph_nodes) {
+    auto it = node_costs_.find(graph_viewer.GetNode(node_index)->Name());
+    if (it != node_costs_.end()) {
+      profiled_costs.push_back(it->second);
+    }
+  }
+  double default_cost = 1.0;
+  if (!profiled_costs.empty()) {
+    auto median = profiled_costs.begin() + profiled_costs.size() / 2;
+    std::nth_element(profiled_costs.begin(), median, profiled_costs.end());
+    default_cost = std::max(*median, 1.0);
+  }
+  const double cross_stream_cost = 0.1 * default_cost;
+
+  std::vector<double> cost(max_node_index, 0.0);
+  for (auto node_index : p_graph_nodes) {
+    auto it = node_costs_.find(graph_viewer.GetNode(node_index)->Name());
+    cost[node_index] = it != node_costs_.end() ? it->second : default_cost;
+  }
+
+  std::vector<double> bottom_level(max_node_index, 0.0);
+  std::vector<size_t> pending_inputs(max_node_index, 0);
+  for (auto it = p_graph_nodes.rbegin(); it != p_graph_nodes.rend(); ++it) {
+    const auto* node = graph_viewer.GetNode(*it);
+    double successor_level = 0.0;
+    for (auto output_it = node->OutputNodesBegin(); output_it != node->OutputNodesEnd(); ++output_it) {
+      if (topo_position[output_it->Index()] >= 0) {
+        successor_level = std::max(successor_level, bottom_level[output_it->Index()]);
+        ++pending_inputs[output_it->Index()];
+      }
+    }
+    bottom_level[*it] = cost[*it] + successor_level;
+  }
+
+  // the streams of each device type, CPU nodes are spread over num_streams_ streams
+  InlinedHashMap<OrtDevice::DeviceType, InlinedVector<size_t>> device_to_streams;
+  std::vector<double> stream_available_time;
+  std::vector<size_t> node_stream(max_node_index, 0);
+  std::vector<double> finish_time(max_node_index, 0.0);
+  stream_nodes.clear();
+
+  auto higher_priority = [&](NodeIndex lhs, NodeIndex rhs) {
+    if (bottom_level[lhs] != bottom_level[rhs]) {
+      return bottom_level[lhs] > bottom_level[rhs];
+    }
+    return topo_position[lhs] < topo_position[rhs];
+  };
+  // the nodes whose inputs are all scheduled
+  std::vector<NodeIndex> ready_nodes;
+  for (auto node_index : p_graph_nodes) {
+    if (pending_inputs[node_index] == 0) {
+      ready_nodes.push_back(node_index);
+    }
+  }
+
+  while (!ready_nodes.empty()) {
+    auto next_it = std::min_element(ready_nodes.begin(), ready_nodes.end(), higher_priority);
+    const NodeIndex node_index = *next_it;
+    ready_nodes.erase(next_it);
+
+    const auto* node = graph_viewer.GetNode(node_index);
+    auto* ep = execution_providers.Get(*node);
+    ORT_RETURN_IF(ep == nullptr, "Failed to find the execution provider of node \"", node->Name(), "\"");
+    const auto device_type = ep->GetOrtDeviceByMemType(OrtMemType::OrtMemTypeDefault).Type();
+
+    auto& streams = device_to_streams[device_type];
+    if (streams.empty()) {
+      const size_t num_device_streams = device_type == OrtDevice::CPU ? num_streams_ : 1;
+      for (size_t i = 0; i < num_device_streams; ++i) {
+        streams.push_back(stream_nodes.size());
+        stream_nodes.emplace_back();
+        stream_available_time.push_back(0.0);
+      }
+    }
+
+    size_t best_stream = streams.front();
+    double best_start_time = std::numeric_limits<double>::max();
+    for (size_t stream : streams) {
+      double start_time = stream_available_time[stream];
+      for (auto input_it = node->InputNodesBegin(); input_it != node->InputNodesEnd(); ++input_it) {
+        if (topo_position[input_it->Index()] >= 0) {
+          const double wait_cost = node_stream[input_it->Index()] == stream ? 0.0 : cross_stream_cost;
+          start_time = std::max(start_time, finish_time[input_it->Index()] + wait_cost);
+        }
+      }
+      if (start_time < best_start_time) {
+        best_start_time = start_time;
+        best_stream = stream;
+      }
+    }
+
+    node_stream[node_index] = best_stream;
+    finish_time[node_index] = best_start_time + cost[node_index];
+    stream_available_time[best_stream] = finish_time[node_index];
+    stream_nodes[best_stream].push_back(node_index);
+
+    for (auto output_it = node->OutputNodesBegin(); output_it != node->OutputNodesEnd(); ++output_it) {
+      if (topo_position[output_it->Index()] >= 0 && --pending_inputs[output_it->Index()] == 0) {
+        ready_nodes.push_back(output_it->Index());
+      }
+    }
+  }
+
+  // a graph narrower than num_streams_ leaves some streams empty
+  stream_nodes.erase(std::remove_if(stream_nodes.begin(), stream_nodes.end(),
+                                    [](const InlinedVector<NodeIndex>& nodes) { return nodes.empty(); }),
+                     stream_nodes.end());
+
+  size_t num_scheduled = 0;
+  for (const auto& nodes : stream_nodes) {
+    num_scheduled += nodes.size();
+  }
+  ORT_RETURN_IF_NOT(num_scheduled == p_graph_nodes.size(), "CriticalPathPartitioner scheduled ", num_scheduled,
+                    " of ", p_graph_nodes.size(), " nodes");
+  return Status::OK();
+}
+
+void CriticalPathPartitioner::Initialize() {
+  std::ifstream if_stream(config_file_);
+  if (!if_stream.is_open()) {
+    LOGS(logger_, WARNING) << "Failed to open the partition config file, all CPU nodes are in one stream";
+    return;
+  }
+
+  ORT_TRY {
+    json json_config = json::parse(if_stream);
+    num_streams_ = std::max<size_t>(json_config.value("num_streams", size_t{1}), 1);
+    const std::string profile_file = json_config.value("profile_file", std::string{});
+    if (!profile_file.empty()) {
+      LoadProfile(profile_file);
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      LOGS(logger_, WARNING) << "Caught exception when reading CriticalPathPartitioner config: " << ex.what();
+      num_streams_ = 1;
+      node_costs_.clear();
+    });
+  }
+}
+
+void CriticalPathPartitioner::LoadProfile(const std::string& profile_file) {
+  std::ifstream if_stream(profile_file);
+  if (!if_stream.is_open()) {
+    LOGS(logger_, WARNING) << "Failed to open profile file " << profile_file << ", all nodes cost the same";
+    return;
+  }
+
+  // the kernel time events of the profile are named <node name>_kernel_time
+  constexpr std::string_view kKernelTimeSuffix = "_kernel_time";
+  InlinedHashMap<std::string, std::pair<double, size_t>> total_costs;
+  for (const auto& event : json::parse(if_stream)) {
+    if (!event.is_object() || event.value("cat", std::string{}) != "Node") {
+      continue;
+    }
+    const std::string name = event.value("name", std::string{});
+    if (name.size() <= kKernelTimeSuffix.size() ||
+        name.compare(name.size() - kKernelTimeSuffix.size(), kKernelTimeSuffix.size(), kKernelTimeSuffix) != 0) {
+      continue;
+    }
+    auto& [total, count] = total_costs[name.substr(0, name.size() - kKernelTimeSuffix.size())];
+    total += event.value("dur", 0.0);
+    ++count;
+  }
+
+  for (const auto& [name, total_cost] : total_costs) {
+    node_costs_[name] = total_cost.first / static_cast<double>(total_cost.second);
+  }
+}
+
 std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(const logging::Logger& logger,
                                                                              const PathString& config_file) {
   // use device based partitioner by default
@@ -2647,6 +3231,8 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
           auto type = json_config["type"];
           if (type == "DeviceBasedPartitioner") {
             partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
+          } else if (type == "CriticalPathPartitioner") {
+            partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition;
           }
         }
       } catch (const std::exception& ex) {
@@ -2658,6 +3244,8 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
   if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition) {
     LOGS(logger, INFO) << "Use DeviceBasedPartition as default";
     return std::make_unique<DeviceBasedPartitioner>(logger, config_file);
+  } else if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition) {
+    return std::make_unique<CriticalPathPartitioner>(logger, config_file);
   }  // else if other partitioner types ...
   ORT_THROW("Failed to create partitioner");
 }
@@ -13,6 +13,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
 #include "core/framework/bfc_arena.h"
+#include "core/framework/huge_page_allocator.h"
 
 namespace onnxruntime {
 using namespace common;
@@ -34,6 +35,9 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
     int64_t max_power_of_two_extend_bytes = info.arena_cfg.max_power_of_two_extend_bytes == -1
                                                 ? BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES
                                                 : info.arena_cfg.max_power_of_two_extend_bytes;
+    int64_t max_thread_cache_bytes = info.arena_cfg.max_thread_cache_bytes == -1
+                                         ? BFCArena::DEFAULT_MAX_THREAD_CACHE_BYTES
+                                         : info.arena_cfg.max_thread_cache_bytes;
     ArenaExtendStrategy arena_extend_str;
     switch (info.arena_cfg.arena_extend_strategy) {
       case static_cast<int>(ArenaExtendStrategy::kSameAsRequested):
@@ -49,6 +53,22 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
         return nullptr;
     }
 
+    if (info.arena_cfg.huge_pages > OrtArenaCfg::HugePages::kNone) {
+      const OrtDevice& device = device_allocator->Info().device;
+      if (device.Type() == OrtDevice::CPU && device.MemType() == OrtDevice::MemType::DEFAULT) {
+        size_t huge_page_size = 0;
+        if (info.arena_cfg.huge_pages == OrtArenaCfg::HugePages::k2MB) {
+          huge_page_size = size_t{2} * 1024 * 1024;
+        } else if (info.arena_cfg.huge_pages == OrtArenaCfg::HugePages::k1GB) {
+          huge_page_size = size_t{1} * 1024 * 1024 * 1024;
+        }
+        device_allocator = std::make_unique<HugePageAllocator>(std::move(device_allocator), huge_page_size);
+      } else {
+        LOGS_DEFAULT(WARNING) << "huge_pages is only supported by arenas of CPU memory, ignoring it for "
+                              << device_allocator->Info().name;
+      }
+    }
+
     if (info.use_stream_aware_arena) {
 #ifdef ORT_ENABLE_STREAM
       return AllocatorPtr(
@@ -70,7 +90,8 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                      initial_chunk_size_bytes,
                                      max_dead_bytes_per_chunk,
                                      initial_growth_chunk_size_bytes,
-                                     max_power_of_two_extend_bytes));
+                                     max_power_of_two_extend_bytes,
+                                     max_thread_cache_bytes));
     }
   } else {
     return device_allocator;
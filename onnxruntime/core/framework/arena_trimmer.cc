@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/arena_trimmer.h"
+
+#include <utility>
+
+#include "core/common/logging/logging.h"
+#include "core/framework/bfc_arena.h"
+
+namespace onnxruntime {
+
+ArenaTrimmer::ArenaTrimmer(std::vector<AllocatorPtr> arenas, std::chrono::milliseconds interval,
+                           std::chrono::milliseconds max_idle, size_t max_retained_bytes)
+    : arenas_{std::move(arenas)},
+      interval_{interval},
+      // a region freed during a pass has been idle for less than an interval at the next one
+      min_idle_passes_{static_cast<uint64_t>((max_idle.count() + interval.count() - 1) / interval.count())},
+      max_retained_bytes_{max_retained_bytes} {
+  ORT_ENFORCE(interval_.count() > 0, "The arena trim interval must be positive.");
+  thread_ = std::thread(&ArenaTrimmer::Run, this);
+}
+
+ArenaTrimmer::~ArenaTrimmer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  stop_cv_.notify_one();
+  thread_.join();
+}
+
+void ArenaTrimmer::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_cv_.wait_for(lock, interval_, [this] { return stop_; })) {
+    lock.unlock();
+    for (const auto& arena : arenas_) {
+      const size_t freed_bytes = static_cast<BFCArena*>(arena.get())->Trim(min_idle_passes_, max_retained_bytes_);
+      if (freed_bytes > 0) {
+        LOGS_DEFAULT(VERBOSE) << "Trimmed " << freed_bytes << " bytes of idle regions from the arena "
+                              << arena->Info().ToString();
+      }
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+/// <summary>
+/// Gives the memory of idle arena regions back from a background thread, instead of shrinking the arenas at the end
+/// of a run on the thread that made the request. Every interval, each arena is trimmed with BFCArena::Trim under its
+/// lock: the regions in which no chunk has been in use for max_idle are freed, then the idle regions beyond the
+/// max_retained_bytes budget of the arena. As the idle time is counted in trim passes, the result doesn't depend on
+/// the timing of the frees within an interval.
+/// </summary>
+class ArenaTrimmer {
+ public:
+  ArenaTrimmer(std::vector<AllocatorPtr> arenas, std::chrono::milliseconds interval,
+               std::chrono::milliseconds max_idle, size_t max_retained_bytes);
+
+  /// Stops the background thread. A trim pass in progress completes first.
+  ~ArenaTrimmer();
+
+ private:
+  void Run();
+
+  const std::vector<AllocatorPtr> arenas_;
+  const std::chrono::milliseconds interval_;
+  const uint64_t min_idle_passes_;
+  const size_t max_retained_bytes_;
+
+  std::mutex mutex_;
+  std::condition_variable stop_cv_;
+  bool stop_ = false;
+  std::thread thread_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ArenaTrimmer);
+};
+
+}  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
+#include <thread>
 #include <type_traits>
 
 namespace onnxruntime {
@@ -12,7 +14,8 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
                    int initial_growth_chunk_size_bytes,
-                   int64_t max_power_of_two_extend_bytes)
+                   int64_t max_power_of_two_extend_bytes,
+                   int64_t max_thread_cache_bytes)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -24,12 +27,14 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
       initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
-      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes) {
+      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes),
+      max_thread_cache_bytes_(max_thread_cache_bytes) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " max_power_of_two_extend_bytes: " << max_power_of_two_extend_bytes_
+                     << " max_thread_cache_bytes: " << max_thread_cache_bytes_
                      << " memory limit: " << total_memory
                      << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
 
@@ -57,6 +62,11 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
     // Do not consider the first allocation region for shrinkage
     consider_first_allocation_region_for_shrinkage_ = false;
   }
+
+  if (ThreadCacheEnabled()) {
+    thread_cache_shards_ = std::make_unique<ThreadCacheShard[]>(kNumThreadCacheShards);
+    thread_cache_allocations_ = std::make_unique<ThreadCacheAllocationShard[]>(kNumThreadCacheShards);
+  }
   // Create a bunch of bins of various good sizes.
 
   // We create bins to fit all possible ranges that cover the
@@ -210,6 +220,12 @@ Status BFCArena::Extend(size_t rounded_bytes) {
 
   LOGS_DEFAULT(INFO) << "Allocated memory at " << mem_addr << " to "
                      << static_cast<void*>(static_cast<char*>(mem_addr) + bytes);
+  AddRegion(mem_addr, bytes, nullptr);
+
+  return Status::OK();
+}
+
+void BFCArena::AddRegion(void* mem_addr, size_t bytes, Stream* stream) {
   region_manager_.AddAllocationRegion(mem_addr, bytes, stats_.num_arena_extensions);
   stats_.num_arena_extensions += 1;
 
@@ -222,8 +238,9 @@ Status BFCArena::Extend(size_t rounded_bytes) {
   c->allocation_id = -1;
   c->prev = kInvalidChunkHandle;
   c->next = kInvalidChunkHandle;
-  // assign the new created chunk to default stream, so it can be pick up by any stream
-  c->stream = nullptr;
+  // a chunk of the default stream (nullptr) can be picked up by any stream
+  c->stream = stream;
+  c->trim_pass = num_trim_passes_;
 
   region_manager_.set_handle(c->ptr, h);
 
@@ -233,7 +250,32 @@ Status BFCArena::Extend(size_t rounded_bytes) {
 
   // Insert the chunk into the right bin.
   InsertFreeChunkIntoBin(h);
+}
+
+Status BFCArena::ReserveRegion(size_t size, Stream* stream) {
+  if (size == 0) {
+    return Status::OK();
+  }
 
+  std::lock_guard<std::mutex> lock(lock_);
+  const size_t rounded_bytes = RoundedBytes(size);
+  const size_t available_bytes = memory_limit_ - static_cast<size_t>(stats_.total_allocated_bytes);
+  if (rounded_bytes > available_bytes) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Available memory of ", available_bytes,
+                           " is smaller than the reserved region of ", rounded_bytes, " bytes");
+  }
+
+  void* mem_addr = device_allocator_->Alloc(rounded_bytes);
+  if (mem_addr == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to allocate a reserved region of ", rounded_bytes, " bytes");
+  }
+
+  stats_.total_allocated_bytes += rounded_bytes;
+  LOGS_DEFAULT(INFO) << "Reserved a region of " << rounded_bytes << " bytes in BFCArena for "
+                     << device_allocator_->Info().name << ". Total allocated bytes: "
+                     << stats_.total_allocated_bytes;
+
+  AddRegion(mem_addr, rounded_bytes, stream);
   return Status::OK();
 }
 
@@ -268,9 +310,116 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (ThreadCacheEnabled() && size != 0 && size <= kMaxThreadCacheChunkSize) {
+    return AllocateFromThreadCache(size);
+  }
   return AllocateRawInternal(size, false, nullptr, false, nullptr);
 }
 
+// static
+int BFCArena::ThreadCacheSizeClass(size_t rounded_bytes) {
+  int size_class = 0;
+  while ((kMinAllocationSize << size_class) < rounded_bytes) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+BFCArena::ThreadCacheShard& BFCArena::ThreadCacheShardForCurrentThread() {
+  thread_local const size_t shard_index =
+      std::hash<std::thread::id>{}(std::this_thread::get_id()) % kNumThreadCacheShards;
+  return thread_cache_shards_[shard_index];
+}
+
+void* BFCArena::AllocateFromThreadCache(size_t num_bytes) {
+  const int size_class = ThreadCacheSizeClass(RoundedBytes(num_bytes));
+  const size_t class_bytes = kMinAllocationSize << size_class;
+
+  ThreadCacheShard& shard = ThreadCacheShardForCurrentThread();
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& free_list = shard.free_lists[size_class];
+    if (!free_list.empty()) {
+      void* p = free_list.back();
+      free_list.pop_back();
+      shard.cached_bytes -= class_bytes;
+      thread_cache_bytes_ -= static_cast<int64_t>(class_bytes);
+      ++num_thread_cache_hits_;
+      return p;
+    }
+  }
+
+  // Miss. Allocate a chunk of the full size class from the bins so it can be reused for any request of that class.
+  void* p = AllocateRawInternal(class_bytes, false, nullptr, false, nullptr);
+  ThreadCacheAllocationShard& allocation_shard = ThreadCacheAllocationShardFor(p);
+  std::lock_guard<std::mutex> lock(allocation_shard.mutex);
+  allocation_shard.size_classes[p] = size_class;
+  return p;
+}
+
+bool BFCArena::FreeToThreadCache(void* p) {
+  ThreadCacheAllocationShard& allocation_shard = ThreadCacheAllocationShardFor(p);
+  int size_class = 0;
+  {
+    std::lock_guard<std::mutex> lock(allocation_shard.mutex);
+    auto it = allocation_shard.size_classes.find(p);
+    if (it == allocation_shard.size_classes.end()) {
+      return false;
+    }
+    size_class = it->second;
+  }
+
+  const size_t class_bytes = kMinAllocationSize << size_class;
+  ThreadCacheShard& shard = ThreadCacheShardForCurrentThread();
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.cached_bytes + class_bytes <= static_cast<size_t>(max_thread_cache_bytes_)) {
+      shard.free_lists[size_class].push_back(p);
+      shard.cached_bytes += class_bytes;
+      thread_cache_bytes_ += static_cast<int64_t>(class_bytes);
+      return true;
+    }
+  }
+
+  // The shard is full so return the chunk to the bins.
+  {
+    std::lock_guard<std::mutex> lock(allocation_shard.mutex);
+    allocation_shard.size_classes.erase(p);
+  }
+  std::lock_guard<std::mutex> lock(lock_);
+  DeallocateRawInternal(p);
+  return true;
+}
+
+void BFCArena::FlushThreadCache() {
+  if (!ThreadCacheEnabled()) {
+    return;
+  }
+
+  std::vector<void*> cached_ptrs;
+  for (int i = 0; i < kNumThreadCacheShards; ++i) {
+    ThreadCacheShard& shard = thread_cache_shards_[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto& free_list : shard.free_lists) {
+      cached_ptrs.insert(cached_ptrs.end(), free_list.begin(), free_list.end());
+      free_list.clear();
+    }
+    thread_cache_bytes_ -= static_cast<int64_t>(shard.cached_bytes);
+    shard.cached_bytes = 0;
+  }
+
+  for (void* p : cached_ptrs) {
+    ThreadCacheAllocationShard& allocation_shard = ThreadCacheAllocationShardFor(p);
+    std::lock_guard<std::mutex> lock(allocation_shard.mutex);
+    allocation_shard.size_classes.erase(p);
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  for (void* p : cached_ptrs) {
+    DeallocateRawInternal(p);
+  }
+}
+
 void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
@@ -378,6 +527,10 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<std::mutex> lock(lock_);
   *stats = stats_;
+  // allocations served by the thread cache never reach the bins so add them to the total here
+  stats->num_thread_cache_hits = num_thread_cache_hits_;
+  stats->num_allocs += stats->num_thread_cache_hits;
+  stats->thread_cache_bytes = thread_cache_bytes_;
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -464,6 +617,7 @@ void BFCArena::SplitChunk(BFCArena::ChunkHandle h, size_t num_bytes) {
   // set the new chunk's stream and timestamp
   new_chunk->stream = c->stream;
   new_chunk->stream_timestamp = c->stream_timestamp;
+  new_chunk->trim_pass = c->trim_pass;
 
   new_chunk->ptr = static_cast<void*>(static_cast<char*>(c->ptr) + num_bytes);
   region_manager_.set_handle(new_chunk->ptr, h_new_chunk);
@@ -495,6 +649,9 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+  if (ThreadCacheEnabled() && FreeToThreadCache(p)) {
+    return;
+  }
   std::lock_guard<std::mutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -508,6 +665,9 @@ void BFCArena::Free(void* p) {
 }
 
 Status BFCArena::Shrink() {
+  // cached chunks are in use from the point of view of the bins and would keep their regions alive
+  FlushThreadCache();
+
   std::lock_guard<std::mutex> lock(lock_);
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
@@ -539,27 +699,7 @@ Status BFCArena::Shrink() {
     }
 
     if (deallocate_region) {
-      auto shrink_size = region_sizes[i];
-      stats_.num_arena_shrinkages += 1;
-      stats_.total_allocated_bytes -= shrink_size;
-
-      LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena shrunk by "
-                            << shrink_size << " bytes. "
-                            << " The total allocated bytes is now " << stats_.total_allocated_bytes;
-
-      h = region_begin_chunk;
-      ChunkHandle temp = region_begin_chunk;
-      while (h != kInvalidChunkHandle) {
-        const Chunk* c = ChunkFromHandle(h);
-        temp = c->next;
-        RemoveFreeChunkFromBin(h);
-        DeleteChunk(h);
-        h = temp;
-      }
-
-      device_allocator_->Free(region_ptr);
-      region_manager_.RemoveAllocationRegion(region_ptr);
-      stats_.num_arena_extensions--;
+      FreeRegion(region_ptr, region_sizes[i]);
     }
 
     ++i;
@@ -572,6 +712,80 @@ Status BFCArena::Shrink() {
   return Status::OK();
 }
 
+size_t BFCArena::Trim(uint64_t min_idle_passes, size_t max_retained_bytes) {
+  std::lock_guard<std::mutex> lock(lock_);
+  const uint64_t current_pass = ++num_trim_passes_;
+
+  // the regions in which no chunk is in use, with the pass their last chunk was freed in
+  struct IdleRegion {
+    void* ptr;
+    size_t size;
+    uint64_t last_freed_pass;
+  };
+  std::vector<IdleRegion> idle_regions;
+  for (const auto& region : region_manager_.regions()) {
+    if (!consider_first_allocation_region_for_shrinkage_ && region.id() == 0) {
+      continue;
+    }
+
+    bool in_use = false;
+    uint64_t last_freed_pass = 0;
+    for (ChunkHandle h = region_manager_.get_handle(region.ptr()); h != kInvalidChunkHandle;) {
+      const Chunk* c = ChunkFromHandle(h);
+      if (c->in_use()) {
+        in_use = true;
+        break;
+      }
+      last_freed_pass = std::max(last_freed_pass, c->trim_pass);
+      h = c->next;
+    }
+
+    if (!in_use) {
+      idle_regions.push_back({region.ptr(), region.memory_size(), last_freed_pass});
+    }
+  }
+
+  // the regions idle the longest go first
+  std::stable_sort(idle_regions.begin(), idle_regions.end(), [](const IdleRegion& a, const IdleRegion& b) {
+    return a.last_freed_pass < b.last_freed_pass;
+  });
+
+  size_t freed_bytes = 0;
+  for (const auto& region : idle_regions) {
+    const bool expired = current_pass - region.last_freed_pass > min_idle_passes;
+    const bool over_budget = static_cast<size_t>(stats_.total_allocated_bytes) > max_retained_bytes;
+    if (!expired && !over_budget) {
+      break;
+    }
+    FreeRegion(region.ptr, region.size);
+    freed_bytes += region.size;
+  }
+
+  return freed_bytes;
+}
+
+void BFCArena::FreeRegion(void* region_ptr, size_t region_size) {
+  stats_.num_arena_shrinkages += 1;
+  stats_.total_allocated_bytes -= region_size;
+
+  LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena shrunk by "
+                        << region_size << " bytes. "
+                        << " The total allocated bytes is now " << stats_.total_allocated_bytes;
+
+  ChunkHandle h = region_manager_.get_handle(region_ptr);
+  while (h != kInvalidChunkHandle) {
+    const Chunk* c = ChunkFromHandle(h);
+    ChunkHandle next = c->next;
+    RemoveFreeChunkFromBin(h);
+    DeleteChunk(h);
+    h = next;
+  }
+
+  device_allocator_->Free(region_ptr);
+  region_manager_.RemoveAllocationRegion(region_ptr);
+  stats_.num_arena_extensions--;
+}
+
 void BFCArena::DeallocateRawInternal(void* ptr) {
   // Find the chunk from the ptr.
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
@@ -609,6 +823,7 @@ void BFCArena::Merge(BFCArena::ChunkHandle h1,
   // Set the new size
   c1->size += c2->size;
   c1->stream_timestamp = std::max(c1->stream_timestamp, c2->stream_timestamp);
+  c1->trim_pass = std::max(c1->trim_pass, c2->trim_pass);
 
   DeleteChunk(h2);
 }
@@ -654,6 +869,7 @@ void BFCArena::FreeAndMaybeCoalesce(BFCArena::ChunkHandle h) {
 
   // Mark the chunk as no longer in use
   c->allocation_id = -1;
+  c->trim_pass = num_trim_passes_;
 
   // Updates the stats.
   stats_.bytes_in_use -= c->size;
@@ -16,9 +16,12 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "onnxruntime_config.h"
 
@@ -61,6 +64,7 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const int64_t DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES = 1024 * 1024 * 1024;  // 1GB
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  static const int64_t DEFAULT_MAX_THREAD_CACHE_BYTES = 0;  // thread cache disabled
 
   enum ArenaType {
     BaseArena,
@@ -73,7 +77,8 @@ class BFCArena : public IAllocator {
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
            int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           int64_t max_thread_cache_bytes = DEFAULT_MAX_THREAD_CACHE_BYTES);
 
   ~BFCArena() override;
 
@@ -85,7 +90,11 @@ class BFCArena : public IAllocator {
   // If p is NULL, no operation is performed.
   void Free(void* p) override;
 
+  // Returns all chunks held in the thread cache to the arena.
+  void FlushThreadCache();
+
   // Frees all allocation regions in which no chunk is in use.
+  // Chunks held in the thread cache are returned to the arena first.
   // Does not free any reserved chunks.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
@@ -93,8 +102,21 @@ class BFCArena : public IAllocator {
   // and the allocation request.
   Status Shrink();
 
+  // Counts a trim pass and frees the allocation regions in which no chunk has been in use for more than
+  // `min_idle_passes` passes. Then, while the arena holds more than `max_retained_bytes`, frees the other regions
+  // in which no chunk is in use, starting with the ones idle the longest. Unlike Shrink(), chunks held in the thread
+  // cache stay there and the size the arena grows by is kept. Meant to be called periodically, e.g. by ArenaTrimmer.
+  // Returns the number of bytes freed.
+  size_t Trim(uint64_t min_idle_passes, size_t max_retained_bytes);
+
   void* Reserve(size_t size) override;
 
+  // Adds a region of exactly `size` bytes (rounded up to the allocation granularity) to the arena, as free memory the
+  // allocations of `stream` can be carved from, or those of any stream if it is nullptr. Unlike Reserve(), the memory
+  // is part of the arena: it lets a workload whose peak is known get one contiguous region up front, instead of the
+  // regions the extend strategy would grow the arena by. The size of the next extension is unchanged.
+  Status ReserveRegion(size_t size, Stream* stream = nullptr);
+
   void GetStats(AllocatorStats* stats) override;
 
   size_t RequestedSize(const void* ptr);
@@ -123,6 +145,48 @@ class BFCArena : public IAllocator {
  private:
   void DeallocateRawInternal(void* ptr);
 
+  // Returns the memory of a region in which no chunk is in use to the device allocator.
+  void FreeRegion(void* region_ptr, size_t region_size);
+
+  // Thread cache for small allocations made without a stream.
+  //
+  // Chunks freed by the client are parked in a cache shard selected by the freeing thread instead of being
+  // returned to the bins, so that a subsequent allocation of the same size class from that thread can be served
+  // while only taking the (practically uncontended) shard lock. From the point of view of the bins a cached chunk
+  // is still in use; it is returned to the bins when the shard is full, on FlushThreadCache() and on Shrink().
+  static constexpr int kNumThreadCacheShards = 32;
+  static constexpr int kNumThreadCacheSizeClasses = 9;  // 256 bytes to 64KB in powers of two
+  static constexpr size_t kMaxThreadCacheChunkSize = static_cast<size_t>(256) << (kNumThreadCacheSizeClasses - 1);
+
+  struct ThreadCacheShard {
+    std::mutex mutex;
+    std::array<std::vector<void*>, kNumThreadCacheSizeClasses> free_lists;
+    size_t cached_bytes = 0;
+  };
+
+  // Ptrs handed out with a size class rounded allocation, sharded by address so Free() can find the size class
+  // without taking lock_.
+  struct ThreadCacheAllocationShard {
+    std::mutex mutex;
+    std::unordered_map<void*, int> size_classes;
+  };
+
+  bool ThreadCacheEnabled() const { return max_thread_cache_bytes_ > 0; }
+
+  static int ThreadCacheSizeClass(size_t rounded_bytes);
+
+  ThreadCacheShard& ThreadCacheShardForCurrentThread();
+
+  ThreadCacheAllocationShard& ThreadCacheAllocationShardFor(const void* p) {
+    return thread_cache_allocations_[(reinterpret_cast<std::uintptr_t>(p) >> kMinAllocationBits) %
+                                     kNumThreadCacheShards];
+  }
+
+  void* AllocateFromThreadCache(size_t num_bytes);
+
+  // Returns true if p was allocated through the thread cache and is now owned by it.
+  bool FreeToThreadCache(void* p);
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   using ChunkHandle = size_t;
@@ -170,6 +234,9 @@ class BFCArena : public IAllocator {
 
     uint64_t stream_timestamp = 0;
 
+    // The number of Trim() passes when the chunk was last freed or added to the arena.
+    uint64_t trim_pass = 0;
+
     bool in_use() const { return allocation_id != -1; }
 
     std::string DebugString(BFCArena* a, bool recurse) {
@@ -369,6 +436,9 @@ class BFCArena : public IAllocator {
   // 'rounded_bytes' bytes.
   Status Extend(size_t rounded_bytes);
 
+  // Adds the memory allocated from the device allocator as a new region with one free chunk for `stream`.
+  void AddRegion(void* mem_addr, size_t bytes, Stream* stream);
+
   // Returns an underlying allocated chunk of size
   // 'rounded_bytes'.
   BFCArena::Chunk* FindChunkPtr(BinNum bin_num,
@@ -514,6 +584,15 @@ class BFCArena : public IAllocator {
   // is to be considered for shrinkage or not.
   bool consider_first_allocation_region_for_shrinkage_;
 
+  // The number of calls of Trim().
+  uint64_t num_trim_passes_ = 0;
+
+  const int64_t max_thread_cache_bytes_;
+  std::unique_ptr<ThreadCacheShard[]> thread_cache_shards_;
+  std::unique_ptr<ThreadCacheAllocationShard[]> thread_cache_allocations_;
+  std::atomic<int64_t> num_thread_cache_hits_{0};
+  std::atomic<int64_t> thread_cache_bytes_{0};
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 #ifdef ORT_ENABLE_STREAM
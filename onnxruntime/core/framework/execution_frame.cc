@@ -5,6 +5,7 @@
 
 #include <sstream>
 
+#include "core/common/safeint.h"
 #include "core/framework/mem_pattern_planner.h"
 #include "core/framework/execution_plan_base.h"
 #include "core/framework/sequential_execution_plan.h"
@@ -357,7 +358,7 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
       device_streams_(device_streams),
 #endif
       session_state_(session_state),
-      mem_patterns_(nullptr) {
+      mem_patterns_() {
   Init(
       feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -551,8 +552,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       if (block) {
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // the pattern buffer is allocated for the whole run anyway, so any block large enough can be used.
+          // this allows a pattern generated for the upper end of a shape bucket to serve all shapes in the bucket.
+          // if the block is too small, log message then fall back to default behavior
+          if (size <= block->size_) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
@@ -561,8 +564,6 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
           } else {
             // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
             // fed in, so use VERBOSE as the log level as it's expected.
-            // TODO: Should we reuse the block if the size is large enough? Would probably need to allow it
-            // to be freed if the size difference was too large so our memory usage doesn't stick at a high water mark
             LOGS(session_state_.Logger(), VERBOSE) << "For ort_value with index: " << ort_value_index
                                                    << ", block in memory pattern size is: " << block->size_
                                                    << " but the actual size is: " << size
@@ -589,6 +590,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
           current_stream->GetDevice(), current_stream->GetDevice());
       void* p_data = stream_aware_alloc->AllocOnStream(buffer_size, current_stream, wait_handle);
       Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
+    } else if (alloc->IsStreamAware()) {
+      size_t buffer_size = Tensor::CalculateTensorStorageSize(element_type, shape);
+      void* p_data = alloc->AllocOnStream(buffer_size, current_stream);
+      Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
     } else {
       Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
     }
@@ -618,7 +623,7 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   }
 
 #if !defined(ORT_MINIMAL_BUILD)
-  if (session_state_.GetNodeStatsRecorder() != nullptr) {
+  if (session_state_.GetNodeStatsRecorder() != nullptr || session_state_.GetNodeMemoryStatsCollector() != nullptr) {
     ort_value_to_dynamic_allocations_size_.insert_or_assign(ort_value_index, size);
   }
 #endif
@@ -670,6 +675,33 @@ Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_valu
   return AllocateTensorWithPreAllocateBufferHelper(ort_value, reuse_buffer, element_type, location, shape);
 }
 
+Status ExecutionFrame::AllocateSliceOfReusedBuffer(OrtValue& ort_value, int ort_value_index_reuse, size_t offset,
+                                                   MLDataType element_type, const OrtDevice& location,
+                                                   const TensorShape& shape) {
+  // The buffer is allocated when the first of its slices is. The planner only plans slices of buffers with a static
+  // shape (the output of a Concat whose inputs are written in place), so the shape comes from the graph.
+  OrtValue& ort_value_reuse = GetMutableMLValue(ort_value_index_reuse);
+  if (!ort_value_reuse.IsAllocated()) {
+    std::string name;
+    ORT_RETURN_IF_ERROR(session_state_.GetOrtValueNameIdxMap().GetName(ort_value_index_reuse, name));
+    const auto* node_arg = session_state_.GetGraphViewer().GetNodeArg(name);
+    ORT_RETURN_IF_NOT(node_arg != nullptr && node_arg->Shape() != nullptr, "No static shape for the buffer ", name);
+    const TensorShape reuse_shape = utils::GetTensorShapeFromTensorShapeProto(*node_arg->Shape());
+    ORT_RETURN_IF_ERROR(AllocateAsPerAllocationPlan(ort_value_reuse, ort_value_index_reuse, &reuse_shape));
+  }
+
+  auto* reuse_tensor = ort_value_reuse.GetMutable<Tensor>();
+  const size_t slice_size = SafeInt<size_t>(shape.Size()) * element_type->Size();
+  if (SafeInt<size_t>(offset) + slice_size > reuse_tensor->SizeInBytes()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Slice of ", slice_size, " bytes at offset ", offset,
+                           " is out of the bounds of the reused buffer of shape ", reuse_tensor->Shape(),
+                           ". Validate the static shapes in the model.");
+  }
+
+  void* slice_buffer = static_cast<uint8_t*>(reuse_tensor->MutableDataRaw()) + offset;
+  return AllocateTensorWithPreAllocateBufferHelper(ort_value, slice_buffer, element_type, location, shape);
+}
+
 Status ExecutionFrame::AllocateTensorWithPreAllocateBufferHelper(OrtValue& ort_value, void* pBuffer,
                                                                  MLDataType element_type,
                                                                  const OrtDevice& location,
@@ -769,6 +801,13 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
       case AllocKind::kReuse: {
         int reuse_mlvalue_index = per_alloc_plan.reused_buffer;
 
+        if (per_alloc_plan.is_slice_of_reused_buffer) {
+          ORT_RETURN_IF_ERROR(AllocateSliceOfReusedBuffer(ort_value, reuse_mlvalue_index,
+                                                          per_alloc_plan.reused_buffer_offset, ml_data_type,
+                                                          alloc_info, *shape));
+          break;
+        }
+
         ORT_RETURN_IF_ERROR(AllocateReusedOrtValueIfNotAllocatedHelper(reuse_mlvalue_index, shape));
 
         bool is_strided_tensor = false;
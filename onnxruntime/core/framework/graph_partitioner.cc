@@ -5,8 +5,10 @@
 
 #include <cassert>
 #include <functional>
+#include <limits>
 
 #include "core/common/inlined_containers.h"
+#include "core/common/parse_string.h"
 #include "core/common/string_utils.h"
 #include "core/framework/compute_capability.h"
 #include "core/framework/execution_providers.h"
@@ -412,6 +414,93 @@ static Node* PlaceNode(Graph& graph, const IndexedSubGraph& capability,
   return result;
 }
 
+// Removes the single node capabilities in connected groups of fewer than min_group_size nodes, so that these nodes
+// are left to the next EP. Two nodes are connected if one consumes an output of the other and the EP can run both.
+static void DropSmallNodeGroups(Graph& graph, std::vector<std::unique_ptr<ComputeCapability>>& capabilities,
+                                GraphPartitioner::Mode mode, const std::string& ep_type, size_t min_group_size,
+                                const logging::Logger& logger) {
+  constexpr size_t kNoGroup = std::numeric_limits<size_t>::max();
+
+  InlinedHashMap<NodeIndex, size_t> group_of_node;
+  for (const auto& capability : capabilities) {
+    const IndexedSubGraph& sub_graph = *capability->sub_graph;
+    if (sub_graph.GetMetaDef() == nullptr && sub_graph.nodes.size() == 1 &&
+        IsIndexedSubGraphAvailableForAssignment(graph, sub_graph, mode, ep_type)) {
+      group_of_node.emplace(sub_graph.nodes[0], kNoGroup);
+    }
+  }
+
+  // label the groups with a traversal from each node not labeled yet
+  std::vector<size_t> group_sizes;
+  std::vector<NodeIndex> to_visit;
+  for (auto& [start, start_group] : group_of_node) {
+    if (start_group != kNoGroup) {
+      continue;
+    }
+
+    const size_t group = group_sizes.size();
+    size_t group_size = 0;
+    start_group = group;
+    to_visit.push_back(start);
+    while (!to_visit.empty()) {
+      const Node* node = graph.GetNode(to_visit.back());
+      to_visit.pop_back();
+      ++group_size;
+
+      auto visit = [&](const Node& neighbor) {
+        auto it = group_of_node.find(neighbor.Index());
+        if (it != group_of_node.end() && it->second == kNoGroup) {
+          it->second = group;
+          to_visit.push_back(neighbor.Index());
+        }
+      };
+      for (auto it = node->InputNodesBegin(), end = node->InputNodesEnd(); it != end; ++it) {
+        visit(*it);
+      }
+      for (auto it = node->OutputNodesBegin(), end = node->OutputNodesEnd(); it != end; ++it) {
+        visit(*it);
+      }
+    }
+    group_sizes.push_back(group_size);
+  }
+
+  size_t dropped_groups = 0;
+  size_t dropped_nodes = 0;
+  for (size_t size : group_sizes) {
+    if (size < min_group_size) {
+      ++dropped_groups;
+      dropped_nodes += size;
+    }
+  }
+
+  LOGS(logger, INFO) << ep_type << " can run " << group_of_node.size() << " nodes in " << group_sizes.size()
+                     << " groups of graph '" << graph.Name() << "'. " << dropped_nodes << " nodes in "
+                     << dropped_groups << " groups of fewer than " << min_group_size
+                     << " nodes are left to the next execution provider.";
+
+  if (dropped_groups == 0) {
+    return;
+  }
+
+  capabilities.erase(
+      std::remove_if(capabilities.begin(), capabilities.end(),
+                     [&](const std::unique_ptr<ComputeCapability>& capability) {
+                       const IndexedSubGraph& sub_graph = *capability->sub_graph;
+                       if (sub_graph.GetMetaDef() != nullptr || sub_graph.nodes.size() != 1) {
+                         return false;
+                       }
+                       auto it = group_of_node.find(sub_graph.nodes[0]);
+                       if (it == group_of_node.end() || group_sizes[it->second] >= min_group_size) {
+                         return false;
+                       }
+                       const Node* node = graph.GetNode(sub_graph.nodes[0]);
+                       LOGS(logger, INFO) << "Node '" << node->Name() << "' (" << node->OpType() << ") in a group of "
+                                          << group_sizes[it->second] << " nodes is not assigned to " << ep_type;
+                       return true;
+                     }),
+      capabilities.end());
+}
+
 // for the current EP, recursively iterate through the Graph and any nested subgraphs (recursion is bottom-up).
 // assign any nodes to the EP that are currently unassigned, and that the EP can handle.
 static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
@@ -425,7 +514,7 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
                                            const CheckLoadCancellationFn& check_load_cancellation_fn,
                                            const logging::Logger& logger, IResourceAccountant* resource_accountant,
                                            const GraphOptimizerRegistry& graph_optimizer_registry,
-                                           bool disable_model_compile) {
+                                           bool disable_model_compile, size_t min_ep_node_group_size) {
   // handle testing edge case where optimizers or constant lifting results in graph with no nodes.
   // doing it here saves all providers checking for this in GetCapability
   if (graph.NumberOfNodes() == 0) {
@@ -442,7 +531,8 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
                                                        transform_layout_fn, debug_graph_fn,
                                                        check_load_cancellation_fn,
                                                        logger, resource_accountant,
-                                                       graph_optimizer_registry, disable_model_compile));
+                                                       graph_optimizer_registry, disable_model_compile,
+                                                       min_ep_node_group_size));
     }
   }
 
@@ -471,6 +561,13 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
       std::cref(check_load_cancellation_fn)};
 
   ORT_RETURN_IF_ERROR(GetCapabilityForEP(get_capability_params, logger));
+
+  // The nodes of an EP preferring NHWC may be transformed to its layout already, so they must stay with it.
+  if (min_ep_node_group_size > 1 && current_ep.Type() != kCpuExecutionProvider &&
+      current_ep.GetPreferredLayout() != DataLayout::NHWC) {
+    DropSmallNodeGroups(graph, capabilities, mode, current_ep.Type(), min_ep_node_group_size, logger);
+  }
+
   if (capabilities.empty()) {
     return Status::OK();
   }
@@ -793,10 +890,10 @@ static Status GetValidatedEpContextPath(const std::filesystem::path& ep_context_
   return Status::OK();
 }
 
-static Status CreateEpContextModel(const ExecutionProviders& execution_providers,
-                                   const Graph& graph,
-                                   const EpContextModelGenerationOptions& ep_context_gen_options,
-                                   const logging::Logger& logger) {
+Status GraphPartitioner::CreateEpContextModel(const ExecutionProviders& execution_providers,
+                                              const Graph& graph,
+                                              const EpContextModelGenerationOptions& ep_context_gen_options,
+                                              const logging::Logger& logger) {
   InlinedVector<const Node*> all_ep_context_nodes;
   for (const auto& ep : execution_providers) {
     const InlinedVector<const Node*> ep_context_nodes = ep->GetEpContextNodes();
@@ -952,7 +1049,8 @@ static Status PartitionOnnxFormatModel(const PartitionParams& partition_params,
                                        KernelRegistryManager& kernel_registry_manager,
                                        const std::optional<ResourceAccountantMap>& acc_map,
                                        const GraphOptimizerRegistry& graph_optimizer_registry,
-                                       const logging::Logger& logger, bool disable_model_compile) {
+                                       const logging::Logger& logger, bool disable_model_compile,
+                                       size_t min_ep_node_group_size) {
   bool modified_graph = false;
 
   auto& graph = partition_params.graph.get();
@@ -978,7 +1076,7 @@ static Status PartitionOnnxFormatModel(const PartitionParams& partition_params,
                                                        partition_params.debug_graph_fn,
                                                        check_load_cancellation_fn,
                                                        logger, resource_accountant, graph_optimizer_registry,
-                                                       disable_model_compile));
+                                                       disable_model_compile, min_ep_node_group_size));
     }
 
     // expand any nodes that have an ONNX function definition but no matching ORT kernel.
@@ -1253,11 +1351,21 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
     ORT_RETURN_IF_ERROR(NodeStatsRecorder::CreateAccountants(config_options, graph.ModelPath(), ep_acc_map));
 
     bool disable_model_compile = config_options.GetConfigOrDefault(kOrtSessionOptionsDisableModelCompile, "0") == "1";
+
+    size_t min_ep_node_group_size = 0;
+    const std::string min_ep_node_group_size_str =
+        config_options.GetConfigOrDefault(kOrtSessionOptionsMinEpNodeGroupSize, "0");
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(min_ep_node_group_size_str, min_ep_node_group_size),
+                      "Failed to parse ", kOrtSessionOptionsMinEpNodeGroupSize, ": ", min_ep_node_group_size_str);
+
     ORT_RETURN_IF_ERROR(PartitionOnnxFormatModel(partition_params, mode, providers_, kernel_registry_mgr_,
                                                  ep_acc_map, *graph_optimizer_registry_, logger,
-                                                 disable_model_compile));
+                                                 disable_model_compile, min_ep_node_group_size));
 
-    if (ep_context_gen_options.enable) {
+    // the session creates the EP context model after the graph optimizations if the CPU nodes are to be optimized
+    const bool optimize_cpu_nodes =
+        config_options.GetConfigOrDefault(kOrtSessionOptionEpContextOptimizeCpuNodes, "0") == "1";
+    if (ep_context_gen_options.enable && !optimize_cpu_nodes) {
       ORT_RETURN_IF_ERROR(CreateEpContextModel(providers_, graph, ep_context_gen_options, logger));
     }
 #else
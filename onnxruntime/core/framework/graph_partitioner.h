@@ -77,6 +77,17 @@ class GraphPartitioner {
                             const ExecutionProviders& execution_providers,
                             const KernelRegistryManager& kernel_registry_manager,
                             const logging::Logger& logger) const;
+
+  /// <summary>
+  /// Creates the EP context model from a partitioned graph, replacing the nodes fused by the execution providers
+  /// with their EPContext nodes, and saves it as specified by ep_context_gen_options.
+  /// Called by Partition(), or by the session after the graph optimizations if
+  /// kOrtSessionOptionEpContextOptimizeCpuNodes is set.
+  /// </summary>
+  static Status CreateEpContextModel(const ExecutionProviders& execution_providers,
+                                     const Graph& graph,
+                                     const EpContextModelGenerationOptions& ep_context_gen_options,
+                                     const logging::Logger& logger);
 #endif
 
  private:
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/huge_page_allocator.h"
+
+#include "core/common/logging/logging.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+HugePageAllocator::HugePageAllocator(std::unique_ptr<IAllocator> fallback_allocator, size_t huge_page_size)
+    : IAllocator(fallback_allocator->Info()),
+      fallback_allocator_(std::move(fallback_allocator)),
+      huge_page_size_(huge_page_size) {
+}
+
+HugePageAllocator::~HugePageAllocator() {
+  for (const auto& [p, size] : mapped_sizes_) {
+    Env::Default().FreeHugePages(p, size);
+  }
+}
+
+void* HugePageAllocator::TryAllocHugePages(size_t size, size_t page_size) {
+  const size_t granularity = page_size == 0 ? kTransparentHugePageSize : page_size;
+  if (size < granularity) {
+    return nullptr;
+  }
+
+  const size_t mapped_size = (size + granularity - 1) / granularity * granularity;
+  void* p = Env::Default().AllocateHugePages(mapped_size, page_size);
+  if (p != nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    mapped_sizes_.emplace(p, mapped_size);
+  }
+  return p;
+}
+
+void* HugePageAllocator::Alloc(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  // MLAS kernels may read a little past the end of a buffer, as in AllocatorDefaultAllocAligned
+  const size_t padded_size = size + MLAS_SYMM_QGEMM_BUF_OVERRUN;
+
+  if (huge_page_size_ != 0) {
+    if (void* p = TryAllocHugePages(padded_size, huge_page_size_)) {
+      return p;
+    }
+    if (padded_size >= huge_page_size_ && !warned_explicit_pages_unavailable_.exchange(true)) {
+      LOGS_DEFAULT(WARNING) << "Could not allocate " << padded_size << " bytes of huge pages of " << huge_page_size_
+                            << " bytes, using transparent huge pages or regular pages instead. "
+                            << "Check the size of the huge page pool, e.g. /proc/sys/vm/nr_hugepages.";
+    }
+  }
+
+  if (void* p = TryAllocHugePages(padded_size, 0)) {
+    return p;
+  }
+
+  return fallback_allocator_->Alloc(size);
+}
+
+void HugePageAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  size_t mapped_size = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = mapped_sizes_.find(p);
+    if (it != mapped_sizes_.end()) {
+      mapped_size = it->second;
+      mapped_sizes_.erase(it);
+    }
+  }
+
+  if (mapped_size != 0) {
+    Env::Default().FreeHugePages(p, mapped_size);
+  } else {
+    fallback_allocator_->Free(p);
+  }
+}
+
+size_t HugePageAllocator::HugePageBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t bytes = 0;
+  for (const auto& entry : mapped_sizes_) {
+    bytes += entry.second;
+  }
+  return bytes;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+/// <summary>
+/// CPU device allocator for the regions of an arena that backs them with huge pages, so large weights and
+/// activations need a fraction of the TLB entries of 4 KB pages. Allocations of at least a huge page are mapped
+/// from the explicit huge pages of huge_page_size bytes (hugetlbfs on Linux, large pages on Windows) if
+/// huge_page_size is not 0, else or when none are left from the transparent huge pages of the OS. Smaller
+/// allocations, and all of them when the platform has no huge pages, are served by the wrapped allocator.
+/// </summary>
+class HugePageAllocator : public IAllocator {
+ public:
+  // The size of the transparent huge pages of x64 and of aarch64 with 4 KB base pages.
+  static constexpr size_t kTransparentHugePageSize = 2 * 1024 * 1024;
+
+  HugePageAllocator(std::unique_ptr<IAllocator> fallback_allocator, size_t huge_page_size);
+  ~HugePageAllocator() override;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HugePageAllocator);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+  // Returns the number of bytes currently mapped from huge pages.
+  size_t HugePageBytes() const;
+
+ private:
+  void* TryAllocHugePages(size_t size, size_t page_size);
+
+  std::unique_ptr<IAllocator> fallback_allocator_;
+  const size_t huge_page_size_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<void*, size_t> mapped_sizes_;  // the allocations backed by huge pages
+  std::atomic<bool> warned_explicit_pages_unavailable_{false};
+};
+
+}  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -174,6 +175,25 @@ bool KernelRegistry::VerifyKernelDef(const Node& node,
   return matched;
 }
 
+std::string KernelRegistry::GetLookupCacheKey(const Node& node, std::string_view provider) {
+  std::string key = GetMapKey(node.OpType(), node.Domain(), provider);
+  key.append(1, ' ').append(std::to_string(node.SinceVersion()));
+  for (int count : node.InputArgCount()) {
+    key.append(1, ' ').append(std::to_string(count));
+  }
+
+  auto append_types = [&key](ConstPointerContainer<std::vector<NodeArg*>> args) {
+    key.append(" |");
+    for (const NodeArg* arg : args) {
+      const std::string* type = arg != nullptr && arg->Exists() ? arg->Type() : nullptr;
+      key.append(1, ' ').append(type != nullptr ? *type : "-");
+    }
+  };
+  append_types(node.InputDefs());
+  append_types(node.OutputDefs());
+  return key;
+}
+
 // It's often this function returns a failed status, but it is totally expected.
 // It just means this registry doesn't have such a kernel, please search it elsewhere.
 // if this function is called before graph partition, then node.provider is not set.
@@ -187,34 +207,62 @@ Status KernelRegistry::TryFindKernelImpl(const Node& node,
                                          const KernelCreateInfo** out) const {
   const auto& node_provider = node.GetExecutionProviderType();
   const auto& expected_provider = (node_provider.empty() ? exec_provider : node_provider);
-
-  auto range = kernel_creator_fn_map_.equal_range(GetMapKey(node.OpType(), node.Domain(), expected_provider));
   if (out) *out = nullptr;
 
-  std::vector<std::string> verify_kernel_def_error_strs;
+  // Only the lookups using the types of the node are cached, the explicit type_constraints are not part of the key.
+  std::string cache_key;
+  std::optional<LookupResult> result;
+  if (kernel_type_str_resolver != nullptr) {
+    cache_key = GetLookupCacheKey(node, expected_provider);
+    std::lock_guard<std::mutex> lock(lookup_cache_mutex_);
+    auto entry = lookup_cache_.find(cache_key);
+    if (entry != lookup_cache_.end()) {
+      result = entry->second;
+    }
+  }
 
-  for (auto i = range.first; i != range.second; ++i) {
-    std::string error_str;
-    if (VerifyKernelDef(node, *i->second.kernel_def, kernel_type_str_resolver, type_constraints, error_str)) {
-      if (out) {
-        *out = &i->second;
+  if (!result.has_value()) {
+    result = LookupResult{nullptr, {}};
+    auto range = kernel_creator_fn_map_.equal_range(GetMapKey(node.OpType(), node.Domain(), expected_provider));
+    std::vector<std::string> verify_kernel_def_error_strs;
+
+    for (auto i = range.first; i != range.second; ++i) {
+      std::string error_str;
+      if (VerifyKernelDef(node, *i->second.kernel_def, kernel_type_str_resolver, type_constraints, error_str)) {
+        result->kernel_create_info = &i->second;
+        break;
       }
-      return Status::OK();
+
+      verify_kernel_def_error_strs.push_back(error_str);
     }
 
-    verify_kernel_def_error_strs.push_back(error_str);
+    if (result->kernel_create_info == nullptr && !verify_kernel_def_error_strs.empty()) {
+      std::ostringstream oss;
+      std::copy(verify_kernel_def_error_strs.begin(), verify_kernel_def_error_strs.end(),
+                std::ostream_iterator<std::string>(oss, "\n"));
+      result->verify_kernel_def_errors = oss.str();
+    }
+
+    if (kernel_type_str_resolver != nullptr) {
+      std::lock_guard<std::mutex> lock(lookup_cache_mutex_);
+      lookup_cache_.emplace(std::move(cache_key), *result);
+    }
   }
 
-  if (!verify_kernel_def_error_strs.empty()) {
+  if (result->kernel_create_info != nullptr) {
+    if (out) {
+      *out = result->kernel_create_info;
+    }
+    return Status::OK();
+  }
+
+  if (!result->verify_kernel_def_errors.empty()) {
     std::ostringstream oss;
     oss << "Op with name (" << node.Name() << ")"
         << " domain (" << node.Domain() << ")"
         << " and type (" << node.OpType() << ")"
         << " kernel is not supported in " << expected_provider << "."
-        << " Encountered following errors: (";
-    std::copy(verify_kernel_def_error_strs.begin(), verify_kernel_def_error_strs.end(),
-              std::ostream_iterator<std::string>(oss, "\n"));
-    oss << ")";
+        << " Encountered following errors: (" << result->verify_kernel_def_errors << ")";
 
     VLOGS(logger, 2) << "TryFindKernel failed, Reason: " << oss.str();
     return Status(common::ONNXRUNTIME, common::FAIL, oss.str());
@@ -327,6 +375,10 @@ Status KernelRegistry::Register(KernelCreateInfo&& create_info) {
   // Register the kernel.
   // Ownership of the KernelDef is transferred to kernel_creator_fn_map_.
   kernel_creator_fn_map_.emplace(key, std::move(create_info));
+
+  // A new kernel may match nodes that were looked up before.
+  std::lock_guard<std::mutex> lock(lookup_cache_mutex_);
+  lookup_cache_.clear();
   return Status::OK();
 }
 
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+
+#include <algorithm>
+
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+MemoryPatternCache::MemoryPatternCache(InlinedVector<int64_t> shape_buckets, size_t max_entries)
+    : shape_buckets_(std::move(shape_buckets)), max_entries_(max_entries) {
+}
+
+Status MemoryPatternCache::ParseShapeBuckets(std::string_view config_value,
+                                             InlinedVector<int64_t>& shape_buckets) {
+  shape_buckets.clear();
+  for (const auto& token : utils::SplitString(config_value, ",", /*keep_empty*/ false)) {
+    int64_t boundary = 0;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(utils::TrimString(std::string{token}), boundary) &&
+                          boundary > 0,
+                      "Invalid memory pattern shape bucket '", token, "' in '", config_value, "'");
+    ORT_RETURN_IF_NOT(shape_buckets.empty() || boundary > shape_buckets.back(),
+                      "Memory pattern shape buckets must be strictly increasing: ", config_value);
+    shape_buckets.push_back(boundary);
+  }
+
+  return Status::OK();
+}
+
+InlinedVector<int64_t> MemoryPatternCache::GetInputDims(gsl::span<const OrtValue> tensor_inputs) {
+  InlinedVector<int64_t> input_dims;
+  for (const auto& input : tensor_inputs) {
+    const auto dims = input.Get<Tensor>().Shape().GetDims();
+    input_dims.insert(input_dims.end(), dims.begin(), dims.end());
+  }
+  return input_dims;
+}
+
+int64_t MemoryPatternCache::CalculateKey(gsl::span<const OrtValue> tensor_inputs) const {
+  uint64_t key = 0;
+  const auto combine = [&key](int64_t value) {
+    key ^= static_cast<uint64_t>(value) + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+  };
+
+  for (const auto& input : tensor_inputs) {
+    const auto dims = input.Get<Tensor>().Shape().GetDims();
+    combine(static_cast<int64_t>(dims.size()));
+    for (auto dim : dims) {
+      if (!shape_buckets_.empty()) {
+        auto bucket = std::lower_bound(shape_buckets_.begin(), shape_buckets_.end(), dim);
+        if (bucket != shape_buckets_.end()) {
+          dim = *bucket;
+        }
+      }
+      combine(dim);
+    }
+  }
+
+  return static_cast<int64_t>(key);
+}
+
+bool MemoryPatternCache::CanHold(const CacheItem& item, gsl::span<const int64_t> input_dims) {
+  if (item.input_dims.size() != input_dims.size()) {
+    return false;
+  }
+
+  if (item.entry.inferred_shapes) {
+    return std::equal(input_dims.begin(), input_dims.end(), item.input_dims.begin());
+  }
+
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    if (input_dims[i] > item.input_dims[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+const MemoryPatternCache::Entry* MemoryPatternCache::Get(gsl::span<const OrtValue> tensor_inputs) {
+  auto it = entries_.find(CalculateKey(tensor_inputs));
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+
+  auto item = it->second;
+  if (!CanHold(*item, GetInputDims(tensor_inputs))) {
+    return nullptr;
+  }
+
+  lru_list_.splice(lru_list_.begin(), lru_list_, item);
+  return &item->entry;
+}
+
+void MemoryPatternCache::Put(gsl::span<const OrtValue> tensor_inputs, Entry entry) {
+  const int64_t key = CalculateKey(tensor_inputs);
+  auto input_dims = GetInputDims(tensor_inputs);
+
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    auto item = it->second;
+    if (CanHold(*item, input_dims)) {
+      return;
+    }
+
+    // the inputs outgrew the existing entry for this bucket so replace it
+    item->input_dims = std::move(input_dims);
+    item->entry = std::move(entry);
+    lru_list_.splice(lru_list_.begin(), lru_list_, item);
+    return;
+  }
+
+  lru_list_.push_front(CacheItem{key, std::move(input_dims), std::move(entry)});
+  entries_.insert_or_assign(key, lru_list_.begin());
+
+  if (max_entries_ != 0 && lru_list_.size() > max_entries_) {
+    entries_.erase(lru_list_.back().key);
+    lru_list_.pop_back();
+  }
+}
+
+}  // namespace onnxruntime
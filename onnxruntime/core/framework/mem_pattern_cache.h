@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string_view>
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/tensor_shape.h"
+
+namespace onnxruntime {
+
+// Cache of memory patterns keyed by the shapes of the graph inputs.
+//
+// By default the key is derived from the exact input shapes. If shape buckets are provided, every input dimension is
+// rounded up to the smallest bucket boundary that is >= the dimension (dimensions larger than the last boundary are
+// used as is) so all input shapes that fall into the same bucket share one entry. A pattern generated from a run
+// can hold the tensors of any later run whose input dimensions are all <= the dimensions it was generated with, so
+// an entry is only replaced when a run in its bucket needs more memory than the entry provides.
+//
+// If max_entries is not 0 the least recently used entry is evicted once the limit is exceeded. Entries are handed
+// out as shared_ptr so an evicted pattern stays valid for in-flight runs.
+//
+// This class is not thread-safe.
+class MemoryPatternCache {
+ public:
+  struct Entry {
+    std::shared_ptr<const MemoryPatternGroup> patterns;
+    // Inferred shapes of the OrtValues. Only produced by static (training) planning, in which case the entry is
+    // only valid for the exact input shapes it was generated with.
+    std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes;
+  };
+
+  MemoryPatternCache() = default;
+  MemoryPatternCache(InlinedVector<int64_t> shape_buckets, size_t max_entries);
+
+  // Parses a comma separated list of strictly increasing positive bucket boundaries, e.g. "128,256,512".
+  static Status ParseShapeBuckets(std::string_view config_value, InlinedVector<int64_t>& shape_buckets);
+
+  bool UsesShapeBuckets() const { return !shape_buckets_.empty(); }
+
+  // Returns the entry that can be used for tensor_inputs, or nullptr. Marks the entry as most recently used.
+  const Entry* Get(gsl::span<const OrtValue> tensor_inputs);
+
+  // Adds an entry generated from tensor_inputs. An existing entry for the same key is kept unless it cannot hold
+  // tensor_inputs.
+  void Put(gsl::span<const OrtValue> tensor_inputs, Entry entry);
+
+  size_t Size() const { return lru_list_.size(); }
+
+ private:
+  struct CacheItem {
+    int64_t key;
+    // flattened dims of all inputs the entry was generated with
+    InlinedVector<int64_t> input_dims;
+    Entry entry;
+  };
+
+  using LruList = std::list<CacheItem>;
+
+  int64_t CalculateKey(gsl::span<const OrtValue> tensor_inputs) const;
+  static InlinedVector<int64_t> GetInputDims(gsl::span<const OrtValue> tensor_inputs);
+  static bool CanHold(const CacheItem& item, gsl::span<const int64_t> input_dims);
+
+  InlinedVector<int64_t> shape_buckets_;
+  size_t max_entries_{0};
+
+  // most recently used entry at the front
+  LruList lru_list_;
+  InlinedHashMap<int64_t, LruList::iterator> entries_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/node_memory_stats.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+
+void NodeMemoryStatsCollector::Report(NodeMemoryStats stats) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entry = node_stats_[stats.node_name];
+  stats.max_peak_bytes_in_use = std::max(entry.max_peak_bytes_in_use, stats.peak_bytes_in_use);
+  entry = std::move(stats);
+}
+
+std::vector<NodeMemoryStats> NodeMemoryStatsCollector::GetStats() const {
+  std::vector<NodeMemoryStats> result;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.reserve(node_stats_.size());
+    for (const auto& [name, stats] : node_stats_) {
+      result.push_back(stats);
+    }
+  }
+
+  std::sort(result.begin(), result.end(), [](const NodeMemoryStats& a, const NodeMemoryStats& b) {
+    return a.peak_bytes_in_use != b.peak_bytes_in_use ? a.peak_bytes_in_use > b.peak_bytes_in_use
+                                                      : a.node_name < b.node_name;
+  });
+  return result;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+
+namespace onnxruntime {
+
+/// <summary>
+/// Memory used by one execution of a node, measured in the allocator of the node's device.
+/// </summary>
+struct NodeMemoryStats {
+  std::string node_name;
+  // Bytes in use in the allocator at the high-water mark of the execution: the bytes in use once the node returned,
+  // which include its inputs and outputs, plus the peak of its temporary allocations.
+  int64_t peak_bytes_in_use = 0;
+  // Change of the bytes in use in the allocator across the execution, mostly the outputs of the node.
+  int64_t bytes_in_use_delta = 0;
+  // Bytes of the outputs that were allocated by the execution frame while the node ran,
+  // rather than placed in a pre-allocated memory pattern block.
+  int64_t dynamic_output_bytes = 0;
+  // Peak and total of the temporary allocations made through OpKernelContext::GetTempSpaceAllocator.
+  int64_t peak_temp_bytes = 0;
+  int64_t total_temp_bytes = 0;
+  // peak_bytes_in_use of the node over all the runs of the session
+  int64_t max_peak_bytes_in_use = 0;
+};
+
+/// <summary>
+/// Collects the NodeMemoryStats of each node of a session at run time.
+/// Thread safe. With concurrent runs the stats of a node are those of its latest execution.
+/// </summary>
+class NodeMemoryStatsCollector {
+ public:
+  NodeMemoryStatsCollector() = default;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NodeMemoryStatsCollector);
+
+  void Report(NodeMemoryStats stats);
+
+  /// Returns the stats of the nodes, by decreasing peak_bytes_in_use.
+  std::vector<NodeMemoryStats> GetStats() const;
+
+ private:
+  mutable std::mutex mutex_;
+  InlinedHashMap<std::string, NodeMemoryStats> node_stats_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/numa_replicated_buffer.h"
+
+#include <cstring>
+
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+NumaReplicatedBuffer::~NumaReplicatedBuffer() {
+  Release();
+}
+
+void NumaReplicatedBuffer::Replicate(const void* data, size_t size) {
+  Release();
+
+  const Env& env = Env::Default();
+  const int num_nodes = env.GetNumaNodeCount();
+  if (data == nullptr || size < kMinReplicatedSize || num_nodes <= 1 || env.GetCurrentNumaNode() < 0) {
+    return;
+  }
+
+  size_ = size;
+  replicas_.resize(static_cast<size_t>(num_nodes), nullptr);
+  for (int node = 0; node < num_nodes; ++node) {
+    void* replica = env.AllocateOnNumaNode(size, node);
+    if (replica != nullptr) {
+      std::memcpy(replica, data, size);
+      replicas_[node] = replica;
+    }
+  }
+}
+
+const void* NumaReplicatedBuffer::Local(const void* data) const {
+  if (replicas_.empty()) {
+    return data;
+  }
+  const int node = Env::Default().GetCurrentNumaNode();
+  if (node < 0 || static_cast<size_t>(node) >= replicas_.size() || replicas_[node] == nullptr) {
+    return data;
+  }
+  return replicas_[node];
+}
+
+void NumaReplicatedBuffer::Release() {
+  const Env& env = Env::Default();
+  for (void* replica : replicas_) {
+    env.FreeOnNumaNode(replica, size_);
+  }
+  replicas_.clear();
+  size_ = 0;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+/// <summary>
+/// Read-only copies of a buffer, like the pre-packed weights of a kernel, on each NUMA node of the host.
+/// Kernels read the copy local to the node of the calling thread instead of the memory of the node that loaded the
+/// model, which halves the bandwidth of a GEMM running on another socket. This pairs with thread pools whose
+/// threads are affinitized to the processors of one node, see OrtApi::RegisterThreadPoolPartition.
+/// </summary>
+class NumaReplicatedBuffer {
+ public:
+  // Smaller buffers mostly stay in the caches, so reading them from a remote node is cheap.
+  static constexpr size_t kMinReplicatedSize = 256 * 1024;
+
+  NumaReplicatedBuffer() = default;
+  ~NumaReplicatedBuffer();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NumaReplicatedBuffer);
+
+  // Copies the size bytes at data to each NUMA node, replacing the previous copies. Does nothing on single node
+  // hosts, for buffers smaller than kMinReplicatedSize or if the platform can't place memory on a node.
+  // data must stay valid as it is returned by Local() for the nodes without a copy.
+  void Replicate(const void* data, size_t size);
+
+  // Returns the copy on the NUMA node of the calling thread, or data if there is none.
+  const void* Local(const void* data) const;
+
+  size_t NumReplicas() const { return replicas_.size(); }
+
+ private:
+  void Release();
+
+  size_t size_ = 0;
+  std::vector<void*> replicas_;  // indexed by NUMA node, nullptr if the allocation failed
+};
+
+}  // namespace onnxruntime
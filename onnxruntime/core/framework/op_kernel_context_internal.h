@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <mutex>
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
 #include "core/session/onnxruntime_c_api.h"
@@ -38,7 +40,7 @@ class OpKernelContextInternal : public OpKernelContext {
     }
 
 #if !defined(ORT_MINIMAL_BUILD)
-    if (session_state_.GetNodeStatsRecorder() != nullptr) {
+    if (session_state_.GetNodeStatsRecorder() != nullptr || session_state_.GetNodeMemoryStatsCollector() != nullptr) {
       auto alloc = OpKernelContext::GetAllocator(kernel.GetDevice(OrtMemTypeDefault));
       if (alloc != nullptr) {
         accounting_allocator_ = std::make_shared<AccountingAllocator>(std::move(alloc));
@@ -114,21 +116,38 @@ class OpKernelContextInternal : public OpKernelContext {
     void* Alloc(size_t size) override {
       void* p = allocator_->Alloc(size);
       if (p != nullptr) {
-        stats_.total_allocated_bytes += size;
+        // kernels may allocate from the threads of their parallel loops
+        std::lock_guard<std::mutex> lock(mutex_);
+        allocation_sizes_.insert_or_assign(p, size);
+        const auto bytes = static_cast<int64_t>(size);
+        ++stats_.num_allocs;
+        stats_.total_allocated_bytes += bytes;
+        stats_.bytes_in_use += bytes;
+        stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+        stats_.max_alloc_size = std::max(stats_.max_alloc_size, bytes);
       }
       return p;
     }
 
     void Free(void* p) override {
       allocator_->Free(p);
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = allocation_sizes_.find(p);
+      if (it != allocation_sizes_.end()) {
+        stats_.bytes_in_use -= static_cast<int64_t>(it->second);
+        allocation_sizes_.erase(it);
+      }
     }
 
     void GetStats(AllocatorStats* stats) override {
+      std::lock_guard<std::mutex> lock(mutex_);
       *stats = stats_;
     }
 
    private:
     AllocatorPtr allocator_;
+    std::mutex mutex_;
+    InlinedHashMap<void*, size_t> allocation_sizes_;
     AllocatorStats stats_;
   };
 
@@ -4,6 +4,7 @@
 #include "core/framework/plugin_data_transfer.h"
 
 #include "core/framework/error_code_helper.h"
+#include "core/framework/plugin_ep_stream.h"
 
 namespace onnxruntime {
 namespace plugin_ep {
@@ -41,7 +42,7 @@ Status DataTransfer::CopyTensors(const std::vector<SrcDstPair>& src_dst_pairs) c
   for (size_t i = 0; i < src_dst_pairs.size(); ++i) {
     src_values.push_back(&values[i * 2]);
     dst_values.push_back(&values[i * 2 + 1]);
-    streams.push_back(nullptr);  // static_cast<OrtSyncStream*>(src_dst_pairs[i].src_stream));
+    streams.push_back(static_cast<OrtSyncStream*>(src_dst_pairs[i].src_stream));
   }
 
   auto* status = impl_.CopyTensors(&impl_, src_values.data(), dst_values.data(), streams.data(),
@@ -51,14 +52,14 @@ Status DataTransfer::CopyTensors(const std::vector<SrcDstPair>& src_dst_pairs) c
 }
 
 // optimized version for a single copy. see comments above in CopyTensors regarding the OrtValue usage and const_cast
-Status DataTransfer::CopyTensorImpl(const Tensor& src_tensor, Tensor& dst_tensor, onnxruntime::Stream* /*stream*/) const {
+Status DataTransfer::CopyTensorImpl(const Tensor& src_tensor, Tensor& dst_tensor, onnxruntime::Stream* stream) const {
   OrtValue src, dst;
   Tensor* src_tensor_ptr = const_cast<Tensor*>(&src_tensor);
   src.Init(static_cast<void*>(src_tensor_ptr), ml_tensor_type, no_op_deleter);
   dst.Init(static_cast<void*>(&dst_tensor), ml_tensor_type, no_op_deleter);
   const OrtValue* src_ptr = &src;
   OrtValue* dst_ptr = &dst;
-  OrtSyncStream* stream_ptr = nullptr;  // static_cast<OrtSyncStream*>(stream);
+  OrtSyncStream* stream_ptr = static_cast<OrtSyncStream*>(stream);
   auto* status = impl_.CopyTensors(&impl_, &src_ptr, &dst_ptr, &stream_ptr, 1);
 
   return ToStatusAndRelease(status);
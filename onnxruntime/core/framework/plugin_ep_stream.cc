@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/plugin_ep_stream.h"
+
+#include <cassert>
+
+#include "core/framework/error_code_helper.h"
+
+namespace onnxruntime {
+namespace plugin_ep {
+
+void Notification::Activate() {
+  ORT_THROW_IF_ERROR(ToStatusAndRelease(impl_.Activate(&impl_)));
+}
+
+void Notification::WaitNotificationOnDevice(onnxruntime::Stream* stream, synchronize::Notification& notification) {
+  assert(stream != nullptr);  // should never happen
+  auto& plugin_notification = static_cast<Notification&>(notification);
+  ORT_THROW_IF_ERROR(ToStatusAndRelease(
+      plugin_notification.impl_.WaitOnDevice(&plugin_notification.impl_, static_cast<OrtSyncStream*>(stream))));
+}
+
+void Notification::WaitNotificationOnHost(onnxruntime::Stream* /*stream*/, synchronize::Notification& notification) {
+  auto& plugin_notification = static_cast<Notification&>(notification);
+  ORT_THROW_IF_ERROR(ToStatusAndRelease(plugin_notification.impl_.WaitOnHost(&plugin_notification.impl_)));
+}
+
+std::unique_ptr<synchronize::Notification> Stream::CreateNotification(size_t /*num_consumers*/) {
+  OrtSyncNotificationImpl* notification_impl = nullptr;
+  ORT_THROW_IF_ERROR(ToStatusAndRelease(impl_.CreateNotification(&impl_, &notification_impl)));
+  ORT_ENFORCE(notification_impl != nullptr, "OrtSyncStreamImpl::CreateNotification returned a null notification.");
+
+  return std::make_unique<Notification>(*this, *notification_impl);
+}
+
+void Stream::Flush() {
+  ORT_THROW_IF_ERROR(ToStatusAndRelease(impl_.Flush(&impl_)));
+}
+
+Status Stream::CleanUpOnRunEnd() {
+  return ToStatusAndRelease(impl_.OnSessionRunEnd(&impl_));
+}
+
+}  // namespace plugin_ep
+}  // namespace onnxruntime
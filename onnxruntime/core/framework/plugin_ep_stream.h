@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+#pragma once
+
+#include "core/framework/stream_handles.h"
+#include "core/session/onnxruntime_c_api.h"
+
+// OrtSyncStream is an onnxruntime::Stream. The API passes it as an opaque type.
+struct OrtSyncStream : onnxruntime::Stream {};
+
+namespace onnxruntime {
+namespace plugin_ep {
+
+/// <summary>
+/// Class to implement synchronize::Notification for plugin execution providers.
+/// It uses the OrtSyncNotificationImpl created by the plugin EP's OrtSyncStreamImpl.
+/// </summary>
+class Notification : public synchronize::Notification {
+ public:
+  Notification(onnxruntime::Stream& stream, OrtSyncNotificationImpl& impl)
+      : synchronize::Notification(stream), impl_{impl} {
+  }
+
+  ~Notification() override {
+    impl_.Release(&impl_);
+  }
+
+  static void WaitNotificationOnDevice(onnxruntime::Stream* stream, synchronize::Notification& notification);
+  static void WaitNotificationOnHost(onnxruntime::Stream* stream, synchronize::Notification& notification);
+
+ protected:
+  void Activate() override;
+
+ private:
+  OrtSyncNotificationImpl& impl_;
+};
+
+/// <summary>
+/// Class to implement onnxruntime::Stream for plugin execution providers.
+/// It uses the OrtSyncStreamImpl created by OrtEpFactory::CreateSyncStreamForDevice.
+/// </summary>
+class Stream : public onnxruntime::Stream {
+ public:
+  Stream(const OrtDevice& device, OrtSyncStreamImpl& impl)
+      : onnxruntime::Stream(impl.GetHandle(&impl), device), impl_{impl} {
+  }
+
+  ~Stream() override {
+    impl_.Release(&impl_);
+  }
+
+  std::unique_ptr<synchronize::Notification> CreateNotification(size_t num_consumers) override;
+
+  void Flush() override;
+
+  Status CleanUpOnRunEnd() override;
+
+  WaitNotificationFn GetWaitNotificationFn() const override {
+    return Notification::WaitNotificationOnDevice;
+  }
+
+ private:
+  OrtSyncStreamImpl& impl_;
+};
+}  // namespace plugin_ep
+}  // namespace onnxruntime
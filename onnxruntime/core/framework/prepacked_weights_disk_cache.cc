@@ -0,0 +1,192 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_disk_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+
+#include "core/common/cpuid_info.h"
+#include "core/common/narrow.h"
+#include "core/common/path_string.h"
+#include "core/framework/endian.h"
+#include "core/framework/murmurhash3.h"
+#include "core/platform/env.h"
+#include "onnxruntime_config.h"  // for ORT_VERSION
+
+namespace onnxruntime {
+
+namespace {
+
+// Entry layout: kMagic, the buffer count, (size, is_null) for each buffer, then the buffers, each starting at a
+// multiple of kBufferAlignment. Mapped files are page aligned so the buffers keep the allocator alignment.
+constexpr char kMagic[8] = {'O', 'R', 'T', 'P', 'P', 'W', 'C', '1'};
+constexpr size_t kBufferAlignment = 64;
+
+size_t AlignUp(size_t value) {
+  return (value + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+}
+
+size_t GetHeaderSize(size_t num_buffers) {
+  return sizeof(kMagic) + sizeof(uint64_t) + num_buffers * 2 * sizeof(uint64_t);
+}
+
+}  // namespace
+
+PrepackedWeightsDiskCache::KeyBuilder::KeyBuilder() {
+  Add(std::string_view{ORT_VERSION});
+  Add(int64_t{endian::native == endian::little});
+
+  // packed layouts depend on the kernels MLAS selects for the CPU
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  Add(int64_t{cpu_info.GetCPUVendorId()});
+  const bool features[] = {
+      cpu_info.HasSSE3(), cpu_info.HasSSE4_1(), cpu_info.HasAVX(), cpu_info.HasAVX2(), cpu_info.HasF16C(),
+      cpu_info.HasAVX512f(), cpu_info.HasAVX512Skylake(), cpu_info.HasAVX512_BF16(), cpu_info.HasAMX_BF16(),
+      cpu_info.HasArmNeonDot(), cpu_info.HasArmNeon_I8MM(), cpu_info.HasArmSVE_I8MM(), cpu_info.HasArmNeon_BF16(),
+      cpu_info.HasFp16VectorAcceleration()};
+  for (const bool feature : features) {
+    Add(int64_t{feature});
+  }
+}
+
+PrepackedWeightsDiskCache::KeyBuilder& PrepackedWeightsDiskCache::KeyBuilder::Add(const void* data, size_t length) {
+  MurmurHash3::x86_128(data, length, hash_[0], &hash_);
+  return *this;
+}
+
+std::string PrepackedWeightsDiskCache::KeyBuilder::Build() const {
+  std::ostringstream ss;
+  ss << std::hex << std::setfill('0');
+  for (const uint32_t value : hash_) {
+    ss << std::setw(8) << value;
+  }
+  return ss.str();
+}
+
+PrepackedWeightsDiskCache::PrepackedWeightsDiskCache(const Env& env, std::filesystem::path cache_dir)
+    : env_(env), cache_dir_(std::move(cache_dir)) {
+}
+
+std::filesystem::path PrepackedWeightsDiskCache::GetEntryPath(const std::string& key) const {
+  return cache_dir_ / ToPathString(key + ".bin");
+}
+
+bool PrepackedWeightsDiskCache::TryLoad(const std::string& key, PrePackedWeights& weights) const {
+  const auto entry_path = GetEntryPath(key);
+  std::error_code ec;
+  const auto file_size = std::filesystem::file_size(entry_path, ec);
+  if (ec || file_size < GetHeaderSize(0)) {
+    return false;
+  }
+
+  Env::MappedMemoryPtr mapped_memory;
+  if (!env_.MapFileIntoMemory(entry_path.native().c_str(), 0, narrow<size_t>(file_size), mapped_memory).IsOK()) {
+    return false;
+  }
+
+  const char* base = mapped_memory.get();
+  if (std::memcmp(base, kMagic, sizeof(kMagic)) != 0) {
+    return false;
+  }
+
+  uint64_t num_buffers = 0;
+  std::memcpy(&num_buffers, base + sizeof(kMagic), sizeof(num_buffers));
+  if (num_buffers > (file_size - GetHeaderSize(0)) / (2 * sizeof(uint64_t))) {
+    return false;
+  }
+
+  // every buffer refers to the mapping, which is unmapped with the last of them
+  std::shared_ptr<char> mapping(mapped_memory.release(), mapped_memory.get_deleter());
+
+  PrePackedWeights loaded;
+  const char* header = base + GetHeaderSize(0);
+  size_t offset = AlignUp(GetHeaderSize(narrow<size_t>(num_buffers)));
+  for (uint64_t i = 0; i < num_buffers; ++i) {
+    uint64_t size_and_is_null[2];
+    std::memcpy(size_and_is_null, header + i * sizeof(size_and_is_null), sizeof(size_and_is_null));
+    const size_t size = narrow<size_t>(size_and_is_null[0]);
+    if (offset > file_size || size > file_size - offset) {
+      return false;
+    }
+
+    void* buffer = size_and_is_null[1] != 0 ? nullptr : const_cast<char*>(base + offset);
+    loaded.buffers_.push_back(IAllocatorUniquePtr<void>(buffer, [mapping](void*) {}));
+    loaded.buffer_sizes_.push_back(size);
+    offset = AlignUp(offset + size);
+  }
+
+  weights = std::move(loaded);
+  return true;
+}
+
+Status PrepackedWeightsDiskCache::Save(const std::string& key, const PrePackedWeights& weights) const {
+  ORT_RETURN_IF_NOT(weights.buffers_.size() == weights.buffer_sizes_.size(),
+                    "Pre-packed weights have a different number of buffers and sizes.");
+
+  std::error_code ec;
+  std::filesystem::create_directories(cache_dir_, ec);
+  ORT_RETURN_IF(ec, "Failed to create the pre-packed weights cache directory ",
+                PathToUTF8String(cache_dir_.native()), ": ", ec.message());
+
+  // the temporary file is unique to this writer so concurrent writers of an entry don't interleave
+  static std::atomic<uint64_t> temp_file_counter{0};
+  const auto entry_path = GetEntryPath(key);
+  auto temp_path = entry_path;
+  temp_path += ToPathString("." + std::to_string(env_.GetSelfPid()) + "." + std::to_string(temp_file_counter++) +
+                            ".tmp");
+
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(out, "Failed to open ", PathToUTF8String(temp_path.native()), " for writing.");
+
+    const size_t num_buffers = weights.buffers_.size();
+    out.write(kMagic, sizeof(kMagic));
+    const uint64_t num_buffers_value = num_buffers;
+    out.write(reinterpret_cast<const char*>(&num_buffers_value), sizeof(num_buffers_value));
+    for (size_t i = 0; i < num_buffers; ++i) {
+      const uint64_t size_and_is_null[2] = {weights.buffer_sizes_[i], weights.buffers_[i] == nullptr ? 1u : 0u};
+      out.write(reinterpret_cast<const char*>(size_and_is_null), sizeof(size_and_is_null));
+    }
+
+    const char padding[kBufferAlignment] = {};
+    size_t offset = GetHeaderSize(num_buffers);
+    for (size_t i = 0; i < num_buffers; ++i) {
+      out.write(padding, AlignUp(offset) - offset);
+      offset = AlignUp(offset);
+      if (weights.buffers_[i] != nullptr) {
+        out.write(static_cast<const char*>(weights.buffers_[i].get()), weights.buffer_sizes_[i]);
+      } else {
+        for (size_t remaining = weights.buffer_sizes_[i]; remaining > 0;) {
+          const size_t count = std::min(remaining, kBufferAlignment);
+          out.write(padding, count);
+          remaining -= count;
+        }
+      }
+      offset += weights.buffer_sizes_[i];
+    }
+
+    out.close();
+    if (!out) {
+      std::filesystem::remove(temp_path, ec);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write ", PathToUTF8String(temp_path.native()));
+    }
+  }
+
+  std::filesystem::rename(temp_path, entry_path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    // another writer may have won the race, which is as good as writing it
+    ORT_RETURN_IF_NOT(std::filesystem::exists(entry_path, ec), "Failed to write the pre-packed weights cache entry ",
+                      PathToUTF8String(entry_path.native()));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "core/common/common.h"
+#include "core/framework/prepacked_weights.h"
+
+namespace onnxruntime {
+
+class Env;
+
+// A directory of pre-packed weights that persists across sessions and processes.
+// Cached entries are memory mapped so the pages are loaded on first use and shared between processes.
+//
+// An entry is keyed by a hash of everything PrePack() may depend on, which the caller adds with a KeyBuilder.
+// The builder always includes the onnxruntime version and the CPU features MLAS selects kernels by, so a cache
+// directory may be shared by different builds and machines. Entries are written to a temporary file that is renamed
+// into place, so concurrent writers of the same entry are safe.
+class PrepackedWeightsDiskCache final {
+ public:
+  class KeyBuilder {
+   public:
+    KeyBuilder();
+
+    KeyBuilder& Add(const void* data, size_t length);
+    KeyBuilder& Add(std::string_view value) {
+      return Add(static_cast<int64_t>(value.size())).Add(value.data(), value.size());
+    }
+    KeyBuilder& Add(int64_t value) { return Add(&value, sizeof(value)); }
+
+    // Hex string of the 128-bit hash of what was added.
+    std::string Build() const;
+
+   private:
+    uint32_t hash_[4] = {0, 0, 0, 0};
+  };
+
+  PrepackedWeightsDiskCache(const Env& env, std::filesystem::path cache_dir);
+
+  // Maps the entry for key into weights. Returns false if there is no valid entry.
+  bool TryLoad(const std::string& key, PrePackedWeights& weights) const;
+
+  // Writes weights as the entry for key, creating the cache directory if needed.
+  Status Save(const std::string& key, const PrePackedWeights& weights) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsDiskCache);
+
+ private:
+  std::filesystem::path GetEntryPath(const std::string& key) const;
+
+  const Env& env_;
+  const std::filesystem::path cache_dir_;
+};
+
+}  // namespace onnxruntime
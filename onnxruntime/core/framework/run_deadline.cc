@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/run_deadline.h"
+
+namespace onnxruntime {
+
+namespace {
+thread_local RunDeadline::Clock::time_point current_deadline = RunDeadline::Clock::time_point::max();
+}  // namespace
+
+RunDeadline::Clock::time_point RunDeadline::Get() noexcept {
+  return current_deadline;
+}
+
+RunDeadline::Scope::Scope(Clock::time_point deadline) noexcept : prev_deadline_(current_deadline) {
+  current_deadline = deadline;
+}
+
+RunDeadline::Scope::~Scope() {
+  current_deadline = prev_deadline_;
+}
+
+}  // namespace onnxruntime
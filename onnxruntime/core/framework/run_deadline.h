@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+/// <summary>
+/// Deadline of the run executing on the calling thread, set from the "run.timeout_ms" run option. The executors
+/// check it between the kernels, along with RunOptions::terminate, so a run whose client has given up stops at the
+/// next kernel instead of keeping the cores busy. Subgraphs (Loop, Scan, If, the steps of beam search) are executed
+/// with the deadline of their parent run, so their long iterations stop at the next subgraph kernel too.
+///
+/// The deadline is thread local; the executors set it on the inter-op threads running the streams of a run.
+/// </summary>
+class RunDeadline {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // The deadline of the calling thread, Clock::time_point::max() if there is none.
+  static Clock::time_point Get() noexcept;
+
+  // Whether the calling thread has a deadline and it has passed.
+  static bool Passed() noexcept {
+    const Clock::time_point deadline = Get();
+    return deadline != Clock::time_point::max() && Clock::now() >= deadline;
+  }
+
+  // Sets the deadline of the calling thread for the lifetime of the scope.
+  class Scope {
+   public:
+    explicit Scope(Clock::time_point deadline) noexcept;
+    ~Scope();
+
+   private:
+    Clock::time_point prev_deadline_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Scope);
+  };
+};
+
+}  // namespace onnxruntime
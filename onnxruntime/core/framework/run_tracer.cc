@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/run_tracer.h"
+
+#include <atomic>
+
+namespace onnxruntime {
+
+namespace {
+thread_local RunTracer::Context current_context;
+
+int64_t ToNanosecondsSinceEpoch(RunTracer::Clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+}  // namespace
+
+const RunTracer::Context& RunTracer::Current() noexcept {
+  return current_context;
+}
+
+uint64_t RunTracer::NewSpanId() noexcept {
+  static std::atomic<uint64_t> next_span_id{1};
+  return next_span_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RunTracer::EmitSpan(const char* name, const std::string& detail, const std::string& run_tag, uint64_t span_id,
+                         uint64_t parent_span_id, Clock::time_point start, Clock::time_point end) const {
+  span_fn_(user_data_, name, detail.c_str(), run_tag.c_str(), span_id, parent_span_id,
+           ToNanosecondsSinceEpoch(start), ToNanosecondsSinceEpoch(end));
+}
+
+RunTracer::Scope::Scope(const Context& context) noexcept : prev_context_(current_context) {
+  current_context = context;
+}
+
+RunTracer::Scope::~Scope() {
+  current_context = prev_context_;
+}
+
+RunTracer::Span::Span(const char* name) : name_(name) {
+  const Context& context = current_context;
+  if (context.tracer != nullptr) {
+    Start(context.tracer, context.run_tag, Clock::now());
+  }
+}
+
+RunTracer::Span::Span(const RunTracer* tracer, const std::string& run_tag, const char* name) : name_(name) {
+  if (tracer != nullptr) {
+    Start(tracer, &run_tag, Clock::now());
+  }
+}
+
+RunTracer::Span::Span(const RunTracer* tracer, const std::string& run_tag, const char* name,
+                      Clock::time_point start) : name_(name) {
+  if (tracer != nullptr) {
+    Start(tracer, &run_tag, start);
+  }
+}
+
+void RunTracer::Span::Start(const RunTracer* tracer, const std::string* run_tag, Clock::time_point start) {
+  tracer_ = tracer;
+  run_tag_ = run_tag;
+  span_id_ = NewSpanId();
+  prev_context_ = current_context;
+  start_ = start;
+  current_context = Context{tracer, span_id_, run_tag};
+}
+
+void RunTracer::Span::End() {
+  if (tracer_ == nullptr) {
+    return;
+  }
+
+  const auto end = Clock::now();
+  current_context = prev_context_;
+  const uint64_t parent_span_id = prev_context_.tracer == tracer_ ? prev_context_.span_id : 0;
+  tracer_->EmitSpan(name_, detail_, *run_tag_, span_id_, parent_span_id, start_, end);
+  tracer_ = nullptr;
+}
+
+}  // namespace onnxruntime
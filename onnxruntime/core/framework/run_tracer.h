@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/session/onnxruntime_c_api.h"
+
+namespace onnxruntime {
+
+/// <summary>
+/// Emits the spans of the runs of a session to the callback set with OrtApi::SessionOptionsSetTracingCallback.
+/// A "Run" span has an "ExecuteGraph" child for the execution of the graph, whose children are the "NodeGroup"
+/// spans of the sequences of nodes of one stream run back to back. The subgraphs of control flow nodes add their
+/// own "ExecuteGraph" span to the span running the node. A run through RunAsync is the child of a "RunAsync" span,
+/// which also has a "RunAsyncQueue" child for the time the request waited for a thread.
+///
+/// The innermost span of the calling thread is thread local, like RunDeadline; the executors set it on the inter-op
+/// threads running the streams of a run. When the session has no tracer, a span costs a thread local read.
+/// </summary>
+class RunTracer {
+ public:
+  using Clock = std::chrono::system_clock;
+
+  RunTracer(OrtTracingSpanFn span_fn, void* user_data) : span_fn_(span_fn), user_data_(user_data) {}
+
+  // The innermost span of a thread, and the tracer and run tag of its run.
+  struct Context {
+    const RunTracer* tracer = nullptr;
+    uint64_t span_id = 0;
+    const std::string* run_tag = nullptr;
+  };
+
+  // The context of the calling thread, without a tracer if the thread isn't in a traced run.
+  static const Context& Current() noexcept;
+
+  // Returns an identifier unique within the process, never 0.
+  static uint64_t NewSpanId() noexcept;
+
+  void EmitSpan(const char* name, const std::string& detail, const std::string& run_tag, uint64_t span_id,
+                uint64_t parent_span_id, Clock::time_point start, Clock::time_point end) const;
+
+  // Sets the context of the calling thread for the lifetime of the scope.
+  class Scope {
+   public:
+    explicit Scope(const Context& context) noexcept;
+    ~Scope();
+
+   private:
+    Context prev_context_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Scope);
+  };
+
+  // A span that starts with the object and is emitted by End() or when the object is destroyed. The spans started
+  // by the thread in between are its children.
+  class Span {
+   public:
+    // A child of the innermost span of the calling thread. Does nothing if the thread isn't in a traced run.
+    explicit Span(const char* name);
+
+    // A span of the given tracer, which is nullptr if the session isn't traced. It is the child of the innermost
+    // span of the calling thread if that span is of the same tracer, and a root span otherwise.
+    Span(const RunTracer* tracer, const std::string& run_tag, const char* name);
+    Span(const RunTracer* tracer, const std::string& run_tag, const char* name, Clock::time_point start);
+
+    ~Span() { End(); }
+
+    bool IsActive() const noexcept { return tracer_ != nullptr; }
+    uint64_t Id() const noexcept { return span_id_; }
+
+    void SetDetail(std::string detail) { detail_ = std::move(detail); }
+
+    // Emits the span and restores the context of the calling thread. Does nothing if the span has ended.
+    void End();
+
+   private:
+    void Start(const RunTracer* tracer, const std::string* run_tag, Clock::time_point start);
+
+    const char* name_;
+    const RunTracer* tracer_ = nullptr;
+    const std::string* run_tag_ = nullptr;
+    uint64_t span_id_ = 0;
+    Context prev_context_;
+    Clock::time_point start_;
+    std::string detail_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Span);
+  };
+
+ private:
+  OrtTracingSpanFn span_fn_;
+  void* user_data_;
+};
+
+}  // namespace onnxruntime
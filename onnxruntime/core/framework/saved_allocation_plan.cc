@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/saved_allocation_plan.h"
+
+#include "core/flatbuffers/schema/ort.fbs.h"
+#include "core/flatbuffers/flatbuffers_utils.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/sequential_execution_plan.h"
+
+namespace fb = flatbuffers;
+
+namespace onnxruntime {
+
+namespace {
+bool IsSavableAllocKind(AllocKind alloc_kind) {
+  switch (alloc_kind) {
+    case AllocKind::kAllocate:
+    case AllocKind::kReuse:
+    case AllocKind::kPreExisting:
+    case AllocKind::kAllocateStatically:
+    case AllocKind::kAllocateOutput:
+    case AllocKind::kShare:
+    case AllocKind::kAllocatedExternally:
+      return true;
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status SavedAllocationPlan::SaveToOrtFormat(const SequentialExecutionPlan& plan,
+                                            const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                            gsl::span<const NodeIndex> execution_order,
+                                            fb::FlatBufferBuilder& builder,
+                                            fb::Offset<fbs::AllocationPlan>& fbs_allocation_plan) {
+  const auto& allocation_plan = plan.allocation_plan;
+  std::vector<fb::Offset<fbs::AllocationPlanEntry>> fbs_values;
+  fbs_values.reserve(allocation_plan.size());
+
+  std::string name;
+  std::string reused_name;
+  for (size_t idx = 0; idx < allocation_plan.size(); ++idx) {
+    const auto& per_value_plan = allocation_plan[idx];
+    if (per_value_plan.alloc_kind == AllocKind::kNotSet) {
+      continue;
+    }
+
+    ORT_RETURN_IF_NOT(IsSavableAllocKind(per_value_plan.alloc_kind),
+                      "Unexpected allocation kind ", static_cast<int>(per_value_plan.alloc_kind));
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetName(static_cast<int>(idx), name));
+
+    // the offset of a slice of the reused buffer is not saved, so a slice gets its own buffer instead
+    AllocKind alloc_kind = per_value_plan.alloc_kind;
+    if (alloc_kind == AllocKind::kReuse && per_value_plan.is_slice_of_reused_buffer) {
+      alloc_kind = AllocKind::kAllocate;
+    }
+
+    fb::Offset<fb::String> fbs_reused_buffer{};
+    if (alloc_kind == AllocKind::kReuse) {
+      ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetName(per_value_plan.reused_buffer, reused_name));
+      fbs_reused_buffer = builder.CreateSharedString(reused_name);
+    }
+
+    fbs_values.push_back(fbs::CreateAllocationPlanEntry(builder,
+                                                        builder.CreateSharedString(name),
+                                                        static_cast<int8_t>(alloc_kind),
+                                                        fbs_reused_buffer));
+  }
+
+  std::vector<uint32_t> fbs_execution_order;
+  fbs_execution_order.reserve(execution_order.size());
+  for (const auto node_index : execution_order) {
+    fbs_execution_order.push_back(gsl::narrow<uint32_t>(node_index));
+  }
+
+  fbs_allocation_plan = fbs::CreateAllocationPlan(builder, builder.CreateVector(fbs_values),
+                                                  builder.CreateVector(fbs_execution_order));
+  return Status::OK();
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+Status SavedAllocationPlan::LoadFromOrtFormat(const fbs::AllocationPlan& fbs_allocation_plan) {
+  const auto* fbs_values = fbs_allocation_plan.values();
+  ORT_FORMAT_RETURN_IF_NULL(fbs_values, "allocation plan values");
+  const auto* fbs_execution_order = fbs_allocation_plan.execution_order();
+  ORT_FORMAT_RETURN_IF_NULL(fbs_execution_order, "allocation plan execution_order");
+
+  InlinedHashMap<std::string, Entry> loaded_values;
+  loaded_values.reserve(fbs_values->size());
+  for (const auto* fbs_value : *fbs_values) {
+    ORT_FORMAT_RETURN_IF_NULL(fbs_value, "allocation plan entry");
+    ORT_FORMAT_RETURN_IF_NULL(fbs_value->value_name(), "allocation plan entry value_name");
+
+    Entry entry;
+    entry.alloc_kind = static_cast<AllocKind>(fbs_value->alloc_kind());
+    ORT_RETURN_IF_NOT(IsSavableAllocKind(entry.alloc_kind),
+                      "Invalid allocation kind in ORT format model: ", static_cast<int>(fbs_value->alloc_kind()));
+
+    if (entry.alloc_kind == AllocKind::kReuse) {
+      ORT_FORMAT_RETURN_IF_NULL(fbs_value->reused_buffer(), "allocation plan entry reused_buffer");
+      entry.reused_buffer = fbs_value->reused_buffer()->str();
+    }
+
+    ORT_RETURN_IF_NOT(loaded_values.emplace(fbs_value->value_name()->str(), std::move(entry)).second,
+                      "Duplicate allocation plan entry in ORT format model: ", fbs_value->value_name()->str());
+  }
+
+  InlinedVector<NodeIndex> loaded_execution_order;
+  loaded_execution_order.reserve(fbs_execution_order->size());
+  for (const auto node_index : *fbs_execution_order) {
+    loaded_execution_order.push_back(static_cast<NodeIndex>(node_index));
+  }
+
+  values = std::move(loaded_values);
+  execution_order = std::move(loaded_execution_order);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
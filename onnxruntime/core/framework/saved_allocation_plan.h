@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include <gsl/gsl>
+
+#include "core/common/flatbuffers.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/status.h"
+#include "core/framework/alloc_kind.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+namespace fbs {
+struct AllocationPlan;
+}  // namespace fbs
+
+class OrtValueNameIdxMap;
+struct SequentialExecutionPlan;
+
+/**
+ * The allocation decisions made by the SequentialPlanner for the main graph, keyed by OrtValue name.
+ *
+ * This is saved in an ORT format model so that a session loading the model can skip the buffer reuse computation.
+ * The planner validates the saved plan against the graph it is planning, and ignores it if it does not match.
+ */
+struct SavedAllocationPlan {
+  struct Entry {
+    AllocKind alloc_kind{AllocKind::kNotSet};
+    // name of the OrtValue whose buffer is reused. only set if alloc_kind is AllocKind::kReuse.
+    std::string reused_buffer;
+  };
+
+  InlinedHashMap<std::string, Entry> values;
+
+  // the node execution order the plan was created for
+  InlinedVector<NodeIndex> execution_order;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  /**
+   * Saves the allocation plan of `plan` in ORT format.
+   * @param plan The execution plan of the main graph.
+   * @param ort_value_name_idx_map The OrtValue name to index mapping `plan` was created with.
+   * @param execution_order The node execution order `plan` was created with.
+   * @param builder The flatbuffers builder.
+   * @param[out] fbs_allocation_plan The saved flatbuffers representation offset.
+   */
+  static Status SaveToOrtFormat(const SequentialExecutionPlan& plan,
+                                const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                gsl::span<const NodeIndex> execution_order,
+                                flatbuffers::FlatBufferBuilder& builder,
+                                flatbuffers::Offset<fbs::AllocationPlan>& fbs_allocation_plan);
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+  /**
+   * Loads the allocation plan from ORT format.
+   * @param fbs_allocation_plan The flatbuffers representation to load.
+   */
+  Status LoadFromOrtFormat(const fbs::AllocationPlan& fbs_allocation_plan);
+};
+
+}  // namespace onnxruntime
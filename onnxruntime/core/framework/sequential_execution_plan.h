@@ -35,6 +35,11 @@ struct AllocPlanPerValue {
   // reused_buffer is valid only if alloc_kind == kReuse. It indicates
   // which OrtValue's buffer must be reused for this OrtValue.
   OrtValueIndex reused_buffer{0};
+  // is_slice_of_reused_buffer and reused_buffer_offset are valid only if alloc_kind == kReuse. If set, this OrtValue
+  // is the contiguous slice of the reused buffer starting reused_buffer_offset bytes in, like an input of Concat that
+  // its producer writes straight into the Concat output.
+  bool is_slice_of_reused_buffer{false};
+  size_t reused_buffer_offset{0};
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   IntervalT life_interval{0, 0};
   IntervalT allocate_interval{0, 0};
@@ -11,7 +11,9 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/node_memory_stats.h"
 #include "core/framework/resource_accountant.h"
+#include "core/framework/run_deadline.h"
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
@@ -156,7 +158,8 @@ class SessionScope {
  public:
   friend class KernelScope;
   SessionScope(const SessionState& session_state, const ExecutionFrame& frame)
-      : session_state_(session_state)
+      : session_state_(session_state),
+        profile_execution_(session_state.Profiler().ShouldProfileExecution())
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
         ,
         frame_(frame)
@@ -177,7 +180,7 @@ class SessionScope {
             session_state_.GetGraphExecutionCounter(), 0}
 #endif
   {
-    if (session_state_.Profiler().IsEnabled()) {
+    if (profile_execution_) {
       session_start_ = session_state.Profiler().Start();
     }
 
@@ -225,7 +228,7 @@ class SessionScope {
     }
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (profile_execution_) {
       session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_);
     }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
@@ -254,6 +257,8 @@ class SessionScope {
 
  private:
   const SessionState& session_state_;
+  // whether the events of this execution are recorded, which may only be done for a sample of the executions
+  const bool profile_execution_;
   TimePoint session_start_;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
@@ -288,7 +293,8 @@ class KernelScope {
       : session_scope_(session_scope),
         session_state_(session_scope_.session_state_),
         kernel_context_(kernel_context),
-        kernel_(kernel)
+        kernel_(kernel),
+        loop_owner_scope_(session_state_.GetThreadPool(), &kernel)
 #ifdef CONCURRENCY_VISUALIZER
         ,
         span_(session_scope_.series_, "%s.%d", kernel_.Node().OpType().c_str(), kernel_.Node().Index())
@@ -344,10 +350,15 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (session_state_.Profiler().IsNodeStatsEnabled() && !session_scope_.profile_execution_) {
+      kernel_begin_time_ = std::chrono::high_resolution_clock::now();
+    }
+
+    if (session_scope_.profile_execution_) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
-      concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool());
+      concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool(),
+                                              session_state_.Profiler().IsHardwareCountersEnabled());
       VLOGS(session_state_.Logger(), 1) << "Computing kernel: " << node_name_;
       kernel_begin_time_ = session_state_.Profiler().Start();
       CalculateTotalInputSizes(&kernel_context, &kernel_,
@@ -363,7 +374,14 @@ class KernelScope {
     node_compute_range_.End();
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (session_state_.Profiler().IsNodeStatsEnabled()) {
+      const auto& node = kernel_.Node();
+      session_state_.Profiler().RecordNodeStats(&node, kernel_begin_time_, [&node]() {
+        return node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
+      });
+    }
+
+    if (session_scope_.profile_execution_) {
       auto& profiler = session_state_.Profiler();
       std::string output_type_shape_;
       CalculateTotalOutputSizes(&kernel_context_, total_output_sizes_, node_name_, output_type_shape_);
@@ -417,6 +435,9 @@ class KernelScope {
   size_t total_output_sizes_{};
   std::string input_type_shape_;
 
+  // still in scope when the destructor stops the thread pool profiling, which reports the learned threshold
+  concurrency::ThreadPool::LoopOwnerScope loop_owner_scope_;
+
 #ifdef CONCURRENCY_VISUALIZER
   diagnostic::span span_;
 #endif
@@ -430,6 +451,48 @@ class KernelScope {
 #endif
 };
 
+#if !defined(ORT_MINIMAL_BUILD)
+// Attributes to the node the high-water mark of the allocator of its device while it ran, see NodeMemoryStats.
+// Other nodes running concurrently on other streams share the allocator, so the attribution is approximate with
+// the parallel executor.
+static void ReportNodeMemoryStats(NodeMemoryStatsCollector& collector,
+                                  OpKernelContextInternal& kernel_ctx,
+                                  const ExecutionFrame& frame,
+                                  const Node& node,
+                                  IAllocator* device_allocator,
+                                  const AllocatorStats& allocator_stats_before) {
+  NodeMemoryStats node_stats;
+  node_stats.node_name = IResourceAccountant::MakeUniqueNodeName(node);
+
+  AllocatorStats temp_stats;
+  if (kernel_ctx.GetAllocatorStats(temp_stats)) {
+    node_stats.peak_temp_bytes = temp_stats.max_bytes_in_use;
+    node_stats.total_temp_bytes = temp_stats.total_allocated_bytes;
+  }
+
+  if (device_allocator != nullptr) {
+    AllocatorStats allocator_stats_after;
+    device_allocator->GetStats(&allocator_stats_after);
+    node_stats.bytes_in_use_delta = allocator_stats_after.bytes_in_use - allocator_stats_before.bytes_in_use;
+    // the temporary allocations still alive when the node returned are already part of bytes_in_use
+    node_stats.peak_bytes_in_use = allocator_stats_after.bytes_in_use - temp_stats.bytes_in_use;
+  }
+  node_stats.peak_bytes_in_use += node_stats.peak_temp_bytes;
+
+  for (int i = 0, lim = kernel_ctx.OutputCount(); i < lim; ++i) {
+    const OrtValue* p_output = kernel_ctx.GetOutputMLValue(i);
+    if (p_output != nullptr && p_output->IsAllocated() && p_output->IsTensor()) {
+      auto dynamic_allocation = frame.GetOrtValueDynamicAllocation(kernel_ctx.GetOrtValueIndexForOutput(i));
+      if (dynamic_allocation.has_value()) {
+        node_stats.dynamic_output_bytes += static_cast<int64_t>(*dynamic_allocation);
+      }
+    }
+  }
+
+  collector.Report(std::move(node_stats));
+}
+#endif
+
 onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
                                   NodeIndex idx,
                                   size_t stream_idx,
@@ -489,9 +552,26 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
         status = kernel_ctx.SetOutputMLValue(0, cache.get()->at(cached_arg_name));
       }
 #else
+#if !defined(ORT_MINIMAL_BUILD)
+      auto* node_memory_stats_collector = ctx.GetSessionState().GetNodeMemoryStatsCollector();
+      AllocatorPtr device_allocator;
+      AllocatorStats allocator_stats_before;
+      if (node_memory_stats_collector != nullptr) {
+        device_allocator = kernel_ctx.GetAllocator(p_kernel->GetDevice(OrtMemTypeDefault));
+        if (device_allocator != nullptr) {
+          device_allocator->GetStats(&allocator_stats_before);
+        }
+      }
+#endif
+
       status = p_kernel->Compute(&kernel_ctx);
 
 #if !defined(ORT_MINIMAL_BUILD)
+      if (node_memory_stats_collector != nullptr && status.IsOK()) {
+        ReportNodeMemoryStats(*node_memory_stats_collector, kernel_ctx, ctx.GetExecutionFrame(), p_kernel->Node(),
+                              device_allocator.get(), allocator_stats_before);
+      }
+
       auto* node_stats_recorder = ctx.GetSessionState().GetNodeStatsRecorder();
       if (node_stats_recorder != nullptr) {
         const auto& node = p_kernel->Node();
@@ -578,6 +658,72 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
   return Status::OK();
 }
 
+// KernelScope instruments every kernel in these builds, so their plans are always run by the execution steps.
+#if !defined(DEBUG_NODE_INPUTS_OUTPUTS) && !defined(ENABLE_NVTX_PROFILE) && !defined(CONCURRENCY_VISUALIZER) && \
+    !defined(ONNXRUNTIME_ENABLE_INSTRUMENT) && !(!defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE))
+#define ORT_LEAN_EXECUTION_SUPPORTED
+#endif
+
+#ifdef ORT_LEAN_EXECUTION_SUPPORTED
+// Whether the nodes of a run can go through ExecuteLeanPlan, which skips the per node instrumentation.
+static bool CanExecuteLeanPlan(const SessionState& session_state) {
+  if (session_state.GetLeanExecutionOrder() == nullptr ||
+      session_state.Profiler().IsEnabled() || session_state.Profiler().IsNodeStatsEnabled()) {
+    return false;
+  }
+#if !defined(ORT_MINIMAL_BUILD)
+  if (session_state.GetNodeMemoryStatsCollector() != nullptr || session_state.GetNodeStatsRecorder() != nullptr) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+// Runs the kernels of a plan made of a single sequence of CPU kernels, see SessionState::GetLeanExecutionOrder.
+// It does what the LaunchKernelStep of each node does, without the dispatch through the steps and the checks of
+// the instrumentation that the run doesn't use.
+static Status ExecuteLeanPlan(StreamExecutionContext& ctx, size_t stream_idx,
+                              gsl::span<const NodeIndex> execution_order, const bool& terminate_flag) {
+  const SessionState& session_state = ctx.GetSessionState();
+  ExecutionFrame& frame = ctx.GetExecutionFrame();
+  const auto& logger = ctx.GetLogger();
+  Stream* device_stream = ctx.GetDeviceStream(stream_idx);
+
+  for (const NodeIndex node_index : execution_order) {
+    if (terminate_flag) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+    }
+    if (RunDeadline::Passed()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to the deadline of the run having passed.");
+    }
+
+    const OpKernel& kernel = *session_state.GetKernel(node_index);
+    OpKernelContextInternal kernel_ctx(session_state, frame, kernel, logger, terminate_flag, device_stream);
+    concurrency::ThreadPool::LoopOwnerScope loop_owner_scope(session_state.GetThreadPool(), &kernel);
+    Status status;
+    ORT_TRY {
+      status = kernel.Compute(&kernel_ctx);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    if (!status.IsOK()) {
+      const auto& node = kernel.Node();
+      const auto msg_string = MakeString("Non-zero status code returned while running ", node.OpType(),
+                                         " node. Name:'", node.Name(), "' Status Message: ", status.ErrorMessage());
+      LOGS(logger, ERROR) << msg_string;
+      return Status(status.Category(), status.Code(), msg_string);
+    }
+
+    ctx.RecycleNodeInputs(node_index);
+  }
+
+  return Status::OK();
+}
+#endif
+
 onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
                                    gsl::span<const OrtValue> feeds, gsl::span<const int> fetch_mlvalue_idxs,
                                    std::vector<OrtValue>& fetches,
@@ -589,6 +735,12 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
                                    const bool& terminate_flag,
                                    const bool only_execute_path_to_fetches,
                                    bool single_thread_mode) {
+  // started before the execution context, which passes it to the threads running the streams
+  RunTracer::Span graph_span("ExecuteGraph");
+  if (graph_span.IsActive()) {
+    graph_span.SetDetail(session_state.GetGraphViewer().Name());
+  }
+
   auto* execution_plan = session_state.GetExecutionPlan();
   VLOGS(logger, 0) << "Number of streams: " << execution_plan->execution_plan.size();
   int32_t valid_streams = 0;
@@ -635,16 +787,47 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 
   auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
 
-  for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
-    if (execution_plan->execution_plan[i]->steps_.empty()) {
-      // execution context is initialized with number of valid streams
-      // for invalid stream (0 steps), it doesn't count in number of tasks
-      // so don't need to invoke CompleteTask here
-      // ctx.CompleteTask();
-    } else {
-      concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
-        RunSince(i, ctx, session_scope, terminate_flag, 0);
-      });
+  bool lean_execution = false;
+#ifdef ORT_LEAN_EXECUTION_SUPPORTED
+  lean_execution = CanExecuteLeanPlan(session_state);
+#ifdef ENABLE_TRAINING
+  lean_execution = lean_execution && !only_execute_path_to_fetches;
+#endif
+#endif
+
+  if (lean_execution) {
+#ifdef ORT_LEAN_EXECUTION_SUPPORTED
+    // The plan has a single stream, which is run on the calling thread.
+    size_t stream_idx = 0;
+    while (execution_plan->execution_plan[stream_idx]->steps_.empty()) {
+      ++stream_idx;
+    }
+    Status status;
+    {
+      RunTracer::Span node_group_span("NodeGroup");
+      if (node_group_span.IsActive()) {
+        node_group_span.SetDetail(
+            MakeString(execution_plan->execution_plan[stream_idx]->device_.ToString(), ", stream ", stream_idx));
+      }
+      status = ExecuteLeanPlan(ctx, stream_idx, *session_state.GetLeanExecutionOrder(), terminate_flag);
+    }
+    if (!status.IsOK()) {
+      ctx.SetStatus(status);
+    }
+    ctx.CompleteTask();
+#endif
+  } else {
+    for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
+      if (execution_plan->execution_plan[i]->steps_.empty()) {
+        // execution context is initialized with number of valid streams
+        // for invalid stream (0 steps), it doesn't count in number of tasks
+        // so don't need to invoke CompleteTask here
+        // ctx.CompleteTask();
+      } else {
+        concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
+          RunSince(i, ctx, session_scope, terminate_flag, 0);
+        });
+      }
     }
   }
 
@@ -691,6 +874,7 @@ onnxruntime::Status PartialExecuteThePlan(const SessionState& session_state, gsl
   auto* plan = session_state.GetExecutionPlan();
 
   ctx.SetCurrentRange(&state.GetProgramRegions(session_state));
+  ctx.SetTracingContext(RunTracer::Current());
 
   SessionScope session_scope(session_state, ctx.GetExecutionFrame());
 
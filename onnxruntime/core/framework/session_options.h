@@ -247,6 +247,10 @@ struct SessionOptions {
   OrtLoggingFunction user_logging_function = nullptr;
   void* user_logging_param = nullptr;
 
+  // callback receiving the tracing spans of the runs, see OrtApi::SessionOptionsSetTracingCallback
+  OrtTracingSpanFn tracing_span_fn = nullptr;
+  void* tracing_user_data = nullptr;
+
   void SetLoadCancellationFlag(bool value) noexcept {
     *load_cancellation_flag = value;
   }
@@ -3,19 +3,28 @@
 
 #include "core/framework/session_state.h"
 
+#include <map>
+#include <optional>
 #include <sstream>
 
 #include <mutex>
 #include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
+#include "core/common/parse_string.h"
+#include "core/common/path_string.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
+#include "core/framework/bfc_arena.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_disk_cache.h"
 #include "core/framework/session_state_utils.h"
 #include "core/framework/utils.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 
@@ -107,6 +116,31 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+  if (enable_mem_pattern_) {
+    InlinedVector<int64_t> shape_buckets;
+    const auto shape_buckets_config =
+        sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryPatternShapeBuckets, "");
+    auto status = MemoryPatternCache::ParseShapeBuckets(shape_buckets_config, shape_buckets);
+    if (!status.IsOK()) {
+      LOGS(logger_, WARNING) << status.ErrorMessage() << ". Memory patterns will be cached by exact input shapes.";
+      shape_buckets.clear();
+    }
+
+    size_t max_entries = 0;
+    const auto max_entries_config =
+        sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryPatternCacheMaxEntries, "0");
+    if (!TryParseStringWithClassicLocale(max_entries_config, max_entries)) {
+      LOGS(logger_, WARNING) << "Invalid value '" << max_entries_config << "' for "
+                             << kOrtSessionOptionsMemoryPatternCacheMaxEntries
+                             << ". The memory pattern cache size will not be limited.";
+      max_entries = 0;
+    }
+
+    mem_patterns_ = MemoryPatternCache(std::move(shape_buckets), max_entries);
+
+    reserve_mem_pattern_peaks_ =
+        sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsReserveMemoryPatternPeak, "0") == "1";
+  }
   if (parent_allocators) {
     allocators_ = parent_allocators;
   } else {
@@ -244,7 +278,8 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
-    for (const auto& node : nodes) {
+
+    auto create_kernel = [&](const Node& node) -> Status {
       // construct and save the kernels
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
 
@@ -253,7 +288,38 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
       // assumes vector is already resize()'ed to the number of nodes in the graph
-      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
+      return kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]);
+    };
+
+    // The kernels of CPU nodes only read the session state while they are constructed, so they are created in
+    // parallel, with the concurrency used to load the initializers. Kernels of other EPs may share state, e.g. the
+    // function manager of compiled nodes, and those of control flow nodes set up their subgraphs, so they are created
+    // one at a time.
+    const bool parallel =
+        session_state_utils::GetInitializerLoadMaxConcurrency(sess_options_, thread_pool_) > 1;
+    InlinedVector<const Node*> cpu_nodes;
+    for (const auto& node : nodes) {
+      if (parallel && node.GetExecutionProviderType() == kCpuExecutionProvider && !node.ContainsSubgraph()) {
+        cpu_nodes.push_back(&node);
+      } else {
+        ORT_RETURN_IF_ERROR(create_kernel(node));
+      }
+    }
+
+    std::vector<Status> cpu_node_status(cpu_nodes.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool_, narrow<std::ptrdiff_t>(cpu_nodes.size()), [&](std::ptrdiff_t i) {
+          ORT_TRY {
+            cpu_node_status[narrow<size_t>(i)] = create_kernel(*cpu_nodes[narrow<size_t>(i)]);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              cpu_node_status[narrow<size_t>(i)] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+            });
+          }
+        });
+    for (auto& status : cpu_node_status) {
+      ORT_RETURN_IF_ERROR(status);
     }
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
@@ -416,230 +482,368 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
+// The key of the pre-packed weights of input_idx of node in the persistent cache.
+static std::string GenerateKeyForPrepackedWeightsDiskCache(const Node& node, int input_idx, const Tensor& tensor,
+                                                          const ConfigOptions& config_options) {
+  PrepackedWeightsDiskCache::KeyBuilder builder;
+  builder.Add(node.Domain()).Add(node.OpType()).Add(int64_t{node.SinceVersion()});
+  builder.Add(node.GetExecutionProviderType());
+
+  // hash maps are iterated in sorted order so the key doesn't depend on their layout
+  std::map<std::string_view, const ONNX_NAMESPACE::AttributeProto*> attributes;
+  for (const auto& [name, attribute] : node.GetAttributes()) {
+    attributes.emplace(name, &attribute);
+  }
+  for (const auto& [name, attribute] : attributes) {
+    builder.Add(name).Add(attribute->SerializeAsString());
+  }
+
+  std::map<std::string_view, std::string_view> configurations;
+  for (const auto& [key, value] : config_options.configurations) {
+    configurations.emplace(key, value);
+  }
+  for (const auto& [key, value] : configurations) {
+    builder.Add(key).Add(value);
+  }
+
+  builder.Add(int64_t{input_idx}).Add(int64_t{tensor.GetElementType()});
+  const auto dims = tensor.Shape().GetDims();
+  builder.Add(static_cast<int64_t>(dims.size())).Add(dims.data(), dims.size_bytes());
+  builder.Add(tensor.DataRaw(), tensor.SizeInBytes());
+
+  return builder.Build();
+}
+
+// Calls PrePack() on the kernel, unless disk_cache has the pre-packed weights of an earlier session and the kernel
+// can use them without it. Newly pre-packed weights are written to disk_cache.
+static Status PrePackWithDiskCache(const PrepackedWeightsDiskCache* disk_cache, const Node& node, OpKernel& kernel,
+                                   const Tensor& tensor, int input_idx, const AllocatorPtr& alloc,
+                                   const ConfigOptions& config_options, const logging::Logger& logger,
+                                   /*out*/ bool& is_packed, /*out*/ PrePackedWeights& weights) {
+  std::string disk_cache_key;
+  if (disk_cache != nullptr && node.GetExecutionProviderType() == kCpuExecutionProvider &&
+      !tensor.IsDataTypeString() && kernel.CanUseSharedPrePackedBuffersWithoutPrePack(input_idx)) {
+    disk_cache_key = GenerateKeyForPrepackedWeightsDiskCache(node, input_idx, tensor, config_options);
+    if (disk_cache->TryLoad(disk_cache_key, weights) && !weights.buffers_.empty()) {
+      LOGS(logger, VERBOSE) << "Using pre-packed weights from the cache for input " << input_idx
+                            << " of node: " << node.Name();
+      is_packed = true;
+      return Status::OK();
+    }
+    weights = PrePackedWeights{};
+  }
+
+  ORT_RETURN_IF_ERROR(kernel.PrePack(tensor, input_idx, alloc, is_packed, &weights));
+
+  if (!disk_cache_key.empty() && is_packed && !weights.buffers_.empty()) {
+    // the cache is an optimization, so failing to write it must not fail the session
+    auto status = disk_cache->Save(disk_cache_key, weights);
+    if (!status.IsOK()) {
+      LOGS(logger, WARNING) << "Failed to cache the pre-packed weights for input " << input_idx
+                            << " of node: " << node.Name() << ". " << status.ErrorMessage();
+    }
+  }
+
+  return Status::OK();
+}
+
 Status SessionState::PrepackConstantInitializedTensors(
     InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
     const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
-                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
-      if (sess_options_.IsLoadCancellationFlagSet()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED,
-                               "Weight pre-packing was canceled due to user request.");
-      }
-      auto kernel = GetMutableKernel(node.Index());
-      int input_idx = 0;
-      for (auto& input_def : node.InputDefs()) {
-        if (input_def->Exists()) {
-          const std::string& input_name = input_def->Name();
-          SessionState* st = this;
-          auto* prepacked_for_graph = &graph_.GetPrepacked();
-          // subgraph can use the value from outer scope,
-          // so it needs to check if current node uses constant initialized tensor from current and outer graphs
-          do {
-            int ort_value_idx;
-            if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
-
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {
-                  // caching of pre-packed weights' turned ON
-
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
-
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
-                  // because other static properties of the node like node attributes could play a role in the
-                  // pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
-                    // to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
-                                "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
-
-                    const auto& op_type = node.OpType();
-
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
-
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
-
-                    const std::string prepacked_weights_container_key =
-                        GenerateKeyForPrepackedWeightsMap(op_type,
-                                                          weights_to_be_filled_in);
-
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
-                        prepacked_weights_container_key);
+  std::optional<PrepackedWeightsDiskCache> disk_cache;
+  const std::string disk_cache_dir =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPrepackedWeightsCacheDir, "");
+  if (!disk_cache_dir.empty()) {
+    disk_cache.emplace(Env::Default(), ToPathString(disk_cache_dir));
+  }
+  const PrepackedWeightsDiskCache* disk_cache_ptr = disk_cache.has_value() ? &*disk_cache : nullptr;
+
+  // Pre-packs the constant initialized tensors used by node. When nodes are pre-packed in parallel, the session state
+  // is only accessed with mutex held, and the tensors to release are added to released_initializers as the other
+  // nodes may still be pre-packing them.
+  auto prepack_node = [this, &constant_initializers_use_count, &initializers_to_share_map, disk_cache_ptr](
+                          const Node& node, bool should_cache_prepacked_weights_for_shared_initializers,
+                          std::mutex* mutex,
+                          InlinedVector<std::pair<SessionState*, int>>* released_initializers) -> Status {
+    std::unique_lock<std::mutex> session_state_lock =
+        mutex != nullptr ? std::unique_lock<std::mutex>(*mutex) : std::unique_lock<std::mutex>();
+    auto kernel = GetMutableKernel(node.Index());
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        SessionState* st = this;
+        auto* prepacked_for_graph = &graph_.GetPrepacked();
+        // subgraph can use the value from outer scope,
+        // so it needs to check if current node uses constant initialized tensor from current and outer graphs
+        do {
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
+
+            if (constant_initialized_tensors.count(ort_value_idx)) {
+              bool is_packed = false;
+              const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
+
+              auto iter = initializers_to_share_map.find(input_name);
+              bool is_shared_initializer = (iter != initializers_to_share_map.end());
+
+              // Caching pre-packed weights is limited to shared initializers associated with the CPU and XNNPACK EPs
+              // for now
+              if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
+                  (node.GetExecutionProviderType() == kCpuExecutionProvider ||
+                   node.GetExecutionProviderType() == kXnnpackExecutionProvider)) {
+                // caching of pre-packed weights' turned ON
+
+                AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+                ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+                // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
+                // because other static properties of the node like node attributes could play a role in the
+                // pre-packed weights' contents.
+                ORT_RETURN_IF_ERROR(PrePackWithDiskCache(disk_cache_ptr, node, *kernel, const_initialized_tensor,
+                                                         input_idx, allocator_for_caching,
+                                                         sess_options_.config_options, logger_,
+                                                         is_packed, weights_to_be_filled_in));
 
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
-                                          << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: "
-                                          << node.OpType();
-
-                      const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_shared,
-                                                                          node.Name()));
-
-                      ++used_shared_pre_packed_weights_counter_;
-
-                      // Write references to what is stored in the shared container
-                      // and release memory mapped entries this container may have loaded from disk
-                      std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
-                                                                                      prepacked_weights_container_key,
-                                                                                      prepacked_shared);
-
-                    } else {
-                      // container doesn't contain the pre-packed weight - so write into it for sharing across
-                      // kernel instances
-
-                      // Check if we loaded it from disk, then put it into the shared container so
-                      // everybody can share the same memory mapped entry
-                      // the shared container takes ownership of the memory mapped entries
-
-                      // The next line replaces the existing entry with references to it
-                      // and returns the container that holds the memory mapped entries
-                      // so we can transfer it to shared container.
-                      // if there is not an entry, we replace it with references to weights_to_be_filled_in
-                      // in saving mode and return std::nullopt
-                      auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
-                          input_name,
-                          prepacked_weights_container_key,
-                          weights_to_be_filled_in);
-
-                      if (prepacked_from_disk.has_value()) {
-                        weights_to_be_filled_in = std::move(*prepacked_from_disk);
-                      }
-
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
-                                                                     std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(
-                            ONNXRUNTIME, FAIL,
-                            "Unable to write the provided PrePackedWeights instance into the container");
-                      }
-
-                      const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          shared_prepacked,
-                                                                          node.Name()));
-                    }
-                  }
+                if (is_packed) {
+                  // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
+                  // to be cached if the weight was pre-packed
+                  ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
+                              "The kernel corresponding to the node ", node.Name(),
+                              " doesn't have an implementation that can cache computed pre-packed weights");
 
-                } else {
-                  // cross session caching of pre-packed weights' turned OFF
-                  // we use serialization container to share weights loaded from disk
-                  // within this session. Or if the weight is not present on disk,
-                  // we store the newly minted pre-packed data.
-
-                  AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
-                  // other static properties of the node like node attributes could play a role in the pre-packed
-                  // weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
-                  // even though they set is_packed = true so we leave it up to them.
-                  // We can change their behavior if we wish do so in a separate PR
-                  // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
-                  // produce them.
-                  if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
-                    const auto& op_type = node.OpType();
-                    const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
-                        op_type,
-                        weights_to_be_filled_in);
+                  const auto& op_type = node.OpType();
+
+                  // Sanity check
+                  // TODO: Check if some version of the ONNX IR allows op_type to be empty
+                  ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
+
+                  // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+                  // that we just got by invoking PrePack() on this kernel.
+
+                  const std::string prepacked_weights_container_key =
+                      GenerateKeyForPrepackedWeightsMap(op_type,
+                                                        weights_to_be_filled_in);
 
-                    // See if we can use pre-packed data from disk
-                    const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
+                  bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
+                      prepacked_weights_container_key);
+
+                  if (container_contains_packed_weight) {
+                    LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
+                                        << input_name
+                                        << " used in the node: " << node.Name() << " which is of op type: "
+                                        << node.OpType();
+
+                    const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
                         prepacked_weights_container_key);
+                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                        prepacked_shared,
+                                                                        node.Name()));
 
-                    if (weights_to_use == nullptr) {
-                      // In this case pre-packed container owns the data
-                      prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
-                                                                   std::move(weights_to_be_filled_in));
-                      weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
-                      assert(weights_to_use != nullptr);
+                    ++used_shared_pre_packed_weights_counter_;
+
+                    // Write references to what is stored in the shared container
+                    // and release memory mapped entries this container may have loaded from disk
+                    std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
+                                                                                    prepacked_weights_container_key,
+                                                                                    prepacked_shared);
+
+                  } else {
+                    // container doesn't contain the pre-packed weight - so write into it for sharing across
+                    // kernel instances
+
+                    // Check if we loaded it from disk, then put it into the shared container so
+                    // everybody can share the same memory mapped entry
+                    // the shared container takes ownership of the memory mapped entries
+
+                    // The next line replaces the existing entry with references to it
+                    // and returns the container that holds the memory mapped entries
+                    // so we can transfer it to shared container.
+                    // if there is not an entry, we replace it with references to weights_to_be_filled_in
+                    // in saving mode and return std::nullopt
+                    auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
+                        input_name,
+                        prepacked_weights_container_key,
+                        weights_to_be_filled_in);
+
+                    if (prepacked_from_disk.has_value()) {
+                      weights_to_be_filled_in = std::move(*prepacked_from_disk);
+                    }
+
+                    if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
+                                                                   std::move(weights_to_be_filled_in))) {
+                      return ORT_MAKE_STATUS(
+                          ONNXRUNTIME, FAIL,
+                          "Unable to write the provided PrePackedWeights instance into the container");
                     }
 
+                    const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
+                        prepacked_weights_container_key);
                     ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                        *weights_to_use,
+                                                                        shared_prepacked,
                                                                         node.Name()));
                   }
                 }
 
-                if (is_packed) {
-                  ++number_of_prepacks_counter_;
+              } else {
+                // cross session caching of pre-packed weights' turned OFF
+                // we use serialization container to share weights loaded from disk
+                // within this session. Or if the weight is not present on disk,
+                // we store the newly minted pre-packed data.
+
+                AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+                // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
+                // other static properties of the node like node attributes could play a role in the pre-packed
+                // weights' contents.
+                if (mutex != nullptr) {
+                  session_state_lock.unlock();
+                }
+                auto status = PrePackWithDiskCache(disk_cache_ptr, node, *kernel, const_initialized_tensor,
+                                                   input_idx, session_cpu_alloc,
+                                                   sess_options_.config_options, logger_,
+                                                   is_packed, weights_to_be_filled_in);
+                if (mutex != nullptr) {
+                  session_state_lock.lock();
+                }
+                ORT_RETURN_IF_ERROR(status);
+
+                // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
+                // even though they set is_packed = true so we leave it up to them.
+                // We can change their behavior if we wish do so in a separate PR
+                // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
+                // produce them.
+                if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+                  const auto& op_type = node.OpType();
+                  const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
+                      op_type,
+                      weights_to_be_filled_in);
+
+                  // See if we can use pre-packed data from disk
+                  const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
+                      prepacked_weights_container_key);
+
+                  if (weights_to_use == nullptr) {
+                    // In this case pre-packed container owns the data
+                    prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
+                                                                 std::move(weights_to_be_filled_in));
+                    weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
+                    assert(weights_to_use != nullptr);
+                  }
+
+                  ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                      *weights_to_use,
+                                                                      node.Name()));
+                }
+              }
+
+              if (is_packed) {
+                ++number_of_prepacks_counter_;
 
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
+                if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+                  // release the constant initialized tensor
+                  if (released_initializers != nullptr) {
+                    released_initializers->emplace_back(st, ort_value_idx);
+                  } else {
                     st->initialized_tensors_.erase(ort_value_idx);
                     constant_initialized_tensors.erase(ort_value_idx);
                   }
                 }
               }
-              // stop searching in 2 cases:
-              // 1. value is not from OuterScope
-              // 2. value is from OuterScope and the current OuterScope has the value
-              if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
-                break;
-              }
             }
-            st = st->Parent();
-            prepacked_for_graph = &st->graph_.GetPrepacked();
-          } while (st);
-        }
-        input_idx++;
+            // stop searching in 2 cases:
+            // 1. value is not from OuterScope
+            // 2. value is from OuterScope and the current OuterScope has the value
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
+            }
+          }
+          st = st->Parent();
+          prepacked_for_graph = &st->graph_.GetPrepacked();
+        } while (st);
       }
+      input_idx++;
     }
 
     return Status::OK();
   };
 
+  auto cancellation_status = []() {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED, "Weight pre-packing was canceled due to user request.");
+  };
+
   bool should_cache_prepacked_weights_for_shared_initializers = (prepacked_weights_container_ != nullptr);
 
   if (should_cache_prepacked_weights_for_shared_initializers) {
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
     std::lock_guard<std::mutex> l(prepacked_weights_container_->mutex_);
-    return prepacked_constant_weights(true);
-  } else {
-    return prepacked_constant_weights(false);
+    for (auto& node : GetGraphViewer().Nodes()) {
+      if (sess_options_.IsLoadCancellationFlagSet()) {
+        return cancellation_status();
+      }
+      ORT_RETURN_IF_ERROR(prepack_node(node, true, nullptr, nullptr));
+    }
+    return Status::OK();
   }
-}
 
-static int64_t
-CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
-  for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+  // The kernels of CPU nodes are pre-packed in parallel, in batches of up to max_concurrency nodes so the tensors they
+  // release are freed before the next batch. Kernels of other EPs may share state, and nodes with the same weights
+  // write the same disk cache entry, so they are pre-packed one at a time.
+  const size_t max_concurrency =
+      disk_cache_ptr == nullptr ? session_state_utils::GetInitializerLoadMaxConcurrency(sess_options_, thread_pool_)
+                                : 1;
+  std::mutex session_state_mutex;
+  InlinedVector<const Node*> batch;
+  std::vector<Status> batch_status;
+  InlinedVector<std::pair<SessionState*, int>> released_initializers;
+
+  auto prepack_batch = [&]() -> Status {
+    batch_status.assign(batch.size(), Status::OK());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool_, narrow<std::ptrdiff_t>(batch.size()), [&](std::ptrdiff_t i) {
+          batch_status[narrow<size_t>(i)] = prepack_node(*batch[narrow<size_t>(i)], false, &session_state_mutex,
+                                                         &released_initializers);
+        });
+
+    for (const auto& [st, ort_value_idx] : released_initializers) {
+      st->initialized_tensors_.erase(ort_value_idx);
+      st->constant_initialized_tensors_.erase(ort_value_idx);
+    }
+    released_initializers.clear();
+    batch.clear();
+
+    for (auto& status : batch_status) {
+      ORT_RETURN_IF_ERROR(status);
+    }
+    return Status::OK();
+  };
+
+  for (auto& node : GetGraphViewer().Nodes()) {
+    if (sess_options_.IsLoadCancellationFlagSet()) {
+      return cancellation_status();
+    }
+
+    if (max_concurrency > 1 && node.GetExecutionProviderType() == kCpuExecutionProvider) {
+      batch.push_back(&node);
+      if (batch.size() == max_concurrency) {
+        ORT_RETURN_IF_ERROR(prepack_batch());
+      }
+    } else {
+      ORT_RETURN_IF_ERROR(prepack_batch());
+      ORT_RETURN_IF_ERROR(prepack_node(node, false, nullptr, nullptr));
+    }
   }
-  return key;
+
+  return prepack_batch();
 }
 
 #ifdef ENABLE_TRAINING
@@ -876,26 +1080,27 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
-// MemoryPatternGroup pointer is cached. It only inserted upon creation
-// and is not updated if already present.
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+// MemoryPatternGroup is shared with the cache. An entry is only replaced if a later run in its shape bucket does not
+// fit into it.
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
     gsl::span<const OrtValue> tensor_inputs,
     gsl::span<const int> feed_mlvalue_idxs,
-    const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
+    std::shared_ptr<const InlinedHashMap<int, TensorShape>>& out_inferred_shapes) const {
   out_inferred_shapes = nullptr;
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
+  const auto* entry = mem_patterns_.Get(tensor_inputs);
+  if (entry == nullptr) {
 #ifdef ENABLE_TRAINING
     MemoryPatternGroup mem_patterns;
     InlinedHashMap<int, TensorShape> inferred_shapes;
     if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
-      auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
-      auto ptr = &patt_insert.first->second;
-      auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
-      out_inferred_shapes = &shape_insert.first->second;
-      return ptr;
+      MemoryPatternCache::Entry new_entry{std::make_shared<const MemoryPatternGroup>(std::move(mem_patterns)),
+                                          std::make_shared<const InlinedHashMap<int, TensorShape>>(
+                                              std::move(inferred_shapes))};
+      out_inferred_shapes = new_entry.inferred_shapes;
+      auto patterns = new_entry.patterns;
+      mem_patterns_.Put(tensor_inputs, std::move(new_entry));
+      return patterns;
     }
 #else
     ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
@@ -903,11 +1108,8 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
     return nullptr;
   }
 
-  auto patt_hit = shape_patterns_.find(key);
-  if (patt_hit != shape_patterns_.cend()) {
-    out_inferred_shapes = &patt_hit->second;
-  }
-  return &it->second;
+  out_inferred_shapes = entry->inferred_shapes;
+  return entry->patterns;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -958,11 +1160,36 @@ void SessionState::ResolveMemoryPatternFlag() {
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                                    MemoryPatternGroup mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
-
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
-  // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+
+  if (reserve_mem_pattern_peaks_) {
+    // the buffer of a location is allocated at its peak size by every run using the pattern. a region of that size
+    // lets the arena serve it without extending, whatever the extend strategy would have grown the arena by.
+    for (size_t i = 0; i < mem_patterns.locations.size(); ++i) {
+      const OrtDevice& location = mem_patterns.locations[i];
+      const size_t peak_size = mem_patterns.patterns[i].PeakSize();
+      size_t& reserved_peak = reserved_mem_pattern_peaks_[location];
+      if (peak_size <= reserved_peak) {
+        continue;
+      }
+
+      AllocatorPtr alloc = GetAllocator(location);
+      if (alloc && alloc->Info().alloc_type == OrtAllocatorType::OrtArenaAllocator) {
+        const Status status = static_cast<BFCArena*>(alloc.get())->ReserveRegion(peak_size);
+        if (!status.IsOK()) {
+          LOGS(logger_, WARNING) << "Failed to reserve the memory pattern peak of " << peak_size << " bytes for "
+                                 << location.ToString() << ": " << status.ErrorMessage();
+          continue;
+        }
+        reserved_peak = peak_size;
+      }
+    }
+  }
+
+  // Existing entries are only replaced if they cannot hold tensor_inputs
+  mem_patterns_.Put(tensor_inputs,
+                    MemoryPatternCache::Entry{std::make_shared<const MemoryPatternGroup>(std::move(mem_patterns)),
+                                              nullptr});
   return Status::OK();
 }
 
@@ -1452,6 +1679,52 @@ static void AccumulateAllNestedSubgraphsInfo(
   }
 }
 
+void SessionState::SetupLeanExecution(const SessionOptions& session_options) {
+  lean_execution_order_.reset();
+  if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsDisableLeanExecution, "0") == "1") {
+    return;
+  }
+
+  // Without barriers and notifications, the only steps of a stream are the kernel launches.
+  const auto& plan = *p_seq_exec_plan_;
+  if (plan.num_barriers != 0 || !plan.notification_owner_stream.empty()) {
+    return;
+  }
+
+  const SequentialExecutionPlan::LogicStream* stream = nullptr;
+  for (const auto& logic_stream : plan.execution_plan) {
+    if (logic_stream && !logic_stream->steps_.empty()) {
+      if (stream != nullptr) {
+        return;
+      }
+      stream = logic_stream.get();
+    }
+  }
+  if (stream == nullptr) {
+    return;
+  }
+
+  InlinedVector<NodeIndex> order;
+  order.reserve(stream->steps_.size());
+  for (const auto& step : stream->steps_) {
+    const NodeIndex node_index = step->GetNodeIndex();
+    const OpKernel* kernel = GetKernel(node_index);
+    if (kernel == nullptr || kernel->IsAsync() ||
+        kernel->Info().GetExecutionProvider()->Type() != kCpuExecutionProvider ||
+        kernel->KernelDef().OpName() == "YieldOp") {
+      return;
+    }
+#ifdef ENABLE_TRAINING
+    if (kernel->KernelDef().AllocateInputsContiguously()) {
+      return;
+    }
+#endif
+    order.push_back(node_index);
+  }
+
+  lean_execution_order_ = std::move(order);
+}
+
 Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_TYPE>& graph_location,
                                               const KernelRegistryManager& kernel_registry_manager,
                                               _In_opt_ const Node* parent_node,
@@ -1516,7 +1789,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
   SequentialPlannerContext context(session_options.execution_mode,
                                    session_options.execution_order,
-                                   session_options.enable_mem_reuse);
+                                   session_options.enable_mem_reuse,
+                                   parent_node == nullptr ? saved_allocation_plan_ : nullptr);
 
 #ifdef _WIN32
 
@@ -1629,7 +1903,7 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
         return Status::OK();
       },
       logger_, data_transfer_mgr_, external_data_loader_mgr_, *p_seq_exec_plan_, session_options,
-      memory_profile_func, graph_.GetPrepacked()));
+      memory_profile_func, graph_.GetPrepacked(), thread_pool_, GetSharedInitializerStore()));
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1644,6 +1918,7 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  SetupLeanExecution(session_options);
 
   if (!disable_prepacking) {
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
@@ -25,11 +25,14 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/mem_pattern_cache.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
+#include "core/framework/node_memory_stats.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/graph/graph_viewer.h"
@@ -57,6 +60,7 @@ class KernelDef;
 class OpKernel;
 class NodeIndexInfo;
 struct SequentialExecutionPlan;
+struct SavedAllocationPlan;
 struct MemoryPatternGroup;
 class DeviceStreamCollection;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
@@ -189,6 +193,12 @@ class SessionState {
   // execution plan. nullptr until FinalizeSessionState is called
   const SequentialExecutionPlan* GetExecutionPlan() const;
 
+  // Nodes run in order by the lean execution loop, see kOrtSessionOptionsDisableLeanExecution.
+  // nullptr if the execution plan isn't a single sequence of CPU kernels.
+  const InlinedVector<NodeIndex>* GetLeanExecutionOrder() const {
+    return lean_execution_order_.has_value() ? &*lean_execution_order_ : nullptr;
+  }
+
   const std::vector<AllocPlanPerValue>& GetPerValueAllocPlan() const;
 
   /**
@@ -215,15 +225,13 @@ class SessionState {
   Get cached memory pattern based on input shapes
   Must be called only when all values contain tensors
   In training scenarios, the cache may be updated so
-  the callers would receive a copy of inferred shapes
-  made under mutex being held. In inference scenarios,
-  it is not mutable, we do not obtain a lock and simply get a pointer
-  w/o copying a hashtable
+  the callers would receive the inferred shapes generated together with the pattern.
+  The returned pattern and shapes are shared with the cache so they remain valid if the entry is evicted
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       gsl::span<const OrtValue> tensor_inputs,
       gsl::span<const int> feed_mlvalue_idxs,
-      const InlinedHashMap<int, TensorShape>*& inferred_shapes) const;
+      std::shared_ptr<const InlinedHashMap<int, TensorShape>>& inferred_shapes) const;
 
   /**
   Set generated memory pattern with a given input shapes.
@@ -310,6 +318,12 @@ class SessionState {
                               bool remove_initializers = true,
                               bool saving_ort_format = false);
 
+  // Set the allocation plan loaded from an ORT format model. It is used when planning the main graph in
+  // FinalizeSessionState if it matches. The plan must remain valid until then.
+  void SetSavedAllocationPlan(const SavedAllocationPlan* saved_allocation_plan) {
+    saved_allocation_plan_ = saved_allocation_plan;
+  }
+
   SessionState* Parent() {
     return parent_;
   }
@@ -382,8 +396,39 @@ class SessionState {
     }
     return node_stats_recorder_;
   }
+
+  void SetNodeMemoryStatsCollector(NodeMemoryStatsCollector* node_memory_stats_collector) {
+    node_memory_stats_collector_ = node_memory_stats_collector;
+  }
+
+  /**
+   * Returns a pointer to the NodeMemoryStatsCollector object if it was enabled for the session.
+   * The object pointer is only present at the root SessionState object
+   */
+  NodeMemoryStatsCollector* GetNodeMemoryStatsCollector() const {
+    if (parent_ != nullptr) {
+      return parent_->GetNodeMemoryStatsCollector();
+    }
+    return node_memory_stats_collector_;
+  }
 #endif
 
+  void SetSharedInitializerStore(SharedInitializerStore* shared_initializer_store) {
+    shared_initializer_store_ = shared_initializer_store;
+  }
+
+  /**
+   * Returns the store the constant CPU initializers are shared through if the session set
+   * kOrtSessionOptionsShareInitializersByContent, or nullptr.
+   * The object pointer is only present at the root SessionState object
+   */
+  SharedInitializerStore* GetSharedInitializerStore() const {
+    if (parent_ != nullptr) {
+      return parent_->GetSharedInitializerStore();
+    }
+    return shared_initializer_store_;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionState);
 
@@ -393,6 +438,9 @@ class SessionState {
   // create kernels using info in kernel_create_info_map_
   Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
 
+  // set lean_execution_order_ if the execution plan and the kernels can run in the lean execution loop
+  void SetupLeanExecution(const SessionOptions& session_options);
+
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
   void CleanInitializedTensorsFromGraph();
@@ -495,6 +543,7 @@ class SessionState {
   // munmap memory region and close file descriptor
   InlinedVector<BufferUniquePtr> weights_buffers_;
   std::optional<SequentialExecutionPlan> p_seq_exec_plan_;
+  std::optional<InlinedVector<NodeIndex>> lean_execution_order_;
 
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
@@ -505,23 +554,27 @@ class SessionState {
 
 #if !defined(ORT_MINIMAL_BUILD)
   NodeStatsRecorder* node_stats_recorder_ = nullptr;
+  NodeMemoryStatsCollector* node_memory_stats_collector_ = nullptr;
 #endif
 
+  SharedInitializerStore* shared_initializer_store_ = nullptr;
+
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
   // lock for the mem_patterns_
   mutable std::mutex mem_patterns_lock_;
-  // cache for the generated mem_patterns. key is calculated based on input shapes.
-  // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
-  // This is mutable under mutex in training scenarios so execution frame would make a copy
-  // of the value when created.
-#ifdef ENABLE_TRAINING
-  mutable NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#else
-  NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#endif
+  // cache for the generated mem_patterns and the shapes inferred with them in training scenarios.
+  // key is calculated based on (optionally bucketed) input shapes.
+  mutable MemoryPatternCache mem_patterns_;
+
+  // whether the peak of a new memory pattern is reserved in the arena of its location, and the largest peak reserved
+  // per location. guarded by mem_patterns_lock_.
+  bool reserve_mem_pattern_peaks_ = false;
+  mutable std::map<OrtDevice, size_t> reserved_mem_pattern_peaks_;
+
+  // allocation plan loaded from an ORT format model. not owned.
+  const SavedAllocationPlan* saved_allocation_plan_ = nullptr;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -1,11 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <core/common/status.h>
 
@@ -14,6 +16,8 @@
 #include "core/framework/session_state_utils.h"
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
+#include "core/common/parse_string.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/graph_partitioner.h"
@@ -22,12 +26,14 @@
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shared_initializer_store.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/framework/bfc_arena.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -97,7 +103,10 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   const auto device = memory_info.device;
 
   if (utils::HasExternalData(tensor_proto)) {
-    auto external_data_loader = external_data_loader_mgr.GetExternalDataLoader(memory_info);
+    // data that is already in memory, e.g. an initializer added by an optimizer, has no file to load from
+    auto external_data_loader = utils::HasExternalDataInMemory(tensor_proto)
+                                    ? nullptr
+                                    : external_data_loader_mgr.GetExternalDataLoader(memory_info);
     if (external_data_loader) {
       // if custom external data loader is used, always allocate memory on device
       ORT_RETURN_IF_ERROR(AllocateTensor(memory_buffer, tensor, type, tensor_shape, use_device_allocator_for_initializers, alloc));
@@ -115,6 +124,27 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
                                                            ort_value,
                                                            &prepacked_for_graph));
       return common::Status::OK();
+    } else if (device.Type() == OrtDevice::CPU && device.MemType() == OrtDevice::MemType::DEFAULT) {
+      // an EP consuming plain host memory, e.g. with a larger alignment than the CPU EP, can also use the mmap'd
+      // buffer or the in-memory data (e.g. the bytes of an ORT format model) directly if it is aligned for the EP.
+      OrtValue deserialized_value;
+      ORT_RETURN_IF_ERROR(utils::GetExtDataFromTensorProto(env, proto_path, tensor_proto,
+                                                           deserialized_value,
+                                                           &prepacked_for_graph));
+      const Tensor& deserialized_tensor = deserialized_value.Get<Tensor>();
+      void* data = const_cast<void*>(deserialized_tensor.DataRaw());
+      if (reinterpret_cast<uintptr_t>(data) % std::max<size_t>(device.GetAlignment(), 1) == 0) {
+        // view the data from the EP's device, keeping the mapping or the buffer alive
+        auto p_tensor = std::make_unique<Tensor>(type, tensor_shape, data, memory_info);
+        ort_value.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(),
+                       [deserialized_value](void* t) { delete static_cast<Tensor*>(t); });
+        return common::Status::OK();
+      }
+
+      ORT_RETURN_IF_ERROR(AllocateTensor(memory_buffer, tensor, type, tensor_shape, use_device_allocator_for_initializers, alloc));
+      memcpy(tensor.MutableDataRaw(), data, deserialized_tensor.SizeInBytes());
+      Tensor::InitOrtValue(std::move(tensor), ort_value);
+      return common::Status::OK();
     } else {  // non-cpu tensor or tensor in a cpu accessible memory
       if (utils::HasString(tensor_proto)) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "string tensor is not supported for copying between allocators");
@@ -222,6 +252,23 @@ common::Status CopyTensorFromCPUToDevice(
   }
 }
 
+size_t GetInitializerLoadMaxConcurrency(const SessionOptions& session_options,
+                                        concurrency::ThreadPool* thread_pool) {
+  const std::string config_value = session_options.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsInitializerLoadMaxConcurrency, "0");
+  int64_t max_concurrency = 0;
+  if (!TryParseStringWithClassicLocale(config_value, max_concurrency) || max_concurrency < 0) {
+    max_concurrency = 0;
+  }
+
+  const auto degree_of_parallelism =
+      static_cast<int64_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
+  if (max_concurrency == 0 || max_concurrency > degree_of_parallelism) {
+    max_concurrency = degree_of_parallelism;
+  }
+  return static_cast<size_t>(std::max<int64_t>(max_concurrency, 1));
+}
+
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_alloc,
@@ -235,7 +282,9 @@ common::Status SaveInitializedTensors(
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
-    PrepackedWeightsForGraph& prepacked_for_graph) {
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    concurrency::ThreadPool* thread_pool,
+    SharedInitializerStore* shared_initializer_store) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -287,6 +336,26 @@ common::Status SaveInitializedTensors(
 
   static const auto default_cpu_device = OrtDevice();
 
+  // constant CPU initializers shared by content with other sessions. they are not traced, as their buffer is
+  // allocated on its own so it can outlive the session.
+  InlinedHashMap<int, std::string> shared_initializer_keys;
+  if (shared_initializer_store != nullptr) {
+    for (const auto& [ort_value_index, tensor_proto] : id_to_initialized_tensor) {
+      const std::string& name = tensor_proto->name();
+      if (user_supplied_initializer_ids.count(ort_value_index) != 0 ||
+          exec_plan.GetLocation(ort_value_index) != default_cpu_device ||
+          !graph.IsConstantInitializer(name, /* check_outer_scope */ false)) {
+        continue;
+      }
+      if (OrtValue ort_value_from_graph; graph.GetOrtValueInitializer(name, ort_value_from_graph)) {
+        continue;
+      }
+      if (std::string key = SharedInitializerStore::GetKey(*tensor_proto); !key.empty()) {
+        shared_initializer_keys.emplace(ort_value_index, std::move(key));
+      }
+    }
+  }
+
   // tensors requiring a specific allocation order are traced first, to ensure they are allocated in order
   // NB1: vector with init allocation order may contain a subset of all tensors (or none at all)
   // NB2: only skip tracing and planning memory when data is external (i.e mmap) and on CPU.
@@ -304,8 +373,9 @@ common::Status SaveInitializedTensors(
     // - Values that are external and mapped from disk. We let the OS manage the memory.
     // - we do not trace values that are in memory because they may be sitting on top of the user allocated
     //   memory.
-    const bool trace_allocation = (exec_plan.GetLocation(ort_value_index) != default_cpu_device) ||
-                                  !utils::HasExternalData(*tensor_proto);
+    const bool trace_allocation = ((exec_plan.GetLocation(ort_value_index) != default_cpu_device) ||
+                                   !utils::HasExternalData(*tensor_proto)) &&
+                                  shared_initializer_keys.count(ort_value_index) == 0;
 
     if (trace_allocation) {
       // can not trace string tensor, and they exist only on CPU
@@ -320,6 +390,9 @@ common::Status SaveInitializedTensors(
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       continue;
     }
+    if (shared_initializer_keys.count(entry.first) != 0) {
+      continue;
+    }
     if (utils::HasString(*entry.second)) {
       // do not trace string tensor
       continue;
@@ -343,6 +416,67 @@ common::Status SaveInitializedTensors(
   }
 
   // 3. create weight tensors based on weights buffer
+  auto save_tensor = [&](const std::string& name, int ort_value_index, const OrtValue& ort_value) -> Status {
+    // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
+    // so we need to output this message prior to calling save_tensor_func
+    VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
+
+    // any outer scope value is shadowed by a local value and can't override it.
+    // due to that check_outer_scope is false
+    const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
+#if !defined(DISABLE_SPARSE_TENSORS)
+    const bool sparse = graph.GetGraph().IsSparseInitializer(name);
+    return save_tensor_func(name, ort_value_index, ort_value, constant, sparse);
+#else
+    return save_tensor_func(name, ort_value_index, ort_value, constant, false);
+#endif
+  };
+
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+
+  // Initializers deserialized on CPU from the data in their TensorProto don't share any state, so they are
+  // deserialized on the thread pool in batches of up to max_concurrency, and saved in order once a batch is done.
+  // The other ones may load external data or copy to a device, and are deserialized one at a time.
+  struct PendingInitializer {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::optional<MemBuffer> memory_buffer;
+    AllocatorPtr alloc;
+    OrtValue ort_value;
+    Status status;
+  };
+
+  const size_t max_concurrency = GetInitializerLoadMaxConcurrency(session_options, thread_pool);
+  std::vector<PendingInitializer> pending_initializers;
+  pending_initializers.reserve(max_concurrency);
+
+  auto save_pending_initializers = [&]() -> Status {
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, narrow<std::ptrdiff_t>(pending_initializers.size()), [&](std::ptrdiff_t i) {
+          auto& pending = pending_initializers[narrow<size_t>(i)];
+          pending.status = DeserializeTensorProto(env, graph_loc, *pending.tensor_proto,
+                                                  pending.memory_buffer.has_value() ? &*pending.memory_buffer : nullptr,
+                                                  pending.alloc, default_cpu_alloc, pending.ort_value,
+                                                  data_transfer_mgr, external_data_loader_mgr, prepacked_for_graph,
+                                                  use_device_allocator_for_initializers);
+        });
+
+    for (auto& pending : pending_initializers) {
+      const std::string& name = pending.tensor_proto->name();
+      if (!pending.status.IsOK()) {
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << name << " failed." << pending.status.ErrorMessage();
+        return Status(pending.status.Category(), pending.status.Code(), oss.str());
+      }
+      ORT_RETURN_IF_ERROR(save_tensor(name, pending.ort_value_index, pending.ort_value));
+    }
+
+    pending_initializers.clear();
+    return Status::OK();
+  };
+
   for (const auto& entry : id_to_initialized_tensor) {
     // We check for cancellation for every initializer since mapping from disk can be costly
     if (session_options.IsLoadCancellationFlagSet()) {
@@ -370,14 +504,11 @@ common::Status SaveInitializedTensors(
       AllocatorPtr alloc;
       // TODO: if the tensor need be copied, does it have enough room?
       ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, memory_buffer, alloc));
-      const bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(
-              kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+      const auto& memory_info = (alloc != nullptr) ? alloc->Info() : memory_buffer->GetAllocInfo();
 
       // Check if we already have an OrtValue for this initializer on CPU
       if (OrtValue ort_value_from_graph;
           graph.GetOrtValueInitializer(name, ort_value_from_graph)) {
-        const auto& memory_info = (alloc != nullptr) ? alloc->Info() : memory_buffer->GetAllocInfo();
         if (memory_info.device == default_cpu_device) {
           // This is on CPU use directly from the graph
           ort_value = std::move(ort_value_from_graph);
@@ -394,6 +525,31 @@ common::Status SaveInitializedTensors(
                                                         ort_value_from_graph.Get<Tensor>(),
                                                         std::move(tensor), ort_value));
         }
+      } else if (auto key_it = shared_initializer_keys.find(ort_value_index);
+                 key_it != shared_initializer_keys.end()) {
+        if (shared_initializer_store->TryGet(key_it->second, tensor_proto, ort_value)) {
+          VLOGS(logger, 1) << "Sharing initializer " << name << " loaded by another session.";
+        } else {
+          // the stored buffer must not hold on to the allocator of the session, e.g. its arena
+          OrtValue loaded_value;
+          Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, nullptr, CPUAllocator::DefaultInstance(),
+                                             default_cpu_alloc, loaded_value, data_transfer_mgr,
+                                             external_data_loader_mgr, prepacked_for_graph);
+          if (!st.IsOK()) {
+            std::ostringstream oss;
+            oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
+            return Status(st.Category(), st.Code(), oss.str());
+          }
+          ort_value = shared_initializer_store->Add(key_it->second, std::move(loaded_value));
+        }
+      } else if (max_concurrency > 1 && memory_info.device == default_cpu_device &&
+                 !utils::HasExternalData(tensor_proto)) {
+        pending_initializers.push_back(
+            PendingInitializer{ort_value_index, &tensor_proto, std::move(memory_buffer), std::move(alloc), {}, {}});
+        if (pending_initializers.size() == max_concurrency) {
+          ORT_RETURN_IF_ERROR(save_pending_initializers());
+        }
+        continue;
       } else {
         // We need to deserialize the tensor proto into an OrtValue
         // using the preallocated buffer or allocator.
@@ -410,21 +566,11 @@ common::Status SaveInitializedTensors(
       }
     }
 
-    // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
-    // so we need to output this message prior to calling save_tensor_func
-    VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
-
-    // any outer scope value is shadowed by a local value and can't override it.
-    // due to that check_outer_scope is false
-    const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
-#if !defined(DISABLE_SPARSE_TENSORS)
-    const bool sparse = graph.GetGraph().IsSparseInitializer(name);
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, constant, sparse));
-#else
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, constant, false));
-#endif
+    ORT_RETURN_IF_ERROR(save_tensor(name, ort_value_index, ort_value));
   }
 
+  ORT_RETURN_IF_ERROR(save_pending_initializers());
+
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
 }
@@ -26,6 +26,7 @@ class OrtValueNameIdxMap;
 class DataTransferManager;
 class ExternalDataLoaderManager;
 class NodeArg;
+class SharedInitializerStore;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
 #endif
@@ -34,6 +35,10 @@ namespace logging {
 class Logger;
 }
 
+namespace concurrency {
+class ThreadPool;
+}
+
 namespace session_state_utils {
 using SaveTensorFunction = std::function<Status(const std::string& name, int idx, const OrtValue& value,
                                                 bool constant, bool sparse)>;
@@ -51,7 +56,13 @@ common::Status SaveInitializedTensors(
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
-    PrepackedWeightsForGraph& prepacked_for_graph);
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    concurrency::ThreadPool* thread_pool,
+    SharedInitializerStore* shared_initializer_store = nullptr);
+
+// Returns the number of initializers deserialized, or of nodes pre-packed, at a time on thread_pool during session
+// initialization, as configured by kOrtSessionOptionsInitializerLoadMaxConcurrency. 1 means one at a time.
+size_t GetInitializerLoadMaxConcurrency(const SessionOptions& session_options, concurrency::ThreadPool* thread_pool);
 
 common::Status AllocateTensor(
     const onnxruntime::MemBuffer* memory_buffer,
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include <cstring>
+
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// A tensor viewing the buffer of the stored value, which it keeps alive.
+OrtValue MakeSharedValue(std::shared_ptr<OrtValue> stored) {
+  const Tensor& tensor = stored->Get<Tensor>();
+  auto p_tensor = std::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), const_cast<void*>(tensor.DataRaw()),
+                                           tensor.Location());
+  OrtValue value;
+  value.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(),
+             [stored = std::move(stored)](void* p) { delete static_cast<Tensor*>(p); });
+  return value;
+}
+
+}  // namespace
+
+std::string SharedInitializerStore::GetKey(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  if (utils::HasString(tensor_proto) || utils::HasExternalData(tensor_proto) || !utils::HasRawData(tensor_proto)) {
+    return {};
+  }
+
+  const std::string& raw_data = tensor_proto.raw_data();
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(raw_data.data(), raw_data.size(), hash[0], &hash);
+
+  std::string key = std::to_string(tensor_proto.data_type());
+  for (const auto dim : tensor_proto.dims()) {
+    key += ',';
+    key += std::to_string(dim);
+  }
+  for (const auto h : hash) {
+    key += ':';
+    key += std::to_string(h);
+  }
+  return key;
+}
+
+bool SharedInitializerStore::TryGet(const std::string& key, const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                    OrtValue& value) {
+  std::shared_ptr<OrtValue> stored;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = values_.find(key);
+    if (it == values_.end()) {
+      return false;
+    }
+    stored = it->second.lock();
+    if (stored == nullptr) {
+      values_.erase(it);
+      return false;
+    }
+  }
+
+  // the key is a hash, so compare the bytes
+  const Tensor& tensor = stored->Get<Tensor>();
+  const std::string& raw_data = tensor_proto.raw_data();
+  if (tensor.SizeInBytes() != raw_data.size() || memcmp(tensor.DataRaw(), raw_data.data(), raw_data.size()) != 0) {
+    return false;
+  }
+
+  value = MakeSharedValue(std::move(stored));
+  return true;
+}
+
+OrtValue SharedInitializerStore::Add(const std::string& key, OrtValue value) {
+  std::shared_ptr<OrtValue> stored;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = values_[key];
+    stored = entry.lock();
+    if (stored == nullptr) {
+      stored = std::make_shared<OrtValue>(std::move(value));
+      entry = stored;
+      return MakeSharedValue(std::move(stored));
+    }
+  }
+
+  // keep a value whose hash collides with a different stored one to itself
+  const Tensor& stored_tensor = stored->Get<Tensor>();
+  const Tensor& tensor = value.Get<Tensor>();
+  if (stored_tensor.SizeInBytes() != tensor.SizeInBytes() ||
+      memcmp(stored_tensor.DataRaw(), tensor.DataRaw(), tensor.SizeInBytes()) != 0) {
+    return value;
+  }
+  return MakeSharedValue(std::move(stored));
+}
+
+size_t SharedInitializerStore::GetNumberOfElements() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t count = 0;
+  for (const auto& entry : values_) {
+    count += entry.second.expired() ? 0 : 1;
+  }
+  return count;
+}
+
+}  // namespace onnxruntime
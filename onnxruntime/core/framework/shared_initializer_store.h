@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/framework/ort_value.h"
+
+namespace ONNX_NAMESPACE {
+class TensorProto;
+}
+
+namespace onnxruntime {
+
+/// <summary>
+/// A content-addressed store of the constant CPU initializers of the sessions of an environment that set
+/// kOrtSessionOptionsShareInitializersByContent. Sessions loading an initializer with the same data type, shape
+/// and bytes as one already loaded by another session share its buffer, read-only, instead of holding a copy.
+/// The store only holds weak references, so an initializer is freed once no session uses it.
+/// </summary>
+class SharedInitializerStore final {
+ public:
+  SharedInitializerStore() = default;
+
+  // Returns the key of an initializer whose data is in the raw_data of its TensorProto, or an empty string if the
+  // initializer can't be shared, e.g. a string tensor or one with external data.
+  static std::string GetKey(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+
+  // Sets value to a tensor sharing the buffer of the stored initializer with the key, if there is one and its bytes
+  // match the raw_data of tensor_proto.
+  bool TryGet(const std::string& key, const ONNX_NAMESPACE::TensorProto& tensor_proto, OrtValue& value);
+
+  // Stores value with the key and returns a tensor sharing its buffer. If another session stored an identical
+  // initializer meanwhile, the returned tensor shares that one instead.
+  OrtValue Add(const std::string& key, OrtValue value);
+
+  // Returns the number of initializers in the store that are still used by a session.
+  size_t GetNumberOfElements() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializerStore);
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::weak_ptr<OrtValue>> values_;
+};
+
+}  // namespace onnxruntime
@@ -224,15 +224,36 @@ void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& sess
   }
 #endif
 
+  // the stream may run on an inter-op thread, which takes the deadline and the tracing span of the run from the
+  // context
+  RunDeadline::Scope deadline_scope(ctx.GetDeadline());
+  RunTracer::Scope tracing_scope(ctx.GetTracingContext());
+
+  // the span ends before the task completes, as the run may return once all the tasks complete
+  RunTracer::Span node_group_span("NodeGroup");
+  if (node_group_span.IsActive()) {
+    node_group_span.SetDetail(MakeString(logic_stream->device_.ToString(), ", stream ", stream_idx));
+  }
+  auto complete_task = [&ctx, &node_group_span]() {
+    node_group_span.End();
+    ctx.CompleteTask();
+  };
+
   while (since < end) {
     if (!ctx.TaskStatus().IsOK()) {
-      ctx.CompleteTask();
+      complete_task();
       return;
     }
     if (terminate_flag) {
       Status status_made = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
       ctx.SetStatus(status_made);
-      ctx.CompleteTask();
+      complete_task();
+      return;
+    }
+    if (RunDeadline::Passed()) {
+      Status status_made = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to the deadline of the run having passed.");
+      ctx.SetStatus(status_made);
+      complete_task();
       return;
     }
     bool continue_flag = true;
@@ -248,18 +269,18 @@ void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& sess
     if (!status.IsOK()) {
       // terminate it
       ctx.SetStatus(status);
-      ctx.CompleteTask();
+      complete_task();
       return;
     }
     if (!continue_flag) {
       // break but not terminate
-      ctx.CompleteTask();
+      complete_task();
       return;
     }
     since++;
   }
   ORT_ENFORCE(since == end);
-  ctx.CompleteTask();
+  complete_task();
   return;
 }
 
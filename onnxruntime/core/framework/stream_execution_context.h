@@ -10,6 +10,8 @@
 #include "core/graph/basic_types.h"
 #include "core/common/inlined_containers.h"
 #include "core/framework/memory_info.h"
+#include "core/framework/run_deadline.h"
+#include "core/framework/run_tracer.h"
 #ifdef ENABLE_TRAINING
 #include "core/framework/partial_graph_execution_state.h"
 #endif
@@ -96,6 +98,15 @@ class StreamExecutionContext {
   // 2. multi-threads mode: use inter-op thread pool to schedule the N streams.
   bool SingleThreadMode() const { return single_thread_mode_; }
 
+  // The deadline of the run, taken from the thread creating the context.  See RunDeadline.
+  RunDeadline::Clock::time_point GetDeadline() const { return deadline_; }
+
+  // The tracing span of the graph execution, taken from the thread creating the context.  See RunTracer.
+  const RunTracer::Context& GetTracingContext() const { return tracing_context_; }
+
+  // Replaces the tracing span of a context reused by several executions.
+  void SetTracingContext(const RunTracer::Context& tracing_context) { tracing_context_ = tracing_context; }
+
   // Get the Stream instance for a given logic sequence.
   // return nullptr if the device of given logic sequence doesn't register stream support.
   Stream* GetDeviceStream(size_t idx);
@@ -171,6 +182,10 @@ class StreamExecutionContext {
 #endif
   const bool single_thread_mode_;
 
+  const RunDeadline::Clock::time_point deadline_{RunDeadline::Get()};
+
+  RunTracer::Context tracing_context_{RunTracer::Current()};
+
 #ifdef ORT_ENABLE_STREAM
   InlinedVector<std::unique_ptr<synchronize::Notification>> notifications_;
   // if it is nullptr, means current session doesn't have any EP using stream feature
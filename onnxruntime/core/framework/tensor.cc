@@ -3,6 +3,7 @@
 
 #include "core/framework/tensor.h"
 
+#include <cstdlib>
 #include <utility>
 #include "core/common/safeint.h"
 #include "core/framework/data_types.h"
@@ -20,7 +21,8 @@ int64_t GetSizeFromStrides(const TensorShape& shape, gsl::span<const int64_t> st
       size = 0;
       break;
     }
-    size += strides[dim] * (shape[dim] - 1);
+    // negative strides (e.g. a Slice with negative steps) span the storage backwards from the first element
+    size += std::abs(strides[dim]) * (shape[dim] - 1);
   }
   return size;
 }
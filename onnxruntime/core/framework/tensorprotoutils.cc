@@ -1012,8 +1012,12 @@ ORT_API(void, OrtUninitializeBuffer, _In_opt_ void* input, size_t input_len, enu
 #endif
 
 #if !defined(__wasm__)
+// Maps the data when possible so it is paged in on first use and shared between processes, otherwise copies it.
+// The mapped memory is only used if it is aligned to `alignment` and can be used as is, i.e. the data needs no
+// byte swapping on this platform.
 static Status GetFileContent(const Env& env, const std::filesystem::path& file_path, FileOffsetType offset,
-                             size_t length, IAllocatorUniquePtr<void>& external_data) {
+                             size_t length, IAllocatorUniquePtr<void>& external_data, size_t alignment = 1,
+                             bool can_use_mapped_data = true) {
   // query length if it is 0
   if (length == 0) {
     // The return type of std::filesystem::file_size is uintmax_t which could be bigger than size_t
@@ -1021,10 +1025,10 @@ static Status GetFileContent(const Env& env, const std::filesystem::path& file_p
   }
 
   // first, try to map into memory
-  {
+  if (can_use_mapped_data) {
     Env::MappedMemoryPtr mapped_memory{};
     auto status = env.MapFileIntoMemory(file_path.native().c_str(), offset, length, mapped_memory);
-    if (status.IsOK()) {
+    if (status.IsOK() && reinterpret_cast<uintptr_t>(mapped_memory.get()) % alignment == 0) {
       IAllocatorUniquePtr<void> raw_buffer(mapped_memory.release(),
                                            mapped_memory.get_deleter());
       external_data.swap(raw_buffer);
@@ -1118,16 +1122,18 @@ Status GetExtDataFromTensorProto(const Env& env,
                   " size to read: ", static_cast<size_t>(raw_data_safe_len), " given file_length: ", file_length,
                   " are out of bounds or can not be read in full.");
 
+    // the data is used as the tensor buffer, so it has to be aligned to the element size. the swap below writes to
+    // the buffer, so on big endian platforms multi-byte data is always copied.
+    const size_t alignment = std::min(type->Size(), alignof(std::max_align_t));
+    const bool needs_byte_swap = endian::native != endian::little && type->Size() > 1;
     IAllocatorUniquePtr<void> ext_data_buf;
     ORT_RETURN_IF_ERROR(GetFileContent(env, external_data_file_path, file_offset, raw_data_safe_len,
-                                       ext_data_buf));
+                                       ext_data_buf, alignment, !needs_byte_swap));
 
     // Data on disk is little endian
-    if constexpr (endian::native != endian::little) {
-      if (type->Size() > 1) {
-        gsl::span<std::byte> data_span{reinterpret_cast<std::byte*>(ext_data_buf.get()), raw_data_safe_len};
-        SwapByteOrderInplace(type->Size(), data_span);
-      }
+    if (needs_byte_swap) {
+      gsl::span<std::byte> data_span{reinterpret_cast<std::byte*>(ext_data_buf.get()), raw_data_safe_len};
+      SwapByteOrderInplace(type->Size(), data_span);
     }
 
     auto p_tensor = std::make_unique<Tensor>(type, tensor_shape, ext_data_buf.get(),
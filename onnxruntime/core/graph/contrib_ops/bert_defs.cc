@@ -344,6 +344,16 @@ void GroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext&
   // TODO(aciddelgado): propagate output shapes depending if kv-share buffer is on or not
   constexpr int use_max_past_present_buffer = -1;
   BaseGroupQueryAttentionTypeAndShapeInference(ctx, past_key_index, use_max_past_present_buffer);
+
+  // a quantized cache is int8 instead of the type of query
+  if (ctx.getNumOutputs() > 1) {
+    if (getAttribute(ctx, "k_quant_type", "NONE") != "NONE") {
+      updateOutputElemType(ctx, 1, ONNX_NAMESPACE::TensorProto::INT8);
+    }
+    if (getAttribute(ctx, "v_quant_type", "NONE") != "NONE") {
+      updateOutputElemType(ctx, 2, ONNX_NAMESPACE::TensorProto::INT8);
+    }
+  }
 }
 
 void SparseAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, int past_key_index) {
@@ -1094,6 +1104,8 @@ Only supports causal and local attention.
 Supports rotary position embedding for CPU and CUDA.
 Supports packed input for CPU and CUDA.
 Supports continuous decoding for batch_size == 1 for CPU and CUDA.
+Supports batches that mix prompts and token generation steps for CPU: when cumulative_sequence_length is given, query,
+key and value are the packed tokens of all sequences with shape (1, token_count, hidden_size).
 
 )DOC";
 
@@ -1127,6 +1139,16 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
               "Use a smooth factor in softmax.",
               AttributeProto::INT,
               static_cast<int64_t>(-1))
+        .Attr("k_quant_type",
+              "Quantization of the key cache: NONE for a cache of type T, or PER_TENSOR or PER_CHANNEL for an int8 cache "
+              "whose values are multiplied by k_scale. Default value is NONE.",
+              AttributeProto::STRING,
+              std::string("NONE"))
+        .Attr("v_quant_type",
+              "Quantization of the value cache: NONE for a cache of type T, or PER_TENSOR or PER_CHANNEL for an int8 "
+              "cache whose values are multiplied by v_scale. Default value is NONE.",
+              AttributeProto::STRING,
+              std::string("NONE"))
         .Input(0,
                "query",
                "Query with shape (batch_size, sequence_length, hidden_size), or packed QKV with shape"
@@ -1146,13 +1168,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "past_key",
                "past state key with support for format BNSH. When past_key uses same tensor as present_key"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(4,
                "past_value",
                "past state value with support for format BNSH. When past_value uses same tensor as present_value"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(5,
                "seqlens_k",
@@ -1184,6 +1206,31 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "additional add to QxK' with shape (batch_size or 1, num_heads or 1, sequence_length, total_sequence_length)",
                "T",
                OpSchema::Optional)
+        .Input(11,
+               "head_sink",
+               "1D tensor with shape (num_heads). Each head has a smooth factor adding to the denominator of softmax.",
+               "T",
+               OpSchema::Optional)
+        .Input(12,
+               "k_scale",
+               "Scale of the int8 key cache, with shape (1) when k_quant_type is PER_TENSOR or "
+               "(kv_num_heads, 1, head_size) when it is PER_CHANNEL. Required when k_quant_type is not NONE.",
+               "T_KV_SCALE",
+               OpSchema::Optional)
+        .Input(13,
+               "v_scale",
+               "Scale of the int8 value cache, with shape (1) when v_quant_type is PER_TENSOR or "
+               "(kv_num_heads, 1, head_size) when it is PER_CHANNEL. Required when v_quant_type is not NONE.",
+               "T_KV_SCALE",
+               OpSchema::Optional)
+        .Input(14,
+               "cumulative_sequence_length",
+               "1D tensor with shape (batch_size + 1). When it is given, query, key and value have shape "
+               "(1, token_count, hidden_size) and sequence b has the tokens [cumulative_sequence_length[b], "
+               "cumulative_sequence_length[b + 1]), which follow its seqlens_k[b] + 1 - (number of tokens) "
+               "past tokens, so each sequence may be a prompt or a token generation step.",
+               "M",
+               OpSchema::Optional)
         .Output(0,
                 "output",
                 "3D output tensor with shape (batch_size, sequence_length, hidden_size)",
@@ -1193,14 +1240,17 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "present state key with support for format BNSH. When past_key uses same tensor as present_key"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .Output(2,
                 "present_value",
                 "present state value with support for format BNSH. When past_value uses same tensor as present_value"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .TypeConstraint("T", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("T_CACHE", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)", "tensor(int8)"},
+                        "Constrain the KV cache to float tensors, or int8 tensors when it is quantized.")
+        .TypeConstraint("T_KV_SCALE", {"tensor(float)"}, "Constrain the KV cache scales to float tensors.")
         .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask to int tensor.")
         .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
           GroupQueryAttentionTypeAndShapeInference(ctx, 3);
@@ -1209,8 +1259,9 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
 constexpr const char* PagedAttention_ver1_doc = R"DOC(
 Paged Attention.
 
-This op leverages a block-based KV cache to enable continuous batching for LLMs. Currently, it is designed to work with
-the CUDA Execution Provider only.
+This op leverages a block-based KV cache to enable continuous batching for LLMs. It is implemented for the CUDA and CPU
+Execution Providers. The CUDA kernel requires a block size that is a multiple of 256 and float16 or bfloat16 inputs,
+and the CPU kernel supports float and float16 inputs.
 
 In other attention ops, batch entries typically aren't of the same length, so they are padded.
 Below is a batch with 3 sequences where * denotes a padding token.
@@ -1396,7 +1447,8 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "the same tensor as value_cache.",
                 "T",
                 OpSchema::Optional)
-        .TypeConstraint("T", {"tensor(float16)", "tensor(bfloat16)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("T", {"tensor(float)", "tensor(float16)", "tensor(bfloat16)"},
+                        "Constrain input and output to float tensors.")
         .TypeConstraint("S", {"tensor(int32)"}, "Constrain Positional inputs to int tensor.")
         .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
           PagedAttentionTypeAndShapeInference(ctx);
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 #include "core/graph/contrib_ops/contrib_defs.h"
 
+#include <algorithm>
 #include <cmath>
 #include "core/graph/onnx_protobuf.h"
 
@@ -631,6 +632,157 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           return true;
         }));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+Applies a chain of elementwise operators to X = inputs[0] in a single pass over the data.
+ops lists the ONNX operator types in the order they are applied. For a binary operator, operand_indices holds the
+index in inputs of its other operand, which is a scalar, a tensor with the shape of X, or a 1-D tensor with the
+size of the last dimension of X. operand_first is 1 if that operand is the first input of the operator
+(e.g. Sub(operand, value)). For a unary operator both are ignored.
+Supported operators are Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Exp, Log, Neg, Abs, Sqrt, Reciprocal and Erf.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    FusedElementwise, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(FusedElementwise_ver1_doc)
+        .Attr("ops", "Operator types of the chain, in order of application.", AttributeProto::STRINGS)
+        .Attr("operand_indices", "Index in inputs of the other operand of each binary operator, -1 for unary ones.",
+              AttributeProto::INTS)
+        .Attr("operand_first", "1 if the other operand is the first input of the binary operator, else 0.",
+              AttributeProto::INTS)
+        .Input(0, "inputs", "X followed by the operands of the binary operators.", "T", OpSchema::Variadic, true, 1)
+        .Output(0, "Y", "The output, with the shape of X.", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
+constexpr const char* MultiReduce_ver1_doc = R"DOC(
+Computes several reductions of data over the same axes in a single pass over the data. Output i is the result of
+the reduction named by reduce_ops[i], with the semantics of the ONNX operator of that name and the given axes and
+keepdims. An empty axes reduces over all the dimensions.
+Supported reductions are ReduceSum, ReduceMean, ReduceSumSquare, ReduceL1, ReduceL2, ReduceMax and ReduceMin.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    MultiReduce, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(MultiReduce_ver1_doc)
+        .Attr("reduce_ops", "ONNX reduction operator types, one per output.", AttributeProto::STRINGS)
+        .Attr("axes", "Axes to reduce over. Empty means all the axes.", AttributeProto::INTS, OPTIONAL_VALUE)
+        .Attr("keepdims", "Keep the reduced dimensions with size 1 if 1.", AttributeProto::INT, static_cast<int64_t>(1))
+        .Input(0, "data", "An input tensor.", "T")
+        .Output(0, "reduced", "The reductions of data, in the order of reduce_ops.", "T", OpSchema::Variadic, true, 1)
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+            propagateElemTypeFromInputToOutput(ctx, 0, i);
+          }
+
+          if (!hasInputShape(ctx, 0)) {
+            return;
+          }
+
+          const auto& input_shape = getInputShape(ctx, 0);
+          const int64_t rank = input_shape.dim_size();
+          std::vector<int64_t> axes;
+          getRepeatedAttribute(ctx, "axes", axes);
+          for (auto& axis : axes) {
+            if (rank > 0 && (axis < -rank || axis >= rank)) {
+              fail_shape_inference("axis ", axis, " is out of range for an input of rank ", rank);
+            }
+            axis = HandleNegativeAxis(axis, rank);
+          }
+
+          const bool keepdims = getAttribute(ctx, "keepdims", 1) != 0;
+          TensorShapeProto output_shape;
+          for (int64_t i = 0; i < rank; ++i) {
+            if (axes.empty() || std::find(axes.begin(), axes.end(), i) != axes.end()) {
+              if (keepdims) {
+                output_shape.add_dim()->set_dim_value(1);
+              }
+            } else {
+              *output_shape.add_dim() = input_shape.dim(static_cast<int>(i));
+            }
+          }
+
+          for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+            updateOutputShape(ctx, i, output_shape);
+          }
+        }));
+
+constexpr const char* EmbeddingBag_ver1_doc = R"DOC(
+Computes the sum or the mean of each bag of rows of an embedding table, without materializing the gathered rows.
+With 2-D indices of shape [num_bags, bag_size], bag b holds the rows indices[b, :]. With 1-D indices, exactly one of
+offsets and lengths is required: bag b holds the rows indices[offsets[b]:offsets[b + 1]], the last bag ending at the
+end of indices, or the lengths[b] rows following the rows of the previous bags. Negative indices count from the end
+of the table. per_sample_weights, only allowed in the "sum" mode, scales each row before it is added to its bag.
+The mean of an empty bag is 0. An int8 table is dequantized with table_scale, a scalar or one scale per row, and
+produces a float output. The rows are accumulated in float.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    EmbeddingBag, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(EmbeddingBag_ver1_doc)
+        .Attr("mode", "How the rows of a bag are combined: \"sum\" or \"mean\".", AttributeProto::STRING,
+              std::string("sum"))
+        .Input(0, "table", "The embedding table, of shape [num_embeddings, embedding_dim].", "T1")
+        .Input(1, "indices", "The rows of the bags, of shape [num_bags, bag_size], or 1-D with offsets or lengths.",
+               "Tind")
+        .Input(2, "offsets", "1-D start of each bag in the 1-D indices, of shape [num_bags].", "Tind",
+               OpSchema::Optional)
+        .Input(3, "lengths", "1-D number of rows of each bag in the 1-D indices, of shape [num_bags].", "Tind",
+               OpSchema::Optional)
+        .Input(4, "per_sample_weights", "The weight of each row, of the shape of indices.", "T", OpSchema::Optional)
+        .Input(5, "table_scale", "The scale of an int8 table, a scalar or of shape [num_embeddings].",
+               "tensor(float)", OpSchema::Optional)
+        .Output(0, "output", "The combined bags, of shape [num_bags, embedding_dim].", "T")
+        .TypeConstraint("T1", {"tensor(float)", "tensor(float16)", "tensor(int8)"},
+                        "Constrain the table to float or int8 tensors.")
+        .TypeConstraint("T", {"tensor(float)", "tensor(float16)"},
+                        "Constrain the output to the type of a float table, or float for an int8 table.")
+        .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          const auto* table_type = ctx.getInputType(0);
+          if (table_type != nullptr &&
+              table_type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_INT8) {
+            updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+          } else {
+            propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          }
+          if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+            return;
+          }
+
+          const auto& table_shape = getInputShape(ctx, 0);
+          const auto& indices_shape = getInputShape(ctx, 1);
+          if (table_shape.dim_size() != 2) {
+            fail_shape_inference("table must be 2-D");
+          }
+
+          TensorShapeProto output_shape;
+          if (indices_shape.dim_size() == 2) {
+            *output_shape.add_dim() = indices_shape.dim(0);
+          } else if (indices_shape.dim_size() == 1) {
+            // the bag boundaries come from offsets or lengths, whichever is given.
+            const size_t bounds_index = hasInputShape(ctx, 2) ? 2 : 3;
+            if (!hasInputShape(ctx, bounds_index)) {
+              return;
+            }
+            const auto& bounds_shape = getInputShape(ctx, bounds_index);
+            if (bounds_shape.dim_size() != 1) {
+              fail_shape_inference("offsets and lengths must be 1-D");
+            }
+            *output_shape.add_dim() = bounds_shape.dim(0);
+          } else {
+            fail_shape_inference("indices must be 1-D or 2-D");
+          }
+          *output_shape.add_dim() = table_shape.dim(1);
+          updateOutputShape(ctx, 0, output_shape);
+        }));
+
 // Used to be ONNX 1.7 Inverse(12)
 // Comment out docs not to increase the binary size
 //
@@ -1321,6 +1473,14 @@ ONNX_MS_OPERATOR_SET_SCHEMA(GreedySearch, 1,
                                       "This is relevant only for the GPT2 model. If this attribute is missing, the `decoder` subgraph will be used for all decoding runs",
                                       AttributeProto::GRAPH, OPTIONAL_VALUE)
                                 .Attr("decoder", "Decoder subgraph to execute in a loop.", AttributeProto::GRAPH)
+                                .Attr("draft_decoder",
+                                      "A smaller GPT2 decoder subgraph for speculative decoding. In each step it proposes up to "
+                                      "`num_speculative_tokens` tokens, which are verified by a single run of the `decoder` subgraph. "
+                                      "The generated sequences are the same as without it. Supported on CPU with batch_size 1 only",
+                                      AttributeProto::GRAPH, OPTIONAL_VALUE)
+                                .Attr("num_speculative_tokens",
+                                      "The number of tokens proposed by the `draft_decoder` subgraph in each step",
+                                      AttributeProto::INT, static_cast<int64_t>(4))
                                 .Attr("vocab_size",
                                       "Size of the vocabulary. "
                                       "If not provided, it will be inferred from the decoder subgraph's output shape",
@@ -1871,12 +2031,18 @@ If tokenizer removes the entire content of [C]-input, it will produce [[]].
 I.e. the output shape should be [C][0] or [N][C][0] if input shape was [N][C].
 If the tokenizer receives empty input of [0] then the output is [0] if empty input
 of [N, 0] then [N, 0].
+If "ragged" is true, the tokens are not padded: Y is 1-D and holds the tokens of all the input strings one after the other,
+markers included. The optional output "row_splits" of shape [N * C + 1] gives the offsets of the tokens of every input string:
+the i-th string (in row major order) has row_splits[i + 1] - row_splits[i] tokens, which start at row_splits[i] in the ragged Y.
+In padded mode, row_splits holds the same values, so it gives the number of tokens of every string before the padding.
 )DOC";
 
 ONNX_MS_OPERATOR_SET_SCHEMA(Tokenizer, 1,
                             OpSchema()
                                 .Input(0, "X", "Strings to tokenize", "T")
                                 .Output(0, "Y", "Tokenized strings", "T")
+                                .Output(1, "row_splits", "Offsets of the tokens of every input string in the ragged output",
+                                        "tensor(int64)", OpSchema::Optional)
                                 .TypeConstraint(
                                     "T",
                                     {"tensor(string)"},
@@ -1910,9 +2076,18 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Tokenizer, 1,
                                     "mincharnum",
                                     "Minimum number of characters allowed in the output. For example, if mincharnum is 2, tokens such as \"A\" and \"B\" would be ignored",
                                     AttributeProto::INT)
+                                .Attr(
+                                    "ragged",
+                                    "Boolean whether to output the tokens of all the strings one after the other in a 1-D Y instead of padding them.",
+                                    AttributeProto::INT,
+                                    static_cast<int64_t>(0))
                                 .SetDoc(Tokenizer_ver1_doc)
                                 .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
                                   propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  const bool ragged = getAttribute(ctx, "ragged", int64_t(0)) != 0;
+                                  if (ctx.getNumOutputs() > 1) {
+                                    updateOutputElemType(ctx, 1, ONNX_NAMESPACE::TensorProto::INT64);
+                                  }
 
                                   // Shape inference
                                   if (!hasInputShape(ctx, 0))
@@ -1926,13 +2101,30 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Tokenizer, 1,
                                   }
 
                                   int64_t size = 1;
+                                  bool size_known = true;
                                   for (auto& dim : dims) {
                                     if (utils::HasDimValue(dim)) {
                                       size *= dim.dim_value();
+                                    } else {
+                                      size_known = false;
+                                    }
+                                  }
+
+                                  if (ctx.getNumOutputs() > 1) {
+                                    ONNX_NAMESPACE::TensorShapeProto row_splits_shape;
+                                    auto* row_splits_dim = row_splits_shape.add_dim();
+                                    if (size_known) {
+                                      row_splits_dim->set_dim_value(size + 1);
                                     }
+                                    updateOutputShape(ctx, 1, row_splits_shape);
                                   }
 
-                                  if (size > 0) {
+                                  if (ragged) {
+                                    auto* dim = output_shape.add_dim();
+                                    if (size == 0) {
+                                      dim->set_dim_value(0);
+                                    }
+                                  } else if (size > 0) {
                                     for (auto& dim : dims) {
                                       *output_shape.add_dim() = dim;
                                     }
@@ -2263,6 +2455,42 @@ ONNX_MS_OPERATOR_SET_SCHEMA(SparseToDenseMatMul, 1,
                                   sparseCompatibleMatmulShapeInference(ctx, 0, 1);
                                 }));
 
+constexpr const char* BatchedLoraMatMul_doc = R"DOC(
+Computes the LoRA update of a batch in which each entry uses its own adapter, as the gathered low-rank products
+`Y[b] = scale * (X[b] * A[adapter_index[b]]) * B[adapter_index[b]]`. A and B stack the weights of the adapters along
+their first dimension, so the adapters stay bound to the session between runs and a run selects them by index only.
+Consecutive batch entries using the same adapter are multiplied together. Entries with a negative adapter index
+use no adapter and get a zero update. Y is meant to be added to the output of the MatMul with the base weights.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    BatchedLoraMatMul, 1,
+    OpSchema()
+        .SetDoc(BatchedLoraMatMul_doc)
+        .Attr("scale", "Scaling factor of the update, e.g. alpha / rank.", AttributeProto::FLOAT, 1.0f)
+        .Input(0, "X", "Input tensor with shape (batch_size, ..., K)", "T")
+        .Input(1, "A", "Stacked down projections of the adapters, with shape (num_adapters, K, rank)", "T")
+        .Input(2, "B", "Stacked up projections of the adapters, with shape (num_adapters, rank, N)", "T")
+        .Input(3, "adapter_index",
+               "Adapter of each batch entry, with shape (batch_size). A negative index selects no adapter.",
+               "tensor(int32)")
+        .Output(0, "Y", "Output tensor with shape (batch_size, ..., N)", "T")
+        .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 2)) {
+            return;
+          }
+          const auto& x_shape = getInputShape(ctx, 0);
+          const auto& b_shape = getInputShape(ctx, 2);
+          if (x_shape.dim_size() < 2 || b_shape.dim_size() != 3) {
+            fail_shape_inference("X is expected to have at least 2 dimensions and B 3 dimensions");
+          }
+          ONNX_NAMESPACE::TensorShapeProto y_shape(x_shape);
+          *y_shape.mutable_dim(y_shape.dim_size() - 1) = b_shape.dim(2);
+          updateOutputShape(ctx, 0, y_shape);
+        }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(MurmurHash3, 1,
                             OpSchema()
                                 .SetDoc(R"DOC(The underlying implementation is MurmurHash3_x86_32 generating low latency 32bits hash suitable for implementing lookup tables, Bloom filters, count min sketch or feature hashing.)DOC")
@@ -289,6 +289,7 @@ bool NodeArg::HasTensorOrScalarShape() const {
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 void NodeArg::SetShape(const TensorShapeProto& shape) {
+  changed_since_resolve_ = true;
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
     case TypeProto::kTensorType:
@@ -320,6 +321,7 @@ void NodeArg::SetShape(const TensorShapeProto& shape) {
 }
 
 void NodeArg::ClearShape() {
+  changed_since_resolve_ = true;
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
     case TypeProto::kTensorType:
@@ -383,6 +385,7 @@ common::Status NodeArg::OverrideTypesHelper(const ONNX_NAMESPACE::TypeProto& inp
 
 common::Status NodeArg::UpdateTypeAndShape(const ONNX_NAMESPACE::TypeProto& input_type, bool strict,
                                            bool override_types, const logging::Logger& logger) {
+  changed_since_resolve_ = true;
   if (!utils::HasType(node_arg_info_)) {
     SetType(input_type);
     return Status::OK();
@@ -506,6 +509,7 @@ void NodeArg::SetType(DataType p_type) {
 
   type_ = p_type;
   *(node_arg_info_.mutable_type()) = DataTypeUtils::ToTypeProto(p_type);
+  changed_since_resolve_ = true;
 }
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -515,6 +519,7 @@ void NodeArg::SetType(DataType p_type) {
 void NodeArg::SetType(const TypeProto& type_proto) {
   type_ = DataTypeUtils::ToType(type_proto);
   *(node_arg_info_.mutable_type()) = type_proto;
+  changed_since_resolve_ = true;
 }
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -643,6 +648,7 @@ bool Node::TryGetFunctionProto(ONNX_NAMESPACE::FunctionProto& onnx_function_prot
 }
 
 void Node::SetFunctionTemplate(const FunctionTemplate& func_template) {
+  type_inference_needed_ = true;
   op_ = func_template.op_schema_.get();
   since_version_ = op_->since_version();
   func_template_ = &func_template;
@@ -957,6 +963,7 @@ Node::Definitions& Node::MutableDefinitions() noexcept {
   // someone fetching these is going to change something
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  type_inference_needed_ = true;
   return definitions_;
 }
 
@@ -984,6 +991,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 
 void Node::AddAttributeProto(AttributeProto value) {
   utils::SetNodeAttribute(std::move(value), attributes_);
+  type_inference_needed_ = true;
   if (graph_) {
     graph_->SetGraphResolveNeeded();
     graph_->SetGraphProtoSyncNeeded();
@@ -1034,6 +1042,7 @@ void Node::AddAttribute(std::string attr_name, GraphProto value) {
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  type_inference_needed_ = true;
   return attributes_.erase(attr_name) > 0;
 }
 
@@ -1042,6 +1051,7 @@ bool Node::ClearAttribute(const std::string& attr_name) {
 int Node::PruneRemovableAttributes(gsl::span<const std::string> removable_attributes) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  type_inference_needed_ = true;
   int n_removed = 0;
   for (const auto& name : removable_attributes) {
     n_removed += static_cast<int>(attributes_.erase(name));
@@ -1124,6 +1134,7 @@ const Graph* Node::GetGraphAttribute(const std::string& attr_name) const {
 
 void Node::ReplaceDefs(const std::map<const onnxruntime::NodeArg*, onnxruntime::NodeArg*>& replacements) {
   std::vector<std::vector<NodeArg*>*> all_defs = {&definitions_.input_defs, &definitions_.output_defs};
+  type_inference_needed_ = true;
 
   for (auto pair : replacements)
     for (auto* defs : all_defs)
@@ -1515,6 +1526,8 @@ Status Graph::VerifyNoDuplicateName() {
 
   output_args.clear();
   node_name_to_index.clear();
+  output_args.reserve(node_args_.size());
+  node_name_to_index.reserve(static_cast<size_t>(std::max(num_of_nodes_, 0)));
   // inputs_and_initializers: this is passed in as a parameter, since functions don't have initializers
   // but graphs have them.
 
@@ -1522,15 +1535,13 @@ Status Graph::VerifyNoDuplicateName() {
     // Verify node name should be unique.
     auto& node_name = node.Name();
 
-    if (!node_name.empty() && node_name_to_index.end() != node_name_to_index.find(node_name)) {
+    if (!node_name_to_index.insert_or_assign(node_name, node.Index()).second && !node_name.empty()) {
       // The node has name and its name was used by another node.
       Status status(ONNXRUNTIME, onnxruntime::common::StatusCode::FAIL,
                     "This is an invalid model. Error: two nodes with same node name (" + node_name + ").");
       return status;
     }
 
-    node_name_to_index[node_name] = node.Index();
-
     // Verify node outputs' name should be unique.
     int output_index = -1;
     for (const auto* output_def : node.OutputDefs()) {
@@ -1576,27 +1587,26 @@ void Graph::AddEdge(NodeIndex src_node_index, NodeIndex dst_node_index, int src_
     ORT_THROW("Invalid node indexes specified when adding edge.");
   }
 
+  // the definitions are only modified when the input of the destination is replaced, so the nodes are not marked as
+  // needing type inference for an edge between values they already have
   NodeArg* src_arg = nullptr;
   NodeArg* dst_arg = nullptr;
-  if (nodes_[src_node_index]->MutableDefinitions().output_defs.size() > static_cast<size_t>(src_arg_slot)) {
-    src_arg = nodes_[src_node_index]->MutableDefinitions().output_defs[src_arg_slot];
+  const auto& src_node_defs = nodes_[src_node_index]->GetDefinitions();
+  if (src_node_defs.output_defs.size() > static_cast<size_t>(src_arg_slot)) {
+    src_arg = src_node_defs.output_defs[src_arg_slot];
   }
 
   if (nullptr == src_arg) {
     ORT_THROW("Invalid source node arg slot specified when adding edge.");
   }
 
-  auto& dst_node_defs = nodes_[dst_node_index]->MutableDefinitions();
-  NodeArg** dst_arg_pointer = nullptr;
-  if (dst_node_defs.input_defs.size() > static_cast<size_t>(dst_arg_slot)) {
-    dst_arg_pointer = &dst_node_defs.input_defs[dst_arg_slot];
-    dst_arg = *dst_arg_pointer;
-  } else {
-    auto num_of_explicit_inputs = dst_node_defs.input_defs.size();
-    if (num_of_explicit_inputs + dst_node_defs.implicit_input_defs.size() > static_cast<size_t>(dst_arg_slot)) {
-      dst_arg_pointer = &dst_node_defs.implicit_input_defs[dst_arg_slot - num_of_explicit_inputs];
-      dst_arg = *dst_arg_pointer;
-    }
+  const auto& dst_node_defs = nodes_[dst_node_index]->GetDefinitions();
+  const size_t num_of_explicit_inputs = dst_node_defs.input_defs.size();
+  const auto dst_slot = static_cast<size_t>(dst_arg_slot);
+  if (dst_slot < num_of_explicit_inputs) {
+    dst_arg = dst_node_defs.input_defs[dst_slot];
+  } else if (dst_slot < num_of_explicit_inputs + dst_node_defs.implicit_input_defs.size()) {
+    dst_arg = dst_node_defs.implicit_input_defs[dst_slot - num_of_explicit_inputs];
   }
   if (nullptr == dst_arg) {
     ORT_THROW("Invalid destination node arg slot specified when adding edge.");
@@ -1607,7 +1617,12 @@ void Graph::AddEdge(NodeIndex src_node_index, NodeIndex dst_node_index, int src_
       // The output type of source node arg does not match the input type of destination node arg.
       ORT_THROW("Argument type mismatch when adding edge.");
     }
-    *dst_arg_pointer = src_arg;
+    auto& mutable_dst_node_defs = nodes_[dst_node_index]->MutableDefinitions();
+    if (dst_slot < num_of_explicit_inputs) {
+      mutable_dst_node_defs.input_defs[dst_slot] = src_arg;
+    } else {
+      mutable_dst_node_defs.implicit_input_defs[dst_slot - num_of_explicit_inputs] = src_arg;
+    }
   }
 
   nodes_[src_node_index]->MutableRelationships().output_edges.insert(Node::EdgeEnd(*nodes_[dst_node_index],
@@ -2440,9 +2455,12 @@ void Graph::MemoryEfficientTopologicalSort(const Node* yield_op,
 GSL_SUPPRESS(es .84)  // noisy warning about ignoring return value from insert(...)
 Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
   nodes_in_topological_order_.clear();
-  std::unordered_set<NodeIndex> downstream_nodes;  // nodes downstream of the node we're currently checking
-  std::unordered_set<NodeIndex> nodes_seen;        // nodes we have seen but may not have been added to nodes_added yet
-  std::unordered_set<NodeIndex> nodes_added;       // nodes added to topo order
+  nodes_in_topological_order_.reserve(static_cast<size_t>(std::max(num_of_nodes_, 0)));
+  // flags indexed by NodeIndex, as node indexes are dense
+  const auto max_node_index = static_cast<size_t>(MaxNodeIndex());
+  std::vector<bool> downstream_nodes(max_node_index);  // nodes downstream of the node we're currently checking
+  std::vector<bool> nodes_seen(max_node_index);        // nodes we have seen but may not have been added to nodes_added yet
+  std::vector<bool> nodes_added(max_node_index);       // nodes added to topo order
   std::stack<NodeIndex> stack;
 
   // push the root nodes into nodes_in_topological_order in the order they were defined in the model
@@ -2455,7 +2473,7 @@ Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
                   // find the top level nodes in the graph.
                   // need to also consider nodes that only have Constants as inputs as top level nodes,
                   // as the constant will get replaced by an initializer.
-                  auto input_edges = node.GetRelationships().input_edges;
+                  const auto& input_edges = node.GetRelationships().input_edges;
                   auto has_inputs = std::any_of(input_edges.cbegin(), input_edges.cend(),
                                                 [](const Node::EdgeEnd& edge) {
                                                   return edge.GetNode().OpType() != kConstant;
@@ -2464,8 +2482,8 @@ Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
                   if (!has_inputs) {
                     // add to the topological list, and ensure we skip these nodes when walking the graph
                     nodes_in_topological_order_.push_back(index);
-                    nodes_added.insert(index);
-                    nodes_seen.insert(index);
+                    nodes_added[index] = true;
+                    nodes_seen[index] = true;
                   }
                 });
 
@@ -2481,16 +2499,16 @@ Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
     const NodeIndex current = stack.top();
     stack.pop();
 
-    if (nodes_added.find(current) != nodes_added.end()) {
+    if (nodes_added[current]) {
       continue;
     }
 
-    if (nodes_seen.find(current) != nodes_seen.end()) {
+    if (nodes_seen[current]) {
       // we popped the stack and are back to a node that was seen previously,
       // so we know all the upstream nodes from it have been added.
       nodes_in_topological_order_.push_back(current);
-      nodes_added.insert(current);
-      downstream_nodes.erase(current);
+      nodes_added[current] = true;
+      downstream_nodes[current] = false;
       continue;
     }
 
@@ -2501,22 +2519,22 @@ Status Graph::PerformTopologicalSortAndCheckIsAcyclic() {
 
     // node hasn't been seen before, so mark it as seen and re-add it along with its inputs
     // also mark it as downstream of anything new that is added to the stack to detect acyclic graphs
-    nodes_seen.insert(current);
-    downstream_nodes.insert(current);
+    nodes_seen[current] = true;
+    downstream_nodes[current] = true;
 
     stack.push(current);
 
     for (auto iter = node->InputNodesBegin(), end = node->InputNodesEnd(); iter != end; ++iter) {
       const NodeIndex idx = iter->Index();
       // the input to this node is also downstream of this node
-      if (downstream_nodes.find(idx) != downstream_nodes.end()) {
+      if (downstream_nodes[idx]) {
         Status status(ONNXRUNTIME, onnxruntime::common::StatusCode::FAIL,
                       "This is an invalid model. Error: the graph is not acyclic.");
         return status;
       }
 
       // avoid re-processing nodes
-      if (nodes_seen.find(idx) == nodes_seen.end()) {
+      if (!nodes_seen[idx]) {
         stack.push(idx);
       }
     }
@@ -3138,12 +3156,45 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     lsc.output_names.insert(std::string(input));
   }
 
+  // Type and shape inference only revisits the nodes that were modified since the last Resolve, the nodes with a
+  // modified input or output, and the nodes with subgraphs. The outputs of a revisited node are marked as modified if
+  // inference changes them, so their consumers, which come later in the topological order, are revisited too.
+  // Subgraphs depend on the outer scope and are always inferred in full.
+  const bool infer_all_nodes = parent_node_ != nullptr || !outer_scope_node_arg_names_.empty() ||
+                               options.override_types;
+
+  auto for_each_def = [](const Node& node, const auto& fn) {
+    const auto& definitions = node.GetDefinitions();
+    for (const auto* defs : {&definitions.input_defs, &definitions.implicit_input_defs, &definitions.output_defs}) {
+      for (NodeArg* def : *defs) {
+        fn(*def);
+      }
+    }
+  };
+
+  auto serialized_type = [](const NodeArg& def) {
+    return utils::HasType(def.node_arg_info_) ? def.node_arg_info_.type().SerializeAsString() : std::string();
+  };
+
+  struct DefSnapshot {
+    NodeArg* def;
+    bool changed_since_resolve;
+    bool has_type;
+    std::string type;
+  };
+  std::vector<DefSnapshot> def_snapshots;
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
 
     const auto& node_name = node.Name();
 
+    bool infer_node = infer_all_nodes || !node.Op() || node.TypeInferenceNeeded() || node.ContainsSubgraph();
+    if (!infer_node) {
+      for_each_def(node, [&infer_node](const NodeArg& def) { infer_node = infer_node || def.changed_since_resolve_; });
+    }
+
     if (!node.Op()) {
       {
         auto status = Status::OK();
@@ -3227,7 +3278,23 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
       }
     }
 
-    NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+    if (infer_node) {
+      def_snapshots.clear();
+      for_each_def(node, [&](NodeArg& def) {
+        def_snapshots.push_back({&def, def.changed_since_resolve_, utils::HasType(def.node_arg_info_),
+                                 serialized_type(def)});
+      });
+
+      NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+
+      // inference updates the outputs even when it infers what they already hold, which must not mark them
+      for (auto& snapshot : def_snapshots) {
+        const bool unchanged = snapshot.has_type == utils::HasType(snapshot.def->node_arg_info_) &&
+                               snapshot.type == serialized_type(*snapshot.def);
+        snapshot.def->changed_since_resolve_ = unchanged ? snapshot.changed_since_resolve : true;
+      }
+      node.SetTypeInferenceNeeded(false);
+    }
 
     // Accumulate output names of the iterated Node
     for (const auto& output : node.OutputDefs()) {
@@ -3277,7 +3344,9 @@ Status Graph::InitInputsInitializersOutputs() {
   // same applies to the implicit input defs as they are built from any subgraphs within this graph.
   for (auto& node : Nodes()) {
     node.MutableRelationships().Clear();
-    node.MutableDefinitions().implicit_input_defs.clear();
+    if (!node.GetDefinitions().implicit_input_defs.empty()) {
+      node.MutableDefinitions().implicit_input_defs.clear();
+    }
   }
 
   // add the subgraph pointers to the resolve context.
@@ -3365,6 +3434,11 @@ Status Graph::Resolve(const ResolveOptions& options) {
             graph.CleanUnusedInitializersAndNodeArgs(options.initializer_names_to_preserve);
             graph.GraphResolveNeeded(false);
 
+            // all the changes were taken into account by type and shape inference
+            for (auto& node_arg : graph.node_args_) {
+              node_arg.second->changed_since_resolve_ = false;
+            }
+
             // if we are resolving immediately after loading from a GraphProto, we don't need to
             // do a proto sync
             if (options.no_proto_sync_required) {
@@ -3437,6 +3511,7 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
     ORT_IGNORE_RETURN_VALUE(GetOrCreateNodeArg(tensor.name(), &t));
   }
 
+  MarkNodeArgChanged(tensor.name());
   SetGraphResolveNeeded();
 }
 
@@ -3473,6 +3548,7 @@ Status Graph::AddInitializedOrtValue(const ONNX_NAMESPACE::TensorProto& tensor_p
     t.mutable_tensor_type()->set_elem_type(tensor_proto.data_type());
     ORT_IGNORE_RETURN_VALUE(GetOrCreateNodeArg(tensor_proto.name(), &t));
   }
+  MarkNodeArgChanged(tensor_proto.name());
 
   return Status::OK();
 }
@@ -3561,6 +3637,7 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
     // doesn't matter if it existed or not
     ORT_IGNORE_RETURN_VALUE(ortvalue_initializers_.erase(tensor_name));
 
+    MarkNodeArgChanged(tensor_name);
     SetGraphResolveNeeded();
   } else {
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -3631,6 +3708,7 @@ Status Graph::ReplaceInitializedTensorImpl(ONNX_NAMESPACE::TensorProto new_initi
     ORT_IGNORE_RETURN_VALUE(ortvalue_initializers_.erase(initializer_name));
   }
 
+  MarkNodeArgChanged(initializer_name);
   **existing_entry = std::move(new_initializer);
 
   return Status::OK();
@@ -3641,6 +3719,64 @@ common::Status Graph::ReplaceInitializedTensor(const ONNX_NAMESPACE::TensorProto
   return ReplaceInitializedTensorImpl(new_initializer, ort_value, false);
 }
 
+Status Graph::MoveInitializerDataToOrtValues() {
+  // raw_data is little-endian, it can only be used as is on little-endian platforms
+  if constexpr (endian::native != endian::little) {
+    return Status::OK();
+  }
+
+  for (auto& tensor_proto : *graph_proto_->mutable_initializer()) {
+    if (!utils::HasRawData(tensor_proto) ||
+        tensor_proto.raw_data().size() <= utils::kSmallTensorExternalDataThreshold) {
+      continue;
+    }
+
+    // skip initializers overridden by a later duplicate, name_to_initial_tensor_ only refers to the last one
+    const std::string tensor_name = tensor_proto.name();
+    auto entry = name_to_initial_tensor_.find(tensor_name);
+    if (entry == name_to_initial_tensor_.end() || entry->second != &tensor_proto) {
+      continue;
+    }
+
+    // leave malformed initializers to be reported by the usual deserialization
+    size_t tensor_byte_size = 0;
+    if (!utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &tensor_byte_size).IsOK() ||
+        tensor_byte_size != tensor_proto.raw_data().size()) {
+      continue;
+    }
+
+    const DataTypeImpl* const type =
+        DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+    TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+
+    // take the string that holds the data out of the proto, the OrtValue deleter keeps it alive
+    std::shared_ptr<std::string> raw_data{tensor_proto.release_raw_data()};
+    auto tensor = std::make_unique<Tensor>(type, tensor_shape, raw_data->data(),
+                                           OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator));
+
+    constexpr const bool use_tensor_buffer_true = true;
+    auto new_tensor_proto = utils::TensorToTensorProto(*tensor, tensor_name, use_tensor_buffer_true);
+    new_tensor_proto.set_doc_string(tensor_proto.doc_string());
+
+    OrtValue ort_value;
+    ort_value.Init(tensor.release(), DataTypeImpl::GetType<Tensor>(),
+                   [raw_data](void* p) { delete static_cast<Tensor*>(p); });
+    ortvalue_initializers_.insert_or_assign(tensor_name, std::move(ort_value));
+    tensor_proto = std::move(new_tensor_proto);
+
+    // ToGraphProto must copy the data back into the serialized initializers
+    SetGraphProtoSyncNeeded();
+  }
+
+  for (auto& node : Nodes()) {
+    for (auto& [name, subgraph] : node.GetAttributeNameToMutableSubgraphMap()) {
+      ORT_RETURN_IF_ERROR(subgraph->MoveInitializerDataToOrtValues());
+    }
+  }
+
+  return Status::OK();
+}
+
 #if !defined(DISABLE_EXTERNAL_INITIALIZERS)
 Status Graph::InjectExternalInitializedTensors(const InlinedHashMap<std::string, OrtValue>& external_initializers) {
   for (const auto& [name, value] : external_initializers) {
@@ -4848,11 +4984,17 @@ bool Graph::SetOpSchemaFromRegistryForNode(Node& node) {
 Status Graph::PopulateNodeArgToProducerConsumerLookupsFromNodes() {
   node_arg_to_producer_node_.clear();
   node_arg_to_consumer_nodes_.clear();
+  node_arg_to_producer_node_.reserve(node_args_.size());
+  node_arg_to_consumer_nodes_.reserve(node_args_.size());
 
   for (const auto& node : Nodes()) {
     node.ForEachDef([&](const NodeArg& node_arg, bool is_input) {
       if (is_input) {
-        node_arg_to_consumer_nodes_[node_arg.Name()].insert(node.Index());
+        // nodes are visited in order, so a node consuming the same value twice is at the back
+        auto& consumers = node_arg_to_consumer_nodes_[node_arg.Name()];
+        if (consumers.empty() || consumers.back() != node.Index()) {
+          consumers.push_back(node.Index());
+        }
       } else {
         node_arg_to_producer_node_.insert({node_arg.Name(), node.Index()});
       }
@@ -5524,6 +5666,14 @@ Status Graph::InlineFunction(Node& callnode) {
 }
 
 void Graph::SetInputs(gsl::span<const NodeArg* const> inputs) {
+  // an initializer is constant, and its value used by type inference, only if it's not also a graph input
+  for (const auto* input : graph_inputs_including_initializers_) {
+    MarkNodeArgChanged(input->Name());
+  }
+  for (const auto* input : inputs) {
+    MarkNodeArgChanged(input->Name());
+  }
+
   graph_inputs_including_initializers_.clear();
   graph_inputs_excluding_initializers_.clear();
 
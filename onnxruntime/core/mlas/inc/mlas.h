@@ -98,6 +98,28 @@ Abstract:
 #endif // ARM64
 #endif // Visual Studio 16 or earlier does not support fp16 intrinsic
 
+//
+// Define the x64 targets where the compiler supports the AVX512-FP16
+// instructions. The kernels are selected at runtime by CPUID.
+//
+
+#if defined(MLAS_TARGET_AMD64) && !defined(__APPLE__)
+#if (defined(_MSC_VER) && (_MSC_VER >= 1933)) || \
+    (defined(__clang__) && (__clang_major__ >= 14)) || \
+    (defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 12))
+#define MLAS_AVX512FP16_INTRINSICS_SUPPORTED
+#endif
+#endif
+
+//
+// Define the targets with a bfloat16 precision GEMM (SBGEMM) implementation.
+// MlasBf16AccelerationSupported() reports whether the current CPU can run it.
+//
+
+#if (defined(__aarch64__) && defined(__linux__)) || defined(MLAS_TARGET_AMD64)
+#define MLAS_SBGEMM_SUPPORTED
+#endif
+
 //
 // Basic Linear Algebra Subprograms (BLAS) types.
 //
@@ -245,6 +267,38 @@ MlasGemmBatch(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Supply the shape and data of one multiplication of a grouped single
+ *        precision gemm
+ */
+struct MLAS_SGEMM_GROUPED_PARAMS {
+    CBLAS_TRANSPOSE TransA = CblasNoTrans; /**< Supplies the transpose operation for matrix A. */
+    CBLAS_TRANSPOSE TransB = CblasNoTrans; /**< Supplies the transpose operation for matrix B. */
+    size_t M = 0;                          /**< Supplies the number of rows of matrix A and matrix C. */
+    size_t N = 0;                          /**< Supplies the number of columns of matrix B and matrix C. */
+    size_t K = 0;                          /**< Supplies the number of columns of matrix A and rows of matrix B. */
+    MLAS_SGEMM_DATA_PARAMS Data;           /**< Supplies the matrices data parameters */
+};
+
+/**
+ * @brief  Grouped single precision matrix/matrix multiply operation (SGEMM)
+ *         where each multiplication has its own shape. The multiplications
+ *         are segmented by their complexity and run in a single parallel
+ *         loop, so the thread pool is dispatched once for the whole group.
+ *
+ * @param Problems      A array of the multiplications
+ * @param ProblemCount  Supplies number of multiplications in this group
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr if the
+                        base library threading support should be used.
+ */
+void
+MLASCALL
+MlasGemmGrouped(
+    const MLAS_SGEMM_GROUPED_PARAMS* Problems,
+    size_t ProblemCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 /**
  * @brief  Single precision matrix/matrix multiply operation (SGEMM)
  *
@@ -376,6 +430,49 @@ MlasGemm(
                   M, N, K, &DataParams, 1, ThreadPool);
 }
 
+/**
+ * @brief Sparse matrix B of a single precision GEMM, compressed by column:
+ *        the non-zero elements of column n are Values[ColumnStart[n] ..
+ *        ColumnStart[n + 1]), at the rows RowIndices[ColumnStart[n] ..
+ *        ColumnStart[n + 1]).
+ */
+struct MLAS_SGEMM_SPARSE_B {
+    size_t K = 0;                          /**< Supplies the number of rows of matrix B. */
+    size_t N = 0;                          /**< Supplies the number of columns of matrix B. */
+    const uint32_t* ColumnStart = nullptr; /**< Supplies N + 1 offsets into RowIndices and Values. */
+    const uint32_t* RowIndices = nullptr;  /**< Supplies the row of each non-zero element. */
+    const float* Values = nullptr;         /**< Supplies the value of each non-zero element. */
+};
+
+/**
+ * @brief Single precision matrix/matrix multiply C = A * B, with B sparse.
+ *
+ *        The work is proportional to M times the number of non-zero elements
+ *        of B, rather than to M * N * K. Rows of A are processed in tiles that
+ *        are transposed once, so each non-zero element of B is applied to the
+ *        tile with vector multiply-adds.
+ *
+ * @param M           Supplies the number of rows of matrix A and matrix C.
+ * @param B           Supplies the sparse matrix B, of B->K rows and B->N columns.
+ * @param A           Supplies the address of matrix A, not transposed.
+ * @param lda         Supplies the first dimension of matrix A.
+ * @param C           Supplies the address of matrix C, which is overwritten.
+ * @param ldc         Supplies the first dimension of matrix C.
+ * @param ThreadPool  Supplies the thread pool object to use, else nullptr if the
+                      base library threading support should be used.
+ */
+void
+MLASCALL
+MlasSparseGemm(
+    size_t M,
+    const MLAS_SGEMM_SPARSE_B* B,
+    const float* A,
+    size_t lda,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 /**
  * @brief Supply matrices data information to double precision gemm functions
  */
@@ -758,6 +855,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -790,6 +888,12 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileCountHeight;
+            size_t TileCountWidth;
+            size_t TileBlockSize;
+            size_t TileBlockCount;
+        } Winograd;
     } u;
 };
 
@@ -809,6 +913,7 @@ MlasConvPrepare(MLAS_CONV_PARAMETERS* Parameters,
                 const MLAS_ACTIVATION* Activation,
                 size_t* WorkingBufferSize,
                 float Beta,
+                bool WinogradFilterAvailable,
                 MLAS_THREADPOOL* ThreadPool);
 
 void
@@ -823,6 +928,31 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd F(2x2, 3x3) filter transform for 3x3 convolutions with unit stride
+// and dilation. MlasConvPrepare only selects MlasConvAlgorithmWinograd when the
+// caller has a transformed filter, which is then passed to MlasConv instead of
+// the original filter.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradPackedFilterSize(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* PackedFilter
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -1023,6 +1153,43 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Element-wise transform applied to each row of a masked softmax in the same pass
+ * as the row maximum: X' = Softcap(X * Scale + Bias + Mask). The Bias and Mask rows have
+ * the shape of the input rows. When Causal is set, the row n only attends the columns
+ * [0, n + CausalOffset], and the other columns get a probability of zero.
+ */
+struct MLAS_SOFTMAX_MASK_PARAMS {
+    float Scale = 1.0f;            /**< Supplies the multiplier of the input */
+    const float* Bias = nullptr;   /**< Optionally supplies an additive N x D bias */
+    const float* Mask = nullptr;   /**< Optionally supplies an additive N x D mask */
+    float Softcap = 0.0f;          /**< Supplies the softcap, or zero to skip it */
+    bool Causal = false;           /**< Whether the columns past the causal limit are masked out */
+    size_t CausalOffset = 0;       /**< Supplies the last column attended by the first row */
+};
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    bool SmoothSoftmax,
+    const MLAS_SOFTMAX_MASK_PARAMS* MaskParams,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Whether current CPU supports half precision softmax and log softmax.
+ */
+bool
+MLASCALL
+MlasFp16SoftmaxSupported(
+    void
+    );
+
 template <typename T>
 void
 MLASCALL
@@ -1438,6 +1605,15 @@ MLAS_FP16* Destination,
 size_t Count
 );
 
+void
+MLASCALL
+MlasConvertFloatToHalfBufferInParallel(
+    const float* Source,
+    MLAS_FP16* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+);
+
 /**
  * @brief rotary embedding for one hidden state vector
  *
@@ -1461,6 +1637,47 @@ MlasRotaryEmbedOneRow(
     T* output
 );
 
+/**
+ * @brief Normalizes one row for LayerNormalization, RMS normalization (Simplified) and their
+ *        SkipLayerNormalization variants: with X = Input + Skip + Bias,
+ *        Output = (X - mean(X)) / sqrt(var(X) + Epsilon) * Scale + Shift, or
+ *        Output = X / sqrt(mean(X * X) + Epsilon) * Scale if Simplified.
+ *
+ *        The statistics are computed in one vectorized pass and the row is normalized in a
+ *        second one, in fp32. fp16 rows are converted in small blocks as they are read and written.
+ *
+ * @tparam T: data type of Input, Skip, Output and SumOutput. float and MLAS_FP16 are supported.
+ * @param Input:      input row, of N elements
+ * @param Skip:       optional row of N elements added to Input, else nullptr
+ * @param Bias:       optional N elements added to Input, else nullptr
+ * @param Scale:      N elements multiplied with the normalized row
+ * @param Shift:      optional N elements added to the scaled row, else nullptr. Ignored if Simplified.
+ * @param N:          number of elements of the row
+ * @param Epsilon:    added to the variance
+ * @param Simplified: whether to compute an RMS normalization
+ * @param Output:     output row, of N elements
+ * @param SumOutput:  optional output for Input + Skip + Bias, else nullptr
+ * @param Mean:       optional output for the mean of the row, else nullptr. Not written if Simplified.
+ * @param InvStdDev:  optional output for the inverse of the standard deviation (or root mean square), else nullptr
+ */
+template <typename T>
+void
+MLASCALL
+MlasLayerNormOneRow(
+    const T* Input,
+    const T* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    T* Output,
+    T* SumOutput,
+    float* Mean,
+    float* InvStdDev
+);
+
 /**
  * @brief Supply matrices data information to half precision gemm functions
  */
@@ -1780,7 +1997,7 @@ MlasHalfGemmConvertPackB(
     void* PackedB
     );
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 /**
  * @brief Whether current CPU supports Bfloat16(bf16) acceleration.
  */
@@ -1987,6 +2204,7 @@ struct MlasFlashAttentionThreadedArgs {
     int q_block_size;
     int kv_block_size;
     float scale;
+    bool causal;  // query row i only attends to key rows 0..i
     int thread_count;
     float* buffer;
     size_t buffer_size_per_thread;
@@ -104,3 +104,40 @@ MlasConvertFloatToHalfBuffer(
         GetMlasPlatform().CastF32ToF16Kernel(Source, reinterpret_cast<unsigned short*>(Destination), Count);
     }
 }
+
+void
+MLASCALL
+MlasConvertFloatToHalfBufferInParallel(
+    const float* Source,
+    MLAS_FP16* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+)
+{
+#if defined(BUILD_MLAS_NO_ONNXRUNTIME)
+    MLAS_UNREFERENCED_PARAMETER(ThreadPool);
+
+    MlasConvertFloatToHalfBuffer(Source, Destination, Count);
+#else
+    //
+    // The cost of an element: the conversion kernel converts several elements per cycle, the scalar conversion
+    // takes about ten cycles.
+    //
+    const double num_compute_cycles = (GetMlasPlatform().CastF32ToF16Kernel == nullptr) ? 10.0 : 0.5;
+
+    MLAS_THREADPOOL::TryParallelFor(
+        ThreadPool, static_cast<std::ptrdiff_t>(Count),
+        {
+            static_cast<double>(sizeof(float)),      // bytes loaded per element
+            static_cast<double>(sizeof(MLAS_FP16)),  // bytes stored per element
+            num_compute_cycles,
+        },
+        [Source, Destination](std::ptrdiff_t first_span, std::ptrdiff_t last_span) {
+            MlasConvertFloatToHalfBuffer(
+                Source + first_span,
+                Destination + first_span,
+                static_cast<size_t>(last_span - first_span));
+        }
+    );
+#endif // BUILD_MLAS_NO_ONNXRUNTIME
+}
@@ -74,6 +74,7 @@ struct MLAS_SOFTMAX_WORK_BLOCK {
     ptrdiff_t ThreadCountN;
     bool LogSoftmax;
     bool SmoothSoftmax;
+    const MLAS_SOFTMAX_MASK_PARAMS* MaskParams;
     const T* Input;
     T* Output;
     size_t N;
@@ -800,6 +801,101 @@ Return Value:
     }
 }
 
+float
+MlasComputeSoftmaxMaskRow(
+    const float* Input,
+    float* Output,
+    size_t D,
+    const float* Bias,
+    const float* Mask,
+    const MLAS_SOFTMAX_MASK_PARAMS* MaskParams
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the row Softcap(Input * Scale + Bias + Mask) of a
+    masked softmax operation, and returns the maximum value of the row.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Output - Supplies the output row.
+
+    D - Supplies the number of columns of the row to process.
+
+    Bias - Optionally supplies the additive bias row.
+
+    Mask - Optionally supplies the additive mask row.
+
+    MaskParams - Supplies the parameters of the masked softmax operation.
+
+Return Value:
+
+    Returns the maximum value of the row.
+
+--*/
+{
+    const float Softcap = MaskParams->Softcap;
+
+    //
+    // The softcap is Softcap * tanh(X / Softcap), so the row is first stored
+    // divided by the softcap. As the softcap is monotonic, the maximum of the
+    // row is the softcap of the maximum of X.
+    //
+
+    const float OutputScale = Softcap > 0.0f ? 1.0f / Softcap : 1.0f;
+
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(MaskParams->Scale);
+    MLAS_FLOAT32X4 OutputScaleVector = MlasBroadcastFloat32x4(OutputScale);
+    MLAS_FLOAT32X4 MaximumVector = MlasBroadcastFloat32x4(MlasMinimumF32Value);
+    float Maximum = MlasMinimumF32Value;
+
+    size_t i = 0;
+    for (; i + 4 <= D; i += 4) {
+        MLAS_FLOAT32X4 Value = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Input + i), ScaleVector);
+        if (Bias != nullptr) {
+            Value = MlasAddFloat32x4(Value, MlasLoadFloat32x4(Bias + i));
+        }
+        if (Mask != nullptr) {
+            Value = MlasAddFloat32x4(Value, MlasLoadFloat32x4(Mask + i));
+        }
+        MaximumVector = MlasMaximumFloat32x4(MaximumVector, Value);
+        MlasStoreFloat32x4(Output + i, MlasMultiplyFloat32x4(Value, OutputScaleVector));
+    }
+    for (; i < D; i++) {
+        float Value = Input[i] * MaskParams->Scale;
+        if (Bias != nullptr) {
+            Value += Bias[i];
+        }
+        if (Mask != nullptr) {
+            Value += Mask[i];
+        }
+        Maximum = std::max(Maximum, Value);
+        Output[i] = Value * OutputScale;
+    }
+
+    Maximum = std::max(Maximum, MlasReduceMaximumFloat32x4(MaximumVector));
+
+    if (Softcap > 0.0f) {
+        MlasComputeTanh<float>(Output, Output, D);
+
+        MLAS_FLOAT32X4 SoftcapVector = MlasBroadcastFloat32x4(Softcap);
+        i = 0;
+        for (; i + 4 <= D; i += 4) {
+            MlasStoreFloat32x4(Output + i, MlasMultiplyFloat32x4(MlasLoadFloat32x4(Output + i), SoftcapVector));
+        }
+        for (; i < D; i++) {
+            Output[i] *= Softcap;
+        }
+
+        Maximum = Softcap * std::tanh(Maximum * OutputScale);
+    }
+
+    return Maximum;
+}
+
 template <typename T>
 void
 MlasComputeSoftmaxThreaded(
@@ -850,6 +946,7 @@ Return Value:
     const size_t D = WorkBlock->D;
     const bool LogSoftmax = WorkBlock->LogSoftmax;
     const bool SmoothSoftmax = WorkBlock->SmoothSoftmax;
+    const MLAS_SOFTMAX_MASK_PARAMS* MaskParams = WorkBlock->MaskParams;
 
     const float* Input = WorkBlock->Input + n * D;
     float* Output = WorkBlock->Output + n * D;
@@ -872,14 +969,30 @@ Return Value:
 #endif
 
         //
-        // Find the maximum value for the row.
+        // Find the maximum value for the row. A masked row is transformed to
+        // the output buffer in the same pass, and only its columns up to the
+        // causal limit are processed.
         //
 
+        const float* RowInput = Input;
+        size_t RowD = D;
+        float Maximum;
+
+        if (MaskParams != nullptr) {
+            if (MaskParams->Causal) {
+                RowD = std::min(D, n + MaskParams->CausalOffset + 1);
+            }
+            const float* Bias = MaskParams->Bias != nullptr ? MaskParams->Bias + n * D : nullptr;
+            const float* Mask = MaskParams->Mask != nullptr ? MaskParams->Mask + n * D : nullptr;
+            Maximum = MlasComputeSoftmaxMaskRow(Input, Output, RowD, Bias, Mask, MaskParams);
+            RowInput = Output;
+        } else {
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
-        float Maximum = GetMlasPlatform().ReduceMaximumF32Kernel(Input, D);
+            Maximum = GetMlasPlatform().ReduceMaximumF32Kernel(Input, D);
 #else
-        float Maximum = MlasReduceMaximumF32Kernel(Input, D);
+            Maximum = MlasReduceMaximumF32Kernel(Input, D);
 #endif
+        }
         float NegativeMaximum = -Maximum;
         if (SmoothSoftmax && NegativeMaximum > 0.0f) {
             NegativeMaximum = 0.0f;
@@ -891,9 +1004,9 @@ Return Value:
         //
         float* Temp = LogSoftmax ? nullptr : Output;
 #if defined(MLAS_TARGET_AMD64)
-        float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(Input, Temp, D, &NegativeMaximum);
+        float Accumulation = GetMlasPlatform().ComputeSumExpF32Kernel(RowInput, Temp, RowD, &NegativeMaximum);
 #else
-        float Accumulation = MlasComputeSumExpF32Kernel(Input, Temp, D, &NegativeMaximum);
+        float Accumulation = MlasComputeSumExpF32Kernel(RowInput, Temp, RowD, &NegativeMaximum);
 #endif
 
         if (SmoothSoftmax) {
@@ -907,9 +1020,9 @@ Return Value:
             float Parameters[] = {NegativeMaximum, std::log(Accumulation)};
 
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
-            GetMlasPlatform().ComputeLogSoftmaxOutputF32Kernel(Input, Output, D, Parameters);
+            GetMlasPlatform().ComputeLogSoftmaxOutputF32Kernel(RowInput, Output, RowD, Parameters);
 #else
-            MlasComputeLogSoftmaxOutputF32Kernel(Input, Output, D, Parameters);
+            MlasComputeLogSoftmaxOutputF32Kernel(RowInput, Output, RowD, Parameters);
 #endif
 
         } else {
@@ -919,14 +1032,24 @@ Return Value:
             float Parameters[] = {1.0f / Accumulation};
 
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
-            GetMlasPlatform().ComputeSoftmaxOutputF32Kernel(Output, D, Parameters);
+            GetMlasPlatform().ComputeSoftmaxOutputF32Kernel(Output, RowD, Parameters);
 #else
-            MlasComputeSoftmaxOutputF32Kernel(Output, D, Parameters);
+            MlasComputeSoftmaxOutputF32Kernel(Output, RowD, Parameters);
 #endif
         }
 
+        //
+        // The columns past the causal limit are masked out.
+        //
+
+        if (RowD < D) {
+            std::fill(Output + RowD, Output + D,
+                      LogSoftmax ? -std::numeric_limits<float>::infinity() : 0.0f);
+        }
+
         Input += D;
         Output += D;
+        n++;
         CountN--;
     }
 }
@@ -1004,6 +1127,60 @@ Return Value:
     }
 }
 
+template <typename T>
+void
+MlasExecuteSoftmax(
+    MLAS_SOFTMAX_WORK_BLOCK<T>& WorkBlock,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine executes a softmax operation on the worker threads.
+
+Arguments:
+
+    WorkBlock - Supplies the parameters of the softmax operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t N = WorkBlock.N;
+    const size_t D = WorkBlock.D;
+
+    //
+    // Compute the number of target threads given the complexity of the softmax
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    ptrdiff_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = ptrdiff_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasComputeSoftmaxThreaded<T>, &WorkBlock, ThreadCountN, ThreadPool);
+}
+
 template <typename T>
 void
 MLASCALL
@@ -1056,35 +1233,13 @@ Return Value:
 
     WorkBlock.LogSoftmax = LogSoftmax;
     WorkBlock.SmoothSoftmax = SmoothSoftmax;
+    WorkBlock.MaskParams = nullptr;
     WorkBlock.Input = Input;
     WorkBlock.Output = Output;
     WorkBlock.N = N;
     WorkBlock.D = D;
 
-    //
-    // Compute the number of target threads given the complexity of the softmax
-    // operation. Limit the number of threads to the number of rows and try to
-    // keep each thread processing a minimum number of elements before using
-    // another thread.
-    //
-
-    ptrdiff_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
-
-    if (size_t(ThreadCountN) > N) {
-        ThreadCountN = ptrdiff_t(N);
-    }
-
-    constexpr size_t MinimumElementsPerThread = 16384;
-
-    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
-
-    if (size_t(ThreadCountN) > BlockCount) {
-        ThreadCountN = ptrdiff_t(BlockCount);
-    }
-
-    WorkBlock.ThreadCountN = ThreadCountN;
-
-    MlasExecuteThreaded(MlasComputeSoftmaxThreaded<T>, &WorkBlock, ThreadCountN, ThreadPool);
+    MlasExecuteSoftmax(WorkBlock, ThreadPool);
 }
 
 template
@@ -1113,6 +1268,83 @@ MlasComputeSoftmax<MLAS_FP16>(
     MLAS_THREADPOOL* ThreadPool
 );
 
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    bool SmoothSoftmax,
+    const MLAS_SOFTMAX_MASK_PARAMS* MaskParams,
+    MLAS_THREADPOOL* ThreadPool
+)
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function of the rows
+    Softcap(Input * Scale + Bias + Mask), with the scale, the additive bias
+    and mask, the softcap and the causal mask applied in the same pass over
+    each row as its maximum value.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+    SmoothSoftmax - Supplies true if a smooth factor is used in softmax operation.
+
+    MaskParams - Optionally supplies the scale, bias, mask, softcap and causal
+        mask applied to the rows.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SOFTMAX_WORK_BLOCK<float> WorkBlock;
+
+    WorkBlock.LogSoftmax = LogSoftmax;
+    WorkBlock.SmoothSoftmax = SmoothSoftmax;
+    WorkBlock.MaskParams = MaskParams;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+
+    MlasExecuteSoftmax(WorkBlock, ThreadPool);
+}
+
+bool
+MLASCALL
+MlasFp16SoftmaxSupported(
+    void
+    )
+{
+    const auto* dispatch = GetMlasPlatform().SoftmaxDispatch;
+    return dispatch != nullptr &&
+           dispatch->ReduceMax_Fp16 != nullptr &&
+           dispatch->SumExp_Fp16 != nullptr &&
+           dispatch->Softmax_Fp16 != nullptr &&
+           dispatch->LogSoftmax_Fp16 != nullptr;
+}
+
 template <>
 bool
 MLASCALL
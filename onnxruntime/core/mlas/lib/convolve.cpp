@@ -729,6 +729,377 @@ Return Value:
     }
 }
 
+//
+// Define the Winograd F(2x2, 3x3) transform sizes. Each tile of 2x2 outputs is
+// computed from a 4x4 input patch, so a 3x3 convolution is reduced to 16
+// matrix multiplications over the tiles.
+//
+
+#define MLAS_CONV_WINOGRAD_TILE_ELEMENTS 16
+
+//
+// Define the number of working buffer elements to target per thread for the
+// transformed inputs and outputs of a block of tiles.
+//
+
+#define MLAS_CONV_WINOGRAD_WORKING_BUFFER_ELEMENTS (128 * 1024)
+
+size_t
+MLASCALL
+MlasConvWinogradPackedFilterSize(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of elements of the Winograd transformed
+    filter of a 3x3 convolution.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of output channels per group.
+
+Return Value:
+
+    Returns the number of elements to allocate for the transformed filter.
+
+--*/
+{
+    return GroupCount * MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the filter of a 3x3 convolution to the Winograd
+    domain (G * g * G^T). The transformed filter of each group is stored as 16
+    row major matrices of FilterCount rows and InputChannels columns.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of output channels per group.
+
+    Filter - Supplies the filter tensor in MCHW layout.
+
+    PackedFilter - Supplies the buffer that receives the transformed filter,
+        sized by MlasConvWinogradPackedFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t MatrixSize = FilterCount * InputChannels;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        for (size_t m = 0; m < FilterCount; m++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                const float* g = Filter + (m * InputChannels + c) * 9;
+
+                //
+                // Compute G * g (4x3).
+                //
+
+                float t[4][3];
+
+                for (size_t col = 0; col < 3; col++) {
+                    const float g0 = g[col];
+                    const float g1 = g[3 + col];
+                    const float g2 = g[6 + col];
+                    t[0][col] = g0;
+                    t[1][col] = 0.5f * (g0 + g1 + g2);
+                    t[2][col] = 0.5f * (g0 - g1 + g2);
+                    t[3][col] = g2;
+                }
+
+                //
+                // Compute (G * g) * G^T (4x4).
+                //
+
+                float* u = PackedFilter + m * InputChannels + c;
+
+                for (size_t row = 0; row < 4; row++) {
+                    const float t0 = t[row][0];
+                    const float t1 = t[row][1];
+                    const float t2 = t[row][2];
+                    u[(row * 4 + 0) * MatrixSize] = t0;
+                    u[(row * 4 + 1) * MatrixSize] = 0.5f * (t0 + t1 + t2);
+                    u[(row * 4 + 2) * MatrixSize] = 0.5f * (t0 - t1 + t2);
+                    u[(row * 4 + 3) * MatrixSize] = t2;
+                }
+            }
+        }
+
+        Filter += MatrixSize * 9;
+        PackedFilter += MLAS_CONV_WINOGRAD_TILE_ELEMENTS * MatrixSize;
+    }
+}
+
+void
+MlasConvWinogradOperation(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    float* WorkingBuffer,
+    float* Output,
+    size_t StartTile,
+    size_t CountTiles
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of output tiles of a 3x3 convolution using
+    the Winograd F(2x2, 3x3) algorithm. The bias and activation are applied
+    once the whole output is computed.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor of the batch and group.
+
+    PackedFilter - Supplies the transformed filter of the group.
+
+    WorkingBuffer - Supplies the working buffer of this thread.
+
+    Output - Supplies the output tensor of the batch and group.
+
+    StartTile - Supplies the index of the first tile to compute.
+
+    CountTiles - Supplies the number of tiles to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t TileCountWidth = Parameters->u.Winograd.TileCountWidth;
+    const float Beta = Parameters->Beta;
+
+    float* V = WorkingBuffer;
+    float* M = WorkingBuffer + MLAS_CONV_WINOGRAD_TILE_ELEMENTS * InputChannels * CountTiles;
+
+    //
+    // Transform the input patches of the tiles (B^T * d * B).
+    //
+
+    for (size_t t = 0; t < CountTiles; t++) {
+
+        const size_t TileRow = (StartTile + t) / TileCountWidth;
+        const size_t TileColumn = (StartTile + t) % TileCountWidth;
+
+        //
+        // The input coordinates wrap around for the leading padding, so are
+        // bounds checked with a single unsigned comparison.
+        //
+
+        const size_t ih0 = TileRow * 2 - PaddingTop;
+        const size_t iw0 = TileColumn * 2 - PaddingLeft;
+
+        const bool Interior = (ih0 + 3 < InputHeight) && (iw0 + 3 < InputWidth) &&
+                              ih0 < InputHeight && iw0 < InputWidth;
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* input = Input + c * InputSize;
+            float d[4][4];
+
+            if (Interior) {
+                for (size_t row = 0; row < 4; row++) {
+                    const float* input_row = input + (ih0 + row) * InputWidth + iw0;
+                    d[row][0] = input_row[0];
+                    d[row][1] = input_row[1];
+                    d[row][2] = input_row[2];
+                    d[row][3] = input_row[3];
+                }
+            } else {
+                for (size_t row = 0; row < 4; row++) {
+                    const size_t ih = ih0 + row;
+                    for (size_t col = 0; col < 4; col++) {
+                        const size_t iw = iw0 + col;
+                        d[row][col] = (ih < InputHeight && iw < InputWidth) ? input[ih * InputWidth + iw] : 0.0f;
+                    }
+                }
+            }
+
+            float s[4][4];
+
+            for (size_t col = 0; col < 4; col++) {
+                s[0][col] = d[0][col] - d[2][col];
+                s[1][col] = d[1][col] + d[2][col];
+                s[2][col] = d[2][col] - d[1][col];
+                s[3][col] = d[1][col] - d[3][col];
+            }
+
+            float* v = V + c * CountTiles + t;
+            const size_t MatrixSize = InputChannels * CountTiles;
+
+            for (size_t row = 0; row < 4; row++) {
+                v[(row * 4 + 0) * MatrixSize] = s[row][0] - s[row][2];
+                v[(row * 4 + 1) * MatrixSize] = s[row][1] + s[row][2];
+                v[(row * 4 + 2) * MatrixSize] = s[row][2] - s[row][1];
+                v[(row * 4 + 3) * MatrixSize] = s[row][1] - s[row][3];
+            }
+        }
+    }
+
+    //
+    // Multiply the transformed filter and inputs for each of the 16 elements
+    // of a tile.
+    //
+
+    for (size_t xi = 0; xi < MLAS_CONV_WINOGRAD_TILE_ELEMENTS; xi++) {
+
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountTiles, InputChannels, 1.0f,
+                           PackedFilter + xi * FilterCount * InputChannels, InputChannels,
+                           V + xi * InputChannels * CountTiles, CountTiles, 0.0f,
+                           M + xi * FilterCount * CountTiles, CountTiles);
+    }
+
+    //
+    // Transform the products back to the output tiles (A^T * m * A).
+    //
+
+    const size_t MatrixSize = FilterCount * CountTiles;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        float* output = Output + f * OutputSize;
+
+        for (size_t t = 0; t < CountTiles; t++) {
+
+            const float* m = M + f * CountTiles + t;
+
+            float s[2][4];
+
+            for (size_t col = 0; col < 4; col++) {
+                const float m0 = m[(0 * 4 + col) * MatrixSize];
+                const float m1 = m[(1 * 4 + col) * MatrixSize];
+                const float m2 = m[(2 * 4 + col) * MatrixSize];
+                const float m3 = m[(3 * 4 + col) * MatrixSize];
+                s[0][col] = m0 + m1 + m2;
+                s[1][col] = m1 - m2 - m3;
+            }
+
+            const size_t oh0 = ((StartTile + t) / TileCountWidth) * 2;
+            const size_t ow0 = ((StartTile + t) % TileCountWidth) * 2;
+
+            for (size_t row = 0; row < 2 && oh0 + row < OutputHeight; row++) {
+
+                const float y[2] = {
+                    s[row][0] + s[row][1] + s[row][2],
+                    s[row][1] - s[row][2] - s[row][3],
+                };
+
+                float* output_row = output + (oh0 + row) * OutputWidth + ow0;
+
+                for (size_t col = 0; col < 2 && ow0 + col < OutputWidth; col++) {
+                    output_row[col] = (Beta == 0.0f) ? y[col] : y[col] + Beta * output_row[col];
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a range of the
+    tile blocks of all the batches and groups of a Winograd convolution.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t TileCount = Parameters->u.Winograd.TileCountHeight * Parameters->u.Winograd.TileCountWidth;
+    const size_t TileBlockSize = Parameters->u.Winograd.TileBlockSize;
+    const size_t TileBlockCount = Parameters->u.Winograd.TileBlockCount;
+
+    const size_t InputGroupSize = InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * Parameters->OutputSize;
+    const size_t FilterGroupSize = MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+
+    float* WorkingBuffer = WorkBlock->WorkingBuffer +
+        Index * MLAS_CONV_WINOGRAD_TILE_ELEMENTS * (InputChannels + FilterCount) * TileBlockSize;
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount,
+        Parameters->BatchCount * GroupCount * TileBlockCount, &WorkIndex, &WorkRemaining);
+
+    for (; WorkRemaining > 0; WorkIndex++, WorkRemaining--) {
+
+        const size_t bg = WorkIndex / TileBlockCount;
+        const size_t group = bg % GroupCount;
+        const size_t StartTile = (WorkIndex % TileBlockCount) * TileBlockSize;
+        const size_t CountTiles = std::min(TileBlockSize, TileCount - StartTile);
+
+        MlasConvWinogradOperation(Parameters, WorkBlock->Input + bg * InputGroupSize,
+            WorkBlock->Filter + group * FilterGroupSize, WorkingBuffer,
+            WorkBlock->Output + bg * OutputGroupSize, StartTile, CountTiles);
+    }
+}
+
 inline
 bool
 MlasConvTryMultithread(
@@ -843,7 +1214,9 @@ Arguments:
 
     Input - Supplies the input tensor.
 
-    Filter - Supplies the filter tensor.
+    Filter - Supplies the filter tensor, or the filter transformed by
+        MlasConvWinogradPackFilter if MlasConvPrepare selected
+        MlasConvAlgorithmWinograd.
 
     Bias - Optionally supplies the bias vector.
 
@@ -874,6 +1247,46 @@ Return Value:
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    //
+    // Schedule the tile blocks of all batches and groups of a Winograd
+    // convolution across multiple threads and then apply the activation with
+    // optional bias.
+    //
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = Filter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = WorkingBuffer;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = Parameters->ThreadCount;
+
+        MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, Parameters->ThreadCount, ThreadPool);
+
+        for (size_t batch = 0; batch < BatchCount; batch++) {
+
+            const float* bias = Bias;
+
+            for (size_t group = 0; group < GroupCount; group++) {
+
+                MlasActivation(Parameters->Activation, Output, bias, FilterCount,
+                    OutputSize, OutputSize);
+
+                if (bias != nullptr) {
+                    bias += FilterCount;
+                }
+
+                Output += OutputGroupSize;
+            }
+        }
+
+        return;
+    }
+
     //
     // Schedule batches of GEMMs across multiple threads.
     //
@@ -1041,6 +1454,7 @@ MlasConvPrepare(
     const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize,
     float Beta,
+    bool WinogradFilterAvailable,
     MLAS_THREADPOOL* ThreadPool
     )
 /*++
@@ -1085,6 +1499,14 @@ Arguments:
     WorkingBufferSize - Receives the number of elements to allocate for the
         working buffer for intermediate results.
 
+    Beta - Supplies the scale of the existing output that is added to the
+        convolution output.
+
+    WinogradFilterAvailable - Supplies true if the caller has transformed the
+        filter with MlasConvWinogradPackFilter, which allows the Winograd
+        algorithm to be selected for 3x3 convolutions with unit stride and
+        dilation.
+
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
@@ -1168,6 +1590,69 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    if (WinogradFilterAvailable && Dimensions == 2 && AllStridesAreOne && AllDilationsAreOne &&
+        Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3) {
+
+        //
+        // Winograd F(2x2, 3x3) replaces the 36 multiplies of a 2x2 output tile
+        // per channel pair by 16, at the cost of transforming the input and
+        // output tiles and of smaller matrix multiplications. Use it when the
+        // channel counts are large enough for the multiplications to dominate.
+        //
+
+        const size_t TileCountHeight = (Parameters->OutputShape[0] + 1) / 2;
+        const size_t TileCountWidth = (Parameters->OutputShape[1] + 1) / 2;
+        const size_t TileCount = TileCountHeight * TileCountWidth;
+
+        const double DirectCost = 9.0 * double(FilterCount) * double(InputChannels) * double(OutputSize);
+        const double WinogradCost = double(MLAS_CONV_WINOGRAD_TILE_ELEMENTS) * double(TileCount) *
+            (double(FilterCount) * double(InputChannels) + 4.0 * double(FilterCount + InputChannels));
+
+        if (InputChannels >= 8 && FilterCount >= 8 && 1.5 * WinogradCost < DirectCost) {
+
+            //
+            // Size the tile blocks so the transformed inputs and outputs of a
+            // block stay in the cache, then spread the blocks of all batches
+            // and groups over the threads.
+            //
+
+            const size_t TileElements = MLAS_CONV_WINOGRAD_TILE_ELEMENTS * (InputChannels + FilterCount);
+
+            size_t TileBlockSize = MLAS_CONV_WINOGRAD_WORKING_BUFFER_ELEMENTS / TileElements;
+
+            if (TileBlockSize >= 16) {
+                TileBlockSize &= ~size_t(15);
+            } else if (TileBlockSize < 8) {
+                TileBlockSize = 8;
+            }
+
+            if (TileBlockSize > TileCount) {
+                TileBlockSize = TileCount;
+            }
+
+            const size_t TileBlockCount = (TileCount + TileBlockSize - 1) / TileBlockSize;
+            const size_t WorkCount = BatchCount * GroupCount * TileBlockCount;
+
+            ptrdiff_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+            if (size_t(TargetThreadCount) >= WorkCount) {
+                TargetThreadCount = ptrdiff_t(WorkCount);
+            }
+
+            Parameters->ThreadCount = TargetThreadCount;
+
+            Parameters->Algorithm = MlasConvAlgorithmWinograd;
+            Parameters->u.Winograd.TileCountHeight = TileCountHeight;
+            Parameters->u.Winograd.TileCountWidth = TileCountWidth;
+            Parameters->u.Winograd.TileBlockSize = TileBlockSize;
+            Parameters->u.Winograd.TileBlockCount = TileBlockCount;
+
+            *WorkingBufferSize = TargetThreadCount * TileElements * TileBlockSize;
+
+            return;
+        }
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
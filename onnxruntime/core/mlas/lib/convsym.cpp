@@ -84,6 +84,8 @@ extern "C" {
     MLAS_CONV_SYM_KERNEL MlasConvSymS8KernelDot;
     MLAS_CONV_SYM_KERNEL MlasConvSymS8KernelDotLd64;
     MLAS_CONV_SYM_KERNEL MlasConvSymU8KernelDot;
+    MLAS_CONV_SYM_KERNEL MlasConvSymS8KernelI8mm;
+    MLAS_CONV_SYM_KERNEL MlasConvSymU8KernelI8mm;
     MLAS_CONV_SYM_DEPTHWISE_KERNEL MlasConvSymDepthwiseU8KernelNeon;
     MLAS_CONV_SYM_DEPTHWISE_KERNEL MlasConvSymDepthwiseS8KernelNeon;
 
@@ -299,6 +301,45 @@ const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchDot = {
     4,   // KernelDepthwiseOutputCount
     false
 };
+
+//
+// The I8MM kernels only replace the indirect conv kernel, SMMLA has no
+// advantage for the depthwise kernels which do not reduce across channels.
+//
+
+const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchI8mm = {
+    MlasConvSymU8KernelI8mm,
+    MlasConvSymU8KernelI8mm,
+    MlasConvSymDepthwiseU8KernelNeon,
+    MlasConvSymDepthwiseKernelSize9Arm64U8S8,
+    MlasConvSymDepthwiseKernelSize25ArmU8S8,
+    8,   // FilterInputChannelPackCount
+    16,  // FilterOutputChannelPackCount
+    0,   // KernelChannelCount
+    4,   // KernelOutputCount
+    8,   // KernelInputChannelAlignment
+    16,  // KernelOutputChannelAlignment
+    16,  // KernelDepthwiseChannelCount
+    4,   // KernelDepthwiseOutputCount
+    true
+};
+
+const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchI8mm = {
+    MlasConvSymS8KernelI8mm,
+    MlasConvSymS8KernelI8mm,
+    MlasConvSymDepthwiseS8KernelNeon,
+    MlasConvSymDepthwiseKernelSize9Arm64S8S8,
+    MlasConvSymDepthwiseKernelSize25ArmS8S8,
+    8,   // FilterInputChannelPackCount
+    16,  // FilterOutputChannelPackCount
+    0,   // KernelChannelCount
+    4,   // KernelOutputCount
+    8,   // KernelInputChannelAlignment
+    16,  // KernelOutputChannelAlignment
+    16,  // KernelDepthwiseChannelCount
+    4,   // KernelDepthwiseOutputCount
+    false
+};
 #endif // MLAS_TARGET_AMD64
 
 MLAS_FORCEINLINE
@@ -0,0 +1,229 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convsym_kernel_neon_i8mm.cpp
+
+Abstract:
+
+    This module implements the symmetric quantized integer convolution
+    kernels for ARM64 processors with the I8MM extension.
+
+    The filter is packed by MlasConvSymPackW in blocks of 16 output channels
+    by 8 input channels, so each 16 byte load of the filter holds the two
+    8x1 columns consumed by one SMMLA. Two output pixels form the other
+    operand, the kernel computes up to 4 output pixels by 16 output channels
+    per iteration with 16 accumulators.
+
+--*/
+
+#include "mlasi.h"
+
+#if defined(MLAS_TARGET_ARM64)
+
+namespace {
+
+constexpr size_t ConvSymI8mmOutputChannelBlock = 16;
+constexpr size_t ConvSymI8mmInputChannelBlock = 8;
+constexpr size_t ConvSymI8mmOutputCount = 4;
+
+template <typename InputType>
+MLAS_FORCEINLINE int8x8_t
+LoadInput8(const InputType* Input);
+
+template <>
+MLAS_FORCEINLINE int8x8_t
+LoadInput8<int8_t>(const int8_t* Input)
+{
+    return vld1_s8(Input);
+}
+
+template <>
+MLAS_FORCEINLINE int8x8_t
+LoadInput8<uint8_t>(const uint8_t* Input)
+{
+    //
+    // The unsigned dispatch fixes up the input zero point by 128, flip the
+    // sign bit to match (same as the dot product kernel).
+    //
+    return vreinterpret_s8_u8(veor_u8(vld1_u8(Input), vdup_n_u8(0x80)));
+}
+
+template <typename OutputType>
+MLAS_FORCEINLINE void
+StoreOutput16(OutputType* Output, int16x8_t Low, int16x8_t High);
+
+template <>
+MLAS_FORCEINLINE void
+StoreOutput16<int8_t>(int8_t* Output, int16x8_t Low, int16x8_t High)
+{
+    vst1q_s8(Output, vcombine_s8(vqmovn_s16(Low), vqmovn_s16(High)));
+}
+
+template <>
+MLAS_FORCEINLINE void
+StoreOutput16<uint8_t>(uint8_t* Output, int16x8_t Low, int16x8_t High)
+{
+    vst1q_u8(Output, vcombine_u8(vqmovun_s16(Low), vqmovun_s16(High)));
+}
+
+MLAS_FORCEINLINE int32x4_t
+Requantize(
+    int32x4_t Accumulator,
+    const int32_t* Bias,
+    float32x4_t Scale,
+    float32x4_t MinimumValue,
+    float32x4_t MaximumValue,
+    int32x4_t OutputZeroPoint
+    )
+{
+    float32x4_t Value = vcvtq_f32_s32(vaddq_s32(Accumulator, vld1q_s32(Bias)));
+    Value = vmulq_f32(Value, Scale);
+    Value = vminq_f32(vmaxq_f32(Value, MinimumValue), MaximumValue);
+    return vaddq_s32(vcvtnq_s32_f32(Value), OutputZeroPoint);
+}
+
+template <typename InputType>
+void
+ConvSymKernelI8mm(
+    const void* Input,
+    const void* Filter,
+    void* Output,
+    size_t KernelSize,
+    size_t InputChannels,
+    size_t OutputChannels,
+    unsigned ChannelCount,
+    unsigned OutputCount,
+    const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    const bool InputDirect = (KernelFlags & MLAS_CONV_SYM_FLAG_INPUT_DIRECT) != 0;
+    const bool PerChannelScale = (KernelFlags & MLAS_CONV_SYM_FLAG_PER_CHANNEL_SCALE) != 0;
+
+    const float32x4_t MinimumValue = vdupq_n_f32(PostProcessParams->MinimumValue);
+    const float32x4_t MaximumValue = vdupq_n_f32(PostProcessParams->MaximumValue);
+    const int32x4_t OutputZeroPoint = vdupq_n_s32(PostProcessParams->OutputZeroPoint);
+
+    const int8_t* FilterBlock = static_cast<const int8_t*>(Filter);
+    InputType* OutputBlock = static_cast<InputType*>(Output);
+
+    for (size_t co = 0; co < ChannelCount; co += ConvSymI8mmOutputChannelBlock) {
+
+        //
+        // Accumulators[p][j] holds the 2x2 tile of output pixels (2p, 2p+1)
+        // by output channels (2j, 2j+1), in row major order.
+        //
+        int32x4_t Accumulators[ConvSymI8mmOutputCount / 2][ConvSymI8mmOutputChannelBlock / 2];
+        for (auto& Row : Accumulators) {
+            for (auto& Tile : Row) {
+                Tile = vdupq_n_s32(0);
+            }
+        }
+
+        const int8_t* f = FilterBlock;
+
+        for (size_t k = 0; k < KernelSize; k++) {
+
+            //
+            // Rows past OutputCount repeat the last valid row, their results
+            // are discarded.
+            //
+            const InputType* Rows[ConvSymI8mmOutputCount];
+            for (size_t i = 0; i < ConvSymI8mmOutputCount; i++) {
+                const size_t r = std::min<size_t>(i, OutputCount - 1);
+                Rows[i] = InputDirect
+                    ? static_cast<const InputType*>(Input) + r * InputChannels
+                    : static_cast<const InputType* const*>(Input)[r * KernelSize + k];
+            }
+
+            for (size_t ic = 0; ic < InputChannels; ic += ConvSymI8mmInputChannelBlock) {
+
+                const int8x16_t a01 = vcombine_s8(LoadInput8(Rows[0] + ic), LoadInput8(Rows[1] + ic));
+                const int8x16_t a23 = vcombine_s8(LoadInput8(Rows[2] + ic), LoadInput8(Rows[3] + ic));
+
+                for (size_t j = 0; j < ConvSymI8mmOutputChannelBlock / 2; j++) {
+                    const int8x16_t b = vld1q_s8(f + j * 16);
+                    Accumulators[0][j] = vmmlaq_s32(Accumulators[0][j], a01, b);
+                    Accumulators[1][j] = vmmlaq_s32(Accumulators[1][j], a23, b);
+                }
+
+                f += ConvSymI8mmOutputChannelBlock * ConvSymI8mmInputChannelBlock;
+            }
+        }
+
+        const int32_t* Bias = PostProcessParams->Bias + co;
+        const float* Scale = PostProcessParams->Scale + (PerChannelScale ? co : 0);
+
+        for (size_t p = 0; p < OutputCount; p++) {
+
+            const auto& Row = Accumulators[p / 2];
+            int32x4_t Values[4];
+
+            for (size_t q = 0; q < 4; q++) {
+                const int64x2_t Low = vreinterpretq_s64_s32(Row[2 * q]);
+                const int64x2_t High = vreinterpretq_s64_s32(Row[2 * q + 1]);
+                const int32x4_t Channels = vreinterpretq_s32_s64((p & 1) == 0 ? vzip1q_s64(Low, High)
+                                                                              : vzip2q_s64(Low, High));
+                const float32x4_t ScaleVector = PerChannelScale ? vld1q_f32(Scale + q * 4) : vdupq_n_f32(Scale[0]);
+                Values[q] = Requantize(Channels, Bias + q * 4, ScaleVector, MinimumValue, MaximumValue, OutputZeroPoint);
+            }
+
+            StoreOutput16(OutputBlock + p * OutputChannels + co,
+                          vcombine_s16(vqmovn_s32(Values[0]), vqmovn_s32(Values[1])),
+                          vcombine_s16(vqmovn_s32(Values[2]), vqmovn_s32(Values[3])));
+        }
+
+        FilterBlock += ConvSymI8mmOutputChannelBlock * InputChannels * KernelSize;
+    }
+}
+
+}  // namespace
+
+extern "C" {
+
+void
+MLASCALL
+MlasConvSymS8KernelI8mm(
+    const void* Input,
+    const void* Filter,
+    void* Output,
+    size_t KernelSize,
+    size_t InputChannels,
+    size_t OutputChannels,
+    unsigned ChannelCount,
+    unsigned OutputCount,
+    const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    ConvSymKernelI8mm<int8_t>(Input, Filter, Output, KernelSize, InputChannels, OutputChannels,
+                              ChannelCount, OutputCount, PostProcessParams, KernelFlags);
+}
+
+void
+MLASCALL
+MlasConvSymU8KernelI8mm(
+    const void* Input,
+    const void* Filter,
+    void* Output,
+    size_t KernelSize,
+    size_t InputChannels,
+    size_t OutputChannels,
+    unsigned ChannelCount,
+    unsigned OutputCount,
+    const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    ConvSymKernelI8mm<uint8_t>(Input, Filter, Output, KernelSize, InputChannels, OutputChannels,
+                               ChannelCount, OutputCount, PostProcessParams, KernelFlags);
+}
+
+}
+
+#endif  // defined(MLAS_TARGET_ARM64)
@@ -0,0 +1,54 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    eltwise_kernel_avx512fp16.cpp
+
+Abstract:
+
+    This module implements the fp16 element-wise kernels for AVX512-FP16.
+
+--*/
+
+#include "mlasi.h"
+#include "eltwise.h"
+
+#if defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+
+namespace eltwise_avx512fp16 {
+
+void
+Add_Kernel_Fp16(const MLAS_FP16* left, const MLAS_FP16* right, MLAS_FP16* output, size_t N)
+{
+    while (N >= 32) {
+        const __m512h l = _mm512_castsi512_ph(_mm512_loadu_si512(left));
+        const __m512h r = _mm512_castsi512_ph(_mm512_loadu_si512(right));
+        _mm512_storeu_si512(output, _mm512_castph_si512(_mm512_add_ph(l, r)));
+
+        left += 32;
+        right += 32;
+        output += 32;
+        N -= 32;
+    }
+
+    if (N > 0) {
+        const __mmask32 Mask = __mmask32((1u << N) - 1);
+        const __m512h l = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask, left));
+        const __m512h r = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask, right));
+        _mm512_mask_storeu_epi16(output, Mask, _mm512_castph_si512(_mm512_add_ph(l, r)));
+    }
+}
+
+}  // namespace eltwise_avx512fp16
+
+const MLAS_ELTWISE_DISPATCH MlasEltwiseDispatchAvx512Fp16 = []() {
+    MLAS_ELTWISE_DISPATCH d;
+    d.Add_Fp16 = eltwise_avx512fp16::Add_Kernel_Fp16;
+    return d;
+}();
+
+#endif  // defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <numeric>
 
 #include "mlasi.h"
@@ -20,6 +21,7 @@ MlasFlashAttentionThreaded(
     float* buffer = args->buffer;
     ptrdiff_t buffer_size_per_thread = static_cast<ptrdiff_t>(args->buffer_size_per_thread);
     ptrdiff_t thread_count = static_cast<ptrdiff_t>(args->thread_count);
+    const bool causal = args->causal;
     const float* query = args->query;
     const float* key = args->key;
     const float* value = args->value;
@@ -61,7 +63,14 @@ MlasFlashAttentionThreaded(
         float* temp_output = intermediate + q_block_size * kv_block_size;
         float negmax = 0;
 
-        for (ptrdiff_t ir = 0; ir < kv_sequence_length; ir += kv_block_size) {
+        // With a causal mask the key blocks after the last query row of the chunk are skipped entirely.
+        size_t row_size_q_capped = static_cast<size_t>(std::min(q_block_size, q_sequence_length - q_idx));
+        ptrdiff_t kv_end = kv_sequence_length;
+        if (causal) {
+            kv_end = std::min(kv_end, q_idx + static_cast<ptrdiff_t>(row_size_q_capped));
+        }
+
+        for (ptrdiff_t ir = 0; ir < kv_end; ir += kv_block_size) {
             /*
                 S = Q[batch_idx, head_idx, q_idx:q_idx+q_block_size, :] * (K[batch_idx, head_idx, ir:ir+kv_block_size, :]).T
                 old_m = m
@@ -76,7 +85,6 @@ MlasFlashAttentionThreaded(
             const float* inputK = key + (h * kv_sequence_length + ir) * qk_head_size;
             const float* inputV = value + (h * kv_sequence_length + ir) * v_head_size;
 
-            size_t row_size_q_capped = static_cast<size_t>(std::min(q_block_size, q_sequence_length - q_idx));
             size_t row_size_kv_capped = static_cast<size_t>(std::min(kv_block_size, kv_sequence_length - ir));
 
             MlasSgemmOperation(CBLAS_TRANSPOSE::CblasNoTrans,
@@ -96,10 +104,22 @@ MlasFlashAttentionThreaded(
             for (ptrdiff_t irow = 0; irow < static_cast<ptrdiff_t>(row_size_q_capped); ++irow) {
                 float* p = intermediate + irow * row_size_kv_capped;
 
+                // Columns after the query row are masked out by zeroing their probabilities. The first key row is
+                // never masked, so every row has a valid column in the first block and m is finite afterwards.
+                size_t row_size_kv_valid = row_size_kv_capped;
+                if (causal) {
+                    ptrdiff_t valid = q_idx + irow + 1 - ir;
+                    row_size_kv_valid = static_cast<size_t>(std::clamp<ptrdiff_t>(valid, 0, static_cast<ptrdiff_t>(row_size_kv_capped)));
+                    std::fill(p + row_size_kv_valid, p + row_size_kv_capped, 0.0f);
+                    if (row_size_kv_valid == 0) {
+                        continue;
+                    }
+                }
+
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
-                float rowmax = mlas_platform.ReduceMaximumF32Kernel(p, row_size_kv_capped);
+                float rowmax = mlas_platform.ReduceMaximumF32Kernel(p, row_size_kv_valid);
 #else
-                float rowmax = MlasReduceMaximumF32Kernel(p, row_size_kv_capped);
+                float rowmax = MlasReduceMaximumF32Kernel(p, row_size_kv_valid);
 #endif
                 float m_diff = m[irow];
                 m[irow] = std::max(m[irow], rowmax);  // new m
@@ -107,9 +127,9 @@ MlasFlashAttentionThreaded(
                 m_diff -= m[irow];  // old - new (less than 0)
 
 #if defined(MLAS_TARGET_AMD64)
-                float rowsum = mlas_platform.ComputeSumExpF32Kernel(p, p, row_size_kv_capped, &negmax);
+                float rowsum = mlas_platform.ComputeSumExpF32Kernel(p, p, row_size_kv_valid, &negmax);
 #else
-                float rowsum = MlasComputeSumExpF32Kernel(p, p, row_size_kv_capped, &negmax);
+                float rowsum = MlasComputeSumExpF32Kernel(p, p, row_size_kv_valid, &negmax);
 #endif
 
                 // Note: for ir == 0, there is actually no need to calculate exp_diff
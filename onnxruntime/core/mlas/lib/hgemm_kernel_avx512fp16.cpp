@@ -0,0 +1,343 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    hgemm_kernel_avx512fp16.cpp
+
+Abstract:
+
+    This module implements half precision GEMM kernel for AVX512-FP16.
+
+    B is packed in strips of 32 columns, the width of a 512 bit vector of
+    fp16 elements. Each row of a strip is 32 consecutive elements, the last
+    strip is padded with zero columns.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+#if defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+
+namespace hgemm_avx512fp16 {
+
+constexpr size_t StripN = 32;
+
+//
+// Number of strips computed together, so the FMAs of independent
+// accumulators hide the latency of each other.
+//
+constexpr size_t MaxStrips = 4;
+
+MLAS_FORCEINLINE __mmask32
+StripMask(size_t CountN)
+{
+    return CountN >= StripN ? __mmask32(~0u) : __mmask32((1u << CountN) - 1);
+}
+
+MLAS_FORCEINLINE __m512h
+BroadcastFp16(_mlas_fp16_ Value)
+{
+    return _mm512_castsi512_ph(_mm512_set1_epi16(static_cast<short>(Value)));
+}
+
+MLAS_FORCEINLINE __m512h
+LoadStrip(const MLAS_FP16* Source, __mmask32 Mask)
+{
+    return _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask, Source));
+}
+
+MLAS_FORCEINLINE void
+StoreStrip(MLAS_FP16* Destination, __m512h Vector, __mmask32 Mask)
+{
+    _mm512_mask_storeu_epi16(Destination, Mask, _mm512_castph_si512(Vector));
+}
+
+MLAS_FORCEINLINE bool
+IsZeroFp16(_mlas_fp16_ Value)
+{
+    return (Value & 0x7fff) == 0;
+}
+
+void
+HPackB_B_Kernel(
+    const MLAS_FP16* B,
+    MLAS_FP16* PackedB,
+    size_t CountN,
+    size_t CountK,
+    size_t ldb
+)
+{
+    for (size_t n = 0; n < CountN; n += StripN) {
+        const __mmask32 Mask = StripMask(CountN - n);
+        const MLAS_FP16* b = B + n;
+
+        for (size_t k = 0; k < CountK; k++) {
+            _mm512_storeu_si512(PackedB, _mm512_maskz_loadu_epi16(Mask, b));
+            PackedB += StripN;
+            b += ldb;
+        }
+    }
+}
+
+void
+HPackB_TransposedB_Kernel(
+    const MLAS_FP16* B,
+    MLAS_FP16* PackedB,
+    size_t CountN,
+    size_t CountK,
+    size_t ldb
+)
+{
+    auto* Destination = reinterpret_cast<_mlas_fp16_*>(PackedB);
+
+    for (size_t n = 0; n < CountN; n += StripN) {
+        const size_t CountStripN = std::min(CountN - n, StripN);
+
+        //
+        // Column j of the strip is row n + j of the transposed B, copy it
+        // with a stride of the strip width.
+        //
+        for (size_t j = 0; j < StripN; j++) {
+            _mlas_fp16_* d = Destination + j;
+
+            if (j < CountStripN) {
+                const auto* b = reinterpret_cast<const _mlas_fp16_*>(B + (n + j) * ldb);
+                for (size_t k = 0; k < CountK; k++) {
+                    d[k * StripN] = b[k];
+                }
+            } else {
+                for (size_t k = 0; k < CountK; k++) {
+                    d[k * StripN] = 0;
+                }
+            }
+        }
+
+        Destination += CountK * StripN;
+    }
+}
+
+/**
+ * @brief C[0:Rows, 0:Strips*32] = alpha * A * B + beta * C, with the rows of
+ *        a strip of B ldb_row elements apart and the strips stride_strip
+ *        elements apart.
+ */
+template <size_t Rows, size_t Strips>
+MLAS_FORCEINLINE void
+HGemmBlock(
+    const MLAS_FP16* A,
+    size_t lda,
+    const MLAS_FP16* B,
+    size_t ldb_row,
+    size_t stride_strip,
+    MLAS_FP16* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_ alpha,
+    _mlas_fp16_ beta
+)
+{
+    __m512h Accumulators[Rows][Strips];
+    __mmask32 Masks[Strips];
+
+    for (size_t s = 0; s < Strips; s++) {
+        Masks[s] = StripMask(CountN - s * StripN);
+        for (size_t r = 0; r < Rows; r++) {
+            Accumulators[r][s] = _mm512_setzero_ph();
+        }
+    }
+
+    const auto* a = reinterpret_cast<const _mlas_fp16_*>(A);
+
+    for (size_t k = 0; k < CountK; k++) {
+        __m512h BElements[Strips];
+        for (size_t s = 0; s < Strips; s++) {
+            BElements[s] = LoadStrip(B + s * stride_strip + k * ldb_row, Masks[s]);
+        }
+
+        for (size_t r = 0; r < Rows; r++) {
+            const __m512h AElement = BroadcastFp16(a[r * lda + k]);
+            for (size_t s = 0; s < Strips; s++) {
+                Accumulators[r][s] = _mm512_fmadd_ph(AElement, BElements[s], Accumulators[r][s]);
+            }
+        }
+    }
+
+    const __m512h AlphaBroadcast = BroadcastFp16(alpha);
+    const __m512h BetaBroadcast = BroadcastFp16(beta);
+    const bool BetaIsZero = IsZeroFp16(beta);
+
+    for (size_t r = 0; r < Rows; r++) {
+        for (size_t s = 0; s < Strips; s++) {
+            MLAS_FP16* c = C + r * ldc + s * StripN;
+            __m512h Result = _mm512_mul_ph(Accumulators[r][s], AlphaBroadcast);
+            if (!BetaIsZero) {
+                Result = _mm512_fmadd_ph(LoadStrip(c, Masks[s]), BetaBroadcast, Result);
+            }
+            StoreStrip(c, Result, Masks[s]);
+        }
+    }
+}
+
+template <size_t Rows>
+MLAS_FORCEINLINE void
+HGemmRows(
+    const MLAS_FP16* A,
+    size_t lda,
+    const MLAS_FP16* B,
+    size_t ldb_row,
+    size_t stride_strip,
+    MLAS_FP16* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_ alpha,
+    _mlas_fp16_ beta
+)
+{
+    while (CountN > 0) {
+        const size_t Strips = std::min(MlasDivRoundup(CountN, StripN), MaxStrips);
+        const size_t CountBlockN = std::min(CountN, Strips * StripN);
+
+        switch (Strips) {
+            case 4:
+                HGemmBlock<Rows, 4>(A, lda, B, ldb_row, stride_strip, C, ldc, CountBlockN, CountK, alpha, beta);
+                break;
+            case 3:
+                HGemmBlock<Rows, 3>(A, lda, B, ldb_row, stride_strip, C, ldc, CountBlockN, CountK, alpha, beta);
+                break;
+            case 2:
+                HGemmBlock<Rows, 2>(A, lda, B, ldb_row, stride_strip, C, ldc, CountBlockN, CountK, alpha, beta);
+                break;
+            default:
+                HGemmBlock<Rows, 1>(A, lda, B, ldb_row, stride_strip, C, ldc, CountBlockN, CountK, alpha, beta);
+                break;
+        }
+
+        B += Strips * stride_strip;
+        C += CountBlockN;
+        CountN -= CountBlockN;
+    }
+}
+
+void
+HGemm_B_Kernel(
+    const MLAS_FP16* A,
+    const MLAS_FP16* B,
+    MLAS_FP16* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    _mlas_fp16_ alpha,
+    _mlas_fp16_ beta
+)
+{
+    assert(CountM <= 2);
+
+    if (CountM == 2) {
+        HGemmRows<2>(A, lda, B, ldb, StripN, C, ldc, CountN, CountK, alpha, beta);
+    } else {
+        HGemmRows<1>(A, lda, B, ldb, StripN, C, ldc, CountN, CountK, alpha, beta);
+    }
+}
+
+void
+HGemm_PackedB_Kernel(
+    const MLAS_FP16* A,
+    const MLAS_FP16* PackedB,
+    MLAS_FP16* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldc,
+    _mlas_fp16_ alpha,
+    _mlas_fp16_ beta
+)
+{
+    assert(CountM <= 2);
+
+    if (CountM == 2) {
+        HGemmRows<2>(A, lda, PackedB, StripN, StripN * CountK, C, ldc, CountN, CountK, alpha, beta);
+    } else {
+        HGemmRows<1>(A, lda, PackedB, StripN, StripN * CountK, C, ldc, CountN, CountK, alpha, beta);
+    }
+}
+
+/**
+ * @brief Sum the 32 fp16 elements of a vector in fp32.
+ */
+MLAS_FORCEINLINE float
+ReduceAddFp16(__m512h Vector)
+{
+    const __m512i Bits = _mm512_castph_si512(Vector);
+    const __m512 Low = _mm512_cvtxph_ps(_mm256_castsi256_ph(_mm512_castsi512_si256(Bits)));
+    const __m512 High = _mm512_cvtxph_ps(_mm256_castsi256_ph(_mm512_extracti64x4_epi64(Bits, 1)));
+    return _mm512_reduce_add_ps(_mm512_add_ps(Low, High));
+}
+
+void
+HGemm_TransposedB_Kernel(
+    const MLAS_FP16* A,
+    const MLAS_FP16* B,
+    MLAS_FP16* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    _mlas_fp16_ alpha,
+    _mlas_fp16_ beta
+)
+{
+    assert(CountM <= 2);
+
+    const float AlphaValue = MLAS_Half2Float(alpha);
+    const float BetaValue = MLAS_Half2Float(beta);
+    const bool BetaIsZero = IsZeroFp16(beta);
+
+    for (size_t n = 0; n < CountN; n++) {
+        const MLAS_FP16* b = B + n * ldb;
+        __m512h Accumulators[2] = {_mm512_setzero_ph(), _mm512_setzero_ph()};
+
+        for (size_t k = 0; k < CountK; k += StripN) {
+            const __mmask32 Mask = StripMask(CountK - k);
+            const __m512h BElements = LoadStrip(b + k, Mask);
+            for (size_t m = 0; m < CountM; m++) {
+                Accumulators[m] = _mm512_fmadd_ph(LoadStrip(A + m * lda + k, Mask), BElements, Accumulators[m]);
+            }
+        }
+
+        for (size_t m = 0; m < CountM; m++) {
+            auto* c = reinterpret_cast<_mlas_fp16_*>(C + m * ldc + n);
+            float Result = AlphaValue * ReduceAddFp16(Accumulators[m]);
+            if (!BetaIsZero) {
+                Result += BetaValue * MLAS_Half2Float(*c);
+            }
+            *c = MLAS_Float2Half(Result);
+        }
+    }
+}
+
+}  // namespace hgemm_avx512fp16
+
+const MLAS_HGEMM_DISPATCH MlasHGemmDispatchAvx512Fp16 = []() {
+    MLAS_HGEMM_DISPATCH d;
+    d.HPackBKernel_TransposedB = hgemm_avx512fp16::HPackB_TransposedB_Kernel;
+    d.HPackBKernel_B = hgemm_avx512fp16::HPackB_B_Kernel;
+    d.HGemmKernel_TransposedB = hgemm_avx512fp16::HGemm_TransposedB_Kernel;
+    d.HGemmKernel_B = hgemm_avx512fp16::HGemm_B_Kernel;
+    d.HGemmKernel_PackedB = hgemm_avx512fp16::HGemm_PackedB_Kernel;
+    return d;
+}();
+
+#endif  // defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
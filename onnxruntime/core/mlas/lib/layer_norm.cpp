@@ -0,0 +1,279 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layer_norm.cpp
+
+Abstract:
+
+    This module implements the row normalization kernels of LayerNormalization,
+    SimplifiedLayerNormalization (RMSNorm) and their SkipLayerNormalization
+    variants, for fp32 and fp16 rows.
+
+    The mean and variance are accumulated in a single pass as the sums of the
+    elements and of their squares, shifted by the first element of the row so
+    rows with a large mean don't lose the variance to cancellation. A second
+    pass normalizes the row.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements of a row that are converted to fp32 at once.
+//
+
+constexpr size_t MLAS_LAYER_NORM_BLOCK_SIZE = 64;
+
+//
+// Returns the elements [Start, Start + Count) of a row as fp32, from Buffer if
+// they need to be converted.
+//
+
+MLAS_FORCEINLINE
+const float*
+MlasLayerNormLoad(const float* Row, size_t Start, size_t Count, float* Buffer)
+{
+    MLAS_UNREFERENCED_PARAMETER(Count);
+    MLAS_UNREFERENCED_PARAMETER(Buffer);
+    return Row + Start;
+}
+
+MLAS_FORCEINLINE
+const float*
+MlasLayerNormLoad(const MLAS_FP16* Row, size_t Start, size_t Count, float* Buffer)
+{
+    MlasConvertHalfToFloatBuffer(Row + Start, Buffer, Count);
+    return Buffer;
+}
+
+MLAS_FORCEINLINE
+void
+MlasLayerNormStore(const float* Values, size_t Count, float* Row)
+{
+    if (Values != Row) {
+        std::copy_n(Values, Count, Row);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasLayerNormStore(const float* Values, size_t Count, MLAS_FP16* Row)
+{
+    MlasConvertFloatToHalfBuffer(Values, Row, Count);
+}
+
+//
+// Loads the block [Start, Start + Count) of Input + Skip + Bias. Buffer is
+// returned, unless there is nothing to add to Input.
+//
+
+template <typename T>
+MLAS_FORCEINLINE
+const float*
+MlasLayerNormLoadSum(
+    const T* Input,
+    const T* Skip,
+    const float* Bias,
+    size_t Start,
+    size_t Count,
+    float* Buffer,
+    float* SkipBuffer
+    )
+{
+    const float* x = MlasLayerNormLoad(Input, Start, Count, Buffer);
+    if (Skip == nullptr && Bias == nullptr) {
+        return x;
+    }
+
+    const float* skip = Skip != nullptr ? MlasLayerNormLoad(Skip, Start, Count, SkipBuffer) : nullptr;
+    const float* bias = Bias != nullptr ? Bias + Start : nullptr;
+
+    for (size_t i = 0; i < Count; i++) {
+        float value = x[i];
+        if (skip != nullptr) {
+            value += skip[i];
+        }
+        if (bias != nullptr) {
+            value += bias[i];
+        }
+        Buffer[i] = value;
+    }
+    return Buffer;
+}
+
+template <typename T>
+void
+MLASCALL
+MlasLayerNormOneRow(
+    const T* Input,
+    const T* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    T* Output,
+    T* SumOutput,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+    if (N == 0) {
+        return;
+    }
+
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_LAYER_NORM_BLOCK_SIZE], 16);
+    MLAS_DECLSPEC_ALIGN(float SkipBuffer[MLAS_LAYER_NORM_BLOCK_SIZE], 16);
+
+    //
+    // Accumulate the sum and the sum of squares of X - Offset.
+    //
+
+    float Offset = 0.0f;
+    if (!Simplified) {
+        Offset = *MlasLayerNormLoadSum(Input, Skip, Bias, 0, 1, Buffer, SkipBuffer);
+    }
+
+    MLAS_FLOAT32X4 OffsetVector = MlasBroadcastFloat32x4(Offset);
+    MLAS_FLOAT32X4 SumVector = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquaresVector = MlasZeroFloat32x4();
+    float Sum = 0.0f;
+    float SumSquares = 0.0f;
+
+    for (size_t Start = 0; Start < N; Start += MLAS_LAYER_NORM_BLOCK_SIZE) {
+        const size_t Count = std::min(N - Start, MLAS_LAYER_NORM_BLOCK_SIZE);
+        const float* x = MlasLayerNormLoadSum(Input, Skip, Bias, Start, Count, Buffer, SkipBuffer);
+
+        if (SumOutput != nullptr) {
+            MlasLayerNormStore(x, Count, SumOutput + Start);
+        }
+
+        size_t i = 0;
+        for (; i + 4 <= Count; i += 4) {
+            MLAS_FLOAT32X4 Value = MlasSubtractFloat32x4(MlasLoadFloat32x4(x + i), OffsetVector);
+            SumVector = MlasAddFloat32x4(SumVector, Value);
+            SumSquaresVector = MlasMultiplyAddFloat32x4(Value, Value, SumSquaresVector);
+        }
+        for (; i < Count; i++) {
+            const float Value = x[i] - Offset;
+            Sum += Value;
+            SumSquares += Value * Value;
+        }
+    }
+
+    Sum += MlasReduceAddFloat32x4(SumVector);
+    SumSquares += MlasReduceAddFloat32x4(SumSquaresVector);
+
+    const float ShiftedMean = Sum / static_cast<float>(N);
+    const float MeanValue = Offset + ShiftedMean;
+    const float Variance = Simplified ? SumSquares / static_cast<float>(N)
+                                      : std::max(SumSquares / static_cast<float>(N) - ShiftedMean * ShiftedMean, 0.0f);
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    if (Mean != nullptr && !Simplified) {
+        *Mean = MeanValue;
+    }
+    if (InvStdDev != nullptr) {
+        *InvStdDev = InvStdDevValue;
+    }
+
+    //
+    // Normalize, as (X - Mean) * InvStdDev * Scale + Shift.
+    //
+
+    const float Center = Simplified ? 0.0f : MeanValue;
+    const float* ShiftData = Simplified ? nullptr : Shift;
+    MLAS_FLOAT32X4 CenterVector = MlasBroadcastFloat32x4(Center);
+    MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDevValue);
+
+    for (size_t Start = 0; Start < N; Start += MLAS_LAYER_NORM_BLOCK_SIZE) {
+        const size_t Count = std::min(N - Start, MLAS_LAYER_NORM_BLOCK_SIZE);
+
+        //
+        // The fp32 sum was written to SumOutput, there is no need to add it up again.
+        //
+
+        const float* x;
+        if constexpr (std::is_same_v<T, float>) {
+            x = SumOutput != nullptr ? SumOutput + Start
+                                     : MlasLayerNormLoadSum(Input, Skip, Bias, Start, Count, Buffer, SkipBuffer);
+        } else {
+            x = MlasLayerNormLoadSum(Input, Skip, Bias, Start, Count, Buffer, SkipBuffer);
+        }
+
+        const float* scale = Scale + Start;
+        const float* shift = ShiftData != nullptr ? ShiftData + Start : nullptr;
+
+        //
+        // Write fp32 rows in place, and fp16 rows through Buffer.
+        //
+
+        float* y;
+        if constexpr (std::is_same_v<T, float>) {
+            y = Output + Start;
+        } else {
+            y = Buffer;
+        }
+
+        size_t i = 0;
+        for (; i + 4 <= Count; i += 4) {
+            MLAS_FLOAT32X4 Value = MlasSubtractFloat32x4(MlasLoadFloat32x4(x + i), CenterVector);
+            Value = MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(Value, InvStdDevVector), MlasLoadFloat32x4(scale + i));
+            if (shift != nullptr) {
+                Value = MlasAddFloat32x4(Value, MlasLoadFloat32x4(shift + i));
+            }
+            MlasStoreFloat32x4(y + i, Value);
+        }
+        for (; i < Count; i++) {
+            float Value = (x[i] - Center) * InvStdDevValue * scale[i];
+            if (shift != nullptr) {
+                Value += shift[i];
+            }
+            y[i] = Value;
+        }
+
+        MlasLayerNormStore(y, Count, Output + Start);
+    }
+}
+
+template
+void
+MLASCALL
+MlasLayerNormOneRow<float>(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Output,
+    float* SumOutput,
+    float* Mean,
+    float* InvStdDev
+    );
+
+template
+void
+MLASCALL
+MlasLayerNormOneRow<MLAS_FP16>(
+    const MLAS_FP16* Input,
+    const MLAS_FP16* Skip,
+    const float* Bias,
+    const float* Scale,
+    const float* Shift,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    MLAS_FP16* Output,
+    MLAS_FP16* SumOutput,
+    float* Mean,
+    float* InvStdDev
+    );
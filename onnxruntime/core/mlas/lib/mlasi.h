@@ -966,7 +966,7 @@ extern "C" {
 #define MLAS_QGEMM_THREAD_COMPLEXITY                65536
 #define MLAS_HGEMM_THREAD_COMPLEXITY                65536
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 #define MLAS_SBGEMM_THREAD_COMPLEXITY (size_t(64) * size_t(1024))
 #endif
 
@@ -1042,6 +1042,8 @@ extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchNeon;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchNeon;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchDot;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchDot;
+extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchI8mm;
+extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchI8mm;
 
 //
 // Quantized 8-bit integer/quantized 4-bit integer matrix/matrix multiply dispatch structure.
@@ -1078,6 +1080,9 @@ extern const MLAS_QNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512;
 
 extern const MLAS_QNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512vnni;
 
+const MLAS_QNBIT_GEMM_DISPATCH&
+GetMlasQNBitGemmDispatchAmx();
+
 //
 // Rotary embedding dispatch structure.
 //
@@ -1090,14 +1095,31 @@ extern const MLAS_ROPE_DISPATCH MlasRopeDispatchAvx2;
 //
 struct MLAS_HGEMM_DISPATCH;
 extern const MLAS_HGEMM_DISPATCH MlasHGemmDispatchNeon;
+#if defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+extern const MLAS_HGEMM_DISPATCH MlasHGemmDispatchAvx512Fp16;
+#endif
 
 // softmax dispatch structure
 struct MLAS_SOFTMAX_DISPATCH;
 extern const MLAS_SOFTMAX_DISPATCH MlasSoftmaxDispatchNeon;
+#if defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+extern const MLAS_SOFTMAX_DISPATCH MlasSoftmaxDispatchAvx512Fp16;
+#endif
 
 // eltwise dispatch structure
 struct MLAS_ELTWISE_DISPATCH;
 extern const MLAS_ELTWISE_DISPATCH MlasEltwiseDispatchNeon;
+#if defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+extern const MLAS_ELTWISE_DISPATCH MlasEltwiseDispatchAvx512Fp16;
+#endif
+
+//
+// bfloat16 precision gemm dispatch structure
+//
+struct MLAS_SBGEMM_DISPATCH;
+#if defined(MLAS_TARGET_AMD64)
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16;
+#endif
 
 //
 // Quantized depthwise convolution kernels.
@@ -1267,6 +1289,9 @@ struct MLAS_PLATFORM {
     const MLAS_HGEMM_DISPATCH* HGemmDispatch{nullptr};
     const MLAS_SOFTMAX_DISPATCH* SoftmaxDispatch{nullptr};
     const MLAS_ELTWISE_DISPATCH* EltwiseDispatch{nullptr};
+#if defined(MLAS_TARGET_AMD64)
+    const MLAS_SBGEMM_DISPATCH* SBGemmDispatch{nullptr};
+#endif
 };
 
 inline
@@ -2146,6 +2171,8 @@ MlasMultiplyAddFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_FL
     return _mm_add_ps(_mm_mul_ps(Vector1, Vector2), Vector3);
 #elif defined(MLAS_VSX_INTRINSICS)
     return vec_madd(Vector1, Vector2, Vector3);
+#elif defined(MLAS_WASM_RELAXED_SIMD_INTRINSICS)
+    return wasm_f32x4_relaxed_madd(Vector1, Vector2, Vector3);
 #elif defined(MLAS_WASM_SIMD_INTRINSICS)
     return wasm_f32x4_add(wasm_f32x4_mul(Vector1, Vector2), Vector3);
 #elif defined(MLAS_LSX_INTRINSICS)
@@ -19,6 +19,8 @@ Abstract:
 
 #include <thread>
 #include <mutex>
+#include <cstdlib>
+#include <cstring>
 
 #if defined(MLAS_TARGET_POWER)
 #if defined(__linux__)
@@ -220,6 +222,81 @@ MLAS_INTERNAL_DATA MLAS_DECLSPEC_ALIGN(const uint32_t MlasMaskMoveTableLasx[16],
 };
 
 #endif
+
+#if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_ARM64)
+
+//
+// The instruction sets the dispatch can be capped to with the MLAS_MAX_ISA
+// environment variable, from the oldest to the newest. A capped dispatch runs
+// the kernels of an older instruction set, so the kernel paths of each
+// instruction set can be compared on the same machine.
+//
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+enum MLAS_ISA_LEVEL {
+    MlasIsaSse,
+    MlasIsaAvx,
+    MlasIsaAvx2,
+    MlasIsaAvx512,
+    MlasIsaAmx,
+    MlasIsaLevelCount,
+};
+
+static const char* const MlasIsaNames[MlasIsaLevelCount] = {"sse", "avx", "avx2", "avx512", "amx"};
+#else
+enum MLAS_ISA_LEVEL {
+    MlasIsaNeon,
+    MlasIsaNeonDot,
+    MlasIsaNeonI8mm,
+    MlasIsaLevelCount,
+};
+
+static const char* const MlasIsaNames[MlasIsaLevelCount] = {"neon", "dot", "i8mm"};
+#endif
+
+static
+MLAS_ISA_LEVEL
+MlasGetMaximumIsaLevel(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the newest instruction set the dispatch may use.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns the instruction set named by MLAS_MAX_ISA, else the newest one.
+
+--*/
+{
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+    const char* MaxIsa = getenv("MLAS_MAX_ISA");
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+    if (MaxIsa != nullptr) {
+        for (int i = 0; i < MlasIsaLevelCount; i++) {
+            if (strcmp(MaxIsa, MlasIsaNames[i]) == 0) {
+                return MLAS_ISA_LEVEL(i);
+            }
+        }
+    }
+
+    return MLAS_ISA_LEVEL(MlasIsaLevelCount - 1);
+}
+
+#endif
+
 MLAS_PLATFORM::MLAS_PLATFORM(
     void
     )
@@ -300,6 +377,8 @@ Return Value:
 
 #endif
 
+    const MLAS_ISA_LEVEL MaxIsa = MlasGetMaximumIsaLevel();
+
     unsigned Cpuid1[4];
 #if defined(_WIN32)
     __cpuid((int*)Cpuid1, 1);
@@ -327,7 +406,7 @@ Return Value:
     //
 
 #ifndef FORCE_GENERIC_ALGORITHMS
-    if ((Cpuid1[2] & 0x18000000) == 0x18000000) {
+    if ((Cpuid1[2] & 0x18000000) == 0x18000000 && MaxIsa >= MlasIsaAvx) {
 #else  // FORCE_GENERIC_ALGORITHMS
     if (false) {
 #endif  // FORCE_GENERIC_ALGORITHMS
@@ -372,7 +451,7 @@ Return Value:
             __cpuid_count(7, 0, Cpuid7[0], Cpuid7[1], Cpuid7[2], Cpuid7[3]);
 #endif
 
-            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0)) {
+            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0) && MaxIsa >= MlasIsaAvx2) {
 
                 this->Avx2Supported_ = true;
 
@@ -441,7 +520,7 @@ Return Value:
                 // operating system supports saving AVX512F state.
                 //
 
-                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
+                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0) && MaxIsa >= MlasIsaAvx512) {
 
                     this->GemmFloatKernel = MlasGemmFloatKernelAvx512F;
                     this->GemmDoubleKernel = MlasGemmDoubleKernelAvx512F;
@@ -489,6 +568,28 @@ Return Value:
                             this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchAvx512vnni;
                             this->QNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512vnni;
                         }
+
+                        //
+                        // Check if the processor supports AVX512-BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+
+                            this->SBGemmDispatch = &MlasSBGemmDispatchAvx512Bf16;
+                        }
+
+#if defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+                        //
+                        // Check if the processor supports AVX512-FP16.
+                        //
+
+                        if ((Cpuid7[3] & 0x800000) != 0) {
+
+                            this->HGemmDispatch = &MlasHGemmDispatchAvx512Fp16;
+                            this->SoftmaxDispatch = &MlasSoftmaxDispatchAvx512Fp16;
+                            this->EltwiseDispatch = &MlasEltwiseDispatchAvx512Fp16;
+                        }
+#endif
                     }
                 }
 
@@ -520,10 +621,14 @@ Return Value:
                 //
                 if ((Cpuid7[3] & 0b1 << 24) != 0 &&
                     (Cpuid7[3] & 0b1 << 25) != 0 &&
-                    (xcr0 & XFEATURE_MASK_XTILE) == XFEATURE_MASK_XTILE) {
+                    (xcr0 & XFEATURE_MASK_XTILE) == XFEATURE_MASK_XTILE &&
+                    MaxIsa >= MlasIsaAmx) {
                     if (MlasInitAMX()) {
                         this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAmx;
                         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+                        if (this->QNBitGemmDispatch == &MlasSQNBitGemmDispatchAvx512vnni) {
+                            this->QNBitGemmDispatch = &GetMlasQNBitGemmDispatchAmx();
+                        }
                     }
                 }
 #endif // __APPLE__
@@ -565,7 +670,9 @@ Return Value:
     // asm("mrs %[reg], ID_AA64ISAR0_EL1\n" : [reg] "=r"(isar0_el1) : :);
     // const bool HasDotProductInstructions = ((isar0_el1 >> 44) & 0xfu) == 0x1u;
 
-    const bool HasDotProductInstructions = MLAS_CPUIDINFO::GetCPUIDInfo().HasArmNeonDot();
+    const MLAS_ISA_LEVEL MaxIsa = MlasGetMaximumIsaLevel();
+    const bool HasDotProductInstructions =
+        MLAS_CPUIDINFO::GetCPUIDInfo().HasArmNeonDot() && MaxIsa >= MlasIsaNeonDot;
 
     if (HasDotProductInstructions) {
         this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchUdot;
@@ -582,10 +689,12 @@ Return Value:
     //
     // Check if the processor supports ASIMD I8MM instructions.
     //
-    if (MLAS_CPUIDINFO::GetCPUIDInfo().HasArmNeon_I8MM()) {
+    if (MLAS_CPUIDINFO::GetCPUIDInfo().HasArmNeon_I8MM() && MaxIsa >= MlasIsaNeonI8mm) {
         this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchUmmla;
         this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchUmmla;
         this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchSmmla;
+        this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchI8mm;
+        this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchI8mm;
     }
 #endif
 
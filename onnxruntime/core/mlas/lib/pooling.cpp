@@ -1279,10 +1279,52 @@ Return Value:
     PoolKernelRoutine(&WorkBlock, TotalChannelCount, Input, Output);
 #else
     //
-    // Use an external thread pool if one is provided.
-    // TODO: change to use MlasExecuteThreaded
-    onnxruntime::concurrency::ThreadPool::TryBatchParallelFor(ThreadPool, static_cast<ptrdiff_t>(TotalChannelCount), [&](ptrdiff_t c) {
-      PoolKernelRoutine(&WorkBlock, 1, Input + c * InputSize, Output + c * OutputSize);
+    // When there are fewer channels than threads, split the outermost output
+    // dimension of each channel into tiles, so that a few large planes still
+    // keep the threads busy. A tile is computed by the same kernel with the
+    // output rows before it removed from the leading padding, which becomes
+    // negative past the padded rows. The global kernels reduce a plane to a
+    // single output and are only split across the channels.
+    //
+
+    const size_t OutputRows = WorkBlock.OutputShape[0];
+    size_t RowsPerTile = OutputRows;
+
+    if (PoolKernelRoutine != MlasPoolGlobalKernels[PoolingKind] && OutputRows > 1) {
+
+        const size_t ThreadCount = size_t(MlasGetMaximumThreadCount(ThreadPool));
+
+        if (TotalChannelCount < ThreadCount) {
+
+            const size_t TilesPerChannel = std::min(OutputRows, (ThreadCount + TotalChannelCount - 1) / TotalChannelCount);
+            RowsPerTile = (OutputRows + TilesPerChannel - 1) / TilesPerChannel;
+        }
+    }
+
+    const size_t TilesPerChannel = (OutputRows + RowsPerTile - 1) / RowsPerTile;
+
+    if (TilesPerChannel <= 1) {
+
+        //
+        // Use an external thread pool if one is provided.
+        // TODO: change to use MlasExecuteThreaded
+        onnxruntime::concurrency::ThreadPool::TryBatchParallelFor(ThreadPool, static_cast<ptrdiff_t>(TotalChannelCount), [&](ptrdiff_t c) {
+          PoolKernelRoutine(&WorkBlock, 1, Input + c * InputSize, Output + c * OutputSize);
+        }, 0);
+        return;
+    }
+
+    const size_t OutputRowSize = OutputSize / OutputRows;
+
+    onnxruntime::concurrency::ThreadPool::TryBatchParallelFor(ThreadPool, static_cast<ptrdiff_t>(TotalChannelCount * TilesPerChannel), [&](ptrdiff_t t) {
+      const size_t c = size_t(t) / TilesPerChannel;
+      const size_t RowStart = (size_t(t) % TilesPerChannel) * RowsPerTile;
+
+      MLAS_POOL_WORK_BLOCK TileWorkBlock = WorkBlock;
+      TileWorkBlock.OutputShape[0] = std::min(RowsPerTile, OutputRows - RowStart);
+      TileWorkBlock.Padding[0] -= int64_t(RowStart) * WorkBlock.StrideShape[0];
+
+      PoolKernelRoutine(&TileWorkBlock, 1, Input + c * InputSize, Output + c * OutputSize + RowStart * OutputRowSize);
     }, 0);
     return;
 #endif
@@ -166,17 +166,6 @@ MlasGemmQuantCopyPackB<MLAS_GEMM_U8S8_KERNEL_AMX>(
 }
 
 
-// Tile configure structure
-struct tileconfig_t {
-    uint8_t palette_id = 0;
-    uint8_t start_row = 0;
-    uint8_t reserved1[14] = {0};
-    uint16_t colb[8] = {0};
-    uint8_t reserved2[16] = {0};
-    uint8_t rows[8] = {0};
-    uint8_t reserved3[8] = {0};
-};
-
 template <>
 MLAS_FORCEINLINE
 void
@@ -1053,12 +1053,21 @@ MlasQNBitGemmBatch(
     // Compute the number of target threads given the complexity of the SGEMM
     // operation. Small requests should run using the single threaded path.
     //
+    // A GEMM of a few rows, as in token generation, is bound by reading B rather than by
+    // the multiply-adds. Its cost is taken as that of MemoryBoundM rows whatever M is, and
+    // N is split into one strip of B per thread instead of oversubscribing the thread pool,
+    // so each thread streams one contiguous range of B.
+    //
+
+    constexpr size_t MemoryBoundM = 4;
+    const bool IsMemoryBound = M <= MemoryBoundM;
 
-    const double Complexity = double(M) * double(N) * double(K) * double(BatchN);
+    const double Complexity =
+        double(IsMemoryBound ? MemoryBoundM : M) * double(N) * double(K) * double(BatchN);
 
     ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
 
-    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool) * 8;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool) * (IsMemoryBound ? 1 : 8);
 
     if (TargetThreadCount >= MaximumThreadCount) {
         TargetThreadCount = MaximumThreadCount;
@@ -22,6 +22,10 @@ Abstract:
 
     MlasSBGemmOperation is the shared kernel driver.
 
+    The driver defines the public SBGEMM routines, so it is included by the
+    kernel source file of a single target: sbgemm_kernel_neon.cpp on ARM64
+    Linux, sbgemm_kernel_avx512bf16.cpp on AMD64.
+
     A kernel type should define the following constants:
         bool PackNeeded;         Whether B needs to be packed
         size_t KernelMaxM;       Max # rows the vectorized kernel can process
@@ -30,7 +34,7 @@ Abstract:
         MLAS_SBGEMM_STRIDES Strides{128, 128, 256};
 --*/
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
 
 #pragma once
 
@@ -39,6 +43,14 @@ Abstract:
 
 #include "mlasi.h"
 
+#if defined(MLAS_TARGET_AMD64)
+//
+// The bfloat16 values are stored in their 16 bit patterns, the instructions
+// operating on them take integer vectors.
+//
+typedef uint16_t bfloat16_t;
+#endif
+
 /**
  * @brief Define the default striding parameters for
  *        the bfloat16 precision gemm operation
@@ -134,7 +146,12 @@ MlasSBGemmPackedOperation(size_t M, size_t RangeStartN, size_t RangeCountN, size
             bool ZeroMode = (k == 0);
             CountK = std::min(K - k, PackedStrideK);
 
-            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k + CountK * SliceStartN;
+            //
+            // Each K slice holds the packed columns of all of B, the columns
+            // of a K slice are packed with its rows padded to PackedK.
+            //
+            const size_t PaddedCountK = (CountK + KernelType::PackedK - 1) & ~(KernelType::PackedK - 1);
+            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k + PaddedCountK * SliceStartN;
             float* c = C + n;
             const float* pbias = ((nullptr == Bias) ? nullptr : Bias + RangeStartN + n);
             MlasSBGemmKernel<KernelType>(M, CountN, CountK, A + k, lda, pb, c, ldc, ZeroMode ? pbias : nullptr, ZeroMode);
@@ -155,14 +172,15 @@ MlasSBGemmNonPackedOperation(size_t M, size_t N, size_t K, const float* A, size_
     //
     // Expand the N stride if K is small or expand the K stride if N is small
     // for better utilization of the B panel. Avoid changing the K stride if
-    // the A panel needs to be used for transposing.
+    // the A panel needs to be used for transposing. The K stride is kept a
+    // multiple of PackedK, so the padded panel fits the packing buffer.
     //
     constexpr MLAS_SBGEMM_STRIDES Strides = KernelType::Strides;
     size_t StrideN = Strides.N;
     size_t StrideK = Strides.K;
 
     if (N >= K) {
-        while (StrideK / 2 >= K) {
+        while (StrideK / 2 >= K && StrideK / 2 >= KernelType::PackedK) {
             StrideN *= 2;
             StrideK /= 2;
         }
@@ -291,6 +309,8 @@ MlasSBGemmGetDispatch()
 {
 #if defined(MLAS_TARGET_ARM64)
     return &MlasSBGemmDispatchNeon;
+#elif defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().SBGemmDispatch;
 #else
     std::cerr << "SBGemm Kernel is supported only on ARM64 platform.";
     exit(1);
@@ -396,4 +416,4 @@ MlasSBGemmBatch(const size_t M, const size_t N, const size_t K, const size_t Bat
         }
     );
 }
-#endif  // defined(__aarch64__) && defined(__linux__)
+#endif  // defined(MLAS_SBGEMM_SUPPORTED)
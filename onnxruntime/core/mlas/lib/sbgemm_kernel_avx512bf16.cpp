@@ -0,0 +1,277 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements bfloat16 precision GEMM kernel for AVX512-BF16.
+
+    Matrix A is converted to bfloat16 a block of rows at a time, matrix B is
+    converted and packed in strips of 16 columns, with the rows of a strip
+    interleaved in pairs to feed the VDPBF16PS instruction. The products are
+    accumulated in single precision.
+
+--*/
+
+#include "mlasi.h"
+
+#if defined(MLAS_TARGET_AMD64)
+
+#include "sbgemm.h"
+
+struct MLAS_SBGEMM_KERNEL_AVX512BF16 {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 8;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 2;
+    static constexpr size_t PackedN = MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+};
+
+static_assert(MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN == 16, "kernel processes strips of 16 columns");
+
+bool MLASCALL
+MlasBf16AccelerationSupported()
+{
+    return GetMlasPlatform().SBGemmDispatch != nullptr;
+}
+
+/*
+    This routine converts fp32 to bf16 and copies elements from the source
+    matrix to the destination packed buffer.
+
+    The columns are packed in strips of 16. Inside a strip, each pair of rows
+    is stored as 16 consecutive (row k, row k + 1) element pairs. The last
+    strip is padded with zero columns and the last pair with a zero row.
+*/
+MLAS_FORCEINLINE
+void
+MlasSBGemmConvertCopyPackB(bfloat16_t* D, const float* B, size_t ldb, size_t CountN, size_t CountK)
+{
+    //
+    // Interleave the 16 elements of the first row with the 16 elements of
+    // the second row.
+    //
+    const __m512i InterleaveIndices = _mm512_set_epi16(
+        31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8,
+        23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0
+    );
+
+    for (size_t n = 0; n < CountN; n += 16) {
+        const size_t CountStripN = std::min(CountN - n, size_t(16));
+        const __mmask16 LoadMask = __mmask16((1u << CountStripN) - 1);
+        const float* b = B + n;
+
+        for (size_t k = 0; k < CountK; k += 2) {
+            __m512 Row0 = _mm512_maskz_loadu_ps(LoadMask, b);
+            __m512 Row1 = (k + 1 < CountK) ? _mm512_maskz_loadu_ps(LoadMask, b + ldb) : _mm512_setzero_ps();
+
+            __m512i Packed = (__m512i)_mm512_cvtne2ps_pbh(Row1, Row0);
+            Packed = _mm512_permutexvar_epi16(InterleaveIndices, Packed);
+            _mm512_storeu_si512(D, Packed);
+
+            D += 32;
+            b += 2 * ldb;
+        }
+    }
+}
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    constexpr size_t PackedN = MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN;
+    constexpr size_t PackedK = MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK;
+
+    const size_t AlignedN = (CountN + PackedN - 1) & ~(PackedN - 1);
+
+    //
+    // Step through each slice of matrix B along the K dimension.
+    //
+    size_t K_block_size;
+    constexpr MLAS_SBGEMM_STRIDES Strides = MLAS_SBGEMM_KERNEL_AVX512BF16::Strides;
+
+    for (size_t k = 0; k < CountK; k += K_block_size) {
+        K_block_size = std::min(CountK - k, Strides.K);
+
+        MlasSBGemmConvertCopyPackB(PackedB, B + k * ldb, ldb, CountN, K_block_size);
+        PackedB += AlignedN * ((K_block_size + PackedK - 1) & ~(PackedK - 1));
+    }
+}
+
+/*
+    This routine computes a block of up to KernelMaxM rows and 16 columns of
+    matrix C from the converted rows of matrix A and a packed strip of
+    matrix B.
+*/
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmKernelAvx512Bf16Block(
+    const uint32_t* APairs,
+    size_t lda_pairs,
+    const bfloat16_t* B,
+    size_t CountPairsK,
+    float* C,
+    size_t ldc,
+    __mmask16 StoreMask,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    __m512 Accumulators[RowCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        if (!ZeroMode) {
+            Accumulators[r] = _mm512_maskz_loadu_ps(StoreMask, C + r * ldc);
+        } else if (Bias != nullptr) {
+            Accumulators[r] = _mm512_maskz_loadu_ps(StoreMask, Bias);
+        } else {
+            Accumulators[r] = _mm512_setzero_ps();
+        }
+    }
+
+    for (size_t p = 0; p < CountPairsK; p++) {
+        const __m512bh BElements = (__m512bh)_mm512_loadu_si512(B);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m512bh AElements = (__m512bh)_mm512_set1_epi32(int32_t(APairs[r * lda_pairs + p]));
+            Accumulators[r] = _mm512_dpbf16_ps(Accumulators[r], AElements, BElements);
+        }
+
+        B += 32;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        _mm512_mask_storeu_ps(C + r * ldc, StoreMask, Accumulators[r]);
+    }
+}
+
+/*
+    This routine computes matrix C for a panel of at most Strides.K rows of
+    packed matrix B.
+*/
+void
+MlasSBGemmKernelAvx512Bf16Panel(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    const float* A,
+    size_t lda,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+)
+{
+    constexpr size_t KernelMaxM = MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM;
+    constexpr size_t StrideK = MLAS_SBGEMM_KERNEL_AVX512BF16::Strides.K;
+
+    //
+    // Rows of matrix A converted to bfloat16, as pairs of consecutive
+    // elements. The elements past CountK are zero.
+    //
+    MLAS_DECLSPEC_ALIGN(uint32_t APairs[KernelMaxM][StrideK / 2], 64);
+
+    const size_t CountPairsK = (CountK + 1) / 2;
+    const size_t StripSize = CountPairsK * 32;
+
+    size_t RowCount;
+    for (size_t m = 0; m < CountM; m += RowCount) {
+        RowCount = std::min(CountM - m, KernelMaxM);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const float* a = A + (m + r) * lda;
+            uint32_t* pairs = APairs[r];
+
+            for (size_t k = 0; k < CountK; k += 16) {
+                const size_t CountBlockK = std::min(CountK - k, size_t(16));
+                const __mmask16 LoadMask = __mmask16((1u << CountBlockK) - 1);
+                const __m256i Converted = (__m256i)_mm512_cvtneps_pbh(_mm512_maskz_loadu_ps(LoadMask, a + k));
+                _mm256_storeu_si256((__m256i*)(pairs + k / 2), Converted);
+            }
+        }
+
+        const bfloat16_t* b = B;
+        float* c = C + m * ldc;
+
+        for (size_t n = 0; n < CountN; n += 16) {
+            const size_t CountStripN = std::min(CountN - n, size_t(16));
+            const __mmask16 StoreMask = __mmask16((1u << CountStripN) - 1);
+            const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
+
+            switch (RowCount) {
+                case 1:
+                    MlasSBGemmKernelAvx512Bf16Block<1>(APairs[0], StrideK / 2, b, CountPairsK, c + n, ldc, StoreMask, bias, ZeroMode);
+                    break;
+                case 2:
+                    MlasSBGemmKernelAvx512Bf16Block<2>(APairs[0], StrideK / 2, b, CountPairsK, c + n, ldc, StoreMask, bias, ZeroMode);
+                    break;
+                case 3:
+                    MlasSBGemmKernelAvx512Bf16Block<3>(APairs[0], StrideK / 2, b, CountPairsK, c + n, ldc, StoreMask, bias, ZeroMode);
+                    break;
+                case 4:
+                    MlasSBGemmKernelAvx512Bf16Block<4>(APairs[0], StrideK / 2, b, CountPairsK, c + n, ldc, StoreMask, bias, ZeroMode);
+                    break;
+                case 5:
+                    MlasSBGemmKernelAvx512Bf16Block<5>(APairs[0], StrideK / 2, b, CountPairsK, c + n, ldc, StoreMask, bias, ZeroMode);
+                    break;
+                case 6:
+                    MlasSBGemmKernelAvx512Bf16Block<6>(APairs[0], StrideK / 2, b, CountPairsK, c + n, ldc, StoreMask, bias, ZeroMode);
+                    break;
+                case 7:
+                    MlasSBGemmKernelAvx512Bf16Block<7>(APairs[0], StrideK / 2, b, CountPairsK, c + n, ldc, StoreMask, bias, ZeroMode);
+                    break;
+                default:
+                    MlasSBGemmKernelAvx512Bf16Block<8>(APairs[0], StrideK / 2, b, CountPairsK, c + n, ldc, StoreMask, bias, ZeroMode);
+                    break;
+            }
+
+            b += StripSize;
+        }
+    }
+}
+
+template <>
+void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AVX512BF16>(size_t CountM, size_t CountN, size_t CountK, const float* A, size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode)
+{
+    constexpr size_t PackedN = MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN;
+    constexpr MLAS_SBGEMM_STRIDES Strides = MLAS_SBGEMM_KERNEL_AVX512BF16::Strides;
+
+    //
+    // The packing routine splits B into slices of Strides.K rows, the non
+    // packed driver may pass several slices when N is small.
+    //
+    const size_t AlignedN = (CountN + PackedN - 1) & ~(PackedN - 1);
+
+    size_t CountSliceK;
+    for (size_t k = 0; k < CountK; k += CountSliceK) {
+        CountSliceK = std::min(CountK - k, Strides.K);
+        const bool SliceZeroMode = ZeroMode && (k == 0);
+
+        MlasSBGemmKernelAvx512Bf16Panel(
+            CountM, CountN, CountSliceK, A + k, lda, B + AlignedN * k, C, ldc,
+            SliceZeroMode ? Bias : nullptr, SliceZeroMode
+        );
+    }
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16 = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM,
+    0  // kernel reads only inside the packed strips
+};
+
+#endif  // defined(MLAS_TARGET_AMD64)
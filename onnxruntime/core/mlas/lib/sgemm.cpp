@@ -17,6 +17,8 @@ Abstract:
 
 #include "mlasi.h"
 
+#include <vector>
+
 //
 // Define the number of rows from matrix A to transpose to a local buffer.
 //
@@ -1634,6 +1636,107 @@ MlasGemmBatch(
 #pragma warning(pop)
 #endif
 
+void
+MLASCALL
+MlasGemmGrouped(
+    const MLAS_SGEMM_GROUPED_PARAMS* Problems,
+    size_t ProblemCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a group of single precision matrix/matrix
+    multiply operations with different shapes.
+
+Arguments:
+
+    Problems - Supplies the array of multiplications.
+
+    ProblemCount - Supplies the number of multiplications.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (ProblemCount == 0) {
+        return;
+    }
+
+    //
+    // Size the segments so the whole group is spread evenly over the threads,
+    // but keep small requests on a single thread as MlasGemmBatch does.
+    //
+
+    double TotalComplexity = 0.0;
+
+    for (size_t i = 0; i < ProblemCount; i++) {
+        TotalComplexity += double(Problems[i].M) * double(Problems[i].N) * double(Problems[i].K);
+    }
+
+    const ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+    const double SegmentComplexity =
+        std::max(double(MLAS_SGEMM_THREAD_COMPLEXITY), TotalComplexity / double(MaximumThreadCount));
+
+    //
+    // Compute the number of segments of each multiplication, which are split
+    // along the larger of the M and N dimensions, and their running total.
+    //
+
+    std::vector<ptrdiff_t> SegmentEnd(ProblemCount);
+    ptrdiff_t SegmentCount = 0;
+
+    for (size_t i = 0; i < ProblemCount; i++) {
+
+        const MLAS_SGEMM_GROUPED_PARAMS& Problem = Problems[i];
+
+        ptrdiff_t Segments = 0;
+
+        if (Problem.M > 0 && Problem.N > 0) {
+
+            const double Complexity = double(Problem.M) * double(Problem.N) * double(Problem.K);
+
+            Segments = ptrdiff_t(Complexity / SegmentComplexity) + 1;
+
+            if (Segments > MaximumThreadCount) {
+                Segments = MaximumThreadCount;
+            }
+
+            const size_t MaximumSegments = (Problem.N > Problem.M)
+                ? (Problem.N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) / MLAS_SGEMM_STRIDEN_THREAD_ALIGN
+                : Problem.M;
+
+            if (size_t(Segments) > MaximumSegments) {
+                Segments = ptrdiff_t(MaximumSegments);
+            }
+        }
+
+        SegmentCount += Segments;
+        SegmentEnd[i] = SegmentCount;
+    }
+
+    MlasTrySimpleParallel(ThreadPool, SegmentCount, [&](ptrdiff_t tid) {
+
+        const size_t i = size_t(std::upper_bound(SegmentEnd.begin(), SegmentEnd.end(), tid) - SegmentEnd.begin());
+        const ptrdiff_t SegmentStart = (i == 0) ? 0 : SegmentEnd[i - 1];
+        const ptrdiff_t Segments = SegmentEnd[i] - SegmentStart;
+
+        const MLAS_SGEMM_GROUPED_PARAMS& Problem = Problems[i];
+
+        const ptrdiff_t ThreadCountM = (Problem.N > Problem.M) ? 1 : Segments;
+        const ptrdiff_t ThreadCountN = (Problem.N > Problem.M) ? Segments : 1;
+
+        MlasSgemmThreaded(ThreadCountM, ThreadCountN, Problem.TransA, Problem.TransB,
+            Problem.M, Problem.N, Problem.K, &Problem.Data, tid - SegmentStart);
+    });
+}
+
 size_t
 MLASCALL
 MlasGemmPackBSize(
@@ -0,0 +1,217 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    softmax_kernel_avx512fp16.cpp
+
+Abstract:
+
+    This module implements the fp16 softmax kernels for AVX512-FP16.
+
+    The transcendental functions are evaluated in single precision, 16
+    elements at a time, and rounded to half precision once. The remaining
+    kernels operate on 32 half precision elements at a time.
+
+--*/
+
+#include "mlasi.h"
+#include "softmax.h"
+
+#if defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+
+namespace softmax_avx512fp16 {
+
+MLAS_FORCEINLINE __mmask16
+Mask16(size_t N)
+{
+    return N >= 16 ? __mmask16(0xffff) : __mmask16((1u << N) - 1);
+}
+
+MLAS_FORCEINLINE __mmask32
+Mask32(size_t N)
+{
+    return N >= 32 ? __mmask32(~0u) : __mmask32((1u << N) - 1);
+}
+
+MLAS_FORCEINLINE __m512
+LoadFp16AsFloat(const MLAS_FP16* Source, __mmask16 Mask)
+{
+    return _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(Mask, Source));
+}
+
+MLAS_FORCEINLINE void
+StoreFloatAsFp16(MLAS_FP16* Destination, __m512 Vector, __mmask16 Mask)
+{
+    _mm256_mask_storeu_epi16(Destination, Mask, _mm512_cvtps_ph(Vector, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+}
+
+MLAS_FORCEINLINE __m512h
+LoadFp16(const MLAS_FP16* Source, __mmask32 Mask)
+{
+    return _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask, Source));
+}
+
+MLAS_FORCEINLINE void
+StoreFp16(MLAS_FP16* Destination, __m512h Vector, __mmask32 Mask)
+{
+    _mm512_mask_storeu_epi16(Destination, Mask, _mm512_castph_si512(Vector));
+}
+
+MLAS_FORCEINLINE __m512h
+BroadcastFp16(MLAS_FP16 Value)
+{
+    return _mm512_castsi512_ph(_mm512_set1_epi16(static_cast<short>(Value.val)));
+}
+
+/**
+ * @brief exp(x) in single precision: x = n * ln2 + r with |r| <= ln2 / 2,
+ *        exp(r) by a polynomial and the scaling by 2^n with VSCALEFPS.
+ */
+MLAS_FORCEINLINE __m512
+Exp(__m512 x)
+{
+    x = _mm512_max_ps(_mm512_set1_ps(-87.3365478515625f), x);
+    x = _mm512_min_ps(_mm512_set1_ps(88.72283172607421875f), x);
+
+    const __m512 n = _mm512_roundscale_ps(
+        _mm512_mul_ps(x, _mm512_set1_ps(1.44269504088896341f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC
+    );
+    __m512 r = _mm512_fmadd_ps(n, _mm512_set1_ps(-6.93145752e-1f), x);
+    r = _mm512_fmadd_ps(n, _mm512_set1_ps(-1.42860677e-6f), r);
+
+    __m512 p = _mm512_set1_ps(1.38319808e-3f);
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(8.37550033e-3f));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(4.16689515e-2f));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(1.66664466e-1f));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(4.99999851e-1f));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(1.0f));
+    p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(1.0f));
+
+    return _mm512_scalef_ps(p, n);
+}
+
+/**
+ * @brief tanh(x) = 1 - 2 / (exp(2x) + 1). Near zero the subtraction cancels,
+ *        there tanh(x) is x to half precision.
+ */
+MLAS_FORCEINLINE __m512
+Tanh(__m512 x)
+{
+    const __m512 e = Exp(_mm512_add_ps(x, x));
+    const __m512 t = _mm512_sub_ps(
+        _mm512_set1_ps(1.0f), _mm512_div_ps(_mm512_set1_ps(2.0f), _mm512_add_ps(e, _mm512_set1_ps(1.0f)))
+    );
+    const __mmask16 Small = _mm512_cmp_ps_mask(_mm512_abs_ps(x), _mm512_set1_ps(0.004f), _CMP_LT_OQ);
+    return _mm512_mask_blend_ps(Small, t, x);
+}
+
+void
+Exp_Kernel_Fp16(const MLAS_FP16* Input, MLAS_FP16* Output, size_t N)
+{
+    for (size_t n = 0; n < N; n += 16) {
+        const __mmask16 Mask = Mask16(N - n);
+        StoreFloatAsFp16(Output + n, Exp(LoadFp16AsFloat(Input + n, Mask)), Mask);
+    }
+}
+
+MLAS_FP16
+SumExp_Kernel_Fp16(const MLAS_FP16* Input, MLAS_FP16* Output, size_t N, const MLAS_FP16 NegativeMaximum)
+{
+    const __m512 Bias = _mm512_set1_ps(NegativeMaximum.ToFloat());
+    __m512 Accumulator = _mm512_setzero_ps();
+
+    for (size_t n = 0; n < N; n += 16) {
+        const __mmask16 Mask = Mask16(N - n);
+        const __m512 e = Exp(_mm512_add_ps(LoadFp16AsFloat(Input + n, Mask), Bias));
+        Accumulator = _mm512_mask_add_ps(Accumulator, Mask, Accumulator, e);
+        if (Output != nullptr) {
+            StoreFloatAsFp16(Output + n, e, Mask);
+        }
+    }
+
+    return MLAS_FP16(_mm512_reduce_add_ps(Accumulator));
+}
+
+void
+Tanh_Kernel_Fp16(const MLAS_FP16* Input, MLAS_FP16* Output, size_t N)
+{
+    for (size_t n = 0; n < N; n += 16) {
+        const __mmask16 Mask = Mask16(N - n);
+        StoreFloatAsFp16(Output + n, Tanh(LoadFp16AsFloat(Input + n, Mask)), Mask);
+    }
+}
+
+void
+Softcap_Kernel_Fp16(const MLAS_FP16* Input, MLAS_FP16* Output, size_t N, const MLAS_FP16 Softcap)
+{
+    const float SoftcapValue = Softcap.ToFloat();
+    const __m512 Cap = _mm512_set1_ps(SoftcapValue);
+    const __m512 InverseCap = _mm512_set1_ps(1.0f / SoftcapValue);
+
+    for (size_t n = 0; n < N; n += 16) {
+        const __mmask16 Mask = Mask16(N - n);
+        const __m512 x = _mm512_mul_ps(LoadFp16AsFloat(Input + n, Mask), InverseCap);
+        StoreFloatAsFp16(Output + n, _mm512_mul_ps(Tanh(x), Cap), Mask);
+    }
+}
+
+MLAS_FP16
+ReduceMax_Kernel_Fp16(const MLAS_FP16* Input, size_t N)
+{
+    const __m512i Lowest = _mm512_set1_epi16(static_cast<short>(0xfc00));  // -inf
+    __m512h Maximum = _mm512_castsi512_ph(Lowest);
+
+    for (size_t n = 0; n < N; n += 32) {
+        const __mmask32 Mask = Mask32(N - n);
+        const __m512h v = _mm512_castsi512_ph(_mm512_mask_loadu_epi16(Lowest, Mask, Input + n));
+        Maximum = _mm512_max_ph(Maximum, v);
+    }
+
+    return MLAS_FP16::FromBits(static_cast<uint16_t>(_mm_cvtsi128_si32(_mm_castph_si128(
+        _mm_set_sh(_mm512_reduce_max_ph(Maximum))
+    ))));
+}
+
+void
+Softmax_Kernel_Fp16(const MLAS_FP16* Input, MLAS_FP16* Output, size_t N, const MLAS_FP16 Sum)
+{
+    const __m512h Scale = BroadcastFp16(MLAS_FP16(1.0f / Sum.ToFloat()));
+
+    for (size_t n = 0; n < N; n += 32) {
+        const __mmask32 Mask = Mask32(N - n);
+        StoreFp16(Output + n, _mm512_mul_ph(LoadFp16(Input + n, Mask), Scale), Mask);
+    }
+}
+
+void
+LogSoftmax_Kernel_Fp16(const MLAS_FP16* Input, MLAS_FP16* Output, size_t N, const MLAS_FP16 NegativeMaximum, const MLAS_FP16 LogSum)
+{
+    const __m512h Bias = BroadcastFp16(NegativeMaximum);
+    const __m512h LogSumBroadcast = BroadcastFp16(LogSum);
+
+    for (size_t n = 0; n < N; n += 32) {
+        const __mmask32 Mask = Mask32(N - n);
+        const __m512h v = _mm512_add_ph(LoadFp16(Input + n, Mask), Bias);
+        StoreFp16(Output + n, _mm512_sub_ph(v, LogSumBroadcast), Mask);
+    }
+}
+
+}  // namespace softmax_avx512fp16
+
+const MLAS_SOFTMAX_DISPATCH MlasSoftmaxDispatchAvx512Fp16 = []() {
+    MLAS_SOFTMAX_DISPATCH d;
+    d.Tanh_Fp16 = softmax_avx512fp16::Tanh_Kernel_Fp16;
+    d.Softcap_Fp16 = softmax_avx512fp16::Softcap_Kernel_Fp16;
+    d.Exp_Fp16 = softmax_avx512fp16::Exp_Kernel_Fp16;
+    d.ReduceMax_Fp16 = softmax_avx512fp16::ReduceMax_Kernel_Fp16;
+    d.SumExp_Fp16 = softmax_avx512fp16::SumExp_Kernel_Fp16;
+    d.Softmax_Fp16 = softmax_avx512fp16::Softmax_Kernel_Fp16;
+    d.LogSoftmax_Fp16 = softmax_avx512fp16::LogSoftmax_Kernel_Fp16;
+    return d;
+}();
+
+#endif  // defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
@@ -0,0 +1,178 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparse_gemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) with a sparse matrix B, compressed by column.
+
+    A tile of rows of matrix A is transposed to a buffer, so that each
+    non-zero element B[k, n] updates the column n of the tile of matrix C with
+    vector multiply-adds of the row k of the buffer. The work is proportional
+    to the number of non-zero elements of matrix B, whatever their pattern, so
+    both unstructured and structured (e.g. 2:4) pruned weights benefit.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of rows of matrix A in a tile, as two vectors of 4 elements.
+//
+
+constexpr size_t MLAS_SPARSE_GEMM_TILE_M = 8;
+
+MLAS_FORCEINLINE
+void
+MlasSparseGemmPackATile(
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t K,
+    float* PackedA
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a tile of rows of matrix A to a buffer of K rows of
+    MLAS_SPARSE_GEMM_TILE_M elements, padding the rows past CountM with zeros.
+
+--*/
+{
+    for (size_t k = 0; k < K; k++) {
+        for (size_t m = 0; m < MLAS_SPARSE_GEMM_TILE_M; m++) {
+            PackedA[m] = m < CountM ? A[m * lda + k] : 0.0f;
+        }
+        PackedA += MLAS_SPARSE_GEMM_TILE_M;
+    }
+}
+
+void
+MlasSparseGemmKernel(
+    const MLAS_SGEMM_SPARSE_B* B,
+    const float* PackedA,
+    size_t CountM,
+    size_t StartN,
+    size_t CountN,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the columns [StartN, StartN + CountN) of a tile of
+    CountM rows of matrix C.
+
+--*/
+{
+    float Accumulators[MLAS_SPARSE_GEMM_TILE_M];
+
+    for (size_t n = StartN; n < StartN + CountN; n++) {
+        MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+
+        for (uint32_t i = B->ColumnStart[n]; i < B->ColumnStart[n + 1]; i++) {
+            const float* a = PackedA + size_t{B->RowIndices[i]} * MLAS_SPARSE_GEMM_TILE_M;
+            MLAS_FLOAT32X4 Value = MlasBroadcastFloat32x4(B->Values + i);
+
+            Accumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(a), Value, Accumulator0);
+            Accumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(a + 4), Value, Accumulator1);
+        }
+
+        MlasStoreFloat32x4(Accumulators, Accumulator0);
+        MlasStoreFloat32x4(Accumulators + 4, Accumulator1);
+
+        for (size_t m = 0; m < CountM; m++) {
+            C[m * ldc + n] = Accumulators[m];
+        }
+    }
+}
+
+void
+MLASCALL
+MlasSparseGemm(
+    size_t M,
+    const MLAS_SGEMM_SPARSE_B* B,
+    const float* A,
+    size_t lda,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation C = A * B, with B sparse.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    B - Supplies the sparse matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t K = B->K;
+    const size_t N = B->N;
+
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    //
+    // Each thread transposes the tiles of matrix A it works on, so the columns
+    // of matrix C are only split between threads when there are fewer tiles
+    // than threads.
+    //
+
+    const size_t TileCountM = (M + MLAS_SPARSE_GEMM_TILE_M - 1) / MLAS_SPARSE_GEMM_TILE_M;
+    const size_t TargetThreadCount = static_cast<size_t>(MlasGetMaximumThreadCount(ThreadPool));
+    const size_t BlockCountN =
+        std::min(N, std::max<size_t>(1, (TargetThreadCount + TileCountM - 1) / TileCountM));
+    const size_t BlockSizeN = (N + BlockCountN - 1) / BlockCountN;
+
+    MlasTrySimpleParallel(ThreadPool, static_cast<ptrdiff_t>(TileCountM * BlockCountN), [&](ptrdiff_t tid) {
+        const size_t TileM = static_cast<size_t>(tid) / BlockCountN;
+        const size_t BlockN = static_cast<size_t>(tid) % BlockCountN;
+
+        const size_t StartM = TileM * MLAS_SPARSE_GEMM_TILE_M;
+        const size_t CountM = std::min(M - StartM, MLAS_SPARSE_GEMM_TILE_M);
+        const size_t StartN = BlockN * BlockSizeN;
+        if (StartN >= N) {
+            return;
+        }
+        const size_t CountN = std::min(N - StartN, BlockSizeN);
+
+        MlasThreadedBufAlloc(UpAlignSize(K * MLAS_SPARSE_GEMM_TILE_M * sizeof(float)));
+        float* PackedA = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+        MlasSparseGemmPackATile(A + StartM * lda, lda, CountM, K, PackedA);
+        MlasSparseGemmKernel(B, PackedA, CountM, StartN, CountN, C + StartM * ldc, ldc);
+    });
+}
@@ -0,0 +1,440 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the quantized 4-bit integer matrix
+    multiplication kernels with int8 activations (accuracy level 4)
+    for x64 amx-int8.
+
+    The B data is packed in the order of AMX B tiles so a tile is
+    unpacked with a mask and a shift. Each block of K is accumulated
+    in int32 tiles and scaled into float accumulators.
+
+--*/
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "qnbitgemm.h"
+#include "amx_common.h"
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+#define TMM5 5
+#define TMM6 6
+#define TMM7 7
+
+namespace
+{
+
+constexpr size_t TileM = 16;
+constexpr size_t TileN = 16;
+
+// Row tiles are 16 rows, so a small M is faster with avx512vnni on the unpacked tiles.
+constexpr size_t AmxMinCountM = 8;
+
+// K of a B tile. A tile row is 4 k values of each of 16 columns and a tile has at most 16 rows.
+MLAS_FORCEINLINE size_t
+AmxSubBlkLen(size_t BlkLen)
+{
+    return std::min(BlkLen, size_t{64});
+}
+
+//
+// The packed data of a column tile, 16 columns or fewer for the last one, is a chunk for each SubBlkLen of K.
+// A chunk is the unsigned values in the order of an AMX B tile, with the first half of them in the low nibbles
+// and the second half in the high nibbles. The packed data is the same size as the source data.
+//
+void
+PackQuantBAmx(
+    const std::byte* QuantBDataBegin,
+    std::byte* PackedQuantBDataBegin,
+    MLAS_THREADPOOL* ThreadPool,
+    const size_t N,
+    const size_t BlockCountK,
+    const size_t BlkLen
+)
+{
+    const size_t SubBlkLen = AmxSubBlkLen(BlkLen);
+    const size_t ldb = BlockCountK * MlasQNBitBlkDataSizeInBytes(4, BlkLen);
+    const size_t SubBlkCountK = BlockCountK * BlkLen / SubBlkLen;
+    const size_t TileCountN = MlasDivRoundup(N, TileN);
+
+    MlasTrySimpleParallel(ThreadPool, TileCountN * SubBlkCountK, [&](ptrdiff_t tid) {
+        const size_t n_start = (tid / SubBlkCountK) * TileN;
+        const size_t k_subblk = tid % SubBlkCountK;
+        const size_t CountN = std::min(N - n_start, TileN);
+        const size_t Half = SubBlkLen * CountN / 2;
+
+        const std::byte* src = QuantBDataBegin + n_start * ldb + k_subblk * SubBlkLen / 2;
+        std::byte* dst = PackedQuantBDataBegin + n_start * ldb + k_subblk * Half;
+
+        for (size_t j = 0; j < 2 * Half; ++j) {
+            const size_t n = (j / 4) % CountN;
+            const size_t k = (j / (CountN * 4)) * 4 + j % 4;
+            const uint8_t v = (static_cast<uint8_t>(src[n * ldb + k / 2]) >> ((k & 1) * 4)) & 0x0F;
+            if (j < Half) {
+                dst[j] = std::byte{v};
+            } else {
+                dst[j - Half] |= std::byte(v << 4);
+            }
+        }
+    });
+}
+
+// The scales keep the source order, BlockSum is the width 16 row major matrix of the other kernels.
+void
+ComputePackBlkSumAmx(
+    size_t N,
+    size_t BlockCountK,
+    const float* QuantBScaleBegin,
+    const std::byte* QuantBZPBegin,
+    float* BlockSumBegin,
+    MLAS_THREADPOOL* ThreadPool
+)
+{
+    MlasTrySimpleParallel(ThreadPool, N * BlockCountK, [&](ptrdiff_t tid) {
+        const size_t n = tid / BlockCountK;
+        const size_t k_blk = tid % BlockCountK;
+
+        uint8_t zp = 8;
+        if (QuantBZPBegin) {
+            const std::byte QuantBZP = QuantBZPBegin[MlasDivRoundup(BlockCountK, 2) * n + k_blk / 2];
+            zp = static_cast<uint8_t>(k_blk % 2 == 0 ? (QuantBZP & std::byte{0x0F}) : (QuantBZP >> 4));
+        }
+
+        const size_t dst_offset = ((n / 16) * BlockCountK + k_blk) * 16 + n % 16;
+        BlockSumBegin[dst_offset] = -QuantBScaleBegin[n * BlockCountK + k_blk] * zp;
+    });
+}
+
+//
+// Unpacks a column tile to the B tiles of all of K, SubBlkLen / 4 rows of 64 bytes for each chunk, with zeros
+// for the columns past CountN.
+//
+void
+UnpackColumnTile(
+    const std::byte* PackedTile,
+    size_t CountN,
+    size_t SubBlkCountK,
+    size_t SubBlkLen,
+    uint8_t* Tile
+)
+{
+    const size_t TileBytes = SubBlkLen * TileN;
+
+    if (CountN == TileN) {
+        const size_t Half = TileBytes / 2;
+        const __m512i LowMask = _mm512_set1_epi8(0x0F);
+        for (size_t c = 0; c < SubBlkCountK; ++c) {
+            const std::byte* src = PackedTile + c * Half;
+            uint8_t* dst = Tile + c * TileBytes;
+            for (size_t i = 0; i < Half; i += 64) {
+                const __m512i bytes = _mm512_loadu_si512(src + i);
+                _mm512_storeu_si512(dst + i, _mm512_and_si512(bytes, LowMask));
+                _mm512_storeu_si512(dst + Half + i, _mm512_and_si512(_mm512_srli_epi16(bytes, 4), LowMask));
+            }
+        }
+        return;
+    }
+
+    std::memset(Tile, 0, TileBytes * SubBlkCountK);
+    const size_t Half = SubBlkLen * CountN / 2;
+    for (size_t c = 0; c < SubBlkCountK; ++c) {
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(PackedTile) + c * Half;
+        uint8_t* dst = Tile + c * TileBytes;
+        for (size_t j = 0; j < 2 * Half; ++j) {
+            const uint8_t v = j < Half ? (src[j] & 0x0F) : (src[j - Half] >> 4);
+            dst[(j / (CountN * 4)) * 64 + j % (CountN * 4)] = v;
+        }
+    }
+}
+
+//
+// Computes 32 rows by 32 columns, two row tiles of A by two column tiles of B, into Acc.
+//
+void
+GemmTilesAmx(
+    const int8_t* A,
+    size_t lda,
+    const float* AScale,
+    size_t CountM,
+    const uint8_t* BTile0,
+    const uint8_t* BTile1,
+    const float* BScaleT,
+    size_t BlockCountK,
+    size_t BlkLen,
+    size_t SubBlkLen,
+    float* Acc
+)
+{
+    alignas(64) static const int32_t ZeroTile[TileM * TileN] = {};
+    alignas(64) int32_t TileC[4][TileM * TileN];
+
+    std::fill_n(Acc, 2 * TileM * 2 * TileN, 0.0f);
+
+    for (size_t blk = 0; blk < BlockCountK; ++blk) {
+        tile_loadd(TMM4, ZeroTile, TileN * sizeof(int32_t));
+        tile_loadd(TMM5, ZeroTile, TileN * sizeof(int32_t));
+        tile_loadd(TMM6, ZeroTile, TileN * sizeof(int32_t));
+        tile_loadd(TMM7, ZeroTile, TileN * sizeof(int32_t));
+
+        for (size_t k = blk * BlkLen; k < (blk + 1) * BlkLen; k += SubBlkLen) {
+            tile_loadd(TMM2, A + k, lda);
+            tile_loadd(TMM3, A + TileM * lda + k, lda);
+            tile_loadd(TMM0, BTile0 + k * TileN, 64);
+            tile_loadd(TMM1, BTile1 + k * TileN, 64);
+            tile_dpbsud(TMM4, TMM2, TMM0);
+            tile_dpbsud(TMM5, TMM2, TMM1);
+            tile_dpbsud(TMM6, TMM3, TMM0);
+            tile_dpbsud(TMM7, TMM3, TMM1);
+        }
+
+        tile_stored(TMM4, TileC[0], TileN * sizeof(int32_t));
+        tile_stored(TMM5, TileC[1], TileN * sizeof(int32_t));
+        tile_stored(TMM6, TileC[2], TileN * sizeof(int32_t));
+        tile_stored(TMM7, TileC[3], TileN * sizeof(int32_t));
+
+        const __m512 scale_b0 = _mm512_loadu_ps(BScaleT + blk * 2 * TileN);
+        const __m512 scale_b1 = _mm512_loadu_ps(BScaleT + blk * 2 * TileN + TileN);
+        for (size_t m = 0; m < CountM; ++m) {
+            const __m512 scale_a = _mm512_set1_ps(AScale[m * BlockCountK + blk]);
+            const int32_t* c = TileC[(m / TileM) * 2] + (m % TileM) * TileN;
+            float* acc = Acc + m * 2 * TileN;
+            _mm512_storeu_ps(acc, _mm512_fmadd_ps(_mm512_cvtepi32_ps(_mm512_load_si512(c)),
+                                                  _mm512_mul_ps(scale_a, scale_b0), _mm512_loadu_ps(acc)));
+            _mm512_storeu_ps(acc + TileN, _mm512_fmadd_ps(_mm512_cvtepi32_ps(_mm512_load_si512(c + TileM * TileN)),
+                                                          _mm512_mul_ps(scale_a, scale_b1),
+                                                          _mm512_loadu_ps(acc + TileN)));
+        }
+    }
+}
+
+//
+// Computes a row of A by a column tile of B with vpdpbusd.
+//
+MLAS_FORCEINLINE __m512
+GemmRowVnni(
+    const int8_t* a,
+    const float* AScale,
+    const uint8_t* BTile,
+    const float* BScaleT,
+    size_t BlockCountK,
+    size_t BlkLen
+)
+{
+    __m512 acc = _mm512_setzero_ps();
+    for (size_t blk = 0; blk < BlockCountK; ++blk) {
+        __m512i sum = _mm512_setzero_si512();
+        for (size_t k = blk * BlkLen; k < (blk + 1) * BlkLen; k += 4) {
+            int32_t a4;
+            std::memcpy(&a4, a + k, sizeof(a4));
+            sum = _mm512_dpbusd_epi32(sum, _mm512_loadu_si512(BTile + k * TileN), _mm512_set1_epi32(a4));
+        }
+        const __m512 scale = _mm512_mul_ps(_mm512_set1_ps(AScale[blk]), _mm512_loadu_ps(BScaleT + blk * 2 * TileN));
+        acc = _mm512_fmadd_ps(_mm512_cvtepi32_ps(sum), scale, acc);
+    }
+    return acc;
+}
+
+MLAS_FORCEINLINE void
+StoreRow(const float* acc, const float* Bias, size_t CountN, float* c)
+{
+    for (size_t n = 0; n < CountN; n += TileN) {
+        const __mmask16 mask = static_cast<__mmask16>(0xFFFF >> (TileN - std::min(CountN - n, TileN)));
+        __m512 v = _mm512_maskz_loadu_ps(mask, acc + n);
+        if (Bias != nullptr) {
+            v = _mm512_add_ps(v, _mm512_maskz_loadu_ps(mask, Bias + n));
+        }
+        _mm512_mask_storeu_ps(c + n, mask, v);
+    }
+}
+
+}  // namespace
+
+static size_t
+SQ4BitGemmKernel_BlkSum_CompInt8_amx(
+    const size_t BlkLen,
+    const std::byte* QuantA,
+    const float* QuantAScale,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* /*QuantBZeroPoint*/,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t /*CountK*/,
+    size_t BlockCountK,
+    const float* Bias,
+    size_t ldc,
+    const float* ABlockSum,
+    const float* QuantBBlkSum
+)
+{
+    const size_t SubBlkLen = AmxSubBlkLen(BlkLen);
+    const size_t lda = BlockCountK * BlkLen;
+    const size_t ldb = BlockCountK * MlasQNBitBlkDataSizeInBytes(4, BlkLen);
+    const size_t SubBlkCountK = lda / SubBlkLen;
+    const bool UseAmx = CountM >= AmxMinCountM;
+
+    //
+    // The buffer holds two unpacked column tiles, their scales by block and, for amx, a zero padded copy of the
+    // last rows of A.
+    //
+    const size_t BTileSize = lda * TileN;
+    const size_t BScaleSize = BlockCountK * 2 * TileN * sizeof(float);
+    const size_t APadSize = UseAmx ? 2 * TileM * lda : 0;
+    MlasThreadedBufAlloc(2 * BTileSize + BScaleSize + APadSize);
+    uint8_t* BTile0 = ThreadedBufHolder.get();
+    uint8_t* BTile1 = BTile0 + BTileSize;
+    float* BScaleT = reinterpret_cast<float*>(BTile1 + BTileSize);
+    int8_t* APad = reinterpret_cast<int8_t*>(BTile1 + BTileSize + BScaleSize);
+
+    if (UseAmx) {
+        tileconfig_t tc;
+        tc.palette_id = 1;
+        for (int t = 0; t < 2; t++) {
+            tc.rows[t] = static_cast<uint8_t>(SubBlkLen / 4);
+            tc.colb[t] = 64;
+        }
+        for (int t = 2; t < 4; t++) {
+            tc.rows[t] = TileM;
+            tc.colb[t] = static_cast<uint16_t>(SubBlkLen);
+        }
+        for (int t = 4; t < 8; t++) {
+            tc.rows[t] = TileM;
+            tc.colb[t] = TileN * sizeof(int32_t);
+        }
+        tile_loadconfig(&tc);
+    }
+
+    for (size_t n = 0; n < CountN; n += 2 * TileN) {
+        const size_t CountN0 = std::min(CountN - n, TileN);
+        const size_t CountN1 = CountN - n > TileN ? std::min(CountN - n - TileN, TileN) : 0;
+        const size_t CountNBlk = CountN0 + CountN1;
+
+        UnpackColumnTile(QuantBData + n * ldb, CountN0, SubBlkCountK, SubBlkLen, BTile0);
+        UnpackColumnTile(CountN1 > 0 ? QuantBData + (n + TileN) * ldb : nullptr, CountN1, SubBlkCountK, SubBlkLen,
+                         BTile1);
+        for (size_t blk = 0; blk < BlockCountK; ++blk) {
+            for (size_t j = 0; j < 2 * TileN; ++j) {
+                BScaleT[blk * 2 * TileN + j] = j < CountNBlk ? QuantBScale[(n + j) * BlockCountK + blk] : 0.0f;
+            }
+        }
+
+        const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
+
+        if (UseAmx) {
+            alignas(64) float Acc[2 * TileM * 2 * TileN];
+            for (size_t m = 0; m < CountM; m += 2 * TileM) {
+                const size_t CountMBlk = std::min(CountM - m, 2 * TileM);
+                const int8_t* a = reinterpret_cast<const int8_t*>(QuantA) + m * lda;
+                if (CountMBlk < 2 * TileM) {
+                    std::memcpy(APad, a, CountMBlk * lda);
+                    std::memset(APad + CountMBlk * lda, 0, (2 * TileM - CountMBlk) * lda);
+                    a = APad;
+                }
+
+                GemmTilesAmx(a, lda, QuantAScale + m * BlockCountK, CountMBlk, BTile0, BTile1, BScaleT,
+                             BlockCountK, BlkLen, SubBlkLen, Acc);
+
+                for (size_t i = 0; i < CountMBlk; ++i) {
+                    StoreRow(Acc + i * 2 * TileN, bias, CountNBlk, C + (m + i) * ldc + n);
+                }
+            }
+        } else {
+            alignas(64) float Acc[2 * TileN];
+            for (size_t m = 0; m < CountM; ++m) {
+                const int8_t* a = reinterpret_cast<const int8_t*>(QuantA) + m * lda;
+                const float* a_scale = QuantAScale + m * BlockCountK;
+                _mm512_store_ps(Acc, GemmRowVnni(a, a_scale, BTile0, BScaleT, BlockCountK, BlkLen));
+                if (CountN1 > 0) {
+                    _mm512_store_ps(Acc + TileN,
+                                    GemmRowVnni(a, a_scale, BTile1, BScaleT + TileN, BlockCountK, BlkLen));
+                }
+                StoreRow(Acc, bias, CountNBlk, C + m * ldc + n);
+            }
+        }
+    }
+
+    float* c_blk = C;
+    const float* b_blk_sum = QuantBBlkSum;
+
+    size_t RowsRemaining = CountM;
+    const float* a_blksum_row = ABlockSum;
+    while (RowsRemaining > 0) {
+        auto RowsHandled = GetMlasPlatform().GemmFloatKernel(
+            a_blksum_row, b_blk_sum, c_blk, BlockCountK, RowsRemaining, CountN, BlockCountK, ldc, 1.f, false
+        );
+
+        c_blk += ldc * RowsHandled;
+        a_blksum_row += BlockCountK * RowsHandled;
+        RowsRemaining -= RowsHandled;
+    }
+    return CountM;
+}
+
+static void
+SQ4BitGemmPackQuantBDataAndBlkSumAmx(
+    size_t N,
+    size_t K,
+    size_t BlkLen,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE /*ComputeType*/,
+    const std::byte* QuantBDataBegin,
+    const float* QuantBScaleBegin,
+    bool HasZeroPoint,
+    const std::byte* QuantBZPBegin,
+    PackedQuantBDataStruct<float, 4>& PackedQuantB,
+    MLAS_THREADPOOL* ThreadPool
+)
+{
+    assert(BlkLen >= 16 && BlkLen % 16 == 0);
+
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+
+    if (QuantBDataBegin) {
+        PackQuantBAmx(QuantBDataBegin, PackedQuantB.PackedQuantBData, ThreadPool, N, BlockCountK, BlkLen);
+    }
+
+    if (QuantBScaleBegin) {
+        std::copy(QuantBScaleBegin, QuantBScaleBegin + N * BlockCountK, PackedQuantB.PackedQuantBScale);
+    }
+
+    if ((QuantBScaleBegin && !HasZeroPoint) || QuantBZPBegin) {
+        ComputePackBlkSumAmx(N, BlockCountK, PackedQuantB.PackedQuantBScale, QuantBZPBegin,
+                             PackedQuantB.QuantBBlkSum, ThreadPool);
+    }
+}
+
+//
+// Kernel dispatch structure definition.
+//
+// The packed layout and the kernel of 4-bit B with int8 activations replace those of avx512vnni, which provides
+// the other entries. The copy is made on first use as the avx512vnni structure is defined in another module.
+//
+const MLAS_QNBIT_GEMM_DISPATCH&
+GetMlasQNBitGemmDispatchAmx()
+{
+    static const MLAS_QNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAmx = []() {
+        MLAS_QNBIT_GEMM_DISPATCH d = MlasSQNBitGemmDispatchAvx512vnni;
+
+        d.SQ4BitGemmPackQuantBDataAndBlkSum = SQ4BitGemmPackQuantBDataAndBlkSumAmx;
+        d.SQ4BitGemmKernel_BlkSum_CompInt8 = SQ4BitGemmKernel_BlkSum_CompInt8_amx;
+
+        return d;
+    }();
+
+    return MlasSQNBitGemmDispatchAmx;
+}
@@ -0,0 +1,254 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/autocast_transformer.h"
+
+#include <sstream>
+
+#include "core/framework/data_types.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// the ops converted when no allow list is given. their cost is dominated by multiply-accumulates, which the lower
+// precision kernels run at a multiple of the float throughput.
+const InlinedHashSet<std::string_view>& DefaultAllowOps() {
+  static const InlinedHashSet<std::string_view> ops{
+      "MatMul", "Gemm", "Conv", "ConvTranspose", "FusedMatMul", "Attention", "MultiHeadAttention"};
+  return ops;
+}
+
+// ops whose accumulations or statistics lose too much in 16 bits. never converted.
+const InlinedHashSet<std::string_view>& SensitiveOps() {
+  static const InlinedHashSet<std::string_view> ops{
+      "Softmax", "LogSoftmax", "LayerNormalization", "SkipLayerNormalization", "SimplifiedLayerNormalization",
+      "SkipSimplifiedLayerNormalization", "BatchNormalization", "InstanceNormalization", "GroupNormalization",
+      "ReduceSum", "ReduceMean", "ReduceSumSquare", "ReduceL2", "ReduceLogSumExp", "Exp", "Log", "Pow"};
+  return ops;
+}
+
+bool IsFloatTensor(const NodeArg& node_arg) {
+  const TypeProto* type = node_arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+MLDataType TensorTypeOf(int32_t elem_type) {
+  return elem_type == TensorProto_DataType_FLOAT16 ? DataTypeImpl::GetTensorType<MLFloat16>()
+         : elem_type == TensorProto_DataType_BFLOAT16 ? DataTypeImpl::GetTensorType<BFloat16>()
+                                                       : DataTypeImpl::GetTensorType<float>();
+}
+
+// the type of node_arg with the element type replaced, keeping the shape
+TypeProto WithElemType(const NodeArg& node_arg, int32_t elem_type) {
+  TypeProto type = *node_arg.TypeAsProto();
+  type.mutable_tensor_type()->set_elem_type(elem_type);
+  return type;
+}
+
+NodeArg& AddCast(Graph& graph, NodeArg& input, NodeArg& output, int32_t to, const std::string& provider_type) {
+  const std::string node_name = graph.GenerateNodeName("AutocastCast_" + input.Name());
+  Node& cast_node = graph.AddNode(node_name, "Cast", "cast inserted by autocast", {&input}, {&output});
+  cast_node.AddAttribute("to", static_cast<int64_t>(to));
+  cast_node.SetExecutionProviderType(provider_type);
+  return output;
+}
+
+}  // namespace
+
+AutocastTransformer::AutocastTransformer(int32_t target_type, InlinedHashSet<std::string> allow_ops,
+                                         InlinedHashSet<std::string> deny_list,
+                                         const KernelRegistryManager& kernel_registry_manager)
+    : GraphTransformer("AutocastTransformer"),
+      target_type_(target_type),
+      allow_ops_(std::move(allow_ops)),
+      deny_list_(std::move(deny_list)),
+      kernel_registry_manager_(kernel_registry_manager) {
+  ORT_ENFORCE(target_type_ == TensorProto_DataType_FLOAT16 || target_type_ == TensorProto_DataType_BFLOAT16,
+              "Autocast only converts to float16 or bfloat16.");
+}
+
+InlinedHashSet<std::string> AutocastTransformer::ParseList(const std::string& list) {
+  InlinedHashSet<std::string> entries;
+  std::istringstream ss(list);
+  std::string entry;
+  while (std::getline(ss, entry, ',')) {
+    if (!entry.empty()) {
+      entries.insert(entry);
+    }
+  }
+  return entries;
+}
+
+bool AutocastTransformer::HasKernel(const Node& node, const std::string& op_type, int since_version,
+                                    const KernelRegistry::TypeConstraintMap& type_constraints,
+                                    const logging::Logger& logger) const {
+  const std::string& provider_type = node.GetExecutionProviderType();
+  const std::string& domain = op_type == node.OpType() ? node.Domain() : kOnnxDomain;
+  for (const KernelRegistry* registry : kernel_registry_manager_.GetKernelRegistriesByProviderType(provider_type)) {
+    const KernelCreateInfo* kernel_create_info = nullptr;
+    if (registry->TryFindKernel(provider_type, op_type, domain, since_version, type_constraints, logger,
+                                &kernel_create_info)
+            .IsOK() &&
+        kernel_create_info != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AutocastTransformer::IsCandidate(const Node& node) const {
+  const std::string& op_type = node.OpType();
+  const bool allowed = allow_ops_.empty() ? DefaultAllowOps().count(op_type) > 0 : allow_ops_.count(op_type) > 0;
+  return allowed &&
+         SensitiveOps().count(op_type) == 0 &&
+         deny_list_.count(op_type) == 0 &&
+         deny_list_.count(node.Name()) == 0 &&
+         (node.Domain() == kOnnxDomain || node.Domain() == kMSDomain) &&
+         !node.GetExecutionProviderType().empty() &&
+         !node.ContainsSubgraph() &&
+         node.Op() != nullptr;
+}
+
+Status AutocastTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                      const logging::Logger& logger) const {
+  const auto& domain_to_version = graph.DomainToVersionMap();
+  const auto onnx_opset = domain_to_version.find(kOnnxDomain);
+  if (onnx_opset == domain_to_version.end()) {
+    return Status::OK();
+  }
+  const int cast_since_version = onnx_opset->second;
+  const MLDataType float_type = DataTypeImpl::GetTensorType<float>();
+  const MLDataType target_type = TensorTypeOf(target_type_);
+  const KernelRegistry::TypeConstraintMap cast_down{{"T1", float_type}, {"T2", target_type}};
+  const KernelRegistry::TypeConstraintMap cast_up{{"T1", target_type}, {"T2", float_type}};
+
+  // the lower precision version of the float inputs converted so far, shared by their consumers
+  InlinedHashMap<const NodeArg*, NodeArg*> converted_inputs;
+
+  GraphViewer graph_viewer(graph);
+  for (NodeIndex i : graph_viewer.GetNodesInTopologicalOrder()) {
+    Node* node = graph.GetNode(i);
+    if (!node) {
+      continue;
+    }
+
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (!IsCandidate(*node)) {
+      continue;
+    }
+
+    // find the float inputs and outputs, and the type constraints they bind
+    const auto& type_schema = node->Op()->typeConstraintMap();
+    KernelRegistry::TypeConstraintMap type_constraints;
+    InlinedVector<size_t> float_inputs;
+    InlinedVector<size_t> float_outputs;
+    bool mixed_types = false;
+
+    const auto& input_arg_counts = node->InputArgCount();
+    const auto& input_defs = node->InputDefs();
+    const auto& formal_inputs = node->Op()->inputs();
+    const size_t num_formal_inputs = std::min(formal_inputs.size(), input_arg_counts.size());
+    size_t input_idx = 0;
+    for (size_t formal_idx = 0; formal_idx < num_formal_inputs; ++formal_idx) {
+      const auto& type_str = formal_inputs[formal_idx].GetTypeStr();
+      const bool constrained = type_schema.find(type_str) != type_schema.end();
+      for (int j = 0; j < input_arg_counts[formal_idx]; ++j, ++input_idx) {
+        const NodeArg* input_def = input_defs[input_idx];
+        if (!constrained || input_def == nullptr || !input_def->Exists()) {
+          continue;
+        }
+        if (IsFloatTensor(*input_def)) {
+          float_inputs.push_back(input_idx);
+          type_constraints[type_str] = target_type;
+        } else if (type_constraints.count(type_str) > 0) {
+          mixed_types = true;
+        }
+      }
+    }
+
+    const auto& output_defs = node->OutputDefs();
+    const auto& formal_outputs = node->Op()->outputs();
+    const size_t num_outputs = std::min(formal_outputs.size(), output_defs.size());
+    for (size_t idx = 0; idx < num_outputs; ++idx) {
+      const auto& type_str = formal_outputs[idx].GetTypeStr();
+      const NodeArg* output_def = output_defs[idx];
+      if (type_schema.find(type_str) == type_schema.end() || output_def == nullptr || !output_def->Exists()) {
+        continue;
+      }
+      if (IsFloatTensor(*output_def)) {
+        // an output constraint no input binds, e.g. a float output of integer inputs, stays in float
+        if (type_constraints.count(type_str) == 0) {
+          mixed_types = true;
+          break;
+        }
+        float_outputs.push_back(idx);
+      }
+    }
+
+    if (float_inputs.empty() || mixed_types) {
+      continue;
+    }
+
+    // the execution provider registers the lower precision kernels only where they are fast
+    if (!HasKernel(*node, node->OpType(), node->SinceVersion(), type_constraints, logger) ||
+        !HasKernel(*node, "Cast", cast_since_version, cast_down, logger) ||
+        !HasKernel(*node, "Cast", cast_since_version, cast_up, logger)) {
+      LOGS(logger, VERBOSE) << "Autocast: keeping " << node->OpType() << " node " << node->Name()
+                            << " in float as " << node->GetExecutionProviderType()
+                            << " has no lower precision kernel for it.";
+      continue;
+    }
+
+    const std::string& provider_type = node->GetExecutionProviderType();
+    std::map<const NodeArg*, NodeArg*> replacement_defs;
+    for (size_t idx : float_inputs) {
+      NodeArg* input = node->MutableInputDefs()[idx];
+      auto converted = converted_inputs.find(input);
+      if (converted != converted_inputs.end()) {
+        replacement_defs[input] = converted->second;
+        continue;
+      }
+
+      NodeArg* new_input = nullptr;
+      const std::string new_name = graph.GenerateNodeArgName(input->Name() + "_autocast");
+      if (const TensorProto* initializer = graph_utils::GetConstantInitializer(graph, input->Name(), false)) {
+        // constant weights are converted once instead of on every run
+        Initializer float_initializer{graph, *initializer, graph.ModelPath()};
+        const TensorProto converted_initializer = target_type_ == TensorProto_DataType_FLOAT16
+                                                      ? float_initializer.ToFP16(new_name)
+                                                      : float_initializer.ToBFloat16(new_name);
+        new_input = &graph_utils::AddInitializerWithExternalData(graph, converted_initializer);
+      } else {
+        TypeProto new_type = WithElemType(*input, target_type_);
+        new_input = &AddCast(graph, *input, graph.GetOrCreateNodeArg(new_name, &new_type), target_type_,
+                             provider_type);
+      }
+
+      converted_inputs[input] = new_input;
+      replacement_defs[input] = new_input;
+    }
+
+    for (size_t idx : float_outputs) {
+      NodeArg* output = node->MutableOutputDefs()[idx];
+      TypeProto new_type = WithElemType(*output, target_type_);
+      NodeArg& new_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output->Name() + "_autocast"),
+                                                     &new_type);
+      AddCast(graph, new_output, *output, TensorProto_DataType_FLOAT, provider_type);
+      replacement_defs[output] = &new_output;
+    }
+
+    node->ReplaceDefs(replacement_defs);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/kernel_registry_manager.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class AutocastTransformer
+
+Runs the compute heavy float nodes (MatMul, Gemm, Conv, Attention, ...) in float16 or bfloat16 where the execution
+provider the node is assigned to has a kernel for the lower precision, which it only registers on hardware with a fast
+path for it. Float inputs are cast to the lower precision, or converted once if they are constant initializers, and
+the outputs are cast back to float. The other nodes stay in float, and the numerically sensitive ones (Softmax,
+normalizations, reductions) are never converted, even if they are in the allow list.
+
+It runs after partitioning, right before InsertCastTransformer, whose duplicate Cast removal drops the pairs of
+Cast nodes between two converted nodes, so a chain of converted nodes only has Cast nodes at its ends.
+*/
+class AutocastTransformer : public GraphTransformer {
+ public:
+  /**
+   * @param target_type the lower precision, TensorProto_DataType_FLOAT16 or TensorProto_DataType_BFLOAT16.
+   * @param allow_ops the op types to convert. If empty, a default list of compute heavy ops.
+   * @param deny_list op types or node names never converted.
+   * @param kernel_registry_manager used to check that the execution provider has the lower precision kernels.
+   */
+  AutocastTransformer(int32_t target_type, InlinedHashSet<std::string> allow_ops, InlinedHashSet<std::string> deny_list,
+                      const KernelRegistryManager& kernel_registry_manager);
+
+  // Parses a comma separated list of op types or node names.
+  static InlinedHashSet<std::string> ParseList(const std::string& list);
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  // Whether the op type and the assignment of the node allow converting it. The types are checked later.
+  bool IsCandidate(const Node& node) const;
+
+  bool HasKernel(const Node& node, const std::string& op_type, int since_version,
+                 const KernelRegistry::TypeConstraintMap& type_constraints, const logging::Logger& logger) const;
+
+  const int32_t target_type_;
+  const InlinedHashSet<std::string> allow_ops_;
+  const InlinedHashSet<std::string> deny_list_;
+  const KernelRegistryManager& kernel_registry_manager_;
+};
+
+}  // namespace onnxruntime
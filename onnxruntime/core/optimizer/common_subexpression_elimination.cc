@@ -5,7 +5,9 @@
 #include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/optimizer/initializer.h"
 
+#include <algorithm>
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
@@ -33,6 +35,12 @@
 // first every graph input, constant initializer and graph node output are assigned
 // an equivalence class, and then nodes that have the same operation and equivalent inputs
 // are collapsed.
+//
+// Nodes of a subgraph (e.g. the branches of an If or the body of a Loop) that only consume values
+// of the outer scope are numbered in the outer graph too. When the outer graph computes the same
+// value, the node is removed and the subgraph consumes the outer value instead. The nodes of the
+// body of a Loop or Scan are hoisted into the outer graph otherwise, as they would run once per
+// iteration. The nodes of If branches are not, as their branch may not run at all.
 
 namespace onnxruntime {
 
@@ -397,25 +405,295 @@ struct hash<onnxruntime::EquivalenceClass> {
 
 namespace onnxruntime {
 
+namespace {
+
+// Pool of equivalence classes; unique_ptr to guarantee stable address.
+using EquivalenceClassPool = InlinedVector<std::unique_ptr<EquivalenceClass>>;
+
+// Maps an equivalence class of values to a representative NodeArg that belongs to this class.
+using RepresentativeMap = std::unordered_map<const EquivalenceClass*, Representative,
+                                             DeepPointerHash, DeepPointerEquality>;
+
+// Maps every NodeArg to its equivalence class.
+using EquivalenceClassMap = std::unordered_map<const NodeArg*, const EquivalenceClass*,
+                                               NodeArgPtrHash, NodeArgPtrEquality>;
+
+// Largest constant initializer of a subgraph that is matched with an equal one of the outer graph.
+constexpr size_t kMaxMatchedInitializerSize = 8;
+
+// Returns the equivalence class of node_arg, adding one for a non-op value (graph input or constant initializer)
+// that has none yet.
+const EquivalenceClass* GetOrAddValueClass(const NodeArg* node_arg, EquivalenceClassPool& unique_equivalence_classes,
+                                           RepresentativeMap& value_to_representative,
+                                           EquivalenceClassMap& equivalence_classes) {
+  auto it = equivalence_classes.find(node_arg);
+  if (it == equivalence_classes.end()) {
+    auto value = std::make_unique<EquivalenceClass>(node_arg);
+    const auto* raw_ptr = value.get();
+    unique_equivalence_classes.push_back(std::move(value));
+    value_to_representative.emplace(raw_ptr, Representative{node_arg, 0, kInvalidOutputIndex});
+    it = equivalence_classes.emplace_hint(it, node_arg, raw_ptr);
+  }
+  return it->second;
+}
+
+// Finds a constant initializer of graph equal to the small constant initializer name of subgraph, so that the
+// values the subgraph computes from it can match those graph computes from its own copy.
+const NodeArg* FindEqualConstantInitializer(const Graph& graph, const Graph& subgraph, const std::string& name) {
+  const auto* subgraph_initializer = graph_utils::GetConstantInitializer(subgraph, name, false);
+  if (subgraph_initializer == nullptr ||
+      subgraph_initializer->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return nullptr;
+  }
+
+  const Initializer value{subgraph, *subgraph_initializer, subgraph.ModelPath()};
+  if (value.size() > kMaxMatchedInitializerSize) {
+    return nullptr;
+  }
+
+  for (const auto& [initializer_name, initializer] : graph.GetAllInitializedTensors()) {
+    if (initializer->data_type() != subgraph_initializer->data_type() ||
+        !std::equal(initializer->dims().begin(), initializer->dims().end(),
+                    subgraph_initializer->dims().begin(), subgraph_initializer->dims().end()) ||
+        !graph_utils::IsConstantInitializer(graph, initializer_name, false)) {
+      continue;
+    }
+
+    const Initializer other{graph, *initializer, graph.ModelPath()};
+    const auto bytes = value.DataAsByteSpan();
+    const auto other_bytes = other.DataAsByteSpan();
+    if (std::equal(bytes.begin(), bytes.end(), other_bytes.begin(), other_bytes.end())) {
+      return graph.GetNodeArg(initializer_name);
+    }
+  }
+
+  return nullptr;
+}
+
+// Copies a constant initializer of subgraph into graph, under a name that is unique in graph.
+NodeArg& CopyInitializer(Graph& graph, const Graph& subgraph, const std::string& name) {
+  const auto* subgraph_initializer = graph_utils::GetConstantInitializer(subgraph, name, false);
+  Initializer initializer{subgraph, *subgraph_initializer, subgraph.ModelPath()};
+  ONNX_NAMESPACE::TensorProto proto;
+  initializer.ToProto(proto);
+  proto.set_name(graph.GenerateNodeArgName(name));
+  return graph_utils::AddInitializerWithExternalData(graph, proto);
+}
+
+// Numbers the nodes of subgraph, a subgraph of node, that only consume values of graph (or values computed from
+// them) with the equivalence classes of graph. A node whose outputs all have a representative in graph is removed and
+// its consumers use the representatives instead. Otherwise, if hoist is set, the node is moved into graph.
+bool EliminateOuterScopeValues(Graph& graph, const Node& node, Graph& subgraph, bool hoist,
+                               EquivalenceClassPool& unique_equivalence_classes,
+                               RepresentativeMap& value_to_representative,
+                               EquivalenceClassMap& equivalence_classes,
+                               const logging::Logger& logger) {
+  InlinedHashSet<std::string_view> subgraph_inputs;
+  for (const auto* arg : subgraph.GetInputs()) {
+    subgraph_inputs.insert(arg->Name());
+  }
+
+  InlinedHashSet<std::string_view> subgraph_outputs;
+  for (const auto* arg : subgraph.GetOutputs()) {
+    subgraph_outputs.insert(arg->Name());
+  }
+
+  // whether name can refer to a value of graph in subgraph, i.e. it isn't a different value of subgraph
+  auto is_free_in_subgraph = [&](const std::string& name) {
+    return subgraph_inputs.count(name) == 0 && subgraph.GetProducerNode(name) == nullptr &&
+           !subgraph.IsInitializedTensor(name);
+  };
+
+  // the equivalence classes of the values of subgraph that are now computed in graph
+  InlinedHashMap<std::string, const EquivalenceClass*> outer_values;
+  InlinedHashMap<std::string, NodeArg*> copied_initializers;
+  bool modified = false;
+
+  GraphViewer subgraph_viewer(subgraph);
+  for (NodeIndex node_index : subgraph_viewer.GetNodesInTopologicalOrder()) {
+    Node* subgraph_node = subgraph.GetNode(node_index);
+    if (subgraph_node == nullptr || subgraph_node->OpType() == "EPContext" || !IsNodeSupported(*subgraph_node)) {
+      continue;
+    }
+
+    // the classes of the inputs in graph. a constant initializer of subgraph without an equal one in graph has
+    // none, and is copied into graph when the node is hoisted.
+    const auto& input_defs = subgraph_node->InputDefs();
+    InlinedVector<const EquivalenceClass*> input_values;
+    input_values.reserve(input_defs.size());
+    bool consumes_subgraph_values = false;
+    bool needs_copies = false;
+    for (const NodeArg* input_def : input_defs) {
+      const std::string& name = input_def->Name();
+      const NodeArg* outer_value = nullptr;
+      if (!input_def->Exists()) {
+        outer_value = input_def;
+      } else if (auto it = outer_values.find(name); it != outer_values.end()) {
+        input_values.push_back(it->second);
+        continue;
+      } else if (subgraph.IsInitializedTensor(name)) {
+        if (!graph_utils::IsConstantInitializer(subgraph, name, false)) {
+          consumes_subgraph_values = true;
+          break;
+        }
+        outer_value = FindEqualConstantInitializer(graph, subgraph, name);
+        needs_copies = needs_copies || outer_value == nullptr;
+      } else if (is_free_in_subgraph(name)) {
+        outer_value = graph.GetNodeArg(name);
+        if (outer_value == nullptr) {
+          consumes_subgraph_values = true;
+          break;
+        }
+      } else {
+        consumes_subgraph_values = true;
+        break;
+      }
+
+      input_values.push_back(outer_value == nullptr
+                                 ? nullptr
+                                 : GetOrAddValueClass(outer_value, unique_equivalence_classes,
+                                                      value_to_representative, equivalence_classes));
+    }
+
+    const auto& output_defs = subgraph_node->OutputDefs();
+    if (consumes_subgraph_values ||
+        std::any_of(output_defs.begin(), output_defs.end(), [&](const NodeArg* output_def) {
+          return subgraph_outputs.count(output_def->Name()) > 0;
+        })) {
+      continue;
+    }
+
+    // the representatives in graph of the outputs, if graph computes all of them
+    InlinedVector<const NodeArg*> replacements(output_defs.size(), nullptr);
+    bool is_computed_in_graph = !needs_copies;
+    for (OutputIndex output_index = 0, end = static_cast<int>(output_defs.size());
+         is_computed_in_graph && output_index < end; ++output_index) {
+      if (!output_defs[output_index]->Exists()) {
+        continue;
+      }
+
+      const EquivalenceClass equivalence_class(*subgraph_node, input_values, output_index, 0);
+      auto it = value_to_representative.find(&equivalence_class);
+      is_computed_in_graph = it != value_to_representative.end() && it->second.node_arg->Exists() &&
+                             is_free_in_subgraph(it->second.node_arg->Name());
+      if (is_computed_in_graph) {
+        replacements[output_index] = it->second.node_arg;
+      }
+    }
+
+    // the consumers of a replaced output within nested subgraphs would need to be renamed too
+    const auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(*subgraph_node);
+    const bool has_implicit_consumers =
+        std::any_of(output_edges.begin(), output_edges.end(), [&](const graph_utils::GraphEdge& edge) {
+          return static_cast<size_t>(edge.dst_arg_index) >= subgraph.GetNode(edge.dst_node)->InputDefs().size();
+        });
+
+    if (is_computed_in_graph && !has_implicit_consumers) {
+      for (const auto& edge : output_edges) {
+        const NodeArg& replacement = *replacements[edge.src_arg_index];
+        graph_utils::ReplaceNodeInput(*subgraph.GetNode(edge.dst_node), edge.dst_arg_index,
+                                      subgraph.GetOrCreateNodeArg(replacement.Name(), replacement.TypeAsProto()));
+      }
+      graph_utils::GraphEdge::RemoveGraphEdges(subgraph, output_edges);
+
+      for (size_t output_index = 0; output_index < output_defs.size(); ++output_index) {
+        if (replacements[output_index] != nullptr) {
+          subgraph.AddOuterScopeNodeArg(replacements[output_index]->Name());
+          outer_values[output_defs[output_index]->Name()] = equivalence_classes.at(replacements[output_index]);
+        }
+      }
+
+      LOGS(logger, VERBOSE) << "Replaced the outputs of node " << subgraph_node->Name() << "["
+                            << subgraph_node->OpType() << "] in a subgraph of " << node.Name()
+                            << " with values of the outer scope.";
+      subgraph.RemoveNode(node_index);
+      modified = true;
+      continue;
+    }
+
+    // the hoisted node keeps the names of its outputs, so the subgraph consumes them as outer scope values
+    if (!hoist || std::any_of(output_defs.begin(), output_defs.end(), [&](const NodeArg* output_def) {
+          return output_def->Exists() && graph.GetNodeArgIncludingParentGraphs(output_def->Name()) != nullptr;
+        })) {
+      continue;
+    }
+
+    InlinedVector<NodeArg*> inputs;
+    inputs.reserve(input_defs.size());
+    for (size_t input_index = 0; input_index < input_defs.size(); ++input_index) {
+      const NodeArg* input_def = input_defs[input_index];
+      if (!input_def->Exists()) {
+        inputs.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+      } else if (input_values[input_index] == nullptr) {
+        // the subgraph keeps its initializer for its other consumers
+        auto [it, inserted] = copied_initializers.try_emplace(input_def->Name(), nullptr);
+        if (inserted) {
+          it->second = &CopyInitializer(graph, subgraph, input_def->Name());
+        }
+        inputs.push_back(it->second);
+        input_values[input_index] = GetOrAddValueClass(it->second, unique_equivalence_classes,
+                                                       value_to_representative, equivalence_classes);
+      } else {
+        const NodeArg* representative = value_to_representative.at(input_values[input_index]).node_arg;
+        inputs.push_back(graph.GetNodeArg(representative->Name()));
+      }
+    }
+
+    InlinedVector<NodeArg*> outputs;
+    outputs.reserve(output_defs.size());
+    for (const NodeArg* output_def : output_defs) {
+      outputs.push_back(&graph.GetOrCreateNodeArg(output_def->Name(), output_def->TypeAsProto()));
+      if (output_def->Exists()) {
+        subgraph.AddOuterScopeNodeArg(output_def->Name());
+      }
+    }
+
+    Node& hoisted = graph.AddNode(graph.GenerateNodeName(subgraph_node->Name()), subgraph_node->OpType(),
+                                  "Hoisted from a subgraph by CommonSubexpressionElimination", inputs, outputs,
+                                  &subgraph_node->GetAttributes(), subgraph_node->Domain());
+    hoisted.MutableInputArgsCount() = subgraph_node->InputArgCount();
+    hoisted.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    for (OutputIndex output_index = 0, end = static_cast<int>(outputs.size()); output_index < end; ++output_index) {
+      auto equivalence_class = std::make_unique<EquivalenceClass>(hoisted, input_values, output_index, 0);
+      auto* raw_ptr = equivalence_class.get();
+      auto it = value_to_representative.find(raw_ptr);
+      if (it == value_to_representative.end()) {
+        unique_equivalence_classes.push_back(std::move(equivalence_class));
+        it = value_to_representative.emplace_hint(
+            it, raw_ptr, Representative{outputs[output_index], hoisted.Index(), output_index});
+      }
+
+      equivalence_classes[outputs[output_index]] = it->first;
+      if (outputs[output_index]->Exists()) {
+        outer_values[outputs[output_index]->Name()] = it->first;
+      }
+    }
+
+    LOGS(logger, VERBOSE) << "Hoisted node " << subgraph_node->Name() << "[" << subgraph_node->OpType()
+                          << "] out of a subgraph of " << node.Name() << ".";
+    graph_utils::RemoveNodeOutputEdges(subgraph, *subgraph_node);
+    subgraph.RemoveNode(node_index);
+    modified = true;
+  }
+
+  return modified;
+}
+
+}  // namespace
+
 Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   GraphViewer graph_viewer(graph);
   const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
 
-  // Pool of equivalence classes; unique_ptr to guarantee stable address.
-  InlinedVector<std::unique_ptr<EquivalenceClass>> unique_equivalence_classes;
+  EquivalenceClassPool unique_equivalence_classes;
   unique_equivalence_classes.reserve(graph.NumberOfNodes());
 
-  // Maps an equivalence class of values to a representative NodeArg that belongs to this class.
-  std::unordered_map<
-      const EquivalenceClass*,
-      Representative,
-      DeepPointerHash, DeepPointerEquality>
-      value_to_representative;
+  RepresentativeMap value_to_representative;
 
-  // Maps every NodeArg to its equivalence class of.
   // This is the inverse of the above mapping, except that different NodeArgs can belong to the same
   // equivalence class. In that case these NodeArgs will be "merged" into one.
-  std::unordered_map<const NodeArg*, const EquivalenceClass*, NodeArgPtrHash, NodeArgPtrEquality> equivalence_classes;
+  EquivalenceClassMap equivalence_classes;
 
   int unique_discriminator = 1;
 
@@ -435,18 +713,10 @@ Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, i
     InlinedVector<const EquivalenceClass*> input_values;
     input_values.reserve(node->InputDefs().size());
     for (const NodeArg* input_def : node->InputDefs()) {
-      auto it = equivalence_classes.find(input_def);
-      if (it == equivalence_classes.end()) {
-        // Because nodes are processed in topological order, this will always be
-        // a non-op value (graph input or constant initializer).
-        auto value = std::make_unique<EquivalenceClass>(input_def);
-        const auto* raw_ptr = value.get();
-        unique_equivalence_classes.push_back(std::move(value));
-        value_to_representative.emplace(raw_ptr, Representative{input_def, 0, kInvalidOutputIndex});
-        it = equivalence_classes.emplace_hint(it, input_def, raw_ptr);
-      }
-
-      input_values.push_back(it->second);
+      // Because nodes are processed in topological order, an input without a class will always be
+      // a non-op value (graph input or constant initializer).
+      input_values.push_back(GetOrAddValueClass(input_def, unique_equivalence_classes, value_to_representative,
+                                                equivalence_classes));
     }
 
     int discriminator = 0;
@@ -471,6 +741,23 @@ Status CommonSubexpressionElimination::ApplyImpl(Graph& graph, bool& modified, i
     }
   }
 
+  // The subgraphs were transformed by Recurse above. Number their nodes that only depend on this graph too.
+  for (NodeIndex node_index : node_topology_list) {
+    Node* node = graph.GetNode(node_index);
+    if (node == nullptr || !node->ContainsSubgraph()) {
+      continue;
+    }
+
+    // the body of a Loop or Scan runs once per iteration, an If branch at most once
+    const bool hoist = node->Domain() == kOnnxDomain && (node->OpType() == "Loop" || node->OpType() == "Scan");
+    for (auto& [attr_name, subgraph] : node->GetAttributeNameToMutableSubgraphMap()) {
+      if (EliminateOuterScopeValues(graph, *node, *subgraph, hoist, unique_equivalence_classes,
+                                    value_to_representative, equivalence_classes, logger)) {
+        modified = true;
+      }
+    }
+  }
+
   InlinedHashSet<const NodeArg*> graph_outputs;
   graph_outputs.reserve(graph_viewer.GetOutputs().size());
   graph_outputs.insert(graph_viewer.GetOutputs().begin(), graph_viewer.GetOutputs().end());
@@ -10,6 +10,8 @@ namespace onnxruntime {
 /**
 @Class CommonSubexpressionElimination
 Merge nodes that always evaluate to the same result.
+Nodes of subgraphs that only depend on outer scope values are merged with the equal nodes of the outer graph, and
+hoisted into it from the body of a Loop or Scan, so they don't run on every iteration.
 */
 class CommonSubexpressionElimination : public GraphTransformer {
  public:
@@ -17,6 +19,8 @@ class CommonSubexpressionElimination : public GraphTransformer {
       : GraphTransformer("CommonSubexpressionElimination", compatible_execution_providers) {
   }
 
+  bool CanTransformSubgraphsInParallel() const override { return true; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
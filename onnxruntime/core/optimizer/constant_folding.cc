@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <limits>
+#include <optional>
 
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/initializer.h"
@@ -11,11 +12,38 @@
 #include "core/optimizer/utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/common/parse_string.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 using namespace onnxruntime::common;
 
 namespace onnxruntime {
 
+static size_t GetMaxOutputBytes(const ConfigOptions& config_options) {
+  size_t max_output_bytes = 0;
+  const std::string value =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsConstantFoldingMaxOutputBytes, "0");
+  if (!TryParseStringWithClassicLocale(value, max_output_bytes)) {
+    max_output_bytes = 0;
+  }
+  return max_output_bytes;
+}
+
+// The size in bytes of the outputs of the node from their inferred shapes, or nullopt if a shape isn't static.
+static std::optional<size_t> GetStaticOutputBytes(const Node& node) {
+  size_t total_bytes = 0;
+  for (const auto* output_def : node.OutputDefs()) {
+    const auto* type = output_def->TypeAsProto();
+    size_t bytes = 0;
+    if (type == nullptr || !utils::HasTensorType(*type) ||
+        !utils::GetSizeInBytesFromTensorTypeProto<0>(type->tensor_type(), &bytes).IsOK()) {
+      return std::nullopt;
+    }
+    total_bytes += bytes;
+  }
+  return total_bytes;
+}
+
 ConstantFolding::ConstantFolding(const IExecutionProvider& execution_provider,
                                  bool skip_dequantize_linear,
                                  const ConfigOptions& config_options,
@@ -33,6 +61,7 @@ ConstantFolding::ConstantFolding(const std::string& name,
     : GraphTransformer(name, compatible_execution_providers),
       skip_dequantize_linear_(skip_dequantize_linear),
       config_options_(config_options),
+      max_output_bytes_(GetMaxOutputBytes(config_options)),
       excluded_initializers_(excluded_initializers),
       execution_provider_(execution_provider) {
 }
@@ -233,6 +262,24 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         }
       }
 
+      // keep the nodes expanding their inputs into large constants, e.g. Expand or Tile, computed at run time.
+      // their output shape is usually inferred, so they aren't even run.
+      size_t input_bytes = 0;
+      if (max_output_bytes_ != 0) {
+        for (const auto& [name, initializer] : constant_inputs) {
+          size_t bytes = 0;
+          if (utils::GetSizeInBytesFromTensorProto<0>(*initializer, &bytes).IsOK()) {
+            input_bytes += bytes;
+          }
+        }
+        const auto output_bytes = GetStaticOutputBytes(*node);
+        if (output_bytes.has_value() && ExceedsOutputBudget(input_bytes, *output_bytes)) {
+          LOGS(logger, VERBOSE) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                                << "' as its " << *output_bytes << " bytes of outputs exceed the budget.";
+          continue;
+        }
+      }
+
 #if !defined(DISABLE_SPARSE_TENSORS)
       // Create execution frame for executing constant nodes.
       OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
@@ -311,6 +358,18 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         }
       }
 
+      if (converted_to_constant && max_output_bytes_ != 0) {
+        size_t output_bytes = 0;
+        for (const auto& fetch : fetches) {
+          output_bytes += fetch.Get<Tensor>().SizeInBytes();
+        }
+        if (ExceedsOutputBudget(input_bytes, output_bytes)) {
+          LOGS(logger, VERBOSE) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                                << "' as its " << output_bytes << " bytes of outputs exceed the budget.";
+          converted_to_constant = false;
+        }
+      }
+
       if (converted_to_constant) {
         for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
           OrtValue& ort_value = fetches[fetch_idx];
@@ -28,6 +28,8 @@ class ConstantFolding : public GraphTransformer {
                   const InlinedHashSet<std::string_view>& compatible_execution_providers = {},
                   const InlinedHashSet<std::string>& excluded_initializers = {}) noexcept;
 
+  bool CanTransformSubgraphsInParallel() const override { return true; }
+
  protected:
   /**
    * Same as the constructor above but with a name provided by derived class.
@@ -49,8 +51,15 @@ class ConstantFolding : public GraphTransformer {
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
+  // Whether folding the node would add constants larger than max_output_bytes_ and larger than its inputs.
+  bool ExceedsOutputBudget(size_t input_bytes, size_t output_bytes) const {
+    return max_output_bytes_ != 0 && output_bytes > max_output_bytes_ && output_bytes > input_bytes;
+  }
+
   bool skip_dequantize_linear_;
   const ConfigOptions& config_options_;
+  // 0 if the size of the folded constants is not limited.
+  const size_t max_output_bytes_;
   const InlinedHashSet<std::string> excluded_initializers_;
   const IExecutionProvider& execution_provider_;
 };
@@ -0,0 +1,191 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/dynamic_quantize_gru_transformer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/node_attr_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// Quantized copy of a GRU weight, transposed from [num_directions, 3*hidden_size, K] to
+// [num_directions, K, 3*hidden_size] with one scale per direction and gate column.
+struct QuantizedGRUWeight {
+  std::vector<uint8_t> data;
+  std::vector<float> scales;
+};
+
+QuantizedGRUWeight QuantizeGRUWeight(gsl::span<const float> w, size_t num_directions, size_t N, size_t K,
+                                     int offset, double& error_norm, double& weight_norm) {
+  QuantizedGRUWeight result;
+  result.data.resize(num_directions * N * K);
+  result.scales.resize(num_directions * N, 0.0f);
+
+  for (size_t dir = 0; dir < num_directions; ++dir) {
+    const float* w_dir = w.data() + dir * N * K;
+    float* scales = result.scales.data() + dir * N;
+    uint8_t* q_dir = result.data.data() + dir * N * K;
+
+    for (size_t n = 0; n < N; ++n) {
+      for (size_t k = 0; k < K; ++k) {
+        scales[n] = std::max(scales[n], std::fabs(w_dir[n * K + k]));
+      }
+      scales[n] = scales[n] > 0.0f ? scales[n] / 127.0f : 1.0f;
+    }
+
+    for (size_t n = 0; n < N; ++n) {
+      for (size_t k = 0; k < K; ++k) {
+        const float value = w_dir[n * K + k];
+        const int q = static_cast<int>(std::clamp(std::nearbyint(value / scales[n]), -127.0f, 127.0f));
+        const double error = static_cast<double>(value) - static_cast<double>(q) * scales[n];
+        error_norm += error * error;
+        weight_norm += static_cast<double>(value) * value;
+        q_dir[k * N + n] = static_cast<uint8_t>(q + offset);
+      }
+    }
+  }
+
+  return result;
+}
+
+}  // namespace
+
+bool DynamicQuantizeGRUTransformer::QuantizeGRU(Graph& graph, Node& gru, const logging::Logger& logger) const {
+  const auto* layout = graph_utils::GetNodeAttribute(gru, "layout");
+  if (layout != nullptr && layout->i() != 0) {
+    return false;
+  }
+
+  const auto& input_defs = gru.InputDefs();
+  const auto* x_type = input_defs[0]->TypeAsProto();
+  if (x_type == nullptr || !x_type->tensor_type().has_elem_type() ||
+      x_type->tensor_type().elem_type() != TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  const auto* W = graph_utils::GetConstantInitializer(graph, input_defs[1]->Name());
+  const auto* R = graph_utils::GetConstantInitializer(graph, input_defs[2]->Name());
+  if (W == nullptr || R == nullptr || W->dims_size() != 3 || R->dims_size() != 3 ||
+      W->data_type() != TensorProto_DataType_FLOAT || R->data_type() != TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  Initializer W_source{graph, *W, graph.ModelPath()};
+  Initializer R_source{graph, *R, graph.ModelPath()};
+  const auto W_dims = W_source.dims();
+  const auto R_dims = R_source.dims();
+
+  // W: [num_directions, 3*hidden_size, input_size], R: [num_directions, 3*hidden_size, hidden_size]
+  const size_t num_directions = narrow<size_t>(W_dims[0]);
+  const size_t N = narrow<size_t>(W_dims[1]);
+  const size_t input_size = narrow<size_t>(W_dims[2]);
+  const size_t hidden_size = N / 3;
+  if (N == 0 || input_size == 0 || N % 3 != 0 ||
+      R_dims[0] != W_dims[0] || R_dims[1] != W_dims[1] || narrow<size_t>(R_dims[2]) != hidden_size) {
+    return false;
+  }
+
+  const int offset = weight_is_unsigned_ ? 128 : 0;
+  double error_norm = 0.0;
+  double weight_norm = 0.0;
+  const auto W_quantized = QuantizeGRUWeight(W_source.DataAsSpan<float>(), num_directions, N, input_size, offset,
+                                             error_norm, weight_norm);
+  const auto R_quantized = QuantizeGRUWeight(R_source.DataAsSpan<float>(), num_directions, N, hidden_size, offset,
+                                             error_norm, weight_norm);
+
+  const double relative_error = weight_norm > 0.0 ? std::sqrt(error_norm / weight_norm) : 0.0;
+  if (relative_error > max_relative_error_) {
+    LOGS(logger, VERBOSE) << "Keeping GRU " << gru.Name() << " in float, weight quantization error "
+                          << relative_error << " exceeds " << max_relative_error_;
+    return false;
+  }
+
+  const TensorProto_DataType quant_type = weight_is_unsigned_ ? TensorProto_DataType_UINT8 : TensorProto_DataType_INT8;
+
+  auto add_initializer = [&graph](TensorProto_DataType type, const std::string& name,
+                                  gsl::span<const int64_t> dims, const void* data, size_t size) -> NodeArg& {
+    Initializer initializer{type, graph.GenerateNodeArgName(name), dims};
+    std::memcpy(initializer.MutableDataAsByteSpan().data(), data, size);
+    TensorProto proto;
+    initializer.ToProto(proto);
+    return graph_utils::AddInitializerWithExternalData(graph, proto);
+  };
+
+  const int64_t W_quantized_dims[] = {W_dims[0], W_dims[2], W_dims[1]};
+  const int64_t R_quantized_dims[] = {R_dims[0], R_dims[2], R_dims[1]};
+  const int64_t scale_dims[] = {W_dims[0], W_dims[1]};
+
+  NodeArg& W_arg = add_initializer(quant_type, W->name() + "_quantized", W_quantized_dims,
+                                   W_quantized.data.data(), W_quantized.data.size());
+  NodeArg& R_arg = add_initializer(quant_type, R->name() + "_quantized", R_quantized_dims,
+                                   R_quantized.data.data(), R_quantized.data.size());
+  NodeArg& W_scale_arg = add_initializer(TensorProto_DataType_FLOAT, W->name() + "_scale", scale_dims,
+                                         W_quantized.scales.data(), W_quantized.scales.size() * sizeof(float));
+  NodeArg& R_scale_arg = add_initializer(TensorProto_DataType_FLOAT, R->name() + "_scale", scale_dims,
+                                         R_quantized.scales.data(), R_quantized.scales.size() * sizeof(float));
+
+  const std::vector<uint8_t> zero_points(num_directions * N, static_cast<uint8_t>(offset));
+  NodeArg& W_zp_arg = add_initializer(quant_type, W->name() + "_zero_point", scale_dims,
+                                      zero_points.data(), zero_points.size());
+  NodeArg& R_zp_arg = add_initializer(quant_type, R->name() + "_zero_point", scale_dims,
+                                      zero_points.data(), zero_points.size());
+
+  // B, sequence_lens and initial_h are optional, missing ones keep an empty slot before the quantization inputs.
+  NodeArg& empty_arg = graph.GetOrCreateNodeArg("", nullptr);
+  auto& mutable_input_defs = gru.MutableInputDefs();
+  InlinedVector<NodeArg*> new_input_defs{mutable_input_defs[0], &W_arg, &R_arg};
+  for (size_t i = 3; i < 6; ++i) {
+    new_input_defs.push_back(i < mutable_input_defs.size() ? mutable_input_defs[i] : &empty_arg);
+  }
+  new_input_defs.insert(new_input_defs.end(), {&W_scale_arg, &W_zp_arg, &R_scale_arg, &R_zp_arg});
+
+  NodeAttributes attributes = gru.GetAttributes();
+  attributes.erase("layout");
+  if (attributes.count("hidden_size") == 0) {
+    utils::SetNodeAttribute(utils::MakeAttribute("hidden_size", static_cast<int64_t>(hidden_size)), attributes);
+  }
+
+  Node& quantized_gru = graph.AddNode(graph.GenerateNodeName(gru.Name() + "_dynamic_quantized"),
+                                      "DynamicQuantizeGRU",
+                                      "GRU with weights quantized by DynamicQuantizeGRUTransformer",
+                                      new_input_defs, gru.MutableOutputDefs(), &attributes, kMSDomain);
+  quantized_gru.SetExecutionProviderType(gru.GetExecutionProviderType());
+
+  graph_utils::FinalizeNodeFusion(graph, {gru}, quantized_gru);
+  return true;
+}
+
+Status DynamicQuantizeGRUTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                                const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "GRU", {7, 14, 22}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    modified |= QuantizeGRU(graph, node, logger);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
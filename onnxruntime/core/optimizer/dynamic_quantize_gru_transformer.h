@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Rewrite float GRU nodes with constant W and R into com.microsoft DynamicQuantizeGRU.
+ *
+ * W and R are transposed to [num_directions, K, 3*hidden_size] and quantized symmetrically per gate column. Their
+ * combined quantization error, relative to the norm of the float weights, must not exceed max_relative_error,
+ * otherwise the GRU stays in float. The bias, the initial hidden state and the activation stay in float.
+ */
+class DynamicQuantizeGRUTransformer : public GraphTransformer {
+ public:
+  DynamicQuantizeGRUTransformer(float max_relative_error, bool weight_is_unsigned,
+                                const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("DynamicQuantizeGRUTransformer", compatible_execution_providers),
+        max_relative_error_(max_relative_error),
+        weight_is_unsigned_(weight_is_unsigned) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+ private:
+  bool QuantizeGRU(Graph& graph, Node& gru, const logging::Logger& logger) const;
+
+  const float max_relative_error_;
+
+  // uint8 weights with a zero point of 128, for the CPUs where the U8S8 kernels can overflow.
+  const bool weight_is_unsigned_;
+};
+
+}  // namespace onnxruntime
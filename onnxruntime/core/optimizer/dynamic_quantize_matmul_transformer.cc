@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/dynamic_quantize_matmul_transformer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+bool DynamicQuantizeMatMulTransformer::QuantizeMatMul(Graph& graph, Node& matmul,
+                                                      const logging::Logger& logger) const {
+  const auto& input_defs = matmul.InputDefs();
+  const auto* a_type = input_defs[0]->TypeAsProto();
+  if (a_type == nullptr || !a_type->tensor_type().has_elem_type() ||
+      a_type->tensor_type().elem_type() != TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  const auto* weight = graph_utils::GetConstantInitializer(graph, input_defs[1]->Name());
+  if (weight == nullptr || weight->dims_size() != 2 || weight->data_type() != TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  Initializer source{graph, *weight, graph.ModelPath()};
+  const auto dims = source.dims();
+  const size_t K = narrow<size_t>(dims[0]);
+  const size_t N = narrow<size_t>(dims[1]);
+  if (K == 0 || N == 0) {
+    return false;
+  }
+  const auto w = source.DataAsSpan<float>();
+
+  // Symmetric per column scales, the quantized values are in [-127, 127].
+  std::vector<float> scales(N, 0.0f);
+  for (size_t k = 0; k < K; ++k) {
+    for (size_t n = 0; n < N; ++n) {
+      scales[n] = std::max(scales[n], std::fabs(w[k * N + n]));
+    }
+  }
+  for (auto& scale : scales) {
+    scale = scale > 0.0f ? scale / 127.0f : 1.0f;
+  }
+
+  const TensorProto_DataType quant_type = weight_is_unsigned_ ? TensorProto_DataType_UINT8 : TensorProto_DataType_INT8;
+  const int offset = weight_is_unsigned_ ? 128 : 0;
+
+  Initializer quantized{quant_type, graph.GenerateNodeArgName(weight->name() + "_quantized"), dims};
+  auto quantized_bytes = quantized.MutableDataAsByteSpan();
+
+  double error_norm = 0.0;
+  double weight_norm = 0.0;
+  for (size_t k = 0; k < K; ++k) {
+    for (size_t n = 0; n < N; ++n) {
+      const float value = w[k * N + n];
+      const int q = static_cast<int>(std::clamp(std::nearbyint(value / scales[n]), -127.0f, 127.0f));
+      const double error = static_cast<double>(value) - static_cast<double>(q) * scales[n];
+      error_norm += error * error;
+      weight_norm += static_cast<double>(value) * value;
+      quantized_bytes[k * N + n] = static_cast<uint8_t>(q + offset);
+    }
+  }
+
+  const double relative_error = weight_norm > 0.0 ? std::sqrt(error_norm / weight_norm) : 0.0;
+  if (relative_error > max_relative_error_) {
+    LOGS(logger, VERBOSE) << "Keeping MatMul " << matmul.Name() << " in float, weight quantization error "
+                          << relative_error << " exceeds " << max_relative_error_;
+    return false;
+  }
+
+  TensorProto quantized_proto;
+  quantized.ToProto(quantized_proto);
+  NodeArg& quantized_arg = graph_utils::AddInitializerWithExternalData(graph, quantized_proto);
+
+  const int64_t scale_dims[] = {narrow<int64_t>(N)};
+  Initializer scale{TensorProto_DataType_FLOAT, graph.GenerateNodeArgName(weight->name() + "_scale"), scale_dims};
+  std::copy(scales.begin(), scales.end(), scale.data<float>());
+  TensorProto scale_proto;
+  scale.ToProto(scale_proto);
+  NodeArg& scale_arg = graph_utils::AddInitializerWithExternalData(graph, scale_proto);
+
+  InlinedVector<NodeArg*> new_input_defs{matmul.MutableInputDefs()[0], &quantized_arg, &scale_arg};
+  if (weight_is_unsigned_) {
+    Initializer zero_point{TensorProto_DataType_UINT8, graph.GenerateNodeArgName(weight->name() + "_zero_point"),
+                           gsl::span<const int64_t>{}};
+    *zero_point.data<uint8_t>() = static_cast<uint8_t>(offset);
+    TensorProto zero_point_proto;
+    zero_point.ToProto(zero_point_proto);
+    new_input_defs.push_back(&graph_utils::AddInitializerWithExternalData(graph, zero_point_proto));
+  }
+
+  Node& quantized_matmul = graph.AddNode(graph.GenerateNodeName(matmul.Name() + "_dynamic_quantized"),
+                                         "DynamicQuantizeMatMul",
+                                         "MatMul with a weight quantized by DynamicQuantizeMatMulTransformer",
+                                         new_input_defs, matmul.MutableOutputDefs(), nullptr, kMSDomain);
+  quantized_matmul.SetExecutionProviderType(matmul.GetExecutionProviderType());
+
+  graph_utils::FinalizeNodeFusion(graph, {matmul}, quantized_matmul);
+  return true;
+}
+
+Status DynamicQuantizeMatMulTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                                   const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    modified |= QuantizeMatMul(graph, node, logger);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
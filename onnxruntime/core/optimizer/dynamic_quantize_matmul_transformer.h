@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Rewrite float MatMul nodes with a constant 2-D weight into com.microsoft DynamicQuantizeMatMul, so fp32
+ * models get the int8 GEMM without an offline quantization step.
+ *
+ * The weight is quantized once here, symmetrically and per column. Its quantization error, the norm of
+ * (W - dequantize(quantize(W))) relative to the norm of W, must not exceed max_relative_error, otherwise the MatMul
+ * stays in float. The kernel prepacks the quantized weight through MlasGemmPackB and quantizes the activation at
+ * runtime.
+ */
+class DynamicQuantizeMatMulTransformer : public GraphTransformer {
+ public:
+  DynamicQuantizeMatMulTransformer(float max_relative_error, bool weight_is_unsigned,
+                                   const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("DynamicQuantizeMatMulTransformer", compatible_execution_providers),
+        max_relative_error_(max_relative_error),
+        weight_is_unsigned_(weight_is_unsigned) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+ private:
+  bool QuantizeMatMul(Graph& graph, Node& matmul, const logging::Logger& logger) const;
+
+  const float max_relative_error_;
+
+  // uint8 weights with a zero point of 128, for the CPUs where the U8S8 kernels can overflow.
+  const bool weight_is_unsigned_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_chain_fusion.h"
+
+#include <algorithm>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+static constexpr std::array supported_data_types{"tensor(float)"};
+
+bool IsFusibleBinaryNode(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14});
+}
+
+bool IsFusibleUnaryNode(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Log", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13});
+}
+
+// Shapes are the same if they have the same rank and each dimension has the same value or the same symbolic name.
+bool HaveSameShape(const NodeArg& arg, const NodeArg& other) {
+  const auto* shape = arg.Shape();
+  const auto* other_shape = other.Shape();
+  if (shape == nullptr || other_shape == nullptr || shape->dim_size() != other_shape->dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < shape->dim_size(); ++i) {
+    const auto& dim = shape->dim(i);
+    const auto& other_dim = other_shape->dim(i);
+    if (utils::HasDimValue(dim) && utils::HasDimValue(other_dim)) {
+      if (dim.dim_value() != other_dim.dim_value()) return false;
+    } else if (utils::HasDimParam(dim) && utils::HasDimParam(other_dim)) {
+      if (dim.dim_param() != other_dim.dim_param()) return false;
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Whether operand can be broadcast against value by FusedElementwise without changing the shape of value.
+bool IsSupportedOperand(const NodeArg& operand, const NodeArg& value) {
+  if (optimizer_utils::IsScalar(operand) || HaveSameShape(operand, value)) {
+    return true;
+  }
+
+  const auto* shape = operand.Shape();
+  const auto* value_shape = value.Shape();
+  if (shape == nullptr || value_shape == nullptr || shape->dim_size() != 1 || value_shape->dim_size() < 1) {
+    return false;
+  }
+
+  const auto& dim = shape->dim(0);
+  const auto& last_dim = value_shape->dim(value_shape->dim_size() - 1);
+  return utils::HasDimValue(dim) && utils::HasDimValue(last_dim) && dim.dim_value() == last_dim.dim_value();
+}
+
+struct ChainStep {
+  Node* node;
+  // input index of the chain value in node.
+  int value_index;
+};
+
+// Returns the input index of the chain value in node if it can be part of a chain, or -1.
+// If chain_value is nullptr the node starts a chain and any input can be used as the chain value.
+int GetChainValueIndex(const Node& node, const NodeArg* chain_value,
+                       const InlinedHashSet<std::string_view>& compatible_providers) {
+  if (!graph_utils::IsSupportedProvider(node, compatible_providers) ||
+      !optimizer_utils::IsSupportedDataType(node, supported_data_types) ||
+      node.OutputDefs().size() != 1) {
+    return -1;
+  }
+
+  const NodeArg& output = *node.OutputDefs()[0];
+  const auto inputs = node.InputDefs();
+  if (IsFusibleUnaryNode(node)) {
+    return (chain_value == nullptr || inputs[0] == chain_value) && HaveSameShape(*inputs[0], output) ? 0 : -1;
+  }
+
+  if (!IsFusibleBinaryNode(node) || inputs.size() != 2 || inputs[0] == inputs[1]) {
+    return -1;
+  }
+
+  for (int i = 0; i < 2; ++i) {
+    const NodeArg& value = *inputs[i];
+    const NodeArg& operand = *inputs[1 - i];
+    if ((chain_value == nullptr || &value == chain_value) && HaveSameShape(value, output) &&
+        IsSupportedOperand(operand, value)) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+}  // namespace
+
+/**
+Rewrite a chain of elementwise nodes, e.g. Sigmoid(Add(Mul(x, a), b)), to FusedElementwise.
+*/
+Status ElementwiseChainFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    int value_index = GetChainValueIndex(node, nullptr, GetCompatibleExecutionProviders());
+    if (value_index < 0) {
+      continue;
+    }
+
+    InlinedVector<ChainStep> chain{{&node, value_index}};
+    while (true) {
+      Node& last = *chain.back().node;
+      if (!optimizer_utils::CheckOutputEdges(graph, last, 1)) {
+        break;
+      }
+
+      Node& next = *graph.GetNode(last.OutputNodesBegin()->Index());
+      value_index = GetChainValueIndex(next, last.OutputDefs()[0], GetCompatibleExecutionProviders());
+      if (value_index < 0 || next.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+        break;
+      }
+
+      chain.push_back({&next, value_index});
+    }
+
+    if (chain.size() < 2) {
+      continue;
+    }
+
+    NodeArg* chain_input = node.MutableInputDefs()[chain[0].value_index];
+    InlinedVector<NodeArg*> fused_inputs{chain_input};
+    std::vector<std::string> ops;
+    std::vector<int64_t> operand_indices;
+    std::vector<int64_t> operand_first;
+    InlinedVector<std::reference_wrapper<Node>> nodes_to_fuse;
+    // input edges of the other nodes are not moved by FinalizeNodeFusion and have to be re-created.
+    std::vector<graph_utils::GraphEdge> operand_edges;
+    for (size_t i = 0; i < chain.size(); ++i) {
+      Node& chain_node = *chain[i].node;
+      ops.push_back(chain_node.OpType());
+      nodes_to_fuse.emplace_back(chain_node);
+
+      if (chain_node.InputDefs().size() == 2) {
+        NodeArg* operand = chain_node.MutableInputDefs()[1 - chain[i].value_index];
+        auto it = std::find(fused_inputs.begin(), fused_inputs.end(), operand);
+        if (it == fused_inputs.end()) {
+          it = fused_inputs.insert(fused_inputs.end(), operand);
+        }
+        operand_indices.push_back(static_cast<int64_t>(it - fused_inputs.begin()));
+        operand_first.push_back(chain[i].value_index == 1 ? 1 : 0);
+
+        if (i > 0) {
+          for (const auto& edge : graph_utils::GraphEdge::GetNodeInputEdges(chain_node, 1 - chain[i].value_index)) {
+            operand_edges.push_back(edge);
+          }
+        }
+      } else {
+        operand_indices.push_back(-1);
+        operand_first.push_back(0);
+      }
+    }
+
+    Node& last_node = *chain.back().node;
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(last_node.Name() + "/ElementwiseChainFusion/"),
+                                     "FusedElementwise", "fused elementwise chain", fused_inputs,
+                                     std::array{last_node.MutableOutputDefs()[0]}, {}, kMSDomain);
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("operand_indices", operand_indices);
+    fused_node.AddAttribute("operand_first", operand_first);
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_fuse, fused_node);
+
+    for (const auto& edge : operand_edges) {
+      graph.AddEdge(edge.src_node, fused_node.Index(), edge.src_arg_index,
+                    graph_utils::GetNodeInputIndexFromInputName(fused_node, edge.arg_name));
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Rewrite chains of float elementwise operators (Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Exp, Log, Neg, Abs,
+ * Sqrt, Reciprocal, Erf) to a single FusedElementwise node, so the chain makes one pass over memory instead of one
+ * per operator.
+ *
+ * A chain follows the first input that has the shape of each node's output. Intermediate values must have a single
+ * consumer, and the other input of a binary operator must be a scalar, a tensor with the same shape as the chain
+ * value, or a 1-D tensor matching its last dimension. It runs after the pattern-specific fusions so those keep
+ * precedence.
+ */
+class ElementwiseChainFusion : public GraphTransformer {
+ public:
+  ElementwiseChainFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseChainFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
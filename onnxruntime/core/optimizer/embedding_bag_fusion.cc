@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/embedding_bag_fusion.h"
+
+#include <algorithm>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool HasType(const NodeArg& arg, std::initializer_list<std::string_view> types) {
+  return arg.Type() != nullptr && std::find(types.begin(), types.end(), *arg.Type()) != types.end();
+}
+
+bool HasRank(const NodeArg& arg, int rank) {
+  return arg.Shape() != nullptr && arg.Shape()->dim_size() == rank;
+}
+
+// Returns the mode of an EmbeddingBag computing the reduction of the gathered rows, or nullptr if node is not a
+// ReduceSum or ReduceMean of a 3-D input over the constant axis 1 without keeping it.
+const char* GetBagReduceMode(const Graph& graph, const Node& node) {
+  const char* mode = nullptr;
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceSum", {1, 11, 13})) {
+    mode = "sum";
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMean", {1, 11, 13, 18})) {
+    mode = "mean";
+  } else {
+    return nullptr;
+  }
+
+  const auto* keepdims = graph_utils::GetNodeAttribute(node, "keepdims");
+  if (keepdims == nullptr || keepdims->i() != 0) {
+    return nullptr;
+  }
+
+  InlinedVector<int64_t> axes;
+  if (!graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes) &&
+      node.InputDefs().size() > 1 && node.InputDefs()[1]->Exists()) {
+    const auto* axes_initializer = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+    if (axes_initializer == nullptr) {
+      return nullptr;
+    }
+
+    Initializer axes_values{graph, *axes_initializer, graph.ModelPath()};
+    auto axes_span = axes_values.DataAsSpan<int64_t>();
+    axes.assign(axes_span.begin(), axes_span.end());
+  }
+
+  if (axes.size() != 1 || (axes[0] != 1 && axes[0] != -2)) {
+    return nullptr;
+  }
+
+  return mode;
+}
+
+// Returns true if node dequantizes an int8 table with a scalar or per-row float scale and no zero point, so that
+// EmbeddingBag can read the int8 rows and apply the scale to them.
+bool IsFoldableTableDequantize(const Graph& graph, const Node& node) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "DequantizeLinear", {10, 13, 19, 21}) ||
+      !optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+    return false;
+  }
+
+  const auto& inputs = node.InputDefs();
+  if (!HasType(*inputs[0], {"tensor(int8)"}) || !HasRank(*inputs[0], 2) ||
+      !HasType(*inputs[1], {"tensor(float)"}) || inputs[1]->Shape() == nullptr) {
+    return false;
+  }
+
+  const auto* block_size = graph_utils::GetNodeAttribute(node, "block_size");
+  if (block_size != nullptr && block_size->i() != 0) {
+    return false;
+  }
+
+  const auto& scale_shape = *inputs[1]->Shape();
+  const bool is_scalar = scale_shape.dim_size() == 0 ||
+                         (scale_shape.dim_size() == 1 && utils::HasDimValue(scale_shape.dim(0)) &&
+                          scale_shape.dim(0).dim_value() == 1);
+  if (!is_scalar) {
+    // one scale per row is a per-axis quantization along axis 0.
+    const auto* axis = graph_utils::GetNodeAttribute(node, "axis");
+    const int64_t axis_value = axis != nullptr ? axis->i() : 1;
+    if (scale_shape.dim_size() != 1 || (axis_value != 0 && axis_value != -2)) {
+      return false;
+    }
+  }
+
+  if (inputs.size() > 2 && inputs[2]->Exists()) {
+    const auto* zero_point = graph_utils::GetConstantInitializer(graph, inputs[2]->Name());
+    if (zero_point == nullptr) {
+      return false;
+    }
+
+    Initializer zero_point_values{graph, *zero_point, graph.ModelPath()};
+    const auto zero_points = zero_point_values.DataAsSpan<int8_t>();
+    if (std::any_of(zero_points.begin(), zero_points.end(), [](int8_t zp) { return zp != 0; })) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+/**
+Rewrite ReduceSum(Gather(table, indices), axes=[1], keepdims=0), or ReduceMean, to EmbeddingBag(table, indices),
+and ReduceSum(Gather(DequantizeLinear(int8_table, scale), indices)) to EmbeddingBag(int8_table, indices, scale).
+*/
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& reduce_node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(reduce_node, modified, graph_level, logger));
+
+    const char* mode = GetBagReduceMode(graph, reduce_node);
+    if (mode == nullptr || !graph_utils::IsSupportedProvider(reduce_node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const Node* gather = graph_utils::GetInputNode(reduce_node, 0);
+    if (gather == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*gather, "Gather", {1, 11, 13}) ||
+        gather->GetExecutionProviderType() != reduce_node.GetExecutionProviderType() ||
+        !optimizer_utils::CheckOutputEdges(graph, *gather, 1)) {
+      continue;
+    }
+
+    const auto* gather_axis = graph_utils::GetNodeAttribute(*gather, "axis");
+    if (gather_axis != nullptr && gather_axis->i() != 0) {
+      continue;
+    }
+
+    Node& gather_node = *graph.GetNode(gather->Index());
+    NodeArg* table = gather_node.MutableInputDefs()[0];
+    NodeArg* indices = gather_node.MutableInputDefs()[1];
+    if (!HasType(*table, {"tensor(float)", "tensor(float16)"}) || !HasRank(*table, 2) ||
+        !HasType(*indices, {"tensor(int32)", "tensor(int64)"}) || !HasRank(*indices, 2)) {
+      continue;
+    }
+
+    // the int8 table of a DequantizeLinear is read directly rather than dequantizing the whole table on every run.
+    const Node* dequantize = graph_utils::GetInputNode(*gather, 0);
+    if (dequantize != nullptr &&
+        (dequantize->GetExecutionProviderType() != reduce_node.GetExecutionProviderType() ||
+         !HasType(*table, {"tensor(float)"}) || !IsFoldableTableDequantize(graph, *dequantize))) {
+      dequantize = nullptr;
+    }
+
+    NodeArg& empty_arg = graph.GetOrCreateNodeArg("", nullptr);
+    InlinedVector<NodeArg*> inputs{table, indices};
+    if (dequantize != nullptr) {
+      Node& dequantize_node = *graph.GetNode(dequantize->Index());
+      inputs[0] = dequantize_node.MutableInputDefs()[0];
+      inputs.insert(inputs.end(), {&empty_arg, &empty_arg, &empty_arg, dequantize_node.MutableInputDefs()[1]});
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(reduce_node.Name() + "/EmbeddingBagFusion/"),
+                                     "EmbeddingBag", "fused Gather and " + reduce_node.OpType(), inputs,
+                                     reduce_node.MutableOutputDefs(), {}, kMSDomain);
+    fused_node.AddAttribute("mode", std::string(mode));
+    fused_node.SetExecutionProviderType(reduce_node.GetExecutionProviderType());
+
+    // the table and its scale come from the DequantizeLinear inputs 0 and 1 if it is folded.
+    const Node* table_source = dequantize != nullptr ? dequantize : gather;
+    for (const auto& edge : graph_utils::GraphEdge::GetNodeInputEdges(*table_source, 0)) {
+      graph.AddEdge(edge.src_node, fused_node.Index(), edge.src_arg_index, 0);
+    }
+    for (const auto& edge : graph_utils::GraphEdge::GetNodeInputEdges(gather_node, 1)) {
+      graph.AddEdge(edge.src_node, fused_node.Index(), edge.src_arg_index, 1);
+    }
+    if (dequantize != nullptr) {
+      for (const auto& edge : graph_utils::GraphEdge::GetNodeInputEdges(*dequantize, 1)) {
+        graph.AddEdge(edge.src_node, fused_node.Index(), edge.src_arg_index, 5);
+      }
+    }
+
+    auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(reduce_node);
+    graph_utils::GraphEdge::RemoveGraphEdges(graph, output_edges);
+    for (const auto& edge : output_edges) {
+      graph.AddEdge(fused_node.Index(), edge.dst_node, 0, edge.dst_arg_index);
+    }
+
+    graph.RemoveNode(reduce_node.Index());
+    graph.RemoveNode(gather_node.Index());
+    if (dequantize != nullptr) {
+      graph.RemoveNode(dequantize->Index());
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
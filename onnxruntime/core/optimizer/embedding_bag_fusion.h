@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Rewrite Gather(table, indices) followed by a ReduceSum or ReduceMean over the bag axis to an EmbeddingBag
+ * node, which accumulates the rows of each bag straight into the output instead of materializing the
+ * [num_bags, bag_size, embedding_dim] gathered rows, as in the embedding lookups of recommendation models.
+ *
+ * The table must be 2-D and the indices 2-D, with the Reduce over axis 1 without keeping it. A DequantizeLinear of an
+ * int8 table with a scalar or per-row scale and no zero point is folded into the EmbeddingBag, which then reads the
+ * int8 rows.
+ *
+ * It runs before MultiReduceFusion so the Reduce isn't fused with its siblings first.
+ */
+class EmbeddingBagFusion : public GraphTransformer {
+ public:
+  EmbeddingBagFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("EmbeddingBagFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
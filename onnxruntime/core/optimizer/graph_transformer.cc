@@ -3,6 +3,11 @@
 
 #include "core/optimizer/graph_transformer.h"
 
+#include <vector>
+
+#include <gsl/gsl>
+#include "core/platform/threadpool.h"
+
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -26,4 +31,47 @@ Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logg
   return status;
 }
 
+Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logger& logger,
+                               concurrency::ThreadPool* subgraph_thread_pool) const {
+  std::vector<Graph*> subgraphs;
+  if (CanTransformSubgraphsInParallel() &&
+      concurrency::ThreadPool::DegreeOfParallelism(subgraph_thread_pool) > 1) {
+    for (auto& node : graph.Nodes()) {
+      for (auto& entry : node.GetAttributeNameToMutableSubgraphMap()) {
+        subgraphs.push_back(entry.second);
+      }
+    }
+  }
+
+  if (subgraphs.size() < 2) {
+    return Apply(graph, modified, logger);
+  }
+
+  // the subgraphs only share the outer scope, which isn't modified until they are all transformed
+  std::vector<Status> statuses(subgraphs.size());
+  std::vector<char> subgraph_modified(subgraphs.size(), 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      subgraph_thread_pool, static_cast<std::ptrdiff_t>(subgraphs.size()), [&](std::ptrdiff_t i) {
+        bool is_modified = false;
+        ORT_TRY {
+          statuses[i] = ApplyImpl(*subgraphs[i], is_modified, 1, logger);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "GraphTransformer ", Name(), " failed: ", ex.what());
+          });
+        }
+        subgraph_modified[i] = is_modified;
+      });
+
+  for (size_t i = 0; i < subgraphs.size(); ++i) {
+    ORT_RETURN_IF_ERROR(statuses[i]);
+    modified = modified || subgraph_modified[i] != 0;
+  }
+
+  subgraphs_transformed_ = true;
+  auto reset_subgraphs_transformed = gsl::finally([this]() { subgraphs_transformed_ = false; });
+  return Apply(graph, modified, logger);
+}
+
 }  // namespace onnxruntime
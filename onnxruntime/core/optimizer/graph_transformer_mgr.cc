@@ -40,7 +40,7 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
         continue;
 
       bool modified = false;
-      ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
+      ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger, subgraph_thread_pool_));
       graph_changed = graph_changed || modified;
       _is_graph_modified = _is_graph_modified || modified;
     }
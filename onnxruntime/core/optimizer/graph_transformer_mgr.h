@@ -34,6 +34,12 @@ class GraphTransformerManager {
     return check_load_cancellation_fn_ && check_load_cancellation_fn_();
   }
 
+  // Set the thread pool the transformers that support it use to transform the subgraphs of the main graph in
+  // parallel. nullptr, the default, transforms them on the calling thread.
+  void SetSubgraphThreadPool(concurrency::ThreadPool* thread_pool) noexcept {
+    subgraph_thread_pool_ = thread_pool;
+  }
+
   // Register a transformer with a level.
   common::Status Register(std::unique_ptr<GraphTransformer> transformer, TransformerLevel level);
 
@@ -54,6 +60,7 @@ class GraphTransformerManager {
   InlinedHashMap<TransformerLevel, InlinedVector<std::unique_ptr<GraphTransformer>>> level_to_transformer_map_;
   InlinedHashMap<std::string, GraphTransformer*> transformers_info_;
   CheckLoadCancellationFn check_load_cancellation_fn_;
+  concurrency::ThreadPool* subgraph_thread_pool_ = nullptr;
   mutable bool _is_graph_modified = false;
 };
 }  // namespace onnxruntime
@@ -36,6 +36,10 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/dynamic_quantize_gru_transformer.h"
+#include "core/optimizer/dynamic_quantize_matmul_transformer.h"
+#include "core/optimizer/embedding_bag_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
@@ -51,12 +55,14 @@
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/label_encoder_fusion.h"
 #include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/loop_unrolling.h"
 #include "core/optimizer/matmul_activation_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/matmul_bn_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
+#include "core/optimizer/multi_reduce_fusion.h"
 #include "core/optimizer/nchwc_transformer.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
@@ -77,8 +83,11 @@
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rocm_blas_alt_impl.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/scaled_dot_product_attention_fusion.h"
+#include "core/optimizer/scaler_linear_fusion.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_sharding.h"
 #include "core/optimizer/transpose_optimizer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #ifdef ENABLE_TRAINING
@@ -144,6 +153,7 @@ InlinedVector<std::unique_ptr<RewriteRule>> GenerateRewriteRules(
       rules.push_back(std::make_unique<PadFusion>());
       rules.push_back(std::make_unique<MatmulBNFusion>());
       rules.push_back(std::make_unique<LabelEncoderFusion>());
+      rules.push_back(std::make_unique<ScalerLinearFusion>());
       break;
 
     case TransformerLevel::Level2:
@@ -236,6 +246,13 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
         transformers.emplace_back(std::make_unique<DoubleQDQPairsRemover>());
       }
 
+      // Unroll before ConstantSharing, CSE and ConstantFolding so they can work across the iterations of the Loop.
+      const int64_t loop_unroll_max_trip_count = ParseStringWithClassicLocale<int64_t>(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsLoopUnrollMaxTripCount, "0"));
+      if (loop_unroll_max_trip_count > 0) {
+        transformers.emplace_back(std::make_unique<LoopUnrolling>(loop_unroll_max_trip_count));
+      }
+
       // Put ConstantSharing before CommonSubexpressionElimination by intention as it can create more opportunities for
       // CSE. For example, if A and B nodes consume different initializers with same value, by default,
       // CSE will not merge them.
@@ -360,6 +377,7 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<LayerNormFusion>(cpu_acl_cuda_dml_rocm_eps, level));
       transformers.emplace_back(std::make_unique<SimplifiedLayerNormFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<AttentionFusion>(cpu_acl_cuda_dml_rocm_eps));
+      transformers.emplace_back(std::make_unique<ScaledDotProductAttentionFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<EmbedLayerNormFusion>(cpu_acl_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherSliceToSplitFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherToSliceFusion>(cpu_cuda_rocm_eps));
@@ -373,6 +391,19 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<FastGeluFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<QuickGeluFusion>(cpu_acl_cuda_dml_rocm_eps));
 
+      // shards the blocks the fusions above produced, e.g. Attention and BiasGelu.
+      const int64_t tensor_parallel_world_size = ParseStringWithClassicLocale<int64_t>(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelWorldSize, "1"));
+      if (tensor_parallel_world_size > 1) {
+        const int64_t tensor_parallel_rank = ParseStringWithClassicLocale<int64_t>(
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelRank, "0"));
+        ORT_ENFORCE(0 <= tensor_parallel_rank && tensor_parallel_rank < tensor_parallel_world_size,
+                    "Invalid tensor parallel rank ", tensor_parallel_rank, " for world size ",
+                    tensor_parallel_world_size);
+        transformers.emplace_back(std::make_unique<TensorParallelSharding>(tensor_parallel_rank,
+                                                                           tensor_parallel_world_size, cuda_eps));
+      }
+
       // GeluApproximation has side effects which may change results. It needs to be manually enabled,
       // or alternatively the model can be updated offline using a model conversion script
       //   e.g. fusion_gelu_approximation function used by onnxruntime/python/tools/transformers/onnx_model_bert.py
@@ -398,6 +429,12 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
       transformers.emplace_back(std::make_unique<MatMulScaleFusion>(cpu_acl_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<MatMulActivationFusion>(dml_ep));
+      // accumulates embedding lookups into their bags, before MultiReduceFusion can take the reductions.
+      transformers.emplace_back(std::make_unique<EmbeddingBagFusion>(cpu_ep));
+      // collapses the elementwise chains left over by the pattern-specific fusions above.
+      transformers.emplace_back(std::make_unique<ElementwiseChainFusion>(cpu_ep));
+      // computes sibling reductions of the same input in one pass.
+      transformers.emplace_back(std::make_unique<MultiReduceFusion>(cpu_ep));
 
 #ifdef MLAS_TARGET_AMD64_IX86
       if (avx2_precision_mode) {
@@ -407,6 +444,25 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
       transformers.emplace_back(std::make_unique<MatMulNBitsFusion>(cpu_ep));
 
+      // runs after the fusions above, which consume float MatMuls.
+      const float dynamic_quantize_matmul_tolerance = ParseStringWithClassicLocale<float>(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsDynamicQuantizeMatMulTolerance, "0"));
+      const float dynamic_quantize_gru_tolerance = ParseStringWithClassicLocale<float>(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsDynamicQuantizeGRUTolerance, "0"));
+#ifdef MLAS_TARGET_AMD64_IX86
+      const bool weight_is_unsigned = MlasPlatformU8S8Overflow();
+#else
+      const bool weight_is_unsigned = false;
+#endif
+      if (dynamic_quantize_matmul_tolerance > 0.0f) {
+        transformers.emplace_back(std::make_unique<DynamicQuantizeMatMulTransformer>(
+            dynamic_quantize_matmul_tolerance, weight_is_unsigned, cpu_ep));
+      }
+      if (dynamic_quantize_gru_tolerance > 0.0f) {
+        transformers.emplace_back(std::make_unique<DynamicQuantizeGRUTransformer>(
+            dynamic_quantize_gru_tolerance, weight_is_unsigned, cpu_ep));
+      }
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
       // The QDQFinalCleanupTransformer must run AFTER other transformers that fuse Q/DQ nodes. Otherwise, their
       // fusions might be prevented if this one removes a Q/DQ node too early.
@@ -416,14 +472,18 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
     case TransformerLevel::Level3: {
 #ifndef DISABLE_CONTRIB_OPS
-      // Register the NCHWc layout transformer if supported by the platform.
-      if (MlasNchwcGetBlockSize() > 1) {
+      const bool enable_fp32_nhwc =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableFp32NhwcLayout, "0") == "1";
+
+      // Register the NCHWc layout transformer if supported by the platform. The float convolutions run in NHWC
+      // instead when enabled.
+      if (MlasNchwcGetBlockSize() > 1 && !enable_fp32_nhwc) {
         transformers.emplace_back(std::make_unique<NchwcTransformer>());
       }
 
       auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
       auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
-                                                                logger);
+                                                                logger, enable_fp32_nhwc);
       if (nhwc_transformer->IsActive()) {
         transformers.emplace_back(std::move(nhwc_transformer));
       }
@@ -518,8 +578,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformersForMinimalB
 #ifndef DISABLE_CONTRIB_OPS
         AllocatorPtr cpu_allocator = CPUAllocator::DefaultInstance();
         auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
+        const bool enable_fp32_nhwc =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableFp32NhwcLayout, "0") == "1";
         auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
-                                                                  logger);
+                                                                  logger, enable_fp32_nhwc);
         if (nhwc_transformer->IsActive()) {
           transformers.emplace_back(std::move(nhwc_transformer));
         }
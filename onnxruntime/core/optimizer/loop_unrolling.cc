@@ -0,0 +1,385 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/loop_unrolling.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/node_attr_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// Largest number of nodes that the copies of a Loop body add to the graph.
+constexpr int64_t kMaxUnrolledNodes = 4096;
+
+// The value of a constant initializer with a single element of type T, if arg is one.
+template <typename T>
+std::optional<T> GetConstantScalar(const Graph& graph, const NodeArg& arg, TensorProto_DataType data_type) {
+  const auto* proto = graph_utils::GetConstantInitializer(graph, arg.Name());
+  if (proto == nullptr || proto->data_type() != data_type) {
+    return std::nullopt;
+  }
+
+  Initializer initializer{graph, *proto, graph.ModelPath(), /*check_outer_scope*/ true};
+  const auto data = initializer.DataAsSpan<T>();
+  if (data.size() != 1) {
+    return std::nullopt;
+  }
+  return data[0];
+}
+
+template <typename T>
+NodeArg& AddScalarInitializer(Graph& graph, const std::string& base_name, TensorProto_DataType data_type,
+                              T value, bool is_rank_1) {
+  const int64_t rank_1_dims[] = {1};
+  Initializer initializer{data_type, graph.GenerateNodeArgName(base_name),
+                          is_rank_1 ? gsl::span<const int64_t>(rank_1_dims) : gsl::span<const int64_t>()};
+  initializer.MutableDataAsSpan<T>()[0] = value;
+  TensorProto proto;
+  initializer.ToProto(proto);
+  return graph_utils::AddInitializerWithExternalData(graph, proto);
+}
+
+bool IsRank1(const NodeArg& arg) {
+  return arg.Shape() != nullptr && arg.Shape()->dim_size() == 1;
+}
+
+// Copies an initializer of the body into graph, under a name that is unique in graph.
+NodeArg& CopyInitializer(Graph& graph, const Graph& body, const TensorProto& body_initializer) {
+  Initializer initializer{body, body_initializer, body.ModelPath()};
+  TensorProto proto;
+  initializer.ToProto(proto);
+  proto.set_name(graph.GenerateNodeArgName(body_initializer.name()));
+  return graph_utils::AddInitializerWithExternalData(graph, proto);
+}
+
+}  // namespace
+
+bool LoopUnrolling::HoistLoopInvariantNodes(Graph& graph, const Node& loop, Graph& body) const {
+  InlinedHashSet<std::string_view> body_values;
+  for (const auto* arg : body.GetInputs()) {
+    body_values.insert(arg->Name());
+  }
+
+  InlinedHashSet<std::string_view> body_outputs;
+  for (const auto* arg : body.GetOutputs()) {
+    body_outputs.insert(arg->Name());
+  }
+
+  // the hoisted nodes keep the names of their outputs, so the body consumes them as outer scope values.
+  InlinedHashSet<std::string> hoisted_values;
+  InlinedHashMap<std::string, NodeArg*> copied_initializers;
+  bool modified = false;
+
+  GraphViewer body_viewer(body);
+  for (auto node_index : body_viewer.GetNodesInTopologicalOrder()) {
+    Node* node = body.GetNode(node_index);
+    if (node == nullptr || node->ContainsSubgraph() ||
+        !optimizer_utils::IsOperationDeterministic(node->Domain(), node->OpType())) {
+      continue;
+    }
+
+    auto is_invariant = [&](const NodeArg* input) {
+      const auto& name = input->Name();
+      if (!input->Exists() || hoisted_values.count(name) > 0) {
+        return true;
+      }
+      if (body_values.count(name) > 0 || body.GetProducerNode(name) != nullptr) {
+        return false;
+      }
+      // a constant initializer of the body, or a value from an outer scope
+      return body.IsInitializedTensor(name) ? graph_utils::IsConstantInitializer(body, name, false)
+                                            : graph.GetNodeArgIncludingParentGraphs(name) != nullptr;
+    };
+
+    auto can_keep_name = [&](const NodeArg* output) {
+      return !output->Exists() || (body_outputs.count(output->Name()) == 0 &&
+                                   graph.GetNodeArgIncludingParentGraphs(output->Name()) == nullptr);
+    };
+
+    const auto& input_defs = node->InputDefs();
+    const auto& output_defs = node->OutputDefs();
+    if (!std::all_of(input_defs.begin(), input_defs.end(), is_invariant) ||
+        !std::all_of(output_defs.begin(), output_defs.end(), can_keep_name)) {
+      continue;
+    }
+
+    InlinedVector<NodeArg*> inputs;
+    inputs.reserve(input_defs.size());
+    for (const auto* input : input_defs) {
+      const auto& name = input->Name();
+      const TensorProto* initializer = nullptr;
+      if (!input->Exists()) {
+        inputs.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+      } else if (hoisted_values.count(name) == 0 && body.GetInitializedTensor(name, initializer)) {
+        // the body keeps its initializer for its other consumers
+        auto [it, inserted] = copied_initializers.try_emplace(name, nullptr);
+        if (inserted) {
+          it->second = &CopyInitializer(graph, body, *initializer);
+        }
+        inputs.push_back(it->second);
+      } else {
+        inputs.push_back(&graph.GetOrCreateNodeArg(name, input->TypeAsProto()));
+      }
+    }
+
+    InlinedVector<NodeArg*> outputs;
+    outputs.reserve(output_defs.size());
+    for (const auto* output : output_defs) {
+      outputs.push_back(&graph.GetOrCreateNodeArg(output->Name(), output->TypeAsProto()));
+      if (output->Exists()) {
+        hoisted_values.insert(output->Name());
+        body.AddOuterScopeNodeArg(output->Name());
+      }
+    }
+
+    Node& hoisted = graph.AddNode(graph.GenerateNodeName(node->Name()), node->OpType(),
+                                  "Loop invariant node hoisted by LoopUnrolling", inputs, outputs,
+                                  &node->GetAttributes(), node->Domain());
+    hoisted.SetExecutionProviderType(loop.GetExecutionProviderType());
+
+    graph_utils::RemoveNodeOutputEdges(body, *node);
+    body.RemoveNode(node->Index());
+    modified = true;
+  }
+
+  return modified;
+}
+
+bool LoopUnrolling::UnrollLoop(Graph& graph, Node& loop, const Graph& body, const logging::Logger& logger) const {
+  const auto& loop_inputs = loop.InputDefs();
+  const auto& loop_outputs = loop.OutputDefs();
+  const auto& body_inputs = body.GetInputs();
+  const auto& body_outputs = body.GetOutputs();
+
+  if (loop_inputs.size() < 2 || !loop_inputs[0]->Exists()) {
+    return false;
+  }
+
+  const auto trip_count = GetConstantScalar<int64_t>(graph, *loop_inputs[0], TensorProto_DataType_INT64);
+  if (!trip_count || *trip_count <= 0 || *trip_count > max_trip_count_ ||
+      *trip_count * body.NumberOfNodes() > kMaxUnrolledNodes) {
+    return false;
+  }
+
+  const bool has_cond = loop_inputs[1]->Exists();
+  if (has_cond) {
+    const auto cond = GetConstantScalar<bool>(graph, *loop_inputs[1], TensorProto_DataType_BOOL);
+    if (!cond || !*cond) {
+      return false;
+    }
+  }
+
+  const size_t num_loop_carried_vars = loop_inputs.size() - 2;
+  if (body_inputs.size() != num_loop_carried_vars + 2 || body_outputs.size() != loop_outputs.size() + 1) {
+    return false;
+  }
+
+  // the body must not exit early: its condition output is the condition input, an Identity of it, or constant true
+  const NodeArg& cond_in = *body_inputs[1];
+  const NodeArg& cond_out = *body_outputs[0];
+  const Node* cond_producer = body.GetProducerNode(cond_out.Name());
+  bool never_exits = false;
+  if (cond_out.Name() == cond_in.Name()) {
+    never_exits = true;
+  } else if (cond_producer != nullptr) {
+    never_exits = cond_producer->OpType() == "Identity" && cond_producer->InputDefs()[0]->Name() == cond_in.Name();
+  } else {
+    const auto cond = GetConstantScalar<bool>(body, cond_out, TensorProto_DataType_BOOL);
+    never_exits = cond && *cond;
+  }
+  if (!never_exits) {
+    return false;
+  }
+
+  for (size_t i = 0; i < num_loop_carried_vars; ++i) {
+    const auto* type = body_inputs[i + 2]->TypeAsProto();
+    if (!loop_inputs[i + 2]->Exists() || type == nullptr || !type->has_tensor_type()) {
+      return false;
+    }
+  }
+
+  GraphViewer body_viewer(body);
+  const auto& body_nodes = body_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : body_nodes) {
+    if (body.GetNode(node_index)->ContainsSubgraph()) {
+      return false;
+    }
+  }
+
+  const auto& domain_to_version = graph.DomainToVersionMap();
+  const auto onnx_opset = domain_to_version.find(kOnnxDomain);
+  if (onnx_opset == domain_to_version.end()) {
+    return false;
+  }
+
+  const std::string loop_name = loop.Name().empty() ? std::string{"Loop"} : loop.Name();
+  const std::string& provider = loop.GetExecutionProviderType();
+
+  // the values of the body for the current iteration, by their name in the body
+  InlinedHashMap<std::string, NodeArg*> values;
+  InlinedHashMap<std::string, NodeArg*> copied_initializers;
+  auto get_value = [&](const NodeArg& arg) -> NodeArg* {
+    const auto& name = arg.Name();
+    if (!arg.Exists()) {
+      return &graph.GetOrCreateNodeArg("", nullptr);
+    }
+    if (auto it = values.find(name); it != values.end()) {
+      return it->second;
+    }
+    if (auto it = copied_initializers.find(name); it != copied_initializers.end()) {
+      return it->second;
+    }
+    const TensorProto* initializer = nullptr;
+    if (body.GetInitializedTensor(name, initializer)) {
+      return copied_initializers.emplace(name, &CopyInitializer(graph, body, *initializer)).first->second;
+    }
+    // a value from an outer scope
+    return &graph.GetOrCreateNodeArg(name, arg.TypeAsProto());
+  };
+
+  NodeArg* cond_value = has_cond ? loop_inputs[1]
+                                 : &AddScalarInitializer<bool>(graph, loop_name + "_cond", TensorProto_DataType_BOOL,
+                                                               true, IsRank1(cond_in));
+  InlinedVector<NodeArg*> loop_carried_values(loop_inputs.begin() + 2, loop_inputs.end());
+  std::vector<InlinedVector<NodeArg*>> scan_values(loop_outputs.size() - num_loop_carried_vars);
+
+  for (int64_t iter = 0; iter < *trip_count; ++iter) {
+    values.clear();
+    values[body_inputs[0]->Name()] = &AddScalarInitializer<int64_t>(graph, loop_name + "_iter_num",
+                                                                     TensorProto_DataType_INT64, iter,
+                                                                     IsRank1(*body_inputs[0]));
+    values[cond_in.Name()] = cond_value;
+    for (size_t i = 0; i < num_loop_carried_vars; ++i) {
+      values[body_inputs[i + 2]->Name()] = loop_carried_values[i];
+    }
+
+    const std::string node_prefix = loop_name + "_iter_" + std::to_string(iter) + "_";
+    for (auto node_index : body_nodes) {
+      const Node& node = *body.GetNode(node_index);
+
+      InlinedVector<NodeArg*> inputs;
+      inputs.reserve(node.InputDefs().size());
+      for (const auto* input : node.InputDefs()) {
+        inputs.push_back(get_value(*input));
+      }
+
+      InlinedVector<NodeArg*> outputs;
+      outputs.reserve(node.OutputDefs().size());
+      for (const auto* output : node.OutputDefs()) {
+        if (!output->Exists()) {
+          outputs.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+          continue;
+        }
+        NodeArg& value = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output->Name()), output->TypeAsProto());
+        outputs.push_back(&value);
+        values[output->Name()] = &value;
+      }
+
+      Node& copy = graph.AddNode(graph.GenerateNodeName(node_prefix + node.Name()), node.OpType(),
+                                 "Loop body node unrolled by LoopUnrolling", inputs, outputs, &node.GetAttributes(),
+                                 node.Domain());
+      copy.SetExecutionProviderType(provider);
+    }
+
+    for (size_t i = 0; i < num_loop_carried_vars; ++i) {
+      loop_carried_values[i] = get_value(*body_outputs[i + 1]);
+    }
+    for (size_t i = 0; i < scan_values.size(); ++i) {
+      scan_values[i].push_back(get_value(*body_outputs[num_loop_carried_vars + i + 1]));
+    }
+  }
+
+  // the body is owned by the Loop, so it can only be removed once the copies are made
+  InlinedVector<NodeArg*> outputs(loop_outputs.begin(), loop_outputs.end());
+  graph_utils::RemoveNodeOutputEdges(graph, loop);
+  graph.RemoveNode(loop.Index());
+
+  for (size_t i = 0; i < num_loop_carried_vars; ++i) {
+    if (outputs[i]->Exists()) {
+      graph.AddNode(graph.GenerateNodeName(loop_name + "_final"), "Identity", "Final value of a Loop carried var",
+                    {loop_carried_values[i]}, {outputs[i]})
+          .SetExecutionProviderType(provider);
+    }
+  }
+
+  // each iteration adds a leading dimension to its scan output values, which are concatenated along it
+  NodeArg* axes = nullptr;
+  for (size_t i = 0; i < scan_values.size(); ++i) {
+    NodeArg* output = outputs[num_loop_carried_vars + i];
+    if (!output->Exists()) {
+      continue;
+    }
+
+    InlinedVector<NodeArg*> unsqueezed;
+    unsqueezed.reserve(scan_values[i].size());
+    for (NodeArg* value : scan_values[i]) {
+      NodeArg& unsqueezed_value = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output->Name()), nullptr);
+      unsqueezed.push_back(&unsqueezed_value);
+
+      if (onnx_opset->second >= 13) {
+        if (axes == nullptr) {
+          const int64_t axes_dims[] = {1};
+          Initializer axes_initializer{TensorProto_DataType_INT64, graph.GenerateNodeArgName(loop_name + "_axes"),
+                                       axes_dims};
+          TensorProto axes_proto;
+          axes_initializer.ToProto(axes_proto);
+          axes = &graph_utils::AddInitializerWithExternalData(graph, axes_proto);
+        }
+        graph.AddNode(graph.GenerateNodeName(loop_name + "_unsqueeze"), "Unsqueeze", "Loop scan output value",
+                      {value, axes}, {&unsqueezed_value})
+            .SetExecutionProviderType(provider);
+      } else {
+        NodeAttributes attributes;
+        utils::SetNodeAttribute(utils::MakeAttribute("axes", std::vector<int64_t>{0}), attributes);
+        graph.AddNode(graph.GenerateNodeName(loop_name + "_unsqueeze"), "Unsqueeze", "Loop scan output value",
+                      {value}, {&unsqueezed_value}, &attributes)
+            .SetExecutionProviderType(provider);
+      }
+    }
+
+    NodeAttributes attributes;
+    utils::SetNodeAttribute(utils::MakeAttribute("axis", int64_t{0}), attributes);
+    graph.AddNode(graph.GenerateNodeName(loop_name + "_concat"), "Concat", "Loop scan output",
+                  unsqueezed, {output}, &attributes)
+        .SetExecutionProviderType(provider);
+  }
+
+  LOGS(logger, VERBOSE) << "Unrolled the " << *trip_count << " iterations of Loop " << loop_name;
+  return true;
+}
+
+Status LoopUnrolling::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    // inner Loops are unrolled first, so their outer Loop no longer has a subgraph and can be unrolled too
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Loop", {1, 11, 13, 16, 19, 21, 23}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    Graph& body = *node.GetMutableGraphAttribute("body");
+    modified |= HoistLoopInvariantNodes(graph, node, body);
+    modified |= UnrollLoop(graph, node, body, logger);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
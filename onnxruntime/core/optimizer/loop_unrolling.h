@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class LoopUnrolling
+
+Rewrites Loop nodes so the other transformers can see across their iterations:
+- the nodes of the body that only consume constants, outer scope values and other such nodes are hoisted into the
+  graph of the Loop, so they run once rather than once per iteration.
+- a Loop with a constant trip count of at most max_trip_count, whose body can't exit early and has no subgraphs,
+  is replaced by a copy of its body per iteration. Its scan outputs are built with Unsqueeze and Concat.
+*/
+class LoopUnrolling : public GraphTransformer {
+ public:
+  explicit LoopUnrolling(int64_t max_trip_count,
+                         const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("LoopUnrolling", compatible_execution_providers),
+        max_trip_count_(max_trip_count) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool HoistLoopInvariantNodes(Graph& graph, const Node& loop, Graph& body) const;
+
+  // Removes the Loop from graph when it is unrolled.
+  bool UnrollLoop(Graph& graph, Node& loop, const Graph& body, const logging::Logger& logger) const;
+
+  const int64_t max_trip_count_;
+};
+
+}  // namespace onnxruntime
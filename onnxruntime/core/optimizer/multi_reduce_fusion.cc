@@ -0,0 +1,164 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/multi_reduce_fusion.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+#include "core/providers/common.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsFusibleReduceNode(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceSum", {1, 11, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMean", {1, 11, 13, 18}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceSumSquare", {1, 11, 13, 18}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceL1", {1, 11, 13, 18}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceL2", {1, 11, 13, 18}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMax", {1, 11, 12, 13, 18, 20}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMin", {1, 11, 12, 13, 18, 20});
+}
+
+// the reduction a node computes, which must match for nodes to be fused.
+struct ReduceAttributes {
+  // sorted, and non negative if the rank of the input is known.
+  InlinedVector<int64_t> axes;
+  int64_t keepdims;
+
+  bool operator==(const ReduceAttributes& other) const {
+    return keepdims == other.keepdims && axes == other.axes;
+  }
+};
+
+// Returns false if node can't be fused: it isn't a float reduction supported by MultiReduce, its axes are not
+// constant, or it is a no-op for empty axes.
+bool GetReduceAttributes(const Graph& graph, const Node& node,
+                         const InlinedHashSet<std::string_view>& compatible_providers, ReduceAttributes& attributes) {
+  if (!IsFusibleReduceNode(node) || !graph_utils::IsSupportedProvider(node, compatible_providers) ||
+      node.OutputDefs().size() != 1 || node.InputDefs().empty()) {
+    return false;
+  }
+
+  const NodeArg& input = *node.InputDefs()[0];
+  if (input.Type() == nullptr || *input.Type() != "tensor(float)") {
+    return false;
+  }
+
+  attributes.axes.clear();
+  if (!graph_utils::GetRepeatedNodeAttributeValues(node, "axes", attributes.axes) &&
+      node.InputDefs().size() > 1 && node.InputDefs()[1]->Exists()) {
+    const auto* axes_initializer = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+    if (axes_initializer == nullptr) {
+      return false;
+    }
+
+    Initializer axes{graph, *axes_initializer, graph.ModelPath()};
+    auto axes_values = axes.DataAsSpan<int64_t>();
+    attributes.axes.assign(axes_values.begin(), axes_values.end());
+  }
+
+  const auto* noop_with_empty_axes = graph_utils::GetNodeAttribute(node, "noop_with_empty_axes");
+  if (attributes.axes.empty() && noop_with_empty_axes != nullptr && noop_with_empty_axes->i() != 0) {
+    return false;
+  }
+
+  const auto* keepdims = graph_utils::GetNodeAttribute(node, "keepdims");
+  attributes.keepdims = keepdims == nullptr || keepdims->i() != 0 ? 1 : 0;
+
+  if (const auto* shape = input.Shape(); shape != nullptr) {
+    const int64_t rank = shape->dim_size();
+    for (auto& axis : attributes.axes) {
+      if (rank > 0 && (axis < -rank || axis >= rank)) {
+        return false;
+      }
+      axis = rank > 0 ? HandleNegativeAxis(axis, rank) : axis;
+    }
+  }
+
+  std::sort(attributes.axes.begin(), attributes.axes.end());
+  return true;
+}
+
+}  // namespace
+
+/**
+Rewrite sibling reductions of X, e.g. ReduceMean(X) and ReduceSumSquare(X) over the same axes, to MultiReduce.
+*/
+Status MultiReduceFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    ReduceAttributes attributes;
+    if (!GetReduceAttributes(graph, node, GetCompatibleExecutionProviders(), attributes)) {
+      continue;
+    }
+
+    // the first reduction of X in topological order collects its siblings, the others were removed with it.
+    NodeArg* input = node.MutableInputDefs()[0];
+    InlinedVector<std::reference_wrapper<Node>> nodes_to_fuse{node};
+    for (Node* consumer : graph.GetMutableConsumerNodes(input->Name())) {
+      ReduceAttributes consumer_attributes;
+      if (consumer == &node || consumer->InputDefs()[0] != input ||
+          consumer->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+          !GetReduceAttributes(graph, *consumer, GetCompatibleExecutionProviders(), consumer_attributes) ||
+          !(consumer_attributes == attributes)) {
+        continue;
+      }
+      nodes_to_fuse.emplace_back(*consumer);
+    }
+
+    if (nodes_to_fuse.size() < 2) {
+      continue;
+    }
+
+    std::vector<std::string> reduce_ops;
+    InlinedVector<NodeArg*> outputs;
+    for (Node& reduce_node : nodes_to_fuse) {
+      reduce_ops.push_back(reduce_node.OpType());
+      outputs.push_back(reduce_node.MutableOutputDefs()[0]);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "/MultiReduceFusion/"),
+                                     "MultiReduce", "fused sibling reductions", std::array{input}, outputs, {},
+                                     kMSDomain);
+    fused_node.AddAttribute("reduce_ops", reduce_ops);
+    fused_node.AddAttribute("axes", std::vector<int64_t>(attributes.axes.begin(), attributes.axes.end()));
+    fused_node.AddAttribute("keepdims", attributes.keepdims);
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    for (const auto& edge : graph_utils::GraphEdge::GetNodeInputEdges(node, 0)) {
+      graph.AddEdge(edge.src_node, fused_node.Index(), edge.src_arg_index, 0);
+    }
+
+    for (size_t i = 0; i < nodes_to_fuse.size(); ++i) {
+      Node& reduce_node = nodes_to_fuse[i];
+      auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(reduce_node);
+      graph_utils::GraphEdge::RemoveGraphEdges(graph, output_edges);
+      for (const auto& edge : output_edges) {
+        graph.AddEdge(fused_node.Index(), edge.dst_node, static_cast<int>(i), edge.dst_arg_index);
+      }
+      graph.RemoveNode(reduce_node.Index());
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Rewrite float ReduceSum, ReduceMean, ReduceSumSquare, ReduceL1, ReduceL2, ReduceMax and ReduceMin nodes
+ * that reduce the same input over the same constant axes with the same keepdims to a single MultiReduce node, which
+ * computes all of them in one pass over the input, e.g. the ReduceMean and ReduceSumSquare of a normalization.
+ *
+ * It runs after the pattern-specific fusions so those keep precedence.
+ */
+class MultiReduceFusion : public GraphTransformer {
+ public:
+  MultiReduceFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MultiReduceFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
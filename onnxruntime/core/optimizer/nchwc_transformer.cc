@@ -112,6 +112,8 @@ class NchwcTransformerImpl {
   void CreateNchwcArgument(Node& node, Node& nchwc_node, int64_t channels, const NchwcArgument::Shape& shape);
   void FuseNchwcArgument(Node& node, const NchwcArgument& nchwc_arg);
   void InsertReorderInput(Node& node);
+  bool CanFuseConvSum(const NchwcArgument& nchwc_arg) const;
+  void FuseConvSum(Node& node, NchwcArgument& nchwc_arg, NodeArg* sum_nchwc_arg);
 
   void ConvPoolShapeInference(const Node& node,
                               const NchwcArgument::Shape& input_shape,
@@ -122,6 +124,7 @@ class NchwcTransformerImpl {
   void TransformConv(Node& node);
   void TransformPool(Node& node);
   void TransformBinary(Node& node, bool add_node);
+  void TransformResidualAdd(Node& node, size_t conv_input_index);
   void TransformConcat(Node& node);
   void TransformActivation(Node& node);
   void TransformBatchNormalization(Node& node);
@@ -593,6 +596,40 @@ Node& NchwcTransformerImpl::InsertReshape(NodeArg* input_arg,
   return reshape_node;
 }
 
+// Check if this is a single use NCHWc convolution that hasn't already been
+// fused with another Add/Sum node. The Add/Sum can also only be fused if the
+// convolution isn't itself fused with an activation.
+bool NchwcTransformerImpl::CanFuseConvSum(const NchwcArgument& nchwc_arg) const {
+  auto& nchwc_node = nchwc_arg.output_node_;
+  return (nchwc_node.OpType() == "Conv") && (nchwc_node.Domain() == kMSNchwcDomain) &&
+         (nchwc_node.InputDefs().size() < 4) && (nchwc_node.InputArgsCount().size() < 4) &&
+         (nchwc_arg.starting_original_uses_ == 1) &&
+         (graph_utils::GetNodeAttribute(nchwc_node, "activation") == nullptr);
+}
+
+// Feed the NCHWc sum input into the convolution that produces nchwc_arg and
+// remove the Add/Sum node. The convolution kernel may write its output in
+// place into the sum input buffer.
+void NchwcTransformerImpl::FuseConvSum(Node& node, NchwcArgument& nchwc_arg, NodeArg* sum_nchwc_arg) {
+  auto& nchwc_node = nchwc_arg.output_node_;
+  auto& nchwc_input_defs = nchwc_node.MutableInputDefs();
+  auto& nchwc_input_args_count = nchwc_node.MutableInputArgsCount();
+  size_t nchwc_input_defs_count = nchwc_input_defs.size();
+
+  nchwc_input_defs.resize(4);
+  nchwc_input_args_count.resize(4);
+  if (nchwc_input_defs_count < 3) {
+    // The optional bias parameter is empty so set to an empty string.
+    nchwc_input_defs[2] = &graph_.GetOrCreateNodeArg("", nullptr);
+    nchwc_input_args_count[2] = 1;
+  }
+  nchwc_input_defs[3] = sum_nchwc_arg;
+  nchwc_input_args_count[3] = 1;
+
+  FuseNchwcArgument(node, nchwc_arg);
+  removed_nodes_.push_front(node.Index());
+}
+
 void NchwcTransformerImpl::TransformBinary(Node& node, bool add_node) {
   auto& input_defs = node.MutableInputDefs();
   auto& output_defs = node.MutableOutputDefs();
@@ -604,6 +641,15 @@ void NchwcTransformerImpl::TransformBinary(Node& node, bool add_node) {
   for (size_t i = 0; i < input_defs_count; i++) {
     auto* nchwc_input = LookupNchwcArgument(input_defs[i]);
     if (nchwc_input == nullptr) {
+      // An Add of a NCHWc convolution and a tensor in NCHW format can still be
+      // fused if the tensor has already been reordered to NCHWc.
+      if (add_node && input_defs_count == 2) {
+        if (i == 1) {
+          TransformResidualAdd(node, 0);
+        } else if (LookupNchwcArgument(input_defs[1]) != nullptr) {
+          TransformResidualAdd(node, 1);
+        }
+      }
       return;
     }
     nchwc_inputs.push_back(nchwc_input);
@@ -659,32 +705,10 @@ void NchwcTransformerImpl::TransformBinary(Node& node, bool add_node) {
     // attempt to fuse the addition into the convolution itself.
     if (add_node && input_defs_count == 2) {
       for (size_t n = 0; n < 2; n++) {
-        auto* nchwc_input_n = nchwc_inputs[n];
-        auto& nchwc_node = nchwc_input_n->output_node_;
-        auto& nchwc_input_defs = nchwc_node.MutableInputDefs();
-        auto& nchwc_input_args_count = nchwc_node.MutableInputArgsCount();
-        size_t nchwc_input_defs_count = nchwc_input_defs.size();
-        // Check if this is a single use NCHWc convolution that hasn't already
-        // been fused with another Add/Sum node. The Add/Sum can also only be
-        // fused if the convolution isn't itself fused with an activation.
-        if ((nchwc_node.OpType() == "Conv") && (nchwc_node.Domain() == kMSNchwcDomain) &&
-            (nchwc_input_defs_count < 4) && (nchwc_input_args_count.size() < 4) &&
-            (nchwc_input_n->starting_original_uses_ == 1) &&
-            (graph_utils::GetNodeAttribute(nchwc_node, "activation") == nullptr)) {
+        if (CanFuseConvSum(*nchwc_inputs[n])) {
           // Feed the output of the other NCHWc node into the selected convolution
           // node.
-          nchwc_input_defs.resize(4);
-          nchwc_input_args_count.resize(4);
-          if (nchwc_input_defs_count < 3) {
-            // The optional bias parameter is empty so set to an empty string.
-            nchwc_input_defs[2] = &graph_.GetOrCreateNodeArg("", nullptr);
-            nchwc_input_args_count[2] = 1;
-          }
-          nchwc_input_defs[3] = nchwc_inputs[n ^ 1]->output_node_.MutableOutputDefs()[0];
-          nchwc_input_args_count[3] = 1;
-
-          FuseNchwcArgument(node, *nchwc_input_n);
-          removed_nodes_.push_front(node.Index());
+          FuseConvSum(node, *nchwc_inputs[n], nchwc_inputs[n ^ 1]->output_node_.MutableOutputDefs()[0]);
           return;
         }
       }
@@ -730,6 +754,64 @@ void NchwcTransformerImpl::TransformBinary(Node& node, bool add_node) {
   }
 }
 
+// Fuse an Add of a NCHWc convolution and a residual tensor in NCHW format,
+// such as the first block of a ResNet after a NCHW node. The residual is
+// usually also the input of the block, so it has already been reordered for
+// the convolutions of the block and that NCHWc tensor can be used as the sum
+// input instead of reordering the output of the convolution back to NCHW for
+// the Add.
+void NchwcTransformerImpl::TransformResidualAdd(Node& node, size_t conv_input_index) {
+  auto& input_defs = node.MutableInputDefs();
+  auto* nchwc_input = LookupNchwcArgument(input_defs[conv_input_index]);
+  auto* residual_arg = input_defs[conv_input_index ^ 1];
+
+  if (!CanFuseConvSum(*nchwc_input)) {
+    return;
+  }
+
+  // Only use an existing reorder of the residual, as reordering it just for
+  // the fusion costs as much as reordering the output of the convolution.
+  auto it = reorder_inputs_.find(residual_arg);
+  if (it == reorder_inputs_.end()) {
+    return;
+  }
+
+  // The residual must be a float tensor of exactly the output shape as the
+  // fused sum input is not broadcast.
+  const auto* residual_type = residual_arg->TypeAsProto();
+  if (residual_type == nullptr || !residual_type->has_tensor_type() ||
+      residual_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return;
+  }
+  auto* conv_output_shape = input_defs[conv_input_index]->Shape();
+  auto* residual_shape = residual_arg->Shape();
+  if ((conv_output_shape == nullptr) || (residual_shape == nullptr) ||
+      (conv_output_shape->dim_size() != kNchwcDims) || (residual_shape->dim_size() != kNchwcDims)) {
+    return;
+  }
+  for (int i = 0; i < kNchwcDims; i++) {
+    auto& conv_output_dim = conv_output_shape->dim(i);
+    auto& residual_dim = residual_shape->dim(i);
+    if (utils::HasDimValue(conv_output_dim) && utils::HasDimValue(residual_dim) &&
+        (conv_output_dim.dim_value() > 0) && (conv_output_dim.dim_value() == residual_dim.dim_value())) {
+      continue;
+    }
+    if (utils::HasDimParam(conv_output_dim) && utils::HasDimParam(residual_dim) &&
+        (conv_output_dim.dim_param() == residual_dim.dim_param())) {
+      continue;
+    }
+    return;
+  }
+
+  const auto& channels_dim = residual_shape->dim(1);
+  if (!utils::HasDimValue(channels_dim) || (channels_dim.dim_value() != nchwc_input->channels_)) {
+    return;
+  }
+
+  nchwc_input->remaining_original_uses_--;
+  FuseConvSum(node, *nchwc_input, it->second);
+}
+
 void NchwcTransformerImpl::TransformConcat(Node& node) {
   auto& input_defs = node.MutableInputDefs();
   auto& output_defs = node.MutableOutputDefs();
@@ -1155,6 +1237,12 @@ void NchwcTransformerImpl::Transform(Node& node) {
   } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MaxPool", {1, 8, 10, 11, 12}) ||
              graph_utils::IsSupportedOptypeVersionAndDomain(node, "AveragePool", {1, 7, 10, 11})) {
     TransformPool(node);
+  } else if (node.GetInputEdgesCount() <= 1 && node.InputDefs().size() == 2 &&
+             (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+              graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sum", {6, 8, 13}))) {
+    // An Add/Sum of a NCHWc convolution and a tensor in NCHW format still has
+    // the input edge from the node producing the NCHW tensor.
+    TransformBinary(node, true);
   } else if (node.GetInputEdgesCount() == 0 && node.InputDefs().size() != 0) {
     // The following transforms only run when the input edge count has already
     // been decremented to zero by earlier transforms. This is a hint that the
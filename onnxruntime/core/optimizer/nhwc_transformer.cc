@@ -46,8 +46,9 @@ NhwcConvLookup(
 
 NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator,
                                  std::shared_ptr<KernelRegistry> cpu_kernel_registry,
-                                 const logging::Logger& logger) noexcept
-    : GraphTransformer("NhwcTransformer"), cpu_allocator_(std::move(cpu_allocator)) {
+                                 const logging::Logger& logger,
+                                 bool enable_fp32) noexcept
+    : GraphTransformer("NhwcTransformer"), cpu_allocator_(std::move(cpu_allocator)), enable_fp32_(enable_fp32) {
   if (!cpu_kernel_registry) {
     // This is a CPU op nodes optimizer, not useful if cpu EP is not available.
     return;
@@ -167,6 +168,32 @@ NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator,
           OpTransformInfo{nhwc_gavgpool_fp16.op_type_, nhwc_gavgpool_fp16.domain_, nhwc_gavgpool_fp16.version_, false});
     }
   }
+
+  if (enable_fp32) {
+    // fp32 conv and pools -> fp32 nhwc conv and pools
+    const std::pair<std::string_view, OpKernelRegistryId> nhwc_fp32_ops[] = {
+        {"Conv", {"NhwcFusedConv", kMSDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}}},
+        {"MaxPool", {"MaxPool", kMSInternalNHWCDomain, 12, {{"T", {DataTypeImpl::GetTensorType<float>()}}}}},
+        {"AveragePool", {"AveragePool", kMSInternalNHWCDomain, 11, {{"T", {DataTypeImpl::GetTensorType<float>()}}}}},
+        {"GlobalAveragePool",
+         {"GlobalAveragePool", kMSInternalNHWCDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}}},
+    };
+
+    for (const auto& [op_type, nhwc_op] : nhwc_fp32_ops) {
+      const KernelCreateInfo* kernel_create_info{};
+      const auto status = cpu_kernel_registry->TryFindKernel(
+          kCpuExecutionProvider, nhwc_op.op_type_, nhwc_op.domain_,
+          nhwc_op.version_, nhwc_op.type_constraints_, logger, &kernel_create_info);
+      if (!status.IsOK() || kernel_create_info == nullptr) {
+        continue;
+      }
+      const OpTransformInfo transform_info{nhwc_op.op_type_, nhwc_op.domain_, nhwc_op.version_, false};
+      conv_table_.emplace(OpIdInfo(op_type, kOnnxDomain, api::DataType::FLOAT), transform_info);
+      if (op_type == "Conv") {
+        conv_table_.emplace(OpIdInfo("FusedConv", kMSDomain, api::DataType::FLOAT), transform_info);
+      }
+    }
+  }
 };
 
 Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
@@ -204,6 +231,12 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       continue;
     }
 
+    // Skip if a MaxPool also produces the indices, the NHWC kernels only produce the values
+    const auto outputs = node->Outputs();
+    if (outputs.size() > 1 && !outputs[1].empty()) {
+      continue;
+    }
+
     // Skip if unknown rank
     auto shape = NodeFromApiNode(*node).InputDefs()[0]->Shape();
     if (shape == nullptr) {
@@ -232,7 +265,24 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
   }
 
   if (modified) {
-    Optimize(*api_graph, kCpuExecutionProvider, OrtEPCostCheck, OrtExtendedHandlers());
+    CostCheckFn cost_check = OrtEPCostCheck;
+    if (enable_fp32_) {
+      // the float Resize kernel has a NHWC path for 4-D linear mode, so the layout transposes go through it too
+      cost_check = [](const api::GraphRef& graph, const api::NodeRef& node, const std::vector<int64_t>& perm,
+                      const std::unordered_set<std::string>& outputs_leading_to_transpose) {
+        if (node.IsOp("Resize") && node.GetExecutionProviderType() == kCpuExecutionProvider) {
+          auto X_value_info = graph.GetValueInfo(node.Inputs()[0]);
+          auto X_shape = X_value_info->Shape();
+          auto mode = node.GetAttributeString("mode");
+          if (X_value_info->DType() == api::DataType::FLOAT && X_shape && X_shape->size() == 4 &&
+              mode && *mode == "linear") {
+            return CostCheckResult::kPushTranspose;
+          }
+        }
+        return OrtEPCostCheck(graph, node, perm, outputs_leading_to_transpose);
+      };
+    }
+    Optimize(*api_graph, kCpuExecutionProvider, cost_check, OrtExtendedHandlers());
   }
 
   return Status::OK();
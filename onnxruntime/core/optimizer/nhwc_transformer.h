@@ -75,8 +75,12 @@ and inserts nodes to transpose tensors as needed.
 class NhwcTransformer : public GraphTransformer {
  private:
  public:
+  /**
+   * @param enable_fp32 whether the float Conv and pooling nodes are also converted, which is only faster than their
+   *                    NCHW(c) kernels when the whole model can stay channels last.
+   */
   explicit NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry,
-                           const logging::Logger& logger) noexcept;
+                           const logging::Logger& logger, bool enable_fp32 = false) noexcept;
 
   /**
    * @brief Usually called right after constructor, it shows whether
@@ -92,6 +96,7 @@ class NhwcTransformer : public GraphTransformer {
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
   AllocatorPtr cpu_allocator_;
+  bool enable_fp32_;
 
   /**
    * A mapping table to identify operators that need to be transformed, and map
@@ -0,0 +1,251 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/pattern_matcher.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+namespace onnxruntime {
+
+GraphPattern::GraphPattern(std::string op_type, std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> versions,
+                           std::string domain) {
+  AddNode(std::move(op_type), versions, std::move(domain));
+}
+
+int GraphPattern::AddNode(std::string op_type, std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> versions,
+                          std::string domain) {
+  PatternNode node;
+  node.op_type = std::move(op_type);
+  node.domain = std::move(domain);
+  node.versions.assign(versions.begin(), versions.end());
+  node.exclusive_outputs = !nodes_.empty();
+  nodes_.push_back(std::move(node));
+  return static_cast<int>(nodes_.size()) - 1;
+}
+
+int GraphPattern::AddInput(int consumer, int input_index, std::string op_type,
+                           std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> versions, std::string domain) {
+  ORT_ENFORCE(consumer >= 0 && static_cast<size_t>(consumer) < nodes_.size(), "Invalid pattern node ", consumer);
+  const int id = AddNode(std::move(op_type), versions, std::move(domain));
+  PatternNode& node = nodes_[id];
+  node.anchor = consumer;
+  node.is_producer = true;
+  node.anchor_slot = input_index;
+  return id;
+}
+
+int GraphPattern::AddOutput(int producer, int output_index, int input_index, std::string op_type,
+                            std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> versions, std::string domain) {
+  ORT_ENFORCE(producer >= 0 && static_cast<size_t>(producer) < nodes_.size(), "Invalid pattern node ", producer);
+  const int id = AddNode(std::move(op_type), versions, std::move(domain));
+  PatternNode& node = nodes_[id];
+  node.anchor = producer;
+  node.is_producer = false;
+  node.anchor_slot = output_index;
+  node.input_index = input_index;
+  return id;
+}
+
+GraphPattern& GraphPattern::AddEdge(int producer, int output_index, int consumer, int input_index) {
+  ORT_ENFORCE(static_cast<size_t>(std::max(producer, consumer)) < nodes_.size() && std::min(producer, consumer) >= 0,
+              "Invalid pattern nodes ", producer, " and ", consumer);
+  edges_.push_back({consumer, input_index, producer, output_index, false});
+  return *this;
+}
+
+GraphPattern& GraphPattern::AddSharedInput(int node, int input_index, int other, int other_input_index) {
+  ORT_ENFORCE(static_cast<size_t>(std::max(node, other)) < nodes_.size() && std::min(node, other) >= 0,
+              "Invalid pattern nodes ", node, " and ", other);
+  edges_.push_back({node, input_index, other, other_input_index, true});
+  return *this;
+}
+
+GraphPattern& GraphPattern::SetCommutative(int node) {
+  // the swaps of the commutative nodes are a bit mask of the node ids.
+  ORT_ENFORCE(node >= 0 && node < 64 && static_cast<size_t>(node) < nodes_.size(),
+              "Invalid commutative pattern node ", node);
+  if (!nodes_[node].commutative) {
+    nodes_[node].commutative = true;
+    commutative_nodes_.push_back(node);
+  }
+  return *this;
+}
+
+GraphPattern& GraphPattern::AddPredicate(int node, NodePredicate predicate) {
+  ORT_ENFORCE(node >= 0 && static_cast<size_t>(node) < nodes_.size(), "Invalid pattern node ", node);
+  nodes_[node].predicates.push_back(std::move(predicate));
+  return *this;
+}
+
+GraphPattern& GraphPattern::SetExclusiveOutputs(int node, bool exclusive) {
+  ORT_ENFORCE(node >= 0 && static_cast<size_t>(node) < nodes_.size(), "Invalid pattern node ", node);
+  nodes_[node].exclusive_outputs = exclusive;
+  return *this;
+}
+
+bool GraphPattern::MatchNode(const Graph& graph, const Node& node, int id) const {
+  const PatternNode& pattern_node = nodes_[id];
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, pattern_node.op_type, pattern_node.versions,
+                                                      pattern_node.domain)) {
+    return false;
+  }
+
+  return std::all_of(pattern_node.predicates.begin(), pattern_node.predicates.end(),
+                     [&graph, &node](const NodePredicate& predicate) { return predicate(graph, node); });
+}
+
+bool GraphPattern::Match(const Graph& graph, const Node& root, PatternMatch* match) const {
+  if (!MatchNode(graph, root, 0)) {
+    return false;
+  }
+
+  // Each node is reached through a single edge, so a match is found without backtracking once the order of the inputs
+  // of the commutative nodes is set, and the orders are tried in turn.
+  InlinedVector<NodeIndex> nodes;
+  const uint64_t num_orders = uint64_t{1} << commutative_nodes_.size();
+  for (uint64_t order = 0; order < num_orders; ++order) {
+    uint64_t swaps = 0;
+    for (size_t i = 0; i < commutative_nodes_.size(); ++i) {
+      if (((order >> i) & 1) != 0) {
+        swaps |= uint64_t{1} << commutative_nodes_[i];
+      }
+    }
+
+    if (MatchWithSwaps(graph, root, swaps, nodes)) {
+      if (match != nullptr) {
+        match->node_indices_ = std::move(nodes);
+        match->swaps_ = swaps;
+      }
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool GraphPattern::MatchWithSwaps(const Graph& graph, const Node& root, uint64_t swaps,
+                                  InlinedVector<NodeIndex>& nodes) const {
+  const auto input_index = [swaps](int id, int index) {
+    return ((swaps >> id) & 1) != 0 && index < 2 ? 1 - index : index;
+  };
+  const auto is_matched = [&nodes](NodeIndex index) {
+    return std::find(nodes.begin(), nodes.end(), index) != nodes.end();
+  };
+
+  nodes.assign(1, root.Index());
+  InlinedVector<const Node*> matched_nodes{&root};
+  for (size_t id = 1; id < nodes_.size(); ++id) {
+    const PatternNode& pattern_node = nodes_[id];
+    const Node& anchor = *matched_nodes[pattern_node.anchor];
+
+    const Node* node = nullptr;
+    if (pattern_node.is_producer) {
+      node = graph_utils::GetInputNode(anchor, input_index(pattern_node.anchor, pattern_node.anchor_slot));
+    } else {
+      for (auto it = anchor.OutputEdgesBegin(), end = anchor.OutputEdgesEnd(); it != end; ++it) {
+        if (it->GetSrcArgIndex() != pattern_node.anchor_slot) {
+          continue;
+        }
+
+        if (node != nullptr ||
+            it->GetDstArgIndex() != input_index(static_cast<int>(id), pattern_node.input_index)) {
+          return false;
+        }
+        node = &it->GetNode();
+      }
+    }
+
+    if (node == nullptr || is_matched(node->Index()) ||
+        node->GetExecutionProviderType() != root.GetExecutionProviderType() ||
+        !MatchNode(graph, *node, static_cast<int>(id))) {
+      return false;
+    }
+
+    nodes.push_back(node->Index());
+    matched_nodes.push_back(node);
+  }
+
+  for (const PatternEdge& edge : edges_) {
+    const auto& input_defs = matched_nodes[edge.node]->InputDefs();
+    const size_t index = static_cast<size_t>(input_index(edge.node, edge.input_index));
+    const auto& other_defs = edge.shared_input ? matched_nodes[edge.other]->InputDefs()
+                                               : matched_nodes[edge.other]->OutputDefs();
+    const size_t other_index = static_cast<size_t>(
+        edge.shared_input ? input_index(edge.other, edge.other_index) : edge.other_index);
+    if (index >= input_defs.size() || other_index >= other_defs.size() ||
+        !input_defs[index]->Exists() || input_defs[index] != other_defs[other_index]) {
+      return false;
+    }
+  }
+
+  for (size_t id = 0; id < nodes_.size(); ++id) {
+    if (!nodes_[id].exclusive_outputs) {
+      continue;
+    }
+
+    const Node& node = *matched_nodes[id];
+    if (graph.NodeProducesGraphOutput(node)) {
+      return false;
+    }
+
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      if (!is_matched(it->GetNode().Index())) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+GraphPattern::NodePredicate GraphPattern::AttributeEquals(const std::string& name, int64_t value) {
+  return [name, value](const Graph&, const Node& node) {
+    return optimizer_utils::IsAttributeWithExpectedValue(node, name, value);
+  };
+}
+
+GraphPattern::NodePredicate GraphPattern::AttributeEquals(const std::string& name, std::vector<int64_t> values) {
+  return [name, values = std::move(values)](const Graph&, const Node& node) {
+    return optimizer_utils::IsAttributeWithExpectedValues(node, name, values);
+  };
+}
+
+GraphPattern::NodePredicate GraphPattern::InputIsConstant(int input_index) {
+  return [input_index](const Graph& graph, const Node& node) {
+    const auto& input_defs = node.InputDefs();
+    return static_cast<size_t>(input_index) < input_defs.size() && input_defs[input_index]->Exists() &&
+           graph_utils::NodeArgIsConstant(graph, *input_defs[input_index]);
+  };
+}
+
+void PatternMatch::RemoveNodes(Graph& graph) const {
+  for (NodeIndex index : node_indices_) {
+    Node* node = graph.GetNode(index);
+    if (node != nullptr) {
+      graph_utils::RemoveNodeOutputEdges(graph, *node);
+      graph.RemoveNode(index);
+    }
+  }
+}
+
+bool PatternRewriteRule::SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger&) const {
+  return pattern_.Match(graph, node);
+}
+
+Status PatternRewriteRule::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect,
+                                 const logging::Logger& logger) const {
+  PatternMatch match;
+  ORT_RETURN_IF_NOT(pattern_.Match(graph, node, &match), "The pattern of ", Name(), " does not match ", node.Name());
+
+  const NodeIndex root_index = node.Index();
+  ORT_RETURN_IF_ERROR(rewrite_(graph, match, logger));
+
+  rule_effect = graph.GetNode(root_index) == nullptr ? RewriteRuleEffect::kRemovedCurrentNode
+                                                     : RewriteRuleEffect::kModifiedRestOfGraph;
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,182 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/common/inlined_containers.h"
+#include "core/graph/graph.h"
+#include "core/optimizer/rewrite_rule.h"
+
+namespace onnxruntime {
+
+class PatternMatch;
+
+/**
+@Class GraphPattern
+
+Declarative description of a subgraph, to write fusions without walking the edges by hand.
+
+A pattern is a tree of pattern nodes grown from the root, node 0, which the match starts from. Each other node is
+added as the producer of an input or the only consumer of an output of a node added before it, and gets the next id.
+Extra edges and shared inputs between existing nodes close diamonds, e.g. the x read by both the Mul and the Sigmoid of
+x * Sigmoid(x).
+
+A graph node matches a pattern node when its op type, domain and since version match and all the predicates of the
+pattern node accept it. The two inputs of a commutative pattern node, Add or Mul, match in either order.
+
+The match is rejected when two pattern nodes match the same graph node, when the nodes are assigned to different
+execution providers, or when an output of a node other than the root is a graph output or is consumed outside of the
+match, as the rewrite removes these nodes. SetExclusiveOutputs changes the latter per node.
+
+    GraphPattern pattern("Mul", {7, 13, 14});
+    const int sigmoid = pattern.AddInput(0, 1, "Sigmoid", {6, 13});
+    pattern.AddSharedInput(0, 0, sigmoid, 0).SetCommutative(0);  // Mul(x, Sigmoid(x)) or Mul(Sigmoid(x), x)
+*/
+class GraphPattern {
+ public:
+  using NodePredicate = std::function<bool(const Graph& graph, const Node& node)>;
+
+  GraphPattern(std::string op_type, std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> versions,
+               std::string domain = kOnnxDomain);
+
+  /** Adds the producer of input `input_index` of pattern node `consumer`.
+      @returns the id of the new pattern node. */
+  int AddInput(int consumer, int input_index, std::string op_type,
+               std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> versions, std::string domain = kOnnxDomain);
+
+  /** Adds the only consumer of output `output_index` of pattern node `producer`, reading it as its input
+      `input_index`.
+      @returns the id of the new pattern node. */
+  int AddOutput(int producer, int output_index, int input_index, std::string op_type,
+                std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> versions,
+                std::string domain = kOnnxDomain);
+
+  /** Requires input `input_index` of pattern node `consumer` to be output `output_index` of pattern node
+      `producer`. */
+  GraphPattern& AddEdge(int producer, int output_index, int consumer, int input_index);
+
+  /** Requires input `input_index` of pattern node `node` and input `other_input_index` of pattern node `other` to be
+      the same value, e.g. the x of x * Sigmoid(x). */
+  GraphPattern& AddSharedInput(int node, int input_index, int other, int other_input_index);
+
+  /** Lets inputs 0 and 1 of pattern node `node` match in either order. */
+  GraphPattern& SetCommutative(int node);
+
+  /** Adds a condition on the graph node matching pattern node `node`. The predicate sees the inputs of the graph
+      node in their order in the graph, even when they are swapped for a commutative node. */
+  GraphPattern& AddPredicate(int node, NodePredicate predicate);
+
+  /** Sets whether the outputs of pattern node `node` must only be consumed inside the match. True by default for
+      all nodes but the root, whose outputs the rewrite keeps. */
+  GraphPattern& SetExclusiveOutputs(int node, bool exclusive);
+
+  const std::string& RootOpType() const noexcept { return nodes_[0].op_type; }
+  size_t NumNodes() const noexcept { return nodes_.size(); }
+
+  /** Matches the pattern rooted at `root`.
+      @param match receives the matched nodes when not null. */
+  bool Match(const Graph& graph, const Node& root, PatternMatch* match = nullptr) const;
+
+  static NodePredicate AttributeEquals(const std::string& name, int64_t value);
+  static NodePredicate AttributeEquals(const std::string& name, std::vector<int64_t> values);
+  static NodePredicate InputIsConstant(int input_index);
+
+ private:
+  struct PatternNode {
+    std::string op_type;
+    std::string domain;
+    InlinedVector<ONNX_NAMESPACE::OperatorSetVersion> versions;
+    InlinedVector<NodePredicate> predicates;
+    bool commutative = false;
+    bool exclusive_outputs = true;
+
+    // How the node is reached from the node `anchor` added before it: as the producer of input `anchor_slot` of the
+    // anchor, or as the consumer of its output `anchor_slot` through input `input_index`. Unused for the root.
+    int anchor = -1;
+    bool is_producer = false;
+    int anchor_slot = 0;
+    int input_index = 0;
+  };
+
+  // Input `input_index` of `node` is output `other_index` of `other`, or its input `other_index` when `shared_input`.
+  struct PatternEdge {
+    int node;
+    int input_index;
+    int other;
+    int other_index;
+    bool shared_input;
+  };
+
+  int AddNode(std::string op_type, std::initializer_list<ONNX_NAMESPACE::OperatorSetVersion> versions,
+              std::string domain);
+  bool MatchNode(const Graph& graph, const Node& node, int id) const;
+  bool MatchWithSwaps(const Graph& graph, const Node& root, uint64_t swaps, InlinedVector<NodeIndex>& nodes) const;
+
+  InlinedVector<PatternNode> nodes_;
+  InlinedVector<PatternEdge> edges_;
+  InlinedVector<int> commutative_nodes_;
+};
+
+/**
+@Class PatternMatch
+
+The graph nodes matching the nodes of a GraphPattern, by pattern node id.
+*/
+class PatternMatch {
+ public:
+  NodeIndex GetNodeIndex(int id) const { return node_indices_[id]; }
+  Node& GetNode(Graph& graph, int id) const { return *graph.GetNode(node_indices_[id]); }
+
+  /** The index in the graph node of input `input_index` of pattern node `id`, which differs for swapped inputs of a
+      commutative node. */
+  int InputIndex(int id, int input_index) const {
+    return ((swaps_ >> id) & 1) != 0 && input_index < 2 ? 1 - input_index : input_index;
+  }
+
+  NodeArg* GetInput(Graph& graph, int id, int input_index) const {
+    return GetNode(graph, id).MutableInputDefs()[InputIndex(id, input_index)];
+  }
+
+  /** Removes all the matched nodes, once the rewrite has moved the outputs of the root to the replacement. */
+  void RemoveNodes(Graph& graph) const;
+
+ private:
+  friend class GraphPattern;
+
+  InlinedVector<NodeIndex> node_indices_;
+  uint64_t swaps_ = 0;  // bit `id` is set when the inputs 0 and 1 of commutative node `id` are swapped
+};
+
+/**
+@Class PatternRewriteRule
+
+Rewrite rule made of a GraphPattern, triggered on the nodes of the op type of its root, and a function rewriting the
+matched nodes. A RuleBasedGraphTransformer only matches a node against the rules targeting its op type, so any number
+of pattern rules registered in it are all applied in a single traversal of the graph.
+*/
+class PatternRewriteRule : public RewriteRule {
+ public:
+  /** Rewrites a complete match. The checks belong in the pattern predicates: the rewrite must modify the graph. */
+  using RewriteFn = std::function<Status(Graph& graph, const PatternMatch& match, const logging::Logger& logger)>;
+
+  PatternRewriteRule(const std::string& name, GraphPattern pattern, RewriteFn rewrite)
+      : RewriteRule(name), pattern_(std::move(pattern)), rewrite_(std::move(rewrite)) {}
+
+  std::vector<std::string> TargetOpTypes() const noexcept override {
+    return {pattern_.RootOpType()};
+  }
+
+ private:
+  bool SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const override;
+
+  Status Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect, const logging::Logger& logger) const override;
+
+  const GraphPattern pattern_;
+  const RewriteFn rewrite_;
+};
+
+}  // namespace onnxruntime
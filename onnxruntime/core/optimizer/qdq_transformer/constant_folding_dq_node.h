@@ -30,6 +30,9 @@ class ConstantFoldingDQ : public ConstantFolding {
 
   bool AllowConstantFolding(const Node& node) const override;
 
+  // node_index_set_ holds nodes of the graph the transformer is applied to, not of its subgraphs
+  bool CanTransformSubgraphsInParallel() const override { return false; }
+
  private:
   InlinedHashSet<NodeIndex> node_index_set_;
 };
@@ -93,6 +93,24 @@ std::vector<NodeAndMoveInfo> WhereMoves() {
       MoveAll(q, ArgType::kOutput)};
   return moves;
 }
+// moves for replacing a LayerNormalization node with DQ inputs with QLinearLayerNormalization
+std::vector<NodeAndMoveInfo> LayerNormalizationMoves() {
+  NTO::NodeLocation dq_x{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation dq_scale{NTO::NodeType::kInput, 1};
+  NTO::NodeLocation dq_bias{NTO::NodeType::kInput, 2};
+  NTO::NodeLocation q{NTO::NodeType::kOutput, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAll(dq_x, ArgType::kInput),                                     // append all inputs from x
+      MoveAll(dq_scale, ArgType::kInput),                                 // append all inputs from scale
+      MoveAndAppend(q, ArgType::kInput, 1, ArgType::kInput),              // append scale (input 1) from q
+      MoveAndAppend(q, ArgType::kInput, 2, ArgType::kInput),              // append zp (input 2) from q
+      MoveAndAppend(dq_bias, ArgType::kInput, 0, ArgType::kInput, true),  // (optional) append bias
+      MoveAndAppend(dq_bias, ArgType::kInput, 1, ArgType::kInput, true),  // (optional) append bias scale
+      MoveAll(q, ArgType::kOutput)};                                      // and use the outputs from q
+
+  return moves;
+}
 QDQReplaceWithNew SplitReplacer(bool has_split_as_input) {
   NTO::NodeLocation dq{NTO::NodeType::kInput, 0};
   NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
@@ -254,6 +272,9 @@ ConvReplaceWithQLinear::ConvReplaceWithQLinear()
 WhereReplaceWithQLinear::WhereReplaceWithQLinear()
     : ReplaceWithQLinear(kMSDomain, WhereMoves()) {
 }
+LayerNormalizationReplaceWithQLinear::LayerNormalizationReplaceWithQLinear()
+    : ReplaceWithQLinear(kMSDomain, LayerNormalizationMoves()) {
+}
 MatMulReplaceWithQLinear::MatMulReplaceWithQLinear()
     : matmul_int_to_float_replacer_{MatMulIntToFloatReplacer()},
       qlinear_matmul_replacer_{kOnnxDomain} {
@@ -485,6 +506,54 @@ static std::vector<NodeAndMoveInfo> GetGemmMoveInfo(bool does_q_node_exist) {
   return moves;
 }
 
+NodeAttributes
+DQGatherToGatherBlockQuantizedAction::ExtraAttributes(const RuntimeState& runtime_state) const {
+  NodeAttributes extra_attributes;
+
+  // the Gather "axis" attribute becomes "gather_axis", ProcessNewNode removes the copied "axis"
+  const auto& gather_attrs = runtime_state.selected_nodes.Target().GetAttributes();
+  const auto g_iter = gather_attrs.find("axis");
+  utils::SetNodeAttribute(utils::MakeAttribute("gather_axis", g_iter == gather_attrs.end() ? int64_t{0}
+                                                                                           : g_iter->second.i()),
+                          extra_attributes);
+
+  const auto* dq_node = runtime_state.selected_nodes.Input(0);
+  const auto& dq_attrs = dq_node->GetAttributes();
+  const auto q_iter = dq_attrs.find("axis");
+  utils::SetNodeAttribute(utils::MakeAttribute("quantize_axis", q_iter == dq_attrs.end() ? int64_t{1}
+                                                                                         : q_iter->second.i()),
+                          extra_attributes);
+  utils::SetNodeAttribute(utils::MakeAttribute("block_size", dq_attrs.at("block_size").i()), extra_attributes);
+
+  return extra_attributes;
+}
+
+std::vector<NodeAndMoveInfo>
+DQGatherToGatherBlockQuantizedAction::ValueMoves(const RuntimeState& runtime_state) const {
+  NTO::NodeLocation dq{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+
+  // data, indices, scales and the zero points if the DQ has them
+  std::vector<NodeAndMoveInfo> value_moves{
+      MoveAndAppend(dq, ArgType::kInput, 0, ArgType::kInput),
+      MoveAndAppend(target, ArgType::kInput, 1, ArgType::kInput),
+      MoveAndAppend(dq, ArgType::kInput, 1, ArgType::kInput)};
+
+  const auto& dq_inputs = runtime_state.selected_nodes.Input(0)->InputDefs();
+  if (dq_inputs.size() > 2 && dq_inputs[2]->Exists()) {
+    value_moves.push_back(MoveAndAppend(dq, ArgType::kInput, 2, ArgType::kInput));
+  }
+
+  value_moves.push_back(MoveAll(target, ArgType::kOutput));
+  return value_moves;
+}
+
+Status DQGatherToGatherBlockQuantizedAction::ProcessNewNode(Graph&, const NodesToOptimize&,
+                                                            Node& replacement_node) const {
+  replacement_node.ClearAttribute("axis");
+  return Status::OK();
+}
+
 GemmReplaceWithQuant::GemmReplaceWithQuant()
     : qgemm_with_float_as_output_replacer_(kMSDomain, "QGemm", GetGemmMoveInfo(false)),
       qgemm_with_8bits_as_output_replacer_(kMSDomain, "QGemm", GetGemmMoveInfo(true)) {
@@ -69,6 +69,9 @@ struct ConvReplaceWithQLinear : ReplaceWithQLinear {
 struct WhereReplaceWithQLinear : ReplaceWithQLinear {
   WhereReplaceWithQLinear();
 };
+struct LayerNormalizationReplaceWithQLinear : ReplaceWithQLinear {
+  LayerNormalizationReplaceWithQLinear();
+};
 struct SplitReplaceWithQuant : public Action {
   Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
 };
@@ -107,6 +110,23 @@ struct DQMatMulToMatMulNBitsAction : public ReplaceWithNew {
   concurrency::ThreadPool* intra_op_thread_pool_;
 };
 
+// used together with DQGatherNodeGroupSelector, which does the sanity check
+struct DQGatherToGatherBlockQuantizedAction : public ReplaceWithNew {
+  DQGatherToGatherBlockQuantizedAction() = default;
+
+ private:
+  std::string OpType(const RuntimeState&) const override { return "GatherBlockQuantized"; }
+
+  std::string Domain(const RuntimeState&) const override { return kMSDomain; }
+
+  NodeAttributes ExtraAttributes(const RuntimeState&) const override;
+
+  std::vector<NodeAndMoveInfo> ValueMoves(const RuntimeState&) const override;
+
+  // remove the Gather "axis" attribute copied to the new node
+  Status ProcessNewNode(Graph&, const NodesToOptimize&, Node&) const override;
+};
+
 struct GemmReplaceWithQuant : public Action {
   GemmReplaceWithQuant();
 
@@ -305,6 +305,27 @@ void DQMatMulToMatMulNBitsRules(SelectorActionRegistry& qdq_selector_action_regi
 #endif
 }
 
+void DQGatherToGatherBlockQuantizedRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 2 nodes. DQ -> Gather. DQ is the data input to Gather.
+  // DQ's weight is int4/uint4. DQ's scale is float/float16.
+  // DQ is block-quantized along any axis, with block_size >= 16 and as 2's power.
+  const std::string action_name{"DQGatherToGatherBlockQuantized"};
+
+  std::unique_ptr<Action> action = std::make_unique<QDQ::DQGatherToGatherBlockQuantizedAction>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::vector<const char*> providers = {kCpuExecutionProvider};
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::DQGatherToGatherBlockQuantizedSelector>(providers);
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"Gather", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 void GemmQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
   // 3 to 5 nodes. 0=DQ A, 1=DQ B, 2=DQ C(optional), 3=Gemm, 4=Q Y(optional)
   // Replace with QGemm
@@ -348,6 +369,26 @@ void WhereQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
 #endif
 }
 
+void LayerNormalizationQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 4 or 5 nodes. 0=DQ X, 1=DQ Scale, 2=DQ B (optional), 3=LayerNormalization, 4=Q
+  // Replace with QLinearLayerNormalization
+  // Delete all original nodes.
+  const std::string action_name{"LayerNormalization"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::LayerNormalizationReplaceWithQLinear>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::vector<const char*> providers = {kCpuExecutionProvider};
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::LayerNormalizationSelector>(providers);
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"LayerNormalization", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 SelectorActionRegistry CreateSelectorActionRegistry(
     bool is_int8_allowed,
     int64_t qdq_matmulnbits_accuracy_level,
@@ -363,9 +404,11 @@ SelectorActionRegistry CreateSelectorActionRegistry(
   MatMulQDQRules(qdq_selector_action_registry, is_int8_allowed);
   GemmQDQRules(qdq_selector_action_registry);
   WhereQDQRules(qdq_selector_action_registry);
+  LayerNormalizationQDQRules(qdq_selector_action_registry);
   DQMatMulToMatMulNBitsRules(qdq_selector_action_registry,
                              qdq_matmulnbits_accuracy_level,
                              intra_op_thread_pool);
+  DQGatherToGatherBlockQuantizedRules(qdq_selector_action_registry);
 
   return qdq_selector_action_registry;
 }
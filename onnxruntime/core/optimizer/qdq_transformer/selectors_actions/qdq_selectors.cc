@@ -5,6 +5,9 @@
 
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selectors.h"
 
+#include <algorithm>
+#include <optional>
+
 #include "core/graph/graph.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/qdq_transformer/qdq_util.h"
@@ -32,6 +35,76 @@ int NumActualValues(const Node& node, bool input) {
       std::count_if(defs.cbegin(), defs.cend(), [](const NodeArg* def) { return def && def->Exists(); }));
 }
 
+// Checks that a DQ node dequantizes constant int4/uint4 weights blockwise to float or float16, with a block_size that
+// is a power of 2 and >= 16 and with scales and zero points (if exist) of the blocked weight shape. This is the
+// layout MatMulNBits and GatherBlockQuantized take. Returns the non-negative quantization axis if so.
+std::optional<int64_t> GetBlockwise4BitConstantDQAxis(const Graph& graph, const Node& dq_node) {
+  const auto& input_defs = dq_node.InputDefs();
+  const auto* weight_arg = input_defs[0];
+  const auto* scale_arg = input_defs[1];
+  const auto* zero_point_arg = input_defs.size() == 3 && input_defs[2]->Exists() ? input_defs[2] : nullptr;
+  int32_t dt_weight = weight_arg->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_scales = scale_arg->TypeAsProto()->tensor_type().elem_type();
+  if (dt_scales != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT &&
+      dt_scales != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT16) {
+    return std::nullopt;
+  }
+
+  // the output has the scales type, i.e. no output_dtype attribute asks for another one
+  if (dq_node.OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type() != dt_scales) {
+    return std::nullopt;
+  }
+
+  if (!Is4BitIntType(dt_weight)) {
+    return std::nullopt;
+  }
+
+  const auto& dq_attrs = dq_node.GetAttributes();
+  const auto bs_iter = dq_attrs.find("block_size");
+  if (bs_iter == dq_attrs.end()) {
+    return std::nullopt;
+  }
+
+  const auto block_size = bs_iter->second.i();
+  if (block_size < 16 || ((block_size - 1) & block_size)) {
+    return std::nullopt;
+  }
+
+  // weight, scale and zero points (if exists) must be constants
+  const auto* weight_tensor_proto = graph.GetConstantInitializer(weight_arg->Name(), true);
+  const auto* scale_tensor_proto = graph.GetConstantInitializer(scale_arg->Name(), true);
+  const auto* zp_tensor_proto = zero_point_arg ? graph.GetConstantInitializer(zero_point_arg->Name(), true) : nullptr;
+
+  if (!weight_tensor_proto || !scale_tensor_proto || (zero_point_arg && !zp_tensor_proto)) {
+    return std::nullopt;
+  }
+
+  const int rank = weight_tensor_proto->dims_size();
+  const auto a_iter = dq_attrs.find("axis");
+  int64_t axis = a_iter == dq_attrs.end() ? 1 : a_iter->second.i();
+  if (axis < -rank || axis >= rank) {
+    return std::nullopt;
+  }
+
+  axis = axis < 0 ? axis + rank : axis;
+
+  // scale is the weight shape with the axis dimension divided into blocks, zero points (if exists) match the scale
+  if (scale_tensor_proto->dims_size() != rank || (zp_tensor_proto && zp_tensor_proto->dims_size() != rank)) {
+    return std::nullopt;
+  }
+
+  for (int i = 0; i < rank; ++i) {
+    const auto weight_dim = weight_tensor_proto->dims(i);
+    const auto scale_dim = scale_tensor_proto->dims(i);
+    if ((i == axis ? (weight_dim + block_size - 1) / block_size : weight_dim) != scale_dim ||
+        (zp_tensor_proto && zp_tensor_proto->dims(i) != scale_dim)) {
+      return std::nullopt;
+    }
+  }
+
+  return axis;
+}
+
 std::vector<const Node*> FindQDQNodes(const GraphViewer& graph_viewer, const Node& node, bool find_dq_nodes) {
   // First get all the upstream (DQ) or downstream (Q) nodes
   std::vector<const Node*> nodes = find_dq_nodes ? graph_utils::FindParentsByType(node, QDQ::DQOpName)
@@ -531,65 +604,38 @@ bool DQMatMulNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Nod
     return false;
   }
 
-  // DQ weight/zero points types are int4/uint4, scales/output types are float or float16
-  const auto* weight_arg = dq_nodes[0]->InputDefs()[0];
-  const auto* scale_arg = dq_nodes[0]->InputDefs()[1];
-  const auto* zero_point_arg = dq_nodes[0]->InputDefs().size() == 3 ? dq_nodes[0]->InputDefs()[2] : nullptr;
-  int32_t dt_weight = weight_arg->TypeAsProto()->tensor_type().elem_type();
-  int32_t dt_scales = scale_arg->TypeAsProto()->tensor_type().elem_type();
-  if (dt_scales != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT &&
-      dt_scales != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT16) {
-    return false;
-  }
-
-  if (!Is4BitIntType(dt_weight)) {
-    return false;
-  }
-
-  // DQ is blockwise quantized along axis 0, and block_size must be 2's power and >= 16
-  const auto& dq_attrs = dq_nodes[0]->GetAttributes();
-  if (const auto a_iter = dq_attrs.find("axis"); a_iter == dq_attrs.end() || a_iter->second.i() != 0) {
-    return false;
-  }
-
-  const auto a_iter = dq_attrs.find("block_size");
-  if (a_iter == dq_attrs.end()) {
-    return false;
-  }
+  // DQ weight is a 2D int4/uint4 constant, blockwise quantized along axis 0. A missing zero point is 0.
+  const auto axis = GetBlockwise4BitConstantDQAxis(graph, *dq_nodes[0]);
+  return axis.has_value() && *axis == 0 &&
+         graph.GetConstantInitializer(dq_nodes[0]->InputDefs()[0]->Name(), true)->dims_size() == 2;
+}
 
-  auto block_size = a_iter->second.i();
-  if (block_size < 16 || ((block_size - 1) & block_size)) {
+bool DQGatherNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
+                                      const Node* redundant_clip_node, const std::vector<const Node*>& dq_nodes,
+                                      const std::vector<const Node*>& q_nodes) const {
+  if (redundant_clip_node) {
     return false;
   }
 
-  // weight, scale and zero points (if exists) must be constants
-  const auto* weight_tensor_proto = graph.GetConstantInitializer(weight_arg->Name(), true);
-  const auto* scale_tensor_proto = graph.GetConstantInitializer(scale_arg->Name(), true);
-  const auto* zp_tensor_proto = zero_point_arg ? graph.GetConstantInitializer(zero_point_arg->Name(), true) : nullptr;
-
-  if (!weight_tensor_proto || !scale_tensor_proto) {
+  // Should not have any Q nodes
+  if (!q_nodes.empty()) {
     return false;
   }
 
-  if (zero_point_arg && !zp_tensor_proto) {
-    return false;
-  }
+  const auto& graph = graph_viewer.GetGraph();
 
-  // weight, scale and zero points (if exists) must have the rank 2
-  if (weight_tensor_proto->dims_size() != 2 || scale_tensor_proto->dims_size() != 2 ||
-      (zp_tensor_proto && zp_tensor_proto->dims_size() != 2)) {
+  // Gather has only 1 DQ input and the DQ must have 1 output edge and not be a graph output
+  if (dq_nodes.size() != 1 || !optimizer_utils::CheckOutputEdges(graph, *dq_nodes[0], 1)) {
     return false;
   }
 
-  // check weight, scale and zero points (if exists) shapes
-  if ((weight_tensor_proto->dims()[0] + block_size - 1) / block_size != scale_tensor_proto->dims()[0] ||
-      weight_tensor_proto->dims()[1] != scale_tensor_proto->dims()[1] ||
-      (zp_tensor_proto && (zp_tensor_proto->dims()[0] != scale_tensor_proto->dims()[0] ||
-                           zp_tensor_proto->dims()[1] != scale_tensor_proto->dims()[1]))) {
+  // DQ must be Gather's data input
+  if (node.InputDefs()[0] != dq_nodes[0]->OutputDefs()[0]) {
     return false;
   }
 
-  return true;
+  // GatherBlockQuantized takes any gather and quantize axis
+  return GetBlockwise4BitConstantDQAxis(graph, *dq_nodes[0]).has_value();
 }
 
 bool GemmNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node, const Node* redundant_clip_node,
@@ -719,6 +765,61 @@ bool InstanceAndLayerNormalizationNodeGroupSelector::Check(const GraphViewer& gr
          (has_bias ? dt_bias == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT32 : true);
 }
 
+bool LayerNormalizationNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
+                                                const Node* redundant_clip_node,
+                                                const std::vector<const Node*>& dq_nodes,
+                                                const std::vector<const Node*>& q_nodes) const {
+  if (!CheckQDQNodes(graph_viewer, node, redundant_clip_node, dq_nodes, q_nodes)) {
+    return false;
+  }
+
+  const auto is_8bit_type = [](int32_t data_type) {
+    return data_type == ONNX_NAMESPACE::TensorProto_DataType_INT8 ||
+           data_type == ONNX_NAMESPACE::TensorProto_DataType_UINT8;
+  };
+
+  const int32_t dt_input = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  const int32_t dt_scale = dq_nodes[1]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  const int32_t dt_output = q_nodes[0]->OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  if (dt_input != dt_output || !is_8bit_type(dt_input) || !is_8bit_type(dt_scale)) {
+    return false;
+  }
+
+  // The input and output are quantized per tensor.
+  if (!optimizer_utils::IsScalar(*dq_nodes[0]->InputDefs()[QDQ::InputIndex::SCALE_ID]) ||
+      !optimizer_utils::IsScalar(*q_nodes[0]->InputDefs()[QDQ::InputIndex::SCALE_ID])) {
+    return false;
+  }
+
+  if (dq_nodes.size() > 2) {
+    const auto& bias_defs = dq_nodes[2]->InputDefs();
+    if (bias_defs[0]->TypeAsProto()->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_INT32) {
+      return false;
+    }
+
+    // QLinearLayerNormalization has no zero point for B, so it must be missing or 0.
+    if (bias_defs.size() > QDQ::InputIndex::ZERO_POINT_ID && bias_defs[QDQ::InputIndex::ZERO_POINT_ID]->Exists()) {
+      const auto* zp_tensor_proto =
+          graph_viewer.GetConstantInitializer(bias_defs[QDQ::InputIndex::ZERO_POINT_ID]->Name(), true);
+      if (zp_tensor_proto == nullptr) {
+        return false;
+      }
+
+      Initializer zero_point(graph_viewer.GetGraph(), *zp_tensor_proto, graph_viewer.ModelPath());
+      const auto zero_points = zero_point.DataAsSpan<int32_t>();
+      if (std::any_of(zero_points.begin(), zero_points.end(), [](int32_t value) { return value != 0; })) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void LayerNormalizationSelector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
+  builder.input_nodes.resize(3, NodesToOptimizeIndices::kEmptyNodeIndex);
+}
+
 bool BatchNormalizationNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
                                                 const Node* redundant_clip_node,
                                                 const std::vector<const Node*>& dq_nodes,
@@ -245,6 +245,14 @@ class DQMatMulNodeGroupSelector : public NodeGroupSelector {
              const std::vector<const Node*>& q_nodes) const override;
 };
 
+// Convert "1 DQ node for input data -> Gather" to "GatherBlockQuantized"
+class DQGatherNodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node, const Node* redundant_clip_node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 // Input: DQ nodes for A, B and optional C
 // Output: optional Q node for Y
 class GemmNodeGroupSelector : public NodeGroupSelector {
@@ -270,6 +278,15 @@ class InstanceAndLayerNormalizationNodeGroupSelector : public NodeGroupSelector
              const std::vector<const Node*>& q_nodes) const override;
 };
 
+// DQ nodes for input, scale and optionally B -> LayerNormalization -> Q, as supported by QLinearLayerNormalization:
+// 8-bit input, output and scale with per-tensor input and output quantization, and an int32 B with a zero point of 0.
+class LayerNormalizationNodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node, const Node* redundant_clip_node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 // DQ nodes for X, W and optionally B, not used for mean, var -> node -> Q
 class BatchNormalizationNodeGroupSelector : public NodeGroupSelector {
  public:
@@ -412,6 +429,15 @@ class WhereSelector : public BaseSelector {
       : BaseSelector(std::make_unique<WhereNodeGroupSelector>(allow_16bit, allow_4bit), compatible_providers) {}
 };
 
+// DQ nodes for input, scale and optional B -> LayerNormalization -> Q
+class LayerNormalizationSelector : public BaseSelector {
+ public:
+  explicit LayerNormalizationSelector(gsl::span<const char*> compatible_providers = {})
+      : BaseSelector(std::make_unique<LayerNormalizationNodeGroupSelector>(), compatible_providers) {}
+
+  void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
+};
+
 // 2 DQ nodes for input -> node -> optional Q if QLinearMatMul, MatMulIntegerToFloat if not
 class MatMulSelector : public BaseSelector {
  public:
@@ -429,6 +455,13 @@ class DQMatMulToMatMulNBitsSelector : public BaseSelector {
       : BaseSelector(std::make_unique<DQMatMulNodeGroupSelector>(), compatible_providers) {}
 };
 
+// Convert "1 DQ node for input data -> Gather" to "GatherBlockQuantized"
+class DQGatherToGatherBlockQuantizedSelector : public BaseSelector {
+ public:
+  explicit DQGatherToGatherBlockQuantizedSelector(gsl::span<const char*> compatible_providers = {})
+      : BaseSelector(std::make_unique<DQGatherNodeGroupSelector>(), compatible_providers) {}
+};
+
 // Input: DQ nodes for A, B and optional C
 // Output: optional Q node for Y
 class GemmSelector : public BaseSelector {
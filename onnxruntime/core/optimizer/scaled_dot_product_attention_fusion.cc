@@ -0,0 +1,506 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/scaled_dot_product_attention_fusion.h"
+
+#include <optional>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+#define DEBUG_LOG(x) LOGS(logger, VERBOSE) << x
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+
+namespace {
+
+// The nodes of a decomposed attention. The optional scales and bias are null when they are not in the graph.
+struct AttentionNodes {
+  Node* q_scale = nullptr;
+  Node* k_transpose = nullptr;
+  Node* k_scale = nullptr;
+  Node* qk_matmul = nullptr;
+  Node* qk_scale = nullptr;
+  Node* add_bias = nullptr;
+  Node* softmax = nullptr;
+  Node* qkv_matmul = nullptr;
+  Node* transpose = nullptr;
+  Node* reshape = nullptr;
+
+  NodeArg* query = nullptr;
+  NodeArg* key = nullptr;
+  NodeArg* value = nullptr;
+  NodeArg* attention_bias = nullptr;
+
+  // The product of the scales of the query, the key and the scores.
+  float scale = 1.0f;
+};
+
+Node* GetInputNode(Graph& graph, const Node& node, int index) {
+  const Node* input_node = graph_utils::GetInputNode(node, index);
+  return input_node == nullptr ? nullptr : graph.GetNode(input_node->Index());
+}
+
+// The consumer of the output of `node`, when it is the only one and the output is not a graph output.
+Node* GetOnlyOutputNode(Graph& graph, const Node& node) {
+  if (!optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+    return nullptr;
+  }
+
+  return graph.GetNode(node.OutputEdgesBegin()->GetNode().Index());
+}
+
+bool SameDim(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  if (utils::HasDimValue(a) && utils::HasDimValue(b)) {
+    return a.dim_value() == b.dim_value();
+  }
+
+  return utils::HasDimParam(a) && utils::HasDimParam(b) && a.dim_param() == b.dim_param();
+}
+
+bool IsDimValue(const TensorShapeProto_Dimension& dim, int64_t value) {
+  return utils::HasDimValue(dim) && dim.dim_value() == value;
+}
+
+const TensorShapeProto* GetShape(const NodeArg& node_arg, int rank) {
+  const TensorShapeProto* shape = node_arg.Shape();
+  return shape != nullptr && shape->dim_size() == rank ? shape : nullptr;
+}
+
+// The factor applied by `node` when it is a Mul or Div by a constant scalar, and the index of its other input.
+std::optional<float> GetScaleFactor(const Graph& graph, const Node& node, int& input_index) {
+  const bool is_mul = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14});
+  const bool is_div = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14});
+  if (!is_mul && !is_div) {
+    return std::nullopt;
+  }
+
+  for (int scalar_index : {1, 0}) {
+    if (is_div && scalar_index == 0) {
+      continue;
+    }
+
+    const TensorProto* tensor = graph_utils::GetConstantInitializer(graph, node.InputDefs()[scalar_index]->Name());
+    // A scalar of a higher rank than the attention tensors would broadcast them.
+    if (tensor == nullptr || tensor->dims_size() > 4) {
+      continue;
+    }
+
+    Initializer initializer(graph, *tensor, graph.ModelPath());
+    if (initializer.size() != 1) {
+      continue;
+    }
+
+    float value = 0.0f;
+    if (tensor->data_type() == TensorProto_DataType_FLOAT) {
+      value = initializer.data<float>()[0];
+    } else if (tensor->data_type() == TensorProto_DataType_FLOAT16) {
+      value = initializer.data<MLFloat16>()[0].ToFloat();
+    } else {
+      continue;
+    }
+
+    if (value == 0.0f) {
+      return std::nullopt;
+    }
+
+    input_index = 1 - scalar_index;
+    return is_div ? 1.0f / value : value;
+  }
+
+  return std::nullopt;
+}
+
+/** Match the scores, from the node producing them:
+
+    query   key
+      |      |
+      |   Transpose (perm=0,1,3,2)
+      |      |
+   [Mul]   [Mul]
+       \    /
+       MatMul
+         |
+     [Mul or Div]
+
+  The scales in brackets are optional and are Mul or Div by a constant scalar. The torch.onnx dynamo exporter scales
+  both the query and the transposed key by the square root of the scale, other exporters scale the scores.
+*/
+bool MatchScores(Graph& graph, Node& scores_node, AttentionNodes& nodes) {
+  Node* node = &scores_node;
+  int input_index = 0;
+  if (const auto factor = GetScaleFactor(graph, *node, input_index)) {
+    if (!optimizer_utils::CheckOutputEdges(graph, *node, 1)) {
+      return false;
+    }
+
+    nodes.qk_scale = node;
+    nodes.scale *= *factor;
+    node = GetInputNode(graph, *node, input_index);
+  }
+
+  if (node == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*node, "MatMul", {1, 9, 13}) ||
+      !optimizer_utils::CheckOutputEdges(graph, *node, 1)) {
+    return false;
+  }
+
+  nodes.qk_matmul = node;
+  nodes.query = node->MutableInputDefs()[0];
+
+  // The scale of a query consumed elsewhere too stays in the graph, its output being the query.
+  Node* q_node = GetInputNode(graph, *node, 0);
+  if (q_node != nullptr) {
+    if (const auto factor = GetScaleFactor(graph, *q_node, input_index);
+        factor && optimizer_utils::CheckOutputEdges(graph, *q_node, 1)) {
+      nodes.q_scale = q_node;
+      nodes.query = q_node->MutableInputDefs()[input_index];
+      nodes.scale *= *factor;
+    }
+  }
+
+  Node* k_node = GetInputNode(graph, *node, 1);
+  if (k_node == nullptr) {
+    return false;
+  }
+
+  if (const auto factor = GetScaleFactor(graph, *k_node, input_index)) {
+    if (!optimizer_utils::CheckOutputEdges(graph, *k_node, 1)) {
+      return false;
+    }
+
+    nodes.k_scale = k_node;
+    nodes.scale *= *factor;
+    k_node = GetInputNode(graph, *k_node, input_index);
+  }
+
+  if (k_node == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*k_node, "Transpose", {1, 13, 21, 23}) ||
+      !optimizer_utils::IsAttributeWithExpectedValues(*k_node, "perm", {0, 1, 3, 2}) ||
+      !optimizer_utils::CheckOutputEdges(graph, *k_node, 1)) {
+    return false;
+  }
+
+  nodes.k_transpose = k_node;
+  nodes.key = k_node->MutableInputDefs()[0];
+
+  // The transpose optimizer can move the scale of the key before its Transpose.
+  Node* k_scale = GetInputNode(graph, *k_node, 0);
+  if (nodes.k_scale == nullptr && k_scale != nullptr) {
+    if (const auto factor = GetScaleFactor(graph, *k_scale, input_index);
+        factor && optimizer_utils::CheckOutputEdges(graph, *k_scale, 1)) {
+      nodes.k_scale = k_scale;
+      nodes.key = k_scale->MutableInputDefs()[input_index];
+      nodes.scale *= *factor;
+    }
+  }
+
+  return true;
+}
+
+/** Match the attention around a Softmax:
+
+     scores   [attention_bias]
+         \     /
+         [Add]
+           |
+        Softmax (axis=-1)   value
+              \             /
+                  MatMul
+                    |
+             Transpose (perm=0,2,1,3)
+                    |
+                 Reshape
+*/
+bool MatchAttention(Graph& graph, Node& softmax, AttentionNodes& nodes) {
+  const auto* axis_attr = graph_utils::GetNodeAttribute(softmax, "axis");
+  const int64_t axis = axis_attr != nullptr ? axis_attr->i() : (softmax.SinceVersion() < 13 ? 1 : -1);
+  if ((axis != -1 && axis != 3) || GetShape(*softmax.InputDefs()[0], 4) == nullptr) {
+    return false;
+  }
+
+  nodes.softmax = &softmax;
+  nodes.qkv_matmul = GetOnlyOutputNode(graph, softmax);
+  if (nodes.qkv_matmul == nullptr || softmax.OutputEdgesBegin()->GetDstArgIndex() != 0 ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*nodes.qkv_matmul, "MatMul", {1, 9, 13})) {
+    return false;
+  }
+
+  nodes.value = nodes.qkv_matmul->MutableInputDefs()[1];
+  nodes.transpose = GetOnlyOutputNode(graph, *nodes.qkv_matmul);
+  if (nodes.transpose == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*nodes.transpose, "Transpose", {1, 13, 21, 23}) ||
+      !optimizer_utils::IsAttributeWithExpectedValues(*nodes.transpose, "perm", {0, 2, 1, 3})) {
+    return false;
+  }
+
+  nodes.reshape = GetOnlyOutputNode(graph, *nodes.transpose);
+  if (nodes.reshape == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*nodes.reshape, "Reshape", {5, 13, 14, 19, 21, 23})) {
+    return false;
+  }
+
+  Node* scores_node = GetInputNode(graph, softmax, 0);
+  if (scores_node == nullptr) {
+    return false;
+  }
+
+  bool matched = false;
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(*scores_node, "Add", {7, 13, 14})) {
+    if (!optimizer_utils::CheckOutputEdges(graph, *scores_node, 1)) {
+      return false;
+    }
+
+    for (int scores_index : {0, 1}) {
+      AttentionNodes candidate = nodes;
+      Node* input_node = GetInputNode(graph, *scores_node, scores_index);
+      if (input_node != nullptr && MatchScores(graph, *input_node, candidate)) {
+        nodes = candidate;
+        nodes.add_bias = scores_node;
+        nodes.attention_bias = scores_node->MutableInputDefs()[1 - scores_index];
+        matched = true;
+        break;
+      }
+    }
+  } else {
+    matched = MatchScores(graph, *scores_node, nodes);
+  }
+
+  if (!matched) {
+    return false;
+  }
+
+  const Node* all_nodes[] = {nodes.q_scale, nodes.k_transpose, nodes.k_scale, nodes.qk_matmul, nodes.qk_scale,
+                             nodes.add_bias, nodes.qkv_matmul, nodes.transpose, nodes.reshape};
+  for (const Node* node : all_nodes) {
+    if (node != nullptr && node->GetExecutionProviderType() != softmax.GetExecutionProviderType()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Whether the output Reshape merges the heads, from (batch_size, sequence_length, num_heads, head_size) to
+// (batch_size, sequence_length, num_heads * head_size).
+bool IsMergeHeadsReshape(const Graph& graph, const Node& reshape, const TensorShapeProto& query_shape,
+                         int64_t hidden_size) {
+  const TensorShapeProto* output_shape = GetShape(*reshape.OutputDefs()[0], 3);
+  if (output_shape != nullptr && SameDim(output_shape->dim(0), query_shape.dim(0)) &&
+      SameDim(output_shape->dim(1), query_shape.dim(2)) && IsDimValue(output_shape->dim(2), hidden_size)) {
+    return true;
+  }
+
+  // The shape inferred for a Reshape to a computed shape can miss symbolic dimensions, a constant shape is checked
+  // instead: 0 copies the dimension of the input.
+  InlinedVector<int64_t> shape;
+  if (!optimizer_utils::AppendTensorFromInitializer(graph, *reshape.InputDefs()[1], shape, true) ||
+      shape.size() != 3) {
+    return false;
+  }
+
+  return (shape[0] == 0 || IsDimValue(query_shape.dim(0), shape[0])) &&
+         (shape[1] == 0 || IsDimValue(query_shape.dim(2), shape[1])) &&
+         (shape[2] == hidden_size || (shape[2] == -1 && shape[0] == 0 && shape[1] == 0));
+}
+
+// Check the inputs of the attention against the MultiHeadAttention requirements and get its attributes.
+bool CheckInputs(const Graph& graph, const AttentionNodes& nodes, int64_t& num_heads, int64_t& head_size) {
+  const TensorShapeProto* query_shape = GetShape(*nodes.query, 4);
+  const TensorShapeProto* key_shape = GetShape(*nodes.key, 4);
+  const TensorShapeProto* value_shape = GetShape(*nodes.value, 4);
+  if (query_shape == nullptr || key_shape == nullptr || value_shape == nullptr ||
+      !utils::HasDimValue(query_shape->dim(1)) || !utils::HasDimValue(query_shape->dim(3))) {
+    return false;
+  }
+
+  num_heads = query_shape->dim(1).dim_value();
+  head_size = query_shape->dim(3).dim_value();
+
+  // The key and value in (batch_size, num_heads, kv_sequence_length, head_size) must have the same shape.
+  if (!SameDim(key_shape->dim(0), query_shape->dim(0)) || !SameDim(key_shape->dim(1), query_shape->dim(1)) ||
+      !SameDim(key_shape->dim(3), query_shape->dim(3))) {
+    return false;
+  }
+
+  for (int i = 0; i < 4; ++i) {
+    if (!SameDim(value_shape->dim(i), key_shape->dim(i))) {
+      return false;
+    }
+  }
+
+  const int32_t data_type = nodes.query->TypeAsProto()->tensor_type().elem_type();
+  if (nodes.key->TypeAsProto()->tensor_type().elem_type() != data_type ||
+      nodes.value->TypeAsProto()->tensor_type().elem_type() != data_type) {
+    return false;
+  }
+
+  // MultiHeadAttention has float16 kernels on GPU only.
+  const bool is_cpu = nodes.softmax->GetExecutionProviderType() == kCpuExecutionProvider;
+  if (data_type != TensorProto_DataType_FLOAT && (is_cpu || data_type != TensorProto_DataType_FLOAT16)) {
+    return false;
+  }
+
+  // The attention bias is (batch_size or 1, num_heads or 1, sequence_length, total_sequence_length), without
+  // broadcasting along the sequences.
+  if (nodes.attention_bias != nullptr) {
+    const TensorShapeProto* scores_shape = nodes.softmax->InputDefs()[0]->Shape();
+    const TensorShapeProto* bias_shape = GetShape(*nodes.attention_bias, 4);
+    if (bias_shape == nullptr ||
+        nodes.attention_bias->TypeAsProto()->tensor_type().elem_type() != data_type ||
+        !(IsDimValue(bias_shape->dim(0), 1) || SameDim(bias_shape->dim(0), query_shape->dim(0))) ||
+        !(IsDimValue(bias_shape->dim(1), 1) || IsDimValue(bias_shape->dim(1), num_heads)) ||
+        !SameDim(bias_shape->dim(2), scores_shape->dim(2)) || !SameDim(bias_shape->dim(3), scores_shape->dim(3))) {
+      return false;
+    }
+  }
+
+  return IsMergeHeadsReshape(graph, *nodes.reshape, *query_shape, num_heads * head_size);
+}
+
+// The query in (batch_size, sequence_length, num_heads * head_size) for MultiHeadAttention. When the query comes from
+// splitting the heads of such a tensor, that tensor is used and the split nodes are added to `nodes_to_remove`,
+// otherwise the heads are merged by a Transpose and a Reshape.
+NodeArg* GetQueryInput(Graph& graph, const AttentionNodes& nodes, int64_t num_heads, int64_t head_size,
+                       InlinedVector<Node*>& nodes_to_remove) {
+  const int64_t hidden_size = num_heads * head_size;
+  const std::string& provider = nodes.softmax->GetExecutionProviderType();
+
+  //  Reshape (B, S, N * H) to (B, S, N, H)
+  //      |
+  //  Transpose (perm=0,2,1,3)
+  const Node* q_consumer = nodes.q_scale != nullptr ? nodes.q_scale : nodes.qk_matmul;
+  const int q_index = optimizer_utils::IndexOfNodeInput(*q_consumer, *nodes.query);
+  Node* q_transpose = GetInputNode(graph, *q_consumer, q_index);
+  if (q_transpose != nullptr &&
+      graph_utils::IsSupportedOptypeVersionAndDomain(*q_transpose, "Transpose", {1, 13, 21, 23}) &&
+      optimizer_utils::IsAttributeWithExpectedValues(*q_transpose, "perm", {0, 2, 1, 3}) &&
+      q_transpose->GetExecutionProviderType() == provider &&
+      optimizer_utils::CheckOutputEdges(graph, *q_transpose, 1)) {
+    Node* q_reshape = GetInputNode(graph, *q_transpose, 0);
+    if (q_reshape != nullptr &&
+        graph_utils::IsSupportedOptypeVersionAndDomain(*q_reshape, "Reshape", {5, 13, 14, 19, 21, 23}) &&
+        q_reshape->GetExecutionProviderType() == provider) {
+      NodeArg* input = q_reshape->MutableInputDefs()[0];
+      const TensorShapeProto* input_shape = GetShape(*input, 3);
+      const TensorShapeProto* split_shape = GetShape(*q_reshape->OutputDefs()[0], 4);
+      if (input_shape != nullptr && split_shape != nullptr &&
+          SameDim(split_shape->dim(0), input_shape->dim(0)) && SameDim(split_shape->dim(1), input_shape->dim(1)) &&
+          IsDimValue(input_shape->dim(2), hidden_size)) {
+        nodes_to_remove.push_back(q_transpose);
+        if (optimizer_utils::CheckOutputEdges(graph, *q_reshape, 1)) {
+          nodes_to_remove.push_back(q_reshape);
+        }
+        return input;
+      }
+    }
+  }
+
+  NodeArg& transposed = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("query_BSNH"), nullptr);
+  Node& transpose = graph.AddNode(graph.GenerateNodeName("Transpose"),
+                                  "Transpose",
+                                  "Query to (batch_size, sequence_length, num_heads, head_size)",
+                                  {nodes.query},
+                                  {&transposed});
+  transpose.AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+  transpose.SetExecutionProviderType(provider);
+
+  TensorProto shape_initializer;
+  shape_initializer.set_name(graph.GenerateNodeArgName("query_shape"));
+  shape_initializer.set_data_type(TensorProto_DataType_INT64);
+  shape_initializer.add_dims(3);
+  for (int64_t dim : {int64_t{0}, int64_t{0}, hidden_size}) {
+    shape_initializer.add_int64_data(dim);
+  }
+
+  NodeArg& shape = graph_utils::AddInitializer(graph, shape_initializer);
+  NodeArg& query = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("query_BSD"), nullptr);
+  Node& reshape = graph.AddNode(graph.GenerateNodeName("Reshape"),
+                                "Reshape",
+                                "Query to (batch_size, sequence_length, hidden_size)",
+                                {&transposed, &shape},
+                                {&query});
+  reshape.SetExecutionProviderType(provider);
+
+  return &query;
+}
+
+void FuseAttention(Graph& graph, const AttentionNodes& nodes, int64_t num_heads, int64_t head_size) {
+  InlinedVector<Node*> nodes_to_remove{nodes.q_scale, nodes.k_transpose, nodes.k_scale, nodes.qk_matmul,
+                                       nodes.qk_scale, nodes.add_bias, nodes.softmax, nodes.qkv_matmul,
+                                       nodes.transpose, nodes.reshape};
+  NodeArg* query = GetQueryInput(graph, nodes, num_heads, head_size, nodes_to_remove);
+
+  InlinedVector<NodeArg*> input_defs{query, nodes.key, nodes.value};
+  if (nodes.attention_bias != nullptr) {
+    // No bias and key_padding_mask.
+    NodeArg& empty = graph.GetOrCreateNodeArg("", nullptr);
+    input_defs.insert(input_defs.end(), {&empty, &empty, nodes.attention_bias});
+  }
+
+  const std::array output_defs{nodes.reshape->MutableOutputDefs()[0]};
+  Node& attention_node = graph.AddNode(graph.GenerateNodeName("MultiHeadAttention"),
+                                       "MultiHeadAttention",
+                                       "Fused scaled dot product attention",
+                                       input_defs,
+                                       output_defs,
+                                       nullptr,
+                                       kMSDomain);
+  attention_node.AddAttribute("num_heads", num_heads);
+  attention_node.AddAttribute("scale", nodes.scale);
+  attention_node.SetExecutionProviderType(nodes.softmax->GetExecutionProviderType());
+
+  for (Node* node : nodes_to_remove) {
+    if (node != nullptr) {
+      graph_utils::RemoveNodeOutputEdges(graph, *node);
+      graph.RemoveNode(node->Index());
+    }
+  }
+}
+
+}  // namespace
+
+Status ScaledDotProductAttentionFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                                  const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (node_ptr == nullptr)
+      continue;  // we removed the node as part of an earlier fusion
+
+    Node& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Softmax", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    AttentionNodes nodes;
+    if (!MatchAttention(graph, node, nodes)) {
+      continue;
+    }
+
+    int64_t num_heads = 0;
+    int64_t head_size = 0;
+    if (!CheckInputs(graph, nodes, num_heads, head_size)) {
+      DEBUG_LOG("Inputs of the attention around " << node.Name() << " are not supported by MultiHeadAttention");
+      continue;
+    }
+
+    FuseAttention(graph, nodes, num_heads, head_size);
+    modified = true;
+
+    DEBUG_LOG("Fused a scaled dot product attention into MultiHeadAttention.");
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
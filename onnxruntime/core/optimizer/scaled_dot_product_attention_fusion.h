@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ScaledDotProductAttentionFusion
+
+Fuses the scaled dot product attention that exporters decompose into MatMul, Softmax and MatMul, on query, key and
+value in the (batch_size, num_heads, sequence_length, head_size) layout, into a MultiHeadAttention node.
+
+This is how the torch.onnx dynamo exporter writes the attention of decoder models like Llama, Mistral or Qwen. The
+rotary embedding and the repeat of the key and value heads sit between the projections and the attention, so
+AttentionFusion, which matches the BERT and GPT-2 subgraphs from the projections, does not apply to them.
+*/
+class ScaledDotProductAttentionFusion : public GraphTransformer {
+ public:
+  explicit ScaledDotProductAttentionFusion(
+      const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ScaledDotProductAttentionFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "core/optimizer/scaler_linear_fusion.h"
+#include "core/framework/op_node_proto_helper.h"
+#include "core/graph/graph_utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Number of rows of the coefficients of the linear model, one per class or target, 0 if unknown.
+size_t GetLinearModelRowCount(const Node& linear_node) {
+  ProtoHelperNodeContext helper_ctx(linear_node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> helper(&helper_ctx);
+  if (linear_node.OpType() == "LinearClassifier") {
+    return helper.GetAttrsOrDefault<float>("intercepts").size();
+  }
+
+  int64_t targets = helper.GetAttrOrDefault<int64_t>("targets", 1);
+  return targets > 0 ? static_cast<size_t>(targets) : 0;
+}
+
+}  // namespace
+
+bool ScalerLinearFusion::SatisfyCondition(const Graph& graph, const Node& node,
+                                          const logging::Logger& logger) const {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Scaler", {1}, kMLDomain) ||
+      node.GetOutputEdgesCount() != 1 ||
+      !graph_utils::CanRemoveNode(graph, node, logger)) {
+    return false;
+  }
+
+  // the linear models only have float kernels for all the input types of Scaler
+  const auto* input_type = node.InputDefs()[0]->TypeAsProto();
+  if (input_type == nullptr || !input_type->tensor_type().has_elem_type() ||
+      input_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  const Node& next_node = *node.OutputNodesBegin();
+  if (!(graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "LinearClassifier", {1}, kMLDomain) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "LinearRegressor", {1}, kMLDomain)) ||
+      next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    return false;
+  }
+
+  ProtoHelperNodeContext node_helper_ctx(node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> node_helper(&node_helper_ctx);
+  const std::vector<float> scale = node_helper.GetAttrsOrDefault<float>("scale");
+  const std::vector<float> offset = node_helper.GetAttrsOrDefault<float>("offset");
+  if (scale.empty() || scale.size() != offset.size()) {
+    return false;
+  }
+
+  // the scale and offset are per feature, or a single value for all the features
+  ProtoHelperNodeContext next_helper_ctx(next_node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> next_helper(&next_helper_ctx);
+  const size_t coefficient_count = next_helper.GetAttrsOrDefault<float>("coefficients").size();
+  const size_t row_count = GetLinearModelRowCount(next_node);
+  if (row_count == 0 || coefficient_count == 0 || coefficient_count % row_count != 0) {
+    return false;
+  }
+
+  const size_t feature_count = coefficient_count / row_count;
+  return scale.size() == 1 || scale.size() == feature_count;
+}
+
+Status ScalerLinearFusion::Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect,
+                                 const logging::Logger& /*logger*/) const {
+  Node& linear_node = *graph.GetNode(node.OutputNodesBegin()->Index());
+
+  ProtoHelperNodeContext node_helper_ctx(node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> node_helper(&node_helper_ctx);
+  const std::vector<float> scale = node_helper.GetAttrsOrDefault<float>("scale");
+  const std::vector<float> offset = node_helper.GetAttrsOrDefault<float>("offset");
+
+  ProtoHelperNodeContext linear_helper_ctx(linear_node);
+  OpNodeProtoHelper<ProtoHelperNodeContext> linear_helper(&linear_helper_ctx);
+  std::vector<float> coefficients = linear_helper.GetAttrsOrDefault<float>("coefficients");
+  std::vector<float> intercepts = linear_helper.GetAttrsOrDefault<float>("intercepts");
+  const size_t row_count = GetLinearModelRowCount(linear_node);
+  const size_t feature_count = coefficients.size() / row_count;
+
+  // LinearRegressor ignores intercepts that don't have one value per target
+  if (intercepts.size() != row_count) {
+    intercepts.assign(row_count, 0.f);
+  }
+
+  for (size_t row = 0; row < row_count; ++row) {
+    float* row_coefficients = coefficients.data() + row * feature_count;
+    double shift = 0.0;
+    for (size_t feature = 0; feature < feature_count; ++feature) {
+      const size_t i = scale.size() == 1 ? 0 : feature;
+      row_coefficients[feature] *= scale[i];
+      shift += static_cast<double>(offset[i]) * row_coefficients[feature];
+    }
+    intercepts[row] -= static_cast<float>(shift);
+  }
+
+  linear_node.ClearAttribute("coefficients");
+  linear_node.ClearAttribute("intercepts");
+  linear_node.AddAttribute("coefficients", coefficients);
+  linear_node.AddAttribute("intercepts", intercepts);
+
+  if (graph_utils::RemoveNode(graph, node)) {
+    rule_effect = RewriteRuleEffect::kRemovedCurrentNode;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/rewrite_rule.h"
+
+namespace onnxruntime {
+/**
+@Class ScalerLinearFusion
+
+Rewrite rule that folds a Scaler into the LinearClassifier or LinearRegressor consuming its output, as exported by
+sklearn-onnx for a StandardScaler followed by a linear model. The scaled features are not materialized:
+
+  ((x - offset) * scale) . w + b = x . (w * scale) + (b - offset . (w * scale))
+
+*/
+class ScalerLinearFusion : public RewriteRule {
+ public:
+  ScalerLinearFusion() noexcept : RewriteRule("ScalerLinearFusion") {}
+
+  std::vector<std::string> TargetOpTypes() const noexcept override {
+    return {"Scaler"};
+  }
+
+ private:
+  bool SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const override;
+  Status Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
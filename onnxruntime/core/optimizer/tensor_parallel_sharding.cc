@@ -0,0 +1,272 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/tensor_parallel_sharding.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// Returns the constant float or float16 initializer of arg if it has rank dimensions, which AllReduce can sum.
+const TensorProto* GetShardableWeight(const Graph& graph, const NodeArg& arg, int rank) {
+  if (!arg.Exists()) {
+    return nullptr;
+  }
+
+  const auto* weight = graph_utils::GetConstantInitializer(graph, arg.Name());
+  if (weight == nullptr || weight->dims_size() != rank ||
+      (weight->data_type() != TensorProto_DataType_FLOAT && weight->data_type() != TensorProto_DataType_FLOAT16)) {
+    return nullptr;
+  }
+  return weight;
+}
+
+// Adds an initializer with the part of weight of shard out of num_shards. A 2-D weight is split by row if split_rows,
+// otherwise each of its num_blocks blocks of columns is split by column, as is a 1-D bias.
+NodeArg& AddWeightShard(Graph& graph, const TensorProto& weight, bool split_rows, int64_t num_blocks, int64_t shard,
+                        int64_t num_shards) {
+  Initializer source{graph, weight, graph.ModelPath()};
+  const auto dims = source.dims();
+  const auto source_bytes = source.DataAsByteSpan();
+  const size_t element_size = source_bytes.size() / source.size();
+  const auto shard_index = narrow<size_t>(shard);
+
+  TensorShapeVector shard_dims(dims.begin(), dims.end());
+  if (split_rows) {
+    shard_dims.front() /= num_shards;
+  } else {
+    shard_dims.back() /= num_shards;
+  }
+
+  Initializer weight_shard{static_cast<TensorProto_DataType>(source.data_type()),
+                           graph.GenerateNodeArgName(weight.name() + "_shard"), shard_dims};
+  auto shard_bytes = weight_shard.MutableDataAsByteSpan();
+  if (split_rows) {
+    std::copy_n(source_bytes.data() + shard_index * shard_bytes.size(), shard_bytes.size(), shard_bytes.data());
+  } else {
+    const size_t num_rows = dims.size() == 2 ? narrow<size_t>(dims[0]) : 1;
+    const size_t num_cols = narrow<size_t>(dims.back());
+    const size_t block_cols = num_cols / narrow<size_t>(num_blocks);
+    const size_t shard_cols = block_cols / narrow<size_t>(num_shards);
+    auto* dst = shard_bytes.data();
+    for (size_t row = 0; row < num_rows; ++row) {
+      for (size_t block = 0; block < narrow<size_t>(num_blocks); ++block) {
+        const size_t col = block * block_cols + shard_index * shard_cols;
+        dst = std::copy_n(source_bytes.data() + (row * num_cols + col) * element_size, shard_cols * element_size, dst);
+      }
+    }
+  }
+
+  TensorProto shard_proto;
+  weight_shard.ToProto(shard_proto);
+  return graph_utils::AddInitializerWithExternalData(graph, shard_proto);
+}
+
+// Sums the partial results of the ranks in the output of a row parallel node with an AllReduce.
+void AddAllReduce(Graph& graph, Node& node) {
+  NodeArg* output = node.MutableOutputDefs()[0];
+  NodeArg& partial_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output->Name() + "_partial"),
+                                                     output->TypeAsProto());
+
+  auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(node, 0);
+  graph_utils::GraphEdge::RemoveGraphEdges(graph, output_edges);
+  node.MutableOutputDefs()[0] = &partial_output;
+  graph.UpdateProducerNode(partial_output.Name(), node.Index());
+
+  Node& all_reduce = graph.AddNode(graph.GenerateNodeName(node.Name() + "/AllReduce"), "AllReduce",
+                                   "sums the row parallel partial results", {&partial_output}, {output}, nullptr,
+                                   kMSDomain);
+  all_reduce.SetExecutionProviderType(node.GetExecutionProviderType());
+  graph.UpdateProducerNode(output->Name(), all_reduce.Index());
+
+  graph.AddEdge(node.Index(), all_reduce.Index(), 0, 0);
+  for (const auto& edge : output_edges) {
+    graph.AddEdge(all_reduce.Index(), edge.dst_node, 0, edge.dst_arg_index);
+  }
+}
+
+// Returns true if node is elementwise along the columns of a column parallel MatMul, given that its input 0 is the
+// MatMul output. bias_index is set to the input of a 1-D bias that must be sharded with the columns, or -1.
+bool IsColumnwiseNode(const Graph& graph, const Node& node, int& bias_index) {
+  bias_index = -1;
+  const auto& domain = node.Domain();
+  const auto& op_type = node.OpType();
+  if (domain == kOnnxDomain && (op_type == "Relu" || op_type == "Gelu" || op_type == "Sigmoid" ||
+                                op_type == "Tanh" || op_type == "Erf")) {
+    return true;
+  }
+
+  if (domain == kMSDomain && (op_type == "Gelu" || op_type == "QuickGelu")) {
+    return true;
+  }
+
+  if (domain == kMSDomain && (op_type == "FastGelu" || op_type == "BiasGelu")) {
+    if (node.InputDefs().size() < 2 || !node.InputDefs()[1]->Exists()) {
+      return op_type == "FastGelu";
+    }
+    bias_index = 1;
+    return GetShardableWeight(graph, *node.InputDefs()[1], 1) != nullptr;
+  }
+
+  return false;
+}
+
+}  // namespace
+
+bool TensorParallelSharding::ShardMlp(Graph& graph, Node& matmul) const {
+  const TensorProto* weight = GetShardableWeight(graph, *matmul.InputDefs()[1], 2);
+  if (weight == nullptr || weight->dims(1) % world_size_ != 0) {
+    return false;
+  }
+  const int64_t num_cols = weight->dims(1);
+
+  // the nodes between the column parallel and the row parallel MatMul, with the input of their bias if they have one.
+  InlinedVector<std::pair<Node*, int>> columnwise_nodes;
+  Node* node = &matmul;
+  Node* row_parallel_matmul = nullptr;
+  while (row_parallel_matmul == nullptr) {
+    if (!optimizer_utils::CheckOutputEdges(graph, *node, 1)) {
+      return false;
+    }
+
+    Node& next = *graph.GetNode(node->OutputNodesBegin()->Index());
+    if (next.GetExecutionProviderType() != matmul.GetExecutionProviderType()) {
+      return false;
+    }
+
+    const NodeArg* columns = node->OutputDefs()[0];
+    int bias_index = -1;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(next, "MatMul", {1, 9, 13})) {
+      const TensorProto* row_weight = GetShardableWeight(graph, *next.InputDefs()[1], 2);
+      if (next.InputDefs()[0] != columns || row_weight == nullptr || row_weight->dims(0) != num_cols) {
+        return false;
+      }
+      row_parallel_matmul = &next;
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(next, "Add", {7, 13, 14})) {
+      bias_index = next.InputDefs()[0] == columns ? 1 : 0;
+      const TensorProto* bias = GetShardableWeight(graph, *next.InputDefs()[bias_index], 1);
+      if (bias == nullptr || bias->dims(0) != num_cols) {
+        return false;
+      }
+      columnwise_nodes.push_back({&next, bias_index});
+    } else if (next.InputDefs()[0] == columns && IsColumnwiseNode(graph, next, bias_index)) {
+      if (bias_index >= 0 && GetShardableWeight(graph, *next.InputDefs()[bias_index], 1)->dims(0) != num_cols) {
+        return false;
+      }
+      columnwise_nodes.push_back({&next, bias_index});
+    } else {
+      return false;
+    }
+    node = &next;
+  }
+
+  graph_utils::ReplaceNodeInput(matmul, 1, AddWeightShard(graph, *weight, false, 1, rank_, world_size_));
+  matmul.MutableOutputDefs()[0]->ClearShape();
+  for (auto& [columnwise_node, bias_index] : columnwise_nodes) {
+    if (bias_index >= 0) {
+      const TensorProto& bias = *GetShardableWeight(graph, *columnwise_node->InputDefs()[bias_index], 1);
+      graph_utils::ReplaceNodeInput(*columnwise_node, bias_index,
+                                    AddWeightShard(graph, bias, false, 1, rank_, world_size_));
+    }
+    columnwise_node->MutableOutputDefs()[0]->ClearShape();
+  }
+
+  const TensorProto& row_weight = *GetShardableWeight(graph, *row_parallel_matmul->InputDefs()[1], 2);
+  graph_utils::ReplaceNodeInput(*row_parallel_matmul, 1,
+                                AddWeightShard(graph, row_weight, true, 1, rank_, world_size_));
+  AddAllReduce(graph, *row_parallel_matmul);
+  return true;
+}
+
+bool TensorParallelSharding::ShardAttention(Graph& graph, Node& attention) const {
+  const auto* num_heads = graph_utils::GetNodeAttribute(attention, "num_heads");
+  if (num_heads == nullptr || num_heads->i() % world_size_ != 0 ||
+      graph_utils::GetNodeAttribute(attention, "qkv_hidden_sizes") != nullptr) {
+    return false;
+  }
+
+  // past, attention_bias and present are not split by head.
+  const auto& inputs = attention.InputDefs();
+  for (size_t i = 4; i < inputs.size(); ++i) {
+    if (inputs[i]->Exists()) {
+      return false;
+    }
+  }
+  if (attention.OutputDefs().size() > 1 && attention.OutputDefs()[1]->Exists()) {
+    return false;
+  }
+
+  const TensorProto* weight = GetShardableWeight(graph, *inputs[1], 2);
+  if (weight == nullptr || weight->dims(1) % 3 != 0) {
+    return false;
+  }
+  const int64_t hidden_size = weight->dims(1) / 3;
+  const TensorProto* bias = inputs.size() > 2 ? GetShardableWeight(graph, *inputs[2], 1) : nullptr;
+  if (bias == nullptr || bias->dims(0) != 3 * hidden_size) {
+    return false;
+  }
+
+  if (!optimizer_utils::CheckOutputEdges(graph, attention, 1)) {
+    return false;
+  }
+  Node& output_matmul = *graph.GetNode(attention.OutputNodesBegin()->Index());
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(output_matmul, "MatMul", {1, 9, 13}) ||
+      output_matmul.GetExecutionProviderType() != attention.GetExecutionProviderType() ||
+      output_matmul.InputDefs()[0] != attention.OutputDefs()[0]) {
+    return false;
+  }
+  const TensorProto* output_weight = GetShardableWeight(graph, *output_matmul.InputDefs()[1], 2);
+  if (output_weight == nullptr || output_weight->dims(0) != hidden_size) {
+    return false;
+  }
+
+  graph_utils::ReplaceNodeInput(attention, 1, AddWeightShard(graph, *weight, false, 3, rank_, world_size_));
+  graph_utils::ReplaceNodeInput(attention, 2, AddWeightShard(graph, *bias, false, 3, rank_, world_size_));
+  attention.AddAttribute("num_heads", num_heads->i() / world_size_);
+  attention.MutableOutputDefs()[0]->ClearShape();
+
+  graph_utils::ReplaceNodeInput(output_matmul, 1,
+                                AddWeightShard(graph, *output_weight, true, 1, rank_, world_size_));
+  AddAllReduce(graph, output_matmul);
+  return true;
+}
+
+Status TensorParallelSharding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  if (world_size_ <= 1) {
+    return Status::OK();
+  }
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13})) {
+      modified |= ShardMlp(graph, node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Attention", {1}, kMSDomain)) {
+      modified |= ShardAttention(graph, node);
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
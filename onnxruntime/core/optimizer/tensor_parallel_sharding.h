@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief Shard the weights of the MLP and Attention blocks of a transformer model for tensor parallel (Megatron
+ * style) execution, so every rank of a tensor parallel group runs the unsharded model and keeps only its part of the
+ * weights.
+ *
+ * Each rank runs the model in its own session, with the rank and the group size of the NCCL communicator used by the
+ * collective ops (kOrtSessionOptionsConfigTensorParallelRank and kOrtSessionOptionsConfigTensorParallelWorldSize).
+ *
+ * The weights must be constant initializers:
+ * - MLP: MatMul(X, W1) -> [Add(b1) | activations]* -> MatMul(., W2). W1 and b1 are split by column (column parallel)
+ *   and W2 by row (row parallel).
+ * - Attention: Attention(X, Wqkv, bqkv) -> MatMul(., Wo). The Q, K and V columns of Wqkv and bqkv are split by head
+ *   and num_heads is divided by the group size. Wo is split by row.
+ * An AllReduce after the row parallel MatMul sums the partial results of the ranks, so a bias added to it is added
+ * once.
+ */
+class TensorParallelSharding : public GraphTransformer {
+ public:
+  TensorParallelSharding(int64_t rank, int64_t world_size,
+                         const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("TensorParallelSharding", compatible_execution_providers),
+        rank_(rank),
+        world_size_(world_size) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+ private:
+  bool ShardMlp(Graph& graph, Node& matmul) const;
+  bool ShardAttention(Graph& graph, Node& attention) const;
+
+  const int64_t rank_;
+  const int64_t world_size_;
+};
+
+}  // namespace onnxruntime
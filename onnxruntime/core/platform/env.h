@@ -90,6 +90,14 @@ struct ThreadOptions {
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // Learn the cost below which the parallel loops of each kernel run in the calling thread,
+  // see ThreadPool::LoopOwnerScope.
+  bool adaptive_inline_threshold = false;
+
+  // Tune how long the spinning threads spin before blocking from how long they recently waited for work,
+  // instead of spinning a fixed number of times. Only used if the thread pool allows spinning.
+  bool adaptive_spinning = false;
 };
 
 std::ostream& operator<<(std::ostream& os, const LogicalProcessors&);
@@ -148,6 +156,44 @@ class Env {
 
   virtual int GetL2CacheSize() const = 0;
 
+  /// <summary>
+  /// Returns an id for the group of logical processors that share the last level cache with the given logical
+  /// processor, e.g. an AMD CCX. Logical processors with the same id are in the same group.
+  /// The intra-op thread pool prefers stealing work from threads in the same group.
+  /// </summary>
+  /// <param name="logical_processor_id">Logical processor id, as used in ThreadOptions::affinities.</param>
+  /// <returns>Group id, or -1 if it is unknown.</returns>
+  virtual int GetLogicalProcessorDomainId(int /*logical_processor_id*/) const { return -1; }
+
+  /// <summary>
+  /// Returns the number of NUMA nodes of the host, 1 if it is unknown.
+  /// </summary>
+  virtual int GetNumaNodeCount() const { return 1; }
+
+  /// <summary>
+  /// Returns the NUMA node of the logical processor the calling thread is running on, or -1 if it is unknown.
+  /// </summary>
+  virtual int GetCurrentNumaNode() const { return -1; }
+
+  /// <summary>
+  /// Allocates page aligned memory whose pages are placed on the given NUMA node when they are first touched.
+  /// Must be released with FreeOnNumaNode.
+  /// </summary>
+  /// <returns>The memory, or nullptr if placing memory on a NUMA node isn't supported.</returns>
+  virtual void* AllocateOnNumaNode(size_t /*size*/, int /*numa_node*/) const { return nullptr; }
+
+  virtual void FreeOnNumaNode(void* /*p*/, size_t /*size*/) const {}
+
+  /// <summary>
+  /// Allocates memory backed by huge pages. With a huge_page_size of 0 the memory is aligned to and advised for
+  /// the transparent huge pages of the OS, otherwise it is taken from the pool of explicit huge pages of that size.
+  /// size must be a multiple of the page size. Must be released with FreeHugePages.
+  /// </summary>
+  /// <returns>The memory, or nullptr if huge pages of the given kind aren't available.</returns>
+  virtual void* AllocateHugePages(size_t /*size*/, size_t /*huge_page_size*/) const { return nullptr; }
+
+  virtual void FreeHugePages(void* /*p*/, size_t /*size*/) const {}
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
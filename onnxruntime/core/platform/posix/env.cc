@@ -31,8 +31,11 @@ limitations under the License.
 #endif
 #include <unistd.h>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <optional>
+#include <string>
 #include <thread>
 #include <utility>  // for std::forward
 #include <vector>
@@ -317,6 +320,147 @@ class PosixEnv : public Env {
 #endif
   }
 
+  int GetLogicalProcessorDomainId(int logical_processor_id) const override {
+#if defined(ORT_USE_CPUINFO) && defined(__linux__)
+    if (cpuinfo_available_) {
+      const auto num_processors = cpuinfo_get_processors_count();
+      for (uint32_t i = 0; i < num_processors; ++i) {
+        const auto* processor = cpuinfo_get_processor(i);
+        if (processor->linux_id == logical_processor_id) {
+          const auto* l3 = processor->cache.l3;
+          return l3 != nullptr ? narrow<int>(l3->processor_start) : -1;
+        }
+      }
+    }
+#else
+    ORT_UNUSED_PARAMETER(logical_processor_id);
+#endif
+    return -1;
+  }
+
+  int GetNumaNodeCount() const override {
+#if defined(__linux__)
+    // the nodes are listed as ranges, e.g. "0-1", so the count is one more than the last number
+    static const int num_nodes = []() {
+      std::ifstream online("/sys/devices/system/node/online");
+      std::string nodes;
+      if (!std::getline(online, nodes)) {
+        return 1;
+      }
+      const auto last = nodes.find_last_of("-,");
+      const int last_node = atoi(nodes.c_str() + (last == std::string::npos ? 0 : last + 1));
+      return std::max(1, last_node + 1);
+    }();
+    return num_nodes;
+#else
+    return 1;
+#endif
+  }
+
+  int GetCurrentNumaNode() const override {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+      return static_cast<int>(node);
+    }
+#endif
+    return -1;
+  }
+
+  void* AllocateOnNumaNode(size_t size, int numa_node) const override {
+#if defined(__linux__) && defined(SYS_mbind)
+    if (size == 0 || numa_node < 0 || numa_node >= static_cast<int>(8 * sizeof(unsigned long))) {
+      return nullptr;
+    }
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      return nullptr;
+    }
+    // MPOL_PREFERRED, so the allocation falls back to other nodes instead of failing when the node is full
+    constexpr int kMpolPreferred = 1;
+    const unsigned long node_mask = 1UL << numa_node;
+    if (syscall(SYS_mbind, p, size, kMpolPreferred, &node_mask, 8 * sizeof(node_mask), 0) != 0) {
+      munmap(p, size);
+      return nullptr;
+    }
+    return p;
+#else
+    ORT_UNUSED_PARAMETER(size);
+    ORT_UNUSED_PARAMETER(numa_node);
+    return nullptr;
+#endif
+  }
+
+  void FreeOnNumaNode(void* p, size_t size) const override {
+#if defined(__linux__) && defined(SYS_mbind)
+    if (p != nullptr) {
+      munmap(p, size);
+    }
+#else
+    ORT_UNUSED_PARAMETER(p);
+    ORT_UNUSED_PARAMETER(size);
+#endif
+  }
+
+  void* AllocateHugePages(size_t size, size_t huge_page_size) const override {
+#if defined(__linux__) && defined(MAP_HUGETLB) && defined(MADV_HUGEPAGE)
+    if (size == 0) {
+      return nullptr;
+    }
+
+    if (huge_page_size != 0) {
+      // MAP_HUGETLB selects the pool by the log2 of the page size, stored above MAP_HUGE_SHIFT
+      constexpr int kMapHugeShift = 26;
+      int log2_page_size = 0;
+      while ((size_t{1} << log2_page_size) < huge_page_size) {
+        ++log2_page_size;
+      }
+      if ((size_t{1} << log2_page_size) != huge_page_size || size % huge_page_size != 0) {
+        return nullptr;
+      }
+      // private hugetlb mappings reserve their pages here, so an exhausted pool fails now instead of on first touch
+      void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (log2_page_size << kMapHugeShift), -1, 0);
+      return p == MAP_FAILED ? nullptr : p;
+    }
+
+    // transparent huge pages can only back the 2 MB aligned part of a mapping, so map more and trim both ends
+    constexpr uintptr_t kTransparentHugePageSize = 2 * 1024 * 1024;
+    const size_t mapped_size = size + kTransparentHugePageSize;
+    void* p = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      return nullptr;
+    }
+    const uintptr_t start = reinterpret_cast<uintptr_t>(p);
+    const uintptr_t aligned_start = (start + kTransparentHugePageSize - 1) & ~(kTransparentHugePageSize - 1);
+    if (aligned_start != start) {
+      munmap(p, aligned_start - start);
+    }
+    const uintptr_t end = start + mapped_size;
+    if (end != aligned_start + size) {
+      munmap(reinterpret_cast<void*>(aligned_start + size), end - aligned_start - size);
+    }
+    void* aligned = reinterpret_cast<void*>(aligned_start);
+    // fails if the kernel is built without transparent huge pages
+    if (madvise(aligned, size, MADV_HUGEPAGE) != 0) {
+      munmap(aligned, size);
+      return nullptr;
+    }
+    return aligned;
+#else
+    ORT_UNUSED_PARAMETER(size);
+    ORT_UNUSED_PARAMETER(huge_page_size);
+    return nullptr;
+#endif
+  }
+
+  void FreeHugePages(void* p, size_t size) const override {
+    if (p != nullptr) {
+      munmap(p, size);
+    }
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
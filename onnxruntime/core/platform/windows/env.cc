@@ -301,6 +301,47 @@ int WindowsEnv::GetL2CacheSize() const {
   return l2_cache_size_;
 }
 
+int WindowsEnv::GetNumaNodeCount() const {
+  ULONG highest_node = 0;
+  return GetNumaHighestNodeNumber(&highest_node) ? static_cast<int>(highest_node) + 1 : 1;
+}
+
+int WindowsEnv::GetCurrentNumaNode() const {
+  PROCESSOR_NUMBER processor;
+  GetCurrentProcessorNumberEx(&processor);
+  USHORT node = 0;
+  return GetNumaProcessorNodeEx(&processor, &node) ? static_cast<int>(node) : -1;
+}
+
+void* WindowsEnv::AllocateOnNumaNode(size_t size, int numa_node) const {
+  if (size == 0 || numa_node < 0) {
+    return nullptr;
+  }
+  return VirtualAllocExNuma(GetCurrentProcess(), nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE,
+                            static_cast<DWORD>(numa_node));
+}
+
+void WindowsEnv::FreeOnNumaNode(void* p, size_t /*size*/) const {
+  if (p != nullptr) {
+    VirtualFree(p, 0, MEM_RELEASE);
+  }
+}
+
+void* WindowsEnv::AllocateHugePages(size_t size, size_t huge_page_size) const {
+  // Windows has no transparent huge pages, and its large pages need the "Lock pages in memory" privilege
+  const size_t large_page_size = GetLargePageMinimum();
+  if (size == 0 || large_page_size == 0 || huge_page_size != large_page_size || size % large_page_size != 0) {
+    return nullptr;
+  }
+  return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+}
+
+void WindowsEnv::FreeHugePages(void* p, size_t /*size*/) const {
+  if (p != nullptr) {
+    VirtualFree(p, 0, MEM_RELEASE);
+  }
+}
+
 WindowsEnv& WindowsEnv::Instance() {
   static WindowsEnv default_env;
   return default_env;
@@ -439,30 +480,29 @@ Status WindowsEnv::MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path,
   SYSTEM_INFO sysinfo;
   GetSystemInfo(&sysinfo);
 
-  static const DWORD page_size = sysinfo.dwPageSize;
+  // MapViewOfFile requires the offset to be a multiple of the allocation granularity, so map from the closest
+  // preceding multiple and return a pointer into the view.
   static const DWORD allocation_granularity = sysinfo.dwAllocationGranularity;
-  const FileOffsetType offset_to_page = offset % static_cast<FileOffsetType>(page_size);
-  const size_t mapped_length = length + static_cast<size_t>(offset_to_page);
-  const FileOffsetType mapped_offset = offset - offset_to_page;
-  if (mapped_offset % allocation_granularity != 0) {
-    const auto error_code = GetLastError();
-    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
-                           "mapped offset must be a multiple of the allocation granularity",
-                           " , mapped_offset = ", mapped_offset,
-                           " , allocation_granularity = ", allocation_granularity,
-                           " , errcode = ", error_code,
-                           " - ", std::system_category().message(error_code));
-  }
+  const FileOffsetType offset_to_granularity = offset % static_cast<FileOffsetType>(allocation_granularity);
+  const size_t mapped_length = length + static_cast<size_t>(offset_to_granularity);
+  const FileOffsetType mapped_offset = offset - offset_to_granularity;
 
   void* const mapped_base = MapViewOfFile(file_mapping_handle.get(),
                                           FILE_MAP_READ,
                                           static_cast<DWORD>((mapped_offset >> 32) & 0xFFFFFFFF),
                                           static_cast<DWORD>(mapped_offset & 0xFFFFFFFF),
                                           mapped_length);
+  if (mapped_base == nullptr) {
+    const auto error_code = GetLastError();
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "map view of file ", ToUTF8String(Basename(file_path)),
+                           " fail, errcode = ", error_code,
+                           " - ", std::system_category().message(error_code));
+  }
   GSL_SUPPRESS(r.11)
 
   mapped_memory =
-      MappedMemoryPtr{reinterpret_cast<char*>(mapped_base) + offset_to_page,
+      MappedMemoryPtr{reinterpret_cast<char*>(mapped_base) + offset_to_granularity,
                       [mapped_base](void*) {
                         UnmapFile(mapped_base);
                       }};
@@ -56,6 +56,12 @@ class WindowsEnv : public Env {
   int GetNumPhysicalCpuCores() const override;
   std::vector<LogicalProcessors> GetDefaultThreadAffinities() const override;
   int GetL2CacheSize() const override;
+  int GetNumaNodeCount() const override;
+  int GetCurrentNumaNode() const override;
+  void* AllocateOnNumaNode(size_t size, int numa_node) const override;
+  void FreeOnNumaNode(void* p, size_t size) const override;
+  void* AllocateHugePages(size_t size, size_t huge_page_size) const override;
+  void FreeHugePages(void* p, size_t size) const override;
   static WindowsEnv& Instance();
   PIDType GetSelfPid() const override;
   Status GetFileLength(_In_z_ const ORTCHAR_T* file_path, size_t& length) const override;
@@ -84,6 +84,44 @@ InlinedVector<int64_t> GetStaticOutputShape(gsl::span<const int64_t> inferred_sh
   return static_shape;
 }
 
+// Creates a MLMultiArray of the contiguous `shape` over `data_pointer`, which the array doesn't own.
+Status CreateMultiArrayWithDataPointer(void* data_pointer, gsl::span<const int64_t> shape,
+                                       MLMultiArrayDataType data_type, const std::string& name,
+                                       MLMultiArray* __autoreleasing* _Nonnull multi_array_out) {
+  NSError* error = nil;
+
+  NSMutableArray* shape_array = [NSMutableArray arrayWithCapacity:shape.size()];
+  for (const auto dim : shape) {
+    [shape_array addObject:[NSNumber numberWithLongLong:dim]];
+  }
+
+  NSMutableArray* strides_array = [NSMutableArray arrayWithCapacity:shape.size()];
+  {
+    int64_t stride = 1;
+    for (size_t idx = 0; idx < shape.size(); ++idx) {
+      const size_t idx_from_end = shape.size() - 1 - idx;
+      [strides_array insertObject:[NSNumber numberWithLongLong:stride]
+                          atIndex:0];
+
+      stride *= shape[idx_from_end];
+    }
+  }
+
+  MLMultiArray* multi_array = [[MLMultiArray alloc] initWithDataPointer:data_pointer
+                                                                  shape:shape_array
+                                                               dataType:data_type
+                                                                strides:strides_array
+                                                            deallocator:^(void* /* bytes */) {
+                                                            }
+                                                                  error:&error];
+  ORT_RETURN_IF(error != nil || multi_array == nil,
+                "Failed to create MLMultiArray for feature: ", name,
+                (error != nil) ? MakeString(", error: ", [[error localizedDescription] UTF8String]) : "");
+
+  *multi_array_out = multi_array;
+  return Status::OK();
+}
+
 Status CreateInputFeatureProvider(const std::unordered_map<std::string, OnnxTensorData>& inputs,
                                   const logging::Logger& logger,
                                   id<MLFeatureProvider> __autoreleasing* _Nonnull feature_provider_out,
@@ -96,23 +134,6 @@ Status CreateInputFeatureProvider(const std::unordered_map<std::string, OnnxTens
   for (const auto& [name, onnx_tensor_data] : inputs) {
     const auto& shape = onnx_tensor_data.tensor_info.shape;
 
-    NSMutableArray* shape_array = [NSMutableArray arrayWithCapacity:shape.size()];
-    for (const auto dim : shape) {
-      [shape_array addObject:[NSNumber numberWithLongLong:dim]];
-    }
-
-    NSMutableArray* strides_array = [NSMutableArray arrayWithCapacity:shape.size()];
-    {
-      int64_t stride = 1;
-      for (size_t idx = 0; idx < shape.size(); ++idx) {
-        const size_t idx_from_end = shape.size() - 1 - idx;
-        [strides_array insertObject:[NSNumber numberWithLongLong:stride]
-                            atIndex:0];
-
-        stride *= shape[idx_from_end];
-      }
-    }
-
     MLMultiArrayDataType data_type;
     void* data_pointer = onnx_tensor_data.buffer;
 
@@ -152,16 +173,8 @@ Status CreateInputFeatureProvider(const std::unordered_map<std::string, OnnxTens
       }
     }
 
-    MLMultiArray* multi_array = [[MLMultiArray alloc] initWithDataPointer:data_pointer
-                                                                    shape:shape_array
-                                                                 dataType:data_type
-                                                                  strides:strides_array
-                                                              deallocator:^(void* /* bytes */) {
-                                                              }
-                                                                    error:&error];
-    ORT_RETURN_IF(error != nil || multi_array == nil,
-                  "Failed to create MLMultiArray for feature: ", name,
-                  (error != nil) ? MakeString(", error: ", [[error localizedDescription] UTF8String]) : "");
+    MLMultiArray* multi_array = nil;
+    ORT_RETURN_IF_ERROR(CreateMultiArrayWithDataPointer(data_pointer, shape, data_type, name, &multi_array));
 
     MLFeatureValue* feature_value = [MLFeatureValue featureValueWithMultiArray:multi_array];
     NSString* feature_name = util::Utf8StringToNSString(name.c_str());
@@ -590,6 +603,48 @@ Status Execution::Predict(const std::unordered_map<std::string, OnnxTensorData>&
         ORT_RETURN_IF_ERROR(CreateInputFeatureProvider(inputs, logger_, &input_features, conversion_buffers));
 
         MLPredictionOptions* options = [[MLPredictionOptions alloc] init];
+
+        // Back the outputs of static shape with the ORT output buffers, so that CoreML can write them in place.
+        // CoreML may still return its own array for an output, e.g. in another layout, which is then copied below.
+        std::unordered_map<std::string, const void*> output_backing_buffers;
+        if (@available(macOS 13.0, iOS 16.0, *)) {
+          NSMutableDictionary* output_backings = [NSMutableDictionary dictionaryWithCapacity:outputs.size()];
+          for (const auto& [output_name, output_tensor_info] : outputs) {
+            const auto& shape = output_tensor_info.shape;
+            if (shape.empty() || !IsStaticShape(shape)) {
+              continue;
+            }
+
+            MLMultiArrayDataType data_type;
+            switch (output_tensor_info.data_type) {
+              case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
+                data_type = MLMultiArrayDataTypeFloat32;
+                break;
+              case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+                data_type = MLMultiArrayDataTypeFloat16;
+                break;
+              case ONNX_NAMESPACE::TensorProto_DataType_INT32:
+                data_type = MLMultiArrayDataTypeInt32;
+                break;
+              default:
+                // int64 outputs are converted from the int32 CoreML outputs
+                continue;
+            }
+
+            void* output_buffer = get_output_tensor_mutable_raw_data_fn(output_name, output_tensor_info.data_type,
+                                                                        shape);
+            MLMultiArray* multi_array = nil;
+            ORT_RETURN_IF_ERROR(CreateMultiArrayWithDataPointer(output_buffer, shape, data_type, output_name,
+                                                                &multi_array));
+            output_backings[util::Utf8StringToNSString(output_name.c_str())] = multi_array;
+            output_backing_buffers.emplace(output_name, output_buffer);
+          }
+
+          if (output_backings.count > 0) {
+            options.outputBackings = output_backings;
+          }
+        }
+
         NSError* error = nil;
         id<MLFeatureProvider> output_features = [model_ predictionFromFeatures:input_features
                                                                        options:options
@@ -610,6 +665,19 @@ Status Execution::Predict(const std::unordered_map<std::string, OnnxTensorData>&
 
           MLMultiArray* data = [output_value multiArrayValue];
 
+          if (auto it = output_backing_buffers.find(output_name); it != output_backing_buffers.end()) {
+            if (@available(macOS 13.0, iOS 16.0, *)) {
+              const void* output_backing_buffer = it->second;
+              __block bool written_in_place = false;
+              [data getBytesWithHandler:^(const void* bytes, NSInteger /* size */) {
+                written_in_place = bytes == output_backing_buffer;
+              }];
+              if (written_in_place) {
+                continue;
+              }
+            }
+          }
+
           const auto coreml_static_output_shape = [data]() {
             InlinedVector<int64_t> result;
             result.reserve(data.shape.count);
@@ -46,13 +46,13 @@ REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(Relu, 14, float);
 REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(Relu, 14, double);
 REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(Relu, 14, int8_t);
 REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(Relu, 14, int32_t);
-#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) || defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
 REGISTER_VERSIONED_UNARY_ELEMENTWISE_TYPED_KERNEL(Relu, 6, 12, MLFloat16);
 REGISTER_VERSIONED_UNARY_ELEMENTWISE_TYPED_KERNEL(Relu, 13, 13, MLFloat16);
 REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(Relu, 14, MLFloat16);
 REGISTER_VERSIONED_UNARY_ELEMENTWISE_TYPED_KERNEL(LeakyRelu, 6, 15, MLFloat16);
 REGISTER_UNARY_ELEMENTWISE_TYPED_KERNEL(LeakyRelu, 16, MLFloat16);
-#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+#endif
 
 REGISTER_VERSIONED_UNARY_ELEMENTWISE_KERNEL(Selu, 6, 21);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(Selu, 22);
@@ -13,6 +13,7 @@
 #include "core/providers/cpu/controlflow/utils.h"
 
 #include "core/framework/allocator.h"
+#include "core/framework/device_stream_collection.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
@@ -225,6 +226,11 @@ class LoopImpl {
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
   void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
 
+  // Keep the loop carried var inputs of the previous iteration that no other value shares a buffer with, so the
+  // current iteration can write its outputs to them.
+  void UpdateSpareLoopCarriedVars(const std::vector<OrtValue>& last_outputs, const std::vector<OrtValue>& last_inputs,
+                                  gsl::span<const bool> owned);
+
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
 
@@ -244,9 +250,23 @@ class LoopImpl {
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
+  // the loop carried vars of the iteration before the previous one, which are no longer used by any feed or fetch.
+  // an iteration writes its loop carried var outputs to them when the shape matches, so the loop carried vars with a
+  // fixed shape alternate between two buffers rather than being allocated on every iteration.
+  std::vector<OrtValue> spare_loop_carried_vars_;
+
   const Loop::ConcatOutput& concat_output_func_;
 };
 
+// the buffer of a tensor that the subgraph can write to, or nullptr
+static const void* WritableTensorData(const OrtValue& value) {
+  if (!value.IsTensor()) {
+    return nullptr;
+  }
+  const auto& tensor = value.Get<Tensor>();
+  return tensor.IsDataTypeString() || tensor.SizeInBytes() == 0 ? nullptr : tensor.DataRaw();
+}
+
 static Status ConcatenateCpuOutput(void* /*stream*/,
                                    std::vector<OrtValue>& per_iteration_output,
                                    void* output, size_t output_size_in_bytes) {
@@ -445,6 +465,7 @@ Status LoopImpl::Initialize() {
   condition_mlvalue_ = MakeScalarMLValue<bool>(cpu_allocator, condition_, condition_rank != 0);
 
   loop_output_tensors_.resize(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
+  spare_loop_carried_vars_.resize(info_.num_loop_carried_vars);
 
   return status;
 }
@@ -484,6 +505,28 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
   }
 }
 
+void LoopImpl::UpdateSpareLoopCarriedVars(const std::vector<OrtValue>& last_outputs,
+                                          const std::vector<OrtValue>& last_inputs,
+                                          gsl::span<const bool> owned) {
+  // last_inputs: iter_num, cond, loop vars... are the outputs of the iteration before, which had a buffer of their
+  // own if 'owned'. they can be written to unless the last iteration passed them through to an output.
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    auto& spare = spare_loop_carried_vars_[i];
+    spare = OrtValue();
+
+    const OrtValue& input = last_inputs[static_cast<ptrdiff_t>(i) + 2];
+    const void* data = WritableTensorData(input);
+    if (!owned[i] || data == nullptr) {
+      continue;
+    }
+
+    if (std::none_of(last_outputs.begin(), last_outputs.end(),
+                     [data](const OrtValue& output) { return WritableTensorData(output) == data; })) {
+      spare = input;
+    }
+  }
+}
+
 Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index) {
   const auto& first_output = per_iteration_output.front().Get<Tensor>();
   const auto& per_iteration_dims = first_output.Shape().GetDims();
@@ -512,16 +555,45 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   CreateInitialFeeds(feeds);
 
+  // the loop carried var outputs are written to the spare buffers when they fit
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    fetch_allocators[static_cast<size_t>(i) + 1] = [this, i](const TensorShape& shape, const OrtDevice& location,
+                                                             OrtValue& ort_value, bool& allocated) {
+      auto& spare = spare_loop_carried_vars_[i];
+      if (spare.IsAllocated() && spare.Get<Tensor>().Shape() == shape &&
+          spare.Get<Tensor>().Location().device == location) {
+        ort_value = std::move(spare);
+        allocated = true;
+      }
+      return Status::OK();
+    };
+  }
+
+  // whether each loop carried var output of the last two iterations has a buffer that no other feed or fetch of its
+  // iteration uses.
+  InlinedVector<bool> outputs_owned(info_.num_loop_carried_vars, false);
+  InlinedVector<bool> previous_outputs_owned(info_.num_loop_carried_vars, false);
+
+#ifdef ORT_ENABLE_STREAM
+  // acquire the device streams once for all the iterations
+  DeviceStreamCollectionHolder device_stream_collection_holder(&session_state_);
+#endif
+
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
+      UpdateSpareLoopCarriedVars(fetches, feeds, previous_outputs_owned);
       SaveOutputsAndUpdateFeeds(fetches, feeds);
       fetches.clear();
     }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger(),
+#ifdef ORT_ENABLE_STREAM
+                                    device_stream_collection_holder,
+#endif
                                     context_.GetComputeStream(),
                                     // because the fetch[0] is the loop condition which we need to access on CPU,
                                     // have to perofrm a stream sync to make sure the data arrived.
@@ -530,6 +602,15 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
     condition_mlvalue_ = fetches[0];
 
+    std::swap(outputs_owned, previous_outputs_owned);
+    for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+      const void* data = WritableTensorData(fetches[static_cast<ptrdiff_t>(i) + 1]);
+      auto is_shared = [data](const OrtValue& value) { return WritableTensorData(value) == data; };
+      outputs_owned[i] = data != nullptr &&
+                         std::none_of(feeds.begin(), feeds.end(), is_shared) &&
+                         std::count_if(fetches.begin(), fetches.end(), is_shared) == 1;
+    }
+
     ++iter_num_value;
   }
 
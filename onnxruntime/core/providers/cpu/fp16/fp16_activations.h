@@ -7,7 +7,7 @@
 #include "core/framework/float16.h"
 #include "core/providers/cpu/activation/activations.h"
 
-#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) || defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
 
 namespace onnxruntime {
 namespace functors {
@@ -80,4 +80,4 @@ struct LeakyRelu<MLFloat16> : public ElementWiseRangedTransform<MLFloat16> {
 }  // namespace functors
 }  // namespace onnxruntime
 
-#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+#endif
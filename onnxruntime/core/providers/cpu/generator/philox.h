@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace philox {
+
+// Counter-based sampling for the CPU random ops.
+//
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3") maps a 64 bit key, the seed, and a
+// 128 bit counter to four 32 bit random values. There is no state to carry from one value to the next, so sample i
+// of a tensor is drawn from counter offset + i / SamplesPerBlock<T>() and any range of the tensor can be filled on
+// any thread: the samples only depend on the seed and the offset, not on the number of threads.
+
+using Block = std::array<uint32_t, 4>;
+
+inline Block Generate(uint64_t key, uint64_t counter) {
+  constexpr uint32_t kMul0 = 0xD2511F53;
+  constexpr uint32_t kMul1 = 0xCD9E8D57;
+  constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  constexpr uint32_t kWeyl1 = 0xBB67AE85;
+
+  Block x{static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), 0, 0};
+  uint32_t k0 = static_cast<uint32_t>(key);
+  uint32_t k1 = static_cast<uint32_t>(key >> 32);
+  for (int round = 0; round < 10; ++round) {
+    const uint64_t product0 = static_cast<uint64_t>(kMul0) * x[0];
+    const uint64_t product1 = static_cast<uint64_t>(kMul1) * x[2];
+    x = {static_cast<uint32_t>(product1 >> 32) ^ x[1] ^ k0, static_cast<uint32_t>(product1),
+         static_cast<uint32_t>(product0 >> 32) ^ x[3] ^ k1, static_cast<uint32_t>(product0)};
+    k0 += kWeyl0;
+    k1 += kWeyl1;
+  }
+  return x;
+}
+
+// A float sample uses 32 bits of a block and a double sample 64 bits.
+template <typename T>
+constexpr size_t SamplesPerBlock() {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8, "float or double samples");
+  return sizeof(Block) / sizeof(T);
+}
+
+// The number of counters used by count samples, by which the offset of the next call is advanced.
+template <typename T>
+uint64_t BlockCount(size_t count) {
+  return (static_cast<uint64_t>(count) + SamplesPerBlock<T>() - 1) / SamplesPerBlock<T>();
+}
+
+// Uniform samples in [0, 1) from 24 random bits for float and 53 for double.
+template <typename T>
+void ToUniform(const Block& block, T* samples);
+
+template <>
+inline void ToUniform<float>(const Block& block, float* samples) {
+  for (size_t i = 0; i < 4; ++i) {
+    samples[i] = static_cast<float>(block[i] >> 8) * (1.0f / 16777216.0f);
+  }
+}
+
+template <>
+inline void ToUniform<double>(const Block& block, double* samples) {
+  for (size_t i = 0; i < 2; ++i) {
+    const uint64_t bits = (static_cast<uint64_t>(block[2 * i]) << 21) ^ (block[2 * i + 1] >> 11);
+    samples[i] = static_cast<double>(bits) * (1.0 / 9007199254740992.0);
+  }
+}
+
+// Standard normal samples by the Box-Muller transform of pairs of uniform samples. The first of each pair is moved
+// from [0, 1) to (0, 1] for the logarithm.
+template <typename T>
+void ToNormal(const Block& block, T* samples) {
+  constexpr size_t kSamples = SamplesPerBlock<T>();
+  constexpr T kUniformStep = sizeof(T) == 4 ? T(1.0 / 16777216.0) : T(1.0 / 9007199254740992.0);
+  constexpr T kTwoPi = T(6.283185307179586476925286766559);
+  T uniforms[kSamples];
+  ToUniform<T>(block, uniforms);
+  for (size_t i = 0; i < kSamples; i += 2) {
+    const T radius = std::sqrt(T(-2) * std::log(uniforms[i] + kUniformStep));
+    const T angle = kTwoPi * uniforms[i + 1];
+    samples[i] = radius * std::cos(angle);
+    samples[i + 1] = radius * std::sin(angle);
+  }
+}
+
+/**
+ * Fills output with count samples drawn from the counters starting at offset, in parallel.
+ * @param transform void(const Block&, T* samples) converting a block to SamplesPerBlock<T>() samples.
+ * @param cost_per_block the compute cost of generating and transforming a block.
+ */
+template <typename T, typename Transform>
+void Fill(uint64_t seed, uint64_t offset, T* output, size_t count, concurrency::ThreadPool* thread_pool,
+          double cost_per_block, Transform transform) {
+  constexpr size_t kSamples = SamplesPerBlock<T>();
+  const auto num_blocks = static_cast<std::ptrdiff_t>(BlockCount<T>(count));
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, num_blocks, TensorOpCost{0, static_cast<double>(kSamples * sizeof(T)), cost_per_block},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        T samples[kSamples];
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          transform(Generate(seed, offset + static_cast<uint64_t>(block)), samples);
+          const size_t begin = static_cast<size_t>(block) * kSamples;
+          std::copy_n(samples, std::min(kSamples, count - begin), output + begin);
+        }
+      });
+}
+
+}  // namespace philox
+}  // namespace onnxruntime
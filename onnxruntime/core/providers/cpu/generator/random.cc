@@ -26,8 +26,10 @@ limitations under the License.
 #include <random>
 
 #include "core/common/eigen_common_wrapper.h"
+#include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/providers/cpu/generator/philox.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math_cpuonly.h"
 
@@ -126,11 +128,10 @@ ONNX_CPU_OPERATOR_KERNEL(
                         BuildKernelDefConstraintsFromTypeList<EnabledMultinomialOutputTypes>()),
     Multinomial);
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine& generator, TDistribution distribution, Tensor& tensor);
-
-static Status RandomNormalCompute(float mean, float scale, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
-static Status RandomUniformCompute(float high, float low, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
+static Status RandomNormalCompute(float mean, float scale, PhiloxGenerator& generator, TensorProto::DataType dtype,
+                                  Tensor& Y, concurrency::ThreadPool* thread_pool);
+static Status RandomUniformCompute(float low, float high, PhiloxGenerator& generator, TensorProto::DataType dtype,
+                                   Tensor& Y, concurrency::ThreadPool* thread_pool);
 
 static Status CreateOutputTensorFromTensorShape(OpKernelContext* ctx, const Tensor& X, Tensor** Y);
 static TensorProto::DataType InferDataType(const Tensor& tensor);
@@ -138,8 +139,7 @@ static TensorProto::DataType InferDataType(const Tensor& tensor);
 Status RandomNormal::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
-  std::lock_guard<std::mutex> l(generator_mutex_);
-  auto status = RandomNormalCompute(mean_, scale_, generator_, dtype_, Y);
+  auto status = RandomNormalCompute(mean_, scale_, generator_, dtype_, Y, ctx->GetOperatorThreadPool());
 
   return status;
 }
@@ -147,8 +147,7 @@ Status RandomNormal::Compute(OpKernelContext* ctx) const {
 Status RandomUniform::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
-  std::lock_guard<std::mutex> l(generator_mutex_);
-  auto status = RandomUniformCompute(low_, high_, generator_, dtype_, Y);
+  auto status = RandomUniformCompute(low_, high_, generator_, dtype_, Y, ctx->GetOperatorThreadPool());
 
   return status;
 }
@@ -169,8 +168,7 @@ Status RandomNormalLike::Compute(OpKernelContext* ctx) const {
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
 
-  std::lock_guard<std::mutex> l(generator_mutex_);
-  status = RandomNormalCompute(mean_, scale_, generator_, dtype, *Y);
+  status = RandomNormalCompute(mean_, scale_, generator_, dtype, *Y, ctx->GetOperatorThreadPool());
 
   return status;
 }
@@ -190,8 +188,7 @@ Status RandomUniformLike::Compute(OpKernelContext* ctx) const {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
-  std::lock_guard<std::mutex> l(generator_mutex_);
-  status = RandomUniformCompute(low_, high_, generator_, dtype, *Y);
+  status = RandomUniformCompute(low_, high_, generator_, dtype, *Y, ctx->GetOperatorThreadPool());
 
   return status;
 }
@@ -346,23 +343,50 @@ static TensorProto::DataType InferDataType(const Tensor& tensor) {
   return static_cast<TensorProto::DataType>(dtype);
 }
 
-static Status RandomNormalCompute(float mean, float scale,
-                                  std::default_random_engine& generator,
-                                  TensorProto::DataType dtype, Tensor& Y) {
+// The samples of a call are drawn from the next counters of the generator, so consecutive calls draw different
+// samples. They are generated in parallel and do not depend on the number of threads.
+template <typename T>
+static void GenerateNormal(T mean, T scale, PhiloxGenerator& generator, Tensor& tensor,
+                           concurrency::ThreadPool* thread_pool) {
+  const auto count = narrow<size_t>(tensor.Shape().Size());
+  const auto [seed, offset] = generator.NextPhiloxSeeds(philox::BlockCount<T>(count));
+  philox::Fill<T>(seed, offset, tensor.MutableData<T>(), count, thread_pool, 200.0,
+                  [mean, scale](const philox::Block& block, T* samples) {
+                    philox::ToNormal<T>(block, samples);
+                    for (size_t i = 0; i < philox::SamplesPerBlock<T>(); ++i) {
+                      samples[i] = mean + scale * samples[i];
+                    }
+                  });
+}
+
+template <typename T>
+static void GenerateUniform(T low, T high, PhiloxGenerator& generator, Tensor& tensor,
+                            concurrency::ThreadPool* thread_pool) {
+  const auto count = narrow<size_t>(tensor.Shape().Size());
+  const auto [seed, offset] = generator.NextPhiloxSeeds(philox::BlockCount<T>(count));
+  philox::Fill<T>(seed, offset, tensor.MutableData<T>(), count, thread_pool, 60.0,
+                  [low, high](const philox::Block& block, T* samples) {
+                    philox::ToUniform<T>(block, samples);
+                    for (size_t i = 0; i < philox::SamplesPerBlock<T>(); ++i) {
+                      samples[i] = low + (high - low) * samples[i];
+                    }
+                  });
+}
+
+static Status RandomNormalCompute(float mean, float scale, PhiloxGenerator& generator, TensorProto::DataType dtype,
+                                  Tensor& Y, concurrency::ThreadPool* thread_pool) {
   bool handled = false;
   switch (dtype) {
     case TensorProto::FLOAT: {
       if (utils::HasType<EnabledRandomNormalComputeOutputTypes, float>()) {
-        GenerateData<float, std::normal_distribution<float>>(
-            generator, std::normal_distribution<float>{mean, scale}, Y);
+        GenerateNormal<float>(mean, scale, generator, Y, thread_pool);
         handled = true;
       }
       break;
     }
     case TensorProto::DOUBLE: {
       if (utils::HasType<EnabledRandomNormalComputeOutputTypes, double>()) {
-        GenerateData<double, std::normal_distribution<double>>(
-            generator, std::normal_distribution<double>{mean, scale}, Y);
+        GenerateNormal<double>(mean, scale, generator, Y, thread_pool);
         handled = true;
       }
       break;
@@ -378,24 +402,20 @@ static Status RandomNormalCompute(float mean, float scale,
   return Status::OK();
 }
 
-static Status RandomUniformCompute(float low, float high,
-                                   std::default_random_engine& generator,
-                                   TensorProto::DataType dtype,
-                                   Tensor& Y) {
+static Status RandomUniformCompute(float low, float high, PhiloxGenerator& generator, TensorProto::DataType dtype,
+                                   Tensor& Y, concurrency::ThreadPool* thread_pool) {
   bool handled = false;
   switch (dtype) {
     case TensorProto::FLOAT: {
       if (utils::HasType<EnabledRandomUniformComputeOutputTypes, float>()) {
-        GenerateData<float, std::uniform_real_distribution<float>>(
-            generator, std::uniform_real_distribution<float>{low, high}, Y);
+        GenerateUniform<float>(low, high, generator, Y, thread_pool);
         handled = true;
       }
       break;
     }
     case TensorProto::DOUBLE: {
       if (utils::HasType<EnabledRandomUniformComputeOutputTypes, double>()) {
-        GenerateData<double, std::uniform_real_distribution<double>>(
-            generator, std::uniform_real_distribution<double>{low, high}, Y);
+        GenerateUniform<double>(low, high, generator, Y, thread_pool);
         handled = true;
       }
       break;
@@ -411,15 +431,6 @@ static Status RandomUniformCompute(float low, float high,
   return Status::OK();
 }
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine& generator, TDistribution distribution, Tensor& tensor) {
-  T* out = tensor.MutableData<T>();
-  for (int64_t i = 0, end = tensor.Shape().Size(); i < end; ++i) {
-    *out = distribution(generator);
-    ++out;
-  }
-}
-
 template Status MultinomialComputeShared<int64_t>(AllocatorPtr& alloc,
                                                   const Tensor& X,
                                                   const int64_t batch_size,
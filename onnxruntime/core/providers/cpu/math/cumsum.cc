@@ -2,17 +2,24 @@
 // Licensed under the MIT License.
 
 #include <functional>
+#include <numeric>
 
 #include "cumsum.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/util/parallel_scan.h"
 
 using namespace onnxruntime;
 
 namespace onnxruntime {
 
+namespace {
+// the minimum number of elements of each block of the parallel scan
+constexpr std::ptrdiff_t kMinScanBlockSize = 64 * 1024;
+}  // namespace
+
 namespace cumsum_op {
 Status GetAxis(const Tensor* axis_tensor, int64_t input_rank, int64_t& axis_out) {
   if (!axis_tensor)
@@ -177,6 +184,38 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   const int64_t lower_dim_size =  // sizes of the slices we can treat as 1D arrays
       std::accumulate(input_shape.begin() + axis + 1, input_shape.end(), static_cast<int64_t>(1), std::multiplies<int64_t>());
 
+  // a long innermost axis, e.g. the CumSum of a flat tensor, is scanned in parallel blocks. the blocks are summed
+  // separately before they are scanned, so float results can differ in the last bits from a sequential sum.
+  if (lower_dim_size == 1) {
+    ParallelScan<T> scan(ctx->GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(dim), kMinScanBlockSize);
+    if (scan.NumBlocks() > 1) {
+      for (int64_t outer = 0; outer < upper_dim_count; outer++) {
+        const T* input_data = input->Data<T>() + outer * dim;
+        T* output_data = output_tensor.MutableData<T>() + outer * dim;
+
+        // the position i of the scan is the element dim - 1 - i of the slice if reverse
+        scan.Reduce([&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          const T* begin = reverse_ ? input_data + (dim - last) : input_data + first;
+          return std::accumulate(begin, begin + (last - first), T{});
+        });
+        scan.Scan([&](std::ptrdiff_t first, std::ptrdiff_t last, T sum) {
+          for (std::ptrdiff_t i = first; i < last; i++) {
+            const std::ptrdiff_t element = reverse_ ? dim - 1 - i : i;
+            if (exclusive_) {
+              output_data[element] = sum;
+              sum += input_data[element];
+            } else {
+              sum += input_data[element];
+              output_data[element] = sum;
+            }
+          }
+        });
+      }
+
+      return Status::OK();
+    }
+  }
+
   if (!reverse_) {
     const auto* input_iter = input->Data<T>();
     auto* output_iter = output_tensor.MutableData<T>();
@@ -9,6 +9,7 @@
 #include "einsum_utils/einsum_typed_compute_processor.h"
 #endif
 #include "einsum_utils/einsum_compute_preprocessor.h"
+#include "einsum_utils/einsum_contraction_path.h"
 
 namespace onnxruntime {
 
@@ -29,6 +30,9 @@ class Einsum : public OpKernel {
 
   std::string equation_;
   std::unique_ptr<EinsumEquationPreprocessor> einsum_equation_preprocessor_;
+
+  // Contraction paths of the input shapes seen so far (used by the CPU kernel)
+  mutable EinsumOp::ContractionPathCache contraction_path_cache_;
 };
 
 }  // namespace onnxruntime
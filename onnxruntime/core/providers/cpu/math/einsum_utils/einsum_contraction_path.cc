@@ -0,0 +1,307 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "einsum_contraction_path.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+namespace {
+
+// Paths that save less than this fraction of the multiply-adds of the left to right order are not worth deviating
+// from it.
+constexpr double kMinContractionPathSavings = 0.01;
+
+// The subscript labels an operand has (dim value > 1) and the dim value of each, in the homogenized order.
+using OperandDims = InlinedVector<int64_t>;
+
+struct ContractionProblem {
+  ContractionProblem(gsl::span<const TensorShape> homogenized_input_dims,
+                     gsl::span<const int64_t> subscript_indices_to_output_indices)
+      : num_labels(subscript_indices_to_output_indices.size()) {
+    inputs.reserve(homogenized_input_dims.size());
+    for (const auto& dims : homogenized_input_dims) {
+      ORT_ENFORCE(dims.NumDimensions() == num_labels, "Einsum op: Input dims are not homogenized");
+      inputs.emplace_back(dims.GetDims().begin(), dims.GetDims().end());
+    }
+    in_output.reserve(num_labels);
+    for (auto output_index : subscript_indices_to_output_indices) {
+      in_output.push_back(output_index != -1);
+    }
+
+    // the labels only one input has are summed over before that input is contracted with another
+    for (size_t label = 0; label < num_labels; ++label) {
+      size_t num_inputs_with_label = 0;
+      for (const auto& input : inputs) {
+        num_inputs_with_label += input[label] > 1 ? 1 : 0;
+      }
+      if (!in_output[label] && num_inputs_with_label == 1) {
+        for (auto& input : inputs) {
+          input[label] = 1;
+        }
+      }
+    }
+  }
+
+  size_t num_labels;
+  std::vector<OperandDims> inputs;
+  InlinedVector<bool> in_output;
+};
+
+// The dims of the result of contracting `left` and `right` while the operands in `others` are still pending,
+// and the number of multiply-adds it takes.
+OperandDims Contract(const ContractionProblem& problem, const OperandDims& left, const OperandDims& right,
+                     gsl::span<const OperandDims* const> others, double& cost) {
+  OperandDims result(problem.num_labels, 1);
+  cost = 1.0;
+  for (size_t label = 0; label < problem.num_labels; ++label) {
+    const int64_t dim = std::max(left[label], right[label]);
+    if (dim <= 1) {
+      continue;
+    }
+
+    cost *= static_cast<double>(dim);
+    bool is_kept = problem.in_output[label];
+    for (size_t i = 0; !is_kept && i < others.size(); ++i) {
+      is_kept = (*others[i])[label] > 1;
+    }
+    if (is_kept) {
+      result[label] = dim;
+    }
+  }
+
+  return result;
+}
+
+double LeftToRightCost(const ContractionProblem& problem) {
+  const size_t num_inputs = problem.inputs.size();
+  InlinedVector<const OperandDims*> others;
+  OperandDims current = problem.inputs[0];
+  double total_cost = 0.0;
+  for (size_t input = 1; input < num_inputs; ++input) {
+    others.clear();
+    for (size_t i = input + 1; i < num_inputs; ++i) {
+      others.push_back(&problem.inputs[i]);
+    }
+    double cost;
+    current = Contract(problem, current, problem.inputs[input], others, cost);
+    total_cost += cost;
+  }
+
+  return total_cost;
+}
+
+// Exhaustive search over the ways to split each subset of the inputs in two, cheapest subsets first.
+ContractionPath OptimalContractionPath(const ContractionProblem& problem, double max_cost) {
+  const size_t num_inputs = problem.inputs.size();
+  const uint32_t all_inputs = (1u << num_inputs) - 1;
+
+  // for each label, the inputs that have it
+  InlinedVector<uint32_t> inputs_with_label(problem.num_labels, 0);
+  for (size_t input = 0; input < num_inputs; ++input) {
+    for (size_t label = 0; label < problem.num_labels; ++label) {
+      if (problem.inputs[input][label] > 1) {
+        inputs_with_label[label] |= 1u << input;
+      }
+    }
+  }
+
+  // the dims of the contraction of a subset of the inputs, which holds the labels of the subset that are in the
+  // output or in an input outside the subset.
+  std::vector<OperandDims> subset_dims(size_t{1} << num_inputs);
+  for (uint32_t subset = 1; subset <= all_inputs; ++subset) {
+    OperandDims& dims = subset_dims[subset];
+    dims.assign(problem.num_labels, 1);
+    for (size_t label = 0; label < problem.num_labels; ++label) {
+      const uint32_t with_label = inputs_with_label[label];
+      if ((with_label & subset) != 0 && (problem.in_output[label] || (with_label & ~subset) != 0)) {
+        for (size_t input = 0; input < num_inputs; ++input) {
+          if ((subset >> input) & 1u) {
+            dims[label] = std::max(dims[label], problem.inputs[input][label]);
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<double> subset_cost(size_t{1} << num_inputs, std::numeric_limits<double>::infinity());
+  std::vector<uint32_t> subset_split(size_t{1} << num_inputs, 0);
+  for (size_t input = 0; input < num_inputs; ++input) {
+    subset_cost[size_t{1} << input] = 0.0;
+  }
+
+  // subsets are visited in increasing order, so both halves of a split are already solved
+  for (uint32_t subset = 1; subset <= all_inputs; ++subset) {
+    if ((subset & (subset - 1)) == 0) {
+      continue;
+    }
+
+    const uint32_t lowest_input = subset & (~subset + 1);
+    for (uint32_t left = (subset - 1) & subset; left != 0; left = (left - 1) & subset) {
+      // visit each split once, with the lowest input on the left
+      if ((left & lowest_input) == 0) {
+        continue;
+      }
+      const uint32_t right = subset ^ left;
+      double cost = subset_cost[left] + subset_cost[right];
+      if (cost >= subset_cost[subset]) {
+        continue;
+      }
+
+      double step_cost = 1.0;
+      for (size_t label = 0; label < problem.num_labels; ++label) {
+        const int64_t dim = std::max(subset_dims[left][label], subset_dims[right][label]);
+        step_cost *= static_cast<double>(dim);
+      }
+      cost += step_cost;
+      if (cost < subset_cost[subset]) {
+        subset_cost[subset] = cost;
+        subset_split[subset] = left;
+      }
+    }
+  }
+
+  ContractionPath path;
+  if (!(subset_cost[all_inputs] < max_cost)) {
+    return path;
+  }
+
+  // emit the steps of the tree of splits bottom up, returning the operand id of each subset
+  path.reserve(num_inputs - 1);
+  auto emit = [&](auto& self, uint32_t subset) -> size_t {
+    if ((subset & (subset - 1)) == 0) {
+      size_t input = 0;
+      while (((subset >> input) & 1u) == 0) {
+        ++input;
+      }
+      return input;
+    }
+    const size_t left = self(self, subset_split[subset]);
+    const size_t right = self(self, subset ^ subset_split[subset]);
+    path.emplace_back(std::min(left, right), std::max(left, right));
+    return num_inputs + path.size() - 1;
+  };
+  emit(emit, all_inputs);
+
+  return path;
+}
+
+// Contracts the pair with the fewest multiply-adds first (the smaller result on ties) until one operand is left.
+ContractionPath GreedyContractionPath(const ContractionProblem& problem, double max_cost) {
+  const size_t num_inputs = problem.inputs.size();
+  std::vector<OperandDims> operands = problem.inputs;
+  operands.reserve(2 * num_inputs - 1);
+  std::vector<size_t> pending(num_inputs);
+  for (size_t i = 0; i < num_inputs; ++i) {
+    pending[i] = i;
+  }
+
+  ContractionPath path;
+  path.reserve(num_inputs - 1);
+  double total_cost = 0.0;
+  InlinedVector<const OperandDims*> others;
+  while (pending.size() > 1) {
+    size_t best_left = 0;
+    size_t best_right = 1;
+    double best_cost = std::numeric_limits<double>::infinity();
+    double best_size = std::numeric_limits<double>::infinity();
+    OperandDims best_result;
+    for (size_t left = 0; left < pending.size(); ++left) {
+      for (size_t right = left + 1; right < pending.size(); ++right) {
+        others.clear();
+        for (size_t other = 0; other < pending.size(); ++other) {
+          if (other != left && other != right) {
+            others.push_back(&operands[pending[other]]);
+          }
+        }
+
+        double cost;
+        OperandDims result = Contract(problem, operands[pending[left]], operands[pending[right]], others, cost);
+        double size = 1.0;
+        for (auto dim : result) {
+          size *= static_cast<double>(dim);
+        }
+        if (cost < best_cost || (cost == best_cost && size < best_size)) {
+          best_left = left;
+          best_right = right;
+          best_cost = cost;
+          best_size = size;
+          best_result = std::move(result);
+        }
+      }
+    }
+
+    total_cost += best_cost;
+    path.emplace_back(pending[best_left], pending[best_right]);
+    operands.push_back(std::move(best_result));
+    pending.erase(pending.begin() + best_right);
+    pending.erase(pending.begin() + best_left);
+    pending.push_back(operands.size() - 1);
+  }
+
+  if (!(total_cost < max_cost)) {
+    path.clear();
+  }
+
+  return path;
+}
+
+}  // namespace
+
+ContractionPath FindContractionPath(gsl::span<const TensorShape> homogenized_input_dims,
+                                    gsl::span<const int64_t> subscript_indices_to_output_indices) {
+  if (homogenized_input_dims.size() < 3) {
+    return {};
+  }
+
+  ContractionProblem problem(homogenized_input_dims, subscript_indices_to_output_indices);
+  const double max_cost = LeftToRightCost(problem) * (1.0 - kMinContractionPathSavings);
+  if (problem.inputs.size() <= kMaxInputsForOptimalContractionPath) {
+    return OptimalContractionPath(problem, max_cost);
+  }
+
+  return GreedyContractionPath(problem, max_cost);
+}
+
+std::shared_ptr<const ContractionPath> ContractionPathCache::Get(
+    gsl::span<const TensorShape> homogenized_input_dims,
+    gsl::span<const int64_t> subscript_indices_to_output_indices) {
+  std::vector<int64_t> input_dims;
+  for (const auto& dims : homogenized_input_dims) {
+    input_dims.insert(input_dims.end(), dims.GetDims().begin(), dims.GetDims().end());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->input_dims == input_dims) {
+        entries_.splice(entries_.begin(), entries_, it);
+        return entries_.front().path;
+      }
+    }
+  }
+
+  // search outside the lock, a concurrent miss for the same dims just finds the same path
+  auto path = std::make_shared<const ContractionPath>(
+      FindContractionPath(homogenized_input_dims, subscript_indices_to_output_indices));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.push_front(Entry{std::move(input_dims), path});
+  if (entries_.size() > capacity_) {
+    entries_.pop_back();
+  }
+
+  return path;
+}
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
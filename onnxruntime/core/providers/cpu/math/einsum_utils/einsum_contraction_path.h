@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// This module hosts the search for the order in which the operands of an Einsum with 3 or more inputs are contracted
+// pair-wise (the "contraction path"), and a cache of the paths found for the input shapes an Einsum kernel has seen.
+
+#pragma once
+
+#ifndef SHARED_PROVIDER
+#include "core/framework/tensor_shape.h"
+#endif
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+// Each step contracts two operands given by their ids: ids [0, num_inputs) are the inputs and the result of the
+// k-th step has the id num_inputs + k. The first id of a step is always the smaller one.
+// An empty path means the operands are contracted left to right, which is what Einsum does by default.
+using ContractionPath = std::vector<std::pair<size_t, size_t>>;
+
+// Einsums with up to this many inputs get an exhaustive search, the others a greedy one.
+constexpr size_t kMaxInputsForOptimalContractionPath = 8;
+
+#ifndef SHARED_PROVIDER
+// Finds the contraction path with the fewest multiply-adds for the given homogenized input dims (a dim value of 1
+// means the input doesn't have the subscript label). `subscript_indices_to_output_indices` holds -1 for the labels
+// that are summed over. Returns an empty path if contracting left to right is (almost) as cheap.
+ContractionPath FindContractionPath(gsl::span<const TensorShape> homogenized_input_dims,
+                                    gsl::span<const int64_t> subscript_indices_to_output_indices);
+#endif
+
+// An Einsum kernel sees the same input shapes on every run in the common case, so it keeps the paths of the most
+// recently seen shapes instead of searching again.
+class ContractionPathCache {
+ public:
+  static constexpr size_t kDefaultCapacity = 8;
+
+  explicit ContractionPathCache(size_t capacity = kDefaultCapacity) : capacity_(capacity) {}
+
+  // Returns the contraction path for the homogenized input dims, finding it on a miss.
+  std::shared_ptr<const ContractionPath> Get(gsl::span<const TensorShape> homogenized_input_dims,
+                                             gsl::span<const int64_t> subscript_indices_to_output_indices);
+
+ private:
+  struct Entry {
+    // the homogenized dims of all the inputs, one after the other
+    std::vector<int64_t> input_dims;
+    std::shared_ptr<const ContractionPath> path;
+  };
+
+  std::mutex mutex_;
+  std::list<Entry> entries_;  // most recently used first
+  size_t capacity_;
+};
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
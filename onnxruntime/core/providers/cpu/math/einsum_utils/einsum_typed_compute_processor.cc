@@ -332,6 +332,76 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   return output;
 }
 
+template <typename T>
+void EinsumTypedComputeProcessor<T>::ContractAlongPath(const EinsumOp::ContractionPath& contraction_path,
+                                                       std::unique_ptr<const Tensor> first_operand) {
+  const auto& subscript_indices_to_output_indices =
+      einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+  auto& preprocessed_inputs = einsum_compute_preprocessor_.GetPreprocessedInputTensors();
+  const auto& raw_inputs = einsum_compute_preprocessor_.GetRawInputTensors();
+  const auto& homogenized_input_dims = einsum_compute_preprocessor_.GetHomogenizedInputDims();
+  const size_t num_subscript_labels = subscript_indices_to_output_indices.size();
+  const size_t num_inputs = raw_inputs.size();
+  const size_t num_operands = num_inputs + contraction_path.size();
+
+  ORT_ENFORCE(contraction_path.size() == num_inputs - 1, "Einsum op: Invalid contraction path");
+
+  // Operand ids follow the contraction path: the inputs first, then the result of each step.
+  // Intermediate results are released as soon as they have been contracted.
+  std::vector<std::unique_ptr<const Tensor>> owned_operands(num_operands);
+  std::vector<const Tensor*> operands(num_operands, nullptr);
+  std::vector<TensorShape> operand_dims(num_operands);
+  std::vector<bool> is_pending(num_operands, false);
+  for (size_t input = 0; input < num_inputs; ++input) {
+    if (input == 0) {
+      // the first input has already been processed (if it needed to be)
+      owned_operands[input] = std::move(first_operand);
+    } else {
+      owned_operands[input] = std::move(preprocessed_inputs[input]);
+    }
+    operands[input] = owned_operands[input] ? owned_operands[input].get() : raw_inputs[input];
+    operand_dims[input] = input == 0 && owned_operands[input] ? owned_operands[input]->Shape()
+                                                             : homogenized_input_dims[input];
+    is_pending[input] = true;
+  }
+
+  TensorShapeVector reduced_dims;
+  reduced_dims.reserve(num_subscript_labels);
+  for (size_t step = 0; step < contraction_path.size(); ++step) {
+    const auto [left, right] = contraction_path[step];
+    const size_t result_id = num_inputs + step;
+    ORT_ENFORCE(left < right && right < result_id && is_pending[left] && is_pending[right],
+                "Einsum op: Invalid contraction path");
+    is_pending[left] = false;
+    is_pending[right] = false;
+
+    // Reduce the dims that are not in the output and that no other pending operand has
+    reduced_dims.clear();
+    for (size_t dim = 0; dim < num_subscript_labels; ++dim) {
+      if (subscript_indices_to_output_indices[dim] != -1) {
+        continue;
+      }
+      bool is_in_pending_operand = false;
+      for (size_t operand = 0; operand < result_id && !is_in_pending_operand; ++operand) {
+        is_in_pending_operand = is_pending[operand] && operand_dims[operand][dim] > 1;
+      }
+      if (!is_in_pending_operand) {
+        reduced_dims.push_back(static_cast<int64_t>(dim));
+      }
+    }
+
+    auto result = PairwiseOperandProcess(*operands[left], operand_dims[left], *operands[right], operand_dims[right],
+                                         reduced_dims, step == contraction_path.size() - 1);
+    operand_dims[result_id] = result->Shape();
+    operands[result_id] = result.get();
+    owned_operands[result_id] = std::move(result);
+    is_pending[result_id] = true;
+
+    owned_operands[left].reset();
+    owned_operands[right].reset();
+  }
+}
+
 template <typename T>
 void EinsumTypedComputeProcessor<T>::SetDeviceHelpers(const EinsumOp::DeviceHelpers::Transpose& device_transpose_func,
                                                       const EinsumOp::DeviceHelpers::MatMul<T>& device_matmul_func,
@@ -357,6 +427,17 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
+  // Find the order to contract the operands in. The operands are contracted left to right if the path is empty.
+  std::shared_ptr<const EinsumOp::ContractionPath> contraction_path;
+  if (num_inputs > 2) {
+    const auto& subscript_indices_to_output_indices =
+        einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+    contraction_path = contraction_path_cache_
+                           ? contraction_path_cache_->Get(homogenized_input_dims, subscript_indices_to_output_indices)
+                           : std::make_shared<const EinsumOp::ContractionPath>(EinsumOp::FindContractionPath(
+                                 homogenized_input_dims, subscript_indices_to_output_indices));
+  }
+
   // Pre-process the first input so as to reduce any dims that only it has
   std::unique_ptr<const Tensor> result;
 
@@ -397,6 +478,11 @@ Status EinsumTypedComputeProcessor<T>::Run() {
     }
   }
 
+  if (contraction_path && !contraction_path->empty()) {
+    ContractAlongPath(*contraction_path, std::move(result));
+    return Status::OK();
+  }
+
   // Process the operands in a pair-wise fashion
   {
     bool is_final_pair = false;
@@ -9,6 +9,7 @@
 
 #include "einsum_auxiliary_ops.h"
 #include "einsum_compute_preprocessor.h"
+#include "einsum_contraction_path.h"
 
 namespace onnxruntime {
 
@@ -33,6 +34,12 @@ class EinsumTypedComputeProcessor {
                         const EinsumOp::DeviceHelpers::ReduceSum<T>& device_reduce_sum_func,
                         const EinsumOp::DeviceHelpers::DataCopy& device_data_copy_func);
 
+  // Optional cache of contraction paths owned by the kernel. Without it the path of an Einsum with 3 or more inputs
+  // is searched on every run.
+  void SetContractionPathCache(EinsumOp::ContractionPathCache* contraction_path_cache) {
+    contraction_path_cache_ = contraction_path_cache;
+  }
+
   Status Run();
 
  private:
@@ -48,6 +55,10 @@ class EinsumTypedComputeProcessor {
                                                  const gsl::span<const int64_t>& reduce_dims,
                                                  bool is_final_pair);
 
+  // Contracts the operands pair-wise in the order of `contraction_path` (which must not be empty).
+  // `first_operand` is the processed first input, if it was processed.
+  void ContractAlongPath(const EinsumOp::ContractionPath& contraction_path, std::unique_ptr<const Tensor> first_operand);
+
   // Here we take a "candidate output"(candidate output is a tensor that is a permutation and / or a reshape away from the final output),
   // and after a few operations to get it to the required output structure, copy it to the op's output
   // The candidate output might contain dims that may not be part of the op's output (i.e.) the dims will have to be unsqueezed
@@ -67,6 +78,8 @@ class EinsumTypedComputeProcessor {
 
   // Holds EP-specific assets required for (auxiliary) ops that need to be executed on non-CPU EPs
   void* einsum_ep_assets_;
+
+  EinsumOp::ContractionPathCache* contraction_path_cache_ = nullptr;
 };
 
 }  // namespace onnxruntime
@@ -570,7 +570,7 @@ using AllocateTensorFunc = std::unique_ptr<Tensor> (*)(const TensorAllocator& te
 
 static void UntypedBroadcastVariadic(int input_count, OpKernelContext& context,
                                      AllocateTensorFunc allocate_tensor,
-                                     const ProcessBroadcastSpanFuncs& funcs);
+                                     const ProcessBroadcastSpanFuncs& funcs, double unit_cost);
 
 template <typename T>
 Status Add<T>::Compute(OpKernelContext* context) const {
@@ -796,7 +796,7 @@ Status Sum_8<T>::Compute(OpKernelContext* context) const {
       }};
 
   int input_count = Node().InputArgCount().front();
-  UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs);
+  UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs, 1.0);
 
   return Status::OK();
 }
@@ -842,7 +842,7 @@ struct Min_8::ComputeImpl {
         }};
 
     int input_count = inst.Node().InputArgCount().front();
-    UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs);
+    UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs, 1.0);
 
     return Status::OK();
   }
@@ -909,7 +909,7 @@ static Status MinMaxMLFloat16(const OpKernel& inst, OpKernelContext* context) {
       }};
 
   int input_count = inst.Node().InputArgCount().front();
-  UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs);
+  UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs, 1.0);
 
   return Status::OK();
 }
@@ -969,12 +969,7 @@ struct Max_8::ComputeImpl {
         }};
 
     int input_count = inst.Node().InputArgCount().front();
-    // TODO: Parallelize across spans in UntypedBroadcastVariadic to avoid specific logic here
-    if (input_count == 2) {
-      UntypedBroadcastTwo(*context, funcs, 1.0);
-    } else {
-      UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs);
-    }
+    UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs, 1.0);
 
     return Status::OK();
   }
@@ -1227,7 +1222,7 @@ Status Mean_8<float>::Compute(OpKernelContext* context) const {
       }};
 
   int input_count = Node().InputArgCount().front();
-  UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs);
+  UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs, 1.0);
 
   // Now divide by the input count to get the mean
   EigenMap<float>(*context->Output<Tensor>(0)) *= 1.0f / static_cast<float>(input_count);
@@ -2149,17 +2144,10 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
   BroadcastLooper(broadcast_helper, funcs);
 }
 
-// Variant of UntypedBroadcastTwo that will parallelize.
-// Operator usage is the same as the parallelization is opaque to the operator.
-// unit_cost must be a valid cost value.
-void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFuncs& funcs, double unit_cost,
-                         void* user_data) {
-  const Tensor& input0_tensor = *context.Input<Tensor>(0);
-  const Tensor& input1_tensor = *context.Input<Tensor>(1);
-  InputBroadcaster input_broadcaster(input0_tensor, input1_tensor);
-
-  Tensor& output_tensor = *context.Output(0, input_broadcaster.GetOutputShape());
-
+// Broadcasts the inputs of input_broadcaster into output_tensor, in parallel on tp.
+static void ParallelBroadcastTwo(InputBroadcaster& input_broadcaster, Tensor& output_tensor,
+                                 const ProcessBroadcastSpanFuncs& funcs, concurrency::ThreadPool* tp,
+                                 double unit_cost, void* user_data) {
   size_t span_size = input_broadcaster.GetSpanSize();
   size_t output_size = static_cast<ptrdiff_t>(output_tensor.Shape().Size());
 
@@ -2168,43 +2156,99 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
     return;
   }
 
-  concurrency::ThreadPool* tp = context.GetOperatorThreadPool();
-
   if (span_size == output_size) {  // Input data will be processed in a single span, so parallelize within the span
     OutputBroadcaster output_broadcaster(span_size, output_tensor);
     BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, user_data, tp, unit_cost);
     BroadcastLooper(broadcast_helper, funcs);
-  } else {
-    // Input data will be processed in multiple spans, so parallelize across spans.
-
-    // enforce const on input broadcaster we copy from
-    const InputBroadcaster& const_input_broadcaster = input_broadcaster;
+    return;
+  }
 
+  // enforce const on input broadcaster we copy from
+  const InputBroadcaster& const_input_broadcaster = input_broadcaster;
+  const size_t num_spans = output_size / span_size;
+
+  // With fewer spans than threads, e.g. [2, 1, 1M] + [1, 3, 1M], parallelizing across spans leaves threads idle.
+  // The spans are then split in pieces, which are processed like the parts of a single span.
+  constexpr size_t kMinPieceSize = 4096;
+  const size_t degree_of_parallelism = static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(tp));
+  const size_t pieces_per_span =
+      num_spans < degree_of_parallelism
+          ? std::max<size_t>(1, std::min(degree_of_parallelism / num_spans, span_size / kMinPieceSize))
+          : 1;
+
+  if (pieces_per_span > 1) {
+    const size_t piece_size = span_size / pieces_per_span;
     concurrency::ThreadPool::TryParallelFor(
-        tp, output_size / span_size,
-        TensorOpCost{static_cast<double>(input_broadcaster.Input0ElementSize()) * span_size,
-                     static_cast<double>(output_tensor.DataType()->Size()) * span_size,
-                     unit_cost * span_size},
-        [span_size, &const_input_broadcaster, &output_tensor, &funcs, user_data](std::ptrdiff_t first_span,
-                                                                                 std::ptrdiff_t last_span) {
-          // copy original input_broadcaster (which is at start of all input) and advance to this segment
-          InputBroadcaster segment_input_broadcaster(const_input_broadcaster);
-          segment_input_broadcaster.AdvanceBy(first_span * span_size);
-
-          // create broadcaster for this segment of output
-          OutputBroadcaster segment_output_broadcaster(span_size, output_tensor,
-                                                       first_span * span_size, last_span * span_size);
-
-          BroadcastHelper segment_helper(segment_input_broadcaster, segment_output_broadcaster, user_data);
-          BroadcastLooper(segment_helper, funcs);
+        tp, static_cast<std::ptrdiff_t>(num_spans * pieces_per_span),
+        TensorOpCost{static_cast<double>(input_broadcaster.Input0ElementSize()) * piece_size,
+                     static_cast<double>(output_tensor.DataType()->Size()) * piece_size,
+                     unit_cost * piece_size},
+        [span_size, pieces_per_span, &const_input_broadcaster, &output_tensor, &funcs,
+         user_data](std::ptrdiff_t first_piece, std::ptrdiff_t last_piece) {
+          for (auto piece = static_cast<size_t>(first_piece); piece < static_cast<size_t>(last_piece); ++piece) {
+            const size_t span = piece / pieces_per_span;
+            const size_t begin = (piece % pieces_per_span) * span_size / pieces_per_span;
+            const size_t end = (piece % pieces_per_span + 1) * span_size / pieces_per_span;
+
+            InputBroadcaster segment_input_broadcaster(const_input_broadcaster);
+            segment_input_broadcaster.AdvanceBy(span * span_size);
+            OutputBroadcaster segment_output_broadcaster(span_size, output_tensor,
+                                                         span * span_size, (span + 1) * span_size);
+            BroadcastHelper span_helper(segment_input_broadcaster, segment_output_broadcaster, user_data);
+
+            BroadcastHelper piece_helper(span_helper, begin, end - begin);
+            if (piece_helper.IsInput0Scalar()) {
+              funcs.input0scalar(piece_helper);
+            } else if (piece_helper.IsInput1Scalar()) {
+              funcs.input1scalar(piece_helper);
+            } else {
+              funcs.general(piece_helper);
+            }
+          }
         });
+    return;
   }
+
+  // Input data will be processed in multiple spans, so parallelize across spans.
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_spans,
+      TensorOpCost{static_cast<double>(input_broadcaster.Input0ElementSize()) * span_size,
+                   static_cast<double>(output_tensor.DataType()->Size()) * span_size,
+                   unit_cost * span_size},
+      [span_size, &const_input_broadcaster, &output_tensor, &funcs, user_data](std::ptrdiff_t first_span,
+                                                                               std::ptrdiff_t last_span) {
+        // copy original input_broadcaster (which is at start of all input) and advance to this segment
+        InputBroadcaster segment_input_broadcaster(const_input_broadcaster);
+        segment_input_broadcaster.AdvanceBy(first_span * span_size);
+
+        // create broadcaster for this segment of output
+        OutputBroadcaster segment_output_broadcaster(span_size, output_tensor,
+                                                     first_span * span_size, last_span * span_size);
+
+        BroadcastHelper segment_helper(segment_input_broadcaster, segment_output_broadcaster, user_data);
+        BroadcastLooper(segment_helper, funcs);
+      });
+}
+
+// Variant of UntypedBroadcastTwo that will parallelize.
+// Operator usage is the same as the parallelization is opaque to the operator.
+// unit_cost must be a valid cost value.
+void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFuncs& funcs, double unit_cost,
+                         void* user_data) {
+  const Tensor& input0_tensor = *context.Input<Tensor>(0);
+  const Tensor& input1_tensor = *context.Input<Tensor>(1);
+  InputBroadcaster input_broadcaster(input0_tensor, input1_tensor);
+
+  Tensor& output_tensor = *context.Output(0, input_broadcaster.GetOutputShape());
+
+  ParallelBroadcastTwo(input_broadcaster, output_tensor, funcs, context.GetOperatorThreadPool(), unit_cost,
+                       user_data);
 }
 
 // allocate_tensor should allocate a tensor of the output type with the given shape
 static void UntypedBroadcastVariadic(int input_count, OpKernelContext& context,
                                      AllocateTensorFunc allocate_tensor,
-                                     const ProcessBroadcastSpanFuncs& funcs) {
+                                     const ProcessBroadcastSpanFuncs& funcs, double unit_cost) {
   const auto& input0 = *context.Input<Tensor>(0);
 
   // One item is trivial, just copy and exit
@@ -2235,10 +2279,7 @@ static void UntypedBroadcastVariadic(int input_count, OpKernelContext& context,
       p_output = temp_output.get();
     }
 
-    OutputBroadcaster output_broadcaster(input_broadcaster.GetSpanSize(), *p_output);
-    BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster);
-
-    BroadcastLooper(broadcast_helper, funcs);
+    ParallelBroadcastTwo(input_broadcaster, *p_output, funcs, context.GetOperatorThreadPool(), unit_cost, nullptr);
 
     temp_input = std::move(temp_output);
   }
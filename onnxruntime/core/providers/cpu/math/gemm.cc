@@ -223,9 +223,23 @@ void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans
     return;
   }
 #endif
-  // Fallback to Eigen
   // Broadcast the bias as needed if bias is given
   GemmBroadcastBias(M, N, beta, c_data, c_shape, y_data);
+
+  // Use the native half precision gemm kernels of MLAS when the CPU has them, e.g. AVX512-FP16 on x64.
+  if (MlasHGemmSupported(trans_a, trans_b)) {
+    const size_t m = static_cast<size_t>(M);
+    const size_t n = static_cast<size_t>(N);
+    const size_t k = static_cast<size_t>(K);
+    MlasGemm(trans_a, trans_b, m, n, k,
+             reinterpret_cast<const MLAS_FP16*>(a_data), trans_a == CblasNoTrans ? k : m,
+             reinterpret_cast<const MLAS_FP16*>(b_data), trans_b == CblasNoTrans ? n : k,
+             reinterpret_cast<MLAS_FP16*>(y_data), n,
+             alpha.val, beta.val, thread_pool);
+    return;
+  }
+
+  // Fallback to Eigen
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wstrict-aliasing"
@@ -268,6 +282,8 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
       prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    } else if (is_packed && replicate_packed_b_) {
+      packed_b_replicas_.Replicate(packed_b_.get(), packed_b_size);
     }
   }
   return Status::OK();
@@ -290,6 +306,14 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   if (input_idx == 1) {
     used_shared_buffers = true;
     packed_b_ = std::move(prepacked_buffers[0]);
+
+    // the size of the buffer isn't passed, it is the size GemmPackBFp32 packed it to
+    if (replicate_packed_b_ && b_shape_.NumDimensions() == 2) {
+      const bool trans_b = trans_B_ != CblasNoTrans;
+      const size_t K = trans_b ? static_cast<size_t>(b_shape_[1]) : static_cast<size_t>(b_shape_[0]);
+      const size_t N = trans_b ? static_cast<size_t>(b_shape_[0]) : static_cast<size_t>(b_shape_[1]);
+      packed_b_replicas_.Replicate(packed_b_.get(), MlasGemmPackBSize(N, K));
+    }
   }
   return Status::OK();
 }
@@ -432,7 +456,7 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
           alpha_,
           A->Data<float>(),
           static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
-          packed_b_.get(),
+          packed_b_replicas_.Local(packed_b_.get()),
           c_data != nullptr ? beta_ : 0.0f,
           y_data,
           static_cast<size_t>(N),
@@ -5,10 +5,12 @@
 
 #include "gemm_base.h"
 
+#include "core/framework/numa_replicated_buffer.h"
 #include "core/framework/op_kernel.h"
 #include "core/common/common.h"
 #include "core/util/math.h"
 #include "core/providers/cpu/activation/activations.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -16,6 +18,8 @@ template <typename T>
 class Gemm : protected GemmBase, public OpKernel {
  public:
   Gemm(const OpKernelInfo& info) : GemmBase(info), OpKernel(info) {
+    replicate_packed_b_ =
+        info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsNumaReplicatePrepackedWeights, "0") == "1";
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -40,6 +44,9 @@ class Gemm : protected GemmBase, public OpKernel {
  protected:
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
+  // copies of packed_b_ on each NUMA node
+  bool replicate_packed_b_;
+  NumaReplicatedBuffer packed_b_replicas_;
 
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
@@ -2,8 +2,12 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/matmul.h"
+
+#include <algorithm>
+
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cpu/tunable/math/gemm.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -133,7 +137,77 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
 
   return Status::OK();
 }
-#if defined(__aarch64__) && defined(__linux__)
+
+#if defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+// Half precision MatMul on the native fp16 gemm kernels of MLAS. Registered at runtime by the CPU EP only when
+// MlasHGemmSupported() reports the kernels, so fp16 graphs do not get Cast nodes around every MatMul.
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* a = ctx->Input<Tensor>(0);
+  const auto* b = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  auto* y_data = y->MutableData<MLFloat16>();
+  if (helper.K() == 0) {
+    auto output_span = y->MutableDataAsSpan<MLFloat16>();
+    std::fill(output_span.begin(), output_span.end(), MLFloat16::Zero);
+    return Status::OK();
+  }
+
+  const auto* a_data = a->Data<MLFloat16>();
+  const auto* b_data = b->Data<MLFloat16>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  std::vector<MLAS_HGEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = reinterpret_cast<const MLAS_FP16*>(a_data + helper.LeftOffsets()[i]);
+    data[i].lda = static_cast<size_t>(helper.K());
+    data[i].B = reinterpret_cast<const MLAS_FP16*>(b_data + helper.RightOffsets()[i]);
+    data[i].ldb = static_cast<size_t>(helper.N());
+    data[i].C = reinterpret_cast<MLAS_FP16*>(y_data + helper.OutputOffsets()[i]);
+    data[i].ldc = static_cast<size_t>(helper.N());
+    data[i].alpha = MLFloat16::One.val;
+    data[i].beta = MLFloat16::Zero.val;
+  }
+
+  MlasGemmBatch(CblasNoTrans, CblasNoTrans, static_cast<size_t>(helper.M()), static_cast<size_t>(helper.N()),
+                static_cast<size_t>(helper.K()), data.data(), max_len, thread_pool);
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9, 12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+#endif
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
 bool GemmPackBBfloat16(AllocatorPtr& alloc,
                        const Tensor& tensor_b,
                        bool trans_b,
@@ -172,6 +246,47 @@ bool GemmPackBBfloat16(AllocatorPtr& alloc,
 }
 #endif
 
+void MatMul<float>::CompressSparseB(const Tensor& b) {
+  // the sparse GEMM doesn't transpose or scale
+  if (sparse_b_max_density_ <= 0.0f || b.Shape().NumDimensions() != 2 || trans_a_attr_ != 0 || trans_b_attr_ != 0 ||
+      trans_batch_a_ || trans_batch_b_ || alpha_attr_ != 1.0f) {
+    return;
+  }
+
+  const size_t K = static_cast<size_t>(b.Shape()[0]);
+  const size_t N = static_cast<size_t>(b.Shape()[1]);
+  const auto data = b.DataAsSpan<float>();
+  const size_t non_zeros = static_cast<size_t>(std::count_if(data.begin(), data.end(),
+                                                             [](float value) { return value != 0.0f; }));
+  if (data.empty() || non_zeros > std::numeric_limits<uint32_t>::max() ||
+      static_cast<double>(non_zeros) > static_cast<double>(sparse_b_max_density_) * static_cast<double>(data.size())) {
+    return;
+  }
+
+  sparse_b_column_start_.resize(N + 1);
+  sparse_b_row_indices_.resize(non_zeros);
+  sparse_b_values_.resize(non_zeros);
+  uint32_t i = 0;
+  for (size_t n = 0; n < N; ++n) {
+    sparse_b_column_start_[n] = i;
+    for (size_t k = 0; k < K; ++k) {
+      const float value = data[k * N + n];
+      if (value != 0.0f) {
+        sparse_b_row_indices_[i] = static_cast<uint32_t>(k);
+        sparse_b_values_[i] = value;
+        ++i;
+      }
+    }
+  }
+  sparse_b_column_start_[N] = i;
+
+  sparse_b_.K = K;
+  sparse_b_.N = N;
+  sparse_b_.ColumnStart = sparse_b_column_start_.data();
+  sparse_b_.RowIndices = sparse_b_row_indices_.data();
+  sparse_b_.Values = sparse_b_values_.data();
+}
+
 Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
                               /*out*/ bool& is_packed,
                               /*out*/ PrePackedWeights* prepacked_weights) {
@@ -180,7 +295,7 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
     size_t dim1 = 0;
     size_t dim2 = 0;
     TensorShape b_shape = tensor.Shape();
@@ -190,23 +305,42 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
       dim2 = static_cast<size_t>(b_shape[1]);
     }
 
-    if (use_fastmath_mode_ && (trans_b_attr_ == 0) && ((dim1 * dim2) >= kFastMathModeKernelsizeThreshold)) {
+    if ((trans_b_attr_ == 0) && UseFastMathMode(dim1, dim2)) {
       is_packed = GemmPackBBfloat16(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
     } else
 #endif
     {
       is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+      if (is_packed) {
+        CompressSparseB(tensor);
+      }
     }
 
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
       prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    } else if (is_packed && replicate_packed_b_) {
+      packed_b_replicas_.Replicate(packed_b_.get(), packed_b_size);
     }
   }
   return Status::OK();
 }
 
+size_t MatMul<float>::PackedBSize() const {
+  if (b_shape_.NumDimensions() != 2) {
+    return 0;
+  }
+  const size_t K = trans_b_attr_ ? static_cast<size_t>(b_shape_[1]) : static_cast<size_t>(b_shape_[0]);
+  const size_t N = trans_b_attr_ ? static_cast<size_t>(b_shape_[0]) : static_cast<size_t>(b_shape_[1]);
+#if defined(MLAS_SBGEMM_SUPPORTED)
+  if ((trans_b_attr_ == 0) && UseFastMathMode(K, N)) {
+    return MlasSBGemmPackBSize(N, K);
+  }
+#endif
+  return MlasGemmPackBSize(N, K);
+}
+
 Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
                                                 int input_idx,
                                                 /*out*/ bool& used_shared_buffers) {
@@ -215,6 +349,16 @@ Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
   if (input_idx == 1) {
     used_shared_buffers = true;
     packed_b_ = std::move(prepacked_buffers[0]);
+
+    // PrePack() is skipped when the buffers come from the persistent cache
+    const Tensor* b = nullptr;
+    if (OpKernel::Info().TryGetConstantInput(1, &b)) {
+      b_shape_ = b->Shape();
+    }
+
+    if (replicate_packed_b_) {
+      packed_b_replicas_.Replicate(packed_b_.get(), PackedBSize());
+    }
   }
 
   return Status::OK();
@@ -258,15 +402,16 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t K = static_cast<size_t>(helper.K());
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
-#if defined(__aarch64__) && defined(__linux__)
-  if (use_fastmath_mode_ && !trans_b && ((N * K) >= kFastMathModeKernelsizeThreshold)) {
+  const auto* packed_b = static_cast<const float*>(packed_b_replicas_.Local(packed_b_.get()));
+#if defined(MLAS_SBGEMM_SUPPORTED)
+  if (!trans_b && UseFastMathMode(K, N)) {
     std::vector<MLAS_SBGEMM_DATA_PARAMS> data(max_len);
     for (size_t i = 0; i < max_len; i++) {
       data[i].BIsfp32 = !(bool(packed_b_));
       data[i].AIsfp32 = true;
       data[i].A = a_data + helper.LeftOffsets()[i];
       data[i].lda = lda;
-      data[i].B = data[i].BIsfp32 ? b_data + helper.RightOffsets()[i] : (float*)packed_b_.get();
+      data[i].B = data[i].BIsfp32 ? b_data + helper.RightOffsets()[i] : packed_b;
       data[i].ldb = ldb;
       data[i].C = y_data + helper.OutputOffsets()[i];
       data[i].ldc = N;
@@ -282,15 +427,17 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
       data[i].BIsPacked = bool(packed_b_);
       data[i].A = a_data + helper.LeftOffsets()[i];
       data[i].lda = lda;
-      data[i].B = data[i].BIsPacked ? (float*)packed_b_.get() : b_data + helper.RightOffsets()[i];
+      data[i].B = data[i].BIsPacked ? packed_b : b_data + helper.RightOffsets()[i];
       data[i].ldb = ldb;
       data[i].C = y_data + helper.OutputOffsets()[i];
       data[i].ldc = N;
       data[i].alpha = alpha_attr_;
       data[i].beta = 0.0f;
     }
-    MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
-                  M, N, K, data.data(), max_len, thread_pool);
+    const bool use_sparse_b = packed_b_ && !sparse_b_column_start_.empty();
+    ORT_RETURN_IF_ERROR(cpu::tunable::TunableSgemmBatch(tuning_ctx_, trans_a ? CblasTrans : CblasNoTrans,
+                                                        trans_b ? CblasTrans : CblasNoTrans, M, N, K, data.data(),
+                                                        max_len, thread_pool, use_sparse_b ? &sparse_b_ : nullptr));
   }
   return Status::OK();
 }
@@ -3,8 +3,14 @@
 
 #pragma once
 
+#include <limits>
+#include <vector>
+
+#include "core/common/parse_string.h"
+#include "core/framework/numa_replicated_buffer.h"
 #include "core/framework/op_kernel.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
@@ -29,10 +35,31 @@ class MatMul<float> final : public OpKernel {
     info.GetAttrOrDefault<int64_t>("transBatchB", &trans_batch_b_attr, 0);
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
+    tuning_ctx_ = cpu::tunable::GetCpuTuningContext(info);
+    replicate_packed_b_ =
+        info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsNumaReplicatePrepackedWeights, "0") == "1";
+    sparse_b_max_density_ = ParseStringWithClassicLocale<float>(
+        info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMlasSparseGemmMaxDensity, "0"));
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
+    const auto& config_options = info.GetConfigOptions();
+    use_fastmath_mode_ =
+        (config_options.GetConfigOrDefault(kOrtSessionOptionsMlasGemmFastMathBfloat16, "0") == "1" ||
+         config_options.GetConfigOrDefault(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16, "0") == "1") &&
+        MlasBf16AccelerationSupported();
 
-#if defined(__aarch64__) && defined(__linux__)
-    auto config_ops = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16);
-    use_fastmath_mode_ = (config_ops == "1") && MlasBf16AccelerationSupported();
+    // bfloat16 inputs have a relative error of 2^-8, so a dot product of length K has an error of about
+    // 2^-8 * sqrt(K). Keep the MatMuls whose K would exceed the tolerance in fp32.
+    const auto tolerance_str = config_options.GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathBfloat16Tolerance);
+    if (tolerance_str.has_value()) {
+      float tolerance = 0.0f;
+      ORT_ENFORCE(TryParseStringWithClassicLocale(*tolerance_str, tolerance) && tolerance > 0.0f,
+                  "Invalid value for ", kOrtSessionOptionsMlasGemmFastMathBfloat16Tolerance, ": ", *tolerance_str);
+      const double max_k = static_cast<double>(tolerance) * 256.0 * static_cast<double>(tolerance) * 256.0;
+      if (max_k < static_cast<double>(fastmath_max_k_)) {
+        fastmath_max_k_ = static_cast<size_t>(max_k);
+      }
+    }
 #endif
   }
 
@@ -43,11 +70,29 @@ class MatMul<float> final : public OpKernel {
   Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  bool CanUseSharedPrePackedBuffersWithoutPrePack(int input_idx) const override { return input_idx == 1; }
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  // Returns the size of packed_b_, which isn't passed to UseSharedPrePackedBuffers().
+  size_t PackedBSize() const;
+
+  // Keeps a copy of B compressed by column if its density is at most sparse_b_max_density_.
+  void CompressSparseB(const Tensor& b);
+
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
+  // copies of packed_b_ on each NUMA node
+  bool replicate_packed_b_;
+  NumaReplicatedBuffer packed_b_replicas_;
+
+  // B compressed by column, for MlasSparseGemm. Only kept by the kernels that prepack B themselves.
+  float sparse_b_max_density_;
+  MLAS_SGEMM_SPARSE_B sparse_b_;
+  std::vector<uint32_t> sparse_b_column_start_;
+  std::vector<uint32_t> sparse_b_row_indices_;
+  std::vector<float> sparse_b_values_;
 
   // For FusedMatMul contrib ops
   float alpha_attr_;
@@ -55,10 +100,18 @@ class MatMul<float> final : public OpKernel {
   int64_t trans_b_attr_;
   bool trans_batch_a_;
   bool trans_batch_b_;
+  cpu::tunable::CpuTuningContext* tuning_ctx_;
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
+  // Whether the fastmath mode runs a MatMul with a K x N weight through SBGEMM.
+  bool UseFastMathMode(size_t K, size_t N) const {
+    return use_fastmath_mode_ && (K * N >= kFastMathModeKernelsizeThreshold) && (K <= fastmath_max_k_);
+  }
 
-#if defined(__aarch64__) && defined(__linux__)
   // fastmath mode state
   bool use_fastmath_mode_;
+  // largest K within the fastmath tolerance
+  size_t fastmath_max_k_ = std::numeric_limits<size_t>::max();
   // sbgemm kernel is implemented as 8x8 blocks with weights pre-packed to 4 blocks of 4x2
   // so a minimum of 32 elements is defined to outweigh the additional prepacking overhead
   const size_t kFastMathModeKernelsizeThreshold = 32;
@@ -140,6 +140,77 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Minimum number of items along the axis each thread handles when a selection is split over threads.
+constexpr int64_t kMinTopKItemsPerAxisChunk = 32 * 1024;
+
+// Selects the top k of 'count' items starting at first_idx with a stride of block_slice, leaving their indices in
+// (unordered) heap order in 'heap'. count must be at least k.
+template <class Comparator>
+static void HeapSelectTopK(const Comparator& comparer, const typename Comparator::DataType* input_data,
+                           int64_t first_idx, int64_t count, int64_t block_slice, const unsigned k, int64_t* heap) {
+  int64_t l = 0;
+  auto cur_idx = first_idx;
+
+  // add first k items starting from the bottom up
+  for (; l < k; ++l) {
+    heap[k - l - 1] = cur_idx;
+    HeapifyIthPosition(heap, k - SafeInt<size_t>(l) - 1, k, comparer);
+    cur_idx += block_slice;
+  }
+
+  // insert remainder if the next value would replace the top of the heap (current worst top k value)
+  auto top = input_data[heap[0]];
+  for (; l < count; ++l) {
+    if (comparer.CompareValueOnly(input_data[cur_idx], top)) {
+      heap[0] = cur_idx;
+      HeapifyIthPosition(heap, 0, k, comparer);
+      top = input_data[heap[0]];
+    }
+    cur_idx += block_slice;
+  }
+}
+
+// Used when there are fewer selections (rows * block_slice) than threads and the axis is long: each selection is
+// split into chunks of the axis that threads select the top k of with a local heap, and the k * num_chunks
+// candidates are then reduced to the top k. The comparator orders equal values by index, so the result is the
+// same as selecting over the whole axis at once.
+template <class Comparator>
+static void FindTopKElementsSplitAxis(const typename Comparator::DataType* input_data,
+                                      EigenMatrixMapRowMajor<typename Comparator::DataType>& values_map,
+                                      EigenMatrixMapRowMajor<int64_t>& indices_map,
+                                      int64_t rows, int64_t cols, int64_t num_blocks, int64_t block_slice,
+                                      const unsigned k, bool sorted, int64_t num_chunks,
+                                      concurrency::ThreadPool* threadpool) {
+  Comparator comparer(input_data);
+  std::vector<int64_t> candidates(SafeInt<size_t>(num_chunks) * k);
+
+  for (int64_t i = 0; i < rows; ++i) {
+    const auto row_offset = i * cols;
+    for (int64_t j = 0; j < block_slice; ++j) {
+      concurrency::ThreadPool::TrySimpleParallelFor(
+          threadpool, onnxruntime::narrow<ptrdiff_t>(num_chunks), [&](std::ptrdiff_t chunk) {
+            auto work = concurrency::ThreadPool::PartitionWork(chunk, onnxruntime::narrow<size_t>(num_chunks),
+                                                               onnxruntime::narrow<size_t>(num_blocks));
+            HeapSelectTopK(comparer, input_data, row_offset + j + work.start * block_slice,
+                           work.end - work.start, block_slice, k, candidates.data() + chunk * k);
+          });
+
+      std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), comparer);
+      if (sorted) {
+        std::sort(candidates.begin(), candidates.begin() + k, comparer);
+      }
+
+      for (int64_t l = 0; l < k; ++l) {
+        int64_t idx = candidates[onnxruntime::narrow<size_t>(l)];
+        auto col_index = l * block_slice + j;
+        values_map(i, onnxruntime::narrow<size_t>(col_index)) = input_data[idx];
+        indices_map(i, onnxruntime::narrow<size_t>(col_index)) = block_slice == 1 ? (idx - row_offset - j)
+                                                                                  : (idx - row_offset - j) / block_slice;
+      }
+    }
+  }
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -165,6 +236,19 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   const int64_t block_slice = reduced_cols / k;
 
   int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+
+  // splitting on rows can't use all the threads, so split the axis of each selection if it's long enough for the
+  // threads to have a meaningful share of it after selecting their local top k.
+  if (rows * block_slice < tp_threads) {
+    const int64_t items_per_chunk = std::max(kMinTopKItemsPerAxisChunk, static_cast<int64_t>(4) * k);
+    const int64_t num_chunks = std::min(tp_threads, num_blocks / items_per_chunk);
+    if (num_chunks > 1) {
+      FindTopKElementsSplitAxis<Comparator>(input_data, values_map, indices_map, rows, cols, num_blocks,
+                                            block_slice, k, sorted, num_chunks, threadpool);
+      return;
+    }
+  }
+
   int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
 
   // rough attempt to make sure there's enough work for each thread. if there's insufficient work the usage of
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <gsl/gsl>
+#include "core/common/common.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace onnxruntime {
+namespace ml {
+
+/// <summary>
+/// Read-only open addressing table for the mappings of LabelEncoder and CategoryMapper.
+/// The mappings are built once when the kernel is created and may hold millions of entries. The slots are a flat
+/// array of (hash tag, entry index) probed linearly, the entries are stored next to each other, and Lookup()
+/// hashes a block of keys and prefetches their slots before probing any of them, so the cache misses of a large
+/// vocabulary overlap instead of being paid one at a time.
+/// </summary>
+template <typename TKey, typename TValue, typename Hash = std::hash<TKey>, typename Equal = std::equal_to<TKey>>
+class LabelLookupTable {
+ public:
+  LabelLookupTable() { Rehash(kMinCapacity); }
+
+  void Reserve(size_t num_entries) {
+    entries_.reserve(num_entries);
+    size_t capacity = slots_.size();
+    while (capacity < num_entries * 2) {
+      capacity *= 2;
+    }
+    if (capacity != slots_.size()) {
+      Rehash(capacity);
+    }
+  }
+
+  // Adds the pair if key isn't in the table. Otherwise the existing value is kept, or replaced if overwrite is true.
+  void Insert(const TKey& key, const TValue& value, bool overwrite = false) {
+    if ((entries_.size() + 1) * 2 > slots_.size()) {
+      Rehash(slots_.size() * 2);
+    }
+
+    const uint64_t hash = HashKey(key);
+    const size_t mask = slots_.size() - 1;
+    for (size_t pos = SlotIndex(hash);; pos = (pos + 1) & mask) {
+      Slot& slot = slots_[pos];
+      if (slot.index == 0) {
+        ORT_ENFORCE(entries_.size() < std::numeric_limits<uint32_t>::max(), "Too many entries in the mapping.");
+        entries_.emplace_back(key, value);
+        slot.tag = static_cast<uint32_t>(hash);
+        slot.index = static_cast<uint32_t>(entries_.size());
+        return;
+      }
+      if (slot.tag == static_cast<uint32_t>(hash) && Equal{}(entries_[slot.index - 1].first, key)) {
+        if (overwrite) {
+          entries_[slot.index - 1].second = value;
+        }
+        return;
+      }
+    }
+  }
+
+  size_t Size() const { return entries_.size(); }
+
+  // Returns the value of key, or nullptr if key isn't in the table.
+  const TValue* Find(const TKey& key) const { return Find(key, HashKey(key)); }
+
+  // Sets output[i] to the value of input[i], or to default_value if input[i] isn't in the table.
+  void Lookup(gsl::span<const TKey> input, gsl::span<TValue> output, const TValue& default_value) const {
+    uint64_t hashes[kLookupBlockSize];
+    for (size_t start = 0; start < input.size(); start += kLookupBlockSize) {
+      const size_t count = std::min(kLookupBlockSize, input.size() - start);
+      for (size_t i = 0; i < count; ++i) {
+        hashes[i] = HashKey(input[start + i]);
+        PrefetchForRead(&slots_[SlotIndex(hashes[i])]);
+      }
+      for (size_t i = 0; i < count; ++i) {
+        const TValue* value = Find(input[start + i], hashes[i]);
+        output[start + i] = value == nullptr ? default_value : *value;
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    uint32_t tag = 0;    // low bits of the hash, compared before the keys
+    uint32_t index = 0;  // 1 + the index of the entry, 0 for an empty slot
+  };
+
+  static constexpr size_t kMinCapacity = 16;
+  static constexpr size_t kLookupBlockSize = 16;
+
+  static void PrefetchForRead(const void* address) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#else
+    ORT_UNUSED_PARAMETER(address);
+#endif
+  }
+
+  // Hash may be the identity, as std::hash is for integers on some platforms, so multiply it to spread the keys
+  // over the high bits, which select the slot.
+  static uint64_t HashKey(const TKey& key) {
+    return static_cast<uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull;
+  }
+
+  size_t SlotIndex(uint64_t hash) const { return static_cast<size_t>(hash >> shift_); }
+
+  const TValue* Find(const TKey& key, uint64_t hash) const {
+    const size_t mask = slots_.size() - 1;
+    for (size_t pos = SlotIndex(hash);; pos = (pos + 1) & mask) {
+      const Slot& slot = slots_[pos];
+      if (slot.index == 0) {
+        return nullptr;
+      }
+      if (slot.tag == static_cast<uint32_t>(hash) && Equal{}(entries_[slot.index - 1].first, key)) {
+        return &entries_[slot.index - 1].second;
+      }
+    }
+  }
+
+  void Rehash(size_t capacity) {
+    shift_ = 64;
+    for (size_t size = 1; size < capacity; size *= 2) {
+      --shift_;
+    }
+    slots_.assign(capacity, Slot{});
+
+    const size_t mask = capacity - 1;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      const uint64_t hash = HashKey(entries_[i].first);
+      size_t pos = SlotIndex(hash);
+      while (slots_[pos].index != 0) {
+        pos = (pos + 1) & mask;
+      }
+      slots_[pos].tag = static_cast<uint32_t>(hash);
+      slots_[pos].index = static_cast<uint32_t>(i + 1);
+    }
+  }
+
+  // the number of slots is a power of 2, at least twice the number of entries
+  std::vector<Slot> slots_;
+  std::vector<std::pair<TKey, TValue>> entries_;
+  int shift_ = 64;
+};
+
+}  // namespace ml
+}  // namespace onnxruntime
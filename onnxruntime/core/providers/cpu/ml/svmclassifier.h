@@ -39,28 +39,33 @@ class SVMCommon {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
     if (kernel_type_ == KERNEL::RBF) {
-      T* cur_out = out.data();
-      const T* cur_batch = a.data();
-
-      // each batch has 'k' features
-      for (int64_t batch = 0; batch < m; ++batch) {
-        const T* cur_support_vector = b.data();
-
-        // broadcast the support vectors against the k features in each batch. output is one value per support vector
-        for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
-          T sum = 0.f;
-          const T* cur_input = cur_batch;
-
-          for (int64_t feature = 0; feature < k; ++feature) {
-            T val = *cur_input++ - *cur_support_vector++;
-            sum += val * val;
-          }
-
-          *cur_out++ = std::exp(-gamma_ * sum);
-        }
+      // exp(-gamma * |a_i - b_j|^2) with |a_i - b_j|^2 = |a_i|^2 + |b_j|^2 - 2 * a_i.b_j, so that the dot products of
+      // all the rows and support vectors are computed by a single GEMM.
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        m, n, k,
+                                        -2.f, a.data(), b.data(), 0.f,
+                                        nullptr, nullptr,
+                                        out.data(),
+                                        threadpool);
 
-        cur_batch += k;  // move to start of next batch
-      }
+      std::vector<T> b_norms(narrow<size_t>(n));
+      EigenVectorMap<T>(b_norms.data(), n) = ConstEigenMatrixMapRowMajor<T>(b.data(), n, k).rowwise().squaredNorm();
+
+      const double cost_per_row = static_cast<double>(n) * 24;  // the exp dominates
+      concurrency::ThreadPool::TryParallelFor(
+          threadpool, m,
+          TensorOpCost{static_cast<double>((n + k) * sizeof(T)), static_cast<double>(n * sizeof(T)), cost_per_row},
+          [&](ptrdiff_t first, ptrdiff_t last) {
+            for (ptrdiff_t row = first; row < last; ++row) {
+              const T a_norm = ConstEigenVectorMap<T>(a.data() + row * k, k).squaredNorm();
+              T* row_out = out.data() + row * n;
+              for (ptrdiff_t i = 0; i < n; ++i) {
+                // rounding may make the distance of a row to a support vector equal to it slightly negative
+                row_out[i] = -gamma_ * std::max(row_out[i] + a_norm + b_norms[i], T{0});
+              }
+              MlasComputeExp(row_out, row_out, narrow<size_t>(n));
+            }
+          });
     } else {
       float alpha = 1.f;
       float beta = 1.f;
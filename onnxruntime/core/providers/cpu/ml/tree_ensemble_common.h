@@ -3,8 +3,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
 #include <mutex>
+#include "core/common/logging/logging.h"
 #include "core/platform/threadpool.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "tree_ensemble_helper.h"
 #include "tree_ensemble_attribute.h"
 #include "tree_ensemble_aggregator.h"
@@ -13,6 +20,12 @@ namespace onnxruntime {
 namespace ml {
 namespace detail {
 
+enum class TreeEnsembleParallelization {
+  kNone,   // a single thread
+  kTrees,  // every thread walks a share of the trees for all rows, the scores are merged afterwards
+  kRows,   // every thread walks all the trees for a share of the rows
+};
+
 /**
  * These attributes are the kernel attributes. They are different from the onnx operator attributes
  * to improve the computation efficiency. The initialization consists in moving the onnx attributes
@@ -35,9 +48,11 @@ class TreeEnsembleCommonAttributes {
   int64_t n_trees_;
   bool same_mode_;
   bool has_missing_tracks_;
-  int parallel_tree_;    // starts parallelizing the computing by trees if n_tree >= parallel_tree_
-  int parallel_tree_N_;  // batch size if parallelizing by trees
-  int parallel_N_;       // starts parallelizing the computing by rows if n_rows <= parallel_N_
+  int parallel_tree_;    // unused, the parallelization is chosen by ChooseParallelization
+  int parallel_tree_N_;  // number of rows walked together by every tree
+  int parallel_N_;       // unused, the parallelization is chosen by ChooseParallelization
+  double tree_cycles_;   // estimated cycles to walk one tree for one row
+  bool autotune_parallelization_ = false;
 };
 
 // TI: input type
@@ -54,6 +69,15 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   std::vector<SparseValue<ThresholdType>> weights_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
 
+  // Breadth first layout of the trees padded to complete trees of depth compact_depth_, see BuildCompactTrees.
+  // The children of node k are 2k+1 (true) and 2k+2 (false). It is unused if compact_depth_ == 0.
+  size_t compact_depth_ = 0;
+  NODE_MODE_ORT compact_mode_ = NODE_MODE_ORT::LEAF;
+  std::vector<int32_t> compact_feature_ids_;
+  std::vector<ThresholdType> compact_thresholds_;
+  std::vector<uint8_t> compact_missing_tracks_true_;
+  std::vector<const TreeNodeElement<ThresholdType>*> compact_leaves_;
+
  public:
   TreeEnsembleCommon() {}
 
@@ -69,10 +93,28 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
                                                        const InputType* x_data) const;
 
+  // Calls fn(i, leaf) with the leaf of tree j reached by every row i in [begin, end).
+  template <typename Fn>
+  void ProcessTreeNodeLeaves(size_t j, const InputType* x_data, int64_t stride, int64_t begin, int64_t end,
+                             Fn&& fn) const;
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
 
+  TreeEnsembleParallelization ChooseParallelization(int64_t N, int max_num_threads) const;
+
  private:
+  template <typename AGG>
+  void ComputeAggWithParallelization(TreeEnsembleParallelization parallelization, concurrency::ThreadPool* ttp,
+                                     const InputType* x_data, int64_t N, int64_t stride, OutputType* z_data,
+                                     int64_t* label_data, const AGG& agg) const;
+
+  // The parallelization timed as the fastest on the first run with several rows, see
+  // kOrtSessionOptionsTreeEnsembleAutotuneParallelization.
+  mutable std::atomic<bool> is_parallelization_tuned_{false};
+  mutable TreeEnsembleParallelization tuned_parallelization_ = TreeEnsembleParallelization::kNone;
+  mutable std::mutex tune_mutex_;
+
   bool CheckIfSubtreesAreEqual(const size_t left_id, const size_t right_id, const int64_t tree_id, const InlinedVector<NODE_MODE_ONNX>& cmodes,
                                const InlinedVector<size_t>& truenode_ids, const InlinedVector<size_t>& falsenode_ids, gsl::span<const int64_t> nodes_featureids,
                                gsl::span<const ThresholdType> nodes_values_as_tensor, gsl::span<const float> node_values,
@@ -84,6 +126,14 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
                   gsl::span<const int64_t> nodes_missing_value_tracks_true, std::vector<size_t>& updated_mapping,
                   int64_t tree_id, const InlinedVector<TreeNodeElementId>& node_tree_ids, gsl::span<const float> target_class_weights,
                   gsl::span<const ThresholdType> target_class_weights_as_tensor, InlinedVector<std::pair<TreeNodeElementId, uint32_t>>& indices);
+  void BuildCompactTrees();
+  void FillCompactTree(size_t tree, const TreeNodeElement<ThresholdType>* node, size_t index, size_t level);
+  template <NODE_MODE_ORT Mode, typename Fn>
+  void ProcessCompactTreeOfMode(size_t j, const InputType* x_data, int64_t stride, int64_t begin, int64_t end,
+                                Fn& fn) const;
+  template <NODE_MODE_ORT Mode, size_t Depth, typename Fn>
+  void ProcessCompactTree(size_t j, const InputType* x_data, int64_t stride, int64_t begin, int64_t end,
+                          Fn& fn) const;
 };
 
 // Below is simple implementation of `bit_cast` as it is supported from c++20 and the current supported version is c++17
@@ -115,9 +165,23 @@ std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t> bit_cast_i
   static_assert(sizeof(T) == sizeof(uint32_t) || sizeof(T) == sizeof(uint64_t));
 }
 
+// Depth of the tree below node, or max_depth + 1 if it is deeper than max_depth.
+template <typename T>
+size_t TreeDepth(const TreeNodeElement<T>* node, size_t max_depth) {
+  if (!node->is_not_leaf()) {
+    return 0;
+  }
+  if (max_depth == 0) {
+    return 1;
+  }
+  return 1 + std::max(TreeDepth(node + 1, max_depth - 1), TreeDepth<T>(node->truenode_or_weight.ptr, max_depth - 1));
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(const OpKernelInfo& info) {
   TreeEnsembleAttributesV3<ThresholdType> attributes(info, false);
+  autotune_parallelization_ =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsTreeEnsembleAutotuneParallelization, "0") == "1";
   return Init(80, 128, 50, attributes);
 }
 
@@ -308,6 +372,16 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(
     }
   }
 
+  BuildCompactTrees();
+
+  // a node is a load of the feature, a comparison and a jump which is often mispredicted
+  constexpr double kNodeCycles = 5;
+  double depth_sum = 0;
+  for (const auto* root : roots_) {
+    depth_sum += static_cast<double>(TreeDepth(root, 64));
+  }
+  tree_cycles_ = kNodeCycles * (1 + depth_sum / static_cast<double>(std::max<size_t>(1, roots_.size())));
+
 #if defined(_TREE_DEBUG)
   std::cout << "TreeEnsemble:same_mode_=" << (same_mode_ ? 1 : 0) << "\n";
   for (auto& node : nodes_) {
@@ -448,6 +522,78 @@ size_t TreeEnsembleCommon<InputType, ThresholdType, OutputType>::AddNodes(
   return node_pos;
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::BuildCompactTrees() {
+  // Trees of gradient boosting are usually shallow and close to complete. Walking a complete tree is a fixed number
+  // of steps without a test for leaves, so the paths of several rows are walked together.
+  constexpr size_t kMaxCompactDepth = 12;
+  compact_depth_ = 0;
+  compact_feature_ids_.clear();
+  compact_thresholds_.clear();
+  compact_missing_tracks_true_.clear();
+  compact_leaves_.clear();
+  if (!same_mode_ || roots_.empty()) {
+    return;
+  }
+
+  auto first_branch = std::find_if(nodes_.begin(), nodes_.end(), [](const auto& node) { return node.is_not_leaf(); });
+  if (first_branch == nodes_.end() || first_branch->mode() == NODE_MODE_ORT::BRANCH_MEMBER) {
+    return;
+  }
+
+  size_t depth = 0;
+  for (const auto* root : roots_) {
+    depth = std::max(depth, TreeDepth(root, kMaxCompactDepth));
+    if (depth > kMaxCompactDepth) {
+      return;
+    }
+  }
+
+  // the padding of unbalanced trees is not worth it
+  const size_t n_internal = (size_t{1} << depth) - 1;
+  if (n_internal * roots_.size() > 4 * nodes_.size()) {
+    return;
+  }
+
+  compact_depth_ = depth;
+  compact_mode_ = first_branch->mode();
+  compact_feature_ids_.assign(n_internal * roots_.size(), 0);
+  compact_thresholds_.assign(n_internal * roots_.size(), ThresholdType(0));
+  if (has_missing_tracks_) {
+    compact_missing_tracks_true_.assign(n_internal * roots_.size(), 0);
+  }
+  compact_leaves_.resize((n_internal + 1) * roots_.size());
+  for (size_t j = 0; j < roots_.size(); ++j) {
+    FillCompactTree(j, roots_[j], 0, 0);
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::FillCompactTree(
+    size_t tree, const TreeNodeElement<ThresholdType>* node, size_t index, size_t level) {
+  const size_t n_internal = (size_t{1} << compact_depth_) - 1;
+  if (level == compact_depth_) {
+    compact_leaves_[tree * (n_internal + 1) + index - n_internal] = node;
+    return;
+  }
+
+  // A leaf above the last level is the leaf of all the paths below it, whatever the padding nodes compare.
+  const TreeNodeElement<ThresholdType>* true_node = node;
+  const TreeNodeElement<ThresholdType>* false_node = node;
+  if (node->is_not_leaf()) {
+    const size_t pos = tree * n_internal + index;
+    compact_feature_ids_[pos] = node->feature_id;
+    compact_thresholds_[pos] = node->value_or_unique_weight;
+    if (has_missing_tracks_) {
+      compact_missing_tracks_true_[pos] = node->is_missing_track_true() ? 1 : 0;
+    }
+    true_node = node->truenode_or_weight.ptr;
+    false_node = node + 1;
+  }
+  FillCompactTree(tree, true_node, 2 * index + 1, level + 1);
+  FillCompactTree(tree, false_node, 2 * index + 2, level + 1);
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::compute(OpKernelContext* ctx,
                                                                          const Tensor* X,
@@ -487,6 +633,34 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::compute(OpKerne
   }
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+TreeEnsembleParallelization TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ChooseParallelization(
+    int64_t N, int max_num_threads) const {
+  // Same orders of magnitude as the cost model of the thread pool: a thread is worth starting for about 100000
+  // cycles of work and waiting for the threads at the end of a parallel loop costs a few microseconds.
+  constexpr double kThreadCycles = 100000;
+  constexpr double kLoopCycles = 20000;
+  constexpr double kMergeCycles = 10;
+  const double cycles = tree_cycles_ * static_cast<double>(n_trees_) * static_cast<double>(N);
+  const double threads = std::min(static_cast<double>(max_num_threads), cycles / kThreadCycles);
+  if (threads < 2 || n_trees_ == 0) {
+    return TreeEnsembleParallelization::kNone;
+  }
+  if (N == 1) {
+    return TreeEnsembleParallelization::kTrees;
+  }
+
+  // By rows, there is a single parallel loop. By trees, there is one for every batch of rows and the scores of every
+  // thread are merged for every row, in parallel over the rows.
+  const double row_threads = std::min(threads, static_cast<double>(N));
+  const double tree_threads = std::min(threads, static_cast<double>(n_trees_));
+  const double by_rows = cycles / row_threads + kLoopCycles;
+  const double n_batches = std::ceil(static_cast<double>(N) / static_cast<double>(parallel_tree_N_));
+  const double by_trees = cycles / tree_threads + (n_batches + 1) * kLoopCycles +
+                          static_cast<double>(N * n_targets_or_classes_) * tree_threads * kMergeCycles / threads;
+  return by_trees < by_rows ? TreeEnsembleParallelization::kTrees : TreeEnsembleParallelization::kRows;
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 template <typename AGG>
 void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concurrency::ThreadPool* ttp,
@@ -505,12 +679,55 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
 
   const InputType* x_data = X->Data<InputType>();
   int64_t* label_data = label == nullptr ? nullptr : label->MutableData<int64_t>();
+  const int max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
+  TreeEnsembleParallelization parallelization = ChooseParallelization(N, max_num_threads);
+
+  if (autotune_parallelization_ && N > 1 && parallelization != TreeEnsembleParallelization::kNone) {
+    if (is_parallelization_tuned_.load(std::memory_order_acquire)) {
+      parallelization = tuned_parallelization_;
+    } else {
+      // concurrent runs keep the choice of the cost model while one of them times both parallelizations
+      std::unique_lock<std::mutex> lock(tune_mutex_, std::try_to_lock);
+      if (lock.owns_lock() && !is_parallelization_tuned_.load(std::memory_order_relaxed)) {
+        // every parallelization runs twice and the fastest run is kept so that neither pays for a cold cache
+        const TreeEnsembleParallelization candidates[] = {TreeEnsembleParallelization::kTrees,
+                                                          TreeEnsembleParallelization::kRows};
+        double seconds[] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+        for (int repeat = 0; repeat < 2; ++repeat) {
+          for (size_t k = 0; k < 2; ++k) {
+            const auto start = std::chrono::steady_clock::now();
+            ComputeAggWithParallelization(candidates[k], ttp, x_data, N, stride, z_data, label_data, agg);
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            seconds[k] = std::min(seconds[k], elapsed.count());
+          }
+        }
+        tuned_parallelization_ = seconds[0] <= seconds[1] ? candidates[0] : candidates[1];
+        is_parallelization_tuned_.store(true, std::memory_order_release);
+        LOGS_DEFAULT(INFO) << "TreeEnsemble with " << n_trees_ << " trees and " << N << " rows on "
+                           << max_num_threads << " threads: " << seconds[0] * 1e6 << " us by trees, "
+                           << seconds[1] * 1e6 << " us by rows, the cost model chose "
+                           << (parallelization == TreeEnsembleParallelization::kTrees ? "trees" : "rows")
+                           << ", parallelizing by "
+                           << (tuned_parallelization_ == TreeEnsembleParallelization::kTrees ? "trees" : "rows");
+        return;
+      }
+    }
+  }
+
+  ComputeAggWithParallelization(parallelization, ttp, x_data, N, stride, z_data, label_data, agg);
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename AGG>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAggWithParallelization(
+    TreeEnsembleParallelization parallelization, concurrency::ThreadPool* ttp, const InputType* x_data, int64_t N,
+    int64_t stride, OutputType* z_data, int64_t* label_data, const AGG& agg) const {
   auto max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
 
   if (n_targets_or_classes_ == 1) {
     if (N == 1) {
       ScoreValue<ThresholdType> score = {0, 0};
-      if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A: 1 output, 1 row and not enough trees to parallelize */
+      if (parallelization == TreeEnsembleParallelization::kNone) { /* section A: 1 output, 1 row and not enough trees to parallelize */
         for (int64_t j = 0; j < n_trees_; ++j) {
           agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data));
         }
@@ -529,7 +746,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
         }
       }
       agg.FinalizeScores1(z_data, score, label_data);
-    } else if (N <= parallel_N_ || max_num_threads == 1) { /* section C: 1 output, 2+ rows but not enough rows to parallelize */
+    } else if (parallelization == TreeEnsembleParallelization::kNone) { /* section C: 1 output, 2+ rows but not enough work to parallelize */
       // Not enough data to parallelize but the computation is split into batches of 128 rows,
       // and then loop on trees to evaluate every tree on this batch.
       // This change was introduced by PR: https://github.com/microsoft/onnxruntime/pull/13835.
@@ -550,16 +767,17 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           scores[SafeInt<ptrdiff_t>(i - batch)] = {0, 0};
         }
         for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-          for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-          }
+          ProcessTreeNodeLeaves(j, x_data, stride, batch, batch_end,
+                                [&](int64_t row, const TreeNodeElement<ThresholdType>& leaf) {
+                                  agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(row - batch)], leaf);
+                                });
         }
         for (i = batch; i < batch_end; ++i) {
           agg.FinalizeScores1(z_data + i, scores[SafeInt<ptrdiff_t>(i - batch)],
                               label_data == nullptr ? nullptr : (label_data + i));
         }
       }
-    } else if (n_trees_ > max_num_threads) { /* section D: 1 output, 2+ rows and enough trees to parallelize */
+    } else if (parallelization == TreeEnsembleParallelization::kTrees) { /* section D: 1 output, 2+ rows, parallelization by trees */
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
       std::vector<ScoreValue<ThresholdType>> scores(SafeInt<size_t>(num_threads) * N);
       int64_t end_n, begin_n = 0;
@@ -574,10 +792,11 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i] = {0, 0};
               }
               for (auto j = work.start; j < work.end; ++j) {
-                for (int64_t i = begin_n; i < end_n; ++i) {
-                  agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                 *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-                }
+                ProcessTreeNodeLeaves(j, x_data, stride, begin_n, end_n,
+                                      [&](int64_t i, const TreeNodeElement<ThresholdType>& leaf) {
+                                        agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
+                                                                       leaf);
+                                      });
               }
             });
         begin_n = end_n;
@@ -596,23 +815,35 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             }
           });
     } else { /* section E: 1 output, 2+ rows, parallelization by rows */
-      concurrency::ThreadPool::TryBatchParallelFor(
+      // every thread walks the trees over batches of its rows as in section C
+      auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(N));
+      concurrency::ThreadPool::TrySimpleParallelFor(
           ttp,
-          SafeInt<int32_t>(N),
-          [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
-            ScoreValue<ThresholdType> score = {0, 0};
-            for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+          num_threads,
+          [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
+            std::vector<ScoreValue<ThresholdType>> scores(parallel_tree_N_);
+            auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<ptrdiff_t>(N));
+            for (int64_t batch = work.start; batch < work.end; batch += parallel_tree_N_) {
+              int64_t batch_end = std::min<int64_t>(work.end, batch + parallel_tree_N_);
+              for (int64_t i = batch; i < batch_end; ++i) {
+                scores[SafeInt<ptrdiff_t>(i - batch)] = {0, 0};
+              }
+              for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+                ProcessTreeNodeLeaves(j, x_data, stride, batch, batch_end,
+                                      [&](int64_t row, const TreeNodeElement<ThresholdType>& leaf) {
+                                        agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(row - batch)], leaf);
+                                      });
+              }
+              for (int64_t i = batch; i < batch_end; ++i) {
+                agg.FinalizeScores1(z_data + i, scores[SafeInt<ptrdiff_t>(i - batch)],
+                                    label_data == nullptr ? nullptr : (label_data + i));
+              }
             }
-
-            agg.FinalizeScores1(z_data + i, score,
-                                label_data == nullptr ? nullptr : (label_data + i));
-          },
-          max_num_threads);
+          });
     }
   } else {
     if (N == 1) {                                               /* section A2: 2+ outputs, 1 row, not enough trees to parallelize */
-      if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A2 */
+      if (parallelization == TreeEnsembleParallelization::kNone) { /* section A2 */
         InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
         for (int64_t j = 0; j < n_trees_; ++j) {
           agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data), weights_);
@@ -636,7 +867,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
         }
         agg.FinalizeScores(scores[0], z_data, -1, label_data);
       }
-    } else if (N <= parallel_N_ || max_num_threads == 1) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
+    } else if (parallelization == TreeEnsembleParallelization::kNone) { /* section C2: 2+ outputs, 2+ rows, not enough work to parallelize */
       std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(parallel_tree_N_);
       size_t j, limit;
       int64_t i, batch, batch_end;
@@ -650,9 +881,10 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           std::fill(scores[SafeInt<ptrdiff_t>(i - batch)].begin(), scores[SafeInt<ptrdiff_t>(i - batch)].end(), ScoreValue<ThresholdType>({0, 0}));
         }
         for (j = 0, limit = roots_.size(); j < limit; ++j) {
-          for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
-          }
+          ProcessTreeNodeLeaves(j, x_data, stride, batch, batch_end,
+                                [&](int64_t row, const TreeNodeElement<ThresholdType>& leaf) {
+                                  agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(row - batch)], leaf, weights_);
+                                });
         }
         for (i = batch; i < batch_end; ++i) {
           agg.FinalizeScores(scores[SafeInt<ptrdiff_t>(i - batch)], z_data + i * n_targets_or_classes_, -1,
@@ -660,7 +892,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
         }
       }
 
-    } else if (n_trees_ >= max_num_threads) { /* section: D2: 2+ outputs, 2+ rows, enough trees to parallelize*/
+    } else if (parallelization == TreeEnsembleParallelization::kTrees) { /* section: D2: 2+ outputs, 2+ rows, parallelization by trees */
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
       std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(SafeInt<size_t>(num_threads) * N);
       int64_t end_n, begin_n = 0;
@@ -675,10 +907,11 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               }
               for (auto j = work.start; j < work.end; ++j) {
-                for (int64_t i = begin_n; i < end_n; ++i) {
-                  agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
-                }
+                ProcessTreeNodeLeaves(j, x_data, stride, begin_n, end_n,
+                                      [&](int64_t i, const TreeNodeElement<ThresholdType>& leaf) {
+                                        agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
+                                                                      leaf, weights_);
+                                      });
               }
             });
         begin_n = end_n;
@@ -697,28 +930,36 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             }
           });
     } else { /* section E2: 2+ outputs, 2+ rows, parallelization by rows */
+      // every thread walks the trees over batches of its rows as in section C2
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(N));
       concurrency::ThreadPool::TrySimpleParallelFor(
           ttp,
           num_threads,
           [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
-            size_t j, limit;
-            InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_));
+            std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(
+                parallel_tree_N_, InlinedVector<ScoreValue<ThresholdType>>(onnxruntime::narrow<size_t>(n_targets_or_classes_)));
             auto work = concurrency::ThreadPool::PartitionWork(batch_num, onnxruntime::narrow<ptrdiff_t>(num_threads), onnxruntime::narrow<ptrdiff_t>(N));
-
-            for (auto i = work.start; i < work.end; ++i) {
-              std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
-              for (j = 0, limit = roots_.size(); j < limit; ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+            for (int64_t batch = work.start; batch < work.end; batch += parallel_tree_N_) {
+              int64_t batch_end = std::min<int64_t>(work.end, batch + parallel_tree_N_);
+              for (int64_t i = batch; i < batch_end; ++i) {
+                std::fill(scores[SafeInt<ptrdiff_t>(i - batch)].begin(), scores[SafeInt<ptrdiff_t>(i - batch)].end(), ScoreValue<ThresholdType>({0, 0}));
+              }
+              for (size_t j = 0, limit = roots_.size(); j < limit; ++j) {
+                ProcessTreeNodeLeaves(j, x_data, stride, batch, batch_end,
+                                      [&](int64_t row, const TreeNodeElement<ThresholdType>& leaf) {
+                                        agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(row - batch)], leaf, weights_);
+                                      });
+              }
+              for (int64_t i = batch; i < batch_end; ++i) {
+                agg.FinalizeScores(scores[SafeInt<ptrdiff_t>(i - batch)], z_data + i * n_targets_or_classes_, -1,
+                                   label_data == nullptr ? nullptr : (label_data + i));
               }
-
-              agg.FinalizeScores(scores,
-                                 z_data + i * n_targets_or_classes_, -1,
-                                 label_data == nullptr ? nullptr : (label_data + i));
             }
           });
     }
   }
+}
+
 }  // namespace detail
 
 #define TREE_FIND_VALUE(CMP)                                                                           \
@@ -840,6 +1081,128 @@ TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
   return root;
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename Fn>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaves(
+    size_t j, const InputType* x_data, int64_t stride, int64_t begin, int64_t end, Fn&& fn) const {
+  switch (compact_depth_ == 0 ? NODE_MODE_ORT::LEAF : compact_mode_) {
+    case NODE_MODE_ORT::BRANCH_LEQ:
+      ProcessCompactTreeOfMode<NODE_MODE_ORT::BRANCH_LEQ>(j, x_data, stride, begin, end, fn);
+      break;
+    case NODE_MODE_ORT::BRANCH_LT:
+      ProcessCompactTreeOfMode<NODE_MODE_ORT::BRANCH_LT>(j, x_data, stride, begin, end, fn);
+      break;
+    case NODE_MODE_ORT::BRANCH_GTE:
+      ProcessCompactTreeOfMode<NODE_MODE_ORT::BRANCH_GTE>(j, x_data, stride, begin, end, fn);
+      break;
+    case NODE_MODE_ORT::BRANCH_GT:
+      ProcessCompactTreeOfMode<NODE_MODE_ORT::BRANCH_GT>(j, x_data, stride, begin, end, fn);
+      break;
+    case NODE_MODE_ORT::BRANCH_EQ:
+      ProcessCompactTreeOfMode<NODE_MODE_ORT::BRANCH_EQ>(j, x_data, stride, begin, end, fn);
+      break;
+    case NODE_MODE_ORT::BRANCH_NEQ:
+      ProcessCompactTreeOfMode<NODE_MODE_ORT::BRANCH_NEQ>(j, x_data, stride, begin, end, fn);
+      break;
+    default:
+      for (int64_t i = begin; i < end; ++i) {
+        fn(i, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+      }
+      break;
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <NODE_MODE_ORT Mode, typename Fn>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessCompactTreeOfMode(
+    size_t j, const InputType* x_data, int64_t stride, int64_t begin, int64_t end, Fn& fn) const {
+  // The usual depths of boosted trees get a walk unrolled for their depth, deeper trees use the generic one.
+  switch (compact_depth_) {
+    case 1:
+      ProcessCompactTree<Mode, 1>(j, x_data, stride, begin, end, fn);
+      break;
+    case 2:
+      ProcessCompactTree<Mode, 2>(j, x_data, stride, begin, end, fn);
+      break;
+    case 3:
+      ProcessCompactTree<Mode, 3>(j, x_data, stride, begin, end, fn);
+      break;
+    case 4:
+      ProcessCompactTree<Mode, 4>(j, x_data, stride, begin, end, fn);
+      break;
+    case 5:
+      ProcessCompactTree<Mode, 5>(j, x_data, stride, begin, end, fn);
+      break;
+    case 6:
+      ProcessCompactTree<Mode, 6>(j, x_data, stride, begin, end, fn);
+      break;
+    case 7:
+      ProcessCompactTree<Mode, 7>(j, x_data, stride, begin, end, fn);
+      break;
+    case 8:
+      ProcessCompactTree<Mode, 8>(j, x_data, stride, begin, end, fn);
+      break;
+    default:
+      ProcessCompactTree<Mode, 0>(j, x_data, stride, begin, end, fn);
+      break;
+  }
+}
+
+// Depth is the depth of the compact trees when it is known at compile time, 0 otherwise.
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <NODE_MODE_ORT Mode, size_t Depth, typename Fn>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessCompactTree(
+    size_t j, const InputType* x_data, int64_t stride, int64_t begin, int64_t end, Fn& fn) const {
+  // The paths of the rows of a block don't depend on each other, so their loads overlap. With a fixed depth the
+  // levels are unrolled and the comparisons of a level are a select per row, so more rows are walked together.
+  constexpr int64_t kRowBlock = Depth == 0 ? 8 : 16;
+  const size_t depth = Depth == 0 ? compact_depth_ : Depth;
+  const size_t n_internal = (size_t{1} << depth) - 1;
+  const int32_t* feature_ids = compact_feature_ids_.data() + j * n_internal;
+  const ThresholdType* thresholds = compact_thresholds_.data() + j * n_internal;
+  const uint8_t* missing_tracks_true =
+      has_missing_tracks_ ? compact_missing_tracks_true_.data() + j * n_internal : nullptr;
+  const TreeNodeElement<ThresholdType>* const* leaves = compact_leaves_.data() + j * (n_internal + 1);
+
+  for (int64_t i = begin; i < end; i += kRowBlock) {
+    const int64_t count = std::min(kRowBlock, end - i);
+    // The rows past the end of a last partial block repeat its last row, so every block has the same trip count.
+    const InputType* rows[kRowBlock];
+    for (int64_t r = 0; r < kRowBlock; ++r) {
+      rows[r] = x_data + (i + std::min(r, count - 1)) * stride;
+    }
+    size_t index[kRowBlock] = {};
+    for (size_t level = 0; level < depth; ++level) {
+      for (int64_t r = 0; r < kRowBlock; ++r) {
+        const InputType val = rows[r][feature_ids[index[r]]];
+        const ThresholdType threshold = thresholds[index[r]];
+        bool is_true;
+        if constexpr (Mode == NODE_MODE_ORT::BRANCH_LEQ) {
+          is_true = val <= threshold;
+        } else if constexpr (Mode == NODE_MODE_ORT::BRANCH_LT) {
+          is_true = val < threshold;
+        } else if constexpr (Mode == NODE_MODE_ORT::BRANCH_GTE) {
+          is_true = val >= threshold;
+        } else if constexpr (Mode == NODE_MODE_ORT::BRANCH_GT) {
+          is_true = val > threshold;
+        } else if constexpr (Mode == NODE_MODE_ORT::BRANCH_EQ) {
+          is_true = val == threshold;
+        } else {
+          is_true = val != threshold;
+        }
+        if (missing_tracks_true != nullptr) {
+          const bool is_missing = _isnan_(val);
+          is_true = is_true || (missing_tracks_true[index[r]] != 0 && is_missing);
+        }
+        index[r] = 2 * index[r] + 2 - static_cast<size_t>(is_true);
+      }
+    }
+    for (int64_t r = 0; r < count; ++r) {
+      fn(i + r, *leaves[index[r] - n_internal]);
+    }
+  }
+}
+
 // TI: input type
 // TH: threshold type, double if T==double, float otherwise
 // TO: output type
@@ -865,6 +1228,8 @@ class TreeEnsembleCommonClassifier : public TreeEnsembleCommon<InputType, Thresh
 template <typename InputType, typename ThresholdType, typename OutputType>
 Status TreeEnsembleCommonClassifier<InputType, ThresholdType, OutputType>::Init(const OpKernelInfo& info) {
   TreeEnsembleAttributesV3<ThresholdType> attributes(info, true);
+  this->autotune_parallelization_ =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsTreeEnsembleAutotuneParallelization, "0") == "1";
   return Init(80, 128, 50, attributes);
 }
 
@@ -945,6 +1310,8 @@ class TreeEnsembleCommonV5 : public TreeEnsembleCommon<IOType, ThresholdType, IO
 template <typename IOType, typename ThresholdType>
 Status TreeEnsembleCommonV5<IOType, ThresholdType>::Init(const OpKernelInfo& info) {
   TreeEnsembleAttributesV5<ThresholdType> attributes(info);
+  this->autotune_parallelization_ =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsTreeEnsembleAutotuneParallelization, "0") == "1";
   return Init(80, 128, 50, attributes);
 }
 
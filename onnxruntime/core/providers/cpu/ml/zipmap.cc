@@ -35,6 +35,34 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                             DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
     ZipMapOp);
 
+template <typename TKey>
+static void MakeRow(const std::vector<TKey>& labels, std::map<TKey, float>& row, std::vector<size_t>& sorted_columns) {
+  // a label repeated in the attributes takes the value of its last column
+  std::map<TKey, size_t> columns;
+  for (size_t j = 0; j < labels.size(); ++j) {
+    columns[labels[j]] = j;
+  }
+  for (const auto& [label, column] : columns) {
+    row.emplace_hint(row.end(), label, 0.f);
+    sorted_columns.push_back(column);
+  }
+}
+
+template <typename TKey>
+static void FillRows(const float* x_data, int64_t batch_size, int64_t features_per_batch,
+                     const std::map<TKey, float>& row, gsl::span<const size_t> sorted_columns,
+                     std::vector<std::map<TKey, float>>& y_data) {
+  y_data.resize(onnxruntime::narrow<size_t>(batch_size));
+  for (auto& y_row : y_data) {
+    y_row = row;
+    auto column = sorted_columns.begin();
+    for (auto& entry : y_row) {
+      entry.second = x_data[*column++];
+    }
+    x_data += features_per_batch;
+  }
+}
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +70,11 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  if (using_strings_) {
+    MakeRow(classlabels_strings_, string_row_, sorted_columns_);
+  } else {
+    MakeRow(classlabels_int64s_, int64_row_, sorted_columns_);
+  }
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -76,18 +109,7 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     }
     auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-
-    // auto* y_data = Y->MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(onnxruntime::narrow<size_t>(batch_size));
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[onnxruntime::narrow<size_t>(j)]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[onnxruntime::narrow<size_t>(n)] = std::move(map1);
-    }
+    FillRows(x_data, batch_size, features_per_batch, string_row_, sorted_columns_, *y_data);
   } else {
     if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
       return Status(ONNXRUNTIME,
@@ -97,17 +119,7 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     }
     auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    // auto* y_data = Y->MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(onnxruntime::narrow<size_t>(batch_size));
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+    FillRows(x_data, batch_size, features_per_batch, int64_row_, sorted_columns_, *y_data);
   }
   return common::Status::OK();
 }
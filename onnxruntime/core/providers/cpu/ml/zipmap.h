@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <map>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 namespace onnxruntime {
@@ -16,6 +18,12 @@ class ZipMapOp final : public OpKernel {
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+
+  // The map of every row has the same keys.  Each row is built as a copy of this map, whose values are then set in
+  // the order of the keys from the columns in sorted_columns_, so building the rows doesn't compare any keys.
+  std::map<std::string, float> string_row_;
+  std::map<int64_t, float> int64_row_;
+  std::vector<size_t> sorted_columns_;
 };
 
 }  // namespace ml
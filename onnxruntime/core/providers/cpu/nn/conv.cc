@@ -17,6 +17,8 @@
 
 #include "core/providers/cpu/nn/conv.h"
 
+#include <algorithm>
+
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/util/math_cpuonly.h"
@@ -153,6 +155,34 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+  // W is kept, since whether the Winograd algorithm is used depends on the input shape
+  is_packed = false;
+
+  // only transform 3x3 filters with unit strides and dilations
+  const auto& w_shape = tensor.Shape();
+  auto all_ones = [](const TensorShapeVector& values) {
+    return std::all_of(values.begin(), values.end(), [](int64_t value) { return value == 1; });
+  };
+  if (input_idx != 1 || w_shape.NumDimensions() != 4 || w_shape[2] != 3 || w_shape[3] != 3 ||
+      !all_ones(conv_attrs_.strides) || !all_ones(conv_attrs_.dilations)) {
+    return Status::OK();
+  }
+
+  const size_t group_count = narrow<size_t>(conv_attrs_.group);
+  const size_t filter_count = narrow<size_t>(w_shape[0]) / group_count;
+  const size_t input_channels = narrow<size_t>(w_shape[1]);
+  const size_t packed_size = MlasConvWinogradPackedFilterSize(group_count, input_channels, filter_count);
+  auto* packed_data = alloc->Alloc(SafeInt<size_t>(packed_size) * sizeof(float));
+  winograd_filter_ = BufferUniquePtr(packed_data, BufferDeleter(std::move(alloc)));
+
+  MlasConvWinogradPackFilter(group_count, input_channels, filter_count, tensor.Data<float>(),
+                             static_cast<float*>(packed_data));
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
@@ -231,6 +261,7 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     &activation_,
                     &WorkingBufferSize,
                     Beta,
+                    winograd_filter_ != nullptr,
                     thread_pool);
 
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
@@ -239,7 +270,8 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
 
     MlasConv(&Parameters,
              Xdata.data(),
-             W->Data<float>(),
+             Parameters.Algorithm == MlasConvAlgorithmWinograd ? static_cast<const float*>(winograd_filter_.get())
+                                                                : W->Data<float>(),
              Bdata,
              static_cast<float*>(working_buffer.get()),
              Ydata.data(),
@@ -28,12 +28,20 @@ class Conv<float> : public OpKernel {
     activation_.ActivationKind = MlasIdentityActivation;
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // W transformed by MlasConvWinogradPackFilter, used when MlasConvPrepare selects the Winograd algorithm.
+  BufferUniquePtr winograd_filter_;
 };
 
 }  // namespace onnxruntime
@@ -24,6 +24,52 @@
 
 namespace onnxruntime {
 
+namespace {
+
+// Col2im of the output channels of a group, followed by the bias of each channel. The channels scatter into
+// disjoint planes of the output, so they run in parallel on the thread pool instead of one after the other.
+void Col2imChannels(const float* col_buffer_data, int64_t channels, int64_t input_image_size,
+                    const ConvTransposeAttributes::Prepare& p, const float* bias, float* Ydata,
+                    concurrency::ThreadPool* thread_pool) {
+  const int64_t kernel_size = p.kernel_shape[0] * p.kernel_shape[1];
+  const int64_t output_height = p.Y->Shape()[2];
+  const int64_t output_width = p.Y->Shape()[3];
+  const int64_t output_image_size = output_height * output_width;
+  const double col_elements = static_cast<double>(kernel_size * input_image_size);
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, onnxruntime::narrow<std::ptrdiff_t>(channels),
+      TensorOpCost{col_elements * sizeof(float), static_cast<double>(output_image_size) * sizeof(float),
+                   col_elements},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t c = first; c < last; ++c) {
+          float* y = Ydata + c * output_image_size;
+          math::Col2im<float, CPUMathUtil, StorageOrder::NCHW>(
+              col_buffer_data + c * kernel_size * input_image_size,
+              1,
+              output_height,
+              output_width,
+              p.kernel_shape[0],
+              p.kernel_shape[1],
+              p.dilations[0],
+              p.dilations[1],
+              p.pads[0],
+              p.pads[1],
+              p.pads[2],
+              p.pads[3],
+              p.strides[0],
+              p.strides[1],
+              y,
+              &CPUMathUtil::Instance());
+          if (bias != nullptr) {
+            EigenVectorArrayMap<float>(y, onnxruntime::narrow<size_t>(output_image_size)) += bias[c];
+          }
+        }
+      });
+}
+
+}  // namespace
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     ConvTranspose,
     1, 10,
@@ -279,23 +325,10 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
           thread_pool);
 
       if (p.X->Shape().NumDimensions() == 4) {
-        math::Col2im<float, CPUMathUtil, StorageOrder::NCHW>(
-            col_buffer_data,
-            p.num_output_channels / conv_transpose_attrs_.group,
-            p.Y->Shape()[2],
-            p.Y->Shape()[3],
-            p.kernel_shape[0],
-            p.kernel_shape[1],
-            p.dilations[0],
-            p.dilations[1],
-            p.pads[0],
-            p.pads[1],
-            p.pads[2],
-            p.pads[3],
-            p.strides[0],
-            p.strides[1],
-            Ydata + group_id * Y_offset,
-            &CPUMathUtil::Instance());
+        const int64_t group_output_channels = p.num_output_channels / conv_transpose_attrs_.group;
+        Col2imChannels(col_buffer_data, group_output_channels, input_image_size, p,
+                       p.B ? p.B->Data<float>() + group_id * group_output_channels : nullptr,
+                       Ydata + group_id * Y_offset, thread_pool);
       } else {
         math::Col2imNd<float, CPUMathUtil, StorageOrder::NCHW>(
             col_buffer_data,
@@ -313,7 +346,8 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
       }
     }
 
-    if (p.B != nullptr) {
+    // the 2-D case adds the bias in Col2imChannels
+    if (p.B != nullptr && p.X->Shape().NumDimensions() != 4) {
       auto Ymatrix = EigenMatrixMap<float>(Ydata, onnxruntime::narrow<size_t>(output_size), onnxruntime::narrow<size_t>(p.num_output_channels));
       auto Bvec = ConstEigenVectorMap<float>(p.B->Data<float>(), onnxruntime::narrow<size_t>(p.num_output_channels));
       Ymatrix.rowwise() += Bvec.transpose();
@@ -6,8 +6,7 @@
 #include "core/common/narrow.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/random_generator.h"
-#include <chrono>
-#include <random>
+#include "core/providers/cpu/generator/philox.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -18,14 +17,14 @@ class Dropout final : public OpKernel {
   Dropout(const OpKernelInfo& info) : OpKernel{info} {
     int64_t seed = 0;
     if (info.GetAttr<int64_t>("seed", &seed).IsOK()) {
-      generator_ = std::make_unique<RandomGenerator>(seed);
+      generator_ = std::make_unique<PhiloxGenerator>(static_cast<uint64_t>(seed));
     }
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  mutable std::unique_ptr<RandomGenerator> generator_;
+  mutable std::unique_ptr<PhiloxGenerator> generator_;
 };
 
 namespace {
@@ -78,21 +77,30 @@ Status Dropout<T1, T2>::Compute(OpKernelContext* context) const {
 
   } else {
     // drop some
-    ConstEigenVectorArrayMap<T1> X_arr(X_span.data(), X_span.size());
-    EigenVectorArrayMap<T1> Y_arr(Y_span.data(), Y_span.size());
-    EigenVectorArrayMap<bool> mask_arr(mask_span.data(), mask_span.size());
-
-    // generate mask
-    {
-      RandomGenerator& generator = generator_ != nullptr ? *generator_.get() : RandomGenerator::Default();
-      std::default_random_engine rng(gsl::narrow_cast<std::default_random_engine::result_type>(generator.NextSeed()));
-      std::uniform_real_distribution<float> dist{0.0f, 1.0f};
-      mask_arr = Eigen::ArrayX<bool>::NullaryExpr(
-          mask_arr.size(),
-          [ratio_value, &dist, &rng]() { return dist(rng) >= ratio_value; });
-    }
-
-    Y_arr = mask_arr.cast<T1>() * X_arr / (1.0f - ratio_value);
+    // The mask and the output are generated together from counter-based samples, in parallel over the blocks of
+    // samples, and do not depend on the number of threads.
+    PhiloxGenerator& generator = generator_ != nullptr ? *generator_.get() : PhiloxGenerator::Default();
+    const size_t count = X_span.size();
+    const auto [seed, offset] = generator.NextPhiloxSeeds(philox::BlockCount<float>(count));
+    constexpr size_t kSamples = philox::SamplesPerBlock<float>();
+    const T1 scale = static_cast<T1>(1.0f / (1.0f - ratio_value));
+    concurrency::ThreadPool::TryParallelFor(
+        context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(philox::BlockCount<float>(count)),
+        TensorOpCost{static_cast<double>(kSamples * sizeof(T1)), static_cast<double>(kSamples * (sizeof(T1) + 1)),
+                     60.0},
+        [&, seed = seed, offset = offset](std::ptrdiff_t first, std::ptrdiff_t last) {
+          float samples[kSamples];
+          for (std::ptrdiff_t block = first; block < last; ++block) {
+            philox::ToUniform<float>(philox::Generate(seed, offset + static_cast<uint64_t>(block)), samples);
+            const size_t begin = static_cast<size_t>(block) * kSamples;
+            const size_t end = std::min(begin + kSamples, count);
+            for (size_t i = begin; i < end; ++i) {
+              const bool keep = samples[i - begin] >= ratio_value;
+              mask_span[i] = keep;
+              Y_span[i] = keep ? X_span[i] * scale : T1{0};
+            }
+          }
+        });
   }
 
   return Status::OK();
@@ -41,6 +41,23 @@ void ComputeJob(
   const T* p_input = X_data + task_idx * norm_size;
   T* p_output = Y_data + task_idx * norm_size;
 
+  if constexpr (std::is_same_v<T, float>) {
+    // Compute the offset of gamma and beta to support broadcasting.
+    const int64_t offset = LAYER_NORM_SCALE_BIAS_OFFSET(broadcast_param, task_idx, norm_size);
+    float mean = 0.0f;
+    float inv_std_dev = 0.0f;
+    MlasLayerNormOneRow(p_input, nullptr, nullptr, scale_data + offset, bias_data ? bias_data + offset : nullptr,
+                        static_cast<size_t>(norm_size), epsilon, simplified, p_output, nullptr, &mean, &inv_std_dev);
+
+    if (mean_data != nullptr) {
+      mean_data[task_idx] = mean;
+    }
+    if (inv_std_dev_data != nullptr) {
+      inv_std_dev_data[task_idx] = inv_std_dev;
+    }
+    return;
+  }
+
   T mean(0.0f);
   T mean_square(0.0f);
 
@@ -98,56 +115,26 @@ void ComputeJob(
     AllocatorPtr alloc) {
   ORT_UNUSED_PARAMETER(scale_data);  // only used in float/double overload
   ORT_UNUSED_PARAMETER(bias_data);   // only used in float/double overload
+  ORT_UNUSED_PARAMETER(alloc);
 
   const MLFloat16* p_input = X_data + task_idx * norm_size;
   MLFloat16* p_output = Y_data + task_idx * norm_size;
 
-  float mean(0.0f);
-  float mean_square(0.0f);
-
-  const size_t num_elems = static_cast<size_t>(norm_size);
-  IAllocatorUniquePtr<float> input_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-  MlasConvertHalfToFloatBuffer(p_input, input_float_uptr.get(), num_elems);
-
-  IAllocatorUniquePtr<float> output_float_uptr = IAllocator::MakeUniquePtr<float>(alloc, num_elems);
-  float* output_float_ptr = output_float_uptr.get();
-
-  const float* input_float_ptr = input_float_uptr.get();
-  for (size_t h = 0; h < num_elems; h++) {
-    output_float_ptr[h] = input_float_ptr[h];
-    mean += input_float_ptr[h];
-    mean_square += input_float_ptr[h] * input_float_ptr[h];
-  }
-
-  mean = mean / norm_size;
-  if (simplified) {
-    mean_square = sqrt(mean_square / norm_size + epsilon);
-  } else {
-    mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
-  }
-
   // Compute the offset of gamma and beta to support broadcasting.
-  int64_t i = LAYER_NORM_SCALE_BIAS_OFFSET(broadcast_param, task_idx, norm_size);
-
-  for (size_t h = 0; h < num_elems; h++, i++) {
-    if (simplified) {
-      output_float_ptr[h] = output_float_ptr[h] / mean_square * scale_float_ptr[i];
-    } else if (nullptr == bias_float_ptr) {
-      output_float_ptr[h] = (output_float_ptr[h] - mean) / mean_square * scale_float_ptr[i];
-    } else {
-      output_float_ptr[h] = (output_float_ptr[h] - mean) / mean_square * scale_float_ptr[i] + bias_float_ptr[i];
-    }
-  }
-
-  MlasConvertFloatToHalfBuffer(output_float_ptr, p_output, num_elems);
+  const int64_t offset = LAYER_NORM_SCALE_BIAS_OFFSET(broadcast_param, task_idx, norm_size);
+  float mean = 0.0f;
+  float inv_std_dev = 0.0f;
+  MlasLayerNormOneRow(p_input, nullptr, nullptr, scale_float_ptr + offset,
+                      bias_float_ptr ? bias_float_ptr + offset : nullptr, static_cast<size_t>(norm_size), epsilon,
+                      simplified, p_output, nullptr, &mean, &inv_std_dev);
 
   if (mean_data != nullptr) {
     // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
-    mean_data[task_idx] = MLFloat16(mean);
+    mean_data[task_idx] = static_cast<U>(mean);
   }
 
   if (inv_std_dev_data != nullptr) {
-    inv_std_dev_data[task_idx] = MLFloat16(1 / mean_square);
+    inv_std_dev_data[task_idx] = static_cast<U>(inv_std_dev);
   }
 }
 
@@ -13,10 +13,13 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -43,6 +46,73 @@ ONNX_OPERATOR_KERNEL_EX(
 
 using namespace nms_helpers;
 
+namespace {
+
+// Corners and areas of boxes, in separate arrays so the IOU of a box with many others vectorizes.
+struct BoxCorners {
+  explicit BoxCorners(size_t count)
+      : x_min(count), y_min(count), x_max(count), y_max(count), area(count) {}
+
+  void Set(size_t i, const BoxCorners& other, size_t j) {
+    x_min[i] = other.x_min[j];
+    y_min[i] = other.y_min[j];
+    x_max[i] = other.x_max[j];
+    y_max[i] = other.y_max[j];
+    area[i] = other.area[j];
+  }
+
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+};
+
+// Returns whether box 'index' of 'boxes' exceeds iou_threshold with any of the first 'count' boxes of 'selected'.
+// This computes the same values as nms_helpers::SuppressByIOU, without branches within a block of boxes so the
+// compiler can vectorize it, and goes on to the next block only if no box of this one suppresses.
+bool SuppressedBySelected(const BoxCorners& boxes, size_t index, const BoxCorners& selected, size_t count,
+                          float iou_threshold) {
+  constexpr size_t kBlockSize = 16;
+  const float x_min = boxes.x_min[index];
+  const float y_min = boxes.y_min[index];
+  const float x_max = boxes.x_max[index];
+  const float y_max = boxes.y_max[index];
+  const float area = boxes.area[index];
+  const float* selected_x_min = selected.x_min.data();
+  const float* selected_y_min = selected.y_min.data();
+  const float* selected_x_max = selected.x_max.data();
+  const float* selected_y_max = selected.y_max.data();
+  const float* selected_area = selected.area.data();
+
+  for (size_t start = 0; start < count; start += kBlockSize) {
+    const size_t end = std::min(count, start + kBlockSize);
+    int suppressed = 0;
+    for (size_t i = start; i < end; ++i) {
+      const float intersection_x_min = std::max(x_min, selected_x_min[i]);
+      const float intersection_x_max = std::min(x_max, selected_x_max[i]);
+      const float intersection_y_min = std::max(y_min, selected_y_min[i]);
+      const float intersection_y_max = std::min(y_max, selected_y_max[i]);
+      const float intersection_area = (intersection_x_max - intersection_x_min) *
+                                      (intersection_y_max - intersection_y_min);
+      const float union_area = area + selected_area[i] - intersection_area;
+      suppressed |= static_cast<int>(intersection_x_max > intersection_x_min) &
+                    static_cast<int>(intersection_y_max > intersection_y_min) &
+                    static_cast<int>(intersection_area > .0f) &
+                    static_cast<int>(area > .0f) & static_cast<int>(selected_area[i] > .0f) &
+                    static_cast<int>(union_area > .0f) &
+                    static_cast<int>(intersection_area / union_area > iou_threshold);
+    }
+    if (suppressed != 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace
+
 // This works for both CPU and GPU.
 // CUDA kernel declare OrtMemTypeCPUInput for max_output_boxes_per_class(2), iou_threshold(3) and score_threshold(4)
 Status NonMaxSuppressionBase::PrepareCompute(OpKernelContext* ctx, PrepareContext& pc) {
@@ -135,6 +205,29 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
+  const auto center_point_box = GetCenterPointBox();
+  const size_t num_boxes = static_cast<size_t>(pc.num_boxes_);
+
+  // Convert the boxes of all batches to corners in SoA layout once, as they're shared by all the classes.
+  const size_t total_boxes = SafeInt<size_t>(pc.num_batches_) * num_boxes;
+  BoxCorners corners(total_boxes);
+  for (size_t i = 0; i < total_boxes; ++i) {
+    const float* box = boxes_data + 4 * i;
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2]
+      MaxMin(box[1], box[3], corners.x_min[i], corners.x_max[i]);
+      MaxMin(box[0], box[2], corners.y_min[i], corners.y_max[i]);
+    } else {
+      // boxes data format [x_center, y_center, width, height]
+      const float width_half = box[2] / 2;
+      const float height_half = box[3] / 2;
+      corners.x_min[i] = box[0] - width_half;
+      corners.x_max[i] = box[0] + width_half;
+      corners.y_min[i] = box[1] - height_half;
+      corners.y_max[i] = box[1] + height_half;
+    }
+    corners.area[i] = (corners.x_max[i] - corners.x_min[i]) * (corners.y_max[i] - corners.y_min[i]);
+  }
 
   struct BoxInfoPtr {
     float score_{};
@@ -142,61 +235,70 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
     BoxInfoPtr() = default;
     explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
+    // orders by descending score, then by ascending index
     inline bool operator<(const BoxInfoPtr& rhs) const {
-      return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
+      return score_ > rhs.score_ || (score_ == rhs.score_ && index_ < rhs.index_);
     }
   };
 
-  const auto center_point_box = GetCenterPointBox();
+  // The (batch, class) pairs are independent, so they run in parallel and keep their selected box indices apart
+  // until they're written to the output in order.
+  const std::ptrdiff_t num_tasks = narrow<std::ptrdiff_t>(pc.num_batches_ * pc.num_classes_);
+  std::vector<std::vector<int64_t>> selected_per_task(static_cast<size_t>(num_tasks));
+  const size_t max_selected = std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), num_boxes);
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
+  auto select_boxes = [&](std::ptrdiff_t task) {
+    const int64_t batch_index = task / pc.num_classes_;
+    const size_t batch_box_offset = static_cast<size_t>(batch_index) * num_boxes;
+
+    std::vector<BoxInfoPtr> candidate_boxes;
+    candidate_boxes.reserve(num_boxes);
+
+    // Filter by score_threshold_
+    const auto* class_scores = scores_data + task * pc.num_boxes_;
+    for (size_t box_index = 0; box_index < num_boxes; ++box_index) {
+      if (pc.score_threshold_ == nullptr || class_scores[box_index] > score_threshold) {
+        candidate_boxes.emplace_back(class_scores[box_index], static_cast<int64_t>(box_index));
+      }
+    }
+    std::sort(candidate_boxes.begin(), candidate_boxes.end());
+
+    std::vector<int64_t>& selected = selected_per_task[static_cast<size_t>(task)];
+    BoxCorners selected_corners(std::min(max_selected, candidate_boxes.size()));
+    size_t num_selected = 0;
+
+    // Take the boxes in score order, suppressing the ones that exceed the IOU (Intersection Over Union) threshold
+    // with a box already selected for this class.
+    for (const auto& candidate : candidate_boxes) {
+      if (num_selected == max_selected) {
+        break;
       }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
-          }
-        }
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+      const size_t box = batch_box_offset + static_cast<size_t>(candidate.index_);
+      if (!SuppressedBySelected(corners, box, selected_corners, num_selected, iou_threshold)) {
+        selected_corners.Set(num_selected++, corners, box);
+        selected.push_back(candidate.index_);
+      }
+    }
+  };
+
+  // the cost of a task is dominated by reading the scores and sorting the candidates
+  const double num_boxes_cost = static_cast<double>(num_boxes);
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), num_tasks,
+      TensorOpCost{num_boxes_cost * sizeof(float), 0, num_boxes_cost * 16},
+      [&select_boxes](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t task = first; task < last; ++task) {
+          select_boxes(task);
         }
-        sorted_boxes.pop();
-      }  // while
-    }  // for class_index
-  }  // for batch_index
+      });
+
+  std::vector<SelectedIndex> selected_indices;
+  for (std::ptrdiff_t task = 0; task < num_tasks; ++task) {
+    for (int64_t box_index : selected_per_task[static_cast<size_t>(task)]) {
+      selected_indices.emplace_back(task / pc.num_classes_, task % pc.num_classes_, box_index);
+    }
+  }
 
   constexpr auto last_dim = 3;
   const auto num_selected = selected_indices.size();
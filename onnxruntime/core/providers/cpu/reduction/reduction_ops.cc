@@ -332,7 +332,7 @@ bool operator!=(FastReduceKind a, FastReduceKind b) {
 }
 
 bool ResultsNoTransposePrepareForReduce::equal(gsl::span<const int64_t> local_input_shape,
-                                               gsl::span<const int64_t> local_reduced_axes) {
+                                               gsl::span<const int64_t> local_reduced_axes) const {
   if (!SpanEq(gsl::make_span(input_shape), local_input_shape))
     return false;
   if (!SpanEq(gsl::make_span(reduced_axes), local_reduced_axes))
@@ -340,12 +340,36 @@ bool ResultsNoTransposePrepareForReduce::equal(gsl::span<const int64_t> local_in
   return true;
 }
 
-void ResultsNoTransposePrepareForReduce::ValidateNotEmpty() {
+void ResultsNoTransposePrepareForReduce::ValidateNotEmpty() const {
   ORT_ENFORCE(last_loop_red_size > 0);
   ORT_ENFORCE(last_loop_size > 0);
   ORT_ENFORCE(projected_index.size() > 0);
 }
 
+std::shared_ptr<const ResultsNoTransposePrepareForReduce> ReducePlanCache::Get(
+    const TensorShape& new_input_shape, gsl::span<const int64_t> reduced_axes) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = plans_.begin(); it != plans_.end(); ++it) {
+      if ((*it)->equal(new_input_shape.GetDims(), reduced_axes)) {
+        plans_.splice(plans_.begin(), plans_, it);
+        return plans_.front();
+      }
+    }
+  }
+
+  // built outside of the lock, a concurrent miss on the same key only adds a duplicate that ages out.
+  auto plan = std::make_shared<ResultsNoTransposePrepareForReduce>();
+  NoTransposePrepareForReduce(new_input_shape, reduced_axes, *plan);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  plans_.push_front(plan);
+  if (plans_.size() > capacity_) {
+    plans_.pop_back();
+  }
+  return plan;
+}
+
 static void ValidateMustBeOverloaded() {
   ORT_ENFORCE(false, "must be overloaded.");
 }
@@ -386,6 +410,13 @@ void ReduceAggregatorBase::FastReduceRKR(const Tensor&, const gsl::span<const in
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
                                  gsl::span<const int64_t> reduced_axes,
                                  ResultsNoTransposePrepareForReduce& results) {
+  results.input_shape.assign(new_input_shape.GetDims().begin(), new_input_shape.GetDims().end());
+  results.reduced_axes.assign(reduced_axes.begin(), reduced_axes.end());
+  results.projected_index.clear();
+  results.unprojected_index.clear();
+  results.last_loop_size = 0;
+  results.last_loop_inc = 0;
+
   // Common initialisation for the indices.
   auto cumulative_shape = new_input_shape.AsShapeVector();
   cumulative_shape[cumulative_shape.size() - 1] = 1;
@@ -488,34 +519,38 @@ template <typename AGG>
 struct ParallelizedData {
   int64_t denominator;
   int64_t loop_size;
-  ResultsNoTransposePrepareForReduce* last_results;
+  const ResultsNoTransposePrepareForReduce* last_results;
   const typename AGG::input_type* from_data;
   typename AGG::value_type* to_data;
 };
 
+// Reduces all the axes at once, returns false if the reduction needs a plan.
 template <typename AGG>
-void NoTransposeReduce1Loop(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
-                            gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
-                            ResultsNoTransposePrepareForReduce& last_results) {
-  auto output_shape = output->Shape();
+bool NoTransposeReduceAll(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
+                          gsl::span<const int64_t> reduced_axes) {
+  if (reduced_axes.size() != 0 && reduced_axes.size() != new_input_shape.NumDimensions()) {
+    return false;
+  }
+
+  ValidateNoTransposeReduce(output->Shape().Size());
   const typename AGG::input_type* from_data = input.Data<typename AGG::input_type>();
   typename AGG::value_type* to_data = output->MutableData<typename AGG::value_type>();
-  int64_t count = output_shape.Size();
+  int64_t input_size = new_input_shape.Size();
+  to_data[0] = AGG(input_size, from_data[0]).aggall(from_data);
+  return true;
+}
 
-  if (reduced_axes.size() == 0 || reduced_axes.size() == new_input_shape.NumDimensions()) {
-    ValidateNoTransposeReduce(count);
-    int64_t input_size = new_input_shape.Size();
-    to_data[0] = AGG(input_size, from_data[0]).aggall(from_data);
+template <typename AGG>
+void NoTransposeReduce1LoopWithPlan(Tensor* output, const Tensor& input, concurrency::ThreadPool* tp,
+                                    const ResultsNoTransposePrepareForReduce& last_results) {
+  if (last_results.last_loop_red_size == 0 || last_results.last_loop_size == 0)
     return;
-  }
-
-  if (!last_results.equal(new_input_shape.GetDims(), reduced_axes)) {
-    NoTransposePrepareForReduce(new_input_shape, reduced_axes, last_results);
-    if (last_results.last_loop_red_size == 0 || last_results.last_loop_size == 0)
-      return;
-  }
   last_results.ValidateNotEmpty();
 
+  const typename AGG::input_type* from_data = input.Data<typename AGG::input_type>();
+  typename AGG::value_type* to_data = output->MutableData<typename AGG::value_type>();
+  int64_t count = output->Shape().Size();
+
   ParallelizedData<AGG> data;
   data.denominator = last_results.last_loop_red_size * last_results.projected_index.size();
   data.loop_size = last_results.last_loop_red_size * last_results.last_loop_red_inc;
@@ -559,28 +594,42 @@ void NoTransposeReduce1Loop(Tensor* output, const TensorShape& new_input_shape,
 }
 
 template <typename AGG>
-void NoTransposeReduce2Loops(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
-                             gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
-                             ResultsNoTransposePrepareForReduce& last_results) {
-  auto output_shape = output->Shape();
-  const typename AGG::input_type* from_data = input.Data<typename AGG::input_type>();
-  typename AGG::value_type* to_data = output->MutableData<typename AGG::value_type>();
-  int64_t count = output_shape.Size();
-
-  if (reduced_axes.size() == 0 || reduced_axes.size() == new_input_shape.NumDimensions()) {
-    ValidateNoTransposeReduce(count);
-    int64_t input_size = new_input_shape.Size();
-    to_data[0] = AGG(input_size, from_data[0]).aggall(from_data);
+void NoTransposeReduce1Loop(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
+                            gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
+                            ResultsNoTransposePrepareForReduce& last_results) {
+  if (NoTransposeReduceAll<AGG>(output, new_input_shape, input, reduced_axes)) {
     return;
   }
 
   if (!last_results.equal(new_input_shape.GetDims(), reduced_axes)) {
     NoTransposePrepareForReduce(new_input_shape, reduced_axes, last_results);
-    if (last_results.last_loop_red_size == 0 || last_results.last_loop_size == 0)
-      return;
   }
+  NoTransposeReduce1LoopWithPlan<AGG>(output, input, tp, last_results);
+}
+
+template <typename AGG>
+void NoTransposeReduce1Loop(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
+                            gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
+                            ReducePlanCache& plan_cache) {
+  if (NoTransposeReduceAll<AGG>(output, new_input_shape, input, reduced_axes)) {
+    return;
+  }
+
+  auto plan = plan_cache.Get(new_input_shape, reduced_axes);
+  NoTransposeReduce1LoopWithPlan<AGG>(output, input, tp, *plan);
+}
+
+template <typename AGG>
+void NoTransposeReduce2LoopsWithPlan(Tensor* output, const Tensor& input, concurrency::ThreadPool* tp,
+                                     const ResultsNoTransposePrepareForReduce& last_results) {
+  if (last_results.last_loop_red_size == 0 || last_results.last_loop_size == 0)
+    return;
   last_results.ValidateNotEmpty();
 
+  const typename AGG::input_type* from_data = input.Data<typename AGG::input_type>();
+  typename AGG::value_type* to_data = output->MutableData<typename AGG::value_type>();
+  int64_t count = output->Shape().Size();
+
   ParallelizedData<AGG> data;
   data.denominator = last_results.last_loop_red_size * last_results.projected_index.size();
   data.loop_size = last_results.last_loop_red_size * last_results.last_loop_red_inc;
@@ -630,6 +679,32 @@ void NoTransposeReduce2Loops(Tensor* output, const TensorShape& new_input_shape,
   concurrency::ThreadPool::TryParallelFor(tp, onnxruntime::narrow<std::ptrdiff_t>(count), cost, fn);
 }
 
+template <typename AGG>
+void NoTransposeReduce2Loops(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
+                             gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
+                             ResultsNoTransposePrepareForReduce& last_results) {
+  if (NoTransposeReduceAll<AGG>(output, new_input_shape, input, reduced_axes)) {
+    return;
+  }
+
+  if (!last_results.equal(new_input_shape.GetDims(), reduced_axes)) {
+    NoTransposePrepareForReduce(new_input_shape, reduced_axes, last_results);
+  }
+  NoTransposeReduce2LoopsWithPlan<AGG>(output, input, tp, last_results);
+}
+
+template <typename AGG>
+void NoTransposeReduce2Loops(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
+                             gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
+                             ReducePlanCache& plan_cache) {
+  if (NoTransposeReduceAll<AGG>(output, new_input_shape, input, reduced_axes)) {
+    return;
+  }
+
+  auto plan = plan_cache.Get(new_input_shape, reduced_axes);
+  NoTransposeReduce2LoopsWithPlan<AGG>(output, input, tp, *plan);
+}
+
 void DropDimensions(const gsl::span<const int64_t>& input_shape,
                     const gsl::span<const int64_t>& axes,
                     TensorShapeVector& dropped_axes) {
@@ -923,7 +998,7 @@ bool check_and_reduce_empty_set_input(OpKernelContext* ctx, const gsl::span<cons
 template <typename AGG>
 void CommonReduce1Loop(OpKernelContext* ctx,
                        const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                       bool noop_with_empty_axes) {
+                       bool noop_with_empty_axes, ReducePlanCache* plan_cache) {
   if (check_and_reduce_empty_set_input<AGG>(ctx, axes_, keepdims_ != 0)) {
     return;
   }
@@ -953,6 +1028,11 @@ void CommonReduce1Loop(OpKernelContext* ctx,
     return;
   }
 
+  if (plan_cache != nullptr) {
+    NoTransposeReduce1Loop<AGG>(output, fast_shape, *input, fast_axes, ctx->GetOperatorThreadPool(), *plan_cache);
+    return;
+  }
+
   ResultsNoTransposePrepareForReduce last_results;
   NoTransposeReduce1Loop<AGG>(output, fast_shape, *input, fast_axes, ctx->GetOperatorThreadPool(), last_results);
 }
@@ -960,7 +1040,7 @@ void CommonReduce1Loop(OpKernelContext* ctx,
 template <typename AGG>
 void CommonReduce2Loops(OpKernelContext* ctx,
                         const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                        bool noop_with_empty_axes) {
+                        bool noop_with_empty_axes, ReducePlanCache* plan_cache) {
   if (check_and_reduce_empty_set_input<AGG>(ctx, axes_, keepdims_ != 0)) {
     return;
   }
@@ -989,6 +1069,11 @@ void CommonReduce2Loops(OpKernelContext* ctx,
     return;
   }
 
+  if (plan_cache != nullptr) {
+    NoTransposeReduce2Loops<AGG>(output, fast_shape, *input, fast_axes, ctx->GetOperatorThreadPool(), *plan_cache);
+    return;
+  }
+
   ResultsNoTransposePrepareForReduce last_results;
   NoTransposeReduce2Loops<AGG>(output, fast_shape, *input, fast_axes, ctx->GetOperatorThreadPool(), last_results);
 }
@@ -998,55 +1083,55 @@ Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
   // The following variable does not change if the input tensor and the
   // axes do not either. It could be either cached in ctx or precomputed
   // in the constructor if shape and axes are known at this stage.
-  CommonReduce1Loop<ReduceAggregatorL1<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_);
+  CommonReduce1Loop<ReduceAggregatorL1<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorL2<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_);
+  CommonReduce1Loop<ReduceAggregatorL2<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorLogSum<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_);
+  CommonReduce1Loop<ReduceAggregatorLogSum<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce2Loops<ReduceAggregatorLogSumExp<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_);
+  CommonReduce2Loops<ReduceAggregatorLogSumExp<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorMax<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_);
+  CommonReduce1Loop<ReduceAggregatorMax<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorMean<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_);
+  CommonReduce1Loop<ReduceAggregatorMean<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorMin<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_);
+  CommonReduce1Loop<ReduceAggregatorMin<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorProd<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_);
+  CommonReduce1Loop<ReduceAggregatorProd<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorSum<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_);
+  CommonReduce1Loop<ReduceAggregatorSum<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_, &plan_cache_);
   return Status::OK();
 }
 
@@ -1124,16 +1209,16 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
 
 template <typename T>
 Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
-  CommonReduce1Loop<ReduceAggregatorSumSquare<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_);
+  CommonReduce1Loop<ReduceAggregatorSumSquare<T>>(ctx, axes_, keepdims_, noop_with_empty_axes_, &plan_cache_);
   return Status::OK();
 }
 
 template <typename T>
 Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
   if (select_last_index_) {
-    CommonReduce1Loop<ReduceAggregatorArgMaxLastIndex<T>>(ctx, axes_, keepdims_);
+    CommonReduce1Loop<ReduceAggregatorArgMaxLastIndex<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   } else {
-    CommonReduce1Loop<ReduceAggregatorArgMax<T>>(ctx, axes_, keepdims_);
+    CommonReduce1Loop<ReduceAggregatorArgMax<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   }
   return Status::OK();
 }
@@ -1141,9 +1226,9 @@ Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
 template <typename T>
 Status ArgMin<T>::Compute(OpKernelContext* ctx) const {
   if (select_last_index_) {
-    CommonReduce1Loop<ReduceAggregatorArgMinLastIndex<T>>(ctx, axes_, keepdims_);
+    CommonReduce1Loop<ReduceAggregatorArgMinLastIndex<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   } else {
-    CommonReduce1Loop<ReduceAggregatorArgMin<T>>(ctx, axes_, keepdims_);
+    CommonReduce1Loop<ReduceAggregatorArgMin<T>>(ctx, axes_, keepdims_, false, &plan_cache_);
   }
   return Status::OK();
 }
@@ -1159,15 +1244,15 @@ template class ReduceSum<int64_t>;
 
 template void CommonReduce1Loop<ReduceAggregatorSum<float>>(OpKernelContext* ctx,
                                                             const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                                                            bool noop_with_empty_axes);
+                                                            bool noop_with_empty_axes, ReducePlanCache* plan_cache);
 template void CommonReduce1Loop<ReduceAggregatorSum<int32_t>>(OpKernelContext* ctx,
                                                               const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                                                              bool noop_with_empty_axes);
+                                                              bool noop_with_empty_axes, ReducePlanCache* plan_cache);
 template void CommonReduce1Loop<ReduceAggregatorSum<double>>(OpKernelContext* ctx,
                                                              const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                                                             bool noop_with_empty_axes);
+                                                             bool noop_with_empty_axes, ReducePlanCache* plan_cache);
 template void CommonReduce1Loop<ReduceAggregatorSum<int64_t>>(OpKernelContext* ctx,
                                                               const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                                                              bool noop_with_empty_axes);
+                                                              bool noop_with_empty_axes, ReducePlanCache* plan_cache);
 
 }  // namespace onnxruntime
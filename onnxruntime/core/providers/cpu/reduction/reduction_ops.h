@@ -17,6 +17,9 @@
 #include "core/providers/cpu/reduction/reduction_kernel_base.h"
 #include "core/common/safeint.h"
 #include <cmath>
+#include <list>
+#include <memory>
+#include <mutex>
 
 namespace onnxruntime {
 
@@ -88,8 +91,31 @@ class ResultsNoTransposePrepareForReduce {
     last_loop_inc = 0;
   }
 
-  bool equal(gsl::span<const int64_t> local_input_shape, gsl::span<const int64_t> local_reduced_axes);
-  void ValidateNotEmpty();
+  bool equal(gsl::span<const int64_t> local_input_shape, gsl::span<const int64_t> local_reduced_axes) const;
+  void ValidateNotEmpty() const;
+};
+
+/**
+  A small LRU cache of the plans built by NoTransposePrepareForReduce, keyed by the simplified
+  input shape and the reduced axes. Each reduce kernel owns one, so a call with a shape seen
+  recently skips the setup, which costs more than the reduction itself for small tensors.
+  Plans are immutable once cached and the cache may be used by concurrent runs.
+*/
+class ReducePlanCache {
+ public:
+  static constexpr size_t kDefaultCapacity = 8;
+
+  explicit ReducePlanCache(size_t capacity = kDefaultCapacity) : capacity_(capacity) {}
+
+  // Returns the plan for the shape and axes, built by NoTransposePrepareForReduce if not cached.
+  std::shared_ptr<const ResultsNoTransposePrepareForReduce> Get(const TensorShape& new_input_shape,
+                                                                gsl::span<const int64_t> reduced_axes);
+
+ private:
+  std::mutex mutex_;
+  // most recently used first.
+  std::list<std::shared_ptr<const ResultsNoTransposePrepareForReduce>> plans_;
+  const size_t capacity_;
 };
 
 template <typename T>
@@ -793,27 +819,42 @@ void NoTransposeReduce1Loop(Tensor* output, const TensorShape& new_input_shape,
                             gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
                             ResultsNoTransposePrepareForReduce& last_results);
 
+// Same as above with the plan taken from plan_cache.
+template <typename AGG>
+void NoTransposeReduce1Loop(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
+                            gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
+                            ReducePlanCache& plan_cache);
+
 // Specific case for ReduceLogSumExp.
 template <typename AGG>
 void NoTransposeReduce2Loops(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
                              gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
                              ResultsNoTransposePrepareForReduce& last_results);
 
+template <typename AGG>
+void NoTransposeReduce2Loops(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
+                             gsl::span<const int64_t> reduced_axes, concurrency::ThreadPool* tp,
+                             ReducePlanCache& plan_cache);
+
+// plan_cache, if not null, keeps the reduction plans across calls.
 template <typename AGG>
 void CommonReduce1Loop(OpKernelContext* ctx,
                        const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                       bool noop_with_empty_axes = false);
+                       bool noop_with_empty_axes = false, ReducePlanCache* plan_cache = nullptr);
 
 // Specific case for ReduceLogSumExp.
 template <typename AGG>
 void CommonReduce2Loops(OpKernelContext* ctx,
                         const gsl::span<const int64_t>& axes_, int64_t keepdims_,
-                        bool noop_with_empty_axes = false);
+                        bool noop_with_empty_axes = false, ReducePlanCache* plan_cache = nullptr);
 
 template <bool allow_multi_axes>
 class ReduceKernel : public OpKernel, public ReduceKernelBase<allow_multi_axes> {
  protected:
   ReduceKernel(const OpKernelInfo& info) : OpKernel(info), ReduceKernelBase<allow_multi_axes>(info) {}
+
+  // plans of the reductions not handled by a fast path, reused while the input shape repeats.
+  mutable ReducePlanCache plan_cache_;
 };
 
 template <typename T>
@@ -7,54 +7,16 @@
 
 #include "core/common/narrow.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/rnn/gru_base.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
 
 namespace onnxruntime {
 
 /// The class represents GRU operator using DeepCPU implementation for
 /// fast inference computation on CPU machines.
-class DeepCpuGruOp final : public OpKernel {
+class DeepCpuGruOp final : public OpKernel, public GRUBase {
  public:
-  DeepCpuGruOp(const OpKernelInfo& info) : OpKernel(info) {
-    // required attributes
-    std::string direction;
-    ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
-
-    int64_t int64_value;
-    ORT_ENFORCE(info.GetAttr("linear_before_reset", &int64_value).IsOK());
-    linear_before_reset_ = narrow<int>(int64_value);
-
-    ORT_ENFORCE(info.GetAttr("hidden_size", &int64_value).IsOK() && int64_value > 0);
-    hidden_size_ = narrow<int>(int64_value);
-
-    // optional attributes
-    std::vector<std::string> activation_func_names = info.GetAttrsOrDefault<std::string>("activations");
-    std::vector<float> activation_func_alphas = info.GetAttrsOrDefault<float>("activation_alpha");
-    std::vector<float> activation_func_betas = info.GetAttrsOrDefault<float>("activation_beta");
-
-    clip_ = info.GetAttrOrDefault<float>("clip", std::numeric_limits<float>::max());
-    ORT_ENFORCE(clip_ > 0.f);
-
-    direction_ = rnn::detail::MakeDirection(direction);
-    num_directions_ = direction_ == rnn::detail::Direction::kBidirectional ? 2 : 1;
-
-    if (activation_func_names.empty()) {
-      for (int i = 0; i < num_directions_; ++i) {
-        activation_func_names.emplace_back("sigmoid");
-        activation_func_names.emplace_back("tanh");
-      }
-    }
-
-    ORT_ENFORCE(activation_func_names.size() == static_cast<size_t>(num_directions_) * 2);
-
-    activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
-                                                     activation_func_alphas,
-                                                     activation_func_betas);
-
-    layout_ = info.GetAttrOrDefault("layout", static_cast<int64_t>(0));
-    ORT_ENFORCE(layout_ == 0,
-                "Batchwise recurrent operations (layout == 1) are not supported. If you need support create a github issue with justification.");
-  }
+  DeepCpuGruOp(const OpKernelInfo& info) : OpKernel(info), GRUBase(info) {}
 
   Status Compute(OpKernelContext* context) const override;
 
@@ -73,16 +35,6 @@ class DeepCpuGruOp final : public OpKernel {
 
   bool TryPackRecurrentWeights(const Tensor& weights, AllocatorPtr& alloc);
 
-  rnn::detail::Direction direction_;
-  int num_directions_;
-
-  int hidden_size_{};
-  float clip_;
-  int linear_before_reset_{};
-  int64_t layout_;
-
-  rnn::detail::ActivationFuncs activation_funcs_;
-
   // This kernel supports either forward or bidirectional
   // This is split in half for bidirectional, but we prepack it in the same buffer
   rnn::detail::PackedWeights pre_packed_input_weights_;
@@ -107,10 +59,11 @@ class UniDirectionalGru {
                     onnxruntime::concurrency::ThreadPool* ttp,
                     const bool training_mode = false);
 
+  template <typename WeightT>
   void Compute(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths, int num_directions,
-               const rnn::detail::GemmWeights<T>& input_weights,
-               const rnn::detail::GemmWeights<T>& recurrent_weights_ZR,
-               const rnn::detail::GemmWeights<T>& recurrent_weights_H,
+               const rnn::detail::GemmWeights<WeightT>& input_weights,
+               const rnn::detail::GemmWeights<WeightT>& recurrent_weights_ZR,
+               const rnn::detail::GemmWeights<WeightT>& recurrent_weights_H,
                gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
 
   // This function overloads the above one by adding two additional reference inputs that are computed in this kernel:
@@ -126,10 +79,11 @@ class UniDirectionalGru {
   ~UniDirectionalGru() = default;
 
  private:
+  template <typename WeightT>
   void ComputeImpl(gsl::span<const T> inputs, gsl::span<const int> sequence_lengths, int num_directions,
-                   const rnn::detail::GemmWeights<T>& input_weights,
-                   const rnn::detail::GemmWeights<T>& recurrent_weights_ZR,
-                   const rnn::detail::GemmWeights<T>& recurrent_weights_H,
+                   const rnn::detail::GemmWeights<WeightT>& input_weights,
+                   const rnn::detail::GemmWeights<WeightT>& recurrent_weights_ZR,
+                   const rnn::detail::GemmWeights<WeightT>& recurrent_weights_H,
                    gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
                    gsl::span<T>& zrh);
 
@@ -191,6 +145,16 @@ class UniDirectionalGru {
 
   void AllocateBuffers();
 
+  template <typename WeightT>
+  void AllocateQuantizeBuffers(int max_sequence_length);
+
+  // Buffer shared for quantized input whole, and quantized a each sequence step
+  IAllocatorUniquePtr<uint8_t> quantized_input_or_a_ptr_;
+  gsl::span<uint8_t> quantized_input_or_a_;
+
+  IAllocatorUniquePtr<int32_t> quantized_C_buffer_ptr_;
+  gsl::span<int32_t> quantized_C_buffer_;
+
   onnxruntime::concurrency::ThreadPool* ttp_;
 
   const bool training_mode_ = false;
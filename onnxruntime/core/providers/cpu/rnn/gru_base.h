@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <limits>
+
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/rnn/rnn_helpers.h"
+
+namespace onnxruntime {
+
+/// The class represents the DeepCPU implementation of a gated recurrent unit (GRU) operator, shared by the
+/// float GRU kernel and the dynamically quantized one.
+class GRUBase {
+ protected:
+  GRUBase(const OpKernelInfo& info)
+      : clip_(info.GetAttrOrDefault<float>("clip", std::numeric_limits<float>::max())),
+        layout_(info.GetAttrOrDefault("layout", static_cast<int64_t>(0))) {
+    // required attributes
+    std::string direction;
+    ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
+
+    int64_t int64_value;
+    ORT_ENFORCE(info.GetAttr("linear_before_reset", &int64_value).IsOK());
+    linear_before_reset_ = narrow<int>(int64_value);
+
+    ORT_ENFORCE(info.GetAttr("hidden_size", &int64_value).IsOK() && int64_value > 0);
+    hidden_size_ = narrow<int>(int64_value);
+
+    // optional attributes
+    std::vector<std::string> activation_func_names = info.GetAttrsOrDefault<std::string>("activations");
+    std::vector<float> activation_func_alphas = info.GetAttrsOrDefault<float>("activation_alpha");
+    std::vector<float> activation_func_betas = info.GetAttrsOrDefault<float>("activation_beta");
+    ORT_ENFORCE(clip_ > 0.f);
+
+    direction_ = rnn::detail::MakeDirection(direction);
+    num_directions_ = direction_ == rnn::detail::Direction::kBidirectional ? 2 : 1;
+
+    if (activation_func_names.empty()) {
+      for (int i = 0; i < num_directions_; ++i) {
+        activation_func_names.emplace_back("sigmoid");
+        activation_func_names.emplace_back("tanh");
+      }
+    }
+
+    ORT_ENFORCE(activation_func_names.size() == static_cast<size_t>(num_directions_) * 2);
+
+    activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
+                                                     activation_func_alphas,
+                                                     activation_func_betas);
+
+    ORT_ENFORCE(layout_ == 0,
+                "Batchwise recurrent operations (layout == 1) are not supported. If you need support create a github issue with justification.");
+  }
+
+  ~GRUBase() = default;
+
+  // The inputs are expected to be validated by the caller, the recurrent weights are split in the weights of
+  // the update and reset gates (ZR) and the ones of the hidden gate (H).
+  template <typename InputT, typename WeightT>
+  Status ComputeImpl(OpKernelContext& context,
+                     const rnn::detail::GemmWeights<WeightT>& W_1,
+                     const rnn::detail::GemmWeights<WeightT>& W_2,
+                     const rnn::detail::GemmWeights<WeightT>& R_ZR_1,
+                     const rnn::detail::GemmWeights<WeightT>& R_ZR_2,
+                     const rnn::detail::GemmWeights<WeightT>& R_H_1,
+                     const rnn::detail::GemmWeights<WeightT>& R_H_2) const;
+
+  rnn::detail::Direction direction_;
+  int num_directions_;
+
+  int hidden_size_{};
+  float clip_;
+  int linear_before_reset_{};
+  int64_t layout_;
+
+  rnn::detail::ActivationFuncs activation_funcs_;
+};
+
+}  // namespace onnxruntime
@@ -62,6 +62,7 @@ UniDirectionalLstm<T>::UniDirectionalLstm(
       clip_(clip),
       use_bias_(!bias.empty()),
       use_peepholes_(!peephole_weights.empty()),
+      fuse_iof_gates_(!use_peepholes_ && !input_forget_),
       thread_pool_(thread_pool),
       training_mode_(training_mode) {
   activation_f_ = {deepcpu::ActivationFuncByName(activation_func_f.name), activation_func_f.alpha,
@@ -103,10 +104,11 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
   }
 
   if (use_bias_) {
-    bias_WRi_ = Allocate(allocator_, hidden_size_, bias_WRi_ptr_);
-    bias_WRf_ = Allocate(allocator_, hidden_size_, bias_WRf_ptr_);
-    bias_WRo_ = Allocate(allocator_, hidden_size_, bias_WRo_ptr_);
-    bias_WRc_ = Allocate(allocator_, hidden_size_, bias_WRc_ptr_);
+    bias_WRiofc_ = Allocate(allocator_, 4 * hidden_size_, bias_WRiofc_ptr_);
+    bias_WRi_ = bias_WRiofc_.subspan(0 * hidden_size_, hidden_size_);
+    bias_WRo_ = bias_WRiofc_.subspan(1 * hidden_size_, hidden_size_);
+    bias_WRf_ = bias_WRiofc_.subspan(2 * hidden_size_, hidden_size_);
+    bias_WRc_ = bias_WRiofc_.subspan(3 * hidden_size_, hidden_size_);
   }
 
   if (direction_ == kReverse) {
@@ -497,6 +499,33 @@ void UniDirectionalLstm<T>::GateComputations(
 
     // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
 
+    if (fuse_iof_gates_) {
+      // Input, Output and Forget Gates in one pass over the 3 * hidden_size_ values starting at pi
+      const float* pBiof = use_bias_ ? SafeRawConstPointer<T>(bias_WRiofc_, 0, 3 * hidden_size_) : nullptr;
+      clip_with_bias_ptr_(clip_, pBiof, pi, 3 * hidden_size_);
+      activation_f_.func(pi, 3 * hidden_size_, activation_f_.alpha, activation_f_.beta);
+
+      // Block Gate
+      const float* pBc = use_bias_ ? SafeRawConstPointer<T>(bias_WRc_, 0, hidden_size_) : nullptr;
+      clip_with_bias_ptr_(clip_, pBc, pc, hidden_size_);
+      activation_g_.func(pc, hidden_size_, activation_g_.alpha, activation_g_.beta);
+
+      float* pC_cur = pCprev_hidden_size;
+      deepcpu::merge_lstm_gates_to_memory(pCprev_hidden_size, pi, pf, pc, pC_cur, hidden_size_);
+
+      if (training_mode_) {
+        float* pC = SafeRawPointer<T>(batched_cell_states + row * hidden_size_ + b * hidden_size_,
+                                      batched_cell_states_end, hidden_size_);
+        std::copy_n(pC_cur, hidden_size_, pC);
+      }
+
+      float* pH =
+          SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_, batched_output_end, hidden_size_);
+      float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped + b * hidden_size_, C_prev_clipped_end, hidden_size_);
+      activation_h_.func(pC_cur, pC_prev_clipped, po, pH, hidden_size_, activation_h_.alpha, activation_h_.beta);
+      continue;
+    }
+
     // Input Gate
     if (use_peepholes_) {
       deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_), pi,
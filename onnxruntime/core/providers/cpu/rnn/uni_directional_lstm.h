@@ -91,6 +91,10 @@ class UniDirectionalLstm {
   bool use_bias_;
   bool use_peepholes_;
 
+  // without peepholes and coupled input/forget gates the i, o and f gates are independent of Ct-1 and
+  // adjacent in output_iofc_, so they take one clip/bias pass and one f() call per row.
+  bool fuse_iof_gates_;
+
   int num_threads_ = -1;
 
   // output_iofc_ptr_ and output_iofc_ are not used when training_mode_ is true.
@@ -106,9 +110,11 @@ class UniDirectionalLstm {
   gsl::span<T> internal_memory_prev_, batched_internal_memory_prev_;
   gsl::span<T> batched_internal_memory_clipped_;
 
-  IAllocatorUniquePtr<T> bias_WRi_ptr_, bias_WRf_ptr_, bias_WRo_ptr_, bias_WRc_ptr_;
+  // the fused biases are stored in the iofc order of the gates, bias_WR[iofc]_ are views into bias_WRiofc_
+  IAllocatorUniquePtr<T> bias_WRiofc_ptr_;
   IAllocatorUniquePtr<T> peephole_i_ptr_, peephole_f_ptr_, peephole_o_ptr_;
   IAllocatorUniquePtr<T> inputs_reverse_ptr_, outputs_reverse_ptr_;
+  gsl::span<T> bias_WRiofc_;
   gsl::span<T> bias_WRi_, bias_WRf_, bias_WRo_, bias_WRc_;
   gsl::span<T> inputs_reverse_, outputs_reverse_;
 
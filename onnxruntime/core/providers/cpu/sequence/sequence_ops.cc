@@ -234,6 +234,14 @@ Status SequenceInsert::Compute(OpKernelContext* context) const {
   }
 
   auto* Y = context->Output<TensorSeq>(0);
+  if (input_seq_idx == num_tensors_input_seq) {
+    // Y shares the elements of S and appends to them in place, unless another consumer of S already did.
+    *Y = *S;
+    // Using DataTransferManager here allows other non-CPU EPs to use this implementation of the sequence ops
+    Y->Add(CloneTensor(*X, context, Info().GetDataTransferManager()));
+    return Status::OK();
+  }
+
   Y->SetType(S->DataType());
   Y->Reserve(SafeInt<size_t>(num_tensors_input_seq) + 1);
 
@@ -246,10 +254,6 @@ Status SequenceInsert::Compute(OpKernelContext* context) const {
       Y->Add(S->GetAt(i));
     }
   }
-  if (input_seq_idx == num_tensors_input_seq) {
-    // Using DataTransferManager here allows other non-CPU EPs to use this implementation of the sequence ops
-    Y->Add(CloneTensor(*X, context, Info().GetDataTransferManager()));
-  }
 
   return Status::OK();
 }
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/signal/dft.h"
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <functional>
@@ -100,11 +101,105 @@ static std::complex<T> compute_exponential(size_t index, const T angular_velocit
   return std::complex<T>(cos(angle), sin(angle));
 }
 
+// Twiddle factors of the radix-2 FFT of dft_length samples, ordered with the bit-reversed permutation
+template <typename T>
+static void compute_twiddle_factors(size_t dft_length, bool inverse, InlinedVector<std::complex<T>>& V) {
+  unsigned significant_bits = static_cast<unsigned>(log2(dft_length));
+  auto angular_velocity = compute_angular_velocity<T>(dft_length, inverse);
+  V.resize(dft_length);
+  for (size_t i = 0; i < dft_length; i++) {
+    size_t bit_reversed_index = bit_reverse(i, significant_bits);
+    V[bit_reversed_index] = compute_exponential(i, angular_velocity);
+  }
+}
+
+// Butterflies of the radix-2 FFT of a signal in bit-reversed order
+template <typename T>
+static void fft_radix2_butterflies(std::complex<T>* Y_data, size_t Y_data_stride, size_t dft_length,
+                                   const InlinedVector<std::complex<T>>& V) {
+  unsigned current_significant_bits = 0;
+  for (size_t i = 2; i <= dft_length; i <<= 1) {
+    size_t midpoint = i >> 1;
+    current_significant_bits++;
+
+    for (size_t k = 0; k < midpoint; k++) {
+      auto first_idx = bit_reverse(k, current_significant_bits);
+      auto second_idx = bit_reverse(midpoint + k, current_significant_bits);
+      for (size_t j = 0; j < dft_length; j += i) {
+        auto even_index = k + j;
+        auto odd_index = k + j + midpoint;
+        std::complex<T>* even = (Y_data + even_index * Y_data_stride);
+        std::complex<T>* odd = (Y_data + odd_index * Y_data_stride);
+        std::complex<T> first = *even + (V[first_idx] * *odd);
+        std::complex<T> second = *even + (V[second_idx] * *odd);
+        *even = first;
+        *odd = second;
+      }
+    }
+  }
+}
+
+// FFT of a real signal of N = dft_length samples through the complex FFT of half its length: the even and odd
+// samples are packed as the real and imaginary parts of z, and the spectrum is recovered from that of z as
+// X[k] = (Z[k] + conj(Z[N/2 - k])) / 2 - i W^k (Z[k] - conj(Z[N/2 - k])) / 2, with W = exp(-2 pi i / N).
+// The other half of the spectrum is its conjugate, and the inverse DFT of a real signal is the conjugate of the
+// forward one, scaled.
+template <typename T>
+static void fft_radix2_real(const T* X_data, size_t X_stride, size_t number_of_samples, const T* window_data,
+                            std::complex<T>* Y_data, size_t Y_stride, size_t dft_length, bool is_onesided,
+                            bool inverse, signal::DFTState<T>& state, signal::DFTScratch<T>& scratch) {
+  const size_t half_length = dft_length >> 1;
+  auto& real_V = state.real_V;
+  auto& real_W = state.real_W;
+  if (real_W.size() != half_length + 1) {
+    compute_twiddle_factors(half_length, false, real_V);
+    auto angular_velocity = compute_angular_velocity<T>(dft_length, false);
+    real_W.resize(half_length + 1);
+    for (size_t k = 0; k <= half_length; k++) {
+      real_W[k] = compute_exponential(k, angular_velocity);
+    }
+  }
+
+  auto sample = [&](size_t n) -> T {
+    if (n >= number_of_samples) {
+      return 0;
+    }
+    T x = *(X_data + n * X_stride);
+    return window_data ? x * *(window_data + n) : x;
+  };
+
+  auto& z = scratch.packed;
+  if (z.size() != half_length) {
+    z.resize(half_length);
+  }
+  unsigned significant_bits = static_cast<unsigned>(log2(half_length));
+  for (size_t i = 0; i < half_length; i++) {
+    size_t n = bit_reverse(i, significant_bits);
+    z[i] = std::complex<T>(sample(2 * n), sample(2 * n + 1));
+  }
+  fft_radix2_butterflies(z.data(), 1, half_length, real_V);
+
+  const T scale = inverse ? static_cast<T>(1) / static_cast<T>(dft_length) : static_cast<T>(1);
+  for (size_t k = 0; k <= half_length; k++) {
+    std::complex<T> z_k = z[k == half_length ? 0 : k];
+    std::complex<T> z_conj = std::conj(z[k == 0 ? 0 : half_length - k]);
+    std::complex<T> even = (z_k + z_conj) * static_cast<T>(0.5);
+    std::complex<T> odd = (z_k - z_conj) * std::complex<T>(0, static_cast<T>(-0.5));
+    std::complex<T> x_k = (even + real_W[k] * odd) * scale;
+    *(Y_data + k * Y_stride) = inverse ? std::conj(x_k) : x_k;
+  }
+  if (!is_onesided) {
+    for (size_t k = half_length + 1; k < dft_length; k++) {
+      *(Y_data + k * Y_stride) = std::conj(*(Y_data + (dft_length - k) * Y_stride));
+    }
+  }
+}
+
 template <typename T, typename U>
 static Status fft_radix2(OpKernelContext* /*ctx*/, const Tensor* X, Tensor* Y, size_t X_offset, size_t X_stride,
                          size_t Y_offset, size_t Y_stride, int64_t axis, size_t dft_length, const Tensor* window,
-                         bool is_onesided, bool inverse, InlinedVector<std::complex<T>>& V,
-                         InlinedVector<std::complex<T>>& temp_output) {
+                         bool is_onesided, bool inverse, signal::DFTState<T>& state,
+                         signal::DFTScratch<T>& scratch) {
   // Get shape and significant bits
   const auto& X_shape = X->Shape();
   size_t number_of_samples = static_cast<size_t>(X_shape[onnxruntime::narrow<size_t>(axis)]);
@@ -118,8 +213,19 @@ static Status fft_radix2(OpKernelContext* /*ctx*/, const Tensor* X, Tensor* Y, s
     window_data = const_cast<U*>(reinterpret_cast<const U*>(window->DataRaw()));
   }
 
+  if constexpr (std::is_same_v<U, T>) {
+    if (dft_length >= 2) {
+      fft_radix2_real(X_data, X_stride, number_of_samples, window_data,
+                      reinterpret_cast<std::complex<T>*>(Y->MutableDataRaw()) + Y_offset, Y_stride, dft_length,
+                      is_onesided, inverse, state, scratch);
+      return Status::OK();
+    }
+  }
+
   size_t Y_data_stride = 1;
   std::complex<T>* Y_data;
+  auto& V = state.V;
+  auto& temp_output = scratch.temp_output;
   if (is_onesided) {
     if (temp_output.size() != dft_length) {
       temp_output.resize(dft_length);
@@ -130,15 +236,9 @@ static Status fft_radix2(OpKernelContext* /*ctx*/, const Tensor* X, Tensor* Y, s
     Y_data_stride = Y_stride;
   }
 
-  auto angular_velocity = compute_angular_velocity<T>(dft_length, inverse);
-
   // Create vandermonde matrix V ordered with the bit-reversed permutation
   if (V.size() != dft_length) {
-    V.resize(dft_length);
-    for (size_t i = 0; i < dft_length; i++) {
-      size_t bit_reversed_index = bit_reverse(i, significant_bits);
-      V[bit_reversed_index] = compute_exponential(i, angular_velocity);
-    }
+    compute_twiddle_factors(dft_length, inverse, V);
   }
 
   for (size_t i = 0; i < dft_length; i++) {
@@ -149,26 +249,7 @@ static Status fft_radix2(OpKernelContext* /*ctx*/, const Tensor* X, Tensor* Y, s
   }
 
   // Run fft_radix2
-  unsigned current_significant_bits = 0;
-  for (size_t i = 2; i <= dft_length; i <<= 1) {
-    size_t midpoint = i >> 1;
-    current_significant_bits++;
-
-    for (size_t k = 0; k < midpoint; k++) {
-      auto first_idx = bit_reverse(k, current_significant_bits);
-      auto second_idx = bit_reverse(midpoint + k, current_significant_bits);
-      for (size_t j = 0; j < dft_length; j += i) {
-        auto even_index = k + j;
-        auto odd_index = k + j + midpoint;
-        std::complex<T>* even = (Y_data + even_index * Y_data_stride);
-        std::complex<T>* odd = (Y_data + odd_index * Y_data_stride);
-        std::complex<T> first = *even + (V[first_idx] * *odd);
-        std::complex<T> second = *even + (V[second_idx] * *odd);
-        *even = first;
-        *odd = second;
-      }
-    }
-  }
+  fft_radix2_butterflies(Y_data, Y_data_stride, dft_length, V);
 
   // Scale the output if inverse
   if (inverse) {
@@ -201,9 +282,9 @@ T next_power_of_2(T in) {
 
 template <typename T, typename U>
 static Status dft_bluestein_z_chirp(
-    OpKernelContext* ctx, const Tensor* X, Tensor* Y, Tensor& b_fft, Tensor& chirp, size_t X_offset, size_t X_stride, size_t Y_offset, size_t Y_stride,
-    int64_t axis, size_t dft_length, const Tensor* window, bool inverse, InlinedVector<std::complex<T>>& V,
-    InlinedVector<std::complex<T>>& temp_output) {
+    OpKernelContext* ctx, const Tensor* X, Tensor* Y, size_t X_offset, size_t X_stride, size_t Y_offset, size_t Y_stride,
+    int64_t axis, size_t dft_length, const Tensor* window, bool inverse, signal::DFTState<T>& state,
+    signal::DFTScratch<T>& scratch) {
   static constexpr T pi = static_cast<T>(M_PI);
 
   AllocatorPtr alloc;
@@ -215,10 +296,14 @@ static Status dft_bluestein_z_chirp(
   T scale = inverse ? 1.f / N : 1.f;
   T direction = inverse ? 1.f : -1.f;
 
-  bool should_recreate_b_fft = b_fft.Shape().Size() != dft_input_shape.Size();
-  bool should_recreate_chirp = chirp.Shape().Size() != dft_input_shape.Size();
-  bool should_recreate = should_recreate_b_fft || should_recreate_chirp;
+  // the chirp depends on the length and not only on the size M of the FFTs
+  Tensor& b_fft = state.b_fft;
+  Tensor& chirp = state.chirp;
+  bool should_recreate = state.chirp_length != N || state.chirp_is_inverse != inverse ||
+                         b_fft.Shape().Size() != dft_input_shape.Size();
   if (should_recreate) {
+    state.chirp_length = N;
+    state.chirp_is_inverse = inverse;
     auto b = onnxruntime::Tensor(X->DataType(), dft_input_shape, alloc);
     b_fft = onnxruntime::Tensor(Y->DataType(), dft_input_shape, alloc);
     chirp = onnxruntime::Tensor(X->DataType(), dft_input_shape, alloc);
@@ -250,7 +335,7 @@ static Status dft_bluestein_z_chirp(
     // Forward FFT radix2 for the "b" signal
     // This will be cached and reused!
     ORT_RETURN_IF_ERROR((fft_radix2<T, std::complex<T>>(ctx, &b, &b_fft, 0, 1, 0, 1, 1, M, nullptr,
-                                                        false, false, V, temp_output)));
+                                                        false, false, state, scratch)));
   }
 
   // Get data
@@ -261,8 +346,12 @@ static Status dft_bluestein_z_chirp(
     window_data = const_cast<U*>(reinterpret_cast<const U*>(window->DataRaw()));
   }
 
-  auto a = onnxruntime::Tensor(X->DataType(), dft_input_shape, alloc);
-  auto a_fft = onnxruntime::Tensor(Y->DataType(), dft_input_shape, alloc);
+  if (scratch.a.Shape().Size() != dft_input_shape.Size()) {
+    scratch.a = onnxruntime::Tensor(X->DataType(), dft_input_shape, alloc);
+    scratch.a_fft = onnxruntime::Tensor(Y->DataType(), dft_input_shape, alloc);
+  }
+  Tensor& a = scratch.a;
+  Tensor& a_fft = scratch.a_fft;
   std::complex<T>* a_data = reinterpret_cast<std::complex<T>*>(a.MutableDataRaw());
   std::complex<T>* a_fft_data = reinterpret_cast<std::complex<T>*>(a_fft.MutableDataRaw());
   std::complex<T>* b_fft_data = reinterpret_cast<std::complex<T>*>(b_fft.MutableDataRaw());
@@ -284,7 +373,7 @@ static Status dft_bluestein_z_chirp(
 
   // Forward FFT radix2 for the "a" signal
   ORT_RETURN_IF_ERROR((fft_radix2<T, std::complex<T>>(ctx, &a, &a_fft, 0, 1, 0, 1, 1, M, nullptr,
-                                                      false, false, V, temp_output)));
+                                                      false, false, state, scratch)));
 
   for (size_t i = 0; i < M; i++) {
     std::complex<T>& a_i = *(a_fft_data + i);
@@ -294,7 +383,7 @@ static Status dft_bluestein_z_chirp(
 
   // Inverse FFT radix2 for the "a" signal
   ORT_RETURN_IF_ERROR((fft_radix2<T, std::complex<T>>(ctx, &a_fft, &a, 0, 1, 0, 1, 1, M, nullptr,
-                                                      false, true, V, temp_output)));
+                                                      false, true, state, scratch)));
   const auto& Y_shape = Y->Shape();
   size_t dft_output_size = static_cast<size_t>(Y_shape[onnxruntime::narrow<size_t>(axis)]);
 
@@ -313,11 +402,47 @@ static Status dft_bluestein_z_chirp(
   return Status::OK();
 }
 
+// Approximate cost of a DFT: a radix-2 FFT of its length, or the three FFTs of Bluestein's algorithm.
+static double dft_cost(size_t dft_length) {
+  const bool is_radix2 = is_power_of_2(dft_length);
+  const double fft_length = static_cast<double>(is_radix2 ? dft_length : next_power_of_2(2 * dft_length - 1));
+  return (is_radix2 ? 1.0 : 3.0) * 4.0 * fft_length * std::max(std::log2(fft_length), 1.0);
+}
+
+// Runs run_dft(i, scratch) for i in [0, count). The first DFT runs on the calling thread with the cached scratch
+// buffers, as it creates the twiddle factors and the chirp that the others only read. The others run in parallel,
+// each block of them with its own scratch buffers.
+template <typename T, typename RunDFT>
+static Status run_dfts(concurrency::ThreadPool* thread_pool, size_t count, double cost_per_dft,
+                       signal::DFTScratch<T>& scratch, RunDFT&& run_dft) {
+  if (count == 0) {
+    return Status::OK();
+  }
+  ORT_RETURN_IF_ERROR(run_dft(0, scratch));
+
+  if (concurrency::ThreadPool::DegreeOfParallelism(thread_pool) == 1) {
+    for (size_t i = 1; i < count; i++) {
+      ORT_RETURN_IF_ERROR(run_dft(i, scratch));
+    }
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(count - 1), cost_per_dft,
+      [&run_dft](std::ptrdiff_t first, std::ptrdiff_t last) {
+        signal::DFTScratch<T> block_scratch;
+        for (std::ptrdiff_t i = first; i < last; i++) {
+          ORT_THROW_IF_ERROR(run_dft(static_cast<size_t>(i) + 1, block_scratch));
+        }
+      });
+  return Status::OK();
+}
+
 template <typename T, typename U>
-static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X, Tensor* Y, Tensor& b_fft, Tensor& chirp,
-                                         int64_t axis, int64_t dft_length, const Tensor* window, bool is_onesided, bool inverse,
-                                         InlinedVector<std::complex<T>>& V,
-                                         InlinedVector<std::complex<T>>& temp_output) {
+static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X, Tensor* Y, int64_t axis,
+                                         int64_t dft_length, const Tensor* window, bool is_onesided, bool inverse,
+                                         signal::DFTState<T>& state, signal::DFTScratch<T>& scratch,
+                                         concurrency::ThreadPool* thread_pool) {
   // Get shape
   const auto& X_shape = X->Shape();
   const auto& Y_shape = Y->Shape();
@@ -332,8 +457,17 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
     batch_and_signal_rank -= 1;
   }
 
+  // The radix-2 FFT uses the twiddle factors of its direction. Bluestein's algorithm uses those of the forward FFT
+  // for both of its FFTs and undoes the reversal of the inverse one.
+  const bool is_radix2 = is_power_of_2(onnxruntime::narrow<size_t>(dft_length));
+  const bool V_is_inverse = is_radix2 && inverse;
+  if (state.V_is_inverse != V_is_inverse) {
+    state.V.clear();
+    state.V_is_inverse = V_is_inverse;
+  }
+
   // Calculate x/y offsets/strides
-  for (size_t i = 0; i < total_dfts; i++) {
+  auto run_dft = [&](size_t i, signal::DFTScratch<T>& dft_scratch) -> Status {
     size_t X_offset = 0;
     size_t X_stride = onnxruntime::narrow<size_t>(X_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1) / complex_input_factor);
     size_t cumulative_packed_stride = total_dfts;
@@ -362,19 +496,18 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
       Y_offset += index * SafeInt<size_t>(Y_shape.SizeFromDimension(r + 1)) / 2;
     }
 
-    if (is_power_of_2(onnxruntime::narrow<size_t>(dft_length))) {
-      ORT_RETURN_IF_ERROR((fft_radix2<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window,
-                                            is_onesided, inverse, V, temp_output)));
-    } else {
-      ORT_RETURN_IF_ERROR(
-          (dft_bluestein_z_chirp<T, U>(ctx, X, Y, b_fft, chirp, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window, inverse, V, temp_output)));
+    if (is_radix2) {
+      return fft_radix2<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window,
+                              is_onesided, inverse, state, dft_scratch);
     }
-  }
+    return dft_bluestein_z_chirp<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window, inverse, state, dft_scratch);
+  };
 
-  return Status::OK();
+  return run_dfts(thread_pool, total_dfts, dft_cost(onnxruntime::narrow<size_t>(dft_length)), scratch, run_dft);
 }
 
-static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, bool is_onesided, bool inverse) {
+static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, bool is_onesided, bool inverse,
+                                         signal::DFTStateCache& state_cache) {
   // Get input shape
   const auto* X = ctx->Input<Tensor>(0);
   const auto* dft_length = ctx->Input<Tensor>(1);
@@ -407,18 +540,17 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, boo
 
   // Get data type
   auto data_type = X->DataType();
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
-  Tensor b_fft, chirp;
   auto element_size = data_type->Size();
   if (element_size == sizeof(float)) {
-    InlinedVector<std::complex<float>> V;
-    InlinedVector<std::complex<float>> temp_output;
+    auto state = state_cache.Take<float>();
     if (is_real_valued) {
-      ORT_RETURN_IF_ERROR((discrete_fourier_transform<float, float>(ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr,
-                                                                    is_onesided, inverse, V, temp_output)));
+      ORT_RETURN_IF_ERROR((discrete_fourier_transform<float, float>(
+          ctx, X, Y, axis, number_of_samples, nullptr, is_onesided, inverse, state, state.scratch, thread_pool)));
     } else if (is_complex_valued) {
       ORT_RETURN_IF_ERROR((discrete_fourier_transform<float, std::complex<float>>(
-          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, V, temp_output)));
+          ctx, X, Y, axis, number_of_samples, nullptr, is_onesided, inverse, state, state.scratch, thread_pool)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimension must be the batch dimension and its second "
@@ -426,15 +558,15 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, boo
           "complex inputs.",
           data_type);
     }
+    state_cache.Put(std::move(state));
   } else if (element_size == sizeof(double)) {
-    InlinedVector<std::complex<double>> V;
-    InlinedVector<std::complex<double>> temp_output;
+    auto state = state_cache.Take<double>();
     if (is_real_valued) {
-      ORT_RETURN_IF_ERROR((discrete_fourier_transform<double, double>(ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr,
-                                                                      is_onesided, inverse, V, temp_output)));
+      ORT_RETURN_IF_ERROR((discrete_fourier_transform<double, double>(
+          ctx, X, Y, axis, number_of_samples, nullptr, is_onesided, inverse, state, state.scratch, thread_pool)));
     } else if (is_complex_valued) {
       ORT_RETURN_IF_ERROR((discrete_fourier_transform<double, std::complex<double>>(
-          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, V, temp_output)));
+          ctx, X, Y, axis, number_of_samples, nullptr, is_onesided, inverse, state, state.scratch, thread_pool)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimension must be the batch dimension and its second "
@@ -442,6 +574,7 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, boo
           "complex inputs.",
           data_type);
     }
+    state_cache.Put(std::move(state));
   } else {
     ORT_THROW("Unsupported input data type of ", data_type);
   }
@@ -456,12 +589,13 @@ Status DFT::Compute(OpKernelContext* ctx) const {
     axis = axes_tensor->Data<int64_t>()[0];
   }
 
-  ORT_RETURN_IF_ERROR(discrete_fourier_transform(ctx, axis, is_onesided_, is_inverse_));
+  ORT_RETURN_IF_ERROR(discrete_fourier_transform(ctx, axis, is_onesided_, is_inverse_, state_cache_));
   return Status::OK();
 }
 
 template <typename T, typename U>
-static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_onesided, bool /*inverse*/) {
+static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_onesided, bool /*inverse*/,
+                                           signal::DFTStateCache& state_cache) {
   // Attr("onesided"): default = 1
   // Input(0, "signal") type = T1
   // Input(1, "frame_length") type = T2
@@ -529,30 +663,32 @@ static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_oneside
   auto dft_input_shape = onnxruntime::TensorShape({1, window_size, signal_components});
   auto dft_output_shape = onnxruntime::TensorShape({1, dft_output_size, output_components});
 
-  Tensor b_fft, chirp;
-  InlinedVector<std::complex<T>> V;
-  InlinedVector<std::complex<T>> temp_output;
+  auto state = state_cache.Take<T>();
 
-  // Run each dft of each batch as if it was a real-valued batch size 1 dft operation
-  for (int64_t batch_idx = 0; batch_idx < batch_size; batch_idx++) {
-    for (int64_t i = 0; i < n_dfts; i++) {
-      auto input_frame_begin =
-          signal_data + (batch_idx * signal_size * signal_components) + (i * frame_step * signal_components);
+  // Run each dft of each batch as if it was a real-valued batch size 1 dft operation, the frames of all the batches
+  // in parallel
+  auto run_frame = [&](size_t frame, signal::DFTScratch<T>& scratch) -> Status {
+    const int64_t batch_idx = static_cast<int64_t>(frame) / n_dfts;
+    const int64_t i = static_cast<int64_t>(frame) % n_dfts;
+    auto input_frame_begin =
+        signal_data + (batch_idx * signal_size * signal_components) + (i * frame_step * signal_components);
 
-      auto output_frame_begin = Y_data + (batch_idx * n_dfts * dft_output_size * output_components) +
-                                (i * dft_output_size * output_components);
+    auto output_frame_begin = Y_data + (batch_idx * n_dfts * dft_output_size * output_components) +
+                              (i * dft_output_size * output_components);
 
-      // Tensors do not own the backing memory, so no worries on destruction
-      auto input = onnxruntime::Tensor(signal->DataType(), dft_input_shape, input_frame_begin, signal->Location(), 0);
+    // Tensors do not own the backing memory, so no worries on destruction
+    auto input = onnxruntime::Tensor(signal->DataType(), dft_input_shape, input_frame_begin, signal->Location(), 0);
 
-      auto output = onnxruntime::Tensor(Y->DataType(), dft_output_shape, output_frame_begin, Y->Location(), 0);
+    auto output = onnxruntime::Tensor(Y->DataType(), dft_output_shape, output_frame_begin, Y->Location(), 0);
 
-      // Run individual dft
-      ORT_RETURN_IF_ERROR((discrete_fourier_transform<T, U>(ctx, &input, &output, b_fft, chirp, 1, window_size, window, is_onesided,
-                                                            false, V, temp_output)));
-    }
-  }
+    // Run individual dft
+    return discrete_fourier_transform<T, U>(ctx, &input, &output, 1, window_size, window, is_onesided, false, state,
+                                            scratch, nullptr);
+  };
+  ORT_RETURN_IF_ERROR(run_dfts(ctx->GetOperatorThreadPool(), onnxruntime::narrow<size_t>(batch_size * n_dfts),
+                               dft_cost(onnxruntime::narrow<size_t>(window_size)), state.scratch, run_frame));
 
+  state_cache.Put(std::move(state));
   return Status::OK();
 }
 
@@ -576,9 +712,9 @@ Status STFT::Compute(OpKernelContext* ctx) const {
   const auto element_size = data_type->Size();
   if (element_size == sizeof(float)) {
     if (is_real_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, float>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, float>(ctx, is_onesided_, false, state_cache_)));
     } else if (is_complex_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, std::complex<float>>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<float, std::complex<float>>(ctx, is_onesided_, false, state_cache_)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimenstion must be the batch dimension and its second "
@@ -588,9 +724,9 @@ Status STFT::Compute(OpKernelContext* ctx) const {
     }
   } else if (element_size == sizeof(double)) {
     if (is_real_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, double>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, double>(ctx, is_onesided_, false, state_cache_)));
     } else if (is_complex_valued) {
-      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, std::complex<double>>(ctx, is_onesided_, false)));
+      ORT_RETURN_IF_ERROR((short_time_fourier_transform<double, std::complex<double>>(ctx, is_onesided_, false, state_cache_)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimenstion must be the batch dimension and its second "
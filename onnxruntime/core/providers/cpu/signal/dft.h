@@ -1,16 +1,91 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#pragma once
+
+#include <complex>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
 
+namespace signal {
+
+// Buffers of a single DFT, one set per thread running DFTs.
+template <typename T>
+struct DFTScratch {
+  InlinedVector<std::complex<T>> temp_output;
+  InlinedVector<std::complex<T>> packed;  // the real signal packed as a complex signal of half its length
+  Tensor a;                               // Bluestein's algorithm: the buffers of the convolution
+  Tensor a_fft;
+};
+
+// Twiddle factors and scratch buffers of the DFTs of one length. They only depend on the length and the direction
+// of the transform, so they are reused by every frame of STFT and by the following runs of the node.
+// The twiddle factors and the chirp are created by the first DFT of a run and only read by the others, which may
+// run in parallel with their own scratch buffers.
+template <typename T>
+struct DFTState {
+  InlinedVector<std::complex<T>> V;  // radix-2 twiddle factors in bit-reversed order
+  bool V_is_inverse = false;
+
+  // real signals: the forward twiddle factors of the FFT of half the length in bit-reversed order, and those
+  // recovering the spectrum of the signal from the FFT of its packed form
+  InlinedVector<std::complex<T>> real_V;
+  InlinedVector<std::complex<T>> real_W;
+
+  // Bluestein's algorithm: the chirp of chirp_length samples and the FFT of its conjugate
+  size_t chirp_length = 0;
+  bool chirp_is_inverse = false;
+  Tensor chirp;
+  Tensor b_fft;
+
+  DFTScratch<T> scratch;  // the buffers of the calling thread
+};
+
+class DFTStateCache {
+ public:
+  // Returns the cached state, or an empty one while another run of the node is using it.
+  template <typename T>
+  DFTState<T> Take() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::exchange(Get<T>(), DFTState<T>{});
+  }
+
+  template <typename T>
+  void Put(DFTState<T>&& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Get<T>() = std::move(state);
+  }
+
+ private:
+  template <typename T>
+  DFTState<T>& Get() {
+    if constexpr (std::is_same_v<T, float>) {
+      return float_state_;
+    } else {
+      return double_state_;
+    }
+  }
+
+  std::mutex mutex_;
+  DFTState<float> float_state_;
+  DFTState<double> double_state_;
+};
+
+}  // namespace signal
+
 class DFT final : public OpKernel {
   int opset_;
   bool is_onesided_ = true;
   int64_t axis_ = 0;
   bool is_inverse_ = false;
+  mutable signal::DFTStateCache state_cache_;
 
  public:
   explicit DFT(const OpKernelInfo& info) : OpKernel(info) {
@@ -27,6 +102,7 @@ class DFT final : public OpKernel {
 
 class STFT final : public OpKernel {
   bool is_onesided_ = true;
+  mutable signal::DFTStateCache state_cache_;
 
  public:
   explicit STFT(const OpKernelInfo& info) : OpKernel(info) {
@@ -3,11 +3,15 @@
 
 // https://github.com/onnx/onnx/blob/main/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
+
+#include <algorithm>
+
 #include "core/common/common.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/gather_rows.h"
 #include "core/providers/op_kernel_type_control.h"
 
 namespace onnxruntime {
@@ -86,7 +90,7 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
-                      const int64_t N, const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
+                      const int64_t N, const int64_t data_batch_bytes,
                       const TensorShape& input_data_shape, const int64_t axis, concurrency::ThreadPool* tp) {
   const Tin* indices_data = indices_tensor->Data<Tin>();
 
@@ -102,30 +106,63 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
-  auto lambda = [&](int64_t index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
+  const TensorOpCost cost{static_cast<double>(block_size), static_cast<double>(block_size), 1.0};
+
+  if (is_string_type) {
+    const int64_t block = block_size / narrow<int64_t>(element_bytes);
+    const auto* src_strings = reinterpret_cast<const std::string*>(src_base);
+    auto* dst_strings = reinterpret_cast<std::string*>(dst_base);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, SafeInt<ptrdiff_t>(M) * N, cost, [&](ptrdiff_t first, ptrdiff_t last) {
+          for (ptrdiff_t index = first; index < last; ++index) {
+            const int64_t batch = index / N;
+            Tin idx = indices_data[index % N];
+            idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
+            const auto* src = src_strings + batch * (data_batch_bytes / narrow<int64_t>(element_bytes)) + idx * block;
+            std::copy(src, src + block, dst_strings + index * block);
+          }
+        });
+    return Status::OK();
+  }
 
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, narrow<size_t>(block_size));
-    }
-  };
-  concurrency::ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(M) * N, static_cast<double>(block_size),
-                                          [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int index = static_cast<int>(first), end = static_cast<int>(last); index < end; ++index) {
-                                              lambda(index);
-                                            }
-                                          });
+  // The rows are copied in the order of the output, and the row kGatherPrefetchDistance ahead is prefetched so the
+  // cache misses on a large table overlap.
+  DispatchOnRowBytes(narrow<size_t>(block_size), [&](auto fixed_row_bytes) {
+    constexpr size_t kRowBytes = decltype(fixed_row_bytes)::value;
+    const size_t row_bytes = kRowBytes != 0 ? kRowBytes : narrow<size_t>(block_size);
+
+    auto src_row = [&](int64_t batch, int64_t i) {
+      Tin idx = indices_data[i];
+      idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
+      return src_base + batch * data_batch_bytes + idx * block_size;
+    };
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, SafeInt<ptrdiff_t>(M) * N, cost, [&](ptrdiff_t first, ptrdiff_t last) {
+          int64_t batch = first / N;
+          int64_t i = first % N;
+          ptrdiff_t ahead = std::min<ptrdiff_t>(first + kGatherPrefetchDistance, last);
+          int64_t ahead_batch = ahead / N;
+          int64_t ahead_i = ahead % N;
+          for (ptrdiff_t index = first; index < last; ++index) {
+            if (ahead < last) {
+              PrefetchRowForRead(src_row(ahead_batch, ahead_i), row_bytes);
+              ++ahead;
+              if (++ahead_i == N) {
+                ahead_i = 0;
+                ++ahead_batch;
+              }
+            }
+
+            // the gathered rows of a batch are contiguous, so the destination is the index-th row of the output
+            memcpy(dst_base + index * block_size, src_row(batch, i), row_bytes);
+            if (++i == N) {
+              i = 0;
+              ++batch;
+            }
+          }
+        });
+  });
 
   return Status::OK();
 }
@@ -144,7 +181,6 @@ Status Gather::Compute(OpKernelContext* context) const {
   const int64_t M = input_data_shape.SizeToDimension(narrow<size_t>(p.axis));
   const int64_t N = p.indices_tensor->Shape().Size();
   const int64_t data_batch_bytes = input_data_shape.SizeFromDimension(narrow<size_t>(p.axis)) * element_bytes;
-  const int64_t gathered_batch_bytes = N * block * SafeInt<int64_t>(element_bytes);
 
   const auto* src_base = static_cast<const uint8_t*>(p.input_tensor->DataRaw());
   auto* dst_base = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
@@ -154,12 +190,12 @@ Status Gather::Compute(OpKernelContext* context) const {
   if (utils::HasType<EnabledIndexTypes, int32_t>() &&
       p.indices_tensor->IsDataType<int32_t>()) {
     return GatherCopyData<int32_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis, tp);
+                                   block_size, M, N, data_batch_bytes, input_data_shape, p.axis, tp);
   }
   if (utils::HasType<EnabledIndexTypes, int64_t>() &&
       p.indices_tensor->IsDataType<int64_t>()) {
     return GatherCopyData<int64_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis, tp);
+                                   block_size, M, N, data_batch_bytes, input_data_shape, p.axis, tp);
   }
 
   return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Gather Tind type not supported in this build.");
@@ -3,6 +3,7 @@
 #include <core/common/safeint.h>
 #include "gather_nd.h"
 #include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/gather_rows.h"
 
 namespace onnxruntime {
 
@@ -106,7 +107,7 @@ Status GatherNDBase::PrepareForCompute(const TensorShape& input_shape, const Ten
   concurrency::ThreadPool::TryParallelFor(
       tp, onnxruntime::narrow<size_t>(num_slices), static_cast<double>(num_slice_dims),
       [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
+        for (ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
           lambda(slice_idx);
         }
       });
@@ -177,17 +178,29 @@ Status GatherND::Compute(OpKernelContext* context) const {
 }
 
 Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
-  auto lambda = [&](int64_t slice_idx) {
-    memcpy(p.output_base + slice_idx * p.bytes_per_slice, p.input_base + p.slice_offsets[onnxruntime::narrow<size_t>(slice_idx)] * p.element_bytes,
-           onnxruntime::narrow<size_t>(p.bytes_per_slice));
-  };
-  concurrency::ThreadPool::TryParallelFor(
-      tp, p.slice_offsets.size(), static_cast<double>(p.bytes_per_slice),
-      [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
-          lambda(slice_idx);
-        }
-      });
+  const int64_t bytes_per_slice = static_cast<int64_t>(p.bytes_per_slice);
+  const ptrdiff_t num_slices = static_cast<ptrdiff_t>(p.slice_offsets.size());
+  const TensorOpCost cost{static_cast<double>(bytes_per_slice), static_cast<double>(bytes_per_slice), 1.0};
+
+  // the slice kGatherPrefetchDistance ahead of the copy is prefetched so the cache misses on a large input overlap
+  DispatchOnRowBytes(onnxruntime::narrow<size_t>(bytes_per_slice), [&](auto fixed_slice_bytes) {
+    constexpr size_t kSliceBytes = decltype(fixed_slice_bytes)::value;
+    const size_t slice_bytes = kSliceBytes != 0 ? kSliceBytes : onnxruntime::narrow<size_t>(bytes_per_slice);
+    auto src_slice = [&](ptrdiff_t slice_idx) {
+      return p.input_base + p.slice_offsets[static_cast<size_t>(slice_idx)] * p.element_bytes;
+    };
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_slices, cost, [&](ptrdiff_t first, ptrdiff_t last) {
+          for (ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
+            if (slice_idx + kGatherPrefetchDistance < last) {
+              PrefetchRowForRead(src_slice(slice_idx + kGatherPrefetchDistance), slice_bytes);
+            }
+            memcpy(p.output_base + slice_idx * bytes_per_slice, src_slice(slice_idx), slice_bytes);
+          }
+        });
+  });
+
   return Status::OK();
 }
 
@@ -201,7 +214,7 @@ Status GatherND::GatherString(const Prepare& p, concurrency::ThreadPool* tp) con
   concurrency::ThreadPool::TryParallelFor(
       tp, p.slice_offsets.size(), static_cast<double>(p.element_count_per_slice),
       [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
+        for (ptrdiff_t slice_idx = first; slice_idx < last; ++slice_idx) {
           lambda(slice_idx);
         }
       });
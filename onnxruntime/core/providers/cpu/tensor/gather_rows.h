@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "core/common/common.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace onnxruntime {
+
+// Helpers for the CPU kernels that copy rows of the data from offsets given by indices (Gather, GatherND).
+// A large table, like an embedding, doesn't fit in the cache, so those gathers wait on a cache miss for every row.
+// Prefetching the rows a few iterations ahead of the copy overlaps the misses.
+
+// How many rows ahead of the copy the rows are prefetched.
+constexpr ptrdiff_t kGatherPrefetchDistance = 8;
+
+// Only the start of longer rows is prefetched, the hardware prefetcher follows the sequential copy of the rest.
+constexpr size_t kGatherMaxPrefetchBytes = 256;
+
+inline void PrefetchRowForRead(const void* row, size_t row_bytes) {
+  constexpr size_t kCacheLineBytes = 64;
+  const auto* address = static_cast<const char*>(row);
+  const size_t prefetch_bytes = std::min(row_bytes, kGatherMaxPrefetchBytes);
+  for (size_t offset = 0; offset < prefetch_bytes; offset += kCacheLineBytes) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(address + offset, _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address + offset);
+#else
+    ORT_UNUSED_PARAMETER(address);
+#endif
+  }
+}
+
+// Calls fn(std::integral_constant<size_t, kRowBytes>{}) with kRowBytes equal to row_bytes for the common small row
+// sizes and 0 otherwise, so that a memcpy of the rows compiles to a few vector moves when the size is known.
+template <typename Fn>
+void DispatchOnRowBytes(size_t row_bytes, Fn&& fn) {
+  switch (row_bytes) {
+    case 4:
+      fn(std::integral_constant<size_t, 4>{});
+      break;
+    case 8:
+      fn(std::integral_constant<size_t, 8>{});
+      break;
+    case 16:
+      fn(std::integral_constant<size_t, 16>{});
+      break;
+    case 32:
+      fn(std::integral_constant<size_t, 32>{});
+      break;
+    case 64:
+      fn(std::integral_constant<size_t, 64>{});
+      break;
+    case 128:
+      fn(std::integral_constant<size_t, 128>{});
+      break;
+    case 256:
+      fn(std::integral_constant<size_t, 256>{});
+      break;
+    case 512:
+      fn(std::integral_constant<size_t, 512>{});
+      break;
+    default:
+      fn(std::integral_constant<size_t, 0>{});
+      break;
+  }
+}
+
+}  // namespace onnxruntime
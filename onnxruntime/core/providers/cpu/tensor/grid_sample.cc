@@ -109,22 +109,26 @@ T GsBicubicInterpolate(T p[4][4], T x, T y) {
 }
 
 template <typename T>
-T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const {
-  T pixel = {};  // default 0
+int64_t GridSample<T>::IndexAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const {
   if (padding_mode_ == Zeros) {
     if (c >= 0 && c < W && r >= 0 && r < H) {
-      pixel = image[r * W + c];
+      return r * W + c;
     }
+    return -1;
   } else if (padding_mode_ == Border) {
     c = std::clamp<int64_t>(c, 0, W - 1);
     r = std::clamp<int64_t>(r, 0, H - 1);
-    pixel = image[r * W + c];
   } else {  // (padding_mode_ == Reflection)
     c = static_cast<int64_t>(GsReflect(static_cast<T>(c), border[0], border[2]));
     r = static_cast<int64_t>(GsReflect(static_cast<T>(r), border[1], border[3]));
-    pixel = image[r * W + c];
   }
-  return pixel;
+  return r * W + c;
+}
+
+template <typename T>
+T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const {
+  const int64_t index = IndexAtGrid(r, c, H, W, border);
+  return index >= 0 ? image[index] : T{};  // default 0
 }
 
 template <typename T>
@@ -210,6 +214,76 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
     T border[] = {x_min, y_min, x_max, y_max};  // l-t-r-b
 
     concurrency::ThreadPool* tp = H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
+
+    if (mode_ != Cubic) {
+      // The input pixels and weights of a grid point are the same in every channel. They are computed once per grid
+      // point into tables, one table per tap, and the channels only gather and blend the pixels. An index of -1 is a
+      // zero padding pixel.
+      const int64_t grid_size = H_out * W_out;
+      const int64_t taps = mode_ == Linear ? 4 : 1;
+      std::vector<int64_t> indices(onnxruntime::narrow<size_t>(taps * grid_size));
+      std::vector<T> weights(onnxruntime::narrow<size_t>(taps * grid_size));
+
+      for (int64_t n = 0; n < N; n++) {
+        const T* grid_data = grid->Data<T>() + n * grid_size * 2;
+        concurrency::ThreadPool::TrySimpleParallelFor(
+            tp, onnxruntime::narrow<std::ptrdiff_t>(H_out),
+            [&](std::ptrdiff_t oy) {
+              for (int64_t ox = 0; ox < W_out; ox++) {
+                const int64_t i = oy * W_out + ox;
+                const T* gridpoint = grid_data + i * 2;
+                auto x = GsDenormalize<T>(gridpoint[0], W_in, align_corners_);  // actual location
+                auto y = GsDenormalize<T>(gridpoint[1], H_in, align_corners_);
+
+                if (mode_ == Nearest) {
+                  x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
+                  y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
+                  indices[i] = IndexAtGrid(static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
+                  weights[i] = 1;
+                } else {
+                  int64_t x1 = static_cast<int64_t>(std::floor(x));
+                  int64_t y1 = static_cast<int64_t>(std::floor(y));
+                  int64_t x2 = x1 + 1;
+                  int64_t y2 = y1 + 1;
+                  T dx2 = static_cast<T>(x2) - x;
+                  T dx1 = x - static_cast<T>(x1);
+                  T dy2 = static_cast<T>(y2) - y;
+                  T dy1 = y - static_cast<T>(y1);
+
+                  indices[i] = IndexAtGrid(y1, x1, H_in, W_in, border);
+                  indices[grid_size + i] = IndexAtGrid(y1, x2, H_in, W_in, border);
+                  indices[2 * grid_size + i] = IndexAtGrid(y2, x1, H_in, W_in, border);
+                  indices[3 * grid_size + i] = IndexAtGrid(y2, x2, H_in, W_in, border);
+                  weights[i] = dy2 * dx2;
+                  weights[grid_size + i] = dy2 * dx1;
+                  weights[2 * grid_size + i] = dy1 * dx2;
+                  weights[3 * grid_size + i] = dy1 * dx1;
+                }
+              }
+            });
+
+        concurrency::ThreadPool::TrySimpleParallelFor(
+            tp, onnxruntime::narrow<std::ptrdiff_t>(C),
+            [&](std::ptrdiff_t c) {
+              const T* X_data = input->Data<T>() + (n * C + c) * (H_in * W_in);
+              T* Y_data = Y.MutableData<T>() + (n * C + c) * grid_size;
+
+              for (int64_t i = 0; i < grid_size; i++) {
+                T value = {};
+                for (int64_t k = 0; k < taps; k++) {
+                  const int64_t index = indices[k * grid_size + i];
+                  if (index >= 0) {
+                    value += weights[k * grid_size + i] * X_data[index];
+                  }
+                }
+                Y_data[i] = value;
+              }
+            });
+      }
+
+      return Status::OK();
+    }
+
     for (int64_t n = 0; n < N; n++) {
       const T* grid_data = grid->Data<T>() + n * (H_out * W_out) * 2;
       concurrency::ThreadPool::TrySimpleParallelFor(
@@ -227,41 +301,19 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
                 auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
                 auto y = GsDenormalize<T>(ny, H_in, align_corners_);
 
-                if (mode_ == Nearest) {
-                  x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
-                  y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
-                  // x, y are integers in all padding modes
-                  *Y_gridpoint = PixelAtGrid(X_data, static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
-                } else if (mode_ == Linear) {
-                  int64_t x1 = static_cast<int64_t>(std::floor(x));
-                  int64_t y1 = static_cast<int64_t>(std::floor(y));
-                  int64_t x2 = x1 + 1;
-                  int64_t y2 = y1 + 1;
+                // bicubic, the other modes use the tables above
+                int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
+                int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
 
-                  T p11 = PixelAtGrid(X_data, y1, x1, H_in, W_in, border);
-                  T p12 = PixelAtGrid(X_data, y1, x2, H_in, W_in, border);
-                  T p21 = PixelAtGrid(X_data, y2, x1, H_in, W_in, border);
-                  T p22 = PixelAtGrid(X_data, y2, x2, H_in, W_in, border);
-
-                  T dx2 = static_cast<T>(x2) - x;
-                  T dx1 = x - static_cast<T>(x1);
-                  T dy2 = static_cast<T>(y2) - y;
-                  T dy1 = y - static_cast<T>(y1);
-                  *Y_gridpoint = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
-                } else if (mode_ == Cubic) {
-                  int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
-                  int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
-
-                  T p[4][4] = {};  // [H][W]
-                  for (int64_t h = 0; h < 4; h++) {
-                    for (int64_t w = 0; w < 4; w++) {
-                      p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
-                    }
+                T p[4][4] = {};  // [H][W]
+                for (int64_t h = 0; h < 4; h++) {
+                  for (int64_t w = 0; w < 4; w++) {
+                    p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
                   }
-                  T dx = static_cast<T>(x - x0 - 1);
-                  T dy = static_cast<T>(y - y0 - 1);
-                  *Y_gridpoint = GsBicubicInterpolate(p, dx, dy);
                 }
+                T dx = static_cast<T>(x - x0 - 1);
+                T dy = static_cast<T>(y - y0 - 1);
+                *Y_gridpoint = GsBicubicInterpolate(p, dx, dy);
               }
             }
           });
@@ -68,6 +68,8 @@ class GridSample final : public OpKernel {
     Reflection
   };
 
+  // Offset of the pixel at row r and column c after padding, or -1 if it is a zero padding pixel.
+  int64_t IndexAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const;
   T PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const;
   T PixelAtGrid3D(const T* image, int64_t d, int64_t h, int64_t w, int64_t D, int64_t H, int64_t W, T border[/* 6 */]) const;
 
@@ -3,10 +3,10 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
-#include <vector>
-#include <core/common/safeint.h>
-#include "core/util/math_cpuonly.h"
+
+#include "core/util/parallel_scan.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -51,6 +51,11 @@ NONZERO_TYPED_KERNEL(float)
 #undef NONZERO_9_TYPED_KERNEL
 #undef NONZERO_TYPED_KERNEL
 
+namespace {
+// the blocks of elements in which the nonzero elements are counted, then written, in parallel
+constexpr std::ptrdiff_t kMinBlockSize = 32 * 1024;
+}  // namespace
+
 template <typename T>
 Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto X = context->Input<Tensor>(0);
@@ -59,25 +64,56 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<Eigen::Index>(X_shape.NumDimensions());
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(SafeInt<size_t>(X_shape.Size()) * coordinate_size);
-
+  const int64_t coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<int64_t>(X_shape.NumDimensions());
   const T* data = X->Data<T>();
 
   if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
+    const int64_t num_non_zero_values = *data != T{} ? 1 : 0;
+    Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
+    ORT_ENFORCE(Y, "failed to get first output!");
+    if (num_non_zero_values > 0) {
+      Y->MutableData<int64_t>()[0] = 0;
+    }
+    return Status::OK();
+  }
+
+  // the first pass counts the nonzero elements of each block, which gives the size of the output and the position
+  // of the first nonzero element of each block in it. the second pass writes the coordinates of the nonzero elements
+  // straight to the output, which has one row per dimension.
+  ParallelScan<int64_t> scan(context->GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(X_shape.Size()),
+                             kMinBlockSize);
+  const int64_t num_non_zero_values = scan.Reduce([data](std::ptrdiff_t first, std::ptrdiff_t last) {
+    return static_cast<int64_t>(std::count_if(data + first, data + last, [](const T& value) { return value != T{}; }));
+  });
+
+  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
+  ORT_ENFORCE(Y, "failed to get first output!");
+  int64_t* y_data = Y->MutableData<int64_t>();
+
+  scan.Scan([&](std::ptrdiff_t first, std::ptrdiff_t last, int64_t position) {
+    if (first == last) {
+      return;
+    }
+
+    // the coordinate of the first element of the block
+    TensorShapeVector coordinate(onnxruntime::narrow<size_t>(coordinate_size));
+    int64_t remainder = first;
+    for (int64_t idx = coordinate_size - 1; idx >= 0; --idx) {
+      coordinate[idx] = remainder % X_shape[idx];
+      remainder /= X_shape[idx];
     }
-  } else {
-    std::vector<int64_t> coordinate(coordinate_size, 0);
 
     // as we iterate the entries, increment the coordinate for the current entry
     // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
-      for (Eigen::Index idx = coordinate_size - 1; idx >= 0; --idx) {
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      if (data[i] != T{}) {
+        for (int64_t idx = 0; idx < coordinate_size; ++idx) {
+          y_data[idx * num_non_zero_values + position] = coordinate[idx];
+        }
+        ++position;
+      }
+
+      for (int64_t idx = coordinate_size - 1; idx >= 0; --idx) {
         int64_t& cur_coord = coordinate[idx];
         if (cur_coord != X_shape[idx] - 1) {
           ++cur_coord;
@@ -85,33 +121,8 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
         }
         cur_coord = 0;
       }
-    };
-
-    for (size_t i = 0, end = onnxruntime::narrow<size_t>(X_shape.Size()); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
-      }
-
-      increment_coordinate();
     }
-  }
-
-  const Eigen::Index num_non_zero_values = onnxruntime::narrow<Eigen::Index>(non_zero_indices_buffer.size()) / coordinate_size;
-
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
-
-  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
-  ORT_ENFORCE(Y, "failed to get first output!");
-
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+  });
 
   return Status::OK();
 }
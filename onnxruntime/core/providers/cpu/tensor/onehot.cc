@@ -15,13 +15,12 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #include "core/providers/cpu/tensor/onehot.h"
-#include "core/common/eigen_common_wrapper.h"
-#include "core/platform/env.h"
+
+#include <algorithm>
+
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 
-#ifndef EIGEN_USE_THREADS
-#define EIGEN_USE_THREADS
-#endif
 using namespace ::onnxruntime::common;
 using namespace std;
 
@@ -109,40 +108,6 @@ Status PrepareOutputShape(const Tensor* indices, const int64_t depth_val, const
   return Status::OK();
 }
 
-// Helper to define Tensor types given that the scalar is of type T.
-template <typename T, int NDIMS = 1, typename IndexType = Eigen::DenseIndex>
-struct EigenTensorTypes {
-  using EigenTensorMap = Eigen::TensorMap<Eigen::Tensor<T, NDIMS, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using ConstEigenTensorMap = Eigen::TensorMap<Eigen::Tensor<const T, NDIMS, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using Scalar = Eigen::TensorMap<Eigen::TensorFixedSize<T, Eigen::Sizes<>, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using ConstScalar = Eigen::TensorMap<Eigen::TensorFixedSize<const T, Eigen::Sizes<>, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-  using ConstMatrix = Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor, IndexType>, Eigen::Aligned>;
-};
-
-namespace generator {
-template <typename in_type, typename out_type>
-class OneGenerator {
- public:
-  EIGEN_DEVICE_FUNC EIGEN_ALWAYS_INLINE
-  OneGenerator(const typename EigenTensorTypes<in_type>::ConstMatrix& indices,
-               const typename EigenTensorTypes<out_type>::ConstScalar& on_value,
-               const typename EigenTensorTypes<out_type>::ConstScalar& off_value)
-      : indices_(indices), on_value_(on_value), off_value_(off_value) {}
-
-  EIGEN_DEVICE_FUNC EIGEN_ALWAYS_INLINE out_type
-  operator()(const Eigen::array<Eigen::DenseIndex, 3>& pre_depth_suff) const {
-    return (indices_(pre_depth_suff[0], pre_depth_suff[2]) == pre_depth_suff[1])
-               ? on_value_()
-               : off_value_();
-  }
-
- private:
-  const typename EigenTensorTypes<in_type>::ConstMatrix indices_;
-  const typename EigenTensorTypes<out_type>::ConstScalar on_value_;
-  const typename EigenTensorTypes<out_type>::ConstScalar off_value_;
-};
-}  // namespace generator
-
 template <typename in_type, typename out_type, typename depth_type>
 Status OneHotOp<in_type, out_type, depth_type>::Compute(OpKernelContext* p_op_kernel_context) const {
   const auto* indices = p_op_kernel_context->Input<Tensor>(0);
@@ -171,41 +136,40 @@ Status OneHotOp<in_type, out_type, depth_type>::Compute(OpKernelContext* p_op_ke
   if (output->Shape().Size() == 0)
     return Status::OK();
 
-  // Split indices into matrix of size prefix_dim_size x suffix_dim_size
-  Eigen::array<Eigen::DenseIndex, 2> indices_dims_e = {
-      {static_cast<Eigen::DenseIndex>(prefix_dim_size), static_cast<Eigen::DenseIndex>(suffix_dim_size)}};
-
-  // Handle negative indices. It's faster to create a new indices instead of comparing in generator
-  // since generator has much larger loops.
+  // The output is a prefix_dim_size x depth x suffix_dim_size tensor. Each depth x suffix_dim_size block is filled
+  // with the off value and the on values are then written at the positions given by the suffix_dim_size indices of
+  // the block. Out of range indices, and for float indices the non integral ones, select no position.
   const auto* indices_data = indices->Data<in_type>();
-  const auto indices_size = indices->Shape().Size();
-  std::vector<in_type> adjusted_indices;
-  adjusted_indices.reserve(onnxruntime::narrow<size_t>(indices_size));
-  for (int64_t i = 0; i < indices_size; ++i) {
-    if (indices_data[i] < 0)
-      adjusted_indices.push_back(indices_data[i] + static_cast<in_type>(depth_val));
-    else
-      adjusted_indices.push_back(indices_data[i]);
-  }
-  indices_data = adjusted_indices.data();
-
-  typename EigenTensorTypes<in_type, 2>::ConstEigenTensorMap indices_tensor_e(indices_data, indices_dims_e);
-
-  // Split output into 3-Tensor of size:
-  //   prefix_dim_size x depth x suffix_dim_size.
-  Eigen::array<Eigen::DenseIndex, 3> output_dims_e = {
-      {static_cast<Eigen::DenseIndex>(prefix_dim_size), static_cast<Eigen::DenseIndex>(depth_val), static_cast<Eigen::DenseIndex>(suffix_dim_size)}};
+  const out_type& off_value = values_data[0];
+  const out_type& on_value = values_data[1];
   auto* output_data = output->MutableData<out_type>();
-  typename EigenTensorTypes<out_type, 3>::EigenTensorMap output_tensor_e(output_data, output_dims_e);
-
-  typename EigenTensorTypes<out_type>::ConstScalar on_value_e(values_data + 1);
-  typename EigenTensorTypes<out_type>::ConstScalar off_value_e(values_data);
-
-  generator::OneGenerator<in_type, out_type> generator(indices_tensor_e, on_value_e, off_value_e);
-
-  // TODO potential optimization opportunity
-  // TODO figure out the eigen threadpool stuff for use here
-  output_tensor_e = output_tensor_e.generate(generator);
+  const int64_t block_size = depth_val * suffix_dim_size;
+
+  const double block_bytes = static_cast<double>(block_size) * sizeof(out_type);
+  concurrency::ThreadPool::TryParallelFor(
+      p_op_kernel_context->GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(prefix_dim_size),
+      TensorOpCost{static_cast<double>(suffix_dim_size) * sizeof(in_type), block_bytes, 0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t prefix = first; prefix < last; ++prefix) {
+          out_type* output_block = output_data + prefix * block_size;
+          std::fill_n(output_block, onnxruntime::narrow<size_t>(block_size), off_value);
+
+          const in_type* indices_block = indices_data + prefix * suffix_dim_size;
+          for (int64_t suffix = 0; suffix < suffix_dim_size; ++suffix) {
+            in_type index = indices_block[suffix];
+            if (index < 0) {
+              index += static_cast<in_type>(depth_val);
+            }
+            if (!(index >= 0 && index < static_cast<in_type>(depth_val))) {
+              continue;
+            }
+            const auto depth_index = static_cast<int64_t>(index);
+            if (static_cast<in_type>(depth_index) == index) {
+              output_block[depth_index * suffix_dim_size + suffix] = on_value;
+            }
+          }
+        }
+      });
 
   return Status::OK();
 }
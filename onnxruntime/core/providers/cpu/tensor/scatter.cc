@@ -10,6 +10,7 @@
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 #if defined(ENABLE_TRAINING_OPS)
@@ -266,7 +267,7 @@ template <class Tdata, typename FuncT>
 Status ScatterData(
     const FuncT& func,
     const Tensor* data_input, const std::vector<int64_t>& indices_data, const Tensor* updates_input, int64_t axis,
-    Tensor* data_output) {
+    Tensor* data_output, concurrency::ThreadPool* thread_pool) {
   const TensorShape& input_data_shape = data_input->Shape();
 
   const auto input_elements = input_data_shape.Size();
@@ -296,29 +297,15 @@ Status ScatterData(
   const auto num_dims = input_data_shape.NumDimensions();
   ORT_RETURN_IF_NOT(num_dims > 0, "ScatterElements op: input tensor must have at least one dimension");
 
-  // Allocate and zero out counts. The input/output is of the same rank as
-  // indices/updates but the actual dimensions of indices/updates must be less or equal
-  // than that of input/output because we can update no more elements than
-  // the input contains. As we walk through the indices/updates
-  // we maintain dimension count as we will need to use it
-  // to compute output offset but using input/output dim values.
-  // We treat the whole array as a number where each element having
-  // different cardinality according to the upd_shape dimensions.
-  // As each counter reaches its max (upd_shape) it resets to zero
-  // and we carry to the more significant dim (right to left)
-  std::vector<int64_t> dim_counters(num_dims);
-
   // This vector contains number of elements under the dimension.
   // For example, for the dimensions of [4, 2, 3] the vector
   // would contain [6, 3, 1] since for each count of dim 1 it
   // contains 3 elements of dim 2.
   // For each count of dim 0 we would have 2x3=6 elements.
   // The last value is always 1.
-  // We use it to compute output element offset. For a given value of
-  // counters we multiple each counter value per corresponding entry of dim_block_size value
-  // and add up resulting the output element offset. However, for dimensions
-  // that are equal to the specified axis value we take indices_data[index]
-  // instead of the counter value.
+  // The output element offset of an update is the sum of its coordinates multiplied by the
+  // corresponding entries of dim_block_size, except that the coordinate along the axis is
+  // replaced by indices_data[index].
   // E.g. for 3-dim and axis=0
   //    output[indices[i][j][k]][j][k] = updates[i][j][k]
   // for axis 1
@@ -335,41 +322,66 @@ Status ScatterData(
     }
   }
 
-  const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
-  // For every update we compute the destination offset and copy it there
-  for (int64_t index = 0; index < num_indices;) {
-    const auto axis_idx = indices_data[narrow<size_t>(index)];
-
-    // Compute the offset
-    // See comments above for dim_block_size
-    size_t dst_offset = 0;
-    for (size_t i = 0; i < num_dims; ++i) {
-      if (i == size_t(axis)) {
-        // replace the counter with the update index for this dim
-        dst_offset += narrow<size_t>(axis_idx * dim_block_size[narrow<size_t>(i)]);
-      } else {
-        dst_offset += narrow<size_t>(dim_counters[narrow<size_t>(i)] * dim_block_size[narrow<size_t>(i)]);
+  // The updates are viewed as [outer, axis_dim, inner]. The output offsets of the outer and inner
+  // coordinates are computed once, as the dimensions of the updates may be smaller than those of
+  // the output. Two updates can only land on the same output element if they share their outer and
+  // inner coordinates, so the outer rows, or the inner columns when there is a single row, are
+  // scattered in parallel while the updates along the axis are applied in order, as the reductions
+  // and the last-write-wins assignment require.
+  const auto axis_dim = upd_shape[narrow<size_t>(axis)];
+  const auto outer_size = upd_shape.SizeToDimension(narrow<size_t>(axis));
+  const auto inner_size = upd_shape.SizeFromDimension(SafeInt<size_t>(axis) + 1);
+  const auto axis_block_size = dim_block_size[narrow<size_t>(axis)];
+
+  auto dim_offsets = [&](size_t first_dim, size_t last_dim) {
+    std::vector<int64_t> offsets(1, 0);
+    for (size_t i = first_dim; i < last_dim; ++i) {
+      std::vector<int64_t> next;
+      next.reserve(offsets.size() * narrow<size_t>(upd_shape[i]));
+      for (int64_t offset : offsets) {
+        for (int64_t c = 0; c < upd_shape[i]; ++c) {
+          next.push_back(offset + c * dim_block_size[i]);
+        }
       }
+      offsets = std::move(next);
     }
+    return offsets;
+  };
+  const std::vector<int64_t> outer_offsets = dim_offsets(0, narrow<size_t>(axis));
+  const std::vector<int64_t> inner_offsets = dim_offsets(SafeInt<size_t>(axis) + 1, num_dims);
 
-    func(dst_base + dst_offset, update_data + index);
-
-    if (++index == num_indices) {
-      break;
-    }
-    // Increment counters
-    // See comments for dim_counters above
-    for (auto i = int64_t(num_dims - 1); i >= 0; --i) {
-      auto v = ++dim_counters[narrow<size_t>(i)];
-      assert(v <= upd_shape[narrow<size_t>(i)]);
-      if (v < upd_shape[narrow<size_t>(i)]) {
-        // No carry, done
-        break;
+  const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
+  auto scatter = [&](int64_t outer_begin, int64_t outer_end, int64_t inner_begin, int64_t inner_end) {
+    for (int64_t o = outer_begin; o < outer_end; ++o) {
+      for (int64_t k = 0; k < axis_dim; ++k) {
+        const int64_t row = (o * axis_dim + k) * inner_size;
+        for (int64_t j = inner_begin; j < inner_end; ++j) {
+          const int64_t index = row + j;
+          const int64_t dst_offset = outer_offsets[narrow<size_t>(o)] +
+                                     indices_data[narrow<size_t>(index)] * axis_block_size +
+                                     inner_offsets[narrow<size_t>(j)];
+          func(dst_base + dst_offset, update_data + index);
+        }
       }
-      // No carry for the most significant dim
-      assert(i > 0);
-      dim_counters[narrow<size_t>(i)] = 0;
     }
+  };
+
+  if (num_indices == 0) {
+    return Status::OK();
+  }
+
+  if (outer_size > 1) {
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, narrow<std::ptrdiff_t>(outer_size), static_cast<double>(axis_dim * inner_size),
+        [&scatter, inner_size](std::ptrdiff_t first, std::ptrdiff_t last) {
+          scatter(first, last, 0, inner_size);
+        });
+  } else {
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, narrow<std::ptrdiff_t>(inner_size), static_cast<double>(axis_dim),
+        [&scatter](std::ptrdiff_t first, std::ptrdiff_t last) {
+          scatter(0, 1, first, last);
+        });
   }
   return Status::OK();
 }
@@ -377,22 +389,22 @@ Status ScatterData(
 template <typename TData>
 struct ScatterDataDispatchTarget {
   Status operator()(const Tensor* data_input, const std::vector<int64_t>& indices_data, const Tensor* updates_input, int64_t axis,
-                    const std::string& reduction, Tensor* data_output) const {
+                    const std::string& reduction, Tensor* data_output, concurrency::ThreadPool* thread_pool) const {
     if (reduction == "add")
       return ScatterData<TData>(
-          Func_Add<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Add<TData>(), data_input, indices_data, updates_input, axis, data_output, thread_pool);
     else if (reduction == "mul")
       return ScatterData<TData>(
-          Func_Mul<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Mul<TData>(), data_input, indices_data, updates_input, axis, data_output, thread_pool);
     else if (reduction == "min")
       return ScatterData<TData>(
-          Func_Min<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Min<TData>(), data_input, indices_data, updates_input, axis, data_output, thread_pool);
     else if (reduction == "max")
       return ScatterData<TData>(
-          Func_Max<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Max<TData>(), data_input, indices_data, updates_input, axis, data_output, thread_pool);
     else  // if (reduction == "none")
       return ScatterData<TData>(
-          Func_Assignment<TData>(), data_input, indices_data, updates_input, axis, data_output);
+          Func_Assignment<TData>(), data_input, indices_data, updates_input, axis, data_output, thread_pool);
   }
 };
 
@@ -462,7 +474,7 @@ Status Scatter<EnabledDataTypes>::Compute(OpKernelContext* context) const {
 
   utils::MLTypeCallDispatcherFromTypeList<EnabledDataTypes> dispatcher{data_type};
   status = dispatcher.template InvokeRet<Status, ScatterDataDispatchTarget>(
-      data_input, indices_data, updates_input, axis, this->reduction_, data_output);
+      data_input, indices_data, updates_input, axis, this->reduction_, data_output, context->GetOperatorThreadPool());
 
   return status;
 }
@@ -483,7 +495,7 @@ Status GatherElementsGradImpl(const Tensor* indices_input, const Tensor* updates
                               const int64_t axis, Tensor* data_output) {
   std::vector<int64_t> indices_data{};
   ORT_RETURN_IF_ERROR(GetIndices<Tin>(*data_output, *indices_input, axis, indices_data));
-  return ScatterData<Tdata>(Func_Add<Tdata>(), data_output, indices_data, updates_input, axis, data_output);
+  return ScatterData<Tdata>(Func_Add<Tdata>(), data_output, indices_data, updates_input, axis, data_output, nullptr);
 }
 
 #define GATHER_ELEMENTS_GRAD_IMPL_SPECIALIZED(Tin, Tdata) \
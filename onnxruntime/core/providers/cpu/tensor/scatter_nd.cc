@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/tensor/scatter_nd.h"
 
+#include <algorithm>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
@@ -356,50 +358,69 @@ struct ScatterNDDispatchTarget {
     Prepare<TData> prepare;
     ORT_RETURN_IF_ERROR(PrepareForCompute(context, prepare));
 
-    auto lambda = [&](int64_t i) {
+    const auto& offsets = prepare.element_offsets;
+    const size_t num_slices = offsets.size();
+    if (num_slices == 0) {
+      return Status::OK();
+    }
+
+    // Slices whose indices address adjacent slices of the output, e.g. the positions of the new
+    // tokens in a KV cache, are merged into runs and updated with a single call per run.
+    // The slices are distinct if they are in increasing order, otherwise the offsets are sorted
+    // to look for duplicates. Duplicated slices of a reduction are applied in order on the
+    // calling thread, the assignment of duplicated slices being undefined anyway.
+    std::vector<size_t> run_starts{0};
+    bool increasing = true;
+    for (size_t i = 1; i < num_slices; ++i) {
+      if (offsets[i] != offsets[i - 1] + prepare.element_to_copy) {
+        run_starts.push_back(i);
+      }
+      increasing = increasing && offsets[i] > offsets[i - 1];
+    }
+
+    if (!increasing && reduction != ScatterND::Reduction::None) {
+      std::vector<uint64_t> sorted_offsets(offsets);
+      std::sort(sorted_offsets.begin(), sorted_offsets.end());
+      if (std::adjacent_find(sorted_offsets.begin(), sorted_offsets.end()) != sorted_offsets.end()) {
+        tp = nullptr;
+      }
+    }
+
+    const size_t num_runs = run_starts.size();
+    auto lambda = [&](size_t run) {
+      const size_t first = run_starts[run];
+      const size_t last = run + 1 < num_runs ? run_starts[run + 1] : num_slices;
+      TData* dst = prepare.output_base + offsets[first];
+      const TData* src = prepare.input_base + first * prepare.element_to_copy;
+      const uint64_t element_count = (last - first) * prepare.element_to_copy;
       switch (reduction) {
         case ScatterND::Reduction::Add: {
           auto func = Func_Add_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
+          func(dst, src, element_count);
         } break;
         case ScatterND::Reduction::Mul: {
           auto func = Func_Mul_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
+          func(dst, src, element_count);
         } break;
         case ScatterND::Reduction::Min: {
           auto func = Func_Min_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
+          func(dst, src, element_count);
         } break;
         case ScatterND::Reduction::Max: {
           auto func = Func_Max_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
+          func(dst, src, element_count);
         } break;
         default:
         case ScatterND::Reduction::None: {
           auto func = Func_Copy_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
+          func(dst, src, element_count);
         } break;
       }
     };
     concurrency::ThreadPool::TryParallelFor(
-        tp, prepare.element_offsets.size(), static_cast<double>(prepare.element_to_copy),
+        tp, num_runs, static_cast<double>(num_slices * prepare.element_to_copy / num_runs),
         [&lambda](ptrdiff_t first, ptrdiff_t last) {
-          for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
+          for (size_t i = static_cast<size_t>(first), end = static_cast<size_t>(last); i < end; ++i) {
             lambda(i);
           }
         });
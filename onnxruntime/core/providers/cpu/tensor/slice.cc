@@ -11,6 +11,7 @@
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/slice_helper.h"
+#include "core/providers/cpu/tensor/strided_view.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 
@@ -39,16 +40,22 @@ using EnabledIndicesTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(kCpuE
                                                                            Slice, Input, 1);
 }  // namespace
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_SLICE_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedOutput(0, 0)
+#else
+#define CREATE_SLICE_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     1, 9,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    CREATE_SLICE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
     Slice1);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     10, 10,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
@@ -57,7 +64,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     11,
     12,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
@@ -65,7 +72,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
 ONNX_CPU_OPERATOR_KERNEL(
     Slice,
     13,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
@@ -288,12 +295,13 @@ Status SliceBase::Compute(OpKernelContext* ctx) const {
 
   SliceOp::PrepareForComputeMetadata compute_metadata(input_dimensions);
 
+  TensorShapeVector input_starts;
+  TensorShapeVector input_ends;
+  TensorShapeVector input_axes;
+  TensorShapeVector input_steps;
+
   // Slice V10 & DynamicSlice
   if (dynamic_) {
-    TensorShapeVector input_starts;
-    TensorShapeVector input_ends;
-    TensorShapeVector input_axes;
-    TensorShapeVector input_steps;
     ORT_RETURN_IF_ERROR(FillVectorsFromInput(*ctx->Input<Tensor>(1), *ctx->Input<Tensor>(2),
                                              ctx->Input<Tensor>(3), ctx->Input<Tensor>(4),
                                              input_starts, input_ends,
@@ -306,6 +314,31 @@ Status SliceBase::Compute(OpKernelContext* ctx) const {
     ORT_RETURN_IF_ERROR(PrepareForCompute(attr_starts_, attr_ends_, attr_axes_, compute_metadata));
   }
 
+#ifdef ENABLE_STRIDED_TENSORS
+  auto& output_tensor = *ctx->Output(0, TensorShape(compute_metadata.output_dims_));
+  if (!input_tensor.IsContiguous() || IsStridedViewOf(output_tensor, input_tensor)) {
+    // the view needs the start and step of every dim, which FlattenOutputDims has coalesced
+    SliceOp::PrepareForComputeMetadata view_metadata(input_dimensions);
+    if (dynamic_) {
+      ORT_RETURN_IF_ERROR(SliceOp::PrepareForComputeHelper(input_starts, input_ends, input_axes, input_steps,
+                                                           view_metadata));
+    } else {
+      ORT_RETURN_IF_ERROR(SliceOp::PrepareForComputeHelper(attr_starts_, attr_ends_, attr_axes_, view_metadata));
+    }
+
+    const auto input_strides = input_tensor.Strides();
+    std::ptrdiff_t offset = 0;
+    TensorShapeVector output_strides(input_dimensions.size());
+    for (size_t i = 0; i < input_dimensions.size(); ++i) {
+      offset += static_cast<std::ptrdiff_t>(view_metadata.starts_[i] * input_strides[i]);
+      output_strides[i] = view_metadata.steps_[i] * input_strides[i];
+    }
+
+    return SetOrCopyStridedView<EnabledDataTypes>(input_tensor, offset, output_strides, output_tensor,
+                                                  ctx->GetOperatorThreadPool());
+  }
+#endif
+
   Status status = Status::OK();
 
   bool supported = false;
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#ifdef ENABLE_STRIDED_TENSORS
+
+#include "core/framework/copy.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+// CPU kernels that only rearrange their input (Transpose, Slice, Expand) are registered with MayStridedOutput(0, 0)
+// and MayStridedInput(0). The allocation planner makes the output share the buffer of the input when every consumer
+// of the output accepts a strided input, in which case the kernel only has to describe the view. Otherwise the view
+// is copied into the contiguous output. Either way, the input can itself be a view.
+
+// Returns true if the planner made `output` share the buffer of `input`.
+inline bool IsStridedViewOf(const Tensor& output, const Tensor& input) {
+  return output.DataRaw() == input.DataRaw();
+}
+
+// Makes `output` the view of `input` whose element at index i is input[offset + dot(i, strides)], where offset and
+// strides are in elements of `input`, or copies that view into `output` if it doesn't share the buffer of `input`.
+template <typename EnabledDataTypes>
+Status SetOrCopyStridedView(const Tensor& input, std::ptrdiff_t offset, const TensorShapeVector& strides,
+                            Tensor& output, concurrency::ThreadPool* thread_pool) {
+  const TensorShape& output_shape = output.Shape();
+  ORT_RETURN_IF_NOT(strides.size() == output_shape.NumDimensions(), "Strides don't match the rank of the view.");
+
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  if (IsStridedViewOf(output, input)) {
+    output.SetByteOffset(output.ByteOffset() + offset * static_cast<std::ptrdiff_t>(input.DataType()->Size()));
+    output.SetShapeAndStrides(output_shape, strides);
+    return Status::OK();
+  }
+
+  // StridedCopy needs at least one dim
+  if (output_shape.NumDimensions() == 0) {
+    return DispatchStridedCopy<EnabledDataTypes>(thread_pool, output, 0, TensorShapeVector{1}, TensorShape({1}), input,
+                                                 offset, TensorShapeVector{1});
+  }
+
+  return DispatchStridedCopy<EnabledDataTypes>(thread_pool, output, 0, StridesForTensor(output), output_shape, input,
+                                               offset, strides);
+}
+
+}  // namespace onnxruntime
+
+#endif  // ENABLE_STRIDED_TENSORS
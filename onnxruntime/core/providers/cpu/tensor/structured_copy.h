@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "core/common/inlined_containers.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// Copies an input tensor into an output tensor of the same rank in which every element is either an element of the
+// input or a fill value: the pads of Pad, the repeats of Tile and the broadcasts of Expand.
+//
+// source_offsets[axis][i] is the offset in the input, in elements, of the slice read by position i of the output
+// along the axis (the input coordinate multiplied by the input pitch of the axis), or -1 where the output holds the
+// fill value. An output row, along the innermost axis, reads the input row at the sum of the offsets of its outer
+// coordinates, or holds the fill value if one of them is -1.
+//
+// The innermost axis is split once into segments of consecutive input elements, copied with memcpy, and segments of
+// a repeated input element or of the fill value, filled. Short rows are first merged with the axes above them when
+// that keeps them moderately long, and the rows are then built in parallel.
+template <typename T>
+class StructuredCopy {
+ public:
+  explicit StructuredCopy(std::vector<std::vector<int64_t>> source_offsets)
+      : source_offsets_(std::move(source_offsets)) {
+    while (source_offsets_.size() > 1 && source_offsets_.back().size() < kMinRowSize &&
+           source_offsets_.back().size() * source_offsets_[source_offsets_.size() - 2].size() <= kMaxMergedRowSize) {
+      MergeInnermostAxes();
+    }
+    if (!source_offsets_.empty()) {
+      SplitRow(source_offsets_.back());
+    }
+  }
+
+  void Run(const T* input, T* output, const T& fill_value, concurrency::ThreadPool* thread_pool) const {
+    if (source_offsets_.empty()) {
+      *output = *input;
+      return;
+    }
+
+    const size_t outer_rank = source_offsets_.size() - 1;
+    const std::ptrdiff_t row_size = static_cast<std::ptrdiff_t>(source_offsets_.back().size());
+    std::ptrdiff_t row_count = 1;
+    for (size_t axis = 0; axis < outer_rank; ++axis) {
+      row_count *= static_cast<std::ptrdiff_t>(source_offsets_[axis].size());
+    }
+    if (row_size == 0 || row_count == 0) {
+      return;
+    }
+
+    const double row_bytes = static_cast<double>(row_size) * sizeof(T);
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, row_count, TensorOpCost{row_bytes, row_bytes, 0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          InlinedVector<size_t> coords(outer_rank);
+          for (size_t axis = outer_rank, remains = static_cast<size_t>(first); axis-- > 0;) {
+            const size_t dim = source_offsets_[axis].size();
+            coords[axis] = remains % dim;
+            remains /= dim;
+          }
+
+          for (std::ptrdiff_t row = first; row < last; ++row) {
+            int64_t input_offset = 0;
+            for (size_t axis = 0; axis < outer_rank && input_offset >= 0; ++axis) {
+              const int64_t offset = source_offsets_[axis][coords[axis]];
+              input_offset = offset < 0 ? -1 : input_offset + offset;
+            }
+            T* output_row = output + row * row_size;
+            if (input_offset < 0) {
+              std::fill_n(output_row, row_size, fill_value);
+            } else {
+              CopyRow(input + input_offset, output_row, fill_value);
+            }
+
+            for (size_t axis = outer_rank; axis-- > 0;) {
+              if (++coords[axis] < source_offsets_[axis].size()) {
+                break;
+              }
+              coords[axis] = 0;
+            }
+          }
+        });
+  }
+
+ private:
+  static constexpr size_t kMinRowSize = 64;
+  static constexpr size_t kMaxMergedRowSize = 16384;
+
+  struct Segment {
+    size_t output_begin;
+    size_t length;
+    int64_t input_offset;  // -1 for the fill value
+    bool repeated;         // the element at input_offset is repeated
+  };
+
+  void MergeInnermostAxes() {
+    std::vector<int64_t> inner = std::move(source_offsets_.back());
+    source_offsets_.pop_back();
+    const std::vector<int64_t> outer = std::move(source_offsets_.back());
+    std::vector<int64_t>& merged = source_offsets_.back();
+    merged.clear();
+    merged.reserve(outer.size() * inner.size());
+    for (int64_t outer_offset : outer) {
+      for (int64_t inner_offset : inner) {
+        merged.push_back(outer_offset < 0 || inner_offset < 0 ? -1 : outer_offset + inner_offset);
+      }
+    }
+  }
+
+  void SplitRow(const std::vector<int64_t>& offsets) {
+    for (size_t i = 0; i < offsets.size(); ++i) {
+      const int64_t offset = offsets[i];
+      if (!segments_.empty()) {
+        Segment& segment = segments_.back();
+        if (offset < 0 && segment.input_offset < 0) {
+          ++segment.length;
+          continue;
+        }
+        if (offset >= 0 && segment.input_offset >= 0) {
+          if (!segment.repeated && offset == segment.input_offset + static_cast<int64_t>(segment.length)) {
+            ++segment.length;
+            continue;
+          }
+          if ((segment.repeated || segment.length == 1) && offset == segment.input_offset) {
+            segment.repeated = true;
+            ++segment.length;
+            continue;
+          }
+        }
+      }
+      segments_.push_back({i, 1, offset < 0 ? -1 : offset, false});
+    }
+  }
+
+  void CopyRow(const T* input_row, T* output_row, const T& fill_value) const {
+    for (const Segment& segment : segments_) {
+      T* output = output_row + segment.output_begin;
+      if (segment.input_offset < 0) {
+        std::fill_n(output, segment.length, fill_value);
+      } else if (segment.repeated) {
+        std::fill_n(output, segment.length, input_row[segment.input_offset]);
+      } else {
+        std::copy_n(input_row + segment.input_offset, segment.length, output);
+      }
+    }
+  }
+
+  std::vector<std::vector<int64_t>> source_offsets_;
+  InlinedVector<Segment> segments_;
+};
+
+}  // namespace onnxruntime
@@ -10,6 +10,7 @@
 #endif
 
 #include "core/providers/cpu/tensor/tile.h"
+#include "core/providers/cpu/tensor/structured_copy.h"
 #include "core/providers/cpu/tensor/utils.h"
 
 #ifdef _MSC_VER
@@ -57,85 +58,26 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<int64_t>()),
     Tile);
 
-Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats, TensorAxisCounters& input_counters, const TensorPitches& output_pitches, size_t element_size) {
-  const auto& input_shape = input_tensor.Shape().GetDims();
-  const size_t dimension_count = input_shape.size();
-
-  const auto* input = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
-  auto* output = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
-
-  // some helper variables that will be used along the way
-  size_t block_size = 0;
-  int64_t num_repeats = 0;
-  const uint8_t* copy = nullptr;
-  const int64_t innermost_dim = input_shape[dimension_count - 1];
-
-  while (input_counters) {
-    // Copy the input data over
-    block_size = SafeInt<size_t>(innermost_dim) * element_size;
-    memcpy(output, input, block_size);
-    output += block_size;
-    input += block_size;
-
-    // Tile data for the innermost axis
-    copy = output - block_size;
-    num_repeats = repeats[dimension_count - 1] - 1;
-    for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-      memcpy(output, copy, block_size);
-      output += block_size;
-    }
-
-    // Tile data for other axes
-    while (input_counters.Increment()) {
-      ptrdiff_t pitch = onnxruntime::narrow<size_t>(output_pitches[input_counters.Axis()] * input_shape[input_counters.Axis()]);
-      block_size = pitch * element_size;
-      copy = output - block_size;
-      num_repeats = repeats[input_counters.Axis()] - 1;
-      for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-        memcpy(output, copy, block_size);
-        output += block_size;
-      }
+// Each index of an output axis reads the input index it is a repeat of
+template <typename T>
+static Status TileCore(const Tensor& input_tensor, Tensor& output_tensor, concurrency::ThreadPool* thread_pool) {
+  const auto& input_shape = input_tensor.Shape();
+  const auto& output_shape = output_tensor.Shape();
+  const size_t dimension_count = input_shape.NumDimensions();
+  TensorPitches input_pitches(input_shape);
+
+  std::vector<std::vector<int64_t>> source_offsets(dimension_count);
+  for (size_t axis = 0; axis < dimension_count; ++axis) {
+    auto& offsets = source_offsets[axis];
+    offsets.resize(onnxruntime::narrow<size_t>(output_shape[axis]));
+    for (int64_t i = 0; i < output_shape[axis]; ++i) {
+      offsets[onnxruntime::narrow<size_t>(i)] = (i % input_shape[axis]) * input_pitches[axis];
     }
   }
-  return Status::OK();
-}
-
-Status TileCoreForStringType(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats, TensorAxisCounters& input_counters, const TensorPitches& output_pitches) {
-  const auto& input_shape = input_tensor.Shape().GetDims();
-  const size_t dimension_count = input_shape.size();
-
-  const auto* input = input_tensor.Data<std::string>();
-  auto* output = output_tensor.MutableData<std::string>();
-
-  // some helper variables that will be used along the way
-  size_t block_size = 0;
-  int64_t num_repeats = 0;
-  const std::string* copy = nullptr;
-  const int64_t innermost_dim = input_shape[dimension_count - 1];
 
-  while (input_counters) {
-    // Copy the input data over
-    block_size = SafeInt<size_t>(innermost_dim);
-    output = std::copy(input, input + block_size, output);
-    input += block_size;
-
-    // Tile data for the innermost axis
-    copy = output - block_size;
-    num_repeats = repeats[dimension_count - 1] - 1;
-    for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-      output = std::copy(copy, copy + block_size, output);
-    }
-
-    // Tile data for other axes
-    while (input_counters.Increment()) {
-      block_size = onnxruntime::narrow<size_t>(output_pitches[input_counters.Axis()] * input_shape[input_counters.Axis()]);
-      copy = output - block_size;
-      num_repeats = repeats[input_counters.Axis()] - 1;
-      for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-        output = std::copy(copy, copy + block_size, output);
-      }
-    }
-  }
+  StructuredCopy<T>(std::move(source_offsets))
+      .Run(reinterpret_cast<const T*>(input_tensor.DataRaw()), reinterpret_cast<T*>(output_tensor.MutableDataRaw()),
+           T{}, thread_pool);
   return Status::OK();
 }
 
@@ -234,73 +176,66 @@ Status Tile::Compute(OpKernelContext* ctx) const {
     const int8_t* input_data_casted = reinterpret_cast<const int8_t*>(input_tensor.DataRaw());
     const void* input_data_raw = input_tensor.DataRaw();
 
+    concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
     if (!is_batched_memcpy) {
       size_t copy_bytes = input_tensor.SizeInBytes();
-      // TODO: Add multi-threading logic if num_of_copies_per_batch is large enough
-      for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-        memcpy(static_cast<void*>(output_data_casted), input_data_raw, copy_bytes);
-        output_data_casted += copy_bytes;
-      }
+      concurrency::ThreadPool::TryParallelFor(
+          thread_pool, static_cast<std::ptrdiff_t>(num_of_copies_per_batch),
+          TensorOpCost{static_cast<double>(copy_bytes), static_cast<double>(copy_bytes), 0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              memcpy(static_cast<void*>(output_data_casted + i * copy_bytes), input_data_raw, copy_bytes);
+            }
+          });
     } else {
       size_t copy_bytes = num_of_elements_per_batch * input_tensor.DataType()->Size();
       size_t batch_count = static_cast<size_t>(input_tensor.Shape()[0]);  // The tensor is atleast 1-D- this is safe
 
-      // TODO: Multi-thread if needed
-      for (size_t batch = 0; batch < batch_count; ++batch) {
-        for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-          memcpy(static_cast<void*>(output_data_casted), static_cast<const void*>(input_data_casted), copy_bytes);
-          output_data_casted += copy_bytes;
-        }
-        input_data_casted += copy_bytes;
-      }
+      // copy i is the copy i % num_of_copies_per_batch of batch i / num_of_copies_per_batch
+      concurrency::ThreadPool::TryParallelFor(
+          thread_pool, static_cast<std::ptrdiff_t>(batch_count * num_of_copies_per_batch),
+          TensorOpCost{static_cast<double>(copy_bytes), static_cast<double>(copy_bytes), 0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              const size_t batch = static_cast<size_t>(i) / num_of_copies_per_batch;
+              memcpy(static_cast<void*>(output_data_casted + i * copy_bytes),
+                     static_cast<const void*>(input_data_casted + batch * copy_bytes), copy_bytes);
+            }
+          });
 
       // Now account for batch dim repeat
       if (num_of_batch_copies > 1) {
-        // reset some values
-        output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
         copy_bytes *= num_of_copies_per_batch * batch_count;
-        int8_t* copy_ptr = output_data_casted + copy_bytes;
-
-        for (size_t i = 1; i < num_of_batch_copies; ++i) {
-          memcpy(static_cast<void*>(copy_ptr), static_cast<const void*>(output_data_casted), copy_bytes);
-          copy_ptr += copy_bytes;
-        }
+        concurrency::ThreadPool::TryParallelFor(
+            thread_pool, static_cast<std::ptrdiff_t>(num_of_batch_copies - 1),
+            TensorOpCost{static_cast<double>(copy_bytes), static_cast<double>(copy_bytes), 0},
+            [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+              for (std::ptrdiff_t i = first; i < last; ++i) {
+                memcpy(static_cast<void*>(output_data_casted + (i + 1) * copy_bytes),
+                       static_cast<const void*>(output_data_casted), copy_bytes);
+              }
+            });
       }
     }
 
     return Status::OK();
   }
 
-  TensorAxisCounters input_counters(input_tensor);
-  TensorPitches output_pitches(output_tensor);
-
-  static_assert(sizeof(float) == sizeof(int32_t), "Float and Int32 are of different sizes");
-  static_assert(sizeof(double) == sizeof(int64_t), "Double and Int64 are of different sizes");
-
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
   if (input_tensor.IsDataType<std::string>())
-    return TileCoreForStringType(input_tensor, output_tensor, repeats, input_counters, output_pitches);
-
-  if (input_tensor.IsDataType<float>() ||
-      input_tensor.IsDataType<int32_t>() ||
-      input_tensor.IsDataType<uint32_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(float));
-
-  if (input_tensor.IsDataType<double>() || input_tensor.IsDataType<int64_t>() ||
-      input_tensor.IsDataType<uint64_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(double));
-
-  else if (input_tensor.IsDataType<int8_t>() ||
-           input_tensor.IsDataType<uint8_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int8_t));
-
-  if (input_tensor.IsDataType<int16_t>() || input_tensor.IsDataType<uint16_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int16_t));
-
-  else if (input_tensor.IsDataType<bool>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(bool));
-
-  // TODO: Support 'string' and 'float16' types for completeness
-  else
-    ORT_THROW("Tile doesn't have an implementation yet for the type: ", input_tensor.DataType());
+    return TileCore<std::string>(input_tensor, output_tensor, thread_pool);
+
+  switch (input_tensor.DataType()->Size()) {
+    case sizeof(uint8_t):
+      return TileCore<uint8_t>(input_tensor, output_tensor, thread_pool);
+    case sizeof(uint16_t):
+      return TileCore<uint16_t>(input_tensor, output_tensor, thread_pool);
+    case sizeof(uint32_t):
+      return TileCore<uint32_t>(input_tensor, output_tensor, thread_pool);
+    case sizeof(uint64_t):
+      return TileCore<uint64_t>(input_tensor, output_tensor, thread_pool);
+    default:
+      ORT_THROW("Tile doesn't have an implementation yet for the type: ", input_tensor.DataType());
+  }
 }
 }  // namespace onnxruntime
@@ -918,45 +918,66 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// Taps of the cubic interpolation along one axis, for each output coordinate: the clamped input indices of the
+// CubicModeGridLength samples and their weights, renormalized when exclude_outside is set.
+struct CubicAxisTaps {
+  std::vector<int64_t> indices;
+  std::vector<float> weights;
+  // whether the extrapolation value is used for the output coordinate
+  std::vector<uint8_t> use_extrapolation_value;
+};
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+static CubicAxisTaps SetupCubicAxisTaps(int64_t input_size,
+                                        int64_t output_size,
+                                        float scale,
+                                        float cubic_coeff_a,
+                                        bool use_extrapolation,
+                                        bool exclude_outside,
+                                        float roi_start,
+                                        float roi_end,
+                                        const GetOriginalCoordinateFunc& get_original_coordinate) {
+  CubicAxisTaps taps;
+  taps.indices.resize(narrow<size_t>(output_size) * CubicModeGridLength);
+  taps.weights.resize(narrow<size_t>(output_size) * CubicModeGridLength);
+  taps.use_extrapolation_value.resize(narrow<size_t>(output_size));
+
+  for (int64_t o = 0; o < output_size; ++o) {
+    float in_o = scale == 1 ? static_cast<float>(o)
+                            : get_original_coordinate(static_cast<float>(o), scale,
+                                                      static_cast<float>(output_size),
+                                                      static_cast<float>(input_size),
+                                                      roi_start, roi_end);
+
+    // when use_extrapolation is set and original index is out of the dim range
+    // then use extrapolation_value as the output value.
+    taps.use_extrapolation_value[narrow<size_t>(o)] =
+        use_extrapolation && (in_o < 0 || in_o > static_cast<float>(input_size - 1));
+
+    const auto o_int = static_cast<int64_t>(std::floor(in_o));
+    auto coeffs = GetCubicCoeffs(in_o - o_int, cubic_coeff_a);
+    float coeff_sum = 1;
+    if (exclude_outside) {
+      // When true, the weight of sampling locations outside the grid will be set to 0
+      // and the weight will be renormalized so that their sum is 1.0
+      coeff_sum = 0;
+      for (int64_t i = 0, val = o_int - 1; val <= o_int + 2; val++, i++) {
+        if (val < 0 || val >= input_size) {
+          coeffs[narrow<size_t>(i)] = 0.0f;
+        }
+        coeff_sum += coeffs[narrow<size_t>(i)];
+      }
+    }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
+    for (int64_t i = 0, val = o_int - 1; val <= o_int + 2; val++, i++) {
+      const size_t tap = narrow<size_t>(o) * CubicModeGridLength + narrow<size_t>(i);
+      taps.indices[tap] = std::max(static_cast<int64_t>(0), std::min(val, input_size - 1));
+      taps.weights[tap] = coeffs[narrow<size_t>(i)] / coeff_sum;
+    }
   }
-  cache[grid_start_pos] = result;
 
-  return result;
+  return taps;
 }
+
 #if defined(_MSC_VER)
 #pragma warning(push)
 #pragma warning(disable : 6001)
@@ -977,134 +998,65 @@ void ResizeBiCubic(int64_t batch_size,
                    gsl::span<const float> roi,
                    const T* Xdata,
                    T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(narrow<size_t>(output_height));
-
-  std::vector<float> x_original;
-  x_original.reserve(narrow<size_t>(output_width));
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
+                   const GetOriginalCoordinateFunc& get_original_coordinate,
+                   concurrency::ThreadPool* tp) {
   auto roi_y_start = roi.size() / 2 - 2;
   auto roi_y_end = roi.size() - 2;
   auto roi_x_start = roi.size() / 2 - 1;
   auto roi_x_end = roi.size() - 1;
 
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
-          }
-        }
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
-
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
+  // The coefficients only depend on the output coordinate, so they're computed once for all the channels.
+  const CubicAxisTaps y_taps = SetupCubicAxisTaps(input_height, output_height, height_scale, cubic_coeff_a,
+                                                  use_extrapolation, exclude_outside,
+                                                  roi[roi_y_start], roi[roi_y_end], get_original_coordinate);
+  const CubicAxisTaps x_taps = SetupCubicAxisTaps(input_width, output_width, width_scale, cubic_coeff_a,
+                                                  use_extrapolation, exclude_outside,
+                                                  roi[roi_x_start], roi[roi_x_end], get_original_coordinate);
+
+  // Each output row of each channel is computed independently: the 4 input rows of its y taps are interpolated
+  // in the x dimension and the results are combined with the y coefficients.
+  const std::ptrdiff_t num_rows = narrow<std::ptrdiff_t>(batch_size * num_channels * output_height);
+  const double row_elements = static_cast<double>(output_width);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_rows,
+      TensorOpCost{row_elements * CubicModeGridLength * CubicModeGridLength * sizeof(T),
+                   row_elements * sizeof(T), row_elements * CubicModeGridLength * CubicModeGridLength * 2},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t nc = row / output_height;
+          const size_t y = narrow<size_t>(row % output_height);
+          const T* X = Xdata + nc * input_height * input_width;
+          T* Y = Ydata + nc * output_height * output_width + y * output_width;
+
+          if (y_taps.use_extrapolation_value[y]) {
+            std::fill_n(Y, narrow<size_t>(output_width), static_cast<T>(extrapolation_value));
             continue;
           }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
+          const int64_t* y_indices = y_taps.indices.data() + y * CubicModeGridLength;
+          const float* y_weights = y_taps.weights.data() + y * CubicModeGridLength;
+          for (size_t x = 0; x < narrow<size_t>(output_width); ++x) {
+            if (x_taps.use_extrapolation_value[x]) {
+              Y[x] = static_cast<T>(extrapolation_value);
+              continue;
             }
-          }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
-          }
+            const int64_t* x_indices = x_taps.indices.data() + x * CubicModeGridLength;
+            const float* x_weights = x_taps.weights.data() + x * CubicModeGridLength;
+            float result = 0;
+            for (size_t i = 0; i < CubicModeGridLength; ++i) {
+              const T* X_row = X + y_indices[i] * input_width;
+              float x_interpolation_result = 0;
+              for (size_t j = 0; j < CubicModeGridLength; ++j) {
+                x_interpolation_result += x_weights[j] * X_row[x_indices[j]];
+              }
+              result += x_interpolation_result * y_weights[i];
+            }
 
-          Ydata[y * output_width + x] = static_cast<T>(result);
+            Y[x] = static_cast<T>(result);
+          }
         }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+      });
 }
 #if defined(_MSC_VER)
 #pragma warning(pop)
@@ -1361,7 +1313,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
         ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
                       height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
                       extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                      Y->MutableData<float>(), get_original_coordinate_);
+                      Y->MutableData<float>(), get_original_coordinate_,
+                      output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
       }
       return Status::OK();
     }
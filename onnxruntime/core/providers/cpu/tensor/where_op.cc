@@ -4,9 +4,12 @@
 #include "core/providers/cpu/tensor/where_op.h"
 
 #include <algorithm>
+#include <array>
 #include <type_traits>
 
-#include "core/providers/cpu/math/element_wise_ops.h"  // for broadcast utilities
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -61,219 +64,186 @@ WHERE_TYPED_KERNEL_WITH_TYPE_NAME(std::string, string)
 
 namespace {
 
-template <typename T, typename R>
-using EnableIfEigenScalar = typename std::enable_if<std::is_arithmetic<T>::value, R>::type;
-
-template <typename T, typename R>
-using EnableIfEigenNotScalar = typename std::enable_if<!std::is_arithmetic<T>::value, R>::type;
-
-template <typename T>
-ProcessBroadcastSpanFuncs CreateScalarBroadcastFuncs() {
-  return ProcessBroadcastSpanFuncs{
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        bool condition = per_iter_bh.ScalarInput0<bool>();
-        auto value = per_iter_bh.EigenInput1<T>();
-        auto output = per_iter_bh.OutputEigen<T>();
-        if (condition == target) {
-          output = value;
-        } else {
-          output = EigenVectorMap<T>::PlainObject::Constant(value.size(), T{});
+constexpr size_t kNumWhereInputs = 3;  // condition, X, Y
+
+// The output shape of the multidirectional broadcast of condition, X and Y, as a list of axes along which each input
+// is either contiguous or broadcast. Adjacent axes that can be walked as one are merged, so the innermost axis is as
+// long as possible.
+struct WhereBroadcast {
+  Status Init(const std::array<const TensorShape*, kNumWhereInputs>& input_shapes, TensorShapeVector& output_dims) {
+    size_t rank = 0;
+    for (const TensorShape* shape : input_shapes) {
+      rank = std::max(rank, shape->NumDimensions());
+    }
+
+    // the dimensions of the inputs, right aligned and padded with 1
+    std::array<TensorShapeVector, kNumWhereInputs> input_dims;
+    for (size_t input = 0; input < kNumWhereInputs; ++input) {
+      const auto dims = input_shapes[input]->GetDims();
+      input_dims[input].assign(rank - dims.size(), 1);
+      input_dims[input].insert(input_dims[input].end(), dims.begin(), dims.end());
+    }
+
+    output_dims.assign(rank, 1);
+    for (size_t axis = 0; axis < rank; ++axis) {
+      for (size_t input = 0; input < kNumWhereInputs; ++input) {
+        const int64_t dim = input_dims[input][axis];
+        if (dim == 1) {
+          continue;
         }
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        auto condition = per_iter_bh.EigenInput0<bool>();
-        const T& value = per_iter_bh.ScalarInput1<T>();
-        auto output = per_iter_bh.OutputEigen<T>();
-        output = (condition.array() == target)
-                     .select(value, EigenVectorMap<T>::PlainObject::Constant(condition.size(), T{}));
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        auto condition = per_iter_bh.EigenInput0<bool>();
-        auto value = per_iter_bh.EigenInput1<T>();
-        auto output = per_iter_bh.OutputEigen<T>();
-        output = (condition.array() == target)
-                     .select(value, EigenVectorMap<T>::PlainObject::Constant(condition.size(), T{}));
-      }};
-}
-
-template <typename T>
-ProcessBroadcastSpanFuncs CreateNonScalarBroadcastFuncs() {
-  return ProcessBroadcastSpanFuncs{
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        bool condition = per_iter_bh.ScalarInput0<bool>();
-        auto value = per_iter_bh.SpanInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
-        if (condition == target) {
-          std::copy(value.begin(), value.end(), output.begin());
+        ORT_RETURN_IF_NOT(output_dims[axis] == 1 || output_dims[axis] == dim,
+                          "Where: the inputs cannot be broadcast. Condition shape: ", *input_shapes[0],
+                          " X shape: ", *input_shapes[1], " Y shape: ", *input_shapes[2]);
+        output_dims[axis] = dim;
+      }
+    }
+
+    // the strides of the inputs, 0 along the axes they are broadcast on
+    std::array<TensorShapeVector, kNumWhereInputs> input_strides;
+    for (size_t input = 0; input < kNumWhereInputs; ++input) {
+      input_strides[input].resize(rank);
+      int64_t stride = 1;
+      for (size_t axis = rank; axis-- > 0;) {
+        input_strides[input][axis] = input_dims[input][axis] == 1 ? 0 : stride;
+        stride *= input_dims[input][axis];
+      }
+    }
+
+    for (size_t axis = 0; axis < rank; ++axis) {
+      if (output_dims[axis] == 1) {
+        continue;
+      }
+      bool merge = !dims.empty();
+      for (size_t input = 0; merge && input < kNumWhereInputs; ++input) {
+        merge = strides[input].back() == input_strides[input][axis] * output_dims[axis];
+      }
+      for (size_t input = 0; input < kNumWhereInputs; ++input) {
+        if (merge) {
+          strides[input].back() = input_strides[input][axis];
         } else {
-          std::fill(output.begin(), output.end(), T{});
+          strides[input].push_back(input_strides[input][axis]);
         }
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        auto condition = per_iter_bh.SpanInput0<bool>();
-        const T& value = per_iter_bh.ScalarInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
-        std::transform(condition.begin(), condition.end(), output.begin(),
-                       [target, &value](bool condition_element) {
-                         return condition_element == target ? value : T{};
-                       });
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        bool target = (per_iter_bh.GetUserData() != nullptr);
-        auto condition = per_iter_bh.SpanInput0<bool>();
-        auto value = per_iter_bh.SpanInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
-        std::transform(condition.begin(), condition.end(), value.begin(), output.begin(),
-                       [target](bool condition_element, const T& value_element) {
-                         return condition_element == target ? value_element : T{};
-                       });
-      }};
-}
-
-template <typename T>
-EnableIfEigenScalar<T, ProcessBroadcastSpanFuncs> SelectBroadcastFuncs() {
-  // NOTE: Workaround a VS2017 bug by calling a separate function to create the broadcast funcs.
-  // If we create them directly here it doesn't bring in the definitions of the Eigen classes leading to
-  // a 'class has no constructors' error
-  return CreateScalarBroadcastFuncs<T>();
-}
-
-template <typename T>
-EnableIfEigenNotScalar<T, ProcessBroadcastSpanFuncs> SelectBroadcastFuncs() {
-  return CreateNonScalarBroadcastFuncs<T>();
-}
-
-template <typename T>
-void MergeScalarAndVector(EigenVectorMap<T> output, const T& scalar_value, ConstEigenVectorMap<T> vector_value) {
-  if (scalar_value != T{}) {
-    output = EigenVectorMap<T>::PlainObject::Constant(vector_value.size(), scalar_value);
-  } else {
-    output = vector_value;
+      }
+      if (merge) {
+        dims.back() *= output_dims[axis];
+      } else {
+        dims.push_back(output_dims[axis]);
+      }
+    }
+
+    if (dims.empty()) {
+      dims.push_back(1);
+      for (auto& strides_of_input : strides) {
+        strides_of_input.push_back(0);
+      }
+    }
+    return Status::OK();
   }
+
+  TensorShapeVector dims;
+  std::array<TensorShapeVector, kNumWhereInputs> strides;
 };
 
-template <typename T>
-EnableIfEigenScalar<T, ProcessBroadcastSpanFuncs> MergeBroadcastFuncs() {
-  return ProcessBroadcastSpanFuncs{
-      [](BroadcastHelper& per_iter_bh) {
-        MergeScalarAndVector(per_iter_bh.OutputEigen<T>(),
-                             per_iter_bh.ScalarInput0<T>(),  // X selection
-                             per_iter_bh.EigenInput1<T>());  // Y selection
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        MergeScalarAndVector(per_iter_bh.OutputEigen<T>(),
-                             per_iter_bh.ScalarInput1<T>(),  // Y selection
-                             per_iter_bh.EigenInput0<T>());  // X selection
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        auto X_selection = per_iter_bh.EigenInput0<T>();
-        auto Y_selection = per_iter_bh.EigenInput1<T>();
-        per_iter_bh.OutputEigen<T>() = X_selection.binaryExpr(Y_selection,
-                                                              [](T x, T y) -> T {
-                                                                return x != T{} ? x : y;
-                                                              });
-      }};
+// Selects count elements of a row of the output. Along the row each input is contiguous or broadcast, so a row is a
+// branchless blend of vectors or of a vector and a value, which compilers vectorize for the arithmetic types.
+template <typename T, bool kConditionVector, bool kXVector, bool kYVector>
+void SelectRow(const bool* condition, const T* x, const T* y, T* output, ptrdiff_t count) {
+  for (ptrdiff_t i = 0; i < count; ++i) {
+    const bool c = condition[kConditionVector ? i : 0];
+    if constexpr (std::is_arithmetic<T>::value) {
+      const T x_value = x[kXVector ? i : 0];
+      const T y_value = y[kYVector ? i : 0];
+      output[i] = c ? x_value : y_value;
+    } else {
+      output[i] = c ? x[kXVector ? i : 0] : y[kYVector ? i : 0];
+    }
+  }
 }
 
 template <typename T>
-void MergeScalarAndVector(gsl::span<T> output, const T& scalar_value, gsl::span<const T> vector_value) {
-  if (!scalar_value.empty()) {
-    std::fill(output.begin(), output.end(), scalar_value);
-  } else {
-    std::copy(vector_value.begin(), vector_value.end(), output.begin());
-  }
-};
+using SelectRowFunc = void (*)(const bool*, const T*, const T*, T*, ptrdiff_t);
 
 template <typename T>
-EnableIfEigenNotScalar<T, ProcessBroadcastSpanFuncs> MergeBroadcastFuncs() {
-  return ProcessBroadcastSpanFuncs{
-      [](BroadcastHelper& per_iter_bh) {
-        MergeScalarAndVector(per_iter_bh.OutputSpan<T>(),
-                             per_iter_bh.ScalarInput0<T>(),  // X selection
-                             per_iter_bh.SpanInput1<T>());   // Y selection
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        MergeScalarAndVector(per_iter_bh.OutputSpan<T>(),
-                             per_iter_bh.ScalarInput1<T>(),  // Y selection
-                             per_iter_bh.SpanInput0<T>());   // X selection
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        auto X_selection = per_iter_bh.SpanInput0<T>();
-        auto Y_selection = per_iter_bh.SpanInput1<T>();
-        auto output = per_iter_bh.OutputSpan<T>();
-        std::transform(X_selection.begin(), X_selection.end(), Y_selection.begin(), output.begin(),
-                       [](const T& x, const T& y) { return !x.empty() ? x : y; });
-      }};
-}
-
-// function pointer to create typed tensor from type agnostic code whilst avoiding the overhead of std::function
-using AllocTensorFunc = std::unique_ptr<Tensor> (*)(const TensorAllocator& allocator, const TensorShape& shape);
-
-static std::unique_ptr<Tensor> UntypedSelect(OpKernelContext& context, bool target,
-                                             const TensorAllocator& allocator, AllocTensorFunc allocate_tensor,
-                                             const ProcessBroadcastSpanFuncs& functors) {
-  const auto& condition = *context.Input<Tensor>(0);
-  // select the X input (input 1) for 'true', and Y input (input 2) for 'false'
-  const auto& values = *context.Input<Tensor>(target ? 1 : 2);
-
-  InputBroadcaster input_broadcaster(condition, values);
-
-  std::unique_ptr<Tensor> selection_tensor = allocate_tensor(allocator, input_broadcaster.GetOutputShape());
-  OutputBroadcaster output_broadcaster(input_broadcaster.GetSpanSize(), *selection_tensor);
-
-  // store value of 'target' directly in void* for user_data so it's accessible in the state-less functors
-  BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, reinterpret_cast<void*>(target));
-
-  BroadcastLooper(broadcast_helper, functors);
-
-  return selection_tensor;
+SelectRowFunc<T> GetSelectRowFunc(bool condition_vector, bool x_vector, bool y_vector) {
+  static const SelectRowFunc<T> funcs[] = {
+      SelectRow<T, false, false, false>, SelectRow<T, false, false, true>,
+      SelectRow<T, false, true, false>, SelectRow<T, false, true, true>,
+      SelectRow<T, true, false, false>, SelectRow<T, true, false, true>,
+      SelectRow<T, true, true, false>, SelectRow<T, true, true, true>};
+  return funcs[(condition_vector ? 4 : 0) + (x_vector ? 2 : 0) + (y_vector ? 1 : 0)];
 }
 
-static void UntypedMerge(OpKernelContext& context,
-                         const Tensor& X_selection_tensor, const Tensor& Y_selection_tensor,
-                         const ProcessBroadcastSpanFuncs& functors) {
-  InputBroadcaster merge_broadcaster{X_selection_tensor, Y_selection_tensor};
-  Tensor& output = *context.Output(0, merge_broadcaster.GetOutputShape());
-
-  OutputBroadcaster output_broadcaster{merge_broadcaster.GetSpanSize(), output};
-  BroadcastHelper broadcast_helper(merge_broadcaster, output_broadcaster);
-
-  BroadcastLooper(broadcast_helper, functors);
-}
 }  // namespace
 
 template <typename T>
 Status Where<T>::Compute(OpKernelContext* context) const {
-  // we use a func pointer to save the overhead of std::function, so we can't capture tensor_allocator here
-  const auto typed_tensor_allocation = [](const TensorAllocator& allocator,
-                                          const TensorShape& shape) {
-    return allocator.Allocate<T>(shape);
-  };
-
-  TensorAllocator tensor_allocator{*context};
-  ProcessBroadcastSpanFuncs funcs = SelectBroadcastFuncs<T>();
-
-  // The current implementation is limited to broadcasting over two tensors at once.
-  // So, we first broadcast over condition and X to select the values from X:
-  //   X_selection = condition ? X : default value
-  // Similarly, we broadcast over condition and Y to select the values from Y:
-  //   Y_selection = !condition ? Y : default value
-  //
-  // These selections are handled within UntypedSelect.
-  //
-  // Finally, we broadcast over and merge X_selection and Y_selection:
-  //   output = (X_selection != default value) ? X_selection : Y_selection
-  //
-  // The merging is handled within UntypedMerge.
-  auto X_selection_tensor = UntypedSelect(*context, true, tensor_allocator, typed_tensor_allocation, funcs);
-  auto Y_selection_tensor = UntypedSelect(*context, false, tensor_allocator, typed_tensor_allocation, funcs);
-
-  UntypedMerge(*context, *X_selection_tensor, *Y_selection_tensor, MergeBroadcastFuncs<T>());
+  const auto& condition_tensor = *context->Input<Tensor>(0);
+  const auto& X_tensor = *context->Input<Tensor>(1);
+  const auto& Y_tensor = *context->Input<Tensor>(2);
+
+  // A single pass over the output, reading the three inputs through their broadcast strides.
+  WhereBroadcast broadcast;
+  TensorShapeVector output_dims;
+  ORT_RETURN_IF_ERROR(broadcast.Init({&condition_tensor.Shape(), &X_tensor.Shape(), &Y_tensor.Shape()},
+                                     output_dims));
+
+  Tensor& output_tensor = *context->Output(0, TensorShape(output_dims));
+  const ptrdiff_t output_size = narrow<ptrdiff_t>(output_tensor.Shape().Size());
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  const bool* condition = condition_tensor.Data<bool>();
+  const T* X = X_tensor.Data<T>();
+  const T* Y = Y_tensor.Data<T>();
+  T* output = output_tensor.MutableData<T>();
+
+  const size_t outer_rank = broadcast.dims.size() - 1;
+  const ptrdiff_t row_size = narrow<ptrdiff_t>(broadcast.dims.back());
+  const auto select_row = GetSelectRowFunc<T>(broadcast.strides[0].back() != 0, broadcast.strides[1].back() != 0,
+                                              broadcast.strides[2].back() != 0);
+
+  // The work is split over the output elements rather than the rows, so that a single long row is split too.
+  const double bytes_per_element = 1.0 + 2.0 * sizeof(T);
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), output_size, TensorOpCost{bytes_per_element, sizeof(T), 1.0},
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        ptrdiff_t row = first / row_size;
+        ptrdiff_t column = first % row_size;
+
+        InlinedVector<int64_t> coords(outer_rank);
+        std::array<int64_t, kNumWhereInputs> offsets{};
+        for (size_t axis = outer_rank, remains = static_cast<size_t>(row); axis-- > 0;) {
+          const size_t dim = static_cast<size_t>(broadcast.dims[axis]);
+          coords[axis] = static_cast<int64_t>(remains % dim);
+          remains /= dim;
+          for (size_t input = 0; input < kNumWhereInputs; ++input) {
+            offsets[input] += coords[axis] * broadcast.strides[input][axis];
+          }
+        }
+
+        for (ptrdiff_t begin = first; begin < last; ++row, column = 0) {
+          const ptrdiff_t count = std::min(row_size - column, last - begin);
+          select_row(condition + offsets[0] + column * broadcast.strides[0].back(),
+                     X + offsets[1] + column * broadcast.strides[1].back(),
+                     Y + offsets[2] + column * broadcast.strides[2].back(),
+                     output + begin, count);
+          begin += count;
+
+          for (size_t axis = outer_rank; axis-- > 0;) {
+            for (size_t input = 0; input < kNumWhereInputs; ++input) {
+              offsets[input] += broadcast.strides[input][axis];
+            }
+            if (++coords[axis] < broadcast.dims[axis]) {
+              break;
+            }
+            for (size_t input = 0; input < kNumWhereInputs; ++input) {
+              offsets[input] -= coords[axis] * broadcast.strides[input][axis];
+            }
+            coords[axis] = 0;
+          }
+        }
+      });
 
   return Status::OK();
 }
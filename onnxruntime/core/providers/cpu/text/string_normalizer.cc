@@ -12,6 +12,8 @@
 #include <locale.h>
 #endif  // _MSC_VER
 
+#include <algorithm>
+#include <cassert>
 #include <codecvt>
 #include <locale>
 #include <functional>
@@ -436,6 +438,30 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS and not Apple
 #endif
 
 #endif  // _MSC_VER
+
+bool IsAscii(const std::string& str) {
+  // no early exit so that the loop is vectorized, the strings are usually short
+  unsigned char bits = 0;
+  for (const char ch : str) {
+    bits |= static_cast<unsigned char>(ch);
+  }
+  return bits < 0x80;
+}
+
+// Changes the case of the ASCII letters as the "C" locale, without branches so that the loop is vectorized.
+void ChangeCaseAscii(StringNormalizer::CaseAction caseaction, const std::string& src, std::string& dest) {
+  assert(caseaction != StringNormalizer::NONE);
+  dest.resize(src.size());
+  const unsigned char first = caseaction == StringNormalizer::LOWER ? 'A' : 'a';
+  const char* src_data = src.data();
+  char* dest_data = dest.data();
+  for (size_t i = 0, lim = src.size(); i < lim; ++i) {
+    const unsigned char ch = static_cast<unsigned char>(src_data[i]);
+    const unsigned char is_letter = static_cast<unsigned char>(ch - first) < 26;
+    dest_data[i] = static_cast<char>(ch ^ (is_letter << 5));
+  }
+}
+
 }  // namespace string_normalizer
 
 using namespace string_normalizer;
@@ -460,6 +486,22 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info) {
   }
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
+  if (case_change_action_ != NONE || !is_case_sensitive_) {
+    locale_ = std::make_unique<Locale>(locale_name_);
+
+    is_ascii_case_standard_ = true;
+    for (wchar_t ch = 0; ch < 128 && is_ascii_case_standard_; ++ch) {
+      std::wstring lower(1, ch);
+      std::wstring upper(1, ch);
+      locale_->ChangeCase(LOWER, lower);
+      locale_->ChangeCase(UPPER, upper);
+      const bool is_upper_letter = ch >= L'A' && ch <= L'Z';
+      const bool is_lower_letter = ch >= L'a' && ch <= L'z';
+      const wchar_t expected_lower = is_upper_letter ? static_cast<wchar_t>(ch + (L'a' - L'A')) : ch;
+      const wchar_t expected_upper = is_lower_letter ? static_cast<wchar_t>(ch - (L'a' - L'A')) : ch;
+      is_ascii_case_standard_ = lower == std::wstring(1, expected_lower) && upper == std::wstring(1, expected_upper);
+    }
+  }
 
   std::vector<std::string> stop_words = info.GetAttrsOrDefault<std::string>("stopwords");
   if (is_case_sensitive_) {
@@ -468,17 +510,26 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info) {
       stopwords_.insert(std::move(s));
     }
   } else {
-    Locale locale(locale_name_);
     Utf8Converter converter;
     wstopwords_.reserve(stop_words.size());
     for (std::string& s : stop_words) {
       std::wstring wstr = converter.from_bytes(s);
-      locale.ChangeCase(compare_caseaction_, wstr);
+      locale_->ChangeCase(compare_caseaction_, wstr);
+      if (std::all_of(wstr.begin(), wstr.end(), [](wchar_t ch) { return static_cast<uint32_t>(ch) < 128; })) {
+        std::string ascii_word;
+        ascii_word.reserve(wstr.size());
+        for (const wchar_t ch : wstr) {
+          ascii_word.push_back(static_cast<char>(ch));
+        }
+        ascii_wstopwords_.insert(std::move(ascii_word));
+      }
       wstopwords_.insert(std::move(wstr));
     }
   }
 }
 
+StringNormalizer::~StringNormalizer() = default;
+
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   using namespace string_normalizer;
 
@@ -523,12 +574,18 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   // to widechar, lowercase it and then compare. Case-insensitive comparison is complicated
   // for UTF-8 and requires additional dependency.
 
-  Locale locale(locale_name_);
+  const Locale* locale = locale_.get();
   Utf8Converter converter;
 
+  // ASCII strings are handled without wide chars if the locale allows it
+  auto is_ascii_fast_path = [this](const std::string& s) { return is_ascii_case_standard_ && IsAscii(s); };
+
   // Compute the largest widestring buffer needed.
   size_t max_wide_buffer_len = 0;
   for (const auto& s : input_span) {
+    if (is_ascii_fast_path(s)) {
+      continue;
+    }
     size_t wchars = 0;
     // Checks for invalid UTF-8 characters on Windows
     ORT_RETURN_IF_ERROR(converter.ComputeRequiredSizeToWideChar(s, wchars));
@@ -545,9 +602,13 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
     auto const output_data = output_tensor->MutableData<std::string>();
     for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
       const std::string& s = input_span[i];
+      if (is_ascii_fast_path(s)) {
+        ChangeCaseAscii(case_change_action_, s, output_data[i]);
+        continue;
+      }
       wchar_buffer.resize(max_wide_buffer_len);
       ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-      locale.ChangeCase(case_change_action_, wchar_buffer);
+      locale->ChangeCase(case_change_action_, wchar_buffer);
 
       auto& dest = output_data[i];
       size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
@@ -562,10 +623,12 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
     auto output_data = output_tensor->MutableData<std::string>();
     for (size_t i : filtered_indices) {
       const std::string& s = input_span[i];
-      if (case_change_action_ != NONE) {
+      if (case_change_action_ != NONE && is_ascii_fast_path(s)) {
+        ChangeCaseAscii(case_change_action_, s, *output_data++);
+      } else if (case_change_action_ != NONE) {
         wchar_buffer.resize(max_wide_buffer_len);
         ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(case_change_action_, wchar_buffer);
+        locale->ChangeCase(case_change_action_, wchar_buffer);
 
         auto& dest = *output_data++;
         size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
@@ -614,11 +677,19 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       // Otherwise, we need to pull ICU library on all platforms.
       InlinedVector<size_t> filtered_strings_indices;
       filtered_strings_indices.reserve(input_span.size());
+      std::string ascii_buffer;
       for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
         const std::string& s = input_span[i];
+        if (is_ascii_fast_path(s)) {
+          ChangeCaseAscii(compare_caseaction_, s, ascii_buffer);
+          if (ascii_wstopwords_.count(ascii_buffer) == 0) {
+            filtered_strings_indices.push_back(i);
+          }
+          continue;
+        }
         wchar_buffer.resize(max_wide_buffer_len);
         ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(compare_caseaction_, wchar_buffer);
+        locale->ChangeCase(compare_caseaction_, wchar_buffer);
         if (wstopwords_.count(wchar_buffer) == 0) {
           filtered_strings_indices.push_back(i);
         }
@@ -7,10 +7,15 @@
 #include "core/framework/op_kernel.h"
 
 #include <locale>
+#include <memory>
 #include <string>
 
 namespace onnxruntime {
 
+namespace string_normalizer {
+class Locale;
+}  // namespace string_normalizer
+
 class StringNormalizer : public OpKernel {
  public:
   enum CaseAction {
@@ -20,7 +25,7 @@ class StringNormalizer : public OpKernel {
   };
 
   explicit StringNormalizer(const OpKernelInfo& info);
-  ~StringNormalizer() override = default;
+  ~StringNormalizer() override;
 
   Status Compute(OpKernelContext* ctx) const override;
 
@@ -31,9 +36,15 @@ class StringNormalizer : public OpKernel {
   // used for case-insensitive compare
   CaseAction compare_caseaction_{LOWER};
   std::string locale_name_;
+  std::unique_ptr<string_normalizer::Locale> locale_;
+  // The locale changes the case of ASCII letters as the "C" locale and leaves the other ASCII characters, so the
+  // case of ASCII strings is changed in place without converting them to wide chars.
+  bool is_ascii_case_standard_{false};
   // Either if these are populated but not both
   InlinedHashSet<std::string> stopwords_;
   InlinedHashSet<std::wstring> wstopwords_;
+  // The ASCII words of wstopwords_, only ASCII strings can be equal to them after the case change
+  InlinedHashSet<std::string> ascii_wstopwords_;
 };
 
 }  // namespace onnxruntime
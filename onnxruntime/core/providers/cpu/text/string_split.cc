@@ -16,7 +16,7 @@ ONNX_CPU_OPERATOR_KERNEL(StringSplit, 20,
                          StringSplit);
 
 /// Calculate substrings in ``str`` delimited by ``delimiter``. A maximum of ``max_splits`` splits are permitted.
-/// Returns a vector of string slices into ``str`` representing the substrings as string views. The user must ensure
+/// Appends to ``out`` the string slices into ``str`` representing the substrings as string views. The user must ensure
 /// the returned views' lifetime does not exceed ``str``'s.
 void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t max_splits, InlinedVector<std::string_view>& out) {
   if (str.empty()) {
@@ -45,7 +45,8 @@ void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t
     size_t pos = 0;
     int64_t token_count = 0;
     while (pos != std::string::npos) {
-      auto next_pos = str.find(delimiter, pos);
+      // a single character is found with memchr
+      auto next_pos = delimiter.size() == 1 ? str.find(delimiter[0], pos) : str.find(delimiter, pos);
       if (token_count++ == max_splits || next_pos == std::string::npos) {
         out.push_back(str.substr(pos));
         break;
@@ -69,14 +70,15 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   auto num_tokens_data = context->Output(1, input->Shape())->template MutableDataAsSpan<int64_t>();
   auto num_tokens_iter = num_tokens_data.begin();
 
-  InlinedVector<InlinedVector<std::string_view>> input_slices;
-  input_slices.reserve(input_data.size());
+  // The substrings of all the inputs follow each other in a single buffer, num_tokens gives their boundaries.
+  InlinedVector<std::string_view> substrs;
+  substrs.reserve(input_data.size());
   size_t last_dim = 0;
 
   for (const auto& s : input_data) {
-    auto& substrs = input_slices.emplace_back();
+    const size_t first_substr = substrs.size();
     ComputeSubstrings(s, delimiter_, maxsplit_, substrs);
-    auto substr_count = substrs.size();
+    auto substr_count = substrs.size() - first_substr;
     last_dim = std::max(last_dim, substr_count);
     *num_tokens_iter = static_cast<int64_t>(substr_count);
     ++num_tokens_iter;
@@ -87,9 +89,12 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   splits_shape.push_back(last_dim);
 
   auto splits_data = context->Output(0, splits_shape)->template MutableDataAsSpan<std::string>();
-  auto slices_iter = input_slices.begin();
-  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++slices_iter) {
-    std::copy(slices_iter->begin(), slices_iter->end(), output_splits_iter);
+  auto substrs_iter = substrs.cbegin();
+  num_tokens_iter = num_tokens_data.begin();
+  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++num_tokens_iter) {
+    // short substrings fit in the inline buffer of std::string and are not allocated
+    std::copy(substrs_iter, substrs_iter + *num_tokens_iter, output_splits_iter);
+    substrs_iter += *num_tokens_iter;
   }
 
   return Status::OK();
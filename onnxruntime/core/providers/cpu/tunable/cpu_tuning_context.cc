@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
+
+#include <limits>
+#include <string>
+#include <thread>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/op_kernel_info.h"
+#include "core/framework/tuning_context.h"
+// The CPU EP is always built into the main library, so this is the one translation unit of it that defines the
+// TuningContext methods. EPs built as shared libraries include their own copy.
+#define TUNING_CONTEXT_IMPL
+#include "core/framework/tuning_context_impl.h"
+#undef TUNING_CONTEXT_IMPL
+#include "core/providers/cpu/cpu_execution_provider.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+std::string CpuTuningResultsValidator::GetCpuVendor() const {
+  return std::string{CPUIDInfo::GetCPUIDInfo().GetCPUVendor()};
+}
+
+Status CpuTuningResultsValidator::ValidateCpuVendor(const std::string& value) const {
+  auto current = GetCpuVendor();
+  ORT_RETURN_IF(current != value, "CPU vendor mismatch: tuning results produced with CPU ", value,
+                ", onnxruntime currently run with CPU ", current);
+  return Status::OK();
+}
+
+std::string CpuTuningResultsValidator::GetCpuThreads() const {
+  return std::to_string(std::thread::hardware_concurrency());
+}
+
+Status CpuTuningResultsValidator::ValidateCpuThreads(const std::string& value) const {
+  auto current = GetCpuThreads();
+  ORT_RETURN_IF(current != value, "CPU thread count mismatch: tuning results produced with ", value,
+                " hardware threads, onnxruntime currently run with ", current);
+  return Status::OK();
+}
+
+CpuTuningResultsValidator::CpuTuningResultsValidator() {
+  RegisterValidator(
+      "CPU_VENDOR",
+      [this]() { return GetCpuVendor(); },
+      [this](const std::string& value) { return ValidateCpuVendor(value); });
+  RegisterValidator(
+      "CPU_THREADS",
+      [this]() { return GetCpuThreads(); },
+      [this](const std::string& value) { return ValidateCpuThreads(value); });
+}
+
+CpuTuningContext::CpuTuningContext(CPUExecutionProvider* ep, TunableOpInfo* info)
+    : ITuningContext(ep), info_(info) {}
+
+void CpuTuningContext::EnableTunableOp() {
+  LOGS_DEFAULT(INFO) << "Enable TunableOp for CPU Execution Provider";
+  info_->enable = true;
+}
+
+void CpuTuningContext::DisableTunableOp() {
+  LOGS_DEFAULT(INFO) << "Disable TunableOp for CPU Execution Provider";
+  info_->enable = false;
+}
+
+bool CpuTuningContext::IsTunableOpEnabled() const {
+  return info_->enable;
+}
+
+void CpuTuningContext::EnableTuning() {
+  LOGS_DEFAULT(INFO) << "Enable TunableOp tuning for CPU Execution Provider";
+  info_->tuning_enable = true;
+}
+
+void CpuTuningContext::DisableTuning() {
+  LOGS_DEFAULT(INFO) << "Disable TunableOp tuning for CPU Execution Provider";
+  info_->tuning_enable = false;
+}
+
+bool CpuTuningContext::IsTuningEnabled() const {
+  return info_->tuning_enable;
+}
+
+void CpuTuningContext::SetMaxTuningDurationMs(int max_duration_ms) {
+  info_->max_tuning_duration_ms = max_duration_ms;
+}
+
+int CpuTuningContext::GetMaxTuningDurationMs() const {
+  return info_->max_tuning_duration_ms > 0 ? info_->max_tuning_duration_ms : std::numeric_limits<int>::max();
+}
+
+TuningResultsManager& CpuTuningContext::GetTuningResultsManager() {
+  return manager_;
+}
+
+const TuningResultsManager& CpuTuningContext::GetTuningResultsManager() const {
+  return manager_;
+}
+
+const TuningResultsValidator& CpuTuningContext::GetTuningResultsValidator() const {
+  return validator_;
+}
+
+CpuTuningContext* GetCpuTuningContext(const OpKernelInfo& info) {
+  const auto* ep = info.GetExecutionProvider();
+  if (ep == nullptr || ep->Type() != kCpuExecutionProvider) {
+    return nullptr;
+  }
+  return static_cast<CpuTuningContext*>(ep->GetTuningContext());
+}
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
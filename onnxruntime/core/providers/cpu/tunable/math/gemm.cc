@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tunable/math/gemm.h"
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+SgemmBatchParams::SgemmBatchParams(CpuTuningContext* tuning_ctx, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                                   size_t m, size_t n, size_t k, const MLAS_SGEMM_DATA_PARAMS* data,
+                                   size_t batch_size, concurrency::ThreadPool* thread_pool,
+                                   const MLAS_SGEMM_SPARSE_B* sparse_b)
+    : OpParams(tuning_ctx, nullptr),
+      trans_a_(trans_a),
+      trans_b_(trans_b),
+      m_(m),
+      n_(n),
+      k_(k),
+      data_(data),
+      batch_size_(batch_size),
+      thread_pool_(thread_pool),
+      sparse_b_(sparse_b) {}
+
+std::string SgemmBatchParams::Signature() const {
+  // the threads available are part of the problem, the results of a session with a smaller pool don't apply
+  return MakeString((trans_a_ == CblasTrans ? "T" : "N"), (trans_b_ == CblasTrans ? "T" : "N"), "_", m_, "_", n_,
+                    "_", k_, "_", batch_size_, (data_[0].BIsPacked ? "_packed" : ""),
+                    (sparse_b_ ? MakeString("_sparse", sparse_b_->ColumnStart[sparse_b_->N]) : std::string{}), "_",
+                    concurrency::ThreadPool::DegreeOfParallelism(thread_pool_));
+}
+
+namespace {
+
+// MLAS partitions each GEMM of the batch over the threads
+Status DefaultSgemmBatchOp(const SgemmBatchParams* params) {
+  MlasGemmBatch(params->trans_a_, params->trans_b_, params->m_, params->n_, params->k_, params->data_,
+                params->batch_size_, params->thread_pool_);
+  return Status::OK();
+}
+
+// small GEMMs may not be worth handing to other threads
+Status SingleThreadedSgemmBatchOp(const SgemmBatchParams* params) {
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(concurrency::ThreadPool::DegreeOfParallelism(params->thread_pool_) < 2,
+                                            "There is no thread pool to compare with");
+  MlasGemmBatch(params->trans_a_, params->trans_b_, params->m_, params->n_, params->k_, params->data_,
+                params->batch_size_, nullptr);
+  return Status::OK();
+}
+
+// each thread computes whole GEMMs of the batch, which avoids splitting the small ones
+Status BatchParallelSgemmBatchOp(const SgemmBatchParams* params) {
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(concurrency::ThreadPool::DegreeOfParallelism(params->thread_pool_) < 2 ||
+                                                params->batch_size_ < 2,
+                                            "Requires a thread pool and a batch of GEMMs");
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      params->thread_pool_, static_cast<std::ptrdiff_t>(params->batch_size_), [params](std::ptrdiff_t i) {
+        MlasGemmBatch(params->trans_a_, params->trans_b_, params->m_, params->n_, params->k_, params->data_ + i, 1,
+                      nullptr);
+      });
+  return Status::OK();
+}
+
+// the work of MlasSparseGemm is proportional to the non-zero elements of B, which pays off for sparse enough weights
+Status SparseSgemmBatchOp(const SgemmBatchParams* params) {
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(params->sparse_b_ == nullptr || params->trans_a_ != CblasNoTrans,
+                                            "Requires a sparse B and a non transposed A");
+  for (size_t i = 0; i < params->batch_size_; ++i) {
+    const auto& data = params->data_[i];
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(data.alpha != 1.0f || data.beta != 0.0f,
+                                              "Requires an alpha of 1 and a beta of 0");
+  }
+
+  for (size_t i = 0; i < params->batch_size_; ++i) {
+    const auto& data = params->data_[i];
+    MlasSparseGemm(params->m_, params->sparse_b_, data.A, data.lda, data.C, data.ldc, params->thread_pool_);
+  }
+  return Status::OK();
+}
+
+class SgemmBatchTunableOp : public TunableOp<SgemmBatchParams> {
+ public:
+  SgemmBatchTunableOp() {
+    this->RegisterOp(DefaultSgemmBatchOp);
+    this->RegisterOp(SingleThreadedSgemmBatchOp);
+    this->RegisterOp(BatchParallelSgemmBatchOp);
+    this->RegisterOp(SparseSgemmBatchOp);
+  }
+};
+
+}  // namespace
+
+Status TunableSgemmBatch(CpuTuningContext* tuning_ctx, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                         size_t m, size_t n, size_t k, const MLAS_SGEMM_DATA_PARAMS* data, size_t batch_size,
+                         concurrency::ThreadPool* thread_pool, const MLAS_SGEMM_SPARSE_B* sparse_b) {
+  SgemmBatchParams params(tuning_ctx, trans_a, trans_b, m, n, k, data, batch_size, thread_pool, sparse_b);
+  if (tuning_ctx != nullptr && tuning_ctx->IsTunableOpEnabled()) {
+    static SgemmBatchTunableOp sgemm_batch{};
+    return sgemm_batch(&params);
+  }
+
+  if (sparse_b != nullptr && SparseSgemmBatchOp(&params).IsOK()) {
+    return Status::OK();
+  }
+
+  return DefaultSgemmBatchOp(&params);
+}
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/status.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tunable/cpu_tunable.h"
+
+namespace onnxruntime {
+namespace cpu {
+namespace tunable {
+
+struct SgemmBatchParams : OpParams {
+  SgemmBatchParams(CpuTuningContext* tuning_ctx, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                   size_t m, size_t n, size_t k, const MLAS_SGEMM_DATA_PARAMS* data, size_t batch_size,
+                   concurrency::ThreadPool* thread_pool, const MLAS_SGEMM_SPARSE_B* sparse_b = nullptr);
+
+  std::string Signature() const override;
+
+  CBLAS_TRANSPOSE trans_a_;
+  CBLAS_TRANSPOSE trans_b_;
+  size_t m_;
+  size_t n_;
+  size_t k_;
+  const MLAS_SGEMM_DATA_PARAMS* data_;
+  size_t batch_size_;
+  concurrency::ThreadPool* thread_pool_;
+  // B of every GEMM of the batch in sparse form, if the caller has one
+  const MLAS_SGEMM_SPARSE_B* sparse_b_;
+};
+
+// MlasGemmBatch, with the partitioning of the work over the threads chosen by tuning if TunableOp is enabled on
+// tuning_ctx. tuning_ctx may be nullptr. Tuning runs the GEMMs several times, so the beta of data must be 0.
+// If sparse_b is given, the batch may also run through MlasSparseGemm: always if TunableOp is disabled, otherwise
+// when it's measured to be faster than the dense GEMMs.
+Status TunableSgemmBatch(CpuTuningContext* tuning_ctx, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+                         size_t m, size_t n, size_t k, const MLAS_SGEMM_DATA_PARAMS* data, size_t batch_size,
+                         concurrency::ThreadPool* thread_pool, const MLAS_SGEMM_SPARSE_B* sparse_b = nullptr);
+
+}  // namespace tunable
+}  // namespace cpu
+}  // namespace onnxruntime
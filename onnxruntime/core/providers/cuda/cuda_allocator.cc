@@ -2,8 +2,12 @@
 // Licensed under the MIT License.
 
 #include "cuda_allocator.h"
+
+#include <algorithm>
+
 #include "cuda_common.h"
 #include "gpu_data_transfer.h"
+#include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
 
@@ -86,6 +90,105 @@ void* CUDAExternalAllocator::Reserve(size_t size) {
   return p;
 }
 
+CUDAMemPoolAllocator::CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name,
+                                           size_t release_threshold)
+    : CUDAAllocator(device_id, name) {
+  SetDevice(true);
+  cudaMemPoolProps props{};
+  props.allocType = cudaMemAllocationTypePinned;
+  props.handleTypes = cudaMemHandleTypeNone;
+  props.location.type = cudaMemLocationTypeDevice;
+  props.location.id = device_id;
+  CUDA_CALL_THROW(cudaMemPoolCreate(&pool_, &props));
+
+  uint64_t threshold = release_threshold;
+  CUDA_CALL_THROW(cudaMemPoolSetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+}
+
+CUDAMemPoolAllocator::~CUDAMemPoolAllocator() {
+  cudaMemPoolDestroy(pool_);  // do not throw error since it's OK to fail during shutdown
+}
+
+void* CUDAMemPoolAllocator::AllocFromPool(size_t size, cudaStream_t stream) {
+  SetDevice(true);
+  CheckDevice(true);
+  void* p = nullptr;
+  if (size > 0) {
+    CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, stream));
+
+    std::lock_guard<std::mutex> lock(lock_);
+    allocations_.emplace(p, Allocation{stream, size});
+    stats_.num_allocs++;
+    stats_.bytes_in_use += static_cast<int64_t>(size);
+    stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+    stats_.max_alloc_size = std::max(stats_.max_alloc_size, static_cast<int64_t>(size));
+  }
+  return p;
+}
+
+void* CUDAMemPoolAllocator::Alloc(size_t size) {
+  // without a stream, the memory may be used on any stream, so the allocation must be complete when it is returned.
+  void* p = AllocFromPool(size, nullptr);
+  if (p != nullptr) {
+    CUDA_CALL_THROW(cudaStreamSynchronize(nullptr));
+  }
+  return p;
+}
+
+void* CUDAMemPoolAllocator::AllocOnStream(size_t size, Stream* stream) {
+  if (stream == nullptr || stream->GetHandle() == nullptr || stream->GetDevice() != Info().device) {
+    return Alloc(size);
+  }
+  return AllocFromPool(size, static_cast<cudaStream_t>(stream->GetHandle()));
+}
+
+void CUDAMemPoolAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  Allocation allocation;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = allocations_.find(p);
+    ORT_ENFORCE(it != allocations_.end(), "Freeing memory that was not allocated by ", Info().name);
+    allocation = it->second;
+    allocations_.erase(it);
+    stats_.bytes_in_use -= static_cast<int64_t>(allocation.size);
+  }
+
+  SetDevice(false);
+  if (allocation.stream == nullptr) {
+    // like cudaFree, wait for the work of all the streams that may still use the memory.
+    cudaDeviceSynchronize();
+  }
+  cudaFreeAsync(p, allocation.stream);  // do not throw error since it's OK to fail during shutdown
+}
+
+void CUDAMemPoolAllocator::ReleaseStreamBuffers(Stream* stream) {
+  auto handle = static_cast<cudaStream_t>(stream->GetHandle());
+  if (handle == nullptr) {
+    return;
+  }
+
+  // the memory still in use, e.g. the outputs of a run, outlives the stream and is freed like memory from Alloc().
+  std::lock_guard<std::mutex> lock(lock_);
+  for (auto& entry : allocations_) {
+    if (entry.second.stream == handle) {
+      entry.second.stream = nullptr;
+    }
+  }
+}
+
+void CUDAMemPoolAllocator::GetStats(AllocatorStats* stats) {
+  uint64_t reserved_bytes = 0;
+  CUDA_CALL_THROW(cudaMemPoolGetAttribute(pool_, cudaMemPoolAttrReservedMemCurrent, &reserved_bytes));
+
+  std::lock_guard<std::mutex> lock(lock_);
+  *stats = stats_;
+  stats->total_allocated_bytes = static_cast<int64_t>(reserved_bytes);
+}
+
 void* CUDAPinnedAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
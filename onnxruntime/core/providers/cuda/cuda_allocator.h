@@ -5,6 +5,7 @@
 
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
+#include "core/providers/cuda/cuda_pch.h"
 #include <mutex>
 
 namespace onnxruntime {
@@ -50,6 +51,37 @@ class CUDAExternalAllocator : public CUDAAllocator {
   InlinedHashSet<void*> reserved_;
 };
 
+// Allocates device memory from a stream-ordered CUDA memory pool (cudaMallocFromPoolAsync) owned by the allocator.
+// Memory allocated on a Stream is allocated and freed in the order of the work on the stream, so the driver reuses
+// it across streams without an arena on the CPU side. When a stream synchronizes, the pool keeps up to
+// release_threshold bytes of freed memory cached and returns the rest to the device.
+class CUDAMemPoolAllocator : public CUDAAllocator {
+ public:
+  CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, size_t release_threshold);
+  ~CUDAMemPoolAllocator() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  bool IsStreamAware() const override { return true; }
+  void* AllocOnStream(size_t size, Stream* stream) override;
+  void ReleaseStreamBuffers(Stream* stream) override;
+  void GetStats(AllocatorStats* stats) override;
+
+ private:
+  struct Allocation {
+    // stream the memory is freed on, or nullptr if it may be used on any stream.
+    cudaStream_t stream;
+    size_t size;
+  };
+
+  void* AllocFromPool(size_t size, cudaStream_t stream);
+
+  cudaMemPool_t pool_{};
+  std::mutex lock_;
+  InlinedHashMap<void*, Allocation> allocations_;
+  AllocatorStats stats_;
+};
+
 // TODO: add a default constructor
 class CUDAPinnedAllocator : public IAllocator {
  public:
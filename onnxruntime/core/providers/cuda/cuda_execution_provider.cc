@@ -11,6 +11,7 @@
 #include "core/providers/cuda/cuda_execution_provider.h"
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/cuda_allocator.h"
+#include "core/providers/cuda/cuda_external_data_loader.h"
 #include "core/providers/cuda/cuda_fwd.h"
 #include "core/providers/cuda/gpu_data_transfer.h"
 #include "core/providers/cuda/cuda_profiler.h"
@@ -2713,6 +2714,13 @@ std::unique_ptr<onnxruntime::IDataTransfer> CUDAExecutionProvider::GetDataTransf
   return std::make_unique<onnxruntime::GPUDataTransfer>();
 }
 
+std::unique_ptr<onnxruntime::IExternalDataLoader> CUDAExecutionProvider::GetExternalDataLoader() const {
+  if (info_.external_data_load_chunk_size == 0) {
+    return nullptr;
+  }
+  return std::make_unique<CudaExternalDataLoader>(info_.device_id, info_.external_data_load_chunk_size);
+}
+
 std::vector<std::unique_ptr<ComputeCapability>>
 CUDAExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph,
                                      const IKernelLookup& kernel_lookup,
@@ -2895,9 +2903,24 @@ std::vector<AllocatorPtr> CUDAExecutionProvider::CreatePreferredAllocators() {
         return std::make_unique<CUDAPinnedAllocator>(device_id, CUDA_PINNED);
       },
       info_.device_id);
+
+  AllocatorPtr default_allocator;
+  if (info_.use_cuda_mempool && !info_.external_allocator_info.UseExternalAllocator()) {
+    if (info_.enable_cuda_graph) {
+      // stream-ordered allocations during capture would become part of the graph and not outlive its replay.
+      LOGS_DEFAULT(WARNING) << "use_cuda_mempool is not supported with CUDA graphs, the BFC Arena is used instead.";
+    } else {
+      default_allocator = std::make_shared<CUDAMemPoolAllocator>(info_.device_id, CUDA,
+                                                                 info_.cuda_mempool_release_threshold);
+    }
+  }
+  if (!default_allocator) {
+    default_allocator = CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
+                                            info_.external_allocator_info, info_.default_memory_arena_cfg);
+  }
+
   return std::vector<AllocatorPtr>{
-      CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
-                          info_.external_allocator_info, info_.default_memory_arena_cfg),
+      std::move(default_allocator),
       CreateAllocator(pinned_memory_info),
   };
 }
@@ -36,6 +36,9 @@ constexpr const char* kUseEPLevelUnifiedStream = "use_ep_level_unified_stream";
 constexpr const char* kUseTF32 = "use_tf32";
 constexpr const char* kFuseConvBias = "fuse_conv_bias";
 constexpr const char* kSdpaKernel = "sdpa_kernel";
+constexpr const char* kUseCudaMemPool = "use_cuda_mempool";
+constexpr const char* kCudaMemPoolReleaseThreshold = "cuda_mempool_release_threshold";
+constexpr const char* kExternalDataLoadChunkSize = "external_data_load_chunk_size";
 
 }  // namespace provider_option_names
 }  // namespace cuda
@@ -121,6 +124,11 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
           .AddAssignmentToReference(cuda::provider_option_names::kUseTF32, info.use_tf32)
           .AddAssignmentToReference(cuda::provider_option_names::kSdpaKernel, info.sdpa_kernel)
           .AddAssignmentToReference(cuda::provider_option_names::kFuseConvBias, info.fuse_conv_bias)
+          .AddAssignmentToReference(cuda::provider_option_names::kUseCudaMemPool, info.use_cuda_mempool)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudaMemPoolReleaseThreshold,
+                                    info.cuda_mempool_release_threshold)
+          .AddAssignmentToReference(cuda::provider_option_names::kExternalDataLoadChunkSize,
+                                    info.external_data_load_chunk_size)
           .AddValueParser(
               cuda::provider_option_names::kTunableOpEnable,
               [&info](const std::string& value_str) -> Status {
@@ -176,6 +184,11 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const CUDAExecution
       {cuda::provider_option_names::kUseTF32, MakeStringWithClassicLocale(info.use_tf32)},
       {cuda::provider_option_names::kSdpaKernel, MakeStringWithClassicLocale(info.sdpa_kernel)},
       {cuda::provider_option_names::kFuseConvBias, MakeStringWithClassicLocale(info.fuse_conv_bias)},
+      {cuda::provider_option_names::kUseCudaMemPool, MakeStringWithClassicLocale(info.use_cuda_mempool)},
+      {cuda::provider_option_names::kCudaMemPoolReleaseThreshold,
+       MakeStringWithClassicLocale(info.cuda_mempool_release_threshold)},
+      {cuda::provider_option_names::kExternalDataLoadChunkSize,
+       MakeStringWithClassicLocale(info.external_data_load_chunk_size)},
   };
 
   return options;
@@ -200,6 +213,11 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const OrtCUDAProvid
       {cuda::provider_option_names::kUseTF32, MakeStringWithClassicLocale(info.use_tf32)},
       {cuda::provider_option_names::kFuseConvBias, MakeStringWithClassicLocale(info.fuse_conv_bias)},
       {cuda::provider_option_names::kSdpaKernel, MakeStringWithClassicLocale(info.sdpa_kernel)},
+      {cuda::provider_option_names::kUseCudaMemPool, MakeStringWithClassicLocale(info.use_cuda_mempool)},
+      {cuda::provider_option_names::kCudaMemPoolReleaseThreshold,
+       MakeStringWithClassicLocale(info.cuda_mempool_release_threshold)},
+      {cuda::provider_option_names::kExternalDataLoadChunkSize,
+       MakeStringWithClassicLocale(info.external_data_load_chunk_size)},
   };
 
   return options;
@@ -82,6 +82,15 @@ struct CUDAExecutionProviderInfo {
 
   int sdpa_kernel{0};
 
+  // Allocate device memory from a stream-ordered CUDA memory pool (cudaMallocFromPoolAsync) instead of the BFC Arena.
+  // The pool keeps up to cuda_mempool_release_threshold bytes of freed memory cached when a stream synchronizes.
+  bool use_cuda_mempool{false};
+  size_t cuda_mempool_release_threshold{std::numeric_limits<size_t>::max()};
+
+  // Load external initializers straight into device memory, reading the file in chunks of this many bytes into
+  // pinned host buffers while the previous chunk is copied to the device. 0 reads them into host memory first.
+  size_t external_data_load_chunk_size{0};
+
   static CUDAExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const CUDAExecutionProviderInfo& info);
   static ProviderOptions ToProviderOptions(const OrtCUDAProviderOptionsV2& info);
@@ -115,6 +124,9 @@ struct std::hash<::onnxruntime::CUDAExecutionProviderInfo> {
     onnxruntime::HashCombine(info.gpu_mem_limit, value);
     onnxruntime::HashCombine(info.tunable_op.max_tuning_duration_ms, value);
     onnxruntime::HashCombine(info.sdpa_kernel, value);
+    onnxruntime::HashCombine(info.use_cuda_mempool, value);
+    onnxruntime::HashCombine(info.cuda_mempool_release_threshold, value);
+    onnxruntime::HashCombine(info.external_data_load_chunk_size, value);
 
     // Memory pointers
     onnxruntime::HashCombine(reinterpret_cast<size_t>(info.user_compute_stream), value);
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "core/providers/shared_library/provider_api.h"
+
+#include "core/providers/cuda/cuda_external_data_loader.h"
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+
+CudaExternalDataLoader::CudaExternalDataLoader(OrtDevice::DeviceId device_id, size_t chunk_size)
+    : device_id_(device_id), chunk_size_(chunk_size) {
+  ORT_ENFORCE(chunk_size_ > 0, "The chunk size of the CUDA external data loader must be positive.");
+}
+
+CudaExternalDataLoader::~CudaExternalDataLoader() {
+  if (stream_ == nullptr) {
+    return;
+  }
+
+  int prev_device = 0;
+  ORT_IGNORE_RETURN_VALUE(CUDA_CALL(cudaGetDevice(&prev_device)));
+  ORT_IGNORE_RETURN_VALUE(CUDA_CALL(cudaSetDevice(device_id_)));
+  for (int i = 0; i < 2; ++i) {
+    ORT_IGNORE_RETURN_VALUE(CUDA_CALL(cudaEventDestroy(copied_events_[i])));
+    ORT_IGNORE_RETURN_VALUE(CUDA_CALL(cudaFreeHost(pinned_buffers_[i])));
+  }
+  ORT_IGNORE_RETURN_VALUE(CUDA_CALL(cudaStreamDestroy(stream_)));
+  ORT_IGNORE_RETURN_VALUE(CUDA_CALL(cudaSetDevice(prev_device)));
+}
+
+bool CudaExternalDataLoader::CanLoad(const OrtMemoryInfo& target_memory_info) const {
+  const auto& device = target_memory_info.device;
+  return device.Type() == OrtDevice::GPU && device.Vendor() == OrtDevice::VendorIds::NVIDIA &&
+         device.MemType() == OrtDevice::MemType::DEFAULT && device.Id() == device_id_;
+}
+
+common::Status CudaExternalDataLoader::LoadTensor(const Env& env,
+                                                  const std::filesystem::path& data_file_path,
+                                                  FileOffsetType data_offset,
+                                                  SafeInt<size_t> data_length,
+                                                  Tensor& tensor) const {
+  const size_t length = data_length;
+  ORT_RETURN_IF_NOT(length == tensor.SizeInBytes(), "External data length ", length,
+                    " does not match the tensor size ", tensor.SizeInBytes());
+  if (length == 0) {
+    return Status::OK();
+  }
+
+  // the session loads its initializers one at a time, but the loader may be shared by sessions on other threads
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  int prev_device = 0;
+  CUDA_RETURN_IF_ERROR(cudaGetDevice(&prev_device));
+  CUDA_RETURN_IF_ERROR(cudaSetDevice(device_id_));
+  auto restore_device = gsl::finally([prev_device]() { ORT_IGNORE_RETURN_VALUE(cudaSetDevice(prev_device)); });
+
+  if (stream_ == nullptr) {
+    for (int i = 0; i < 2; ++i) {
+      CUDA_RETURN_IF_ERROR(cudaHostAlloc(&pinned_buffers_[i], chunk_size_, cudaHostAllocDefault));
+      CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&copied_events_[i], cudaEventDisableTiming));
+    }
+    CUDA_RETURN_IF_ERROR(cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking));
+  }
+
+  auto* dst = static_cast<char*>(tensor.MutableDataRaw());
+  size_t chunk_index = 0;
+  for (size_t offset = 0; offset < length; offset += chunk_size_, ++chunk_index) {
+    const size_t buffer_index = chunk_index % 2;
+    const size_t chunk_length = std::min(chunk_size_, length - offset);
+    auto* buffer = static_cast<char*>(pinned_buffers_[buffer_index]);
+
+    // wait for the copy of the chunk read into this buffer two chunks ago
+    CUDA_RETURN_IF_ERROR(cudaEventSynchronize(copied_events_[buffer_index]));
+    ORT_RETURN_IF_ERROR(env.ReadFileIntoBuffer(data_file_path.c_str(),
+                                               data_offset + static_cast<FileOffsetType>(offset), chunk_length,
+                                               gsl::make_span(buffer, chunk_length)));
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst + offset, buffer, chunk_length, cudaMemcpyHostToDevice, stream_));
+    CUDA_RETURN_IF_ERROR(cudaEventRecord(copied_events_[buffer_index], stream_));
+  }
+
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream_));
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+
+#include "cuda_pch.h"
+#include "core/framework/external_data_loader.h"
+
+namespace onnxruntime {
+
+// Loads external initializers straight into CUDA device memory. The file is read in chunks into two pinned host
+// buffers, so reading a chunk overlaps with the asynchronous copy of the previous one to the device, instead of
+// reading the whole initializer into pageable host memory before a synchronous copy.
+class CudaExternalDataLoader : public IExternalDataLoader {
+ public:
+  CudaExternalDataLoader(OrtDevice::DeviceId device_id, size_t chunk_size);
+  ~CudaExternalDataLoader() override;
+
+  bool CanLoad(const OrtMemoryInfo& target_memory_info) const override;
+
+  common::Status LoadTensor(const Env& env,
+                            const std::filesystem::path& data_file_path,
+                            FileOffsetType data_offset,
+                            SafeInt<size_t> data_length,
+                            Tensor& tensor) const override;
+
+ private:
+  const OrtDevice::DeviceId device_id_;
+  const size_t chunk_size_;
+
+  // the pinned buffers, stream and events are created on first use and reused by the following loads
+  mutable std::mutex mutex_;
+  mutable void* pinned_buffers_[2] = {nullptr, nullptr};
+  mutable cudaStream_t stream_ = nullptr;
+  mutable cudaEvent_t copied_events_[2] = {nullptr, nullptr};
+};
+
+}  // namespace onnxruntime
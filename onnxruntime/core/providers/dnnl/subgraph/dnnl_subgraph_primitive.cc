@@ -35,6 +35,7 @@
 #include "dnnl_relugrad.h"
 #endif
 
+#include <algorithm>
 #include <inttypes.h>
 #include <stdio.h>
 #include <iostream>
@@ -276,11 +277,30 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
     key += "|";
   }
   // if key different from shape key, update and recompile
-  if (key != shape_key_) {
-    shape_key_ = key;
-  } else {
+  if (key == shape_key_) {
+    return;
+  }
+
+  // keep the state compiled for the previous shapes, and reuse the state compiled for these shapes if any
+  if (!shape_key_.empty()) {
+    CompiledState previous;
+    SwapCompiledState(previous);
+    cached_shapes_.emplace_front(std::move(shape_key_), std::move(previous));
+    if (cached_shapes_.size() > kMaxCachedShapes) {
+      cached_shapes_.pop_back();
+    }
+  }
+  shape_key_ = key;
+
+  auto cached = std::find_if(cached_shapes_.begin(), cached_shapes_.end(),
+                             [&key](const std::pair<std::string, CompiledState>& entry) { return entry.first == key; });
+  if (cached != cached_shapes_.end()) {
+    LOGS_DEFAULT(INFO) << "Reusing compiled shapes";
+    SwapCompiledState(cached->second);
+    cached_shapes_.erase(cached);
     return;
   }
+
   if (IsDynamic()) {
     LOGS_DEFAULT(INFO) << "Dynamic Compile";
   } else {
@@ -321,6 +341,19 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
   AddOutputs();
 }
 
+void DnnlSubgraphPrimitive::SwapCompiledState(CompiledState& state) {
+  intermediates_.swap(state.intermediates);
+  inputs_.swap(state.inputs);
+  inputs_md_.swap(state.inputs_md);
+  outputs_.swap(state.outputs);
+  outputs_md_.swap(state.outputs_md);
+  outputs_are_always_copied_.swap(state.outputs_are_always_copied);
+  net_.swap(state.net);
+  net_args_.swap(state.net_args);
+  reshapes_.swap(state.reshapes);
+  scalar_outputs_.swap(state.scalar_outputs);
+}
+
 dnnl::memory::format_tag DnnlSubgraphPrimitive::GetDnnlFormat(size_t dim_size) {
   dnnl::memory::format_tag source_format = dnnl::memory::format_tag::any;
   switch (dim_size) {
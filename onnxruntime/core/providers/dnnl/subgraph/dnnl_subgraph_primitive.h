@@ -4,6 +4,7 @@
 #pragma once
 #include "dnnl_subgraph.h"
 #include "dnnl.hpp"
+#include <list>
 #include <mutex>
 
 namespace onnxruntime {
@@ -96,7 +97,29 @@ class DnnlSubgraphPrimitive {
   }
 
  private:
+  // primitives and memories compiled for one set of input shapes
+  struct CompiledState {
+    std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates;
+    std::unordered_map<std::string, dnnl::memory> inputs;
+    std::unordered_map<std::string, dnnl::memory::desc> inputs_md;
+    std::unordered_map<std::string, dnnl::memory> outputs;
+    std::unordered_map<std::string, dnnl::memory::desc> outputs_md;
+    std::unordered_set<std::string> outputs_are_always_copied;
+    std::vector<dnnl::primitive> net;
+    std::vector<std::unordered_map<int, dnnl::memory>> net_args;
+    std::vector<std::pair<dnnl::memory, dnnl::memory>> reshapes;
+    std::unordered_set<std::string> scalar_outputs;
+  };
+  // exchange the members compiled for the current shapes with state
+  void SwapCompiledState(CompiledState& state);
+
+  // number of previously compiled input shapes kept for a dynamic subgraph, so that inputs alternating between a few
+  // shapes (e.g. sequence lengths) don't recompile the subgraph on every run
+  static constexpr size_t kMaxCachedShapes = 8;
+
   std::string shape_key_;
+  // most recently used first, excluding shape_key_
+  std::list<std::pair<std::string, CompiledState>> cached_shapes_;
 
   std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates_;
 
@@ -1,6 +1,7 @@
 // Copyright (C) Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
 #include <map>
 #include <unordered_set>
 
@@ -137,7 +138,17 @@ BasicBackend::BasicBackend(std::unique_ptr<ONNX_NAMESPACE::ModelProto>& model_pr
       }
     }
   }
-  int num_infer_req = (session_context_.num_of_threads > 0) ? session_context_.num_of_threads : 1;
+  size_t num_infer_req = (session_context_.num_of_threads > 0) ? session_context_.num_of_threads : 1;
+  // Create an infer request per stream of the compiled model up front, so concurrent runs use the streams in parallel
+  // from their first inference. Stateful models keep the pool small as each request holds its own KV cache.
+  if (!session_context_.enable_causallm) {
+    try {
+      num_infer_req = std::max<size_t>(num_infer_req,
+                                       exe_network_.Get().get_property(ov::optimal_number_of_infer_requests));
+    } catch (const ov::Exception&) {
+      // the device doesn't report it, the pool grows on demand
+    }
+  }
   std::function<void(OVInferRequestPtr)> initializer = [](OVInferRequestPtr) {};
   auto metadata = shared_context_.shared_weights.metadata;
   if (session_context_.so_share_ep_contexts) {
@@ -274,6 +274,12 @@ Status IDataTransfer::CopySparseTensors(const std::vector<SparseSrcDstPair>& src
 }
 #endif
 
+Status IExternalDataLoader::LoadTensor(const Env& /*env*/, const std::filesystem::path& /*data_file_path*/,
+                                       FileOffsetType /*data_offset*/, SafeInt<size_t> /*data_length*/,
+                                       Tensor& /*tensor*/) const {
+  ORT_NOT_IMPLEMENTED(__FUNCTION__, " is not implemented");
+}
+
 const Node& OpKernel::Node() const { return g_host->OpKernel__Node(this); }
 
 TensorShape::TensorShape(gsl::span<const int64_t> dims) {
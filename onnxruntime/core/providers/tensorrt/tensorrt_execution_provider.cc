@@ -1,11 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include <fstream>
+#include <future>
 #include <list>
 #include <unordered_set>
 #include "core/providers/shared_library/provider_api.h"
 #define ORT_API_MANUAL_INIT
 #include "core/session/onnxruntime_cxx_api.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/common/common.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
@@ -241,13 +243,7 @@ inline std::vector<char> loadTimingCacheFile(const std::string inFileName) {
 }
 
 inline void saveTimingCacheFile(const std::string outFileName, const nvinfer1::IHostMemory* blob) {
-  std::ofstream oFile(outFileName, std::ios::out | std::ios::binary);
-  if (!oFile) {
-    LOGS_DEFAULT(WARNING) << "[TensorRT EP] Could not write timing cache to: " << outFileName;
-    return;
-  }
-  oFile.write((char*)blob->data(), blob->size());
-  oFile.close();
+  WriteCacheFile(outFileName, blob->data(), blob->size());
 }
 }  // namespace
 
@@ -1171,6 +1167,124 @@ Status BindKernelOutput(Ort::KernelContext& ctx,
   return Status::OK();
 }
 
+/*
+ * Check whether the shapes of the dynamic shape inputs are within the shape ranges of the optimization profile that
+ * the engine runs with, so the engine can run them without being rebuilt.
+ */
+bool InputShapesWithinEngineProfile(Ort::KernelContext& ctx,
+                                    const nvinfer1::ICudaEngine* trt_engine,
+                                    const ShapeRangesMap& shape_ranges,
+                                    const std::unordered_map<std::string, size_t>& input_indexes) {
+  for (const auto& shape_range : shape_ranges) {
+    const char* input_name = shape_range.first.c_str();
+    const auto iter = input_indexes.find(shape_range.first);
+    if (iter == input_indexes.end()) {
+      continue;
+    }
+
+    // The values of shape tensors are only checked against the profile when the profile is updated
+    if (trt_engine->isShapeInferenceIO(input_name)) {
+      return false;
+    }
+
+    const auto shape = ctx.GetInput(iter->second).GetTensorTypeAndShapeInfo().GetShape();
+    const auto min_dims = trt_engine->getProfileShape(input_name, 0, nvinfer1::OptProfileSelector::kMIN);
+    const auto max_dims = trt_engine->getProfileShape(input_name, 0, nvinfer1::OptProfileSelector::kMAX);
+    if (min_dims.nbDims != static_cast<int32_t>(shape.size())) {
+      return false;
+    }
+    for (int32_t i = 0; i < min_dims.nbDims; ++i) {
+      if (shape[i] < min_dims.d[i] || shape[i] > max_dims.d[i]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/*
+ * Run the subgraph of the fused node with CUDA EP, for the inputs that its engine can't run while an engine for them
+ * is built in the background. The CUDA EP session is created on the first fallback and kept in the function state.
+ */
+Status RunFallbackSubGraph(Ort::KernelContext& ctx,
+                           TensorrtFuncState& trt_state,
+                           int device_id,
+                           const std::filesystem::path& model_path,
+                           cudaStream_t stream) {
+  const FallbackSubGraph& subgraph = *trt_state.fallback_subgraph;
+  if (trt_state.fallback_session == nullptr) {
+    const OrtApi& api = Ort::GetApi();
+    OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+    Ort::ThrowOnError(api.CreateCUDAProviderOptions(&cuda_options));
+    std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)> cuda_options_holder(
+        cuda_options, api.ReleaseCUDAProviderOptions);
+    const std::string device_id_str = std::to_string(device_id);
+    const char* keys[] = {"device_id"};
+    const char* values[] = {device_id_str.c_str()};
+    Ort::ThrowOnError(api.UpdateCUDAProviderOptions(cuda_options, keys, values, 1));
+
+    Ort::SessionOptions session_options;
+    session_options.AppendExecutionProvider_CUDA_V2(*cuda_options);
+    // Initializers of the subgraph stored in external data are relative to the model
+    if (!model_path.empty()) {
+      session_options.AddConfigEntry(kOrtSessionOptionsModelExternalInitializersFileFolderPath,
+                                     model_path.parent_path().string().c_str());
+    }
+    trt_state.fallback_env = std::make_unique<Ort::Env>();
+    trt_state.fallback_session = std::make_unique<Ort::Session>(*trt_state.fallback_env, subgraph.model.data(),
+                                                                subgraph.model.size(), session_options);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Created CUDA EP session for " << trt_state.fused_node_name;
+  }
+
+  Ort::Session& session = *trt_state.fallback_session;
+  Ort::AllocatorWithDefaultOptions allocator;
+  Ort::IoBinding binding(session);
+
+  std::vector<Ort::Value> inputs;
+  inputs.reserve(session.GetInputCount());
+  for (size_t i = 0, end = session.GetInputCount(); i < end; ++i) {
+    auto input_name = session.GetInputNameAllocated(i, allocator);
+    const auto iter = subgraph.input_map.find(input_name.get());
+    if (iter == subgraph.input_map.end()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP could not find input '", input_name.get(),
+                             "' of the CUDA EP session for ", trt_state.fused_node_name);
+    }
+    auto input = ctx.GetInput(iter->second);
+    auto tensor_info = input.GetTensorTypeAndShapeInfo();
+    const auto shape = tensor_info.GetShape();
+    inputs.push_back(Ort::Value::CreateTensor(input.GetTensorMemoryInfo(), const_cast<void*>(input.GetTensorRawData()),
+                                              input.GetTensorSizeInBytes(), shape.data(), shape.size(),
+                                              tensor_info.GetElementType()));
+    binding.BindInput(input_name.get(), inputs.back());
+  }
+
+  Ort::MemoryInfo cuda_mem_info("Cuda", OrtDeviceAllocator, device_id, OrtMemTypeDefault);
+  std::vector<Ort::AllocatedStringPtr> output_names;
+  for (size_t i = 0, end = session.GetOutputCount(); i < end; ++i) {
+    output_names.push_back(session.GetOutputNameAllocated(i, allocator));
+    binding.BindOutput(output_names.back().get(), cuda_mem_info);
+  }
+
+  // The session runs on its own stream, so the inputs must be ready before it starts
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
+  session.Run(Ort::RunOptions{nullptr}, binding);
+
+  auto outputs = binding.GetOutputValues();
+  for (size_t i = 0, end = outputs.size(); i < end; ++i) {
+    const auto iter = subgraph.output_map.find(output_names[i].get());
+    if (iter == subgraph.output_map.end()) {
+      continue;
+    }
+    const auto shape = outputs[i].GetTensorTypeAndShapeInfo().GetShape();
+    auto output = ctx.GetOutput(iter->second, shape);
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(output.GetTensorMutableRawData(), outputs[i].GetTensorRawData(),
+                                         outputs[i].GetTensorSizeInBytes(), cudaMemcpyDeviceToDevice, stream));
+  }
+  // The session outputs are released on return
+  CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream));
+  return Status::OK();
+}
+
 TensorrtExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId device_id, bool has_user_compute_stream, cudaStream_t stream) {
   if (has_user_compute_stream) {
     CUDA_CALL_THROW(cudaSetDevice(device_id));
@@ -1433,6 +1547,7 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     profile_opt_shapes = info.profile_opt_shapes;
     cuda_graph_enable_ = info.cuda_graph_enable;
     engine_hw_compatible_ = info.engine_hw_compatible;
+    engine_async_build_ = info.engine_async_build;
     op_types_to_exclude_ = info.op_types_to_exclude;
     preview_features_ = ParseTrtPreviewFeatures(info.preview_features);
   } else {
@@ -1631,6 +1746,11 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
         op_types_to_exclude_ = op_types_to_exclude_env;
       }
 
+      const std::string engine_async_build_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kEngineAsyncBuild);
+      if (!engine_async_build_env.empty()) {
+        engine_async_build_ = (std::stoi(engine_async_build_env) == 0 ? false : true);
+      }
+
     } catch (const std::invalid_argument& ex) {
       LOGS_DEFAULT(WARNING) << "[TensorRT EP] Invalid Argument (from environment variables): " << ex.what();
     } catch (const std::out_of_range& ex) {
@@ -1653,6 +1773,11 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     LOGS_DEFAULT(WARNING) << "[TensorRT EP] TensorRT option trt_dla_core must be a non-negative integer value. Set it to 0";
     dla_core_ = 0;
   }
+  if (engine_async_build_ && cuda_graph_enable_) {
+    // The CUDA EP session that runs a subgraph while its engine is built can't be captured in the CUDA graph.
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] TensorRT option trt_engine_async_build is not supported with trt_cuda_graph_enable. Engines are built synchronously";
+    engine_async_build_ = false;
+  }
 
   // If ep_context_file_path_ is provided as a directory, create it if it's not existed
   if (dump_ep_context_model_ && !ep_context_file_path_.empty() && std::filesystem::path(ep_context_file_path_).extension().empty() && !std::filesystem::is_directory(ep_context_file_path_)) {
@@ -1835,6 +1960,7 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
                         << ", trt_ep_context_embed_mode: " << ep_context_embed_mode_
                         << ", trt_cache_prefix: " << cache_prefix_
                         << ", trt_engine_hw_compatible: " << engine_hw_compatible_
+                        << ", trt_engine_async_build: " << engine_async_build_
                         << ", trt_onnx_model_bytestream_size_: " << onnx_model_bytestream_size_
                         << ", trt_op_types_to_exclude: " << op_types_to_exclude_;
 }
@@ -2917,6 +3043,171 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
   return Status::OK();
 }
 
+Status TensorrtExecutionProvider::BuildSerializedEngine(TensorrtFuncState* trt_state,
+                                                      const std::string& timing_cache_path,
+                                                      std::unique_ptr<nvinfer1::IHostMemory>& serialized_engine) const {
+  auto trt_builder = trt_state->builder;
+  const auto& trt_profiles = trt_state->profiles;
+  auto trt_config = std::unique_ptr<nvinfer1::IBuilderConfig>(trt_builder->createBuilderConfig());
+  if (max_workspace_size_ > 0) {
+    trt_config->setMemoryPoolLimit(nvinfer1::MemoryPoolType::kWORKSPACE, max_workspace_size_);
+  }
+  for (auto trt_profile : trt_profiles) {
+    trt_config->addOptimizationProfile(trt_profile);
+  }
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+  // Set INT8 Per Tensor Dynamic range
+  if (trt_state->int8_enable && trt_builder->platformHasFastInt8() && trt_state->int8_calibration_cache_available) {
+    trt_config->setInt8Calibrator(nullptr);
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+    if (!SetDynamicRange(*trt_state->network->get(), trt_state->dynamic_range_map)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to set INT8 dynamic range.");
+    }
+  }
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+  // Set precision
+  if (trt_state->int8_enable) {
+    trt_config->setFlag(nvinfer1::BuilderFlag::kINT8);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] INT8 mode is enabled";
+  }
+  if (trt_state->fp16_enable) {
+    trt_config->setFlag(nvinfer1::BuilderFlag::kFP16);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] FP16 mode is enabled";
+  }
+  if (trt_state->bf16_enable) {
+    trt_config->setFlag(nvinfer1::BuilderFlag::kBF16);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] BF16 mode is enabled";
+  }
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+  // Set DLA (DLA can only run with FP16 or INT8)
+  if ((trt_state->fp16_enable || trt_state->int8_enable) && trt_state->dla_enable) {
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] use DLA core " << trt_state->dla_core;
+    trt_config->setFlag(nvinfer1::BuilderFlag::kGPU_FALLBACK);
+    trt_config->setDefaultDeviceType(nvinfer1::DeviceType::kDLA);
+    trt_config->setDLACore(trt_state->dla_core);
+  }
+
+  // enable sparse weights
+  if (trt_state->sparsity_enable) {
+    trt_config->setFlag(nvinfer1::BuilderFlag::kSPARSE_WEIGHTS);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Sparse weights are allowed";
+  }
+#if NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR == 5
+  // enable builder heuristics
+  if (trt_state->build_heuristics_enable) {
+    trt_config->setFlag(nvinfer1::BuilderFlag::kENABLE_TACTIC_HEURISTIC);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Builder heuristics are enabled";
+  }
+#elif NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR > 5 || NV_TENSORRT_MAJOR > 8
+  // switch optimizaion level
+  if (trt_state->builder_optimization_level != 3) {
+    trt_config->setBuilderOptimizationLevel(trt_state->builder_optimization_level);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Builder optimization level is set to " << builder_optimization_level_;
+  }
+
+  // limit auxiliary streams
+  if (trt_state->auxiliary_streams >= 0) {
+    trt_config->setMaxAuxStreams(trt_state->auxiliary_streams);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Auxiliary streams are se to " << trt_state->auxiliary_streams;
+  }
+#else
+  if (trt_state->builder_optimization_level != 3) {
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] Builder optimization level can only be used on TRT 8.6 onwards!";
+  }
+  if (trt_state->auxiliary_streams >= 0) {
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] Auxiliary streams can only be set on TRT 8.6 onwards!";
+  }
+#endif
+  if (weight_stripped_engine_enable_) {
+#if NV_TENSORRT_MAJOR >= 10
+    trt_config->setFlag(nvinfer1::BuilderFlag::kSTRIP_PLAN);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] STRIP_PLAN is enabled";
+    trt_config->setFlag(nvinfer1::BuilderFlag::kREFIT_IDENTICAL);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] REFIT_IDENTICAL is enabled";
+#else
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] weight-stripped engines can only be used on TRT 10.0 onwards!";
+#endif
+  }
+  // limit used tactic sources
+  if (trt_state->filter_tactic_sources) {
+    nvinfer1::TacticSources tactics = trt_config->getTacticSources();
+    tactics |= trt_state->tactic_sources;
+    trt_config->setTacticSources(tactics);
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Tactic sources are limited using bitmask " << tactics;
+  }
+
+  // Load timing cache from file. Create a fresh cache if the file doesn't exist
+  std::unique_ptr<nvinfer1::ITimingCache> timing_cache = nullptr;
+  if (trt_state->timing_cache_enable) {
+    std::vector<char> loaded_timing_cache = loadTimingCacheFile(timing_cache_path);
+    timing_cache.reset(trt_config->createTimingCache(static_cast<const void*>(loaded_timing_cache.data()), loaded_timing_cache.size()));
+    if (timing_cache == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                             "TensorRT EP could not create timing cache: " + timing_cache_path);
+    }
+    trt_config->setTimingCache(*timing_cache, force_timing_cache_match_);
+    if (detailed_build_log_) {
+      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Deserialized timing cache from " + timing_cache_path;
+    }
+  }
+
+#if NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR > 5 || NV_TENSORRT_MAJOR > 8
+  // Enable hardware compatility mode if assigned
+  if (trt_state->engine_hw_compatible) {
+    trt_config->setHardwareCompatibilityLevel(nvinfer1::HardwareCompatibilityLevel::kAMPERE_PLUS);
+    LOGS_DEFAULT(INFO) << "[TensorRT EP] Re-generate engine with hardware compatibility enabled.";
+  }
+#endif
+
+  // Set preview feature flags
+  for (auto feature : trt_state->preview_features) {
+    trt_config->setPreviewFeature(feature, true);
+  }
+
+  // Build engine
+  {
+    auto lock = GetApiLock();
+    std::chrono::steady_clock::time_point engine_build_start;
+    if (detailed_build_log_) {
+      engine_build_start = std::chrono::steady_clock::now();
+    }
+    serialized_engine = std::unique_ptr<nvinfer1::IHostMemory>(
+        trt_builder->buildSerializedNetwork(*trt_state->network->get(), *trt_config));
+    if (!serialized_engine) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to create engine from network.");
+    }
+    if (detailed_build_log_) {
+      auto engine_build_stop = std::chrono::steady_clock::now();
+      LOGS_DEFAULT(INFO) << "TensorRT engine build for " << trt_state->trt_node_name_with_precision << " took: " << std::chrono::duration_cast<std::chrono::milliseconds>(engine_build_stop - engine_build_start).count() << "ms" << std::endl;
+    }
+  }
+
+  // serialize and save timing cache
+  if (trt_state->timing_cache_enable) {
+    auto timing_cache = trt_config->getTimingCache();
+    std::unique_ptr<nvinfer1::IHostMemory> timingCacheHostData{timing_cache->serialize()};
+    if (timingCacheHostData == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                             "TensorRT EP could not serialize timing cache: " + timing_cache_path);
+    }
+    saveTimingCacheFile(timing_cache_path, timingCacheHostData.get());
+    if (detailed_build_log_) {
+      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized timing cache " + timing_cache_path;
+    }
+  }
+  return Status::OK();
+}
+
 Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphViewer& graph_body_viewer,
                                                                  const Node& fused_node,
                                                                  std::unordered_map<std::string, size_t>& input_map,
@@ -3437,8 +3728,7 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
               LOGS_DEFAULT(WARNING) << "[TensorRT EP] Engine cache encryption function is not found. No cache is written to disk";
             }
           } else {
-            std::ofstream file(engine_cache_path, std::ios::binary | std::ios::out);
-            file.write(reinterpret_cast<char*>(serialized_engine->data()), serialized_engine->size());
+            WriteCacheFile(engine_cache_path, serialized_engine->data(), serialized_engine->size());
             LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized engine " + engine_cache_path;
           }
         }
@@ -3550,6 +3840,9 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
   output_info_[fused_node.Name()].push_back(output_types);
   input_shape_ranges_[fused_node.Name()] = input_implicit_shape_ranges;
   profiles_.emplace(fused_node.Name(), std::move(trt_profiles));
+  if (engine_async_build_ && has_dynamic_shape) {
+    fallback_subgraphs_[fused_node.Name()] = {std::move(string_buf), input_map, output_map};
+  }
 
   // For dynamic shape input model, firstly TRT EP creates a model proto which includes inputs, outputs and empty engine.
   // TRT EP will serialize the model at inference time due to engine can be updated and the updated engine should be included in the model.
@@ -3598,6 +3891,13 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
           detailed_build_log_, build_heuristics_enable_, sparsity_enable_, builder_optimization_level_,
           auxiliary_streams_, !tactic_sources_.empty(), tactics, cuda_graph_enable_, cache_prefix_, cache_suffix, engine_hw_compatible_,
           preview_features_};
+    if (engine_async_build_) {
+      auto fallback_subgraph = fallback_subgraphs_.find(context->node_name);
+      if (fallback_subgraph != fallback_subgraphs_.end()) {
+        p->engine_async_build = true;
+        p->fallback_subgraph = &fallback_subgraph->second;
+      }
+    }
     *state = p.release();
     return 0;
   };
@@ -3628,7 +3928,6 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
     std::unordered_map<std::string, std::vector<int32_t>> shape_tensor_values;        // This map holds "shape tensor -> shape values" for the shape tensor input across this inference run
     std::unordered_map<std::string, std::vector<int64_t>> shape_tensor_values_int64;  // same as above but for int64 shape tensor input
     auto& dds_output_allocator_map = this->dds_output_allocator_maps_[fused_node_name];
-    auto trt_builder = trt_state->builder;
     auto trt_engine = trt_state->engine->get();
     auto trt_context = trt_state->context->get();
     auto trt_profiles = trt_state->profiles;
@@ -3749,6 +4048,21 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
       }
     }
 
+    // Swap in the engine built in the background once it is ready
+    std::unique_ptr<nvinfer1::IHostMemory> serialized_engine;
+    if (trt_state->engine_build.valid() &&
+        trt_state->engine_build.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      auto status = trt_state->engine_build.get();
+      if (status.IsOK()) {
+        serialized_engine = std::move(trt_state->built_engine);
+      } else {
+        LOGS_DEFAULT(WARNING) << "[TensorRT EP] Background engine build for " << fused_node_name
+                              << " failed. Input shapes outside the current engine profile keep running with CUDA EP: "
+                              << status.ErrorMessage();
+      }
+    }
+    const bool engine_build_pending = trt_state->engine_build.valid();
+
     // Check and update shape ranges for dynamic shape inputs.
     for (int i = 0, end = num_inputs; i < end; ++i) {
       auto input = trt_state->network->get()->getInput(i);
@@ -3757,7 +4071,8 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
 
       // If there is any input tensor in shape_ranges, it means this input tensor has dynamic shape and its profile shape values have not yet resolved.
       // TRT EP will help determine the min/max/opt profile values based on current input tensor value.
-      if (shape_ranges.find(input_name) != shape_ranges.end()) {
+      // The profiles are left as they are while an engine is being built with them in the background.
+      if (!engine_build_pending && shape_ranges.find(input_name) != shape_ranges.end()) {
         auto status = ApplyProfileShapesFromInputTensorValue(trt_profiles, ctx, input, shape_ranges, input_indexes, shape_tensor_values, shape_tensor_values_int64, stream, &engine_update);
         if (status != Status::OK()) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to parse input tensor and generate optimization profiles.");
@@ -3766,161 +4081,28 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
     }
 
     // Regenerate engine
-    if (engine_update) {
+    if (engine_update && trt_state->engine_async_build) {
+      LOGS_DEFAULT(INFO) << "[TensorRT EP] Building engine for " << fused_node_name
+                         << " in the background. The subgraph runs with CUDA EP until the engine is ready.";
+      trt_state->engine_build = std::async(std::launch::async, [this, trt_state, timing_cache_path]() {
+        return BuildSerializedEngine(trt_state, timing_cache_path, trt_state->built_engine);
+      });
+    } else if (engine_update) {
       // Destroy the IExecutionContext objects before destroying an engine object, otherwise it will lead to undefined behavior.
       trt_state->context->reset();
       trt_state->engine->reset();
-      auto trt_config = std::unique_ptr<nvinfer1::IBuilderConfig>(trt_builder->createBuilderConfig());
-      if (max_workspace_size_ > 0) {
-        trt_config->setMemoryPoolLimit(nvinfer1::MemoryPoolType::kWORKSPACE, max_workspace_size_);
-      }
-      for (auto trt_profile : trt_profiles) {
-        trt_config->addOptimizationProfile(trt_profile);
-      }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#endif
-      // Set INT8 Per Tensor Dynamic range
-      if (trt_state->int8_enable && trt_builder->platformHasFastInt8() && trt_state->int8_calibration_cache_available) {
-        trt_config->setInt8Calibrator(nullptr);
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
-        if (!SetDynamicRange(*trt_state->network->get(), trt_state->dynamic_range_map)) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to set INT8 dynamic range.");
-        }
-      }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#endif
-      // Set precision
-      if (trt_state->int8_enable) {
-        trt_config->setFlag(nvinfer1::BuilderFlag::kINT8);
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] INT8 mode is enabled";
-      }
-      if (trt_state->fp16_enable) {
-        trt_config->setFlag(nvinfer1::BuilderFlag::kFP16);
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] FP16 mode is enabled";
-      }
-      if (trt_state->bf16_enable) {
-        trt_config->setFlag(nvinfer1::BuilderFlag::kBF16);
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] BF16 mode is enabled";
-      }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
-      // Set DLA (DLA can only run with FP16 or INT8)
-      if ((trt_state->fp16_enable || trt_state->int8_enable) && trt_state->dla_enable) {
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] use DLA core " << trt_state->dla_core;
-        trt_config->setFlag(nvinfer1::BuilderFlag::kGPU_FALLBACK);
-        trt_config->setDefaultDeviceType(nvinfer1::DeviceType::kDLA);
-        trt_config->setDLACore(trt_state->dla_core);
-      }
-
-      // enable sparse weights
-      if (trt_state->sparsity_enable) {
-        trt_config->setFlag(nvinfer1::BuilderFlag::kSPARSE_WEIGHTS);
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Sparse weights are allowed";
-      }
-#if NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR == 5
-      // enable builder heuristics
-      if (trt_state->build_heuristics_enable) {
-        trt_config->setFlag(nvinfer1::BuilderFlag::kENABLE_TACTIC_HEURISTIC);
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Builder heuristics are enabled";
-      }
-#elif NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR > 5 || NV_TENSORRT_MAJOR > 8
-      // switch optimizaion level
-      if (trt_state->builder_optimization_level != 3) {
-        trt_config->setBuilderOptimizationLevel(trt_state->builder_optimization_level);
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Builder optimization level is set to " << builder_optimization_level_;
-      }
-
-      // limit auxiliary streams
-      if (trt_state->auxiliary_streams >= 0) {
-        trt_config->setMaxAuxStreams(trt_state->auxiliary_streams);
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Auxiliary streams are se to " << trt_state->auxiliary_streams;
-      }
-#else
-      if (trt_state->builder_optimization_level != 3) {
-        LOGS_DEFAULT(WARNING) << "[TensorRT EP] Builder optimization level can only be used on TRT 8.6 onwards!";
-      }
-      if (trt_state->auxiliary_streams >= 0) {
-        LOGS_DEFAULT(WARNING) << "[TensorRT EP] Auxiliary streams can only be set on TRT 8.6 onwards!";
-      }
-#endif
-      if (weight_stripped_engine_enable_) {
-#if NV_TENSORRT_MAJOR >= 10
-        trt_config->setFlag(nvinfer1::BuilderFlag::kSTRIP_PLAN);
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] STRIP_PLAN is enabled";
-        trt_config->setFlag(nvinfer1::BuilderFlag::kREFIT_IDENTICAL);
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] REFIT_IDENTICAL is enabled";
-#else
-        LOGS_DEFAULT(WARNING) << "[TensorRT EP] weight-stripped engines can only be used on TRT 10.0 onwards!";
-#endif
-      }
-      // limit used tactic sources
-      if (trt_state->filter_tactic_sources) {
-        nvinfer1::TacticSources tactics = trt_config->getTacticSources();
-        tactics |= trt_state->tactic_sources;
-        trt_config->setTacticSources(tactics);
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Tactic sources are limited using bitmask " << tactics;
-      }
-
-      // Load timing cache from file. Create a fresh cache if the file doesn't exist
-      std::unique_ptr<nvinfer1::ITimingCache> timing_cache = nullptr;
-      if (trt_state->timing_cache_enable) {
-        std::vector<char> loaded_timing_cache = loadTimingCacheFile(timing_cache_path);
-        timing_cache.reset(trt_config->createTimingCache(static_cast<const void*>(loaded_timing_cache.data()), loaded_timing_cache.size()));
-        if (timing_cache == nullptr) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                 "TensorRT EP could not create timing cache: " + timing_cache_path);
-        }
-        trt_config->setTimingCache(*timing_cache, force_timing_cache_match_);
-        if (detailed_build_log_) {
-          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Deserialized timing cache from " + timing_cache_path;
-        }
-      }
-
-#if NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR > 5 || NV_TENSORRT_MAJOR > 8
-      // Enable hardware compatility mode if assigned
-      if (trt_state->engine_hw_compatible) {
-        trt_config->setHardwareCompatibilityLevel(nvinfer1::HardwareCompatibilityLevel::kAMPERE_PLUS);
-        LOGS_DEFAULT(INFO) << "[TensorRT EP] Re-generate engine with hardware compatibility enabled.";
-      }
-#endif
-
-      // Set preview feature flags
-      for (auto feature : trt_state->preview_features) {
-        trt_config->setPreviewFeature(feature, true);
-      }
+      ORT_RETURN_IF_ERROR(BuildSerializedEngine(trt_state, timing_cache_path, serialized_engine));
+    }
 
-      // Build engine
-      std::unique_ptr<nvinfer1::IHostMemory> serialized_engine;
-      {
-        auto lock = GetApiLock();
-        std::chrono::steady_clock::time_point engine_build_start;
-        if (detailed_build_log_) {
-          engine_build_start = std::chrono::steady_clock::now();
-        }
-        serialized_engine = std::unique_ptr<nvinfer1::IHostMemory>(
-            trt_builder->buildSerializedNetwork(*trt_state->network->get(), *trt_config));
-        if (!serialized_engine) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to create engine from network.");
-        }
-        *(trt_state->engine) = std::unique_ptr<nvinfer1::ICudaEngine>(
-            trt_state->runtime->deserializeCudaEngine(serialized_engine->data(), serialized_engine->size()));
-        if (!(*(trt_state->engine))) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to deserialize engine.");
-        }
-        if (detailed_build_log_) {
-          auto engine_build_stop = std::chrono::steady_clock::now();
-          LOGS_DEFAULT(INFO) << "TensorRT engine build for " << trt_state->trt_node_name_with_precision << " took: " << std::chrono::duration_cast<std::chrono::milliseconds>(engine_build_stop - engine_build_start).count() << "ms" << std::endl;
-        }
-      }
+    if (serialized_engine) {
+      trt_state->context->reset();
+      trt_state->engine->reset();
+      // Note: Deserializing an engine from a TensorRT runtime is thread safe per TRT doc
+      // https://docs.nvidia.com/deeplearning/tensorrt/developer-guide/index.html#threading
+      *(trt_state->engine) = std::unique_ptr<nvinfer1::ICudaEngine>(
+          trt_state->runtime->deserializeCudaEngine(serialized_engine->data(), serialized_engine->size()));
       if (!(*(trt_state->engine))) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP Failed to Build Engine.");
+        return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to deserialize engine.");
       }
       trt_engine = trt_state->engine->get();
       if (trt_state->engine_cache_enable) {
@@ -3941,26 +4123,11 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
             LOGS_DEFAULT(WARNING) << "[TensorRT EP] Engine cache encryption function is not found. No cache is written to disk";
           }
         } else {
-          std::ofstream file(engine_cache_path, std::ios::binary | std::ios::out);
-          file.write(reinterpret_cast<char*>(serialized_engine->data()), serialized_engine->size());
+          WriteCacheFile(engine_cache_path, serialized_engine->data(), serialized_engine->size());
           LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
         }
       }
 
-      // serialize and save timing cache
-      if (trt_state->timing_cache_enable) {
-        auto timing_cache = trt_config->getTimingCache();
-        std::unique_ptr<nvinfer1::IHostMemory> timingCacheHostData{timing_cache->serialize()};
-        if (timingCacheHostData == nullptr) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                 "TensorRT EP could not serialize timing cache: " + timing_cache_path);
-        }
-        saveTimingCacheFile(timing_cache_path, timingCacheHostData.get());
-        if (detailed_build_log_) {
-          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized timing cache " + timing_cache_path;
-        }
-      }
-
       // dump ep context model
       if (dump_ep_context_model_ && ep_context_embed_mode_) {
         UpdateCtxNodeModelEngineContext(model_proto_.get(), reinterpret_cast<char*>(serialized_engine->data()), serialized_engine->size());
@@ -4003,6 +4170,12 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
       trt_context = trt_state->context->get();
     }
 
+    // Run the inputs that the engine doesn't support with CUDA EP while an engine for them is built in the background
+    if (trt_state->engine_async_build &&
+        (trt_engine == nullptr || !InputShapesWithinEngineProfile(ctx, trt_engine, shape_ranges, input_indexes))) {
+      return RunFallbackSubGraph(ctx, *trt_state, device_id_, model_path_, stream);
+    }
+
     // Check before using trt_engine
     if (trt_engine == nullptr) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "No engine is found.");
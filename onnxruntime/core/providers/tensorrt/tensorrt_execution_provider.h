@@ -12,7 +12,9 @@ typedef void* cudnnStatus_t;
 #endif
 #include "core/providers/tensorrt/nv_includes.h"
 
+#include <future>
 #include <mutex>
+#include "core/session/onnxruntime_cxx_api.h"
 #include "core/providers/cuda/cuda_graph.h"
 #include "tensorrt_execution_provider_info.h"
 
@@ -58,6 +60,7 @@ static const std::string kDumpEpContextModel = "ORT_DUMP_EP_CONTEXT_MODEL";
 static const std::string kEpContextEmbedMode = "ORT_EP_CONTEXT_EMBED_MODE";
 static const std::string kEpContextComputeCapabilityEnable = "ORT_EP_CONTEXT_COMPUTE_CAPABILITY_ENABLE";
 static const std::string kEngineCachePrefix = "ORT_TENSORRT_CACHE_PREFIX";
+static const std::string kEngineAsyncBuild = "ORT_TENSORRT_ENGINE_ASYNC_BUILD";
 static const std::string kOpTypesToExclude = "ORT_TENSORRT_OP_TYPES_TO_EXCLUDE";
 // Old env variable for backward compatibility
 static const std::string kEngineCachePath = "ORT_TENSORRT_ENGINE_CACHE_PATH";
@@ -155,6 +158,14 @@ class OutputAllocator : public nvinfer1::IOutputAllocator {
  * This map saves the dimension range of the shape of the shape tensor or execution tensor:
  * tensor name -> ( dimension -> [min, max, opt] )
  */
+// The ONNX model of the subgraph of a fused node and the fused node input and output indexes of its inputs and outputs,
+// to run it with CUDA EP while its engine is built in the background.
+struct FallbackSubGraph {
+  std::string model;
+  std::unordered_map<std::string, size_t> input_map;
+  std::unordered_map<std::string, size_t> output_map;
+};
+
 using ShapeRangesMap = std::unordered_map<std::string, std::unordered_map<size_t, std::vector<std::vector<int64_t>>>>;
 
 // Information to construct kernel function state.
@@ -205,6 +216,14 @@ struct TensorrtFuncState {
   std::string cache_suffix;
   bool engine_hw_compatible = false;
   std::vector<nvinfer1::PreviewFeature> preview_features;
+  // Used when engines are built in the background (trt_engine_async_build). The subgraph runs in fallback_session with
+  // CUDA EP until the engine being built by engine_build is ready; built_engine holds the engine once it is.
+  bool engine_async_build = false;
+  const FallbackSubGraph* fallback_subgraph = nullptr;
+  std::unique_ptr<Ort::Env> fallback_env;
+  std::unique_ptr<Ort::Session> fallback_session;
+  std::unique_ptr<nvinfer1::IHostMemory> built_engine;
+  std::future<Status> engine_build;  // last, so that releasing the state waits for the build first
 };
 
 // Minimum information to construct kernel function state for direct engine load code path
@@ -338,6 +357,7 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   bool cuda_graph_enable_ = false;
   std::string cache_prefix_;
   bool engine_hw_compatible_ = false;
+  bool engine_async_build_ = false;
   std::string op_types_to_exclude_;
   std::vector<nvinfer1::PreviewFeature> preview_features_;
 
@@ -380,6 +400,7 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   std::unordered_map<std::string, ShapeRangesMap> input_shape_ranges_;  // The profile shape ranges that the engine is built with
   std::unordered_map<std::string, std::vector<nvinfer1::IOptimizationProfile*>> profiles_;
   std::unordered_map<std::string, DDSOutputAllocatorMap> dds_output_allocator_maps_;
+  std::unordered_map<std::string, FallbackSubGraph> fallback_subgraphs_;
 
   // for external stream, we need to create its cudnn/cublass handle before cuda EP enable cuda graph capture
   cudnnHandle_t external_cudnn_handle_ = nullptr;
@@ -590,6 +611,13 @@ class TensorrtExecutionProvider : public IExecutionProvider {
                                         std::unordered_map<std::string, size_t>& output_map,
                                         std::vector<NodeComputeInfo>& node_compute_funcs);
 
+  /**
+   * Build the engine of a fused node with the optimization profiles and build options of its function state, and
+   * update the timing cache. Called from compute time, on the background thread if trt_engine_async_build is enabled.
+   */
+  Status BuildSerializedEngine(TensorrtFuncState* trt_state, const std::string& timing_cache_path,
+                               std::unique_ptr<nvinfer1::IHostMemory>& serialized_engine) const;
+
   bool IsGraphCaptureAllowed() const;
   void CaptureBegin(int graph_annotation_id);
   void CaptureEnd(int graph_annotation_id);
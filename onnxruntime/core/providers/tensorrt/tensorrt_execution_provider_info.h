@@ -61,6 +61,7 @@ struct TensorrtExecutionProviderInfo {
   int ep_context_embed_mode{0};
   std::string engine_cache_prefix{""};
   bool engine_hw_compatible{false};
+  bool engine_async_build{false};
   std::string op_types_to_exclude{""};
   std::string preview_features{""};
 
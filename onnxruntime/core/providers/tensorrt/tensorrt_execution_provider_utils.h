@@ -8,6 +8,7 @@
 #include <sstream>
 #include <iostream>
 #include <filesystem>
+#include <random>
 #include "flatbuffers/idl.h"
 #include "ort_trt_int8_cal_table.fbs.h"
 #include <NvInferVersion.h>
@@ -120,6 +121,29 @@ int GetNumProfiles(std::unordered_map<std::string, std::vector<std::vector<int64
   return num_profile;
 }
 
+/*
+ * Write an engine, profile or timing cache file.
+ * The data is written to a temporary file next to it that then replaces the file, so other sessions and processes
+ * sharing the cache directory load either the previous or the new cache, never a partially written one.
+ */
+void WriteCacheFile(const std::string& file_name, const void* data, size_t size) {
+  std::filesystem::path temp_path = file_name;
+  temp_path += ".tmp" + std::to_string(std::random_device{}());
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::out);
+    if (!file || !file.write(static_cast<const char*>(data), size)) {
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] Could not write cache file " << temp_path.string();
+      return;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temp_path, file_name, error);
+  if (error) {
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] Could not replace cache file " << file_name << ": " << error.message();
+    std::filesystem::remove(temp_path, error);
+  }
+}
+
 /*
  * Seralize engine profile
  * The profile contains min/max shape ranges of dynamic shape dimensions of each input tensor
@@ -256,11 +280,8 @@ void SerializeProfileV2(const std::string& file_name, std::unordered_map<std::st
   builder.Finish();
 
   // Save flexbuffer
-  std::ofstream file(file_name, std::ios::binary | std::ios::out);
   auto buf = builder.GetBuffer();
-  size_t size = builder.GetSize();
-  file.write(reinterpret_cast<const char*>(&buf[0]), size);
-  file.close();
+  WriteCacheFile(file_name, buf.data(), builder.GetSize());
 }
 
 /*
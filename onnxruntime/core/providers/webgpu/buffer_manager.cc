@@ -395,6 +395,59 @@ class GraphSimpleCacheManager : public IBufferCacheManager {
   std::vector<WGPUBuffer> captured_buffers_;
 };
 
+class UniformBufferSuballocator {
+ public:
+  UniformBufferSuballocator(const wgpu::Device& device, uint64_t alignment)
+      : device_{device}, alignment_{alignment} {}
+
+  ~UniformBufferSuballocator() {
+    for (auto& chunk : chunks_) {
+      wgpuBufferRelease(chunk);
+    }
+  }
+
+  BufferSlice Allocate(size_t size) {
+    ORT_ENFORCE(size <= kChunkSize, "Uniform buffer size ", size, " exceeds the suballocation chunk size ", kChunkSize, ".");
+
+    uint64_t offset = (current_offset_ + alignment_ - 1) / alignment_ * alignment_;
+    if (current_chunk_ == chunks_.size() || offset + size > kChunkSize) {
+      // the current chunk is full, move to the next one.
+      if (current_chunk_ < chunks_.size()) {
+        ++current_chunk_;
+      }
+      if (current_chunk_ == chunks_.size()) {
+        wgpu::BufferDescriptor desc{};
+        desc.size = kChunkSize;
+        desc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform;
+        auto chunk = device_.CreateBuffer(&desc).MoveToCHandle();
+        ORT_ENFORCE(chunk, "Failed to create GPU buffer: size=", kChunkSize, ".");
+        chunks_.push_back(chunk);
+      }
+      offset = 0;
+    }
+
+    current_offset_ = offset + size;
+    return {chunks_[current_chunk_], offset, size};
+  }
+
+  // All dispatches using the ranges have been submitted. Queue writes issued after the submission are ordered after
+  // it, so the chunks can be reused from the beginning.
+  void OnRefresh() {
+    current_chunk_ = 0;
+    current_offset_ = 0;
+  }
+
+ private:
+  // 64KB is the minimum of maxUniformBufferBindingSize, so a range never exceeds the binding limit.
+  static constexpr uint64_t kChunkSize = 64 * 1024;
+
+  const wgpu::Device& device_;
+  const uint64_t alignment_;
+  std::vector<WGPUBuffer> chunks_;
+  size_t current_chunk_ = 0;
+  uint64_t current_offset_ = 0;
+};
+
 std::unique_ptr<IBufferCacheManager> CreateBufferCacheManager(BufferCacheMode cache_mode) {
   switch (cache_mode) {
     case BufferCacheMode::Disabled:
@@ -434,6 +487,9 @@ std::ostream& operator<<(std::ostream& os, BufferCacheMode mode) {
     case BufferCacheMode::GraphSimple:
       os << "GraphSimple";
       break;
+    case BufferCacheMode::Suballocate:
+      os << "Suballocate";
+      break;
     default:
       os << "Unknown(" << static_cast<int>(mode) << ")";
   }
@@ -443,11 +499,19 @@ std::ostream& operator<<(std::ostream& os, BufferCacheMode mode) {
 BufferManager::BufferManager(WebGpuContext& context, BufferCacheMode storage_buffer_cache_mode, BufferCacheMode uniform_buffer_cache_mode, BufferCacheMode query_resolve_buffer_cache_mode)
     : context_{context},
       storage_cache_{CreateBufferCacheManager(storage_buffer_cache_mode)},
-      uniform_cache_{CreateBufferCacheManager(uniform_buffer_cache_mode)},
+      uniform_cache_{CreateBufferCacheManager(uniform_buffer_cache_mode == BufferCacheMode::Suballocate
+                                                   ? BufferCacheMode::Simple
+                                                   : uniform_buffer_cache_mode)},
       query_resolve_cache_{CreateBufferCacheManager(query_resolve_buffer_cache_mode)},
       default_cache_{CreateBufferCacheManager(BufferCacheMode::Disabled)} {
+  if (uniform_buffer_cache_mode == BufferCacheMode::Suballocate) {
+    uniform_suballocator_ = std::make_unique<UniformBufferSuballocator>(context_.Device(),
+                                                                        context_.DeviceLimits().minUniformBufferOffsetAlignment);
+  }
 }
 
+BufferManager::~BufferManager() = default;
+
 void BufferManager::Upload(void* src, WGPUBuffer dst, size_t size) const {
   // If the buffer is mapped, we can directly write to it.
   void* mapped_data = wgpuBufferGetMappedRange(dst, 0, WGPU_WHOLE_MAP_SIZE);  // ensure the buffer is mapped
@@ -548,6 +612,20 @@ void BufferManager::Release(WGPUBuffer buffer) const {
   GetCacheManager(buffer).ReleaseBuffer(buffer);
 }
 
+BufferSlice BufferManager::CreateUniform(size_t size) const {
+  if (uniform_suballocator_) {
+    return uniform_suballocator_->Allocate(size);
+  }
+  return {Create(size, wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform), 0, size};
+}
+
+void BufferManager::ReleaseUniform(const BufferSlice& slice) const {
+  // suballocated ranges are recycled as a whole on refresh.
+  if (!uniform_suballocator_) {
+    Release(slice.buffer);
+  }
+}
+
 void BufferManager::Download(WGPUBuffer src, void* dst, size_t size) const {
   EnforceBufferUnmapped(context_, src);
   auto buffer_size = NormalizeBufferSize(size);
@@ -576,6 +654,9 @@ void BufferManager::Download(WGPUBuffer src, void* dst, size_t size) const {
 void BufferManager::RefreshPendingBuffers(GraphCaptureState graph_capture_state) const {
   storage_cache_->OnRefresh(graph_capture_state);
   uniform_cache_->OnRefresh(graph_capture_state);
+  if (uniform_suballocator_) {
+    uniform_suballocator_->OnRefresh();
+  }
   query_resolve_cache_->OnRefresh(graph_capture_state);
   default_cache_->OnRefresh(graph_capture_state);
 }
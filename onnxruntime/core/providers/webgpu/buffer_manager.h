@@ -28,6 +28,7 @@ enum class BufferCacheMode {
   Bucket,
   Graph,
   GraphSimple,
+  Suballocate,
 };
 std::ostream& operator<<(std::ostream& os, BufferCacheMode mode);
 
@@ -42,6 +43,10 @@ std::ostream& operator<<(std::ostream& os, BufferCacheMode mode);
 // - Bucket: a cache that keeps buffers in different buckets based on the buffer size, with a maximum number of buffers in each bucket.
 // - Graph: used for graph capturing storage buffer cache mode. All buffers will be cached. Buffers can be reused across runs and in one run.
 // - GraphSimple: used for graph capturing uniform buffer cache mode. All buffers will be cached. Buffers can be reused across runs but can't be reused in one run.
+//
+// Suballocate is not a strategy of IBufferCacheManager. It is only available for uniform buffers: the uniforms of all
+// dispatches in one submission are packed into a few large buffers and bound by offset, and the buffers are recycled
+// when the submission is flushed.
 class IBufferCacheManager {
  public:
   virtual ~IBufferCacheManager() = default;
@@ -62,12 +67,22 @@ class IBufferCacheManager {
   virtual void OnRefresh(GraphCaptureState graph_capture_state) = 0;
 };
 
+// A range of a GPU buffer.
+struct BufferSlice {
+  WGPUBuffer buffer = nullptr;
+  uint64_t offset = 0;
+  uint64_t size = 0;
+};
+
+class UniformBufferSuballocator;
+
 //
 // BufferManager manages operations on buffers.
 //
 class BufferManager {
  public:
   BufferManager(WebGpuContext& context, BufferCacheMode storage_buffer_cache_mode, BufferCacheMode uniform_buffer_cache_mode, BufferCacheMode query_resolve_buffer_cache_mode);
+  ~BufferManager();
   void Upload(void* src, WGPUBuffer dst, size_t size) const;
   void MemCpy(WGPUBuffer src, WGPUBuffer dst, size_t size) const;
   WGPUBuffer Create(size_t size, wgpu::BufferUsage usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst) const;
@@ -76,6 +91,10 @@ class BufferManager {
   // Check if CreateUMA is supported (i.e., the device has BufferMapExtendedUsages feature)
   bool SupportsUMA() const;
   void Release(WGPUBuffer buffer) const;
+  // Create a uniform buffer range. It is a range of a shared buffer in the Suballocate uniform buffer cache mode, and
+  // a whole buffer otherwise.
+  BufferSlice CreateUniform(size_t size) const;
+  void ReleaseUniform(const BufferSlice& slice) const;
   void Download(WGPUBuffer src, void* dst, size_t size) const;
   void RefreshPendingBuffers(GraphCaptureState graph_capture_state) const;
 
@@ -88,6 +107,7 @@ class BufferManager {
   std::unique_ptr<IBufferCacheManager> uniform_cache_;
   std::unique_ptr<IBufferCacheManager> query_resolve_cache_;
   std::unique_ptr<IBufferCacheManager> default_cache_;
+  std::unique_ptr<UniformBufferSuballocator> uniform_suballocator_;
 };
 
 class BufferManagerFactory {
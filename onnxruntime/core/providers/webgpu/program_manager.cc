@@ -2,11 +2,14 @@
 // Licensed under the MIT License.
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 
 #include "core/common/common.h"
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
 
 #include "core/providers/webgpu/program_manager.h"
 #include "core/providers/webgpu/shader_helper.h"
@@ -19,6 +22,11 @@ ProgramArtifact::ProgramArtifact(const ProgramBase& program, wgpu::ComputePipeli
       compute_pipeline{compute_pipeline},
       shape_uniform_ranks{shape_uniform_ranks} {}
 
+ProgramArtifact::ProgramArtifact(std::string_view name, wgpu::ComputePipeline&& compute_pipeline, std::vector<int>&& shape_uniform_ranks)
+    : name{name},
+      compute_pipeline{compute_pipeline},
+      shape_uniform_ranks{shape_uniform_ranks} {}
+
 Status ProgramManager::NormalizeDispatchGroupSize(uint32_t& x, uint32_t& y, uint32_t& z) const {
   ORT_RETURN_IF(x == 0 || y == 0 || z == 0, "Invalid dispatch group size (", x, ", ", y, ", ", z, ")");
 
@@ -47,7 +55,8 @@ Status ProgramManager::Build(const ProgramBase& program,
                              uint32_t normalized_dispatch_y,
                              uint32_t normalized_dispatch_z,
                              wgpu::ComputePipeline& compute_pipeline,
-                             std::vector<int>& shape_uniform_ranks) const {
+                             std::vector<int>& shape_uniform_ranks,
+                             ProgramCacheEntry* cache_entry) const {
   ShaderHelper shader_helper{program,
                              program_metadata,
                              device_,
@@ -79,14 +88,6 @@ Status ProgramManager::Build(const ProgramBase& program,
 #endif
                         << "] End ===\n";
 
-  wgpu::ShaderModuleWGSLDescriptor wgsl_descriptor{};
-  wgsl_descriptor.code = code.c_str();
-
-  wgpu::ShaderModuleDescriptor descriptor{};
-  descriptor.nextInChain = &wgsl_descriptor;
-
-  auto shader_module = device_.CreateShaderModule(&descriptor);
-
   // TODO: a new cache hierarchy for constants.
   //
   // Explaination:
@@ -106,13 +107,8 @@ Status ProgramManager::Build(const ProgramBase& program,
   // process overridable constants if available
   size_t constant_count = program.OverridableConstants().size();
 
-  // making a copy of the constant names is required because they are stored as std::string_view in the program
-  // metadata. A value of std::string_view is not guaranteed to be a C-stlye string (null-terminated) and hence
-  // cannot be used directly in the WebGPU API (which expects a const char*).
-  std::vector<std::string> constant_names;
-  constant_names.reserve(constant_count);
-  std::vector<wgpu::ConstantEntry> constant_entries;
-  constant_entries.reserve(constant_count);
+  std::vector<std::pair<std::string, double>> constants;
+  constants.reserve(constant_count);
   for (size_t i = 0; i < constant_count; ++i) {
     const auto& constant_override = program.OverridableConstants()[i];
     const auto& constant_def = program_metadata.overridable_constants[i];
@@ -139,14 +135,44 @@ Status ProgramManager::Build(const ProgramBase& program,
           break;
       }
 
-      const auto& name_string = constant_names.emplace_back(constant_def.name);
-      wgpu::ConstantEntry entry{};
-      entry.key = name_string.c_str();
-      entry.value = value;
-      constant_entries.push_back(std::move(entry));
+      constants.emplace_back(constant_def.name, value);
     }
   }
 
+  compute_pipeline = CreateComputePipeline(code, constants, program.Name());
+
+  if (cache_entry != nullptr) {
+    cache_entry->name = program.Name();
+    cache_entry->code = std::move(code);
+    cache_entry->constants = std::move(constants);
+    cache_entry->shape_uniform_ranks = shape_uniform_ranks;
+  }
+
+  return Status();
+}
+
+wgpu::ComputePipeline ProgramManager::CreateComputePipeline(const std::string& code,
+                                                            const std::vector<std::pair<std::string, double>>& constants,
+                                                            [[maybe_unused]] const std::string& label) const {
+  wgpu::ShaderModuleWGSLDescriptor wgsl_descriptor{};
+  wgsl_descriptor.code = code.c_str();
+
+  wgpu::ShaderModuleDescriptor descriptor{};
+  descriptor.nextInChain = &wgsl_descriptor;
+
+  auto shader_module = device_.CreateShaderModule(&descriptor);
+
+  // the constant names are stored as std::string, so they are null-terminated and can be used directly in the
+  // WebGPU API (which expects a const char*).
+  std::vector<wgpu::ConstantEntry> constant_entries;
+  constant_entries.reserve(constants.size());
+  for (const auto& [name, value] : constants) {
+    wgpu::ConstantEntry entry{};
+    entry.key = name.c_str();
+    entry.value = value;
+    constant_entries.push_back(std::move(entry));
+  }
+
   wgpu::ComputeState compute_state{};
   compute_state.module = shader_module;
   compute_state.entryPoint = "main";
@@ -158,12 +184,10 @@ Status ProgramManager::Build(const ProgramBase& program,
   wgpu::ComputePipelineDescriptor pipeline_descriptor{};
   pipeline_descriptor.compute = compute_state;
 #ifndef NDEBUG  // if debug build
-  pipeline_descriptor.label = program.Name().c_str();
+  pipeline_descriptor.label = label.c_str();
 #endif
 
-  compute_pipeline = device_.CreateComputePipeline(&pipeline_descriptor);
-
-  return Status();
+  return device_.CreateComputePipeline(&pipeline_descriptor);
 }
 
 const ProgramArtifact* ProgramManager::Get(const std::string& key) const {
@@ -179,5 +203,146 @@ const ProgramArtifact* ProgramManager::Set(const std::string& key, ProgramArtifa
   return &(programs_.emplace(key, std::move(program)).first->second);
 }
 
+void ProgramManager::AddCacheEntry(const std::string& key, ProgramCacheEntry&& cache_entry) {
+  cache_entries_.emplace(key, std::move(cache_entry));
+}
+
+namespace {
+
+// The program cache file layout (all integers are little endian uint32):
+//   magic, version, device signature, entry count,
+//   entry count x { key, name, code, constant count, constant count x { name, value (f64) },
+//                   rank count, rank count x rank (i32) }
+// Strings are stored as a length followed by the bytes.
+constexpr uint32_t kProgramCacheMagic = 0x43505257;  // "WRPC"
+constexpr uint32_t kProgramCacheVersion = 1;
+
+class CacheWriter {
+ public:
+  explicit CacheWriter(std::ostream& out) : out_{out} {}
+
+  void Write(uint32_t value) { out_.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+  void Write(int32_t value) { out_.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+  void Write(double value) { out_.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+  void Write(std::string_view value) {
+    Write(onnxruntime::narrow<uint32_t>(value.size()));
+    out_.write(value.data(), value.size());
+  }
+
+ private:
+  std::ostream& out_;
+};
+
+class CacheReader {
+ public:
+  explicit CacheReader(std::istream& in) : in_{in} {}
+
+  template <typename T>
+  bool Read(T& value) {
+    return static_cast<bool>(in_.read(reinterpret_cast<char*>(&value), sizeof(value)));
+  }
+  bool Read(std::string& value) {
+    uint32_t size = 0;
+    if (!Read(size)) {
+      return false;
+    }
+    value.resize(size);
+    return static_cast<bool>(in_.read(value.data(), size));
+  }
+
+ private:
+  std::istream& in_;
+};
+
+}  // namespace
+
+Status ProgramManager::LoadCache(const std::string& file_path, std::string_view device_signature) {
+  std::ifstream in{file_path, std::ios::binary};
+  if (!in) {
+    // no cache file from a previous run yet.
+    return Status::OK();
+  }
+
+  CacheReader reader{in};
+  uint32_t magic = 0, version = 0, entry_count = 0;
+  std::string signature;
+  ORT_RETURN_IF_NOT(reader.Read(magic) && magic == kProgramCacheMagic &&
+                        reader.Read(version) && version == kProgramCacheVersion,
+                    "Invalid WebGPU program cache file: ", file_path);
+  ORT_RETURN_IF_NOT(reader.Read(signature) && reader.Read(entry_count),
+                    "Invalid WebGPU program cache file: ", file_path);
+  if (signature != device_signature) {
+    LOGS_DEFAULT(WARNING) << "Ignoring WebGPU program cache file \"" << file_path
+                          << "\" that was written for a different device.";
+    return Status::OK();
+  }
+
+  // read all entries first, so that a truncated file does not leave a partially loaded cache.
+  std::vector<std::pair<std::string, ProgramCacheEntry>> entries(entry_count);
+  for (auto& [key, entry] : entries) {
+    uint32_t constant_count = 0, rank_count = 0;
+    ORT_RETURN_IF_NOT(reader.Read(key) && reader.Read(entry.name) && reader.Read(entry.code) &&
+                          reader.Read(constant_count),
+                      "Invalid WebGPU program cache file: ", file_path);
+    entry.constants.resize(constant_count);
+    for (auto& [name, value] : entry.constants) {
+      ORT_RETURN_IF_NOT(reader.Read(name) && reader.Read(value), "Invalid WebGPU program cache file: ", file_path);
+    }
+    ORT_RETURN_IF_NOT(reader.Read(rank_count), "Invalid WebGPU program cache file: ", file_path);
+    entry.shape_uniform_ranks.resize(rank_count);
+    for (auto& rank : entry.shape_uniform_ranks) {
+      ORT_RETURN_IF_NOT(reader.Read(rank), "Invalid WebGPU program cache file: ", file_path);
+    }
+  }
+
+  for (auto& [key, entry] : entries) {
+    if (programs_.find(key) != programs_.end()) {
+      continue;
+    }
+    auto compute_pipeline = CreateComputePipeline(entry.code, entry.constants, entry.name);
+    auto shape_uniform_ranks = entry.shape_uniform_ranks;
+    programs_.emplace(key, ProgramArtifact{entry.name, std::move(compute_pipeline), std::move(shape_uniform_ranks)});
+    cache_entries_.emplace(std::move(key), std::move(entry));
+  }
+
+  LOGS_DEFAULT(VERBOSE) << "Loaded " << entries.size() << " WebGPU programs from \"" << file_path << "\"";
+  return Status::OK();
+}
+
+Status ProgramManager::SaveCache(const std::string& file_path, std::string_view device_signature) const {
+  // write to a temporary file first and rename it, so that a concurrent reader never sees a partial file.
+  const std::string temp_file_path = file_path + ".tmp";
+  {
+    std::ofstream out{temp_file_path, std::ios::binary | std::ios::trunc};
+    ORT_RETURN_IF_NOT(out, "Failed to open WebGPU program cache file for writing: ", temp_file_path);
+
+    CacheWriter writer{out};
+    writer.Write(kProgramCacheMagic);
+    writer.Write(kProgramCacheVersion);
+    writer.Write(device_signature);
+    writer.Write(onnxruntime::narrow<uint32_t>(cache_entries_.size()));
+    for (const auto& [key, entry] : cache_entries_) {
+      writer.Write(key);
+      writer.Write(entry.name);
+      writer.Write(entry.code);
+      writer.Write(onnxruntime::narrow<uint32_t>(entry.constants.size()));
+      for (const auto& [name, value] : entry.constants) {
+        writer.Write(name);
+        writer.Write(value);
+      }
+      writer.Write(onnxruntime::narrow<uint32_t>(entry.shape_uniform_ranks.size()));
+      for (int rank : entry.shape_uniform_ranks) {
+        writer.Write(static_cast<int32_t>(rank));
+      }
+    }
+    ORT_RETURN_IF_NOT(out.flush(), "Failed to write WebGPU program cache file: ", temp_file_path);
+  }
+
+  std::remove(file_path.c_str());
+  ORT_RETURN_IF_NOT(std::rename(temp_file_path.c_str(), file_path.c_str()) == 0,
+                    "Failed to rename WebGPU program cache file: ", temp_file_path, " -> ", file_path);
+  return Status::OK();
+}
+
 }  // namespace webgpu
 }  // namespace onnxruntime
@@ -5,6 +5,8 @@
 
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "core/providers/webgpu/webgpu_external_header.h"
 
@@ -20,6 +22,7 @@ namespace webgpu {
 class ProgramArtifact {
  public:
   ProgramArtifact(const ProgramBase& program, wgpu::ComputePipeline&& compute_pipeline, std::vector<int>&& shape_uniform_ranks);
+  ProgramArtifact(std::string_view name, wgpu::ComputePipeline&& compute_pipeline, std::vector<int>&& shape_uniform_ranks);
 
   const std::string name;
   const wgpu::ComputePipeline compute_pipeline;
@@ -32,6 +35,15 @@ class ProgramArtifact {
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(ProgramArtifact);
 };
 
+// The serializable form of a program artifact. It contains everything needed to re-create the compute pipeline
+// without running the program's shader generation, so a program cache file can pre-warm a new process.
+struct ProgramCacheEntry {
+  std::string name;
+  std::string code;
+  std::vector<std::pair<std::string, double>> constants;
+  std::vector<int> shape_uniform_ranks;
+};
+
 class ProgramManager {
  public:
   ProgramManager(const wgpu::Device& device, const wgpu::Limits& limits) : device_(device), limits_(limits) {}
@@ -47,12 +59,35 @@ class ProgramManager {
                uint32_t normalized_dispatch_y,
                uint32_t normalized_dispatch_z,
                wgpu::ComputePipeline& compute_pipeline,
-               std::vector<int>& shape_uniform_ranks) const;
+               std::vector<int>& shape_uniform_ranks,
+               ProgramCacheEntry* cache_entry = nullptr) const;
   const ProgramArtifact* Get(const std::string& key) const;
   const ProgramArtifact* Set(const std::string& key, ProgramArtifact&& program);
 
+  //
+  // Program cache persistence.
+  //
+  // Once enabled, the serializable form of every program built afterwards is kept, so that SaveCache() can write
+  // all programs of this process to a file. LoadCache() re-creates the compute pipelines of a file written by a
+  // previous run, so the programs are ready before the first inference.
+  //
+  // The device signature identifies the adapter that generated the shader code. A file written with a different
+  // signature is ignored, because the generated code depends on the device limits and features.
+  //
+  bool IsCacheRecordingEnabled() const { return record_cache_entries_; }
+  void EnableCacheRecording() { record_cache_entries_ = true; }
+  void AddCacheEntry(const std::string& key, ProgramCacheEntry&& cache_entry);
+  Status LoadCache(const std::string& file_path, std::string_view device_signature);
+  Status SaveCache(const std::string& file_path, std::string_view device_signature) const;
+
  private:
+  wgpu::ComputePipeline CreateComputePipeline(const std::string& code,
+                                              const std::vector<std::pair<std::string, double>>& constants,
+                                              const std::string& label) const;
+
   std::unordered_map<std::string, ProgramArtifact> programs_;
+  std::unordered_map<std::string, ProgramCacheEntry> cache_entries_;
+  bool record_cache_entries_ = false;
   const wgpu::Device& device_;
   const wgpu::Limits& limits_;
 };
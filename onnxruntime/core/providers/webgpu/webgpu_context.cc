@@ -295,6 +295,8 @@ Status WebGpuContext::Run(ComputeContext& context, const ProgramBase& program) {
   if (program_artifact == nullptr) {
     wgpu::ComputePipeline compute_pipeline;
     std::vector<int> shape_uniform_ranks;
+    ProgramCacheEntry cache_entry;
+    const bool record_cache_entry = program_mgr_->IsCacheRecordingEnabled();
     auto status = program_mgr_->Build(program,
                                       metadata,
 #ifndef NDEBUG  // if debug build
@@ -304,11 +306,15 @@ Status WebGpuContext::Run(ComputeContext& context, const ProgramBase& program) {
                                       y,
                                       z,
                                       compute_pipeline,
-                                      shape_uniform_ranks);
+                                      shape_uniform_ranks,
+                                      record_cache_entry ? &cache_entry : nullptr);
     ORT_RETURN_IF_ERROR(status);
     program_artifact = program_mgr_->Set(key, ProgramArtifact{program,
                                                               std::move(compute_pipeline),
                                                               std::move(shape_uniform_ranks)});
+    if (record_cache_entry) {
+      program_mgr_->AddCacheEntry(key, std::move(cache_entry));
+    }
 #ifndef NDEBUG  // if debug build
     ORT_ENFORCE(program_artifact != nullptr, "Program artifact should not be nullptr.");
 #endif
@@ -400,7 +406,7 @@ Status WebGpuContext::Run(ComputeContext& context, const ProgramBase& program) {
   constexpr size_t max_alignment_of_field = 16;
   const size_t uniform_buffer_total_size = (current_offset + max_alignment_of_field - 1) / max_alignment_of_field * max_alignment_of_field;
 
-  WGPUBuffer uniform_buffer = nullptr;
+  BufferSlice uniform_buffer{};
   const webgpu::BufferManager& buffer_mgr = context.BufferManager();
   if (uniform_buffer_total_size > 0) {
     std::vector<uint8_t> uniform_data_buffer(uniform_buffer_total_size);
@@ -409,8 +415,8 @@ Status WebGpuContext::Run(ComputeContext& context, const ProgramBase& program) {
       memcpy(uniform_data_buffer.data() + offset, uniform.data.data(), uniform.data.size());
     }
 
-    uniform_buffer = buffer_mgr.Create(uniform_buffer_total_size, wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform);
-    device_queue_.WriteBuffer(uniform_buffer, 0, uniform_data_buffer.data(), uniform_buffer_total_size);
+    uniform_buffer = buffer_mgr.CreateUniform(uniform_buffer_total_size);
+    device_queue_.WriteBuffer(uniform_buffer.buffer, uniform_buffer.offset, uniform_data_buffer.data(), uniform_buffer_total_size);
   }
 
   const auto& compute_pass_encoder = GetComputePassEncoder();
@@ -418,20 +424,17 @@ Status WebGpuContext::Run(ComputeContext& context, const ProgramBase& program) {
   WriteTimestamp(num_pending_dispatches_ * 2);
 
   std::vector<WGPUBuffer> bind_buffers;
-  bind_buffers.reserve(inputs.size() + outputs.size() + (uniform_buffer ? 1 : 0));
+  bind_buffers.reserve(inputs.size() + outputs.size());
   for (const auto& input : inputs) {
     bind_buffers.push_back(reinterpret_cast<WGPUBuffer>(const_cast<void*>(input.tensor->DataRaw())));
   }
   for (const auto& output : outputs) {
     bind_buffers.push_back(reinterpret_cast<WGPUBuffer>(output.tensor->MutableDataRaw()));
   }
-  if (uniform_buffer) {
-    bind_buffers.push_back(uniform_buffer);
-  }
 
-  LaunchComputePipeline(compute_pass_encoder, bind_buffers, *program_artifact, x, y, z);
-  if (uniform_buffer) {
-    buffer_mgr.Release(uniform_buffer);
+  LaunchComputePipeline(compute_pass_encoder, bind_buffers, uniform_buffer, *program_artifact, x, y, z);
+  if (uniform_buffer.buffer) {
+    buffer_mgr.ReleaseUniform(uniform_buffer);
   }
 
   WriteTimestamp(num_pending_dispatches_ * 2 + 1);
@@ -706,8 +709,32 @@ void WebGpuContext::OnRunEnd() {
 #endif  // ENABLE_PIX_FOR_WEBGPU_EP
 }
 
+Status WebGpuContext::LoadProgramCache(const std::string& file_path) {
+  program_mgr_->EnableCacheRecording();
+  return program_mgr_->LoadCache(file_path, DeviceSignature());
+}
+
+Status WebGpuContext::SaveProgramCache(const std::string& file_path) const {
+  return program_mgr_->SaveCache(file_path, DeviceSignature());
+}
+
+std::string WebGpuContext::DeviceSignature() const {
+  // the generated shader code depends on the adapter (vendor specific code paths) and the device limits.
+  return MakeString(std::string_view{adapter_info_.vendor}, "|",
+                    std::string_view{adapter_info_.architecture}, "|",
+                    std::string_view{adapter_info_.device}, "|",
+                    static_cast<uint32_t>(adapter_info_.backendType), "|",
+                    adapter_info_.vendorID, "|",
+                    adapter_info_.deviceID, "|",
+                    device_limits_.maxComputeWorkgroupSizeX, "|",
+                    device_limits_.maxComputeInvocationsPerWorkgroup, "|",
+                    device_limits_.maxComputeWorkgroupStorageSize, "|",
+                    device_features_.size());
+}
+
 void WebGpuContext::LaunchComputePipeline(const wgpu::ComputePassEncoder& compute_pass_encoder,
                                           const std::vector<WGPUBuffer>& bind_buffers,
+                                          const BufferSlice& uniform_buffer,
                                           const ProgramArtifact& program_artifact,
                                           uint32_t x, uint32_t y, uint32_t z) {
   uint32_t entry_index = 0;
@@ -715,6 +742,9 @@ void WebGpuContext::LaunchComputePipeline(const wgpu::ComputePassEncoder& comput
   for (WGPUBuffer buffer : bind_buffers) {
     bind_group_entries.push_back({nullptr, entry_index++, buffer, 0, WGPU_WHOLE_SIZE, nullptr, nullptr});
   }
+  if (uniform_buffer.buffer) {
+    bind_group_entries.push_back({nullptr, entry_index++, uniform_buffer.buffer, uniform_buffer.offset, uniform_buffer.size, nullptr, nullptr});
+  }
 
   WGPUBindGroupLayout bind_group_layout = program_artifact.compute_pipeline.GetBindGroupLayout(0).MoveToCHandle();
   WGPUBindGroupDescriptor bind_group_desc{};
@@ -159,6 +159,13 @@ class WebGpuContext final {
   Status Run(ComputeContext& context, const ProgramBase& program);
   void OnRunEnd();
 
+  //
+  // Load the programs of a previous run from a program cache file and start recording the programs built by this
+  // context, so that SaveProgramCache() can write them back.
+  //
+  Status LoadProgramCache(const std::string& file_path);
+  Status SaveProgramCache(const std::string& file_path) const;
+
  private:
   enum class TimestampQueryType {
     None = 0,
@@ -172,6 +179,7 @@ class WebGpuContext final {
 
   void LaunchComputePipeline(const wgpu::ComputePassEncoder& compute_pass_encoder,
                              const std::vector<WGPUBuffer>& bind_buffers,
+                             const BufferSlice& uniform_buffer,
                              const ProgramArtifact& program_artifact,
                              uint32_t x, uint32_t y, uint32_t z);
 
@@ -181,6 +189,7 @@ class WebGpuContext final {
   std::vector<wgpu::FeatureName> GetAvailableRequiredFeatures(const wgpu::Adapter& adapter) const;
   wgpu::Limits GetRequiredLimits(const wgpu::Adapter& adapter) const;
   void WriteTimestamp(uint32_t query_index);
+  std::string DeviceSignature() const;
 
   struct PendingKernelInfo {
     PendingKernelInfo(std::string_view kernel_name,
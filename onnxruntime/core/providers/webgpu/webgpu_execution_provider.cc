@@ -772,6 +772,7 @@ WebGpuExecutionProvider::WebGpuExecutionProvider(int context_id,
       context_{context},
       preferred_data_layout_{config.data_layout},
       force_cpu_node_names_{std::move(config.force_cpu_node_names)},
+      program_cache_file_{std::move(config.program_cache_file)},
       enable_graph_capture_{config.enable_graph_capture} {
   // If graph capture is enabled, create a dedicated buffer manager for graph mode
   if (enable_graph_capture_) {
@@ -887,6 +888,13 @@ WebGpuExecutionProvider::~WebGpuExecutionProvider() {
   }
   // The graph_buffer_mgr_ will be automatically cleaned up by unique_ptr
 
+  if (!program_cache_file_.empty()) {
+    auto status = context_.SaveProgramCache(program_cache_file_);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Failed to save WebGPU program cache: " << status.ErrorMessage();
+    }
+  }
+
   WebGpuContextFactory::ReleaseContext(context_id_);
 }
 
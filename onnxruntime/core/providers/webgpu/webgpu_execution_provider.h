@@ -39,6 +39,7 @@ struct WebGpuExecutionProviderConfig {
   bool enable_graph_capture;
   bool enable_pix_capture;
   std::vector<std::string> force_cpu_node_names;
+  std::string program_cache_file;
 };
 
 class WebGpuExecutionProvider : public IExecutionProvider {
@@ -95,6 +96,7 @@ class WebGpuExecutionProvider : public IExecutionProvider {
   webgpu::WebGpuProfiler* profiler_ = nullptr;
   DataLayout preferred_data_layout_;
   std::vector<std::string> force_cpu_node_names_;
+  std::string program_cache_file_;
   bool enable_graph_capture_ = false;
   bool is_graph_captured_ = false;
   int regular_run_count_before_graph_capture_ = 0;
@@ -88,6 +88,9 @@ std::shared_ptr<IExecutionProviderFactory> WebGpuProviderFactoryCreator::Create(
   }
   LOGS_DEFAULT(VERBOSE) << "WebGPU EP force CPU node count: " << webgpu_ep_config.force_cpu_node_names.size();
 
+  config_options.TryGetConfigEntry(kProgramCacheFile, webgpu_ep_config.program_cache_file);
+  LOGS_DEFAULT(VERBOSE) << "WebGPU EP program cache file: " << webgpu_ep_config.program_cache_file;
+
   //
   // STEP.2 - prepare WebGpuContextConfig
   //
@@ -210,6 +213,8 @@ std::shared_ptr<IExecutionProviderFactory> WebGpuProviderFactoryCreator::Create(
         return webgpu::BufferCacheMode::Simple;
       } else if (buffer_cache_mode_str == kBufferCacheMode_Bucket) {
         return webgpu::BufferCacheMode::Bucket;
+      } else if (buffer_cache_mode_str == kBufferCacheMode_Suballocate && config_entry_str == kUniformBufferCacheMode) {
+        return webgpu::BufferCacheMode::Suballocate;
       } else {
         ORT_THROW("Invalid buffer cache mode: ", config_entry_str);
       }
@@ -257,6 +262,14 @@ std::shared_ptr<IExecutionProviderFactory> WebGpuProviderFactoryCreator::Create(
   // Create WebGPU device and initialize the context.
   context.Initialize(buffer_cache_config, backend_type, enable_pix_capture);
 
+  // Pre-warm the programs from a previous run. A stale or broken cache file only costs the pre-warming.
+  if (!webgpu_ep_config.program_cache_file.empty()) {
+    auto status = context.LoadProgramCache(webgpu_ep_config.program_cache_file);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Failed to load WebGPU program cache: " << status.ErrorMessage();
+    }
+  }
+
   // Create WebGPU EP factory.
   return std::make_shared<WebGpuProviderFactory>(context_id, context, std::move(webgpu_ep_config));
 }
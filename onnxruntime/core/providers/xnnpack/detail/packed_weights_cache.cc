@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/xnnpack/detail/packed_weights_cache.h"
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+PackedWeightsCache::PackedWeightsCache(AllocatorPtr alloc) : alloc_{std::move(alloc)} {
+  provider_.context = this;
+  provider_.look_up = &LookUp;
+  provider_.reserve_space = &ReserveSpace;
+  provider_.look_up_or_insert = &LookUpOrInsert;
+  provider_.is_finalized = &IsFinalized;
+  provider_.offset_to_addr = &OffsetToAddr;
+  provider_.delete_cache = &DeleteCache;
+}
+
+void PackedWeightsCache::Store(PrePackedWeights& prepacked_weights) {
+  if (buffer_) {
+    prepacked_weights.buffers_.push_back(std::move(buffer_));
+    prepacked_weights.buffer_sizes_.push_back(size_);
+  }
+}
+
+void PackedWeightsCache::UseShared(void* packed_weights) {
+  // if the buffer was not stored, it is released here and the operator switches to the shared copy.
+  data_ = packed_weights;
+  buffer_.reset();
+}
+
+size_t PackedWeightsCache::LookUp(void* context, const xnn_weights_cache_look_up_key* /*cache_key*/) {
+  // the cache only ever holds the weights of one operator.
+  auto* cache = static_cast<PackedWeightsCache*>(context);
+  return cache->size_ > 0 ? 0 : XNN_CACHE_NOT_FOUND;
+}
+
+void* PackedWeightsCache::ReserveSpace(void* context, size_t n) {
+  auto* cache = static_cast<PackedWeightsCache*>(context);
+  cache->buffer_ = IAllocator::MakeUniquePtr<void>(cache->alloc_, n, true);
+  cache->data_ = cache->buffer_.get();
+  return cache->data_;
+}
+
+size_t PackedWeightsCache::LookUpOrInsert(void* context, const xnn_weights_cache_look_up_key* /*cache_key*/,
+                                          void* ptr, size_t size) {
+  auto* cache = static_cast<PackedWeightsCache*>(context);
+  ORT_ENFORCE(ptr == cache->data_, "XNNPACK packed weights were not written to the reserved space.");
+  cache->size_ = size;
+  return 0;
+}
+
+bool PackedWeightsCache::IsFinalized(void* /*context*/) {
+  return false;
+}
+
+void* PackedWeightsCache::OffsetToAddr(void* context, size_t offset) {
+  auto* cache = static_cast<PackedWeightsCache*>(context);
+  return static_cast<uint8_t*>(cache->data_) + offset;
+}
+
+xnn_status PackedWeightsCache::DeleteCache(void* /*context*/) {
+  // owned by the kernel.
+  return xnn_status_success;
+}
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights.h"
+
+#include "xnnpack.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+// An XNNPACK weights cache for the packed weights of a single operator.
+//
+// XNNPACK writes the packed weights into a buffer allocated from the allocator given to PrePack, instead of the memory
+// of the operator. The buffer is handed to the session as pre-packed weights, so that the session can share one copy
+// of identical packed weights across kernels, and across sessions with a PrepackedWeightsContainer. The operator
+// reads the packed weights through the cache when it is reshaped, so it can be switched to the shared copy after it
+// has been created.
+class PackedWeightsCache {
+ public:
+  explicit PackedWeightsCache(AllocatorPtr alloc);
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PackedWeightsCache);
+
+  xnn_weights_cache_t Get() { return &provider_; }
+
+  // Move the packed weights into prepacked_weights. The operator keeps using them until UseShared() is called.
+  void Store(PrePackedWeights& prepacked_weights);
+
+  // Use a shared copy of the packed weights. It must have the same content as the packed weights of the operator.
+  void UseShared(void* packed_weights);
+
+ private:
+  static size_t LookUp(void* context, const xnn_weights_cache_look_up_key* cache_key);
+  static void* ReserveSpace(void* context, size_t n);
+  static size_t LookUpOrInsert(void* context, const xnn_weights_cache_look_up_key* cache_key, void* ptr, size_t size);
+  static bool IsFinalized(void* context);
+  static void* OffsetToAddr(void* context, size_t offset);
+  static xnn_status DeleteCache(void* context);
+
+  xnn_weights_cache_provider provider_;
+  AllocatorPtr alloc_;
+  IAllocatorUniquePtr<void> buffer_;
+  size_t size_ = 0;
+  void* data_ = nullptr;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
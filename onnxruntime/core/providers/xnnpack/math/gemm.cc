@@ -119,9 +119,9 @@ Gemm::Gemm(const OpKernelInfo& info) : GemmBase(info), XnnpackKernel(info, /*ena
   }
 }
 
-Status Gemm::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr,
+Status Gemm::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                      /*out*/ bool& is_packed,
-                     /*out*/ PrePackedWeights*) {
+                     /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
 
   if (input_idx == 0) {
@@ -140,7 +140,7 @@ Status Gemm::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr,
   // flags - 1 - for no transpose - 0 for transpose
   uint32_t flags = trans_B_ == CblasTrans ? 0 : XNN_FLAG_TRANSPOSE_WEIGHTS;
   auto code_cache = GetCodeCache();
-  auto weights_cache = GetWeightsCache();
+  auto weights_cache = CreatePackedWeightsCache(std::move(alloc));
   xnn_status status = xnn_status::xnn_status_uninitialized;
   struct xnn_operator* p = nullptr;
   float foutput_min = clip_min_max_ ? clip_min_max_->first : -std::numeric_limits<float>::infinity();
@@ -184,6 +184,7 @@ Status Gemm::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr,
                            OpTypeToString(op_compute_type_), " returned ", status);
   }
   op0_.reset(p);
+  StorePackedWeights(prepacked_weights);
 
   return Status::OK();
 }
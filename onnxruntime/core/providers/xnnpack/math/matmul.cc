@@ -79,7 +79,7 @@ MatMul::MatMul(const OpKernelInfo& info) : XnnpackKernel(info, /*enable_caches*/
 
 Status MatMul::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                        /*out*/ bool& is_packed,
-                       /*out*/ PrePackedWeights* /*Not used*/) {
+                       /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
 
   if (input_idx == 0 || input_idx == 2) {
@@ -103,11 +103,10 @@ Status MatMul::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
 
 #ifdef XNN_CACHE_ENABLE
   xnn_code_cache_t code_cache = GetCodeCache();
-  xnn_weights_cache_t weight_cache = GetWeightsCache();
 #else
   xnn_code_cache_t code_cache = nullptr;
-  xnn_weights_cache_t weight_cache = nullptr;
 #endif
+  xnn_weights_cache_t weight_cache = CreatePackedWeightsCache(alloc);
 
   float foutput_min = -std::numeric_limits<float>::infinity();
   float foutput_max = std::numeric_limits<float>::infinity();
@@ -146,6 +145,7 @@ Status MatMul::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
   }
 
   op0_.reset(p);
+  StorePackedWeights(prepacked_weights);
 
   return Status::OK();
 }
@@ -19,7 +19,7 @@ namespace xnnpack {
 // use PrePack to handle the weight layout change as that's not a simple NCHW -> NHWC transpose
 Status Conv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                      /*out*/ bool& is_packed,
-                     /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+                     /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
   // only layout of weight input is adjusted via PrePack
   const bool conv_type_is_float = (conv_type_ == OpComputeType::op_compute_type_fp32 ||
@@ -37,7 +37,7 @@ Status Conv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                                  orig_shape[3],
                                  orig_shape[1]};
 
-      packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), std::move(alloc));
+      packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), alloc);
 
       SingleAxisTranspose(perm, tensor, packed_w_, /*from*/ 1, /*to*/ 3);
     } else {
@@ -48,7 +48,7 @@ Status Conv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                                  orig_shape[2],
                                  orig_shape[1]};
 
-      packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), std::move(alloc));
+      packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), alloc);
 
       SingleAxisTranspose(perm, tensor, packed_w_, /*from*/ 1, /*to*/ 2);
     }
@@ -56,7 +56,7 @@ Status Conv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
     is_packed = true;
 
     // we can create the kernel now
-    ORT_RETURN_IF_ERROR(CreateKernel());
+    ORT_RETURN_IF_ERROR(CreateKernel(std::move(alloc), prepacked_weights));
   }
   return Status::OK();
 }
@@ -518,12 +518,16 @@ ConvBase::ConvBase(const OpKernelInfo& info, bool is_transpose)
   // have to delay creating the xnnpack kernel until after the weights are pre-packed.
 }
 
-Status ConvBase::CreateKernel() {
+Status ConvBase::CreateKernel(AllocatorPtr alloc, PrePackedWeights* prepacked_weights) {
   auto ret = CreateXnnpackKernel(convbase_attrs_ref_, C_, M_, kernel_shape_, clip_min_max_, packed_w_,
                                  B_, op0_,
-                                 GetCodeCache(), GetWeightsCache(),
+                                 GetCodeCache(), CreatePackedWeightsCache(std::move(alloc)),
                                  quant_param_, conv_type_, is_transpose_);
-  return ret;
+  ORT_RETURN_IF_ERROR(ret);
+
+  StorePackedWeights(prepacked_weights);
+  packed_w_ = Tensor();
+  return Status::OK();
 }
 }  // namespace xnnpack
 }  // namespace onnxruntime
@@ -22,7 +22,9 @@ class ConvBase : public XnnpackKernel {
   static bool IsOnnxNodeSupported(const NodeUnit& nchw_nodeunit, const GraphViewer& graph);
 
  protected:
-  Status CreateKernel();
+  // Create the XNNPACK operator from packed_w_. The packed weights are stored in prepacked_weights so the session can
+  // share them, and packed_w_ is released as the operator no longer needs it.
+  Status CreateKernel(AllocatorPtr alloc, PrePackedWeights* prepacked_weights);
 
  protected:
   ConvAttributes conv_attrs_;
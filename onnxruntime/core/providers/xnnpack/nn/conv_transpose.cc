@@ -16,7 +16,7 @@ namespace xnnpack {
 // use PrePack to handle the weight layout change as that's not a simple NCHW -> NHWC transpose
 Status ConvTranspose::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
                               /*out*/ bool& is_packed,
-                              /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+                              /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
   // only layout of weight input is adjusted via PrePack
   const bool conv_type_is_float = (conv_type_ == OpComputeType::op_compute_type_fp32 ||
@@ -44,7 +44,7 @@ Status ConvTranspose::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr
                                    w_reshaped[4],
                                    w_reshaped[1]};
 
-        packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), std::move(alloc));
+        packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), alloc);
         // g I/g O H W --> g O H W I/g
         SingleAxisTranspose(perm, tensor, packed_w_, /*from*/ 1, /*to*/ 4, &w_reshaped);
       } else {
@@ -61,7 +61,7 @@ Status ConvTranspose::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr
                                    w_reshaped[3],
                                    w_reshaped[1]};
 
-        packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), std::move(alloc));
+        packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), alloc);
         // g I/g O W --> g O W I/g
         SingleAxisTranspose(perm, tensor, packed_w_, /*from*/ 1, /*to*/ 3, &w_reshaped);
       }
@@ -74,7 +74,7 @@ Status ConvTranspose::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr
                                    orig_shape[3],
                                    orig_shape[0]};
 
-        packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), std::move(alloc));
+        packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), alloc);
         // I O H W --> O H W I
         SingleAxisTranspose(perm, tensor, packed_w_, /*from*/ 0, /*to*/ 3);
       } else {
@@ -86,7 +86,7 @@ Status ConvTranspose::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr
                                    orig_shape[2],
                                    orig_shape[0]};
 
-        packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), std::move(alloc));
+        packed_w_ = Tensor(tensor.DataType(), TensorShape(new_dims), alloc);
         // I O W --> O W I
         SingleAxisTranspose(perm, tensor, packed_w_, /*from*/ 0, /*to*/ 2);
       }
@@ -95,7 +95,7 @@ Status ConvTranspose::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr
     is_packed = true;
 
     // we can create the kernel now
-    auto ret = CreateKernel();
+    auto ret = CreateKernel(std::move(alloc), prepacked_weights);
     ORT_RETURN_IF_ERROR(ret);
   }
 
@@ -4,6 +4,7 @@
 #pragma once
 #include "core/framework/op_kernel.h"
 #include "core/providers/xnnpack/xnnpack_execution_provider.h"
+#include "core/providers/xnnpack/detail/packed_weights_cache.h"
 #include "xnnpack.h"
 
 struct pthreadpool;
@@ -28,6 +29,30 @@ class XnnpackKernel : public OpKernel {
   xnn_code_cache_t GetCodeCache() { return nullptr; }
   xnn_weights_cache_t GetWeightsCache() { return caches_.auto_weights_cache.get(); }
 
+  // Share the packed weights of the operator created in PrePack with the session (see PackedWeightsCache).
+  // PrePack passes the returned cache to the xnn_create_* call and then calls StorePackedWeights.
+  xnn_weights_cache_t CreatePackedWeightsCache(AllocatorPtr alloc) {
+    packed_weights_cache_ = std::make_unique<PackedWeightsCache>(std::move(alloc));
+    return packed_weights_cache_->Get();
+  }
+
+  void StorePackedWeights(PrePackedWeights* prepacked_weights) {
+    if (prepacked_weights != nullptr) {
+      packed_weights_cache_->Store(*prepacked_weights);
+    }
+  }
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int /*input_idx*/,
+                                   /*out*/ bool& used_shared_buffers) override {
+    used_shared_buffers = false;
+    if (packed_weights_cache_ && !prepacked_buffers.empty()) {
+      packed_weights_cache_->UseShared(prepacked_buffers[0].get());
+      used_shared_buffers = true;
+    }
+    return Status::OK();
+  }
+
  private:
   pthreadpool* xnnpack_threadpool_;
 
@@ -66,6 +91,7 @@ class XnnpackKernel : public OpKernel {
   };
 
   Caches caches_;
+  std::unique_ptr<PackedWeightsCache> packed_weights_cache_;
 };
 }  // namespace xnnpack
 }  // namespace onnxruntime
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/session/IOBinding.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "core/common/logging/logging.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel.h"
@@ -23,6 +27,16 @@ common::Status IOBinding::BindInput(const std::string& name, const OrtValue& ml_
     }
   };
 
+  if (stage_inputs_ && ml_value.IsTensor() && ml_value.Get<Tensor>().Location().device.Type() == OrtDevice::CPU) {
+    OrtValue staged_value;
+    bool staged = false;
+    ORT_RETURN_IF_ERROR(StageInput(name, ml_value.Get<Tensor>(), staged_value, staged));
+    if (staged) {
+      add_or_replace(staged_value);
+      return Status::OK();
+    }
+  }
+
   if (ml_value.IsTensor() || ml_value.IsSparseTensor()) {
     OrtValue new_mlvalue;
     // Do not replace new_mlvalue by feeds_[index] in the following line.
@@ -41,6 +55,85 @@ common::Status IOBinding::BindInput(const std::string& name, const OrtValue& ml_
   return Status::OK();
 }
 
+common::Status IOBinding::StageInput(const std::string& name, const Tensor& tensor, OrtValue& staged_value,
+                                     bool& staged) {
+  staged = false;
+#ifdef ORT_ENABLE_STREAM
+  if (tensor.IsDataTypeString() || tensor.SizeInBytes() == 0) {
+    return Status::OK();
+  }
+
+  InlinedVector<SessionState::NodeInfo> node_info_vec;
+  if (!session_state_.GetInputNodeInfo(name, node_info_vec).IsOK() || node_info_vec.front().p_node == nullptr) {
+    return Status::OK();
+  }
+
+  const OrtDevice& device = *node_info_vec.front().device;
+  if (device.UsesCpuMemory()) {
+    return Status::OK();
+  }
+
+  const OrtDevice pinned_device(device.Type(), OrtDevice::MemType::HOST_ACCESSIBLE, device.Vendor(), device.Id());
+  AllocatorPtr pinned_allocator = session_state_.GetAllocator(pinned_device);
+  AllocatorPtr device_allocator = session_state_.GetAllocator(device);
+  if (!pinned_allocator || !device_allocator) {
+    return Status::OK();
+  }
+
+  if (!staging_stream_) {
+    auto create_stream = session_state_.GetStreamHandleRegistryInstance().GetCreateStreamFn(device.Type());
+    if (!create_stream) {
+      return Status::OK();
+    }
+    staging_stream_ = create_stream(device);
+  }
+  if (staging_stream_->GetDevice() != device) {
+    // a single stream stages the inputs of one device.
+    return Status::OK();
+  }
+
+  StagedInput& staged_input = staged_inputs_[name];
+  const size_t slot = staged_input.next_slot;
+  staged_input.next_slot ^= 1;
+
+  // the pinned buffer of this slot is still being copied if the input was bound twice since the last wait.
+  if (staged_copies_pending_ && staged_input.pinned[slot].IsAllocated()) {
+    ORT_RETURN_IF_ERROR(WaitForStagedInputs());
+  }
+
+  auto ensure_buffer = [&tensor](OrtValue& buffer, const AllocatorPtr& allocator) {
+    if (!buffer.IsAllocated() || buffer.Get<Tensor>().DataType() != tensor.DataType() ||
+        buffer.Get<Tensor>().Shape() != tensor.Shape()) {
+      Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), allocator, buffer);
+    }
+  };
+  ensure_buffer(staged_input.pinned[slot], pinned_allocator);
+  ensure_buffer(staged_input.device[slot], device_allocator);
+
+  Tensor& pinned_tensor = *staged_input.pinned[slot].GetMutable<Tensor>();
+  memcpy(pinned_tensor.MutableDataRaw(), tensor.DataRaw(), tensor.SizeInBytes());
+  ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensorAsync(
+      pinned_tensor, *staged_input.device[slot].GetMutable<Tensor>(), *staging_stream_));
+  staged_copies_pending_ = true;
+
+  staged_value = staged_input.device[slot];
+  staged = true;
+#else
+  ORT_UNUSED_PARAMETER(name);
+  ORT_UNUSED_PARAMETER(tensor);
+  ORT_UNUSED_PARAMETER(staged_value);
+#endif
+  return Status::OK();
+}
+
+common::Status IOBinding::WaitForStagedInputs() {
+  if (staged_copies_pending_) {
+    staging_stream_->Flush();
+    staged_copies_pending_ = false;
+  }
+  return Status::OK();
+}
+
 void IOBinding::ClearInputs() {
   mapped_feed_names_.clear();
   feed_names_.clear();
@@ -69,6 +162,7 @@ static common::Status SyncProviders(const SessionState::NameNodeInfoMapType& nod
 }
 
 common::Status IOBinding::SynchronizeInputs() {
+  ORT_RETURN_IF_ERROR(WaitForStagedInputs());
   ORT_RETURN_IF_ERROR(SyncProviders(session_state_.GetInputNodeInfoMap(), session_state_));
   return Status::OK();
 }
@@ -94,9 +188,11 @@ common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue
     output_names_.push_back(name);
     outputs_.push_back(ml_value);
     outputs_device_info_.push_back(device);
+    outputs_bound_to_device_.push_back(!ml_value.IsAllocated());
   } else {
     outputs_[index] = ml_value;
     outputs_device_info_[index] = device;
+    outputs_bound_to_device_[index] = !ml_value.IsAllocated();
   }
   ORT_ENFORCE(mapped_output_names_.size() == output_names_.size(), "Size mismatch", mapped_output_names_.size(), "!=", output_names_.size());
 
@@ -108,6 +204,73 @@ void IOBinding::ClearOutputs() {
   output_names_.clear();
   outputs_.clear();
   outputs_device_info_.clear();
+  outputs_bound_to_device_.clear();
+}
+
+void IOBinding::PrepareOutputsForRun(std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  if (!use_output_pool_) {
+    return;
+  }
+
+  for (size_t i = 0, end = output_names_.size(); i < end; ++i) {
+    if (!outputs_bound_to_device_[i]) {
+      continue;
+    }
+
+    // drop the value from the previous run so it isn't treated as pre-allocated, which would fail if the shape
+    // changed. it's still in the pool if it can be reused.
+    outputs_[i] = OrtValue();
+
+    auto pool_it = output_pool_.find(output_names_[i]);
+    if (pool_it == output_pool_.end()) {
+      continue;
+    }
+
+    // the pool isn't modified during the run so the pointer stays valid
+    const std::vector<OrtValue>* pooled_values = &pool_it->second;
+    fetch_allocators.emplace(i, [pooled_values](const TensorShape& shape, const OrtDevice& location,
+                                                OrtValue& ort_value, bool& allocated) {
+      for (const auto& value : *pooled_values) {
+        const Tensor& tensor = value.Get<Tensor>();
+        if (tensor.Shape() == shape && tensor.Location().device == location) {
+          ort_value = value;
+          allocated = true;
+          break;
+        }
+      }
+      return Status::OK();
+    });
+  }
+}
+
+void IOBinding::UpdateOutputPool() {
+  if (!use_output_pool_) {
+    return;
+  }
+
+  for (size_t i = 0, end = output_names_.size(); i < end; ++i) {
+    const OrtValue& output = outputs_[i];
+    if (!outputs_bound_to_device_[i] || !output.IsTensor() || output.Get<Tensor>().IsDataTypeString()) {
+      continue;
+    }
+
+    auto& pooled_values = output_pool_[output_names_[i]];
+    const void* data = output.Get<Tensor>().DataRaw();
+    auto it = std::find_if(pooled_values.begin(), pooled_values.end(), [data](const OrtValue& value) {
+      return value.Get<Tensor>().DataRaw() == data;
+    });
+
+    if (it != pooled_values.end()) {
+      // reused. move to the most recently used position
+      std::rotate(it, it + 1, pooled_values.end());
+      continue;
+    }
+
+    pooled_values.push_back(output);
+    if (pooled_values.size() > kMaxPooledValuesPerOutput) {
+      pooled_values.erase(pooled_values.begin());
+    }
+  }
 }
 
 const std::vector<std::string>& IOBinding::GetOutputNames() const { return output_names_; }
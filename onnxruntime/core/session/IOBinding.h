@@ -2,14 +2,17 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
 #include "core/framework/execution_provider.h"
+#include "core/framework/iexecutor.h"
 #include "core/common/status.h"
 #include "core/graph/basic_types.h"
 #include "core/framework/ort_value.h"
+#include "core/framework/stream_handles.h"
 #include "core/session/inference_session.h"
 #include "core/common/logging/logging.h"
 
@@ -107,11 +110,50 @@ class IOBinding {
   std::vector<OrtValue> outputs_;
   std::vector<OrtDevice> outputs_device_info_;
 
+  // true for outputs bound to a device rather than to a pre-allocated value.
+  std::vector<bool> outputs_bound_to_device_;
+
+  // Outputs produced for outputs bound to a device, keyed by output name and most recently used last.
+  // Only used if use_output_pool_ is true (kOrtSessionOptionsConfigIOBindingReuseOutputs).
+  // Kept across ClearOutputs() so rebinding an output to a device each run still reuses them.
+  bool use_output_pool_{false};
+  std::unordered_map<std::string, std::vector<OrtValue>> output_pool_;
+  static constexpr size_t kMaxPooledValuesPerOutput = 4;
+
+  // Inputs bound from CPU memory for a device are copied into pinned memory and then to the device asynchronously on
+  // staging_stream_, so the transfer overlaps with the work still running on the device.
+  // Only used if stage_inputs_ is true (kOrtSessionOptionsConfigIOBindingStageInputs).
+  struct StagedInput {
+    // double buffers: a bind fills one slot while the other may still be read by the previous run.
+    OrtValue pinned[2];
+    OrtValue device[2];
+    size_t next_slot{0};
+  };
+  bool stage_inputs_{false};
+  std::unordered_map<std::string, StagedInput> staged_inputs_;
+  std::unique_ptr<Stream> staging_stream_;
+  // true if copies were issued on staging_stream_ since the last WaitForStagedInputs().
+  bool staged_copies_pending_{false};
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 
+  // Stages a CPU tensor bound to input name. staged is false if the input is not consumed on a device that has pinned
+  // memory and a stream, in which case it is copied as usual.
+  common::Status StageInput(const std::string& name, const Tensor& tensor, OrtValue& staged_value, bool& staged);
+
+  // Waits for the copies of the staged inputs. Called by SynchronizeInputs() and by InferenceSession before a run.
+  common::Status WaitForStagedInputs();
+
   // device info for all outputs. only used by InferenceSession if the output is not pre-allocated.
   const std::vector<OrtDevice>& GetOutputsDeviceInfo() const;
 
+  // Called by InferenceSession before a run. If the output pool is used, resets the outputs bound to a device so
+  // the run allocates them, and adds a fetch allocator that returns a pooled value with the requested shape.
+  void PrepareOutputsForRun(std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // Called by InferenceSession after a successful run to add the outputs bound to a device to the output pool.
+  void UpdateOutputPool();
+
   // The implementation for the BindOutput() overloads
   common::Status BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device);
 };
@@ -176,6 +176,13 @@ ORT_API_STATUS_IMPL(OrtApis::SetUserLoggingFunction, _In_ OrtSessionOptions* opt
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionOptionsSetTracingCallback, _Inout_ OrtSessionOptions* options,
+                    _In_opt_ OrtTracingSpanFn tracing_callback, _In_opt_ void* user_data) {
+  options->value.tracing_span_fn = tracing_callback;
+  options->value.tracing_user_data = user_data;
+  return nullptr;
+}
+
 ///< applies to session load, initialization, etc
 ORT_API_STATUS_IMPL(OrtApis::SetSessionLogVerbosityLevel, _In_ OrtSessionOptions* options, int session_log_verbosity_level) {
   options->value.session_log_verbosity_level = session_log_verbosity_level;
@@ -3,9 +3,11 @@
 
 #include "core/session/environment.h"
 
+#include <algorithm>
 #include <array>
 
 #include "core/common/basic_types.h"
+#include "core/common/path_string.h"
 #include "core/framework/allocator.h"
 #include "core/framework/allocator_utils.h"
 #include "core/framework/error_code_helper.h"
@@ -199,26 +201,8 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
   AllocatorPtr allocator_ptr;
   // create appropriate DeviceAllocatorRegistrationInfo and allocator based on create_arena
   if (create_arena) {
-    // defaults in case arena_cfg is nullptr (not supplied by the user)
-    size_t max_mem = 0;
-    int arena_extend_strategy = -1;
-    int initial_chunk_size_bytes = -1;
-    int max_dead_bytes_per_chunk = -1;
-    int initial_growth_chunk_size_bytes = -1;
-    int64_t max_power_of_two_extend_bytes = -1L;
-
-    // override with values from the user supplied arena_cfg object
-    if (arena_cfg) {
-      max_mem = arena_cfg->max_mem;
-      arena_extend_strategy = arena_cfg->arena_extend_strategy;
-      initial_chunk_size_bytes = arena_cfg->initial_chunk_size_bytes;
-      max_dead_bytes_per_chunk = arena_cfg->max_dead_bytes_per_chunk;
-      initial_growth_chunk_size_bytes = arena_cfg->initial_growth_chunk_size_bytes;
-      max_power_of_two_extend_bytes = arena_cfg->max_power_of_two_extend_bytes;
-    }
-
-    OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
-                            initial_growth_chunk_size_bytes, max_power_of_two_extend_bytes};
+    // the defaults of OrtArenaCfg are used if arena_cfg is nullptr (not supplied by the user)
+    const OrtArenaCfg l_arena_cfg = arena_cfg != nullptr ? *arena_cfg : OrtArenaCfg{};
     AllocatorCreationInfo alloc_creation_info{
         [mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); },
         0,
@@ -387,6 +371,52 @@ Status Environment::SetGlobalThreadingOptions(const OrtThreadingOptions& tp_opti
   return Status::OK();
 }
 
+Status Environment::RegisterThreadPoolPartition(const std::string& name, const OrtThreadingOptions& tp_options) {
+  ORT_RETURN_IF(name.empty(), "Thread pool partition name must not be empty");
+
+  std::lock_guard<std::mutex> lock{thread_pool_partitions_mutex_};
+  if (thread_pool_partitions_.find(name) != thread_pool_partitions_.end()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "A thread pool partition named '", name, "' is already registered");
+  }
+
+  auto partition = std::make_unique<ThreadPoolPartition>();
+  partition->intra_op_thread_pool_name = ToPathString(name) + ORT_TSTR("-intra-op");
+  partition->inter_op_thread_pool_name = ToPathString(name) + ORT_TSTR("-inter-op");
+
+  OrtThreadPoolParams to = tp_options.intra_op_thread_pool_params;
+  to.name = partition->intra_op_thread_pool_name.c_str();
+  partition->intra_op_thread_pool = concurrency::CreateThreadPool(&Env::Default(), to,
+                                                                  concurrency::ThreadPoolType::INTRA_OP);
+  to = tp_options.inter_op_thread_pool_params;
+  to.name = partition->inter_op_thread_pool_name.c_str();
+  partition->inter_op_thread_pool = concurrency::CreateThreadPool(&Env::Default(), to,
+                                                                  concurrency::ThreadPoolType::INTER_OP);
+
+  thread_pool_partitions_.emplace(name, std::move(partition));
+  return Status::OK();
+}
+
+const Environment::ThreadPoolPartition* Environment::GetThreadPoolPartition(const std::string& name) const {
+  std::lock_guard<std::mutex> lock{thread_pool_partitions_mutex_};
+  auto it = thread_pool_partitions_.find(name);
+  return it != thread_pool_partitions_.end() ? it->second.get() : nullptr;
+}
+
+concurrency::ThreadPool* Environment::GetSessionInitThreadPool() const {
+  std::call_once(session_init_thread_pool_once_, [this]() {
+    // one more than the number of workers, as the thread pool counts the thread that creates it
+    constexpr int kMaxSessionInitThreads = 4;
+    OrtThreadPoolParams to;
+    to.name = ORT_TSTR("session-init");
+    to.thread_pool_size = 1 + std::clamp(Env::Default().GetNumPhysicalCpuCores(), 1, kMaxSessionInitThreads);
+    to.allow_spinning = false;
+    session_init_thread_pool_ = concurrency::CreateThreadPool(&Env::Default(), to,
+                                                              concurrency::ThreadPoolType::INTER_OP);
+  });
+  return session_init_thread_pool_.get();
+}
+
 Status Environment::CreateAndRegisterAllocatorV2(const std::string& provider_type, const OrtMemoryInfo& mem_info,
                                                  const std::unordered_map<std::string, std::string>& options,
                                                  const OrtArenaCfg* arena_cfg) {
@@ -420,7 +450,10 @@ Status Environment::CreateAndRegisterAllocatorV2(const std::string& provider_typ
                 provider_type + " is not implemented in CreateAndRegisterAllocatorV2()"};
 }
 
-Environment::~Environment() = default;
+Environment::~Environment() {
+  // wait for the pending session initializations while the rest of the environment is still valid
+  session_init_thread_pool_.reset();
+}
 
 Status Environment::GetSharedAllocator(const OrtMemoryInfo& mem_info, OrtAllocator*& allocator) {
   std::lock_guard<std::mutex> lock{mutex_};
@@ -12,6 +12,7 @@
 #include "core/framework/error_code_helper.h"
 #include "core/framework/model_metadef_id_generator.h"
 #include "core/framework/plugin_data_transfer.h"
+#include "core/framework/plugin_ep_stream.h"
 #include "core/graph/ep_api_types.h"
 #include "core/graph/model_editor_api_types.h"
 #include "core/session/abi_devices.h"
@@ -550,6 +551,35 @@ std::unique_ptr<onnxruntime::IDataTransfer> PluginExecutionProvider::GetDataTran
   return std::make_unique<plugin_ep::DataTransfer>(*data_transfer_impl);
 }
 
+void PluginExecutionProvider::RegisterStreamHandlers(IStreamCommandHandleRegistry& registry,
+                                                     AllocatorMap& /*allocators*/) const {
+  if (ep_factory_.IsStreamAware == nullptr || !ep_factory_.IsStreamAware(&ep_factory_)) {
+    return;
+  }
+
+  // ORT doesn't use streams for CPU nodes
+  const OrtDevice::DeviceType device_type = default_device_.Type();
+  if (device_type == OrtDevice::CPU) {
+    return;
+  }
+
+  ORT_ENFORCE(ep_factory_.CreateSyncStreamForDevice != nullptr, "Execution provider '", Type(),
+              "' is stream aware but its factory does not implement CreateSyncStreamForDevice.");
+
+  // wait on a notification from the EP's stream on another stream of the EP, or on the CPU
+  registry.RegisterWaitFn(device_type, device_type, plugin_ep::Notification::WaitNotificationOnDevice);
+  registry.RegisterWaitFn(device_type, OrtDevice::CPU, plugin_ep::Notification::WaitNotificationOnHost);
+
+  registry.RegisterCreateStreamFn(device_type, [&ep_factory = ep_factory_](const OrtDevice& device) {
+    OrtSyncStreamImpl* stream_impl = nullptr;
+    ORT_THROW_IF_ERROR(ToStatusAndRelease(ep_factory.CreateSyncStreamForDevice(
+        &ep_factory, static_cast<const OrtMemoryDevice*>(&device), /*stream_options*/ nullptr, &stream_impl)));
+    ORT_ENFORCE(stream_impl != nullptr, "OrtEpFactory::CreateSyncStreamForDevice returned a null stream.");
+
+    return std::make_unique<plugin_ep::Stream>(device, *stream_impl);
+  });
+}
+
 std::vector<AllocatorPtr> PluginExecutionProvider::CreatePreferredAllocators() {
   std::vector<AllocatorPtr> allocators;
   allocators.reserve(allocator_mem_infos_.size());
@@ -94,6 +94,9 @@ class PluginExecutionProvider : public IExecutionProvider {
 
   std::unique_ptr<IDataTransfer> GetDataTransfer() const override;
 
+  // register the plugin EP's streams if its factory is stream aware
+  void RegisterStreamHandlers(IStreamCommandHandleRegistry& registry, AllocatorMap& allocators) const override;
+
   // create per-session allocators
   // longer term we should prefer shared allocators in Environment and only create per-session allocators as
   // needed based on matching against allocator_mem_infos_.
@@ -0,0 +1,261 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/graph_capture_shape_buckets.h"
+
+#include <algorithm>
+
+#include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
+#include "core/framework/tensor.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Copies num_bytes from src to dst, which may be on different devices.
+Status CopyBytes(const DataTransferManager& data_transfer, const void* src, const OrtMemoryInfo& src_location,
+                 void* dst, const OrtMemoryInfo& dst_location, size_t num_bytes) {
+  if (num_bytes == 0) {
+    return Status::OK();
+  }
+
+  const TensorShape shape{static_cast<int64_t>(num_bytes)};
+  const Tensor src_view{DataTypeImpl::GetType<uint8_t>(), shape, const_cast<void*>(src), src_location};
+  Tensor dst_view{DataTypeImpl::GetType<uint8_t>(), shape, dst, dst_location};
+  return data_transfer.CopyTensor(src_view, dst_view);
+}
+
+}  // namespace
+
+Status GraphCaptureShapeBuckets::ParseConfig(const std::string& value, Config& config) {
+  const auto separator = value.find(':');
+  ORT_RETURN_IF(separator == std::string::npos || separator == 0,
+                "Graph capture shape buckets must be \"dim_param:size,size,...\", got \"", value, "\"");
+
+  config.dim_param = value.substr(0, separator);
+  config.bucket_sizes.clear();
+  for (const auto size_str : utils::SplitString(std::string_view{value}.substr(separator + 1), ",")) {
+    int64_t size = 0;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(size_str, size) && size > 0,
+                      "Invalid graph capture bucket size \"", size_str, "\" in \"", value, "\"");
+    ORT_RETURN_IF_NOT(config.bucket_sizes.empty() || size > config.bucket_sizes.back(),
+                      "Graph capture bucket sizes must be ascending, got \"", value, "\"");
+    config.bucket_sizes.push_back(size);
+  }
+  ORT_RETURN_IF(config.bucket_sizes.empty(), "No graph capture bucket size in \"", value, "\"");
+
+  return Status::OK();
+}
+
+GraphCaptureShapeBuckets::GraphCaptureShapeBuckets(Config config,
+                                                   InlinedHashMap<std::string, size_t> input_axes,
+                                                   InlinedHashMap<std::string, size_t> output_axes,
+                                                   const OrtDevice& device,
+                                                   GetAllocatorFn get_allocator,
+                                                   const DataTransferManager& data_transfer,
+                                                   RunFn run_fn)
+    : config_(std::move(config)),
+      input_axes_(std::move(input_axes)),
+      output_axes_(std::move(output_axes)),
+      device_(device),
+      get_allocator_(std::move(get_allocator)),
+      data_transfer_(data_transfer),
+      run_fn_(std::move(run_fn)) {
+}
+
+int64_t GraphCaptureShapeBuckets::GetDimSize(gsl::span<const std::string> feed_names,
+                                             gsl::span<const OrtValue> feeds) const {
+  int64_t dim_size = -1;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!feeds[i].IsTensor() || feeds[i].Get<Tensor>().IsDataTypeString()) {
+      return -1;
+    }
+
+    const auto axis = input_axes_.find(feed_names[i]);
+    if (axis == input_axes_.end()) {
+      continue;
+    }
+
+    const auto& shape = feeds[i].Get<Tensor>().Shape();
+    if (axis->second >= shape.NumDimensions() || (dim_size >= 0 && shape[axis->second] != dim_size)) {
+      return -1;
+    }
+    dim_size = shape[axis->second];
+  }
+
+  return dim_size;
+}
+
+Status GraphCaptureShapeBuckets::RunUncaptured(const RunOptions& run_options,
+                                               gsl::span<const std::string> feed_names,
+                                               gsl::span<const OrtValue> feeds,
+                                               gsl::span<const std::string> output_names,
+                                               std::vector<OrtValue>* fetches,
+                                               const std::vector<OrtDevice>* fetches_device_info) const {
+  RunOptions uncaptured_run_options = run_options;
+  ORT_RETURN_IF_ERROR(uncaptured_run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigCudaGraphAnnotation,
+                                                                          "-1"));
+  return run_fn_(uncaptured_run_options, feed_names, feeds, output_names, fetches, fetches_device_info);
+}
+
+Status GraphCaptureShapeBuckets::GetZeros(size_t num_bytes, const void*& zeros) {
+  if (zeros_bytes_ < num_bytes) {
+    auto allocator = get_allocator_(device_);
+    ORT_RETURN_IF(allocator == nullptr, "No allocator for the graph capture device ", device_.ToString());
+
+    zeros_ = IAllocator::MakeUniquePtr<void>(allocator, num_bytes);
+    zeros_allocator_ = allocator;
+    const std::vector<uint8_t> host_zeros(num_bytes, 0);
+    ORT_RETURN_IF_ERROR(CopyBytes(data_transfer_, host_zeros.data(), CPUAllocator::DefaultInstance()->Info(),
+                                  zeros_.get(), allocator->Info(), num_bytes));
+    zeros_bytes_ = num_bytes;
+  }
+
+  zeros = zeros_.get();
+  return Status::OK();
+}
+
+Status GraphCaptureShapeBuckets::CopyAlongAxis(const Tensor& src, Tensor& dst, size_t axis) {
+  ORT_RETURN_IF(src.IsDataTypeString(), "Graph capture shape buckets don't support string tensors");
+  if (src.Shape() == dst.Shape()) {
+    return data_transfer_.CopyTensor(src, dst);
+  }
+
+  const auto& src_shape = src.Shape();
+  const auto& dst_shape = dst.Shape();
+  const size_t outer = narrow<size_t>(src_shape.SizeToDimension(axis));
+  const size_t inner_bytes = narrow<size_t>(src_shape.SizeFromDimension(axis + 1)) * src.DataType()->Size();
+  const size_t src_block_bytes = narrow<size_t>(src_shape[axis]) * inner_bytes;
+  const size_t dst_block_bytes = narrow<size_t>(dst_shape[axis]) * inner_bytes;
+  const size_t copy_bytes = std::min(src_block_bytes, dst_block_bytes);
+  const size_t pad_bytes = dst_block_bytes - copy_bytes;
+
+  const void* zeros = nullptr;
+  if (pad_bytes > 0) {
+    ORT_RETURN_IF_ERROR(GetZeros(pad_bytes, zeros));
+  }
+
+  const auto* src_data = static_cast<const uint8_t*>(src.DataRaw());
+  auto* dst_data = static_cast<uint8_t*>(dst.MutableDataRaw());
+  for (size_t i = 0; i < outer; ++i) {
+    ORT_RETURN_IF_ERROR(CopyBytes(data_transfer_, src_data + i * src_block_bytes, src.Location(),
+                                  dst_data + i * dst_block_bytes, dst.Location(), copy_bytes));
+    // the padding of a previous, longer input of the bucket is overwritten with zeros.
+    if (pad_bytes > 0) {
+      ORT_RETURN_IF_ERROR(CopyBytes(data_transfer_, zeros, zeros_allocator_->Info(),
+                                    dst_data + i * dst_block_bytes + copy_bytes, dst.Location(), pad_bytes));
+    }
+  }
+
+  return Status::OK();
+}
+
+Status GraphCaptureShapeBuckets::Run(const RunOptions& run_options,
+                                     gsl::span<const std::string> feed_names,
+                                     gsl::span<const OrtValue> feeds,
+                                     gsl::span<const std::string> output_names,
+                                     std::vector<OrtValue>* fetches,
+                                     const std::vector<OrtDevice>* fetches_device_info) {
+  const int64_t dim_size = GetDimSize(feed_names, feeds);
+  const auto bucket_size = std::lower_bound(config_.bucket_sizes.begin(), config_.bucket_sizes.end(), dim_size);
+  if (dim_size < 0 || bucket_size == config_.bucket_sizes.end()) {
+    return RunUncaptured(run_options, feed_names, feeds, output_names, fetches, fetches_device_info);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (buckets_.empty()) {
+    feed_names_.assign(feed_names.begin(), feed_names.end());
+    output_names_.assign(output_names.begin(), output_names.end());
+  } else if (!std::equal(feed_names.begin(), feed_names.end(), feed_names_.begin(), feed_names_.end()) ||
+             !std::equal(output_names.begin(), output_names.end(), output_names_.begin(), output_names_.end())) {
+    LOGS_DEFAULT(WARNING) << "The graphs of the shape buckets were captured with other inputs or outputs. "
+                          << "Running without graph capture.";
+    return RunUncaptured(run_options, feed_names, feeds, output_names, fetches, fetches_device_info);
+  }
+
+  // the bucket is keyed by the rank and padded dimensions of every feed.
+  std::vector<int64_t> key;
+  InlinedVector<TensorShape> padded_shapes;
+  InlinedVector<size_t> feed_axes;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    auto dims = feeds[i].Get<Tensor>().Shape().AsShapeVector();
+    const auto axis = input_axes_.find(feed_names[i]);
+    if (axis != input_axes_.end()) {
+      dims[axis->second] = *bucket_size;
+    }
+    feed_axes.push_back(axis != input_axes_.end() ? axis->second : 0);
+    key.push_back(static_cast<int64_t>(dims.size()));
+    key.insert(key.end(), dims.begin(), dims.end());
+    padded_shapes.emplace_back(dims);
+  }
+
+  auto [bucket_it, inserted] = buckets_.try_emplace(std::move(key));
+  Bucket& bucket = bucket_it->second;
+  if (inserted) {
+    auto allocator = get_allocator_(device_);
+    ORT_RETURN_IF(allocator == nullptr, "No allocator for the graph capture device ", device_.ToString());
+
+    bucket.graph_annotation_id = next_graph_annotation_id_++;
+    bucket.feeds.resize(feeds.size());
+    for (size_t i = 0; i < feeds.size(); ++i) {
+      Tensor::InitOrtValue(feeds[i].Get<Tensor>().DataType(), padded_shapes[i], allocator, bucket.feeds[i]);
+    }
+    LOGS_DEFAULT(INFO) << "Capturing the graph of the inputs padded to " << config_.dim_param << "="
+                       << *bucket_size << " with graph annotation id " << bucket.graph_annotation_id;
+  }
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    ORT_RETURN_IF_ERROR(CopyAlongAxis(feeds[i].Get<Tensor>(), *bucket.feeds[i].GetMutable<Tensor>(), feed_axes[i]));
+  }
+
+  // the first runs of the bucket allocate its fetches, the graph is then captured and replayed on them.
+  RunOptions graph_run_options = run_options;
+  ORT_RETURN_IF_ERROR(graph_run_options.config_options.AddConfigEntry(
+      kOrtRunOptionsConfigCudaGraphAnnotation, std::to_string(bucket.graph_annotation_id).c_str()));
+  const std::vector<OrtDevice> graph_fetches_device_info(output_names.size(), device_);
+  ORT_RETURN_IF_ERROR(run_fn_(graph_run_options, feed_names, bucket.feeds, output_names, &bucket.fetches,
+                              &graph_fetches_device_info));
+
+  if (fetches->empty()) {
+    fetches->resize(output_names.size());
+  }
+  ORT_RETURN_IF_NOT(fetches->size() == output_names.size(), "Expected ", output_names.size(), " fetches, got ",
+                    fetches->size());
+
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    ORT_RETURN_IF_NOT(bucket.fetches[i].IsTensor(), "Graph capture shape buckets only support tensor outputs, ",
+                      output_names[i], " is not a tensor");
+    const Tensor& padded = bucket.fetches[i].Get<Tensor>();
+
+    // the outputs that have the padded size along the dimension are sliced back to the size of the inputs.
+    auto dims = padded.Shape().AsShapeVector();
+    size_t axis = 0;
+    if (const auto output_axis = output_axes_.find(output_names[i]);
+        output_axis != output_axes_.end() && output_axis->second < dims.size() &&
+        dims[output_axis->second] == *bucket_size) {
+      axis = output_axis->second;
+      dims[axis] = dim_size;
+    }
+
+    OrtValue& fetch = (*fetches)[i];
+    if (!fetch.IsAllocated()) {
+      const OrtDevice fetch_device = fetches_device_info != nullptr ? (*fetches_device_info)[i] : OrtDevice();
+      auto allocator = get_allocator_(fetch_device);
+      ORT_RETURN_IF(allocator == nullptr, "No allocator for the output device ", fetch_device.ToString());
+      Tensor::InitOrtValue(padded.DataType(), TensorShape(dims), allocator, fetch);
+    } else {
+      ORT_RETURN_IF_NOT(fetch.IsTensor() && fetch.Get<Tensor>().Shape() == TensorShape(dims),
+                        "The preallocated output ", output_names[i], " doesn't have the shape ", TensorShape(dims));
+    }
+
+    ORT_RETURN_IF_ERROR(CopyAlongAxis(padded, *fetch.GetMutable<Tensor>(), axis));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
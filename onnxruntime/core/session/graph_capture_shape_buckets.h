@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/data_transfer_manager.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+
+/// <summary>
+/// Lets a session that captures CUDA/HIP graphs run inputs of varying size along a symbolic dimension without the
+/// application managing graph annotation ids.
+///
+/// The inputs are padded with zeros along the dimension to the nearest configured bucket size and copied into device
+/// buffers owned by the bucket, so every run of a bucket reads and writes the same addresses. Each distinct set of
+/// padded input shapes gets its own graph annotation id: the first runs allocate the memory and capture the graph,
+/// later runs replay it. The outputs are sliced back along the dimension to the size of the inputs and copied to the
+/// caller.
+///
+/// Padding is only correct for models whose valid outputs don't depend on the padded positions, e.g. when they are
+/// masked like the padding of a sequence. Inputs that don't fit in any bucket, or whose sizes along the dimension
+/// disagree, are run without graph capture.
+/// </summary>
+class GraphCaptureShapeBuckets {
+ public:
+  struct Config {
+    // Symbolic dimension (dim_param) of the graph inputs and outputs that is padded to a bucket size.
+    std::string dim_param;
+    // Ascending bucket sizes.
+    InlinedVector<int64_t> bucket_sizes;
+  };
+
+  /// <summary>
+  /// Parses "dim_param:size,size,...", e.g. "sequence_length:32,64,128".
+  /// </summary>
+  static Status ParseConfig(const std::string& value, Config& config);
+
+  using RunFn = std::function<Status(const RunOptions& run_options,
+                                     gsl::span<const std::string> feed_names,
+                                     gsl::span<const OrtValue> feeds,
+                                     gsl::span<const std::string> output_names,
+                                     std::vector<OrtValue>* fetches,
+                                     const std::vector<OrtDevice>* fetches_device_info)>;
+  using GetAllocatorFn = std::function<AllocatorPtr(const OrtDevice& device)>;
+
+  /// <param name="config">Bucketing configuration.</param>
+  /// <param name="input_axes">Axis of config.dim_param for each graph input that has it.</param>
+  /// <param name="output_axes">Axis of config.dim_param for each graph output that has it.</param>
+  /// <param name="device">Device of the buffers read and written by the captured graphs.</param>
+  /// <param name="get_allocator">Returns the allocator of a device.</param>
+  /// <param name="data_transfer">Copies between the caller and the device buffers.</param>
+  /// <param name="run_fn">Runs the session with a graph annotation id in the run options.</param>
+  GraphCaptureShapeBuckets(Config config,
+                           InlinedHashMap<std::string, size_t> input_axes,
+                           InlinedHashMap<std::string, size_t> output_axes,
+                           const OrtDevice& device,
+                           GetAllocatorFn get_allocator,
+                           const DataTransferManager& data_transfer,
+                           RunFn run_fn);
+
+  /// <summary>
+  /// Runs the feeds in their bucket. Same contract as InferenceSession::Run: fetches may be preallocated, and the
+  /// outputs are allocated on fetches_device_info, or on CPU if it is null.
+  /// </summary>
+  Status Run(const RunOptions& run_options,
+             gsl::span<const std::string> feed_names,
+             gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names,
+             std::vector<OrtValue>* fetches,
+             const std::vector<OrtDevice>* fetches_device_info);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphCaptureShapeBuckets);
+
+  // The buffers of a captured graph.
+  struct Bucket {
+    int graph_annotation_id;
+    std::vector<OrtValue> feeds;
+    std::vector<OrtValue> fetches;
+  };
+
+  // Returns the size of the feeds along config_.dim_param, or -1 if they can't be padded.
+  int64_t GetDimSize(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds) const;
+
+  Status RunUncaptured(const RunOptions& run_options,
+                       gsl::span<const std::string> feed_names,
+                       gsl::span<const OrtValue> feeds,
+                       gsl::span<const std::string> output_names,
+                       std::vector<OrtValue>* fetches,
+                       const std::vector<OrtDevice>* fetches_device_info) const;
+
+  // Copies src into dst, which differ in size along axis. dst is padded with zeros or src is truncated.
+  Status CopyAlongAxis(const Tensor& src, Tensor& dst, size_t axis);
+
+  // Returns device memory of at least num_bytes zero bytes.
+  Status GetZeros(size_t num_bytes, const void*& zeros);
+
+  const Config config_;
+  const InlinedHashMap<std::string, size_t> input_axes_;
+  const InlinedHashMap<std::string, size_t> output_axes_;
+  const OrtDevice device_;
+  const GetAllocatorFn get_allocator_;
+  const DataTransferManager& data_transfer_;
+  const RunFn run_fn_;
+
+  // A graph replays on the buffers it was captured with, so the runs of the buckets are serialized.
+  std::mutex mutex_;
+  // The input and output names all the buckets were captured with.
+  std::vector<std::string> feed_names_;
+  std::vector<std::string> output_names_;
+  // Buckets keyed by the padded shapes of their feeds.
+  std::map<std::vector<int64_t>, Bucket> buckets_;
+  int next_graph_annotation_id_{1};
+  AllocatorPtr zeros_allocator_;
+  IAllocatorUniquePtr<void> zeros_;
+  size_t zeros_bytes_{0};
+};
+
+}  // namespace onnxruntime
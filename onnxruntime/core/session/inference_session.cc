@@ -4,7 +4,11 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <list>
 #include <string>
@@ -14,6 +18,7 @@
 #include "core/common/denormal.h"
 #include "core/common/logging/isink.h"
 #include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
 #include "core/common/parse_string.h"
 #include "core/common/path_string.h"
 #include "core/common/string_utils.h"
@@ -34,6 +39,8 @@
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/prepacked_weights_disk_cache.h"
+#include "core/framework/run_deadline.h"
 #include "core/framework/transform_layout_functions.h"
 #include "core/framework/utils.h"
 #include "core/graph/graph_viewer.h"
@@ -44,6 +51,7 @@
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/graph_optimizer_registry.h"
 #include "core/optimizer/layout_transformation/layout_transformation.h"
+#include "core/optimizer/autocast_transformer.h"
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/optimizer/qdq_transformer/ensure_unique_dq_for_node_unit.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
@@ -70,6 +78,7 @@
 #endif
 #include "core/session/environment.h"
 #include "core/session/IOBinding.h"
+#include "core/session/prepared_run.h"
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
@@ -417,6 +426,7 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 
   use_per_session_threads_ = session_options.use_per_session_threads;
   force_spinning_stop_between_runs_ = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigForceSpinningStop, "0") == "1";
+  high_priority_runs_ = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigHighPriority, "0") == "1";
 
   if (use_per_session_threads_) {
     LOGS(*session_logger_, INFO) << "Creating and using per session threadpools since use_per_session_threads_ is true";
@@ -438,6 +448,10 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.allow_spinning = allow_intra_op_spinning;
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
+        to.adaptive_inline_threshold =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigAdaptiveInlineThreshold, "0") == "1";
+        to.adaptive_spinning =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigAdaptiveIntraOpSpinning, "0") == "1";
 
         // Set custom threading functions
         to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
@@ -492,15 +506,63 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
       }
     }
   } else {
-    LOGS(*session_logger_, INFO) << "Using global/env threadpools since use_per_session_threads_ is false";
-    intra_op_thread_pool_from_env_ = session_env.GetIntraOpThreadPool();
-    inter_op_thread_pool_from_env_ = session_env.GetInterOpThreadPool();
-    ORT_ENFORCE(session_env.EnvCreatedWithGlobalThreadPools(),
-                "When the session is not configured to use per session"
-                " threadpools, the env must be created with the the CreateEnvWithGlobalThreadPools API.");
+    std::string thread_pool_partition;
+    if (session_options_.config_options.TryGetConfigEntry(kOrtSessionOptionsConfigThreadPoolPartition,
+                                                          thread_pool_partition)) {
+      LOGS(*session_logger_, INFO) << "Using env threadpool partition '" << thread_pool_partition
+                                   << "' since use_per_session_threads_ is false";
+      const auto* partition = session_env.GetThreadPoolPartition(thread_pool_partition);
+      ORT_ENFORCE(partition != nullptr, "Thread pool partition '", thread_pool_partition,
+                  "' has not been registered with the env.");
+      intra_op_thread_pool_from_env_ = partition->intra_op_thread_pool.get();
+      inter_op_thread_pool_from_env_ = partition->inter_op_thread_pool.get();
+    } else {
+      LOGS(*session_logger_, INFO) << "Using global/env threadpools since use_per_session_threads_ is false";
+      intra_op_thread_pool_from_env_ = session_env.GetIntraOpThreadPool();
+      inter_op_thread_pool_from_env_ = session_env.GetInterOpThreadPool();
+      ORT_ENFORCE(session_env.EnvCreatedWithGlobalThreadPools(),
+                  "When the session is not configured to use per session"
+                  " threadpools, the env must be created with the the CreateEnvWithGlobalThreadPools API.");
+    }
+  }
+
+  const auto run_async_max_batch_size = ParseStringWithClassicLocale<int64_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigRunAsyncMaxBatchSize, "0"));
+  if (run_async_max_batch_size > 1) {
+    RunAsyncBatcher::Config batcher_config;
+    batcher_config.max_batch_size = run_async_max_batch_size;
+    batcher_config.max_queue_delay = std::chrono::microseconds(ParseStringWithClassicLocale<int64_t>(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigRunAsyncMaxQueueDelayMicros,
+                                                           "1000")));
+    batcher_config.batch_dim = ParseStringWithClassicLocale<size_t>(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigRunAsyncBatchDim, "0"));
+    LOGS(*session_logger_, INFO) << "Batching RunAsync requests up to a batch size of "
+                                 << batcher_config.max_batch_size << " along dimension " << batcher_config.batch_dim;
+
+    run_async_batcher_ = std::make_unique<RunAsyncBatcher>(
+        batcher_config,
+        [this](const RunOptions& run_options, gsl::span<const char* const> feed_names,
+               gsl::span<const OrtValue* const> feeds, gsl::span<const char* const> fetch_names,
+               gsl::span<OrtValue*> fetches) {
+          return Run(run_options, feed_names, feeds, fetch_names, fetches);
+        },
+        [this](std::function<void()> fn) {
+          concurrency::ThreadPool::Schedule(GetIntraOpThreadPoolToUse(), std::move(fn));
+        });
   }
 
   session_profiler_.Initialize(session_logger_);
+  session_profiler_.SetSampleInterval(ParseStringWithClassicLocale<size_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsProfilingSampleInterval, "1")));
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsProfilingNodeStats, "0") == "1") {
+    session_profiler_.EnableNodeStats();
+  }
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsProfilingHardwareCounters, "0") == "1") {
+    session_profiler_.EnableHardwareCounters();
+  }
+  if (session_options_.tracing_span_fn != nullptr) {
+    run_tracer_ = std::make_unique<RunTracer>(session_options_.tracing_span_fn, session_options_.tracing_user_data);
+  }
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
@@ -718,6 +780,10 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  // dispatch any queued RunAsync requests while the session is still intact
+  run_async_batcher_.reset();
+  arena_trimmer_.reset();
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -903,6 +969,7 @@ common::Status InferenceSession::RegisterGraphTransformer(
                           "Graph transformers must be registered before the session is initialized.");
   }
 
+  has_custom_graph_transformers_ = true;
   return graph_transformer_mgr_.Register(std::move(p_graph_transformer), level);
 }
 
@@ -932,10 +999,27 @@ common::Status InferenceSession::SaveToOrtFormat(const std::filesystem::path& fi
   ORT_RETURN_IF_ERROR(
       kernel_type_str_resolver.SaveToOrtFormat(builder, fbs_kernel_type_str_resolver));
 
+  flatbuffers::Offset<fbs::AllocationPlan> fbs_allocation_plan;
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSaveAllocationPlan, "0") == "1") {
+    const auto* exec_plan = session_state_ ? session_state_->GetExecutionPlan() : nullptr;
+    if (exec_plan != nullptr && exec_plan->execution_plan.size() == 1) {
+      const auto& execution_order = session_state_->GetGraphViewer().GetNodesInTopologicalOrder(
+          session_options_.execution_order);
+      ORT_RETURN_IF_ERROR(SavedAllocationPlan::SaveToOrtFormat(*exec_plan, session_state_->GetOrtValueNameIdxMap(),
+                                                               execution_order, builder, fbs_allocation_plan));
+    } else {
+      LOGS(*session_logger_, WARNING) << "The allocation plan is not saved as the main graph is not planned as a "
+                                         "single logic stream.";
+    }
+  }
+
   fbs::InferenceSessionBuilder sb(builder);
   sb.add_ort_version(ort_model_version);
   sb.add_model(fbs_model);
   sb.add_kernel_type_str_resolver(fbs_kernel_type_str_resolver);
+  if (!fbs_allocation_plan.IsNull()) {
+    sb.add_allocation_plan(fbs_allocation_plan);
+  }
   auto session = sb.Finish();
   builder.Finish(session, fbs::InferenceSessionIdentifier());
 
@@ -950,6 +1034,135 @@ common::Status InferenceSession::SaveToOrtFormat(const std::filesystem::path& fi
   return Status::OK();
 }
 
+std::filesystem::path InferenceSession::GetOptimizedModelCachePath() const {
+  const std::string cache_dir = session_options_.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsOptimizedModelCacheDir, "");
+  if (cache_dir.empty() || !ort_format_model_bytes_.empty() || !session_options_.optimized_model_filepath.empty()) {
+    return {};
+  }
+
+  // the optimizations of other EPs depend on their options and devices, and custom transformers or
+  // initializers provided by the application aren't part of the key
+  for (const auto& ep : execution_providers_) {
+    if (ep->Type() != kCpuExecutionProvider) {
+      return {};
+    }
+  }
+  if (has_custom_graph_transformers_ || !session_options_.external_initializers.empty() ||
+      !session_options_.external_initializer_files_mmap.empty()) {
+    return {};
+  }
+
+  std::error_code ec;
+  const std::filesystem::path model_path = model_location_;
+  const auto model_size = model_path.empty() ? 0 : std::filesystem::file_size(model_path, ec);
+  if (model_path.empty() || ec || model_size == 0) {
+    // the model was loaded from memory
+    return {};
+  }
+
+  const Env& env = Env::Default();
+  Env::MappedMemoryPtr model_bytes;
+  if (!env.MapFileIntoMemory(model_path.native().c_str(), 0, narrow<size_t>(model_size), model_bytes).IsOK()) {
+    return {};
+  }
+
+  PrepackedWeightsDiskCache::KeyBuilder builder;
+  builder.Add(std::string_view{"optimized_model"});
+  builder.Add(static_cast<int64_t>(model_size)).Add(model_bytes.get(), narrow<size_t>(model_size));
+  model_bytes.reset();
+
+  // hashing external data would cost as much as loading it, so a change of it is detected by its size and time
+  std::set<std::string> external_data_files;
+  std::function<void(const Graph&)> collect_external_data_files = [&](const Graph& graph) {
+    for (const auto& [name, tensor_proto] : graph.GetAllInitializedTensors()) {
+      if (utils::HasExternalData(*tensor_proto) && !utils::HasExternalDataInMemory(*tensor_proto)) {
+        for (const auto& entry : tensor_proto->external_data()) {
+          if (entry.key() == "location") {
+            external_data_files.insert(entry.value());
+          }
+        }
+      }
+    }
+    for (const auto& node : graph.Nodes()) {
+      for (const auto& subgraph : node.GetSubgraphs()) {
+        collect_external_data_files(*subgraph);
+      }
+    }
+  };
+  collect_external_data_files(model_->MainGraph());
+  for (const auto& file : external_data_files) {
+    const auto file_path = model_path.parent_path() / ToPathString(file);
+    const auto file_size = std::filesystem::file_size(file_path, ec);
+    const auto write_time = std::filesystem::last_write_time(file_path, ec);
+    if (ec) {
+      return {};
+    }
+    builder.Add(file).Add(static_cast<int64_t>(file_size));
+    builder.Add(static_cast<int64_t>(write_time.time_since_epoch().count()));
+  }
+
+  for (const auto& ep_id : execution_providers_.GetIds()) {
+    builder.Add(ep_id);
+  }
+  builder.Add(static_cast<int64_t>(session_options_.graph_optimization_level));
+
+  const std::set<std::string_view> optimizers_to_disable(optimizers_to_disable_.begin(),
+                                                          optimizers_to_disable_.end());
+  for (const auto& optimizer : optimizers_to_disable) {
+    builder.Add(optimizer);
+  }
+  for (const auto& free_dimension_override : session_options_.free_dimension_overrides) {
+    builder.Add(free_dimension_override.dim_identifier);
+    builder.Add(static_cast<int64_t>(free_dimension_override.dim_identifier_type));
+    builder.Add(free_dimension_override.dim_value);
+  }
+
+  // hash maps are iterated in sorted order so the key doesn't depend on their layout
+  const std::map<std::string_view, std::string_view> configurations(
+      session_options_.config_options.configurations.begin(), session_options_.config_options.configurations.end());
+  for (const auto& [key, value] : configurations) {
+    builder.Add(key).Add(value);
+  }
+
+  std::filesystem::path cache_path = ToPathString(cache_dir);
+  if (cache_path.is_relative()) {
+    cache_path = model_path.parent_path() / cache_path;
+  }
+  auto entry_name = model_path.filename();
+  entry_name += ToPathString("." + builder.Build() + ".ort");
+  return cache_path / entry_name;
+}
+
+Status InferenceSession::SaveToOptimizedModelCache(const std::filesystem::path& cache_path) const {
+  std::error_code ec;
+  std::filesystem::create_directories(cache_path.parent_path(), ec);
+  ORT_RETURN_IF(ec, "Failed to create the optimized model cache directory ",
+                PathToUTF8String(cache_path.parent_path().native()), ": ", ec.message());
+
+  // the temporary file is unique to this writer so concurrent writers of an entry don't interleave
+  static std::atomic<uint64_t> temp_file_counter{0};
+  auto temp_path = cache_path;
+  temp_path += ToPathString("." + std::to_string(Env::Default().GetSelfPid()) + "." +
+                            std::to_string(temp_file_counter++) + ".tmp");
+
+  Status status = SaveToOrtFormat(temp_path);
+  if (!status.IsOK()) {
+    std::filesystem::remove(temp_path, ec);
+    return status;
+  }
+
+  std::filesystem::rename(temp_path, cache_path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    // another writer may have won the race, which is as good as writing it
+    ORT_RETURN_IF_NOT(std::filesystem::exists(cache_path, ec), "Failed to write the optimized model cache entry ",
+                      PathToUTF8String(cache_path.native()));
+  }
+
+  return Status::OK();
+}
+
 common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std::shared_ptr<Model>&)> loader,
                                                 const std::string& event_name) {
   Status status = Status::OK();
@@ -1449,6 +1662,33 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
                                    *session_logger_, graph,
                                    ((graph_optimizations_loop_level > 1) ? &is_graph_modified : nullptr)));
 
+    // Run the compute heavy nodes in lower precision if requested. The duplicate Cast removal of the
+    // InsertCastTransformer below drops the casts between two converted nodes.
+    if (const std::string autocast_type = session_options_.config_options.GetConfigOrDefault(
+            kOrtSessionOptionsAutocastType, "");
+        !autocast_type.empty()) {
+      int32_t target_type;
+      if (autocast_type == "fp16") {
+        target_type = ONNX_NAMESPACE::TensorProto_DataType_FLOAT16;
+      } else if (autocast_type == "bf16") {
+        target_type = ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16;
+      } else {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported autocast type: ", autocast_type,
+                               ". Expected \"fp16\" or \"bf16\".");
+      }
+
+      AutocastTransformer autocast_transformer{
+          target_type,
+          AutocastTransformer::ParseList(
+              session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsAutocastAllowOps, "")),
+          AutocastTransformer::ParseList(
+              session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsAutocastDenyList, "")),
+          kernel_registry_manager_};
+      ORT_RETURN_IF_ERROR_SESSIONID_(
+          apply_transformer_once(autocast_transformer, *session_logger_, graph,
+                                 ((graph_optimizations_loop_level > 1) ? &is_graph_modified : nullptr)));
+    }
+
     // Insert cast node/s.
     {
       const InlinedVector<gsl::not_null<const KernelRegistry*>> kernel_regs =
@@ -1479,10 +1719,23 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
     }
   }
 
+  // Create the EP context model with the optimized CPU nodes. The partitioner skipped it in this case.
+  if (const auto& ep_context_gen_options = session_options_.GetEpContextGenerationOptions();
+      ep_context_gen_options.enable &&
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionEpContextOptimizeCpuNodes, "0") == "1") {
+    ORT_RETURN_IF_ERROR_SESSIONID_(GraphPartitioner::CreateEpContextModel(execution_providers_, graph,
+                                                                          ep_context_gen_options, *session_logger_));
+  }
+
   // Insert copy node/s.
   {
     std::vector<std::string> provider_types;
     for (auto& provider_ptr : execution_providers_) {
+      // The nodes of an EP whose default memory is CPU memory consume and produce the values of the CPU nodes in
+      // place, e.g. an NPU EP allocating shared buffers of the host, so no copy nodes are needed around them.
+      if (provider_ptr->GetOrtDeviceByMemType(OrtMemTypeDefault).Type() == OrtDevice::CPU) {
+        continue;
+      }
       provider_types.push_back(provider_ptr->Type());
     }
 
@@ -1499,7 +1752,10 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
     const std::string probe_config =
         session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerProbeConfig, "0:0");
 
-    MemoryOptimizer mem_transformer{memory_optimizer_config_file, probe_config};
+    const std::string memory_budget =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerBudget, "");
+
+    MemoryOptimizer mem_transformer{memory_optimizer_config_file, probe_config, memory_budget};
     ORT_RETURN_IF_ERROR_SESSIONID_(apply_transformer_once(mem_transformer, *session_logger_, graph));
   }
 #endif
@@ -1534,6 +1790,24 @@ Status InferenceSession::LoadOrtModel(const PathString& model_uri) {
   return LoadOrtModelWithLoader(
       [&]() {
         model_location_ = model_uri;
+        const bool map_ort_model_file =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMapORTModelFile, "0") == "1";
+        if (map_ort_model_file) {
+          size_t num_bytes = 0;
+          Status status = Env::Default().GetFileLength(model_location_.c_str(), num_bytes);
+          if (status.IsOK()) {
+            status = Env::Default().MapFileIntoMemory(model_location_.c_str(), 0, num_bytes,
+                                                      ort_format_model_mapping_);
+          }
+          if (status.IsOK()) {
+            ort_format_model_bytes_ = gsl::span<const uint8_t>(
+                reinterpret_cast<const uint8_t*>(ort_format_model_mapping_.get()), num_bytes);
+            return Status::OK();
+          }
+          LOGS(*session_logger_, WARNING) << "Failed to map the ORT format model, it will be read instead: "
+                                          << status.ErrorMessage();
+          ort_format_model_mapping_.reset();
+        }
         ORT_RETURN_IF_ERROR(
             LoadOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
         return Status::OK();
@@ -1577,7 +1851,10 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   }
 
   ORT_RETURN_IF_ERROR(load_ort_format_model_bytes());
+  return LoadOrtModelFromBytes();
+}
 
+Status InferenceSession::LoadOrtModelFromBytes() {
   // Verify the ort_format_model_bytes_ is a valid InferenceSessionBuffer before we access the data
   flatbuffers::Verifier verifier(ort_format_model_bytes_.data(), ort_format_model_bytes_.size());
   ORT_RETURN_IF_NOT(fbs::VerifyInferenceSessionBuffer(verifier), "ORT model verification failed.");
@@ -1641,11 +1918,13 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   // provided an existing buffer of bytes when creating the InferenceSession, ort_format_model_bytes_data_holder_
   // will be empty.
   // if that is the case we also allow creating initializers that directly use those bytes.
+  // the initializers always use the bytes of a mapped file, which live as long as the session.
   const auto& config_options = session_options_.config_options;
   using_ort_model_bytes_for_initializers_ =
       load_options.can_use_flatbuffer_for_initializers =
-          ort_format_model_bytes_data_holder_.empty() &&
-          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1";
+          ort_format_model_mapping_ != nullptr ||
+          (ort_format_model_bytes_data_holder_.empty() &&
+           config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1");
 
   // need to go from unique_ptr to shared_ptr when moving into model_
   std::unique_ptr<Model> tmp_model;
@@ -1680,6 +1959,13 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
   kernel_registry_manager_.SetKernelTypeStrResolver(std::move(kernel_type_str_resolver));
 
+  saved_allocation_plan_.reset();
+  if (const auto* fbs_allocation_plan = fbs_session->allocation_plan(); fbs_allocation_plan != nullptr) {
+    auto saved_allocation_plan = std::make_unique<SavedAllocationPlan>();
+    ORT_RETURN_IF_ERROR(saved_allocation_plan->LoadFromOrtFormat(*fbs_allocation_plan));
+    saved_allocation_plan_ = std::move(saved_allocation_plan);
+  }
+
   is_model_loaded_ = true;
 
   return Status::OK();
@@ -2023,11 +2309,9 @@ common::Status InferenceSession::Initialize() {
       have_cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
     }
 
-    // Verify that there are no external initializers in the graph if external data is disabled.
-    onnxruntime::Graph& graph = model_->MainGraph();
-
 #ifdef DISABLE_EXTERNAL_INITIALIZERS
-    const InitializedTensorSet& initializers = graph.GetAllInitializedTensors();
+    // Verify that there are no external initializers in the graph if external data is disabled.
+    const InitializedTensorSet& initializers = model_->MainGraph().GetAllInitializedTensors();
     for (const auto& it : initializers) {
       if (utils::HasExternalData(*it.second) && !utils::HasExternalDataInMemory(*it.second)) {
         return common::Status(common::ONNXRUNTIME, common::FAIL,
@@ -2054,6 +2338,48 @@ common::Status InferenceSession::Initialize() {
     // re-acquire mutex
     std::lock_guard<std::mutex> l(session_mutex_);
 
+    // load the optimized model from the cache if it has an entry for the session, otherwise write one once the
+    // model is optimized
+    bool saving_to_optimized_model_cache = false;
+#if !defined(ORT_MINIMAL_BUILD)
+    const std::filesystem::path optimized_model_cache_path = GetOptimizedModelCachePath();
+    if (!optimized_model_cache_path.empty()) {
+      std::error_code ec;
+      if (std::filesystem::exists(optimized_model_cache_path, ec)) {
+        const auto onnx_model = model_;
+        Status cache_status = LoadOrtModelBytes(optimized_model_cache_path.native(), ort_format_model_bytes_,
+                                                ort_format_model_bytes_data_holder_);
+        if (cache_status.IsOK()) {
+          cache_status = LoadOrtModelFromBytes();
+        }
+
+        if (cache_status.IsOK()) {
+          LOGS(*session_logger_, INFO) << "Using the optimized model from the cache: "
+                                       << PathToUTF8String(optimized_model_cache_path.native());
+        } else {
+          LOGS(*session_logger_, WARNING) << "Failed to load the optimized model from the cache, it will be written "
+                                          << "again: " << cache_status.ErrorMessage();
+          model_ = onnx_model;
+          saved_allocation_plan_.reset();
+          ort_format_model_bytes_ = gsl::span<const uint8_t>();
+          std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+          saving_to_optimized_model_cache = true;
+        }
+      } else {
+        saving_to_optimized_model_cache = true;
+      }
+    }
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+    onnxruntime::Graph& graph = model_->MainGraph();
+
+#if !defined(ORT_MINIMAL_BUILD)
+    if (session_options_.config_options.GetConfigOrDefault(
+            kOrtSessionOptionsMoveInitializerDataToOrtValues, "0") == "1") {
+      ORT_RETURN_IF_ERROR_SESSIONID_(graph.MoveInitializerDataToOrtValues());
+    }
+#endif
+
 #if !defined(DISABLE_EXTERNAL_INITIALIZERS) && !defined(ORT_MINIMAL_BUILD)
     if (!session_options_.external_initializers.empty()) {
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.InjectExternalInitializedTensors(session_options_.external_initializers));
@@ -2129,6 +2455,23 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    const auto* cpu_ep = execution_providers_.Get(kCpuExecutionProvider);
+    auto* cpu_tuning_ctx = cpu_ep != nullptr ? cpu_ep->GetTuningContext() : nullptr;
+    if (cpu_tuning_ctx != nullptr) {
+      const auto& config_options = session_options_.config_options;
+      if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpEnable, "0") == "1") {
+        cpu_tuning_ctx->EnableTunableOp();
+      }
+      if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpTuningEnable, "0") == "1") {
+        cpu_tuning_ctx->EnableTuning();
+      }
+      const std::string max_tuning_duration_ms =
+          config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs, "");
+      if (!max_tuning_duration_ms.empty()) {
+        cpu_tuning_ctx->SetMaxTuningDurationMs(ParseStringWithClassicLocale<int>(max_tuning_duration_ms));
+      }
+    }
+
 #if !defined(ORT_MINIMAL_BUILD)
     const std::string node_stats_file = session_options_.config_options.GetConfigOrDefault(
         kOrtSessionOptionsCollectNodeMemoryStatsToFile, "");
@@ -2138,8 +2481,18 @@ common::Status InferenceSession::Initialize() {
     }
 
     session_state_->SetNodeStatsRecorder(GetNodeStatsRecorder());
+
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsCollectNodeMemoryStats, "0") == "1") {
+      node_memory_stats_collector_ = std::make_unique<NodeMemoryStatsCollector>();
+    }
+    session_state_->SetNodeMemoryStatsCollector(node_memory_stats_collector_.get());
 #endif
 
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsShareInitializersByContent, "0") ==
+        "1") {
+      session_state_->SetSharedInitializerStore(&environment_.GetSharedInitializerStore());
+    }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // Don't want to pollute SessionState constructor since memory profile is enabled optionally.
     session_state_->SetMemoryProfiler(&memory_profiler_);
@@ -2158,6 +2511,9 @@ common::Status InferenceSession::Initialize() {
     const bool loading_ort_format = !ort_format_model_bytes_.empty();
     const bool saving_model = !session_options_.optimized_model_filepath.empty();
     const bool saving_ort_format = [&]() {
+      if (saving_to_optimized_model_cache) {
+        return true;
+      }
       if (saving_model) {
         const std::string model_type = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSaveModelFormat, "");
         const bool has_explicit_type = !model_type.empty();
@@ -2189,6 +2545,13 @@ common::Status InferenceSession::Initialize() {
                                                                record_runtime_optimization_produced_op_schema,
                                                                *session_logger_));
 
+      if (session_options_.config_options.GetConfigOrDefault(
+              kOrtSessionOptionsGraphOptimizationsParallelSubgraphs, "0") == "1") {
+        auto* subgraph_thread_pool = GetInterOpThreadPoolToUse();
+        graph_transformer_mgr_.SetSubgraphThreadPool(subgraph_thread_pool != nullptr ? subgraph_thread_pool
+                                                                                     : GetIntraOpThreadPoolToUse());
+      }
+
 #ifdef USE_DML
       const IExecutionProvider* dmlExecutionProvider = execution_providers_.Get(kDmlExecutionProvider);
 
@@ -2355,6 +2718,40 @@ common::Status InferenceSession::Initialize() {
 
           LOGS(*session_logger_, INFO) << "This session will use the CUDA/HIP Graph feature as requested by the user.";
           cached_execution_provider_for_graph_replay_.SetExecutionProvider(target_ep);
+
+          const std::string shape_buckets = session_options_.config_options.GetConfigOrDefault(
+              kOrtSessionOptionsConfigGraphCaptureShapeBuckets, "");
+          if (!shape_buckets.empty()) {
+            GraphCaptureShapeBuckets::Config buckets_config;
+            ORT_RETURN_IF_ERROR_SESSIONID_(GraphCaptureShapeBuckets::ParseConfig(shape_buckets, buckets_config));
+
+            // the axis of the bucketed dimension in each graph input and output that has it.
+            auto get_axes = [&buckets_config](gsl::span<const NodeArg* const> args) {
+              InlinedHashMap<std::string, size_t> axes;
+              for (const NodeArg* arg : args) {
+                const auto* shape = arg->Shape();
+                for (int i = 0; shape != nullptr && i < shape->dim_size(); ++i) {
+                  if (shape->dim(i).has_dim_param() && shape->dim(i).dim_param() == buckets_config.dim_param) {
+                    axes.emplace(arg->Name(), static_cast<size_t>(i));
+                    break;
+                  }
+                }
+              }
+              return axes;
+            };
+
+            LOGS(*session_logger_, INFO) << "Capturing a graph per shape bucket of " << shape_buckets;
+            graph_capture_shape_buckets_ = std::make_unique<GraphCaptureShapeBuckets>(
+                std::move(buckets_config), get_axes(graph.GetInputs()), get_axes(graph.GetOutputs()),
+                target_ep->GetOrtDeviceByMemType(OrtMemTypeDefault),
+                [this](const OrtDevice& device) { return session_state_->GetAllocator(device); },
+                data_transfer_mgr_,
+                [this](const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                       gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                       std::vector<OrtValue>* fetches, const std::vector<OrtDevice>* fetches_device_info) {
+                  return Run(run_options, feed_names, feeds, output_names, fetches, fetches_device_info);
+                });
+          }
           break;  // Make sure only one ep can run CUDA graph.
         }
       }
@@ -2414,12 +2811,21 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+    if (initialization_progress_callback_) {
+      initialization_progress_callback_("graph_partitioned");
+    }
+
+    session_state_->SetSavedAllocationPlan(saved_allocation_plan_.get());
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              // need to keep the initializers if saving the optimized model
-                                             !saving_model,
+                                             !saving_model && !saving_to_optimized_model_cache,
                                              saving_ort_format));
 
+    if (initialization_progress_callback_) {
+      initialization_progress_callback_("session_state_finalized");
+    }
+
 #if !defined(ORT_MINIMAL_BUILD)
     if (saving_model) {
       if (session_state_->GetFuncMgr().NumFuncs() > 0) {
@@ -2460,6 +2866,17 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    if (saving_to_optimized_model_cache) {
+      // a failure to write the cache only costs the next session the optimizations
+      if (Status cache_status = SaveToOptimizedModelCache(optimized_model_cache_path); cache_status.IsOK()) {
+        LOGS(*session_logger_, INFO) << "Saved the optimized model to the cache: "
+                                     << PathToUTF8String(optimized_model_cache_path.native());
+      } else {
+        LOGS(*session_logger_, WARNING) << "Failed to save the optimized model to the cache: "
+                                        << cache_status.ErrorMessage();
+      }
+    }
+
     std::vector<TuningResults> tuning_results;
     bool found_tuning_results = false;
     ORT_RETURN_IF_ERROR_SESSIONID_(inference_session_utils::ParseTuningResultsFromModelMetadata(
@@ -2472,11 +2889,16 @@ common::Status InferenceSession::Initialize() {
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    ORT_RETURN_IF_ERROR_SESSIONID_(InitializeStatefulTensors());
+
+    ORT_RETURN_IF_ERROR_SESSIONID_(StartArenaTrimmer());
+
     is_inited_ = true;
 
     if (!using_ort_model_bytes_for_initializers_) {
       ort_format_model_bytes_ = gsl::span<const uint8_t>();
       std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+      ort_format_model_mapping_.reset();
     }
 
     // once the model is saved, we may remove unnecessary attributes for inference
@@ -2524,6 +2946,13 @@ common::Status InferenceSession::Initialize() {
     }
   }
 
+  if (status.IsOK()) {
+    // a failed warm-up only costs the first runs their latency
+    if (Status warm_up_status = WarmUpFromConfig(); !warm_up_status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Session warm-up failed: " << warm_up_status.ErrorMessage();
+    }
+  }
+
   return status;
 }
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -2767,6 +3196,35 @@ common::Status InferenceSession::ValidateOutputs(gsl::span<const std::string> ou
   return ValidateInputsOutputs(output_names, fetches, output_def_map_, ArgType::kOutput);
 }
 
+common::Status InferenceSession::ValidatePreparedRun(const PreparedRun& prepared_run, gsl::span<const OrtValue> feeds,
+                                                     const std::vector<OrtValue>* p_fetches) const {
+  const auto& feed_names = prepared_run.GetFeedNames();
+  if (feeds.size() != feed_names.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The run was prepared with ", feed_names.size(),
+                           " inputs, but ", feeds.size(), " inputs were provided.");
+  }
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const MLDataType expected_element_type = prepared_run.feed_element_types_[i];
+    if (expected_element_type != nullptr && feeds[i].IsTensor()) {
+      const auto& tensor = feeds[i].Get<Tensor>();
+      if (tensor.DataType() == expected_element_type && tensor.Shape() == prepared_run.feed_shapes_[i]) {
+        continue;
+      }
+    }
+
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(gsl::make_span(&feed_names[i], 1), feeds.subspan(i, 1)));
+  }
+
+  // the output names were validated by PrepareRun(), only the pre-allocated fetches need to be.
+  if (p_fetches != nullptr &&
+      std::any_of(p_fetches->begin(), p_fetches->end(), [](const OrtValue& fetch) { return fetch.IsAllocated(); })) {
+    return ValidateOutputs(prepared_run.GetOutputNames(), p_fetches);
+  }
+
+  return Status::OK();
+}
+
 #ifdef ENABLE_TRAINING
 Status InferenceSession::PartialRun(onnxruntime::RunOptions& run_options,
                                     std::vector<OrtValue>& feeds,
@@ -2886,14 +3344,245 @@ Status InferenceSession::SetEpDynamicOptions(gsl::span<const char* const> keys,
   return retval;
 }
 
+Status InferenceSession::InitializeStatefulTensors() {
+  const std::string config =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsStatefulTensors, "");
+  if (config.empty()) {
+    return Status::OK();
+  }
+
+  const GraphViewer& graph_viewer = session_state_->GetGraphViewer();
+  auto has_arg = [](gsl::span<const NodeArg* const> args, std::string_view name) {
+    return std::any_of(args.begin(), args.end(), [name](const NodeArg* arg) { return arg->Name() == name; });
+  };
+
+  for (const auto pair : utils::SplitString(config, ";")) {
+    const auto separator = pair.find(':');
+    ORT_RETURN_IF(separator == std::string_view::npos || separator == 0 || separator + 1 == pair.size(),
+                  "State tensors must be \"output:input;...\", got \"", pair, "\" in \"", config, "\"");
+
+    StatefulTensor state;
+    state.output_name = std::string{pair.substr(0, separator)};
+    state.input_name = std::string{pair.substr(separator + 1)};
+    ORT_RETURN_IF_NOT(has_arg(graph_viewer.GetOutputs(), state.output_name),
+                      "State tensor output ", state.output_name, " is not a graph output.");
+    ORT_RETURN_IF_NOT(has_arg(graph_viewer.GetInputsIncludingInitializers(), state.input_name),
+                      "State tensor input ", state.input_name, " is not a graph input.");
+    for (const auto& other : stateful_tensors_) {
+      ORT_RETURN_IF(other.input_name == state.input_name || other.output_name == state.output_name,
+                    "State tensors ", other.output_name, ":", other.input_name, " and ", state.output_name, ":",
+                    state.input_name, " share a graph input or output.");
+    }
+
+    // fetch the output where the input is consumed. an unused input is fed from the CPU.
+    InlinedVector<SessionState::NodeInfo> node_info_vec;
+    if (session_state_->GetInputNodeInfo(state.input_name, node_info_vec).IsOK() &&
+        !node_info_vec.empty() && node_info_vec.front().p_node != nullptr) {
+      state.device = *node_info_vec.front().device;
+    }
+
+    LOGS(*session_logger_, INFO) << "Keeping state tensor " << state.output_name << " -> " << state.input_name
+                                 << " on " << state.device.ToString();
+    stateful_tensors_.push_back(std::move(state));
+  }
+
+  return Status::OK();
+}
+
+Status InferenceSession::WarmUpFromConfig() {
+  const auto num_runs = ParseStringWithClassicLocale<size_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsWarmUpRuns, "0"));
+  if (num_runs == 0) {
+    return Status::OK();
+  }
+
+  InlinedHashMap<std::string, int64_t> symbolic_dims;
+  ORT_RETURN_IF_ERROR(ParseWarmUpDims(session_options_.config_options, symbolic_dims));
+  return WarmUp(symbolic_dims, num_runs);
+}
+
+Status InferenceSession::ParseWarmUpDims(const ConfigOptions& config_options,
+                                         InlinedHashMap<std::string, int64_t>& symbolic_dims) {
+  const std::string config = config_options.GetConfigOrDefault(kOrtSessionOptionsWarmUpDims, "");
+  for (const auto pair : utils::SplitString(config, ";")) {
+    const auto separator = pair.find(':');
+    int64_t value = 0;
+    ORT_RETURN_IF(separator == std::string_view::npos || separator == 0 ||
+                      !TryParseStringWithClassicLocale(pair.substr(separator + 1), value) || value < 0,
+                  "Warm-up dimensions must be \"dim_param:value;...\", got \"", pair, "\" in \"", config, "\"");
+    symbolic_dims[std::string{pair.substr(0, separator)}] = value;
+  }
+  return Status::OK();
+}
+
+Status InferenceSession::WarmUp(const InlinedHashMap<std::string, int64_t>& symbolic_dims, size_t num_runs) {
+  {
+    std::lock_guard<std::mutex> l(session_mutex_);
+    ORT_RETURN_IF_NOT(is_inited_, "Session must be initialized before warming it up.");
+  }
+
+  // zero-filled CPU inputs, which the run copies to the devices consuming them
+  const GraphViewer& graph_viewer = session_state_->GetGraphViewer();
+  AllocatorPtr allocator = session_state_->GetAllocator(OrtDevice());
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  for (const NodeArg* input : graph_viewer.GetInputs()) {
+    const ONNX_NAMESPACE::TypeProto* type = input->TypeAsProto();
+    const ONNX_NAMESPACE::TensorShapeProto* shape_proto = input->Shape();
+    ORT_RETURN_IF(type == nullptr || !utils::HasTensorType(*type) || shape_proto == nullptr,
+                  "Warm-up only supports graph inputs that are tensors of known rank, not ", input->Name());
+
+    TensorShapeVector dims;
+    dims.reserve(shape_proto->dim_size());
+    for (const auto& dim : shape_proto->dim()) {
+      if (utils::HasDimValue(dim)) {
+        dims.push_back(dim.dim_value());
+      } else {
+        auto it = utils::HasDimParam(dim) ? symbolic_dims.find(dim.dim_param()) : symbolic_dims.end();
+        dims.push_back(it != symbolic_dims.end() ? it->second : 1);
+      }
+    }
+
+    OrtValue feed;
+    const auto* element_type = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType();
+    Tensor::InitOrtValue(element_type, TensorShape(dims), allocator, feed);
+    Tensor& tensor = *feed.GetMutable<Tensor>();
+    if (!tensor.IsDataTypeString()) {
+      memset(tensor.MutableDataRaw(), 0, tensor.SizeInBytes());
+    }
+
+    feed_names.push_back(input->Name());
+    feeds.push_back(std::move(feed));
+  }
+
+  std::vector<std::string> output_names;
+  for (const NodeArg* output : graph_viewer.GetOutputs()) {
+    output_names.push_back(output->Name());
+  }
+
+  RunOptions run_options;
+  run_options.run_tag = "warm_up";
+  for (size_t i = 0; i < num_runs; ++i) {
+    std::vector<OrtValue> fetches;
+    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, &fetches));
+  }
+  LOGS(*session_logger_, INFO) << "Warmed up the session with " << num_runs << " runs.";
+
+  // the real runs start a new stream
+  ResetStatefulTensors();
+  return Status::OK();
+}
+
+Status InferenceSession::GetStatefulTensor(std::string_view name, OrtValue& value) const {
+  std::lock_guard<std::mutex> l(stateful_tensors_mutex_);
+  for (const auto& state : stateful_tensors_) {
+    if (state.input_name == name || state.output_name == name) {
+      value = state.value;
+      return Status::OK();
+    }
+  }
+  return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, name, " is not a state tensor of the session. Set it in the ",
+                         kOrtSessionOptionsStatefulTensors, " session config entry.");
+}
+
+void InferenceSession::ResetStatefulTensors() {
+  std::lock_guard<std::mutex> l(stateful_tensors_mutex_);
+  for (auto& state : stateful_tensors_) {
+    state.value = OrtValue();
+  }
+}
+
+Status InferenceSession::RunWithStatefulTensors(
+    const RunOptions& run_options,
+    gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+    gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+    const std::vector<OrtDevice>* p_fetches_device_info,
+    const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators) {
+  ORT_RETURN_IF(p_fetches == nullptr, "Output vector pointer is NULL");
+  std::lock_guard<std::mutex> l(stateful_tensors_mutex_);
+
+  // the states whose input isn't fed are fed from the previous run, and the states whose output isn't requested are
+  // fetched on the device of their input.
+  std::vector<std::string> all_feed_names(feed_names.begin(), feed_names.end());
+  std::vector<OrtValue> all_feeds(feeds.begin(), feeds.end());
+  std::vector<std::string> all_output_names(output_names.begin(), output_names.end());
+  std::vector<OrtDevice> all_fetches_device_info;
+  if (p_fetches_device_info != nullptr) {
+    all_fetches_device_info = *p_fetches_device_info;
+  }
+  all_fetches_device_info.resize(output_names.size());
+
+  InlinedVector<size_t> state_fetch_idxs;
+  state_fetch_idxs.reserve(stateful_tensors_.size());
+  for (const auto& state : stateful_tensors_) {
+    if (std::find(feed_names.begin(), feed_names.end(), state.input_name) == feed_names.end()) {
+      if (!state.value.IsAllocated()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "State tensor input ", state.input_name,
+                               " has no value. Feed its initial value in the first run after the session is "
+                               "created or its state tensors are reset.");
+      }
+      all_feed_names.push_back(state.input_name);
+      all_feeds.push_back(state.value);
+    }
+
+    auto output_it = std::find(output_names.begin(), output_names.end(), state.output_name);
+    if (output_it == output_names.end()) {
+      state_fetch_idxs.push_back(all_output_names.size());
+      all_output_names.push_back(state.output_name);
+      all_fetches_device_info.push_back(state.device);
+    } else {
+      state_fetch_idxs.push_back(static_cast<size_t>(output_it - output_names.begin()));
+    }
+  }
+
+  // the fetches the caller pre-allocated are kept
+  std::vector<OrtValue> all_fetches(*p_fetches);
+  all_fetches.resize(all_output_names.size());
+
+  ORT_RETURN_IF_ERROR(RunImpl(run_options, all_feed_names, all_feeds, all_output_names, &all_fetches,
+                              &all_fetches_device_info, p_fetch_allocators));
+
+  // the fetched values are the next state, the buffers are shared with the next run rather than copied.
+  for (size_t i = 0; i < stateful_tensors_.size(); ++i) {
+    stateful_tensors_[i].value = all_fetches[state_fetch_idxs[i]];
+  }
+
+  all_fetches.resize(output_names.size());
+  *p_fetches = std::move(all_fetches);
+  return Status::OK();
+}
+
 Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
-                             const std::vector<OrtDevice>* p_fetches_device_info) {
+                             const std::vector<OrtDevice>* p_fetches_device_info,
+                             const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators) {
+  // the shape buckets pick the graph annotation id, unless the caller did.
+  if (graph_capture_shape_buckets_ != nullptr && p_fetch_allocators == nullptr &&
+      !run_options.config_options.GetConfigEntry(kOrtRunOptionsConfigCudaGraphAnnotation).has_value()) {
+    return graph_capture_shape_buckets_->Run(run_options, feed_names, feeds, output_names, p_fetches,
+                                             p_fetches_device_info);
+  }
+
+  if (!stateful_tensors_.empty()) {
+    return RunWithStatefulTensors(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                                  p_fetch_allocators);
+  }
+
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info, p_fetch_allocators);
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                 gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info,
+                                 const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators,
+                                 PreparedRun* prepared_run) {
   TimePoint tp = std::chrono::high_resolution_clock::now();
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
   }
+  RunTracer::Span run_span(run_tracer_.get(), run_options.run_tag, "Run");
 
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   TraceLoggingActivity<telemetry_provider_handle> ortrun_activity;
@@ -2913,6 +3602,19 @@ Status InferenceSession::Run(const RunOptions& run_options,
     }
   }
 
+  // The executors stop the run at the next kernel once its deadline has passed
+  std::optional<RunDeadline::Scope> deadline_scope;
+  const std::string& timeout_str = run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigTimeoutMs, "");
+  if (!timeout_str.empty()) {
+    int64_t timeout_ms = 0;
+    if (!TryParseStringWithClassicLocale<int64_t>(timeout_str, timeout_ms) || timeout_ms < 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to parse the run timeout: ", timeout_str);
+    }
+    if (timeout_ms > 0) {
+      deadline_scope.emplace(RunDeadline::Clock::now() + std::chrono::milliseconds(timeout_ms));
+    }
+  }
+
   // Increment/decrement concurrent_num_runs_ and control
   // session threads spinning as configured. Do nothing for graph replay except the counter.
   const bool control_spinning = use_per_session_threads_ &&
@@ -2922,6 +3624,11 @@ Status InferenceSession::Run(const RunOptions& run_options,
   auto* inter_tp = (control_spinning) ? inter_op_thread_pool_.get() : nullptr;
   ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, current_num_runs_);
 
+  // The work of the run goes to the priority lane of the thread pools
+  const std::string& high_priority_str =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigHighPriority, high_priority_runs_ ? "1" : "0");
+  concurrency::ThreadPool::PriorityScope priority_scope(high_priority_str == "1");
+
   // Check if this Run() is simply going to be a CUDA Graph replay.
   if (cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
     LOGS(*session_logger_, INFO) << "Replaying the captured "
@@ -2944,8 +3651,12 @@ Status InferenceSession::Run(const RunOptions& run_options,
       // log evaluation start to trace logging provider
       env.GetTelemetryProvider().LogEvaluationStart();
 
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      if (prepared_run != nullptr) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidatePreparedRun(*prepared_run, feeds, p_fetches));
+      } else {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      }
 
       // shrink certain default memory arenas if the user has requested for it
       const std::string& shrink_memory_arenas =
@@ -2955,8 +3666,21 @@ Status InferenceSession::Run(const RunOptions& run_options,
         ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
       }
 
-      FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-      FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+      // a prepared run has its names resolved already
+      std::optional<FeedsFetchesManager> run_feeds_fetches_manager;
+      if (prepared_run == nullptr) {
+        run_feeds_fetches_manager.emplace(
+            FeedsFetchesInfo(feed_names, output_names, session_state_->GetOrtValueNameIdxMap()));
+      }
+      FeedsFetchesManager& feeds_fetches_manager = prepared_run != nullptr ? prepared_run->feeds_fetches_manager_
+                                                                           : *run_feeds_fetches_manager;
+
+      if (prepared_run != nullptr) {
+        // reset the target devices set by the pre-allocated fetches of a previous run
+        for (auto& fetch_info : feeds_fetches_manager.GetMutableFetchesDeviceCopyInfo()) {
+          fetch_info.target_device = OrtDevice();
+        }
+      }
 
       if (p_fetches_device_info) {
         // populate the target device info. ignored if pre-allocated fetches are provided
@@ -3022,7 +3746,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #ifdef ORT_ENABLE_STREAM
                                      device_stream_collection_holder,
 #endif
-                                     run_logger);
+                                     run_logger,
+                                     p_fetch_allocators);
       }
 
       // info all execution providers InferenceSession:Run ended
@@ -3125,7 +3850,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
       cached_execution_provider_for_graph_replay_.AllowGraphCaptureOnRun(graph_annotation_id) &&
       !cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
     LOGS(*session_logger_, INFO) << "Start another run for necessary memory allocation or graph capture.";
-    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
+    ORT_RETURN_IF_ERROR(RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                                p_fetch_allocators, prepared_run));
   }
 
   // Log runtime error telemetry if the return value is not OK
@@ -3216,8 +3942,24 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
   if (!tp || concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "intra op thread pool must have at least one thread for RunAsync");
   }
+  if (run_async_batcher_) {
+    run_async_batcher_->Submit(run_options, feed_names, feeds, fetch_names, fetches, callback, user_data);
+    return Status::OK();
+  }
+  // the run tag is copied, as the run options may not outlive the call when the request isn't traced
+  std::string run_tag;
+  RunTracer::Clock::time_point queued_time;
+  if (run_tracer_) {
+    run_tag = run_options ? run_options->run_tag : std::string{};
+    queued_time = RunTracer::Clock::now();
+  }
   std::function<void()> run_fn = [run_options, feed_names, feeds, fetch_names, fetches, num_fetches,
-                                  callback, user_data, this]() {
+                                  callback, user_data, run_tag = std::move(run_tag), queued_time, this]() {
+    RunTracer::Span run_async_span(run_tracer_.get(), run_tag, "RunAsync", queued_time);
+    if (run_async_span.IsActive()) {
+      run_tracer_->EmitSpan("RunAsyncQueue", {}, run_tag, RunTracer::NewSpanId(), run_async_span.Id(), queued_time,
+                            RunTracer::Clock::now());
+    }
     Status status = Status::OK();
     ORT_TRY {
       if (run_options) {
@@ -3235,6 +3977,7 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
     ORT_CATCH(...) {
       status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
     }
+    run_async_span.End();
     callback(user_data, fetches.data(), status.IsOK() ? num_fetches : 0, ToOrtStatus(status));
   };  // run_fn
   concurrency::ThreadPool::Schedule(tp, run_fn);
@@ -3323,14 +4066,30 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
   }
 
   *io_binding = std::make_unique<IOBinding>(*session_state_);
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIOBindingReuseOutputs, "0") == "1") {
+    (*io_binding)->use_output_pool_ = true;
+  }
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIOBindingStageInputs, "0") == "1") {
+    (*io_binding)->stage_inputs_ = true;
+  }
   return Status::OK();
 }
 
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
-  return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
-             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+  ORT_RETURN_IF_ERROR(io_binding.WaitForStagedInputs());
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  io_binding.PrepareOutputsForRun(fetch_allocators);
+
+  auto status = Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
+                    &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo(),
+                    fetch_allocators.empty() ? nullptr : &fetch_allocators);
+  if (status.IsOK()) {
+    io_binding.UpdateOutputPool();
+  }
+
+  return status;
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
@@ -3338,6 +4097,57 @@ common::Status InferenceSession::Run(IOBinding& io_binding) {
   return Run(run_options, io_binding);
 }
 
+common::Status InferenceSession::PrepareRun(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                            gsl::span<const std::string> output_names,
+                                            std::unique_ptr<PreparedRun>& prepared_run) const {
+  {
+    std::lock_guard<std::mutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(ValidateInputs(feed_names, feeds));
+  ORT_RETURN_IF_ERROR(ValidateOutputs(output_names, nullptr));
+
+  FeedsFetchesInfo info;
+  info.feed_names.assign(feed_names.begin(), feed_names.end());
+  info.output_names.assign(output_names.begin(), output_names.end());
+  ORT_RETURN_IF_ERROR(info.SetMLValueIdxs(session_state_->GetOrtValueNameIdxMap()));
+
+  auto run = std::make_unique<PreparedRun>(std::move(info));
+  run->feed_element_types_.reserve(feeds.size());
+  run->feed_shapes_.reserve(feeds.size());
+  for (const auto& feed : feeds) {
+    if (feed.IsTensor()) {
+      const auto& tensor = feed.Get<Tensor>();
+      run->feed_element_types_.push_back(tensor.DataType());
+      run->feed_shapes_.push_back(tensor.Shape());
+    } else {
+      run->feed_element_types_.push_back(nullptr);
+      run->feed_shapes_.emplace_back();
+    }
+  }
+
+  prepared_run = std::move(run);
+  return Status::OK();
+}
+
+common::Status InferenceSession::Run(const RunOptions& run_options, PreparedRun& prepared_run,
+                                     gsl::span<const OrtValue> feeds, std::vector<OrtValue>* p_fetches) {
+  ORT_RETURN_IF(p_fetches == nullptr, "Output vector pointer is NULL");
+  const auto& feed_names = prepared_run.GetFeedNames();
+  const auto& output_names = prepared_run.GetOutputNames();
+
+  // the shape buckets and the state tensors change the names of the run, so it is run by name.
+  if (graph_capture_shape_buckets_ != nullptr || !stateful_tensors_.empty()) {
+    return Run(run_options, feed_names, feeds, output_names, p_fetches);
+  }
+
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, nullptr, nullptr, &prepared_run);
+}
+
 template <typename T>
 void InferenceSession::StartProfiling(const std::basic_string<T>& file_prefix) {
   std::basic_ostringstream<T> ss;
@@ -3376,6 +4186,20 @@ const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
 
+Status InferenceSession::GetNodeMemoryStats(std::vector<NodeMemoryStats>& node_memory_stats) const {
+#if !defined(ORT_MINIMAL_BUILD)
+  if (node_memory_stats_collector_ == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Node memory stats are not collected. Set the ",
+                           kOrtSessionOptionsCollectNodeMemoryStats, " session config entry to 1 to enable them.");
+  }
+  node_memory_stats = node_memory_stats_collector_->GetStats();
+  return Status::OK();
+#else
+  ORT_UNUSED_PARAMETER(node_memory_stats);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Node memory stats are not supported in a minimal build.");
+#endif
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 std::vector<TuningResults> InferenceSession::GetTuningResults() const {
   std::vector<TuningResults> ret;
@@ -3505,6 +4329,51 @@ void InferenceSession::ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_t
   }
 }
 
+common::Status InferenceSession::StartArenaTrimmer() {
+  const auto& config_options = session_options_.config_options;
+  const std::string& interval_str = config_options.GetConfigOrDefault(kOrtSessionOptionsArenaTrimIntervalMs, "0");
+  int64_t interval_ms = 0;
+  if (!TryParseStringWithClassicLocale<int64_t>(interval_str, interval_ms) || interval_ms < 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to parse the arena trim interval: ", interval_str);
+  }
+  if (interval_ms == 0) {
+    return Status::OK();
+  }
+
+  const std::string& max_idle_str = config_options.GetConfigOrDefault(kOrtSessionOptionsArenaTrimMaxIdleMs, "10000");
+  int64_t max_idle_ms = 0;
+  if (!TryParseStringWithClassicLocale<int64_t>(max_idle_str, max_idle_ms) || max_idle_ms < 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to parse the arena trim max idle time: ",
+                           max_idle_str);
+  }
+
+  size_t max_retained_bytes = std::numeric_limits<size_t>::max();
+  const std::string& max_retained_bytes_str =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsArenaTrimMaxRetainedBytes, "");
+  if (!max_retained_bytes_str.empty() &&
+      !TryParseStringWithClassicLocale<size_t>(max_retained_bytes_str, max_retained_bytes)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to parse the arena trim max retained bytes: ",
+                           max_retained_bytes_str);
+  }
+
+  std::vector<AllocatorPtr> arenas;
+  for (const auto& [device, allocator_ptr] : session_state_->GetAllocators()) {
+    if (allocator_ptr->Info().alloc_type == OrtAllocatorType::OrtArenaAllocator &&
+        std::find(arenas.begin(), arenas.end(), allocator_ptr) == arenas.end()) {
+      arenas.push_back(allocator_ptr);
+    }
+  }
+
+  if (arenas.empty()) {
+    LOGS(*session_logger_, INFO) << "The session has no arena to trim.";
+    return Status::OK();
+  }
+
+  arena_trimmer_ = std::make_unique<ArenaTrimmer>(std::move(arenas), std::chrono::milliseconds(interval_ms),
+                                                  std::chrono::milliseconds(max_idle_ms), max_retained_bytes);
+  return Status::OK();
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 // assumes model has already been loaded before
 common::Status InferenceSession::DoPostLoadProcessing(onnxruntime::Model& model) {
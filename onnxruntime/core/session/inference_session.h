@@ -17,11 +17,15 @@
 #include "core/common/status.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/framework_common.h"
+#include "core/framework/arena_trimmer.h"
 #include "core/framework/iexecutor.h"
 #include "core/framework/external_data_loader_manager.h"
 #include "core/framework/kernel_registry_manager.h"
+#include "core/framework/node_memory_stats.h"
 #include "core/framework/prepacked_weights_container.h"
 #include "core/framework/resource_accountant.h"
+#include "core/framework/run_tracer.h"
+#include "core/framework/saved_allocation_plan.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tuning_results.h"
 #include "core/framework/framework_provider_common.h"
@@ -30,6 +34,9 @@
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
+#include "core/session/graph_capture_shape_buckets.h"
+#include "core/session/run_async_batcher.h"
 #include <mutex>
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
@@ -56,6 +63,7 @@ class Environment;
 class GraphTransformer;
 class IExecutionProvider;
 class IOBinding;
+class PreparedRun;
 struct Notification;
 
 void reset_saturation_count();
@@ -364,7 +372,9 @@ class InferenceSession {
   [[nodiscard]] common::Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
                                    gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
                                    std::vector<OrtValue>* p_fetches,
-                                   const std::vector<OrtDevice>* p_fetches_device_info = nullptr);
+                                   const std::vector<OrtDevice>* p_fetches_device_info = nullptr,
+                                   const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators =
+                                       nullptr);
 
   [[nodiscard]] common::Status Run(const RunOptions& run_options,
                                    gsl::span<const char* const> feed_names,
@@ -412,6 +422,26 @@ class InferenceSession {
   [[nodiscard]] virtual common::Status Run(const RunOptions& run_options, IOBinding& io_binding);
   [[nodiscard]] common::Status Run(IOBinding& io_binding);
 
+  /**
+   * Resolves the inputs and outputs of runs with the same names once, for repeated runs with Run(PreparedRun).
+   * @param feed_names names of the inputs of the runs.
+   * @param feeds representative inputs, which are validated. A later run only validates an input again if its type
+   *        or shape differs from the representative input.
+   * @param output_names names of the outputs of the runs.
+   * @param prepared_run the prepared run, valid as long as the session is.
+   */
+  [[nodiscard]] common::Status PrepareRun(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                          gsl::span<const std::string> output_names,
+                                          std::unique_ptr<PreparedRun>& prepared_run) const;
+
+  /**
+   * Run with the inputs and outputs resolved by PrepareRun().
+   * @param feeds inputs in the order of the feed names of the prepared run.
+   * @param p_fetches outputs in the order of the output names of the prepared run.
+   */
+  [[nodiscard]] common::Status Run(const RunOptions& run_options, PreparedRun& prepared_run,
+                                   gsl::span<const OrtValue> feeds, std::vector<OrtValue>* p_fetches);
+
 #ifdef ENABLE_TRAINING
   /**
    * Partially run a pre-loaded and pre-intialized model.
@@ -603,6 +633,55 @@ class InferenceSession {
 
 #endif
 
+  /**
+   * Get the memory high-water mark of each node in its latest execution, by decreasing peak bytes in use.
+   * Requires the kOrtSessionOptionsCollectNodeMemoryStats session config entry.
+   * @param node_memory_stats is filled with the stats of the nodes that ran.
+   * @return OK, or an error if the collection isn't enabled for the session.
+   */
+  Status GetNodeMemoryStats(std::vector<NodeMemoryStats>& node_memory_stats) const;
+
+  /**
+   * Get the current value of a state tensor, see kOrtSessionOptionsStatefulTensors.
+   * The value is shared with the session, and is replaced, not modified, by the next run.
+   * @param name is the name of the graph input or graph output of the state.
+   * @param value is set to the state, or to an empty OrtValue before the first run and after a reset.
+   * @return OK, or an error if name isn't a state of the session.
+   */
+  Status GetStatefulTensor(std::string_view name, OrtValue& value) const;
+
+  /**
+   * Drop the values of all the state tensors, so the next run has to feed their initial values.
+   * Used to start a new stream.
+   */
+  void ResetStatefulTensors();
+
+  /**
+   * Run the initialized session num_runs times with zero-filled inputs, discarding the outputs, so the real runs
+   * start with extended arenas, touched pages and filled kernel caches. See kOrtSessionOptionsWarmUpRuns.
+   * @param symbolic_dims values of the symbolic dimensions of the graph inputs. The others are 1.
+   * @param num_runs number of warm-up runs.
+   * @return OK, or the error of the first failed run.
+   */
+  [[nodiscard]] common::Status WarmUp(const InlinedHashMap<std::string, int64_t>& symbolic_dims, size_t num_runs);
+
+  /**
+   * Parse the values of the symbolic dimensions used by WarmUp from kOrtSessionOptionsWarmUpDims.
+   * @param config_options the session config options.
+   * @param symbolic_dims receives the values of the listed symbolic dimensions.
+   * @return OK, or INVALID_ARGUMENT if the config entry is malformed.
+   */
+  [[nodiscard]] static common::Status ParseWarmUpDims(const ConfigOptions& config_options,
+                                                      InlinedHashMap<std::string, int64_t>& symbolic_dims);
+
+  /**
+   * Set a callback that Initialize() invokes with the name of each phase it completes:
+   * "graph_partitioned" and "session_state_finalized". Used by OrtApi::CreateSessionAsync to report progress.
+   */
+  void SetInitializationProgressCallback(std::function<void(const char* phase)> callback) {
+    initialization_progress_callback_ = std::move(callback);
+  }
+
   const Model& GetModel() const;
   const Environment& GetEnvironment() const;
 
@@ -735,6 +814,13 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const std::filesystem::path& filepath) const;
+
+  // Returns the path of the entry for this session in the cache of optimized models, or an empty path if the cache
+  // is disabled or can't be used for this session. See kOrtSessionOptionsOptimizedModelCacheDir.
+  std::filesystem::path GetOptimizedModelCachePath() const;
+
+  // Writes the optimized model to the cache entry at cache_path.
+  [[nodiscard]] common::Status SaveToOptimizedModelCache(const std::filesystem::path& cache_path) const;
 #endif
 
   /**
@@ -756,6 +842,35 @@ class InferenceSession {
 
   [[nodiscard]] common::Status LoadOrtModelWithLoader(std::function<Status()> load_ort_format_model_bytes);
 
+  // Creates model_ from ort_format_model_bytes_. session_mutex_ must be held.
+  [[nodiscard]] common::Status LoadOrtModelFromBytes();
+
+  // Parses kOrtSessionOptionsStatefulTensors once the session state is finalized.
+  [[nodiscard]] common::Status InitializeStatefulTensors();
+
+  // Parses kOrtSessionOptionsWarmUpRuns and kOrtSessionOptionsWarmUpDims and runs the warm-up, if any.
+  [[nodiscard]] common::Status WarmUpFromConfig();
+
+  // Run() with the state tensors added to the feeds and fetches, and updated with the fetched values.
+  [[nodiscard]] common::Status RunWithStatefulTensors(const RunOptions& run_options,
+                                                      gsl::span<const std::string> feed_names,
+                                                      gsl::span<const OrtValue> feeds,
+                                                      gsl::span<const std::string> output_names,
+                                                      std::vector<OrtValue>* p_fetches,
+                                                      const std::vector<OrtDevice>* p_fetches_device_info,
+                                                      const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators);
+
+  // Run() once the shape bucket and the state tensors are resolved.
+  // If prepared_run is not nullptr, the names are its names and the feeds are validated against it.
+  [[nodiscard]] common::Status RunImpl(const RunOptions& run_options,
+                                       gsl::span<const std::string> feed_names,
+                                       gsl::span<const OrtValue> feeds,
+                                       gsl::span<const std::string> output_names,
+                                       std::vector<OrtValue>* p_fetches,
+                                       const std::vector<OrtDevice>* p_fetches_device_info,
+                                       const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators,
+                                       PreparedRun* prepared_run = nullptr);
+
   // Create a Logger for a single execution if possible. Otherwise use the default logger.
   // If a new logger is created, it will also be stored in new_run_logger,
   // which must remain valid for the duration of the execution.
@@ -777,6 +892,11 @@ class InferenceSession {
   [[nodiscard]] common::Status ValidateOutputs(gsl::span<const std::string> output_names,
                                                const std::vector<OrtValue>* p_fetches) const;
 
+  // Validates the feeds and fetches of a run with a prepared run. Only the feeds whose type or shape differ from the
+  // ones the run was prepared with, and the pre-allocated fetches, are validated.
+  [[nodiscard]] common::Status ValidatePreparedRun(const PreparedRun& prepared_run, gsl::span<const OrtValue> feeds,
+                                                   const std::vector<OrtValue>* p_fetches) const;
+
   [[nodiscard]] common::Status ValidateInputsOutputs(gsl::span<const std::string> feed_fetches_names,
                                                      gsl::span<const OrtValue> feeds_fetches,
                                                      const InputOutputDefMetaMap& input_output_meta_map,
@@ -803,6 +923,11 @@ class InferenceSession {
    */
   void ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_to_shrink);
 
+  /*
+   * Starts the background trimming of the arenas of the session if "session.arena_trim_interval_ms" is set.
+   */
+  [[nodiscard]] common::Status StartArenaTrimmer();
+
 #ifdef _WIN32
   static void LogAllSessions();
 #endif
@@ -819,6 +944,9 @@ class InferenceSession {
 
   onnxruntime::GraphTransformerManager graph_transformer_mgr_;
 
+  // whether RegisterGraphTransformer() was called, which makes the result of the optimizations impossible to key
+  bool has_custom_graph_transformers_ = false;
+
   InlinedHashSet<gsl::not_null<const ONNX_NAMESPACE::OpSchema*>> saved_runtime_optimization_produced_node_op_schemas_;
 #endif
   // Any GraphTransformer/RewriteRule name in this set will not be enabled.
@@ -845,6 +973,12 @@ class InferenceSession {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // Emits the tracing spans of the runs. Only created if SessionOptions::tracing_span_fn is set.
+  std::unique_ptr<RunTracer> run_tracer_;
+
+  // Trims the arenas of the session in the background. Only created if "session.arena_trim_interval_ms" is set.
+  std::unique_ptr<ArenaTrimmer> arena_trimmer_;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler memory_profiler_;
 #endif
@@ -864,6 +998,29 @@ class InferenceSession {
   // Spinning is restarted on the next Run()
   bool force_spinning_stop_between_runs_ = false;
 
+  // Default priority of the runs in the thread pools, see kOrtSessionOptionsConfigHighPriority.
+  bool high_priority_runs_ = false;
+
+  // Coalesces concurrent RunAsync requests. Only created if kOrtSessionOptionsConfigRunAsyncMaxBatchSize is set.
+  std::unique_ptr<RunAsyncBatcher> run_async_batcher_;
+
+  // Pads the inputs to a shape bucket with its own captured graph. Only created if graph capture is enabled and
+  // kOrtSessionOptionsConfigGraphCaptureShapeBuckets is set.
+  std::unique_ptr<GraphCaptureShapeBuckets> graph_capture_shape_buckets_;
+
+  // A graph output fed back to a graph input by the next run. See kOrtSessionOptionsStatefulTensors.
+  struct StatefulTensor {
+    std::string input_name;
+    std::string output_name;
+    // the device consuming the input, where the output is fetched so the next run feeds it without a copy.
+    OrtDevice device;
+    // empty until the first run, or after ResetStatefulTensors().
+    OrtValue value;
+  };
+  std::vector<StatefulTensor> stateful_tensors_;
+  // Held for the whole of a run that uses the state tensors, as each run consumes the state of the previous one.
+  mutable std::mutex stateful_tensors_mutex_;
+
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
@@ -883,6 +1040,9 @@ class InferenceSession {
 
   KernelRegistryManager kernel_registry_manager_;
 
+  // allocation plan of the main graph loaded from an ORT format model, if it has one.
+  std::unique_ptr<SavedAllocationPlan> saved_allocation_plan_;
+
 #if !defined(ORT_MINIMAL_BUILD)
   std::list<std::shared_ptr<onnxruntime::IOnnxRuntimeOpSchemaCollection>> custom_schema_registries_;
 #endif
@@ -913,6 +1073,9 @@ class InferenceSession {
   bool is_inited_ = false;                   // GUARDED_BY(session_mutex_)
   bool is_concurrent_run_supported_ = true;  // Graph execution in Run is GUARDED_BY(session_mutex_) if false
 
+  // see SetInitializationProgressCallback.
+  std::function<void(const char* phase)> initialization_progress_callback_;
+
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
   InterOpDomains interop_domains_;
 #endif
@@ -972,6 +1135,10 @@ class InferenceSession {
   // "session.use_ort_model_bytes_directly" to "1", this will be empty
   std::vector<uint8_t> ort_format_model_bytes_data_holder_;
 
+  // The mapping of the ORT format model file, if kOrtSessionOptionsConfigMapORTModelFile is set. The initializers
+  // use the mapped bytes, so it is kept until the InferenceSession goes away.
+  Env::MappedMemoryPtr ort_format_model_mapping_;
+
   bool using_ort_model_bytes_for_initializers_{false};
 
   // Container to store pre-packed weights to share between sessions.
@@ -1025,6 +1192,8 @@ class InferenceSession {
 #if !defined(ORT_MINIMAL_BUILD)
   // Enable nodestats collection
   std::optional<NodeStatsRecorder> node_stats_recorder_;
+  // Run time memory high-water marks of the nodes
+  std::unique_ptr<NodeMemoryStatsCollector> node_memory_stats_collector_;
 #endif
 };
 
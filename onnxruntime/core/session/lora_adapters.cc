@@ -95,6 +95,10 @@ void LoraAdapter::InitializeParamsValues() {
     }
   }
 
+  format_version_ = adapter_->format_version();
+  adapter_version_ = adapter_->adapter_version();
+  model_version_ = adapter_->model_version();
+
   const auto* params = adapter_->parameters();
   ORT_ENFORCE(params != nullptr, "Params absent");
   std::unordered_map<std::string, Param> params_values;
@@ -120,6 +124,63 @@ void LoraAdapter::InitializeParamsValues() {
   params_values_.swap(params_values);
 }
 
+LoraAdapter LoraAdapter::Stack(gsl::span<const LoraAdapter* const> adapters, AllocatorPtr device_allocator) {
+  ORT_ENFORCE(!adapters.empty(), "No adapters to stack");
+
+  std::unique_ptr<IDataTransfer> data_transfer;
+  if (device_allocator) {
+    data_transfer = GetDataTransfer(device_allocator->Info());
+    if (data_transfer == nullptr) {
+      ORT_THROW("Data transfer is not available for the specified device allocator, it also must not be a CPU allocator");
+    }
+  }
+
+  const LoraAdapter& first = *adapters[0];
+  for (const auto* adapter : adapters) {
+    ORT_ENFORCE(adapter->GetParamNum() == first.GetParamNum(), "Stacked adapters must have the same parameters");
+  }
+
+  auto cpu_allocator = CPUAllocator::DefaultInstance();
+  std::unordered_map<std::string, Param> params_values;
+  params_values.reserve(first.params_values_.size());
+  for (const auto& [name, first_param] : first.params_values_) {
+    const auto& first_tensor = first_param.GetMapped().Get<Tensor>();
+
+    TensorShapeVector stacked_dims{static_cast<int64_t>(adapters.size())};
+    const auto dims = first_tensor.Shape().GetDims();
+    stacked_dims.insert(stacked_dims.end(), dims.begin(), dims.end());
+    Tensor stacked(first_tensor.DataType(), TensorShape(stacked_dims), cpu_allocator);
+
+    auto* dst = static_cast<uint8_t*>(stacked.MutableDataRaw());
+    for (const auto* adapter : adapters) {
+      auto hit = adapter->params_values_.find(name);
+      ORT_ENFORCE(hit != adapter->params_values_.end(), "Parameter ", name, " is missing in a stacked adapter");
+      const auto& tensor = hit->second.GetMapped().Get<Tensor>();
+      ORT_ENFORCE(tensor.DataType() == first_tensor.DataType() && tensor.Shape() == first_tensor.Shape(),
+                  "Parameter ", name, " has a different type or shape in a stacked adapter");
+      memcpy(dst, tensor.DataRaw(), tensor.SizeInBytes());
+      dst += tensor.SizeInBytes();
+    }
+
+    OrtValue ort_value;
+    Tensor::InitOrtValue(std::move(stacked), ort_value);
+    if (data_transfer) {
+      OrtValue ort_value_ondevice;
+      ORT_THROW_IF_ERROR(CreateOrtValueOnDevice(ort_value, device_allocator, *data_transfer, ort_value_ondevice));
+      params_values.emplace(name, Param(std::move(ort_value), std::move(ort_value_ondevice)));
+    } else {
+      params_values.emplace(name, Param(std::move(ort_value)));
+    }
+  }
+
+  LoraAdapter result(std::move(device_allocator));
+  result.format_version_ = first.format_version_;
+  result.adapter_version_ = first.adapter_version_;
+  result.model_version_ = first.model_version_;
+  result.params_values_.swap(params_values);
+  return result;
+}
+
 }  // namespace lora
 }  // namespace onnxruntime
 
@@ -161,6 +222,24 @@ ORT_API_STATUS_IMPL(OrtApis::CreateLoraAdapterFromArray, _In_ const void* bytes,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateLoraAdapterStack, _In_reads_(num_adapters) const OrtLoraAdapter* const* adapters,
+                    size_t num_adapters, _In_opt_ OrtAllocator* allocator, _Outptr_ OrtLoraAdapter** adapter) {
+  API_IMPL_BEGIN
+
+  onnxruntime::AllocatorPtr alloc_ptr;
+  if (allocator != nullptr) {
+    alloc_ptr = std::make_shared<onnxruntime::IAllocatorImplWrappingOrtAllocator>(allocator);
+  }
+
+  auto lora_adapters = gsl::make_span(reinterpret_cast<const onnxruntime::lora::LoraAdapter* const*>(adapters),
+                                      num_adapters);
+  auto lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>(
+      onnxruntime::lora::LoraAdapter::Stack(lora_adapters, std::move(alloc_ptr)));
+  *adapter = reinterpret_cast<OrtLoraAdapter*>(lora_adapter.release());
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API(void, OrtApis::ReleaseLoraAdapter, _Frees_ptr_opt_ OrtLoraAdapter* adapter) {
   delete reinterpret_cast<onnxruntime::lora::LoraAdapter*>(adapter);
 }
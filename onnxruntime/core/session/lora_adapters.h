@@ -98,6 +98,17 @@ class LoraAdapter {
   /// <param name="file_name"></param>
   void MemoryMap(const std::filesystem::path& file_path);
 
+  /// <summary>
+  /// Creates an adapter whose parameters stack the parameters of the adapters along a new first dimension,
+  /// in the order of the adapters. The adapters must have the same parameters, with the same types and shapes.
+  /// The stacked parameters are copied to the device of device_allocator once, if specified.
+  /// The versions are the ones of the first adapter.
+  /// </summary>
+  /// <param name="adapters">adapters to stack</param>
+  /// <param name="device_allocator">optional device allocator</param>
+  /// <returns>stacked adapter</returns>
+  static LoraAdapter Stack(gsl::span<const LoraAdapter* const> adapters, AllocatorPtr device_allocator);
+
   /// <summary>
   /// Returns number of parameters in the adapter.
   /// The number is expected to be even as lora params come in pairs.
@@ -112,7 +123,7 @@ class LoraAdapter {
   /// </summary>
   /// <returns></returns>
   int FormatVersion() const noexcept {
-    return adapter_->format_version();
+    return format_version_;
   }
 
   /// <summary>
@@ -120,7 +131,7 @@ class LoraAdapter {
   /// </summary>
   /// <returns></returns>
   int AdapterVersion() const noexcept {
-    return adapter_->adapter_version();
+    return adapter_version_;
   }
 
   /// <summary>
@@ -128,7 +139,7 @@ class LoraAdapter {
   /// </summary>
   /// <returns></returns>
   int ModelVersion() const noexcept {
-    return adapter_->model_version();
+    return model_version_;
   }
 
   /// <summary>
@@ -169,6 +180,9 @@ class LoraAdapter {
 
   AllocatorPtr device_allocator_;
   const adapters::Adapter* adapter_{nullptr};
+  int format_version_{0};
+  int adapter_version_{0};
+  int model_version_{0};
   std::unordered_map<std::string, Param> params_values_;
 };
 
@@ -5,6 +5,7 @@
 #include <cassert>
 #include <cstring>
 #include <functional>
+#include <locale>
 #include <mutex>
 #include <vector>
 #include <sstream>
@@ -46,6 +47,7 @@
 #include "core/session/onnxruntime_c_api.h"
 #include "core/session/ort_apis.h"
 #include "core/session/ort_env.h"
+#include "core/session/prepared_run.h"
 #include "core/session/utils.h"
 
 #if defined(USE_CUDA) || defined(USE_CUDA_PROVIDER_INTERFACE)
@@ -229,6 +231,17 @@ ORT_API_STATUS_IMPL(OrtApis::CreateEnvWithCustomLoggerAndGlobalThreadPools, OrtL
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::RegisterThreadPoolPartition, _In_ OrtEnv* env, _In_ const char* partition_name,
+                    _In_ const OrtThreadingOptions* tp_options) {
+  API_IMPL_BEGIN
+  if (env == nullptr || partition_name == nullptr || tp_options == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "env, partition_name and tp_options must be provided");
+  }
+  ORT_API_RETURN_IF_STATUS_NOT_OK(env->GetEnvironment().RegisterThreadPoolPartition(partition_name, *tp_options));
+  return nullptr;
+  API_IMPL_END
+}
+
 // enable platform telemetry
 ORT_API_STATUS_IMPL(OrtApis::EnableTelemetryEvents, _In_ const OrtEnv* ort_env) {
   API_IMPL_BEGIN
@@ -734,6 +747,59 @@ ORT_API_STATUS_IMPL(OrtApis::CreateSession, _In_ const OrtEnv* env, _In_ const O
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateSessionAsync, _In_ const OrtEnv* env, _In_ const ORTCHAR_T* model_path,
+                    _In_ const OrtSessionOptions* options, _In_opt_ CreateSessionAsyncProgressFn progress_callback,
+                    _In_ CreateSessionAsyncCallbackFn callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  if (env == nullptr || model_path == nullptr || callback == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "env, model_path and callback must be provided");
+  }
+
+  auto* tp = env->GetEnvironment().GetSessionInitThreadPool();
+  if (tp == nullptr) {
+    return OrtApis::CreateStatus(ORT_FAIL, "Failed to create the session initialization thread pool");
+  }
+
+  // the caller may release the options and the path once this returns
+  auto options_copy = options != nullptr ? std::make_shared<OrtSessionOptions>(*options) : nullptr;
+  std::basic_string<ORTCHAR_T> model_path_copy{model_path};
+
+  std::function<void()> init_fn = [env, options_copy, model_path_copy, progress_callback, callback, user_data]() {
+    std::unique_ptr<onnxruntime::InferenceSession> sess;
+    OrtStatus* status = nullptr;
+    ORT_TRY {
+      status = CreateSessionAndLoadModel(options_copy.get(), env, model_path_copy.c_str(), nullptr, 0, sess);
+      if (status == nullptr) {
+        if (progress_callback != nullptr) {
+          progress_callback(user_data, "model_loaded");
+          sess->SetInitializationProgressCallback(
+              [progress_callback, user_data](const char* phase) { progress_callback(user_data, phase); });
+        }
+        status = InitializeSession(options_copy.get(), *sess);
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = OrtApis::CreateStatus(ORT_RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    ORT_CATCH(...) {
+      status = OrtApis::CreateStatus(ORT_RUNTIME_EXCEPTION, "Unknown exception during session initialization");
+    }
+
+    if (status != nullptr) {
+      callback(user_data, nullptr, status);
+      return;
+    }
+    sess->SetInitializationProgressCallback(nullptr);
+    callback(user_data, reinterpret_cast<OrtSession*>(sess.release()), nullptr);
+  };
+
+  onnxruntime::concurrency::ThreadPool::Schedule(tp, std::move(init_fn));
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::CreateSessionFromArray, _In_ const OrtEnv* env, _In_ const void* model_data,
                     size_t model_data_length, _In_ const OrtSessionOptions* options, _Outptr_ OrtSession** out) {
   API_IMPL_BEGIN
@@ -868,6 +934,104 @@ ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreatePreparedRun, _In_ const OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Outptr_ OrtPreparedRun** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+
+  InlinedVector<std::string> input_name_vec;
+  InlinedVector<OrtValue> input_vec;
+  input_name_vec.reserve(input_len);
+  input_vec.reserve(input_len);
+  for (size_t i = 0; i < input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0' || inputs[i] == nullptr) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input names and values cannot be empty");
+    }
+    input_name_vec.emplace_back(input_names[i]);
+    input_vec.push_back(*inputs[i]);
+  }
+
+  InlinedVector<std::string> output_name_vec;
+  output_name_vec.reserve(output_names_len);
+  for (size_t i = 0; i < output_names_len; ++i) {
+    if (output_names[i] == nullptr || output_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_name_vec.emplace_back(output_names[i]);
+  }
+
+  std::unique_ptr<::onnxruntime::PreparedRun> prepared_run;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->PrepareRun(input_name_vec, input_vec, output_name_vec, prepared_run));
+  *out = reinterpret_cast<OrtPreparedRun*>(prepared_run.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunPrepared, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _Inout_ OrtPreparedRun* prepared_run, _In_reads_(input_len) const OrtValue* const* inputs,
+                    size_t input_len, _Inout_updates_all_(output_len) OrtValue** outputs, size_t output_len) {
+  API_IMPL_BEGIN
+  auto* session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  auto* run = reinterpret_cast<::onnxruntime::PreparedRun*>(prepared_run);
+
+  if (output_len != run->GetOutputNames().size()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "outputs must have an entry for each output of the prepared run");
+  }
+
+  InlinedVector<OrtValue> feeds;
+  feeds.reserve(input_len);
+  for (size_t i = 0; i < input_len; ++i) {
+    if (inputs[i] == nullptr) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "NULL input supplied to a prepared run");
+    }
+    feeds.push_back(*inputs[i]);
+  }
+
+  std::vector<OrtValue> fetches;
+  fetches.reserve(output_len);
+  for (size_t i = 0; i < output_len; ++i) {
+    if (outputs[i] != nullptr) {
+      fetches.push_back(*outputs[i]);
+    } else {
+      fetches.emplace_back();
+    }
+  }
+
+  Status status;
+  if (run_options == nullptr) {
+    const RunOptions default_run_options;
+    status = session->Run(default_run_options, *run, feeds, &fetches);
+  } else {
+    if (!run_options->active_adapters.empty()) {
+      LOGS(*session->GetLogger(), WARNING) << "RunPrepared() has active adapters specified, but won't have an effect";
+    }
+    status = session->Run(*run_options, *run, feeds, &fetches);
+  }
+  ORT_API_RETURN_IF_STATUS_NOT_OK(status);
+
+  // We do it in two loops to make sure copy __ctors does not throw
+  InlinedVector<std::unique_ptr<OrtValue>> fetch_unique_ptrs;
+  fetch_unique_ptrs.reserve(output_len);
+  for (size_t i = 0; i < output_len; ++i) {
+    if (outputs[i] == nullptr) {
+      fetch_unique_ptrs.emplace_back(std::make_unique<OrtValue>(fetches[i]));
+    } else {
+      fetch_unique_ptrs.emplace_back();
+    }
+  }
+
+  for (size_t i = 0; i < output_len; ++i) {
+    if (outputs[i] == nullptr) {
+      outputs[i] = fetch_unique_ptrs[i].release();
+    }
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 struct OrtIoBinding {
   std::unique_ptr<::onnxruntime::IOBinding> binding_;
   explicit OrtIoBinding(std::unique_ptr<::onnxruntime::IOBinding>&& binding) : binding_(std::move(binding)) {}
@@ -2236,6 +2400,105 @@ ORT_API_STATUS_IMPL(OrtApis::SessionGetProfilingStartTimeNs, _In_ const OrtSessi
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetProfilingNodeStats, _In_ const OrtSession* sess,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::ostringstream json;
+  json.imbue(std::locale::classic());
+  json << "[";
+  bool is_first = true;
+  for (const auto& stats : session->GetProfiling().GetNodeStats()) {
+    json << (is_first ? "\n" : ",\n") << R"({"name" : ")";
+    for (const char c : stats.name) {
+      if (c == '"' || c == '\\') {
+        json << '\\';
+      }
+      json << c;
+    }
+    json << R"(", "count" : )" << stats.count
+         << R"(, "total_us" : )" << stats.total_us
+         << R"(, "mean_us" : )" << stats.mean_us
+         << R"(, "min_us" : )" << stats.min_us
+         << R"(, "max_us" : )" << stats.max_us
+         << R"(, "p50_us" : )" << stats.p50_us
+         << R"(, "p99_us" : )" << stats.p99_us << "}";
+    is_first = false;
+  }
+  json << "\n]\n";
+  *out = StrDup(json.str(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetNodeMemoryStats, _In_ const OrtSession* sess,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::vector<NodeMemoryStats> node_memory_stats;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetNodeMemoryStats(node_memory_stats));
+  std::ostringstream json;
+  json.imbue(std::locale::classic());
+  json << "[";
+  bool is_first = true;
+  for (const auto& stats : node_memory_stats) {
+    json << (is_first ? "\n" : ",\n") << R"({"name" : ")";
+    for (const char c : stats.node_name) {
+      if (c == '"' || c == '\\') {
+        json << '\\';
+      }
+      json << c;
+    }
+    json << R"(", "peak_bytes_in_use" : )" << stats.peak_bytes_in_use
+         << R"(, "bytes_in_use_delta" : )" << stats.bytes_in_use_delta
+         << R"(, "dynamic_output_bytes" : )" << stats.dynamic_output_bytes
+         << R"(, "peak_temp_bytes" : )" << stats.peak_temp_bytes
+         << R"(, "total_temp_bytes" : )" << stats.total_temp_bytes
+         << R"(, "max_peak_bytes_in_use" : )" << stats.max_peak_bytes_in_use << "}";
+    is_first = false;
+  }
+  json << "\n]\n";
+  *out = StrDup(json.str(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetStatefulTensor, _In_ const OrtSession* sess, _In_ const char* name,
+                    _Outptr_result_maybenull_ OrtValue** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  OrtValue value;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetStatefulTensor(name, value));
+  *out = value.IsAllocated() ? std::make_unique<OrtValue>(std::move(value)).release() : nullptr;
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionResetStatefulTensors, _Inout_ OrtSession* sess) {
+  API_IMPL_BEGIN
+  auto* session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  session->ResetStatefulTensors();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionWarmUp, _Inout_ OrtSession* sess,
+                    _In_reads_(num_dims) const char* const* dim_params,
+                    _In_reads_(num_dims) const int64_t* dim_values, size_t num_dims, size_t num_runs) {
+  API_IMPL_BEGIN
+  auto* session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  onnxruntime::InlinedHashMap<std::string, int64_t> symbolic_dims;
+  for (size_t i = 0; i < num_dims; ++i) {
+    if (dim_params[i] == nullptr || dim_values[i] < 0) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Warm-up dimensions must be named and non-negative");
+    }
+    symbolic_dims[dim_params[i]] = dim_values[i];
+  }
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->WarmUp(symbolic_dims, num_runs));
+  return nullptr;
+  API_IMPL_END
+}
+
 // End support for non-tensor types
 
 ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfg, _In_ size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
@@ -2275,6 +2538,10 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "max_power_of_two_extend_bytes") == 0) {
       cfg->max_power_of_two_extend_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "max_thread_cache_bytes") == 0) {
+      cfg->max_thread_cache_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "huge_pages") == 0) {
+      cfg->huge_pages = static_cast<int>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -3634,6 +3901,19 @@ static constexpr OrtApi ort_api_1_to_23 = {
     &OrtApis::GetTensorData,
 
     &OrtApis::GetSessionOptionsConfigEntries,
+
+    &OrtApis::RegisterThreadPoolPartition,
+    &OrtApis::SessionGetProfilingNodeStats,
+    &OrtApis::SessionGetNodeMemoryStats,
+    &OrtApis::SessionGetStatefulTensor,
+    &OrtApis::SessionResetStatefulTensors,
+    &OrtApis::CreateSessionAsync,
+    &OrtApis::SessionWarmUp,
+    &OrtApis::CreateLoraAdapterStack,
+    &OrtApis::CreatePreparedRun,
+    &OrtApis::RunPrepared,
+    &OrtApis::ReleasePreparedRun,
+    &OrtApis::SessionOptionsSetTracingCallback,
 };
 
 // OrtApiBase can never change as there is no way to know what version of OrtApiBase is returned by OrtGetApiBase.
@@ -3710,3 +3990,4 @@ DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Value, OrtValue)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(RunOptions, OrtRunOptions)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Session, ::onnxruntime::InferenceSession)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(ModelMetadata, ::onnxruntime::ModelMetadata)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(PreparedRun, ::onnxruntime::PreparedRun)
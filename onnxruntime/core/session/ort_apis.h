@@ -692,4 +692,41 @@ ORT_API_STATUS_IMPL(ReleaseSharedAllocator, _In_ OrtEnv* env, _In_ const OrtEpDe
 ORT_API_STATUS_IMPL(GetTensorData, _In_ const OrtValue* value, _Outptr_ const void** out);
 
 ORT_API_STATUS_IMPL(GetSessionOptionsConfigEntries, _In_ const OrtSessionOptions* options, _Outptr_ OrtKeyValuePairs** out);
+
+ORT_API_STATUS_IMPL(RegisterThreadPoolPartition, _In_ OrtEnv* env, _In_ const char* partition_name,
+                    _In_ const OrtThreadingOptions* tp_options);
+
+ORT_API_STATUS_IMPL(SessionGetProfilingNodeStats, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+
+ORT_API_STATUS_IMPL(SessionGetNodeMemoryStats, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+
+ORT_API_STATUS_IMPL(SessionGetStatefulTensor, _In_ const OrtSession* sess, _In_ const char* name,
+                    _Outptr_result_maybenull_ OrtValue** out);
+
+ORT_API_STATUS_IMPL(SessionResetStatefulTensors, _Inout_ OrtSession* sess);
+
+ORT_API_STATUS_IMPL(CreateSessionAsync, _In_ const OrtEnv* env, _In_ const ORTCHAR_T* model_path,
+                    _In_ const OrtSessionOptions* options, _In_opt_ CreateSessionAsyncProgressFn progress_callback,
+                    _In_ CreateSessionAsyncCallbackFn callback, _In_opt_ void* user_data);
+
+ORT_API_STATUS_IMPL(SessionWarmUp, _Inout_ OrtSession* sess, _In_reads_(num_dims) const char* const* dim_params,
+                    _In_reads_(num_dims) const int64_t* dim_values, size_t num_dims, size_t num_runs);
+
+ORT_API_STATUS_IMPL(CreateLoraAdapterStack, _In_reads_(num_adapters) const OrtLoraAdapter* const* adapters,
+                    size_t num_adapters, _In_opt_ OrtAllocator* allocator, _Outptr_ OrtLoraAdapter** out);
+
+ORT_API_STATUS_IMPL(CreatePreparedRun, _In_ const OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Outptr_ OrtPreparedRun** out);
+ORT_API_STATUS_IMPL(RunPrepared, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _Inout_ OrtPreparedRun* prepared_run, _In_reads_(input_len) const OrtValue* const* inputs,
+                    size_t input_len, _Inout_updates_all_(output_len) OrtValue** outputs, size_t output_len);
+ORT_API(void, ReleasePreparedRun, _Frees_ptr_opt_ OrtPreparedRun*);
+
+ORT_API_STATUS_IMPL(SessionOptionsSetTracingCallback, _Inout_ OrtSessionOptions* options,
+                    _In_opt_ OrtTracingSpanFn tracing_callback, _In_opt_ void* user_data);
 }  // namespace OrtApis
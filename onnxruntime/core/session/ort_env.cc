@@ -11,7 +11,9 @@
 #include "core/session/allocator_adapters.h"
 #include "core/session/user_logging_sink.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
 #include "core/framework/provider_shutdown.h"
+#include "core/platform/env_var_utils.h"
 #include "core/platform/logging/make_platform_default_log_sink.h"
 
 // Whether the process is shutting down
@@ -27,6 +29,10 @@ void CleanupWebGpuContexts();
 }  // namespace onnxruntime
 #endif
 
+// When set to a number of messages, the log messages are sent to the sink from a background thread through a buffer
+// of that size, and dropped if the buffer is full. Logging then doesn't wait for the sink's I/O.
+static constexpr const char* kAsyncLogBufferSize = "ORT_ASYNC_LOG_BUFFER_SIZE";
+
 OrtEnv* OrtEnv::p_instance_;
 int OrtEnv::ref_count_ = 0;
 std::mutex OrtEnv::m_;
@@ -61,6 +67,10 @@ OrtEnv* OrtEnv::GetInstance(const OrtEnv::LoggingManagerConstructionInfo& lm_inf
     } else {
       sink = MakePlatformDefaultLogSink();
     }
+    if (const auto async_log_buffer_size = ParseEnvironmentVariableWithDefault<size_t>(kAsyncLogBufferSize, 0);
+        async_log_buffer_size > 0) {
+      sink = std::make_unique<AsyncSink>(std::move(sink), async_log_buffer_size);
+    }
     auto etwOverrideSeverity = logging::OverrideLevelWithEtw(static_cast<Severity>(lm_info.default_warning_level));
     sink = EnhanceSinkWithEtw(std::move(sink), static_cast<Severity>(lm_info.default_warning_level),
                               etwOverrideSeverity);
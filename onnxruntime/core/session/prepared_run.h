@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/data_types.h"
+#include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/tensor_shape.h"
+
+namespace onnxruntime {
+
+/**
+ * Feeds and fetches of a run resolved once for repeated runs of a session with the same input and output names.
+ * Created by InferenceSession::PrepareRun() from the names and a set of representative feeds, which are validated.
+ * A run with a prepared run doesn't look up the names, and only validates a feed again if its type or shape differs
+ * from the feed the run was prepared with.
+ *
+ * The copy information of the feeds and fetches is updated by each run, so a prepared run must not be used by
+ * concurrent runs. Create one per thread instead.
+ */
+class PreparedRun {
+ public:
+  explicit PreparedRun(FeedsFetchesInfo&& info) : feeds_fetches_manager_(std::move(info)) {}
+
+  const InlinedVector<std::string>& GetFeedNames() const {
+    return feeds_fetches_manager_.GetFeedsFetchesInfo().feed_names;
+  }
+
+  const InlinedVector<std::string>& GetOutputNames() const {
+    return feeds_fetches_manager_.GetFeedsFetchesInfo().output_names;
+  }
+
+ private:
+  friend class InferenceSession;
+
+  FeedsFetchesManager feeds_fetches_manager_;
+
+  // element type and shape of the tensor feeds the run was prepared with. nullptr for the other feeds, which are
+  // always validated.
+  InlinedVector<MLDataType> feed_element_types_;
+  InlinedVector<TensorShape> feed_shapes_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PreparedRun);
+};
+
+}  // namespace onnxruntime
@@ -6,9 +6,16 @@
 #include "core/session/provider_policy_context.h"
 
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
 #include <memory>
 
+#include "core/common/narrow.h"
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
 #include "core/framework/error_code_helper.h"
+#include "core/graph/model.h"
 #include "core/session/abi_devices.h"
 #include "core/session/abi_logger.h"
 #include "core/session/ep_factory_internal.h"
@@ -131,6 +138,55 @@ OrtKeyValuePairs GetModelMetadata(const InferenceSession& session) {
 
   return metadata;
 }
+
+// The model in the calibration cache. A model loaded from a file is identified by its path, size and modification
+// time, one loaded from memory by a hash of its bytes.
+std::string GetModelCacheKey(const Model& model, const std::string& model_bytes) {
+  if (!model_bytes.empty()) {
+    return MakeString("bytes|", model_bytes.size(), "|", std::hash<std::string>{}(model_bytes));
+  }
+
+  const std::filesystem::path& model_path = model.ModelPath();
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(model_path, ec);
+  const auto write_time = std::filesystem::last_write_time(model_path, ec);
+  return MakeString(ToUTF8String(model_path.native()), "|", size, "|", write_time.time_since_epoch().count());
+}
+
+std::string GetDeviceCacheKey(const OrtEpDevice& device) {
+  return MakeString(device.ep_name, "|", static_cast<int>(device.device->type), "|", device.device->vendor_id, "|",
+                    device.device->device_id);
+}
+
+// median run time in microseconds for each (model, device), stored one per line as "model\tdevice\ttime"
+using CalibrationCache = std::map<std::pair<std::string, std::string>, int64_t>;
+
+CalibrationCache ReadCalibrationCache(const std::filesystem::path& path) {
+  CalibrationCache cache;
+  std::ifstream in(path);
+  std::string line;
+  while (std::getline(in, line)) {
+    const auto fields = utils::SplitString(line, "\t");
+    int64_t time = 0;
+    if (fields.size() == 3 && TryParseStringWithClassicLocale(fields[2], time)) {
+      cache[{std::string{fields[0]}, std::string{fields[1]}}] = time;
+    }
+  }
+
+  return cache;
+}
+
+void WriteCalibrationCache(const std::filesystem::path& path, const CalibrationCache& cache,
+                           const logging::Logger& logger) {
+  std::ofstream out(path, std::ios::trunc);
+  for (const auto& [key, time] : cache) {
+    out << key.first << '\t' << key.second << '\t' << time << '\n';
+  }
+
+  if (!out) {
+    LOGS(logger, WARNING) << "EP selection: failed to write the calibration cache " << path;
+  }
+}
 }  // namespace
 
 // Select execution providers based on the device policy and available devices and add to session
@@ -204,9 +260,19 @@ Status ProviderPolicyContext::SelectEpsForSession(const Environment& env, const
         break;
     }
 
+    // MAX_PERFORMANCE measures which device is the fastest for the model if calibration runs are configured
+    const auto calibration_runs = ParseStringWithClassicLocale<size_t>(
+        options.value.config_options.GetConfigOrDefault(kOrtSessionOptionsEpSelectionCalibrationRuns, "0"));
+    if (options.value.ep_selection_policy.policy == OrtExecutionProviderDevicePolicy_MAX_PERFORMANCE &&
+        calibration_runs > 0) {
+      ORT_RETURN_IF_ERROR(SelectFastestDevices(env, sess, calibration_runs, execution_devices, devices_selected));
+    }
+
     // Execute policy
 
-    selector->SelectProvidersForDevices(execution_devices, devices_selected);
+    if (devices_selected.empty()) {
+      selector->SelectProvidersForDevices(execution_devices, devices_selected);
+    }
   }
 
   // Fail if we did not find any device matches
@@ -310,6 +376,138 @@ Status ProviderPolicyContext::SelectEpsForSession(const Environment& env, const
   return Status::OK();
 }
 
+Status ProviderPolicyContext::SelectFastestDevices(const Environment& env, const InferenceSession& sess,
+                                                   size_t num_runs,
+                                                   const std::vector<const OrtEpDevice*>& sorted_devices,
+                                                   std::vector<const OrtEpDevice*>& selected_devices) {
+  const logging::Logger& logger = *sess.GetLogger();
+  const auto& config_options = sess.GetSessionOptions().config_options;
+  const Model& model = sess.GetModel();
+
+  // a model loaded from a file is loaded again by the temporary sessions, which also finds its external data.
+  // one loaded from memory is serialized.
+  std::string model_bytes;
+  if (model.ModelPath().empty()) {
+    model_bytes = model.ToProto().SerializeAsString();
+  }
+
+  const std::string model_key = GetModelCacheKey(model, model_bytes);
+  const std::string cache_file = config_options.GetConfigOrDefault(kOrtSessionOptionsEpSelectionCacheFile, "");
+  CalibrationCache cache;
+  if (!cache_file.empty()) {
+    cache = ReadCalibrationCache(ToPathString(cache_file));
+  }
+  bool cache_updated = false;
+
+  const bool disable_ort_cpu_ep = config_options.GetConfigOrDefault(kOrtSessionOptionsDisableCPUEPFallback, "0") == "1";
+  const OrtEpDevice* ort_cpu_device = IsDefaultCpuEp(sorted_devices.back()) ? sorted_devices.back() : nullptr;
+
+  const OrtEpDevice* fastest_device = nullptr;
+  auto fastest_time = std::chrono::microseconds::max();
+  std::vector<std::string> timed_eps;
+  for (const OrtEpDevice* candidate : sorted_devices) {
+    // one candidate per EP, its preferred device
+    if (std::find(timed_eps.begin(), timed_eps.end(), candidate->ep_name) != timed_eps.end() ||
+        (disable_ort_cpu_ep && candidate == ort_cpu_device)) {
+      continue;
+    }
+    timed_eps.push_back(candidate->ep_name);
+
+    std::vector<const OrtEpDevice*> devices{candidate};
+    if (ort_cpu_device != nullptr && candidate != ort_cpu_device && !disable_ort_cpu_ep) {
+      devices.push_back(ort_cpu_device);
+    }
+
+    const auto cache_key = std::make_pair(model_key, GetDeviceCacheKey(*candidate));
+    std::chrono::microseconds time{};
+    if (auto it = cache.find(cache_key); it != cache.end()) {
+      time = std::chrono::microseconds{it->second};
+    } else {
+      Status status = TimeDevices(env, sess, model_bytes, devices, num_runs, time);
+      if (!status.IsOK()) {
+        LOGS(logger, WARNING) << "EP selection: skipping " << candidate->ep_name
+                              << " as the calibration failed: " << status.ErrorMessage();
+        continue;
+      }
+      cache[cache_key] = time.count();
+      cache_updated = true;
+    }
+
+    LOGS(logger, INFO) << "EP selection: " << candidate->ep_name << " runs the model in " << time.count() << "us";
+    if (time < fastest_time) {
+      fastest_device = candidate;
+      fastest_time = time;
+    }
+  }
+
+  if (cache_updated && !cache_file.empty()) {
+    WriteCalibrationCache(ToPathString(cache_file), cache, logger);
+  }
+
+  if (fastest_device != nullptr) {
+    LOGS(logger, INFO) << "EP selection: selected " << fastest_device->ep_name << " as the fastest.";
+    selected_devices.push_back(fastest_device);
+    if (ort_cpu_device != nullptr && fastest_device != ort_cpu_device) {
+      selected_devices.push_back(ort_cpu_device);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status ProviderPolicyContext::TimeDevices(const Environment& env, const InferenceSession& sess,
+                                          const std::string& model_bytes,
+                                          const std::vector<const OrtEpDevice*>& devices, size_t num_runs,
+                                          std::chrono::microseconds& median_time) {
+  // the temporary session doesn't write an optimized model, profile or EP context model
+  SessionOptions session_options = sess.GetSessionOptions();
+  session_options.optimized_model_filepath.clear();
+  session_options.enable_profiling = false;
+  session_options.config_options.configurations.erase(kOrtSessionOptionEpContextEnable);
+  session_options.session_logid += "_ep_calibration";
+
+  InferenceSession calibration_session(session_options, env);
+  if (model_bytes.empty()) {
+    ORT_RETURN_IF_ERROR(calibration_session.Load(sess.GetModel().ModelPath().native()));
+  } else {
+    ORT_RETURN_IF_ERROR(calibration_session.Load(model_bytes.data(), narrow<int>(model_bytes.size())));
+  }
+
+  ORT_RETURN_IF_ERROR(AddEpDefaultOptionsToSession(calibration_session, devices));
+  OrtSessionOptions ort_so;
+  ort_so.value = calibration_session.GetSessionOptions();
+  const OrtLogger& api_session_logger = *calibration_session.GetLogger()->ToExternal();
+
+  std::vector<SelectionInfo> eps_selected;
+  FoldSelectedDevices(devices, eps_selected);
+  for (auto& info : eps_selected) {
+    std::unique_ptr<IExecutionProvider> ep = nullptr;
+    ORT_RETURN_IF_ERROR(CreateExecutionProvider(env, ort_so, api_session_logger, info, ep));
+    if (ep != nullptr) {
+      ORT_RETURN_IF_ERROR(calibration_session.RegisterExecutionProvider(std::move(ep)));
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(calibration_session.Initialize());
+
+  // the runs use the inputs of the warm-up runs. the first one is slower than the next ones and isn't timed.
+  InlinedHashMap<std::string, int64_t> symbolic_dims;
+  ORT_RETURN_IF_ERROR(InferenceSession::ParseWarmUpDims(session_options.config_options, symbolic_dims));
+  ORT_RETURN_IF_ERROR(calibration_session.WarmUp(symbolic_dims, 1));
+
+  std::vector<std::chrono::microseconds> times;
+  times.reserve(num_runs);
+  for (size_t i = 0; i < num_runs; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    ORT_RETURN_IF_ERROR(calibration_session.WarmUp(symbolic_dims, 1));
+    times.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+  }
+
+  std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+  median_time = times[times.size() / 2];
+  return Status::OK();
+}
+
 void ProviderPolicyContext::FoldSelectedDevices(std::vector<const OrtEpDevice*> devices_selected,
                                                 std::vector<SelectionInfo>& eps_selected) {
   while (devices_selected.size() > 0) {
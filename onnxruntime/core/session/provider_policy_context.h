@@ -5,6 +5,8 @@
 
 #if !defined(ORT_MINIMAL_BUILD)
 
+#include <chrono>
+
 #include "core/session/abi_session_options_impl.h"
 #include "core/session/environment.h"
 #include "core/session/onnxruntime_c_api.h"  // For OrtExecutionProviderDevicePolicy
@@ -49,6 +51,17 @@ class ProviderPolicyContext {
                            std::vector<SelectionInfo>& eps_selected);
 
  private:
+  // Selection for OrtExecutionProviderDevicePolicy_MAX_PERFORMANCE with kOrtSessionOptionsEpSelectionCalibrationRuns.
+  // Times the model on each candidate device, or reads the time from kOrtSessionOptionsEpSelectionCacheFile, and
+  // selects the fastest device with the ORT CPU EP as fallback. Selects nothing if no candidate could be timed.
+  Status SelectFastestDevices(const Environment& env, const InferenceSession& sess, size_t num_runs,
+                              const std::vector<const OrtEpDevice*>& sorted_devices,
+                              std::vector<const OrtEpDevice*>& selected_devices);
+
+  // Creates a temporary session of the model with the given devices and returns the median time of num_runs runs.
+  Status TimeDevices(const Environment& env, const InferenceSession& sess, const std::string& model_bytes,
+                     const std::vector<const OrtEpDevice*>& devices, size_t num_runs,
+                     std::chrono::microseconds& median_time);
 };
 
 class DefaultEpPolicy : public IEpPolicySelector {
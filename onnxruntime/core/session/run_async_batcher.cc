@@ -0,0 +1,355 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_async_batcher.h"
+
+#include <cstring>
+#include <memory>
+
+#include "core/common/narrow.h"
+#include "core/framework/allocator.h"
+#include "core/framework/error_code_helper.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Copies each part into its slice of dst along dim. All tensors are contiguous and have the element type of dst.
+void ConcatAlongDim(gsl::span<const Tensor* const> parts, size_t dim, Tensor& dst) {
+  const auto& dst_shape = dst.Shape();
+  const size_t outer = narrow<size_t>(dst_shape.SizeToDimension(dim));
+  const size_t inner_bytes = narrow<size_t>(dst_shape.SizeFromDimension(dim + 1)) * dst.DataType()->Size();
+  const size_t dst_block_bytes = narrow<size_t>(dst_shape[dim]) * inner_bytes;
+  auto* dst_data = static_cast<uint8_t*>(dst.MutableDataRaw());
+
+  size_t offset = 0;
+  for (const Tensor* part : parts) {
+    const size_t part_block_bytes = narrow<size_t>(part->Shape()[dim]) * inner_bytes;
+    const auto* src_data = static_cast<const uint8_t*>(part->DataRaw());
+    for (size_t i = 0; i < outer; ++i) {
+      std::memcpy(dst_data + i * dst_block_bytes + offset, src_data + i * part_block_bytes, part_block_bytes);
+    }
+    offset += part_block_bytes;
+  }
+}
+
+// Inverse of ConcatAlongDim.
+void SplitAlongDim(const Tensor& src, size_t dim, gsl::span<Tensor* const> parts) {
+  const auto& src_shape = src.Shape();
+  const size_t outer = narrow<size_t>(src_shape.SizeToDimension(dim));
+  const size_t inner_bytes = narrow<size_t>(src_shape.SizeFromDimension(dim + 1)) * src.DataType()->Size();
+  const size_t src_block_bytes = narrow<size_t>(src_shape[dim]) * inner_bytes;
+  const auto* src_data = static_cast<const uint8_t*>(src.DataRaw());
+
+  size_t offset = 0;
+  for (Tensor* part : parts) {
+    const size_t part_block_bytes = narrow<size_t>(part->Shape()[dim]) * inner_bytes;
+    auto* dst_data = static_cast<uint8_t*>(part->MutableDataRaw());
+    for (size_t i = 0; i < outer; ++i) {
+      std::memcpy(dst_data + i * part_block_bytes, src_data + i * src_block_bytes + offset, part_block_bytes);
+    }
+    offset += part_block_bytes;
+  }
+}
+
+bool IsBatchableTensor(const Tensor& tensor, size_t batch_dim) {
+  return !tensor.IsDataTypeString() &&
+         tensor.Location().device.Type() == OrtDevice::CPU &&
+         tensor.Shape().NumDimensions() > batch_dim;
+}
+
+bool SameNames(gsl::span<const char* const> lhs, gsl::span<const char* const> rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (std::strcmp(lhs[i], rhs[i]) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+RunAsyncBatcher::RunAsyncBatcher(const Config& config, RunFn run_fn, ScheduleFn schedule_fn)
+    : config_(config), run_fn_(std::move(run_fn)), schedule_fn_(std::move(schedule_fn)) {
+  ORT_ENFORCE(config_.max_batch_size > 1, "RunAsync batching requires a max batch size greater than 1");
+}
+
+RunAsyncBatcher::~RunAsyncBatcher() {
+  std::unique_lock<std::mutex> lock{mutex_};
+  shutdown_ = true;
+  cv_.notify_all();
+  cv_.wait(lock, [this]() { return !dispatcher_active_; });
+}
+
+void RunAsyncBatcher::Submit(const RunOptions* run_options,
+                             gsl::span<const char* const> feed_names,
+                             gsl::span<const OrtValue* const> feeds,
+                             gsl::span<const char* const> fetch_names,
+                             gsl::span<OrtValue*> fetches,
+                             RunAsyncCallbackFn callback,
+                             void* user_data) {
+  Request request{run_options, feed_names, feeds, fetch_names, fetches, callback, user_data,
+                  GetBatchableRows(fetch_names, feeds, fetches), std::chrono::steady_clock::now()};
+
+  bool schedule_dispatcher = false;
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    queued_rows_ += request.rows > 0 ? request.rows : config_.max_batch_size;
+    queue_.push_back(request);
+    if (!dispatcher_active_) {
+      dispatcher_active_ = true;
+      schedule_dispatcher = true;
+    }
+  }
+  cv_.notify_all();
+
+  if (schedule_dispatcher) {
+    schedule_fn_([this]() { DispatchLoop(); });
+  }
+}
+
+void RunAsyncBatcher::DispatchLoop() {
+  std::unique_lock<std::mutex> lock{mutex_};
+  while (!queue_.empty()) {
+    const auto deadline = queue_.front().enqueue_time + config_.max_queue_delay;
+    cv_.wait_until(lock, deadline, [this]() { return shutdown_ || queued_rows_ >= config_.max_batch_size; });
+
+    Batch batch = TakeBatch();
+    lock.unlock();
+
+    // the batch task must not reference this instance as it may outlive it
+    schedule_fn_([batch = std::move(batch), batch_dim = config_.batch_dim, run_fn = run_fn_]() {
+      RunBatch(batch, batch_dim, run_fn);
+    });
+
+    lock.lock();
+  }
+
+  dispatcher_active_ = false;
+  cv_.notify_all();
+}
+
+RunAsyncBatcher::Batch RunAsyncBatcher::TakeBatch() {
+  Batch batch;
+  const Request head = queue_.front();
+  queue_.pop_front();
+  queued_rows_ -= head.rows > 0 ? head.rows : config_.max_batch_size;
+  batch.push_back(head);
+
+  if (head.rows == 0) {
+    return batch;
+  }
+
+  int64_t rows = head.rows;
+  for (auto it = queue_.begin(); it != queue_.end() && rows < config_.max_batch_size;) {
+    if (it->rows > 0 && rows + it->rows <= config_.max_batch_size && IsCompatible(head, *it)) {
+      rows += it->rows;
+      queued_rows_ -= it->rows;
+      batch.push_back(*it);
+      it = queue_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  return batch;
+}
+
+int64_t RunAsyncBatcher::GetBatchableRows(gsl::span<const char* const> fetch_names,
+                                          gsl::span<const OrtValue* const> feeds,
+                                          gsl::span<OrtValue*> fetches) const {
+  if (feeds.empty() || fetch_names.empty()) {
+    return 0;
+  }
+
+  // preallocated outputs are written in place by Run so they can't be shared by a batch
+  for (const OrtValue* fetch : fetches) {
+    if (fetch != nullptr) {
+      return 0;
+    }
+  }
+
+  int64_t rows = 0;
+  for (const OrtValue* feed : feeds) {
+    if (feed == nullptr || !feed->IsTensor() || !IsBatchableTensor(feed->Get<Tensor>(), config_.batch_dim)) {
+      return 0;
+    }
+
+    const int64_t feed_rows = feed->Get<Tensor>().Shape()[config_.batch_dim];
+    if (feed_rows <= 0 || (rows != 0 && feed_rows != rows)) {
+      return 0;
+    }
+    rows = feed_rows;
+  }
+
+  return rows;
+}
+
+bool RunAsyncBatcher::IsCompatible(const Request& lhs, const Request& rhs) const {
+  if (lhs.run_options != rhs.run_options ||
+      !SameNames(lhs.feed_names, rhs.feed_names) ||
+      !SameNames(lhs.fetch_names, rhs.fetch_names)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < lhs.feeds.size(); ++i) {
+    const Tensor& lhs_tensor = lhs.feeds[i]->Get<Tensor>();
+    const Tensor& rhs_tensor = rhs.feeds[i]->Get<Tensor>();
+    if (lhs_tensor.DataType() != rhs_tensor.DataType()) {
+      return false;
+    }
+
+    const auto lhs_dims = lhs_tensor.Shape().GetDims();
+    const auto rhs_dims = rhs_tensor.Shape().GetDims();
+    if (lhs_dims.size() != rhs_dims.size()) {
+      return false;
+    }
+
+    for (size_t dim = 0; dim < lhs_dims.size(); ++dim) {
+      if (dim != config_.batch_dim && lhs_dims[dim] != rhs_dims[dim]) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void RunAsyncBatcher::RunSingle(const Request& request, const RunFn& run_fn) {
+  Status status = Status::OK();
+  ORT_TRY {
+    if (request.run_options) {
+      status = run_fn(*request.run_options, request.feed_names, request.feeds, request.fetch_names, request.fetches);
+    } else {
+      RunOptions default_run_options;
+      status = run_fn(default_run_options, request.feed_names, request.feeds, request.fetch_names, request.fetches);
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+  ORT_CATCH(...) {
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
+  }
+  request.callback(request.user_data, request.fetches.data(), status.IsOK() ? request.fetches.size() : 0,
+                   ToOrtStatus(status));
+}
+
+Status RunAsyncBatcher::TryRunBatched(const Batch& batch, size_t batch_dim, const RunFn& run_fn,
+                                      InlinedVector<InlinedVector<OrtValue>>& request_fetches) {
+  const Request& head = batch.front();
+  const size_t num_feeds = head.feeds.size();
+  const size_t num_fetches = head.fetch_names.size();
+  auto allocator = CPUAllocator::DefaultInstance();
+
+  int64_t total_rows = 0;
+  for (const Request& request : batch) {
+    total_rows += request.rows;
+  }
+
+  InlinedVector<OrtValue> batched_feeds(num_feeds);
+  InlinedVector<const OrtValue*> batched_feed_ptrs;
+  batched_feed_ptrs.reserve(num_feeds);
+  InlinedVector<const Tensor*> feed_parts;
+  feed_parts.reserve(batch.size());
+  for (size_t i = 0; i < num_feeds; ++i) {
+    const Tensor& head_feed = head.feeds[i]->Get<Tensor>();
+    TensorShape shape = head_feed.Shape();
+    shape[batch_dim] = total_rows;
+    Tensor::InitOrtValue(head_feed.DataType(), shape, allocator, batched_feeds[i]);
+
+    feed_parts.clear();
+    for (const Request& request : batch) {
+      feed_parts.push_back(&request.feeds[i]->Get<Tensor>());
+    }
+    ConcatAlongDim(feed_parts, batch_dim, *batched_feeds[i].GetMutable<Tensor>());
+    batched_feed_ptrs.push_back(&batched_feeds[i]);
+  }
+
+  InlinedVector<OrtValue*> batched_fetches(num_fetches, nullptr);
+  RunOptions default_run_options;
+  const RunOptions& run_options = head.run_options ? *head.run_options : default_run_options;
+  Status status = run_fn(run_options, head.feed_names, batched_feed_ptrs, head.fetch_names, batched_fetches);
+
+  // the fetches are allocated by run_fn, take ownership so they're released once split
+  InlinedVector<std::unique_ptr<OrtValue>> owned_fetches;
+  owned_fetches.reserve(num_fetches);
+  for (OrtValue* fetch : batched_fetches) {
+    owned_fetches.emplace_back(fetch);
+  }
+  ORT_RETURN_IF_ERROR(status);
+
+  request_fetches.resize(batch.size());
+  for (auto& fetches : request_fetches) {
+    fetches.resize(num_fetches);
+  }
+
+  InlinedVector<Tensor*> fetch_parts;
+  fetch_parts.reserve(batch.size());
+  for (size_t i = 0; i < num_fetches; ++i) {
+    const OrtValue* fetch = owned_fetches[i].get();
+    ORT_RETURN_IF(fetch == nullptr || !fetch->IsTensor() || !IsBatchableTensor(fetch->Get<Tensor>(), batch_dim) ||
+                      fetch->Get<Tensor>().Shape()[batch_dim] != total_rows,
+                  "Output ", head.fetch_names[i], " can not be split along the batch dimension");
+
+    const Tensor& batched_fetch = fetch->Get<Tensor>();
+    fetch_parts.clear();
+    for (size_t r = 0; r < batch.size(); ++r) {
+      TensorShape shape = batched_fetch.Shape();
+      shape[batch_dim] = batch[r].rows;
+      Tensor::InitOrtValue(batched_fetch.DataType(), shape, allocator, request_fetches[r][i]);
+      fetch_parts.push_back(request_fetches[r][i].GetMutable<Tensor>());
+    }
+    SplitAlongDim(batched_fetch, batch_dim, fetch_parts);
+  }
+
+  return Status::OK();
+}
+
+void RunAsyncBatcher::RunBatch(const Batch& batch, size_t batch_dim, const RunFn& run_fn) {
+  if (batch.size() == 1) {
+    RunSingle(batch.front(), run_fn);
+    return;
+  }
+
+  InlinedVector<InlinedVector<OrtValue>> request_fetches;
+  Status status = Status::OK();
+  ORT_TRY {
+    status = TryRunBatched(batch, batch_dim, run_fn, request_fetches);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+  ORT_CATCH(...) {
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
+  }
+
+  if (!status.IsOK()) {
+    // e.g. the model doesn't support the combined batch size. run the requests separately so each of them gets
+    // its own outputs or error.
+    for (const Request& request : batch) {
+      RunSingle(request, run_fn);
+    }
+    return;
+  }
+
+  for (size_t r = 0; r < batch.size(); ++r) {
+    const Request& request = batch[r];
+    for (size_t i = 0; i < request.fetches.size(); ++i) {
+      request.fetches[i] = new OrtValue(std::move(request_fetches[r][i]));
+    }
+    request.callback(request.user_data, request.fetches.data(), request.fetches.size(), nullptr);
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/session/onnxruntime_c_api.h"
+
+namespace onnxruntime {
+
+/// <summary>
+/// Coalesces concurrent RunAsync requests into a single Run along a batch dimension.
+///
+/// Requests are queued until either the queued rows reach max_batch_size or the oldest request has waited for
+/// max_queue_delay. Compatible requests are then concatenated along batch_dim, run once, and the outputs are split
+/// back to the callback of each request. Requests are compatible when they share the RunOptions instance, use the
+/// same input and output names, and their CPU tensor inputs match in type and in shape except for batch_dim.
+///
+/// Requests that cannot be batched (non-tensor or device inputs, preallocated outputs, ...) run on their own.
+/// If a batched run fails or produces an output that cannot be split along batch_dim, the requests of the batch are
+/// re-run one by one so every callback still gets its own result.
+/// </summary>
+class RunAsyncBatcher {
+ public:
+  struct Config {
+    // Maximum sum of the batch_dim sizes of the requests in a batch.
+    int64_t max_batch_size{0};
+    // Maximum time the oldest queued request waits for more requests before its batch is dispatched.
+    std::chrono::microseconds max_queue_delay{1000};
+    // Dimension of the inputs and outputs that requests are concatenated along.
+    size_t batch_dim{0};
+  };
+
+  using RunFn = std::function<Status(const RunOptions& run_options,
+                                     gsl::span<const char* const> feed_names,
+                                     gsl::span<const OrtValue* const> feeds,
+                                     gsl::span<const char* const> fetch_names,
+                                     gsl::span<OrtValue*> fetches)>;
+  using ScheduleFn = std::function<void(std::function<void()>)>;
+
+  /// <param name="config">Batching configuration. config.max_batch_size must be greater than 1.</param>
+  /// <param name="run_fn">Synchronous run used for both batched and unbatched requests.</param>
+  /// <param name="schedule_fn">Schedules work on the thread pool used by RunAsync.</param>
+  RunAsyncBatcher(const Config& config, RunFn run_fn, ScheduleFn schedule_fn);
+
+  // Dispatches all queued requests without waiting for their delay to expire.
+  ~RunAsyncBatcher();
+
+  /// <summary>
+  /// Queue a request. The spans must stay valid until the callback is invoked, as for InferenceSession::RunAsync.
+  /// </summary>
+  void Submit(const RunOptions* run_options,
+              gsl::span<const char* const> feed_names,
+              gsl::span<const OrtValue* const> feeds,
+              gsl::span<const char* const> fetch_names,
+              gsl::span<OrtValue*> fetches,
+              RunAsyncCallbackFn callback,
+              void* user_data);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunAsyncBatcher);
+
+  struct Request {
+    const RunOptions* run_options;
+    gsl::span<const char* const> feed_names;
+    gsl::span<const OrtValue* const> feeds;
+    gsl::span<const char* const> fetch_names;
+    gsl::span<OrtValue*> fetches;
+    RunAsyncCallbackFn callback;
+    void* user_data;
+    // batch_dim size of the inputs, or 0 if the request can't be batched.
+    int64_t rows;
+    std::chrono::steady_clock::time_point enqueue_time;
+  };
+
+  using Batch = InlinedVector<Request>;
+
+  // Runs on the thread pool while there are queued requests, forming batches and scheduling them.
+  void DispatchLoop();
+
+  // Pops the oldest request and the compatible requests that fit in the same batch. Requires mutex_ to be held.
+  Batch TakeBatch();
+
+  int64_t GetBatchableRows(gsl::span<const char* const> fetch_names, gsl::span<const OrtValue* const> feeds,
+                           gsl::span<OrtValue*> fetches) const;
+  bool IsCompatible(const Request& lhs, const Request& rhs) const;
+
+  static void RunBatch(const Batch& batch, size_t batch_dim, const RunFn& run_fn);
+  static void RunSingle(const Request& request, const RunFn& run_fn);
+  static Status TryRunBatched(const Batch& batch, size_t batch_dim, const RunFn& run_fn,
+                              InlinedVector<InlinedVector<OrtValue>>& request_fetches);
+
+  const Config config_;
+  const RunFn run_fn_;
+  const ScheduleFn schedule_fn_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request> queue_;
+  // sum of rows of the queued requests. unbatchable requests count as a full batch so they are dispatched at once.
+  int64_t queued_rows_{0};
+  bool dispatcher_active_{false};
+  bool shutdown_{false};
+};
+
+}  // namespace onnxruntime
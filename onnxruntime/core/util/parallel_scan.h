@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "core/common/inlined_containers.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+/**
+ * Two-pass parallel prefix scan over the range [0, total), for the kernels that compute each output from the sum of
+ * the inputs before it (CumSum, the output positions of NonZero, ...).
+ *
+ * The range is split into one block per thread of the thread pool, each of at least min_block_size elements. Reduce
+ * computes the total of each block in parallel and the offset of each block from the totals of the blocks before it.
+ * Scan then scans each block in parallel starting from its offset. Without a thread pool, or for a short range, there
+ * is a single block processed on the calling thread.
+ */
+template <typename T>
+class ParallelScan {
+ public:
+  ParallelScan(concurrency::ThreadPool* thread_pool, std::ptrdiff_t total, std::ptrdiff_t min_block_size)
+      : thread_pool_(thread_pool), total_(total) {
+    const std::ptrdiff_t max_blocks = std::max<std::ptrdiff_t>(total / std::max<std::ptrdiff_t>(min_block_size, 1), 1);
+    num_blocks_ = std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool), max_blocks);
+    num_blocks_ = std::max<std::ptrdiff_t>(num_blocks_, 1);
+    block_size_ = (total + num_blocks_ - 1) / num_blocks_;
+    offsets_.resize(static_cast<size_t>(num_blocks_));
+  }
+
+  /**
+   * First pass. Must run before Scan.
+   * @param reduce_block T(std::ptrdiff_t first, std::ptrdiff_t last) returning the total of the elements of a block.
+   * @return the total of the range.
+   */
+  template <typename ReduceBlock>
+  T Reduce(ReduceBlock&& reduce_block) {
+    RunBlocks([this, &reduce_block](size_t block, std::ptrdiff_t first, std::ptrdiff_t last) {
+      offsets_[block] = reduce_block(first, last);
+    });
+
+    T sum{};
+    for (auto& offset : offsets_) {
+      const T block_total = offset;
+      offset = sum;
+      sum += block_total;
+    }
+    return sum;
+  }
+
+  /**
+   * Second pass.
+   * @param scan_block void(std::ptrdiff_t first, std::ptrdiff_t last, T offset) scanning the elements of a block,
+   * offset being the total of the elements before the block.
+   */
+  template <typename ScanBlock>
+  void Scan(ScanBlock&& scan_block) {
+    RunBlocks([this, &scan_block](size_t block, std::ptrdiff_t first, std::ptrdiff_t last) {
+      scan_block(first, last, offsets_[block]);
+    });
+  }
+
+  std::ptrdiff_t NumBlocks() const { return num_blocks_; }
+
+ private:
+  template <typename Fn>
+  void RunBlocks(Fn&& fn) {
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool_, num_blocks_, [this, &fn](std::ptrdiff_t block) {
+      const std::ptrdiff_t first = std::min(block * block_size_, total_);
+      const std::ptrdiff_t last = std::min(first + block_size_, total_);
+      fn(static_cast<size_t>(block), first, last);
+    });
+  }
+
+  concurrency::ThreadPool* thread_pool_;
+  const std::ptrdiff_t total_;
+  std::ptrdiff_t num_blocks_;
+  std::ptrdiff_t block_size_;
+  InlinedVector<T> offsets_;
+};
+
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "core/common/inlined_containers.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/common/narrow.h"
@@ -32,57 +33,56 @@ struct is_quant_type<int8_t> : std::true_type {};
 template <>
 struct is_quant_type<uint8_t> : std::true_type {};
 
-// Define max number of parallel threads for computing min max values
-// This is hacky. Ideally we should let the thread pool handle work partition.
-// Unfortunately I can't find an elegant way for aggregation at this point.
-#define MAX_DEGREE_OF_PAR_FOR_MINMAX 32
-
 struct FloatMinMax {
   float min;
   float max;
 };
 
+/**
+ * @brief Finds the min and max of data in parallel, with provided thread pool. Each thread of the pool reduces one
+ * contiguous block to a partial min and max with MlasFindMinMaxElement, and the partials are then reduced on the
+ * calling thread, so the data is read once.
+ */
+inline FloatMinMax ParFindMinMaxElement(const float* data, size_t N, concurrency::ThreadPool* thread_pool) {
+  // below this many elements per block the partials cost more than they save
+  constexpr size_t min_block_size = 16384;
+  // blocks are a multiple of a cache line of floats
+  constexpr size_t block_granularity = 16;
+
+  const auto max_blocks = static_cast<std::ptrdiff_t>(std::max<size_t>(N / min_block_size, 1));
+  const std::ptrdiff_t num_blocks =
+      std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool), max_blocks);
+  size_t block_size = (N + num_blocks - 1) / num_blocks;
+  block_size = (block_size + block_granularity - 1) / block_granularity * block_granularity;
+
+  InlinedVector<FloatMinMax> partials(static_cast<size_t>(num_blocks),
+                                      {std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()});
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_blocks, [&](std::ptrdiff_t block) {
+    const size_t begin = std::min(static_cast<size_t>(block) * block_size, N);
+    const size_t end = std::min(begin + block_size, N);
+    if (begin < end) {
+      MlasFindMinMaxElement(data + begin, &partials[block].min, &partials[block].max, end - begin);
+    }
+  });
+
+  FloatMinMax result = partials[0];
+  for (size_t i = 1; i < partials.size(); i++) {
+    result.min = std::min(result.min, partials[i].min);
+    result.max = std::max(result.max, partials[i].max);
+  }
+  return result;
+}
+
 // ReduceRange and Symmetric is for test only
 template <typename QType,
           bool ReduceRange = false,
           bool Symmetric = false,
           typename std::enable_if<is_quant_type<QType>::value, int>::type = 0>
 void GetQuantizationParameter(const float* data, int64_t num_of_elements, float& scale, QType& zp, concurrency::ThreadPool* thread_pool) {
-  FloatMinMax aggregate[MAX_DEGREE_OF_PAR_FOR_MINMAX];
-
-  // Min max operation granularity: AVX512 can potentially handle 64 ~ 128 floats
-  // per iteration.
-  constexpr int granularity = 128;
-  std::ptrdiff_t block_size;
-  std::ptrdiff_t num_blocks;
-  if (concurrency::ThreadPool::ShouldParallelize(thread_pool) && num_of_elements > granularity) {
-    block_size = onnxruntime::narrow<std::ptrdiff_t>((num_of_elements + MAX_DEGREE_OF_PAR_FOR_MINMAX - 1) / MAX_DEGREE_OF_PAR_FOR_MINMAX);
-    block_size = (block_size + granularity - 1) / granularity * granularity;
-    num_blocks = onnxruntime::narrow<std::ptrdiff_t>((num_of_elements + block_size - 1) / block_size);
-  } else {
-    num_blocks = 1;
-    block_size = onnxruntime::narrow<std::ptrdiff_t>(num_of_elements);
-  }
-
-  for (int i = 0; i < narrow<int>(num_blocks); i++) {
-    aggregate[i].min = std::numeric_limits<float>::max();
-    aggregate[i].max = std::numeric_limits<float>::lowest();
-  }
-
-  const TensorOpCost unit_cost{static_cast<double>(block_size) * sizeof(float), 2.0, static_cast<double>(block_size)};
-  concurrency::ThreadPool::TryParallelFor(thread_pool, num_blocks, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-    auto begin_idx = begin * block_size;
-    auto end_idx = std::min(std::ptrdiff_t(num_of_elements), end * block_size);
-    auto agg_idx = begin % num_blocks;
-    MlasFindMinMaxElement(&(data[begin_idx]), &aggregate[agg_idx].min, &aggregate[agg_idx].max, end_idx - begin_idx);
-  });
+  const FloatMinMax min_max = ParFindMinMaxElement(data, onnxruntime::narrow<size_t>(num_of_elements), thread_pool);
+  float min = min_max.min;
+  float max = min_max.max;
 
-  float& min = aggregate[0].min;
-  float& max = aggregate[0].max;
-  for (int i = 1; i < narrow<int>(num_blocks); i++) {
-    min = std::min(min, aggregate[i].min);
-    max = std::max(max, aggregate[i].max);
-  }
   // ensure the input range includes zero
   min = std::min(min, 0.0f);
   max = std::max(max, 0.0f);
@@ -20,6 +20,8 @@ std::ostream& operator<<(std::ostream& os, const OrtThreadPoolParams& params) {
   os << " auto_set_affinity: " << params.auto_set_affinity;
   os << " allow_spinning: " << params.allow_spinning;
   os << " dynamic_block_base_: " << params.dynamic_block_base_;
+  os << " adaptive_inline_threshold: " << params.adaptive_inline_threshold;
+  os << " adaptive_spinning: " << params.adaptive_spinning;
   os << " stack_size: " << params.stack_size;
   os << " affinity_str: " << params.affinity_str;
   // os << " name: " << (params.name ? params.name : L"nullptr");
@@ -151,6 +153,8 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   to.custom_thread_creation_options = options.custom_thread_creation_options;
   to.custom_join_thread_fn = options.custom_join_thread_fn;
   to.dynamic_block_base_ = options.dynamic_block_base_;
+  to.adaptive_inline_threshold = options.adaptive_inline_threshold;
+  to.adaptive_spinning = options.adaptive_spinning;
   if (to.custom_create_thread_fn) {
     ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set");
   }
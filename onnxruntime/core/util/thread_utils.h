@@ -25,6 +25,12 @@ struct OrtThreadPoolParams {
   // of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_)
   int dynamic_block_base_ = 0;
 
+  // If it is true, the parallel loops of each kernel learn the cost below which they run in the calling thread.
+  bool adaptive_inline_threshold = false;
+
+  // If it is true and allow_spinning is set, the threads spin for about as long as they recently waited for work.
+  bool adaptive_spinning = false;
+
   unsigned int stack_size = 0;
 
   // A utf-8 string of affinity settings, format be like:
@@ -6,6 +6,7 @@ from __future__ import annotations
 
 import collections
 import collections.abc
+import concurrent.futures
 import os
 import typing
 import warnings
@@ -176,6 +177,8 @@ class Session:
         # self._sess is managed by the derived class and relies on bindings from C.InferenceSession
         self._sess = None
         self._enable_fallback = enable_fallback
+        # created on the first call to run_batch_async
+        self._batch_executor = None
 
     def get_session_options(self) -> onnxruntime.SessionOptions:
         "Return the session options. See :class:`onnxruntime.SessionOptions`."
@@ -252,25 +255,34 @@ class Session:
                 f"Required inputs ({missing_input_names}) are missing from input feed ({feed_input_names})."
             )
 
-    def run(self, output_names, input_feed, run_options=None) -> Sequence[np.ndarray | SparseTensor | list | dict]:
+    def run(
+        self, output_names, input_feed, run_options=None, output_format="numpy"
+    ) -> Sequence[np.ndarray | SparseTensor | list | dict]:
         """
         Compute the predictions.
 
         :param output_names: name of the outputs
-        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param input_feed: dictionary ``{ input_name: input_value }``. Besides numpy arrays, the values
+            may be tensors of other frameworks implementing ``__dlpack__``, such as torch tensors on CPU or CUDA,
+            which are fed without a copy.
         :param run_options: See :class:`onnxruntime.RunOptions`.
-        :return: list of results, every result is either a numpy array,
+        :param output_format: ``"numpy"`` or ``"dlpack"``. With ``"dlpack"``, the tensor outputs
+            are returned as DLPack capsules sharing the memory of the outputs on their device,
+            which ``torch.from_dlpack`` consumes without a copy. A boolean tensor is returned as uint8.
+            Requires a build with DLPack enabled.
+        :return: list of results, every result is either a numpy array or a DLPack capsule,
             a sparse tensor, a list or a dictionary.
 
         ::
 
             sess.run([output_name], {input_name: x})
+            y = torch.from_dlpack(sess.run([output_name], {input_name: x_torch}, output_format="dlpack")[0])
         """
         self._validate_input(list(input_feed.keys()))
         if not output_names:
             output_names = [output.name for output in self._outputs_meta]
         try:
-            return self._sess.run(output_names, input_feed, run_options)
+            return self._sess.run(output_names, input_feed, run_options, output_format)
         except C.EPFail as err:
             if self._enable_fallback:
                 print(f"EP Error: {err!s} using {self._providers}")
@@ -278,7 +290,7 @@ class Session:
                 self.set_providers(self._fallback_providers)
                 # Fallback only once.
                 self.disable_fallback()
-                return self._sess.run(output_names, input_feed, run_options)
+                return self._sess.run(output_names, input_feed, run_options, output_format)
             raise
 
     def run_async(self, output_names, input_feed, callback, user_data, run_options=None):
@@ -311,6 +323,55 @@ class Session:
             output_names = [output.name for output in self._outputs_meta]
         return self._sess.run_async(output_names, input_feed, callback, user_data, run_options)
 
+    def run_batch(
+        self, output_names, input_feeds, run_options=None, output_format="numpy", max_concurrency=0
+    ) -> list[Sequence[np.ndarray | SparseTensor | list | dict]]:
+        """
+        Compute the predictions of several independent requests.
+
+        The feeds of all the requests are converted first, then the requests run concurrently
+        without holding the GIL, and their outputs are converted once they have all completed.
+        It scales better than calling :meth:`run` from many python threads, whose conversions
+        are serialized by the GIL.
+
+        :param output_names: name of the outputs, the same for every request
+        :param input_feeds: list of dictionaries ``{ input_name: input_value }``, one per request
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :param output_format: ``"numpy"`` or ``"dlpack"``, see :meth:`run`.
+        :param max_concurrency: number of requests running at the same time, the number of cores if 0
+        :return: the list of the results of each request, as returned by :meth:`run`
+
+        ::
+
+            results = sess.run_batch([output_name], [{input_name: x} for x in xs])
+        """
+        for input_feed in input_feeds:
+            self._validate_input(list(input_feed.keys()))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        return self._sess.run_batch(output_names, input_feeds, run_options, output_format, max_concurrency)
+
+    def run_batch_async(
+        self, output_names, input_feeds, run_options=None, output_format="numpy", max_concurrency=0
+    ) -> concurrent.futures.Future:
+        """
+        Compute the predictions of several independent requests like :meth:`run_batch`,
+        on a thread of the session, and return a future of the list of their results.
+        The feeds must not be modified until the future is done.
+
+        ::
+
+            future = sess.run_batch_async([output_name], [{input_name: x} for x in xs])
+            results = future.result()
+        """
+        if self._batch_executor is None:
+            self._batch_executor = concurrent.futures.ThreadPoolExecutor(
+                max_workers=1, thread_name_prefix="ort_run_batch"
+            )
+        return self._batch_executor.submit(
+            self.run_batch, output_names, input_feeds, run_options, output_format, max_concurrency
+        )
+
     def run_with_ort_values(self, output_names, input_dict_ort_values, run_options=None) -> Sequence[OrtValue]:
         """
         Compute the predictions.
@@ -2,8 +2,10 @@
 // SPDX-FileCopyrightText: Copyright 2024 Arm Limited and/or its affiliates <open-source-office@arm.com>
 // Licensed under the MIT License.
 
+#include <atomic>
 #include <functional>
 #include <mutex>
+#include <thread>
 #include "python/onnxruntime_pybind_exceptions.h"
 #include "python/onnxruntime_pybind_mlvalue.h"
 #include "python/onnxruntime_pybind_state_common.h"
@@ -901,6 +903,14 @@ static std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory
             } else {
               ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_hw_compatible' should be 'True' or 'False'. Default value is 'False'.\n");
             }
+          } else if (option.first == "trt_engine_async_build") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_engine_async_build = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_engine_async_build = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_async_build' should be 'True' or 'False'. Default value is 'False'.\n");
+            }
           } else if (option.first == "trt_op_types_to_exclude") {
             trt_op_types_to_exclude = option.second;
             params.trt_op_types_to_exclude = trt_op_types_to_exclude.c_str();
@@ -1580,6 +1590,95 @@ static void LogDeprecationWarning(
 }
 #endif
 
+// Returns true when the outputs of a run are returned as DLPack capsules rather than numpy arrays.
+static bool ParseOutputFormat(const std::string& output_format) {
+  const bool dlpack_outputs = output_format == "dlpack";
+  if (!dlpack_outputs && output_format != "numpy") {
+    throw std::invalid_argument("output_format must be 'numpy' or 'dlpack', not '" + output_format + "'.");
+  }
+#if !defined(ENABLE_DLPACK)
+  if (dlpack_outputs) {
+    throw std::runtime_error("output_format 'dlpack' requires a build with DLPack enabled.");
+  }
+#endif
+  return dlpack_outputs;
+}
+
+// Converts the feeds of a run to OrtValues. It reads python objects, so it must be called with the GIL held.
+static void CreateFeedsFromPyObjects(PyInferenceSession* sess, const RunOptions* run_options,
+                                     const std::map<std::string, const py::object>& pyfeeds, NameMLValMap& feeds) {
+  if (run_options != nullptr && !run_options->active_adapters.empty()) {
+    AppendLoraParametersAsInputs(*run_options, pyfeeds.size(), feeds);
+  } else {
+    feeds.reserve(pyfeeds.size());
+  }
+
+  auto px = sess->GetSessionHandle()->GetModelInputs();
+  if (!px.first.IsOK() || !px.second) {
+    throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+  }
+
+  for (const auto& feed : pyfeeds) {
+    // No need to process 'None's sent in by the user
+    // to feed Optional inputs in the graph.
+    // We just won't include anything in the feed and ORT
+    // will handle such implicit 'None's internally.
+    if (feed.second.is(py::none())) {
+      continue;
+    }
+#if defined(ENABLE_DLPACK)
+    // tensors of other frameworks, e.g. torch tensors on CPU or CUDA, are fed without a copy.
+    // numpy arrays also implement __dlpack__ but are already fed without a copy below.
+    py::object value = feed.second;
+    if (!IsNumpyArray(value) && py::hasattr(value, "__dlpack__")) {
+      const auto def = std::find_if(px.second->begin(), px.second->end(), [&feed](const NodeArg* arg) {
+        return arg->Name() == feed.first;
+      });
+      const bool is_bool_tensor = def != px.second->end() && *(*def)->Type() == "tensor(bool)";
+      py::object capsule = value.attr("__dlpack__")();
+      feeds.insert(std::make_pair(feed.first, FromDlpack(capsule.ptr(), is_bool_tensor)));
+      continue;
+    }
+#endif
+    OrtValue ml_value;
+    CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
+    ThrowIfPyErrOccured();
+    feeds.insert(std::make_pair(feed.first, std::move(ml_value)));
+  }
+}
+
+// Converts the outputs of a run to python objects, which must be done with the GIL held.
+static py::list CreatePyObjectsFromFetches(const std::vector<OrtValue>& fetches, bool dlpack_outputs) {
+#if !defined(ENABLE_DLPACK)
+  ORT_UNUSED_PARAMETER(dlpack_outputs);
+#endif
+  py::list result;
+  size_t pos = 0;
+  for (const auto& fet : fetches) {
+    if (fet.IsAllocated()) {
+#if defined(ENABLE_DLPACK)
+      if (dlpack_outputs && fet.IsTensor() && !fet.Get<Tensor>().IsDataTypeString()) {
+        // the capsule shares the buffer of the output, whatever the device it is on
+        result.append(py::reinterpret_steal<py::object>(ToDlpack(fet)));
+        ++pos;
+        continue;
+      }
+#endif
+      if (fet.IsTensor()) {
+        result.append(AddTensorAsPyObj(fet, nullptr, nullptr));
+      } else if (fet.IsSparseTensor()) {
+        result.append(GetPyObjectFromSparseTensor(pos, fet, nullptr));
+      } else {
+        result.append(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+      }
+    } else {  // Send back None because the corresponding OrtValue was empty
+      result.append(py::none());
+    }
+    ++pos;
+  }
+  return result;
+}
+
 void addGlobalMethods(py::module& m) {
   m.def("set_global_thread_pool_sizes", [](int intra_op_num_threads, int inter_op_num_threads) {
           static std::mutex global_thread_pool_mutex;
@@ -2002,6 +2101,8 @@ for model inference.)pbdoc");
             ort_arena_cfg->initial_growth_chunk_size_bytes = kvp.second.cast<int>();
           } else if (key == "max_power_of_two_extend_bytes") {
             ort_arena_cfg->max_power_of_two_extend_bytes = kvp.second.cast<int>();
+          } else if (key == "huge_pages") {
+            ort_arena_cfg->huge_pages = kvp.second.cast<int>();
           } else {
             ORT_THROW("Invalid OrtArenaCfg option: ", key);
           }
@@ -2013,7 +2114,8 @@ for model inference.)pbdoc");
       .def_readwrite("initial_chunk_size_bytes", &OrtArenaCfg::initial_chunk_size_bytes)
       .def_readwrite("max_dead_bytes_per_chunk", &OrtArenaCfg::max_dead_bytes_per_chunk)
       .def_readwrite("initial_growth_chunk_size_bytes", &OrtArenaCfg::initial_growth_chunk_size_bytes)
-      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes);
+      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes)
+      .def_readwrite("huge_pages", &OrtArenaCfg::huge_pages);
 
   py::class_<OrtMemoryInfo> ort_memory_info_binding(m, "OrtMemoryInfo");
   ort_memory_info_binding.def(py::init([](const char* name, OrtAllocatorType type, int id, OrtMemType mem_type) {
@@ -2551,35 +2653,15 @@ including arg name, arg type (contains both type and shape).)pbdoc")
           R"pbdoc(Load a model saved in ONNX or ORT format.)pbdoc")
       .def("run",
            [](PyInferenceSession* sess, const std::vector<std::string>& output_names,
-              const std::map<std::string, const py::object>& pyfeeds, RunOptions* run_options = nullptr)
+              const std::map<std::string, const py::object>& pyfeeds, RunOptions* run_options = nullptr,
+              const std::string& output_format = "numpy")
                -> py::list {
+             const bool dlpack_outputs = ParseOutputFormat(output_format);
              NameMLValMap feeds;
-             if (run_options != nullptr && !run_options->active_adapters.empty()) {
-               AppendLoraParametersAsInputs(*run_options, pyfeeds.size(), feeds);
-             } else {
-               feeds.reserve(pyfeeds.size());
-             }
-
-             for (const auto& feed : pyfeeds) {
-               // No need to process 'None's sent in by the user
-               // to feed Optional inputs in the graph.
-               // We just won't include anything in the feed and ORT
-               // will handle such implicit 'None's internally.
-               if (!feed.second.is(py::none())) {
-                 OrtValue ml_value;
-                 auto px = sess->GetSessionHandle()->GetModelInputs();
-                 if (!px.first.IsOK() || !px.second) {
-                   throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-                 }
-                 CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
-                 ThrowIfPyErrOccured();
-                 feeds.insert(std::make_pair(feed.first, std::move(ml_value)));
-               }
-             }
+             CreateFeedsFromPyObjects(sess, run_options, pyfeeds, feeds);
 
              std::vector<OrtValue> fetches;
              fetches.reserve(output_names.size());
-             common::Status status;
 
              {
                // release GIL to allow multiple python threads to invoke Run() in parallel.
@@ -2591,23 +2673,62 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                }
              }
 
-             py::list result;
-             size_t pos = 0;
-             for (const auto& fet : fetches) {
-               if (fet.IsAllocated()) {
-                 if (fet.IsTensor()) {
-                   result.append(AddTensorAsPyObj(fet, nullptr, nullptr));
-                 } else if (fet.IsSparseTensor()) {
-                   result.append(GetPyObjectFromSparseTensor(pos, fet, nullptr));
-                 } else {
-                   result.append(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+             return CreatePyObjectsFromFetches(fetches, dlpack_outputs);
+           })
+      /// Runs a list of feed dictionaries with the same outputs. The feeds are converted, then the GIL is released
+      /// once while the requests run concurrently on max_concurrency threads (the number of cores if 0), and the
+      /// outputs of all the requests are converted when it is reacquired.
+      .def("run_batch",
+           [](PyInferenceSession* sess, const std::vector<std::string>& output_names,
+              const std::vector<std::map<std::string, const py::object>>& pyfeeds_batch,
+              RunOptions* run_options = nullptr, const std::string& output_format = "numpy",
+              size_t max_concurrency = 0)
+               -> py::list {
+             const bool dlpack_outputs = ParseOutputFormat(output_format);
+             const size_t batch_size = pyfeeds_batch.size();
+             std::vector<NameMLValMap> feeds_batch(batch_size);
+             for (size_t i = 0; i < batch_size; ++i) {
+               CreateFeedsFromPyObjects(sess, run_options, pyfeeds_batch[i], feeds_batch[i]);
+             }
+
+             std::vector<std::vector<OrtValue>> fetches_batch(batch_size);
+             std::vector<common::Status> statuses(batch_size);
+             {
+               py::gil_scoped_release release;
+               size_t num_threads = max_concurrency != 0 ? max_concurrency : std::thread::hardware_concurrency();
+               num_threads = std::max<size_t>(1, std::min(num_threads, batch_size));
+
+               std::atomic<size_t> next_request{0};
+               auto run_requests = [&]() {
+                 for (size_t i = next_request++; i < batch_size; i = next_request++) {
+                   fetches_batch[i].reserve(output_names.size());
+                   statuses[i] = run_options != nullptr
+                                     ? sess->GetSessionHandle()->Run(*run_options, feeds_batch[i], output_names,
+                                                                     &fetches_batch[i])
+                                     : sess->GetSessionHandle()->Run(feeds_batch[i], output_names, &fetches_batch[i]);
                  }
-               } else {  // Send back None because the corresponding OrtValue was empty
-                 result.append(py::none());
+               };
+
+               std::vector<std::thread> threads;
+               threads.reserve(num_threads - 1);
+               for (size_t i = 1; i < num_threads; ++i) {
+                 threads.emplace_back(run_requests);
                }
-               ++pos;
+               run_requests();
+               for (auto& thread : threads) {
+                 thread.join();
+               }
+             }
+
+             for (const auto& status : statuses) {
+               OrtPybindThrowIfError(status);
+             }
+
+             py::list results;
+             for (const auto& fetches : fetches_batch) {
+               results.append(CreatePyObjectsFromFetches(fetches, dlpack_outputs));
              }
-             return result;
+             return results;
            })
       .def("run_async",
            [](PyInferenceSession* sess,
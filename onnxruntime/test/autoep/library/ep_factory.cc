@@ -26,6 +26,10 @@ ExampleEpFactory::ExampleEpFactory(const char* ep_name, ApiPtrs apis)
 
   CreateDataTransfer = CreateDataTransferImpl;
 
+  // the example EP copies synchronously so it is not stream aware
+  IsStreamAware = nullptr;
+  CreateSyncStreamForDevice = nullptr;
+
   // for the sake of this example we specify a CPU allocator with no arena and 1K alignment (arbitrary)
   // as well as GPU and GPU shared memory. the actual EP implementation would typically define two at most for a
   // device (one for device memory and one for shared memory for data transfer between device and CPU)
@@ -357,6 +357,38 @@ TEST(AutoEpSelection, PreferNpu) {
                        OrtExecutionProviderDevicePolicy::OrtExecutionProviderDevicePolicy_PREFER_NPU);
 }
 
+// MAX_PERFORMANCE with calibration runs times each EP and caches the times. falls back to CPU if nothing else runs.
+TEST(AutoEpSelection, MaxPerformanceCalibration) {
+  const std::filesystem::path cache_file = std::filesystem::temp_directory_path() / "ep_selection_cache.txt";
+  std::filesystem::remove(cache_file);
+
+  std::vector<Input<float>> inputs(1);
+  auto& input = inputs.back();
+  input.name = "X";
+  input.dims = {3, 2};
+  input.values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+
+  std::vector<int64_t> expected_dims_y = {3, 2};
+  std::vector<float> expected_values_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+
+  for (int i = 0; i < 2; ++i) {
+    Ort::SessionOptions session_options;
+    session_options.SetEpSelectionPolicy(OrtExecutionProviderDevicePolicy_MAX_PERFORMANCE);
+    session_options.AddConfigEntry("session.ep_selection_calibration_runs", "3");
+    session_options.AddConfigEntry("session.ep_selection_cache_file", cache_file.string().c_str());
+    Ort::Session session(*ort_env, ORT_TSTR("testdata/mul_1.onnx"), session_options);
+
+    auto default_allocator = std::make_unique<MockedOrtAllocator>();
+    RunSession<float>(default_allocator.get(), session, inputs, "Y", expected_dims_y, expected_values_y, nullptr);
+
+    // the first session times at least the ORT CPU EP, the second one reads the cache
+    ASSERT_TRUE(std::filesystem::exists(cache_file));
+    EXPECT_GT(std::filesystem::file_size(cache_file), 0u);
+  }
+
+  std::filesystem::remove(cache_file);
+}
+
 static OrtStatus* ORT_API_CALL PolicyDelegate(_In_ const OrtEpDevice** ep_devices,
                                               _In_ size_t num_devices,
                                               _In_ const OrtKeyValuePairs* model_metadata,
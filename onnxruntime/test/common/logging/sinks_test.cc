@@ -3,6 +3,7 @@
 #include "core/common/common.h"
 #include "core/common/logging/capture.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
 #include "core/common/logging/sinks/cerr_sink.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/logging/sinks/composite_sink.h"
@@ -168,6 +169,33 @@ TEST(LoggingTests, TestCompositeSinkBasic) {
   LOGS_CATEGORY(*logger, WARNING, "ArbitraryCategory") << "Warning";
 }
 
+/// <summary>
+/// Tests that an async sink sends the messages to the wrapped sink from its background thread.
+/// </summary>
+TEST(LoggingTests, TestAsyncSink) {
+  const std::string logid{"TestAsyncSink"};
+  const std::string message{"Test async message"};
+  const Severity min_log_level = Severity::kWARNING;
+
+  MockSink* sink_ptr = new MockSink();
+
+  // the messages are sent by the time the async sink is destroyed
+  EXPECT_CALL(*sink_ptr, SendImpl(testing::_, logid,
+                                  testing::ResultOf([](const Capture& capture) { return capture.Message(); }, message)))
+      .Times(3);
+
+  {
+    LoggingManager manager{std::make_unique<AsyncSink>(std::unique_ptr<ISink>{sink_ptr}, 16), min_log_level, false,
+                           InstanceType::Temporal};
+
+    auto logger = manager.CreateLogger(logid);
+
+    LOGS(*logger, WARNING) << message;
+    LOGS(*logger, ERROR) << message;
+    LOGS_CATEGORY(*logger, WARNING, "ArbitraryCategory") << message;
+  }
+}
+
 /// <summary>
 /// Tests that removing a sink of a specific type correctly updates the composite sink.
 /// </summary>
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+static void RunBatchedLoraMatMul(int64_t batch_size, int64_t rows_per_batch, int64_t k, int64_t rank, int64_t n,
+                                 int64_t num_adapters, const std::vector<int32_t>& adapter_index, float scale) {
+  std::vector<float> x(static_cast<size_t>(batch_size * rows_per_batch * k));
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<float>(static_cast<int>(i * 7 % 13) - 6) * 0.25f;
+  }
+  std::vector<float> a(static_cast<size_t>(num_adapters * k * rank));
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = static_cast<float>(static_cast<int>(i * 5 % 11) - 5) * 0.125f;
+  }
+  std::vector<float> b(static_cast<size_t>(num_adapters * rank * n));
+  for (size_t i = 0; i < b.size(); i++) {
+    b[i] = static_cast<float>(static_cast<int>(i * 3 % 7) - 3) * 0.5f;
+  }
+
+  // reference, each row multiplied by the adapter of its batch entry
+  std::vector<float> y(static_cast<size_t>(batch_size * rows_per_batch * n), 0.0f);
+  for (int64_t batch = 0; batch < batch_size; batch++) {
+    const int32_t adapter = adapter_index[batch];
+    if (adapter < 0) {
+      continue;
+    }
+    for (int64_t row = batch * rows_per_batch; row < (batch + 1) * rows_per_batch; row++) {
+      std::vector<float> shrunk(static_cast<size_t>(rank), 0.0f);
+      for (int64_t r = 0; r < rank; r++) {
+        for (int64_t i = 0; i < k; i++) {
+          shrunk[r] += x[row * k + i] * a[(adapter * k + i) * rank + r];
+        }
+      }
+      for (int64_t j = 0; j < n; j++) {
+        float value = 0.0f;
+        for (int64_t r = 0; r < rank; r++) {
+          value += shrunk[r] * b[(adapter * rank + r) * n + j];
+        }
+        y[row * n + j] = scale * value;
+      }
+    }
+  }
+
+  OpTester test("BatchedLoraMatMul", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<float>("scale", scale);
+  test.AddInput<float>("X", {batch_size, rows_per_batch, k}, x);
+  test.AddInput<float>("A", {num_adapters, k, rank}, a);
+  test.AddInput<float>("B", {num_adapters, rank, n}, b);
+  test.AddInput<int32_t>("adapter_index", {batch_size}, adapter_index);
+  test.AddOutput<float>("Y", {batch_size, rows_per_batch, n}, y);
+  test.SetOutputTolerance(1e-4f);
+  test.Run();
+}
+
+TEST(BatchedLoraMatMulTest, OneAdapterPerEntry) {
+  RunBatchedLoraMatMul(4, 3, 16, 4, 8, 4, {2, 0, 3, 1}, 1.0f);
+}
+
+TEST(BatchedLoraMatMulTest, SharedAndMissingAdapters) {
+  // consecutive entries sharing an adapter are multiplied together, negative entries get no update
+  RunBatchedLoraMatMul(6, 2, 32, 8, 16, 3, {1, 1, -1, 0, 0, 2}, 0.5f);
+}
+
+TEST(BatchedLoraMatMulTest, InvalidAdapterIndex) {
+  OpTester test("BatchedLoraMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("X", {1, 2}, {1.0f, 2.0f});
+  test.AddInput<float>("A", {1, 2, 1}, {1.0f, 1.0f});
+  test.AddInput<float>("B", {1, 1, 2}, {1.0f, 1.0f});
+  test.AddInput<int32_t>("adapter_index", {1}, {1});
+  test.AddOutput<float>("Y", {1, 2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is out of range");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// a 5 x 3 table whose row r is {r, 10 * r, -r}.
+const std::vector<float> kTable{0.f, 0.f, -0.f,
+                                1.f, 10.f, -1.f,
+                                2.f, 20.f, -2.f,
+                                3.f, 30.f, -3.f,
+                                4.f, 40.f, -4.f};
+
+}  // namespace
+
+TEST(EmbeddingBagTest, Sum2DIndices) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("table", {5, 3}, kTable);
+  test.AddInput<int64_t>("indices", {2, 3}, {1, 2, -1, 0, 3, 3});
+  test.AddOutput<float>("output", {2, 3}, {7.f, 70.f, -7.f, 6.f, 60.f, -6.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, MeanOffsetsWithEmptyBag) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<float>("table", {5, 3}, kTable);
+  test.AddInput<int32_t>("indices", {5}, {1, 3, 4, 2, 0});
+  test.AddInput<int32_t>("offsets", {3}, {0, 2, 2});
+  test.AddOutput<float>("output", {3, 3}, {2.f, 20.f, -2.f, 0.f, 0.f, 0.f, 2.f, 20.f, -2.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, SumLengthsWithPerSampleWeights) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("table", {5, 3}, kTable);
+  test.AddInput<int64_t>("indices", {4}, {1, 2, 4, 4});
+  test.AddOptionalInputEdge<int64_t>();
+  test.AddInput<int64_t>("lengths", {2}, {1, 3});
+  test.AddInput<float>("per_sample_weights", {4}, {2.f, 1.f, 0.5f, -1.f});
+  test.AddOutput<float>("output", {2, 3}, {2.f, 20.f, -2.f, 0.f, 0.f, 0.f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, Float16Table) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<MLFloat16>("table", {5, 3}, ToFloat16(kTable));
+  test.AddInput<int64_t>("indices", {2, 2}, {1, 4, 2, 2});
+  test.AddOutput<MLFloat16>("output", {2, 3}, ToFloat16({2.5f, 25.f, -2.5f, 2.f, 20.f, -2.f}));
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, Int8TableWithPerRowScale) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<int8_t>("table", {3, 2}, {1, -2, 10, 20, -128, 127});
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 1, 2, 0});
+  test.AddOptionalInputEdge<int64_t>();
+  test.AddOptionalInputEdge<int64_t>();
+  test.AddInput<float>("per_sample_weights", {2, 2}, {1.f, 1.f, 1.f, 2.f});
+  test.AddInput<float>("table_scale", {3}, {0.5f, 0.1f, 0.25f});
+  test.AddOutput<float>("output", {2, 2}, {1.5f, 1.f, -31.f, 29.75f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, InvalidOffsets) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("table", {5, 3}, kTable);
+  test.AddInput<int64_t>("indices", {3}, {1, 2, 3});
+  test.AddInput<int64_t>("offsets", {2}, {2, 1});
+  test.AddOutput<float>("output", {2, 3}, std::vector<float>(6, 0.f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "offsets must be non decreasing");
+}
+
+TEST(EmbeddingBagTest, IndexOutOfRange) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("table", {5, 3}, kTable);
+  test.AddInput<int64_t>("indices", {1, 2}, {1, 5});
+  test.AddOutput<float>("output", {1, 3}, std::vector<float>(3, 0.f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -543,5 +543,59 @@ TEST(GatherBlockQuantizedOpTest, GatherAxis2) {
   Test_GatherAxis2_WithZeroPoints<Int4x2, MLFloat16, int64_t>();
 }
 
+// rows of several blocks along the last axis, with an odd row width so rows start in the middle of a byte
+template <typename T1, typename T2, typename Tind>
+void Test_GatherAxis0_MultipleBlocksPerRow() {
+  constexpr int64_t rows = 5;
+  constexpr int64_t columns = 37;
+  constexpr int64_t block_size = 16;
+  constexpr int64_t blocks = (columns + block_size - 1) / block_size;
+
+  std::vector<int> data;
+  for (int64_t i = 0; i < rows * columns; ++i) {
+    data.push_back(static_cast<int>(i % 16) - 8);
+  }
+
+  std::vector<float> scales;
+  std::vector<int> zero_points;
+  for (int64_t r = 0; r < rows; ++r) {
+    for (int64_t b = 0; b < blocks; ++b) {
+      scales.push_back(0.5f * static_cast<float>(b + 1) + static_cast<float>(r));
+      zero_points.push_back(static_cast<int>((r + b) % 3) - 1);
+    }
+  }
+
+  std::vector<int> indices = {3, 0, -1, 3};
+  std::vector<float> output;
+  for (int index : indices) {
+    const int64_t r = index < 0 ? index + rows : index;
+    for (int64_t c = 0; c < columns; ++c) {
+      const int64_t scale_idx = r * blocks + c / block_size;
+      output.push_back(static_cast<float>(data[r * columns + c] - zero_points[scale_idx]) * scales[scale_idx]);
+    }
+  }
+
+  RunGatherBlockQuantized(ToType<T1>(data),
+                          {rows, columns},
+                          ToType<Tind>(indices),
+                          {2, 2},
+                          ToType<T2>(scales),
+                          {rows, blocks},
+                          ToType<T1>(zero_points),
+                          0,
+                          1,
+                          block_size,
+                          ToType<T2>(output),
+                          {2, 2, columns},
+                          OpTester::ExpectResult::kExpectSuccess);
+}
+
+TEST(GatherBlockQuantizedOpTest, GatherAxis0MultipleBlocksPerRow) {
+  Test_GatherAxis0_MultipleBlocksPerRow<UInt4x2, float, int32_t>();
+  Test_GatherAxis0_MultipleBlocksPerRow<Int4x2, float, int32_t>();
+  Test_GatherAxis0_MultipleBlocksPerRow<UInt4x2, MLFloat16, int64_t>();
+  Test_GatherAxis0_MultipleBlocksPerRow<Int4x2, MLFloat16, int64_t>();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
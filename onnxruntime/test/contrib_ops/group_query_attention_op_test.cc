@@ -0,0 +1,291 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+constexpr int kNumHeads = 4;
+constexpr int kKvNumHeads = 2;
+constexpr int kHeadSize = 8;
+constexpr int kHiddenSize = kNumHeads * kHeadSize;
+constexpr int kKvHiddenSize = kKvNumHeads * kHeadSize;
+
+std::vector<float> MakeData(size_t count, float seed) {
+  std::vector<float> data(count);
+  for (size_t i = 0; i < count; ++i) {
+    data[i] = std::sin(seed + 0.37f * static_cast<float>(i));
+  }
+  return data;
+}
+
+int8_t Quantize(float value, float scale) {
+  return static_cast<int8_t>(std::clamp(std::nearbyint(value / scale), -128.0f, 127.0f));
+}
+
+// Appends the new tokens, quantized, to a BNSH int8 cache of past_seqlen tokens and returns the attention of the
+// new tokens to the dequantized cache.
+std::vector<float> ComputeExpectedOutput(const std::vector<float>& query, const std::vector<float>& key,
+                                         const std::vector<float>& value, const std::vector<float>& k_scale,
+                                         const std::vector<float>& v_scale, int sequence_length, int past_seqlen,
+                                         std::vector<int8_t>& key_cache, std::vector<int8_t>& value_cache) {
+  const int total_seqlen = past_seqlen + sequence_length;
+  const auto scale_of = [](const std::vector<float>& scale, int kv_head, int i) {
+    return scale.size() == 1 ? scale[0] : scale[kv_head * kHeadSize + i];
+  };
+
+  for (int n = 0; n < kKvNumHeads; ++n) {
+    for (int s = 0; s < sequence_length; ++s) {
+      for (int i = 0; i < kHeadSize; ++i) {
+        const size_t src = s * kKvHiddenSize + n * kHeadSize + i;
+        const size_t dst = (n * total_seqlen + past_seqlen + s) * kHeadSize + i;
+        key_cache[dst] = Quantize(key[src], scale_of(k_scale, n, i));
+        value_cache[dst] = Quantize(value[src], scale_of(v_scale, n, i));
+      }
+    }
+  }
+
+  const float alpha = 1.0f / std::sqrt(static_cast<float>(kHeadSize));
+  std::vector<float> output(sequence_length * kHiddenSize);
+  for (int h = 0; h < kNumHeads; ++h) {
+    const int n = h / (kNumHeads / kKvNumHeads);
+    for (int s = 0; s < sequence_length; ++s) {
+      const int causal_length = past_seqlen + s + 1;
+      std::vector<float> scores(causal_length);
+      float max_score = -INFINITY;
+      for (int p = 0; p < causal_length; ++p) {
+        float score = 0.0f;
+        for (int i = 0; i < kHeadSize; ++i) {
+          const float k = key_cache[(n * total_seqlen + p) * kHeadSize + i] * scale_of(k_scale, n, i);
+          score += query[s * kHiddenSize + h * kHeadSize + i] * k;
+        }
+        scores[p] = score * alpha;
+        max_score = std::max(max_score, scores[p]);
+      }
+
+      float sum = 0.0f;
+      for (auto& score : scores) {
+        score = std::exp(score - max_score);
+        sum += score;
+      }
+
+      for (int i = 0; i < kHeadSize; ++i) {
+        float out = 0.0f;
+        for (int p = 0; p < causal_length; ++p) {
+          const float v = value_cache[(n * total_seqlen + p) * kHeadSize + i] * scale_of(v_scale, n, i);
+          out += scores[p] / sum * v;
+        }
+        output[s * kHiddenSize + h * kHeadSize + i] = out;
+      }
+    }
+  }
+
+  return output;
+}
+
+void RunInt8KVCacheTest(const std::string& quant_type, int sequence_length, int past_seqlen) {
+  const int total_seqlen = past_seqlen + sequence_length;
+  const auto query = MakeData(sequence_length * kHiddenSize, 0.1f);
+  const auto key = MakeData(sequence_length * kKvHiddenSize, 0.7f);
+  const auto value = MakeData(sequence_length * kKvHiddenSize, 1.3f);
+
+  std::vector<float> k_scale{1.0f / 127};
+  std::vector<float> v_scale{1.0f / 100};
+  std::vector<int64_t> scale_dims{1};
+  if (quant_type == "PER_CHANNEL") {
+    k_scale = MakeData(kKvHiddenSize, 2.0f);
+    v_scale = MakeData(kKvHiddenSize, 2.5f);
+    for (size_t i = 0; i < k_scale.size(); ++i) {
+      k_scale[i] = (1.5f + k_scale[i]) / 127;
+      v_scale[i] = (1.5f + v_scale[i]) / 127;
+    }
+    scale_dims = {kKvNumHeads, 1, kHeadSize};
+  }
+
+  // the past tokens are already quantized
+  std::vector<int8_t> past_key(kKvNumHeads * past_seqlen * kHeadSize);
+  std::vector<int8_t> past_value(past_key.size());
+  for (size_t i = 0; i < past_key.size(); ++i) {
+    past_key[i] = static_cast<int8_t>(static_cast<int>(i * 37 % 255) - 127);
+    past_value[i] = static_cast<int8_t>(static_cast<int>(i * 53 % 255) - 127);
+  }
+
+  std::vector<int8_t> present_key(kKvNumHeads * total_seqlen * kHeadSize);
+  std::vector<int8_t> present_value(present_key.size());
+  for (int n = 0; n < kKvNumHeads; ++n) {
+    std::copy_n(past_key.begin() + n * past_seqlen * kHeadSize, past_seqlen * kHeadSize,
+                present_key.begin() + n * total_seqlen * kHeadSize);
+    std::copy_n(past_value.begin() + n * past_seqlen * kHeadSize, past_seqlen * kHeadSize,
+                present_value.begin() + n * total_seqlen * kHeadSize);
+  }
+  const auto output = ComputeExpectedOutput(query, key, value, k_scale, v_scale, sequence_length, past_seqlen,
+                                            present_key, present_value);
+
+  OpTester tester("GroupQueryAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", kNumHeads);
+  tester.AddAttribute<int64_t>("kv_num_heads", kKvNumHeads);
+  tester.AddAttribute<std::string>("k_quant_type", quant_type);
+  tester.AddAttribute<std::string>("v_quant_type", quant_type);
+
+  tester.AddInput<float>("query", {1, sequence_length, kHiddenSize}, query);
+  tester.AddInput<float>("key", {1, sequence_length, kKvHiddenSize}, key);
+  tester.AddInput<float>("value", {1, sequence_length, kKvHiddenSize}, value);
+  if (past_seqlen > 0) {
+    tester.AddInput<int8_t>("past_key", {1, kKvNumHeads, past_seqlen, kHeadSize}, past_key);
+    tester.AddInput<int8_t>("past_value", {1, kKvNumHeads, past_seqlen, kHeadSize}, past_value);
+  } else {
+    tester.AddOptionalInputEdge<int8_t>();
+    tester.AddOptionalInputEdge<int8_t>();
+  }
+  tester.AddInput<int32_t>("seqlens_k", {1}, {total_seqlen - 1});
+  tester.AddInput<int32_t>("total_sequence_length", {1}, {total_seqlen});
+  for (int i = 0; i < 5; ++i) {
+    // cos_cache, sin_cache, position_ids, attention_bias and head_sink
+    tester.AddOptionalInputEdge<float>();
+  }
+  tester.AddInput<float>("k_scale", scale_dims, k_scale);
+  tester.AddInput<float>("v_scale", scale_dims, v_scale);
+
+  tester.AddOutput<float>("output", {1, sequence_length, kHiddenSize}, output);
+  tester.AddOutput<int8_t>("present_key", {1, kKvNumHeads, total_seqlen, kHeadSize}, present_key);
+  tester.AddOutput<int8_t>("present_value", {1, kKvNumHeads, total_seqlen, kHeadSize}, present_value);
+  tester.SetOutputTolerance(0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+// Appends the packed tokens of each sequence to its BNSH cache of max_seqlen tokens and returns the attention of the
+// new tokens to the cache.
+std::vector<float> ComputePackedBatchOutput(const std::vector<float>& query, const std::vector<float>& key,
+                                            const std::vector<float>& value,
+                                            const std::vector<int32_t>& cumulative_seqlens,
+                                            const std::vector<int32_t>& past_seqlens, int max_seqlen,
+                                            std::vector<float>& key_cache, std::vector<float>& value_cache) {
+  const float alpha = 1.0f / std::sqrt(static_cast<float>(kHeadSize));
+  std::vector<float> output(query.size());
+  for (size_t b = 0; b < past_seqlens.size(); ++b) {
+    const int past = past_seqlens[b];
+    const int q_start = cumulative_seqlens[b];
+    const int sequence_length = cumulative_seqlens[b + 1] - q_start;
+    const auto cache_index = [&](int n, int p, int i) {
+      return ((static_cast<int>(b) * kKvNumHeads + n) * max_seqlen + p) * kHeadSize + i;
+    };
+
+    for (int n = 0; n < kKvNumHeads; ++n) {
+      for (int s = 0; s < sequence_length; ++s) {
+        for (int i = 0; i < kHeadSize; ++i) {
+          key_cache[cache_index(n, past + s, i)] = key[(q_start + s) * kKvHiddenSize + n * kHeadSize + i];
+          value_cache[cache_index(n, past + s, i)] = value[(q_start + s) * kKvHiddenSize + n * kHeadSize + i];
+        }
+      }
+    }
+
+    for (int h = 0; h < kNumHeads; ++h) {
+      const int n = h / (kNumHeads / kKvNumHeads);
+      for (int s = 0; s < sequence_length; ++s) {
+        const float* q = &query[(q_start + s) * kHiddenSize + h * kHeadSize];
+        const int causal_length = past + s + 1;
+        std::vector<float> scores(causal_length);
+        float max_score = -INFINITY;
+        for (int p = 0; p < causal_length; ++p) {
+          float score = 0.0f;
+          for (int i = 0; i < kHeadSize; ++i) score += q[i] * key_cache[cache_index(n, p, i)];
+          scores[p] = score * alpha;
+          max_score = std::max(max_score, scores[p]);
+        }
+
+        float sum = 0.0f;
+        for (auto& score : scores) {
+          score = std::exp(score - max_score);
+          sum += score;
+        }
+
+        float* out = &output[(q_start + s) * kHiddenSize + h * kHeadSize];
+        for (int p = 0; p < causal_length; ++p) {
+          for (int i = 0; i < kHeadSize; ++i) out[i] += scores[p] / sum * value_cache[cache_index(n, p, i)];
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+}  // namespace
+
+TEST(GroupQueryAttentionTest, CpuPackedBatch) {
+  // a prompt, a token generation step and a continued prompt in one batch
+  const std::vector<int32_t> cumulative_seqlens{0, 3, 4, 6};
+  const std::vector<int32_t> past_seqlens{0, 4, 2};
+  constexpr int kBatchSize = 3;
+  constexpr int kMaxSeqlen = 6;
+  const int token_count = cumulative_seqlens.back();
+
+  std::vector<int32_t> seqlens_k(kBatchSize);
+  for (int b = 0; b < kBatchSize; ++b) {
+    seqlens_k[b] = past_seqlens[b] + cumulative_seqlens[b + 1] - cumulative_seqlens[b] - 1;
+  }
+
+  const auto query = MakeData(token_count * kHiddenSize, 0.1f);
+  const auto key = MakeData(token_count * kKvHiddenSize, 0.7f);
+  const auto value = MakeData(token_count * kKvHiddenSize, 1.3f);
+  const auto past_key = MakeData(kBatchSize * kKvNumHeads * kMaxSeqlen * kHeadSize, 1.9f);
+  const auto past_value = MakeData(past_key.size(), 2.5f);
+  auto present_key = past_key;
+  auto present_value = past_value;
+  const auto output = ComputePackedBatchOutput(query, key, value, cumulative_seqlens, past_seqlens, kMaxSeqlen,
+                                               present_key, present_value);
+
+  OpTester tester("GroupQueryAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", kNumHeads);
+  tester.AddAttribute<int64_t>("kv_num_heads", kKvNumHeads);
+
+  const std::vector<int64_t> cache_dims{kBatchSize, kKvNumHeads, kMaxSeqlen, kHeadSize};
+  tester.AddInput<float>("query", {1, token_count, kHiddenSize}, query);
+  tester.AddInput<float>("key", {1, token_count, kKvHiddenSize}, key);
+  tester.AddInput<float>("value", {1, token_count, kKvHiddenSize}, value);
+  tester.AddInput<float>("past_key", cache_dims, past_key);
+  tester.AddInput<float>("past_value", cache_dims, past_value);
+  tester.AddInput<int32_t>("seqlens_k", {kBatchSize}, seqlens_k);
+  tester.AddInput<int32_t>("total_sequence_length", {1}, {kMaxSeqlen});
+  for (int i = 0; i < 7; ++i) {
+    // cos_cache, sin_cache, position_ids, attention_bias, head_sink, k_scale and v_scale
+    tester.AddOptionalInputEdge<float>();
+  }
+  tester.AddInput<int32_t>("cumulative_sequence_length", {kBatchSize + 1}, cumulative_seqlens);
+
+  tester.AddOutput<float>("output", {1, token_count, kHiddenSize}, output);
+  tester.AddOutput<float>("present_key", cache_dims, present_key);
+  tester.AddOutput<float>("present_value", cache_dims, present_value);
+  tester.SetOutputTolerance(0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(GroupQueryAttentionTest, CpuInt8KVCachePrompt) {
+  RunInt8KVCacheTest("PER_TENSOR", 3, 0);
+}
+
+TEST(GroupQueryAttentionTest, CpuInt8KVCacheTokenGeneration) {
+  RunInt8KVCacheTest("PER_TENSOR", 1, 5);
+}
+
+TEST(GroupQueryAttentionTest, CpuInt8KVCachePerChannel) {
+  RunInt8KVCacheTest("PER_CHANNEL", 1, 5);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "core/platform/env_var_utils.h"
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
@@ -757,5 +761,74 @@ TEST(MultiHeadAttentionTest, CrossAttention_DiffSequenceLengths_UsingDMMHAInside
   RunMultiHeadAttentionTests(data, DISABLE_CPU | DISABLE_ROCM_MHA | DISABLE_WEBGPU | DISABLE_DML);
 }
 
+// A causal prompt long enough for the CPU flash attention kernel to split Q and K/V into several blocks, with the
+// present state requested.
+TEST(MultiHeadAttentionTest, SelfAttention_Causal_WithPresent_LongSequence_Cpu) {
+  constexpr int batch_size = 1;
+  constexpr int sequence_length = 300;
+  constexpr int num_heads = 2;
+  constexpr int head_size = 256;
+  constexpr int hidden_size = num_heads * head_size;
+
+  std::vector<float> query(batch_size * sequence_length * hidden_size);
+  std::vector<float> key(query.size());
+  std::vector<float> value(query.size());
+  for (size_t i = 0; i < query.size(); ++i) {
+    query[i] = std::sin(0.37f * static_cast<float>(i));
+    key[i] = std::cos(0.73f * static_cast<float>(i));
+    value[i] = std::sin(1.3f + 0.11f * static_cast<float>(i));
+  }
+
+  // references in BSNH for the output and BNSH for the present state
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  std::vector<float> output(query.size());
+  std::vector<float> present_key(query.size());
+  std::vector<float> present_value(query.size());
+  for (int n = 0; n < num_heads; ++n) {
+    for (int s = 0; s < sequence_length; ++s) {
+      const float* q = &query[s * hidden_size + n * head_size];
+      std::vector<float> scores(s + 1);
+      float max_score = -INFINITY;
+      for (int t = 0; t <= s; ++t) {
+        const float* k = &key[t * hidden_size + n * head_size];
+        float score = 0.f;
+        for (int h = 0; h < head_size; ++h) score += q[h] * k[h];
+        scores[t] = score * scale;
+        max_score = std::max(max_score, scores[t]);
+      }
+      float sum = 0.f;
+      for (auto& score : scores) {
+        score = std::exp(score - max_score);
+        sum += score;
+      }
+      float* out = &output[s * hidden_size + n * head_size];
+      for (int t = 0; t <= s; ++t) {
+        const float* v = &value[t * hidden_size + n * head_size];
+        for (int h = 0; h < head_size; ++h) out[h] += scores[t] / sum * v[h];
+      }
+      std::copy_n(&key[s * hidden_size + n * head_size], head_size, &present_key[(n * sequence_length + s) * head_size]);
+      std::copy_n(&value[s * hidden_size + n * head_size], head_size,
+                  &present_value[(n * sequence_length + s) * head_size]);
+    }
+  }
+
+  OpTester tester("MultiHeadAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", num_heads);
+  tester.AddAttribute<int64_t>("unidirectional", 1);
+  const std::vector<int64_t> dims{batch_size, sequence_length, hidden_size};
+  const std::vector<int64_t> present_dims{batch_size, num_heads, sequence_length, head_size};
+  tester.AddInput<float>("query", dims, query);
+  tester.AddInput<float>("key", dims, key);
+  tester.AddInput<float>("value", dims, value);
+  tester.AddOutput<float>("output", dims, output);
+  tester.AddOutput<float>("present_key", present_dims, present_key);
+  tester.AddOutput<float>("present_value", present_dims, present_value);
+  tester.SetOutputTolerance(0.0001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,183 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+constexpr int kNumHeads = 2;
+constexpr int kKvNumHeads = 1;
+constexpr int kHeadSize = 8;
+constexpr int kBlockSize = 2;
+constexpr int kNumBlocks = 6;
+constexpr int kMaxBlocksPerSeq = 3;
+constexpr int kHiddenSize = kNumHeads * kHeadSize;
+constexpr int kKvHiddenSize = kKvNumHeads * kHeadSize;
+
+std::vector<float> MakeData(size_t count, float seed) {
+  std::vector<float> data(count);
+  for (size_t i = 0; i < count; ++i) {
+    data[i] = std::sin(seed + 0.37f * static_cast<float>(i));
+  }
+  return data;
+}
+
+// Causal attention of the new tokens of each sequence to its past and new tokens, where the past tokens are read
+// from the caches through the block table.
+std::vector<float> ComputeExpectedOutput(const std::vector<float>& query, const std::vector<float>& key,
+                                         const std::vector<float>& value, const std::vector<float>& key_cache,
+                                         const std::vector<float>& value_cache,
+                                         const std::vector<int32_t>& cumulative_seqlens,
+                                         const std::vector<int32_t>& past_seqlens,
+                                         const std::vector<int32_t>& block_table, int local_window_size) {
+  const int batch_size = static_cast<int>(past_seqlens.size());
+  const float scale = 1.0f / std::sqrt(static_cast<float>(kHeadSize));
+  std::vector<float> output(query.size());
+  for (int b = 0; b < batch_size; ++b) {
+    const int past = past_seqlens[b];
+    const int q_start = cumulative_seqlens[b];
+    const int sequence_length = cumulative_seqlens[b + 1] - q_start;
+
+    // K and V rows of all tokens of the sequence
+    auto kv_row = [&](const std::vector<float>& new_rows, const std::vector<float>& cache, int p, int kv_head) {
+      if (p >= past) {
+        return &new_rows[(q_start + p - past) * kKvHiddenSize + kv_head * kHeadSize];
+      }
+      const int block = block_table[b * kMaxBlocksPerSeq + p / kBlockSize];
+      return &cache[(block * kBlockSize + p % kBlockSize) * kKvHiddenSize + kv_head * kHeadSize];
+    };
+
+    for (int h = 0; h < kNumHeads; ++h) {
+      const int kv_head = h / (kNumHeads / kKvNumHeads);
+      for (int s = 0; s < sequence_length; ++s) {
+        const float* q = &query[(q_start + s) * kHiddenSize + h * kHeadSize];
+        const int causal_length = past + s + 1;
+        const int start = local_window_size >= 0 ? std::max(0, causal_length - local_window_size - 1) : 0;
+
+        std::vector<float> scores;
+        float max_score = -INFINITY;
+        for (int p = start; p < causal_length; ++p) {
+          const float* k = kv_row(key, key_cache, p, kv_head);
+          float score = 0.f;
+          for (int i = 0; i < kHeadSize; ++i) score += q[i] * k[i];
+          scores.push_back(score * scale);
+          max_score = std::max(max_score, scores.back());
+        }
+
+        float sum = 0.f;
+        for (auto& score : scores) {
+          score = std::exp(score - max_score);
+          sum += score;
+        }
+
+        float* out = &output[(q_start + s) * kHiddenSize + h * kHeadSize];
+        for (int p = start; p < causal_length; ++p) {
+          const float* v = kv_row(value, value_cache, p, kv_head);
+          for (int i = 0; i < kHeadSize; ++i) out[i] += scores[p - start] / sum * v[i];
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+void RunPagedAttentionTest(int local_window_size, bool use_float16) {
+  // sequence 0 has 3 cached tokens and 2 new ones, sequence 1 has 3 new tokens
+  const std::vector<int32_t> cumulative_seqlens{0, 2, 5};
+  const std::vector<int32_t> past_seqlens{3, 0};
+  const std::vector<int32_t> block_table{4, 1, 3, 2, 0, 5};
+  const int token_count = cumulative_seqlens.back();
+
+  const auto query = MakeData(token_count * kHiddenSize, 0.1f);
+  const auto key = MakeData(token_count * kKvHiddenSize, 0.7f);
+  const auto value = MakeData(token_count * kKvHiddenSize, 1.3f);
+  const auto key_cache = MakeData(kNumBlocks * kBlockSize * kKvHiddenSize, 1.9f);
+  const auto value_cache = MakeData(kNumBlocks * kBlockSize * kKvHiddenSize, 2.5f);
+  const auto output = ComputeExpectedOutput(query, key, value, key_cache, value_cache, cumulative_seqlens,
+                                            past_seqlens, block_table, local_window_size);
+
+  OpTester tester("PagedAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", kNumHeads);
+  tester.AddAttribute<int64_t>("kv_num_heads", kKvNumHeads);
+  tester.AddAttribute<int64_t>("local_window_size", local_window_size);
+
+  const std::vector<int64_t> cache_dims{kNumBlocks, kBlockSize, kKvNumHeads, kHeadSize};
+  if (use_float16) {
+    tester.AddInput<MLFloat16>("query", {token_count, kHiddenSize}, ToFloat16(query));
+    tester.AddInput<MLFloat16>("key", {token_count, kKvHiddenSize}, ToFloat16(key));
+    tester.AddInput<MLFloat16>("value", {token_count, kKvHiddenSize}, ToFloat16(value));
+    tester.AddInput<MLFloat16>("key_cache", cache_dims, ToFloat16(key_cache));
+    tester.AddInput<MLFloat16>("value_cache", cache_dims, ToFloat16(value_cache));
+  } else {
+    tester.AddInput<float>("query", {token_count, kHiddenSize}, query);
+    tester.AddInput<float>("key", {token_count, kKvHiddenSize}, key);
+    tester.AddInput<float>("value", {token_count, kKvHiddenSize}, value);
+    tester.AddInput<float>("key_cache", cache_dims, key_cache);
+    tester.AddInput<float>("value_cache", cache_dims, value_cache);
+  }
+  tester.AddInput<int32_t>("cumulative_sequence_length", {3}, cumulative_seqlens);
+  tester.AddInput<int32_t>("past_seqlens", {2}, past_seqlens);
+  tester.AddInput<int32_t>("block_table", {2, kMaxBlocksPerSeq}, block_table);
+
+  if (use_float16) {
+    tester.AddOutput<MLFloat16>("output", {token_count, kHiddenSize}, ToFloat16(output));
+    tester.SetOutputTolerance(0.005f);
+  } else {
+    tester.AddOutput<float>("output", {token_count, kHiddenSize}, output);
+    tester.SetOutputTolerance(0.0001f);
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+
+TEST(PagedAttentionTest, Cpu) {
+  RunPagedAttentionTest(-1, false);
+}
+
+TEST(PagedAttentionTest, CpuLocalWindow) {
+  RunPagedAttentionTest(1, false);
+}
+
+TEST(PagedAttentionTest, CpuFloat16) {
+  RunPagedAttentionTest(-1, true);
+}
+
+TEST(PagedAttentionTest, CpuInvalidBlockTable) {
+  OpTester tester("PagedAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", kNumHeads);
+  tester.AddAttribute<int64_t>("kv_num_heads", kKvNumHeads);
+
+  const std::vector<int64_t> cache_dims{kNumBlocks, kBlockSize, kKvNumHeads, kHeadSize};
+  tester.AddInput<float>("query", {1, kHiddenSize}, MakeData(kHiddenSize, 0.1f));
+  tester.AddInput<float>("key", {1, kKvHiddenSize}, MakeData(kKvHiddenSize, 0.7f));
+  tester.AddInput<float>("value", {1, kKvHiddenSize}, MakeData(kKvHiddenSize, 1.3f));
+  tester.AddInput<float>("key_cache", cache_dims, MakeData(kNumBlocks * kBlockSize * kKvHiddenSize, 1.9f));
+  tester.AddInput<float>("value_cache", cache_dims, MakeData(kNumBlocks * kBlockSize * kKvHiddenSize, 2.5f));
+  tester.AddInput<int32_t>("cumulative_sequence_length", {2}, {0, 1});
+  tester.AddInput<int32_t>("past_seqlens", {1}, {2});
+  // the new token is the first one of the second block, which is not in the cache
+  tester.AddInput<int32_t>("block_table", {1, kMaxBlocksPerSeq}, {0, kNumBlocks, 1});
+  tester.AddOutput<float>("output", {1, kHiddenSize}, std::vector<float>(kHiddenSize));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectFailure, "which is not a block of the KV cache", {}, nullptr,
+             &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+template <typename T>
+void RunQLinearLayerNormalization(const std::vector<int64_t>& x_shape, bool has_bias) {
+  const int64_t N = x_shape.back();
+  const int64_t M = std::accumulate(x_shape.begin(), x_shape.end() - 1, int64_t{1}, std::multiplies<int64_t>());
+
+  constexpr float x_scale = 0.05f;
+  const T x_zero_point = std::is_signed_v<T> ? T(0) : T(128);
+  constexpr float scale_scale = 0.01f;
+  const T scale_zero_point = std::is_signed_v<T> ? T(0) : T(128);
+  constexpr float bias_scale = 0.0005f;
+  constexpr float y_scale = 0.02f;
+  const T y_zero_point = std::is_signed_v<T> ? T(0) : T(128);
+  constexpr float epsilon = 1e-5f;
+
+  std::vector<T> x(static_cast<size_t>(M * N));
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<T>(static_cast<int>(x_zero_point) + static_cast<int>(i * 37 % 97) - 48);
+  }
+  std::vector<T> scale(static_cast<size_t>(N));
+  std::vector<int32_t> bias(static_cast<size_t>(N));
+  for (size_t i = 0; i < scale.size(); i++) {
+    scale[i] = static_cast<T>(static_cast<int>(scale_zero_point) + 50 + static_cast<int>(i * 11 % 60));
+    bias[i] = static_cast<int32_t>(i * 173 % 2001) - 1000;
+  }
+
+  // reference in double precision
+  std::vector<T> y(x.size());
+  for (int64_t m = 0; m < M; m++) {
+    std::vector<double> row(static_cast<size_t>(N));
+    double mean = 0.0;
+    for (int64_t n = 0; n < N; n++) {
+      row[n] = (static_cast<double>(x[m * N + n]) - x_zero_point) * x_scale;
+      mean += row[n];
+    }
+    mean /= N;
+    double variance = 0.0;
+    for (int64_t n = 0; n < N; n++) {
+      variance += (row[n] - mean) * (row[n] - mean);
+    }
+    const double inv_std_dev = 1.0 / std::sqrt(variance / N + epsilon);
+    for (int64_t n = 0; n < N; n++) {
+      double value = (row[n] - mean) * inv_std_dev * (static_cast<double>(scale[n]) - scale_zero_point) * scale_scale;
+      if (has_bias) {
+        value += bias[n] * static_cast<double>(bias_scale);
+      }
+      const double q = std::nearbyint(value / y_scale) + y_zero_point;
+      y[m * N + n] = static_cast<T>(std::clamp(q, static_cast<double>(std::numeric_limits<T>::min()),
+                                               static_cast<double>(std::numeric_limits<T>::max())));
+    }
+  }
+
+  OpTester test("QLinearLayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("axis", -1);
+  test.AddAttribute<float>("epsilon", epsilon);
+  test.AddInput<T>("X", x_shape, x);
+  test.AddInput<float>("X_scale", {}, {x_scale}, true);
+  test.AddInput<T>("X_zero_point", {}, {x_zero_point}, true);
+  test.AddInput<T>("Scale", {N}, scale, true);
+  test.AddInput<float>("Scale_scale", {}, {scale_scale}, true);
+  test.AddInput<T>("Scale_zero_point", {}, {scale_zero_point}, true);
+  test.AddInput<float>("Y_scale", {}, {y_scale}, true);
+  test.AddInput<T>("Y_zero_point", {}, {y_zero_point}, true);
+  if (has_bias) {
+    test.AddInput<int32_t>("B", {N}, bias, true);
+    test.AddInput<float>("B_scale", {}, {bias_scale}, true);
+  }
+  test.AddOutput<T>("Y", x_shape, y);
+  // the fp32 kernel may round to the adjacent quantized value
+  test.SetOutputAbsErr("Y", 1.0f);
+  test.Run();
+}
+
+TEST(QLinearLayerNormalizationTest, Int8) {
+  RunQLinearLayerNormalization<int8_t>({2, 3, 32}, true);
+  RunQLinearLayerNormalization<int8_t>({5, 7}, false);
+}
+
+TEST(QLinearLayerNormalizationTest, UInt8) {
+  RunQLinearLayerNormalization<uint8_t>({2, 3, 32}, true);
+  RunQLinearLayerNormalization<uint8_t>({1, 768}, false);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -864,5 +864,52 @@ TEST(ContribOpTest, Tokenizer_EmptyInput) {
     test.Run(OpTester::ExpectResult::kExpectSuccess);
   }
 }
+TEST(ContribOpTest, TokenizerWithSeparators_RaggedWithMarkersNC) {
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, true, {" "}, 1);
+  test.AddAttribute("ragged", int64_t{1});
+
+  std::vector<int64_t> dims{2, 2};
+  std::vector<std::string> input{"Hello World", "", "I love computer science", "!"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<std::string> output{start_mark, "Hello", "World", end_mark,
+                                  start_mark, end_mark,
+                                  start_mark, "I", "love", "computer", "science", end_mark,
+                                  start_mark, "!", end_mark};
+  test.AddOutput<std::string>("Y", {static_cast<int64_t>(output.size())}, output);
+  test.AddOutput<int64_t>("row_splits", {5}, {0, 4, 6, 12, 15});
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
+TEST(ContribOpTest, TokenizerWithSeparators_RowSplitsPaddedC) {
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, {", ", ";"}, 1);
+
+  std::vector<int64_t> dims{3};
+  std::vector<std::string> input{"a, b;c", "", "d"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<std::string> output{"a", "b", "c",
+                                  padval, padval, padval,
+                                  "d", padval, padval};
+  test.AddOutput<std::string>("Y", {3, 3}, output);
+  test.AddOutput<int64_t>("row_splits", {4}, {0, 3, 3, 4});
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
+TEST(ContribOpTest, TokenizerCharLevel_RaggedEmptyOutputC) {
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, true, {""}, 1);
+  test.AddAttribute("ragged", int64_t{1});
+
+  std::vector<int64_t> dims{2};
+  std::vector<std::string> input{"", ""};
+  test.AddInput<std::string>("T", dims, input);
+
+  test.AddOutput<std::string>("Y", {0}, std::vector<std::string>{});
+  test.AddOutput<int64_t>("row_splits", {3}, {0, 0, 0});
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstdio>
+#include <fstream>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -580,6 +582,78 @@ TEST_F(PlannerTest, ExternalOutputsNoReuseTest) {
   CheckFreed(3, {X4});
 }
 
+TEST_F(PlannerTest, ConcatInputSlicesTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6"), concat("concat");
+
+  // graph structure:
+  AddNormalNode(X1, X2);  // normal operator; X1: input; X2: Concat input
+  AddNormalNode(X1, X3);  // normal operator; X3: Concat input
+  std::unique_ptr<::onnxruntime::KernelDef> concat_kernel =
+      KernelDefBuilder().SetName("Concat").Provider(kCpuExecutionProvider).SinceVersion(4, 10).Build();
+  std::vector<onnxruntime::NodeArg*> concat_inputs{Arg(X2), Arg(X3)}, concat_outputs{Arg(X4)};
+  AddNode(*concat_kernel, concat, concat_inputs, concat_outputs)->AddAttribute("axis", int64_t{0});
+  AddNormalNode(X4, X5);  // normal operator; X5: temporary
+  AddNormalNode(X5, X6);  // normal operator; X6: output
+
+  // simulate shape-inference results:
+  Shape input_shape{2, 3};
+  Shape output_shape{4, 3};
+  SetShape({{X1, &input_shape.value}, {X2, &input_shape.value}, {X3, &input_shape.value},
+            {X4, &output_shape.value}, {X5, &output_shape.value}, {X6, &output_shape.value}});
+
+  CreatePlan();
+
+  // X2 and X3 are written into X4, so Concat doesn't copy them
+  CheckAllocKind(X2, AllocKind::kReuse);
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckAllocKind(X5, AllocKind::kAllocate);
+
+  int x2_index, x3_index, x4_index;
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X2, x2_index));
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X3, x3_index));
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X4, x4_index));
+  const auto& x2_plan = GetPlan().allocation_plan[x2_index];
+  const auto& x3_plan = GetPlan().allocation_plan[x3_index];
+  EXPECT_EQ(x2_plan.reused_buffer, x4_index);
+  EXPECT_TRUE(x2_plan.is_slice_of_reused_buffer);
+  EXPECT_EQ(x2_plan.reused_buffer_offset, 0u);
+  EXPECT_EQ(x3_plan.reused_buffer, x4_index);
+  EXPECT_TRUE(x3_plan.is_slice_of_reused_buffer);
+  EXPECT_EQ(x3_plan.reused_buffer_offset, 6 * sizeof(float));
+
+  // X4 is freed by its last consumer
+  CheckFreed(3, {X4});
+}
+
+TEST_F(PlannerTest, ConcatInputSlicesNotContiguousTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), concat("concat");
+
+  // graph structure:
+  AddNormalNode(X1, X2);
+  AddNormalNode(X1, X3);
+  std::unique_ptr<::onnxruntime::KernelDef> concat_kernel =
+      KernelDefBuilder().SetName("Concat").Provider(kCpuExecutionProvider).SinceVersion(4, 10).Build();
+  std::vector<onnxruntime::NodeArg*> concat_inputs{Arg(X2), Arg(X3)}, concat_outputs{Arg(X4)};
+  AddNode(*concat_kernel, concat, concat_inputs, concat_outputs)->AddAttribute("axis", int64_t{1});
+  AddNormalNode(X4, X5);
+
+  // simulate shape-inference results:
+  Shape input_shape{2, 3};
+  Shape output_shape{2, 6};
+  SetShape({{X1, &input_shape.value}, {X2, &input_shape.value}, {X3, &input_shape.value},
+            {X4, &output_shape.value}, {X5, &output_shape.value}});
+
+  CreatePlan();
+
+  // the inputs are interleaved in the output, so they get their own buffers
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+}
+
 #ifdef ENABLE_STRIDED_TENSORS
 TEST_F(PlannerTest, MayStridedTest1) {
   // tensor variables:
@@ -718,6 +792,37 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// InPlaceSymbolicSizeTest: Check that in-place and disjoint lifetime reuse are allowed when the shapes differ but
+// have the same number of elements for every value of the symbolic dimensions.
+TEST_F(PlannerTest, InPlaceSymbolicSizeTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);   // no in-place operator; X1: input; X2: temporary
+  AddInplaceNode(X2, X3);  // may-in-place operator; X3: temporary (reuse X2)
+  AddNormalNode(X3, X4);   // no in-place operator; X4: temporary
+  AddInplaceNode(X4, X5);  // may-in-place operator; X5 output
+
+  // simulate shape-inference results:
+  Shape shape1w{"M", "N"};
+  auto shape1 = &shape1w.value;
+  Shape shape2w{"N", "M"};
+  auto shape2 = &shape2w.value;
+  Shape shape3w{"M", "K"};
+  auto shape3 = &shape3w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape2}, {X4, shape3}, {X5, shape3}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -2003,6 +2108,46 @@ TEST_F(PlannerTest, TestMultiStreamMismatchDevice) {
   status = sess.Initialize();
   ASSERT_TRUE(!status.IsOK());
 }
+
+// Two independent chains of CPU nodes are placed on the two streams of a CriticalPathPartitioner config.
+TEST_F(PlannerTest, TestCriticalPathPartitionerIndependentChains) {
+  const char* config_file_path = "./critical_path_partitioner_test.json";
+  {
+    std::ofstream of_stream(config_file_path);
+    ASSERT_TRUE(of_stream.is_open());
+    of_stream << R"({"type":"CriticalPathPartitioner","num_streams":2})";
+  }
+  auto remove_config_file = gsl::finally([config_file_path]() { std::remove(config_file_path); });
+
+  auto partitioner = IGraphPartitioner::CreateGraphPartitioner(DefaultLoggingManager().DefaultLogger(),
+                                                               ORT_TSTR("./critical_path_partitioner_test.json"));
+  ASSERT_STREQ(partitioner->Type(), "CriticalPathPartitioner");
+  ASSERT_EQ(partitioner->Streams(), 2u);
+
+  ONNX_NAMESPACE::TensorProto tensor;
+  tensor.add_dims(1);
+  tensor.add_float_data(1.0f);
+  tensor.set_data_type(TensorProto_DataType_FLOAT);
+  tensor.set_name("Graph_input");
+  GetGraph().AddInitializedTensor(tensor);
+
+  std::string Graph_input("Graph_input"), A1("A1"), A2("A2"), B1("B1"), B2("B2");
+  AddNormalNode(Graph_input, A1);
+  AddNormalNode(A1, A2);
+  AddNormalNode(Graph_input, B1);
+  AddNormalNode(B1, B2);
+
+  SetNodePartitionConfigFilePath(config_file_path);
+  CreatePlan({}, false);
+
+  const auto& execution_plan = GetState().GetExecutionPlan()->execution_plan;
+  ASSERT_EQ(execution_plan.size(), 2u) << "one logic stream for each chain";
+  for (const auto& logic_stream : execution_plan) {
+    ASSERT_EQ(logic_stream->steps_.size(), 2u) << "the chains don't wait for each other";
+    EXPECT_NE(strstr(typeid(*logic_stream->steps_[0]).name(), "LaunchKernelStep"), nullptr);
+    EXPECT_NE(strstr(typeid(*logic_stream->steps_[1]).name(), "LaunchKernelStep"), nullptr);
+  }
+}
 #endif
 
 #if defined(USE_CUDA) && defined(ORT_ENABLE_STREAM)
@@ -4,9 +4,13 @@
 #include <absl/base/config.h>
 #include "core/framework/bfc_arena.h"
 #include "core/framework/allocator_utils.h"
+#include "core/framework/huge_page_allocator.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <algorithm>
 #include <cstdlib>
+#include <limits>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -307,6 +311,134 @@ TEST(BFCArenaTest, TestShrink) {
   EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024) << "Expect 10M bytes but actually " << stats.total_allocated_bytes << " bytes";
 }
 
+TEST(BFCArenaTest, TestTrim) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+  void* p1M = a.Alloc(1024 * 1024);
+  void* p2M = a.Alloc(2 * 1024 * 1024);
+  void* p4M = a.Alloc(4 * 1024 * 1024);
+  const size_t no_budget = std::numeric_limits<size_t>::max();
+
+  // a region is freed once it has been idle for more than min_idle_passes passes
+  a.Free(p1M);
+  EXPECT_EQ(a.Trim(1, no_budget), 0u) << "p1M was freed during the first pass";
+  EXPECT_EQ(a.Trim(1, no_budget), 1024u * 1024u);
+
+  // above the budget, the idle regions are freed even if they haven't been idle for long
+  a.Free(p2M);
+  EXPECT_EQ(a.Trim(1, 4 * 1024 * 1024), 2u * 1024u * 1024u);
+
+  a.Free(p4M);
+  EXPECT_EQ(a.Trim(1, 4 * 1024 * 1024), 0u) << "the arena is within its budget";
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_shrinkages, 2);
+  EXPECT_EQ(stats.total_allocated_bytes, 4 * 1024 * 1024);
+}
+
+TEST(BFCArenaTest, TestReserveRegion) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30);
+  const size_t peak_size = 3 * 1024 * 1024 + 100;
+  ASSERT_EQ(a.ReserveRegion(peak_size), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 1);
+  EXPECT_EQ(stats.total_allocated_bytes, 3 * 1024 * 1024 + 256) << "the region is not rounded up to a power of two";
+
+  // the reserved region holds the allocation without extending the arena
+  void* p = a.Alloc(peak_size);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 1);
+  EXPECT_EQ(a.AllocatedSize(p), 3u * 1024u * 1024u + 256u);
+  a.Free(p);
+
+  EXPECT_FALSE(a.ReserveRegion(size_t{1} << 31).IsOK()) << "the region exceeds the memory limit";
+}
+
+TEST(BFCArenaTest, TestThreadCache) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             1 << 20);
+
+  // small allocations are rounded up to their size class so a freed chunk can serve any request of that class
+  void* p1 = a.Alloc(1000);
+  EXPECT_EQ(a.RequestedSize(p1), 1024u);
+  a.Free(p1);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.thread_cache_bytes, 1024);
+  EXPECT_EQ(stats.bytes_in_use, 1024) << "cached chunks are still in use from the arena's point of view";
+
+  void* p2 = a.Alloc(800);
+  EXPECT_EQ(p1, p2);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.thread_cache_bytes, 0);
+
+  // large allocations bypass the cache
+  void* p_large = a.Alloc(1 << 20);
+  a.Free(p_large);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.thread_cache_bytes, 0);
+
+  a.Free(p2);
+  a.FlushThreadCache();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.thread_cache_bytes, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+
+  // Shrink() must see the cached chunks as free
+  void* p3 = a.Alloc(512);
+  a.Free(p3);
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 0);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+}
+
+TEST(BFCArenaTest, TestThreadCacheConcurrentAllocations) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kNextPowerOfTwo,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             64 * 1024);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&a, t]() {
+      std::vector<void*> ptrs;
+      for (int i = 0; i < 1000; ++i) {
+        const size_t size = static_cast<size_t>(((i + t) % 64 + 1) * 128);
+        void* p = a.Alloc(size);
+        memset(p, t, size);
+        ptrs.push_back(p);
+        if (ptrs.size() == 16) {
+          for (void* q : ptrs) {
+            a.Free(q);
+          }
+          ptrs.clear();
+        }
+      }
+      for (void* q : ptrs) {
+        a.Free(q);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 8000);
+  EXPECT_GT(stats.num_thread_cache_hits, 0);
+  EXPECT_EQ(stats.bytes_in_use, stats.thread_cache_bytes);
+
+  a.FlushThreadCache();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
@@ -481,5 +613,56 @@ TEST(BFCArenaTest, TestExtendStrategy) {
   ASSERT_EQ(extend_delta_bytes, extend_limit);
 }
 
+TEST(BFCArenaTest, TestHugePageAllocator) {
+  // huge pages may not be available on the test machine, so only check that the allocations are usable
+  HugePageAllocator allocator(std::make_unique<CPUAllocator>(), size_t{1} << 30);
+  const size_t large_size = 5 * HugePageAllocator::kTransparentHugePageSize / 2;
+  auto* large = static_cast<uint8_t*>(allocator.Alloc(large_size));
+  ASSERT_NE(large, nullptr);
+  std::fill_n(large, large_size, uint8_t{1});
+  // the allocation is rounded up to a number of huge pages if it is backed by them
+  EXPECT_TRUE(allocator.HugePageBytes() == 0 ||
+              allocator.HugePageBytes() == 3 * HugePageAllocator::kTransparentHugePageSize);
+
+  // smaller allocations than a huge page use regular pages
+  const size_t huge_page_bytes = allocator.HugePageBytes();
+  void* small = allocator.Alloc(4096);
+  ASSERT_NE(small, nullptr);
+  EXPECT_EQ(allocator.HugePageBytes(), huge_page_bytes);
+
+  allocator.Free(small);
+  allocator.Free(large);
+  EXPECT_EQ(allocator.HugePageBytes(), 0u);
+}
+
+TEST(BFCArenaTest, TestHugePagesConfig) {
+  OrtArenaCfg config;
+  config.arena_extend_strategy = static_cast<int>(ArenaExtendStrategy::kSameAsRequested);
+  config.huge_pages = OrtArenaCfg::HugePages::k2MB;
+  AllocatorCreationInfo device_info{
+      [](OrtDevice::DeviceId) { return std::make_unique<CPUAllocator>(); },
+      0, true, config};
+  auto allocator = CreateAllocator(device_info);
+  ASSERT_NE(allocator, nullptr);
+
+  const size_t size = 8 << 20;
+  auto* p = static_cast<uint8_t*>(allocator->Alloc(size));
+  ASSERT_NE(p, nullptr);
+  std::fill_n(p, size, uint8_t{1});
+  allocator->Free(p);
+
+  AllocatorStats stats;
+  allocator->GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 1);
+
+  OrtKeyValuePairs kvps;
+  kvps.Add(OrtArenaCfg::ConfigKeyNames::HugePages, "1");
+  OrtArenaCfg parsed;
+  ASSERT_TRUE(OrtArenaCfg::FromKeyValuePairs(kvps, parsed).IsOK());
+  EXPECT_EQ(parsed.huge_pages, OrtArenaCfg::HugePages::kTransparent);
+  kvps.Add(OrtArenaCfg::ConfigKeyNames::HugePages, "4");
+  EXPECT_FALSE(OrtArenaCfg::FromKeyValuePairs(kvps, parsed).IsOK());
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,134 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/graph_capture_shape_buckets.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/framework/allocator.h"
+#include "core/framework/data_transfer.h"
+#include "core/framework/tensor.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+#include "test/framework/test_utils.h"
+#include "test/util/include/asserts.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// A run of the fake session: the graph annotation id and the input it saw.
+struct RecordedRun {
+  std::string graph_annotation_id;
+  const void* feed_data;
+  std::vector<int64_t> feed_dims;
+  std::vector<float> feed_values;
+};
+
+// Emulates a session that computes Y = X + 1 on [1, seq] inputs. Like a replayed graph, it writes into the fetches
+// left by the previous run if there are any.
+GraphCaptureShapeBuckets::RunFn CreateAddOneRunFn(std::vector<RecordedRun>& runs) {
+  return [&runs](const RunOptions& run_options, gsl::span<const std::string>, gsl::span<const OrtValue> feeds,
+                 gsl::span<const std::string>, std::vector<OrtValue>* fetches,
+                 const std::vector<OrtDevice>*) -> Status {
+    const Tensor& input = feeds[0].Get<Tensor>();
+    const auto dims = input.Shape().GetDims();
+    const auto values = input.DataAsSpan<float>();
+    runs.push_back({run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigCudaGraphAnnotation, ""),
+                    input.DataRaw(), std::vector<int64_t>(dims.begin(), dims.end()),
+                    std::vector<float>(values.begin(), values.end())});
+
+    if (fetches->empty()) {
+      fetches->resize(1);
+      Tensor::InitOrtValue(input.DataType(), input.Shape(), CPUAllocator::DefaultInstance(), (*fetches)[0]);
+    }
+    auto* output_data = (*fetches)[0].GetMutable<Tensor>()->MutableData<float>();
+    for (size_t i = 0; i < values.size(); ++i) {
+      output_data[i] = values[i] + 1.f;
+    }
+    return Status::OK();
+  };
+}
+
+struct ShapeBucketsTester {
+  explicit ShapeBucketsTester(const std::string& config_value) {
+    GraphCaptureShapeBuckets::Config config;
+    ORT_THROW_IF_ERROR(GraphCaptureShapeBuckets::ParseConfig(config_value, config));
+    ORT_THROW_IF_ERROR(data_transfer.RegisterDataTransfer(std::make_unique<CPUDataTransfer>()));
+    buckets = std::make_unique<GraphCaptureShapeBuckets>(
+        std::move(config), InlinedHashMap<std::string, size_t>{{"X", 1}}, InlinedHashMap<std::string, size_t>{{"Y", 1}},
+        OrtDevice(), [](const OrtDevice&) { return CPUAllocator::DefaultInstance(); }, data_transfer,
+        CreateAddOneRunFn(runs));
+  }
+
+  std::vector<float> Run(const std::vector<float>& x) {
+    OrtValue feed;
+    CreateMLValue<float>(CPUAllocator::DefaultInstance(), {1, static_cast<int64_t>(x.size())}, x, &feed);
+    const std::vector<std::string> feed_names{"X"};
+    const std::vector<std::string> output_names{"Y"};
+    std::vector<OrtValue> fetches;
+    ORT_THROW_IF_ERROR(buckets->Run(RunOptions{}, feed_names, {&feed, 1}, output_names, &fetches, nullptr));
+
+    const Tensor& output = fetches[0].Get<Tensor>();
+    EXPECT_EQ(output.Shape(), TensorShape({1, static_cast<int64_t>(x.size())}));
+    const auto values = output.DataAsSpan<float>();
+    return std::vector<float>(values.begin(), values.end());
+  }
+
+  DataTransferManager data_transfer;
+  std::vector<RecordedRun> runs;
+  std::unique_ptr<GraphCaptureShapeBuckets> buckets;
+};
+
+}  // namespace
+
+TEST(GraphCaptureShapeBucketsTest, PadsToBucketAndSlicesOutputs) {
+  ShapeBucketsTester tester{"seq:4,8"};
+
+  EXPECT_EQ(tester.Run({1.f, 2.f, 3.f}), std::vector<float>({2.f, 3.f, 4.f}));
+  // the padding left by the longer input is zeroed again.
+  EXPECT_EQ(tester.Run({5.f, 6.f}), std::vector<float>({6.f, 7.f}));
+  EXPECT_EQ(tester.Run({1.f, 1.f, 1.f, 1.f, 1.f}), std::vector<float>({2.f, 2.f, 2.f, 2.f, 2.f}));
+
+  ASSERT_EQ(tester.runs.size(), 3u);
+  EXPECT_EQ(tester.runs[0].graph_annotation_id, "1");
+  EXPECT_EQ(tester.runs[0].feed_dims, std::vector<int64_t>({1, 4}));
+  EXPECT_EQ(tester.runs[0].feed_values, std::vector<float>({1.f, 2.f, 3.f, 0.f}));
+
+  // the runs of a bucket share its graph and its input buffer.
+  EXPECT_EQ(tester.runs[1].graph_annotation_id, "1");
+  EXPECT_EQ(tester.runs[1].feed_data, tester.runs[0].feed_data);
+  EXPECT_EQ(tester.runs[1].feed_values, std::vector<float>({5.f, 6.f, 0.f, 0.f}));
+
+  EXPECT_EQ(tester.runs[2].graph_annotation_id, "2");
+  EXPECT_EQ(tester.runs[2].feed_dims, std::vector<int64_t>({1, 8}));
+}
+
+TEST(GraphCaptureShapeBucketsTest, RunsLargerInputsWithoutCapture) {
+  ShapeBucketsTester tester{"seq:2,4"};
+
+  EXPECT_EQ(tester.Run({1.f, 2.f, 3.f, 4.f, 5.f}), std::vector<float>({2.f, 3.f, 4.f, 5.f, 6.f}));
+
+  ASSERT_EQ(tester.runs.size(), 1u);
+  EXPECT_EQ(tester.runs[0].graph_annotation_id, "-1");
+  EXPECT_EQ(tester.runs[0].feed_dims, std::vector<int64_t>({1, 5}));
+}
+
+TEST(GraphCaptureShapeBucketsTest, ParseConfig) {
+  GraphCaptureShapeBuckets::Config config;
+  ASSERT_STATUS_OK(GraphCaptureShapeBuckets::ParseConfig("sequence_length:16,32,64", config));
+  EXPECT_EQ(config.dim_param, "sequence_length");
+  EXPECT_EQ(std::vector<int64_t>(config.bucket_sizes.begin(), config.bucket_sizes.end()),
+            std::vector<int64_t>({16, 32, 64}));
+
+  ASSERT_STATUS_NOT_OK(GraphCaptureShapeBuckets::ParseConfig("16,32", config));
+  ASSERT_STATUS_NOT_OK(GraphCaptureShapeBuckets::ParseConfig("seq:", config));
+  ASSERT_STATUS_NOT_OK(GraphCaptureShapeBuckets::ParseConfig("seq:32,16", config));
+  ASSERT_STATUS_NOT_OK(GraphCaptureShapeBuckets::ParseConfig("seq:0", config));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -9,6 +9,7 @@
 #include <functional>
 #include <future>
 #include <iterator>
+#include <numeric>
 #include <thread>
 #include <fstream>
 #include <random>
@@ -23,6 +24,7 @@
 #include "core/framework/execution_provider.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/run_deadline.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/bfc_arena.h"
@@ -47,6 +49,7 @@
 #include "core/session/allocator_adapters.h"
 #include "core/session/environment.h"
 #include "core/session/IOBinding.h"
+#include "core/session/prepared_run.h"
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
@@ -58,6 +61,7 @@
 #include "test/optimizer/dummy_graph_transformer.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/inference_session_wrapper.h"
+#include "test/util/include/temp_dir.h"
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -564,6 +568,55 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  // the cache directory is relative to the model, so the model is copied to a temporary directory
+  TemporaryDirectory tmp_dir(ORT_TSTR("optimized_model_cache_test"));
+  const std::filesystem::path model_path = std::filesystem::path(tmp_dir.Path()) / ORT_TSTR("abs-id-max.onnx");
+  std::filesystem::copy_file("testdata/transform/abs-id-max.onnx", model_path);
+  const auto cache_dir = std::filesystem::path(tmp_dir.Path()) / ORT_TSTR("cache");
+
+  auto count_cache_entries = [&cache_dir]() {
+    std::error_code ec;
+    return std::distance(std::filesystem::directory_iterator(cache_dir, ec), std::filesystem::directory_iterator());
+  };
+
+  auto create_session = [&](TransformerLevel level) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.OptimizedModelCache";
+    so.graph_optimization_level = level;
+    EXPECT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsOptimizedModelCacheDir, "cache"));
+    auto session_object = std::make_unique<InferenceSessionWrapper>(so, GetEnvironment());
+    EXPECT_STATUS_OK(session_object->Load(model_path.native()));
+    EXPECT_STATUS_OK(session_object->Initialize());
+    return session_object;
+  };
+
+  // the first session writes the optimized model
+  {
+    auto session_object = create_session(TransformerLevel::Level1);
+    EXPECT_EQ(CountOpsInGraph(session_object->GetGraph())["Identity"], 0);
+  }
+  ASSERT_EQ(count_cache_entries(), 1);
+  const auto entry_path = std::filesystem::directory_iterator(cache_dir)->path();
+  EXPECT_EQ(entry_path.extension(), ORT_TSTR(".ort"));
+  const auto entry_write_time = std::filesystem::last_write_time(entry_path);
+
+  // the second loads it
+  {
+    auto session_object = create_session(TransformerLevel::Level1);
+    EXPECT_EQ(CountOpsInGraph(session_object->GetGraph())["Identity"], 0);
+  }
+  EXPECT_EQ(count_cache_entries(), 1);
+  EXPECT_EQ(std::filesystem::last_write_time(entry_path), entry_write_time);
+
+  // sessions with other options don't use it
+  {
+    auto session_object = create_session(TransformerLevel::Default);
+    EXPECT_GT(CountOpsInGraph(session_object->GetGraph())["Identity"], 0);
+  }
+  EXPECT_EQ(count_cache_entries(), 2);
+}
+
 TEST(InferenceSessionTests, RequestLoadCancellation) {
   {
     // Explicit cancel during load, small model is fine
@@ -876,8 +929,336 @@ TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
     count++;
   }
 }
+
+TEST(InferenceSessionTests, CheckRunProfilerWithSampleInterval) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_sample_interval_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsProfilingSampleInterval, "3"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  for (int i = 0; i < 7; ++i) {
+    RunModel(session_object, run_options);
+  }
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  int kernel_events = 0;
+  int run_events = 0;
+  while (std::getline(profile, line)) {
+    kernel_events += line.find("mul_1_kernel_time") != std::string::npos;
+    run_events += line.find("model_run") != std::string::npos;
+  }
+
+  // executions 0, 3 and 6 are sampled, the session level events are recorded for every run
+  EXPECT_EQ(kernel_events, 3);
+  EXPECT_EQ(run_events, 7);
+}
 #endif  // __wasm__
 
+TEST(InferenceSessionTests, CheckRunProfilerNodeStats) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfilerNodeStats";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsProfilingNodeStats, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  EXPECT_TRUE(session_object.GetProfiling().GetNodeStats().empty());
+
+  RunOptions run_options;
+  for (int i = 0; i < 5; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  // the stats are collected without enabling profiling
+  EXPECT_FALSE(session_object.GetProfiling().IsEnabled());
+  const auto node_stats = session_object.GetProfiling().GetNodeStats();
+  ASSERT_EQ(node_stats.size(), 1u);
+  const auto& stats = node_stats[0];
+  EXPECT_EQ(stats.name, "mul_1");
+  EXPECT_EQ(stats.count, 5u);
+  EXPECT_LE(stats.min_us, stats.p50_us);
+  EXPECT_LE(stats.p50_us, stats.p99_us);
+  EXPECT_LE(stats.p99_us, stats.max_us);
+  EXPECT_NEAR(stats.mean_us * 5, stats.total_us, 1e-6);
+}
+
+TEST(InferenceSessionTests, TracingSpans) {
+  struct TracedSpan {
+    std::string name;
+    std::string run_tag;
+    uint64_t span_id;
+    uint64_t parent_span_id;
+    int64_t start_time_ns;
+    int64_t end_time_ns;
+  };
+  std::vector<TracedSpan> spans;
+  OrtTracingSpanFn tracing_fn = [](void* user_data, const char* name, const char* /*detail*/, const char* run_tag,
+                                   uint64_t span_id, uint64_t parent_span_id, int64_t start_time_ns,
+                                   int64_t end_time_ns) {
+    static_cast<std::vector<TracedSpan>*>(user_data)->push_back(
+        {name, run_tag, span_id, parent_span_id, start_time_ns, end_time_ns});
+  };
+
+  SessionOptions so;
+  so.session_logid = "TracingSpans";
+  so.tracing_span_fn = tracing_fn;
+  so.tracing_user_data = &spans;
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "request-42";
+  RunModel(session_object, run_options);
+
+  // the spans are emitted as they end, so the children come first
+  ASSERT_EQ(spans.size(), 3u);
+  const TracedSpan& node_group = spans[0];
+  const TracedSpan& graph = spans[1];
+  const TracedSpan& run = spans[2];
+  EXPECT_EQ(node_group.name, "NodeGroup");
+  EXPECT_EQ(graph.name, "ExecuteGraph");
+  EXPECT_EQ(run.name, "Run");
+  EXPECT_EQ(run.parent_span_id, 0u);
+  EXPECT_EQ(graph.parent_span_id, run.span_id);
+  EXPECT_EQ(node_group.parent_span_id, graph.span_id);
+  for (const auto& span : spans) {
+    EXPECT_EQ(span.run_tag, "request-42");
+    EXPECT_NE(span.span_id, 0u);
+    EXPECT_LE(run.start_time_ns, span.start_time_ns);
+    EXPECT_LE(span.start_time_ns, span.end_time_ns);
+    EXPECT_LE(span.end_time_ns, run.end_time_ns);
+  }
+}
+
+TEST(InferenceSessionTests, CollectNodeMemoryStats) {
+  SessionOptions so;
+
+  so.session_logid = "CollectNodeMemoryStats";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCollectNodeMemoryStats, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  std::vector<NodeMemoryStats> node_memory_stats;
+  ASSERT_STATUS_OK(session_object.GetNodeMemoryStats(node_memory_stats));
+  ASSERT_EQ(node_memory_stats.size(), 1u);
+  const auto& stats = node_memory_stats[0];
+  EXPECT_EQ(stats.node_name.rfind("mul_1_", 0), 0u);
+  // the graph output is allocated while the node runs, in the CPU arena
+  EXPECT_EQ(stats.dynamic_output_bytes, static_cast<int64_t>(6 * sizeof(float)));
+  EXPECT_GE(stats.peak_bytes_in_use, stats.dynamic_output_bytes);
+  EXPECT_GE(stats.max_peak_bytes_in_use, stats.peak_bytes_in_use);
+
+  InferenceSession session_without_stats(SessionOptions{}, GetEnvironment());
+  ASSERT_STATUS_OK(session_without_stats.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_without_stats.Initialize());
+  ASSERT_FALSE(session_without_stats.GetNodeMemoryStats(node_memory_stats).IsOK());
+}
+
+TEST(InferenceSessionTests, WarmUp) {
+  SessionOptions so;
+  so.session_logid = "WarmUp";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsWarmUpRuns, "2"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsWarmUpDims, "unused:4"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  EXPECT_FALSE(session_object.WarmUp({}, 1).IsOK());
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+
+  // the warm-up doesn't leave a state behind
+  SessionOptions so_with_state;
+  ASSERT_STATUS_OK(so_with_state.config_options.AddConfigEntry(kOrtSessionOptionsStatefulTensors, "Y:X"));
+  InferenceSession session_with_state(so_with_state, GetEnvironment());
+  ASSERT_STATUS_OK(session_with_state.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_with_state.Initialize());
+  ASSERT_STATUS_OK(session_with_state.WarmUp({}, 3));
+  OrtValue state;
+  ASSERT_STATUS_OK(session_with_state.GetStatefulTensor("X", state));
+  EXPECT_FALSE(state.IsAllocated());
+}
+
+TEST(InferenceSessionTests, LeanExecution) {
+  RunOptions run_options;
+
+  // the model is a single sequence of CPU kernels, run by the lean execution loop
+  InferenceSessionWrapper session_object{SessionOptions{}, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_NE(session_object.GetSessionState().GetLeanExecutionOrder(), nullptr);
+  EXPECT_EQ(session_object.GetSessionState().GetLeanExecutionOrder()->size(), 1u);
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsDisableLeanExecution, "1"));
+  InferenceSessionWrapper session_without_lean_execution{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_without_lean_execution.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_without_lean_execution.Initialize());
+  EXPECT_EQ(session_without_lean_execution.GetSessionState().GetLeanExecutionOrder(), nullptr);
+  RunModel(session_without_lean_execution, run_options);
+}
+
+TEST(InferenceSessionTests, PreparedRun) {
+  SessionOptions so;
+  so.session_logid = "PreparedRun";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims_mul_x, values_mul_x,
+                       &ml_value);
+  std::vector<std::string> feed_names{"X"};
+  std::vector<OrtValue> feeds{ml_value};
+  std::vector<std::string> output_names{"Y"};
+
+  std::unique_ptr<PreparedRun> prepared_run;
+  ASSERT_STATUS_OK(session_object.PrepareRun(feed_names, feeds, output_names, prepared_run));
+
+  std::vector<int64_t> expected_dims_mul_y = {3, 2};
+  std::vector<float> expected_values_mul_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  RunOptions run_options;
+  for (int i = 0; i < 2; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, *prepared_run, feeds, &fetches));
+    VerifyOutputs(fetches, expected_dims_mul_y, expected_values_mul_y);
+  }
+
+  // an input with another type is validated
+  OrtValue int_value;
+  CreateMLValue<int64_t>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims_mul_x,
+                         {1, 2, 3, 4, 5, 6}, &int_value);
+  std::vector<OrtValue> fetches;
+  auto status = session_object.Run(run_options, *prepared_run, std::vector<OrtValue>{int_value}, &fetches);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("Unexpected input data type"));
+
+  status = session_object.Run(run_options, *prepared_run, std::vector<OrtValue>{}, &fetches);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("The run was prepared with 1 inputs"));
+
+  // the names are validated when the run is prepared
+  std::vector<std::string> invalid_output_names{"Z"};
+  ASSERT_FALSE(session_object.PrepareRun(feed_names, feeds, invalid_output_names, prepared_run).IsOK());
+}
+
+TEST(InferenceSessionTests, RunTimeout) {
+  SessionOptions so;
+  so.session_logid = "RunTimeout";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // a run within its timeout completes
+  RunOptions run_options;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigTimeoutMs, "60000"));
+  RunModel(session_object, run_options);
+
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims_mul_x, values_mul_x,
+                       &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+
+  // a run whose deadline has passed stops before its first kernel
+  {
+    RunDeadline::Scope deadline_scope(RunDeadline::Clock::now() - std::chrono::milliseconds(1));
+    auto status = session_object.Run(RunOptions{}, feeds, output_names, &fetches);
+    ASSERT_FALSE(status.IsOK());
+    EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("deadline of the run having passed"));
+  }
+
+  RunOptions invalid_run_options;
+  ASSERT_STATUS_OK(invalid_run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigTimeoutMs, "-1"));
+  auto status = session_object.Run(invalid_run_options, feeds, output_names, &fetches);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("Failed to parse the run timeout"));
+}
+
+TEST(InferenceSessionTests, StatefulTensors) {
+  SessionOptions so;
+
+  so.session_logid = "StatefulTensors";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsStatefulTensors, "Y:X"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  InferenceSession session_without_state(SessionOptions{}, GetEnvironment());
+  ASSERT_STATUS_OK(session_without_state.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_without_state.Initialize());
+
+  RunOptions run_options;
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+
+  // the state has no value until the first run feeds it
+  OrtValue state;
+  ASSERT_STATUS_OK(session_object.GetStatefulTensor("X", state));
+  EXPECT_FALSE(state.IsAllocated());
+  EXPECT_FALSE(session_object.Run(run_options, NameMLValMap{}, output_names, &fetches).IsOK());
+
+  RunModel(session_object, run_options);
+  ASSERT_STATUS_OK(session_object.GetStatefulTensor("Y", state));
+  ASSERT_TRUE(state.IsAllocated());
+  VerifyOutputs({state}, {3, 2}, {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f});
+
+  // the next run is fed with the previous output
+  std::vector<OrtValue> expected_fetches;
+  ASSERT_STATUS_OK(session_without_state.Run(run_options, NameMLValMap{{"X", state}}, output_names,
+                                             &expected_fetches));
+  ASSERT_STATUS_OK(session_object.Run(run_options, NameMLValMap{}, output_names, &fetches));
+  ASSERT_EQ(fetches.size(), 1u);
+  const auto& expected = expected_fetches[0].Get<Tensor>();
+  const auto expected_dims = expected.Shape().GetDims();
+  const auto expected_values = expected.DataAsSpan<float>();
+  VerifyOutputs(fetches, std::vector<int64_t>(expected_dims.begin(), expected_dims.end()),
+                std::vector<float>(expected_values.begin(), expected_values.end()));
+
+  ASSERT_STATUS_OK(session_object.GetStatefulTensor("X", state));
+  EXPECT_EQ(state.Get<Tensor>().DataRaw(), fetches[0].Get<Tensor>().DataRaw());
+  EXPECT_FALSE(session_object.GetStatefulTensor("Z", state).IsOK());
+
+  session_object.ResetStatefulTensors();
+  ASSERT_STATUS_OK(session_object.GetStatefulTensor("X", state));
+  EXPECT_FALSE(state.IsAllocated());
+  EXPECT_FALSE(session_object.Run(run_options, NameMLValMap{}, output_names, &fetches).IsOK());
+
+  SessionOptions invalid_so;
+  ASSERT_STATUS_OK(invalid_so.config_options.AddConfigEntry(kOrtSessionOptionsStatefulTensors, "X:Y"));
+  InferenceSession invalid_session(invalid_so, GetEnvironment());
+  ASSERT_STATUS_OK(invalid_session.Load(MODEL_URI));
+  ASSERT_FALSE(invalid_session.Initialize().IsOK());
+}
+
 TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
   // Test whether the InferenceSession can access the profiler's start time
   SessionOptions so;
@@ -1223,6 +1604,51 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+TEST(InferenceSessionTests, TestIOBindingOutputPool) {
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigIOBindingReuseOutputs, "1"));
+  InferenceSession session_object(so, GetEnvironment());
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  std::unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+
+  auto cpu_allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue b;
+  CreateMLValue<float>(cpu_allocator, {2, 2}, {1.f, 0.f, 0.f, 1.f}, &b);
+  ASSERT_STATUS_OK(io_binding->BindInput("B", b));
+
+  // run with A of shape {rows, 2}, rebinding Y to the CPU device as a serving loop would do
+  auto run = [&](int64_t rows) -> const void* {
+    std::vector<float> a_values(static_cast<size_t>(rows * 2), 2.f);
+    OrtValue a;
+    CreateMLValue<float>(cpu_allocator, {rows, 2}, a_values, &a);
+    EXPECT_STATUS_OK(io_binding->BindInput("A", a));
+    io_binding->ClearOutputs();
+    EXPECT_STATUS_OK(io_binding->BindOutput("Y", OrtDevice()));
+    EXPECT_STATUS_OK(session_object.Run(RunOptions(), *io_binding));
+
+    const auto& y = io_binding->GetOutputs()[0].Get<Tensor>();
+    EXPECT_EQ(y.Shape(), TensorShape({rows, 2}));
+    VerifyOutputs(y, {rows, 2}, a_values);
+    return y.DataRaw();
+  };
+
+  const void* y_data_3 = run(3);
+  // a different shape needs a new output
+  const void* y_data_1 = run(1);
+  EXPECT_NE(y_data_1, y_data_3);
+  // outputs with a shape that was seen before are reused
+  EXPECT_EQ(run(3), y_data_3);
+  EXPECT_EQ(run(1), y_data_1);
+}
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
@@ -1311,6 +1737,52 @@ TEST(InferenceSessionTests, TestBindCudaSpecifyOutputDeviceOnCuda) {
                  kGpuExecutionProvider,
                  &device /* specify output device */);
 }
+
+#ifdef USE_CUDA
+TEST(InferenceSessionTests, TestIOBindingStageInputsOnCuda) {
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigIOBindingStageInputs, "1"));
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(DefaultCudaExecutionProvider()));
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCudaExecutionProvider);
+
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  std::unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+
+  auto cpu_allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue b;
+  CreateMLValue<float>(cpu_allocator, {2, 2}, {1.f, 0.f, 0.f, 1.f}, &b);
+  ASSERT_STATUS_OK(io_binding->BindInput("B", b));
+  ASSERT_STATUS_OK(io_binding->BindOutput("Y", OrtDevice()));
+
+  auto run = [&](float value) -> const void* {
+    std::vector<float> a_values(6, value);
+    OrtValue a;
+    CreateMLValue<float>(cpu_allocator, {3, 2}, a_values, &a);
+    EXPECT_STATUS_OK(io_binding->BindInput("A", a));
+
+    const Tensor& staged_a = io_binding->GetInputs()[1].Get<Tensor>();
+    EXPECT_FALSE(staged_a.Location().device.UsesCpuMemory());
+    EXPECT_STATUS_OK(session_object.Run(RunOptions(), *io_binding));
+
+    VerifyOutputs(io_binding->GetOutputs()[0].Get<Tensor>(), {3, 2}, a_values);
+    return staged_a.DataRaw();
+  };
+
+  // the device buffers of an input alternate between binds.
+  const void* a_data_0 = run(1.f);
+  const void* a_data_1 = run(2.f);
+  EXPECT_NE(a_data_0, a_data_1);
+  EXPECT_EQ(run(3.f), a_data_0);
+  EXPECT_EQ(run(4.f), a_data_1);
+}
+#endif
 #else
 TEST(InferenceSessionTests, TestGraphCapture) {
   TestBindHelper("TestGraphCapture",
@@ -2809,6 +3281,64 @@ TEST(InferenceSessionTests, InvalidSessionEnvCombination) {
   }
 }
 
+// Sessions bound to different env thread pool partitions use the partition's threadpools, not the global ones
+TEST(InferenceSessionTests, CheckIfThreadPoolPartitionsAreBeingUsed) {
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(new CLogSink()), logging::Severity::kVERBOSE, false,
+      LoggingManager::InstanceType::Temporal);
+
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+  OrtThreadingOptions tp_options;
+  tp_options.intra_op_thread_pool_params.thread_pool_size = 2;
+  ASSERT_STATUS_OK(env->RegisterThreadPoolPartition("node0", tp_options));
+  ASSERT_STATUS_OK(env->RegisterThreadPoolPartition("node1", tp_options));
+  ASSERT_FALSE(env->RegisterThreadPoolPartition("node0", tp_options).IsOK());
+
+  const auto* partition0 = env->GetThreadPoolPartition("node0");
+  const auto* partition1 = env->GetThreadPoolPartition("node1");
+  ASSERT_NE(partition0, nullptr);
+  ASSERT_NE(partition1, nullptr);
+  ASSERT_EQ(env->GetThreadPoolPartition("node2"), nullptr);
+  ASSERT_NE(partition0->intra_op_thread_pool, nullptr);
+  ASSERT_NE(partition0->intra_op_thread_pool.get(), partition1->intra_op_thread_pool.get());
+
+  for (const auto* partition_name : {"node0", "node1"}) {
+    SessionOptions so;
+    so.use_per_session_threads = false;
+    so.session_logid = "CheckIfThreadPoolPartitionsAreBeingUsed";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigThreadPoolPartition, partition_name));
+
+    InferenceSessionTestGlobalThreadPools session_object{so, *env.get()};
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    const auto* partition = env->GetThreadPoolPartition(partition_name);
+    ASSERT_EQ(session_object.GetIntraOpThreadPoolToUse(), partition->intra_op_thread_pool.get());
+    ASSERT_EQ(session_object.GetSessionState().GetThreadPool(), partition->intra_op_thread_pool.get());
+    ASSERT_EQ(session_object.GetInterOpThreadPoolToUse(), partition->inter_op_thread_pool.get());
+
+    RunOptions run_options;
+    run_options.run_tag = "RunTag";
+    RunModel(session_object, run_options);
+  }
+
+  // binding to an unknown partition fails
+  SessionOptions so;
+  so.use_per_session_threads = false;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigThreadPoolPartition, "node2"));
+  ORT_TRY {
+    InferenceSessionTestGlobalThreadPools session_object{so, *env.get()};
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&e]() {
+      std::string e_message(std::string(e.what()));
+      ASSERT_TRUE(e_message.find("Thread pool partition 'node2' has not been registered") != std::string::npos);
+    });
+  }
+}
+
 // Tests for sharing allocators between sessions
 class InferenceSessionTestSharingAllocator : public InferenceSessionWrapper {
  public:
@@ -3015,6 +3545,72 @@ TEST(InferenceSessionTests, InitializerSharing_EnsureSessionsUseUserAddedInitial
   }
 }
 
+TEST(InferenceSessionTests, InitializerSharing_ByContent) {
+  onnxruntime::Model model("share_by_content", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(16);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& w = graph.GetOrCreateNodeArg("W", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("mul", "Mul", "", {&x, &w}, {&y});
+
+  std::vector<float> w_data(16);
+  std::iota(w_data.begin(), w_data.end(), 1.0f);
+  ONNX_NAMESPACE::TensorProto w_proto;
+  w_proto.set_name("W");
+  w_proto.add_dims(16);
+  w_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  w_proto.set_raw_data(w_data.data(), w_data.size() * sizeof(float));
+  graph.AddInitializedTensor(w_proto);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsShareInitializersByContent, "1"));
+
+  auto get_w_buffer = [](const InferenceSessionWrapper& session) {
+    int idx;
+    ORT_THROW_IF_ERROR(session.GetSessionState().GetOrtValueNameIdxMap().GetIdx("W", idx));
+    return session.GetSessionState().GetInitializedTensors().at(idx).Get<Tensor>().DataRaw();
+  };
+
+  InferenceSessionWrapper sess1(so, GetEnvironment());
+  ASSERT_STATUS_OK(sess1.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(sess1.Initialize());
+
+  InferenceSessionWrapper sess2(so, GetEnvironment());
+  ASSERT_STATUS_OK(sess2.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(sess2.Initialize());
+
+  InferenceSessionWrapper sess3(SessionOptions{}, GetEnvironment());
+  ASSERT_STATUS_OK(sess3.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(sess3.Initialize());
+
+  // the sessions sharing by content use the same buffer, the other one has its own copy
+  EXPECT_EQ(get_w_buffer(sess1), get_w_buffer(sess2));
+  EXPECT_NE(get_w_buffer(sess1), get_w_buffer(sess3));
+  EXPECT_GE(GetEnvironment().GetSharedInitializerStore().GetNumberOfElements(), 1u);
+
+  OrtValue x_value;
+  std::vector<int64_t> dims{16};
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, std::vector<float>(16, 2.0f),
+                       &x_value);
+  std::vector<float> expected(16);
+  std::transform(w_data.begin(), w_data.end(), expected.begin(), [](float v) { return v * 2.0f; });
+  for (auto* session : {&sess1, &sess2}) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session->Run(RunOptions{}, NameMLValMap{{"X", x_value}}, {"Y"}, &fetches));
+    VerifyOutputs(fetches, dims, expected);
+  }
+}
+
 void RunModelWithDenormalAsZero(InferenceSession& session_object,
                                 const RunOptions& run_options,
                                 bool set_denormal_as_zero) {
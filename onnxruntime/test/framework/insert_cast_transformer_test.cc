@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/allocator.h"
+#include "core/optimizer/autocast_transformer.h"
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/graph/model.h"
 #include "core/graph/node_attr_utils.h"
@@ -371,5 +372,68 @@ TEST(TransformerTest, IsIsolatedFp16NodeOnCpuTest) {
   EXPECT_EQ(ops["Cast"], 4);
 }
 
+// MatMul nodes on the CPU are converted to fp16 if the CPU has fp16 kernels, with the Cast nodes between them
+// removed. Softmax stays in float even if it is in the allow list.
+TEST(TransformerTest, AutocastMatMulChain) {
+  auto model = std::make_shared<onnxruntime::Model>("test", false, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model->MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  for (const char* name : {"W1", "W2"}) {
+    TensorProto weight;
+    weight.set_name(name);
+    weight.set_data_type(TensorProto_DataType_FLOAT);
+    weight.add_dims(4);
+    weight.add_dims(4);
+    for (int i = 0; i < 16; ++i) {
+      weight.add_float_data(0.25f);
+    }
+    graph.AddInitializedTensor(weight);
+  }
+
+  onnxruntime::NodeArg x_def("X", &tensor_float), w1_def("W1", &tensor_float), w2_def("W2", &tensor_float),
+      y1_def("Y1", &tensor_float), y2_def("Y2", &tensor_float), z_def("Z", &tensor_float);
+  auto& matmul1 = graph.AddNode("matmul1", "MatMul", "", ArgMap{&x_def, &w1_def}, ArgMap{&y1_def});
+  auto& matmul2 = graph.AddNode("matmul2", "MatMul", "", ArgMap{&y1_def, &w2_def}, ArgMap{&y2_def});
+  auto& softmax = graph.AddNode("softmax", "Softmax", "", ArgMap{&y2_def}, ArgMap{&z_def});
+  for (Node* node : {&matmul1, &matmul2, &softmax}) {
+    node->SetExecutionProviderType(kCpuExecutionProvider);
+  }
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto cpu_kernel_registry = DefaultCpuExecutionProvider()->GetKernelRegistry();
+  KernelRegistryManager kernel_registry_manager;
+  kernel_registry_manager.RegisterKernelRegistry(cpu_kernel_registry);
+  const KernelCreateInfo* kernel_create_info = nullptr;
+  const bool has_fp16_matmul =
+      cpu_kernel_registry
+          ->TryFindKernel(kCpuExecutionProvider, "MatMul", kOnnxDomain, matmul1.SinceVersion(),
+                          {{"T", DataTypeImpl::GetTensorType<MLFloat16>()}}, DefaultLoggingManager().DefaultLogger(),
+                          &kernel_create_info)
+          .IsOK();
+
+  AutocastTransformer autocast(TensorProto_DataType_FLOAT16, {"MatMul", "Softmax"}, {}, kernel_registry_manager);
+  InsertCastTransformer cast_inserter("Test", cpu_kernel_registry.get());
+  bool modified = false;
+  ASSERT_STATUS_OK(autocast.Apply(graph, modified, DefaultLoggingManager().DefaultLogger()));
+  EXPECT_EQ(modified, has_fp16_matmul);
+  ASSERT_STATUS_OK(cast_inserter.Apply(graph, modified, DefaultLoggingManager().DefaultLogger()));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(softmax.InputDefs()[0]->TypeAsProto()->tensor_type().elem_type(), TensorProto_DataType_FLOAT);
+  if (has_fp16_matmul) {
+    // X is cast to fp16, the weights are converted, and only the output of the chain is cast back
+    EXPECT_EQ(op_to_count["Cast"], 2);
+    EXPECT_EQ(matmul1.InputDefs()[1]->TypeAsProto()->tensor_type().elem_type(), TensorProto_DataType_FLOAT16);
+    EXPECT_EQ(matmul2.InputDefs()[0]->TypeAsProto()->tensor_type().elem_type(), TensorProto_DataType_FLOAT16);
+  } else {
+    EXPECT_EQ(op_to_count["Cast"], 0);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
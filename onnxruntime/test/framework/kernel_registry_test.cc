@@ -6,7 +6,10 @@
 #include <gtest/gtest.h>
 
 #include "asserts.h"
+#include "core/framework/kernel_type_str_resolver.h"
 #include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
+#include "test/test_environment.h"
 
 namespace onnxruntime::test {
 
@@ -101,4 +104,57 @@ TEST(KernelRegistryTests, two_versions4) {
   ASSERT_STATUS_NOT_OK(RegKernels(r, function_table, CreateFakeKernel));
 }
 
+// A lookup is cached by op, version, EP and types of the node, and the cache is cleared when a kernel is registered.
+TEST(KernelRegistryTests, lookup_cache) {
+  KernelRegistry r;
+  std::vector<std::unique_ptr<KernelDef>> function_table;
+  function_table.emplace_back(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).SetName("Elu").SetDomain("").SinceVersion(6).Provider(kCpuExecutionProvider).Build());
+  ASSERT_STATUS_OK(RegKernels(r, function_table, CreateFakeKernel));
+
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 6}};
+  Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version, {},
+              DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+  ONNX_NAMESPACE::TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  ONNX_NAMESPACE::TypeProto tensor_double;
+  tensor_double.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_DOUBLE);
+  auto& x_float = graph.GetOrCreateNodeArg("X_float", &tensor_float);
+  auto& y_float = graph.GetOrCreateNodeArg("Y_float", &tensor_float);
+  auto& z_float = graph.GetOrCreateNodeArg("Z_float", &tensor_float);
+  auto& x_double = graph.GetOrCreateNodeArg("X_double", &tensor_double);
+  auto& y_double = graph.GetOrCreateNodeArg("Y_double", &tensor_double);
+  Node& elu_float1 = graph.AddNode("elu_float1", "Elu", "", {&x_float}, {&y_float});
+  Node& elu_float2 = graph.AddNode("elu_float2", "Elu", "", {&y_float}, {&z_float});
+  Node& elu_double = graph.AddNode("elu_double", "Elu", "", {&x_double}, {&y_double});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const OpSchemaKernelTypeStrResolver resolver{};
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  const KernelCreateInfo* kci1 = nullptr;
+  const KernelCreateInfo* kci2 = nullptr;
+  ASSERT_STATUS_OK(r.TryFindKernel(elu_float1, kCpuExecutionProvider, resolver, logger, &kci1));
+  ASSERT_STATUS_OK(r.TryFindKernel(elu_float2, kCpuExecutionProvider, resolver, logger, &kci2));
+  ASSERT_NE(kci1, nullptr);
+  ASSERT_EQ(kci1, kci2);
+
+  // a cached failure still names the node
+  for (int i = 0; i < 2; ++i) {
+    const KernelCreateInfo* kci = nullptr;
+    Status status = r.TryFindKernel(elu_double, kCpuExecutionProvider, resolver, logger, &kci);
+    ASSERT_FALSE(status.IsOK());
+    ASSERT_EQ(kci, nullptr);
+    ASSERT_NE(status.ErrorMessage().find("elu_double"), std::string::npos);
+    ASSERT_NE(status.ErrorMessage().find("tensor(double)"), std::string::npos);
+  }
+
+  function_table.clear();
+  function_table.emplace_back(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()).SetName("Elu").SetDomain("").SinceVersion(6).Provider(kCpuExecutionProvider).Build());
+  ASSERT_STATUS_OK(RegKernels(r, function_table, CreateFakeKernel));
+  const KernelCreateInfo* kci_double = nullptr;
+  ASSERT_STATUS_OK(r.TryFindKernel(elu_double, kCpuExecutionProvider, resolver, logger, &kci_double));
+  ASSERT_NE(kci_double, nullptr);
+  ASSERT_NE(kci_double, kci1);
+}
+
 }  // namespace onnxruntime::test
@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/framework/mem_pattern_planner.h"
+#include "core/framework/mem_pattern_cache.h"
+#include "test/framework/test_utils.h"
+#include "test/util/include/asserts.h"
 #include "gtest/gtest.h"
 
 namespace onnxruntime {
@@ -35,5 +38,101 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
   EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
   EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
 }
+
+static std::vector<OrtValue> CreateInputs(std::initializer_list<std::vector<int64_t>> shapes) {
+  auto alloc = std::make_shared<CPUAllocator>();
+  std::vector<OrtValue> inputs;
+  for (const auto& shape : shapes) {
+    OrtValue value;
+    AllocateMLValue<float>(alloc, shape, &value);
+    inputs.push_back(std::move(value));
+  }
+  return inputs;
+}
+
+static MemoryPatternCache::Entry CreateEntry() {
+  return MemoryPatternCache::Entry{std::make_shared<const MemoryPatternGroup>(), nullptr};
+}
+
+TEST(MemoryPatternCacheTest, ParseShapeBuckets) {
+  InlinedVector<int64_t> buckets;
+  ASSERT_STATUS_OK(MemoryPatternCache::ParseShapeBuckets("128, 256,512", buckets));
+  EXPECT_EQ(buckets, (InlinedVector<int64_t>{128, 256, 512}));
+
+  ASSERT_STATUS_OK(MemoryPatternCache::ParseShapeBuckets("", buckets));
+  EXPECT_TRUE(buckets.empty());
+
+  EXPECT_FALSE(MemoryPatternCache::ParseShapeBuckets("256,128", buckets).IsOK());
+  EXPECT_FALSE(MemoryPatternCache::ParseShapeBuckets("0,128", buckets).IsOK());
+  EXPECT_FALSE(MemoryPatternCache::ParseShapeBuckets("abc", buckets).IsOK());
+}
+
+TEST(MemoryPatternCacheTest, ExactShapes) {
+  MemoryPatternCache cache;
+  auto inputs = CreateInputs({{1, 100}});
+  EXPECT_EQ(cache.Get(inputs), nullptr);
+
+  auto entry = CreateEntry();
+  const auto* patterns = entry.patterns.get();
+  cache.Put(inputs, std::move(entry));
+  ASSERT_NE(cache.Get(inputs), nullptr);
+  EXPECT_EQ(cache.Get(inputs)->patterns.get(), patterns);
+
+  // transposed dims must not collide
+  EXPECT_EQ(cache.Get(CreateInputs({{100, 1}})), nullptr);
+  EXPECT_EQ(cache.Get(CreateInputs({{1, 101}})), nullptr);
+}
+
+TEST(MemoryPatternCacheTest, ShapeBuckets) {
+  MemoryPatternCache cache({128, 256, 512}, 0);
+
+  auto entry = CreateEntry();
+  const auto* patterns = entry.patterns.get();
+  cache.Put(CreateInputs({{1, 200}}), std::move(entry));
+
+  // smaller shapes in the same bucket reuse the pattern
+  ASSERT_NE(cache.Get(CreateInputs({{1, 129}})), nullptr);
+  EXPECT_EQ(cache.Get(CreateInputs({{1, 150}}))->patterns.get(), patterns);
+  // larger shapes in the same bucket do not fit into it
+  EXPECT_EQ(cache.Get(CreateInputs({{1, 256}})), nullptr);
+  // other buckets
+  EXPECT_EQ(cache.Get(CreateInputs({{1, 100}})), nullptr);
+
+  // an entry that is large enough is not replaced
+  cache.Put(CreateInputs({{1, 150}}), CreateEntry());
+  EXPECT_EQ(cache.Get(CreateInputs({{1, 200}}))->patterns.get(), patterns);
+
+  // a run that outgrew the entry replaces it
+  auto larger_entry = CreateEntry();
+  const auto* larger_patterns = larger_entry.patterns.get();
+  cache.Put(CreateInputs({{1, 256}}), std::move(larger_entry));
+  EXPECT_EQ(cache.Get(CreateInputs({{1, 200}}))->patterns.get(), larger_patterns);
+  EXPECT_EQ(cache.Size(), 1u);
+
+  // dims beyond the last bucket are used as is
+  cache.Put(CreateInputs({{1, 1000}}), CreateEntry());
+  EXPECT_EQ(cache.Get(CreateInputs({{1, 999}})), nullptr);
+  EXPECT_EQ(cache.Size(), 2u);
+}
+
+TEST(MemoryPatternCacheTest, LruEviction) {
+  MemoryPatternCache cache({128, 256, 512}, 2);
+  cache.Put(CreateInputs({{1, 100}}), CreateEntry());
+  auto evicted_entry = CreateEntry();
+  std::shared_ptr<const MemoryPatternGroup> evicted_patterns = evicted_entry.patterns;
+  cache.Put(CreateInputs({{1, 200}}), std::move(evicted_entry));
+
+  // touch the 128 bucket so the 256 bucket is the least recently used one
+  ASSERT_NE(cache.Get(CreateInputs({{1, 100}})), nullptr);
+  cache.Put(CreateInputs({{1, 500}}), CreateEntry());
+
+  EXPECT_EQ(cache.Size(), 2u);
+  EXPECT_NE(cache.Get(CreateInputs({{1, 100}})), nullptr);
+  EXPECT_EQ(cache.Get(CreateInputs({{1, 200}})), nullptr);
+  EXPECT_NE(cache.Get(CreateInputs({{1, 500}})), nullptr);
+  // patterns still referenced by a run outlive the eviction
+  EXPECT_EQ(evicted_patterns.use_count(), 1);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/numa_replicated_buffer.h"
+
+#include <cstring>
+#include <vector>
+
+#include "core/platform/env.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(NumaReplicatedBufferTest, LocalCopyHasTheSameContent) {
+  std::vector<uint8_t> data(NumaReplicatedBuffer::kMinReplicatedSize + 1000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  NumaReplicatedBuffer replicas;
+  EXPECT_EQ(replicas.Local(data.data()), data.data());
+
+  replicas.Replicate(data.data(), data.size());
+  const Env& env = Env::Default();
+  if (env.GetNumaNodeCount() > 1 && env.GetCurrentNumaNode() >= 0) {
+    EXPECT_EQ(replicas.NumReplicas(), static_cast<size_t>(env.GetNumaNodeCount()));
+  } else {
+    EXPECT_EQ(replicas.NumReplicas(), 0u);
+  }
+  const void* local = replicas.Local(data.data());
+  ASSERT_NE(local, nullptr);
+  EXPECT_EQ(std::memcmp(local, data.data(), data.size()), 0);
+
+  // replicating again replaces the copies
+  replicas.Replicate(data.data(), data.size());
+  EXPECT_EQ(std::memcmp(replicas.Local(data.data()), data.data(), data.size()), 0);
+}
+
+TEST(NumaReplicatedBufferTest, SmallBufferIsNotReplicated) {
+  std::vector<uint8_t> data(1024, 1);
+  NumaReplicatedBuffer replicas;
+  replicas.Replicate(data.data(), data.size());
+  EXPECT_EQ(replicas.NumReplicas(), 0u);
+  EXPECT_EQ(replicas.Local(data.data()), data.data());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
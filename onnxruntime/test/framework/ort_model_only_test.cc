@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <fstream>
+#include <iterator>
+
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/data_types.h"
 #include "core/framework/tensorprotoutils.h"
@@ -322,6 +325,62 @@ TEST(OrtModelOnlyTests, SerializeToOrtFormat) {
   RunOrtModel(test_info);
 }
 
+TEST(OrtModelOnlyTests, SerializeAllocationPlanToOrtFormat) {
+  const auto ort_file = ORT_TSTR("testdata/mnist.onnx_with_allocation_plan.test_output.ort");
+
+  SessionOptions so;
+  so.session_logid = "SerializeAllocationPlanToOrtFormat";
+  so.optimized_model_filepath = ort_file;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveAllocationPlan, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/mnist.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // the saved model should contain the plan
+  std::ifstream file(ort_file, std::ios::binary);
+  ASSERT_TRUE(file);
+  std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  flatbuffers::Verifier verifier(bytes.data(), bytes.size());
+  ASSERT_TRUE(fbs::VerifyInferenceSessionBuffer(verifier));
+  const auto* fbs_allocation_plan = fbs::GetInferenceSession(bytes.data())->allocation_plan();
+  ASSERT_NE(fbs_allocation_plan, nullptr);
+  ASSERT_NE(fbs_allocation_plan->values(), nullptr);
+  EXPECT_GT(fbs_allocation_plan->values()->size(), 0u);
+
+  SessionOptions so2;
+  so2.session_logid = "LoadAllocationPlanFromOrtFormat";
+  ASSERT_STATUS_OK(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+  InferenceSessionWrapper session_object2{so2, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object2.Load(ort_file));
+  ASSERT_STATUS_OK(session_object2.Initialize());
+
+  CompareGraphAndSessionState(session_object, session_object2);
+
+  // the plan used by the loading session should match the plan computed by the saving session
+  const auto& session_state_1 = session_object.GetSessionState();
+  const auto& session_state_2 = session_object2.GetSessionState();
+  const auto& name_idx_map_1 = session_state_1.GetOrtValueNameIdxMap();
+  const auto& name_idx_map_2 = session_state_2.GetOrtValueNameIdxMap();
+  const auto& alloc_plan_1 = session_state_1.GetExecutionPlan()->allocation_plan;
+  const auto& alloc_plan_2 = session_state_2.GetExecutionPlan()->allocation_plan;
+
+  for (const auto& [name, idx_1] : name_idx_map_1) {
+    int idx_2 = -1;
+    ASSERT_STATUS_OK(name_idx_map_2.GetIdx(name, idx_2));
+    const auto& plan_1 = alloc_plan_1[idx_1];
+    const auto& plan_2 = alloc_plan_2[idx_2];
+    EXPECT_EQ(plan_1.alloc_kind, plan_2.alloc_kind) << name;
+
+    if (plan_1.alloc_kind == AllocKind::kReuse) {
+      std::string reused_1, reused_2;
+      ASSERT_STATUS_OK(name_idx_map_1.GetName(plan_1.reused_buffer, reused_1));
+      ASSERT_STATUS_OK(name_idx_map_2.GetName(plan_2.reused_buffer, reused_2));
+      EXPECT_EQ(reused_1, reused_2) << name;
+    }
+  }
+}
+
 TEST(OrtModelOnlyTests, SparseInitializerHandling) {
   const auto ort_file = ORT_TSTR("testdata/ort_minimal_test_models/sparse_initializer_handling.onnx.test_output.ort");
   SaveAndCompareModels(ORT_TSTR("testdata/ort_minimal_test_models/sparse_initializer_handling.onnx"), ort_file);
@@ -557,6 +616,13 @@ TEST(OrtModelOnlyTests, LoadOrtFormatModelFromBufferNoCopyInitializersUseBuffer)
   RunOrtModel(test_info);
 }
 
+// Map the model file, with the initializers using the mapped bytes
+TEST(OrtModelOnlyTests, LoadOrtFormatModelMapped) {
+  OrtModelTestInfo test_info = GetTestInfoForLoadOrtFormatModel();
+  test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigMapORTModelFile, "1"));
+  RunOrtModel(test_info);
+}
+
 // regression test for 2 issues covered by PR #17000 (internally reported issue).
 // 1) allocation planner broke in minimal build when subgraph had no nodes.
 // 2) usage of a sequence data type caused an exception due to IsSparseTensor() throwing
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_disk_cache.h"
+
+#include <cstring>
+#include <filesystem>
+
+#include "core/framework/allocator.h"
+#include "core/platform/env.h"
+#include "test/util/include/temp_dir.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+PrePackedWeights MakeWeights(const AllocatorPtr& alloc, std::initializer_list<size_t> sizes) {
+  PrePackedWeights weights;
+  uint8_t value = 0;
+  for (const size_t size : sizes) {
+    auto buffer = IAllocator::MakeUniquePtr<void>(alloc, size);
+    auto* bytes = static_cast<uint8_t*>(buffer.get());
+    for (size_t i = 0; i < size; ++i) {
+      bytes[i] = value++;
+    }
+    weights.buffers_.push_back(std::move(buffer));
+    weights.buffer_sizes_.push_back(size);
+  }
+  return weights;
+}
+
+}  // namespace
+
+TEST(PrepackedWeightsDiskCacheTest, KeyDependsOnWhatIsAdded) {
+  const auto key = PrepackedWeightsDiskCache::KeyBuilder{}.Add("MatMul").Add(int64_t{1}).Build();
+  EXPECT_EQ(key.size(), 32u);
+  EXPECT_EQ(key, PrepackedWeightsDiskCache::KeyBuilder{}.Add("MatMul").Add(int64_t{1}).Build());
+  EXPECT_NE(key, PrepackedWeightsDiskCache::KeyBuilder{}.Add("MatMul").Add(int64_t{2}).Build());
+  // strings are length prefixed so moving the boundary between them changes the key
+  EXPECT_NE(PrepackedWeightsDiskCache::KeyBuilder{}.Add("ab").Add("c").Build(),
+            PrepackedWeightsDiskCache::KeyBuilder{}.Add("a").Add("bc").Build());
+}
+
+TEST(PrepackedWeightsDiskCacheTest, SaveAndLoad) {
+  TemporaryDirectory tmp_dir(ORT_TSTR("prepacked_weights_disk_cache_test"));
+  // Save() creates missing directories
+  const auto cache_dir = std::filesystem::path(tmp_dir.Path()) / ORT_TSTR("cache");
+  PrepackedWeightsDiskCache cache(Env::Default(), cache_dir);
+
+  const std::string key = PrepackedWeightsDiskCache::KeyBuilder{}.Add("SaveAndLoad").Build();
+  PrePackedWeights loaded;
+  EXPECT_FALSE(cache.TryLoad(key, loaded));
+
+  AllocatorPtr alloc = std::make_shared<CPUAllocator>();
+  PrePackedWeights weights = MakeWeights(alloc, {100, 1, 4096});
+  ASSERT_TRUE(cache.Save(key, weights).IsOK());
+  // writing an existing entry again succeeds
+  ASSERT_TRUE(cache.Save(key, weights).IsOK());
+
+  ASSERT_TRUE(cache.TryLoad(key, loaded));
+  ASSERT_EQ(loaded.buffers_.size(), weights.buffers_.size());
+  ASSERT_EQ(loaded.buffer_sizes_.size(), weights.buffer_sizes_.size());
+  for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+    ASSERT_EQ(loaded.buffer_sizes_[i], weights.buffer_sizes_[i]);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(loaded.buffers_[i].get()) % 64, 0u);
+    EXPECT_EQ(std::memcmp(loaded.buffers_[i].get(), weights.buffers_[i].get(), weights.buffer_sizes_[i]), 0);
+  }
+  EXPECT_EQ(loaded.GetHash(), weights.GetHash());
+
+  PrePackedWeights other;
+  EXPECT_FALSE(cache.TryLoad(PrepackedWeightsDiskCache::KeyBuilder{}.Add("Other").Build(), other));
+}
+
+TEST(PrepackedWeightsDiskCacheTest, TruncatedEntryIsNotLoaded) {
+  TemporaryDirectory tmp_dir(ORT_TSTR("prepacked_weights_disk_cache_test"));
+  const std::filesystem::path cache_dir = tmp_dir.Path();
+  PrepackedWeightsDiskCache cache(Env::Default(), cache_dir);
+
+  const std::string key = PrepackedWeightsDiskCache::KeyBuilder{}.Add("Truncated").Build();
+  AllocatorPtr alloc = std::make_shared<CPUAllocator>();
+  ASSERT_TRUE(cache.Save(key, MakeWeights(alloc, {1024})).IsOK());
+
+  const auto entry_path = cache_dir / (key + ".bin");
+  ASSERT_TRUE(std::filesystem::exists(entry_path));
+  std::filesystem::resize_file(entry_path, 512);
+
+  PrePackedWeights loaded;
+  EXPECT_FALSE(cache.TryLoad(key, loaded));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
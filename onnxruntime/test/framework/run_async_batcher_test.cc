@@ -0,0 +1,194 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_async_batcher.h"
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "core/framework/allocator.h"
+#include "core/framework/tensor.h"
+#include "test/framework/test_utils.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+struct TestRequest {
+  TestRequest(std::initializer_list<int64_t> dims, std::initializer_list<float> values) {
+    CreateMLValue<float>(CPUAllocator::DefaultInstance(), dims, values, &feed);
+    feeds[0] = &feed;
+  }
+
+  const char* feed_names[1] = {"X"};
+  OrtValue feed;
+  const OrtValue* feeds[1] = {nullptr};
+  const char* fetch_names[1] = {"Y"};
+  OrtValue* fetches[1] = {nullptr};
+
+  std::vector<int64_t> result_dims;
+  std::vector<float> result;
+  bool done = false;
+};
+
+void TestCallback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status) {
+  auto& request = *static_cast<TestRequest*>(user_data);
+  request.done = true;
+  EXPECT_EQ(status, nullptr);
+  ASSERT_EQ(num_outputs, 1u);
+
+  std::unique_ptr<OrtValue> output{outputs[0]};
+  const auto& tensor = output->Get<Tensor>();
+  const auto dims = tensor.Shape().GetDims();
+  request.result_dims.assign(dims.begin(), dims.end());
+  const auto data = tensor.DataAsSpan<float>();
+  request.result.assign(data.begin(), data.end());
+}
+
+// Adds 1 to the input and records the batch sizes it was run with.
+// Fails for batches larger than max_rows to emulate a model with a fixed maximum batch size.
+RunAsyncBatcher::RunFn CreateAddOneRunFn(std::vector<int64_t>& run_rows, int64_t max_rows = 1024) {
+  return [&run_rows, max_rows](const RunOptions&, gsl::span<const char* const>,
+                               gsl::span<const OrtValue* const> feeds, gsl::span<const char* const>,
+                               gsl::span<OrtValue*> fetches) -> Status {
+    const Tensor& input = feeds[0]->Get<Tensor>();
+    run_rows.push_back(input.Shape()[0]);
+    ORT_RETURN_IF(input.Shape()[0] > max_rows, "Unsupported batch size");
+
+    auto output = std::make_unique<OrtValue>();
+    Tensor::InitOrtValue(input.DataType(), input.Shape(), CPUAllocator::DefaultInstance(), *output);
+    const auto input_data = input.DataAsSpan<float>();
+    auto* output_data = output->GetMutable<Tensor>()->MutableData<float>();
+    for (size_t i = 0; i < input_data.size(); ++i) {
+      output_data[i] = input_data[i] + 1.f;
+    }
+    fetches[0] = output.release();
+    return Status::OK();
+  };
+}
+
+void Submit(RunAsyncBatcher& batcher, TestRequest& request) {
+  batcher.Submit(nullptr, request.feed_names, request.feeds, request.fetch_names, request.fetches,
+                 TestCallback, &request);
+}
+
+void RunTasks(std::deque<std::function<void()>>& tasks) {
+  while (!tasks.empty()) {
+    auto task = std::move(tasks.front());
+    tasks.pop_front();
+    task();
+  }
+}
+
+}  // namespace
+
+TEST(RunAsyncBatcherTest, CoalescesCompatibleRequests) {
+  std::vector<int64_t> run_rows;
+  std::deque<std::function<void()>> tasks;
+
+  RunAsyncBatcher::Config config;
+  config.max_batch_size = 4;
+  config.max_queue_delay = std::chrono::seconds(10);
+
+  TestRequest r0{{1, 2}, {1.f, 2.f}};
+  TestRequest r1{{1, 2}, {3.f, 4.f}};
+  TestRequest r2{{2, 2}, {5.f, 6.f, 7.f, 8.f}};
+  {
+    RunAsyncBatcher batcher{config, CreateAddOneRunFn(run_rows),
+                            [&tasks](std::function<void()> fn) { tasks.push_back(std::move(fn)); }};
+    Submit(batcher, r0);
+    Submit(batcher, r1);
+    Submit(batcher, r2);
+
+    // the queue holds a full batch so the dispatcher doesn't wait for the delay
+    RunTasks(tasks);
+  }
+
+  ASSERT_EQ(run_rows, std::vector<int64_t>({4}));
+  ASSERT_TRUE(r0.done && r1.done && r2.done);
+  EXPECT_EQ(r0.result_dims, std::vector<int64_t>({1, 2}));
+  EXPECT_EQ(r0.result, std::vector<float>({2.f, 3.f}));
+  EXPECT_EQ(r1.result, std::vector<float>({4.f, 5.f}));
+  EXPECT_EQ(r2.result_dims, std::vector<int64_t>({2, 2}));
+  EXPECT_EQ(r2.result, std::vector<float>({6.f, 7.f, 8.f, 9.f}));
+}
+
+TEST(RunAsyncBatcherTest, BatchesAlongInnerDim) {
+  std::vector<int64_t> run_rows;
+  std::deque<std::function<void()>> tasks;
+
+  RunAsyncBatcher::Config config;
+  config.max_batch_size = 3;
+  config.batch_dim = 1;
+
+  TestRequest r0{{2, 1}, {1.f, 2.f}};
+  TestRequest r1{{2, 2}, {3.f, 4.f, 5.f, 6.f}};
+  {
+    RunAsyncBatcher batcher{config, CreateAddOneRunFn(run_rows),
+                            [&tasks](std::function<void()> fn) { tasks.push_back(std::move(fn)); }};
+    Submit(batcher, r0);
+    Submit(batcher, r1);
+    RunTasks(tasks);
+  }
+
+  // a single run with both requests concatenated along dim 1. the fake run fn records dim 0.
+  ASSERT_EQ(run_rows.size(), 1u);
+  ASSERT_TRUE(r0.done && r1.done);
+  EXPECT_EQ(r0.result_dims, std::vector<int64_t>({2, 1}));
+  EXPECT_EQ(r0.result, std::vector<float>({2.f, 3.f}));
+  EXPECT_EQ(r1.result_dims, std::vector<int64_t>({2, 2}));
+  EXPECT_EQ(r1.result, std::vector<float>({4.f, 5.f, 6.f, 7.f}));
+}
+
+TEST(RunAsyncBatcherTest, IncompatibleRequestsRunSeparately) {
+  std::vector<int64_t> run_rows;
+  std::deque<std::function<void()>> tasks;
+
+  RunAsyncBatcher::Config config;
+  config.max_batch_size = 2;
+  config.max_queue_delay = std::chrono::microseconds(0);
+
+  TestRequest r0{{1, 2}, {1.f, 2.f}};
+  TestRequest r1{{1, 3}, {3.f, 4.f, 5.f}};
+  {
+    RunAsyncBatcher batcher{config, CreateAddOneRunFn(run_rows),
+                            [&tasks](std::function<void()> fn) { tasks.push_back(std::move(fn)); }};
+    Submit(batcher, r0);
+    Submit(batcher, r1);
+    RunTasks(tasks);
+  }
+
+  ASSERT_EQ(run_rows, std::vector<int64_t>({1, 1}));
+  ASSERT_TRUE(r0.done && r1.done);
+  EXPECT_EQ(r0.result, std::vector<float>({2.f, 3.f}));
+  EXPECT_EQ(r1.result, std::vector<float>({4.f, 5.f, 6.f}));
+}
+
+TEST(RunAsyncBatcherTest, FallsBackToSeparateRunsIfBatchedRunFails) {
+  std::vector<int64_t> run_rows;
+  std::deque<std::function<void()>> tasks;
+
+  RunAsyncBatcher::Config config;
+  config.max_batch_size = 4;
+
+  TestRequest r0{{2, 1}, {1.f, 2.f}};
+  TestRequest r1{{2, 1}, {3.f, 4.f}};
+  {
+    RunAsyncBatcher batcher{config, CreateAddOneRunFn(run_rows, 2),
+                            [&tasks](std::function<void()> fn) { tasks.push_back(std::move(fn)); }};
+    Submit(batcher, r0);
+    Submit(batcher, r1);
+    RunTasks(tasks);
+  }
+
+  ASSERT_EQ(run_rows, std::vector<int64_t>({4, 2, 2}));
+  ASSERT_TRUE(r0.done && r1.done);
+  EXPECT_EQ(r0.result, std::vector<float>({2.f, 3.f}));
+  EXPECT_EQ(r1.result, std::vector<float>({4.f, 5.f}));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -944,6 +944,76 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test1) {
 }
 
 // Pre-packing enabled + shared initializers + no pre-packed weights container = no pre-packed weights caching
+// Pre-packing of the nodes in parallel on the intra-op thread pool, a few nodes at a time.
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, ParallelPrePacking) {
+  OrtThreadPoolParams to;
+  to.thread_pool_size = 4;
+  auto parallel_tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to,
+                                                   concurrency::ThreadPoolType::INTRA_OP);
+
+  for (const char* max_concurrency : {"0", "1", "3"}) {
+    SessionOptions sess_options;
+    sess_options.enable_mem_pattern = true;
+    sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+    sess_options.use_deterministic_compute = false;
+    sess_options.enable_mem_reuse = true;
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+    sess_options.config_options.configurations[kOrtSessionOptionsInitializerLoadMaxConcurrency] = max_concurrency;
+
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+    Graph& graph = model.MainGraph();
+
+    // a chain of nodes that each pre-pack their own initializer
+    constexpr int kNumNodes = 10;
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    NodeArg* input_arg = &graph.GetOrCreateNodeArg("input", &type);
+    for (int i = 0; i < kNumNodes; i++) {
+      const std::string weight_name = "weight_" + std::to_string(i);
+      ONNX_NAMESPACE::TensorProto tensor;
+      tensor.add_dims(1);
+      tensor.add_float_data(static_cast<float>(i));
+      tensor.set_data_type(TensorProto_DataType_FLOAT);
+      tensor.set_name(weight_name);
+      graph.AddInitializedTensor(tensor);
+
+      NodeArg* output_arg = &graph.GetOrCreateNodeArg("output_" + std::to_string(i), &type);
+      graph.AddNode("node_" + std::to_string(i), "PrePackingTest", "node",
+                    {input_arg, &graph.GetOrCreateNodeArg(weight_name, &type)}, {output_arg});
+      input_arg = output_arg;
+    }
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    PlaceAllNodesToCPUEP(graph);
+    SessionState session_state(graph,
+                               execution_providers,
+                               parallel_tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               edlm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler,
+                               sess_options);
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager));
+
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(kNumNodes)) << max_concurrency;
+    for (const auto& node : graph.Nodes()) {
+      const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(node.Index()));
+      ASSERT_EQ(kernel->prepack_calls_count, 1) << max_concurrency;
+      ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 1) << max_concurrency;
+    }
+
+    // all the weights were pre-packed and released
+    ASSERT_TRUE(session_state.GetConstantInitializedTensors().empty()) << max_concurrency;
+  }
+}
+
 TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test2) {
   SessionOptions sess_options;
   sess_options.enable_mem_pattern = true;
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/framework/TensorSeq.h"
 #include "core/framework/allocator_utils.h"
 #include "test_utils.h"
 
@@ -260,5 +261,38 @@ TEST(TensorTest, Strided) {
 }
 #endif
 
+TEST(TensorSeqTest, CopiesShareElementsUntilChanged) {
+  auto alloc = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  auto make_value = [&alloc](float value) {
+    Tensor tensor(DataTypeImpl::GetType<float>(), TensorShape({1}), alloc);
+    *tensor.MutableData<float>() = value;
+    return tensor;
+  };
+
+  TensorSeq seq(DataTypeImpl::GetType<float>());
+  seq.Add(make_value(0.f));
+
+  // the first copy appends in place, the second one can't as the slot after seq is taken
+  TensorSeq first = seq;
+  first.Add(make_value(1.f));
+  TensorSeq second = seq;
+  second.Add(make_value(2.f));
+
+  ASSERT_EQ(seq.Size(), 1u);
+  ASSERT_EQ(first.Size(), 2u);
+  ASSERT_EQ(second.Size(), 2u);
+  EXPECT_EQ(&seq.GetAt(0), &first.GetAt(0));
+  EXPECT_NE(&seq.GetAt(0), &second.GetAt(0));
+  EXPECT_EQ(*first.Get(1).Data<float>(), 1.f);
+  EXPECT_EQ(*second.Get(1).Data<float>(), 2.f);
+
+  // changing the elements of a shared sequence doesn't change the other sequences
+  *first.begin() = OrtValue();
+  EXPECT_TRUE(seq.GetAt(0).IsAllocated());
+  EXPECT_EQ(*seq.Get(0).Data<float>(), 0.f);
+
+  EXPECT_FALSE(first.GetAt(0).IsAllocated());
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -5,8 +5,10 @@
 #include "core/common/parse_string.h"
 #include "core/framework/prepacked_weights.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/tensor.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/onnx_protobuf.h"
+#include "core/platform/env.h"
 #include "test/util/include/asserts.h"
 #include "file_util.h"
 
@@ -356,6 +358,41 @@ TEST(TensorProtoUtilsTest, UnpackTensorWithExternalData) {
   TestUnpackExternalTensor<bool>(TensorProto_DataType_BOOL, model_path);
 }
 
+// External data is used in place when it is suitably aligned, otherwise it is copied to aligned memory.
+TEST(TensorProtoUtilsTest, GetExtDataFromTensorProtoAlignsData) {
+  const std::vector<float> test_data{1.f, 2.f, 3.f, 4.f};
+  const size_t data_size = test_data.size() * sizeof(float);
+
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("tensor_XXXXXX"));
+  FILE* fp;
+  CreateTestFile(fp, filename);
+  std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                         DeleteFileFromDisk);
+  // the data is at offset 4, which is aligned for float, and at offset 9, which isn't.
+  const char padding[5] = {};
+  // WriteDataToFile swaps the data in place on big endian platforms, so write copies.
+  ASSERT_EQ(4u, fwrite(padding, 1, 4, fp));
+  WriteDataToFile(fp, std::vector<float>(test_data));
+  ASSERT_EQ(1u, fwrite(padding, 1, 1, fp));
+  WriteDataToFile(fp, std::vector<float>(test_data));
+  ASSERT_EQ(0, fclose(fp));
+
+  for (const int64_t offset : {int64_t{4}, static_cast<int64_t>(4 + data_size + 1)}) {
+    TensorProto tensor_proto;
+    tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+    tensor_proto.add_dims(static_cast<int64_t>(test_data.size()));
+    ExternalDataInfo::SetExternalLocationToProto(filename, offset, data_size, tensor_proto);
+
+    OrtValue value;
+    ASSERT_STATUS_OK(utils::GetExtDataFromTensorProto(Env::Default(), {}, tensor_proto, value));
+    const auto& tensor = value.Get<Tensor>();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(tensor.DataRaw()) % alignof(float), 0u);
+
+    std::vector<float> values(tensor.Data<float>(), tensor.Data<float>() + tensor.Shape().Size());
+    EXPECT_EQ(values, test_data);
+  }
+}
+
 template <typename T>
 static NodeProto CreateConstantNode(const std::string& attrib_name, AttributeProto_AttributeType type,
                                     std::function<void(AttributeProto&)> add_data) {
@@ -681,6 +681,71 @@ TEST_F(GraphTest, GraphConstruction_VerifyNoDuplicateName) {
   EXPECT_TRUE(duplicate_error_found);
 }
 
+// Each consumer of a value is listed once, in the order of the nodes, even if it consumes the value twice.
+TEST_F(GraphTest, GraphConstruction_ConsumerNodes) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_float);
+  auto& y = graph.GetOrCreateNodeArg("y", &tensor_float);
+  auto& z = graph.GetOrCreateNodeArg("z", &tensor_float);
+  auto& add_1 = graph.AddNode("add_1", "Add", "x + x", {&x, &x}, {&y});
+  auto& add_2 = graph.AddNode("add_2", "Add", "y + x", {&y, &x}, {&z});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  EXPECT_EQ(graph.GetConsumerNodes("x"), (std::vector<const Node*>{&add_1, &add_2}));
+  EXPECT_EQ(graph.GetConsumerNodes("y"), (std::vector<const Node*>{&add_2}));
+  EXPECT_TRUE(graph.GetConsumerNodes("z").empty());
+
+  graph.RemoveConsumerNode("x", &add_1);
+  EXPECT_EQ(graph.GetConsumerNodes("x"), (std::vector<const Node*>{&add_2}));
+  graph.AddConsumerNode("x", &add_1);
+  graph.AddConsumerNode("x", &add_1);
+  EXPECT_EQ(graph.GetConsumerNodes("x"), (std::vector<const Node*>{&add_2, &add_1}));
+}
+
+// After the first Resolve, type inference revisits the nodes that were added or have a modified input or output.
+TEST_F(GraphTest, GraphConstruction_IncrementalTypeInference) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto tensor_float_2x3 = tensor_float;
+  tensor_float_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  tensor_float_2x3.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_float_2x3);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+  auto& z = graph.GetOrCreateNodeArg("z", nullptr);
+  graph.AddNode("relu_1", "Relu", "", {&x}, {&y});
+  graph.AddNode("relu_2", "Relu", "", {&y}, {&z});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto expect_2x3 = [](const NodeArg& node_arg) {
+    ASSERT_NE(node_arg.Shape(), nullptr);
+    ASSERT_EQ(node_arg.Shape()->dim_size(), 2);
+    EXPECT_EQ(node_arg.Shape()->dim(0).dim_value(), 2);
+    EXPECT_EQ(node_arg.Shape()->dim(1).dim_value(), 3);
+  };
+  expect_2x3(y);
+  expect_2x3(z);
+
+  // a modified output is inferred again by its producer
+  z.ClearShape();
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  expect_2x3(z);
+
+  // a new node is inferred
+  auto& w = graph.GetOrCreateNodeArg("w", nullptr);
+  graph.AddNode("relu_3", "Relu", "", {&y}, {&w});
+  ASSERT_STATUS_OK(graph.Resolve());
+  expect_2x3(w);
+  EXPECT_EQ(w.Type(), x.Type());
+}
+
 TEST_F(GraphTest, GraphConstruction_VerifyNodeAndOpMatch) {
   Model model("graph_1", false, *logger_);
   auto& graph = model.MainGraph();
@@ -1854,6 +1919,54 @@ TEST_F(GraphTest, InjectExternalInitializedTensors) {
 }
 #endif
 
+TEST_F(GraphTest, MoveInitializerDataToOrtValues) {
+  std::vector<float> large_data(64);
+  std::iota(large_data.begin(), large_data.end(), 0.5f);
+  const std::vector<float> small_data{1.f, 2.f};
+
+  auto create_tensor_proto = [](const std::string& name, const std::vector<float>& data) {
+    ONNX_NAMESPACE::TensorProto tensor_proto;
+    tensor_proto.set_name(name);
+    tensor_proto.add_dims(data.size());
+    tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    utils::SetRawDataInTensorProto(tensor_proto, data.data(), data.size() * sizeof(float));
+    return tensor_proto;
+  };
+
+  Model m{"test_model", false, *logger_};
+  Graph& graph = m.MainGraph();
+  graph.AddInitializedTensor(create_tensor_proto("large", large_data));
+  graph.AddInitializedTensor(create_tensor_proto("small", small_data));
+
+  ASSERT_STATUS_OK(graph.MoveInitializerDataToOrtValues());
+
+  // the large initializer now refers to the data owned by its OrtValue
+  const TensorProto* large = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("large", large));
+  ASSERT_NE(large, nullptr);
+  ASSERT_TRUE(utils::HasExternalDataInMemory(*large));
+
+  OrtValue large_value;
+  ASSERT_TRUE(graph.GetOrtValueInitializer("large", large_value, false));
+  const auto large_span = large_value.Get<Tensor>().DataAsSpan<float>();
+  ASSERT_EQ(std::vector<float>(large_span.begin(), large_span.end()), large_data);
+
+  // the small initializer keeps its data inline
+  const TensorProto* small = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("small", small));
+  ASSERT_NE(small, nullptr);
+  ASSERT_TRUE(utils::HasRawData(*small));
+
+  OrtValue small_value;
+  ASSERT_FALSE(graph.GetOrtValueInitializer("small", small_value, false));
+
+  // serializing the graph inlines the data again
+  const auto graph_proto = graph.ToGraphProto();
+  for (const auto& initializer : graph_proto.initializer()) {
+    ASSERT_TRUE(utils::HasRawData(initializer)) << initializer.name();
+  }
+}
+
 TEST_F(GraphTest, AddRemoveInitializerHandling) {
   Model m{"test_model", false, *logger_};
   Graph& graph = m.MainGraph();
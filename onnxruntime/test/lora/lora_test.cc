@@ -199,6 +199,42 @@ TEST(LoraAdapterTest, Load) {
   }
 }
 
+TEST(LoraAdapterTest, Stack) {
+  lora::LoraAdapter adapter_1;
+  adapter_1.Load(GenerateTestParameters<float>()());
+  lora::LoraAdapter adapter_2;
+  adapter_2.Load(GenerateTestParameters<float>()());
+
+  const std::array<const lora::LoraAdapter*, 3> adapters = {&adapter_1, &adapter_2, &adapter_1};
+  auto stacked = lora::LoraAdapter::Stack(adapters, nullptr);
+  ASSERT_EQ(kAdapterVersion, stacked.AdapterVersion());
+  ASSERT_EQ(kModelVersion, stacked.ModelVersion());
+  ASSERT_EQ(2U, stacked.GetParamNum());
+
+  auto [begin, end] = stacked.GetParamIterators();
+  for (; begin != end; ++begin) {
+    const auto& [name, param] = *begin;
+    const auto& tensor = param.GetDeviceOrMapped().Get<Tensor>();
+    ASSERT_EQ(TensorShape({3, 8, 4}), tensor.Shape());
+
+    const float offset = name == "param_1" ? 0.f : 32.f;
+    const auto data = tensor.DataAsSpan<float>();
+    for (size_t i = 0; i < data.size(); ++i) {
+      ASSERT_EQ(offset + static_cast<float>(i % 32), data[i]);
+    }
+  }
+
+  // the adapters must have the same parameters
+  lora::LoraAdapter other;
+  adapters::utils::AdapterFormatBuilder adapter_builder;
+  const auto param = CreateParam<float>()();
+  adapter_builder.AddParameter("param_1", adapters::TensorDataType::FLOAT, param_shape,
+                               ReinterpretAsSpan<const uint8_t>(gsl::make_span(param)));
+  other.Load(adapter_builder.Finish(kAdapterVersion, kModelVersion));
+  const std::array<const lora::LoraAdapter*, 2> mismatched = {&adapter_1, &other};
+  ASSERT_THROW(lora::LoraAdapter::Stack(mismatched, nullptr), OnnxRuntimeException);
+}
+
 #ifdef USE_CUDA
 TEST(LoraAdapterTest, VerifyDeviceCopy) {
   auto cpu_ep = DefaultCpuExecutionProvider();
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+void FLASH_ATTENTION(benchmark::State& state, bool causal) {
+  const int batch_size = static_cast<int>(state.range(0));
+  const int num_heads = static_cast<int>(state.range(1));
+  const int sequence_length = static_cast<int>(state.range(2));
+  const int head_size = static_cast<int>(state.range(3));
+  const int threads = static_cast<int>(state.range(4));
+  if (batch_size <= 0 || num_heads <= 0 || sequence_length <= 0 || head_size <= 0 || threads <= 0) {
+    throw std::invalid_argument("All arguments must be greater than 0!");
+  }
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = threads;
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  const size_t count = static_cast<size_t>(batch_size) * num_heads * sequence_length * head_size;
+  auto query = RandomVectorUniform(count, -1.0f, 1.0f);
+  auto key = RandomVectorUniform(count, -1.0f, 1.0f);
+  auto value = RandomVectorUniform(count, -1.0f, 1.0f);
+  std::vector<float> output(count);
+
+  // the block sizes picked by the attention kernels for a 1MB L2 cache
+  constexpr int l2_cache_size = 1 << 20;
+  MlasFlashAttentionThreadedArgs args;
+  args.batch_size = batch_size;
+  args.num_heads = num_heads;
+  args.q_sequence_length = sequence_length;
+  args.kv_sequence_length = sequence_length;
+  args.qk_head_size = head_size;
+  args.v_head_size = head_size;
+  args.kv_block_size = std::max(l2_cache_size / (static_cast<int>(sizeof(float)) * 4 * (2 * head_size)), 1);
+  args.q_block_size = std::min({args.kv_block_size, 2 * head_size, sequence_length});
+  args.kv_block_size = std::min(args.kv_block_size, sequence_length);
+  args.scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  args.causal = causal;
+  args.thread_count = onnxruntime::concurrency::ThreadPool::DegreeOfParallelism(tp.get());
+  args.buffer_size_per_thread = (static_cast<size_t>(args.q_block_size) * 2 +
+                                 static_cast<size_t>(args.q_block_size) * args.kv_block_size +
+                                 static_cast<size_t>(args.q_block_size) * args.v_head_size) *
+                                sizeof(float);
+  std::vector<float> buffer(args.buffer_size_per_thread / sizeof(float) * args.thread_count);
+  args.buffer = buffer.data();
+  args.query = query.data();
+  args.key = key.data();
+  args.value = value.data();
+  args.output = output.data();
+
+  // warm up run
+  MlasFlashAttention(&args, tp.get());
+
+  for (auto _ : state) {
+    MlasFlashAttention(&args, tp.get());
+  }
+
+  // Q x K' and the probabilities x V, about half of them skipped when causal
+  const double flops = 4.0 * batch_size * num_heads * static_cast<double>(sequence_length) * sequence_length *
+                       head_size * (causal ? 0.5 : 1.0);
+  ReportRoofline(state, flops, sizeof(float) * 4.0 * static_cast<double>(count));
+}
+
+static void FlashAttentionArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"B", "N", "S", "H", "Threads"});
+  b->ArgsProduct({{1}, {12, 32}, {128, 512, 2048}, {64, 128}, {1, 8}});
+}
+
+BENCHMARK_CAPTURE(FLASH_ATTENTION, NonCausal, false)->Apply(FlashAttentionArgs)->UseRealTime();
+BENCHMARK_CAPTURE(FLASH_ATTENTION, Causal, true)->Apply(FlashAttentionArgs)->UseRealTime();
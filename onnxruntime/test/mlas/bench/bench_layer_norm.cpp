@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+// normalizes rows of N elements one after the other, as the LayerNormalization kernels do in each thread
+template <typename T>
+void LAYER_NORM(benchmark::State& state, bool simplified, bool skip) {
+  const int64_t rows = state.range(0);
+  const int64_t n = state.range(1);
+  if (rows <= 0 || n <= 0) {
+    throw std::invalid_argument("Rows and N must be greater than 0!");
+  }
+
+  const size_t count = static_cast<size_t>(rows * n);
+  auto input_float = RandomVectorUniform(count, -1.0f, 1.0f);
+  auto skip_float = RandomVectorUniform(count, -1.0f, 1.0f);
+  std::vector<T> input(count), skip_input(count), output(count), sum_output(count);
+  for (size_t i = 0; i < count; i++) {
+    input[i] = static_cast<T>(input_float[i]);
+    skip_input[i] = static_cast<T>(skip_float[i]);
+  }
+  auto scale = RandomVectorUniform(static_cast<size_t>(n), 0.5f, 1.5f);
+  auto shift = RandomVectorUniform(static_cast<size_t>(n), -0.5f, 0.5f);
+
+  auto run = [&]() {
+    for (int64_t row = 0; row < rows; row++) {
+      const size_t offset = static_cast<size_t>(row * n);
+      MlasLayerNormOneRow<T>(input.data() + offset, skip ? skip_input.data() + offset : nullptr, nullptr,
+                             scale.data(), simplified ? nullptr : shift.data(), static_cast<size_t>(n), 1e-5f,
+                             simplified, output.data() + offset, skip ? sum_output.data() + offset : nullptr,
+                             nullptr, nullptr);
+    }
+  };
+
+  // warm up run
+  run();
+
+  for (auto _ : state) {
+    run();
+  }
+
+  // the rows are read and written, with the skip rows and their sums if any
+  ReportRoofline(state, 0, sizeof(T) * static_cast<double>(count) * (skip ? 4 : 2));
+}
+
+static void LayerNormArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"Rows", "N"});
+  b->ArgsProduct({{1, 128, 2048}, {768, 4096}});
+}
+
+BENCHMARK_CAPTURE(LAYER_NORM<float>, LayerNorm, false, false)->Apply(LayerNormArgs)->UseRealTime();
+BENCHMARK_CAPTURE(LAYER_NORM<float>, RmsNorm, true, false)->Apply(LayerNormArgs)->UseRealTime();
+BENCHMARK_CAPTURE(LAYER_NORM<float>, SkipLayerNorm, false, true)->Apply(LayerNormArgs)->UseRealTime();
+BENCHMARK_CAPTURE(LAYER_NORM<MLAS_FP16>, LayerNorm, false, false)->Apply(LayerNormArgs)->UseRealTime();
+BENCHMARK_CAPTURE(LAYER_NORM<MLAS_FP16>, SkipLayerNorm, false, true)->Apply(LayerNormArgs)->UseRealTime();
@@ -3,4 +3,23 @@
 
 #include <benchmark/benchmark.h>
 
-BENCHMARK_MAIN();
+#include <cstdlib>
+
+int main(int argc, char** argv) {
+  // The MLAS dispatch can be capped to an older instruction set with MLAS_MAX_ISA (sse, avx, avx2, avx512 or amx
+  // on x64, neon, dot or i8mm on arm64), so running the benchmarks once per value compares the kernel paths of
+  // each instruction set on the same machine. The cap is recorded in the context of the results.
+#if defined(_MSC_VER)
+#pragma warning(suppress : 4996)
+#endif
+  const char* max_isa = std::getenv("MLAS_MAX_ISA");
+  benchmark::AddCustomContext("mlas_max_isa", max_isa != nullptr ? max_isa : "native");
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <stdexcept>
+
+// 2D convolution of a single image already in the NCHWc layout, with a square kernel padded to keep the size
+void NCHWC_CONV(benchmark::State& state) {
+  const int64_t channels = state.range(0);
+  const int64_t size = state.range(1);
+  const int64_t filters = state.range(2);
+  const int64_t kernel = state.range(3);
+  const int64_t stride = state.range(4);
+  const int64_t threads = state.range(5);
+
+  if (channels <= 0 || size <= 0 || filters <= 0 || kernel <= 0 || stride <= 0 || threads <= 0) {
+    throw std::invalid_argument("All arguments must be greater than 0!");
+  }
+  const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  if (block_size <= 1) {
+    state.SkipWithError("The NCHWc layout is not supported on this platform");
+    return;
+  }
+  if (channels % block_size != 0 || filters % block_size != 0) {
+    state.SkipWithError("C and F must be multiples of the NCHWc block size");
+    return;
+  }
+
+  const int64_t padding = kernel / 2;
+  const int64_t output_size = (size + 2 * padding - kernel) / stride + 1;
+  const int64_t input_shape[] = {1, channels, size, size};
+  const int64_t filter_shape[] = {filters, channels, kernel, kernel};
+  const int64_t output_shape[] = {1, filters, output_size, output_size};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t dilation_shape[] = {1, 1};
+  const int64_t paddings[] = {padding, padding, padding, padding};
+  const int64_t stride_shape[] = {stride, stride};
+
+  auto input = RandomVectorUniform(static_cast<size_t>(channels * size * size), -1.0f, 1.0f);
+  auto filter = RandomVectorUniform(static_cast<size_t>(filters * channels * kernel * kernel), -1.0f, 1.0f);
+  auto bias = RandomVectorUniform(static_cast<size_t>(filters), -1.0f, 1.0f);
+  std::vector<float> reordered_filter(filter.size());
+  MlasReorderFilterOIHWBiBo(filter_shape, filter.data(), reordered_filter.data());
+  std::vector<float> output(static_cast<size_t>(filters * output_size * output_size));
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasIdentityActivation;
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto run = [&]() {
+    MlasNchwcConv(input_shape, kernel_shape, dilation_shape, paddings, stride_shape, output_shape, 1,
+                  input.data(), reordered_filter.data(), bias.data(), output.data(), &activation, true, tp.get());
+  };
+
+  // warm up run
+  run();
+
+  for (auto _ : state) {
+    run();
+  }
+
+  ReportRoofline(state, 2.0 * static_cast<double>(output.size()) * static_cast<double>(channels * kernel * kernel),
+                 sizeof(float) * static_cast<double>(input.size() + filter.size() + output.size()));
+}
+
+static void NchwcConvArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"C", "HW", "F", "K", "S", "Threads"});
+  b->ArgsProduct({{64, 256}, {14, 56}, {64, 256}, {1, 3}, {1, 2}, {1, 8}});
+}
+
+BENCHMARK(NCHWC_CONV)->Apply(NchwcConvArgs)->UseRealTime();
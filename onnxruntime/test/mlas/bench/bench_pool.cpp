@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <stdexcept>
+
+static std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreatePoolThreadPool(int64_t threads) {
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(threads);
+  tpo.auto_set_affinity = true;
+  return std::unique_ptr<onnxruntime::concurrency::ThreadPool>(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+}
+
+// 2D pooling of a single image with a square kernel, in the NCHW layout or in the NCHWc layout
+void POOL(benchmark::State& state, MLAS_POOLING_KIND kind, bool nchwc) {
+  const int64_t channels = state.range(0);
+  const int64_t size = state.range(1);
+  const int64_t kernel = state.range(2);
+  const int64_t stride = state.range(3);
+  const int64_t threads = state.range(4);
+
+  if (channels <= 0 || size <= 0 || kernel <= 0 || stride <= 0 || threads <= 0) {
+    throw std::invalid_argument("All arguments must be greater than 0!");
+  }
+  if (nchwc) {
+    const int64_t block_size = static_cast<int64_t>(MlasNchwcGetBlockSize());
+    if (block_size <= 1) {
+      state.SkipWithError("The NCHWc layout is not supported on this platform");
+      return;
+    }
+    if (channels % block_size != 0) {
+      state.SkipWithError("C must be a multiple of the NCHWc block size");
+      return;
+    }
+  }
+
+  const int64_t output_size = (size - kernel) / stride + 1;
+  const int64_t input_shape[] = {1, channels, size, size};
+  const int64_t output_shape[] = {1, channels, output_size, output_size};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t dilation_shape[] = {1, 1};
+  const int64_t paddings[] = {0, 0, 0, 0};
+  const int64_t stride_shape[] = {stride, stride};
+
+  auto input = RandomVectorUniform(static_cast<size_t>(channels * size * size), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(channels * output_size * output_size));
+  auto tp = CreatePoolThreadPool(threads);
+
+  auto run = [&]() {
+    if (nchwc) {
+      MlasNchwcPool(kind, input_shape, kernel_shape, dilation_shape, paddings, stride_shape, output_shape,
+                    input.data(), output.data(), tp.get());
+    } else {
+      MlasPool(kind, 2, input_shape, kernel_shape, paddings, stride_shape, output_shape,
+               input.data(), output.data(), tp.get());
+    }
+  };
+
+  // warm up run
+  run();
+
+  for (auto _ : state) {
+    run();
+  }
+
+  ReportRoofline(state, static_cast<double>(output.size()) * static_cast<double>(kernel * kernel),
+                 sizeof(float) * static_cast<double>(input.size() + output.size()));
+}
+
+static void PoolArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"C", "HW", "K", "S", "Threads"});
+  b->ArgsProduct({{64, 256}, {14, 56, 112}, {2, 3}, {1, 2}, {1, 8}});
+}
+
+BENCHMARK_CAPTURE(POOL, MaxPool_NCHW, MlasMaximumPooling, false)->Apply(PoolArgs)->UseRealTime();
+BENCHMARK_CAPTURE(POOL, AveragePool_NCHW, MlasAveragePoolingExcludePad, false)->Apply(PoolArgs)->UseRealTime();
+BENCHMARK_CAPTURE(POOL, MaxPool_NCHWc, MlasMaximumPooling, true)->Apply(PoolArgs)->UseRealTime();
+BENCHMARK_CAPTURE(POOL, AveragePool_NCHWc, MlasAveragePoolingExcludePad, true)->Apply(PoolArgs)->UseRealTime();
@@ -99,6 +99,9 @@ void SGEMM(benchmark::State& state, bool pack_b, bool trans_a, bool trans_b, flo
           tp.get());
     }
   }
+
+  ReportRoofline(state, 2.0 * static_cast<double>(M) * N * K,
+                 sizeof(float) * static_cast<double>(M * K + N * K + M * N));
 }
 
 static void GemmSizeWithOne(benchmark::internal::Benchmark* b) {
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+// the element-wise functions read and write each element once, so GB/s is their figure of merit
+void TRANSCENDENTAL(benchmark::State& state, void (*function)(const float*, float*, size_t)) {
+  const int64_t n = state.range(0);
+  if (n <= 0) {
+    throw std::invalid_argument("N must be greater than 0!");
+  }
+
+  auto input = RandomVectorUniform(static_cast<size_t>(n), -5.0f, 5.0f);
+  std::vector<float> output(input.size());
+
+  // warm up run
+  function(input.data(), output.data(), input.size());
+
+  for (auto _ : state) {
+    function(input.data(), output.data(), input.size());
+  }
+
+  ReportRoofline(state, 0, 2.0 * sizeof(float) * static_cast<double>(input.size()));
+}
+
+static void ComputeErf(const float* input, float* output, size_t n) {
+  MlasComputeErf(input, output, n);
+}
+
+static void ComputeTanh(const float* input, float* output, size_t n) {
+  MlasComputeTanh(input, output, n);
+}
+
+static void ComputeLogistic(const float* input, float* output, size_t n) {
+  MlasComputeLogistic(input, output, n);
+}
+
+static void ComputeExp(const float* input, float* output, size_t n) {
+  MlasComputeExp(input, output, n);
+}
+
+static void TranscendentalArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N"});
+  b->ArgsProduct({{1024, 16384, 262144, 4194304}});
+}
+
+BENCHMARK_CAPTURE(TRANSCENDENTAL, Erf, ComputeErf)->Apply(TranscendentalArgs)->UseRealTime();
+BENCHMARK_CAPTURE(TRANSCENDENTAL, Tanh, ComputeTanh)->Apply(TranscendentalArgs)->UseRealTime();
+BENCHMARK_CAPTURE(TRANSCENDENTAL, Logistic, ComputeLogistic)->Apply(TranscendentalArgs)->UseRealTime();
+BENCHMARK_CAPTURE(TRANSCENDENTAL, Exp, ComputeExp)->Apply(TranscendentalArgs)->UseRealTime();
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <stdexcept>
+
+template <typename T>
+void TRANSPOSE(benchmark::State& state) {
+  const int64_t m = state.range(0);
+  const int64_t n = state.range(1);
+  const int64_t threads = state.range(2);
+  if (m <= 0 || n <= 0 || threads <= 0) {
+    throw std::invalid_argument("M, N and Threads must be greater than 0!");
+  }
+
+  std::vector<T> input(static_cast<size_t>(m * n));
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = static_cast<T>(i);
+  }
+  std::vector<T> output(input.size());
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  // warm up run
+  MlasTranspose(input.data(), output.data(), static_cast<size_t>(m), static_cast<size_t>(n), tp.get());
+
+  for (auto _ : state) {
+    MlasTranspose(input.data(), output.data(), static_cast<size_t>(m), static_cast<size_t>(n), tp.get());
+  }
+
+  ReportRoofline(state, 0, 2.0 * sizeof(T) * static_cast<double>(input.size()));
+}
+
+static void TransposeArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "N", "Threads"});
+  b->ArgsProduct({{64, 512, 4096}, {64, 512, 4096}, {1, 8}});
+}
+
+BENCHMARK(TRANSPOSE<float>)->Apply(TransposeArgs)->UseRealTime();
+BENCHMARK(TRANSPOSE<uint16_t>)->Apply(TransposeArgs)->UseRealTime();
+BENCHMARK(TRANSPOSE<uint8_t>)->Apply(TransposeArgs)->UseRealTime();
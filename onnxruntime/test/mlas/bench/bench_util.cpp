@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "bench_util.h"
+#include <cstdlib>
 #include <numeric>
 #include <stdexcept>
 
@@ -22,3 +23,34 @@ std::vector<float> RandomVectorUniform(std::vector<int64_t> shape, float min_val
   }
   return RandomVectorUniform(static_cast<size_t>(sz), min_value, max_value);
 }
+
+static double GetPeakFromEnvironment(const char* name) {
+#if defined(_MSC_VER)
+#pragma warning(suppress : 4996)
+#endif
+  const char* value = std::getenv(name);
+  return value != nullptr ? std::atof(value) : 0.0;
+}
+
+void ReportRoofline(benchmark::State& state, double flops_per_iteration, double bytes_per_iteration) {
+  static const double peak_gflops = GetPeakFromEnvironment("MLAS_BENCH_PEAK_GFLOPS");
+  static const double peak_gbps = GetPeakFromEnvironment("MLAS_BENCH_PEAK_GBPS");
+
+  // the rate counters are divided by the elapsed time of the benchmark, so the percentages are rates too
+  constexpr auto kRate = benchmark::Counter::kIsIterationInvariantRate;
+  if (flops_per_iteration > 0) {
+    state.counters["FLOP/s"] = benchmark::Counter(flops_per_iteration, kRate, benchmark::Counter::kIs1000);
+    if (peak_gflops > 0) {
+      state.counters["PeakFLOP%"] = benchmark::Counter(flops_per_iteration / (peak_gflops * 1e7), kRate);
+    }
+  }
+  if (bytes_per_iteration > 0) {
+    state.counters["Bytes/s"] = benchmark::Counter(bytes_per_iteration, kRate, benchmark::Counter::kIs1000);
+    if (peak_gbps > 0) {
+      state.counters["PeakBW%"] = benchmark::Counter(bytes_per_iteration / (peak_gbps * 1e7), kRate);
+    }
+    if (flops_per_iteration > 0) {
+      state.counters["FLOP/Byte"] = flops_per_iteration / bytes_per_iteration;
+    }
+  }
+}
@@ -52,3 +52,8 @@ RandomVectorUniform(
 std::vector<float> RandomVectorUniform(std::vector<int64_t> shape, float min_value, float max_value);
 
 std::vector<int64_t> BenchArgsVector(benchmark::State& state, size_t& start, size_t count);
+
+// Reports the achieved FLOP/s and bytes/s of a benchmark as counters, for a roofline analysis. If the machine peaks
+// are given by the MLAS_BENCH_PEAK_GFLOPS and MLAS_BENCH_PEAK_GBPS environment variables, the percentage of them
+// achieved is reported too. Call after the benchmark loop.
+void ReportRoofline(benchmark::State& state, double flops_per_iteration, double bytes_per_iteration);
@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+//
+// The Winograd algorithm rounds differently from the direct convolution, so
+// the output is compared against the reference with a tolerance.
+//
+
+template <bool Threaded>
+class MlasConv2DWinogradTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferWorking;
+
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t BatchCount,
+            size_t GroupCount,
+            size_t InputChannels,
+            size_t InputHeight,
+            size_t InputWidth,
+            size_t FilterCount,
+            size_t Padding,
+            float Beta) {
+    const size_t OutputHeight = InputHeight + 2 * Padding - 2;
+    const size_t OutputWidth = InputWidth + 2 * Padding - 2;
+    const size_t InputSize = InputHeight * InputWidth;
+    const size_t OutputSize = OutputHeight * OutputWidth;
+
+    const size_t InputElements = BatchCount * GroupCount * InputChannels * InputSize;
+    const size_t FilterElements = GroupCount * FilterCount * InputChannels * 9;
+    const size_t OutputElements = BatchCount * GroupCount * FilterCount * OutputSize;
+
+    const float* Input = BufferInput.GetBuffer(InputElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterElements);
+    const float* Bias = BufferBias.GetBuffer(GroupCount * FilterCount);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      Output[i] = float(int(i % 13) - 6) * 0.25f;
+      OutputReference[i] = Output[i];
+    }
+
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {3, 3};
+    int64_t DilationShape[] = {1, 1};
+    int64_t PaddingShape[] = {int64_t(Padding), int64_t(Padding), int64_t(Padding), int64_t(Padding)};
+    int64_t StrideShape[] = {1, 1};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasIdentityActivation;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters, 2, BatchCount, GroupCount, InputChannels, InputShape, KernelShape,
+                    DilationShape, PaddingShape, StrideShape, OutputShape, FilterCount, &Activation,
+                    &WorkingBufferSize, Beta, true, threadpool_);
+
+    ASSERT_EQ(Parameters.Algorithm, MlasConvAlgorithmWinograd);
+
+    float* PackedFilter =
+        BufferPackedFilter.GetBuffer(MlasConvWinogradPackedFilterSize(GroupCount, InputChannels, FilterCount));
+    MlasConvWinogradPackFilter(GroupCount, InputChannels, FilterCount, Filter, PackedFilter);
+
+    MlasConv(&Parameters, Input, PackedFilter, Bias, BufferWorking.GetBuffer(WorkingBufferSize), Output,
+             threadpool_);
+
+    for (size_t bg = 0; bg < BatchCount * GroupCount; bg++) {
+      const size_t g = bg % GroupCount;
+      for (size_t f = 0; f < FilterCount; f++) {
+        for (size_t oh = 0; oh < OutputHeight; oh++) {
+          for (size_t ow = 0; ow < OutputWidth; ow++) {
+            double sum = Bias[g * FilterCount + f];
+            for (size_t c = 0; c < InputChannels; c++) {
+              const float* input = Input + (bg * InputChannels + c) * InputSize;
+              const float* filter = Filter + ((g * FilterCount + f) * InputChannels + c) * 9;
+              for (size_t ky = 0; ky < 3; ky++) {
+                size_t ih = oh + ky - Padding;
+                for (size_t kx = 0; kx < 3; kx++) {
+                  size_t iw = ow + kx - Padding;
+                  if (ih < InputHeight && iw < InputWidth) {
+                    sum += double(input[ih * InputWidth + iw]) * double(filter[ky * 3 + kx]);
+                  }
+                }
+              }
+            }
+            float& reference = OutputReference[(bg * FilterCount + f) * OutputSize + oh * OutputWidth + ow];
+            reference = float(sum) + Beta * reference;
+          }
+        }
+      }
+    }
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      ASSERT_NEAR(Output[i], OutputReference[i], 1e-3f * (1.0f + std::fabs(OutputReference[i])))
+          << "B" << BatchCount << "/G" << GroupCount << "/Cpg" << InputChannels << "/Fpg" << FilterCount
+          << "/H" << InputHeight << "/W" << InputWidth << "/Pad" << Padding << "/Beta" << Beta << " @" << i;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Conv2dWinograd_Threaded" : "Conv2dWinograd_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasConv2DWinogradTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    Test(1, 1, 32, 14, 14, 32, 1, 0.0f);
+    Test(2, 1, 32, 15, 17, 32, 1, 1.0f);
+    Test(1, 2, 32, 9, 28, 32, 0, 0.0f);
+    Test(1, 1, 64, 56, 56, 64, 1, 0.0f);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <typename T>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  void
+  Test(size_t N, bool simplified, bool with_skip, bool with_bias) {
+    std::vector<float> input_f(N), skip_f(N), bias(N), scale(N), shift(N);
+    for (size_t i = 0; i < N; i++) {
+      // a large offset checks that the variance survives the cancellation
+      input_f[i] = 100.0f + static_cast<float>(static_cast<int>(i * 7 % 13) - 6) * 0.125f;
+      skip_f[i] = static_cast<float>(static_cast<int>(i * 5 % 11) - 5) * 0.0625f;
+      bias[i] = static_cast<float>(static_cast<int>(i % 3) - 1) * 0.25f;
+      scale[i] = 0.5f + static_cast<float>(i % 4) * 0.25f;
+      shift[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.5f;
+    }
+
+    std::vector<T> input(N), skip(N), output(N), sum_output(N);
+    for (size_t i = 0; i < N; i++) {
+      input[i] = T(input_f[i]);
+      skip[i] = T(skip_f[i]);
+      input_f[i] = static_cast<float>(input[i]);
+      skip_f[i] = static_cast<float>(skip[i]);
+    }
+
+    // reference in double precision
+    std::vector<double> x(N);
+    double sum = 0.0;
+    for (size_t i = 0; i < N; i++) {
+      x[i] = input_f[i] + (with_skip ? skip_f[i] : 0.0) + (with_bias ? bias[i] : 0.0);
+      sum += x[i];
+    }
+    const double mean = simplified ? 0.0 : sum / N;
+    double sum_squares = 0.0;
+    for (size_t i = 0; i < N; i++) {
+      sum_squares += (x[i] - mean) * (x[i] - mean);
+    }
+    const double epsilon = 1e-5;
+    const double inv_std_dev = 1.0 / std::sqrt(sum_squares / N + epsilon);
+
+    float mean_out = -1.0f;
+    float inv_std_dev_out = -1.0f;
+    MlasLayerNormOneRow(input.data(), with_skip ? skip.data() : nullptr, with_bias ? bias.data() : nullptr,
+                        scale.data(), shift.data(), N, static_cast<float>(epsilon), simplified, output.data(),
+                        sum_output.data(), &mean_out, &inv_std_dev_out);
+
+    const float tolerance = std::is_same<T, float>::value ? 1e-4f : 1e-2f;
+    if (!simplified) {
+      ASSERT_NEAR(mean_out, mean, 1e-4 * std::fabs(mean)) << "N=" << N;
+    }
+    ASSERT_NEAR(inv_std_dev_out, inv_std_dev, 1e-3 * inv_std_dev) << "N=" << N << " simplified=" << simplified;
+
+    for (size_t i = 0; i < N; i++) {
+      const double expected = (x[i] - mean) * inv_std_dev * scale[i] + (simplified ? 0.0 : shift[i]);
+      ASSERT_NEAR(static_cast<float>(output[i]), expected, tolerance * (1.0 + std::fabs(expected)))
+          << "@" << i << " N=" << N << " simplified=" << simplified << " skip=" << with_skip
+          << " bias=" << with_bias;
+      ASSERT_NEAR(static_cast<float>(sum_output[i]), x[i], tolerance * (1.0 + std::fabs(x[i]))) << "@" << i;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("LayerNorm_") +
+                                          (std::is_same<T, float>::value ? "fp32" : "fp16");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t n : {1, 3, 4, 63, 64, 65, 200, 768}) {
+      for (bool simplified : {false, true}) {
+        Test(n, simplified, false, false);
+        Test(n, simplified, true, false);
+        Test(n, simplified, true, true);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<float>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<MLAS_FP16>>::RegisterShortExecute();
+  }
+  return count;
+});
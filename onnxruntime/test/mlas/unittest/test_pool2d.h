@@ -239,6 +239,7 @@ class MlasPool2DTest : public MlasTestBase {
                     for (unsigned p2 = 0; p2 < kh; p2++) {
                       for (unsigned p3 = 0; p3 < kw; p3++) {
                         Test(5, 3, is[ih], is[iw], kh, kw, p0, p1, p2, p3, sh, sw);
+                        Test(1, 1, is[ih], is[iw], kh, kw, p0, p1, p2, p3, sh, sw);
                       }
                     }
                   }
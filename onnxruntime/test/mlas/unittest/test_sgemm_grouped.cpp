@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <array>
+#include <vector>
+
+template <bool Threaded>
+class MlasSgemmGroupedTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(const std::vector<std::array<size_t, 3>>& Shapes, bool TransB, bool PackB) {
+    std::vector<std::vector<float>> A(Shapes.size());
+    std::vector<std::vector<float>> B(Shapes.size());
+    std::vector<std::vector<uint8_t>> PackedB(Shapes.size());
+    std::vector<std::vector<float>> C(Shapes.size());
+    std::vector<MLAS_SGEMM_GROUPED_PARAMS> Problems(Shapes.size());
+
+    std::default_random_engine generator(static_cast<unsigned>(Shapes.size()));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    for (size_t i = 0; i < Shapes.size(); i++) {
+      const size_t M = Shapes[i][0];
+      const size_t N = Shapes[i][1];
+      const size_t K = Shapes[i][2];
+
+      A[i].resize(M * K);
+      B[i].resize(K * N);
+      C[i].resize(M * N);
+      for (auto& a : A[i]) a = distribution(generator);
+      for (auto& b : B[i]) b = distribution(generator);
+      for (auto& c : C[i]) c = distribution(generator);
+
+      MLAS_SGEMM_GROUPED_PARAMS& Problem = Problems[i];
+      Problem.TransB = TransB ? CblasTrans : CblasNoTrans;
+      Problem.M = M;
+      Problem.N = N;
+      Problem.K = K;
+      Problem.Data.A = A[i].data();
+      Problem.Data.lda = K;
+      Problem.Data.C = C[i].data();
+      Problem.Data.ldc = N;
+      Problem.Data.alpha = 0.5f;
+      Problem.Data.beta = (i % 2 == 0) ? 0.0f : 1.0f;
+
+      if (PackB) {
+        PackedB[i].resize(MlasGemmPackBSize(N, K));
+        MlasGemmPackB(Problem.TransB, N, K, B[i].data(), TransB ? K : N, PackedB[i].data());
+        Problem.Data.B = reinterpret_cast<const float*>(PackedB[i].data());
+        Problem.Data.BIsPacked = true;
+      } else {
+        Problem.Data.B = B[i].data();
+        Problem.Data.ldb = TransB ? K : N;
+      }
+    }
+
+    std::vector<std::vector<float>> Expected = C;
+
+    MlasGemmGrouped(Problems.data(), Problems.size(), threadpool_);
+
+    for (size_t i = 0; i < Shapes.size(); i++) {
+      const size_t M = Shapes[i][0];
+      const size_t N = Shapes[i][1];
+      const size_t K = Shapes[i][2];
+
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          double sum = 0.0;
+          for (size_t k = 0; k < K; k++) {
+            sum += double(A[i][m * K + k]) * double(TransB ? B[i][n * K + k] : B[i][k * N + n]);
+          }
+          float& expected = Expected[i][m * N + n];
+          expected = 0.5f * float(sum) + Problems[i].Data.beta * expected;
+          ASSERT_NEAR(C[i][m * N + n], expected, 1e-4f * (1.0f + std::fabs(expected)))
+              << "problem " << i << " M" << M << " N" << N << " K" << K << " @" << m << "," << n
+              << (TransB ? " TransB" : "") << (PackB ? " PackB" : "");
+        }
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SgemmGrouped_Threaded" : "SgemmGrouped_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasSgemmGroupedTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    // mixes of tiny and large problems, an empty problem and a single problem
+    const std::vector<std::vector<std::array<size_t, 3>>> Groups = {
+        {{1, 1, 1}},
+        {{64, 48, 96}, {3, 5, 7}, {0, 16, 16}, {128, 64, 64}, {17, 1, 33}},
+        {{256, 64, 128}, {256, 32, 128}, {256, 64, 128}},
+        {{5, 300, 40}, {40, 2, 300}, {16, 16, 1}, {1, 129, 65}},
+    };
+
+    for (const auto& Shapes : Groups) {
+      for (bool TransB : {false, true}) {
+        for (bool PackB : {false, true}) {
+          Test(Shapes, TransB, PackB);
+        }
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmGroupedTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSgemmGroupedTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -166,7 +166,62 @@ class MlasSoftmaxTest : public MlasTestBase {
     }
   }
 
-#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+  void TestMasked(size_t N, size_t D, bool LogSoftmax, bool Causal, float Softcap) {
+    float* Input = BufferInput.GetBuffer(N * D);
+    float* Output = BufferOutput.GetBuffer(N * D);
+    float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+
+    std::default_random_engine generator(static_cast<unsigned>(N * D));
+    std::uniform_real_distribution<float> distribution(-10.f, 10.f);
+
+    std::vector<float> Bias(N * D), Mask(N * D);
+    for (size_t nd = 0; nd < N * D; nd++) {
+      Input[nd] = distribution(generator);
+      Bias[nd] = distribution(generator) * 0.5f;
+      Mask[nd] = (nd % 7 == 3) ? -10000.0f : 0.0f;
+    }
+
+    MLAS_SOFTMAX_MASK_PARAMS MaskParams;
+    MaskParams.Scale = 0.125f;
+    MaskParams.Bias = Bias.data();
+    MaskParams.Mask = Mask.data();
+    MaskParams.Softcap = Softcap;
+    MaskParams.Causal = Causal;
+    MaskParams.CausalOffset = D / 2;
+
+    MlasComputeSoftmax(Input, Output, N, D, LogSoftmax, false, &MaskParams, threadpool_);
+
+    // the reference transforms the rows, then computes the softmax of the columns up to the causal limit
+    std::vector<float> Row(D);
+    for (size_t n = 0; n < N; n++) {
+      const size_t RowD = Causal ? std::min(D, n + MaskParams.CausalOffset + 1) : D;
+      for (size_t d = 0; d < RowD; d++) {
+        float Value = Input[n * D + d] * MaskParams.Scale + Bias[n * D + d] + Mask[n * D + d];
+        Row[d] = Softcap > 0.0f ? Softcap * std::tanh(Value / Softcap) : Value;
+      }
+      ReferenceSoftmax(Row.data(), OutputReference + n * D, 1, RowD, LogSoftmax, false);
+      for (size_t d = RowD; d < D; d++) {
+        OutputReference[n * D + d] = LogSoftmax ? -std::numeric_limits<float>::infinity() : 0.0f;
+      }
+    }
+
+    constexpr float AbsoluteTolerance = 1e-5f;
+    constexpr float RelativeTolerance = 1e-5f;
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      if (std::isinf(OutputReference[nd])) {
+        ASSERT_EQ(Output[nd], OutputReference[nd]) << " @" << nd;
+        continue;
+      }
+      float diff = std::fabs(Output[nd] - OutputReference[nd]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(OutputReference[nd]) * RelativeTolerance)
+          << "Masked LogSoftmax:" << (int)LogSoftmax << " Causal:" << (int)Causal << " Softcap:" << Softcap
+          << " difference " << N << "/" << D << " @" << nd << ", got: " << Output[nd]
+          << ", expecting: " << OutputReference[nd];
+    }
+  }
+
+#if (defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)) || defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
   void TestReduceMaxFp16(size_t N, float MinimumValue, float MaximumValue) {
     MLAS_FP16* Input = BufferInputFp16.GetBuffer(N);
 
@@ -222,7 +277,7 @@ class MlasSoftmaxTest : public MlasTestBase {
           << ", got: " << out << ", expecting: " << ref << ", diff: " << diff << ", r-diff: " << diff / std::fabs(ref);
     }
   }
-#endif  // defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+#endif
 
   void ReferenceSoftmax(const float* Input, float* Output, size_t N, size_t D, bool LogSoftmax, bool SmoothSoftmax) {
     for (size_t n = 0; n < N; n++) {
@@ -279,32 +334,45 @@ class MlasSoftmaxTest : public MlasTestBase {
   void ExecuteShort(void) override {
     for (size_t d = 1; d < 128; d++) {
       Test(1, d, -10.f, 10.f);
-#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
-      TestReduceMaxFp16(d, -10.f, 10.f);
-      TestFp16(1, d, -10.f, 10.f, false, true);
-      TestFp16(1, d, -10.f, 10.f, true, true);
-      TestFp16(1, d, -10.f, 10.f, false, false);
-      TestFp16(1, d, -10.f, 10.f, true, false);
-#endif  // defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+#if (defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)) || defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+      if (MlasFp16SoftmaxSupported()) {
+        TestReduceMaxFp16(d, -10.f, 10.f);
+        TestFp16(1, d, -10.f, 10.f, false, true);
+        TestFp16(1, d, -10.f, 10.f, true, true);
+        TestFp16(1, d, -10.f, 10.f, false, false);
+        TestFp16(1, d, -10.f, 10.f, true, false);
+      }
+#endif
     }
 
     Test(3, 128, 20.f, 30.f);
     Test(63, 95, -150.f, 190.f);
     Test(16, 211, 20.f, 30.f);
-#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
-    TestFp16(3, 128, 3.f, 7.f, false, true);
-    TestFp16(3, 128, 3.f, 7.f, true, true);
-    TestFp16(3, 128, 3.f, 7.f, false, false);
-    TestFp16(3, 128, 3.f, 7.f, true, false);
-    TestFp16(63, 95, -15.f, 19.f, false, true);
-    TestFp16(63, 95, -15.f, 19.f, true, true);
-    TestFp16(63, 95, -15.f, 19.f, false, false);
-    TestFp16(63, 95, -15.f, 19.f, true, false);
-    TestFp16(16, 211, -7.f, -3.f, false, true);
-    TestFp16(16, 211, -7.f, -3.f, true, true);
-    TestFp16(16, 211, -7.f, -3.f, false, false);
-    TestFp16(16, 211, -7.f, -3.f, true, false);
-#endif  // defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+
+    for (size_t d : {1, 5, 64, 95}) {
+      for (bool log_softmax : {false, true}) {
+        for (bool causal : {false, true}) {
+          TestMasked(13, d, log_softmax, causal, 0.0f);
+          TestMasked(13, d, log_softmax, causal, 5.0f);
+        }
+      }
+    }
+#if (defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)) || defined(MLAS_AVX512FP16_INTRINSICS_SUPPORTED)
+    if (MlasFp16SoftmaxSupported()) {
+      TestFp16(3, 128, 3.f, 7.f, false, true);
+      TestFp16(3, 128, 3.f, 7.f, true, true);
+      TestFp16(3, 128, 3.f, 7.f, false, false);
+      TestFp16(3, 128, 3.f, 7.f, true, false);
+      TestFp16(63, 95, -15.f, 19.f, false, true);
+      TestFp16(63, 95, -15.f, 19.f, true, true);
+      TestFp16(63, 95, -15.f, 19.f, false, false);
+      TestFp16(63, 95, -15.f, 19.f, true, false);
+      TestFp16(16, 211, -7.f, -3.f, false, true);
+      TestFp16(16, 211, -7.f, -3.f, true, true);
+      TestFp16(16, 211, -7.f, -3.f, false, false);
+      TestFp16(16, 211, -7.f, -3.f, true, false);
+    }
+#endif
   }
 };
 
@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSparseGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void
+  Test(size_t M, size_t N, size_t K, size_t lda, size_t ldc, int density_percent) {
+    const float* A = BufferA.GetBuffer(M * lda);
+    float* C = BufferC.GetBuffer(M * ldc);
+    float* CReference = BufferCReference.GetBuffer(M * ldc);
+
+    // dense B with the given percentage of non-zero elements, and its column compressed form
+    std::vector<float> B(K * N);
+    std::vector<uint32_t> column_start(N + 1);
+    std::vector<uint32_t> row_indices;
+    std::vector<float> values;
+    for (size_t n = 0; n < N; n++) {
+      column_start[n] = static_cast<uint32_t>(values.size());
+      for (size_t k = 0; k < K; k++) {
+        if (static_cast<int>((k * 7 + n * 13) % 100) < density_percent) {
+          const float value = static_cast<float>(static_cast<int>((k + 3 * n) % 9) - 4) * 0.25f;
+          B[k * N + n] = value;
+          row_indices.push_back(static_cast<uint32_t>(k));
+          values.push_back(value);
+        }
+      }
+    }
+    column_start[N] = static_cast<uint32_t>(values.size());
+
+    MLAS_SGEMM_SPARSE_B SparseB;
+    SparseB.K = K;
+    SparseB.N = N;
+    SparseB.ColumnStart = column_start.data();
+    SparseB.RowIndices = row_indices.data();
+    SparseB.Values = values.data();
+
+    std::fill_n(C, M * ldc, -0.5f);
+    std::fill_n(CReference, M * ldc, -0.5f);
+
+    MlasSparseGemm(M, &SparseB, A, lda, C, ldc, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+          sum += A[m * lda + k] * B[k * N + n];
+        }
+        CReference[m * ldc + n] = sum;
+      }
+    }
+
+    for (size_t i = 0; i < M * ldc; i++) {
+      ASSERT_NEAR(C[i], CReference[i], 1e-4f * (1.0f + std::fabs(CReference[i])))
+          << " @" << i << " of [" << M << "," << N << "," << K << "], density " << density_percent << "%";
+    }
+  }
+
+ public:
+  MlasSparseGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("SparseGemm") +
+                                          std::string(Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t m : {1, 7, 8, 9, 33}) {
+      for (size_t n : {1, 5, 64}) {
+        for (size_t k : {1, 16, 70}) {
+          for (int density_percent : {0, 20, 50, 100}) {
+            Test(m, n, k, k, n, density_percent);
+          }
+        }
+      }
+    }
+
+    // leading dimensions larger than the matrices
+    Test(19, 24, 40, 45, 31, 25);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSparseGemmTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSparseGemmTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+"""Compares a run of the model suite benchmarks (BM_ModelSuite in model_suite.cc) with a baseline.
+
+Both files are the JSON output of onnxruntime_benchmark, written with --benchmark_out_format=json.
+The median real time of each benchmark is compared, and the script exits with 1 when any benchmark
+is slower than the baseline by the threshold or more.
+"""
+
+import argparse
+import json
+import sys
+
+_TIME_UNIT_SECONDS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def load_medians(path):
+    with open(path) as f:
+        data = json.load(f)
+
+    version = data.get("context", {}).get("model_suite_version")
+    medians = {}
+    for benchmark in data.get("benchmarks", []):
+        if not benchmark["run_name"].startswith("BM_ModelSuite/") or benchmark.get("aggregate_name") != "median":
+            continue
+        if benchmark.get("error_occurred"):
+            continue
+        medians[benchmark["run_name"]] = benchmark["real_time"] * _TIME_UNIT_SECONDS[benchmark["time_unit"]]
+    return version, medians
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="JSON output of the baseline run")
+    parser.add_argument("current", help="JSON output of the run to check")
+    parser.add_argument(
+        "--threshold", type=float, default=0.05, help="relative slowdown reported as a regression, 0.05 by default"
+    )
+    args = parser.parse_args()
+
+    baseline_version, baseline = load_medians(args.baseline)
+    current_version, current = load_medians(args.current)
+    if baseline_version != current_version:
+        print(f"model suite version {current_version} does not match the baseline version {baseline_version}")
+        return 2
+
+    regressions = 0
+    print(f"{'benchmark':<56} {'baseline ms':>12} {'current ms':>12} {'change':>8}")
+    for name in sorted(baseline.keys() | current.keys()):
+        if name not in current:
+            print(f"{name:<56} {baseline[name] * 1e3:>12.3f} {'missing':>12}")
+            continue
+        if name not in baseline:
+            print(f"{name:<56} {'missing':>12} {current[name] * 1e3:>12.3f}")
+            continue
+        change = current[name] / baseline[name] - 1.0
+        regressed = change >= args.threshold
+        regressions += regressed
+        print(
+            f"{name:<56} {baseline[name] * 1e3:>12.3f} {current[name] * 1e3:>12.3f} {change:>+8.1%}"
+            + ("  REGRESSION" if regressed else "")
+        )
+
+    if regressions:
+        print(f"{regressions} benchmark(s) regressed by {args.threshold:.0%} or more")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// A fixed suite of representative models run at fixed thread counts, to track the model level performance
+// across versions. The models are read from ../models/model_suite, or from the directory in the
+// ORT_MODEL_SUITE_DIR environment variable:
+//   bert_base.onnx          BERT base uncased exported from PyTorch, with symbolic batch_size and sequence_length
+//   resnet50.onnx           ResNet-50 v1 of the ONNX model zoo, with a symbolic batch dimension N
+//   gpt2_decoder_step.onnx  GPT-2 with past state exported by the transformers tools, run for one new token
+//   tree_ensemble.onnx      scikit-learn random forest regressor with 100 trees on 28 features, converted by
+//                           skl2onnx, with a symbolic batch dimension N
+//
+// A baseline is recorded with
+//   onnxruntime_benchmark --benchmark_filter=BM_ModelSuite --benchmark_out=baseline.json --benchmark_out_format=json
+// and a later run is compared with it by compare_model_suite.py, which fails on a slowdown of 5% or more of the
+// median of any model. Each benchmark is repeated so the median is stable.
+
+#include <benchmark/benchmark.h>
+#include <core/session/onnxruntime_cxx_api.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+namespace {
+
+// Bump when a model, its shapes or the thread counts change, so the results of different suites are not compared.
+constexpr const char* kModelSuiteVersion = "1";
+
+constexpr int kIntraOpThreadCounts[] = {1, 4};
+constexpr int kRepetitions = 10;
+
+struct SuiteModel {
+  std::string name;
+  std::string file;
+  // values of the symbolic dimensions of the inputs, the others are 1
+  std::vector<std::pair<std::string, int64_t>> dims;
+};
+
+const std::vector<SuiteModel>& GetModelSuite() {
+  static const std::vector<SuiteModel> suite = {
+      {"bert_base", "bert_base.onnx", {{"batch_size", 1}, {"sequence_length", 128}}},
+      {"resnet50", "resnet50.onnx", {{"N", 1}}},
+      {"gpt2_decoder_step",
+       "gpt2_decoder_step.onnx",
+       {{"batch_size", 1}, {"seq_len", 1}, {"past_seq_len", 128}, {"total_seq_len", 129}}},
+      {"tree_ensemble", "tree_ensemble.onnx", {{"N", 1000}}},
+  };
+  return suite;
+}
+
+std::filesystem::path GetModelSuiteDir() {
+#if defined(_MSC_VER)
+#pragma warning(suppress : 4996)
+#endif
+  const char* dir = std::getenv("ORT_MODEL_SUITE_DIR");
+  return dir != nullptr ? std::filesystem::path(dir) : std::filesystem::path("../models/model_suite");
+}
+
+// The inputs hold a fixed pattern for the floating point types and zeros for the others, which are valid indices
+// and masks.
+Ort::Value CreateInput(const Ort::ConstTensorTypeAndShapeInfo& info) {
+  std::vector<int64_t> shape = info.GetShape();
+  for (auto& dim : shape) {
+    if (dim < 0) {
+      dim = 1;
+    }
+  }
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  Ort::Value value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), info.GetElementType());
+  if (info.GetElementType() == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+    float* data = value.GetTensorMutableData<float>();
+    const size_t count = value.GetTensorTypeAndShapeInfo().GetElementCount();
+    for (size_t i = 0; i < count; ++i) {
+      data[i] = static_cast<float>(i % 7) * 0.125f;
+    }
+  } else {
+    std::memset(value.GetTensorMutableRawData(), 0, value.GetTensorSizeInBytes());
+  }
+  return value;
+}
+
+void BM_ModelSuite(benchmark::State& state, const SuiteModel* model, int intra_op_threads) {
+  const std::filesystem::path path = GetModelSuiteDir() / model->file;
+  if (!std::filesystem::exists(path)) {
+    state.SkipWithError(("model not found: " + path.string()).c_str());
+    return;
+  }
+
+  Ort::SessionOptions options;
+  options.SetIntraOpNumThreads(intra_op_threads);
+  options.SetInterOpNumThreads(1);
+  options.SetExecutionMode(ORT_SEQUENTIAL);
+  options.SetGraphOptimizationLevel(ORT_ENABLE_ALL);
+  for (const auto& [name, value] : model->dims) {
+    options.AddFreeDimensionOverrideByName(name.c_str(), value);
+  }
+
+  OrtSession* raw_session = nullptr;
+  if (OrtStatus* status = g_ort->CreateSession(env, path.c_str(), options, &raw_session); status != nullptr) {
+    state.SkipWithError(g_ort->GetErrorMessage(status));
+    g_ort->ReleaseStatus(status);
+    return;
+  }
+  Ort::Session session{raw_session};
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  std::vector<Ort::AllocatedStringPtr> names;
+  std::vector<const char*> input_names;
+  std::vector<Ort::Value> inputs;
+  for (size_t i = 0; i < session.GetInputCount(); ++i) {
+    names.push_back(session.GetInputNameAllocated(i, allocator));
+    input_names.push_back(names.back().get());
+    inputs.push_back(CreateInput(session.GetInputTypeInfo(i).GetTensorTypeAndShapeInfo()));
+  }
+  std::vector<const char*> output_names;
+  for (size_t i = 0; i < session.GetOutputCount(); ++i) {
+    names.push_back(session.GetOutputNameAllocated(i, allocator));
+    output_names.push_back(names.back().get());
+  }
+
+  auto run = [&]() {
+    return session.Run(Ort::RunOptions{nullptr}, input_names.data(), inputs.data(), inputs.size(),
+                       output_names.data(), output_names.size());
+  };
+
+  // warm up run, the first run allocates the memory patterns and the thread pool
+  run();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(run());
+  }
+}
+
+const bool model_suite_registered = []() {
+  benchmark::AddCustomContext("model_suite_version", kModelSuiteVersion);
+  for (const auto& model : GetModelSuite()) {
+    for (const int threads : kIntraOpThreadCounts) {
+      const std::string name = "BM_ModelSuite/" + model.name + "/intra_op_threads:" + std::to_string(threads);
+      benchmark::RegisterBenchmark(name.c_str(), BM_ModelSuite, &model, threads)
+          ->Unit(benchmark::kMillisecond)
+          ->UseRealTime()
+          ->Repetitions(kRepetitions)
+          ->ReportAggregatesOnly(true);
+    }
+  }
+  return true;
+}();
+
+}  // namespace
@@ -5,6 +5,7 @@
 #pragma warning(disable : 4244)
 #endif
 
+#include <numeric>
 #include <random>
 
 #include "gtest/gtest.h"
@@ -41,6 +42,10 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/dynamic_quantize_gru_transformer.h"
+#include "core/optimizer/dynamic_quantize_matmul_transformer.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/gather_fusion.h"
@@ -57,12 +62,14 @@
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/isinf_reducesum_fusion.h"
 #include "core/optimizer/label_encoder_fusion.h"
+#include "core/optimizer/loop_unrolling.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/matmul_bn_fusion.h"
 #include "core/optimizer/matmul_nbits_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
+#include "core/optimizer/multi_reduce_fusion.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
 #include "core/optimizer/pad_fusion.h"
@@ -73,10 +80,13 @@
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/scaled_dot_product_attention_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_sharding.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #include "core/optimizer/utils.h"
 #include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 #include "core/session/inference_session.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/math.h"
@@ -662,7 +672,8 @@ TEST_F(GraphTransformationTests, ConstantFoldingUnsupportedFloat16) {
   }
 }
 
-TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
+static void RunConstantFoldingSubgraphTest(const logging::Logger& logger,
+                                           concurrency::ThreadPool* subgraph_thread_pool) {
   TensorProto value_tensor;
   value_tensor.add_dims(1);
   value_tensor.add_float_data(1.f);
@@ -674,7 +685,7 @@ TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
 
   auto create_subgraph = [&](GraphProto& graph_proto) {
     // create subgraph that has an Add node to add a local and parent graph initializer
-    Model model("ConstantFoldingSubgraphTest_subgraph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+    Model model("ConstantFoldingSubgraphTest_subgraph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, logger);
     auto& graph = model.MainGraph();
 
     TensorProto local_constant(value_tensor);
@@ -695,7 +706,7 @@ TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
     graph_proto = graph.ToGraphProto();
   };
 
-  Model model("ConstantFoldingSubgraphTest_main_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+  Model model("ConstantFoldingSubgraphTest_main_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, logger);
   auto& graph = model.MainGraph();
 
   // add initializer at parent level
@@ -724,18 +735,28 @@ TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
   ASSERT_TRUE(op_to_count["Add"] == 2);  // one in each subgraph
   std::unique_ptr<CPUExecutionProvider> e = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
   onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.SetSubgraphThreadPool(subgraph_thread_pool);
   const ConfigOptions empty_config_options;
   ASSERT_STATUS_OK(graph_transformation_mgr.Register(
       std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/, empty_config_options),
       TransformerLevel::Level1));
 
-  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, logger));
 
   op_to_count = CountOpsInGraph(graph);
   ASSERT_TRUE(op_to_count["Add"] == 0)
       << "Constant folding should have been able to remove the Add node in both subgraphs";
 }
 
+TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
+  RunConstantFoldingSubgraphTest(*logger_, nullptr);
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingSubgraphInParallel) {
+  concurrency::ThreadPool thread_pool(&Env::Default(), ThreadOptions(), ORT_TSTR("ConstantFoldingSubgraph"), 2, true);
+  RunConstantFoldingSubgraphTest(*logger_, &thread_pool);
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingWithShapeToInitializer) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/constant_folding_with_shape_to_initializer.onnx";
   std::shared_ptr<Model> model;
@@ -1053,6 +1074,40 @@ TEST_F(GraphTransformationTests, ConstantFoldingStringInitializer) {
   ASSERT_EQ(op_to_count.size(), 0U) << "Identity node should have been removed";
 }
 
+// Expand nodes growing a constant beyond the output budget are not folded, the smaller ones are.
+TEST_F(GraphTransformationTests, ConstantFoldingMaxOutputBytes) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* large_input_arg = builder.MakeInput<float>({{1024, 4}});
+    auto* small_input_arg = builder.MakeInput<float>({{4, 4}});
+    auto* values_arg = builder.MakeInitializer<float>({1, 4}, {1.0f, 2.0f, 3.0f, 4.0f});
+    auto* large_shape_arg = builder.MakeInitializer<int64_t>({2}, {1024, 4});
+    auto* small_shape_arg = builder.MakeInitializer<int64_t>({2}, {4, 4});
+    auto* large_expand_out = builder.MakeIntermediate();
+    auto* small_expand_out = builder.MakeIntermediate();
+    auto* large_output_arg = builder.MakeOutput();
+    auto* small_output_arg = builder.MakeOutput();
+
+    builder.AddNode("Expand", {values_arg, large_shape_arg}, {large_expand_out});
+    builder.AddNode("Expand", {values_arg, small_shape_arg}, {small_expand_out});
+    builder.AddNode("Add", {large_input_arg, large_expand_out}, {large_output_arg});
+    builder.AddNode("Mul", {small_input_arg, small_expand_out}, {small_output_arg});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["Expand"] == 1);
+    return Status::OK();
+  };
+
+  std::unique_ptr<CPUExecutionProvider> e = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  ConfigOptions config_options;
+  ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsConstantFoldingMaxOutputBytes, "1024"));
+  ASSERT_STATUS_OK(TestGraphTransformer(
+      build_test_case, 13, *logger_,
+      std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/, config_options),
+      TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingIfConstantInlining) {
   // This test covers the following necessary cases:
   // The input refers to the explicit or implicit inputs of If node.
@@ -5712,6 +5767,740 @@ TEST_F(GraphTransformationTests, QuickGelu) {
   }
 }
 
+TEST_F(GraphTransformationTests, ElementwiseChainFusion) {
+  // Tanh(1 - Sigmoid(x * 0.5 + bias)) is fused. Mul(y, y) is not a chain and the Relu output is a graph output.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{2, 3, 64}});
+    auto* other_arg = builder.MakeInput<float>({{2, 3, 64}});
+    auto* scale_arg = builder.MakeInitializer<float>({}, {0.5f});
+    auto* bias_arg = builder.MakeInitializer<float>({64}, -1.f, 1.f);
+    auto* one_arg = builder.MakeInitializer<float>({1}, {1.f});
+    auto* mul_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* sub_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeOutput();
+    auto* relu_out = builder.MakeOutput();
+    auto* square_out = builder.MakeOutput();
+
+    builder.AddNode("Mul", {input_arg, scale_arg}, {mul_out});
+    builder.AddNode("Add", {bias_arg, mul_out}, {add_out});
+    builder.AddNode("Sigmoid", {add_out}, {sigmoid_out});
+    builder.AddNode("Sub", {one_arg, sigmoid_out}, {sub_out});
+    builder.AddNode("Tanh", {sub_out}, {tanh_out});
+
+    builder.AddNode("Relu", {other_arg}, {relu_out});
+    builder.AddNode("Mul", {relu_out, relu_out}, {square_out});
+  };
+
+  auto pre_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Mul"] == 2);
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Tanh"] == 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.FusedElementwise"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Mul"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Relu"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Sigmoid"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Sub"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Tanh"] == 0);
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "FusedElementwise") {
+        auto& attrs = node.GetAttributes();
+        const auto& ops = attrs.at("ops").strings();
+        TEST_RETURN_IF_NOT(std::vector<std::string>(ops.begin(), ops.end()) ==
+                           std::vector<std::string>({"Mul", "Add", "Sigmoid", "Sub", "Tanh"}));
+        const auto& operand_first = attrs.at("operand_first").ints();
+        TEST_RETURN_IF_NOT(std::vector<int64_t>(operand_first.begin(), operand_first.end()) ==
+                           std::vector<int64_t>({0, 1, 0, 1, 0}));
+        TEST_RETURN_IF_NOT(node.InputDefs().size() == 4u);
+      }
+    }
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<ElementwiseChainFusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer), TransformerLevel::Level1,
+                                        1, pre_graph_checker, post_graph_checker));
+}
+
+#if !defined(DISABLE_ML_OPS)
+TEST_F(GraphTransformationTests, ScalerLinearFusion) {
+  for (const bool classifier : {true, false}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({5, 3}, -2.f, 2.f);
+      auto* scaled_arg = builder.MakeIntermediate();
+      Node& scaler = builder.AddNode("Scaler", {input_arg}, {scaled_arg}, kMLDomain);
+      scaler.AddAttribute("offset", std::vector<float>{0.5f, -1.f, 2.f});
+      scaler.AddAttribute("scale", std::vector<float>{2.f, 0.25f, -1.5f});
+
+      if (classifier) {
+        auto* label_arg = builder.MakeOutput();
+        auto* score_arg = builder.MakeOutput();
+        Node& linear = builder.AddNode("LinearClassifier", {scaled_arg}, {label_arg, score_arg}, kMLDomain);
+        linear.AddAttribute("coefficients", std::vector<float>{1.f, -2.f, 0.5f, -1.f, 0.75f, 3.f});
+        linear.AddAttribute("intercepts", std::vector<float>{0.1f, -0.2f});
+        linear.AddAttribute("classlabels_ints", std::vector<int64_t>{7, 9});
+      } else {
+        auto* output_arg = builder.MakeOutput();
+        Node& linear = builder.AddNode("LinearRegressor", {scaled_arg}, {output_arg}, kMLDomain);
+        linear.AddAttribute("coefficients", std::vector<float>{1.f, -2.f, 0.5f});
+        linear.AddAttribute("targets", int64_t{1});
+      }
+    };
+
+    auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["ai.onnx.ml.Scaler"], 0);
+    };
+
+    TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Default, TransformerLevel::Level1,
+                      14, 1e-5, 1e-5);
+  }
+}
+#endif
+
+TEST_F(GraphTransformationTests, ElementwiseChainFusion_Run) {
+  // large enough for several tasks with a partial last tile. the row bias wraps within tiles.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({3, 1500}, -1.f, 1.f);
+    auto* other_arg = builder.MakeInput<float>({3, 1500}, 0.5f, 2.f);
+    auto* bias_arg = builder.MakeInitializer<float>({1500}, -1.f, 1.f);
+    auto* scale_arg = builder.MakeInitializer<float>({}, {0.5f});
+    auto* add_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* div_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out});
+    builder.AddNode("Sigmoid", {add_out}, {sigmoid_out});
+    builder.AddNode("Div", {other_arg, sigmoid_out}, {div_out});
+    builder.AddNode("Mul", {div_out, scale_arg}, {mul_out});
+    builder.AddNode("Exp", {mul_out}, {output_arg});
+  };
+
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Exp"], 0);
+  };
+
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Level1, TransformerLevel::Level2, 14,
+                    1e-4, 1e-4, std::make_unique<ElementwiseChainFusion>());
+}
+
+TEST_F(GraphTransformationTests, MultiReduceFusion) {
+  // ReduceMean and ReduceSumSquare of x over the last axis are fused. ReduceMax keeps no dims and ReduceMin reduces
+  // another axis.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{2, 3, 64}});
+    auto* last_axis_arg = builder.MakeInitializer<int64_t>({1}, {-1});
+    auto* axis_2_arg = builder.MakeInitializer<int64_t>({1}, {2});
+    auto* axis_1_arg = builder.MakeInitializer<int64_t>({1}, {1});
+    auto* mean_out = builder.MakeOutput();
+    auto* sum_square_out = builder.MakeIntermediate();
+    auto* max_out = builder.MakeOutput();
+    auto* min_out = builder.MakeOutput();
+    auto* sqrt_out = builder.MakeOutput();
+
+    builder.AddNode("ReduceMean", {input_arg, last_axis_arg}, {mean_out});
+    builder.AddNode("ReduceSumSquare", {input_arg, axis_2_arg}, {sum_square_out});
+    builder.AddNode("Sqrt", {sum_square_out}, {sqrt_out});
+    builder.AddNode("ReduceMax", {input_arg, last_axis_arg}, {max_out}).AddAttribute("keepdims", int64_t(0));
+    builder.AddNode("ReduceMin", {input_arg, axis_1_arg}, {min_out});
+  };
+
+  auto pre_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["ReduceMean"] == 1);
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["ReduceSumSquare"] == 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.MultiReduce"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["ReduceMean"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["ReduceSumSquare"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["ReduceMax"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["ReduceMin"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Sqrt"] == 1);
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "MultiReduce") {
+        auto& attrs = node.GetAttributes();
+        const auto& reduce_ops = attrs.at("reduce_ops").strings();
+        std::vector<std::string> ops(reduce_ops.begin(), reduce_ops.end());
+        std::sort(ops.begin(), ops.end());
+        TEST_RETURN_IF_NOT(ops == std::vector<std::string>({"ReduceMean", "ReduceSumSquare"}));
+        const auto& axes = attrs.at("axes").ints();
+        TEST_RETURN_IF_NOT(std::vector<int64_t>(axes.begin(), axes.end()) == std::vector<int64_t>({2}));
+        TEST_RETURN_IF_NOT(node.InputDefs().size() == 1u);
+        TEST_RETURN_IF_NOT(node.OutputDefs().size() == 2u);
+      }
+    }
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<MultiReduceFusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 18, *logger_, std::move(transformer), TransformerLevel::Level1,
+                                        1, pre_graph_checker, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, MultiReduceFusion_Run) {
+  // the middle axis, the outer axes, the leading axis, the last axis and all the axes, with an odd innermost size.
+  const std::vector<std::vector<int64_t>> axes_list{{1}, {0, 2}, {0}, {2}, {}};
+  for (const auto& axes : axes_list) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({4, 6, 301}, -2.f, 2.f);
+      auto* mean_out = builder.MakeOutput();
+      auto* l2_out = builder.MakeOutput();
+      auto* max_out = builder.MakeOutput();
+      auto* min_out = builder.MakeOutput();
+      auto* l1_out = builder.MakeOutput();
+
+      for (auto [op_type, output_arg] : std::vector<std::pair<std::string, NodeArg*>>{
+               {"ReduceMean", mean_out}, {"ReduceL2", l2_out}, {"ReduceMax", max_out}, {"ReduceMin", min_out},
+               {"ReduceL1", l1_out}}) {
+        Node& node = builder.AddNode(op_type, {input_arg}, {output_arg});
+        if (!axes.empty()) {
+          node.AddAttribute("axes", axes);
+        }
+        node.AddAttribute("keepdims", int64_t(axes.size() == 1 ? 1 : 0));
+      }
+    };
+
+    auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.MultiReduce"], 1);
+      EXPECT_EQ(op_to_count["ReduceMean"], 0);
+      EXPECT_EQ(op_to_count["ReduceL1"], 0);
+    };
+
+    TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13,
+                      1e-4, 1e-4, std::make_unique<MultiReduceFusion>());
+  }
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_Run) {
+  for (const char* reduce_op : {"ReduceSum", "ReduceMean"}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* table_arg = builder.MakeInitializer<float>({50, 17}, -1.f, 1.f);
+      auto* indices_arg = builder.MakeInput<int64_t>({6, 5}, -50, 49);
+      auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {1});
+      auto* gather_out = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+      builder.AddNode(reduce_op, {gather_out, axes_arg}, {output_arg}).AddAttribute("keepdims", int64_t(0));
+    };
+
+    auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+      EXPECT_EQ(op_to_count["Gather"], 0);
+    };
+
+    TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Level1, TransformerLevel::Level2, 18,
+                      1e-5, 1e-5, std::make_unique<EmbeddingBagFusion>());
+  }
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_Int8Table) {
+  // the per-row DequantizeLinear of the table is folded, EmbeddingBag reads the int8 rows.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<int8_t>({40, 32}, -128, 127);
+    auto* scale_arg = builder.MakeInitializer<float>({40}, 0.001f, 0.01f);
+    auto* indices_arg = builder.MakeInput<int32_t>({3, 7}, 0, 39);
+    auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {-2});
+    auto* dequantize_out = builder.MakeIntermediate();
+    auto* gather_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("DequantizeLinear", {table_arg, scale_arg}, {dequantize_out}).AddAttribute("axis", int64_t(0));
+    builder.AddNode("Gather", {dequantize_out, indices_arg}, {gather_out});
+    builder.AddNode("ReduceSum", {gather_out, axes_arg}, {output_arg}).AddAttribute("keepdims", int64_t(0));
+  };
+
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+    EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+    EXPECT_EQ(op_to_count["Gather"], 0);
+  };
+
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13,
+                    1e-5, 1e-5, std::make_unique<EmbeddingBagFusion>());
+}
+
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_NotFused) {
+  // the gathered rows are a graph output of the first lookup, and the second one keeps the bag axis.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({20, 8}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({2, 3}, 0, 19);
+    auto* gather_out = builder.MakeOutput();
+    auto* sum_out = builder.MakeOutput();
+    auto* gather_2_out = builder.MakeIntermediate();
+    auto* mean_out = builder.MakeOutput();
+
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    Node& sum = builder.AddNode("ReduceSum", {gather_out}, {sum_out});
+    sum.AddAttribute("axes", std::vector<int64_t>{1});
+    sum.AddAttribute("keepdims", int64_t(0));
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_2_out});
+    builder.AddNode("ReduceMean", {gather_2_out}, {mean_out}).AddAttribute("axes", std::vector<int64_t>{1});
+  };
+
+  auto pre_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Gather"] == 2);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.EmbeddingBag"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Gather"] == 2);
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<EmbeddingBagFusion>();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 12, *logger_, std::move(transformer), TransformerLevel::Level1,
+                                        1, pre_graph_checker, post_graph_checker));
+}
+
+namespace {
+
+// Returns the values of the initializer input input_index of the first node with op_type.
+std::vector<float> GetInitializerInput(const Graph& graph, const std::string& op_type, int input_index,
+                                       std::vector<int64_t>& dims) {
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == op_type) {
+      const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, node.InputDefs()[input_index]->Name());
+      if (tensor_proto == nullptr) {
+        break;
+      }
+      Initializer values{graph, *tensor_proto, graph.ModelPath()};
+      dims.assign(values.dims().begin(), values.dims().end());
+      return std::vector<float>(values.DataAsSpan<float>().begin(), values.DataAsSpan<float>().end());
+    }
+  }
+  return {};
+}
+
+std::vector<float> Iota(size_t size) {
+  std::vector<float> values(size);
+  std::iota(values.begin(), values.end(), 0.f);
+  return values;
+}
+
+}  // namespace
+
+TEST_F(GraphTransformationTests, TensorParallelSharding_Mlp) {
+  // MatMul(X, W1) -> Add(b1) -> Relu -> MatMul(W2) -> Add(b2), with W1 [4, 8] and W2 [8, 2] holding 0, 1, 2, ...
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4}, -1.f, 1.f);
+    auto* w1_arg = builder.MakeInitializer<float>({4, 8}, Iota(32));
+    auto* b1_arg = builder.MakeInitializer<float>({8}, Iota(8));
+    auto* w2_arg = builder.MakeInitializer<float>({8, 2}, Iota(16));
+    auto* b2_arg = builder.MakeInitializer<float>({2}, {1.f, 2.f});
+    auto* matmul_1_out = builder.MakeIntermediate();
+    auto* add_1_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* matmul_2_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {input_arg, w1_arg}, {matmul_1_out});
+    builder.AddNode("Add", {b1_arg, matmul_1_out}, {add_1_out});
+    builder.AddNode("Relu", {add_1_out}, {relu_out});
+    builder.AddNode("MatMul", {relu_out, w2_arg}, {matmul_2_out});
+    builder.AddNode("Add", {matmul_2_out, b2_arg}, {output_arg});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.AllReduce"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 2);
+
+    // rank 1 of 2 keeps columns 4..7 of W1 and b1, and rows 4..7 of W2.
+    std::vector<int64_t> dims;
+    const auto w1 = GetInitializerInput(graph, "MatMul", 1, dims);
+    TEST_RETURN_IF_NOT(dims == std::vector<int64_t>({4, 4}));
+    TEST_RETURN_IF_NOT(w1.size() == 16 && w1[0] == 4.f && w1[3] == 7.f && w1[4] == 12.f);
+    const auto b1 = GetInitializerInput(graph, "Add", 0, dims);
+    TEST_RETURN_IF_NOT(b1 == std::vector<float>({4.f, 5.f, 6.f, 7.f}));
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "AllReduce") {
+        const Node* matmul = graph_utils::GetInputNode(node, 0);
+        TEST_RETURN_IF_NOT(matmul != nullptr && matmul->OpType() == "MatMul");
+        const auto* w2_proto = graph_utils::GetConstantInitializer(graph, matmul->InputDefs()[1]->Name());
+        TEST_RETURN_IF_NOT(w2_proto != nullptr);
+        Initializer w2{graph, *w2_proto, graph.ModelPath()};
+        TEST_RETURN_IF_NOT(w2.dims().size() == 2 && w2.dims()[0] == 4 && w2.dims()[1] == 2);
+        TEST_RETURN_IF_NOT(w2.DataAsSpan<float>()[0] == 8.f);
+
+        // the bias after the block is added once to the sum.
+        TEST_RETURN_IF_NOT(node.GetOutputEdgesCount() == 1 && node.OutputNodesBegin()->OpType() == "Add");
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<TensorParallelSharding>(1, 2),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, TensorParallelSharding_Attention) {
+  // Attention with 4 heads of size 2 and packed QKV weights [8, 24], followed by the output projection.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 3, 8}, -1.f, 1.f);
+    auto* weight_arg = builder.MakeInitializer<float>({8, 24}, Iota(192));
+    auto* bias_arg = builder.MakeInitializer<float>({24}, Iota(24));
+    auto* output_weight_arg = builder.MakeInitializer<float>({8, 8}, Iota(64));
+    auto* attention_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Attention", {input_arg, weight_arg, bias_arg}, {attention_out}, kMSDomain)
+        .AddAttribute("num_heads", int64_t(4));
+    builder.AddNode("MatMul", {attention_out, output_weight_arg}, {output_arg});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["com.microsoft.AllReduce"] == 1);
+
+    // rank 0 of 2 keeps heads 0 and 1 of each of Q, K and V.
+    std::vector<int64_t> dims;
+    const auto bias = GetInitializerInput(graph, "Attention", 2, dims);
+    TEST_RETURN_IF_NOT(bias == std::vector<float>({0.f, 1.f, 2.f, 3.f, 8.f, 9.f, 10.f, 11.f, 16.f, 17.f, 18.f, 19.f}));
+    const auto weight = GetInitializerInput(graph, "Attention", 1, dims);
+    TEST_RETURN_IF_NOT(dims == std::vector<int64_t>({8, 12}));
+    TEST_RETURN_IF_NOT(weight[12] == 24.f && weight[16] == 32.f);
+    const auto output_weight = GetInitializerInput(graph, "MatMul", 1, dims);
+    TEST_RETURN_IF_NOT(dims == std::vector<int64_t>({4, 8}) && output_weight[0] == 0.f);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Attention") {
+        TEST_RETURN_IF_NOT(graph_utils::GetNodeAttribute(node, "num_heads")->i() == 2);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<TensorParallelSharding>(0, 2),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, TensorParallelSharding_NotSharded) {
+  // the hidden size doesn't divide by the group size, and the second MatMul has no constant weight.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4}, -1.f, 1.f);
+    auto* w1_arg = builder.MakeInitializer<float>({4, 6}, -1.f, 1.f);
+    auto* w2_arg = builder.MakeInitializer<float>({6, 2}, -1.f, 1.f);
+    auto* w3_arg = builder.MakeInitializer<float>({4, 8}, -1.f, 1.f);
+    auto* w4_arg = builder.MakeInput<float>({8, 2}, -1.f, 1.f);
+    auto* relu_1_in = builder.MakeIntermediate();
+    auto* relu_1_out = builder.MakeIntermediate();
+    auto* relu_2_in = builder.MakeIntermediate();
+    auto* relu_2_out = builder.MakeIntermediate();
+
+    builder.AddNode("MatMul", {input_arg, w1_arg}, {relu_1_in});
+    builder.AddNode("Relu", {relu_1_in}, {relu_1_out});
+    builder.AddNode("MatMul", {relu_1_out, w2_arg}, {builder.MakeOutput()});
+    builder.AddNode("MatMul", {input_arg, w3_arg}, {relu_2_in});
+    builder.AddNode("Relu", {relu_2_in}, {relu_2_out});
+    builder.AddNode("MatMul", {relu_2_out, w4_arg}, {builder.MakeOutput()});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["com.microsoft.AllReduce"] == 0);
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<TensorParallelSharding>(0, 4),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, DynamicQuantizeMatMulTransformer) {
+  // the second MatMul has no constant weight and stays in float.
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 16}, -1.f, 1.f);
+    auto* weight_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+    auto* other_weight_arg = builder.MakeInput<float>({8, 4}, -1.f, 1.f);
+    auto* matmul_out = builder.MakeIntermediate();
+
+    builder.AddNode("MatMul", {input_arg, weight_arg}, {matmul_out});
+    builder.AddNode("MatMul", {matmul_out, other_weight_arg}, {builder.MakeOutput()});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.DynamicQuantizeMatMul"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 1);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "DynamicQuantizeMatMul") {
+        const auto* weight = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+        const auto* scale = graph_utils::GetConstantInitializer(graph, node.InputDefs()[2]->Name());
+        TEST_RETURN_IF_NOT(weight != nullptr && weight->data_type() == ONNX_NAMESPACE::TensorProto_DataType_INT8);
+        TEST_RETURN_IF_NOT(scale != nullptr && scale->dims_size() == 1 && scale->dims(0) == 8);
+      }
+    }
+    return Status::OK();
+  };
+
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    const auto& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    ASSERT_EQ(op_to_count["com.microsoft.DynamicQuantizeMatMul"], 1);
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_,
+                                        std::make_unique<DynamicQuantizeMatMulTransformer>(0.05f, false),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+
+  // the outputs of the quantized model stay close to the float model.
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13,
+                    0.05, 0.05, std::make_unique<DynamicQuantizeMatMulTransformer>(0.05f, false));
+}
+
+TEST_F(GraphTransformationTests, DynamicQuantizeMatMulTransformer_ToleranceExceeded) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 16}, -1.f, 1.f);
+    auto* weight_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+    builder.AddNode("MatMul", {input_arg, weight_arg}, {builder.MakeOutput()});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.DynamicQuantizeMatMul"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 1);
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_,
+                                        std::make_unique<DynamicQuantizeMatMulTransformer>(1e-6f, false),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, DynamicQuantizeGRUTransformer) {
+  constexpr int64_t hidden_size = 8;
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({4, 2, 16}, -1.f, 1.f);
+    auto* w_arg = builder.MakeInitializer<float>({2, 3 * hidden_size, 16}, -1.f, 1.f);
+    auto* r_arg = builder.MakeInitializer<float>({2, 3 * hidden_size, hidden_size}, -1.f, 1.f);
+    auto* b_arg = builder.MakeInitializer<float>({2, 6 * hidden_size}, -1.f, 1.f);
+
+    auto& gru = builder.AddNode("GRU", {input_arg, w_arg, r_arg, b_arg}, {builder.MakeOutput(), builder.MakeOutput()});
+    gru.AddAttribute("hidden_size", hidden_size);
+    gru.AddAttribute("direction", "bidirectional");
+    gru.AddAttribute("linear_before_reset", static_cast<int64_t>(1));
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.DynamicQuantizeGRU"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["GRU"] == 0);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "DynamicQuantizeGRU") {
+        const auto* w = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+        const auto* w_scale = graph_utils::GetConstantInitializer(graph, node.InputDefs()[6]->Name());
+        TEST_RETURN_IF_NOT(w != nullptr && w->data_type() == ONNX_NAMESPACE::TensorProto_DataType_INT8);
+        TEST_RETURN_IF_NOT(w->dims(1) == 16 && w->dims(2) == 3 * hidden_size);
+        TEST_RETURN_IF_NOT(w_scale != nullptr && w_scale->dims_size() == 2 && w_scale->dims(1) == 3 * hidden_size);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_,
+                                        std::make_unique<DynamicQuantizeGRUTransformer>(0.05f, false),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    ASSERT_EQ(op_to_count["com.microsoft.DynamicQuantizeGRU"], 1);
+  };
+
+  // the outputs of the quantized model stay close to the float model.
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Level1, TransformerLevel::Level2, 14,
+                    0.05, 0.05, std::make_unique<DynamicQuantizeGRUTransformer>(0.05f, false));
+}
+
+// Loop body computing y = x + (bias + 1) per iteration, with y as both the loop carried var and the scan output.
+// bias + 1 only depends on an outer scope value and a body initializer, so it is loop invariant.
+static ONNX_NAMESPACE::GraphProto MakeLoopUnrollingBody(const std::string& bias_name) {
+  using namespace ONNX_NAMESPACE;
+  GraphProto body;
+  body.set_name("loop_body");
+
+  auto add_value_info = [](ValueInfoProto* value_info, const std::string& name, TensorProto_DataType type,
+                           std::initializer_list<int64_t> dims) {
+    value_info->set_name(name);
+    auto* tensor_type = value_info->mutable_type()->mutable_tensor_type();
+    tensor_type->set_elem_type(type);
+    auto* shape = tensor_type->mutable_shape();
+    for (auto dim : dims) {
+      shape->add_dim()->set_dim_value(dim);
+    }
+  };
+
+  add_value_info(body.add_input(), "iter_num", TensorProto_DataType_INT64, {});
+  add_value_info(body.add_input(), "cond_in", TensorProto_DataType_BOOL, {});
+  add_value_info(body.add_input(), "x", TensorProto_DataType_FLOAT, {2});
+  add_value_info(body.add_output(), "cond_out", TensorProto_DataType_BOOL, {});
+  add_value_info(body.add_output(), "y", TensorProto_DataType_FLOAT, {2});
+  add_value_info(body.add_output(), "scan", TensorProto_DataType_FLOAT, {2});
+
+  auto* one = body.add_initializer();
+  one->set_name("one");
+  one->set_data_type(TensorProto_DataType_FLOAT);
+  one->add_dims(2);
+  one->add_float_data(1.0f);
+  one->add_float_data(1.0f);
+
+  auto add_node = [&body](const std::string& op_type, std::initializer_list<std::string> inputs,
+                          const std::string& output) {
+    auto* node = body.add_node();
+    node->set_op_type(op_type);
+    node->set_name(output + "_" + op_type);
+    for (const auto& input : inputs) {
+      node->add_input(input);
+    }
+    node->add_output(output);
+  };
+
+  add_node("Identity", {"cond_in"}, "cond_out");
+  add_node("Add", {bias_name, "one"}, "offset");
+  add_node("Add", {"x", "offset"}, "y");
+  add_node("Identity", {"y"}, "scan");
+  return body;
+}
+
+TEST_F(GraphTransformationTests, LoopUnrolling) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2}, -1.f, 1.f);
+    auto* bias_arg = builder.MakeInitializer<float>({2}, -1.f, 1.f);
+    auto* trip_count_arg = builder.MakeScalarInitializer<int64_t>(3);
+
+    auto& loop = builder.AddNode("Loop", {trip_count_arg, builder.MakeEmptyInput(), input_arg},
+                                 {builder.MakeOutput(), builder.MakeOutput()});
+    loop.AddAttribute("body", MakeLoopUnrollingBody(bias_arg->Name()));
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["Loop"] == 0);
+    // the hoisted bias + 1, and x + offset once per iteration
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 4);
+    TEST_RETURN_IF_NOT(op_to_count["Unsqueeze"] == 3);
+    TEST_RETURN_IF_NOT(op_to_count["Concat"] == 1);
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<LoopUnrolling>(4),
+                                        TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+
+  // a Loop with more iterations than the limit only has its loop invariant nodes hoisted
+  auto hoisted_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph, /*recurse_into_subgraphs*/ false);
+    TEST_RETURN_IF_NOT(op_to_count["Loop"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 1);
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<LoopUnrolling>(2),
+                                        TransformerLevel::Level1, 1, nullptr, hoisted_graph_checker));
+
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    ASSERT_EQ(op_to_count["Loop"], 0);
+  };
+
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Level1, TransformerLevel::Level1, 13,
+                    0.0, 0.0, std::make_unique<LoopUnrolling>(4));
+}
+
+// If branch computing output = op(x, bias), with x and bias from the outer scope.
+static ONNX_NAMESPACE::GraphProto MakeCseBranch(const std::string& op_type, const std::string& x_name,
+                                                const std::string& bias_name) {
+  using namespace ONNX_NAMESPACE;
+  GraphProto branch;
+  branch.set_name(op_type + "_branch");
+
+  auto* output = branch.add_output();
+  output->set_name(op_type + "_out");
+  auto* tensor_type = output->mutable_type()->mutable_tensor_type();
+  tensor_type->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto* node = branch.add_node();
+  node->set_op_type(op_type);
+  node->set_name(op_type + "_in_branch");
+  node->add_input(x_name);
+  node->add_input(bias_name);
+  node->add_output(op_type + "_out");
+  return branch;
+}
+
+TEST_F(GraphTransformationTests, CseOuterScopeValues) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2}, -1.f, 1.f);
+    auto* cond_arg = builder.MakeInput<bool>({1}, {true});
+    auto* bias_arg = builder.MakeInitializer<float>({2}, -1.f, 1.f);
+    auto* trip_count_arg = builder.MakeScalarInitializer<int64_t>(3);
+
+    // the then branch recomputes x + bias, the else branch computes a value of its own
+    builder.AddNode("Add", {input_arg, bias_arg}, {builder.MakeOutput()});
+    auto& if_node = builder.AddNode("If", {cond_arg}, {builder.MakeOutput()});
+    if_node.AddAttribute("then_branch", MakeCseBranch("Add", input_arg->Name(), bias_arg->Name()));
+    if_node.AddAttribute("else_branch", MakeCseBranch("Sub", input_arg->Name(), bias_arg->Name()));
+
+    // the body computes the loop invariant bias + 1 on every iteration
+    auto& loop = builder.AddNode("Loop", {trip_count_arg, builder.MakeEmptyInput(), input_arg},
+                                 {builder.MakeOutput(), builder.MakeOutput()});
+    loop.AddAttribute("body", MakeLoopUnrollingBody(bias_arg->Name()));
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph, /*recurse_into_subgraphs*/ false);
+    // x + bias, and the bias + 1 hoisted from the Loop body
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 2);
+    TEST_RETURN_IF_NOT(op_to_count["If"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Loop"] == 1);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "If") {
+        TEST_RETURN_IF_NOT(CountOpsInGraph(*node.GetGraphAttribute("then_branch"))["Add"] == 0);
+        TEST_RETURN_IF_NOT(CountOpsInGraph(*node.GetGraphAttribute("else_branch"))["Sub"] == 1);
+      } else if (node.OpType() == "Loop") {
+        TEST_RETURN_IF_NOT(CountOpsInGraph(*node.GetGraphAttribute("body"))["Add"] == 1);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_,
+                                        std::make_unique<CommonSubexpressionElimination>(),
+                                        TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    for (const auto& node : session.GetGraph().Nodes()) {
+      if (node.OpType() == "If") {
+        ASSERT_EQ(CountOpsInGraph(*node.GetGraphAttribute("then_branch"))["Add"], 0);
+      } else if (node.OpType() == "Loop") {
+        ASSERT_EQ(CountOpsInGraph(*node.GetGraphAttribute("body"))["Add"], 1);
+      }
+    }
+  };
+
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Level1, TransformerLevel::Level1, 13,
+                    0.0, 0.0, std::make_unique<CommonSubexpressionElimination>());
+}
+
 struct BiasSoftmaxFusionTester {
   std::shared_ptr<Model> p_model_;
   Status model_load_;
@@ -8235,6 +9024,93 @@ TEST_F(GraphTransformationTests, MatMulNBitsBiasFusion) {
   }
 }
 
+TEST_F(GraphTransformationTests, ScaledDotProductAttentionFusion_DynamoExport) {
+  // torch.onnx dynamo scales the query and the transposed key, the query goes through Transpose and Reshape.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* query_arg = builder.MakeInput<float>({2, 4, 5, 8}, -1.f, 1.f);
+    auto* key_arg = builder.MakeInput<float>({2, 4, 6, 8}, -1.f, 1.f);
+    auto* value_arg = builder.MakeInput<float>({2, 4, 6, 8}, -1.f, 1.f);
+    auto* bias_arg = builder.MakeInput<float>({1, 1, 5, 6}, -1.f, 1.f);
+    auto* scale_arg = builder.MakeScalarInitializer<float>(0.5946035575f);  // 8^-0.25
+    auto* shape_arg = builder.MakeInitializer<int64_t>({3}, {0, 0, 32});
+    auto* query_scaled = builder.MakeIntermediate();
+    auto* key_transposed = builder.MakeIntermediate();
+    auto* key_scaled = builder.MakeIntermediate();
+    auto* scores = builder.MakeIntermediate();
+    auto* biased_scores = builder.MakeIntermediate();
+    auto* probs = builder.MakeIntermediate();
+    auto* attention_out = builder.MakeIntermediate();
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Mul", {query_arg, scale_arg}, {query_scaled});
+    builder.AddNode("Transpose", {key_arg}, {key_transposed}).AddAttribute("perm", std::vector<int64_t>{0, 1, 3, 2});
+    builder.AddNode("Mul", {key_transposed, scale_arg}, {key_scaled});
+    builder.AddNode("MatMul", {query_scaled, key_scaled}, {scores});
+    builder.AddNode("Add", {scores, bias_arg}, {biased_scores});
+    builder.AddNode("Softmax", {biased_scores}, {probs}).AddAttribute("axis", int64_t(-1));
+    builder.AddNode("MatMul", {probs, value_arg}, {attention_out});
+    builder.AddNode("Transpose", {attention_out}, {transpose_out})
+        .AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+    builder.AddNode("Reshape", {transpose_out, shape_arg}, {output_arg});
+  };
+
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.MultiHeadAttention"], 1);
+    EXPECT_EQ(op_to_count["MatMul"], 0);
+    EXPECT_EQ(op_to_count["Softmax"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Transpose"], 1);
+  };
+
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13,
+                    1e-5, 1e-5, std::make_unique<ScaledDotProductAttentionFusion>());
+}
+
+TEST_F(GraphTransformationTests, ScaledDotProductAttentionFusion_SplitHeads) {
+  // the query heads are split from the projection, which MultiHeadAttention takes directly.
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* hidden_arg = builder.MakeInput<float>({2, 5, 32}, -1.f, 1.f);
+    auto* key_arg = builder.MakeInput<float>({2, 4, 5, 8}, -1.f, 1.f);
+    auto* value_arg = builder.MakeInput<float>({2, 4, 5, 8}, -1.f, 1.f);
+    auto* split_shape_arg = builder.MakeInitializer<int64_t>({4}, {0, 0, 4, 8});
+    auto* merge_shape_arg = builder.MakeInitializer<int64_t>({3}, {2, 5, 32});
+    auto* divisor_arg = builder.MakeScalarInitializer<float>(2.8284271247f);
+    auto* split_out = builder.MakeIntermediate();
+    auto* query = builder.MakeIntermediate();
+    auto* key_transposed = builder.MakeIntermediate();
+    auto* scores = builder.MakeIntermediate();
+    auto* scaled_scores = builder.MakeIntermediate();
+    auto* probs = builder.MakeIntermediate();
+    auto* attention_out = builder.MakeIntermediate();
+    auto* transpose_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Reshape", {hidden_arg, split_shape_arg}, {split_out});
+    builder.AddNode("Transpose", {split_out}, {query}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+    builder.AddNode("Transpose", {key_arg}, {key_transposed}).AddAttribute("perm", std::vector<int64_t>{0, 1, 3, 2});
+    builder.AddNode("MatMul", {query, key_transposed}, {scores});
+    builder.AddNode("Div", {scores, divisor_arg}, {scaled_scores});
+    builder.AddNode("Softmax", {scaled_scores}, {probs});
+    builder.AddNode("MatMul", {probs, value_arg}, {attention_out});
+    builder.AddNode("Transpose", {attention_out}, {transpose_out})
+        .AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+    builder.AddNode("Reshape", {transpose_out, merge_shape_arg}, {output_arg});
+  };
+
+  auto check_transformed_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.MultiHeadAttention"], 1);
+    EXPECT_EQ(op_to_count["Reshape"], 0);
+    EXPECT_EQ(op_to_count["Transpose"], 0);
+    EXPECT_EQ(op_to_count["Div"], 0);
+  };
+
+  TransformerTester(build_test_case, check_transformed_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13,
+                    1e-5, 1e-5, std::make_unique<ScaledDotProductAttentionFusion>());
+}
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 }  // namespace test
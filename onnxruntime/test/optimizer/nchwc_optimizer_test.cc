@@ -634,6 +634,48 @@ TEST(NchwcOptimizerTests, FusedConvAddFusion) {
   test_case(true, true, 1);
 }
 
+TEST(NchwcOptimizerTests, ConvAddFusionNchwResidual) {
+  auto test_case = [&](const std::string& op_type, bool swap_inputs) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>({1, 32, 28, 28});
+      auto* neg_output_arg = helper.MakeIntermediate();
+      auto* conv_output_arg = helper.MakeIntermediate();
+      auto* add_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      // The residual is produced by a NCHW node and is also the input of the
+      // convolution.
+      helper.AddNode("Neg", {input_arg}, {neg_output_arg});
+      helper.AddConvNode(neg_output_arg, conv_output_arg, {32, 32, 1, 1});
+      if (swap_inputs) {
+        helper.AddNode(op_type, {neg_output_arg, conv_output_arg}, {add_output_arg});
+      } else {
+        helper.AddNode(op_type, {conv_output_arg, neg_output_arg}, {add_output_arg});
+      }
+      helper.AddNode("Relu", {add_output_arg}, {output_arg});
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], 1);
+      EXPECT_EQ(op_to_count[op_type], 0);
+      EXPECT_EQ(op_to_count["Relu"], 0);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+  };
+
+  // Verify that an Add or Sum of a NCHWc Conv node and a NCHW tensor that is
+  // already reordered for the Conv node uses the reordered tensor as the sum
+  // input, with the following Relu node fused as well.
+  for (const auto* op_type : {"Add", "Sum"}) {
+    test_case(op_type, false);
+    test_case(op_type, true);
+  }
+}
+
 TEST(NchwcOptimizerTests, ConvBinary) {
   auto test_case = [&](const std::string& op_type) {
     auto build_test_case = [&](NchwcTestHelper& helper) {
@@ -8,7 +8,9 @@
 #include "graph_transform_test_builder.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/dnnl_op_test_utils.h"
+#include "test/util/include/asserts.h"
 
 namespace onnxruntime {
 namespace test {
@@ -533,6 +535,91 @@ TEST(NhwcTransformerTests, ConvMixTensorRanks) {
                     TransformerLevel::Level3);
 }
 
+static void EnableFp32Nhwc(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableFp32NhwcLayout, "1"));
+}
+
+TEST(NhwcTransformerTests, ConvFp32) {
+  DNNL_GTEST_SKIP();
+
+  auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape,
+                       int64_t group) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.f, 1.f);
+      auto* output_arg = builder.MakeOutput();
+      auto* weight_arg = builder.MakeInitializer<float>(weights_shape, -1.f, 1.f);
+      auto* bias_arg = builder.MakeInitializer<float>({weights_shape[0]}, -1.f, 1.f);
+
+      Node& conv_node = builder.AddNode("Conv", {input_arg, weight_arg, bias_arg}, {output_arg});
+      conv_node.AddAttribute("group", group);
+      conv_node.AddAttribute("pads", std::vector<int64_t>((weights_shape.size() - 2) * 2, 1));
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 1);
+      EXPECT_EQ(op_to_count["Transpose"], 2);
+    };
+
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12, 1e-4, 1e-4, nullptr, EnableFp32Nhwc);
+  };
+
+  // 1D/2D/3D, grouped, depthwise and pointwise convolutions.
+  test_case({1, 12, 37}, {32, 12, 5}, 1);
+  test_case({2, 23, 13, 13}, {30, 23, 3, 3}, 1);
+  test_case({1, 22, 11, 13, 15}, {30, 22, 5, 3, 3}, 1);
+  test_case({1, 24, 13, 13}, {32, 6, 3, 3}, 4);
+  test_case({2, 24, 13, 13}, {24, 1, 3, 3}, 24);
+  test_case({1, 24, 13, 13}, {16, 24, 1, 1}, 1);
+}
+
+TEST(NhwcTransformerTests, ConvPoolChainFp32) {
+  DNNL_GTEST_SKIP();
+
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 16, 17, 17}, -1.f, 1.f);
+    auto* conv1_output_arg = builder.MakeIntermediate();
+    auto* relu_output_arg = builder.MakeIntermediate();
+    auto* maxpool_output_arg = builder.MakeIntermediate();
+    auto* conv2_output_arg = builder.MakeIntermediate();
+    auto* avgpool_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* conv1_weight_arg = builder.MakeInitializer<float>({32, 16, 3, 3}, -.5f, .5f);
+    auto* conv2_weight_arg = builder.MakeInitializer<float>({32, 32, 3, 3}, -.5f, .5f);
+
+    Node& conv1_node = builder.AddConvNode(input_arg, conv1_weight_arg, conv1_output_arg);
+    conv1_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("Relu", {conv1_output_arg}, {relu_output_arg});
+    Node& maxpool_node = builder.AddNode("MaxPool", {relu_output_arg}, {maxpool_output_arg});
+    maxpool_node.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+    maxpool_node.AddAttribute("strides", std::vector<int64_t>{2, 2});
+    builder.AddConvNode(maxpool_output_arg, conv2_weight_arg, conv2_output_arg);
+    Node& avgpool_node = builder.AddNode("AveragePool", {conv2_output_arg}, {avgpool_output_arg});
+    avgpool_node.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+    avgpool_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("GlobalAveragePool", {avgpool_output_arg}, {output_arg});
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 2);
+    EXPECT_EQ(op_to_count["com.ms.internal.nhwc.MaxPool"], 1);
+    EXPECT_EQ(op_to_count["com.ms.internal.nhwc.AveragePool"], 1);
+    EXPECT_EQ(op_to_count["com.ms.internal.nhwc.GlobalAveragePool"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3,
+                    12, 1e-4, 1e-4, nullptr, EnableFp32Nhwc);
+}
+
 #ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
 
 static std::vector<MLFloat16> ARangeOfFP16Values(const std::vector<int64_t>& shape, MLFloat16 min, MLFloat16 max) {
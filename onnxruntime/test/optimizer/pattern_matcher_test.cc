@@ -0,0 +1,155 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/pattern_matcher.h"
+
+#include "gtest/gtest.h"
+
+#include "asserts.h"
+#include "core/graph/model.h"
+#include "core/optimizer/rule_based_graph_transformer.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+std::unique_ptr<Model> CreateModel() {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}};
+  return std::make_unique<Model>("PatternMatcherTest", false, ModelMetaData(), PathString(),
+                                 IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                 std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                 DefaultLoggingManager().DefaultLogger());
+}
+
+NodeArg& CreateFloatArg(Graph& graph, const std::string& name) {
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  return graph.GetOrCreateNodeArg(name, &float_tensor);
+}
+
+// x * Sigmoid(x), in either order.
+GraphPattern CreateSiluPattern() {
+  GraphPattern pattern("Mul", {7, 13, 14});
+  const int sigmoid = pattern.AddInput(0, 1, "Sigmoid", {6, 13});
+  pattern.AddSharedInput(0, 0, sigmoid, 0).SetCommutative(0);
+  return pattern;
+}
+
+// Replaces the match by an Identity of input 0 of pattern node `input_node`.
+Status ReplaceWithIdentity(Graph& graph, const PatternMatch& match, int input_node) {
+  Node& root = match.GetNode(graph, 0);
+  Node& identity = graph.AddNode(graph.GenerateNodeName("Identity"), "Identity", "",
+                                 {match.GetInput(graph, input_node, 0)}, {root.MutableOutputDefs()[0]});
+  identity.SetExecutionProviderType(root.GetExecutionProviderType());
+  match.RemoveNodes(graph);
+  return Status::OK();
+}
+
+}  // namespace
+
+TEST(PatternMatcherTest, CommutativeSharedInput) {
+  auto model = CreateModel();
+  Graph& graph = model->MainGraph();
+  NodeArg& x = CreateFloatArg(graph, "x");
+  NodeArg& z = CreateFloatArg(graph, "z");
+  NodeArg& sigmoid_x = CreateFloatArg(graph, "sigmoid_x");
+  NodeArg& sigmoid_z = CreateFloatArg(graph, "sigmoid_z");
+  NodeArg& y1 = CreateFloatArg(graph, "y1");
+  NodeArg& y2 = CreateFloatArg(graph, "y2");
+
+  Node& sigmoid = graph.AddNode("sigmoid_x", "Sigmoid", "", {&x}, {&sigmoid_x});
+  Node& swapped_mul = graph.AddNode("swapped_mul", "Mul", "", {&sigmoid_x, &x}, {&y1});
+  graph.AddNode("sigmoid_z", "Sigmoid", "", {&z}, {&sigmoid_z});
+  Node& other_mul = graph.AddNode("other_mul", "Mul", "", {&x, &sigmoid_z}, {&y2});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const GraphPattern pattern = CreateSiluPattern();
+  PatternMatch match;
+  ASSERT_TRUE(pattern.Match(graph, swapped_mul, &match));
+  EXPECT_EQ(match.GetNodeIndex(0), swapped_mul.Index());
+  EXPECT_EQ(match.GetNodeIndex(1), sigmoid.Index());
+  EXPECT_EQ(match.InputIndex(0, 0), 1);
+  EXPECT_EQ(match.GetInput(graph, 0, 0), &x);
+
+  // the Mul reads x but the Sigmoid reads z.
+  EXPECT_FALSE(pattern.Match(graph, other_mul));
+}
+
+TEST(PatternMatcherTest, ExclusiveOutputs) {
+  auto model = CreateModel();
+  Graph& graph = model->MainGraph();
+  NodeArg& x = CreateFloatArg(graph, "x");
+  NodeArg& sigmoid_x = CreateFloatArg(graph, "sigmoid_x");
+  NodeArg& y = CreateFloatArg(graph, "y");
+
+  graph.AddNode("sigmoid", "Sigmoid", "", {&x}, {&sigmoid_x});
+  Node& mul = graph.AddNode("mul", "Mul", "", {&x, &sigmoid_x}, {&y});
+  graph.SetOutputs({&y, &sigmoid_x});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  // the Sigmoid output is a graph output, so the Sigmoid can't be removed.
+  GraphPattern pattern = CreateSiluPattern();
+  EXPECT_FALSE(pattern.Match(graph, mul));
+
+  pattern.SetExclusiveOutputs(1, false);
+  EXPECT_TRUE(pattern.Match(graph, mul));
+}
+
+TEST(PatternMatcherTest, RewriteRules) {
+  auto model = CreateModel();
+  Graph& graph = model->MainGraph();
+  NodeArg& x = CreateFloatArg(graph, "x");
+  NodeArg& transpose_1 = CreateFloatArg(graph, "transpose_1");
+  NodeArg& transpose_2 = CreateFloatArg(graph, "transpose_2");
+  NodeArg& transpose_3 = CreateFloatArg(graph, "transpose_3");
+  NodeArg& neg_1 = CreateFloatArg(graph, "neg_1");
+  NodeArg& y = CreateFloatArg(graph, "y");
+
+  graph.AddNode("transpose_1", "Transpose", "", {&x}, {&transpose_1}).AddAttribute("perm", std::vector<int64_t>{1, 0});
+  graph.AddNode("transpose_2", "Transpose", "", {&transpose_1}, {&transpose_2})
+      .AddAttribute("perm", std::vector<int64_t>{1, 0});
+  // transposes a third time, with a perm that does not cancel the second one.
+  graph.AddNode("transpose_3", "Transpose", "", {&transpose_2}, {&transpose_3})
+      .AddAttribute("perm", std::vector<int64_t>{0, 1});
+  graph.AddNode("neg_1", "Neg", "", {&transpose_3}, {&neg_1});
+  graph.AddNode("neg_2", "Neg", "", {&neg_1}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  // Transpose(Transpose(x, perm=1,0), perm=1,0) and Neg(Neg(x)) are both x.
+  GraphPattern transpose_pattern("Transpose", {1, 13});
+  transpose_pattern.AddPredicate(0, GraphPattern::AttributeEquals("perm", std::vector<int64_t>{1, 0}));
+  const int inner_transpose = transpose_pattern.AddInput(0, 0, "Transpose", {1, 13});
+  transpose_pattern.AddPredicate(inner_transpose, GraphPattern::AttributeEquals("perm", std::vector<int64_t>{1, 0}));
+
+  GraphPattern neg_pattern("Neg", {6, 13});
+  const int inner_neg = neg_pattern.AddInput(0, 0, "Neg", {6, 13});
+
+  RuleBasedGraphTransformer transformer("PatternMatcherTestTransformer");
+  ASSERT_STATUS_OK(transformer.Register(std::make_unique<PatternRewriteRule>(
+      "TransposePair", std::move(transpose_pattern),
+      [inner_transpose](Graph& graph, const PatternMatch& match, const logging::Logger&) {
+        return ReplaceWithIdentity(graph, match, inner_transpose);
+      })));
+  ASSERT_STATUS_OK(transformer.Register(std::make_unique<PatternRewriteRule>(
+      "NegPair", std::move(neg_pattern),
+      [inner_neg](Graph& graph, const PatternMatch& match, const logging::Logger&) {
+        return ReplaceWithIdentity(graph, match, inner_neg);
+      })));
+
+  bool modified = false;
+  ASSERT_STATUS_OK(transformer.Apply(graph, modified, DefaultLoggingManager().DefaultLogger()));
+  EXPECT_TRUE(modified);
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Transpose"], 1);
+  EXPECT_EQ(op_to_count["Neg"], 0);
+  EXPECT_EQ(op_to_count["Identity"], 2);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -511,6 +511,75 @@ TEST(QDQTransformerTests, DQMatMulConvertedToMatMulNBits_Cuda) {
   RunDQMatMulConverted<UInt4x2, false>({12, 12}, {12, 37}, {37, 12}, 0, 16, 1, DefaultCudaExecutionProvider());
 }
 
+//  weight   indices
+//    |        |
+//    DQ       |
+//     \      /
+//      Gather
+//        |
+//      output
+template <typename T, bool use_zp>
+typename std::enable_if<std::is_same_v<T, Int4x2> || std::is_same_v<T, UInt4x2>, void>::type
+RunDQGatherConverted(const std::vector<int64_t>& weight_shape,
+                     const std::vector<int64_t>& indices_shape,
+                     const std::vector<int64_t>& indices,
+                     const int64_t gather_axis,
+                     const int64_t quantize_axis,
+                     const int64_t block_size) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* indices_arg = builder.MakeInput<int64_t>(indices_shape, indices);
+    auto* output_arg = builder.MakeOutput();
+
+    // add DQ
+    NodeAttributes dq_attrs;
+    utils::SetNodeAttribute(utils::MakeAttribute("axis", quantize_axis), dq_attrs);
+    utils::SetNodeAttribute(utils::MakeAttribute("block_size", block_size), dq_attrs);
+    auto scale_shape = std::vector<int64_t>{weight_shape};
+    scale_shape[quantize_axis] = (scale_shape[quantize_axis] + block_size - 1) / block_size;
+
+    auto* weight_arg = builder.MakeInitializer(weight_shape, T(T::min_val, 0), T(T::max_val, 0));
+    auto* scales_arg = builder.MakeInitializer(scale_shape, 8.0f, 12.0f);
+    auto* dq_output = builder.MakeIntermediate();
+    if constexpr (use_zp) {
+      auto* zp_arg = builder.MakeInitializer(scale_shape, T(0, 0), T(2, 0));
+      builder.AddNode("DequantizeLinear", {weight_arg, scales_arg, zp_arg}, {dq_output}, "", &dq_attrs);
+    } else {
+      builder.AddNode("DequantizeLinear", {weight_arg, scales_arg}, {dq_output}, "", &dq_attrs);
+    }
+
+    NodeAttributes gather_attrs;
+    utils::SetNodeAttribute(utils::MakeAttribute("axis", gather_axis), gather_attrs);
+    builder.AddNode("Gather", {dq_output, indices_arg}, {output_arg}, "", &gather_attrs);
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    const QDQOpKeys qdq_keys = GetQDQOpKeys(false);
+    EXPECT_EQ(op_to_count["Gather"], 0);
+    EXPECT_EQ(op_to_count["com.microsoft.GatherBlockQuantized"], 1);
+    EXPECT_EQ(op_to_count[qdq_keys.dequantize_linear], 0);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    21 /*opset_version*/,
+                    1e-5 /*per_sample_tolerance*/,
+                    2e-5 /*relative_per_sample_tolerance*/);
+}
+
+TEST(QDQTransformerTests, DQGatherConvertedToGatherBlockQuantized) {
+  // embedding table quantized along the hidden dimension
+  RunDQGatherConverted<Int4x2, true>({12, 37}, {2, 3}, {0, 5, 11, 2, 7, 5}, 0, 1, 16);
+  RunDQGatherConverted<Int4x2, false>({12, 37}, {2, 3}, {0, 5, 11, 2, 7, 5}, 0, 1, 16);
+  RunDQGatherConverted<UInt4x2, true>({12, 37}, {2, 3}, {0, 5, 11, 2, 7, 5}, 0, 1, 16);
+  RunDQGatherConverted<UInt4x2, false>({12, 37}, {2, 3}, {0, 5, 11, 2, 7, 5}, 0, 1, 16);
+  // gather and quantize along the same axis
+  RunDQGatherConverted<Int4x2, true>({12, 37}, {4}, {36, 0, 17, 36}, 1, 1, 32);
+  RunDQGatherConverted<UInt4x2, false>({37, 12}, {3}, {20, 1, 33}, 0, 0, 16);
+}
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 }  // namespace test
@@ -1878,6 +1878,61 @@ TEST(QDQTransformerTests, Where) {
   test_case({1}, {1}, {1}, true /*use_contrib_qdq*/);
 }
 
+TEST(QDQTransformerTests, LayerNormalization) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, bool has_bias, bool use_contrib_qdq = false) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      const int64_t N = input_shape.back();
+      auto* input_arg = builder.MakeInput<int8_t>(input_shape, int8_t(-64), int8_t(64));
+      auto* output_arg = builder.MakeOutput();
+
+      // add DQ
+      auto* dq_x_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<int8_t>(input_arg, .05f, 0, dq_x_output, use_contrib_qdq);
+
+      auto* scale_arg = builder.MakeInitializer<int8_t>({N}, int8_t(50), int8_t(127));
+      auto* dq_scale_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<int8_t>(scale_arg, .01f, 0, dq_scale_output, use_contrib_qdq);
+
+      std::vector<NodeArg*> layer_norm_inputs{dq_x_output, dq_scale_output};
+      if (has_bias) {
+        auto* bias_arg = builder.MakeInitializer<int32_t>({N}, -1000, 1000);
+        auto* dq_bias_output = builder.MakeIntermediate();
+        builder.AddDequantizeLinearNode<int32_t>(bias_arg, .0005f, 0, dq_bias_output, use_contrib_qdq);
+        layer_norm_inputs.push_back(dq_bias_output);
+      }
+
+      // add LayerNormalization
+      auto* layer_norm_output = builder.MakeIntermediate();
+      Node& layer_norm_node = builder.AddNode("LayerNormalization", layer_norm_inputs, {layer_norm_output});
+      layer_norm_node.AddAttribute("axis", static_cast<int64_t>(-1));
+
+      // add Q
+      builder.AddQuantizeLinearNode<int8_t>(layer_norm_output, .02f, 0, output_arg, use_contrib_qdq);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      const QDQOpKeys qdq_keys = GetQDQOpKeys(use_contrib_qdq);
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearLayerNormalization"], 1);
+      EXPECT_EQ(op_to_count["LayerNormalization"], 0);
+      EXPECT_EQ(op_to_count[qdq_keys.quantize_linear], 0);
+      EXPECT_EQ(op_to_count[qdq_keys.dequantize_linear], 0);
+    };
+
+    // the fp32 and fused results may round to adjacent quantized values
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      17 /*opset_version*/,
+                      1.0 /*per_sample_tolerance*/);
+  };
+
+  test_case({2, 3, 32}, true);
+  test_case({2, 3, 32}, false);
+  test_case({4, 7}, true, true /*use_contrib_qdq*/);
+}
+
 template <typename QuantType>
 static void RunDropQDQTransposeTestCase(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perms,
                                         bool use_contrib_qdq = false,
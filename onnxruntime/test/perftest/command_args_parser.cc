@@ -39,6 +39,22 @@ namespace perftest {
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding. Free dimensions are treated as 1 unless overridden using -f.\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t-Q [target_qps]: Runs an open-loop test issuing requests at the target rate, whether or not the previous ones\n"
+      "\t\tcompleted, with -c workers running them. A comma separated list of rates, e.g. 10,20,50, measures the\n"
+      "\t\tlatency at each rate. Reports the latency percentiles, measured from the scheduled arrival of the requests,\n"
+      "\t\tand their queueing delay. The number of requests or the duration at each rate is set by -r or -t.\n"
+      "\t-a [poisson|constant]: Arrival process of the open-loop requests. Default:'poisson'.\n"
+      "\t-L [latency_report_file]: Writes the latency percentiles of each open-loop rate to a CSV file, or a JSON file\n"
+      "\t\tif the file name ends with '.json'.\n"
+      "\t-k [model_path|weight]: Loads another model in the same process and sends it a share of the requests set by\n"
+      "\t\tits weight, the tested model having a weight of 1. May be repeated. The latency of each model running alone\n"
+      "\t\tand co-located with the others is reported. The weight defaults to 1.\n"
+      "\t-G: Runs the sessions on the global thread pools of the environment, sized by -x and -y.\n"
+      "\t-E: Shares a CPU arena registered with the environment between the sessions.\n"
+      "\t-K: Benchmarks each kernel of the model in isolation, with the shapes it runs with in the model, and reports\n"
+      "\t\tthe kernels ranked by their time in the model with their achieved GFLOP/s and GB/s. Each kernel runs -r times.\n"
+      "\t-W [peak_gflops,peak_gbps]: Peak compute and memory bandwidth of the device, to report the share of them the\n"
+      "\t\tkernels achieve with -K.\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|openvino|dml|acl|nnapi|coreml|qnn|snpe|rocm|migraphx|xnnpack|vitisai|webgpu]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'nvtensorrtrtx', 'openvino', 'dml', 'acl', 'nnapi', 'coreml', 'qnn', 'snpe', 'rocm', 'migraphx', 'xnnpack', 'vitisai' or 'webgpu'. "
       "Default:'cpu'.\n"
@@ -124,6 +140,7 @@ namespace perftest {
       "\t    [TensorRT only] [trt_engine_cache_path]: Specify engine cache path.\n"
       "\t    [TensorRT only] [trt_engine_cache_prefix]: Customize engine cache prefix when trt_engine_cache_enable is true.\n"
       "\t    [TensorRT only] [trt_engine_hw_compatible]: Enable hardware compatibility. Engines ending with '_sm80+' can be re-used across all Ampere+ GPU (a hardware-compatible engine may have lower throughput and/or higher latency than its non-hardware-compatible counterpart).\n"
+      "\t    [TensorRT only] [trt_engine_async_build]: Build engines for new input shapes in the background and run with CUDA EP until they are ready.\n"
       "\t    [TensorRT only] [trt_weight_stripped_engine_enable]: Enable weight-stripped engine build.\n"
       "\t    [TensorRT only] [trt_onnx_model_folder_path]: Folder path for the ONNX model with weights.\n"
       "\t    [TensorRT only] [trt_force_sequential_engine_build]: Force TensorRT engines to be built sequentially.\n"
@@ -195,7 +212,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:AMPIDZvhsqznlgR:X"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:Q:a:L:k:W:AMPIDZvhsqznlgR:XGEK"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -404,6 +421,87 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
       case 'X':
         test_config.run_config.use_extensions = true;
         break;
+      case 'Q': {
+        test_config.run_config.target_qps.clear();
+        std::basic_string<ORTCHAR_T> rates(optarg);
+        size_t begin = 0;
+        while (begin <= rates.size()) {
+          size_t end = rates.find(ORT_TSTR(','), begin);
+          if (end == std::basic_string<ORTCHAR_T>::npos) {
+            end = rates.size();
+          }
+          ORT_TRY {
+            const double qps = std::stod(rates.substr(begin, end - begin));
+            if (!(qps > 0)) {
+              return false;
+            }
+            test_config.run_config.target_qps.push_back(qps);
+          }
+          ORT_CATCH(...) {
+            return false;
+          }
+          begin = end + 1;
+        }
+        break;
+      }
+      case 'a':
+        if (!CompareCString(optarg, ORT_TSTR("poisson"))) {
+          test_config.run_config.arrival_pattern = ArrivalPattern::kPoisson;
+        } else if (!CompareCString(optarg, ORT_TSTR("constant"))) {
+          test_config.run_config.arrival_pattern = ArrivalPattern::kConstantRate;
+        } else {
+          return false;
+        }
+        break;
+      case 'L':
+        test_config.run_config.latency_report_file = optarg;
+        break;
+      case 'k': {
+        std::basic_string<ORTCHAR_T> model(optarg);
+        double weight = 1.0;
+        const size_t pos = model.rfind(ORT_TSTR('|'));
+        if (pos != std::basic_string<ORTCHAR_T>::npos) {
+          ORT_TRY {
+            weight = std::stod(model.substr(pos + 1));
+          }
+          ORT_CATCH(...) {
+            return false;
+          }
+          model.resize(pos);
+        }
+        if (model.empty() || !(weight > 0)) {
+          return false;
+        }
+        test_config.run_config.co_located_models.emplace_back(std::move(model), weight);
+        break;
+      }
+      case 'K':
+        test_config.run_config.kernel_benchmark = true;
+        break;
+      case 'W': {
+        std::basic_string<ORTCHAR_T> peaks(optarg);
+        const size_t pos = peaks.find(ORT_TSTR(','));
+        if (pos == std::basic_string<ORTCHAR_T>::npos) {
+          return false;
+        }
+        ORT_TRY {
+          test_config.run_config.peak_gflops = std::stod(peaks.substr(0, pos));
+          test_config.run_config.peak_gbps = std::stod(peaks.substr(pos + 1));
+        }
+        ORT_CATCH(...) {
+          return false;
+        }
+        if (test_config.run_config.peak_gflops < 0 || test_config.run_config.peak_gbps < 0) {
+          return false;
+        }
+        break;
+      }
+      case 'G':
+        test_config.run_config.use_global_thread_pools = true;
+        break;
+      case 'E':
+        test_config.run_config.use_env_allocators = true;
+        break;
       case '?':
       case 'h':
       default:
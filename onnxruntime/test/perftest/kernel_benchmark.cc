@@ -0,0 +1,446 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "kernel_benchmark.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/common/path_string.h"
+#include "core/graph/onnx_protobuf.h"
+#include "nlohmann/json.hpp"
+#include "TestCase.h"
+#include "ort_test_session.h"
+#include "performance_runner.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+using json = nlohmann::json;
+
+namespace {
+
+// runs of the model profiled to get its kernels, after the warm-up run
+constexpr size_t kProfiledRuns = 10;
+
+struct TensorTypeShape {
+  ONNX_NAMESPACE::TensorProto_DataType type{ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED};
+  size_t element_size{0};
+  std::vector<int64_t> shape;
+
+  double ElementCount() const {
+    double count = 1;
+    for (const auto dim : shape) {
+      count *= static_cast<double>(dim);
+    }
+    return count;
+  }
+};
+
+// Parses the input_type_shape or output_type_shape of a kernel time event of the profile,
+// e.g. [{"float":[1,3,224,224]},{"int64":[4]}]. Returns false for a type with no tensor element type.
+bool ParseTypeShapes(const json& type_shapes, std::vector<TensorTypeShape>& result) {
+  // the names of DataTypeImpl::ToString
+  static const std::unordered_map<std::string, std::pair<ONNX_NAMESPACE::TensorProto_DataType, size_t>> types = {
+      {"float", {ONNX_NAMESPACE::TensorProto_DataType_FLOAT, 4}},
+      {"double", {ONNX_NAMESPACE::TensorProto_DataType_DOUBLE, 8}},
+      {"float16", {ONNX_NAMESPACE::TensorProto_DataType_FLOAT16, 2}},
+      {"bfloat16", {ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16, 2}},
+      {"int8", {ONNX_NAMESPACE::TensorProto_DataType_INT8, 1}},
+      {"uint8", {ONNX_NAMESPACE::TensorProto_DataType_UINT8, 1}},
+      {"int16", {ONNX_NAMESPACE::TensorProto_DataType_INT16, 2}},
+      {"uint16", {ONNX_NAMESPACE::TensorProto_DataType_UINT16, 2}},
+      {"int32", {ONNX_NAMESPACE::TensorProto_DataType_INT32, 4}},
+      {"uint32", {ONNX_NAMESPACE::TensorProto_DataType_UINT32, 4}},
+      {"int64", {ONNX_NAMESPACE::TensorProto_DataType_INT64, 8}},
+      {"uint64", {ONNX_NAMESPACE::TensorProto_DataType_UINT64, 8}},
+      {"bool", {ONNX_NAMESPACE::TensorProto_DataType_BOOL, 1}},
+  };
+
+  result.clear();
+  if (!type_shapes.is_array()) {
+    return false;
+  }
+  for (const auto& type_shape : type_shapes) {
+    if (!type_shape.is_object() || type_shape.size() != 1) {
+      return false;
+    }
+    const auto type = types.find(type_shape.begin().key());
+    if (type == types.end() || !type_shape.begin().value().is_array()) {
+      return false;
+    }
+    TensorTypeShape tensor;
+    tensor.type = type->second.first;
+    tensor.element_size = type->second.second;
+    for (const auto& dim : type_shape.begin().value()) {
+      tensor.shape.push_back(dim.get<int64_t>());
+    }
+    result.push_back(std::move(tensor));
+  }
+  return true;
+}
+
+int64_t GetIntAttribute(const ONNX_NAMESPACE::NodeProto& node, const std::string& name, int64_t default_value) {
+  for (const auto& attribute : node.attribute()) {
+    if (attribute.name() == name) {
+      return attribute.i();
+    }
+  }
+  return default_value;
+}
+
+// Multiply-adds count as 2 FLOPs. 0 for the operators with no FLOP model, whose GB/s is the relevant figure.
+double EstimateFlops(const ONNX_NAMESPACE::NodeProto& node, const std::vector<TensorTypeShape>& inputs,
+                     const std::vector<TensorTypeShape>& outputs) {
+  if (inputs.size() < 2 || outputs.empty() || inputs[0].shape.empty() || inputs[1].shape.empty()) {
+    return 0;
+  }
+
+  const std::string& op_type = node.op_type();
+  const auto& a = inputs[0].shape;
+  const auto& w = inputs[1].shape;
+  if (op_type == "MatMul" || op_type == "FusedMatMul" || op_type == "MatMulInteger" || op_type == "QLinearMatMul") {
+    return 2 * outputs[0].ElementCount() * static_cast<double>(a.back());
+  }
+  if (op_type == "Gemm") {
+    const int64_t k = GetIntAttribute(node, "transA", 0) != 0 ? a.front() : a.back();
+    return 2 * outputs[0].ElementCount() * static_cast<double>(k);
+  }
+  if (op_type == "Conv" || op_type == "FusedConv" || op_type == "NhwcConv" || op_type == "ConvTranspose") {
+    // the weight is [M, C / group, kernel...] for Conv and [C, M / group, kernel...] for ConvTranspose
+    double macs_per_element = 1;
+    for (size_t i = 1; i < w.size(); ++i) {
+      macs_per_element *= static_cast<double>(w[i]);
+    }
+    const auto& elements = op_type == "ConvTranspose" ? inputs[0] : outputs[0];
+    return 2 * elements.ElementCount() * macs_per_element;
+  }
+  return 0;
+}
+
+double GetBytes(const std::vector<TensorTypeShape>& inputs, const std::vector<TensorTypeShape>& outputs) {
+  double bytes = 0;
+  for (const auto* tensors : {&inputs, &outputs}) {
+    for (const auto& tensor : *tensors) {
+      bytes += tensor.ElementCount() * static_cast<double>(tensor.element_size);
+    }
+  }
+  return bytes;
+}
+
+void SetValueInfo(const std::string& name, const TensorTypeShape* tensor, ONNX_NAMESPACE::ValueInfoProto& value_info) {
+  value_info.set_name(name);
+  if (tensor == nullptr) {
+    return;
+  }
+  auto* tensor_type = value_info.mutable_type()->mutable_tensor_type();
+  tensor_type->set_elem_type(tensor->type);
+  auto* shape = tensor_type->mutable_shape();
+  for (const auto dim : tensor->shape) {
+    shape->add_dim()->set_dim_value(dim);
+  }
+}
+
+// Creates a model running the node alone, with its initializers and inputs of the shapes it ran with.
+Status CreateKernelModel(const ONNX_NAMESPACE::ModelProto& model, const ONNX_NAMESPACE::NodeProto& node,
+                         const std::unordered_map<std::string, const ONNX_NAMESPACE::TensorProto*>& initializers,
+                         const std::vector<TensorTypeShape>& inputs, const std::vector<TensorTypeShape>& outputs,
+                         ONNX_NAMESPACE::ModelProto& kernel_model) {
+  kernel_model.set_ir_version(model.ir_version());
+  *kernel_model.mutable_opset_import() = model.opset_import();
+  auto* graph = kernel_model.mutable_graph();
+  graph->set_name(node.name());
+  *graph->add_node() = node;
+
+  // the profile lists the shapes of the present inputs, so the missing optional inputs are skipped
+  std::unordered_set<std::string> added_inputs;
+  size_t input_index = 0;
+  for (const auto& input : node.input()) {
+    if (input.empty()) {
+      continue;
+    }
+    if (input_index >= inputs.size()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "the profiled inputs do not match the node inputs");
+    }
+    const auto& tensor = inputs[input_index++];
+    if (!added_inputs.insert(input).second) {
+      continue;
+    }
+    const auto initializer = initializers.find(input);
+    if (initializer != initializers.end()) {
+      *graph->add_initializer() = *initializer->second;
+    } else {
+      SetValueInfo(input, &tensor, *graph->add_input());
+    }
+  }
+
+  size_t output_index = 0;
+  for (const auto& output : node.output()) {
+    if (output.empty()) {
+      continue;
+    }
+    const TensorTypeShape* tensor = output_index < outputs.size() ? &outputs[output_index] : nullptr;
+    ++output_index;
+    SetValueInfo(output, tensor, *graph->add_output());
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
+KernelBenchmark::KernelBenchmark(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
+    : env_(env), rd_(rd), test_config_(test_config) {
+}
+
+Status KernelBenchmark::ProfileModel(std::string& profile_file,
+                                     std::basic_string<ORTCHAR_T>& optimized_model_path) {
+  const std::filesystem::path model_path(test_config_.model_info.model_file_path);
+  const std::filesystem::path temp_dir = std::filesystem::temp_directory_path();
+  optimized_model_path = (temp_dir / (model_path.stem().native() + ORT_TSTR("_kernels_optimized.onnx"))).native();
+
+  // the optimized model holds the nodes after partitioning, named like the kernel time events of the profile
+  PerformanceTestConfig config = test_config_;
+  auto& run_config = config.run_config;
+  run_config.profile_file = (temp_dir / (model_path.stem().native() + ORT_TSTR("_kernels"))).native();
+  run_config.optimized_model_path = optimized_model_path;
+  run_config.test_mode = TestMode::KFixRepeatedTimesMode;
+  run_config.repeated_times = kProfiledRuns;
+  run_config.concurrent_session_runs = 1;
+  run_config.target_qps.clear();
+  run_config.co_located_models.clear();
+
+  PerformanceRunner runner(env_, config, rd_);
+  ORT_RETURN_IF_ERROR(runner.Run());
+  profile_file = runner.EndProfiling();
+  return Status::OK();
+}
+
+Status KernelBenchmark::BenchmarkKernel(const std::basic_string<ORTCHAR_T>& kernel_model_path,
+                                        KernelResult& result) {
+  PerformanceTestConfig config = test_config_;
+  auto& run_config = config.run_config;
+  config.model_info.model_file_path = kernel_model_path;
+  run_config.generate_model_input_binding = true;
+  run_config.profile_file.clear();
+  run_config.optimized_model_path.clear();
+  run_config.free_dim_name_overrides.clear();
+  run_config.free_dim_denotation_overrides.clear();
+
+  auto status = Status::OK();
+  ORT_TRY {
+    auto model_info = TestModelInfo::LoadOnnxModel(kernel_model_path);
+    OnnxRuntimeTestSession session(env_, rd_, config, *model_info);
+    session.PopulateGeneratedInputTestData(run_config.random_seed_for_input_data);
+
+    // warm up
+    session.Run();
+    std::vector<double> times;
+    const size_t runs = std::max<size_t>(run_config.repeated_times, 1);
+    for (size_t i = 0; i < runs; ++i) {
+      times.push_back(session.Run().count());
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    result.isolated_time = times[times.size() / 2];
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+    });
+  }
+  return status;
+}
+
+Status KernelBenchmark::Run() {
+  std::string profile_file;
+  std::basic_string<ORTCHAR_T> optimized_model_path;
+  ORT_RETURN_IF_ERROR(ProfileModel(profile_file, optimized_model_path));
+
+  ONNX_NAMESPACE::ModelProto model;
+  {
+    std::ifstream model_stream(optimized_model_path, std::ios::in | std::ios::binary);
+    if (!model_stream.good() || !model.ParseFromIstream(&model_stream)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to load the optimized model ",
+                             ToUTF8String(optimized_model_path));
+    }
+  }
+  std::unordered_map<std::string, const ONNX_NAMESPACE::NodeProto*> nodes;
+  for (const auto& node : model.graph().node()) {
+    nodes.emplace(node.name(), &node);
+  }
+  std::unordered_map<std::string, const ONNX_NAMESPACE::TensorProto*> initializers;
+  for (const auto& initializer : model.graph().initializer()) {
+    initializers.emplace(initializer.name(), &initializer);
+  }
+
+  std::ifstream profile_stream(profile_file);
+  const json profile = json::parse(profile_stream, nullptr, false);
+  if (profile.is_discarded() || !profile.is_array()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to parse the profile ", profile_file);
+  }
+
+  // the kernel time events of the profile are named <node name>_kernel_time
+  constexpr std::string_view kKernelTimeSuffix = "_kernel_time";
+  struct NodeProfile {
+    const json* event{nullptr};
+    double total_time{0};
+    size_t runs{0};
+  };
+  std::map<std::string, NodeProfile> node_profiles;
+  for (const auto& event : profile) {
+    if (!event.is_object() || event.value("cat", std::string{}) != "Node") {
+      continue;
+    }
+    const std::string name = event.value("name", std::string{});
+    if (name.size() <= kKernelTimeSuffix.size() ||
+        name.compare(name.size() - kKernelTimeSuffix.size(), kKernelTimeSuffix.size(), kKernelTimeSuffix) != 0) {
+      continue;
+    }
+    auto& node_profile = node_profiles[name.substr(0, name.size() - kKernelTimeSuffix.size())];
+    node_profile.event = &event;
+    node_profile.total_time += event.value("dur", 0.0) / 1e6;
+    ++node_profile.runs;
+  }
+
+  // the nodes with the same operator, attributes and input shapes run the same kernel
+  struct Kernel {
+    const ONNX_NAMESPACE::NodeProto* node{nullptr};
+    std::vector<TensorTypeShape> inputs;
+    std::vector<TensorTypeShape> outputs;
+  };
+  std::vector<Kernel> kernels;
+  std::unordered_map<std::string, size_t> kernel_indices;
+  for (const auto& [node_name, node_profile] : node_profiles) {
+    const json& args = node_profile.event->value("args", json::object());
+    const std::string provider = args.value("provider", std::string{});
+    const json input_type_shape = args.value("input_type_shape", json::array());
+    const auto node = nodes.find(node_name);
+
+    std::string signature = provider + "|" + input_type_shape.dump();
+    if (node != nodes.end()) {
+      signature += "|" + node->second->domain() + "|" + node->second->op_type();
+      for (const auto& attribute : node->second->attribute()) {
+        signature += "|" + attribute.SerializeAsString();
+      }
+    } else {
+      signature += "|" + node_name;
+    }
+
+    auto [kernel_index, inserted] = kernel_indices.emplace(signature, kernels.size());
+    if (inserted) {
+      Kernel kernel;
+      KernelResult result;
+      result.op_type = args.value("op_name", std::string{});
+      result.provider = provider;
+      result.input_type_shape = input_type_shape.dump();
+      if (node == nodes.end()) {
+        // e.g. a node compiled by an execution provider or a node of a subgraph
+        result.skipped_reason = "not in the optimized model";
+      } else if (!ParseTypeShapes(input_type_shape, kernel.inputs) ||
+                 !ParseTypeShapes(args.value("output_type_shape", json::array()), kernel.outputs)) {
+        result.skipped_reason = "unsupported input or output type";
+      } else {
+        kernel.node = node->second;
+        result.flops = EstimateFlops(*kernel.node, kernel.inputs, kernel.outputs);
+        result.bytes = GetBytes(kernel.inputs, kernel.outputs);
+      }
+      kernels.push_back(std::move(kernel));
+      results_.push_back(std::move(result));
+    }
+
+    auto& result = results_[kernel_index->second];
+    ++result.node_count;
+    result.model_time += node_profile.total_time / static_cast<double>(node_profile.runs);
+  }
+
+  const std::filesystem::path kernel_model_dir = std::filesystem::path(optimized_model_path).parent_path();
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    auto& result = results_[i];
+    if (kernels[i].node == nullptr) {
+      continue;
+    }
+    const std::string& op_type = kernels[i].node->op_type();
+    if (op_type == "MemcpyFromHost" || op_type == "MemcpyToHost") {
+      result.skipped_reason = "copy between devices";
+      continue;
+    }
+
+    ONNX_NAMESPACE::ModelProto kernel_model;
+    auto status = CreateKernelModel(model, *kernels[i].node, initializers, kernels[i].inputs, kernels[i].outputs,
+                                    kernel_model);
+    if (status.IsOK()) {
+      // next to the optimized model, so the external data of its initializers is found
+      const std::filesystem::path kernel_model_path =
+          kernel_model_dir / (ORT_TSTR("kernel_") + ToPathString(std::to_string(i)) + ORT_TSTR(".onnx"));
+      {
+        std::ofstream kernel_model_stream(kernel_model_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!kernel_model.SerializeToOstream(&kernel_model_stream)) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to write ", kernel_model_path.string());
+        }
+      }
+      status = BenchmarkKernel(kernel_model_path.native(), result);
+      std::error_code ec;
+      std::filesystem::remove(kernel_model_path, ec);
+    }
+    if (!status.IsOK()) {
+      result.skipped_reason = status.ErrorMessage();
+    }
+  }
+
+  std::sort(results_.begin(), results_.end(),
+            [](const KernelResult& a, const KernelResult& b) { return a.model_time > b.model_time; });
+  return Status::OK();
+}
+
+void KernelBenchmark::PrintReport() const {
+  const auto& run_config = test_config_.run_config;
+  double total_model_time = 0;
+  for (const auto& result : results_) {
+    total_model_time += result.model_time;
+  }
+
+  // times in us, the share of the peaks is printed when they are given
+  std::cout << "\nRank,Op,Provider,Nodes,Model Time,Model Time %,Isolated Time,GFLOP/s,GB/s,Peak FLOP/s %,"
+               "Peak Bandwidth %,Input Shapes,Skipped\n";
+  for (size_t i = 0; i < results_.size(); ++i) {
+    const auto& result = results_[i];
+    std::cout << i + 1 << "," << result.op_type << "," << result.provider << "," << result.node_count << ","
+              << result.model_time * 1e6 << ","
+              << (total_model_time > 0 ? result.model_time / total_model_time * 100 : 0) << ",";
+    if (result.skipped_reason.empty() && result.isolated_time > 0) {
+      const double gflops = result.flops / result.isolated_time / 1e9;
+      const double gbps = result.bytes / result.isolated_time / 1e9;
+      std::cout << result.isolated_time * 1e6 << ",";
+      if (result.flops > 0) {
+        std::cout << gflops;
+      }
+      std::cout << "," << gbps << ",";
+      if (result.flops > 0 && run_config.peak_gflops > 0) {
+        std::cout << gflops / run_config.peak_gflops * 100;
+      }
+      std::cout << ",";
+      if (run_config.peak_gbps > 0) {
+        std::cout << gbps / run_config.peak_gbps * 100;
+      }
+      std::cout << ",";
+    } else {
+      std::cout << ",,,,,";
+    }
+    // the shapes and the reason are quoted, as they contain commas
+    std::string skipped_reason = result.skipped_reason;
+    std::replace(skipped_reason.begin(), skipped_reason.end(), '"', '\'');
+    std::string input_type_shape = result.input_type_shape;
+    std::replace(input_type_shape.begin(), input_type_shape.end(), '"', '\'');
+    std::cout << "\"" << input_type_shape << "\",\"" << skipped_reason << "\"\n";
+  }
+  std::cout << std::flush;
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+#include <core/common/status.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include "test_configuration.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+// The nodes of a model sharing an operator, attributes and input shapes, benchmarked as a single kernel.
+struct KernelResult {
+  std::string op_type;
+  std::string provider;
+  std::string input_type_shape;
+  size_t node_count{0};
+  // sum of the kernel times of the nodes in a run of the model, in seconds
+  double model_time{0};
+  // median time of a run of a single node model of the kernel, in seconds
+  double isolated_time{0};
+  // 0 if the operator has no FLOP model
+  double flops{0};
+  double bytes{0};
+  // why the kernel could not be benchmarked in isolation, empty if it was
+  std::string skipped_reason;
+};
+
+// Benchmarks each kernel of a model in isolation, with the shapes it runs with in the model.
+// The model is first profiled to get the kernels after partitioning and their input shapes, then a single node
+// model is created and run for each distinct kernel with the same execution provider.
+class KernelBenchmark {
+ public:
+  KernelBenchmark(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd);
+
+  Status Run();
+
+  // Prints the kernels ranked by their time in the model, with their achieved GFLOP/s and GB/s.
+  void PrintReport() const;
+
+ private:
+  Status ProfileModel(std::string& profile_file, std::basic_string<ORTCHAR_T>& optimized_model_path);
+  Status BenchmarkKernel(const std::basic_string<ORTCHAR_T>& kernel_model_path, KernelResult& result);
+
+  Ort::Env& env_;
+  std::random_device& rd_;
+  PerformanceTestConfig test_config_;
+  std::vector<KernelResult> results_;
+};
+
+}  // namespace perftest
+}  // namespace onnxruntime
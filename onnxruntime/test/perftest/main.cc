@@ -5,6 +5,7 @@
 #include <core/session/onnxruntime_c_api.h>
 #include <random>
 #include "command_args_parser.h"
+#include "kernel_benchmark.h"
 #include "performance_runner.h"
 #include <google/protobuf/stubs/common.h>
 
@@ -29,7 +30,29 @@ int real_main(int argc, char* argv[]) {
       OrtLoggingLevel logging_level = test_config.run_config.f_verbose
                                           ? ORT_LOGGING_LEVEL_VERBOSE
                                           : ORT_LOGGING_LEVEL_WARNING;
-      env = Ort::Env(logging_level, "Default");
+      const auto& run_config = test_config.run_config;
+      if (run_config.use_global_thread_pools) {
+        Ort::ThreadingOptions tp_options;
+        if (run_config.intra_op_num_threads > 0) {
+          tp_options.SetGlobalIntraOpNumThreads(run_config.intra_op_num_threads);
+        }
+        if (run_config.inter_op_num_threads > 0) {
+          tp_options.SetGlobalInterOpNumThreads(run_config.inter_op_num_threads);
+        }
+        if (run_config.disable_spinning) {
+          tp_options.SetGlobalSpinControl(0);
+        }
+        env = Ort::Env(tp_options, logging_level, "Default");
+      } else {
+        env = Ort::Env(logging_level, "Default");
+      }
+
+      if (run_config.use_env_allocators) {
+        // a CPU arena shared by all the sessions, with the default arena settings
+        Ort::MemoryInfo memory_info("Cpu", OrtArenaAllocator, 0, OrtMemTypeDefault);
+        Ort::ArenaCfg arena_cfg(0, -1, -1, -1);
+        env.CreateAndRegisterAllocator(memory_info, arena_cfg);
+      }
     }
     ORT_CATCH(const Ort::Exception& e) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -42,6 +65,18 @@ int real_main(int argc, char* argv[]) {
       return -1;
   }
   std::random_device rd;
+  if (test_config.run_config.kernel_benchmark) {
+    perftest::KernelBenchmark kernel_benchmark(env, test_config, rd);
+    auto status = kernel_benchmark.Run();
+    if (!status.IsOK()) {
+      printf("Run failed:%s\n", status.ErrorMessage().c_str());
+      return -1;
+    }
+
+    kernel_benchmark.PrintReport();
+    return 0;
+  }
+
   perftest::PerformanceRunner perf_runner(env, test_config, rd);
 
   // Exit if user enabled -n option so that user can measure session creation time
@@ -628,6 +628,18 @@ select from 'TF8', 'TF16', 'UINT8', 'FLOAT', 'ITENSOR'. \n)");
     session_options.AddConfigEntry(kOrtSessionOptionsConfigForceSpinningStop, "1");
   }
 
+  if (performance_test_config.run_config.use_global_thread_pools) {
+    // the thread pools of the environment are sized by -x and -y
+    fprintf(stdout, "Using the global thread pools of the environment\n");
+    session_options.DisablePerSessionThreads();
+  }
+
+  if (performance_test_config.run_config.use_env_allocators) {
+    warn_dup_config_entry(kOrtSessionOptionsConfigUseEnvAllocators);
+    fprintf(stdout, "Using the allocators registered with the environment\n");
+    session_options.AddConfigEntry(kOrtSessionOptionsConfigUseEnvAllocators, "1");
+  }
+
   if (!performance_test_config.run_config.register_custom_op_path.empty()) {
     session_options.RegisterCustomOpsLibrary(performance_test_config.run_config.register_custom_op_path.c_str());
   }
@@ -993,6 +1005,11 @@ static void InitializeTensorWithSeed(int32_t seed, Ort::Value& tensor) {
 #undef CASE_FOR_TYPE
 }
 
+std::string OnnxRuntimeTestSession::EndProfiling() {
+  Ort::AllocatorWithDefaultOptions allocator;
+  return session_.EndProfilingAllocated(allocator).get();
+}
+
 bool OnnxRuntimeTestSession::PopulateGeneratedInputTestData(int32_t seed) {
   Ort::AllocatorWithDefaultOptions default_allocator;
   // iterate over all input nodes
@@ -27,6 +27,9 @@ class OnnxRuntimeTestSession : public TestSession {
 
   bool PopulateGeneratedInputTestData(int32_t seed);
 
+  // Ends the profiling of the session and returns the profile file name.
+  std::string EndProfiling();
+
   ~OnnxRuntimeTestSession() = default;
 
   std::chrono::duration<double> Run() override;
@@ -7,7 +7,11 @@
 #endif
 
 #include "performance_runner.h"
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <numeric>
+#include <thread>
 
 #include "TestCase.h"
 #include "utils.h"
@@ -111,35 +115,132 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
   }
 }
 
+namespace {
+
+struct LatencyStats {
+  double mean{0};
+  double p50{0};
+  double p90{0};
+  double p99{0};
+  double p999{0};
+};
+
+// percentiles picked the same way as the statistics of PerformanceResult::DumpToFile
+LatencyStats GetLatencyStats(std::vector<double> values) {
+  LatencyStats stats;
+  if (values.empty()) {
+    return stats;
+  }
+
+  std::sort(values.begin(), values.end());
+  const size_t total = values.size();
+  stats.mean = std::accumulate(values.begin(), values.end(), 0.0) / total;
+  stats.p50 = values[static_cast<size_t>(total * 0.5)];
+  stats.p90 = values[static_cast<size_t>(total * 0.9)];
+  stats.p99 = values[static_cast<size_t>(total * 0.99)];
+  stats.p999 = values[static_cast<size_t>(total * 0.999)];
+  return stats;
+}
+
+}  // namespace
+
+Status PerformanceResult::DumpOpenLoopReport(const std::basic_string<ORTCHAR_T>& path) const {
+  std::ofstream outfile(path, std::ofstream::out | std::ofstream::trunc);
+  if (!outfile.good()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to open latency report file '", ToUTF8String(path), "'");
+  }
+
+  const bool json = HasExtensionOf(path, ORT_TSTR("json"));
+  if (json) {
+    outfile << "[";
+  } else {
+    outfile << "target_qps,achieved_qps,requests,failed_requests,latency_mean,latency_p50,latency_p90,latency_p99,"
+               "latency_p999,queueing_mean,queueing_p50,queueing_p99\n";
+  }
+
+  for (size_t i = 0; i < open_loop_results.size(); ++i) {
+    const auto& result = open_loop_results[i];
+    const auto latency = GetLatencyStats(result.latencies);
+    const auto queueing = GetLatencyStats(result.queueing_delays);
+    if (json) {
+      outfile << (i == 0 ? "\n" : ",\n")
+              << "  {\"target_qps\": " << result.target_qps
+              << ", \"achieved_qps\": " << result.achieved_qps
+              << ", \"requests\": " << result.latencies.size()
+              << ", \"failed_requests\": " << result.failed_requests
+              << ", \"latency_mean\": " << latency.mean
+              << ", \"latency_p50\": " << latency.p50
+              << ", \"latency_p90\": " << latency.p90
+              << ", \"latency_p99\": " << latency.p99
+              << ", \"latency_p999\": " << latency.p999
+              << ", \"queueing_mean\": " << queueing.mean
+              << ", \"queueing_p50\": " << queueing.p50
+              << ", \"queueing_p99\": " << queueing.p99 << "}";
+    } else {
+      outfile << result.target_qps << "," << result.achieved_qps << "," << result.latencies.size() << ","
+              << result.failed_requests << "," << latency.mean << "," << latency.p50 << "," << latency.p90 << ","
+              << latency.p99 << "," << latency.p999 << "," << queueing.mean << "," << queueing.p50 << ","
+              << queueing.p99 << "\n";
+    }
+  }
+
+  if (json) {
+    outfile << "\n]\n";
+  }
+
+  return Status::OK();
+}
+
 void PerformanceRunner::LogSessionCreationTime() {
   std::chrono::duration<double> session_create_duration = session_create_end_ - session_create_start_;
   std::cout << "\nSession creation time cost: " << session_create_duration.count() << " s\n";
 }
 
+std::string PerformanceRunner::EndProfiling() {
+  return static_cast<OnnxRuntimeTestSession*>(session_.get())->EndProfiling();
+}
+
 Status PerformanceRunner::Run() {
   if (!Initialize()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
   }
+  for (size_t i = 0; i < co_located_runners_.size(); ++i) {
+    if (!co_located_runners_[i]->Initialize()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize co-located model ",
+                             ToUTF8String(performance_test_config_.run_config.co_located_models[i].first));
+    }
+  }
 
   // warm up
   initial_inference_result_.start = std::chrono::high_resolution_clock::now();
   ORT_RETURN_IF_ERROR(RunOneIteration<true>());
   initial_inference_result_.end = std::chrono::high_resolution_clock::now();
+  for (auto& runner : co_located_runners_) {
+    ORT_RETURN_IF_ERROR(runner->RunOneIteration<true>());
+  }
+
+  if (!co_located_runners_.empty()) {
+    ORT_RETURN_IF_ERROR(RunSoloBaselines());
+  }
 
   // TODO: start profiling
   // if (!performance_test_config_.run_config.profile_file.empty())
   performance_result_.start = std::chrono::high_resolution_clock::now();
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(FixDurationTest());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RepeatedTimesTest());
-      break;
-    default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  if (!performance_test_config_.run_config.target_qps.empty()) {
+    ORT_RETURN_IF_ERROR(OpenLoopTest());
+  } else {
+    switch (performance_test_config_.run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ORT_RETURN_IF_ERROR(FixDurationTest());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ORT_RETURN_IF_ERROR(RepeatedTimesTest());
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
   }
   performance_result_.end = std::chrono::high_resolution_clock::now();
 
@@ -165,6 +266,41 @@ Status PerformanceRunner::Run() {
             << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
             << std::endl;
 
+  if (!performance_result_.open_loop_results.empty()) {
+    // the throughput vs latency curve, latencies in ms
+    std::cout << "\nTarget QPS,Achieved QPS,Requests,Failed,P50 Latency,P90 Latency,P99 Latency,P999 Latency,"
+                 "Mean Queueing Delay,P99 Queueing Delay\n";
+    for (const auto& result : performance_result_.open_loop_results) {
+      const auto latency = GetLatencyStats(result.latencies);
+      const auto queueing = GetLatencyStats(result.queueing_delays);
+      std::cout << result.target_qps << "," << result.achieved_qps << "," << result.latencies.size() << ","
+                << result.failed_requests << "," << latency.p50 * 1000 << "," << latency.p90 * 1000 << ","
+                << latency.p99 * 1000 << "," << latency.p999 * 1000 << "," << queueing.mean * 1000 << ","
+                << queueing.p99 * 1000 << "\n";
+    }
+    std::cout << std::flush;
+
+    if (!performance_test_config_.run_config.latency_report_file.empty()) {
+      ORT_RETURN_IF_ERROR(
+          performance_result_.DumpOpenLoopReport(performance_test_config_.run_config.latency_report_file));
+    }
+  }
+
+  if (!performance_result_.model_results.empty()) {
+    // latencies of each model in ms, the slowdown is the co-located latency over the latency running alone
+    std::cout << "\nModel,Weight,Requests,Solo P50 Latency,Solo P99 Latency,P50 Latency,P99 Latency,P50 Slowdown,"
+                 "P99 Slowdown\n";
+    for (const auto& model : performance_result_.model_results) {
+      const auto solo = GetLatencyStats(model.solo_time_costs);
+      const auto co_located = GetLatencyStats(model.time_costs);
+      std::cout << model.model_name << "," << model.weight << "," << model.time_costs.size() << ","
+                << solo.p50 * 1000 << "," << solo.p99 * 1000 << "," << co_located.p50 * 1000 << ","
+                << co_located.p99 * 1000 << "," << (solo.p50 > 0 ? co_located.p50 / solo.p50 : 0) << ","
+                << (solo.p99 > 0 ? co_located.p99 / solo.p99 : 0) << "\n";
+    }
+    std::cout << std::flush;
+  }
+
   return Status::OK();
 }
 
@@ -255,6 +391,156 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::RunSoloBaselines() {
+  // enough runs for a stable median, the tail of a solo run is not what a co-location test is after
+  constexpr size_t kSoloRuns = 100;
+
+  auto& model_results = performance_result_.model_results;
+  model_results.resize(co_located_runners_.size() + 1);
+  for (size_t i = 0; i < model_results.size(); ++i) {
+    PerformanceRunner& runner = i == 0 ? *this : *co_located_runners_[i - 1];
+    model_results[i].model_name =
+        ToUTF8String(GetLastComponent(runner.performance_test_config_.model_info.model_file_path));
+    model_results[i].weight = i == 0 ? 1.0 : performance_test_config_.run_config.co_located_models[i - 1].second;
+
+    auto status = Status::OK();
+    ORT_TRY {
+      for (size_t run = 0; run < kSoloRuns; ++run) {
+        model_results[i].solo_time_costs.emplace_back(runner.session_->Run().count());
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunSoloBaselines caught exception: ",
+                                 ex.what());
+      });
+    }
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
+Status PerformanceRunner::OpenLoopTest() {
+  for (const double target_qps : performance_test_config_.run_config.target_qps) {
+    OpenLoopResult result;
+    ORT_RETURN_IF_ERROR(RunOpenLoop(target_qps, result));
+    performance_result_.open_loop_results.push_back(std::move(result));
+  }
+
+  return Status::OK();
+}
+
+Status PerformanceRunner::RunOpenLoop(double target_qps, OpenLoopResult& result) {
+  using Clock = std::chrono::high_resolution_clock;
+  const auto& run_config = performance_test_config_.run_config;
+  result.target_qps = target_qps;
+
+  std::mt19937 generator(run_config.random_seed_for_input_data >= 0
+                             ? static_cast<uint32_t>(run_config.random_seed_for_input_data)
+                             : std::random_device{}());
+  std::exponential_distribution<double> poisson_interval(target_qps);
+  const std::chrono::duration<double> constant_interval(1.0 / target_qps);
+
+  // Requests are queued at their arrival and run by the workers, so a slow run delays the start of the next
+  // requests rather than their arrival, like the requests of a server.
+  std::deque<Clock::time_point> arrivals;
+  bool arrivals_done = false;
+  std::mutex m;
+  std::condition_variable cv;
+  Clock::time_point last_end{};
+
+  auto worker = [&]() {
+    for (;;) {
+      Clock::time_point arrival;
+      size_t model_index = 0;
+      {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&]() { return !arrivals.empty() || arrivals_done; });
+        if (arrivals.empty()) {
+          return;
+        }
+        arrival = arrivals.front();
+        arrivals.pop_front();
+      }
+
+      const auto start = Clock::now();
+      std::chrono::duration<double> service_time(0);
+      bool failed = false;
+      ORT_TRY {
+        service_time = PickSession(model_index).Run();
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          std::cerr << "PerformanceRunner::RunOpenLoop caught exception: " << ex.what() << std::endl;
+          failed = true;
+        });
+      }
+      const auto end = Clock::now();
+
+      std::lock_guard<std::mutex> guard(results_mutex_);
+      if (failed) {
+        result.failed_requests++;
+        continue;
+      }
+      performance_result_.time_costs.emplace_back(service_time.count());
+      performance_result_.total_time_cost += service_time.count();
+      if (!performance_result_.model_results.empty()) {
+        performance_result_.model_results[model_index].time_costs.emplace_back(service_time.count());
+      }
+      result.latencies.emplace_back(std::chrono::duration<double>(end - arrival).count());
+      result.queueing_delays.emplace_back(std::chrono::duration<double>(start - arrival).count());
+      last_end = std::max(last_end, end);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < std::max<size_t>(run_config.concurrent_session_runs, 1); ++i) {
+    workers.emplace_back(worker);
+  }
+
+  const auto start = Clock::now();
+  const std::chrono::duration<double> duration(static_cast<double>(run_config.duration_in_seconds));
+  auto arrival = start;
+  for (size_t issued = 0;; ++issued) {
+    const bool done = run_config.test_mode == TestMode::KFixRepeatedTimesMode
+                          ? issued >= run_config.repeated_times
+                          : arrival - start >= duration;
+    if (done) {
+      break;
+    }
+
+    std::this_thread::sleep_until(arrival);
+    {
+      std::lock_guard<std::mutex> lock(m);
+      arrivals.push_back(arrival);
+    }
+    cv.notify_one();
+
+    const std::chrono::duration<double> interval =
+        run_config.arrival_pattern == ArrivalPattern::kPoisson
+            ? std::chrono::duration<double>(poisson_interval(generator))
+            : constant_interval;
+    arrival += std::chrono::duration_cast<Clock::duration>(interval);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m);
+    arrivals_done = true;
+  }
+  cv.notify_all();
+  for (auto& thread : workers) {
+    thread.join();
+  }
+
+  const std::chrono::duration<double> elapsed = last_end - start;
+  if (elapsed.count() > 0) {
+    result.achieved_qps = result.latencies.size() / elapsed.count();
+  }
+
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   const auto& file_path = performance_test_config_.model_info.model_file_path;
 #if !defined(ORT_MINIMAL_BUILD)
@@ -276,6 +562,24 @@ PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig&
   session_create_start_ = std::chrono::high_resolution_clock::now();
   session_ = std::make_unique<OnnxRuntimeTestSession>(env, rd, performance_test_config_, *test_model_info_);
   session_create_end_ = std::chrono::high_resolution_clock::now();
+
+  const auto& co_located_models = test_config.run_config.co_located_models;
+  if (!co_located_models.empty()) {
+    std::vector<double> weights{1.0};
+    for (const auto& model : co_located_models) {
+      PerformanceTestConfig co_located_config = test_config;
+      co_located_config.model_info.model_file_path = model.first;
+      co_located_config.run_config.co_located_models.clear();
+      co_located_config.run_config.profile_file.clear();
+      co_located_config.run_config.optimized_model_path.clear();
+      co_located_runners_.push_back(std::make_unique<PerformanceRunner>(env, co_located_config, rd));
+      weights.push_back(model.second);
+    }
+    model_distribution_ = std::discrete_distribution<size_t>(weights.begin(), weights.end());
+    model_generator_.seed(test_config.run_config.random_seed_for_input_data >= 0
+                              ? static_cast<uint32_t>(test_config.run_config.random_seed_for_input_data)
+                              : rd());
+  }
 }
 
 PerformanceRunner::~PerformanceRunner() = default;
@@ -27,6 +27,27 @@ class TestModelInfo;
 namespace onnxruntime {
 namespace perftest {
 
+// Requests of an open-loop test at a target rate.
+struct OpenLoopResult {
+  double target_qps{0};
+  double achieved_qps{0};
+  size_t failed_requests{0};
+  // from the scheduled arrival of each request to the end of its run, in seconds
+  std::vector<double> latencies;
+  // from the scheduled arrival of each request to the start of its run, in seconds
+  std::vector<double> queueing_delays;
+};
+
+// Requests of a model of a co-location test.
+struct CoLocatedModelResult {
+  std::string model_name;
+  double weight{1};
+  // in seconds, running alone
+  std::vector<double> solo_time_costs;
+  // in seconds, running with the other models
+  std::vector<double> time_costs;
+};
+
 struct PerformanceResult {
   std::chrono::time_point<std::chrono::high_resolution_clock> start;
   std::chrono::time_point<std::chrono::high_resolution_clock> end;
@@ -35,8 +56,14 @@ struct PerformanceResult {
   double total_time_cost{0};
   std::vector<double> time_costs;
   std::string model_name;
+  std::vector<OpenLoopResult> open_loop_results;
+  // the tested model first, empty unless other models are co-located with it
+  std::vector<CoLocatedModelResult> model_results;
 
   void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics = false) const;
+
+  // Writes the latency percentiles of each rate of an open-loop test as CSV, or JSON if path ends with ".json".
+  Status DumpOpenLoopReport(const std::basic_string<ORTCHAR_T>& path) const;
 };
 
 class PerformanceRunner {
@@ -48,6 +75,9 @@ class PerformanceRunner {
 
   void LogSessionCreationTime();
 
+  // Ends the profiling of the session of the tested model and returns the profile file name.
+  std::string EndProfiling();
+
   inline const PerformanceResult& GetResult() const { return performance_result_; }
 
   inline void SerializeResult() const {
@@ -59,13 +89,25 @@ class PerformanceRunner {
  private:
   bool Initialize();
 
+  // Picks the session of the next request by the weights of the models, the tested model being index 0.
+  TestSession& PickSession(size_t& model_index) {
+    model_index = 0;
+    if (co_located_runners_.empty()) {
+      return *session_;
+    }
+    std::lock_guard<std::mutex> guard(results_mutex_);
+    model_index = model_distribution_(model_generator_);
+    return model_index == 0 ? *session_ : *co_located_runners_[model_index - 1]->session_;
+  }
+
   template <bool isWarmup>
   Status RunOneIteration() {
     std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
 
     auto status = Status::OK();
+    size_t model_index = 0;
     ORT_TRY {
-      duration_seconds = session_->Run();
+      duration_seconds = PickSession(model_index).Run();
     }
     ORT_CATCH(const std::exception& ex) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -78,6 +120,9 @@ class PerformanceRunner {
       std::lock_guard<std::mutex> guard(results_mutex_);
       performance_result_.time_costs.emplace_back(duration_seconds.count());
       performance_result_.total_time_cost += duration_seconds.count();
+      if (!performance_result_.model_results.empty()) {
+        performance_result_.model_results[model_index].time_costs.emplace_back(duration_seconds.count());
+      }
       if (performance_test_config_.run_config.f_verbose) {
         std::cout << "iteration:" << performance_result_.time_costs.size() << ","
                   << "time_cost:" << performance_result_.time_costs.back() << std::endl;
@@ -90,6 +135,9 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status OpenLoopTest();
+  Status RunOpenLoop(double target_qps, OpenLoopResult& result);
+  Status RunSoloBaselines();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -117,6 +165,11 @@ class PerformanceRunner {
   std::unique_ptr<ITestCase> test_case_;
 
   std::mutex results_mutex_;
+
+  // runners of the models co-located with the tested one, only their sessions and test data are used
+  std::vector<std::unique_ptr<PerformanceRunner>> co_located_runners_;
+  std::discrete_distribution<size_t> model_distribution_;
+  std::mt19937 model_generator_;
 };
 }  // namespace perftest
 }  // namespace onnxruntime
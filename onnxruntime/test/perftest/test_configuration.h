@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
@@ -19,6 +20,12 @@ enum class TestMode : std::uint8_t {
   KFixRepeatedTimesMode
 };
 
+// Arrival process of the requests of an open-loop test.
+enum class ArrivalPattern : std::uint8_t {
+  kPoisson = 0,
+  kConstantRate
+};
+
 enum class Platform : std::uint8_t {
   kWindows = 0,
   kLinux
@@ -68,6 +75,20 @@ struct RunConfig {
   std::basic_string<ORTCHAR_T> register_custom_op_path;
   bool enable_cuda_io_binding{false};
   bool use_extensions = false;
+  // open-loop test: requests are issued at each of the target rates, independently of their completion
+  std::vector<double> target_qps;
+  ArrivalPattern arrival_pattern{ArrivalPattern::kPoisson};
+  std::basic_string<ORTCHAR_T> latency_report_file;
+  // co-location test: models loaded in the same process as the tested one, with their weight in the traffic mix.
+  // The tested model has a weight of 1.
+  std::vector<std::pair<std::basic_string<ORTCHAR_T>, double>> co_located_models;
+  bool use_global_thread_pools{false};
+  bool use_env_allocators{false};
+  // kernel benchmark: each kernel of the model is run in isolation, the peaks are used to report the share of them
+  // the kernels achieve, 0 if unknown
+  bool kernel_benchmark{false};
+  double peak_gflops{0};
+  double peak_gbps{0};
 };
 
 struct PerformanceTestConfig {
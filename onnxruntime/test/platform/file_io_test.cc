@@ -171,11 +171,6 @@ TEST(FileIoTest, MapFileIntoMemory) {
     const auto offset = offset_and_length.first;
     const auto length = offset_and_length.second;
 
-    // The offset must be a multiple of the allocation granularity
-    if (offset % allocation_granularity != 0) {
-      continue;
-    }
-
     Env::MappedMemoryPtr mapped_memory{};
     auto status = Env::Default().MapFileIntoMemory(
         tmp.path.c_str(), offset, length, mapped_memory);
@@ -193,7 +188,7 @@ TEST(FileIoTest, MapFileIntoMemory) {
   {
     Env::MappedMemoryPtr mapped_memory{};
 
-    // invalid - offset is not a multiple of the allocation granularity
+    // invalid - range is past the end of the file
     ASSERT_FALSE(Env::Default().MapFileIntoMemory(
                                    tmp.path.c_str(), allocation_granularity * 3 / 2, page_size / 10, mapped_memory)
                      .IsOK());
@@ -14,6 +14,8 @@
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <chrono>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -613,6 +615,143 @@ TEST(ThreadPoolTest, TestAffinityStringWellShaped) {
   }
 }
 
+TEST(ThreadPoolTest, TestStealDomainStatInProfiling) {
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 3;
+  // both worker threads share a logical processor, so they are in a single domain and steal domains are not used
+  tp_params.affinity_str = "1;1";
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                          tp_params,
+                                          concurrency::ThreadPoolType::INTRA_OP);
+  ASSERT_NE(tp, nullptr);
+
+  ThreadPool::StartProfiling(tp.get());
+  auto test_data = CreateTestData(1000);
+  ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  ValidateTestData(*test_data);
+  const std::string stat = ThreadPool::StopProfiling(tp.get());
+
+  EXPECT_NE(stat.find("\"steal_domains\": {\"-1\": {\"num_threads\": 2, "), std::string::npos) << stat;
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(ThreadPoolTest, TestHardwareCountersInProfiling) {
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 3;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                          tp_params,
+                                          concurrency::ThreadPoolType::INTRA_OP);
+  ASSERT_NE(tp, nullptr);
+
+  // the counters may be unavailable, e.g. restricted by perf_event_paranoid, in which case they are reported as 0
+  ThreadPool::StartProfiling(tp.get(), true);
+  auto test_data = CreateTestData(1000);
+  ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  ValidateTestData(*test_data);
+  const std::string stat = ThreadPool::StopProfiling(tp.get());
+
+  // reported for the calling thread and for each pool thread
+  const size_t sub_threads_pos = stat.find("\"sub_threads\"");
+  ASSERT_NE(sub_threads_pos, std::string::npos) << stat;
+  EXPECT_LT(stat.find("\"hw_cycles\": "), sub_threads_pos) << stat;
+  EXPECT_NE(stat.find("\"hw_llc_misses\": ", sub_threads_pos), std::string::npos) << stat;
+
+  // not reported unless requested
+  ThreadPool::StartProfiling(tp.get());
+  ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  EXPECT_EQ(ThreadPool::StopProfiling(tp.get()).find("\"hw_cycles\""), std::string::npos);
+}
+
+TEST(ThreadPoolTest, TestAdaptiveInlineThreshold) {
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 3;
+  tp_params.adaptive_inline_threshold = true;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                          tp_params,
+                                          concurrency::ThreadPoolType::INTRA_OP);
+  ASSERT_NE(tp, nullptr);
+
+  // the cost model dispatches these loops, but their work takes less time than handing it off to the pool
+  constexpr std::ptrdiff_t num_iterations = 4;
+  const TensorOpCost cost{0, 0, 1e5};
+  std::atomic<std::ptrdiff_t> ctr{0};
+  int owner = 0;
+  ThreadPool::LoopOwnerScope loop_owner_scope(tp.get(), &owner);
+  ThreadPool::StartProfiling(tp.get());
+  for (int i = 0; i < 64; ++i) {
+    ThreadPool::TryParallelFor(tp.get(), num_iterations, cost, [&](std::ptrdiff_t s, std::ptrdiff_t e) {
+      ctr += e - s;
+    });
+  }
+  const std::string stat = ThreadPool::StopProfiling(tp.get());
+
+  ASSERT_EQ(ctr, 64 * num_iterations);
+  EXPECT_NE(stat.find("\"inline_threshold\": {\"cost\": 400000, "), std::string::npos) << stat;
+  EXPECT_EQ(stat.find("\"num_learned_inline_loops\": 0}"), std::string::npos) << stat;
+}
+#endif
+
+TEST(ThreadPoolTest, TestPriorityScope) {
+  // a pool with a single worker thread
+  ThreadOptions to;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), to, nullptr, 2, true);
+
+  // keep the worker busy while the tasks are queued
+  Notification blocker_started;
+  Notification release_blocker;
+  ThreadPool::Schedule(tp.get(), [&]() {
+    blocker_started.Notify();
+    release_blocker.Wait();
+  });
+  blocker_started.Wait();
+
+  std::mutex mutex;
+  std::vector<int> order;
+  Notification all_done;
+  auto task = [&](int id) {
+    return [&, id]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(id);
+      if (order.size() == 4) {
+        all_done.Notify();
+      }
+    };
+  };
+  ThreadPool::Schedule(tp.get(), task(0));
+  ThreadPool::Schedule(tp.get(), task(1));
+  {
+    ThreadPool::PriorityScope priority_scope(true);
+    ThreadPool::Schedule(tp.get(), task(2));
+  }
+  ThreadPool::Schedule(tp.get(), task(3));
+  release_blocker.Notify();
+  all_done.Wait();
+
+  // the high priority task overtakes the normal priority tasks queued before it
+  EXPECT_EQ(order, (std::vector<int>{2, 0, 1, 3}));
+}
+
+TEST(ThreadPoolTest, TestAdaptiveSpinning) {
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 4;
+  tp_params.allow_spinning = true;
+  tp_params.adaptive_spinning = true;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                          tp_params,
+                                          concurrency::ThreadPoolType::INTRA_OP);
+  ASSERT_NE(tp, nullptr);
+
+  // bursts of back to back loops, separated by waits longer than the threads spin
+  for (int burst = 0; burst < 4; ++burst) {
+    for (int i = 0; i < 16; ++i) {
+      auto test_data = CreateTestData(1000);
+      ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t j) { IncrementElement(*test_data, j); });
+      ValidateTestData(*test_data);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+}
+
 #ifdef _WIN32
 TEST(ThreadPoolTest, TestDefaultAffinity) {
   test::CpuGroup cpu_group = {{0, 1},
@@ -1041,6 +1041,87 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// the loop carried var outputs reuse the buffers of the iteration before the previous one.
+// check that doesn't overwrite the values saved for the loop output, or a value passed through to the next iteration.
+TEST(Loop, LoopCarriedVarBufferReuse) {
+  auto create_subgraph = []() {
+    Model model("loop carried var buffer reuse", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond_in, loop carried state variables.
+
+         cond_in    sum_in  one      same_in
+            |          |    |           |
+        [Identity]     [Add]        [Identity]
+            |            |              |
+         cond_out     sum_out        same_out
+                         |
+                     [Identity]
+                         |
+                    sum_scan_out
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& sum_in = graph.GetOrCreateNodeArg("sum_in", &float_tensor);
+    auto& same_in = graph.GetOrCreateNodeArg("same_in", &float_tensor);
+
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& sum_out = graph.GetOrCreateNodeArg("sum_out", &float_tensor);
+    auto& same_out = graph.GetOrCreateNodeArg("same_out", &float_tensor);
+    auto& sum_scan_out = graph.GetOrCreateNodeArg("sum_scan_out", &float_tensor);
+
+    TensorProto one_proto;
+    one_proto.set_name("one");
+    one_proto.set_data_type(TensorProto_DataType_FLOAT);
+    one_proto.add_dims(2);
+    one_proto.add_float_data(1.f);
+    one_proto.add_float_data(1.f);
+    graph.AddInitializedTensor(one_proto);
+    auto& one = graph.GetOrCreateNodeArg("one", &float_tensor);
+
+    graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", {&cond_in}, {&cond_out});
+    graph.AddNode("sum", "Add", "Add one to the sum", {&sum_in, &one}, {&sum_out});
+    graph.AddNode("sum_scan", "Identity", "Save each sum", {&sum_out}, {&sum_scan_out});
+    graph.AddNode("same", "Identity", "Forward same_in to same_out", {&same_in}, {&same_out});
+
+    graph.SetInputs({&iter_num_in, &cond_in, &sum_in, &same_in});
+    graph.SetOutputs({&cond_out, &sum_out, &same_out, &sum_scan_out});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  OpTester test("Loop", 11);
+  auto body = create_subgraph();
+  test.AddAttribute<GraphProto>("body", body);
+  test.AddInput<int64_t>("M", {1}, {5});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("sum", {2}, {0.f, 10.f});
+  test.AddInput<float>("same", {2}, {7.f, 8.f});
+
+  test.AddOutput<float>("sum_final", {2}, {5.f, 15.f});
+  test.AddOutput<float>("same_final", {2}, {7.f, 8.f});
+  test.AddOutput<float>("sum_scan", {5, 2}, {1.f, 11.f, 2.f, 12.f, 3.f, 13.f, 4.f, 14.f, 5.f, 15.f});
+
+  // Disable TensorRT on unsupported data type BOOL
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 // test that when part of the subgraph run on CUDA/ROCm it executes successfully
 TEST(Loop, MixedExecutionProviders) {
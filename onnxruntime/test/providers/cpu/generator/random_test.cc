@@ -2,14 +2,45 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/providers/cpu/generator/philox.h"
 #include "test/providers/provider_test_utils.h"
 
 #include <algorithm>
+#include <cmath>
 #include <random>
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 namespace test {
 
+// The samples of the first run of the CPU kernels: sample i is drawn from the Philox counter
+// i / philox::SamplesPerBlock<T>() of the seed.
+template <typename T>
+static std::vector<T> ExpectedNormalSamples(float seed, float mean, float scale, size_t count) {
+  std::vector<T> samples(count);
+  philox::Fill<T>(static_cast<uint64_t>(seed), 0, samples.data(), count, nullptr, 0.0,
+                  [mean, scale](const philox::Block& block, T* block_samples) {
+                    philox::ToNormal<T>(block, block_samples);
+                    for (size_t i = 0; i < philox::SamplesPerBlock<T>(); ++i) {
+                      block_samples[i] = static_cast<T>(mean) + static_cast<T>(scale) * block_samples[i];
+                    }
+                  });
+  return samples;
+}
+
+template <typename T>
+static std::vector<T> ExpectedUniformSamples(float seed, float low, float high, size_t count) {
+  std::vector<T> samples(count);
+  philox::Fill<T>(static_cast<uint64_t>(seed), 0, samples.data(), count, nullptr, 0.0,
+                  [low, high](const philox::Block& block, T* block_samples) {
+                    philox::ToUniform<T>(block, block_samples);
+                    for (size_t i = 0; i < philox::SamplesPerBlock<T>(); ++i) {
+                      block_samples[i] = static_cast<T>(low) +
+                                         (static_cast<T>(high) - static_cast<T>(low)) * block_samples[i];
+                    }
+                  });
+  return samples;
+}
+
 TEST(Random, RandomNormal2DDouble) {
   OpTester test("RandomNormal");
 
@@ -25,16 +56,12 @@ TEST(Random, RandomNormal2DDouble) {
   test.AddAttribute<int64_t>("dtype", TensorProto::DOUBLE);
   test.AddAttribute("shape", dims);
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::normal_distribution<double> distribution{mean, scale};
-
-  std::vector<double> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](double& value) { value = distribution(generator); });
+  std::vector<double> expected_output =
+      ExpectedNormalSamples<double>(seed, mean, scale, static_cast<size_t>(TensorShape(dims).Size()));
 
   test.AddOutput<double>("Y", dims, expected_output);
 
-  // The expected_output is generated using std lib, which is used by CPU kernel only.
+  // The expected_output is generated using the Philox samples of the CPU kernel only.
   // So we need to exclude other EPs here. Ditto for other places.
   test.Run(OpTester::ExpectResult::kExpectSuccess, "",
            {kCudaExecutionProvider, kCudaNHWCExecutionProvider, kRocmExecutionProvider});
@@ -63,12 +90,8 @@ void RunRandomNormalLike3DFloat(bool infer_dtype = false) {
                         0.f, 0.f, 0.f,
                         0.f, 0.f, 0.f});
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::normal_distribution<float> distribution{mean, scale};
-
-  std::vector<float> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](float& value) { value = distribution(generator); });
+  std::vector<float> expected_output =
+      ExpectedNormalSamples<float>(seed, mean, scale, static_cast<size_t>(TensorShape(dims).Size()));
 
   test.AddOutput<float>("Y", dims, expected_output);
 
@@ -101,12 +124,8 @@ TEST(Random, RandomUniform1DFloat) {
   test.AddAttribute<int64_t>("dtype", TensorProto::FLOAT);
   test.AddAttribute("shape", dims);
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::uniform_real_distribution<float> distribution{low, high};
-
-  std::vector<float> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](float& value) { value = distribution(generator); });
+  std::vector<float> expected_output =
+      ExpectedUniformSamples<float>(seed, low, high, static_cast<size_t>(TensorShape(dims).Size()));
 
   test.AddOutput<float>("Y", dims, expected_output);
 
@@ -135,12 +154,8 @@ void RunRandomUniformLikeTest(bool infer_dtype = false) {
                         {0., 0., 0., 0., 0., 0.,
                          0., 0., 0., 0., 0., 0.});
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::uniform_real_distribution<double> distribution{low, high};
-
-  std::vector<double> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](double& value) { value = distribution(generator); });
+  std::vector<double> expected_output =
+      ExpectedUniformSamples<double>(seed, low, high, static_cast<size_t>(TensorShape(dims).Size()));
 
   test.AddOutput<double>("Y", dims, expected_output);
 
@@ -158,6 +173,46 @@ TEST(Random, RandomUniformLikeInferDType) {
   RunRandomUniformLikeTest(infer_dtype);
 }
 
+TEST(Random, PhiloxKnownAnswer) {
+  // Philox4x32-10 known answer test of the Random123 library for a zero key and counter
+  const philox::Block block = philox::Generate(0, 0);
+  EXPECT_EQ(block[0], 0x6627e8d5u);
+  EXPECT_EQ(block[1], 0xe169c58du);
+  EXPECT_EQ(block[2], 0xbc57ac4cu);
+  EXPECT_EQ(block[3], 0x9b00dbd8u);
+}
+
+TEST(Random, RandomNormalLargeFloat) {
+  // large enough to be generated on several threads
+  OpTester test("RandomNormal");
+
+  std::vector<int64_t> dims{64, 1000};
+  constexpr float scale = 2.f;
+  constexpr float mean = 3.f;
+  constexpr float seed = 7.f;
+
+  test.AddAttribute("scale", scale);
+  test.AddAttribute("mean", mean);
+  test.AddAttribute("seed", seed);
+  test.AddAttribute<int64_t>("dtype", TensorProto::FLOAT);
+  test.AddAttribute("shape", dims);
+
+  const std::vector<float> expected_output =
+      ExpectedNormalSamples<float>(seed, mean, scale, static_cast<size_t>(TensorShape(dims).Size()));
+  double sum = 0.0, sum_of_squares = 0.0;
+  for (float value : expected_output) {
+    sum += value;
+    sum_of_squares += static_cast<double>(value) * value;
+  }
+  const double sample_mean = sum / expected_output.size();
+  EXPECT_NEAR(sample_mean, mean, 0.05);
+  EXPECT_NEAR(std::sqrt(sum_of_squares / expected_output.size() - sample_mean * sample_mean), scale, 0.05);
+
+  test.AddOutput<float>("Y", dims, expected_output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "",
+           {kCudaExecutionProvider, kCudaNHWCExecutionProvider, kRocmExecutionProvider, kTensorrtExecutionProvider});
+}
+
 TEST(Random, InvalidDType) {
   constexpr float seed = 123.f;
 
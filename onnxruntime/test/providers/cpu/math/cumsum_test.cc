@@ -257,5 +257,26 @@ TEST(CumSumTest, _1DTestLong) {
   test.AddOutput<int32_t>("y", {N}, output_value);
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
+TEST(CumSumTest, _2DTestLongReverseExclusive) {
+  // long enough rows to be scanned in parallel blocks
+  OpTester test("CumSum", 14, onnxruntime::kOnnxDomain);
+  test.AddAttribute<int64_t>("reverse", 1);
+  test.AddAttribute<int64_t>("exclusive", 1);
+  constexpr int64_t N = 200000;
+  std::vector<int64_t> input_value(2 * N);
+  std::iota(input_value.begin(), input_value.end(), 0);
+  std::vector<int64_t> output_value(2 * N);
+  for (int64_t row = 0; row < 2; ++row) {
+    int64_t sum = 0;
+    for (int64_t i = N - 1; i >= 0; --i) {
+      output_value[row * N + i] = sum;
+      sum += input_value[row * N + i];
+    }
+  }
+  test.AddInput<int64_t>("x", {2, N}, input_value);
+  test.AddInput<int32_t>("axis", {}, {1});
+  test.AddOutput<int64_t>("y", {2, N}, output_value);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -7,6 +7,7 @@
 #include "test/common/trt_op_test_utils.h"
 #include "core/framework/data_types.h"
 #include "core/util/math.h"
+#include "core/providers/cpu/math/einsum_utils/einsum_contraction_path.h"
 
 namespace onnxruntime {
 namespace test {
@@ -237,6 +238,54 @@ TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
 }
 
+// Contracting 'jk' with 'k' first takes a third of the multiply-adds of the left to right order
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_ContractionPath) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,k->i");
+  test.AddInput<float>("x", {4, 3}, {-5.f, -4.f, -3.f, -2.f, -1.f, 0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {3, 5}, {-7.f, -6.f, -5.f, -4.f, -3.f, -2.f, -1.f, 0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f});
+  test.AddInput<float>("z", {5}, {-2.f, -1.f, 0.f, 1.f, 2.f});
+  test.AddOutput<float>("o", {4}, {-120.f, -30.f, 60.f, 150.f});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
+}
+
+// The cheapest path contracts the two halves of the chain independently before contracting their results
+TEST(Einsum, ExplicitEinsumAsMatmul_Multi_Input_ContractionTree) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,kl,lm->mi");
+  test.AddInput<float>("w", {2, 5}, {-4.f, -3.f, -2.f, -1.f, 0.f, 1.f, 2.f, 3.f, 4.f, 5.f});
+  test.AddInput<float>("x", {5, 2}, {0.f, 1.f, 2.f, 0.f, 1.f, 2.f, 0.f, 1.f, 2.f, 0.f});
+  test.AddInput<float>("y", {2, 5}, {-3.f, -2.f, -1.f, 0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("z", {5, 2}, {-1.f, 0.f, 1.f, 2.f, -1.f, 0.f, 1.f, 2.f, -1.f, 0.f});
+  test.AddOutput<float>("o", {2, 2}, {28.f, -27.f, -112.f, 108.f});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", ExcludeTrtOnA100());
+}
+
+TEST(Einsum, ContractionPath) {
+  // ij,jk,k->i with homogenized dims in the order i, j, k
+  std::vector<TensorShape> input_dims{TensorShape({4, 3, 1}), TensorShape({1, 3, 5}), TensorShape({1, 1, 5})};
+  std::vector<int64_t> output_indices{0, -1, -1};
+  EinsumOp::ContractionPath expected_path{{1, 2}, {0, 3}};
+  EXPECT_EQ(EinsumOp::FindContractionPath(input_dims, output_indices), expected_path);
+
+  // ij,jk,kl,lm->im contracts both halves first
+  input_dims = {TensorShape({2, 5, 1, 1, 1}), TensorShape({1, 5, 2, 1, 1}),
+                TensorShape({1, 1, 2, 5, 1}), TensorShape({1, 1, 1, 5, 2})};
+  output_indices = {0, -1, -1, -1, 1};
+  expected_path = {{0, 1}, {2, 3}, {4, 5}};
+  EXPECT_EQ(EinsumOp::FindContractionPath(input_dims, output_indices), expected_path);
+
+  // left to right is already the cheapest order for ij,jk,kl->li with equal dims
+  input_dims = {TensorShape({2, 2, 1, 1}), TensorShape({1, 2, 2, 1}), TensorShape({1, 1, 2, 2})};
+  output_indices = {1, -1, -1, 0};
+  EXPECT_TRUE(EinsumOp::FindContractionPath(input_dims, output_indices).empty());
+
+  // the cache finds the path once per input dims
+  EinsumOp::ContractionPathCache cache;
+  auto path = cache.Get(input_dims, output_indices);
+  EXPECT_EQ(cache.Get(input_dims, output_indices), path);
+}
+
 TEST(Einsum, ExplicitEinsumAsBatchedMatmul) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
   test.AddAttribute<std::string>("equation", "bij,bjk->bik");
@@ -574,6 +574,33 @@ TEST(MathOpTest, Add_Broadcast_2x1x1_3x4) {
 #endif
 }
 
+// A few spans larger than the work of a thread, which are split when the output is processed in parallel
+TEST(MathOpTest, Add_Broadcast_2x1xN_1x3xN) {
+  OpTester test("Add");
+
+  constexpr int64_t N = 16384;
+  std::vector<float> a(2 * N), b(3 * N), c;
+  for (int64_t i = 0; i < N; ++i) {
+    a[i] = static_cast<float>(i % 101);
+    a[N + i] = 1000.0f + static_cast<float>(i % 101);
+    for (int64_t j = 0; j < 3; ++j) {
+      b[j * N + i] = 10000.0f * static_cast<float>(j + 1) + static_cast<float>(i % 7);
+    }
+  }
+  for (int64_t k = 0; k < 2; ++k) {
+    for (int64_t j = 0; j < 3; ++j) {
+      for (int64_t i = 0; i < N; ++i) {
+        c.push_back(a[k * N + i] + b[j * N + i]);
+      }
+    }
+  }
+
+  test.AddInput<float>("A", {2, 1, N}, a);
+  test.AddInput<float>("B", {1, 3, N}, b);
+  test.AddOutput<float>("C", {2, 3, N}, c);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 // Validate runtime failure has useful error message when ORT_ENFORCE is used
 TEST(MathOpTest, Add_Invalid_Broadcast) {
   OpTester test("Add");
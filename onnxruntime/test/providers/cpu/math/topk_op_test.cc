@@ -861,5 +861,29 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+// a single row with a long axis is split over the threads, each selecting a local top k that are then merged.
+// the values are shuffled and include duplicates so the merge has to keep the lowest indices of equal values.
+TEST(TopKOperator, SplitAxisThreaded) {
+  constexpr int64_t k = 100;
+  constexpr int64_t n = 1000000;
+  std::vector<float> input_vals(n);
+  for (int64_t i = 0; i < n; ++i) {
+    input_vals[i] = static_cast<float>((i * 7919) % (n / 2));
+  }
+
+  std::vector<int64_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&input_vals](int64_t a, int64_t b) { return input_vals[a] > input_vals[b]; });
+
+  std::vector<float> expected_vals(k);
+  std::vector<int64_t> expected_indices(order.begin(), order.begin() + k);
+  for (int64_t i = 0; i < k; ++i) {
+    expected_vals[i] = input_vals[expected_indices[i]];
+  }
+
+  RunTest(11, k, input_vals, {n}, expected_vals, expected_indices, {k}, false);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -257,6 +257,36 @@ TEST(LabelEncoder, Int64toInt64Opset4) {
   test.Run();
 }
 
+TEST(LabelEncoder, LargeVocabularyInt64toInt64Opset4) {
+  // enough keys to grow the lookup table several times, spaced so they share the low bits
+  constexpr int64_t num_keys = 5000;
+  std::vector<int64_t> key_data;
+  std::vector<int64_t> value_data;
+  for (int64_t i = 0; i < num_keys; ++i) {
+    key_data.push_back(i * 4096);
+    value_data.push_back(num_keys - i);
+  }
+
+  std::vector<int64_t> input;
+  std::vector<int64_t> output;
+  for (int64_t i = 0; i < 2 * num_keys; i += 7) {
+    input.push_back(i * 4096);
+    output.push_back(i < num_keys ? num_keys - i : -1);
+    input.push_back(i * 4096 + 1);
+    output.push_back(-1);
+  }
+
+  OpTester test("LabelEncoder", 4, onnxruntime::kMLDomain);
+
+  test.AddAttribute("keys_int64s", key_data);
+  test.AddAttribute("values_int64s", value_data);
+  test.AddAttribute("default_int64", int64_t{-1});
+
+  test.AddInput<int64_t>("X", {static_cast<int64_t>(input.size())}, input);
+  test.AddOutput<int64_t>("Y", {static_cast<int64_t>(output.size())}, output);
+  test.Run();
+}
+
 TEST(LabelEncoder, StringtoInt16Opset4) {
   std::vector<std::int64_t> dims{1, 5};
 
@@ -1,8 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+
+#include "core/framework/session_options.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/asserts.h"
 
 namespace onnxruntime {
 namespace test {
@@ -122,6 +127,53 @@ void GenTreeAndRunTest(int opsetml, const std::vector<T>& X, const std::vector<f
   }
 
   test.Run();
+TEST(MLOpTest, TreeRegressorCompleteTreesBatch) {
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+
+  // tree 0 has depth 2, tree 1 has depth 1, and no node tracks missing values
+  int64_t n_targets = 1;
+  std::vector<int64_t> nodes_featureids = {0, 0, 1, 0, 0, 1, 0, 0};
+  std::vector<std::string> nodes_modes = {"BRANCH_LEQ", "LEAF", "BRANCH_LEQ", "LEAF", "LEAF",
+                                          "BRANCH_LEQ", "LEAF", "LEAF"};
+  std::vector<float> nodes_values = {0.5f, 0.0f, 0.5f, 0.0f, 0.0f, 0.5f, 0.0f, 0.0f};
+  std::vector<int64_t> nodes_treeids = {0, 0, 0, 0, 0, 1, 1, 1};
+  std::vector<int64_t> nodes_nodeids = {0, 1, 2, 3, 4, 0, 1, 2};
+  std::vector<int64_t> nodes_falsenodeids = {2, 0, 4, 0, 0, 2, 0, 0};
+  std::vector<int64_t> nodes_truenodeids = {1, 0, 3, 0, 0, 1, 0, 0};
+
+  std::vector<int64_t> target_ids = {0, 0, 0, 0, 0};
+  std::vector<int64_t> target_nodeids = {1, 3, 4, 1, 2};
+  std::vector<int64_t> target_treeids = {0, 0, 0, 1, 1};
+  std::vector<float> target_weights = {1.0f, 2.0f, 3.0f, 10.0f, 20.0f};
+
+  test.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  test.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  test.AddAttribute("nodes_treeids", nodes_treeids);
+  test.AddAttribute("nodes_nodeids", nodes_nodeids);
+  test.AddAttribute("nodes_featureids", nodes_featureids);
+  test.AddAttribute("nodes_values", nodes_values);
+  test.AddAttribute("nodes_modes", nodes_modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", n_targets);
+
+  // two full blocks of rows walked together and a last partial block
+  const std::vector<float> rows = {0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 1.0f};
+  const std::vector<float> row_scores = {11.0f, 21.0f, 12.0f, 23.0f};
+  const int64_t n_rows = 35;
+  std::vector<float> X, Y;
+  for (int64_t i = 0; i < n_rows; ++i) {
+    X.push_back(rows[(i % 4) * 2]);
+    X.push_back(rows[(i % 4) * 2 + 1]);
+    Y.push_back(row_scores[i % 4]);
+  }
+  test.AddInput<float>("X", {n_rows, 2}, X);
+  test.AddOutput<float>("Y", {n_rows, 1}, Y);
+  test.Run();
+}
+
 }  // namespace test
 
 template <typename T, typename TH>
@@ -336,7 +388,8 @@ TEST(MLOpTest, TreeRegressorMultiTargetMaxDouble) {
   GenTreeAndRunTest<double>(3, X, base_values, results, "MAX", true);
 }
 
-void GenTreeAndRunTest1(int opsetml, const std::string& aggFunction, bool one_obs, int64_t n_obs = 3, int n_trees = 1) {
+void GenTreeAndRunTest1(int opsetml, const std::string& aggFunction, bool one_obs, int64_t n_obs = 3, int n_trees = 1,
+                        bool autotune_parallelization = false) {
   OpTester test("TreeEnsembleRegressor", opsetml, onnxruntime::kMLDomain);
 
   // tree
@@ -430,7 +483,13 @@ void GenTreeAndRunTest1(int opsetml, const std::string& aggFunction, bool one_ob
     test.AddInput<float>("X", {n_obs, 2}, xn);
     test.AddOutput<float>("Y", {n_obs, 1}, yn);
   }
-  test.Run();
+  if (autotune_parallelization) {
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsTreeEnsembleAutotuneParallelization, "1"));
+    test.Config(so).RunWithConfig();
+  } else {
+    test.Run();
+  }
 }
 
 void GenTreeAndRunTest1_as_tensor(int opsetml, const std::string& aggFunction, bool one_obs, int64_t n_obs = 3, int n_trees = 1) {
@@ -596,6 +655,12 @@ TEST(MLOpTest, TreeRegressorSingleTargetBatchTreeE) {
   GenTreeAndRunTest1(3, "AVERAGE", false, 201, 1);  // section E
 }
 
+TEST(MLOpTest, TreeRegressorSingleTargetBatchTreeAutotune) {
+  // the first run times both parallelizations, both must compute the same outputs
+  GenTreeAndRunTest1(3, "AVERAGE", false, 40002, 130, true);
+  GenTreeAndRunTest1(3, "SUM", false, 201, 1, true);
+}
+
 TEST(MLOpTest, TreeRegressorSingleTargetAverage) {
   GenTreeAndRunTest1(1, "AVERAGE", false);
   GenTreeAndRunTest1(3, "AVERAGE", false);
@@ -885,5 +950,55 @@ TEST(MLOpTest, TreeRegressorBranchEq) {
   test.Run();
 }
 
+TEST(MLOpTest, TreeRegressorUnbalancedTreesBatch) {
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+
+  // tree 0 has leaves at depths 1, 2 and 3 and a missing value track, tree 1 is a single leaf
+  int64_t n_targets = 1;
+  std::vector<int64_t> nodes_featureids = {0, 0, 1, 0, 0, 0, 0, 0};
+  std::vector<std::string> nodes_modes = {"BRANCH_LT", "LEAF", "BRANCH_LT", "BRANCH_LT", "LEAF", "LEAF", "LEAF",
+                                          "LEAF"};
+  std::vector<float> nodes_values = {1.0f, 0.0f, 2.0f, 3.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  std::vector<int64_t> nodes_missing_value_tracks_true = {1, 0, 0, 0, 0, 0, 0, 0};
+  std::vector<int64_t> nodes_treeids = {0, 0, 0, 0, 0, 0, 0, 1};
+  std::vector<int64_t> nodes_nodeids = {0, 1, 2, 3, 4, 5, 6, 0};
+  std::vector<int64_t> nodes_falsenodeids = {2, 0, 4, 6, 0, 0, 0, 0};
+  std::vector<int64_t> nodes_truenodeids = {1, 0, 3, 5, 0, 0, 0, 0};
+
+  std::vector<int64_t> target_ids = {0, 0, 0, 0, 0};
+  std::vector<int64_t> target_nodeids = {1, 4, 5, 6, 0};
+  std::vector<int64_t> target_treeids = {0, 0, 0, 0, 1};
+  std::vector<float> target_weights = {1.0f, 4.0f, 5.0f, 6.0f, 10.0f};
+
+  test.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  test.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  test.AddAttribute("nodes_treeids", nodes_treeids);
+  test.AddAttribute("nodes_nodeids", nodes_nodeids);
+  test.AddAttribute("nodes_featureids", nodes_featureids);
+  test.AddAttribute("nodes_values", nodes_values);
+  test.AddAttribute("nodes_modes", nodes_modes);
+  test.AddAttribute("nodes_missing_value_tracks_true", nodes_missing_value_tracks_true);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", n_targets);
+
+  // more rows than are walked together, with a last partial block
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const std::vector<float> rows = {0.0f, 0.0f, nan, 5.0f, 2.0f, 1.0f, 5.0f, 1.0f, 2.0f, 3.0f, 2.0f, nan};
+  const std::vector<float> row_scores = {11.0f, 11.0f, 15.0f, 16.0f, 14.0f, 14.0f};
+  const int64_t n_rows = 19;
+  std::vector<float> X, Y;
+  for (int64_t i = 0; i < n_rows; ++i) {
+    X.push_back(rows[(i % 6) * 2]);
+    X.push_back(rows[(i % 6) * 2 + 1]);
+    Y.push_back(row_scores[i % 6]);
+  }
+  test.AddInput<float>("X", {n_rows, 2}, X);
+  test.AddOutput<float>("Y", {n_rows, 1}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -3,6 +3,7 @@
 #include "core/graph/constants.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 using namespace std;
 namespace onnxruntime {
@@ -1046,5 +1047,60 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+
+// A 3x3 convolution with enough channels to be run with the Winograd algorithm when W is pre-packed.
+TEST(ConvTest, Conv2D_3x3_Winograd) {
+  constexpr int64_t C = 32, M = 32, H = 10, W = 9;
+  vector<float> X(C * H * W);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(static_cast<int>(i % 17) - 8) * 0.125f;
+  }
+  vector<float> weights(M * C * 9);
+  for (size_t i = 0; i < weights.size(); ++i) {
+    weights[i] = static_cast<float>(static_cast<int>(i % 11) - 5) * 0.0625f;
+  }
+  vector<float> bias(M);
+  for (size_t i = 0; i < bias.size(); ++i) {
+    bias[i] = static_cast<float>(i) * 0.25f;
+  }
+
+  // pads of 1, so the output has the input shape
+  vector<float> expected(M * H * W);
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t h = 0; h < H; ++h) {
+      for (int64_t w = 0; w < W; ++w) {
+        float sum = bias[m];
+        for (int64_t c = 0; c < C; ++c) {
+          for (int64_t kh = 0; kh < 3; ++kh) {
+            for (int64_t kw = 0; kw < 3; ++kw) {
+              const int64_t ih = h + kh - 1;
+              const int64_t iw = w + kw - 1;
+              if (ih >= 0 && ih < H && iw >= 0 && iw < W) {
+                sum += X[(c * H + ih) * W + iw] * weights[((m * C + c) * 3 + kh) * 3 + kw];
+              }
+            }
+          }
+        }
+        expected[(m * H + h) * W + w] = sum;
+      }
+    }
+  }
+
+  for (bool weight_is_initializer : {false, true}) {
+    OpTester test("Conv", 11);
+    test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+    test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+    test.AddInput<float>("X", {1, C, H, W}, X);
+    test.AddInput<float>("W", {M, C, 3, 3}, weights, weight_is_initializer);
+    test.AddInput<float>("B", {M}, bias);
+    test.AddOutput<float>("Y", {1, M, H, W}, expected);
+    test.SetOutputTolerance(0.001f);
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
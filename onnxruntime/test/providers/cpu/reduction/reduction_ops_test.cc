@@ -3884,6 +3884,37 @@ TEST(ReductionOpTest, OptimizeShapeForFastReduce_ReduceDimWithZero3) {
   ASSERT_EQ(fast_kind, FastReduceKind::kKR);
 }
 
+TEST(ReductionOpTest, ReducePlanCache) {
+  ReducePlanCache cache(2);
+  const TensorShape shape_a({4, 3, 5});
+  const TensorShape shape_b({6, 3, 5});
+  const TensorShape shape_c({2, 7, 5});
+  const std::vector<int64_t> axes{0, 2};
+
+  auto plan_a = cache.Get(shape_a, axes);
+  ResultsNoTransposePrepareForReduce expected;
+  NoTransposePrepareForReduce(shape_a, axes, expected);
+  ASSERT_TRUE(plan_a->equal(shape_a.GetDims(), axes));
+  ASSERT_EQ(plan_a->projected_index, expected.projected_index);
+  ASSERT_EQ(plan_a->unprojected_index, expected.unprojected_index);
+  ASSERT_EQ(plan_a->last_loop_red_size, expected.last_loop_red_size);
+  ASSERT_EQ(plan_a->last_loop_red_inc, expected.last_loop_red_inc);
+  ASSERT_EQ(plan_a->last_loop_size, expected.last_loop_size);
+  ASSERT_EQ(plan_a->last_loop_inc, expected.last_loop_inc);
+
+  // a hit returns the cached plan, other axes are another plan.
+  ASSERT_EQ(cache.Get(shape_a, axes), plan_a);
+  ASSERT_NE(cache.Get(shape_a, std::vector<int64_t>{1}), plan_a);
+
+  // shape_a was used more recently than shape_a with axis 1, so it survives the insertion of shape_b.
+  ASSERT_EQ(cache.Get(shape_a, axes), plan_a);
+  auto plan_b = cache.Get(shape_b, axes);
+  ASSERT_EQ(cache.Get(shape_a, axes), plan_a);
+  auto plan_c = cache.Get(shape_c, axes);
+  ASSERT_NE(cache.Get(shape_b, axes), plan_b);
+  ASSERT_TRUE(plan_c->equal(shape_c.GetDims(), axes));
+}
+
 TEST(ReductionOpTest, ReduceSum_ReduceDimWithZero3) {
   auto run = [](OpTester& tester, const std::string& error_msg = "") {
     auto expect = error_msg.empty() ? OpTester::ExpectResult::kExpectSuccess
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <functional>
 #include <vector>
 
@@ -116,6 +117,46 @@ TEST(SignalOpsTest, DFT20_Float_inverse) {
   TestInverseFloat(kOpsetVersion20);
 }
 
+// Real signals of a power of 2 length run through the FFT of half their length, the batch in parallel.
+static void TestRealRadix2DFTBatch(bool onesided, bool inverse) {
+  constexpr int64_t batch_size = 8, dft_length = 32;
+  const int64_t output_length = onesided ? (dft_length >> 1) + 1 : dft_length;
+
+  RandomValueGenerator random(GetTestRandomSeed());
+  vector<float> input = random.Uniform<float>({batch_size, dft_length}, -10.f, 10.f);
+  vector<float> expected_output;
+  const double direction = inverse ? 1.0 : -1.0;
+  const double scale = inverse ? 1.0 / dft_length : 1.0;
+  for (int64_t b = 0; b < batch_size; ++b) {
+    for (int64_t k = 0; k < output_length; ++k) {
+      double real = 0.0, imaginary = 0.0;
+      for (int64_t n = 0; n < dft_length; ++n) {
+        const double angle = direction * 2.0 * M_PI * static_cast<double>(k * n) / dft_length;
+        real += input[b * dft_length + n] * std::cos(angle);
+        imaginary += input[b * dft_length + n] * std::sin(angle);
+      }
+      expected_output.push_back(static_cast<float>(real * scale));
+      expected_output.push_back(static_cast<float>(imaginary * scale));
+    }
+  }
+
+  OpTester test("DFT", kOpsetVersion20);
+  test.AddInput<float>("input", {batch_size, dft_length, 1}, input);
+  test.AddInput<int64_t>("dft_length", {}, {dft_length});
+  test.AddInput<int64_t>("axis", {}, {1});
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(onesided));
+  test.AddAttribute<int64_t>("inverse", static_cast<int64_t>(inverse));
+  test.AddOutput<float>("output", {batch_size, output_length, 2}, expected_output);
+  test.SetOutputAbsErr("output", 0.001f);
+  test.Run();
+}
+
+TEST(SignalOpsTest, DFT20_Float_real_radix2_batch) {
+  TestRealRadix2DFTBatch(false, false);
+  TestRealRadix2DFTBatch(true, false);
+  TestRealRadix2DFTBatch(false, true);
+}
+
 // Tests that FFT(FFT(x), inverse=true) == x
 static void TestDFTInvertible(bool complex, int since_version) {
   // TODO: test dft_length
@@ -233,6 +274,26 @@ TEST(SignalOpsTest, STFTFloat) {
   test.Run();
 }
 
+TEST(SignalOpsTest, STFTFloatBluestein) {
+  // the frames of 5 samples reuse the chirp and the buffers of the first one
+  OpTester test("STFT", kMinOpsetVersion);
+
+  vector<float> signal(12, 1);
+  test.AddInput<float>("signal", {1, 12, 1}, signal);
+  test.AddInput<int64_t>("frame_step", {}, {2});
+  test.AddOptionalInputEdge<float>();
+  test.AddInput<int64_t>("frame_length", {}, {5});
+
+  vector<int64_t> output_shape = {1, 4, 3, 2};
+  vector<float> expected_output;
+  for (int64_t i = 0; i < 4; ++i) {
+    expected_output.insert(expected_output.end(), {5.f, 0.f, 0.f, 0.f, 0.f, 0.f});
+  }
+  test.AddOutput<float>("output", output_shape, expected_output);
+  test.SetOutputAbsErr("output", 0.0002f);
+  test.Run();
+}
+
 TEST(SignalOpsTest, HannWindowFloat) {
   OpTester test("HannWindow", kMinOpsetVersion);
 
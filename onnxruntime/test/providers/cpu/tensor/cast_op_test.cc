@@ -153,6 +153,28 @@ TEST(CastOpTest, NonStringTypes) {
       CastNonStringTester{});
 }
 
+// large enough to be cast in parallel blocks
+TEST(CastOpTest, LargeTensors) {
+  constexpr int64_t size = 200000;
+  const std::vector<int64_t> shape{2, size / 2};
+  std::vector<float> float_data(size);
+  std::vector<int64_t> int64_data(size);
+  std::vector<MLFloat16> float16_data(size);
+  for (int64_t i = 0; i < size; ++i) {
+    int64_data[i] = (i % 2001) - 1000;
+    float_data[i] = static_cast<float>(int64_data[i]) * 0.5f;
+    float16_data[i] = MLFloat16(float_data[i]);
+  }
+
+  std::vector<float> float_from_int64(size);
+  for (int64_t i = 0; i < size; ++i) {
+    float_from_int64[i] = static_cast<float>(int64_data[i]);
+  }
+  TestCastOp(gsl::make_span(int64_data), gsl::make_span(float_from_int64), shape);
+  TestCastOp(gsl::make_span(float_data), gsl::make_span(float16_data), shape);
+  TestCastOp(gsl::make_span(float16_data), gsl::make_span(float_data), shape);
+}
+
 TEST(CastOpTest, FromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   const std::vector<std::string> string_data = {"-inf", "+INF", "0.9767611", "0.28280696",
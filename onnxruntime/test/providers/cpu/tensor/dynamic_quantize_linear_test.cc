@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
@@ -53,5 +56,35 @@ TEST(QuantizeLinearOpTest, DynamicQuantizeLinear_Max_Adjusted) {
   test.Run();
 }
 
+// large enough for the min and max to be found in parallel, with the min and the max in different blocks.
+TEST(QuantizeLinearOpTest, DynamicQuantizeLinear_Large) {
+  constexpr size_t size = 100000;
+  constexpr float step = 5.0f / 255.0f;
+  std::vector<float> x(size);
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = static_cast<float>(static_cast<int>((i * 7) % 200) - 100) * step;
+  }
+  x[5] = 102 * step;
+  x[size - 10] = -153 * step;
+
+  const float min = *std::min_element(x.begin(), x.end());
+  const float max = *std::max_element(x.begin(), x.end());
+  const float scale = (max - min) / 255.0f;
+  const auto zero_point = static_cast<uint8_t>(std::nearbyint(std::clamp(-min / scale, 0.0f, 255.0f)));
+  std::vector<uint8_t> y(size);
+  for (size_t i = 0; i < size; ++i) {
+    y[i] = static_cast<uint8_t>(std::clamp(std::nearbyint(x[i] / scale) + zero_point, 0.0f, 255.0f));
+  }
+
+  OpTester test("DynamicQuantizeLinear", 11);
+  std::vector<int64_t> dims{static_cast<int64_t>(size)};
+  test.AddInput<float>("x", dims, x);
+  test.AddOutput<uint8_t>("y", dims, y);
+  test.AddOutput<float>("y_scale", {}, {scale});
+  test.AddOutput<uint8_t>("y_zero_point", {}, {zero_point});
+  // DML rounds some values differently, see DynamicQuantizeLinear above
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kDmlExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -337,6 +337,48 @@ TEST(GatherOpTest, Gather_axis1_indices2d_string) {
   test.Run();
 }
 
+TEST(GatherOpTest, Gather_axis0_string_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 2},
+                             {"0", "1",
+                              "10", "11",
+                              "20", "21"});
+  test.AddInput<int64_t>("indices", {3}, {2, -3, 1});
+  test.AddOutput<std::string>("output", {3, 2},
+                              {"20", "21",
+                               "0", "1",
+                               "10", "11"});
+  test.Run();
+}
+
+// More indices than the prefetch distance, for rows with a size the copy is specialized for and one it isn't.
+TEST(GatherOpTest, Gather_axis0_many_rows) {
+  constexpr int64_t kNumRows = 50;
+  constexpr int64_t kNumIndices = 40;
+  for (int64_t row_size : {4, 5}) {
+    std::vector<float> data(kNumRows * row_size);
+    for (size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<float>(i);
+    }
+
+    std::vector<int64_t> indices(kNumIndices);
+    std::vector<float> output;
+    for (int64_t i = 0; i < kNumIndices; ++i) {
+      const int64_t row = (i * 17) % kNumRows;
+      indices[i] = i % 3 == 0 ? row - kNumRows : row;
+      output.insert(output.end(), data.begin() + row * row_size, data.begin() + (row + 1) * row_size);
+    }
+
+    OpTester test("Gather");
+    test.AddAttribute<int64_t>("axis", 0LL);
+    test.AddInput<float>("data", {kNumRows, row_size}, data);
+    test.AddInput<int64_t>("indices", {kNumIndices}, indices);
+    test.AddOutput<float>("output", {kNumIndices, row_size}, output);
+    test.Run();
+  }
+}
+
 TEST(GatherOpTest, Gather_axis1_indices2d_bool) {
   OpTester test("Gather");
   test.AddAttribute<int64_t>("axis", 1LL);
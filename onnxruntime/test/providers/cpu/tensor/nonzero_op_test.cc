@@ -109,5 +109,24 @@ TEST(NonZeroOpTest, EmptyInput) {
   test.Run();
 }
 
+TEST(NonZeroOpTest, LongInput) {
+  // long enough to be counted and written in parallel blocks
+  constexpr int64_t rows = 300, columns = 1000;
+  std::vector<float> X(rows * columns, 0.0f);
+  std::vector<int64_t> Y_rows, Y_columns;
+  for (int64_t i = 0; i < rows * columns; i += 7) {
+    X[i] = 1.0f;
+    Y_rows.push_back(i / columns);
+    Y_columns.push_back(i % columns);
+  }
+  std::vector<int64_t> Y(Y_rows);
+  Y.insert(Y.end(), Y_columns.begin(), Y_columns.end());
+
+  OpTester test{kOpName, kOpVersion};
+  test.AddInput<float>("X", {rows, columns}, X);
+  test.AddOutput<int64_t>("Y", {2, static_cast<int64_t>(Y_rows.size())}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
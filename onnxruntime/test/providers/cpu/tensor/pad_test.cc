@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -1089,5 +1091,33 @@ TEST(PadOpTest, ConstantPadNegativeAxes) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kNnapiExecutionProvider});
 }
 
+// Pads on the inner and the outer axes of an input with long rows, for which the rows are built from block copies.
+TEST(PadOpTest, Pad_Reflect_Edge_LongRows) {
+  const int64_t rows = 3, cols = 100;
+  std::vector<float> input(static_cast<size_t>(rows * cols));
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+
+  for (const std::string mode : {"reflect", "edge"}) {
+    const int64_t pad_rows = 2, pad_begin = 5, pad_end = 7;
+    const int64_t out_rows = rows + 2 * pad_rows, out_cols = cols + pad_begin + pad_end;
+    auto source = [&mode](int64_t i, int64_t n) {
+      if (mode == "edge") {
+        return std::min(std::max(i, int64_t{0}), n - 1);
+      }
+      return i < 0 ? -i : (i >= n ? 2 * (n - 1) - i : i);
+    };
+    std::vector<float> output;
+    for (int64_t r = 0; r < out_rows; ++r) {
+      for (int64_t c = 0; c < out_cols; ++c) {
+        output.push_back(input[static_cast<size_t>(source(r - pad_rows, rows) * cols + source(c - pad_begin, cols))]);
+      }
+    }
+    RunAllOpsetAllDomainPadTests<float>({rows, cols}, input, {pad_rows, pad_begin, pad_rows, pad_end}, 0.0f,
+                                        {out_rows, out_cols}, output, mode);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -235,5 +235,50 @@ TEST(ScatterNDOpTest, ScatterND_18_max) {
   test1.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
 }
 
+// The new rows of a KV cache, adjacent in the output, are updated as one run.
+TEST(ScatterNDOpTest, ScatterND_adjacent_slices) {
+  constexpr int64_t rows = 64, cols = 4, first_row = 8, num_rows = 48;
+  std::vector<float> data(rows * cols, 0.0f);
+  std::vector<int64_t> indices(num_rows);
+  std::vector<float> updates(num_rows * cols);
+  std::vector<float> expected(data);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    indices[i] = first_row + i;
+    for (int64_t j = 0; j < cols; ++j) {
+      updates[i * cols + j] = static_cast<float>(i * cols + j + 1);
+      expected[(first_row + i) * cols + j] = updates[i * cols + j];
+    }
+  }
+
+  OpTester test("ScatterND", 18);
+  test.AddInput<float>("data", {rows, cols}, data);
+  test.AddInput<int64_t>("indices", {num_rows, 1}, indices);
+  test.AddInput<float>("updates", {num_rows, cols}, updates);
+  test.AddOutput<float>("output", {rows, cols}, expected);
+  test.Run();
+}
+
+// Duplicated slices of a reduction are all accumulated.
+TEST(ScatterNDOpTest, ScatterND_18_add_duplicated_slices) {
+  constexpr int64_t rows = 4, cols = 3, num_slices = 400;
+  std::vector<int64_t> indices(num_slices);
+  std::vector<float> updates(num_slices * cols, 1.0f);
+  std::vector<float> expected(rows * cols, 0.0f);
+  for (int64_t i = 0; i < num_slices; ++i) {
+    indices[i] = (i * 3) % rows;
+    for (int64_t j = 0; j < cols; ++j) {
+      expected[indices[i] * cols + j] += 1.0f;
+    }
+  }
+
+  OpTester test("ScatterND", 18);
+  test.AddAttribute("reduction", "add");
+  test.AddInput<float>("data", {rows, cols}, std::vector<float>(rows * cols, 0.0f));
+  test.AddInput<int64_t>("indices", {num_slices, 1}, indices);
+  test.AddInput<float>("updates", {num_slices, cols}, updates);
+  test.AddOutput<float>("output", {rows, cols}, expected);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -452,5 +452,33 @@ TEST(ScatterElements, MinReduction_Double) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
 }
 
+// Updates along the axis with the same outer and inner coordinates are applied in order.
+TEST(ScatterElements, AddReductionDuplicatedIndicesLong) {
+  constexpr int64_t outer = 3, axis_dim = 2, updates_dim = 64, inner = 5;
+  std::vector<float> data(outer * axis_dim * inner, 1.0f);
+  std::vector<int64_t> indices(outer * updates_dim * inner);
+  std::vector<float> updates(indices.size());
+  std::vector<float> expected(data);
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t k = 0; k < updates_dim; ++k) {
+      for (int64_t j = 0; j < inner; ++j) {
+        const int64_t index = (o * updates_dim + k) * inner + j;
+        indices[index] = (k + j) % axis_dim;
+        updates[index] = static_cast<float>(k % 7);
+        expected[(o * axis_dim + indices[index]) * inner + j] += updates[index];
+      }
+    }
+  }
+
+  OpTester test("ScatterElements", 18);
+  test.AddAttribute<int64_t>("axis", 1);
+  test.AddAttribute<std::string>("reduction", "add");
+  test.AddInput<float>("data", {outer, axis_dim, inner}, data);
+  test.AddInput<int64_t>("indices", {outer, updates_dim, inner}, indices);
+  test.AddInput<float>("updates", {outer, updates_dim, inner}, updates);
+  test.AddOutput<float>("y", {outer, axis_dim, inner}, expected);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
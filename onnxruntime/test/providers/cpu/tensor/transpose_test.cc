@@ -8,6 +8,9 @@
 #include "core/providers/cpu/tensor/transpose.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/asserts.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -869,5 +872,61 @@ TEST(TransposeOpTest, TransposeBigMLFloat16) {  // Exercises CanUse_cublasTransp
 }
 #endif  // defined(USE_CUDA) || defined(USE_ROCM)
 
+// 5D permutations with odd dims that aren't a single moved axis, so they go through the tiled transpose: one with
+// the innermost input axis moved (element-wise tiles) and one keeping it innermost (contiguous rows).
+TEST(TransposeOpTest, TiledTranspose5D) {
+  const std::vector<int64_t> input_shape{2, 3, 17, 19, 5};
+  const std::vector<std::vector<int64_t>> perms{{0, 4, 2, 1, 3}, {2, 0, 3, 1, 4}};
+  std::vector<float> input_vals(2 * 3 * 17 * 19 * 5);
+  std::iota(input_vals.begin(), input_vals.end(), 0.0f);
+
+  std::vector<int64_t> input_strides(input_shape.size(), 1);
+  for (size_t i = input_shape.size() - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * input_shape[i];
+  }
+
+  for (const auto& perm : perms) {
+    std::vector<int64_t> expected_shape(perm.size());
+    for (size_t i = 0; i < perm.size(); ++i) {
+      expected_shape[i] = input_shape[perm[i]];
+    }
+
+    std::vector<float> expected_vals(input_vals.size());
+    for (size_t out = 0; out < expected_vals.size(); ++out) {
+      size_t remaining = out;
+      int64_t in = 0;
+      for (size_t i = perm.size(); i-- > 0;) {
+        in += static_cast<int64_t>(remaining % expected_shape[i]) * input_strides[perm[i]];
+        remaining /= expected_shape[i];
+      }
+      expected_vals[out] = input_vals[in];
+    }
+
+    TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals);
+  }
+}
+
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(TransposeOpTest, Strided) {
+  // Strided output.
+  {
+    KernelComputeTester test("Transpose", kCpuExecutionProvider, 13);
+    test.AddAttribute("perm", std::vector<int64_t>{1, 0});
+    test.AddInput<float>("input", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.AddOutput<float>("output", {3, 2}, {1.f, 4.f, 2.f, 5.f, 3.f, 6.f}, {1, 3});
+    test.Run({0});
+  }
+
+  // Transposing a transposed view gives back the contiguous storage.
+  {
+    KernelComputeTester test("Transpose", kCpuExecutionProvider, 13);
+    test.AddAttribute("perm", std::vector<int64_t>{1, 0});
+    test.AddInput<float>("input", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {1, 2});
+    test.AddOutput<float>("output", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.Run();
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
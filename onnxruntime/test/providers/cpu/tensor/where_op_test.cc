@@ -3,6 +3,8 @@
 
 #include "gtest/gtest.h"
 
+#include <memory>
+
 #include <gsl/gsl>
 
 #include "test/providers/provider_test_utils.h"
@@ -146,5 +148,37 @@ TEST(WhereOpTest, BroadcastWithScalar) {
   test.Run();
 }
 
+TEST(WhereOpTest, BroadcastMask) {
+  // an attention mask style condition broadcast over the heads and the rows of the scores
+  OpTester test{kOpName, kOpVersion};
+
+  const int64_t batch = 2, heads = 3, rows = 4, cols = 40;
+  const size_t condition_size = static_cast<size_t>(batch * cols);
+  auto condition = std::make_unique<bool[]>(condition_size);
+  for (size_t i = 0; i < condition_size; ++i) {
+    condition[i] = (i % 3) != 0;
+  }
+  std::vector<float> X(static_cast<size_t>(batch * heads * rows * cols));
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(i);
+  }
+
+  std::vector<float> result;
+  result.reserve(X.size());
+  for (int64_t b = 0; b < batch; ++b) {
+    for (int64_t i = 0; i < heads * rows * cols; ++i) {
+      const auto x_index = static_cast<size_t>(b * heads * rows * cols + i);
+      result.push_back(condition[static_cast<size_t>(b * cols + i % cols)] ? X[x_index] : -100.0f);
+    }
+  }
+
+  test.AddInput<bool>("condition", {batch, 1, 1, cols}, condition.get(), condition_size);
+  test.AddInput<float>("X", {batch, heads, rows, cols}, X);
+  test.AddInput<float>("Y", {}, {-100.0f});
+  test.AddOutput<float>("output", {batch, heads, rows, cols}, result);
+
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
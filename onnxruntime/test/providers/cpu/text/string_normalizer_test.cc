@@ -194,6 +194,20 @@ TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutUpperWithLocale) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutLowerMixedAscii) {
+  // - case-INSENSITIVE approach en_US locale
+  // - ASCII strings take a path without wide chars, the others are converted
+  // - filter out monday and über whatever their case
+  OpTester test("StringNormalizer", opset_ver, domain);
+  InitTestAttr(test, "LOWER", false, {"Monday", "über"}, test_locale);
+  std::vector<int64_t> dims{6};
+  std::vector<std::string> input = {"MONDAY", "Über", "Tuesday", "ÜBER", "wednesDAY [@`{]", "Étude"};
+  test.AddInput<std::string>("T", dims, input);
+  std::vector<std::string> output = {"tuesday", "wednesday [@`{]", "étude"};
+  test.AddOutput<std::string>("Y", {3}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, StringNormalizerSensitiveFilterOutUpperEmptyCase) {
   // Empty output case
   // - casesensitive approach
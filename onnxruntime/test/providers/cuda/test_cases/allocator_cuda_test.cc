@@ -1,10 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+
 #include "core/framework/allocator_utils.h"
 #include "gtest/gtest.h"
 #include "cuda_runtime.h"
 #include "core/framework/allocator.h"
+#include "core/framework/stream_handles.h"
 #include "core/providers/cuda/cuda_allocator.h"
 #include "core/providers/cuda/cuda_common.h"
 
@@ -113,5 +116,56 @@ TEST(AllocatorTest, CUDAAllocatorFallbackTest) {
   auto last_error = cudaGetLastError();
   EXPECT_EQ(last_error, cudaSuccess) << "Last error should be cleared if handled gracefully";
 }
+
+TEST(AllocatorTest, CUDAMemPoolAllocatorTest) {
+  OrtDevice::DeviceId cuda_device_id = 0;
+  CUDA_CALL_THROW(cudaSetDevice(cuda_device_id));
+
+  CUDAMemPoolAllocator allocator(cuda_device_id, CUDA, std::numeric_limits<size_t>::max());
+  EXPECT_EQ(allocator.Info().alloc_type, OrtDeviceAllocator);
+  EXPECT_TRUE(allocator.IsStreamAware());
+
+  cudaStream_t cuda_stream;
+  CUDA_CALL_THROW(cudaStreamCreateWithFlags(&cuda_stream, cudaStreamNonBlocking));
+  Stream stream(cuda_stream, allocator.Info().device);
+
+  constexpr size_t size = 1024;
+  void* device_addr = allocator.Alloc(size);
+  void* stream_addr = allocator.AllocOnStream(2 * size, &stream);
+  ASSERT_TRUE(device_addr);
+  ASSERT_TRUE(stream_addr);
+
+  CUDA_CALL_THROW(cudaMemsetAsync(stream_addr, -1, 2 * size, cuda_stream));
+  CUDA_CALL_THROW(cudaMemcpyAsync(device_addr, stream_addr, size, cudaMemcpyDeviceToDevice, cuda_stream));
+  int value = 0;
+  CUDA_CALL_THROW(cudaMemcpyAsync(&value, device_addr, sizeof(value), cudaMemcpyDeviceToHost, cuda_stream));
+  CUDA_CALL_THROW(cudaStreamSynchronize(cuda_stream));
+  EXPECT_EQ(value, -1);
+
+  AllocatorStats stats;
+  allocator.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.bytes_in_use, static_cast<int64_t>(3 * size));
+  EXPECT_EQ(stats.max_alloc_size, static_cast<int64_t>(2 * size));
+  EXPECT_GE(stats.total_allocated_bytes, stats.bytes_in_use);
+
+  // the memory allocated on the stream is freed in its order without synchronizing.
+  allocator.Free(stream_addr);
+  void* reused_addr = allocator.AllocOnStream(2 * size, &stream);
+  ASSERT_TRUE(reused_addr);
+
+  // memory that outlives its stream is freed like memory allocated without a stream.
+  allocator.ReleaseStreamBuffers(&stream);
+  CUDA_CALL_THROW(cudaStreamDestroy(cuda_stream));
+  allocator.Free(reused_addr);
+  allocator.Free(device_addr);
+
+  allocator.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 3);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.max_bytes_in_use, static_cast<int64_t>(3 * size));
+  EXPECT_EQ(cudaGetLastError(), cudaSuccess);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
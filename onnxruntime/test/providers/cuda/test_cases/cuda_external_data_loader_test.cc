@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "cuda_runtime.h"
+#include "core/providers/cuda/cuda_allocator.h"
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/cuda_external_data_loader.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(CudaExternalDataLoaderTest, LoadTensorInChunks) {
+  OrtDevice::DeviceId cuda_device_id = 0;
+  CUDA_CALL_THROW(cudaSetDevice(cuda_device_id));
+
+  // the data follows a header of 16 bytes, and spans several chunks with a partial last one
+  constexpr FileOffsetType kDataOffset = 16;
+  std::vector<float> expected(1000);
+  std::iota(expected.begin(), expected.end(), 0.0f);
+  const std::filesystem::path data_file_path = "cuda_external_data_loader_test.bin";
+  {
+    std::ofstream file(data_file_path, std::ios::binary);
+    const std::vector<char> header(kDataOffset, 0);
+    file.write(header.data(), header.size());
+    file.write(reinterpret_cast<const char*>(expected.data()), expected.size() * sizeof(float));
+  }
+
+  CudaExternalDataLoader loader(cuda_device_id, 384);
+  auto allocator = std::make_shared<CUDAAllocator>(cuda_device_id, CUDA);
+  EXPECT_TRUE(loader.CanLoad(allocator->Info()));
+
+  auto tensor = Tensor::Create(DataTypeImpl::GetType<float>(), TensorShape({1000}), allocator);
+  ASSERT_STATUS_OK(loader.LoadTensor(GetDefaultEnv(), data_file_path, kDataOffset,
+                                     expected.size() * sizeof(float), *tensor));
+
+  std::vector<float> loaded(expected.size());
+  CUDA_CALL_THROW(cudaMemcpy(loaded.data(), tensor->DataRaw(), loaded.size() * sizeof(float),
+                             cudaMemcpyDeviceToHost));
+  EXPECT_EQ(loaded, expected);
+
+  std::remove(data_file_path.string().c_str());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -673,6 +673,57 @@ TEST(TensorrtExecutionProviderTest, ExcludeOpsTest) {
   ASSERT_EQ(engine_files.size(), 3);
 }
 
+TEST(TensorrtExecutionProviderTest, EngineAsyncBuildTest) {
+  PathString model_name = ORT_TSTR("trt_execution_provider_engine_async_build_test.onnx");
+  std::string graph_name = "engine_async_build_test";
+  std::vector<int> dims = {1, -1, -1};
+  CreateBaseModel(model_name, graph_name, dims);
+
+  SessionOptions so;
+  so.session_logid = "TensorrtExecutionProviderEngineAsyncBuildTest";
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  InferenceSession session_object{so, GetEnvironment()};
+  auto cuda_provider = DefaultCudaExecutionProvider();
+  auto cpu_allocator = cuda_provider->CreatePreferredAllocators()[1];
+
+  auto make_feeds = [&](const std::vector<int64_t>& input_dims, const std::vector<float>& input_values) {
+    NameMLValMap feeds;
+    for (const char* input_name : {"X", "Y", "Z"}) {
+      OrtValue ml_value;
+      CreateMLValue<float>(cpu_allocator, input_dims, input_values, &ml_value);
+      feeds.insert(std::make_pair(input_name, ml_value));
+    }
+    return feeds;
+  };
+  std::vector<std::string> output_names = {"M"};
+
+  RemoveCachesByType("./", ".engine");
+  OrtTensorRTProviderOptionsV2 params;
+  params.trt_engine_cache_enable = 1;
+  params.trt_engine_cache_prefix = "TRTEP_Async_Build_Test";
+  params.trt_engine_async_build = 1;
+  std::unique_ptr<IExecutionProvider> execution_provider = TensorrtExecutionProviderWithOptions(&params);
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(std::move(execution_provider)));
+  ASSERT_STATUS_OK(session_object.Load(model_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // The first runs use CUDA EP while the engine is built in the background. The engine cache is written once the
+  // engine has been swapped in.
+  NameMLValMap feeds = make_feeds({1, 3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  const auto build_deadline = std::chrono::steady_clock::now() + std::chrono::minutes(5);
+  do {
+    RunSession(session_object, run_options, feeds, output_names, {1, 3, 2}, {3.0f, 6.0f, 9.0f, 12.0f, 15.0f, 18.0f});
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  } while (!HasCacheFileWithPrefix(params.trt_engine_cache_prefix) && std::chrono::steady_clock::now() < build_deadline);
+  ASSERT_TRUE(HasCacheFileWithPrefix(params.trt_engine_cache_prefix));
+
+  // A shape outside of the engine profile runs with CUDA EP again while the engine is rebuilt.
+  feeds = make_feeds({1, 2, 4}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f});
+  RunSession(session_object, run_options, feeds, output_names, {1, 2, 4},
+             {3.0f, 6.0f, 9.0f, 12.0f, 15.0f, 18.0f, 21.0f, 24.0f});
+}
+
 TEST(TensorrtExecutionProviderTest, TRTPluginsCustomOpTest) {
   PathString model_name = ORT_TSTR("testdata/trt_plugin_custom_op_test.onnx");
   SessionOptions so;
@@ -16,6 +16,7 @@
 
 #include "test/common/tensor_op_test_utils.h"
 #include "test/framework/test_utils.h"
+#include "test/providers/op_tester.h"
 #include "test/test_environment.h"
 #include "test/util/include/api_asserts.h"
 #include "test/util/include/asserts.h"
@@ -127,6 +128,51 @@ TEST(XnnpackEP, TestAllocatorSharing) {
   // TODO(leca): should also check there is only 1 allocator in session1.GetSessionState().GetAllocators() which is used by both xnnpack EP and CPU EP
 }
 
+// sessions sharing an initializer and a PrepackedWeightsContainer should share the XNNPACK packed weights
+TEST(XnnpackEP, TestSharedPrepackedWeights) {
+  OpTester test("MatMul");
+
+  std::vector<float> b_init_values(12, 1.0f);
+  test.AddInput<float>("A", {2, 4},
+                       {1.0f, 2.0f, 3.0f, 4.0f,
+                        -1.0f, -2.0f, -3.0f, -4.0f});
+  test.AddInput<float>("B", {4, 3}, b_init_values, true);
+  test.AddOutput<float>("Y", {2, 3},
+                        {10.0f, 10.0f, 10.0f,
+                         -10.0f, -10.0f, -10.0f});
+
+  OrtValue b;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({4, 3}),
+                       b_init_values.data(), OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator), b);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.AddInitializer("B", &b));
+  test.EnableSharingOfPrePackedWeightsAcrossSessions();
+
+  auto xnnpack_ep = []() -> std::vector<std::unique_ptr<IExecutionProvider>> {
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultXnnpackExecutionProvider());
+    return execution_providers;
+  };
+
+  size_t number_of_pre_packed_weights_counter_session_1 = 0;
+  size_t number_of_shared_pre_packed_weights_counter = 0;
+  test.Config(so)
+      .ConfigEps(xnnpack_ep())
+      .RunWithConfig(&number_of_pre_packed_weights_counter_session_1, &number_of_shared_pre_packed_weights_counter);
+  ASSERT_EQ(number_of_pre_packed_weights_counter_session_1, static_cast<size_t>(1));
+  ASSERT_EQ(number_of_shared_pre_packed_weights_counter, static_cast<size_t>(0));
+  ASSERT_EQ(test.GetNumPrePackedWeightsShared(), static_cast<size_t>(1));
+
+  size_t number_of_pre_packed_weights_counter_session_2 = 0;
+  test.Config(so)
+      .ConfigEps(xnnpack_ep())
+      .RunWithConfig(&number_of_pre_packed_weights_counter_session_2, &number_of_shared_pre_packed_weights_counter);
+  ASSERT_EQ(number_of_pre_packed_weights_counter_session_2, static_cast<size_t>(1));
+  ASSERT_EQ(number_of_shared_pre_packed_weights_counter, static_cast<size_t>(1));
+  ASSERT_EQ(test.GetNumPrePackedWeightsShared(), static_cast<size_t>(1));
+}
+
 TEST(XnnpackEP, TestAddEpUsingPublicApi) {
   auto session_has_xnnpack_ep = [](Ort::Session& session) -> bool {
     // dirty hack to access the underlying InferenceSession but don't know a better way.
@@ -4624,6 +4624,62 @@ TEST(CApiTest, RunAsyncFail) {
   EXPECT_THROW(session.RunAsync(run_options, input_names, input_tensors, 1, output_names, output_values, 1, CallbackFail, nullptr), std::exception);
 }
 
+struct CreateSessionAsyncResult {
+  std::vector<std::string> phases;
+  std::promise<std::pair<OrtSession*, OrtStatus*>> done;
+};
+
+void CreateSessionAsyncProgress(void* user_data, const char* phase) {
+  reinterpret_cast<CreateSessionAsyncResult*>(user_data)->phases.push_back(phase);
+}
+
+void CreateSessionAsyncDone(void* user_data, OrtSession* session, OrtStatusPtr status) {
+  reinterpret_cast<CreateSessionAsyncResult*>(user_data)->done.set_value({session, status});
+}
+
+TEST(CApiTest, CreateSessionAsync) {
+  Ort::SessionOptions session_options;
+  CreateSessionAsyncResult result;
+  auto done = result.done.get_future();
+  Ort::ThrowOnError(Ort::GetApi().CreateSessionAsync(*ort_env, MODEL_URI, session_options,
+                                                     CreateSessionAsyncProgress, CreateSessionAsyncDone, &result));
+  // the options are copied
+  session_options = Ort::SessionOptions{};
+
+  ASSERT_EQ(done.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+  auto [session_ptr, status_ptr] = done.get();
+  Ort::Status status(status_ptr);
+  ASSERT_TRUE(status.IsOK()) << status.GetErrorMessage();
+  ASSERT_NE(session_ptr, nullptr);
+  EXPECT_THAT(result.phases, ::testing::ElementsAre("model_loaded", "graph_partitioned", "session_state_finalized"));
+
+  Ort::Session session(session_ptr);
+  const char* input_names[] = {"X"};
+  float x_value[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  int64_t x_dim[] = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  Ort::Value input_tensor = Ort::Value::CreateTensor<float>(memory_info, x_value, 6, x_dim, 2);
+  const char* output_names[] = {"Y"};
+  auto outputs = session.Run(Ort::RunOptions{}, input_names, &input_tensor, 1, output_names, 1);
+  ASSERT_EQ(outputs.size(), 1U);
+  EXPECT_EQ(outputs[0].At<float>({1, 0}), 9.f);
+}
+
+TEST(CApiTest, CreateSessionAsyncFail) {
+  Ort::SessionOptions session_options;
+  CreateSessionAsyncResult result;
+  auto done = result.done.get_future();
+  Ort::ThrowOnError(Ort::GetApi().CreateSessionAsync(*ort_env, TSTR("testdata/not_a_model.onnx"),
+                                                     session_options, nullptr, CreateSessionAsyncDone, &result));
+
+  ASSERT_EQ(done.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+  auto [session_ptr, status_ptr] = done.get();
+  Ort::Status status(status_ptr);
+  EXPECT_FALSE(status.IsOK());
+  EXPECT_EQ(session_ptr, nullptr);
+  EXPECT_TRUE(result.phases.empty());
+}
+
 static void TestRunWithLoraAdapter(const Ort::LoraAdapter& adapter) {
   constexpr const ORTCHAR_T* model_path = TSTR("testdata/lora/two_params_lora_model.onnx");
 
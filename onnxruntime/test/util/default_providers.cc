@@ -5,6 +5,7 @@
 #include <memory>
 #include "default_providers.h"
 #include "providers.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/cpu/cpu_provider_factory_creator.h"
 #ifdef USE_COREML
 #include "core/providers/coreml/coreml_provider_factory.h"
@@ -23,6 +24,13 @@ std::unique_ptr<IExecutionProvider> DefaultCpuExecutionProvider(bool enable_aren
   return CPUProviderFactoryCreator::Create(enable_arena)->CreateProvider();
 }
 
+std::unique_ptr<IExecutionProvider> TunableOpCpuExecutionProvider() {
+  CPUExecutionProviderInfo info;
+  info.tunable_op.enable = true;
+  info.tunable_op.tuning_enable = true;
+  return std::make_unique<CPUExecutionProvider>(info);
+}
+
 std::unique_ptr<IExecutionProvider> DefaultTensorrtExecutionProvider() {
 #ifdef USE_TENSORRT
   OrtTensorRTProviderOptions params{
@@ -36,6 +36,8 @@ namespace test {
 
 // unique_ptr providers with default values for session registration
 std::unique_ptr<IExecutionProvider> DefaultCpuExecutionProvider(bool enable_arena = true);
+// CPU EP with TunableOp and tuning enabled
+std::unique_ptr<IExecutionProvider> TunableOpCpuExecutionProvider();
 std::unique_ptr<IExecutionProvider> DefaultCudaExecutionProvider();
 #ifdef ENABLE_CUDA_NHWC_OPS
 std::unique_ptr<IExecutionProvider> DefaultCudaNHWCExecutionProvider();
@@ -1595,10 +1595,16 @@ void RegisterTrainingOpSchemas() {
              "This signal indicates if weight updates are skipped, applicable to gradient infinity check"
              " in mixed precision training. ",
              "T_BOOL", OpSchema::Optional)
+      .Input(7, "weights_bf16",
+             "Sequence of bfloat16 copies of the weights used by the forward and backward passes. When given, "
+             "weights hold the float master weights and the copies are refreshed from them after the update.",
+             "S_WEIGHT_BF16", OpSchema::Optional)
       .Output(0, "updated_flag", "Whether gradient is applied or not.", "T_BOOL")
       .Output(1, "updated_weights", "Sequence of weights after optimize.", "S_WEIGHT", OpSchema::Optional)
       .Output(2, "updated_momentums_1", "Sequence of momentum_1 after optimize.", "S_MOMENT", OpSchema::Optional)
       .Output(3, "updated_momentums_2", "Sequence of momentum_2 after optimize.", "S_MOMENT", OpSchema::Optional)
+      .Output(4, "updated_weights_bf16", "Sequence of bfloat16 weight copies after optimize.", "S_WEIGHT_BF16",
+              OpSchema::Optional)
       .Attr(
           "alpha",
           "Coefficient of previously accumulated gradient in running average.",
@@ -1648,19 +1654,23 @@ void RegisterTrainingOpSchemas() {
           "Constrain weights' types.")
       .TypeConstraint(
           "S_GRAD",
-          {"seq(tensor(float16))", "seq(tensor(float))", "seq(tensor(double))"},
+          {"seq(tensor(float16))", "seq(tensor(float))", "seq(tensor(double))", "seq(tensor(bfloat16))"},
           "Constrain gradients' types.")
       .TypeConstraint(
           "S_MOMENT",
           {"seq(tensor(float16))", "seq(tensor(float))", "seq(tensor(double))"},
           "Constrain momentums' types.")
+      .TypeConstraint(
+          "S_WEIGHT_BF16",
+          {"seq(tensor(bfloat16))"},
+          "Constrain bfloat16 weight copies' types.")
       .TypeConstraint(
           "T_BOOL",
           {"tensor(bool)"},
           "Constrain types to boolean tensors.")
       .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
         size_t num_of_outputs = ctx.getNumOutputs();
-        std::unordered_map<size_t, size_t> output_to_input_index_map{{0, 1}, {1, 2}, {2, 4}, {3, 5}};
+        std::unordered_map<size_t, size_t> output_to_input_index_map{{0, 1}, {1, 2}, {2, 4}, {3, 5}, {4, 7}};
         assert(output_to_input_index_map.size() >= num_of_outputs);
 
         size_t sequence_source_input_index = 0;  // Be noted: 0 is invalid for sequence source input index
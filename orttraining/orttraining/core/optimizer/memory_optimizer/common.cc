@@ -166,4 +166,31 @@ Status ParseOptimizationConfigFromString(std::string_view memory_optimization_co
   return Status::OK();
 }
 
+Status ParseMemoryBudgetFromString(std::string_view memory_budget_config, MemoryBudget& memory_budget) {
+  memory_budget = MemoryBudget{};
+  if (memory_budget_config.empty()) {
+    return Status::OK();
+  }
+
+  const auto budget_and_dims = utils::SplitString(memory_budget_config, ":");
+  ORT_RETURN_IF_NOT(budget_and_dims.size() <= 2,
+                    "Memory budget should be in the format of BudgetInMiB:dim_param=value,dim_param=value.");
+
+  const int budget_mib = ParseIntValueFromString(budget_and_dims[0]);
+  ORT_RETURN_IF_NOT(budget_mib >= 0, "Invalid memory budget: ", budget_and_dims[0]);
+  memory_budget.budget_bytes = static_cast<int64_t>(budget_mib) * 1024 * 1024;
+
+  if (budget_and_dims.size() == 2) {
+    for (const auto& dim_config : utils::SplitString(budget_and_dims[1], ",")) {
+      const auto dim_and_value = utils::SplitString(dim_config, "=");
+      ORT_RETURN_IF_NOT(dim_and_value.size() == 2, "Invalid dim value in memory budget: ", dim_config);
+      const int dim_value = ParseIntValueFromString(dim_and_value[1]);
+      ORT_RETURN_IF_NOT(dim_value > 0, "Invalid dim value in memory budget: ", dim_config);
+      memory_budget.dim_values[utils::TrimString(std::string(dim_and_value[0]))] = dim_value;
+    }
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime::optimizer::memory_optimizer
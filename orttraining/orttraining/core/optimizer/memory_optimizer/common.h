@@ -73,6 +73,25 @@ int ParseIntValueFromString(std::string_view str);
 Status ParseOptimizationConfigFromString(std::string_view memory_optimization_config_file_path,
                                          InlinedHashMap<std::string, UserConfig>& cluster_id_to_config_map);
 
+/**
+ * @brief Memory budget for the activations stashed for the backward pass.
+ * budget_bytes: the recompute plans are chosen to bring the stashed activations under this size. -1 means disabled.
+ * dim_values: values of the symbolic dimensions used to size the activations, e.g. batch and sequence length.
+ *   Symbolic dimensions without a value count as 1.
+ */
+struct MemoryBudget {
+  int64_t budget_bytes{-1};
+  InlinedHashMap<std::string, int64_t> dim_values;
+
+  bool IsEnabled() const { return budget_bytes >= 0; }
+};
+
+/**
+ * @brief Parse a memory budget in the format of "BudgetInMiB" or "BudgetInMiB:dim_param=value,dim_param=value",
+ * for example "4096:batch=8,sequence=512".
+ */
+Status ParseMemoryBudgetFromString(std::string_view memory_budget_config, MemoryBudget& memory_budget);
+
 constexpr const ExecutionOrder TOPOLOGICAL_SORT_ALGORITHM = ExecutionOrder::MEMORY_EFFICIENT;
 
 }  // namespace onnxruntime::optimizer::memory_optimizer
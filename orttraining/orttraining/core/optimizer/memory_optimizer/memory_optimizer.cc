@@ -69,7 +69,8 @@ bool SetTrainingModeForForwardPythonOpNode(Node& node) {
 }  // namespace
 
 Status MemoryOptimizer::ParseOptimizationConfigFromString(const std::string& memory_optimization_config_file_path,
-                                                          const std::string& recompute_probe_config) {
+                                                          const std::string& recompute_probe_config,
+                                                          const std::string& memory_budget_config) {
   optimizer_config_file_path_ = memory_optimization_config_file_path;
 
   ORT_RETURN_IF_ERROR(optimizer::memory_optimizer::ParseOptimizationConfigFromString(
@@ -80,6 +81,10 @@ Status MemoryOptimizer::ParseOptimizationConfigFromString(const std::string& mem
       recompute_probe_config,
       recompute_probe_config_));
 
+  ORT_RETURN_IF_ERROR(optimizer::memory_optimizer::ParseMemoryBudgetFromString(
+      memory_budget_config,
+      memory_budget_));
+
   return Status::OK();
 }
 
@@ -166,8 +171,8 @@ Status MemoryOptimizer::ApplyImpl(Graph& graph, bool& modified, int /*graph_leve
                         << ", enable_transformer_layer_as_boundary:"
                         << recompute_probe_config_.enable_transformer_layer_as_boundary;
 
-  if (pattern_subgraph_to_user_optimizer_config_map_.empty()) {
-    LOGS(logger, VERBOSE) << "No optimization pattern is specified, skip memory optimization.";
+  if (pattern_subgraph_to_user_optimizer_config_map_.empty() && !memory_budget_.IsEnabled()) {
+    LOGS(logger, VERBOSE) << "No optimization pattern or memory budget is specified, skip memory optimization.";
     return Status::OK();
   }
 
@@ -190,15 +195,23 @@ Status MemoryOptimizer::ApplyImpl(Graph& graph, bool& modified, int /*graph_leve
                   memory_opt_planner)
                   .IsOK());
 
-  // Finalize the plan according to user config,
+  // Finalize the plan according to user config, or to the memory budget if there is no user config,
   // then create a ClusterApplyContext for each unique cluster (having the same node pattern)
   InlinedHashMap<const Node*, std::shared_ptr<optimizer::memory_optimizer::NodeOptimizationPlanBase>>
       node_to_opt_plan_map;
   optimizer::memory_optimizer::NodeToClusterApplyContextMap node_to_apply_context_map;
-  ORT_ENFORCE(memory_opt_planner.FinalizeNodePlansFromUserConfig(pattern_subgraph_to_user_optimizer_config_map_,
-                                                                 node_to_opt_plan_map,
-                                                                 node_to_apply_context_map)
-                  .IsOK());
+  if (!pattern_subgraph_to_user_optimizer_config_map_.empty()) {
+    ORT_ENFORCE(memory_opt_planner.FinalizeNodePlansFromUserConfig(pattern_subgraph_to_user_optimizer_config_map_,
+                                                                   node_to_opt_plan_map,
+                                                                   node_to_apply_context_map)
+                    .IsOK());
+  } else {
+    ORT_ENFORCE(memory_opt_planner.FinalizeNodePlansFromMemoryBudget(memory_budget_,
+                                                                     logger,
+                                                                     node_to_opt_plan_map,
+                                                                     node_to_apply_context_map)
+                    .IsOK());
+  }
 
   // The second pass - apply the transformation.
   const auto& node_ids =
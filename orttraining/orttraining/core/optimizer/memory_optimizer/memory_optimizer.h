@@ -29,12 +29,17 @@ Find recompute subgraphs and enable them according to user configs. The way we c
 class MemoryOptimizer : public GraphTransformer {
  private:
  public:
+  /**
+   * @param memory_budget_config Optional memory budget, see ParseMemoryBudgetFromString. Used to pick the recompute
+   *   plans when no config file is given.
+   */
   MemoryOptimizer(const std::string& memory_optimization_config_file_path,
-                  const std::string& recompute_probe_config)
+                  const std::string& recompute_probe_config,
+                  const std::string& memory_budget_config = "")
       : GraphTransformer("MemoryOptimizer") {
     // Parse user-defined configs.
     ORT_ENFORCE(ParseOptimizationConfigFromString(
-                    memory_optimization_config_file_path, recompute_probe_config)
+                    memory_optimization_config_file_path, recompute_probe_config, memory_budget_config)
                     .IsOK());
   }
 
@@ -44,7 +49,8 @@ class MemoryOptimizer : public GraphTransformer {
 
  private:
   Status ParseOptimizationConfigFromString(const std::string& memory_optimizer_config_file_path,
-                                           const std::string& recompute_probe_config);
+                                           const std::string& recompute_probe_config,
+                                           const std::string& memory_budget_config);
 
   /**
    * @brief Apply graph modifications based on user configs.
@@ -105,6 +111,7 @@ class MemoryOptimizer : public GraphTransformer {
   InlinedHashMap<std::string, optimizer::memory_optimizer::UserConfig> pattern_subgraph_to_user_optimizer_config_map_;
   std::string optimizer_config_file_path_;
   optimizer::memory_optimizer::ProbeConfig recompute_probe_config_;
+  optimizer::memory_optimizer::MemoryBudget memory_budget_;
 };
 
 }  // namespace onnxruntime
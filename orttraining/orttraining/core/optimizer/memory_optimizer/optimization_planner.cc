@@ -1,20 +1,89 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/utils.h"
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/framework/sequential_execution_plan.h"
+#include "core/framework/tensorprotoutils.h"
 
 #include "orttraining/core/optimizer/memory_optimizer/common.h"
 #include "orttraining/core/optimizer/memory_optimizer/optimization_planner.h"
+#include "orttraining/core/optimizer/memory_optimizer/recompute_analysis.h"
 
 namespace onnxruntime::optimizer::memory_optimizer {
 
+namespace {
+
+// Element count of a tensor, with the symbolic dimensions replaced by their values in the memory budget.
+int64_t GetElementCount(const NodeArg& node_arg, const MemoryBudget& memory_budget) {
+  const auto* shape = node_arg.Shape();
+  if (shape == nullptr) {
+    return 1;
+  }
+
+  int64_t count = 1;
+  for (const auto& dim : shape->dim()) {
+    if (utils::HasDimValue(dim)) {
+      count *= dim.dim_value();
+    } else if (utils::HasDimParam(dim)) {
+      auto it = memory_budget.dim_values.find(dim.dim_param());
+      if (it != memory_budget.dim_values.end()) {
+        count *= it->second;
+      }
+    }
+  }
+  return count;
+}
+
+int64_t GetByteCount(const NodeArg& node_arg, const MemoryBudget& memory_budget) {
+  MLDataType ml_data_type = DataTypeImpl::TypeFromProto(*node_arg.TypeAsProto());
+  if (!ml_data_type->IsTensorType()) {
+    return 0;
+  }
+  const int64_t byte_count_per_element = static_cast<int64_t>(ml_data_type->AsTensorType()->GetElementType()->Size());
+  return GetElementCount(node_arg, memory_budget) * byte_count_per_element;
+}
+
+// The bytes of stashed activations a recompute plan saves, following NodeRecomputePlan::GetMemorySavingSymbolicString.
+int64_t GetSavedBytes(const NodeRecomputePlan& plan, const MemoryBudget& memory_budget) {
+  const auto& subgraph_nodes = plan.GetNodesInTopoOrder();
+  int64_t saved_bytes = 0;
+  for (auto output_index : plan.GetActivationOutputIndices()) {
+    auto reused = plan.reuse_buffers.find(output_index);
+    if (reused != plan.reuse_buffers.end() &&
+        std::find(subgraph_nodes.begin(), subgraph_nodes.end(), reused->second.first) == subgraph_nodes.end()) {
+      continue;
+    }
+    saved_bytes += static_cast<int64_t>(
+        static_cast<float>(GetByteCount(*plan.node->OutputDefs()[output_index], memory_budget)) *
+        plan.GetSaveRatio());
+  }
+  return saved_bytes;
+}
+
+// The cost of recomputing a subgraph, approximated with the element count of the outputs of its nodes.
+int64_t GetRecomputeCost(const NodeRecomputePlan& plan, const MemoryBudget& memory_budget) {
+  int64_t cost = 0;
+  for (const Node* node : plan.GetNodesInTopoOrder()) {
+    for (const NodeArg* output : node->OutputDefs()) {
+      if (output->Exists()) {
+        cost += GetElementCount(*output, memory_budget);
+      }
+    }
+  }
+  return std::max<int64_t>(cost, 1);
+}
+
+}  // namespace
+
 Status MemoryOptimizationPlanner::UpdateNodePlansFromExecutionPlan(
     const GraphViewer& graph_viewer,
     const OrtValueNameIdxMap& ortvalue_name_to_idx_map,
@@ -109,4 +178,103 @@ Status MemoryOptimizationPlanner::FinalizeNodePlansFromUserConfig(
   return Status::OK();
 }
 
+Status MemoryOptimizationPlanner::FinalizeNodePlansFromMemoryBudget(
+    const MemoryBudget& memory_budget,
+    const logging::Logger& logger,
+    InlinedHashMap<const Node*, std::shared_ptr<NodeOptimizationPlanBase>>& node_to_opt_plan_map,
+    NodeToClusterApplyContextMap& node_to_apply_context_map) const {
+  if (!memory_budget.IsEnabled()) {
+    return Status::OK();
+  }
+
+  struct Candidate {
+    const Node* node;
+    std::shared_ptr<NodeOptimizationPlanBase> plan;
+    int64_t saved_bytes;
+    int64_t cost;
+  };
+
+  int64_t stashed_bytes = 0;
+  std::vector<Candidate> candidates;
+  for (const auto& [node, node_plans] : node_to_optimization_plans_map) {
+    // the activations of the node are stashed unless they reuse the buffer of another node
+    const auto& activation_indices = node_plans.front()->GetActivationOutputIndices();
+    for (auto output_index : activation_indices) {
+      if (node_plans.front()->reuse_buffers.find(output_index) == node_plans.front()->reuse_buffers.end()) {
+        stashed_bytes += GetByteCount(*node->OutputDefs()[output_index], memory_budget);
+      }
+    }
+
+    // keep the plan of the node saving the most bytes per recomputed element
+    std::optional<Candidate> best;
+    for (const auto& node_plan : node_plans) {
+      const auto* recompute_plan = dynamic_cast<const NodeRecomputePlan*>(node_plan.get());
+      if (recompute_plan == nullptr) {
+        continue;
+      }
+      Candidate candidate{node, node_plan, GetSavedBytes(*recompute_plan, memory_budget),
+                          GetRecomputeCost(*recompute_plan, memory_budget)};
+      if (candidate.saved_bytes <= 0) {
+        continue;
+      }
+      if (!best.has_value() ||
+          static_cast<double>(candidate.saved_bytes) / candidate.cost >
+              static_cast<double>(best->saved_bytes) / best->cost) {
+        best = candidate;
+      }
+    }
+    if (best.has_value()) {
+      candidates.push_back(*best);
+    }
+  }
+
+  // greedy fractional knapsack: the best ratio first, until the stashed activations fit in the budget.
+  // ties are broken by the saving, then by the node index to be deterministic.
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+    const double ratio_a = static_cast<double>(a.saved_bytes) / a.cost;
+    const double ratio_b = static_cast<double>(b.saved_bytes) / b.cost;
+    if (ratio_a != ratio_b) {
+      return ratio_a > ratio_b;
+    }
+    if (a.saved_bytes != b.saved_bytes) {
+      return a.saved_bytes > b.saved_bytes;
+    }
+    return a.node->Index() < b.node->Index();
+  });
+
+  InlinedHashMap<std::string, std::shared_ptr<ClusterApplyContext>> cluster_id_to_apply_contexts_map;
+  int64_t remaining_bytes = stashed_bytes;
+  int64_t recompute_cost = 0;
+  for (const auto& candidate : candidates) {
+    if (remaining_bytes <= memory_budget.budget_bytes) {
+      break;
+    }
+
+    node_to_opt_plan_map[candidate.node] = candidate.plan;
+    const std::string cluster_id = candidate.plan->GetClusterId();
+    auto& apply_context = cluster_id_to_apply_contexts_map[cluster_id];
+    if (apply_context == nullptr) {
+      apply_context = std::make_shared<ClusterApplyContext>();
+      apply_context->type = candidate.plan->GetOptimizationType();
+      apply_context->requested_count = -1;
+    }
+    apply_context->total_frequency++;
+    node_to_apply_context_map[candidate.node] = apply_context;
+
+    remaining_bytes -= candidate.saved_bytes;
+    recompute_cost += candidate.cost;
+  }
+
+  LOGS(logger, INFO) << "Memory budget " << memory_budget.budget_bytes << " bytes, stashed activations "
+                     << stashed_bytes << " bytes, " << node_to_opt_plan_map.size()
+                     << " recompute plan(s) picked, recomputing " << recompute_cost << " elements, leaving "
+                     << remaining_bytes << " bytes.";
+  if (remaining_bytes > memory_budget.budget_bytes) {
+    LOGS(logger, WARNING) << "The memory budget cannot be met with recompute, " << remaining_bytes
+                          << " bytes of activations are still stashed.";
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime::optimizer::memory_optimizer
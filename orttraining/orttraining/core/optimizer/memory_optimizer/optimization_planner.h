@@ -124,6 +124,17 @@ class MemoryOptimizationPlanner {
       InlinedHashMap<const Node*, std::shared_ptr<NodeOptimizationPlanBase>>& node_to_opt_plan_map,
       NodeToClusterApplyContextMap& node_to_apply_context_map) const;
 
+  /**
+   * Pick the recompute plans from a memory budget instead of a user config. The stashed activations are sized with
+   * the budget's dim values, and the plans saving the most bytes per recomputed element are picked until the
+   * remaining stashed activations fit in the budget. Each node gets at most one plan.
+   */
+  Status FinalizeNodePlansFromMemoryBudget(
+      const MemoryBudget& memory_budget,
+      const logging::Logger& logger,
+      InlinedHashMap<const Node*, std::shared_ptr<NodeOptimizationPlanBase>>& node_to_opt_plan_map,
+      NodeToClusterApplyContextMap& node_to_apply_context_map) const;
+
   std::string GenerateNodeClusterId(const Node* node) const {
     ORT_ENFORCE(node_to_optimization_plans_map.find(node) != node_to_optimization_plans_map.end(),
                 "Node not found in node_to_optimization_plans_map.");
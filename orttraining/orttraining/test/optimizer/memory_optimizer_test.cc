@@ -101,6 +101,44 @@ TEST(MemoryOptimizerTests, GeluRecompute) {
   ASSERT_EQ(recompute_gelu_node->MutableInputDefs()[0]->Name(), original_gelu_node->MutableInputDefs()[0]->Name());
 }
 
+TEST(MemoryOptimizerTests, GeluRecomputeFromMemoryBudget) {
+  const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
+  auto model_uri = MODEL_FOLDER "recompute_gelu.onnx";
+
+  // a budget of 0 recomputes every stashed activation that can be recomputed, a large one recomputes nothing.
+  for (const auto& [memory_budget, expected_gelu_count] :
+       std::vector<std::pair<std::string, int>>{{"0", 2}, {"1048576", 1}}) {
+    std::shared_ptr<Model> model;
+    ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger));
+    Graph& graph = model->MainGraph();
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+    const std::string probe_config("1:0");
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<MemoryOptimizer>("", probe_config, memory_budget), TransformerLevel::Level3));
+
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3, *logger));
+
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    ASSERT_EQ(op_to_count["com.microsoft.Gelu"], expected_gelu_count) << "memory budget " << memory_budget;
+    ASSERT_EQ(op_to_count["Gemm"], 5);
+  }
+}
+
+TEST(MemoryOptimizerTests, ParseMemoryBudget) {
+  optimizer::memory_optimizer::MemoryBudget memory_budget;
+  ASSERT_STATUS_OK(optimizer::memory_optimizer::ParseMemoryBudgetFromString("", memory_budget));
+  ASSERT_FALSE(memory_budget.IsEnabled());
+
+  ASSERT_STATUS_OK(optimizer::memory_optimizer::ParseMemoryBudgetFromString("16:batch=8,sequence=512", memory_budget));
+  ASSERT_EQ(memory_budget.budget_bytes, 16 * 1024 * 1024);
+  ASSERT_EQ(memory_budget.dim_values.size(), 2u);
+  ASSERT_EQ(memory_budget.dim_values["batch"], 8);
+  ASSERT_EQ(memory_budget.dim_values["sequence"], 512);
+
+  ASSERT_FALSE(optimizer::memory_optimizer::ParseMemoryBudgetFromString("16:batch", memory_budget).IsOK());
+}
+
 TEST(MemoryOptimizerTests, TileRecompute) {
   const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
   auto model_uri = MODEL_FOLDER "recompute_tile.onnx";
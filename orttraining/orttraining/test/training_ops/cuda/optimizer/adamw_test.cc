@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <fstream>
 
 #include "gtest/gtest.h"
@@ -361,6 +362,82 @@ TEST(AdamWTest, HFAdamWMultipleWeightsStrictTest_Loop10Steps) {
   HFAdamWMultipleWeightsTestLoop10Steps(true);
 }
 
+// Float master weights updated with bfloat16 gradients, the updated weights are also written to their bfloat16 copies.
+// One of the weights is larger than a chunk, so it is updated by several tasks.
+void TorchAdamWBF16CopyTest(ExecutionProviderCreationFunc execution_provider_creator) {
+  const float lr = 1e-03f, alpha = 0.9f, beta = 0.999f, epsilon = 1e-8f, weight_decay = 1e-2f;
+  const int64_t step = 3;
+  const std::vector<VectorInt64> shapes{{2, 3}, {70000}};
+
+  OpTester test("AdamWOptimizer", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("alpha", alpha);
+  test.AddAttribute("beta", beta);
+  test.AddAttribute("epsilon", epsilon);
+  test.AddAttribute("weight_decay", weight_decay);
+  test.AddAttribute("adam_mode", static_cast<int64_t>(0));
+  test.AddAttribute("correct_bias", static_cast<int64_t>(1));
+
+  SeqTensors<float> weights, momentums_1, momentums_2, updated_weights, updated_momentums_1, updated_momentums_2;
+  SeqTensors<BFloat16> gradients, weights_bf16, updated_weights_bf16;
+  const float alpha_correction = 1.f - static_cast<float>(std::pow(alpha, step));
+  const float beta_correction = 1.f - static_cast<float>(std::pow(beta, step));
+  for (const auto& shape : shapes) {
+    const size_t size = static_cast<size_t>(shape[0] * (shape.size() > 1 ? shape[1] : 1));
+    std::vector<float> w(size), m1(size), m2(size), w_out(size), m1_out(size), m2_out(size);
+    std::vector<BFloat16> g(size), w_bf16(size), w_bf16_out(size);
+    for (size_t i = 0; i < size; ++i) {
+      w[i] = static_cast<float>(static_cast<int>(i % 17) - 8) * 0.0625f;
+      g[i] = BFloat16(static_cast<float>(static_cast<int>(i % 11) - 5) * 0.125f);
+      m1[i] = static_cast<float>(i % 5) * 0.01f;
+      m2[i] = static_cast<float>(i % 3) * 0.001f;
+      w_bf16[i] = BFloat16(w[i]);
+
+      const float grad = g[i].ToFloat();
+      float weight = w[i] - w[i] * lr * weight_decay;
+      m1_out[i] = alpha * m1[i] + (1.f - alpha) * grad;
+      m2_out[i] = beta * m2[i] + (1.f - beta) * grad * grad;
+      const float denom = std::sqrt(m2_out[i] / beta_correction) + epsilon;
+      w_out[i] = weight - (lr * m1_out[i]) / (alpha_correction * denom);
+      w_bf16_out[i] = BFloat16(w_out[i]);
+    }
+    weights.AddTensor(shape, w);
+    gradients.AddTensor(shape, g);
+    momentums_1.AddTensor(shape, m1);
+    momentums_2.AddTensor(shape, m2);
+    weights_bf16.AddTensor(shape, w_bf16);
+    updated_weights.AddTensor(shape, w_out);
+    updated_momentums_1.AddTensor(shape, m1_out);
+    updated_momentums_2.AddTensor(shape, m2_out);
+    updated_weights_bf16.AddTensor(shape, w_bf16_out);
+  }
+
+  test.AddInput<float>("lr", {}, {lr});
+  test.AddInput<int64_t>("step", {}, {step});
+  test.AddSeqInput("weights", weights);
+  test.AddSeqInput("gradients", gradients);
+  test.AddSeqInput("momentums_1", momentums_1);
+  test.AddSeqInput("momentums_2", momentums_2);
+  test.AddOptionalInputEdge<bool>();
+  test.AddSeqInput("weights_bf16", weights_bf16);
+
+  test.AddOutput<bool>("updated_flag", {}, {1});
+  test.AddSeqOutput("updated_weights", updated_weights, 1e-4f, 1e-5f);
+  test.AddSeqOutput("updated_momentums_1", updated_momentums_1, 1e-3f, 1e-6f);
+  test.AddSeqOutput("updated_momentums_2", updated_momentums_2, 1e-3f, 1e-6f);
+  test.AddSeqOutput("updated_weights_bf16", updated_weights_bf16, 1e-2f, 1e-3f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(execution_provider_creator());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(AdamWTest, TorchAdamWBF16CopyTest) {
+  TorchAdamWBF16CopyTest([]() -> std::unique_ptr<IExecutionProvider> { return DefaultCpuExecutionProvider(); });
+#if USE_CUDA
+  TorchAdamWBF16CopyTest([]() -> std::unique_ptr<IExecutionProvider> { return DefaultCudaExecutionProvider(); });
+#endif
+}
+
 }  // namespace
 
 }  // namespace optimizer
@@ -3,11 +3,14 @@
 
 #include "orttraining/training_api/checkpoint.h"
 
+#include <cstring>
+
 #include "core/flatbuffers/checkpoint_version.h"
 #include "core/flatbuffers/schema/ort_training_checkpoint.fbs.h"
 #include "core/framework/framework_common.h"
 #include "core/graph/graph_flatbuffers_utils.h"
 #include "core/framework/tensor_external_data_info.h"
+#include "core/platform/env.h"
 
 namespace onnxruntime::training::api {
 
@@ -18,19 +21,40 @@ PathString ExternalCheckpointDataPath(const PathString& checkpoint_path) {
 namespace {
 
 /**
- * @brief Helper method to read data from an external file.
- * @param external_data_stream Stream that data will be read from.
+ * @brief Helper method to read data from an external file mapped into memory.
+ * @param external_data Contents of the external data file.
  * @param offset Offset in the external data file to begin reading from.
  * @param output_buffer Buffer to store the read data.
  * @return Status of the operation.
  */
-Status ReadFromExternalFileHelper(std::ifstream& external_data_stream,
+Status ReadFromExternalFileHelper(gsl::span<const uint8_t> external_data,
                                   uint64_t offset, gsl::span<uint8_t> output_buffer) {
-  external_data_stream.seekg(offset);
-  external_data_stream.read(reinterpret_cast<char*>(output_buffer.data()), output_buffer.size());
+  ORT_RETURN_IF(offset > external_data.size() || output_buffer.size() > external_data.size() - offset,
+                "Failed reading external checkpoint data. Offset ", offset, " and size ", output_buffer.size(),
+                " are out of the bounds of the external data file of size ", external_data.size(), ".");
+  std::memcpy(output_buffer.data(), external_data.data() + offset, output_buffer.size());
 
-  const auto [err, msg] = GetErrnoInfo();
-  ORT_RETURN_IF(external_data_stream.fail(), "Failed reading external checkpoint data. ", msg, " errno:", errno);
+  return Status::OK();
+}
+
+/**
+ * @brief Map a file into memory, so it is read by the loaders without a copy to a heap buffer.
+ * @param file_path Path of the file.
+ * @param mapped_memory Mapping of the file, unmapped when destructed.
+ * @param bytes Contents of the file.
+ * @return Status of the operation.
+ */
+Status MapFileHelper(const PathString& file_path, Env::MappedMemoryPtr& mapped_memory,
+                     gsl::span<const uint8_t>& bytes) {
+  size_t num_bytes = 0;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(file_path.c_str(), num_bytes));
+  bytes = {};
+  if (num_bytes == 0) {
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(file_path.c_str(), 0, num_bytes, mapped_memory));
+  bytes = gsl::make_span(reinterpret_cast<const uint8_t*>(mapped_memory.get()), num_bytes);
 
   return Status::OK();
 }
@@ -92,6 +116,55 @@ InlinedVector<std::string> SortedKeys(const T& hash_map) {
   return keys;
 }
 
+/**
+ * @brief Helper method to write the data of a device tensor to an external file, through a staging buffer.
+ *        The tensor is copied to the host and written in chunks, so a large tensor doesn't need a host buffer of
+ *        its size.
+ * @param src_tensor Device tensor to write.
+ * @param copy_tensor Function to copy a device tensor to a cpu buffer.
+ * @param data_type data type to write -- used to determine alignment.
+ * @param external_data_writer Delegate writing to the external file. The chunks are written back to back.
+ * @param offset Modified to be the offset in the external data file where the data was written.
+ * @return Status of the operation.
+ */
+Status WriteDeviceTensorToExternalFileHelper(
+    const onnxruntime::Tensor& src_tensor,
+    const std::function<Status(const onnxruntime::Tensor& src_tensor, onnxruntime::Tensor& dst_tensor)>& copy_tensor,
+    int32_t data_type, const fbs::utils::ExternalDataWriter& external_data_writer, uint64_t& offset) {
+  // A multiple of the alignment of the external data, so no padding is added between the chunks.
+  constexpr size_t kStagingBufferSize = 64 * 1024 * 1024;
+
+  const size_t total_bytes = src_tensor.SizeInBytes();
+  InlinedVector<uint8_t> staging_buffer(std::min(total_bytes, kStagingBufferSize));
+  const OrtMemoryInfo cpu_alloc_info{onnxruntime::CPU, OrtDeviceAllocator};
+  auto* src_data = static_cast<uint8_t*>(const_cast<void*>(src_tensor.DataRaw()));
+
+  offset = 0;
+  size_t chunk_start = 0;
+  do {
+    const size_t chunk_bytes = std::min(staging_buffer.size(), total_bytes - chunk_start);
+    const TensorShape chunk_shape({static_cast<int64_t>(chunk_bytes)});
+    const onnxruntime::Tensor src_chunk{DataTypeImpl::GetType<uint8_t>(), chunk_shape, src_data + chunk_start,
+                                        src_tensor.Location()};
+    onnxruntime::Tensor dst_chunk{DataTypeImpl::GetType<uint8_t>(), chunk_shape, staging_buffer.data(),
+                                  cpu_alloc_info};
+    ORT_RETURN_IF_ERROR(copy_tensor(src_chunk, dst_chunk));
+
+    uint64_t chunk_offset = 0;
+    ORT_RETURN_IF_ERROR(external_data_writer(data_type, gsl::make_span(staging_buffer.data(), chunk_bytes),
+                                             chunk_offset));
+    if (chunk_start == 0) {
+      offset = chunk_offset;
+    } else {
+      ORT_RETURN_IF_NOT(chunk_offset == offset + chunk_start,
+                        "Failed writing external checkpoint data. The chunks of a tensor are not contiguous.");
+    }
+    chunk_start += chunk_bytes;
+  } while (chunk_start < total_bytes);
+
+  return Status::OK();
+}
+
 /**
  * @brief Create flatbuffer tensor from OrtValue object
  *
@@ -115,7 +188,16 @@ Status FlatbufferTensorFromOrtValue(
 
   // Check if the tensor is on CPU. If not, we need to copy the tensor to CPU before saving it.
   if (const auto& tensor_location = src_tensor.Location();
-      tensor_location.device.Type() != OrtDevice::CPU) {
+      tensor_location.device.Type() != OrtDevice::CPU && external_data_writer) {
+    // The data goes to the external data file, so it is streamed from the device through a bounded staging buffer
+    // instead of copying the whole tensor to the host.
+    const auto staged_external_data_writer = [&](int32_t data_type, gsl::span<const uint8_t> /*device_bytes*/,
+                                                 uint64_t& offset) {
+      return WriteDeviceTensorToExternalFileHelper(src_tensor, copy_tensor, data_type, external_data_writer, offset);
+    };
+    ORT_RETURN_IF_ERROR(
+        fbs::utils::SaveOrtTensorOrtFormat(tensor_name, src_tensor, builder, fbs_tensor, staged_external_data_writer));
+  } else if (tensor_location.device.Type() != OrtDevice::CPU) {
     InlinedVector<uint8_t> tensor_data_buffer{};
     tensor_data_buffer.resize(src_tensor.SizeInBytes());
     const OrtMemoryInfo cpu_alloc_info{onnxruntime::CPU, OrtDeviceAllocator};
@@ -438,11 +520,13 @@ Status FromModuleState(const ModuleCheckpointState& module_state,
  *                        and second order momentums ...).
  * @param builder Flatbuffer builder.
  * @param fbs_optimizer_groups Flatbuffer optimizer groups to be populated.
+ * @param external_data_writer Optional delegate to write tensor data to an external file.
  * @return Status of the operation.
  */
 Status FromOptimizerState(const OptimizerCheckpointState& optimizer_state,
                           flatbuffers::FlatBufferBuilder& builder,
-                          std::vector<flatbuffers::Offset<fbs::OptimizerGroup>>& fbs_optimizer_groups) {
+                          std::vector<flatbuffers::Offset<fbs::OptimizerGroup>>& fbs_optimizer_groups,
+                          fbs::utils::ExternalDataWriter external_data_writer = nullptr) {
   if (optimizer_state.group_named_optimizer_states.empty()) {
     return Status::OK();
   }
@@ -462,7 +546,7 @@ Status FromOptimizerState(const OptimizerCheckpointState& optimizer_state,
       ORT_RETURN_IF_ERROR(FlatbufferTensorsFromOrtValues(
           param_optimizer_state,
           optimizer_state.optimizer_session_data_transfer_mgr,
-          builder, momentums));
+          builder, momentums, external_data_writer));
 
       const auto fbs_param_name = builder.CreateString(param_name);
       const auto fbs_momentums = builder.CreateVector(momentums);
@@ -581,7 +665,11 @@ Status FromCheckpointState(
   // Write optimizer state tensors files.
   std::vector<flatbuffers::Offset<fbs::OptimizerGroup>> optimizer_groups;
   if (include_optimizer_state) {
-    ORT_RETURN_IF_ERROR(FromOptimizerState(state.optimizer_checkpoint_state, builder, optimizer_groups));
+    // The momentums go to the external data file as well. The loader only reads the file when the module state has
+    // external data, which it has when it has parameters.
+    ORT_RETURN_IF_ERROR(FromOptimizerState(
+        state.optimizer_checkpoint_state, builder, optimizer_groups,
+        state.module_checkpoint_state.named_parameters.empty() ? nullptr : external_data_writer));
   }
 
   flatbuffers::Offset<fbs::PropertyBag> property_bag;
@@ -605,23 +693,18 @@ Status FromCheckpointState(
 namespace load {
 
 /**
- * @brief Load checkpoint flatbuffer from file.
+ * @brief Load checkpoint flatbuffer from file. The file is mapped into memory rather than read into a buffer.
  * @param checkpoint_path Path to the checkpoint file.
+ * @param checkpoint_memory Mapping of the checkpoint file, which must outlive the use of checkpoint_bytes.
  * @param checkpoint_bytes Contents of the checkpoint file in bytes.
- * @param checkpoint_span Checkpoint bytes represented as a span.
  * @return Status of the operation.
  *
  */
-Status FromFile(const PathString& checkpoint_path, InlinedVector<uint8_t>& checkpoint_bytes) {
-  size_t num_bytes = 0;
-  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(checkpoint_path.c_str(), num_bytes));
-  checkpoint_bytes.resize(num_bytes);
-
-  std::ifstream bytes_stream(checkpoint_path, std::ifstream::in | std::ifstream::binary);
-  bytes_stream.read(reinterpret_cast<char*>(checkpoint_bytes.data()), num_bytes);
-
-  ORT_RETURN_IF_NOT(bytes_stream, "Loading checkpoint from ", ToUTF8String(checkpoint_path), " failed. Only ",
-                    bytes_stream.gcount(), "/", num_bytes, " bytes could be read.");
+Status FromFile(const PathString& checkpoint_path, Env::MappedMemoryPtr& checkpoint_memory,
+                gsl::span<const uint8_t>& checkpoint_bytes) {
+  ORT_RETURN_IF_ERROR(MapFileHelper(checkpoint_path, checkpoint_memory, checkpoint_bytes));
+  ORT_RETURN_IF(checkpoint_bytes.empty(), "Loading checkpoint from ", ToUTF8String(checkpoint_path),
+                " failed. The file is empty.");
 
   return Status::OK();
 }
@@ -806,16 +889,17 @@ Status ToModelProto(gsl::span<const uint8_t> checkpoint_bytes,
                 "Expected: Complete checkpoint. Actual: Nominal checkpoint.");
 
   fbs::utils::ExternalDataReader external_data_reader = nullptr;
-  std::optional<std::ifstream> external_data_stream;
+  Env::MappedMemoryPtr external_data_memory;
+  gsl::span<const uint8_t> external_data;
 
   if (module_state->has_external_data()) {
     auto data_path = ExternalCheckpointDataPath(checkpoint_path);
-    external_data_stream = std::ifstream(data_path, std::ios::binary);
-    ORT_RETURN_IF(external_data_stream->fail(),
-                  "Failed to open checkpoint's external data file: ", ToUTF8String(data_path));
+    const Status status = MapFileHelper(data_path, external_data_memory, external_data);
+    ORT_RETURN_IF_NOT(status.IsOK(), "Failed to open checkpoint's external data file: ", ToUTF8String(data_path),
+                      " ", status.ErrorMessage());
 
-    external_data_reader = [&external_data_stream](uint64_t offset, gsl::span<uint8_t> output_buffer) {
-      return ReadFromExternalFileHelper(external_data_stream.value(), offset, output_buffer);
+    external_data_reader = [&external_data](uint64_t offset, gsl::span<uint8_t> output_buffer) {
+      return ReadFromExternalFileHelper(external_data, offset, output_buffer);
     };
   }
 
@@ -876,7 +960,8 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
   const auto* fbs_module_state = fbs_checkpoint->module_state();
 
   fbs::utils::ExternalDataReader external_data_reader = nullptr;
-  std::optional<std::ifstream> external_data_stream;
+  Env::MappedMemoryPtr external_data_memory;
+  gsl::span<const uint8_t> external_data;
 
   state.has_external_data = false;
   if (nullptr != fbs_module_state && fbs_module_state->has_external_data()) {
@@ -884,17 +969,14 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
     ORT_RETURN_IF_NOT(checkpoint_path.has_value(),
                       "External data is present in the checkpoint but the checkpoint path is not provided. External data with loading from buffer is not supported yet.");
     auto data_path = ExternalCheckpointDataPath(*checkpoint_path);
-    external_data_stream = std::ifstream(data_path, std::ios::binary);
-
-    if (external_data_stream.value().fail()) {
-      const auto [err, errmsg] = GetErrnoInfo();
+    if (const Status status = MapFileHelper(data_path, external_data_memory, external_data); !status.IsOK()) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                              "Failed to open checkpoint's external data file: ", ToUTF8String(data_path),
-                             " error:", errmsg, " errno:", err);
+                             " error:", status.ErrorMessage());
     }
 
-    external_data_reader = [&external_data_stream](uint64_t offset, gsl::span<uint8_t> output_buffer) {
-      return ReadFromExternalFileHelper(external_data_stream.value(), offset, output_buffer);
+    external_data_reader = [&external_data](uint64_t offset, gsl::span<uint8_t> output_buffer) {
+      return ReadFromExternalFileHelper(external_data, offset, output_buffer);
     };
   }
 
@@ -957,8 +1039,9 @@ Status SaveCheckpoint(const CheckpointState& states, const PathString& checkpoin
 Status LoadCheckpoint(const PathString& checkpoint_path, CheckpointState& checkpoint_states) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
 
-  InlinedVector<uint8_t> checkpoint_bytes;
-  ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, checkpoint_bytes));
+  Env::MappedMemoryPtr checkpoint_memory;
+  gsl::span<const uint8_t> checkpoint_bytes;
+  ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, checkpoint_memory, checkpoint_bytes));
   return load::ToCheckpointState(checkpoint_bytes, checkpoint_states, checkpoint_path);
 }
 
@@ -973,8 +1056,9 @@ Status LoadCheckpointToModel(const PathString& checkpoint_path,
                              ONNX_NAMESPACE::ModelProto& model_proto) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
 
-  InlinedVector<uint8_t> checkpoint_bytes;
-  ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, checkpoint_bytes));
+  Env::MappedMemoryPtr checkpoint_memory;
+  gsl::span<const uint8_t> checkpoint_bytes;
+  ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, checkpoint_memory, checkpoint_bytes));
   return load::ToModelProto(checkpoint_bytes, model_proto, checkpoint_path);
 }
 #endif
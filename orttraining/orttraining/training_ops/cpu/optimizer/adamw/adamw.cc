@@ -1,6 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 #include "orttraining/training_ops/cpu/optimizer/adamw/adamw.h"
 #include "orttraining/training_ops/cpu/optimizer/common.h"
 #include "core/framework/op_kernel.h"
@@ -13,6 +18,11 @@
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+// Count of elements updated by a task of the thread pool.
+constexpr int kAdamWChunkSize = 2048 * 32;
+}  // namespace
+
 Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimizerBase::Prepare& prepare) const {
   prepare.learning_rate = ctx->Input<Tensor>(0);
   prepare.step = ctx->Input<Tensor>(1);
@@ -20,6 +30,7 @@ Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimize
   prepare.gradients = ctx->Input<TensorSeq>(3);
   prepare.momentums_1 = ctx->Input<TensorSeq>(4);
   prepare.momentums_2 = ctx->Input<TensorSeq>(5);
+  prepare.weights_bf16 = ctx->Input<TensorSeq>(7);
 
   prepare.num_of_weights = prepare.weights->Size();
   size_t num_of_gradients = prepare.gradients->Size();
@@ -31,6 +42,17 @@ Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimize
   ORT_RETURN_IF_NOT(prepare.num_of_weights == num_of_gradients, "Number of weights and gradients mismatch.");
   ORT_RETURN_IF_NOT(num_of_gradients == num_of_momentums_1, "Number of gradients and momentums_1 mismatch.");
   ORT_RETURN_IF_NOT(num_of_momentums_1 == num_of_momentums_2, "Number of momentums_1 and momentums_2 mismatch.");
+  ORT_RETURN_IF_NOT(prepare.weights_bf16 == nullptr || prepare.weights_bf16->Size() == prepare.num_of_weights,
+                    "Number of weights and weights_bf16 mismatch.");
+
+  // Weights and momentums are float, gradients are float or bfloat16 when computed by a bfloat16 model.
+  ORT_RETURN_IF_NOT(prepare.weights->DataType() == DataTypeImpl::GetType<float>() &&
+                        prepare.momentums_1->DataType() == DataTypeImpl::GetType<float>() &&
+                        prepare.momentums_2->DataType() == DataTypeImpl::GetType<float>(),
+                    "Weights and momentums must be float.");
+  prepare.gradients_are_bf16 = prepare.gradients->DataType() == DataTypeImpl::GetType<BFloat16>();
+  ORT_RETURN_IF_NOT(prepare.gradients_are_bf16 || prepare.gradients->DataType() == DataTypeImpl::GetType<float>(),
+                    "Gradients must be float or bfloat16.");
 
   prepare.grouped_tensor_sizes.resize(prepare.num_of_weights);
   prepare.grouped_tensor_pointers.resize(prepare.num_of_weights);
@@ -59,9 +81,16 @@ Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimize
 
           prepare.grouped_tensor_pointers[i] = {
               const_cast<float*>(weight_tensor.Data<float>()),
-              const_cast<float*>(gradient_tensor.Data<float>()),
+              const_cast<void*>(gradient_tensor.DataRaw()),
               const_cast<float*>(momentum_1_tensor.Data<float>()),
               const_cast<float*>(momentum_2_tensor.Data<float>())};
+
+          if (prepare.weights_bf16 != nullptr) {
+            const Tensor& weight_bf16_tensor = prepare.weights_bf16->Get(i);
+            ORT_ENFORCE(weight_tensor.Shape() == weight_bf16_tensor.Shape(),
+                        "Shape of weight and weight_bf16 mismatch, weight index:", i);
+            prepare.grouped_tensor_pointers[i].push_back(const_cast<BFloat16*>(weight_bf16_tensor.Data<BFloat16>()));
+          }
         }
       });
 
@@ -69,6 +98,7 @@ Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimize
   prepare.updated_weights = ctx->Output<TensorSeq>(1);
   prepare.updated_momentums_1 = ctx->Output<TensorSeq>(2);
   prepare.updated_momentums_2 = ctx->Output<TensorSeq>(3);
+  prepare.updated_weights_bf16 = ctx->Output<TensorSeq>(4);
 
   return Status::OK();
 }
@@ -82,54 +112,84 @@ ONNX_OPERATOR_KERNEL_EX(
         .Alias(2, 1) /* Return updated weights in-place */
         .Alias(4, 2) /* Return updated moment-1 in-place */
         .Alias(5, 3) /* Return updated moment-2 in-place */
+        .Alias(7, 4) /* Return updated bfloat16 weight copies in-place */
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
         .TypeConstraint("T2", DataTypeImpl::GetTensorType<int64_t>())
         .TypeConstraint("S_WEIGHT", DataTypeImpl::AllFixedSizeSequenceTensorTypes())
         .TypeConstraint("S_GRAD", DataTypeImpl::AllFixedSizeSequenceTensorTypes())
-        .TypeConstraint("S_MOMENT", DataTypeImpl::AllFixedSizeSequenceTensorTypes()),
+        .TypeConstraint("S_MOMENT", DataTypeImpl::AllFixedSizeSequenceTensorTypes())
+        .TypeConstraint("S_WEIGHT_BF16", DataTypeImpl::GetSequenceTensorType<BFloat16>()),
     AdamWOptimizer<float>);
 
 template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode0(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float alpha_correction, float beta_correction) const {
-  // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (MakeEigenArrayMap<T>(weight) * lr * weight_decay_);
-
-  // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
-
-  // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
-
-  // Compute the new weight.
-  auto denom = (MakeEigenArrayMap<T>(momentums_2) / beta_correction).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr * MakeEigenArrayMap<T>(momentums_1)) / (alpha_correction * denom);
-
-  return Status::OK();
+template <typename T_GRAD>
+void AdamWOptimizer<T>::AdamWComputeMode0(const std::vector<void*>& tensor_pointers, int begin, int end, float lr,
+                                          float alpha_correction, float beta_correction) const {
+  T* weight = static_cast<T*>(tensor_pointers[0]);
+  const T_GRAD* gradient = static_cast<const T_GRAD*>(tensor_pointers[1]);
+  T* momentum_1 = static_cast<T*>(tensor_pointers[2]);
+  T* momentum_2 = static_cast<T*>(tensor_pointers[3]);
+  BFloat16* weight_bf16 = tensor_pointers.size() > 4 ? static_cast<BFloat16*>(tensor_pointers[4]) : nullptr;
+
+  for (int i = begin; i < end; ++i) {
+    float w = static_cast<float>(weight[i]);
+    const float g = static_cast<float>(gradient[i]);
+
+    // Perform weight decay.
+    w = w - (w * lr * weight_decay_);
+
+    // Compute exponentially-averaged historical gradient.
+    const float m1 = alpha_ * static_cast<float>(momentum_1[i]) + (1.f - alpha_) * g;
+
+    // Compute exponentially-averaged historical squared gradient.
+    const float m2 = beta_ * static_cast<float>(momentum_2[i]) + (1.f - beta_) * g * g;
+
+    // Compute the new weight.
+    const float denom = std::sqrt(m2 / beta_correction) + epsilon_;
+    w = w - (lr * m1) / (alpha_correction * denom);
+
+    weight[i] = static_cast<T>(w);
+    momentum_1[i] = static_cast<T>(m1);
+    momentum_2[i] = static_cast<T>(m2);
+    if (weight_bf16 != nullptr) {
+      weight_bf16[i] = BFloat16(w);
+    }
+  }
 }
 
 template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode1(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float lr_corrected) const {
-  // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
-
-  // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
-
-  auto denom = MakeEigenArrayMap<T>(momentums_2).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr_corrected * MakeEigenArrayMap<T>(momentums_1) / denom);
-
-  // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (lr * weight_decay_ * MakeEigenArrayMap<T>(weight));
-
-  return Status::OK();
+template <typename T_GRAD>
+void AdamWOptimizer<T>::AdamWComputeMode1(const std::vector<void*>& tensor_pointers, int begin, int end, float lr,
+                                          float lr_corrected) const {
+  T* weight = static_cast<T*>(tensor_pointers[0]);
+  const T_GRAD* gradient = static_cast<const T_GRAD*>(tensor_pointers[1]);
+  T* momentum_1 = static_cast<T*>(tensor_pointers[2]);
+  T* momentum_2 = static_cast<T*>(tensor_pointers[3]);
+  BFloat16* weight_bf16 = tensor_pointers.size() > 4 ? static_cast<BFloat16*>(tensor_pointers[4]) : nullptr;
+
+  for (int i = begin; i < end; ++i) {
+    float w = static_cast<float>(weight[i]);
+    const float g = static_cast<float>(gradient[i]);
+
+    // Compute exponentially-averaged historical gradient.
+    const float m1 = alpha_ * static_cast<float>(momentum_1[i]) + (1.f - alpha_) * g;
+
+    // Compute exponentially-averaged historical squared gradient.
+    const float m2 = beta_ * static_cast<float>(momentum_2[i]) + (1.f - beta_) * g * g;
+
+    const float denom = std::sqrt(m2) + epsilon_;
+    w = w - (lr_corrected * m1 / denom);
+
+    // Perform weight decay.
+    w = w - (lr * weight_decay_ * w);
+
+    weight[i] = static_cast<T>(w);
+    momentum_1[i] = static_cast<T>(m1);
+    momentum_2[i] = static_cast<T>(m2);
+    if (weight_bf16 != nullptr) {
+      weight_bf16[i] = BFloat16(w);
+    }
+  }
 }
 
 template <typename T>
@@ -165,23 +225,40 @@ Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
     //         bias correction is applied on learning rate, then use lr_corrected for subsequent computations.
     //         weight decay is applied after weight is updated.
 
+    // All the weights are split into chunks updated by a single parallel loop, like the multi-tensor-apply of the
+    // CUDA kernel, so a group of many small weights doesn't run a sequential pass per weight.
+    std::vector<std::pair<size_t, int>> chunks;  // weight index, start index of the chunk
     for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
-      Tensor& momentums_1 = const_cast<Tensor&>(p.momentums_1->Get(weight_index));
-      Tensor& momentums_2 = const_cast<Tensor&>(p.momentums_2->Get(weight_index));
-
-      if (adam_mode_ == 0) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode0(weight, gradient, momentums_1, momentums_2, lr, alpha_correction, beta_correction));
-      } else if (adam_mode_ == 1) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode1(weight, gradient, momentums_1, momentums_2, lr, lr_corrected));
-      } else {
-        ORT_THROW("Unsupported Adamw optimizer mode.");
+      for (int start = 0; start < p.grouped_tensor_sizes[weight_index]; start += kAdamWChunkSize) {
+        chunks.emplace_back(weight_index, start);
       }
     }
 
+    ORT_RETURN_IF_NOT(adam_mode_ == 0 || adam_mode_ == 1, "Unsupported Adamw optimizer mode.");
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(chunks.size()),
+        TensorOpCost{kAdamWChunkSize * 16.0, kAdamWChunkSize * 12.0, kAdamWChunkSize * 20.0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t chunk_index = first; chunk_index != last; ++chunk_index) {
+            const auto [weight_index, start] = chunks[chunk_index];
+            const std::vector<void*>& tensor_pointers = p.grouped_tensor_pointers[weight_index];
+            const int end = std::min(start + kAdamWChunkSize, p.grouped_tensor_sizes[weight_index]);
+            if (adam_mode_ == 0) {
+              if (p.gradients_are_bf16) {
+                AdamWComputeMode0<BFloat16>(tensor_pointers, start, end, lr, alpha_correction, beta_correction);
+              } else {
+                AdamWComputeMode0<T>(tensor_pointers, start, end, lr, alpha_correction, beta_correction);
+              }
+            } else {
+              if (p.gradients_are_bf16) {
+                AdamWComputeMode1<BFloat16>(tensor_pointers, start, end, lr, lr_corrected);
+              } else {
+                AdamWComputeMode1<T>(tensor_pointers, start, end, lr, lr_corrected);
+              }
+            }
+          }
+        });
+
     *updated_flag_ptr = true;
   } else {
     *updated_flag_ptr = false;
@@ -196,6 +273,9 @@ Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
   if (p.updated_momentums_2 != nullptr) {
     ORT_RETURN_IF_ERROR(CopyIfNotSameCPUBuffer(ctx, p.num_of_weights, p.momentums_2, p.updated_momentums_2));
   }
+  if (p.weights_bf16 != nullptr && p.updated_weights_bf16 != nullptr) {
+    ORT_RETURN_IF_ERROR(CopyIfNotSameCPUBuffer(ctx, p.num_of_weights, p.weights_bf16, p.updated_weights_bf16));
+  }
 
   return Status::OK();
 }
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/tensor/utils.h"
@@ -21,11 +23,13 @@ class AdamWOptimizer final : public OpKernel, public AdamWOptimizerBase {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  Status AdamWComputeMode0(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2, float lr,
-                           float alpha_correction,
-                           float beta_correction) const;
-  Status AdamWComputeMode1(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2, float lr,
-                           float lr_corrected) const;
+  // Update the elements [begin, end) of a weight, whose tensors are given as in Prepare::grouped_tensor_pointers.
+  template <typename T_GRAD>
+  void AdamWComputeMode0(const std::vector<void*>& tensor_pointers, int begin, int end, float lr,
+                         float alpha_correction, float beta_correction) const;
+  template <typename T_GRAD>
+  void AdamWComputeMode1(const std::vector<void*>& tensor_pointers, int begin, int end, float lr,
+                         float lr_corrected) const;
 };
 
 }  // namespace contrib
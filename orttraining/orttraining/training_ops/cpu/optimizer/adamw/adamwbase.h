@@ -20,8 +20,12 @@ class AdamWOptimizerBase {
     const TensorSeq* gradients;
     const TensorSeq* momentums_1;
     const TensorSeq* momentums_2;
+    // bfloat16 copies of the weights, weights are the float master weights when it is not null.
+    const TensorSeq* weights_bf16;
 
     size_t num_of_weights;
+    bool gradients_are_bf16;
+    // weight, gradient, momentum_1, momentum_2 and, if weights_bf16 is given, weight_bf16 of each weight.
     std::vector<int> grouped_tensor_sizes;
     std::vector<std::vector<void*>> grouped_tensor_pointers;
 
@@ -30,6 +34,7 @@ class AdamWOptimizerBase {
     TensorSeq* updated_weights;
     TensorSeq* updated_momentums_1;
     TensorSeq* updated_momentums_2;
+    TensorSeq* updated_weights_bf16;
   };
 
   AdamWOptimizerBase(const OpKernelInfo& info) {
@@ -24,11 +24,13 @@ ONNX_OPERATOR_KERNEL_EX(
         .Alias(2, 1) /* Return updated weights in-place */
         .Alias(4, 2) /* Return updated moment-1 in-place */
         .Alias(5, 3) /* Return updated moment-2 in-place */
+        .Alias(7, 4) /* Return updated bfloat16 weight copies in-place */
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
         .TypeConstraint("T2", DataTypeImpl::GetTensorType<int64_t>())
         .TypeConstraint("S_WEIGHT", DataTypeImpl::AllFixedSizeSequenceTensorTypes())
         .TypeConstraint("S_GRAD", DataTypeImpl::AllFixedSizeSequenceTensorTypes())
-        .TypeConstraint("S_MOMENT", DataTypeImpl::AllFixedSizeSequenceTensorTypes()),
+        .TypeConstraint("S_MOMENT", DataTypeImpl::AllFixedSizeSequenceTensorTypes())
+        .TypeConstraint("S_WEIGHT_BF16", DataTypeImpl::GetSequenceTensorType<BFloat16>()),
     AdamWOptimizer);
 
 Status AdamWOptimizer::ComputeInternal(OpKernelContext* ctx) const {
@@ -40,17 +42,42 @@ Status AdamWOptimizer::ComputeInternal(OpKernelContext* ctx) const {
   // Currently placed on CPU, need revisit when we had mixed precision training requirement.
   const Tensor* update_signal = ctx->Input<Tensor>(6);
   if (update_signal == nullptr || *update_signal->template Data<bool>()) {
-    typedef typename ToCudaType<float>::MappedType CudaT_FLOAT;
-    typedef AdamWMTAFunctor<CudaT_FLOAT, CudaT_FLOAT, CudaT_FLOAT> TFunctor;
-    TFunctor functor;
-
     const float* lr_ptr = p.learning_rate->template Data<float>();
     const int64_t* step_ptr = p.step->template Data<int64_t>();
     ORT_ENFORCE(lr_ptr && step_ptr);
 
-    launch_multi_tensor_functor<MTA_ADAMW_GROUP_SIZE, TFunctor>(
-        Stream(ctx), MTA_ADAMW_CHUNK_SIZE, p.grouped_tensor_sizes, p.grouped_tensor_pointers, functor,
-        alpha_, beta_, epsilon_, *lr_ptr, weight_decay_, adam_mode_, correct_bias_, *step_ptr);
+    typedef typename ToCudaType<float>::MappedType CudaT_FLOAT;
+    typedef typename ToCudaType<BFloat16>::MappedType CudaT_BF16;
+    if (p.weights_bf16 != nullptr) {
+      // Float master weights, the bfloat16 copies are written by the same launches.
+      if (p.gradients_are_bf16) {
+        typedef AdamWBF16CopyMTAFunctor<CudaT_BF16, CudaT_BF16> TFunctor;
+        TFunctor functor;
+        launch_multi_tensor_functor<MTA_ADAMW_BF16_COPY_GROUP_SIZE, TFunctor>(
+            Stream(ctx), MTA_ADAMW_CHUNK_SIZE, p.grouped_tensor_sizes, p.grouped_tensor_pointers, functor,
+            alpha_, beta_, epsilon_, *lr_ptr, weight_decay_, adam_mode_, correct_bias_, *step_ptr);
+      } else {
+        typedef AdamWBF16CopyMTAFunctor<CudaT_FLOAT, CudaT_BF16> TFunctor;
+        TFunctor functor;
+        launch_multi_tensor_functor<MTA_ADAMW_BF16_COPY_GROUP_SIZE, TFunctor>(
+            Stream(ctx), MTA_ADAMW_CHUNK_SIZE, p.grouped_tensor_sizes, p.grouped_tensor_pointers, functor,
+            alpha_, beta_, epsilon_, *lr_ptr, weight_decay_, adam_mode_, correct_bias_, *step_ptr);
+      }
+    } else {
+      if (p.gradients_are_bf16) {
+        typedef AdamWMTAFunctor<CudaT_FLOAT, CudaT_BF16, CudaT_FLOAT> TFunctor;
+        TFunctor functor;
+        launch_multi_tensor_functor<MTA_ADAMW_GROUP_SIZE, TFunctor>(
+            Stream(ctx), MTA_ADAMW_CHUNK_SIZE, p.grouped_tensor_sizes, p.grouped_tensor_pointers, functor,
+            alpha_, beta_, epsilon_, *lr_ptr, weight_decay_, adam_mode_, correct_bias_, *step_ptr);
+      } else {
+        typedef AdamWMTAFunctor<CudaT_FLOAT, CudaT_FLOAT, CudaT_FLOAT> TFunctor;
+        TFunctor functor;
+        launch_multi_tensor_functor<MTA_ADAMW_GROUP_SIZE, TFunctor>(
+            Stream(ctx), MTA_ADAMW_CHUNK_SIZE, p.grouped_tensor_sizes, p.grouped_tensor_pointers, functor,
+            alpha_, beta_, epsilon_, *lr_ptr, weight_decay_, adam_mode_, correct_bias_, *step_ptr);
+      }
+    }
     *updated_flag_ptr = true;
   } else {
     *updated_flag_ptr = false;
@@ -65,6 +92,9 @@ Status AdamWOptimizer::ComputeInternal(OpKernelContext* ctx) const {
   if (p.updated_momentums_2 != nullptr) {
     ORT_RETURN_IF_ERROR(CopyIfNotSameCUDABuffer(ctx, p.num_of_weights, p.momentums_2, p.updated_momentums_2));
   }
+  if (p.weights_bf16 != nullptr && p.updated_weights_bf16 != nullptr) {
+    ORT_RETURN_IF_ERROR(CopyIfNotSameCUDABuffer(ctx, p.num_of_weights, p.weights_bf16, p.updated_weights_bf16));
+  }
 
   return Status::OK();
 }
@@ -13,14 +13,15 @@
 namespace onnxruntime {
 namespace cuda {
 
-template <typename T_WEIGHT, typename T_GRAD, typename T_MOMENTUM>
+template <int GroupSize, typename T_WEIGHT, typename T_GRAD, typename T_MOMENTUM, typename T_WEIGHT_COPY>
 __device__ void PrepareMTAData(
-    const ChunkGroup<MTA_ADAMW_GROUP_SIZE>& chunks,
+    const ChunkGroup<GroupSize>& chunks,
     const int& block_idx,
     T_WEIGHT*& weight_chunk_ptr,
     T_GRAD*& grad_chunk_ptr,
     T_MOMENTUM*& momentum_1_chunk_ptr,
     T_MOMENTUM*& momentum_2_chunk_ptr,
+    T_WEIGHT_COPY*& weight_copy_chunk_ptr,
     int& chunk_size) {
   const int tensor_idx = chunks.block_index_to_tensor_group_index[block_idx];
   const int tensor_size = chunks.tensor_sizes[tensor_idx];
@@ -38,12 +39,18 @@ __device__ void PrepareMTAData(
   grad_chunk_ptr = grad_tensor_ptr + chunk_start_idx;
   momentum_1_chunk_ptr = momentum_1_tensor_ptr + chunk_start_idx;
   momentum_2_chunk_ptr = momentum_2_tensor_ptr + chunk_start_idx;
+
+  // The fifth tensor of a group, if any, is the low precision copy of the weight.
+  weight_copy_chunk_ptr = nullptr;
+  if constexpr (GroupSize == MTA_ADAMW_BF16_COPY_GROUP_SIZE) {
+    weight_copy_chunk_ptr = static_cast<T_WEIGHT_COPY*>(chunks.tensor_ptrs[4][tensor_idx]) + chunk_start_idx;
+  }
 }
 
 // Torch Adam equivalence.
-template <typename T_WEIGHT, typename T_GRAD, typename T_MOMENTUM>
+template <int GroupSize, typename T_WEIGHT, typename T_GRAD, typename T_MOMENTUM, typename T_WEIGHT_COPY>
 __global__ void AdamWComputeMode0(
-    ChunkGroup<MTA_ADAMW_GROUP_SIZE> chunks,
+    ChunkGroup<GroupSize> chunks,
     const float alpha,
     const float beta,
     const float epsilon,
@@ -57,12 +64,13 @@ __global__ void AdamWComputeMode0(
   T_GRAD* grad_chunk_ptr;
   T_MOMENTUM* momentum_1_chunk_ptr;
   T_MOMENTUM* momentum_2_chunk_ptr;
+  T_WEIGHT_COPY* weight_copy_chunk_ptr;
 
   // TODO(pengwa): unroll this one for better perf.
   int chunk_size;
 
   PrepareMTAData(chunks, block_idx, weight_chunk_ptr, grad_chunk_ptr,
-                 momentum_1_chunk_ptr, momentum_2_chunk_ptr, chunk_size);
+                 momentum_1_chunk_ptr, momentum_2_chunk_ptr, weight_copy_chunk_ptr, chunk_size);
 
 #pragma unroll 4
   for (int i = threadIdx.x; i < chunk_size; i += blockDim.x) {
@@ -88,13 +96,16 @@ __global__ void AdamWComputeMode0(
     weight_chunk_ptr[i] = static_cast<T_WEIGHT>(w);
     momentum_1_chunk_ptr[i] = static_cast<T_MOMENTUM>(m1);
     momentum_2_chunk_ptr[i] = static_cast<T_MOMENTUM>(m2);
+    if constexpr (GroupSize == MTA_ADAMW_BF16_COPY_GROUP_SIZE) {
+      weight_copy_chunk_ptr[i] = static_cast<T_WEIGHT_COPY>(w);
+    }
   }
 }
 
 // Huggingface AdamW equivalence.
-template <typename T_WEIGHT, typename T_GRAD, typename T_MOMENTUM>
+template <int GroupSize, typename T_WEIGHT, typename T_GRAD, typename T_MOMENTUM, typename T_WEIGHT_COPY>
 __global__ void AdamWComputeMode1(
-    ChunkGroup<MTA_ADAMW_GROUP_SIZE> chunks,
+    ChunkGroup<GroupSize> chunks,
     const float alpha,
     const float beta,
     const float epsilon,
@@ -107,10 +118,11 @@ __global__ void AdamWComputeMode1(
   T_GRAD* grad_chunk_ptr;
   T_MOMENTUM* momentum_1_chunk_ptr;
   T_MOMENTUM* momentum_2_chunk_ptr;
+  T_WEIGHT_COPY* weight_copy_chunk_ptr;
   int chunk_size;
 
   PrepareMTAData(chunks, block_idx, weight_chunk_ptr, grad_chunk_ptr,
-                 momentum_1_chunk_ptr, momentum_2_chunk_ptr, chunk_size);
+                 momentum_1_chunk_ptr, momentum_2_chunk_ptr, weight_copy_chunk_ptr, chunk_size);
 
 #pragma unroll 4
   for (int i = threadIdx.x; i < chunk_size; i += blockDim.x) {
@@ -135,13 +147,16 @@ __global__ void AdamWComputeMode1(
     weight_chunk_ptr[i] = static_cast<T_WEIGHT>(w);
     momentum_1_chunk_ptr[i] = static_cast<T_MOMENTUM>(m1);
     momentum_2_chunk_ptr[i] = static_cast<T_MOMENTUM>(m2);
+    if constexpr (GroupSize == MTA_ADAMW_BF16_COPY_GROUP_SIZE) {
+      weight_copy_chunk_ptr[i] = static_cast<T_WEIGHT_COPY>(w);
+    }
   }
 }
 
-template <typename T_WEIGHT, typename T_GRAD, typename T_MOMENTUM>
-void AdamWMTAFunctor<T_WEIGHT, T_GRAD, T_MOMENTUM>::operator()(
+template <int GroupSize, typename T_WEIGHT, typename T_GRAD, typename T_MOMENTUM, typename T_WEIGHT_COPY>
+void LaunchAdamWKernel(
     cudaStream_t stream,
-    ChunkGroup<MTA_ADAMW_GROUP_SIZE> chunks,
+    ChunkGroup<GroupSize> chunks,
     const float alpha,
     const float beta,
     const float epsilon,
@@ -151,7 +166,7 @@ void AdamWMTAFunctor<T_WEIGHT, T_GRAD, T_MOMENTUM>::operator()(
     const int64_t correct_bias,
     const int64_t update_count) {
   const int block_count = chunks.chunk_count;
-  const int thread_count = ChunkGroup<MTA_ADAMW_GROUP_SIZE>::thread_count_per_block;
+  const int thread_count = ChunkGroup<GroupSize>::thread_count_per_block;
 
   float alpha_correction = 1.f, beta_correction = 1.f;
   float lr_corrected = lr;
@@ -174,20 +189,70 @@ void AdamWMTAFunctor<T_WEIGHT, T_GRAD, T_MOMENTUM>::operator()(
   //         bias correction is applied on learning rate, then use lr_corrected for subsequent computations.
   //         weight decay is applied after weight is updated.
   if (adam_mode == 0) {
-    AdamWComputeMode0<T_WEIGHT, T_GRAD, T_MOMENTUM><<<block_count, thread_count, 0, stream>>>(
+    AdamWComputeMode0<GroupSize, T_WEIGHT, T_GRAD, T_MOMENTUM, T_WEIGHT_COPY><<<block_count, thread_count, 0, stream>>>(
         chunks, alpha, beta, epsilon, lr, alpha_correction, beta_correction, decay);
   } else if (adam_mode == 1) {
-    AdamWComputeMode1<T_WEIGHT, T_GRAD, T_MOMENTUM><<<block_count, thread_count, 0, stream>>>(
+    AdamWComputeMode1<GroupSize, T_WEIGHT, T_GRAD, T_MOMENTUM, T_WEIGHT_COPY><<<block_count, thread_count, 0, stream>>>(
         chunks, alpha, beta, epsilon, lr, lr_corrected, decay);
   } else {
     ORT_THROW("Unsupported Adamw optimizer mode.");
   }
 }
 
-#define INSTANTIATE_ADAMMTA_FUNCTOR(T_WEIGHT, T_GRAD, T_MOMENTUM)           \
-  template void AdamWMTAFunctor<T_WEIGHT, T_GRAD, T_MOMENTUM>::operator()(  \
+template <typename T_WEIGHT, typename T_GRAD, typename T_MOMENTUM>
+void AdamWMTAFunctor<T_WEIGHT, T_GRAD, T_MOMENTUM>::operator()(
+    cudaStream_t stream,
+    ChunkGroup<MTA_ADAMW_GROUP_SIZE> chunks,
+    const float alpha,
+    const float beta,
+    const float epsilon,
+    const float lr,
+    const float decay,
+    const int64_t adam_mode,
+    const int64_t correct_bias,
+    const int64_t update_count) {
+  LaunchAdamWKernel<MTA_ADAMW_GROUP_SIZE, T_WEIGHT, T_GRAD, T_MOMENTUM, T_WEIGHT>(
+      stream, chunks, alpha, beta, epsilon, lr, decay, adam_mode, correct_bias, update_count);
+}
+
+template <typename T_GRAD, typename T_WEIGHT_COPY>
+void AdamWBF16CopyMTAFunctor<T_GRAD, T_WEIGHT_COPY>::operator()(
+    cudaStream_t stream,
+    ChunkGroup<MTA_ADAMW_BF16_COPY_GROUP_SIZE> chunks,
+    const float alpha,
+    const float beta,
+    const float epsilon,
+    const float lr,
+    const float decay,
+    const int64_t adam_mode,
+    const int64_t correct_bias,
+    const int64_t update_count) {
+  LaunchAdamWKernel<MTA_ADAMW_BF16_COPY_GROUP_SIZE, float, T_GRAD, float, T_WEIGHT_COPY>(
+      stream, chunks, alpha, beta, epsilon, lr, decay, adam_mode, correct_bias, update_count);
+}
+
+#define INSTANTIATE_ADAMMTA_FUNCTOR(T_WEIGHT, T_GRAD, T_MOMENTUM)          \
+  template void AdamWMTAFunctor<T_WEIGHT, T_GRAD, T_MOMENTUM>::operator()( \
+      cudaStream_t stream,                                                 \
+      ChunkGroup<MTA_ADAMW_GROUP_SIZE> chunks,                             \
+      const float alpha,                                                   \
+      const float beta,                                                    \
+      const float epsilon,                                                 \
+      const float lr,                                                      \
+      const float decay,                                                   \
+      const int64_t adam_mode,                                             \
+      const int64_t correct_bias,                                          \
+      const int64_t update_count);
+
+INSTANTIATE_ADAMMTA_FUNCTOR(float, float, float);
+INSTANTIATE_ADAMMTA_FUNCTOR(float, BFloat16, float);
+
+#undef INSTANTIATE_ADAMMTA_FUNCTOR
+
+#define INSTANTIATE_ADAMBF16COPYMTA_FUNCTOR(T_GRAD, T_WEIGHT_COPY)          \
+  template void AdamWBF16CopyMTAFunctor<T_GRAD, T_WEIGHT_COPY>::operator()( \
       cudaStream_t stream,                                                  \
-      ChunkGroup<MTA_ADAMW_GROUP_SIZE> chunks,                              \
+      ChunkGroup<MTA_ADAMW_BF16_COPY_GROUP_SIZE> chunks,                    \
       const float alpha,                                                    \
       const float beta,                                                     \
       const float epsilon,                                                  \
@@ -195,30 +260,12 @@ void AdamWMTAFunctor<T_WEIGHT, T_GRAD, T_MOMENTUM>::operator()(
       const float decay,                                                    \
       const int64_t adam_mode,                                              \
       const int64_t correct_bias,                                           \
-      const int64_t update_count);                                          \
-                                                                            \
-  template __global__ void AdamWComputeMode0<T_WEIGHT, T_GRAD, T_MOMENTUM>( \
-      ChunkGroup<MTA_ADAMW_GROUP_SIZE> chunks,                              \
-      const float alpha,                                                    \
-      const float beta,                                                     \
-      const float epsilon,                                                  \
-      const float lr,                                                       \
-      const float alpha_correction,                                         \
-      const float beta_correction,                                          \
-      const float decay);                                                   \
-                                                                            \
-  template __global__ void AdamWComputeMode1<T_WEIGHT, T_GRAD, T_MOMENTUM>( \
-      ChunkGroup<MTA_ADAMW_GROUP_SIZE> chunks,                              \
-      const float alpha,                                                    \
-      const float beta,                                                     \
-      const float epsilon,                                                  \
-      const float lr,                                                       \
-      const float lr_corrected,                                             \
-      const float decay);
+      const int64_t update_count);
 
-INSTANTIATE_ADAMMTA_FUNCTOR(float, float, float);
+INSTANTIATE_ADAMBF16COPYMTA_FUNCTOR(float, BFloat16);
+INSTANTIATE_ADAMBF16COPYMTA_FUNCTOR(BFloat16, BFloat16);
 
-#undef INSTANTIATE_ADAMMTA_FUNCTOR
+#undef INSTANTIATE_ADAMBF16COPYMTA_FUNCTOR
 
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -10,6 +10,8 @@ namespace cuda {
 
 #define MTA_ADAMW_GROUP_SIZE 4
 #define MTA_ADAMW_CHUNK_SIZE 2048 * 32
+// weight, gradient, momentum_1, momentum_2 and the bfloat16 copy of the weight.
+#define MTA_ADAMW_BF16_COPY_GROUP_SIZE 5
 
 template <typename T_WEIGHT, typename T_GRAD, typename T_MOMENTUM>
 struct AdamWMTAFunctor {
@@ -25,5 +27,21 @@ struct AdamWMTAFunctor {
                   const int64_t update_count);
 };
 
+// Updates float master weights and momentums with T_GRAD gradients, then writes the updated weights to their
+// bfloat16 copies used by the forward and backward passes.
+template <typename T_GRAD, typename T_WEIGHT_COPY>
+struct AdamWBF16CopyMTAFunctor {
+  void operator()(cudaStream_t stream,
+                  ChunkGroup<MTA_ADAMW_BF16_COPY_GROUP_SIZE> chunks,
+                  const float alpha,
+                  const float beta,
+                  const float epsilon,
+                  const float lr,
+                  const float decay,
+                  const int64_t adam_mode,
+                  const int64_t correct_bias,
+                  const int64_t update_count);
+};
+
 }  // namespace cuda
 }  // namespace onnxruntime